@@ -38,6 +38,25 @@ extern "C"
     android::GuiThread::ProcessTask(taskPointer);
   }
 
+  // static void nativeOnTrimMemory(int level);
+  JNIEXPORT void JNICALL
+  Java_com_mapswithme_maps_MwmApplication_nativeOnTrimMemory(JNIEnv * env, jclass clazz, jint level)
+  {
+    if (!g_framework)
+      return;
+
+    // Levels of ComponentCallbacks2.onTrimMemory().
+    int const kTrimMemoryRunningLow = 10;
+    int const kTrimMemoryRunningCritical = 15;
+    int const kTrimMemoryModerate = 60;
+    if (level < kTrimMemoryRunningLow)
+      return;
+
+    bool const isCritical = level == kTrimMemoryRunningCritical || level >= kTrimMemoryModerate;
+    g_framework->NativeFramework()->TrimMemory(isCritical ? base::CacheRegistry::Pressure::Critical
+                                                          : base::CacheRegistry::Pressure::Moderate);
+  }
+
   // static void nativeAddLocalization(String name, String value);
   JNIEXPORT void JNICALL
   Java_com_mapswithme_maps_MwmApplication_nativeAddLocalization(JNIEnv * env, jclass clazz, jstring name, jstring value)
@@ -0,0 +1,79 @@
+#include "base/arena.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+namespace base
+{
+// static
+size_t constexpr Arena::kDefaultBlockSize;
+
+Arena::Arena(size_t blockSize) : m_blockSize(blockSize)
+{
+  CHECK_GREATER(m_blockSize, 0, ());
+}
+
+void * Arena::Allocate(size_t size, size_t alignment)
+{
+  ASSERT_GREATER(alignment, 0, ());
+  ASSERT_EQUAL(alignment & (alignment - 1), 0, ("Alignment must be a power of two."));
+
+  // Zero size allocations get distinct pointers as from operator new.
+  size = max(size, static_cast<size_t>(1));
+  while (true)
+  {
+    if (m_current < m_blocks.size())
+    {
+      Block & block = m_blocks[m_current];
+      auto const begin = reinterpret_cast<uintptr_t>(block.m_data.get());
+      size_t const offset = ((begin + m_offset + alignment - 1) & ~(alignment - 1)) - begin;
+      if (offset + size <= block.m_size)
+      {
+        m_offset = offset + size;
+        return block.m_data.get() + offset;
+      }
+
+      ++m_current;
+      m_offset = 0;
+    }
+
+    // Free blocks are reused when they are big enough, otherwise a new block is inserted
+    // before them. Big allocations get blocks of their own.
+    size_t const required = size + alignment - 1;
+    if (m_current == m_blocks.size() || m_blocks[m_current].m_size < required)
+    {
+      Block block;
+      block.m_size = max(m_blockSize, required);
+      block.m_data.reset(new char[block.m_size]);
+      m_blocks.insert(m_blocks.begin() + m_current, move(block));
+    }
+  }
+}
+
+void Arena::Rewind(Mark const & mark)
+{
+  ASSERT(mark.m_block < m_current || (mark.m_block == m_current && mark.m_offset <= m_offset),
+         ("The mark is ahead of the arena."));
+  m_current = mark.m_block;
+  m_offset = mark.m_offset;
+}
+
+void Arena::Release()
+{
+  m_blocks.clear();
+  m_current = 0;
+  m_offset = 0;
+}
+
+size_t Arena::GetCapacity() const
+{
+  size_t capacity = 0;
+  for (auto const & block : m_blocks)
+    capacity += block.m_size;
+  return capacity;
+}
+}  // namespace base
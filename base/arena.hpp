@@ -0,0 +1,136 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace base
+{
+// Monotonic allocator for temporary objects of a query, a tile, etc.
+//
+// Memory is taken from big blocks by moving a pointer, Deallocate() does nothing and all
+// memory is returned at once by Rewind() or Release(). Blocks are kept after Rewind(), so an
+// arena which lives as long as its thread reuses the same memory for every query and doesn't
+// touch the heap after the first ones.
+//
+// The interface follows std::pmr::monotonic_buffer_resource, which isn't available in C++14,
+// so the code may be switched to std::pmr when the standard library allows it.
+//
+// *NOTE* The class is not thread-safe, use an arena per thread.
+class Arena
+{
+public:
+  struct Mark
+  {
+    size_t m_block = 0;
+    size_t m_offset = 0;
+  };
+
+  static size_t constexpr kDefaultBlockSize = 64 * 1024;
+
+  explicit Arena(size_t blockSize = kDefaultBlockSize);
+
+  void * Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+  void Deallocate(void * /* p */, size_t /* size */) {}
+
+  // Returns the current position of the arena.
+  Mark GetMark() const { return {m_current, m_offset}; }
+
+  // Frees all memory allocated after |mark|. The memory is kept for the following
+  // allocations.
+  void Rewind(Mark const & mark);
+
+  // Frees all memory allocated from the arena and returns it to the heap.
+  void Release();
+
+  // Size of memory which is taken from the heap.
+  size_t GetCapacity() const;
+
+private:
+  struct Block
+  {
+    std::unique_ptr<char[]> m_data;
+    size_t m_size = 0;
+  };
+
+  size_t const m_blockSize;
+  // Blocks [0, m_current) are full, m_offset bytes of the block m_current are used and the
+  // rest of blocks are free.
+  std::vector<Block> m_blocks;
+  size_t m_current = 0;
+  size_t m_offset = 0;
+
+  DISALLOW_COPY_AND_MOVE(Arena);
+};
+
+// Rewinds |arena| to its position at the construction on destruction. Containers which use
+// the arena inside the scope must be destroyed before the scope.
+class ArenaScope
+{
+public:
+  explicit ArenaScope(Arena & arena) : m_arena(arena), m_mark(arena.GetMark()) {}
+  ~ArenaScope() { m_arena.Rewind(m_mark); }
+
+private:
+  Arena & m_arena;
+  Arena::Mark const m_mark;
+
+  DISALLOW_COPY_AND_MOVE(ArenaScope);
+};
+
+// STL allocator which takes memory from an arena. The default constructed allocator uses the
+// heap, the same way std::pmr::polymorphic_allocator uses the default resource, so containers
+// with the allocator may be used where no arena is available.
+template <typename T>
+class ArenaAllocator
+{
+public:
+  using value_type = T;
+
+  ArenaAllocator() noexcept = default;
+  ArenaAllocator(Arena & arena) noexcept : m_arena(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(ArenaAllocator<U> const & rhs) noexcept : m_arena(rhs.GetArena())
+  {
+  }
+
+  T * allocate(size_t n)
+  {
+    if (m_arena == nullptr)
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    return static_cast<T *>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T * p, size_t n) noexcept
+  {
+    if (m_arena == nullptr)
+      ::operator delete(p);
+    else
+      m_arena->Deallocate(p, n * sizeof(T));
+  }
+
+  Arena * GetArena() const noexcept { return m_arena; }
+
+private:
+  Arena * m_arena = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(ArenaAllocator<T> const & lhs, ArenaAllocator<U> const & rhs) noexcept
+{
+  return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(ArenaAllocator<T> const & lhs, ArenaAllocator<U> const & rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}  // namespace base
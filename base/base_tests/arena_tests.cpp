@@ -0,0 +1,121 @@
+#include "testing/testing.hpp"
+
+#include "base/arena.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+bool IsAligned(void * p, size_t alignment)
+{
+  return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+UNIT_TEST(Arena_Allocate)
+{
+  Arena arena(1024 /* blockSize */);
+  TEST_EQUAL(arena.GetCapacity(), 0, ());
+
+  char * prev = static_cast<char *>(arena.Allocate(1, 1));
+  for (size_t alignment : {1, 2, 4, 8, 16, 64})
+  {
+    char * p = static_cast<char *>(arena.Allocate(3, alignment));
+    TEST(IsAligned(p, alignment), (alignment));
+    TEST_NOT_EQUAL(p, prev, ());
+    prev = p;
+  }
+  TEST_EQUAL(arena.GetCapacity(), 1024, ());
+
+  // Allocations which don't fit in a block get blocks of their own.
+  void * big = arena.Allocate(4000, 8);
+  TEST(IsAligned(big, 8), ());
+  TEST_GREATER_OR_EQUAL(arena.GetCapacity(), 1024 + 4000, ());
+
+  arena.Release();
+  TEST_EQUAL(arena.GetCapacity(), 0, ());
+}
+
+UNIT_TEST(Arena_Rewind)
+{
+  Arena arena(256 /* blockSize */);
+  arena.Allocate(100);
+
+  auto const mark = arena.GetMark();
+  void * first = arena.Allocate(100);
+  for (size_t i = 0; i < 100; ++i)
+    arena.Allocate(100);
+  size_t const capacity = arena.GetCapacity();
+
+  arena.Rewind(mark);
+  TEST_EQUAL(arena.Allocate(100), first, ());
+  // Memory is reused after the rewind.
+  for (size_t i = 0; i < 100; ++i)
+    arena.Allocate(100);
+  TEST_EQUAL(arena.GetCapacity(), capacity, ());
+
+  // A big allocation after the rewind is placed before the free blocks.
+  arena.Rewind(mark);
+  arena.Allocate(1000);
+  arena.Allocate(100);
+  TEST_EQUAL(arena.GetCapacity(), capacity + 1000 + alignof(max_align_t) - 1, ());
+}
+
+UNIT_TEST(Arena_Scope)
+{
+  Arena arena;
+  void * p = nullptr;
+  {
+    ArenaScope scope(arena);
+    p = arena.Allocate(10);
+    {
+      ArenaScope nested(arena);
+      arena.Allocate(10);
+    }
+    TEST_NOT_EQUAL(arena.Allocate(10), p, ());
+  }
+  TEST_EQUAL(arena.Allocate(10), p, ());
+}
+
+UNIT_TEST(ArenaAllocator_Containers)
+{
+  Arena arena(128 /* blockSize */);
+  {
+    ArenaScope scope(arena);
+
+    ArenaVector<uint32_t> v(arena);
+    for (uint32_t i = 0; i < 1000; ++i)
+      v.push_back(i);
+    TEST_EQUAL(v.size(), 1000, ());
+    TEST_EQUAL(v[999], 999, ());
+    TEST_GREATER(arena.GetCapacity(), 0, ());
+
+    // Copies share the arena.
+    ArenaVector<uint32_t> copy = v;
+    TEST(copy.get_allocator() == v.get_allocator(), ());
+    TEST(copy == v, ());
+
+    ArenaVector<ArenaVector<uint32_t>> nested(3, ArenaVector<uint32_t>(arena), arena);
+    nested[1].push_back(1);
+    TEST_EQUAL(nested[1].get_allocator().GetArena(), &arena, ());
+
+    map<string, int, less<string>, ArenaAllocator<pair<string const, int>>> m(arena);
+    m["a"] = 1;
+    m["b"] = 2;
+    TEST_EQUAL(m.size(), 2, ());
+  }
+
+  // The default allocator uses the heap.
+  ArenaVector<string> v;
+  TEST(v.get_allocator().GetArena() == nullptr, ());
+  for (size_t i = 0; i < 100; ++i)
+    v.push_back(to_string(i));
+  TEST_EQUAL(v.back(), "99", ());
+  TEST(v.get_allocator() != ArenaAllocator<string>(arena), ());
+}
+}  // namespace
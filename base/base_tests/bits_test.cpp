@@ -141,6 +141,14 @@ UNIT_TEST(NumUsedBits)
   TEST_EQUAL(bits::NumUsedBits(0x000000000000FDEFULL), 16, ());
 }
 
+UNIT_TEST(CountTrailingZeros)
+{
+  TEST_EQUAL(bits::CountTrailingZeros(0x1ULL), 0, ());
+  TEST_EQUAL(bits::CountTrailingZeros(0x8000000000000000ULL), 63, ());
+  TEST_EQUAL(bits::CountTrailingZeros(0x0FABCDEF0FABCDE0ULL), 5, ());
+  TEST_EQUAL(bits::CountTrailingZeros(0xFFFFFFFFFFFFFFFFULL), 0, ());
+}
+
 UNIT_TEST(PopCount64)
 {
   TEST_EQUAL(0, bits::PopCount(static_cast<uint64_t>(0x0)), ());
@@ -0,0 +1,64 @@
+#include "testing/testing.hpp"
+
+#include "base/cache_registry.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+struct TestCache
+{
+  CacheRegistry::Registration Register(CacheRegistry & registry, string const & name,
+                                       CacheRegistry::Priority priority, vector<string> & log)
+  {
+    return registry.Register(name, priority, [this] { return m_size; },
+                             [this, name, &log](CacheRegistry::Pressure) {
+                               m_size = 0;
+                               log.push_back(name);
+                             });
+  }
+
+  size_t m_size = 0;
+};
+}  // namespace
+
+UNIT_TEST(CacheRegistry_Smoke)
+{
+  CacheRegistry registry;
+  vector<string> log;
+
+  TestCache expensive;
+  expensive.m_size = 100;
+  TestCache cheap;
+  cheap.m_size = 10;
+
+  auto const expensiveRegistration =
+      expensive.Register(registry, "expensive", CacheRegistry::Priority::Expensive, log);
+
+  {
+    TestCache temporary;
+    temporary.m_size = 1;
+    auto const registration =
+        temporary.Register(registry, "temporary", CacheRegistry::Priority::Cheap, log);
+    TEST_EQUAL(registry.GetUsage().size(), 2, ());
+    TEST_EQUAL(registry.GetTotalSize(), 101, ());
+  }
+
+  auto const cheapRegistration =
+      cheap.Register(registry, "cheap", CacheRegistry::Priority::Cheap, log);
+  TEST_EQUAL(registry.GetTotalSize(), 110, ());
+
+  registry.OnMemoryPressure(CacheRegistry::Pressure::Moderate);
+  TEST_EQUAL(log, vector<string>({"cheap"}), ());
+  TEST_EQUAL(registry.GetTotalSize(), 100, ());
+
+  log.clear();
+  registry.OnMemoryPressure(CacheRegistry::Pressure::Critical);
+  // Cheap caches are shrunk first.
+  TEST_EQUAL(log, vector<string>({"cheap", "expensive"}), ());
+  TEST_EQUAL(registry.GetTotalSize(), 0, ());
+}
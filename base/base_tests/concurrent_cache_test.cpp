@@ -0,0 +1,106 @@
+#include "testing/testing.hpp"
+
+#include "base/concurrent_cache.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+UNIT_TEST(ConcurrentCache_Smoke)
+{
+  size_t loads = 0;
+  base::ConcurrentCache<uint32_t, uint32_t> cache(
+      4 /* capacity */,
+      [&loads](uint32_t const & key, uint32_t & value) {
+        ++loads;
+        value = key * 10;
+      },
+      1 /* stripesCount */);
+
+  TEST_EQUAL(cache.GetValue(1), 10, ());
+  TEST_EQUAL(cache.GetValue(2), 20, ());
+  TEST_EQUAL(cache.GetValue(1), 10, ());
+  TEST_EQUAL(loads, 2, ());
+  TEST_EQUAL(cache.GetHits(), 1, ());
+  TEST_EQUAL(cache.GetMisses(), 2, ());
+  TEST_EQUAL(cache.GetSize(), 2, ());
+
+  uint32_t value = 0;
+  TEST(cache.Find(2, value), ());
+  TEST_EQUAL(value, 20, ());
+  TEST(!cache.Find(3, value), ());
+}
+
+UNIT_TEST(ConcurrentCache_Clock)
+{
+  base::ConcurrentCache<uint32_t, uint32_t> cache(
+      3 /* capacity */, [](uint32_t const & key, uint32_t & value) { value = key; },
+      1 /* stripesCount */);
+
+  cache.GetValue(1);
+  cache.GetValue(2);
+  cache.GetValue(3);
+  // 1 and 3 get the second chance, 2 is evicted.
+  cache.GetValue(1);
+  cache.GetValue(3);
+  cache.GetValue(4);
+
+  uint32_t value = 0;
+  TEST_EQUAL(cache.GetSize(), 3, ());
+  TEST(cache.Find(1, value), ());
+  TEST(!cache.Find(2, value), ());
+  TEST(cache.Find(3, value), ());
+  TEST(cache.Find(4, value), ());
+}
+
+UNIT_TEST(ConcurrentCache_ManyKeys)
+{
+  // Lots of evictions check the removal from the hash table.
+  base::ConcurrentCache<uint32_t, uint64_t> cache(
+      100 /* capacity */,
+      [](uint32_t const & key, uint64_t & value) { value = uint64_t{key} * key; });
+
+  for (uint32_t i = 0; i < 10000; ++i)
+  {
+    uint32_t const key = (i * 7919) % 1000;
+    TEST_EQUAL(cache.GetValue(key), uint64_t{key} * key, (key));
+  }
+  TEST_LESS_OR_EQUAL(cache.GetSize(), 112, ());
+  TEST_EQUAL(cache.GetHits() + cache.GetMisses(), 10000, ());
+}
+
+UNIT_TEST(ConcurrentCache_Threads)
+{
+  atomic<uint32_t> loads(0);
+  base::ConcurrentCache<uint32_t, uint32_t> cache(
+      1000 /* capacity */, [&loads](uint32_t const & key, uint32_t & value) {
+        ++loads;
+        value = key + 1;
+      });
+
+  size_t const kThreadsCount = 8;
+  atomic<bool> ok(true);
+  vector<thread> threads;
+  for (size_t t = 0; t < kThreadsCount; ++t)
+  {
+    threads.emplace_back([&cache, &ok, t]() {
+      for (uint32_t i = 0; i < 100000; ++i)
+      {
+        uint32_t const key = (i + static_cast<uint32_t>(t) * 13) % 500;
+        if (cache.GetValue(key) != key + 1)
+          ok = false;
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  TEST(ok, ());
+  // All keys fit, every key is loaded once.
+  TEST_EQUAL(loads, 500, ());
+  TEST_EQUAL(cache.GetMisses(), 500, ());
+  TEST_EQUAL(cache.GetHits(), kThreadsCount * 100000 - 500, ());
+}
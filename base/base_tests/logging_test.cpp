@@ -2,6 +2,11 @@
 
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -60,3 +65,48 @@ UNIT_TEST(Logging_ConditionalLog)
   CLOG(LWARNING, BoolFunction(false, isCalled), ("This should be displayed"));
   TEST(isCalled, ());
 }
+
+UNIT_TEST(Logging_Async)
+{
+  std::ostringstream out;
+  auto * const cerrBuf = std::cerr.rdbuf(out.rdbuf());
+
+  base::LogLevel const logLevelSaved = base::g_LogLevel;
+  base::g_LogLevel = LINFO;
+  base::LogMessageFn logMessageSaved = base::SetLogMessageFn(&base::LogMessageAsync);
+
+  size_t constexpr kThreadsCount = 4;
+  size_t constexpr kMessagesCount = 50;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadsCount; ++i)
+  {
+    threads.emplace_back([i]()
+    {
+      for (size_t j = 0; j < kMessagesCount; ++j)
+        LOG(LINFO, ("Async message", i, j));
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  // Messages of a source point are rate limited.
+  for (size_t i = 0; i < 1000; ++i)
+    LOG(LINFO, ("Frequent message"));
+
+  base::FlushAsyncLog();
+  base::SetLogMessageFn(logMessageSaved);
+  base::g_LogLevel = logLevelSaved;
+  std::cerr.rdbuf(cerrBuf);
+
+  auto const log = out.str();
+  auto const countLines = [&log](std::string const & text)
+  {
+    size_t count = 0;
+    for (auto pos = log.find(text); pos != std::string::npos; pos = log.find(text, pos + 1))
+      ++count;
+    return count;
+  };
+  TEST_EQUAL(countLines("Async message"), kThreadsCount * kMessagesCount, ());
+  TEST_EQUAL(countLines("Async message 2 49"), 1, ());
+  TEST_EQUAL(countLines("Frequent message"), 100, ());
+}
@@ -108,6 +108,16 @@ UNIT_CLASS_TEST(MemTrieTest, Basic)
 
   TEST_EQUAL(newTrie.GetNumNodes(), 8, ());
   TEST_EQUAL(GetTrieContents(newTrie), GetExpectedContents(), ());
+
+  Trie copy = newTrie.Clone();
+  TEST_EQUAL(copy.GetNumNodes(), 8, ());
+  TEST_EQUAL(GetTrieContents(copy), GetExpectedContents(), ());
+
+  // The copy is independent of the original.
+  copy.Erase("roger", 3);
+  copy.Add("rose", 4);
+  TEST_EQUAL(GetTrieContents(newTrie), GetExpectedContents(), ());
+
 }
 
 UNIT_CLASS_TEST(MemTrieTest, KeysRemoval)
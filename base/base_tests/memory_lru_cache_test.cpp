@@ -0,0 +1,91 @@
+#include "testing/testing.hpp"
+
+#include "base/memory_lru_cache.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace
+{
+using Cache = base::MemoryLruCache<uint32_t, string>;
+
+UNIT_TEST(MemoryLruCache_Smoke)
+{
+  Cache cache(10 /* maxMemorySize */);
+  TEST(!cache.Find(1), ());
+
+  cache.Put(1, "one", 3 /* memorySize */);
+  cache.Put(2, "two", 3 /* memorySize */);
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST_EQUAL(cache.GetMemorySize(), 6, ());
+  TEST(cache.Find(1), ());
+  TEST_EQUAL(*cache.Find(1), "one", ());
+  TEST(cache.Contains(2), ());
+  TEST(!cache.Contains(3), ());
+
+  // Values bigger than the limit are not put.
+  cache.Put(3, "three", 11 /* memorySize */);
+  TEST(!cache.Contains(3), ());
+  TEST_EQUAL(cache.GetMemorySize(), 6, ());
+
+  // A value is replaced with its size.
+  cache.Put(2, "deux", 4 /* memorySize */);
+  TEST_EQUAL(*cache.Find(2), "deux", ());
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST_EQUAL(cache.GetMemorySize(), 7, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST_EQUAL(cache.GetMemorySize(), 0, ());
+  TEST(!cache.Find(1), ());
+}
+
+UNIT_TEST(MemoryLruCache_Eviction)
+{
+  Cache cache(3 /* maxMemorySize */);
+  cache.Put(1, "one", 1 /* memorySize */);
+  cache.Put(2, "two", 1 /* memorySize */);
+  cache.Put(3, "three", 1 /* memorySize */);
+
+  // 1 is used more recently than 2 now.
+  TEST(cache.Find(1), ());
+  cache.Put(4, "four", 1 /* memorySize */);
+  TEST(!cache.Contains(2), ());
+  TEST(cache.Contains(1), ());
+
+  // Contains() doesn't make 3 recently used.
+  TEST(cache.Contains(3), ());
+  cache.Put(5, "five", 1 /* memorySize */);
+  TEST(!cache.Contains(3), ());
+
+  // Several least recently used values are evicted for a big one.
+  cache.Put(6, "six", 2 /* memorySize */);
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(cache.Contains(5), ());
+  TEST(cache.Contains(6), ());
+  TEST_EQUAL(cache.GetMemorySize(), 3, ());
+}
+
+UNIT_TEST(MemoryLruCache_Erase)
+{
+  Cache cache(100 /* maxMemorySize */);
+  for (uint32_t key = 0; key < 10; ++key)
+    cache.Put(key, to_string(key), key /* memorySize */);
+
+  cache.EraseIf([](uint32_t key) { return key % 2 == 0; });
+  TEST_EQUAL(cache.GetSize(), 5, ());
+  TEST_EQUAL(cache.GetMemorySize(), 1 + 3 + 5 + 7 + 9, ());
+  TEST(!cache.Contains(4), ());
+  TEST(cache.Contains(5), ());
+
+  cache.EraseRange(3, [](uint32_t key) { return key < 7; });
+  TEST_EQUAL(cache.GetSize(), 3, ());
+  TEST(cache.Contains(1), ());
+  TEST(!cache.Contains(3), ());
+  TEST(!cache.Contains(5), ());
+  TEST(cache.Contains(7), ());
+  TEST_EQUAL(cache.GetMemorySize(), 1 + 7 + 9, ());
+}
+}  // namespace
@@ -2,7 +2,11 @@
 
 #include "base/observer_list.hpp"
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -19,6 +23,18 @@ struct Observer
   std::string message;
   int status;
 };
+
+struct CountingObserver
+{
+  void OnEvent()
+  {
+    TEST(!m_removed, ("Removed observer is notified."));
+    ++m_count;
+  }
+
+  std::atomic<bool> m_removed{false};
+  std::atomic<int> m_count{0};
+};
 }  // namespace
 
 UNIT_TEST(ObserverList_Basic)
@@ -66,3 +82,64 @@ UNIT_TEST(ObserverList_Basic)
   TEST(observers.Remove(observer2), ());
   TEST(!observers.Remove(observer2), ());
 }
+
+UNIT_TEST(ObserverListCopyOnWrite_Basic)
+{
+  Observer observer0;
+  Observer observer1;
+
+  base::ObserverListCopyOnWrite<Observer> observers;
+  TEST(observers.Add(observer0), ());
+  TEST(!observers.Add(observer0), ());
+  TEST(observers.Add(observer1), ());
+
+  std::string const message = "HTTP OK";
+  observers.ForEach(&Observer::OnOperationCompleted, message, 204);
+  TEST_EQUAL(message, observer0.message, ());
+  TEST_EQUAL(204, observer1.status, ());
+
+  TEST(observers.Remove(observer0), ());
+  TEST(!observers.Remove(observer0), ());
+
+  observers.ForEach(&Observer::OnOperationCompleted, std::string("Not found"), 404);
+  TEST_EQUAL(204, observer0.status, ());
+  TEST_EQUAL(404, observer1.status, ());
+
+  TEST(observers.Remove(observer1), ());
+  TEST(!observers.Remove(observer1), ());
+}
+
+UNIT_TEST(ObserverListCopyOnWrite_Concurrent)
+{
+  size_t constexpr kThreadsCount = 4;
+  size_t constexpr kIterationsCount = 200;
+
+  base::ObserverListCopyOnWrite<CountingObserver> observers;
+  CountingObserver permanent;
+  TEST(observers.Add(permanent), ());
+
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadsCount; ++i)
+  {
+    threads.emplace_back([&]() {
+      while (!stop)
+        observers.ForEach(&CountingObserver::OnEvent);
+    });
+  }
+
+  // An observer isn't notified after Remove() returns, even if it's destroyed right after that.
+  for (size_t i = 0; i < kIterationsCount; ++i)
+  {
+    auto temporary = std::make_unique<CountingObserver>();
+    TEST(observers.Add(*temporary), ());
+    std::this_thread::yield();
+    TEST(observers.Remove(*temporary), ());
+    temporary->m_removed = true;
+  }
+
+  stop = true;
+  for (auto & thread : threads)
+    thread.join();
+  TEST_GREATER(permanent.m_count, 0, ());
+}
@@ -0,0 +1,126 @@
+#include "testing/testing.hpp"
+
+#include "base/profiler.hpp"
+#include "base/string_utils.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+size_t CountOccurrences(string const & s, string const & what)
+{
+  size_t count = 0;
+  for (auto pos = s.find(what); pos != string::npos; pos = s.find(what, pos + what.size()))
+    ++count;
+  return count;
+}
+
+UNIT_TEST(Profiler_Disabled)
+{
+  auto & profiler = Profiler::Instance();
+  profiler.Start();
+  profiler.Stop();
+  TEST(!profiler.IsEnabled(), ());
+
+  auto & counter = profiler.GetCounter("test.disabled");
+  counter.Add(10);
+  {
+    ProfilerZone zone("DisabledZone", "test");
+  }
+  TEST_EQUAL(counter.GetValue(), 0, ());
+  TEST_EQUAL(CountOccurrences(profiler.Export(), "DisabledZone"), 0, ());
+}
+
+UNIT_TEST(Profiler_Zones)
+{
+  size_t constexpr kThreadsCount = 4;
+  size_t constexpr kZonesCount = 100;
+
+  auto & profiler = Profiler::Instance();
+  profiler.Start();
+
+  vector<thread> threads;
+  for (size_t i = 0; i < kThreadsCount; ++i)
+  {
+    threads.emplace_back([]() {
+      for (size_t j = 0; j < kZonesCount; ++j)
+        ProfilerZone zone("Zone", "test");
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  {
+    ProfilerZone zone("Quoted \"zone\"", "test");
+  }
+  profiler.Stop();
+
+  string const trace = profiler.Export();
+  TEST(strings::StartsWith(trace, "{\"traceEvents\":["), (trace.substr(0, 100)));
+  TEST_EQUAL(CountOccurrences(trace, "\"name\":\"Zone\""), kThreadsCount * kZonesCount, ());
+  TEST_EQUAL(CountOccurrences(trace, "\"name\":\"Quoted \\\"zone\\\"\""), 1, ());
+  TEST_EQUAL(CountOccurrences(trace, "\"droppedZones\":0"), 1, ());
+
+  // Start() drops zones of the previous profiling.
+  profiler.Start();
+  profiler.Stop();
+  TEST_EQUAL(CountOccurrences(profiler.Export(), "\"name\":\"Zone\""), 0, ());
+}
+
+UNIT_TEST(Profiler_RingBuffer)
+{
+  auto & profiler = Profiler::Instance();
+  profiler.Start();
+  for (size_t i = 0; i < Profiler::kZonesPerThread + 10; ++i)
+  {
+    ProfilerZone zone(i < 10 ? "Old" : "New", "test");
+  }
+  profiler.Stop();
+
+  string const trace = profiler.Export();
+  TEST_EQUAL(CountOccurrences(trace, "\"name\":\"Old\""), 0, ());
+  TEST_EQUAL(CountOccurrences(trace, "\"name\":\"New\""), Profiler::kZonesPerThread, ());
+  TEST_EQUAL(CountOccurrences(trace, "\"droppedZones\":10"), 1, ());
+}
+
+UNIT_TEST(Profiler_CountersAndHistograms)
+{
+  auto & profiler = Profiler::Instance();
+  auto & counter = profiler.GetCounter("test.counter");
+  auto & histogram = profiler.GetHistogram("test.histogram");
+  TEST_EQUAL(&counter, &profiler.GetCounter("test.counter"), ());
+
+  profiler.Start();
+  counter.Add();
+  counter.Add(41);
+  for (uint64_t value : {0, 1, 2, 3, 4, 1000})
+    histogram.Add(value);
+  profiler.Stop();
+
+  TEST_EQUAL(counter.GetValue(), 42, ());
+  TEST_EQUAL(histogram.GetCount(), 6, ());
+  TEST_EQUAL(histogram.GetSum(), 1010, ());
+  TEST_EQUAL(histogram.GetBucketCount(0), 1, ());
+  TEST_EQUAL(histogram.GetBucketCount(1), 1, ());
+  TEST_EQUAL(histogram.GetBucketCount(2), 2, ());
+  TEST_EQUAL(histogram.GetBucketCount(3), 1, ());
+  TEST_EQUAL(histogram.GetBucketCount(10), 1, ());
+  TEST_EQUAL(ProfilerHistogram::GetBucketLowerBound(10), 512, ());
+
+  string const trace = profiler.Export();
+  TEST_EQUAL(CountOccurrences(trace, "\"test.counter\":42"), 1, ());
+  TEST_EQUAL(CountOccurrences(trace, "\"test.histogram\":{\"count\":6,\"sum\":1010,"
+                                     "\"buckets\":[[0,1],[1,1],[2,2],[4,1],[512,1]]}"),
+             1, (trace));
+
+  profiler.Start();
+  profiler.Stop();
+  TEST_EQUAL(counter.GetValue(), 0, ());
+  TEST_EQUAL(histogram.GetCount(), 0, ());
+}
+}  // namespace
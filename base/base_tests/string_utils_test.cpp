@@ -124,6 +124,20 @@ UNIT_TEST(MakeLowerCase)
   strings::MakeLowerCaseInplace(s);
   TEST_EQUAL(s, "ss", ());
 
+  // Long strings are lowered by blocks, chars around latin letters must not be changed.
+  s = "@ABCDEFGHIJKLMNOPQRSTUVWXYZ[`abcdefghijklmnopqrstuvwxyz{ 0123456789";
+  strings::MakeLowerCaseInplace(s);
+  TEST_EQUAL(s, "@abcdefghijklmnopqrstuvwxyz[`abcdefghijklmnopqrstuvwxyz{ 0123456789", ());
+
+  s = "ABCDEFGHIJKLMNOPQRSTUVWXYZ \xD0\xA3\xD0\x9F ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  strings::MakeLowerCaseInplace(s);
+  TEST_EQUAL(s, "abcdefghijklmnopqrstuvwxyz \xD1\x83\xD0\xBF abcdefghijklmnopqrstuvwxyz", ());
+
+  // A char which is replaced with several chars after chars which are replaced in place.
+  strings::UniString mixed = strings::MakeUniString("ABC\xc3\x9f DEF");
+  strings::MakeLowerCaseInplace(mixed);
+  TEST_EQUAL(strings::ToUtf8(mixed), "abcss def", ());
+
   strings::UniChar const arr[] = {0x397, 0x10B4, 'Z'};
   strings::UniChar const carr[] = {0x3b7, 0x2d14, 'z'};
   strings::UniString const us(&arr[0], &arr[0] + ARRAY_SIZE(arr));
@@ -354,6 +368,7 @@ void TestIter(std::string const & s, char const * delims, std::vector<std::strin
   {
     TEST(it, (s, delims, i));
     TEST_EQUAL(*it, tokens[i], (s, delims, i));
+    TEST_EQUAL(it.GetView().to_string(), tokens[i], (s, delims, i));
     ++it;
   }
   TEST(!it, (s, delims));
@@ -362,6 +377,13 @@ void TestIter(std::string const & s, char const * delims, std::vector<std::strin
   FunctorTester f(counter, tokens);
   strings::Tokenize(s, delims, f);
   TEST_EQUAL(counter, tokens.size(), ());
+
+  // Previous content of |views| is cleared.
+  std::vector<strings::StringView> views = {"garbage"};
+  strings::TokenizeToViews(s, delims, views);
+  TEST_EQUAL(views.size(), tokens.size(), (s, delims));
+  for (size_t i = 0; i < views.size(); ++i)
+    TEST_EQUAL(views[i].to_string(), tokens[i], (s, delims, i));
 }
 
 void TestIterWithEmptyTokens(std::string const & s, char const * delims, std::vector<std::string> const & tokens)
@@ -372,6 +394,7 @@ void TestIterWithEmptyTokens(std::string const & s, char const * delims, std::ve
   {
     TEST(it, (s, delims, i));
     TEST_EQUAL(*it, tokens[i], (s, delims, i));
+    TEST_EQUAL(it.GetView().to_string(), tokens[i], (s, delims, i));
     ++it;
   }
   TEST(!it, (s, delims));
@@ -462,6 +485,22 @@ UNIT_TEST(Tokenize)
   }
 }
 
+UNIT_TEST(UniStringViewTokenize)
+{
+  strings::UniString const s = strings::MakeUniString("улица  Ленина, 1");
+  std::vector<strings::UniStringView> views;
+  for (strings::TokenizeIterator<strings::SimpleDelimiter> it(s, " ,"); it; ++it)
+    views.push_back(it.GetUniStringView());
+
+  TEST_EQUAL(views.size(), 3, ());
+  TEST(views[0] == strings::MakeUniString("улица"), ());
+  TEST(views[1] == strings::MakeUniString("Ленина"), ());
+  TEST(views[2] != strings::MakeUniString("2"), ());
+  TEST_EQUAL(views[2].ToUniString(), strings::MakeUniString("1"), ());
+  TEST_EQUAL(views[1].size(), 6, ());
+  TEST(strings::UniStringView().empty(), ());
+}
+
 UNIT_TEST(LastUniChar)
 {
   TEST_EQUAL(strings::LastUniChar(""), 0, ());
@@ -492,6 +531,35 @@ UNIT_TEST(MakeUniString_Smoke)
   TEST_EQUAL(strings::UniString(&s[0], &s[0] + ARRAY_SIZE(s) - 1), strings::MakeUniString(s), ());
 }
 
+UNIT_TEST(MakeUniStringInplace)
+{
+  strings::UniString us;
+  strings::MakeUniStringInplace("0123456789abcdefghijklmnopqrstuvwxyz", us);
+  TEST_EQUAL(us.size(), 36, ());
+  TEST_EQUAL(us[35], 'z', ());
+
+  strings::MakeUniStringInplace("0123456789abcdefghijklmnopqrstuvw\xD0\xA3xyz", us);
+  TEST_EQUAL(us.size(), 37, ());
+  TEST_EQUAL(us[33], 0x423, ());
+  TEST_EQUAL(us[34], 'x', ());
+
+  strings::MakeUniStringInplace("", us);
+  TEST(us.empty(), ());
+}
+
+UNIT_TEST(IsASCIIString)
+{
+  std::string s(100, 'a');
+  TEST(strings::IsASCIIString(s), ());
+  for (size_t i = 0; i < s.size(); ++i)
+  {
+    s[i] = '\x80';
+    TEST(!strings::IsASCIIString(s), (i));
+    s[i] = 'a';
+  }
+  TEST(strings::IsASCIIString(""), ());
+}
+
 UNIT_TEST(Normalize)
 {
   strings::UniChar const s[] = { 0x1f101, 'H', 0xfef0, 0xfdfc, 0x2150 };
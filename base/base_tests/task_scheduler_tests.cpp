@@ -0,0 +1,167 @@
+#include "testing/testing.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+using Priority = TaskScheduler::Priority;
+
+// Blocks the worker which runs it until Release() is called.
+class Gate
+{
+public:
+  void Wait()
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_released; });
+  }
+
+  void Release()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_released = true;
+    }
+    m_cv.notify_all();
+  }
+
+private:
+  mutex m_mutex;
+  condition_variable m_cv;
+  bool m_released = false;
+};
+
+UNIT_TEST(TaskScheduler_Smoke)
+{
+  {
+    TaskScheduler scheduler(2);
+    TEST_EQUAL(scheduler.GetThreadsCount(), 2, ());
+  }
+
+  {
+    TaskScheduler scheduler(0);
+    TEST_EQUAL(scheduler.GetThreadsCount(), 1, ());
+    scheduler.ShutdownAndJoin();
+    TEST(!scheduler.Push(Priority::Search, []() {}), ());
+  }
+}
+
+UNIT_TEST(TaskScheduler_Priorities)
+{
+  Gate start;
+  Gate finish;
+  mutex mu;
+  vector<Priority> order;
+  TaskScheduler scheduler(1);
+
+  scheduler.Push(Priority::UiCritical, [&start]() { start.Wait(); });
+  for (auto const priority : {Priority::BackgroundIo, Priority::Search, Priority::Routing,
+                              Priority::RenderBackend, Priority::UiCritical, Priority::Search})
+  {
+    scheduler.Push(priority, [&mu, &order, priority]() {
+      lock_guard<mutex> lock(mu);
+      order.push_back(priority);
+    });
+  }
+  scheduler.Push(Priority::BackgroundIo, [&finish]() { finish.Release(); });
+
+  start.Release();
+  finish.Wait();
+
+  vector<Priority> const expected = {Priority::UiCritical, Priority::RenderBackend,
+                                     Priority::Routing,    Priority::Search,
+                                     Priority::Search,     Priority::BackgroundIo};
+  TEST_EQUAL(order, expected, ());
+}
+
+UNIT_TEST(TaskScheduler_Cancellation)
+{
+  Gate start;
+  Gate finish;
+  atomic<int> executed(0);
+  auto cancellable = make_shared<Cancellable>();
+  TaskScheduler scheduler(1);
+
+  scheduler.Push(Priority::Routing, [&start]() { start.Wait(); });
+  for (size_t i = 0; i < 10; ++i)
+    scheduler.Push(Priority::Routing, cancellable, [&executed]() { ++executed; });
+  scheduler.Push(Priority::Routing, [&executed]() { executed += 100; });
+  scheduler.Push(Priority::Routing, [&finish]() { finish.Release(); });
+
+  cancellable->Cancel();
+  start.Release();
+  finish.Wait();
+
+  TEST_EQUAL(executed, 100, ());
+}
+
+UNIT_TEST(TaskScheduler_NestedTasks)
+{
+  size_t constexpr kTasksCount = 1000;
+
+  atomic<size_t> executed(0);
+  Gate finish;
+  {
+    TaskScheduler scheduler(4);
+    for (size_t i = 0; i < kTasksCount; ++i)
+    {
+      scheduler.Push(Priority::Search, [&]() {
+        scheduler.Push(Priority::RenderBackend, [&]() {
+          if (++executed == 2 * kTasksCount)
+            finish.Release();
+        });
+        if (++executed == 2 * kTasksCount)
+          finish.Release();
+      });
+    }
+    finish.Wait();
+  }
+  TEST_EQUAL(executed, 2 * kTasksCount, ());
+}
+
+UNIT_TEST(TaskScheduler_Stealing)
+{
+  size_t constexpr kThreadsCount = 4;
+
+  // Tasks pushed from a task get to the queue of its worker. All of the tasks block until all
+  // of them are started, so the test finishes only if other workers steal them.
+  Gate gate;
+  mutex mu;
+  condition_variable cv;
+  size_t blocked = 0;
+  TaskScheduler scheduler(kThreadsCount);
+
+  auto const block = [&]() {
+    {
+      lock_guard<mutex> lock(mu);
+      ++blocked;
+    }
+    cv.notify_one();
+    gate.Wait();
+  };
+
+  scheduler.Push(Priority::Routing, [&]() {
+    for (size_t i = 1; i < kThreadsCount; ++i)
+      scheduler.Push(Priority::Routing, block);
+    block();
+  });
+
+  {
+    unique_lock<mutex> lock(mu);
+    cv.wait(lock, [&]() { return blocked == kThreadsCount; });
+  }
+  gate.Release();
+  scheduler.ShutdownAndJoin();
+  TEST_EQUAL(blocked, kThreadsCount, ());
+}
+}  // namespace
@@ -155,3 +155,48 @@ UNIT_TEST(ThreadPool_EmptyTest)
   threads::Sleep(100);
   pool.Stop();
 }
+
+namespace
+{
+  class OrderedTask : public threads::IRoutine
+  {
+  public:
+    explicit OrderedTask(int id) : m_id(id) {}
+
+    virtual void Do()
+    {
+      TEST_EQUAL(true, false, ());
+    }
+
+    int m_id;
+  };
+}
+
+UNIT_TEST(ThreadPool_ProcessTasksTest)
+{
+  std::vector<int> finishedIds;
+  // Tasks are not started by the empty pool, so they are finished on Stop in the queue order.
+  threads::ThreadPool pool(0, [&finishedIds](threads::IRoutine * routine)
+                          {
+                            finishedIds.push_back(static_cast<OrderedTask *>(routine)->m_id);
+                            delete routine;
+                          });
+
+  for (int i = 0; i < TASK_COUNT; ++i)
+    pool.PushBack(new OrderedTask(i));
+
+  pool.ProcessTasks([](std::list<threads::IRoutine *> & tasks)
+                    {
+                      tasks.sort([](threads::IRoutine const * lhs, threads::IRoutine const * rhs)
+                                 {
+                                   return static_cast<OrderedTask const *>(lhs)->m_id >
+                                          static_cast<OrderedTask const *>(rhs)->m_id;
+                                 });
+                    });
+  pool.Stop();
+
+  std::vector<int> expectedIds;
+  for (int i = TASK_COUNT - 1; i >= 0; --i)
+    expectedIds.push_back(i);
+  TEST_EQUAL(finishedIds, expectedIds, ());
+}
@@ -91,6 +91,16 @@ namespace bits
     return msb;
   }
 
+  // Returns the position of the lowest set bit of |x|, |x| must not be zero.
+  inline uint8_t CountTrailingZeros(uint64_t x) noexcept
+  {
+#ifdef __GNUC__
+    return static_cast<uint8_t>(__builtin_ctzll(x));
+#else
+    return FloorLog(x & (~x + 1));
+#endif
+  }
+
   // Will be implemented when needed.
   uint64_t PopCount(uint64_t const * p, uint64_t n);
 
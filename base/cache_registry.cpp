@@ -0,0 +1,118 @@
+#include "base/cache_registry.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace base
+{
+CacheRegistry::Registration::Registration(Registration && rhs)
+  : m_registry(rhs.m_registry), m_id(rhs.m_id)
+{
+  rhs.m_registry = nullptr;
+}
+
+CacheRegistry::Registration & CacheRegistry::Registration::operator=(Registration && rhs)
+{
+  if (this != &rhs)
+  {
+    if (m_registry)
+      m_registry->Unregister(m_id);
+    m_registry = rhs.m_registry;
+    m_id = rhs.m_id;
+    rhs.m_registry = nullptr;
+  }
+  return *this;
+}
+
+CacheRegistry::Registration::~Registration()
+{
+  if (m_registry)
+    m_registry->Unregister(m_id);
+}
+
+// static
+CacheRegistry & CacheRegistry::Instance()
+{
+  static CacheRegistry registry;
+  return registry;
+}
+
+CacheRegistry::Registration CacheRegistry::Register(string const & name, Priority priority,
+                                                    GetSizeFn const & getSize,
+                                                    ShrinkFn const & shrink)
+{
+  CHECK(getSize, (name));
+  CHECK(shrink, (name));
+
+  lock_guard<mutex> lock(m_mutex);
+  uint64_t const id = m_nextId++;
+  m_caches.push_back({id, name, priority, getSize, shrink});
+  return Registration(*this, id);
+}
+
+void CacheRegistry::Unregister(uint64_t id)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = find_if(m_caches.begin(), m_caches.end(),
+                          [id](Cache const & cache) { return cache.m_id == id; });
+  ASSERT(it != m_caches.end(), (id));
+  if (it != m_caches.end())
+    m_caches.erase(it);
+}
+
+void CacheRegistry::OnMemoryPressure(Pressure pressure)
+{
+  lock_guard<mutex> lock(m_mutex);
+
+  vector<Cache const *> caches;
+  for (auto const & cache : m_caches)
+  {
+    if (cache.m_priority == Priority::Cheap || pressure == Pressure::Critical)
+      caches.push_back(&cache);
+  }
+  stable_sort(caches.begin(), caches.end(), [](Cache const * lhs, Cache const * rhs) {
+    return lhs->m_priority < rhs->m_priority;
+  });
+
+  for (auto const * cache : caches)
+  {
+    size_t const before = cache->m_getSize();
+    cache->m_shrink(pressure);
+    LOG(LINFO, ("Cache", cache->m_name, "is shrunk on", pressure, "memory pressure from", before,
+                "to", cache->m_getSize(), "bytes"));
+  }
+}
+
+vector<CacheRegistry::Usage> CacheRegistry::GetUsage() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  vector<Usage> usage;
+  usage.reserve(m_caches.size());
+  for (auto const & cache : m_caches)
+    usage.push_back({cache.m_name, cache.m_getSize()});
+  return usage;
+}
+
+size_t CacheRegistry::GetTotalSize() const
+{
+  size_t total = 0;
+  for (auto const & usage : GetUsage())
+    total += usage.m_sizeBytes;
+  return total;
+}
+
+string DebugPrint(CacheRegistry::Pressure pressure)
+{
+  switch (pressure)
+  {
+  case CacheRegistry::Pressure::Moderate: return "Moderate";
+  case CacheRegistry::Pressure::Critical: return "Critical";
+  }
+  CHECK_SWITCH();
+}
+}  // namespace base
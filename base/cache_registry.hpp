@@ -0,0 +1,103 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace base
+{
+// Process-wide registry of caches of different subsystems. It lets the platform shrink all
+// the caches when the OS reports memory pressure, cheap to refill caches first, and reports
+// memory used by the caches for diagnostics.
+//
+// *NOTE* This class is thread-safe. Callbacks of caches are called under the lock of the
+// registry, so they must not register or unregister caches.
+class CacheRegistry
+{
+public:
+  enum class Pressure
+  {
+    // The process should release memory which is cheap to restore.
+    Moderate,
+    // The process is going to be killed unless it releases as much memory as it can.
+    Critical
+  };
+
+  enum class Priority
+  {
+    // The cache is cheap to refill, e.g. it keeps data which is read from disk without
+    // processing. Such caches are shrunk on any pressure.
+    Cheap,
+    // The cache is expensive to refill. Such caches are shrunk on critical pressure only.
+    Expensive
+  };
+
+  // Returns the number of bytes used by the cache.
+  using GetSizeFn = std::function<size_t()>;
+  using ShrinkFn = std::function<void(Pressure pressure)>;
+
+  struct Usage
+  {
+    std::string m_name;
+    size_t m_sizeBytes = 0;
+  };
+
+  // Unregisters the cache on destruction.
+  class Registration
+  {
+  public:
+    Registration() = default;
+    Registration(Registration && rhs);
+    Registration & operator=(Registration && rhs);
+    ~Registration();
+
+  private:
+    friend class CacheRegistry;
+
+    Registration(CacheRegistry & registry, uint64_t id) : m_registry(&registry), m_id(id) {}
+
+    CacheRegistry * m_registry = nullptr;
+    uint64_t m_id = 0;
+
+    DISALLOW_COPY(Registration);
+  };
+
+  CacheRegistry() = default;
+
+  static CacheRegistry & Instance();
+
+  Registration Register(std::string const & name, Priority priority, GetSizeFn const & getSize,
+                        ShrinkFn const & shrink);
+
+  // Shrinks caches which should be shrunk on |pressure|, cheap ones first.
+  void OnMemoryPressure(Pressure pressure);
+
+  std::vector<Usage> GetUsage() const;
+  size_t GetTotalSize() const;
+
+private:
+  struct Cache
+  {
+    uint64_t m_id;
+    std::string m_name;
+    Priority m_priority;
+    GetSizeFn m_getSize;
+    ShrinkFn m_shrink;
+  };
+
+  void Unregister(uint64_t id);
+
+  mutable std::mutex m_mutex;
+  std::vector<Cache> m_caches;
+  uint64_t m_nextId = 1;
+
+  DISALLOW_COPY_AND_MOVE(CacheRegistry);
+};
+
+std::string DebugPrint(CacheRegistry::Pressure pressure);
+}  // namespace base
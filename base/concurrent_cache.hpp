@@ -0,0 +1,221 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace base
+{
+// Cache with a fixed capacity which may be used from several threads.
+//
+// Keys are distributed between |stripesCount| stripes and every stripe has its own mutex, so
+// threads wait for each other only when they get keys of the same stripe. All storage is
+// allocated in the constructor: values live in preallocated slots and an open addressing hash
+// table with linear probing maps keys to slots. When a stripe is full, the slot to reuse is
+// chosen by CLOCK: values which were read since the last pass of the clock hand get one more
+// chance.
+//
+// Values are returned by copy because other threads may reuse the slot right after the stripe
+// lock is released. Key and Value must be default constructible.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ConcurrentCache
+{
+public:
+  using Loader = std::function<void(Key const & key, Value & value)>;
+
+  /// \param capacity maximum size of the cache in number of items.
+  /// \param loader Function which is called if it's necessary to load a new item for the cache.
+  /// It's called under the lock of the item's stripe.
+  ConcurrentCache(size_t capacity, Loader const & loader, size_t stripesCount = 16)
+    : m_loader(loader), m_stripesCount(std::max(stripesCount, static_cast<size_t>(1)))
+  {
+    CHECK_GREATER(capacity, 0, ());
+    size_t const stripeCapacity = (capacity + m_stripesCount - 1) / m_stripesCount;
+    m_stripes.reserve(m_stripesCount);
+    for (size_t i = 0; i < m_stripesCount; ++i)
+      m_stripes.emplace_back(std::make_unique<Stripe>(stripeCapacity));
+  }
+
+  /// \brief Loads value, if it's necessary, by |key| with |m_loader|, puts it to the cache and
+  /// returns a copy of it.
+  Value GetValue(Key const & key)
+  {
+    size_t const hash = m_hash(key);
+    Stripe & stripe = GetStripe(hash);
+    std::lock_guard<std::mutex> lock(stripe.m_mutex);
+
+    size_t pos = 0;
+    uint32_t slot = stripe.Find(key, hash, pos);
+    if (slot != kEmpty)
+    {
+      m_hits.fetch_add(1, std::memory_order_relaxed);
+      stripe.m_slots[slot].m_referenced = true;
+      return stripe.m_slots[slot].m_value;
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    slot = stripe.Allocate();
+    // The table could be changed by the eviction.
+    CHECK_EQUAL(stripe.Find(key, hash, pos), kEmpty, ());
+    stripe.m_index[pos] = slot;
+
+    Slot & s = stripe.m_slots[slot];
+    s.m_key = key;
+    s.m_hash = hash;
+    s.m_referenced = false;
+    s.m_value = Value();
+    m_loader(key, s.m_value);
+    return s.m_value;
+  }
+
+  /// \returns true and copies the value to |value| if |key| is in the cache.
+  bool Find(Key const & key, Value & value)
+  {
+    size_t const hash = m_hash(key);
+    Stripe & stripe = GetStripe(hash);
+    std::lock_guard<std::mutex> lock(stripe.m_mutex);
+
+    size_t pos = 0;
+    uint32_t const slot = stripe.Find(key, hash, pos);
+    if (slot == kEmpty)
+      return false;
+
+    stripe.m_slots[slot].m_referenced = true;
+    value = stripe.m_slots[slot].m_value;
+    return true;
+  }
+
+  size_t GetSize() const
+  {
+    size_t size = 0;
+    for (auto const & stripe : m_stripes)
+    {
+      std::lock_guard<std::mutex> lock(stripe->m_mutex);
+      size += stripe->m_size;
+    }
+    return size;
+  }
+
+  uint64_t GetHits() const { return m_hits.load(std::memory_order_relaxed); }
+  uint64_t GetMisses() const { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+  static uint32_t constexpr kEmpty = std::numeric_limits<uint32_t>::max();
+
+  struct Slot
+  {
+    Key m_key = Key();
+    Value m_value = Value();
+    size_t m_hash = 0;
+    bool m_referenced = false;
+  };
+
+  struct Stripe
+  {
+    // The table is at most half full.
+    explicit Stripe(size_t capacity) : m_slots(capacity)
+    {
+      while ((size_t{1} << m_log) < 2 * capacity)
+        ++m_log;
+      m_index.assign(size_t{1} << m_log, kEmpty);
+      m_mask = m_index.size() - 1;
+    }
+
+    // Fibonacci hashing: keys of a stripe have the same low bits of hash, the high bits of the
+    // product are spread well anyway.
+    size_t GetPos(size_t hash) const
+    {
+      if (m_log == 0)
+        return 0;
+      return static_cast<size_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >>
+                                 (64 - m_log));
+    }
+
+    // Returns the slot of |key| or kEmpty. |pos| is set to the position of the key in the
+    // table or to the position where the key should be inserted.
+    uint32_t Find(Key const & key, size_t hash, size_t & pos) const
+    {
+      for (pos = GetPos(hash);; pos = (pos + 1) & m_mask)
+      {
+        uint32_t const slot = m_index[pos];
+        if (slot == kEmpty)
+          return kEmpty;
+        Slot const & s = m_slots[slot];
+        if (s.m_hash == hash && s.m_key == key)
+          return slot;
+      }
+    }
+
+    // Returns a free slot, evicts a value by CLOCK if the stripe is full.
+    uint32_t Allocate()
+    {
+      if (m_size < m_slots.size())
+        return static_cast<uint32_t>(m_size++);
+
+      while (m_slots[m_hand].m_referenced)
+      {
+        m_slots[m_hand].m_referenced = false;
+        m_hand = (m_hand + 1) % m_slots.size();
+      }
+
+      uint32_t const victim = static_cast<uint32_t>(m_hand);
+      m_hand = (m_hand + 1) % m_slots.size();
+      Remove(victim);
+      return victim;
+    }
+
+    // Removes |slot| from the table with backward shift deletion, so no tombstones are needed.
+    void Remove(uint32_t slot)
+    {
+      size_t pos = GetPos(m_slots[slot].m_hash);
+      while (m_index[pos] != slot)
+        pos = (pos + 1) & m_mask;
+
+      m_index[pos] = kEmpty;
+      for (size_t next = (pos + 1) & m_mask; m_index[next] != kEmpty; next = (next + 1) & m_mask)
+      {
+        size_t const ideal = GetPos(m_slots[m_index[next]].m_hash);
+        // The entry at |next| may move to |pos| if its probe sequence starts not later than |pos|
+        // cyclically, i.e. |ideal| is not in (pos, next].
+        bool const stays = pos <= next ? (pos < ideal && ideal <= next)
+                                       : (pos < ideal || ideal <= next);
+        if (stays)
+          continue;
+
+        m_index[pos] = m_index[next];
+        m_index[next] = kEmpty;
+        pos = next;
+      }
+    }
+
+    mutable std::mutex m_mutex;
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_index;
+    size_t m_log = 0;
+    size_t m_mask = 0;
+    size_t m_size = 0;
+    size_t m_hand = 0;
+  };
+
+  Stripe & GetStripe(size_t hash) { return *m_stripes[hash % m_stripesCount]; }
+
+  Loader m_loader;
+  Hash m_hash;
+  size_t const m_stripesCount;
+  std::vector<std::unique_ptr<Stripe>> m_stripes;
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+};
+
+// static
+template <typename Key, typename Value, typename Hash>
+uint32_t constexpr ConcurrentCache<Key, Value, Hash>::kEmpty;
+}  // namespace base
@@ -226,15 +226,15 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
 
   auto pushState = [&states, &visited, this](State const & state, size_t id)
   {
-    ASSERT_EQUAL(id, m_transitions.size(), ());
+    ASSERT_EQUAL(id, GetNumStates(), ());
     ASSERT_EQUAL(visited.count(state), 0, (state, id));
 
-    ASSERT_EQUAL(m_transitions.size(), m_accepting.size(), ());
-    ASSERT_EQUAL(m_transitions.size(), m_errorsMade.size(), ());
+    ASSERT_EQUAL(m_transitions.size(), m_accepting.size() * m_alphabet.size(), ());
+    ASSERT_EQUAL(m_accepting.size(), m_errorsMade.size(), ());
 
     states.emplace(state);
     visited[state] = id;
-    m_transitions.emplace_back(m_alphabet.size());
+    m_transitions.resize(m_transitions.size() + m_alphabet.size());
     m_accepting.push_back(false);
     m_errorsMade.push_back(ErrorsMade(state));
   };
@@ -244,22 +244,22 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
 
   TransitionTable table(s, prefixMisprints, prefixSize);
 
+  State next;
   while (!states.empty())
   {
-    auto const curr = states.front();
+    auto const curr = std::move(states.front());
     states.pop();
     ASSERT(IsValid(curr), (curr));
 
     ASSERT_GREATER(visited.count(curr), 0, (curr));
     auto const id = visited[curr];
-    ASSERT_LESS(id, m_transitions.size(), ());
+    ASSERT_LESS(id, GetNumStates(), ());
 
     if (IsAccepting(curr))
       m_accepting[id] = true;
 
     for (size_t i = 0; i < m_alphabet.size(); ++i)
     {
-      State next;
       table.Move(curr, m_alphabet[i], next);
 
       size_t nid;
@@ -275,7 +275,7 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
         nid = it->second;
       }
 
-      m_transitions[id][i] = nid;
+      m_transitions[id * m_alphabet.size() + i] = nid;
     }
   }
 }
@@ -363,7 +363,7 @@ size_t LevenshteinDFA::Move(size_t s, UniChar c) const
   else
     i = distance(m_alphabet.begin(), it);
 
-  return m_transitions[s][i];
+  return m_transitions[s * m_alphabet.size() + i];
 }
 
 std::string DebugPrint(LevenshteinDFA::Position const & p)
@@ -103,7 +103,7 @@ public:
 
   inline Iterator Begin() const { return Iterator(*this); }
 
-  size_t GetNumStates() const { return m_transitions.size(); }
+  size_t GetNumStates() const { return m_accepting.size(); }
   size_t GetAlphabetSize() const { return m_alphabet.size(); }
 
 private:
@@ -133,7 +133,10 @@ private:
 
   std::vector<UniChar> m_alphabet;
 
-  std::vector<std::vector<size_t>> m_transitions;
+  // Transitions of the state |s| by the |i|-th letter of the alphabet are stored at
+  // |s| * |m_alphabet.size()| + |i|, so the transitions of a state are adjacent in memory
+  // and copies of the DFA are cheap.
+  std::vector<size_t> m_transitions;
   std::vector<bool> m_accepting;
   std::vector<size_t> m_errorsMade;
 };
@@ -2,6 +2,7 @@
 
 #include "base/assert.hpp"
 #include "base/macros.hpp"
+#include "base/stl_helpers.hpp"
 #include "base/thread.hpp"
 #include "base/timer.hpp"
 
@@ -9,19 +10,35 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
 namespace
 {
 mutex g_logMutex;
+
+void WriteProlog(ostream & s, base::LogLevel level, int threadId, double sec)
+{
+  char const * name = base::GetLogLevelNames()[level];
+  s << "LOG";
+  s << " TID(" << threadId << ")";
+  s << " " << name;
+  s << " " << setfill(' ') << setw(static_cast<int>(16 - strlen(name))) << sec << " ";
+}
 }  // namespace
 
 namespace base
@@ -46,7 +63,7 @@ bool FromString(string const & s, LogLevel & level)
 array<char const *, NUM_LOG_LEVELS> const & GetLogLevelNames()
 {
   // If you're going to modify the behavior of the function, please,
-  // check validity of LogHelper ctor.
+  // check validity of WriteProlog.
   static array<char const *, NUM_LOG_LEVELS> const kNames = {
       {"DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"}};
   return kNames;
@@ -67,29 +84,12 @@ class LogHelper
 
   base::Timer m_timer;
 
-  array<char const *, NUM_LOG_LEVELS> m_names;
-  array<size_t, NUM_LOG_LEVELS> m_lens;
-
 public:
-  LogHelper() : m_threadsCount(0)
-  {
-    // This code highly depends on the fact that GetLogLevelNames()
-    // always returns the same constant array of strings.
-
-    m_names = GetLogLevelNames();
-    for (size_t i = 0; i < m_lens.size(); ++i)
-      m_lens[i] = strlen(m_names[i]);
-  }
+  LogHelper() : m_threadsCount(0) {}
 
   void WriteProlog(ostream & s, LogLevel level)
   {
-    s << "LOG";
-
-    s << " TID(" << GetThreadID() << ")";
-    s << " " << m_names[level];
-
-    double const sec = m_timer.ElapsedSeconds();
-    s << " " << setfill(' ') << setw(static_cast<int>(16 - m_lens[level])) << sec << " ";
+    ::WriteProlog(s, level, GetThreadID(), m_timer.ElapsedSeconds());
   }
 };
 
@@ -119,6 +119,252 @@ void LogMessageTests(LogLevel level, SrcPoint const &, string const & msg)
   CHECK_LESS(level, g_LogAbortLevel, ("Abort. Log level is too serious", level));
 }
 
+namespace
+{
+// Messages of a thread are passed to the writer thread by a single producer single consumer
+// ring buffer, so logging threads don't wait for each other. The ring of a thread lives
+// until it is drained after the thread exits.
+class LogRing
+{
+public:
+  struct Entry
+  {
+    LogLevel m_level = LDEBUG;
+    SrcPoint m_srcPoint;
+    double m_time = 0.0;
+    string m_message;
+  };
+
+  explicit LogRing(int threadId) : m_threadId(threadId) {}
+
+  int GetThreadId() const { return m_threadId; }
+
+  // Waits for the writer thread if the ring is full.
+  void Push(Entry && entry)
+  {
+    auto const tail = m_tail.load(memory_order_relaxed);
+    while (tail - m_head.load(memory_order_acquire) == kCapacity)
+      this_thread::yield();
+
+    m_entries[tail % kCapacity] = move(entry);
+    m_tail.store(tail + 1, memory_order_release);
+  }
+
+  template <typename Fn>
+  void Drain(Fn && fn)
+  {
+    auto head = m_head.load(memory_order_relaxed);
+    auto const tail = m_tail.load(memory_order_acquire);
+    for (; head != tail; ++head)
+    {
+      fn(move(m_entries[head % kCapacity]));
+      m_head.store(head + 1, memory_order_release);
+    }
+  }
+
+  bool IsEmpty() const
+  {
+    return m_head.load(memory_order_acquire) == m_tail.load(memory_order_acquire);
+  }
+
+  atomic<bool> m_isAbandoned{false};
+
+private:
+  static size_t constexpr kCapacity = 1024;
+
+  int const m_threadId;
+  array<Entry, kCapacity> m_entries;
+  atomic<size_t> m_head{0};
+  atomic<size_t> m_tail{0};
+};
+
+class AsyncLogger
+{
+public:
+  static AsyncLogger & Instance()
+  {
+    static AsyncLogger logger;
+    return logger;
+  }
+
+  ~AsyncLogger()
+  {
+    {
+      lock_guard<mutex> lock(m_flusherMutex);
+      m_isStopped = true;
+    }
+    m_flusherCv.notify_one();
+    m_flusher.join();
+    Flush();
+
+    // Messages which are logged after destruction of the logger are written synchronously.
+    if (LogMessage == &LogMessageAsync)
+      LogMessage = &LogMessageDefault;
+  }
+
+  double GetTime() const { return m_timer.ElapsedSeconds(); }
+
+  shared_ptr<LogRing> CreateRing()
+  {
+    lock_guard<mutex> lock(m_ringsMutex);
+    m_rings.push_back(make_shared<LogRing>(++m_threadsCount));
+    return m_rings.back();
+  }
+
+  // Writes all the messages which are logged before the call.
+  void Flush()
+  {
+    lock_guard<mutex> lock(m_flushMutex);
+
+    vector<shared_ptr<LogRing>> rings;
+    {
+      lock_guard<mutex> lock(m_ringsMutex);
+      // Rings of the exited threads are removed when they are drained.
+      base::EraseIf(m_rings, [](shared_ptr<LogRing> const & ring)
+      {
+        return ring->m_isAbandoned && ring->IsEmpty();
+      });
+      rings = m_rings;
+    }
+
+    vector<pair<int, LogRing::Entry>> entries;
+    for (auto const & ring : rings)
+    {
+      ring->Drain([&entries, &ring](LogRing::Entry && entry)
+      {
+        entries.emplace_back(ring->GetThreadId(), move(entry));
+      });
+    }
+
+    if (entries.empty())
+      return;
+
+    // Messages of different threads are merged by their time.
+    stable_sort(entries.begin(), entries.end(), [](auto const & lhs, auto const & rhs)
+    {
+      return lhs.second.m_time < rhs.second.m_time;
+    });
+
+    ostringstream out;
+    for (auto const & entry : entries)
+    {
+      WriteProlog(out, entry.second.m_level, entry.first, entry.second.m_time);
+      out << DebugPrint(entry.second.m_srcPoint) << entry.second.m_message << endl;
+    }
+
+    lock_guard<mutex> logLock(g_logMutex);
+    cerr << out.str();
+  }
+
+private:
+  AsyncLogger() : m_flusher(&AsyncLogger::FlusherRoutine, this) {}
+
+  void FlusherRoutine()
+  {
+    // Logging threads never wait on the mutex, so the messages are polled.
+    auto constexpr kFlushPeriod = chrono::milliseconds(10);
+
+    unique_lock<mutex> lock(m_flusherMutex);
+    while (!m_isStopped)
+    {
+      lock.unlock();
+      Flush();
+      lock.lock();
+      m_flusherCv.wait_for(lock, kFlushPeriod, [this]() { return m_isStopped; });
+    }
+  }
+
+  base::Timer m_timer;
+
+  mutex m_ringsMutex;
+  vector<shared_ptr<LogRing>> m_rings;
+  int m_threadsCount = 0;
+
+  mutex m_flushMutex;
+
+  mutex m_flusherMutex;
+  condition_variable m_flusherCv;
+  bool m_isStopped = false;
+  thread m_flusher;
+};
+
+// Frequent messages of a source point are limited per thread: no more than
+// |kMaxMessagesPerPeriod| messages are written in |kRateLimitPeriod| seconds.
+double constexpr kRateLimitPeriod = 1.0;
+uint32_t constexpr kMaxMessagesPerPeriod = 100;
+
+struct SrcPointHash
+{
+  size_t operator()(pair<char const *, int> const & p) const
+  {
+    return hash<char const *>()(p.first) ^ (hash<int>()(p.second) << 1);
+  }
+};
+
+struct RateLimit
+{
+  double m_periodStart = 0.0;
+  uint32_t m_messagesCount = 0;
+  uint32_t m_suppressedCount = 0;
+};
+
+struct ThreadLogState
+{
+  ~ThreadLogState()
+  {
+    if (m_ring)
+      m_ring->m_isAbandoned = true;
+  }
+
+  shared_ptr<LogRing> m_ring;
+  unordered_map<pair<char const *, int>, RateLimit, SrcPointHash> m_rateLimits;
+};
+}  // namespace
+
+void LogMessageAsync(LogLevel level, SrcPoint const & srcPoint, string const & msg)
+{
+  auto & logger = AsyncLogger::Instance();
+  thread_local ThreadLogState state;
+  if (!state.m_ring)
+    state.m_ring = logger.CreateRing();
+
+  auto const time = logger.GetTime();
+  uint32_t suppressedCount = 0;
+  // Source points are literals, so they are identified by the pointers.
+  if (srcPoint.Line() > 0 && level < LERROR)
+  {
+    auto & limit = state.m_rateLimits[make_pair(srcPoint.FileName(), srcPoint.Line())];
+    if (time - limit.m_periodStart > kRateLimitPeriod)
+    {
+      suppressedCount = limit.m_suppressedCount;
+      limit = RateLimit();
+      limit.m_periodStart = time;
+    }
+    if (++limit.m_messagesCount > kMaxMessagesPerPeriod)
+    {
+      ++limit.m_suppressedCount;
+      return;
+    }
+  }
+
+  LogRing::Entry entry;
+  entry.m_level = level;
+  entry.m_srcPoint = srcPoint;
+  entry.m_time = time;
+  if (suppressedCount != 0)
+    entry.m_message = "(" + to_string(suppressedCount) + " similar messages are suppressed) ";
+  entry.m_message += msg;
+  state.m_ring->Push(move(entry));
+
+  // Serious messages must not be lost if the process crashes or is aborted.
+  if (level >= LERROR)
+    logger.Flush();
+
+  CHECK_LESS(level, g_LogAbortLevel, ("Abort. Log level is too serious", level));
+}
+
+void FlushAsyncLog() { AsyncLogger::Instance().Flush(); }
+
 LogMessageFn LogMessage = &LogMessageDefault;
 
 LogMessageFn SetLogMessageFn(LogMessageFn fn)
@@ -41,6 +41,14 @@ LogMessageFn SetLogMessageFn(LogMessageFn fn);
 void LogMessageDefault(LogLevel level, SrcPoint const & srcPoint, std::string const & msg);
 void LogMessageTests(LogLevel level, SrcPoint const & srcPoint, std::string const & msg);
 
+/// Writes messages to stderr like LogMessageDefault but on a background thread, so the logging
+/// threads are not blocked by each other and by I/O. Install it by SetLogMessageFn.
+/// A source point writes no more than 100 messages per second on a thread, messages of
+/// LERROR and higher levels are never suppressed and are written before the call returns.
+void LogMessageAsync(LogLevel level, SrcPoint const & srcPoint, std::string const & msg);
+/// Writes all the messages of LogMessageAsync which are logged before the call.
+void FlushAsyncLog();
+
 /// Scope Guard to temporarily suppress specific log level, for example, in unit tests:
 /// ...
 /// {
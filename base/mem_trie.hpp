@@ -199,6 +199,15 @@ public:
     return *this;
   }
 
+  // Returns a deep copy of the trie. The trie is not copyable because
+  // copying is expensive, so it's done explicitly.
+  MemTrie Clone() const
+  {
+    MemTrie trie;
+    Copy(m_root, trie.m_root);
+    return trie;
+  }
+
   // A read-only iterator wrapping a Node. Any modification to the
   // underlying trie is assumed to invalidate the iterator.
   class Iterator
@@ -235,50 +244,17 @@ public:
   template <typename... Args>
   void Add(String const & key, Args &&... args)
   {
-    auto * curr = &m_root;
-
-    auto it = key.begin();
-    while (it != key.end())
-    {
-      bool created;
-      curr = &curr->GetOrCreateMove(*it++, created);
-
-      auto & edge = curr->m_edge;
-
-      if (created)
-      {
-        edge.Assign(it, key.end());
-        it = key.end();
-        continue;
-      }
-
-      size_t i = 0;
-      SkipEqual(edge, key.end(), i, it);
-
-      if (i == edge.Size())
-      {
-        // We may directly add value to the |curr| values, when edge
-        // equals to the rest of the |key|.  Otherwise we need to jump
-        // to the next iteration of the loop and continue traversal of
-        // the trie.
-        continue;
-      }
-
-      // We need to split the edge to |curr|.
-      auto node = std::make_unique<Node>();
-
-      ASSERT_LESS(i, edge.Size(), ());
-      node->m_edge = edge.DropFirst(i);
-
-      ASSERT(!edge.Empty(), ());
-      auto const next = edge[0];
-      edge.DropFirst(1);
-
-      node->Swap(*curr);
-      curr->AddChild(next, std::move(node));
-    }
+    GetOrCreateNode(key).AddValue(std::forward<Args>(args)...);
+  }
 
-    curr->AddValue(std::forward<Args>(args)...);
+  // Adds all values from [begin, end) by |key|. It's faster than
+  // adding them one by one because the trie is traversed only once.
+  template <typename It>
+  void AddValues(String const & key, It begin, It end)
+  {
+    auto & node = GetOrCreateNode(key);
+    for (auto it = begin; it != end; ++it)
+      node.AddValue(*it);
   }
 
   void Erase(String const & key, Value const & value)
@@ -483,6 +459,56 @@ private:
     DISALLOW_COPY(Node);
   };
 
+  // Returns the node reachable by |key| from the trie root, creating
+  // it when necessary.
+  Node & GetOrCreateNode(String const & key)
+  {
+    auto * curr = &m_root;
+
+    auto it = key.begin();
+    while (it != key.end())
+    {
+      bool created;
+      curr = &curr->GetOrCreateMove(*it++, created);
+
+      auto & edge = curr->m_edge;
+
+      if (created)
+      {
+        edge.Assign(it, key.end());
+        it = key.end();
+        continue;
+      }
+
+      size_t i = 0;
+      SkipEqual(edge, key.end(), i, it);
+
+      if (i == edge.Size())
+      {
+        // We may directly add value to the |curr| values, when edge
+        // equals to the rest of the |key|.  Otherwise we need to jump
+        // to the next iteration of the loop and continue traversal of
+        // the trie.
+        continue;
+      }
+
+      // We need to split the edge to |curr|.
+      auto node = std::make_unique<Node>();
+
+      ASSERT_LESS(i, edge.Size(), ());
+      node->m_edge = edge.DropFirst(i);
+
+      ASSERT(!edge.Empty(), ());
+      auto const next = edge[0];
+      edge.DropFirst(1);
+
+      node->Swap(*curr);
+      curr->AddChild(next, std::move(node));
+    }
+
+    return *curr;
+  }
+
   template <typename Fn>
   void MoveTo(String const & prefix, bool fullMatch, Fn && fn) const
   {
@@ -565,6 +591,18 @@ private:
     }
   }
 
+  // Makes |to| a deep copy of |from|. |to| must be empty.
+  static void Copy(Node const & from, Node & to)
+  {
+    to.m_edge = from.m_edge;
+    to.m_values = from.m_values;
+    from.m_moves.ForEach([&to](Char const & c, Node const & child) {
+      auto node = std::make_unique<Node>();
+      Copy(child, *node);
+      to.AddChild(c, std::move(node));
+    });
+  }
+
   // Calls |toDo| for each key-value pair in subtree where |node| is a
   // root of the subtree. |prefix| is a path from the trie root to the
   // |node|. Because we need to accumulate labels from the root to the
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace base
+{
+// Cache which keeps the most recently used values within a memory limit. Every value is
+// put with its approximate memory size and the least recently used values are evicted
+// when the sum of the sizes exceeds the limit. A cache bounded by the number of values is
+// a cache where every value has size one.
+//
+// This class is not thread-safe, caches which are shared between threads guard it with
+// their own locks.
+template <typename Key, typename Value, typename Less = std::less<Key>>
+class MemoryLruCache
+{
+public:
+  explicit MemoryLruCache(size_t maxMemorySize) : m_maxMemorySize(maxMemorySize) {}
+
+  // Returns nullptr when there is no value for |key|. Otherwise makes the value
+  // the most recently used one. The pointer is valid until the cache is changed.
+  Value const * Find(Key const & key)
+  {
+    auto const it = m_index.find(key);
+    if (it == m_index.end())
+      return nullptr;
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return &it->second->m_value;
+  }
+
+  // Unlike Find(), doesn't make the value recently used.
+  bool Contains(Key const & key) const { return m_index.find(key) != m_index.end(); }
+
+  // Puts |value| by |key| or replaces the value which is already there, and makes it
+  // the most recently used one. Values which are bigger than the limit are not put.
+  void Put(Key const & key, Value value, size_t memorySize)
+  {
+    if (memorySize > m_maxMemorySize)
+      return;
+
+    auto const it = m_index.find(key);
+    if (it != m_index.end())
+    {
+      auto & entry = *it->second;
+      m_memorySize -= entry.m_memorySize;
+      entry.m_value = std::move(value);
+      entry.m_memorySize = memorySize;
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+    }
+    else
+    {
+      m_entries.push_front({key, std::move(value), memorySize});
+      m_index.emplace(key, m_entries.begin());
+    }
+    m_memorySize += memorySize;
+
+    while (m_memorySize > m_maxMemorySize)
+    {
+      ASSERT(!m_entries.empty(), ());
+      auto const & last = m_entries.back();
+      m_memorySize -= last.m_memorySize;
+      m_index.erase(last.m_key);
+      m_entries.pop_back();
+    }
+  }
+
+  // Erases all values which keys satisfy |pred|.
+  template <typename Pred>
+  void EraseIf(Pred && pred)
+  {
+    for (auto it = m_index.begin(); it != m_index.end();)
+    {
+      if (!pred(it->first))
+      {
+        ++it;
+        continue;
+      }
+
+      m_memorySize -= it->second->m_memorySize;
+      m_entries.erase(it->second);
+      it = m_index.erase(it);
+    }
+  }
+
+  // Erases values by keys from [from, ...) in the order of |Less| while |pred| is satisfied.
+  template <typename Pred>
+  void EraseRange(Key const & from, Pred && pred)
+  {
+    for (auto it = m_index.lower_bound(from); it != m_index.end() && pred(it->first);)
+    {
+      m_memorySize -= it->second->m_memorySize;
+      m_entries.erase(it->second);
+      it = m_index.erase(it);
+    }
+  }
+
+  void Clear()
+  {
+    m_entries.clear();
+    m_index.clear();
+    m_memorySize = 0;
+  }
+
+  size_t GetSize() const { return m_entries.size(); }
+  size_t GetMemorySize() const { return m_memorySize; }
+  size_t GetMaxMemorySize() const { return m_maxMemorySize; }
+
+private:
+  struct Entry
+  {
+    Key m_key;
+    Value m_value;
+    size_t m_memorySize;
+  };
+
+  using Entries = std::list<Entry>;
+
+  size_t const m_maxMemorySize;
+  // Most recently used entries are at the front.
+  Entries m_entries;
+  std::map<Key, typename Entries::iterator, Less> m_index;
+  size_t m_memorySize = 0;
+};
+}  // namespace base
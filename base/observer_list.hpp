@@ -1,9 +1,12 @@
 #pragma once
 
+#include "base/atomic_shared_ptr.hpp"
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -69,4 +72,87 @@ private:
   Mutex m_observersLock;
   std::vector<Observer *> m_observers;
 };
+
+/// Thread-safe observers list for frequent notifications and rare changes of observers.
+///
+/// ForEach() iterates over an immutable snapshot of the list, so notifications from different
+/// threads don't wait for each other and for Add(). Add() and Remove() copy the list and
+/// replace the snapshot. After Remove() the snapshot without the observer is published and
+/// Remove() waits until notifications which use older snapshots are finished, so the observer
+/// may be destroyed right after Remove() as with ObserverListSafe.
+///
+/// *NOTE* Remove() must not be called from a notification of the same list, it would wait for
+/// itself.
+template <typename Observer>
+class ObserverListCopyOnWrite
+{
+public:
+  bool Add(Observer & observer)
+  {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto const observers = m_observers.Get();
+    if (std::find(observers->cbegin(), observers->cend(), &observer) != observers->cend())
+    {
+      LOG(LWARNING, ("Can't add the same observer twice:", &observer));
+      return false;
+    }
+
+    auto copy = std::make_shared<Observers>(*observers);
+    copy->push_back(&observer);
+    Publish(std::move(copy));
+    return true;
+  }
+
+  bool Remove(Observer const & observer)
+  {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    {
+      auto const observers = m_observers.Get();
+      auto const it = std::find(observers->cbegin(), observers->cend(), &observer);
+      if (it == observers->cend())
+      {
+        LOG(LWARNING, ("Can't remove non-registered observer:", &observer));
+        return false;
+      }
+
+      auto copy = std::make_shared<Observers>(observers->cbegin(), it);
+      copy->insert(copy->end(), std::next(it), observers->cend());
+      Publish(std::move(copy));
+    }
+
+    // Waits for notifications which started before Publish() and use older snapshots.
+    for (auto const & snapshot : m_retired)
+    {
+      while (!snapshot.expired())
+        std::this_thread::yield();
+    }
+    m_retired.clear();
+    return true;
+  }
+
+  template <typename F, typename... Args>
+  void ForEach(F fn, Args const &... args)
+  {
+    auto const observers = m_observers.Get();
+    for (Observer * observer : *observers)
+      (observer->*fn)(args...);
+  }
+
+private:
+  using Observers = std::vector<Observer *>;
+
+  void Publish(std::shared_ptr<Observers const> observers)
+  {
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+                                   [](auto const & snapshot) { return snapshot.expired(); }),
+                    m_retired.end());
+    m_retired.emplace_back(m_observers.Get());
+    m_observers.Set(std::move(observers));
+  }
+
+  std::mutex m_writeMutex;
+  AtomicSharedPtr<Observers> m_observers;
+  // Replaced snapshots which may be still used by notifications.
+  std::vector<std::weak_ptr<Observers const>> m_retired;
+};
 }  // namespace base
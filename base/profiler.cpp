@@ -0,0 +1,242 @@
+#include "base/profiler.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+using namespace std::chrono;
+
+namespace base
+{
+namespace
+{
+int64_t ToUs(Profiler::Clock::time_point const & t)
+{
+  return duration_cast<microseconds>(t.time_since_epoch()).count();
+}
+
+void WriteJsonString(ostringstream & ss, string const & str)
+{
+  ss << '"';
+  for (auto const c : str)
+  {
+    if (c == '"' || c == '\\')
+      ss << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      ss << ' ';
+    else
+      ss << c;
+  }
+  ss << '"';
+}
+}  // namespace
+
+// static
+size_t constexpr Profiler::kZonesPerThread;
+// static
+size_t constexpr Profiler::kMaxThreads;
+// static
+size_t constexpr ProfilerHistogram::kBucketsCount;
+
+// static
+Profiler & Profiler::Instance()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+void Profiler::Start()
+{
+  Stop();
+
+  size_t const threadsCount = m_threadsCount;
+  for (size_t i = 0; i < threadsCount; ++i)
+  {
+    lock_guard<mutex> lock(m_threads[i].m_mutex);
+    m_threads[i].m_written = 0;
+  }
+  m_droppedZonesCount = 0;
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    for (auto & counter : m_counters)
+      counter.second->Reset();
+    for (auto & histogram : m_histograms)
+      histogram.second->Reset();
+  }
+
+  m_startTimeInUs = ToUs(Clock::now());
+  m_isEnabled = true;
+}
+
+void Profiler::Stop() { m_isEnabled = false; }
+
+void Profiler::AddZone(char const * name, char const * category, Clock::time_point const & start,
+                       Clock::time_point const & end)
+{
+  if (!IsEnabled())
+    return;
+
+  ThreadZones * zones = GetThreadZones();
+  if (zones == nullptr)
+  {
+    ++m_droppedZonesCount;
+    return;
+  }
+
+  Zone zone;
+  zone.m_name = name;
+  zone.m_category = category;
+  zone.m_startInUs = ToUs(start) - m_startTimeInUs;
+  zone.m_durationInUs = duration_cast<microseconds>(end - start).count();
+
+  // The mutex is taken by other threads only during Start() and Export().
+  lock_guard<mutex> lock(zones->m_mutex);
+  if (zones->m_zones.size() < kZonesPerThread)
+    zones->m_zones.resize(kZonesPerThread);
+  zones->m_zones[zones->m_written % kZonesPerThread] = zone;
+  ++zones->m_written;
+}
+
+ProfilerCounter & Profiler::GetCounter(string const & name)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto & counter = m_counters[name];
+  if (!counter)
+    counter = make_unique<ProfilerCounter>();
+  return *counter;
+}
+
+ProfilerHistogram & Profiler::GetHistogram(string const & name)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto & histogram = m_histograms[name];
+  if (!histogram)
+    histogram = make_unique<ProfilerHistogram>();
+  return *histogram;
+}
+
+string Profiler::Export() const
+{
+  ostringstream ss;
+  ss << "{\"traceEvents\":[";
+
+  bool first = true;
+  uint64_t overwrittenZonesCount = 0;
+  size_t const threadsCount = m_threadsCount;
+  for (size_t i = 0; i < threadsCount; ++i)
+  {
+    auto const & zones = m_threads[i];
+    lock_guard<mutex> lock(zones.m_mutex);
+    uint64_t const count = min<uint64_t>(zones.m_written, kZonesPerThread);
+    overwrittenZonesCount += zones.m_written - count;
+    for (uint64_t j = zones.m_written - count; j < zones.m_written; ++j)
+    {
+      auto const & zone = zones.m_zones[j % kZonesPerThread];
+      if (!first)
+        ss << ",";
+      first = false;
+      ss << "\n{\"name\":";
+      WriteJsonString(ss, zone.m_name);
+      ss << ",\"cat\":";
+      WriteJsonString(ss, zone.m_category);
+      ss << ",\"ph\":\"X\",\"ts\":" << zone.m_startInUs << ",\"dur\":" << zone.m_durationInUs
+         << ",\"pid\":0,\"tid\":" << i << "}";
+    }
+  }
+
+  ss << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedZones\":"
+     << m_droppedZonesCount + overwrittenZonesCount;
+
+  lock_guard<mutex> lock(m_mutex);
+  ss << ",\"counters\":{";
+  for (auto it = m_counters.cbegin(); it != m_counters.cend(); ++it)
+  {
+    if (it != m_counters.cbegin())
+      ss << ",";
+    WriteJsonString(ss, it->first);
+    ss << ":" << it->second->GetValue();
+  }
+
+  ss << "},\"histograms\":{";
+  for (auto it = m_histograms.cbegin(); it != m_histograms.cend(); ++it)
+  {
+    if (it != m_histograms.cbegin())
+      ss << ",";
+    auto const & histogram = *it->second;
+    WriteJsonString(ss, it->first);
+    ss << ":{\"count\":" << histogram.GetCount() << ",\"sum\":" << histogram.GetSum()
+       << ",\"buckets\":[";
+    // Buckets are written as [lower bound, count], empty buckets are skipped.
+    bool firstBucket = true;
+    for (size_t i = 0; i < ProfilerHistogram::kBucketsCount; ++i)
+    {
+      uint64_t const count = histogram.GetBucketCount(i);
+      if (count == 0)
+        continue;
+      if (!firstBucket)
+        ss << ",";
+      firstBucket = false;
+      ss << "[" << ProfilerHistogram::GetBucketLowerBound(i) << "," << count << "]";
+    }
+    ss << "]}";
+  }
+  ss << "}}}\n";
+  return ss.str();
+}
+
+Profiler::ThreadZones * Profiler::GetThreadZones()
+{
+  auto const id = this_thread::get_id();
+  size_t const threadsCount = m_threadsCount;
+  for (size_t i = 0; i < threadsCount; ++i)
+  {
+    if (m_threads[i].m_threadId == id)
+      return &m_threads[i];
+  }
+
+  lock_guard<mutex> lock(m_mutex);
+  // Only the current thread may add its buffer, so it's enough to check buffers which are
+  // added since the previous check.
+  size_t const index = m_threadsCount;
+  if (index == kMaxThreads)
+    return nullptr;
+  m_threads[index].m_threadId = id;
+  m_threadsCount = index + 1;
+  return &m_threads[index];
+}
+
+void ProfilerHistogram::Add(uint64_t value)
+{
+  if (!Profiler::Instance().IsEnabled())
+    return;
+
+  m_buckets[bits::NumUsedBits(value)].fetch_add(1, memory_order_relaxed);
+  m_count.fetch_add(1, memory_order_relaxed);
+  m_sum.fetch_add(value, memory_order_relaxed);
+}
+
+uint64_t ProfilerHistogram::GetBucketCount(size_t bucket) const
+{
+  CHECK_LESS(bucket, kBucketsCount, ());
+  return m_buckets[bucket].load(memory_order_relaxed);
+}
+
+// static
+uint64_t ProfilerHistogram::GetBucketLowerBound(size_t bucket)
+{
+  CHECK_LESS(bucket, kBucketsCount, ());
+  return bucket == 0 ? 0 : uint64_t{1} << (bucket - 1);
+}
+
+void ProfilerHistogram::Reset()
+{
+  for (auto & bucket : m_buckets)
+    bucket = 0;
+  m_count = 0;
+  m_sum = 0;
+}
+}  // namespace base
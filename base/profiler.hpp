@@ -0,0 +1,159 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace base
+{
+class ProfilerCounter;
+class ProfilerHistogram;
+
+// Instrumentation which is compiled in all builds and enabled at runtime, so release builds
+// may be profiled in the field. When profiling is disabled a zone, a counter or a histogram
+// costs one relaxed atomic load.
+//
+// Zones are scopes with names. Every thread writes them to its own ring buffer, so threads
+// don't wait for each other and a long profiling keeps the latest zones. Counters and
+// histograms are registered by name once and updated with atomics.
+//
+// Export() returns zones in Chrome trace format, which is opened by chrome://tracing or
+// Perfetto. Counters and histograms are written to "otherData" of the trace.
+class Profiler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Zones of a thread which are kept, older zones are overwritten.
+  static size_t constexpr kZonesPerThread = 16 * 1024;
+  // Zones of threads which start to write after this number of threads are dropped.
+  static size_t constexpr kMaxThreads = 64;
+
+  static Profiler & Instance();
+
+  // Drops zones of the previous profiling and resets counters and histograms.
+  void Start();
+  void Stop();
+  bool IsEnabled() const { return m_isEnabled.load(std::memory_order_relaxed); }
+
+  // Adds a zone on the current thread. |name| and |category| must be string literals.
+  // Does nothing if profiling is disabled.
+  void AddZone(char const * name, char const * category, Clock::time_point const & start,
+               Clock::time_point const & end);
+
+  // Returned references are valid for the lifetime of the profiler.
+  ProfilerCounter & GetCounter(std::string const & name);
+  ProfilerHistogram & GetHistogram(std::string const & name);
+
+  std::string Export() const;
+
+private:
+  struct Zone
+  {
+    char const * m_name = nullptr;
+    char const * m_category = nullptr;
+    int64_t m_startInUs = 0;
+    int64_t m_durationInUs = 0;
+  };
+
+  struct ThreadZones
+  {
+    std::atomic<std::thread::id> m_threadId{std::thread::id()};
+    mutable std::mutex m_mutex;
+    std::vector<Zone> m_zones;
+    // Number of zones written since Start(), the next zone is written to
+    // m_zones[m_written % kZonesPerThread].
+    uint64_t m_written = 0;
+  };
+
+  Profiler() = default;
+
+  ThreadZones * GetThreadZones();
+
+  std::atomic<bool> m_isEnabled{false};
+  std::atomic<int64_t> m_startTimeInUs{0};
+  std::atomic<uint64_t> m_droppedZonesCount{0};
+
+  std::array<ThreadZones, kMaxThreads> m_threads;
+  std::atomic<size_t> m_threadsCount{0};
+
+  mutable std::mutex m_mutex;
+  std::map<std::string, std::unique_ptr<ProfilerCounter>> m_counters;
+  std::map<std::string, std::unique_ptr<ProfilerHistogram>> m_histograms;
+
+  DISALLOW_COPY_AND_MOVE(Profiler);
+};
+
+// Monotonic counter of events, e.g. number of features read.
+class ProfilerCounter
+{
+public:
+  void Add(uint64_t value = 1)
+  {
+    if (Profiler::Instance().IsEnabled())
+      m_value.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  uint64_t GetValue() const { return m_value.load(std::memory_order_relaxed); }
+  void Reset() { m_value = 0; }
+
+private:
+  std::atomic<uint64_t> m_value{0};
+};
+
+// Distribution of values by buckets [0, 1), [1, 2), [2, 4), [4, 8), ...
+class ProfilerHistogram
+{
+public:
+  static size_t constexpr kBucketsCount = 65;
+
+  void Add(uint64_t value);
+
+  uint64_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+  uint64_t GetSum() const { return m_sum.load(std::memory_order_relaxed); }
+  uint64_t GetBucketCount(size_t bucket) const;
+  // Returns the lower bound of values of |bucket|.
+  static uint64_t GetBucketLowerBound(size_t bucket);
+  void Reset();
+
+private:
+  std::array<std::atomic<uint64_t>, kBucketsCount> m_buckets{};
+  std::atomic<uint64_t> m_count{0};
+  std::atomic<uint64_t> m_sum{0};
+};
+
+// Adds a zone for the scope lifetime. |name| and |category| must be string literals.
+class ProfilerZone
+{
+public:
+  ProfilerZone(char const * name, char const * category)
+    : m_name(name), m_category(category), m_isEnabled(Profiler::Instance().IsEnabled())
+  {
+    if (m_isEnabled)
+      m_start = Profiler::Clock::now();
+  }
+
+  ~ProfilerZone()
+  {
+    if (m_isEnabled)
+      Profiler::Instance().AddZone(m_name, m_category, m_start, Profiler::Clock::now());
+  }
+
+private:
+  char const * m_name;
+  char const * m_category;
+  bool m_isEnabled;
+  Profiler::Clock::time_point m_start;
+
+  DISALLOW_COPY_AND_MOVE(ProfilerZone);
+};
+}  // namespace base
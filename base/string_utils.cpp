@@ -19,8 +19,79 @@
 #pragma clang diagnostic pop
 #endif
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define STRING_UTILS_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define STRING_UTILS_NEON
+#endif
+
 namespace strings
 {
+namespace
+{
+// Returns the position of the first byte of |s| which is not ASCII or |size|.
+size_t FindNonASCII(char const * s, size_t size)
+{
+  size_t i = 0;
+#if defined(STRING_UTILS_SSE2)
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(s + i));
+    int const mask = _mm_movemask_epi8(v);
+    if (mask != 0)
+      return i + __builtin_ctz(static_cast<unsigned>(mask));
+  }
+#elif defined(STRING_UTILS_NEON)
+  for (; i + 16 <= size; i += 16)
+  {
+    if (vmaxvq_u8(vld1q_u8(reinterpret_cast<uint8_t const *>(s + i))) >= 0x80)
+      break;
+  }
+#endif
+  for (; i < size; ++i)
+  {
+    if (s[i] & 0x80)
+      return i;
+  }
+  return size;
+}
+
+void MakeLowerCaseASCIIInplace(char * s, size_t size)
+{
+  size_t i = 0;
+#if defined(STRING_UTILS_SSE2)
+  __m128i const beforeA = _mm_set1_epi8('A' - 1);
+  __m128i const afterZ = _mm_set1_epi8('Z' + 1);
+  __m128i const diff = _mm_set1_epi8('a' - 'A');
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i * p = reinterpret_cast<__m128i *>(s + i);
+    __m128i const v = _mm_loadu_si128(p);
+    __m128i const upper = _mm_and_si128(_mm_cmpgt_epi8(v, beforeA), _mm_cmplt_epi8(v, afterZ));
+    _mm_storeu_si128(p, _mm_or_si128(v, _mm_and_si128(upper, diff)));
+  }
+#elif defined(STRING_UTILS_NEON)
+  uint8x16_t const a = vdupq_n_u8('A');
+  uint8x16_t const z = vdupq_n_u8('Z');
+  uint8x16_t const diff = vdupq_n_u8('a' - 'A');
+  for (; i + 16 <= size; i += 16)
+  {
+    uint8_t * p = reinterpret_cast<uint8_t *>(s + i);
+    uint8x16_t const v = vld1q_u8(p);
+    uint8x16_t const upper = vandq_u8(vcgeq_u8(v, a), vcleq_u8(v, z));
+    vst1q_u8(p, vorrq_u8(v, vandq_u8(upper, diff)));
+  }
+#endif
+  for (; i < size; ++i)
+  {
+    if (s[i] >= 'A' && s[i] <= 'Z')
+      s[i] += 'a' - 'A';
+  }
+}
+}  // namespace
+
 bool UniString::IsEqualAscii(char const * s) const
 {
   return (size() == strlen(s) && std::equal(begin(), end(), s));
@@ -129,6 +200,13 @@ UniString MakeLowerCase(UniString const & s)
 
 void MakeLowerCaseInplace(std::string & s)
 {
+  // Case folding of ASCII doesn't change the length of the string.
+  if (FindNonASCII(s.data(), s.size()) == s.size())
+  {
+    MakeLowerCaseASCIIInplace(&s[0], s.size());
+    return;
+  }
+
   UniString uniStr;
   utf8::unchecked::utf8to32(s.begin(), s.end(), std::back_inserter(uniStr));
   MakeLowerCaseInplace(uniStr);
@@ -225,10 +303,21 @@ bool EqualNoCase(std::string const & s1, std::string const & s2)
 UniString MakeUniString(std::string const & utf8s)
 {
   UniString result;
-  utf8::unchecked::utf8to32(utf8s.begin(), utf8s.end(), std::back_inserter(result));
+  MakeUniStringInplace(utf8s, result);
   return result;
 }
 
+void MakeUniStringInplace(std::string const & utf8s, UniString & result)
+{
+  result.clear();
+  size_t const prefix = FindNonASCII(utf8s.data(), utf8s.size());
+  result.reserve(prefix);
+  // ASCII chars are code points.
+  for (size_t i = 0; i < prefix; ++i)
+    result.push_back(static_cast<UniChar>(utf8s[i]));
+  utf8::unchecked::utf8to32(utf8s.begin() + prefix, utf8s.end(), std::back_inserter(result));
+}
+
 std::string ToUtf8(UniString const & s)
 {
   std::string result;
@@ -238,10 +327,7 @@ std::string ToUtf8(UniString const & s)
 
 bool IsASCIIString(std::string const & str)
 {
-  for (size_t i = 0; i < str.size(); ++i)
-    if (str[i] & 0x80)
-      return false;
-  return true;
+  return FindNonASCII(str.data(), str.size()) == str.size();
 }
 
 bool IsASCIIDigit(UniChar c) { return c >= '0' && c <= '9'; }
@@ -348,6 +434,12 @@ bool AlmostEqual(std::string const & str1, std::string const & str2, size_t mism
   return false;
 }
 
+void TokenizeToViews(std::string const & str, char const * delims, std::vector<StringView> & tokens)
+{
+  tokens.clear();
+  ForEachTokenView(str, delims, [&tokens](StringView token) { tokens.push_back(token); });
+}
+
 void ParseCSVRow(std::string const & s, char const delimiter, std::vector<std::string> & target)
 {
   target.clear();
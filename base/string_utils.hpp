@@ -12,6 +12,9 @@
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <vector>
+
+#include <boost/utility/string_view.hpp>
 
 #include "3party/utfcpp/source/utf8/unchecked.h"
 
@@ -21,6 +24,9 @@ namespace strings
 using UniChar = uint32_t;
 // typedef buffer_vector<UniChar, 32> UniString;
 
+// Same as std::string_view, which is not available until C++17.
+using StringView = boost::string_view;
+
 /// Make new type, not typedef. Need to specialize DebugPrint.
 class UniString : public buffer_vector<UniChar, 32>
 {
@@ -54,6 +60,34 @@ public:
   }
 };
 
+/// Non-owning range of characters of UniString, e.g. a token of it.
+/// *NOTE* The string must outlive the view.
+class UniStringView
+{
+public:
+  UniStringView() = default;
+  UniStringView(UniChar const * b, UniChar const * e) : m_begin(b), m_end(e) {}
+  UniStringView(UniString const & s) : m_begin(s.begin()), m_end(s.end()) {}
+
+  UniChar const * begin() const { return m_begin; }
+  UniChar const * end() const { return m_end; }
+  size_t size() const { return static_cast<size_t>(m_end - m_begin); }
+  bool empty() const { return m_begin == m_end; }
+  UniChar operator[](size_t i) const { return m_begin[i]; }
+
+  UniString ToUniString() const { return UniString(m_begin, m_end); }
+
+  bool operator==(UniStringView const & rhs) const
+  {
+    return size() == rhs.size() && std::equal(m_begin, m_end, rhs.m_begin);
+  }
+  bool operator!=(UniStringView const & rhs) const { return !(*this == rhs); }
+
+private:
+  UniChar const * m_begin = nullptr;
+  UniChar const * m_end = nullptr;
+};
+
 /// Performs full case folding for string to make it search-compatible according
 /// to rules in ftp://ftp.unicode.org/Public/UNIDATA/CaseFolding.txt
 /// For implementation @see base/lower_case.cpp
@@ -88,6 +122,8 @@ std::string MakeLowerCase(std::string const & s);
 bool EqualNoCase(std::string const & s1, std::string const & s2);
 
 UniString MakeUniString(std::string const & utf8s);
+// Same as above, but reuses memory of |result|.
+void MakeUniStringInplace(std::string const & utf8s, UniString & result);
 std::string ToUtf8(UniString const & s);
 bool IsASCIIString(std::string const & str);
 bool IsASCIIDigit(UniChar c);
@@ -132,6 +168,19 @@ public:
     return UniString(m_start, m_end);
   }
 
+  // Same as operator*() and GetUniString() but the token is not copied.
+  StringView GetView() const
+  {
+    ASSERT(m_start != m_finish, ("Dereferencing of empty iterator."));
+    return StringView(&*m_start.base(), static_cast<size_t>(m_end.base() - m_start.base()));
+  }
+
+  UniStringView GetUniStringView() const
+  {
+    ASSERT(m_start != m_finish, ("Dereferencing of empty iterator."));
+    return UniStringView(m_start, m_end);
+  }
+
   operator bool() const { return m_start != m_finish; }
 
   TokenizeIterator & operator++()
@@ -219,6 +268,20 @@ public:
     return UniString(m_start, m_end);
   }
 
+  // Same as operator*() and GetUniString() but the token is not copied.
+  StringView GetView() const
+  {
+    ASSERT(!m_finished, ("Dereferencing of empty iterator."));
+    return StringView(m_start.base() == m_end.base() ? nullptr : &*m_start.base(),
+                      static_cast<size_t>(m_end.base() - m_start.base()));
+  }
+
+  UniStringView GetUniStringView() const
+  {
+    ASSERT(!m_finished, ("Dereferencing of empty iterator."));
+    return UniStringView(m_start, m_end);
+  }
+
   operator bool() const { return !m_finished; }
 
   TokenizeIterator & operator++()
@@ -324,6 +387,19 @@ Collection<std::string> Tokenize(std::string const & str, char const * delims)
 static_assert(std::is_same<std::vector<std::string>, decltype(strings::Tokenize("", ""))>::value,
               "Tokenize() should return vector<string> by default.");
 
+/// Same as Tokenize() but |f| is called with views of |str|, so tokens are not copied.
+template <typename TFunctor>
+void ForEachTokenView(std::string const & str, char const * delims, TFunctor && f)
+{
+  for (SimpleTokenizer iter(str, delims); iter; ++iter)
+    f(iter.GetView());
+}
+
+/// Puts views of tokens of |str| to |tokens|. |tokens| is cleared but its memory is reused,
+/// so it's better to call it in loops over many strings with the same |tokens|.
+/// *NOTE* |str| must outlive |tokens|.
+void TokenizeToViews(std::string const & str, char const * delims, std::vector<StringView> & tokens);
+
 /// Splits a string by the delimiter, keeps empty parts, on an empty string returns an empty vector.
 /// Does not support quoted columns, newlines in columns and escaped quotes.
 void ParseCSVRow(std::string const & s, char const delimiter, std::vector<std::string> & target);
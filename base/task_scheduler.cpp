@@ -0,0 +1,157 @@
+#include "base/task_scheduler.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace base
+{
+// static
+size_t constexpr TaskScheduler::kPrioritiesCount;
+
+TaskScheduler::TaskScheduler(size_t threadsCount)
+{
+  threadsCount = max(threadsCount, static_cast<size_t>(1));
+  for (auto & count : m_pendingCounts)
+    count.store(0);
+
+  m_workers.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_workers.emplace_back(make_unique<Worker>());
+
+  m_threads.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_threads.emplace_back(threads::SimpleThread(&TaskScheduler::ProcessTasks, this, i));
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  ShutdownAndJoin();
+}
+
+bool TaskScheduler::Push(Priority priority, Task && task)
+{
+  return Push(priority, nullptr /* cancellable */, move(task));
+}
+
+bool TaskScheduler::Push(Priority priority, shared_ptr<Cancellable> const & cancellable,
+                         Task && task)
+{
+  CHECK_LESS(priority, Priority::Count, ());
+  if (m_shutdown)
+    return false;
+
+  size_t const p = static_cast<size_t>(priority);
+  Worker & worker = *m_workers[GetPushWorker()];
+  {
+    lock_guard<mutex> lock(worker.m_mutex);
+    worker.m_queues[p].push_back({move(task), cancellable});
+    ++m_pendingCounts[p];
+  }
+
+  ++m_pendingCount;
+  {
+    // Sleeping workers check the counter under |m_mutex|, so the notification can't be lost
+    // between their check and wait.
+    lock_guard<mutex> lock(m_mutex);
+  }
+  m_cv.notify_one();
+  return true;
+}
+
+void TaskScheduler::ShutdownAndJoin()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_shutdown)
+      return;
+    m_shutdown = true;
+  }
+  m_cv.notify_all();
+
+  for (auto & thread : m_threads)
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+  m_threads.clear();
+}
+
+void TaskScheduler::ProcessTasks(size_t workerIndex)
+{
+  m_workers[workerIndex]->m_threadId = this_thread::get_id();
+
+  QueuedTask task;
+  while (!m_shutdown)
+  {
+    if (Pop(workerIndex, task))
+    {
+      if (!task.m_cancellable || !task.m_cancellable->IsCancelled())
+        task.m_task();
+      task = QueuedTask();
+      continue;
+    }
+
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_shutdown || m_pendingCount != 0; });
+  }
+}
+
+bool TaskScheduler::Pop(size_t workerIndex, QueuedTask & task)
+{
+  size_t const workersCount = m_workers.size();
+  for (size_t p = 0; p < kPrioritiesCount; ++p)
+  {
+    if (m_pendingCounts[p] == 0)
+      continue;
+
+    for (size_t i = 0; i < workersCount; ++i)
+    {
+      if (PopFrom(*m_workers[(workerIndex + i) % workersCount], p, task))
+        return true;
+    }
+  }
+  return false;
+}
+
+bool TaskScheduler::PopFrom(Worker & worker, size_t priority, QueuedTask & task)
+{
+  lock_guard<mutex> lock(worker.m_mutex);
+  auto & queue = worker.m_queues[priority];
+  if (queue.empty())
+    return false;
+
+  task = move(queue.front());
+  queue.pop_front();
+  --m_pendingCounts[priority];
+  --m_pendingCount;
+  return true;
+}
+
+size_t TaskScheduler::GetPushWorker()
+{
+  auto const id = this_thread::get_id();
+  for (size_t i = 0; i < m_workers.size(); ++i)
+  {
+    if (m_workers[i]->m_threadId == id)
+      return i;
+  }
+  return m_nextWorker++ % m_workers.size();
+}
+
+string DebugPrint(TaskScheduler::Priority priority)
+{
+  switch (priority)
+  {
+  case TaskScheduler::Priority::UiCritical: return "UiCritical";
+  case TaskScheduler::Priority::RenderBackend: return "RenderBackend";
+  case TaskScheduler::Priority::Routing: return "Routing";
+  case TaskScheduler::Priority::Search: return "Search";
+  case TaskScheduler::Priority::BackgroundIo: return "BackgroundIo";
+  case TaskScheduler::Priority::Count: return "Count";
+  }
+  CHECK_SWITCH();
+}
+}  // namespace base
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "base/cancellable.hpp"
+#include "base/macros.hpp"
+#include "base/thread.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace base
+{
+// A pool of threads shared by subsystems instead of their own threads.
+//
+// Every worker has a queue per priority. Tasks pushed from a worker go to its own queues and
+// tasks pushed from other threads are distributed between workers round-robin. A worker
+// takes the oldest task of the highest priority available: from its own queues first,
+// otherwise it steals from the queues of other workers. So a long task doesn't block the tasks queued
+// after it while other workers are idle.
+//
+// Priorities only order tasks, thread priorities of the OS are not changed. Tasks are not
+// interrupted: a task pushed with a Cancellable is skipped if it's cancelled before it's
+// started, and the task itself may check the Cancellable while it runs.
+//
+// *NOTE* Tasks of any priority may run in parallel. Subsystems which need their tasks to be
+// executed one by one should keep using WorkerThread.
+class TaskScheduler
+{
+public:
+  using Task = std::function<void()>;
+
+  enum class Priority : uint8_t
+  {
+    UiCritical,
+    RenderBackend,
+    Routing,
+    Search,
+    BackgroundIo,
+
+    Count
+  };
+
+  explicit TaskScheduler(size_t threadsCount = std::thread::hardware_concurrency());
+  ~TaskScheduler();
+
+  // Returns false when the scheduler is shut down.
+  bool Push(Priority priority, Task && task);
+  bool Push(Priority priority, std::shared_ptr<Cancellable> const & cancellable, Task && task);
+
+  // Waits for the running tasks and stops the workers. Pending tasks are not executed.
+  void ShutdownAndJoin();
+
+  size_t GetThreadsCount() const { return m_workers.size(); }
+
+private:
+  static size_t constexpr kPrioritiesCount = static_cast<size_t>(Priority::Count);
+
+  struct QueuedTask
+  {
+    Task m_task;
+    std::shared_ptr<Cancellable> m_cancellable;
+  };
+
+  struct Worker
+  {
+    std::mutex m_mutex;
+    std::array<std::deque<QueuedTask>, kPrioritiesCount> m_queues;
+    std::atomic<std::thread::id> m_threadId{std::thread::id()};
+  };
+
+  void ProcessTasks(size_t workerIndex);
+  bool Pop(size_t workerIndex, QueuedTask & task);
+  bool PopFrom(Worker & worker, size_t priority, QueuedTask & task);
+  // Returns the index of the worker which runs the current thread or the next worker
+  // round-robin.
+  size_t GetPushWorker();
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::vector<threads::SimpleThread> m_threads;
+  std::array<std::atomic<size_t>, kPrioritiesCount> m_pendingCounts;
+  std::atomic<size_t> m_pendingCount{0};
+  std::atomic<size_t> m_nextWorker{0};
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::atomic<bool> m_shutdown{false};
+
+  DISALLOW_COPY_AND_MOVE(TaskScheduler);
+};
+
+std::string DebugPrint(TaskScheduler::Priority priority);
+}  // namespace base
@@ -73,6 +73,11 @@ namespace threads
       m_tasks.PushFront(routine);
     }
 
+    void ProcessTasks(TProcessTasksFn const & fn)
+    {
+      m_tasks.ProcessList(fn);
+    }
+
     threads::IRoutine * PopFront()
     {
       return m_tasks.Front(true);
@@ -129,6 +134,11 @@ namespace threads
     m_impl->PushFront(routine);
   }
 
+  void ThreadPool::ProcessTasks(TProcessTasksFn const & fn)
+  {
+    m_impl->ProcessTasks(fn);
+  }
+
   void ThreadPool::Stop()
   {
     m_impl->Stop();
@@ -3,12 +3,14 @@
 #include "base/base.hpp"
 
 #include <functional>
+#include <list>
 
 namespace threads
 {
   class IRoutine;
 
   typedef std::function<void(threads::IRoutine *)> TFinishRoutineFn;
+  typedef std::function<void(std::list<threads::IRoutine *> & tasks)> TProcessTasksFn;
 
   class ThreadPool
   {
@@ -19,6 +21,11 @@ namespace threads
     // ThreadPool will not delete routine. You can delete it in finish_routine_fn if need
     void PushBack(threads::IRoutine * routine);
     void PushFront(threads::IRoutine * routine);
+
+    // Calls |fn| for the queue of not started tasks under the lock of the queue, so tasks
+    // may be reordered, e.g. by their priorities. |fn| must not remove tasks from the queue.
+    void ProcessTasks(TProcessTasksFn const & fn);
+
     void Stop();
 
   private:
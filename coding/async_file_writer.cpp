@@ -0,0 +1,185 @@
+#include "coding/async_file_writer.hpp"
+
+#include "coding/internal/file_data.hpp"
+
+#include "base/assert.hpp"
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+size_t constexpr kAlignment = 4096;
+}  // namespace
+
+size_t constexpr AsyncFileWriter::kDefaultBufferSize;
+
+AsyncFileWriter::Buffer::Buffer(size_t capacity) : m_storage(capacity + kAlignment)
+{
+  void * data = m_storage.data();
+  size_t space = m_storage.size();
+  m_data = static_cast<uint8_t *>(align(kAlignment, capacity, data, space));
+  CHECK(m_data, ());
+}
+
+AsyncFileWriter::AsyncFileWriter(string const & fileName, FileWriter::Op operation,
+                                 size_t bufferSize)
+  : m_fileData(make_unique<base::FileData>(fileName, static_cast<base::FileData::Op>(operation)))
+  , m_bufferSize(bufferSize)
+  , m_current(bufferSize)
+  , m_writing(bufferSize)
+{
+  CHECK_GREATER(m_bufferSize, 0, ());
+  m_pos = m_fileData->Pos();
+  m_current.m_pos = m_pos;
+  m_thread = thread(&AsyncFileWriter::ThreadRoutine, this);
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+  try
+  {
+    Flush();
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LERROR, ("Error writing file", GetName(), e.Msg()));
+  }
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_stopped = true;
+  }
+  m_cv.notify_all();
+  m_thread.join();
+}
+
+void AsyncFileWriter::Seek(uint64_t pos)
+{
+  if (pos == m_pos)
+    return;
+
+  Submit();
+  m_pos = pos;
+  m_current.m_pos = pos;
+}
+
+uint64_t AsyncFileWriter::Pos() const { return m_pos; }
+
+void AsyncFileWriter::Write(void const * p, size_t size)
+{
+  auto const * src = static_cast<uint8_t const *>(p);
+  while (size > 0)
+  {
+    if (m_current.m_size == m_bufferSize)
+      Submit();
+
+    size_t const partSize = min(size, m_bufferSize - m_current.m_size);
+    memcpy(m_current.m_data + m_current.m_size, src, partSize);
+    m_current.m_size += partSize;
+    m_pos += partSize;
+    src += partSize;
+    size -= partSize;
+  }
+}
+
+void AsyncFileWriter::Flush()
+{
+  Submit();
+  {
+    unique_lock<mutex> lock(m_mutex);
+    WaitForWriting(lock);
+  }
+  RethrowError();
+  m_fileData->Flush();
+}
+
+uint64_t AsyncFileWriter::Size()
+{
+  Flush();
+  return m_fileData->Size();
+}
+
+void AsyncFileWriter::Reserve(uint64_t size)
+{
+  {
+    unique_lock<mutex> lock(m_mutex);
+    WaitForWriting(lock);
+  }
+  RethrowError();
+  if (!m_fileData->Preallocate(size))
+    LOG(LDEBUG, ("Disk space is not preallocated for", GetName()));
+}
+
+string const & AsyncFileWriter::GetName() const { return m_fileData->GetName(); }
+
+void AsyncFileWriter::Submit()
+{
+  {
+    unique_lock<mutex> lock(m_mutex);
+    WaitForWriting(lock);
+    if (m_current.m_size != 0)
+    {
+      swap(m_current, m_writing);
+      m_hasWriting = true;
+    }
+  }
+  m_cv.notify_all();
+
+  m_current.m_size = 0;
+  m_current.m_pos = m_pos;
+  RethrowError();
+}
+
+void AsyncFileWriter::WaitForWriting(unique_lock<mutex> & lock)
+{
+  m_cv.wait(lock, [this]() { return !m_hasWriting; });
+}
+
+void AsyncFileWriter::RethrowError()
+{
+  exception_ptr error;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    swap(error, m_error);
+  }
+  if (error)
+    rethrow_exception(error);
+}
+
+void AsyncFileWriter::ThreadRoutine()
+{
+  unique_lock<mutex> lock(m_mutex);
+  while (true)
+  {
+    m_cv.wait(lock, [this]() { return m_hasWriting || m_stopped; });
+    if (!m_hasWriting)
+      return;
+
+    // The producer doesn't touch the buffer being written, so the lock is not needed.
+    lock.unlock();
+    exception_ptr error;
+    try
+    {
+      // The file is not seeked for sequential writing, it is not allowed for OP_APPEND.
+      if (m_fileData->Pos() != m_writing.m_pos)
+        m_fileData->Seek(m_writing.m_pos);
+      m_fileData->Write(m_writing.m_data, m_writing.m_size);
+    }
+    catch (Writer::Exception const &)
+    {
+      error = current_exception();
+    }
+    lock.lock();
+
+    if (error && !m_error)
+      m_error = error;
+    m_hasWriting = false;
+    m_cv.notify_all();
+  }
+}
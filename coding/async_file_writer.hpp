@@ -0,0 +1,89 @@
+#pragma once
+
+#include "coding/file_writer.hpp"
+#include "coding/writer.hpp"
+
+#include "base/base.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace base
+{
+class FileData;
+}
+
+// Writer of big output files, e.g. intermediate files of the generator.
+// Data are collected in a large buffer which is written to the file by a background thread
+// while the next buffer is filled, so the producer doesn't wait for the disk.
+// Errors of the background writing are rethrown by the next Write(), Seek() or Flush().
+// Not thread safe.
+class AsyncFileWriter : public Writer
+{
+  DISALLOW_COPY_AND_MOVE(AsyncFileWriter);
+
+public:
+  static size_t constexpr kDefaultBufferSize = 16 * 1024 * 1024;
+
+  explicit AsyncFileWriter(std::string const & fileName,
+                           FileWriter::Op operation = FileWriter::OP_WRITE_TRUNCATE,
+                           size_t bufferSize = kDefaultBufferSize);
+  ~AsyncFileWriter() override;
+
+  // Writer overrides:
+  void Seek(uint64_t pos) override;
+  uint64_t Pos() const override;
+  void Write(void const * p, size_t size) override;
+
+  // Waits until all the written data are passed to the file.
+  void Flush();
+  uint64_t Size();
+
+  // Allocates disk space for |size| bytes to avoid fragmentation of the file.
+  // The size of the file is not changed. Does nothing if it is not supported by the platform.
+  void Reserve(uint64_t size);
+
+  std::string const & GetName() const;
+
+private:
+  // Data of the buffer are aligned by the page size.
+  struct Buffer
+  {
+    explicit Buffer(size_t capacity);
+
+    std::vector<uint8_t> m_storage;
+    uint8_t * m_data = nullptr;
+    size_t m_size = 0;
+    // Position of the buffer in the file.
+    uint64_t m_pos = 0;
+  };
+
+  // Passes the current buffer to the background thread.
+  void Submit();
+  // Waits until the background thread writes the submitted buffer.
+  void WaitForWriting(std::unique_lock<std::mutex> & lock);
+  void RethrowError();
+  void ThreadRoutine();
+
+  std::unique_ptr<base::FileData> m_fileData;
+  size_t const m_bufferSize;
+
+  Buffer m_current;
+  uint64_t m_pos = 0;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  Buffer m_writing;
+  bool m_hasWriting = false;
+  bool m_stopped = false;
+  std::exception_ptr m_error;
+
+  std::thread m_thread;
+};
@@ -1,8 +1,11 @@
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 
 #include "coding/compressed_bit_vector.hpp"
 #include "coding/writer.hpp"
 
+#include "base/macros.hpp"
+
 #include "std/algorithm.hpp"
 #include "std/iterator.hpp"
 #include "std/set.hpp"
@@ -467,3 +470,111 @@ UNIT_TEST(CompressedBitVector_SparseLeaveFirstNBits)
   for (uint64_t bit = 0; bit < (1 << 10); ++bit)
     TEST(!cbv->GetBit(bit), (bit));
 }
+
+UNIT_TEST(CompressedBitVector_IntersectSkewedSparse)
+{
+  vector<uint64_t> setBits1;
+  vector<uint64_t> setBits2;
+  for (uint64_t i = 0; i < 100000; ++i)
+  {
+    if (i % 7 == 0)
+      setBits1.push_back(i);
+    if (i % 1000 == 0 || i % 1001 == 0)
+      setBits2.push_back(i);
+  }
+  // The last position of the smaller vector is beyond the end of the larger one.
+  setBits2.push_back(200000);
+
+  auto cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+  auto cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Sparse, cbv1->GetStorageStrategy(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Sparse, cbv2->GetStorageStrategy(), ());
+
+  auto cbv3 = coding::CompressedBitVector::Intersect(*cbv1, *cbv2);
+  CheckIntersection(setBits1, setBits2, *cbv3);
+  auto cbv4 = coding::CompressedBitVector::Intersect(*cbv2, *cbv1);
+  CheckIntersection(setBits1, setBits2, *cbv4);
+}
+
+UNIT_TEST(CompressedBitVector_DenseOpsWithDifferentSizes)
+{
+  vector<uint64_t> setBits1;
+  vector<uint64_t> setBits2;
+  for (uint64_t i = 0; i < 1000; ++i)
+  {
+    if (i % 2 == 0)
+      setBits1.push_back(i);
+    if (i < 300 && i % 3 == 0)
+      setBits2.push_back(i);
+  }
+
+  auto cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+  auto cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv1->GetStorageStrategy(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv2->GetStorageStrategy(), ());
+
+  CheckIntersection(setBits1, setBits2, *coding::CompressedBitVector::Intersect(*cbv1, *cbv2));
+  CheckSubtraction(setBits1, setBits2, *coding::CompressedBitVector::Subtract(*cbv1, *cbv2));
+  CheckSubtraction(setBits2, setBits1, *coding::CompressedBitVector::Subtract(*cbv2, *cbv1));
+  CheckUnion(setBits1, setBits2, *coding::CompressedBitVector::Union(*cbv1, *cbv2));
+  CheckUnion(setBits2, setBits1, *coding::CompressedBitVector::Union(*cbv2, *cbv1));
+
+  vector<uint64_t> positions;
+  coding::CompressedBitVectorEnumerator::ForEach(*cbv1,
+                                                 [&](uint64_t pos) { positions.push_back(pos); });
+  TEST_EQUAL(positions, setBits1, ());
+}
+
+#ifndef DEBUG
+namespace
+{
+// Every |step|-th position out of |numBits| is set, like in a posting list of a query token.
+unique_ptr<coding::CompressedBitVector> MakeCBV(uint64_t numBits, uint64_t step)
+{
+  vector<uint64_t> setBits;
+  for (uint64_t i = 0; i < numBits; i += step)
+    setBits.push_back(i);
+  return coding::CompressedBitVectorBuilder::FromBitPositions(move(setBits));
+}
+}  // namespace
+
+BENCHMARK_TEST(CompressedBitVector_IntersectDense)
+{
+  auto const cbv1 = MakeCBV(1000000, 2);
+  auto const cbv2 = MakeCBV(1000000, 3);
+  BENCHMARK_N_TIMES(1000, 1.0)
+  {
+    FORCE_USE_VALUE(coding::CompressedBitVector::Intersect(*cbv1, *cbv2)->PopCount());
+  }
+}
+
+BENCHMARK_TEST(CompressedBitVector_UnionDense)
+{
+  auto const cbv1 = MakeCBV(1000000, 2);
+  auto const cbv2 = MakeCBV(500000, 3);
+  BENCHMARK_N_TIMES(1000, 1.0)
+  {
+    FORCE_USE_VALUE(coding::CompressedBitVector::Union(*cbv1, *cbv2)->PopCount());
+  }
+}
+
+BENCHMARK_TEST(CompressedBitVector_IntersectDenseSparse)
+{
+  auto const cbv1 = MakeCBV(1000000, 2);
+  auto const cbv2 = MakeCBV(1000000, 97);
+  BENCHMARK_N_TIMES(1000, 1.0)
+  {
+    FORCE_USE_VALUE(coding::CompressedBitVector::Intersect(*cbv1, *cbv2)->PopCount());
+  }
+}
+
+BENCHMARK_TEST(CompressedBitVector_IntersectSkewedSparse)
+{
+  auto const cbv1 = MakeCBV(1000000, 5);
+  auto const cbv2 = MakeCBV(1000000, 997);
+  BENCHMARK_N_TIMES(10000, 1.0)
+  {
+    FORCE_USE_VALUE(coding::CompressedBitVector::Intersect(*cbv1, *cbv2)->PopCount());
+  }
+}
+#endif
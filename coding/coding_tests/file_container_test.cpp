@@ -206,6 +206,43 @@ UNIT_TEST(FilesContainer_RewriteExisting)
   FileWriter::DeleteFileX(fName);
 }
 
+#ifndef OMIM_OS_WINDOWS
+UNIT_TEST(FilesContainer_Mapped)
+{
+  string const fName = "file_container.tmp";
+  FileWriter::DeleteFileX(fName);
+
+  char const * key[] = { "1", "2", "3" };
+  char const * value[] = { "prolog", "data", "epilog" };
+  {
+    FilesContainerW writer(fName);
+    for (size_t i = 0; i < ARRAY_SIZE(key); ++i)
+    {
+      FileWriter w = writer.GetWriter(key[i]);
+      w.Write(value[i], strlen(value[i]));
+    }
+  }
+
+  {
+    FilesContainerR const reader = FilesContainerR::CreateMapped(fName);
+    for (size_t i = 0; i < ARRAY_SIZE(key); ++i)
+    {
+      FilesContainerR::TReader const r = reader.GetReader(key[i]);
+      r.Advise(ModelReader::Advice::Sequential);
+
+      string s(static_cast<size_t>(r.Size()), ' ');
+      r.Read(0, &s[0], s.size());
+      TEST_EQUAL(s, value[i], ());
+
+      TEST_EQUAL(reader.GetAbsoluteOffsetAndSize(key[i]).second, strlen(value[i]), ());
+      r.Advise(ModelReader::Advice::Normal);
+    }
+  }
+
+  FileWriter::DeleteFileX(fName);
+}
+#endif
+
 UNIT_TEST(FilesMappingContainer_Handle)
 {
   string const fName = "file_container.tmp";
@@ -8,14 +8,17 @@
 
 namespace
 {
-  void TestFileSorter(vector<uint32_t> & data, char const * tmpFileName, size_t bufferSize)
+  template <template <typename LessT> class SorterT = Sorter>
+  void TestFileSorter(vector<uint32_t> & data, char const * tmpFileName, size_t bufferSize,
+                      size_t threadsCount = 1)
   {
     vector<char> serial;
     typedef MemWriter<vector<char> > MemWriterType;
     MemWriterType writer(serial);
     typedef WriterFunctor<MemWriterType> OutT;
     OutT out(writer);
-    FileSorter<uint32_t, OutT> sorter(bufferSize, tmpFileName, out);
+    FileSorter<uint32_t, OutT, less<uint32_t>, SorterT> sorter(bufferSize, tmpFileName, out,
+                                                               less<uint32_t>(), threadsCount);
     for (size_t i = 0; i < data.size(); ++i)
       sorter.Add(data[i]);
     sorter.SortAndFinish();
@@ -49,3 +52,65 @@ UNIT_TEST(FileSorter_Random)
 
   TestFileSorter(data, "file_sorter_test_random.tmp", data.size() / 10);
 }
+
+UNIT_TEST(FileSorter_Parallel)
+{
+  mt19937 rng(0);
+  vector<uint32_t> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = rng() % 100000;
+
+  TestFileSorter(data, "file_sorter_test_parallel.tmp", 4000, 4 /* threadsCount */);
+  TestFileSorter<RadixSorter>(data, "file_sorter_test_parallel_radix.tmp", 4000,
+                              4 /* threadsCount */);
+}
+
+UNIT_TEST(RadixSorter_Smoke)
+{
+  // Items are ordered by the key, then by the comparator.
+  struct Item
+  {
+    uint64_t GetSortKey() const { return m_key; }
+    bool operator<(Item const & rhs) const
+    {
+      return m_key != rhs.m_key ? m_key < rhs.m_key : m_value < rhs.m_value;
+    }
+    bool operator==(Item const & rhs) const
+    {
+      return m_key == rhs.m_key && m_value == rhs.m_value;
+    }
+
+    uint64_t m_key;
+    uint32_t m_value;
+  };
+
+  mt19937 rng(0);
+  vector<Item> items(10000);
+  for (auto & item : items)
+  {
+    item.m_key = (static_cast<uint64_t>(rng() % 16) << 40) | (rng() % 100);
+    item.m_value = rng();
+  }
+
+  vector<Item> expected = items;
+  sort(expected.begin(), expected.end());
+  RadixSorter<less<Item>> sorter((less<Item>()));
+  sorter(items.begin(), items.end());
+  TEST(items == expected, ());
+}
+
+UNIT_TEST(ParallelSort_Smoke)
+{
+  mt19937 rng(0);
+  for (size_t const size : {0, 1, 1000, 100000})
+  {
+    vector<uint32_t> data(size);
+    for (auto & value : data)
+      value = rng();
+
+    vector<uint32_t> expected = data;
+    sort(expected.begin(), expected.end());
+    ParallelSort(data.begin(), data.end(), less<uint32_t>(), 3 /* threadsCount */);
+    TEST_EQUAL(data, expected, ());
+  }
+}
@@ -6,6 +6,7 @@
 
 #include "base/string_utils.hpp"
 
+#include "std/random.hpp"
 #include "std/vector.hpp"
 
 namespace
@@ -25,6 +26,28 @@ void TestDecode(coding::HuffmanCoder const & h, uint32_t bits, uint32_t len, uin
   TEST(h.Decode(code, received), ("Could not decode", code.bits, "( length", code.len, ")"));
   TEST_EQUAL(expected, received, ());
 }
+
+// Decodes |count| symbols from |bits| by codes, one bit at a time.
+strings::UniString DecodeByCodes(coding::HuffmanCoder const & h, vector<uint8_t> const & data,
+                                 size_t pos, size_t count)
+{
+  strings::UniString result;
+  size_t bit = pos * CHAR_BIT;
+  for (size_t i = 0; i < count; ++i)
+  {
+    coding::HuffmanCoder::Code code;
+    uint32_t symbol;
+    while (!h.Decode(code, symbol))
+    {
+      uint32_t const b = (data[bit / CHAR_BIT] >> (bit % CHAR_BIT)) & 1;
+      code.bits |= b << code.len;
+      ++code.len;
+      ++bit;
+    }
+    result.push_back(symbol);
+  }
+  return result;
+}
 }  // namespace
 
 namespace coding
@@ -127,4 +150,66 @@ UNIT_TEST(Huffman_Serialization_Data)
   TEST_EQUAL(expected, received, ());
 }
 
+UNIT_TEST(Huffman_DecodeSpan)
+{
+  // Fibonacci frequencies make codes of all lengths up to the number of symbols, both
+  // shorter and longer than one table lookup.
+  vector<strings::UniString> strs;
+  uint32_t f0 = 1;
+  uint32_t f1 = 1;
+  for (strings::UniChar c = 0; c < 24; ++c)
+  {
+    strs.emplace_back(static_cast<size_t>(f1), c);
+    swap(f0, f1);
+    f1 += f0;
+  }
+
+  mt19937 rng(0);
+  vector<strings::UniString> texts;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    auto const & s = strs[uniform_int_distribution<size_t>(0, strs.size() - 1)(rng)];
+    strings::UniString text;
+    for (size_t j = uniform_int_distribution<size_t>(0, 300)(rng); j > 0; --j)
+    {
+      text.push_back(s[0]);
+      text.push_back(static_cast<strings::UniChar>(j % strs.size()));
+    }
+    texts.push_back(text);
+  }
+
+  HuffmanCoder h;
+  h.Init(strs);
+
+  vector<uint8_t> buf;
+  vector<size_t> positions;
+  {
+    MemWriter<vector<uint8_t>> writer(buf);
+    for (auto const & text : texts)
+    {
+      positions.push_back(writer.Pos());
+      h.EncodeAndWrite(writer, text);
+    }
+  }
+
+  MemReader memReader(buf.data(), buf.size());
+  ReaderSource<MemReader> reader(memReader);
+  for (size_t i = 0; i < texts.size(); ++i)
+  {
+    TEST_EQUAL(reader.Pos(), positions[i], ());
+    TEST_EQUAL(h.ReadAndDecode(reader), texts[i], ());
+
+    ReaderSource<MemReader> src(memReader);
+    src.Skip(positions[i]);
+    size_t const count = ReadVarUint<uint32_t>(src);
+    TEST_EQUAL(count, texts[i].size(), ());
+    TEST_EQUAL(DecodeByCodes(h, buf, src.Pos(), count), texts[i], ());
+
+    vector<uint32_t> symbols(count);
+    h.DecodeSpan(src, count, symbols.data());
+    TEST(equal(symbols.begin(), symbols.end(), texts[i].begin()), ());
+  }
+  TEST_EQUAL(reader.Pos(), buf.size(), ());
+}
+
 }  // namespace coding
@@ -0,0 +1,31 @@
+#include "testing/testing.hpp"
+
+#include "coding/sha1.hpp"
+
+#include <string>
+
+using namespace std;
+
+UNIT_TEST(SHA1_ForString)
+{
+  TEST_EQUAL(coding::SHA1::CalculateBase64ForString("abc"), "qZk+NkcGgWq6PiVxeFDCbJzQ2J0=", ());
+  TEST_EQUAL(coding::SHA1::CalculateBase64ForString(""), "2jmj7l5rSw0yVb/vlWAYkK/YBwk=", ());
+}
+
+UNIT_TEST(SHA1_Streaming)
+{
+  string data;
+  for (size_t i = 0; i < 10000; ++i)
+    data.push_back(static_cast<char>(i * 31 % 251));
+
+  auto const expected = coding::SHA1::CalculateForString(data);
+
+  coding::SHA1 sha1;
+  for (size_t partSize : {1, 7, 64, 1000})
+  {
+    for (size_t i = 0; i < data.size(); i += partSize)
+      sha1.Update(data.data() + i, min(partSize, data.size() - i));
+    // Final() starts a new calculation.
+    TEST_EQUAL(sha1.Final(), expected, (partSize));
+  }
+}
@@ -0,0 +1,116 @@
+#include "testing/testing.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/reader.hpp"
+#include "coding/shared_page_cache.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+vector<char> MakeData(size_t size)
+{
+  vector<char> data(size);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  return data;
+}
+}  // namespace
+
+UNIT_TEST(SharedPageCache_RandomReads)
+{
+  auto const data = MakeData(100000);
+  MemReader memReader(data.data(), data.size());
+  // There are fewer pages in the cache than pages of the data, so pages are evicted.
+  SharedPageCache cache(16 * 1024 /* memorySize */, 10 /* logPageSize */);
+  auto const fileId = cache.GetFileId("data", data.size());
+  auto & stats = cache.GetTagStats("tag");
+
+  mt19937 rng(0);
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    size_t const pos = rng() % data.size();
+    size_t const len = min(static_cast<size_t>(1 + rng() % 3000), data.size() - pos);
+    string expected(len, '0');
+    string actual(len, '0');
+    memReader.Read(pos, &expected[0], len);
+    cache.Read(fileId, data.size(),
+               [&memReader](uint64_t pagePos, void * p, size_t size)
+               {
+                 memReader.Read(pagePos, p, size);
+               },
+               pos, &actual[0], len, stats);
+    TEST_EQUAL(expected, actual, (pos, len, i));
+  }
+
+  TEST_LESS_OR_EQUAL(cache.GetPagesCount(), 16, ());
+  auto const tagStats = cache.GetStats()["tag"];
+  TEST_EQUAL(tagStats.m_reads, 10000, ());
+  TEST_GREATER(tagStats.m_pageHits, 0, ());
+  TEST_GREATER(tagStats.m_pageMisses, 0, ());
+}
+
+UNIT_TEST(SharedPageCache_FileIds)
+{
+  SharedPageCache cache(SharedPageCache::kDefaultMemorySize);
+  auto const id = cache.GetFileId("a", 10);
+  TEST_EQUAL(id, cache.GetFileId("a", 10), ());
+  TEST_NOT_EQUAL(id, cache.GetFileId("a", 11), ());
+  TEST_NOT_EQUAL(id, cache.GetFileId("b", 10), ());
+}
+
+UNIT_TEST(SharedPageCache_FilesContainer)
+{
+  string const fileName = "shared_page_cache_test.tmp";
+  SCOPE_GUARD(deleteFile, [&fileName]() { FileWriter::DeleteFileX(fileName); });
+
+  auto const data = MakeData(20000);
+  {
+    FilesContainerW writer(fileName);
+    writer.Write(data, "first");
+    writer.Write(data, "second");
+  }
+
+  SharedPageCache cache(SharedPageCache::kDefaultMemorySize);
+  vector<thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      // Each thread has its own readers, pages are shared.
+      FilesContainerR container(fileName, cache);
+      for (auto const & tag : {"first", "second"})
+      {
+        auto const reader = container.GetReader(tag);
+        TEST_EQUAL(reader.Size(), data.size(), ());
+        vector<char> buffer(data.size());
+        reader.Read(0, buffer.data(), buffer.size());
+        TEST_EQUAL(buffer, data, ());
+      }
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  auto stats = cache.GetStats();
+  TEST_EQUAL(stats["first"].m_reads, 4, ());
+  TEST_EQUAL(stats["first"].m_readBytes, 4 * data.size(), ());
+  TEST_EQUAL(stats["second"].m_reads, 4, ());
+
+  // The whole file fits the cache, so the pages are not read again.
+  FilesContainerR container(fileName, cache);
+  vector<char> buffer(data.size());
+  container.GetReader("first").Read(0, buffer.data(), buffer.size());
+  TEST_EQUAL(buffer, data, ());
+  TEST_EQUAL(cache.GetStats()["first"].m_pageMisses, stats["first"].m_pageMisses, ());
+}
@@ -0,0 +1,130 @@
+#include "testing/benchmark.hpp"
+#include "testing/testing.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/reader.hpp"
+#include "coding/stream_vbyte.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+namespace
+{
+vector<uint32_t> MakeValues(size_t count, uint32_t seed)
+{
+  mt19937 rng(seed);
+  vector<uint32_t> values(count);
+  for (auto & value : values)
+  {
+    // Values of all lengths, small ones are more frequent as in mwm sections.
+    uint32_t const bits = rng() % 4 == 0 ? 32 : 4 + rng() % 12;
+    value = bits == 32 ? static_cast<uint32_t>(rng()) : static_cast<uint32_t>(rng() % (1U << bits));
+  }
+  return values;
+}
+
+void TestStreamVByte(vector<uint32_t> const & values)
+{
+  vector<uint8_t> buffer(StreamVByteMaxSize(values.size()));
+  size_t const size = StreamVByteEncode(values.data(), values.size(), buffer.data());
+  TEST_LESS_OR_EQUAL(size, buffer.size(), ());
+
+  vector<uint32_t> decoded(values.size());
+  TEST_EQUAL(StreamVByteDecode(buffer.data(), size, values.size(), decoded.data()), size, ());
+  TEST_EQUAL(decoded, values, ());
+}
+
+vector<uint8_t> WriteBlock(vector<uint32_t> const & values, VarUintBlockFormat format)
+{
+  vector<uint8_t> buffer;
+  MemWriter<vector<uint8_t>> writer(buffer);
+  WriteVarUintBlock(writer, values, format);
+  return buffer;
+}
+}  // namespace
+
+UNIT_TEST(StreamVByte_Smoke)
+{
+  TestStreamVByte({});
+  TestStreamVByte({0});
+  TestStreamVByte({0xFF, 0x100, 0xFFFF, 0x10000, 0xFFFFFF, 0x1000000, 0xFFFFFFFF});
+
+  for (size_t count = 1; count < 40; ++count)
+    TestStreamVByte(MakeValues(count, static_cast<uint32_t>(count)));
+  TestStreamVByte(MakeValues(10000, 0 /* seed */));
+}
+
+UNIT_TEST(StreamVByte_Size)
+{
+  vector<uint32_t> const values = {1, 2, 300, 70000, 1};
+  vector<uint8_t> buffer(StreamVByteMaxSize(values.size()));
+  // Two control bytes, then 1 + 1 + 2 + 3 + 1 bytes of values.
+  TEST_EQUAL(StreamVByteEncode(values.data(), values.size(), buffer.data()), 10, ());
+
+  vector<uint32_t> decoded(values.size());
+  TEST_THROW(StreamVByteDecode(buffer.data(), 9, values.size(), decoded.data()),
+             VarUintBlockException, ());
+  TEST_THROW(StreamVByteDecode(buffer.data(), 1, values.size(), decoded.data()),
+             VarUintBlockException, ());
+}
+
+UNIT_TEST(VarUintBlock_Formats)
+{
+  auto const values = MakeValues(1000, 1 /* seed */);
+  for (auto const format : {VarUintBlockFormat::Varint, VarUintBlockFormat::StreamVByte})
+  {
+    auto const buffer = WriteBlock(values, format);
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+
+    vector<uint32_t> decoded;
+    ReadVarUintBlock(src, decoded);
+    TEST_EQUAL(decoded, values, ());
+    TEST_EQUAL(src.Size(), 0, ());
+  }
+
+  vector<uint8_t> buffer = WriteBlock(values, VarUintBlockFormat::Varint);
+  buffer[0] = 100;
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  vector<uint32_t> decoded;
+  TEST_THROW(ReadVarUintBlock(src, decoded), VarUintBlockException, ());
+}
+
+BENCHMARK_TEST(Varint_Decode)
+{
+  auto const values = MakeValues(100000, 2 /* seed */);
+  vector<uint8_t> buffer;
+  PushBackByteSink<vector<uint8_t>> sink(buffer);
+  for (auto const value : values)
+    WriteVarUint(sink, value);
+
+  vector<uint32_t> decoded(values.size());
+  BENCHMARK_N_TIMES(IF_DEBUG_ELSE(10, 500), 10.0)
+  {
+    ArrayByteSource src(buffer.data());
+    for (auto & value : decoded)
+      value = ReadVarUint<uint32_t>(src);
+  }
+  TEST_EQUAL(decoded, values, ());
+}
+
+BENCHMARK_TEST(StreamVByte_Decode)
+{
+  auto const values = MakeValues(100000, 2 /* seed */);
+  vector<uint8_t> buffer(StreamVByteMaxSize(values.size()));
+  size_t const size = StreamVByteEncode(values.data(), values.size(), buffer.data());
+
+  vector<uint32_t> decoded(values.size());
+  BENCHMARK_N_TIMES(IF_DEBUG_ELSE(10, 500), 10.0)
+  {
+    StreamVByteDecode(buffer.data(), size, decoded.size(), decoded.data());
+  }
+  TEST_EQUAL(decoded, values, ());
+}
@@ -4,6 +4,9 @@
 #include "coding/text_storage.hpp"
 #include "coding/writer.hpp"
 
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
 #include <cstdint>
 #include <random>
 #include <string>
@@ -31,31 +34,39 @@ string GenerateRandomString(Engine & engine)
   return s;
 }
 
-void DumpStrings(vector<string> const & strings, uint64_t blockSize, vector<uint8_t> & buffer)
+BlockedTextStorageVersion const kVersions[] = {BlockedTextStorageVersion::V0,
+                                               BlockedTextStorageVersion::V1};
+
+void DumpStrings(vector<string> const & strings, uint64_t blockSize, vector<uint8_t> & buffer,
+                 BlockedTextStorageVersion version = BlockedTextStorageVersion::V0)
 {
   MemWriter<vector<uint8_t>> writer(buffer);
-  BlockedTextStorageWriter<decltype(writer)> ts(writer, blockSize);
+  BlockedTextStorageWriter<decltype(writer)> ts(writer, blockSize, version);
   for (auto const & s : strings)
     ts.Append(s);
 }
 
 UNIT_TEST(TextStorage_Smoke)
 {
-  vector<uint8_t> buffer;
-  DumpStrings({} /* strings */, 10 /* blockSize */, buffer);
-
+  for (auto const version : kVersions)
   {
-    MemReader reader(buffer.data(), buffer.size());
-    BlockedTextStorageIndex index;
-    index.Read(reader);
-    TEST_EQUAL(index.GetNumStrings(), 0, ());
-    TEST_EQUAL(index.GetNumBlockInfos(), 0, ());
-  }
-
-  {
-    MemReader reader(buffer.data(), buffer.size());
-    BlockedTextStorage<decltype(reader)> ts(reader);
-    TEST_EQUAL(ts.GetNumStrings(), 0, ());
+    vector<uint8_t> buffer;
+    DumpStrings({} /* strings */, 10 /* blockSize */, buffer, version);
+
+    {
+      MemReader reader(buffer.data(), buffer.size());
+      BlockedTextStorageIndex index;
+      index.Read(reader);
+      TEST_EQUAL(index.GetVersion(), version, ());
+      TEST_EQUAL(index.GetNumStrings(), 0, ());
+      TEST_EQUAL(index.GetNumBlockInfos(), 0, ());
+    }
+
+    {
+      MemReader reader(buffer.data(), buffer.size());
+      BlockedTextStorage<decltype(reader)> ts(reader);
+      TEST_EQUAL(ts.GetNumStrings(), 0, ());
+    }
   }
 }
 
@@ -63,23 +74,26 @@ UNIT_TEST(TextStorage_Simple)
 {
   vector<string> const strings = {{"", "Hello", "Hello, World!", "Hola mundo", "Smoke test"}};
 
-  vector<uint8_t> buffer;
-  DumpStrings(strings, 10 /* blockSize */, buffer);
-
+  for (auto const version : kVersions)
   {
-    MemReader reader(buffer.data(), buffer.size());
-    BlockedTextStorageIndex index;
-    index.Read(reader);
-    TEST_EQUAL(index.GetNumStrings(), strings.size(), ());
-    TEST_EQUAL(index.GetNumBlockInfos(), 3, ());
-  }
-
-  {
-    MemReader reader(buffer.data(), buffer.size());
-    BlockedTextStorage<decltype(reader)> ts(reader);
-    TEST_EQUAL(ts.GetNumStrings(), strings.size(), ());
-    for (size_t i = 0; i < ts.GetNumStrings(); ++i)
-      TEST_EQUAL(ts.ExtractString(i), strings[i], ());
+    vector<uint8_t> buffer;
+    DumpStrings(strings, 10 /* blockSize */, buffer, version);
+
+    {
+      MemReader reader(buffer.data(), buffer.size());
+      BlockedTextStorageIndex index;
+      index.Read(reader);
+      TEST_EQUAL(index.GetNumStrings(), strings.size(), ());
+      TEST_EQUAL(index.GetNumBlockInfos(), 3, ());
+    }
+
+    {
+      MemReader reader(buffer.data(), buffer.size());
+      BlockedTextStorage<decltype(reader)> ts(reader);
+      TEST_EQUAL(ts.GetNumStrings(), strings.size(), ());
+      for (size_t i = 0; i < ts.GetNumStrings(); ++i)
+        TEST_EQUAL(ts.ExtractString(i), strings[i], ());
+    }
   }
 }
 
@@ -93,10 +107,11 @@ UNIT_TEST(TextStorage_Empty)
       strings.emplace_back();
   }
 
-  vector<uint8_t> buffer;
-  DumpStrings(strings, 5 /* blockSize */, buffer);
-
+  for (auto const version : kVersions)
   {
+    vector<uint8_t> buffer;
+    DumpStrings(strings, 5 /* blockSize */, buffer, version);
+
     MemReader reader(buffer.data(), buffer.size());
     BlockedTextStorage<decltype(reader)> ts(reader);
     TEST_EQUAL(ts.GetNumStrings(), strings.size(), ());
@@ -116,17 +131,92 @@ UNIT_TEST(TextStorage_Random)
   for (int i = 0; i < kNumStrings; ++i)
     strings.push_back(GenerateRandomString(engine));
 
-  vector<uint8_t> buffer;
-  DumpStrings(strings, kBlockSize, buffer);
+  for (auto const version : kVersions)
+  {
+    vector<uint8_t> buffer;
+    DumpStrings(strings, kBlockSize, buffer, version);
 
-  MemReader reader(buffer.data(), buffer.size());
-  BlockedTextStorage<decltype(reader)> ts(reader);
+    MemReader reader(buffer.data(), buffer.size());
+    BlockedTextStorage<decltype(reader)> ts(reader);
+
+    TEST_EQUAL(ts.GetNumStrings(), strings.size(), ());
+    for (size_t i = 0; i < ts.GetNumStrings(); ++i)
+      TEST_EQUAL(ts.ExtractString(i), strings[i], ());
+    ts.ClearCache();
+    for (size_t i = ts.GetNumStrings() - 1; i < ts.GetNumStrings(); --i)
+      TEST_EQUAL(ts.ExtractString(i), strings[i], ());
+  }
+}
+
+UNIT_TEST(TextStorage_Dictionary)
+{
+  // Names with common words, the storage is larger than the training sample, so blocks are
+  // compressed both before and after the dictionary is trained.
+  vector<string> const words = {"Street", "Avenue", "Road", "Main", "Park", "Lake", "Hill"};
+  mt19937 engine(0);
+  uniform_int_distribution<size_t> word(0, words.size() - 1);
+  uniform_int_distribution<int> number(0, 999);
+
+  vector<string> strings;
+  size_t size = 0;
+  while (size < 2 * coding::impl::kTextStorageTrainingSize)
+  {
+    strings.push_back(words[word(engine)] + " " + words[word(engine)] + " " +
+                      strings::to_string(number(engine)));
+    size += strings.back().size();
+  }
 
+  auto const dictionary = coding::impl::TrainTextStorageDictionary(strings);
+  TEST(!dictionary.empty(), ());
+  TEST(dictionary.find("Street") != string::npos, ());
+
+  vector<uint8_t> buffer0;
+  DumpStrings(strings, 4096 /* blockSize */, buffer0, BlockedTextStorageVersion::V0);
+  vector<uint8_t> buffer1;
+  DumpStrings(strings, 4096 /* blockSize */, buffer1, BlockedTextStorageVersion::V1);
+
+  MemReader reader(buffer1.data(), buffer1.size());
+  BlockedTextStorage<decltype(reader)> ts(reader);
   TEST_EQUAL(ts.GetNumStrings(), strings.size(), ());
-  for (size_t i = 0; i < ts.GetNumStrings(); ++i)
-    TEST_EQUAL(ts.ExtractString(i), strings[i], ());
-  ts.ClearCache();
-  for (size_t i = ts.GetNumStrings() - 1; i < ts.GetNumStrings(); --i)
+  for (size_t i = 0; i < ts.GetNumStrings(); i += 7)
     TEST_EQUAL(ts.ExtractString(i), strings[i], ());
+  LOG(LINFO, ("V0:", buffer0.size(), "bytes, V1:", buffer1.size(), "bytes"));
+}
+
+UNIT_TEST(TextStorage_SharedCache)
+{
+  vector<string> strings;
+  for (int i = 0; i < 100; ++i)
+    strings.push_back(string(100 /* size */, static_cast<char>('a' + i % 26)));
+
+  vector<uint8_t> buffer;
+  DumpStrings(strings, 1000 /* blockSize */, buffer, BlockedTextStorageVersion::V1);
+  MemReader reader(buffer.data(), buffer.size());
+
+  // The cache fits a few blocks of 10 strings.
+  DecodedTextBlockCache cache(5000 /* maxMemorySize */);
+  {
+    BlockedTextStorageReader ts1(cache);
+    BlockedTextStorageReader ts2(cache);
+    for (size_t i = 0; i < strings.size(); ++i)
+    {
+      TEST_EQUAL(ts1.ExtractString(reader, i), strings[i], ());
+      size_t const j = strings.size() - 1 - i;
+      TEST_EQUAL(ts2.ExtractString(reader, j), strings[j], ());
+      TEST_LESS_OR_EQUAL(cache.GetMemorySize(), 5000, ());
+    }
+    TEST_GREATER(cache.GetSize(), 0, ());
+
+    // Evicted blocks are decoded again.
+    for (size_t i = 0; i < strings.size(); ++i)
+      TEST_EQUAL(ts1.ExtractString(reader, i), strings[i], ());
+
+    TEST_EQUAL(ts2.ExtractString(reader, 0), strings[0], ());
+    size_t const size = cache.GetSize();
+    ts2.ClearCache();
+    TEST_EQUAL(cache.GetSize(), size - 1, ());
+  }
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST_EQUAL(cache.GetMemorySize(), 0, ());
 }
 }  // namespace
@@ -144,4 +144,40 @@ UNIT_TEST(Traffic_Serialization_ExtremeLatLon)
   };
   Test(path);
 }
+UNIT_TEST(Traffic_Serialization_V2Size)
+{
+  // A drive at about 15 m/s with a fix every second.
+  vector<TrafficGPSEncoder::DataPoint> path;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    path.emplace_back(TrafficGPSEncoder::DataPoint(
+        1500000000 + i, ms::LatLon(55.75 + i * 1e-4, 37.61 + i * 1.5e-4), i % 4));
+  }
+
+  auto const getSize = [&path](uint32_t version) {
+    vector<uint8_t> buf;
+    MemWriter<decltype(buf)> memWriter(buf);
+    return TrafficGPSEncoder::SerializeDataPoints(version, memWriter, path);
+  };
+  // 6 bytes per point against 12 bytes of version 1.
+  TEST_LESS(getSize(2), getSize(1) * 3 / 5, ());
+
+  vector<uint8_t> buf;
+  MemWriter<decltype(buf)> memWriter(buf);
+  TrafficGPSEncoder::SerializeDataPoints(2 /* version */, memWriter, path);
+
+  vector<TrafficGPSEncoder::DataPoint> result;
+  MemReader memReader(buf.data(), buf.size());
+  ReaderSource<MemReader> src(memReader);
+  TrafficGPSEncoder::DeserializeDataPoints(2 /* version */, src, result);
+
+  TEST_EQUAL(result.size(), path.size(), ());
+  for (size_t i = 0; i < path.size(); ++i)
+  {
+    TEST_EQUAL(result[i].m_traffic, path[i].m_traffic, (i));
+    // Coordinates are restored with the quantization error only, it doesn't grow along the path.
+    TEST(base::AlmostEqualAbs(result[i].m_latLon.lat, path[i].m_latLon.lat, 1e-6), (i));
+    TEST(base::AlmostEqualAbs(result[i].m_latLon.lon, path[i].m_latLon.lon, 1e-6), (i));
+  }
+}
 }  // namespace coding
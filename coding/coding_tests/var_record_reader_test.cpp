@@ -69,5 +69,26 @@ UNIT_TEST(VarRecordReader_Simple)
     expectedForEachCalls.push_back(pair<uint64_t, string>(4, longString));
     expectedForEachCalls.push_back(pair<uint64_t, string>(6 + longStringSize, "defg"));
     TEST_EQUAL(forEachCalls, expectedForEachCalls, ());
+
+    vector<uint64_t> const positions = {0, 4, 6 + longStringSize, 6 + longStringSize};
+    vector<pair<uint64_t, string> > expectedForEachAtCalls;
+    expectedForEachAtCalls.push_back(pair<uint64_t, string>(0, "abc"));
+    expectedForEachAtCalls.push_back(pair<uint64_t, string>(4, longString));
+    expectedForEachAtCalls.push_back(pair<uint64_t, string>(6 + longStringSize, "defg"));
+    expectedForEachAtCalls.push_back(pair<uint64_t, string>(6 + longStringSize, "defg"));
+
+    uint32_t maxGaps[] = {0, 4, 1000};
+    uint32_t maxReadSizes[] = {1, 8, 1000};
+    for (auto const maxGap : maxGaps)
+    {
+      for (auto const maxReadSize : maxReadSizes)
+      {
+        vector<pair<uint64_t, string> > forEachAtCalls;
+        recordReader.ForEachRecordAt(positions, maxGap, maxReadSize, r,
+                                     SaveForEachParams(forEachAtCalls));
+        TEST_EQUAL(forEachAtCalls, expectedForEachAtCalls,
+                   (chunkSizes[chunkSize], maxGap, maxReadSize));
+      }
+    }
   }
 }
@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "coding/async_file_writer.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/internal/file_data.hpp"
@@ -58,6 +59,32 @@ UNIT_TEST(FileWriter_Smoke)
   FileWriter::DeleteFileX(fileName);
 }
 
+UNIT_TEST(AsyncFileWriter_Smoke)
+{
+  char const fileName [] = "async_file_writer_smoke_test.tmp";
+  {
+    AsyncFileWriter writer(fileName);
+    TestWrite(writer);
+    TEST_EQUAL(writer.Size(), 8, ());
+    writer.Reserve(1024);
+    writer.Seek(8);
+    writer.Write("8", 1);
+  }
+  {
+    AsyncFileWriter writer(fileName, FileWriter::OP_APPEND, 1 /* bufferSize */);
+    TEST_EQUAL(writer.Pos(), 9, ());
+    writer.Write("9", 1);
+  }
+  vector<char> s;
+  {
+    FileReader reader(fileName);
+    s.resize(reader.Size());
+    reader.Read(0, &s[0], reader.Size());
+  }
+  TEST_EQUAL(string(s.begin(), s.end()), string(kTestWriteStr) + "89", ());
+  FileWriter::DeleteFileX(fileName);
+}
+
 UNIT_TEST(SubWriter_MemWriter_Smoke)
 {
   vector<char> s;
@@ -225,6 +252,25 @@ UNIT_TEST(FileWriter_Chunks)
   FileWriter::DeleteFileX(TEST_FILE);
 }
 
+UNIT_TEST(AsyncFileWriter_Chunks)
+{
+  string const TEST_FILE = "AsyncFileWriter_Chunks.test";
+  {
+    // Small buffers are written by parts.
+    AsyncFileWriter fileWriter(TEST_FILE, FileWriter::OP_WRITE_TRUNCATE, 100 /* bufferSize */);
+    WriteTestData1(fileWriter);
+  }
+  {
+    AsyncFileWriter fileWriter(TEST_FILE, FileWriter::OP_WRITE_EXISTING, 3000 /* bufferSize */);
+    WriteTestData2(fileWriter);
+  }
+  {
+    FileReader r(TEST_FILE);
+    ReadTestData(r);
+  }
+  FileWriter::DeleteFileX(TEST_FILE);
+}
+
 UNIT_TEST(MemWriter_Chunks)
 {
   string buffer;
@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "coding/reader.hpp"
 #include "coding/zlib.hpp"
 
 #include "base/macros.hpp"
@@ -7,6 +8,7 @@
 
 #include "std/cstdint.hpp"
 #include "std/iterator.hpp"
+#include "std/random.hpp"
 #include "std/sstream.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
@@ -16,6 +18,8 @@ using namespace coding;
 
 using Deflate = ZLib::Deflate;
 using Inflate = ZLib::Inflate;
+using InflateStream = ZLib::InflateStream;
+using ParallelDeflate = ZLib::ParallelDeflate;
 
 pair<Deflate::Format, Inflate::Format> const g_combinations[] = {
     {Deflate::Format::ZLib, Inflate::Format::ZLib},
@@ -42,6 +46,23 @@ void TestDeflateInflate(string const & original)
   }
 }
 
+// Random words, so the data is compressible but not trivially.
+string MakeText(size_t size)
+{
+  mt19937 rng(0);
+  uniform_int_distribution<int> letter('a', 'h');
+  uniform_int_distribution<size_t> length(1, 8);
+  string text;
+  while (text.size() < size)
+  {
+    for (size_t i = length(rng); i > 0; --i)
+      text.push_back(static_cast<char>(letter(rng)));
+    text.push_back(' ');
+  }
+  text.resize(size);
+  return text;
+}
+
 UNIT_TEST(ZLib_Smoke)
 {
   Deflate const deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
@@ -68,6 +89,87 @@ UNIT_TEST(ZLib_Large)
   TestDeflateInflate(original);
 }
 
+UNIT_TEST(ZLib_ParallelDeflate)
+{
+  string const original = MakeText(1000 * 1000);
+  for (auto const & p : g_combinations)
+  {
+    Inflate const inflate(p.second /* format */);
+    Deflate const deflate(p.first /* format */, Deflate::Level::DefaultCompression);
+    string expected;
+    TEST(deflate(original, back_inserter(expected)), ());
+
+    for (size_t const threadsCount : {1, 4})
+    {
+      for (size_t const size : {size_t(0), size_t(100), original.size()})
+      {
+        ParallelDeflate const parallel(p.first /* format */, Deflate::Level::DefaultCompression,
+                                       threadsCount, 64 * 1024 /* chunkSize */);
+        string compressed;
+        TEST(parallel(original.data(), size, back_inserter(compressed)), ());
+
+        string decompressed;
+        TEST(inflate(compressed, back_inserter(decompressed)), ());
+        TEST_EQUAL(decompressed, original.substr(0, size), ());
+      }
+    }
+
+    // Chunks are compressed with the previous data as a dictionary.
+    ParallelDeflate const parallel(p.first /* format */, Deflate::Level::DefaultCompression,
+                                   4 /* threadsCount */);
+    string compressed;
+    TEST(parallel(original, back_inserter(compressed)), ());
+    TEST_LESS(compressed.size(), expected.size() + expected.size() / 50, ());
+  }
+}
+
+UNIT_TEST(ZLib_InflateStream)
+{
+  string const original = MakeText(100 * 1000);
+  for (auto const & p : g_combinations)
+  {
+    Deflate const deflate(p.first /* format */, Deflate::Level::BestCompression);
+    string compressed;
+    TEST(deflate(original, back_inserter(compressed)), ());
+
+    for (size_t const partSize : {1, 7, 1000, 1000 * 1000})
+    {
+      InflateStream stream(p.second /* format */);
+      string decompressed;
+      for (size_t i = 0; i < compressed.size(); i += partSize)
+      {
+        TEST(!stream.IsFinished(), ());
+        size_t const size = min(partSize, compressed.size() - i);
+        TEST(stream(compressed.data() + i, size, back_inserter(decompressed)), ());
+      }
+      TEST(stream.IsFinished(), ());
+      TEST_EQUAL(decompressed, original, ());
+
+      // Data after the end of the stream.
+      TEST(!stream("x", 1, back_inserter(decompressed)), ());
+    }
+
+    {
+      InflateStream stream(p.second /* format */);
+      string decompressed;
+      TEST(stream(compressed.data(), compressed.size() / 2, back_inserter(decompressed)), ());
+      TEST(!stream.IsFinished(), ());
+    }
+
+    {
+      InflateStream stream(p.second /* format */);
+      string decompressed;
+      TEST(!stream("garbage", 7, back_inserter(decompressed)), ());
+    }
+
+    MemReader reader(compressed.data(), compressed.size());
+    ReaderSource<MemReader> src(reader);
+    string decompressed;
+    TEST(Inflate(p.second /* format */).FromSource(src, back_inserter(decompressed)), ());
+    TEST_EQUAL(decompressed, original, ());
+  }
+}
+
 UNIT_TEST(GZip_ForeignData)
 {
   // To get this array of bytes, type following:
@@ -11,6 +11,52 @@ namespace coding
 {
 namespace
 {
+// When one of the sparse vectors is this many times smaller than another one, positions
+// of the smaller vector are searched in the larger one instead of merging both vectors.
+size_t constexpr kGallopingRatio = 16;
+
+// Appends to |result| the positions from [smallBegin, smallEnd) which are present in
+// [largeBegin, largeEnd). Every next position is looked for with an exponential search
+// starting after the previous one, so the complexity is O(small * log(large / small)).
+void GallopingIntersect(SparseCBV::TIterator smallBegin, SparseCBV::TIterator smallEnd,
+                        SparseCBV::TIterator largeBegin, SparseCBV::TIterator largeEnd,
+                        vector<uint64_t> & result)
+{
+  for (auto it = smallBegin; it != smallEnd && largeBegin != largeEnd; ++it)
+  {
+    size_t step = 1;
+    auto bound = largeBegin;
+    while (bound != largeEnd && *bound < *it)
+    {
+      largeBegin = bound + 1;
+      if (static_cast<size_t>(largeEnd - bound) <= step)
+        bound = largeEnd;
+      else
+        bound += step;
+      step *= 2;
+    }
+
+    largeBegin = lower_bound(largeBegin, bound, *it);
+    if (largeBegin != largeEnd && *largeBegin == *it)
+      result.push_back(*largeBegin++);
+  }
+}
+
+// Word-by-word operations over raw arrays are written as simple counted loops
+// without bounds checks in order to be vectorized by compilers.
+template <typename TWordOp>
+vector<uint64_t> CombineBitGroups(DenseCBV const & a, DenseCBV const & b, TWordOp const & op)
+{
+  size_t const size = min(a.NumBitGroups(), b.NumBitGroups());
+  vector<uint64_t> resGroups(size);
+  uint64_t const * const groupsA = a.GetBitGroups().data();
+  uint64_t const * const groupsB = b.GetBitGroups().data();
+  uint64_t * const res = resGroups.data();
+  for (size_t i = 0; i < size; ++i)
+    res[i] = op(groupsA[i], groupsB[i]);
+  return resGroups;
+}
+
 struct IntersectOp
 {
   IntersectOp() {}
@@ -18,11 +64,7 @@ struct IntersectOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    size_t sizeA = a.NumBitGroups();
-    size_t sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & b.GetBitGroup(i);
+    auto resGroups = CombineBitGroups(a, b, [](uint64_t wa, uint64_t wb) { return wa & wb; });
     return coding::CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
@@ -30,11 +72,14 @@ struct IntersectOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::SparseCBV const & b) const
   {
+    vector<uint64_t> const & groups = a.GetBitGroups();
+    uint64_t const numBits = groups.size() * DenseCBV::kBlockSize;
     vector<uint64_t> resPos;
-    for (size_t i = 0; i < b.PopCount(); ++i)
+    resPos.reserve(min(a.PopCount(), b.PopCount()));
+    for (auto it = b.Begin(); it != b.End() && *it < numBits; ++it)
     {
-      auto pos = b.Select(i);
-      if (a.GetBit(pos))
+      uint64_t const pos = *it;
+      if (((groups[pos / DenseCBV::kBlockSize] >> (pos % DenseCBV::kBlockSize)) & 1) != 0)
         resPos.push_back(pos);
     }
     return make_unique<coding::SparseCBV>(move(resPos));
@@ -49,8 +94,23 @@ struct IntersectOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::SparseCBV const & a,
                                                      coding::SparseCBV const & b) const
   {
+    size_t const sizeA = static_cast<size_t>(a.PopCount());
+    size_t const sizeB = static_cast<size_t>(b.PopCount());
     vector<uint64_t> resPos;
-    set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    if (sizeA * kGallopingRatio <= sizeB)
+    {
+      resPos.reserve(sizeA);
+      GallopingIntersect(a.Begin(), a.End(), b.Begin(), b.End(), resPos);
+    }
+    else if (sizeB * kGallopingRatio <= sizeA)
+    {
+      resPos.reserve(sizeB);
+      GallopingIntersect(b.Begin(), b.End(), a.Begin(), a.End(), resPos);
+    }
+    else
+    {
+      set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    }
     return make_unique<coding::SparseCBV>(move(resPos));
   }
 };
@@ -62,11 +122,10 @@ struct SubtractOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    size_t sizeA = a.NumBitGroups();
-    size_t sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & ~b.GetBitGroup(i);
+    auto resGroups = CombineBitGroups(a, b, [](uint64_t wa, uint64_t wb) { return wa & ~wb; });
+    // Bits of |a| beyond the end of |b| are kept as is.
+    resGroups.insert(resGroups.end(), a.GetBitGroups().begin() + resGroups.size(),
+                     a.GetBitGroups().end());
     return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
@@ -125,24 +184,10 @@ struct UnionOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    size_t sizeA = a.NumBitGroups();
-    size_t sizeB = b.NumBitGroups();
-
-    size_t commonSize = min(sizeA, sizeB);
-    size_t resultSize = max(sizeA, sizeB);
-    vector<uint64_t> resGroups(resultSize);
-    for (size_t i = 0; i < commonSize; ++i)
-      resGroups[i] = a.GetBitGroup(i) | b.GetBitGroup(i);
-    if (a.NumBitGroups() == resultSize)
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = a.GetBitGroup(i);
-    }
-    else
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = b.GetBitGroup(i);
-    }
+    auto resGroups = CombineBitGroups(a, b, [](uint64_t wa, uint64_t wb) { return wa | wb; });
+    auto const & longer = a.NumBitGroups() >= b.NumBitGroups() ? a : b;
+    resGroups.insert(resGroups.end(), longer.GetBitGroups().begin() + resGroups.size(),
+                     longer.GetBitGroups().end());
     return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
@@ -440,18 +485,22 @@ unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitGroups(
     popCount += bits::PopCount(bitGroups[i]);
 
   if (DenseEnough(popCount, maxBit))
-    return DenseCBV::BuildFromBitGroups(move(bitGroups));
+  {
+    // The population count is already known, so it's not computed once more.
+    unique_ptr<DenseCBV> cbv(new DenseCBV());
+    cbv->m_bitGroups = move(bitGroups);
+    cbv->m_popCount = popCount;
+    return cbv;
+  }
 
   vector<uint64_t> setBits;
+  setBits.reserve(static_cast<size_t>(popCount));
   for (size_t i = 0; i < bitGroups.size(); ++i)
   {
-    for (size_t j = 0; j < kBlockSize; ++j)
-    {
-      if (((bitGroups[i] >> j) & 1) > 0)
-        setBits.push_back(kBlockSize * i + j);
-    }
+    for (uint64_t group = bitGroups[i]; group != 0; group &= group - 1)
+      setBits.push_back(kBlockSize * i + bits::CountTrailingZeros(group));
   }
-  return make_unique<SparseCBV>(setBits);
+  return make_unique<SparseCBV>(move(setBits));
 }
 
 string DebugPrint(CompressedBitVector::StorageStrategy strat)
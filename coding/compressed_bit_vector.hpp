@@ -5,6 +5,7 @@
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/ref_counted.hpp"
 
 #include "std/algorithm.hpp"
@@ -100,16 +101,16 @@ public:
 
   size_t NumBitGroups() const { return m_bitGroups.size(); }
 
+  vector<uint64_t> const & GetBitGroups() const { return m_bitGroups; }
+
   template <typename TFn>
   void ForEach(TFn && f) const
   {
     for (size_t i = 0; i < m_bitGroups.size(); ++i)
     {
-      for (size_t j = 0; j < kBlockSize; ++j)
-      {
-        if (((m_bitGroups[i] >> j) & 1) > 0)
-          f(kBlockSize * i + j);
-      }
+      // Only set bits are visited: the lowest one is cleared on every step.
+      for (uint64_t group = m_bitGroups[i]; group != 0; group &= group - 1)
+        f(kBlockSize * i + bits::CountTrailingZeros(group));
     }
   }
 
@@ -1,6 +1,7 @@
 #include "coding/file_container.hpp"
 
 #include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/read_write_utils.hpp"
 #include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
@@ -84,11 +85,27 @@ FilesContainerR::FilesContainerR(TReader const & file)
   ReadInfo(m_source);
 }
 
+FilesContainerR::FilesContainerR(string const & filePath, SharedPageCache & cache)
+  : m_source(make_unique<FileReader>(filePath, cache))
+{
+  ReadInfo(m_source);
+}
+
+// static
+FilesContainerR FilesContainerR::CreateMapped(string const & filePath)
+{
+  return FilesContainerR(make_unique<MmapReader>(filePath));
+}
+
 FilesContainerR::TReader FilesContainerR::GetReader(Tag const & tag) const
 {
   Info const * p = GetInfo(tag);
   if (!p)
     MYTHROW(Reader::OpenException, ("Can't find section:", GetFileName(), tag));
+
+  auto const * reader = dynamic_cast<FileReader const *>(m_source.GetPtr());
+  if (reader && reader->UsesSharedCache())
+    return make_unique<FileReader>(reader->SubReader(p->m_offset, p->m_size, tag));
   return m_source.SubReader(p->m_offset, p->m_size);
 }
 
@@ -119,6 +119,13 @@ public:
                            uint32_t logPageSize = 10,
                            uint32_t logPageCount = 10);
   explicit FilesContainerR(TReader const & file);
+  // Sections are read through |cache|, and reads are counted in stats of their tags.
+  FilesContainerR(std::string const & filePath, SharedPageCache & cache);
+
+  // Every section is read from one read-only mapping of the whole file, without copies
+  // to caches of readers. Access patterns of sections may be passed by
+  // ModelReaderPtr::Advise(). Mappings are not supported on Windows.
+  static FilesContainerR CreateMapped(std::string const & filePath);
 
   TReader GetReader(Tag const & tag) const;
 
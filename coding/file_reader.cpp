@@ -41,7 +41,19 @@ class FileReader::FileReaderData
 {
 public:
   FileReaderData(string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
-    : m_fileData(fileName), m_readerCache(logPageSize, logPageCount)
+    : m_fileData(fileName)
+    , m_readerCache(make_unique<ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS>>(
+          logPageSize, logPageCount))
+  {
+#if LOG_FILE_READER_STATS
+    m_readCallCount = 0;
+#endif
+  }
+
+  FileReaderData(string const & fileName, SharedPageCache & cache)
+    : m_fileData(fileName)
+    , m_sharedCache(&cache)
+    , m_fileId(cache.GetFileId(fileName, m_fileData.Size()))
   {
 #if LOG_FILE_READER_STATS
     m_readCallCount = 0;
@@ -51,27 +63,45 @@ public:
   ~FileReaderData()
   {
 #if LOG_FILE_READER_STATS
-    LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache.GetStatsStr()));
+    if (m_readerCache)
+      LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache->GetStatsStr()));
 #endif
   }
 
   uint64_t Size() const { return m_fileData.Size(); }
 
-  void Read(uint64_t pos, void * p, size_t size)
+  SharedPageCache * GetSharedCache() const { return m_sharedCache; }
+
+  void Read(uint64_t pos, void * p, size_t size, SharedPageCache::TagStats * stats)
   {
+    if (m_sharedCache)
+    {
+      ASSERT(stats, ());
+      m_sharedCache->Read(m_fileId, m_fileData.Size(),
+                          [this](uint64_t pagePos, void * page, size_t pageSize)
+                          {
+                            m_fileData.Read(pagePos, page, pageSize);
+                          },
+                          pos, p, size, *stats);
+      return;
+    }
+
 #if LOG_FILE_READER_STATS
     if (((++m_readCallCount) & LOG_FILE_READER_EVERY_N_READS_MASK) == 0)
     {
-      LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache.GetStatsStr()));
+      LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache->GetStatsStr()));
     }
 #endif
 
-    return m_readerCache.Read(m_fileData, pos, p, size);
+    return m_readerCache->Read(m_fileData, pos, p, size);
   }
 
 private:
   FileDataWithCachedSize m_fileData;
-  ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS> m_readerCache;
+  // Exactly one of the caches is used.
+  unique_ptr<ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS>> m_readerCache;
+  SharedPageCache * m_sharedCache = nullptr;
+  uint64_t m_fileId = 0;
 
 #if LOG_FILE_READER_STATS
   uint32_t m_readCallCount;
@@ -93,6 +123,17 @@ FileReader::FileReader(string const & fileName, uint32_t logPageSize, uint32_t l
 {
 }
 
+FileReader::FileReader(string const & fileName, SharedPageCache & cache)
+  : ModelReader(fileName)
+  , m_logPageSize(0)
+  , m_logPageCount(0)
+  , m_fileData(new FileReaderData(fileName, cache))
+  , m_offset(0)
+  , m_size(m_fileData->Size())
+  , m_stats(&cache.GetTagStats(string()))
+{
+}
+
 FileReader::FileReader(FileReader const & reader, uint64_t offset, uint64_t size,
                        uint32_t logPageSize, uint32_t logPageCount)
   : ModelReader(reader.GetName())
@@ -101,13 +142,21 @@ FileReader::FileReader(FileReader const & reader, uint64_t offset, uint64_t size
   , m_fileData(reader.m_fileData)
   , m_offset(offset)
   , m_size(size)
+  , m_stats(reader.m_stats)
+{
+}
+
+FileReader::FileReader(FileReader const & reader, uint64_t offset, uint64_t size,
+                       SharedPageCache::TagStats * stats)
+  : FileReader(reader, offset, size, reader.m_logPageSize, reader.m_logPageCount)
 {
+  m_stats = stats;
 }
 
 void FileReader::Read(uint64_t pos, void * p, size_t size) const
 {
   CheckPosAndSize(pos, size);
-  m_fileData->Read(m_offset + pos, p, size);
+  m_fileData->Read(m_offset + pos, p, size, m_stats);
 }
 
 FileReader FileReader::SubReader(uint64_t pos, uint64_t size) const
@@ -116,6 +165,15 @@ FileReader FileReader::SubReader(uint64_t pos, uint64_t size) const
   return FileReader(*this, m_offset + pos, size, m_logPageSize, m_logPageCount);
 }
 
+FileReader FileReader::SubReader(uint64_t pos, uint64_t size, string const & statsTag) const
+{
+  CheckPosAndSize(pos, size);
+  auto * cache = m_fileData->GetSharedCache();
+  if (!cache)
+    return SubReader(pos, size);
+  return FileReader(*this, m_offset + pos, size, &cache->GetTagStats(statsTag));
+}
+
 unique_ptr<Reader> FileReader::CreateSubReader(uint64_t pos, uint64_t size) const
 {
   CheckPosAndSize(pos, size);
@@ -124,6 +182,8 @@ unique_ptr<Reader> FileReader::CreateSubReader(uint64_t pos, uint64_t size) cons
       new FileReader(*this, m_offset + pos, size, m_logPageSize, m_logPageCount));
 }
 
+bool FileReader::UsesSharedCache() const { return m_fileData->GetSharedCache() != nullptr; }
+
 void FileReader::CheckPosAndSize(uint64_t pos, uint64_t size) const
 {
   uint64_t const allSize1 = Size();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "coding/reader.hpp"
+#include "coding/shared_page_cache.hpp"
 
 #include "base/base.hpp"
 
@@ -20,6 +21,8 @@ public:
 
   explicit FileReader(std::string const & fileName);
   FileReader(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount);
+  // Reads pages through |cache| instead of an own cache of the reader.
+  FileReader(std::string const & fileName, SharedPageCache & cache);
 
   // Reader overrides:
   uint64_t Size() const override { return m_size; }
@@ -27,8 +30,12 @@ public:
   std::unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override;
 
   FileReader SubReader(uint64_t pos, uint64_t size) const;
+  // Reads of the sub reader are counted in stats of |statsTag| of the shared cache.
+  FileReader SubReader(uint64_t pos, uint64_t size, std::string const & statsTag) const;
   uint64_t GetOffset() const { return m_offset; }
 
+  bool UsesSharedCache() const;
+
 protected:
   // Used in special derived readers.
   void SetOffsetAndSize(uint64_t offset, uint64_t size);
@@ -38,6 +45,8 @@ private:
 
   FileReader(FileReader const & reader, uint64_t offset, uint64_t size, uint32_t logPageSize,
              uint32_t logPageCount);
+  FileReader(FileReader const & reader, uint64_t offset, uint64_t size,
+             SharedPageCache::TagStats * stats);
 
   // Throws an exception if a (pos, size) read would result in an out-of-bounds access.
   void CheckPosAndSize(uint64_t pos, uint64_t size) const;
@@ -47,4 +56,6 @@ private:
   std::shared_ptr<FileReaderData> m_fileData;
   uint64_t m_offset;
   uint64_t m_size;
+  // Stats of the shared cache, nullptr when the own cache is used.
+  SharedPageCache::TagStats * m_stats = nullptr;
 };
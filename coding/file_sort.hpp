@@ -5,9 +5,15 @@
 #include "base/logging.hpp"
 #include "base/exception.hpp"
 #include "std/algorithm.hpp"
+#include "std/array.hpp"
 #include "std/cstdlib.hpp"
+#include "std/deque.hpp"
 #include "std/functional.hpp"
+#include "std/future.hpp"
+#include "std/iterator.hpp"
 #include "std/queue.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/type_traits.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
@@ -24,6 +30,139 @@ struct Sorter
   }
 };
 
+// Key of an item for RadixSorter: an unsigned integer such that an item with a smaller key is
+// less than an item with a greater one. Items with equal keys are ordered by the comparator.
+template <typename T, typename = void>
+struct RadixSortKey
+{
+  static uint64_t Get(T const & item) { return item.GetSortKey(); }
+};
+
+template <typename T>
+struct RadixSortKey<T, std::enable_if_t<is_unsigned<T>::value>>
+{
+  static uint64_t Get(T item) { return item; }
+};
+
+// LSD radix sort by RadixSortKey for items whose order is mostly defined by a small integer,
+// e.g. by a cell id. Passes over bytes which are the same in all keys are skipped.
+template <typename LessT>
+struct RadixSorter
+{
+  LessT m_Less;
+  RadixSorter(LessT lessF) : m_Less(lessF) {}
+  template <typename IterT> void operator() (IterT beg, IterT end) const
+  {
+    using T = typename iterator_traits<IterT>::value_type;
+    using Key = RadixSortKey<T>;
+
+    size_t const count = static_cast<size_t>(distance(beg, end));
+    if (count < 256)
+    {
+      sort(beg, end, m_Less);
+      return;
+    }
+
+    array<array<size_t, 256>, 8> counts = {};
+    for (auto it = beg; it != end; ++it)
+    {
+      uint64_t const key = Key::Get(*it);
+      for (size_t i = 0; i < counts.size(); ++i)
+        ++counts[i][(key >> (8 * i)) & 0xFF];
+    }
+
+    vector<T> src(beg, end);
+    vector<T> dst(count);
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+      auto & pos = counts[i];
+      if (find(pos.begin(), pos.end(), count) != pos.end())
+        continue;
+
+      size_t sum = 0;
+      for (auto & p : pos)
+      {
+        size_t const c = p;
+        p = sum;
+        sum += c;
+      }
+      for (auto const & item : src)
+        dst[pos[(Key::Get(item) >> (8 * i)) & 0xFF]++] = item;
+      src.swap(dst);
+    }
+
+    // Orders items with equal keys.
+    for (size_t i = 0; i < count;)
+    {
+      uint64_t const key = Key::Get(src[i]);
+      size_t j = i + 1;
+      while (j < count && Key::Get(src[j]) == key)
+        ++j;
+      if (j - i > 1)
+        sort(src.begin() + i, src.begin() + j, m_Less);
+      i = j;
+    }
+    copy(src.begin(), src.end(), beg);
+  }
+};
+
+// Sorts [beg, end) by |threadsCount| threads: parts of the range are sorted by SorterT
+// in parallel and then merged pairwise, also in parallel.
+template <typename IterT, typename LessT, template <typename LessT1> class SorterT = Sorter>
+void ParallelSort(IterT beg, IterT end, LessT less, size_t threadsCount)
+{
+  size_t const count = static_cast<size_t>(distance(beg, end));
+  size_t const partsCount = max(size_t(1), min(threadsCount, count / 1024));
+  if (partsCount == 1)
+  {
+    SorterT<LessT> sorter(less);
+    sorter(beg, end);
+    return;
+  }
+
+  vector<IterT> bounds;
+  for (size_t i = 0; i <= partsCount; ++i)
+    bounds.push_back(next(beg, count * i / partsCount));
+
+  {
+    vector<future<void>> sorted;
+    for (size_t i = 0; i + 1 < bounds.size(); ++i)
+    {
+      sorted.push_back(async(launch::async, [less](IterT b, IterT e)
+      {
+        SorterT<LessT> sorter(less);
+        sorter(b, e);
+      }, bounds[i], bounds[i + 1]));
+    }
+    for (auto & f : sorted)
+      f.get();
+  }
+
+  while (bounds.size() > 2)
+  {
+    vector<IterT> merged;
+    vector<future<void>> futures;
+    size_t i = 0;
+    for (; i + 2 < bounds.size(); i += 2)
+    {
+      futures.push_back(async(launch::async, [less](IterT b, IterT m, IterT e)
+      {
+        std::inplace_merge(b, m, e, less);
+      }, bounds[i], bounds[i + 1], bounds[i + 2]));
+      merged.push_back(bounds[i]);
+    }
+    for (; i < bounds.size(); ++i)
+      merged.push_back(bounds[i]);
+    for (auto & f : futures)
+      f.get();
+    bounds.swap(merged);
+  }
+}
+
+// External sort. Items are collected into buffers of |bufferBytes|, each full buffer is sorted
+// into a run of a temporary file, and runs are merged into |outputSink| by SortAndFinish().
+// With |threadsCount| > 1 runs are sorted by other threads while the next buffer is filled,
+// which takes up to |threadsCount| + 1 buffers of memory.
 template <
     typename T,                                       // Item type.
     class OutputSinkT = FileWriter,                   // Sink to output into result file.
@@ -36,12 +175,14 @@ public:
   FileSorter(size_t bufferBytes,
              string const & tmpFileName,
              OutputSinkT & outputSink,
-             LessT fLess = LessT()) :
+             LessT fLess = LessT(),
+             size_t threadsCount = 1) :
   m_TmpFileName(tmpFileName),
   m_BufferCapacity(max(size_t(16), bufferBytes / sizeof(T))),
   m_OutputSink(outputSink),
   m_ItemCount(0),
-  m_Less(fLess)
+  m_Less(fLess),
+  m_ThreadsCount(threadsCount)
   {
     m_Buffer.reserve(m_BufferCapacity);
     m_pTmpWriter.reset(new FileWriter(tmpFileName));
@@ -59,23 +200,34 @@ public:
   {
     ASSERT(m_pTmpWriter.get(), ());
     FlushToTmpFile();
+    while (!m_PendingRuns.empty())
+      WriteOldestRun();
 
     // Write output.
     {
       m_pTmpWriter.reset();
       FileReader reader(m_TmpFileName);
+
+      vector<RunReader> runs;
+      runs.reserve(m_RunSizes.size());
+      uint64_t runBeg = 0;
+      for (auto const runSize : m_RunSizes)
+      {
+        runs.emplace_back(reader, runBeg, runBeg + runSize);
+        runBeg += runSize;
+      }
+
       ItemIndexPairGreater fGreater(m_Less);
       PriorityQueueType q(fGreater);
-      for (uint32_t i = 0; i < m_ItemCount; i += m_BufferCapacity)
-        Push(q, i, reader);
+      for (uint32_t i = 0; i < runs.size(); ++i)
+        Push(q, i, runs);
 
       while (!q.empty())
       {
         m_OutputSink(q.top().first);
-        uint32_t const i = q.top().second + 1;
+        uint32_t const i = q.top().second;
         q.pop();
-        if (i % m_BufferCapacity != 0 && i < m_ItemCount)
-          Push(q, i, reader);
+        Push(q, i, runs);
       }
     }
     FileWriter::DeleteFileX(m_TmpFileName);
@@ -114,21 +266,99 @@ private:
   typedef priority_queue<pair<T, uint32_t>, vector<pair<T, uint32_t> >, ItemIndexPairGreater>
       PriorityQueueType;
 
+  // Reads items of a run [beg, end) of the temporary file by chunks.
+  class RunReader
+  {
+  public:
+    RunReader(FileReader const & reader, uint64_t beg, uint64_t end)
+      : m_reader(reader), m_pos(beg), m_end(end)
+    {
+    }
+
+    bool Next(T & item)
+    {
+      if (m_bufferPos == m_buffer.size())
+      {
+        if (m_pos == m_end)
+          return false;
+        uint64_t const chunkSize = kChunkSize;
+        size_t const count = static_cast<size_t>(min(chunkSize, m_end - m_pos));
+        m_buffer.resize(count);
+        m_reader.Read(m_pos * sizeof(T), m_buffer.data(), count * sizeof(T));
+        m_pos += count;
+        m_bufferPos = 0;
+      }
+      item = m_buffer[m_bufferPos++];
+      return true;
+    }
+
+  private:
+    static uint64_t constexpr kChunkSize = max(uint64_t(1), uint64_t(16 * 1024 / sizeof(T)));
+
+    FileReader const & m_reader;
+    uint64_t m_pos;
+    uint64_t const m_end;
+    vector<T> m_buffer;
+    size_t m_bufferPos = 0;
+  };
+
+  struct PendingRun
+  {
+    shared_ptr<vector<T>> m_items;
+    future<void> m_sorted;
+  };
+
   void FlushToTmpFile()
   {
     if (m_Buffer.empty())
       return;
-    SorterT<LessT> sorter(m_Less);
-    sorter(m_Buffer.begin(), m_Buffer.end());
-    m_pTmpWriter->Write(&m_Buffer[0], m_Buffer.size() * sizeof(T));
-    m_Buffer.clear();
+
+    if (m_ThreadsCount <= 1)
+    {
+      SorterT<LessT> sorter(m_Less);
+      sorter(m_Buffer.begin(), m_Buffer.end());
+      WriteRun(m_Buffer);
+      m_Buffer.clear();
+      return;
+    }
+
+    // Runs are written in order of their buffers, the oldest one is waited for when
+    // all threads are busy.
+    if (m_PendingRuns.size() >= m_ThreadsCount)
+      WriteOldestRun();
+
+    auto items = make_shared<vector<T>>();
+    items->swap(m_Buffer);
+    m_Buffer.reserve(m_BufferCapacity);
+
+    LessT const less = m_Less;
+    auto sorted = async(launch::async, [items, less]()
+    {
+      SorterT<LessT> sorter(less);
+      sorter(items->begin(), items->end());
+    });
+    m_PendingRuns.push_back({move(items), move(sorted)});
+  }
+
+  void WriteOldestRun()
+  {
+    auto & run = m_PendingRuns.front();
+    run.m_sorted.get();
+    WriteRun(*run.m_items);
+    m_PendingRuns.pop_front();
+  }
+
+  void WriteRun(vector<T> const & items)
+  {
+    m_pTmpWriter->Write(&items[0], items.size() * sizeof(T));
+    m_RunSizes.push_back(items.size());
   }
 
-  void Push(PriorityQueueType & q, uint32_t i, FileReader const & reader)
+  void Push(PriorityQueueType & q, uint32_t i, vector<RunReader> & runs)
   {
     T item;
-    reader.Read(static_cast<uint64_t>(i) * sizeof(T), &item, sizeof(T));
-    q.push(pair<T, uint32_t>(item, i));
+    if (runs[i].Next(item))
+      q.push(pair<T, uint32_t>(item, i));
   }
 
   string const m_TmpFileName;
@@ -138,4 +368,7 @@ private:
   vector<T> m_Buffer;
   uint32_t m_ItemCount;
   LessT m_Less;
+  size_t const m_ThreadsCount;
+  deque<PendingRun> m_PendingRuns;
+  vector<uint64_t> m_RunSizes;
 };
@@ -2,8 +2,14 @@
 
 #include "base/logging.hpp"
 
+#include <limits>
+
 namespace coding
 {
+uint32_t constexpr HuffmanCoder::kTableBits;
+uint64_t constexpr HuffmanCoder::kTableMask;
+size_t constexpr HuffmanCoder::kMaxSymbolsPerEntry;
+
 HuffmanCoder::~HuffmanCoder()
 {
   DeleteHuffmanTree(m_root);
@@ -42,12 +48,56 @@ void HuffmanCoder::BuildTables(Node * root, uint32_t path)
   BuildTables(root->r, path + (static_cast<uint32_t>(1) << root->depth));
 }
 
+void HuffmanCoder::BuildDecodingTable()
+{
+  m_decodingTable.clear();
+  if (!m_root)
+    return;
+
+  size_t const tableSize = static_cast<size_t>(1) << kTableBits;
+  uint8_t const kNoCode = std::numeric_limits<uint8_t>::max();
+
+  // The first symbol of every kTableBits-bit index and the length of its code.
+  std::vector<uint32_t> symbols(tableSize);
+  std::vector<uint8_t> lens(tableSize, kNoCode);
+  for (auto const & kv : m_decoderTable)
+  {
+    auto const & code = kv.first;
+    if (code.len > kTableBits)
+      continue;
+    for (size_t i = code.bits; i < tableSize; i += static_cast<size_t>(1) << code.len)
+    {
+      symbols[i] = kv.second;
+      lens[i] = static_cast<uint8_t>(code.len);
+    }
+  }
+
+  m_decodingTable.resize(tableSize);
+  for (size_t i = 0; i < tableSize; ++i)
+  {
+    auto & entry = m_decodingTable[i];
+    uint32_t len = 0;
+    while (entry.m_count < kMaxSymbolsPerEntry)
+    {
+      // Only kTableBits - len bits of |rest| are known.
+      size_t const rest = i >> len;
+      if (lens[rest] == kNoCode || len + lens[rest] > kTableBits)
+        break;
+      len += lens[rest];
+      entry.m_symbols[entry.m_count] = symbols[rest];
+      entry.m_lens[entry.m_count] = static_cast<uint8_t>(len);
+      ++entry.m_count;
+    }
+  }
+}
+
 void HuffmanCoder::Clear()
 {
   DeleteHuffmanTree(m_root);
   m_root = nullptr;
   m_encoderTable.clear();
   m_decoderTable.clear();
+  m_decodingTable.clear();
 }
 
 void HuffmanCoder::DeleteHuffmanTree(Node * root)
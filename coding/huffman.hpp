@@ -101,6 +101,7 @@ public:
     Clear();
     BuildHuffmanTree(Freqs(args...));
     BuildTables(m_root, 0);
+    BuildDecodingTable();
   }
 
   void Clear();
@@ -162,6 +163,8 @@ public:
       cur->isLeaf = true;
       cur->symbol = symbol;
     }
+
+    BuildDecodingTable();
   }
 
   bool Encode(uint32_t symbol, Code & code) const;
@@ -198,12 +201,8 @@ public:
   template <typename TSource, typename OutIt>
   OutIt ReadAndDecode(TSource & src, OutIt out) const
   {
-    BitReader<TSource> bitReader(src);
-    size_t sz = static_cast<size_t>(ReadVarUint<uint32_t, TSource>(src));
-    std::vector<strings::UniChar> v(sz);
-    for (size_t i = 0; i < sz; ++i)
-      *out++ = ReadAndDecode(bitReader);
-    return out;
+    size_t const sz = static_cast<size_t>(ReadVarUint<uint32_t, TSource>(src));
+    return DecodeSpan(src, sz, out);
   }
 
   template <typename TSource>
@@ -214,7 +213,81 @@ public:
     return result;
   }
 
+  // Decodes |count| symbols of a string written by EncodeAndWrite(). |src| must be
+  // right after the size of the string, it is left right after the last byte of the string.
+  // Codes of up to kTableBits bits are resolved by one table lookup which yields up to
+  // kMaxSymbolsPerEntry symbols, longer codes are decoded by the tree.
+  template <typename TSource, typename OutIt>
+  OutIt DecodeSpan(TSource & src, size_t count, OutIt out) const
+  {
+    // Bytes are read only when the current code is not buffered yet, so |src| is never read
+    // beyond the string.
+    uint64_t buf = 0;
+    uint32_t bufBits = 0;
+    auto const readByte = [&src, &buf, &bufBits]() {
+      uint8_t byte;
+      src.Read(&byte, 1);
+      buf |= static_cast<uint64_t>(byte) << bufBits;
+      bufBits += CHAR_BIT;
+    };
+
+    while (count != 0)
+    {
+      if (!m_decodingTable.empty())
+      {
+        auto const & entry = m_decodingTable[buf & kTableMask];
+        size_t const maxCount = std::min(count, static_cast<size_t>(entry.m_count));
+        size_t n = 0;
+        while (n < maxCount && entry.m_lens[n] <= bufBits)
+          ++n;
+
+        if (n != 0)
+        {
+          for (size_t i = 0; i < n; ++i)
+            *out++ = entry.m_symbols[i];
+          buf >>= entry.m_lens[n - 1];
+          bufBits -= entry.m_lens[n - 1];
+          count -= n;
+          continue;
+        }
+
+        if (entry.m_count != 0 || bufBits < kTableBits)
+        {
+          readByte();
+          continue;
+        }
+      }
+
+      Node const * cur = m_root;
+      while (cur && !cur->isLeaf)
+      {
+        if (bufBits == 0)
+          readByte();
+        cur = (buf & 1) == 0 ? cur->l : cur->r;
+        buf >>= 1;
+        --bufBits;
+      }
+      CHECK(cur, ("Could not decode a Huffman-encoded symbol."));
+      *out++ = cur->symbol;
+      --count;
+    }
+    return out;
+  }
+
 private:
+  static uint32_t constexpr kTableBits = 10;
+  static uint64_t constexpr kTableMask = (static_cast<uint64_t>(1) << kTableBits) - 1;
+  static size_t constexpr kMaxSymbolsPerEntry = 3;
+
+  // Symbols which are encoded by the kTableBits bits of the table index, |m_lens| are the
+  // total lengths of the codes of the first 1, 2, ... symbols.
+  struct TableEntry
+  {
+    uint32_t m_symbols[kMaxSymbolsPerEntry] = {};
+    uint8_t m_lens[kMaxSymbolsPerEntry] = {};
+    uint8_t m_count = 0;
+  };
+
   struct Node
   {
     Node *l, *r;
@@ -271,28 +344,13 @@ private:
     return sz;
   }
 
-  template <typename TSource>
-  uint32_t ReadAndDecode(BitReader<TSource> & bitReader) const
-  {
-    Node * cur = m_root;
-    while (cur)
-    {
-      if (cur->isLeaf)
-        return cur->symbol;
-      uint8_t bit = bitReader.Read(1);
-      if (bit == 0)
-        cur = cur->l;
-      else
-        cur = cur->r;
-    }
-    CHECK(false, ("Could not decode a Huffman-encoded symbol."));
-    return 0;
-  }
-
   // Converts a Huffman tree into the more convenient representation
   // of encoding and decoding tables.
   void BuildTables(Node * root, uint32_t path);
 
+  // Builds the table for DecodeSpan() from |m_decoderTable|.
+  void BuildDecodingTable();
+
   void DeleteHuffmanTree(Node * root);
 
   void BuildHuffmanTree(Freqs const & freqs);
@@ -304,5 +362,6 @@ private:
   Node * m_root;
   std::map<Code, uint32_t> m_decoderTable;
   std::map<uint32_t, Code> m_encoderTable;
+  std::vector<TableEntry> m_decodingTable;
 };
 }  // namespace coding
@@ -19,6 +19,10 @@
   #include <io.h>
 #endif
 
+#ifdef OMIM_OS_LINUX
+  #include <fcntl.h>
+#endif
+
 #ifdef OMIM_OS_TIZEN
 #include "tizen/inc/FIo.hpp"
 #endif
@@ -204,6 +208,19 @@ void FileData::Truncate(uint64_t sz)
     MYTHROW(Writer::WriteException, (GetErrorProlog(), sz));
 }
 
+bool FileData::Preallocate(uint64_t sz)
+{
+#ifdef OMIM_OS_LINUX
+  if (sz == 0)
+    return true;
+  Flush();
+  return fallocate(fileno(m_File), FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(sz)) == 0;
+#else
+  UNUSED_VALUE(sz);
+  return false;
+#endif
+}
+
 bool GetFileSize(string const & fName, uint64_t & sz)
 {
   try
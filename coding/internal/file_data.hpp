@@ -39,6 +39,9 @@ public:
 
   void Flush();
   void Truncate(uint64_t sz);
+  /// Allocates disk space for the first |sz| bytes of the file without changing its size.
+  /// @return false if the platform or the file system doesn't support it.
+  bool Preallocate(uint64_t sz);
 
   string const & GetName() const { return m_FileName; }
 
@@ -1,5 +1,7 @@
 #include "coding/mmap_reader.hpp"
 
+#include "base/macros.hpp"
+
 #include "std/target_os.hpp"
 #include "std/cstring.hpp"
 
@@ -33,7 +35,10 @@ public:
 
     struct stat s;
     if (-1 == fstat(m_fd, &s))
+    {
+      close(m_fd);
       MYTHROW(OpenException, ("fstat failed for file", fileName));
+    }
     m_size = s.st_size;
 
     m_memory = (uint8_t *)mmap(0, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
@@ -86,9 +91,33 @@ unique_ptr<Reader> MmapReader::CreateSubReader(uint64_t pos, uint64_t size) cons
   return unique_ptr<Reader>(new MmapReader(*this, m_offset + pos, size));
 }
 
+void MmapReader::Advise(Advice advice) const
+{
+#ifndef OMIM_OS_WINDOWS
+  if (m_size == 0)
+    return;
+
+  int flag = MADV_NORMAL;
+  switch (advice)
+  {
+  case Advice::Normal: flag = MADV_NORMAL; break;
+  case Advice::Sequential: flag = MADV_SEQUENTIAL; break;
+  case Advice::Random: flag = MADV_RANDOM; break;
+  case Advice::WillNeed: flag = MADV_WILLNEED; break;
+  }
+
+  // The range must start at a page boundary.
+  uint64_t const pageSize = static_cast<uint64_t>(sysconf(_SC_PAGE_SIZE));
+  uint64_t const begin = m_offset / pageSize * pageSize;
+  uint64_t const end = m_offset + m_size;
+  // Hints are optional, so errors are ignored.
+  UNUSED_VALUE(madvise(m_data->m_memory + begin, static_cast<size_t>(end - begin), flag));
+#endif
+}
+
 uint8_t * MmapReader::Data() const
 {
-  return m_data->m_memory;
+  return m_data->m_memory + m_offset;
 }
 
 void MmapReader::SetOffsetAndSize(uint64_t offset, uint64_t size)
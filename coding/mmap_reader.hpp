@@ -22,8 +22,10 @@ public:
   uint64_t Size() const override;
   void Read(uint64_t pos, void * p, size_t size) const override;
   unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override;
+  // Passes |advice| to madvise() for the pages of the reader.
+  void Advise(Advice advice) const override;
 
-  /// Direct file/memory access
+  /// Direct file/memory access, for a sub-reader points to the beginning of its range
   uint8_t * Data() const;
 
 protected:
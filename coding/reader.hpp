@@ -136,10 +136,23 @@ class ModelReader : public Reader
   string m_name;
 
 public:
+  // Access patterns of the data of a reader.
+  enum class Advice
+  {
+    Normal,
+    Sequential,
+    Random,
+    WillNeed
+  };
+
   ModelReader(string const & name) : m_name(name) {}
 
   virtual unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override = 0;
 
+  // Hints how the data of the reader is going to be read, e.g. to madvise() of a mapping.
+  // Does nothing by default.
+  virtual void Advise(Advice /* advice */) const {}
+
   inline string const & GetName() const { return m_name; }
 };
 
@@ -158,6 +171,8 @@ public:
   }
 
   inline string const & GetName() const { return m_p->GetName(); }
+
+  inline void Advise(ModelReader::Advice advice) const { m_p->Advise(advice); }
 };
 
 // Source that reads from a reader.
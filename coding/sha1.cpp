@@ -11,10 +11,38 @@
 #include "3party/liboauthcpp/src/base64.h"
 
 #include <algorithm>
-#include <vector>
+#include <limits>
 
 namespace coding
 {
+SHA1::SHA1() : m_impl(std::make_unique<CSHA1>()) {}
+
+SHA1::~SHA1() = default;
+
+void SHA1::Update(void const * data, size_t size)
+{
+  // CSHA1 takes the length as uint32_t.
+  auto const * p = static_cast<unsigned char const *>(data);
+  while (size != 0)
+  {
+    auto const part = static_cast<uint32_t>(std::min<size_t>(size, std::numeric_limits<uint32_t>::max()));
+    m_impl->Update(const_cast<unsigned char *>(p), part);
+    p += part;
+    size -= part;
+  }
+}
+
+SHA1::Hash SHA1::Final()
+{
+  m_impl->Final();
+
+  Hash result;
+  ASSERT_EQUAL(result.size(), ARRAY_SIZE(m_impl->m_digest), ());
+  std::copy(std::begin(m_impl->m_digest), std::end(m_impl->m_digest), std::begin(result));
+  m_impl->Reset();
+  return result;
+}
+
 // static
 SHA1::Hash SHA1::Calculate(std::string const & filePath)
 {
@@ -24,7 +52,7 @@ SHA1::Hash SHA1::Calculate(std::string const & filePath)
     base::FileData file(filePath, base::FileData::OP_READ);
     uint64_t const fileSize = file.Size();
 
-    CSHA1 sha1;
+    SHA1 sha1;
     uint64_t currSize = 0;
     unsigned char buffer[kFileBufferSize];
     while (currSize < fileSize)
@@ -34,12 +62,7 @@ SHA1::Hash SHA1::Calculate(std::string const & filePath)
       sha1.Update(buffer, toRead);
       currSize += toRead;
     }
-    sha1.Final();
-
-    Hash result;
-    ASSERT_EQUAL(result.size(), ARRAY_SIZE(sha1.m_digest), ());
-    std::copy(std::begin(sha1.m_digest), std::end(sha1.m_digest), std::begin(result));
-    return result;
+    return sha1.Final();
   }
   catch (Reader::Exception const & ex)
   {
@@ -51,28 +74,26 @@ SHA1::Hash SHA1::Calculate(std::string const & filePath)
 // static
 std::string SHA1::CalculateBase64(std::string const & filePath)
 {
-  auto const sha1 = Calculate(filePath);
-  return base64_encode(sha1.data(), sha1.size());
+  return EncodeBase64(Calculate(filePath));
 }
 
 // static
 SHA1::Hash SHA1::CalculateForString(std::string const & str)
 {
-  CSHA1 sha1;
-  std::vector<unsigned char> dat(str.begin(), str.end());
-  sha1.Update(dat.data(), static_cast<uint32_t>(dat.size()));
-  sha1.Final();
-
-  Hash result;
-  ASSERT_EQUAL(result.size(), ARRAY_SIZE(sha1.m_digest), ());
-  std::copy(std::begin(sha1.m_digest), std::end(sha1.m_digest), std::begin(result));
-  return result;
+  SHA1 sha1;
+  sha1.Update(str.data(), str.size());
+  return sha1.Final();
 }
 
 // static
 std::string SHA1::CalculateBase64ForString(std::string const & str)
 {
-  auto const sha1 = CalculateForString(str);
-  return base64_encode(sha1.data(), sha1.size());
+  return EncodeBase64(CalculateForString(str));
+}
+
+// static
+std::string SHA1::EncodeBase64(Hash const & hash)
+{
+  return base64_encode(hash.data(), hash.size());
 }
 }  // coding
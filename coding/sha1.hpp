@@ -1,8 +1,13 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 
+class CSHA1;
+
 namespace coding
 {
 class SHA1
@@ -11,10 +16,23 @@ public:
   static size_t constexpr kHashSizeInBytes = 20;
   using Hash = std::array<uint8_t, kHashSizeInBytes>;
 
+  // Streaming calculation, data may be passed by parts of any size.
+  SHA1();
+  ~SHA1();
+
+  void Update(void const * data, size_t size);
+  // Returns the hash of all the data passed to Update() and starts a new calculation.
+  Hash Final();
+
   static Hash Calculate(std::string const & filePath);
   static std::string CalculateBase64(std::string const & filePath);
 
   static Hash CalculateForString(std::string const & str);
   static std::string CalculateBase64ForString(std::string const & str);
+
+  static std::string EncodeBase64(Hash const & hash);
+
+private:
+  std::unique_ptr<CSHA1> m_impl;
 };
 }  // coding
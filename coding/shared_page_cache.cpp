@@ -0,0 +1,196 @@
+#include "coding/shared_page_cache.hpp"
+
+#include "base/assert.hpp"
+#include "base/cache_registry.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+// SharedPageCache::TagStats -----------------------------------------------------------------------
+void SharedPageCache::TagStats::OnRead(size_t size)
+{
+  ++m_reads;
+  m_readBytes += size;
+}
+
+void SharedPageCache::TagStats::OnPage(bool hit)
+{
+  if (hit)
+    ++m_pageHits;
+  else
+    ++m_pageMisses;
+}
+
+SharedPageCache::Stats SharedPageCache::TagStats::Get() const
+{
+  Stats stats;
+  stats.m_reads = m_reads;
+  stats.m_readBytes = m_readBytes;
+  stats.m_pageHits = m_pageHits;
+  stats.m_pageMisses = m_pageMisses;
+  return stats;
+}
+
+// SharedPageCache ---------------------------------------------------------------------------------
+uint32_t constexpr SharedPageCache::kDefaultLogPageSize;
+size_t constexpr SharedPageCache::kDefaultMemorySize;
+size_t constexpr SharedPageCache::kShardsCount;
+
+SharedPageCache::SharedPageCache(size_t memorySize, uint32_t logPageSize)
+  : m_logPageSize(logPageSize)
+  , m_maxShardPagesCount(max(memorySize / (size_t(1) << logPageSize) / kShardsCount, size_t(1)))
+{
+  ASSERT_LESS(m_logPageSize, 32, ());
+}
+
+// static
+SharedPageCache & SharedPageCache::Instance()
+{
+  static SharedPageCache cache(kDefaultMemorySize);
+  static base::CacheRegistry::Registration const registration =
+      base::CacheRegistry::Instance().Register(
+          "SharedPageCache", base::CacheRegistry::Priority::Cheap,
+          [] { return cache.GetPagesCount() << cache.m_logPageSize; },
+          [](base::CacheRegistry::Pressure) { cache.Clear(); });
+  return cache;
+}
+
+uint64_t SharedPageCache::GetFileId(string const & fileName, uint64_t fileSize)
+{
+  lock_guard<mutex> lock(m_filesLock);
+  return m_fileIds.emplace(make_pair(fileName, fileSize), m_fileIds.size()).first->second;
+}
+
+SharedPageCache::TagStats & SharedPageCache::GetTagStats(string const & tag)
+{
+  lock_guard<mutex> lock(m_filesLock);
+  auto & stats = m_tagStats[tag];
+  if (!stats)
+    stats = make_unique<TagStats>();
+  return *stats;
+}
+
+void SharedPageCache::Read(uint64_t fileId, uint64_t fileSize, ReadFn const & readFn,
+                           uint64_t pos, void * p, size_t size, TagStats & stats)
+{
+  if (size == 0)
+    return;
+  ASSERT_LESS_OR_EQUAL(pos + size, fileSize, (pos, size, fileSize));
+  stats.OnRead(size);
+
+  char * dst = static_cast<char *>(p);
+  size_t const pageSize = GetPageSize();
+  while (size > 0)
+  {
+    uint64_t const pageNum = pos >> m_logPageSize;
+    uint64_t const pagePos = pageNum << m_logPageSize;
+    size_t const offset = static_cast<size_t>(pos - pagePos);
+    size_t const copySize = min(size, pageSize - offset);
+
+    Key const key(fileId, pageNum);
+    bool const hit = CopyFromPage(key, offset, dst, copySize);
+    stats.OnPage(hit);
+    if (!hit)
+    {
+      auto const dataSize = min(static_cast<uint64_t>(pageSize), fileSize - pagePos);
+      vector<char> data(static_cast<size_t>(dataSize));
+      readFn(pagePos, data.data(), data.size());
+      memcpy(dst, data.data() + offset, copySize);
+      PutPage(key, move(data));
+    }
+
+    pos += copySize;
+    dst += copySize;
+    size -= copySize;
+  }
+}
+
+void SharedPageCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    vector<Page> pages;
+    lock_guard<mutex> lock(shard.m_lock);
+    shard.m_index.clear();
+    shard.m_pages.swap(pages);
+    shard.m_hand = 0;
+  }
+}
+
+map<string, SharedPageCache::Stats> SharedPageCache::GetStats() const
+{
+  map<string, Stats> result;
+  lock_guard<mutex> lock(m_filesLock);
+  for (auto const & stats : m_tagStats)
+    result.emplace(stats.first, stats.second->Get());
+  return result;
+}
+
+size_t SharedPageCache::GetPagesCount() const
+{
+  size_t count = 0;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_lock);
+    count += shard.m_pages.size();
+  }
+  return count;
+}
+
+SharedPageCache::Shard & SharedPageCache::GetShard(Key const & key)
+{
+  return m_shards[KeyHash()(key) % kShardsCount];
+}
+
+bool SharedPageCache::CopyFromPage(Key const & key, size_t offset, void * p, size_t size)
+{
+  auto & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_lock);
+  auto const it = shard.m_index.find(key);
+  if (it == shard.m_index.end())
+    return false;
+
+  Page & page = shard.m_pages[it->second];
+  ASSERT_LESS_OR_EQUAL(offset + size, page.m_data.size(), ());
+  page.m_referenced = true;
+  memcpy(p, page.m_data.data() + offset, size);
+  return true;
+}
+
+void SharedPageCache::PutPage(Key const & key, vector<char> && data)
+{
+  auto & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_lock);
+  // The page may be read by another thread meanwhile.
+  if (shard.m_index.find(key) != shard.m_index.end())
+    return;
+
+  if (shard.m_pages.size() < m_maxShardPagesCount)
+  {
+    shard.m_index.emplace(key, shard.m_pages.size());
+    shard.m_pages.push_back({key, move(data), false /* referenced */});
+    return;
+  }
+
+  // CLOCK: pages which were used since the hand passed them get another round.
+  while (true)
+  {
+    size_t const index = shard.m_hand;
+    shard.m_hand = (shard.m_hand + 1) % shard.m_pages.size();
+
+    Page & page = shard.m_pages[index];
+    if (page.m_referenced)
+    {
+      page.m_referenced = false;
+      continue;
+    }
+
+    shard.m_index.erase(page.m_key);
+    shard.m_index.emplace(key, index);
+    page.m_key = key;
+    page.m_data = move(data);
+    return;
+  }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Process-wide cache of file pages, which is shared by all readers that opt in. Unlike
+// ReaderCache, readers of the same file on different threads don't keep duplicate pages.
+// Pages are spread over shards, each shard has its own lock and an equal part of the memory
+// budget and evicts pages by the CLOCK algorithm. This class is thread-safe.
+//
+// Files are identified by their names and sizes, so, as with FileReader, a file must not be
+// modified while its pages may be cached.
+class SharedPageCache
+{
+public:
+  static uint32_t constexpr kDefaultLogPageSize = 12;
+  static size_t constexpr kDefaultMemorySize = 64 * 1024 * 1024;
+
+  struct Stats
+  {
+    uint64_t m_reads = 0;
+    uint64_t m_readBytes = 0;
+    uint64_t m_pageHits = 0;
+    uint64_t m_pageMisses = 0;
+  };
+
+  // Statistics of reads of a group of readers, e.g. of readers of an mwm section.
+  class TagStats
+  {
+  public:
+    void OnRead(size_t size);
+    void OnPage(bool hit);
+
+    Stats Get() const;
+
+  private:
+    std::atomic<uint64_t> m_reads{0};
+    std::atomic<uint64_t> m_readBytes{0};
+    std::atomic<uint64_t> m_pageHits{0};
+    std::atomic<uint64_t> m_pageMisses{0};
+  };
+
+  // Reads |size| bytes at |pos| of the file into |p|.
+  using ReadFn = std::function<void(uint64_t pos, void * p, size_t size)>;
+
+  explicit SharedPageCache(size_t memorySize, uint32_t logPageSize = kDefaultLogPageSize);
+
+  static SharedPageCache & Instance();
+
+  // Returns the same id for all files with |fileName| and |fileSize|.
+  uint64_t GetFileId(std::string const & fileName, uint64_t fileSize);
+
+  // Returns stats of reads with |tag|. The returned object lives as long as the cache.
+  TagStats & GetTagStats(std::string const & tag);
+
+  // Copies |size| bytes at |pos| of file |fileId| to |p|. Pages which are not cached are read
+  // by |readFn| without locks of the cache.
+  void Read(uint64_t fileId, uint64_t fileSize, ReadFn const & readFn, uint64_t pos, void * p,
+            size_t size, TagStats & stats);
+
+  void Clear();
+
+  std::map<std::string, Stats> GetStats() const;
+  size_t GetPagesCount() const;
+  size_t GetPageSize() const { return size_t(1) << m_logPageSize; }
+
+private:
+  static size_t constexpr kShardsCount = 16;
+
+  using Key = std::pair<uint64_t, uint64_t>;
+
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const
+    {
+      return std::hash<uint64_t>()(key.first * 0x9E3779B97F4A7C15ULL ^ key.second);
+    }
+  };
+
+  struct Page
+  {
+    Key m_key;
+    std::vector<char> m_data;
+    bool m_referenced = false;
+  };
+
+  struct Shard
+  {
+    mutable std::mutex m_lock;
+    std::unordered_map<Key, size_t, KeyHash> m_index;
+    std::vector<Page> m_pages;
+    // Position of the CLOCK hand in |m_pages|.
+    size_t m_hand = 0;
+  };
+
+  Shard & GetShard(Key const & key);
+
+  // Copies [offset, offset + size) of the page with |key| to |p|. Returns false when the page
+  // is not cached.
+  bool CopyFromPage(Key const & key, size_t offset, void * p, size_t size);
+  void PutPage(Key const & key, std::vector<char> && data);
+
+  uint32_t const m_logPageSize;
+  size_t const m_maxShardPagesCount;
+  std::array<Shard, kShardsCount> m_shards;
+
+  mutable std::mutex m_filesLock;
+  std::map<std::pair<std::string, uint64_t>, uint64_t> m_fileIds;
+  std::map<std::string, std::unique_ptr<TagStats>> m_tagStats;
+
+  DISALLOW_COPY_AND_MOVE(SharedPageCache);
+};
@@ -0,0 +1,139 @@
+#include "coding/stream_vbyte.hpp"
+
+#include "coding/endianness.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define STREAM_VBYTE_SSSE3
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define STREAM_VBYTE_NEON
+#endif
+
+using namespace std;
+
+namespace
+{
+size_t GetControlSize(size_t count) { return (count + 3) / 4; }
+
+uint32_t GetLength(uint8_t control, size_t i) { return ((control >> (2 * (i % 4))) & 3) + 1; }
+
+#if defined(STREAM_VBYTE_SSSE3) || defined(STREAM_VBYTE_NEON)
+struct Tables
+{
+  Tables()
+  {
+    for (uint32_t control = 0; control < 256; ++control)
+    {
+      uint8_t offset = 0;
+      for (size_t i = 0; i < 4; ++i)
+      {
+        uint32_t const length = GetLength(static_cast<uint8_t>(control), i);
+        for (uint32_t j = 0; j < 4; ++j)
+          m_shuffles[control][4 * i + j] = j < length ? static_cast<uint8_t>(offset + j) : 0xFF;
+        offset += length;
+      }
+      m_lengths[control] = offset;
+    }
+  }
+
+  // Shuffles which move bytes of four values to their 32-bit lanes, 0xFF zeroes a lane byte.
+  array<array<uint8_t, 16>, 256> m_shuffles;
+  // Total lengths of four values.
+  array<uint8_t, 256> m_lengths;
+};
+
+Tables const & GetTables()
+{
+  static Tables const tables;
+  return tables;
+}
+
+// Decodes four values, reads 16 bytes at |in|. Returns the length of the values.
+uint32_t DecodeQuad(uint8_t control, uint8_t const * in, uint32_t * out)
+{
+  auto const & tables = GetTables();
+#if defined(STREAM_VBYTE_SSSE3)
+  __m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in));
+  __m128i const shuffle =
+      _mm_loadu_si128(reinterpret_cast<__m128i const *>(tables.m_shuffles[control].data()));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(data, shuffle));
+#else
+  uint8x16_t const data = vld1q_u8(in);
+  uint8x16_t const shuffle = vld1q_u8(tables.m_shuffles[control].data());
+  vst1q_u32(out, vreinterpretq_u32_u8(vqtbl1q_u8(data, shuffle)));
+#endif
+  return tables.m_lengths[control];
+}
+#endif
+}  // namespace
+
+namespace coding
+{
+size_t StreamVByteMaxSize(size_t count) { return GetControlSize(count) + 4 * count; }
+
+size_t StreamVByteEncode(uint32_t const * values, size_t count, uint8_t * out)
+{
+  uint8_t * control = out;
+  uint8_t * data = out + GetControlSize(count);
+  memset(control, 0, GetControlSize(count));
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    uint32_t value = values[i];
+    uint8_t const code = value < (1U << 8) ? 0 : value < (1U << 16) ? 1 : value < (1U << 24) ? 2 : 3;
+    control[i / 4] |= static_cast<uint8_t>(code << (2 * (i % 4)));
+    for (uint8_t j = 0; j <= code; ++j)
+    {
+      *data++ = static_cast<uint8_t>(value & 0xFF);
+      value >>= 8;
+    }
+  }
+  return static_cast<size_t>(data - out);
+}
+
+size_t StreamVByteDecode(uint8_t const * in, size_t size, size_t count, uint32_t * values)
+{
+  size_t const controlSize = GetControlSize(count);
+  if (size < controlSize)
+    MYTHROW(VarUintBlockException, ("No control bytes for", count, "values"));
+
+  uint8_t const * control = in;
+  uint8_t const * data = in + controlSize;
+  uint8_t const * const end = in + size;
+  size_t i = 0;
+
+#if defined(STREAM_VBYTE_SSSE3) || defined(STREAM_VBYTE_NEON)
+  // Shuffles read 16 bytes, which are not always in the block for the last values.
+  for (; i + 4 <= count && end - data >= 16; i += 4)
+    data += DecodeQuad(control[i / 4], data, values + i);
+#endif
+
+  // Values are read by four bytes while possible.
+  for (; i < count && end - data >= 4; ++i)
+  {
+    uint32_t const length = GetLength(control[i / 4], i);
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    values[i] = SwapIfBigEndianMacroBased(value) & (0xFFFFFFFFU >> (32 - 8 * length));
+    data += length;
+  }
+
+  for (; i < count; ++i)
+  {
+    uint32_t const length = GetLength(control[i / 4], i);
+    if (static_cast<size_t>(end - data) < length)
+      MYTHROW(VarUintBlockException, ("Not enough data for", count, "values"));
+
+    uint32_t value = 0;
+    for (uint32_t j = 0; j < length; ++j)
+      value |= static_cast<uint32_t>(data[j]) << (8 * j);
+    values[i] = value;
+    data += length;
+  }
+  return static_cast<size_t>(data - in);
+}
+}  // namespace coding
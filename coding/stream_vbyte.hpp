@@ -0,0 +1,96 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/exception.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace coding
+{
+// Stream-VByte coding of blocks of 32-bit unsigned integers, see Daniel Lemire, Nathan Kurz,
+// Christoph Rupp, "Stream VByte: Faster Byte-Oriented Integer Compression", 2017.
+//
+// Unlike varints, lengths of values are moved into a separate stream of control bytes, two bits
+// per value, so values are decoded without branches on every byte: four values at once by
+// SSSE3 or NEON shuffles where these are available, and by a scalar loop anywhere else.
+//
+// Layout: (count + 3) / 4 control bytes, then values as 1-4 little-endian bytes each.
+// The value i has length ((control[i / 4] >> (2 * (i % 4))) & 3) + 1.
+
+DECLARE_EXCEPTION(VarUintBlockException, RootException);
+
+// Returns the max size of an encoded block of |count| values.
+size_t StreamVByteMaxSize(size_t count);
+
+// Encodes |count| values to |out|, which must have StreamVByteMaxSize(count) bytes.
+// Returns the number of written bytes.
+size_t StreamVByteEncode(uint32_t const * values, size_t count, uint8_t * out);
+
+// Decodes |count| values from |size| bytes at |in| to |values|. Returns the number of read bytes.
+// Throws VarUintBlockException when |size| bytes are not enough.
+size_t StreamVByteDecode(uint8_t const * in, size_t size, size_t count, uint32_t * values);
+
+// Format of a block written by WriteVarUintBlock(). The format is stored in the block, so
+// encoders may choose it while readers decode any of them.
+enum class VarUintBlockFormat : uint8_t
+{
+  // A varint per value, see WriteVarUint().
+  Varint = 0,
+  StreamVByte = 1,
+};
+
+template <typename Sink>
+void WriteVarUintBlock(Sink & sink, std::vector<uint32_t> const & values,
+                       VarUintBlockFormat format)
+{
+  WriteToSink(sink, static_cast<uint8_t>(format));
+  WriteVarUint(sink, static_cast<uint64_t>(values.size()));
+  switch (format)
+  {
+  case VarUintBlockFormat::Varint:
+    for (auto const value : values)
+      WriteVarUint(sink, value);
+    return;
+  case VarUintBlockFormat::StreamVByte:
+  {
+    std::vector<uint8_t> buffer(StreamVByteMaxSize(values.size()));
+    size_t const size = StreamVByteEncode(values.data(), values.size(), buffer.data());
+    WriteVarUint(sink, static_cast<uint64_t>(size));
+    sink.Write(buffer.data(), size);
+    return;
+  }
+  }
+  CHECK(false, ("Unknown block format", static_cast<int>(format)));
+}
+
+template <typename Source>
+void ReadVarUintBlock(Source & src, std::vector<uint32_t> & values)
+{
+  auto const format = ReadPrimitiveFromSource<uint8_t>(src);
+  auto const count = ReadVarUint<uint64_t>(src);
+  values.resize(static_cast<size_t>(count));
+  switch (static_cast<VarUintBlockFormat>(format))
+  {
+  case VarUintBlockFormat::Varint:
+    for (auto & value : values)
+      value = ReadVarUint<uint32_t>(src);
+    return;
+  case VarUintBlockFormat::StreamVByte:
+  {
+    auto const size = static_cast<size_t>(ReadVarUint<uint64_t>(src));
+    std::vector<uint8_t> buffer(size);
+    src.Read(buffer.data(), size);
+    if (StreamVByteDecode(buffer.data(), size, values.size(), values.data()) != size)
+      MYTHROW(VarUintBlockException, ("Broken block of", count, "values"));
+    return;
+  }
+  }
+  MYTHROW(VarUintBlockException, ("Unknown block format", format));
+}
+}  // namespace coding
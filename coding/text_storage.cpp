@@ -0,0 +1,215 @@
+#include "coding/text_storage.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <tuple>
+#include <unordered_map>
+
+#include "zlib.h"
+
+using namespace std;
+
+namespace coding
+{
+namespace
+{
+// Deflate can refer only to the last 32 KB of the dictionary.
+size_t constexpr kMaxDictionarySize = 32 * 1024;
+// Longer strings are unlikely to repeat.
+size_t constexpr kMaxDictionaryStringSize = 64;
+size_t constexpr kMinDictionaryStringSize = 3;
+
+int constexpr kRawDeflateBits = -MAX_WBITS;
+
+void AddCandidate(string const & s, unordered_map<string, size_t> & counts)
+{
+  if (s.size() >= kMinDictionaryStringSize && s.size() <= kMaxDictionaryStringSize)
+    ++counts[s];
+}
+}  // namespace
+
+string DebugPrint(BlockedTextStorageVersion version)
+{
+  switch (version)
+  {
+  case BlockedTextStorageVersion::V0: return "V0";
+  case BlockedTextStorageVersion::V1: return "V1";
+  }
+  CHECK_SWITCH();
+}
+
+namespace impl
+{
+string TrainTextStorageDictionary(vector<string> const & strings)
+{
+  // Whole strings and their words are candidates, a candidate saves about its size for
+  // every occurrence except the first one, which is compressed anyway.
+  // Strings are split by bytes because they are not necessarily valid UTF-8.
+  unordered_map<string, size_t> counts;
+  for (auto const & s : strings)
+  {
+    AddCandidate(s, counts);
+    if (s.find(' ') == string::npos)
+      continue;
+
+    size_t begin = 0;
+    while (begin < s.size())
+    {
+      size_t end = s.find(' ', begin);
+      if (end == string::npos)
+        end = s.size();
+      AddCandidate(s.substr(begin, end - begin), counts);
+      begin = end + 1;
+    }
+  }
+
+  vector<pair<size_t, string const *>> candidates;
+  for (auto const & entry : counts)
+  {
+    if (entry.second > 1)
+      candidates.emplace_back((entry.second - 1) * entry.first.size(), &entry.first);
+  }
+  sort(candidates.begin(), candidates.end(), [](auto const & lhs, auto const & rhs) {
+    return tie(lhs.first, *lhs.second) > tie(rhs.first, *rhs.second);
+  });
+
+  size_t size = 0;
+  size_t count = 0;
+  while (count < candidates.size() &&
+         size + candidates[count].second->size() <= kMaxDictionarySize)
+  {
+    size += candidates[count++].second->size();
+  }
+
+  // Deflate encodes nearer matches by shorter codes, so the best candidates go to the end of
+  // the dictionary, which is the nearest to the data.
+  string dictionary;
+  dictionary.reserve(size);
+  for (size_t i = count; i > 0; --i)
+    dictionary += *candidates[i - 1].second;
+  return dictionary;
+}
+
+void DeflateTextBlock(string const & dictionary, string const & block, string & compressed)
+{
+  z_stream stream = {};
+  CHECK_EQUAL(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, kRawDeflateBits,
+                           8 /* memLevel */, Z_DEFAULT_STRATEGY),
+              Z_OK, ());
+  SCOPE_GUARD(endDeflate, [&stream]() { deflateEnd(&stream); });
+
+  if (!dictionary.empty())
+  {
+    CHECK_EQUAL(deflateSetDictionary(&stream, reinterpret_cast<Bytef const *>(dictionary.data()),
+                                     static_cast<uInt>(dictionary.size())),
+                Z_OK, ());
+  }
+
+  compressed.resize(deflateBound(&stream, static_cast<uLong>(block.size())));
+  // zlib does not modify the input, see the comment in zlib.cpp.
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(block.data()));
+  stream.avail_in = static_cast<uInt>(block.size());
+  stream.next_out = reinterpret_cast<Bytef *>(&compressed[0]);
+  stream.avail_out = static_cast<uInt>(compressed.size());
+  CHECK_EQUAL(deflate(&stream, Z_FINISH), Z_STREAM_END, ());
+  compressed.resize(stream.total_out);
+}
+
+void InflateTextBlock(string const & dictionary, char const * compressed, size_t compressedSize,
+                      size_t size, string & block)
+{
+  z_stream stream = {};
+  CHECK_EQUAL(inflateInit2(&stream, kRawDeflateBits), Z_OK, ());
+  SCOPE_GUARD(endInflate, [&stream]() { inflateEnd(&stream); });
+
+  // The dictionary of raw deflate is set before the data.
+  if (!dictionary.empty())
+  {
+    CHECK_EQUAL(inflateSetDictionary(&stream, reinterpret_cast<Bytef const *>(dictionary.data()),
+                                     static_cast<uInt>(dictionary.size())),
+                Z_OK, ());
+  }
+
+  block.resize(size);
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed));
+  stream.avail_in = static_cast<uInt>(compressedSize);
+  // One spare byte lets inflate reach the end of the stream when |size| is zero.
+  char spare = 0;
+  stream.next_out = size == 0 ? reinterpret_cast<Bytef *>(&spare)
+                              : reinterpret_cast<Bytef *>(&block[0]);
+  stream.avail_out = size == 0 ? 1 : static_cast<uInt>(size);
+  CHECK_EQUAL(inflate(&stream, Z_FINISH), Z_STREAM_END, ());
+  CHECK_EQUAL(stream.total_out, size, ());
+}
+}  // namespace impl
+
+// DecodedTextBlockCache ---------------------------------------------------------------------------
+size_t constexpr DecodedTextBlockCache::kDefaultMemorySize;
+
+bool DecodedTextBlockCache::Key::operator<(Key const & rhs) const
+{
+  return tie(m_storageId, m_blockIx) < tie(rhs.m_storageId, rhs.m_blockIx);
+}
+
+DecodedTextBlockCache::DecodedTextBlockCache(size_t maxMemorySize) : m_cache(maxMemorySize) {}
+
+// static
+DecodedTextBlockCache & DecodedTextBlockCache::Instance()
+{
+  static DecodedTextBlockCache cache(kDefaultMemorySize);
+  return cache;
+}
+
+// static
+uint64_t DecodedTextBlockCache::GetNewStorageId()
+{
+  static atomic<uint64_t> nextId(0);
+  return nextId++;
+}
+
+DecodedTextBlockCache::BlockPtr DecodedTextBlockCache::Get(Key const & key)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const * block = m_cache.Find(key);
+  return block ? *block : nullptr;
+}
+
+void DecodedTextBlockCache::Put(Key const & key, BlockPtr block)
+{
+  CHECK(block, ());
+  // Approximate size of the entry of the cache and of the block.
+  size_t const memorySize = sizeof(Key) + sizeof(BlockPtr) + 4 * sizeof(void *) +
+                            sizeof(DecodedTextBlock) + block->m_value.capacity() +
+                            block->m_subs.capacity() * sizeof(DecodedTextBlock::StringInfo);
+
+  lock_guard<mutex> lock(m_mutex);
+  m_cache.Put(key, move(block), memorySize);
+}
+
+void DecodedTextBlockCache::Remove(uint64_t storageId)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_cache.EraseRange({storageId, 0 /* blockIx */},
+                     [storageId](Key const & key) { return key.m_storageId == storageId; });
+}
+
+void DecodedTextBlockCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_cache.Clear();
+}
+
+size_t DecodedTextBlockCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_cache.GetSize();
+}
+
+size_t DecodedTextBlockCache::GetMemorySize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_cache.GetMemorySize();
+}
+}  // namespace coding
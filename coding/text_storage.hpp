@@ -6,11 +6,18 @@
 #include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
+#include "base/macros.hpp"
+#include "base/memory_lru_cache.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace coding
 {
@@ -22,39 +29,78 @@ namespace coding
 // because the whole number of strings is packed into a single block.
 //
 // Format description:
-// * first 8 bytes - little endian-encoded offset of the index section
-// * data section - represents a catenated sequence of BWT-compressed blocks with
+// * first 8 bytes - little endian-encoded offset of the index section,
+//   the highest bit is set for versions since V1
+// * since V1: 1 byte - version
+// * since V1: dictionary of the compressor - varint size and the dictionary
+// * data section - represents a catenated sequence of compressed blocks with
 //   a sequence of individual string lengths in the block
 // * index section - represents a delta-encoded sequence of
-//   BWT-compressed blocks offsets intermixed with the number of
+//   compressed blocks offsets intermixed with the number of
 //   strings inside each block.
 //
-// All numbers except the first offset are varints.
+// Blocks of V0 are BWT-compressed. Blocks of V1 are the varint size of compressed data and
+// raw deflate data with the preset dictionary. The dictionary is trained on the first blocks
+// of the storage, so short strings such as names compress well, and blocks are decoded
+// several times faster than BWT blocks.
+//
+// All numbers except the first offset and the version are varints.
+enum class BlockedTextStorageVersion : uint8_t
+{
+  V0 = 0,
+  V1 = 1
+};
+
+std::string DebugPrint(BlockedTextStorageVersion version);
+
+namespace impl
+{
+// Set in the offset of the index section for versions since V1.
+uint64_t constexpr kTextStorageVersionedBit = uint64_t{1} << 63;
+// Strings of V1 blocks are kept in memory until the dictionary is trained on this number
+// of bytes.
+size_t constexpr kTextStorageTrainingSize = 1024 * 1024;
+
+// Returns the dictionary for compressing |strings|, which is made of the most frequent
+// strings and words.
+std::string TrainTextStorageDictionary(std::vector<std::string> const & strings);
+
+void DeflateTextBlock(std::string const & dictionary, std::string const & block,
+                      std::string & compressed);
+void InflateTextBlock(std::string const & dictionary, char const * compressed,
+                      size_t compressedSize, size_t size, std::string & block);
+}  // namespace impl
+
 template <typename Writer>
 class BlockedTextStorageWriter
 {
 public:
-  BlockedTextStorageWriter(Writer & writer, uint64_t blockSize)
-    : m_writer(writer), m_blockSize(blockSize), m_startOffset(writer.Pos()), m_blocks(1)
+  BlockedTextStorageWriter(Writer & writer, uint64_t blockSize,
+                           BlockedTextStorageVersion version = BlockedTextStorageVersion::V0)
+    : m_writer(writer), m_blockSize(blockSize), m_version(version), m_startOffset(writer.Pos())
   {
     CHECK(m_blockSize != 0, ());
     WriteToSink(m_writer, static_cast<uint64_t>(0));
     m_dataOffset = m_writer.Pos();
+    if (m_version != BlockedTextStorageVersion::V0)
+      WriteToSink(m_writer, static_cast<uint8_t>(m_version));
   }
 
   ~BlockedTextStorageWriter()
   {
     if (!m_lengths.empty())
-      FlushPool(m_lengths, m_pool);
-
-    if (m_blocks.back().IsEmpty())
-      m_blocks.pop_back();
+      FlushPool();
+    if (m_version == BlockedTextStorageVersion::V1 && !m_dictionaryWritten)
+      WritePendingBlocks();
 
     {
       auto const currentOffset = m_writer.Pos();
       ASSERT_GREATER_OR_EQUAL(currentOffset, m_startOffset, ());
+      uint64_t indexOffset = currentOffset - m_startOffset;
+      if (m_version != BlockedTextStorageVersion::V0)
+        indexOffset |= impl::kTextStorageVersionedBit;
       m_writer.Seek(m_startOffset);
-      WriteToSink(m_writer, static_cast<uint64_t>(currentOffset - m_startOffset));
+      WriteToSink(m_writer, indexOffset);
       m_writer.Seek(currentOffset);
     }
 
@@ -75,21 +121,13 @@ public:
 
   void Append(std::string const & s)
   {
-    ASSERT(!m_blocks.empty(), ());
-
     ASSERT_LESS(m_pool.size(), m_blockSize, ());
 
-    ++m_blocks.back().m_subs;
     m_pool.append(s);
     m_lengths.push_back(s.size());
 
     if (m_pool.size() >= m_blockSize)
-    {
-      FlushPool(m_lengths, m_pool);
-      m_pool.clear();
-      m_lengths.clear();
-      m_blocks.emplace_back(m_writer.Pos() - m_dataOffset /* offset */, 0 /* subs */);
-    }
+      FlushPool();
   }
 
 private:
@@ -104,16 +142,76 @@ private:
     uint64_t m_subs = 0;    // number of strings inside the block
   };
 
-  void FlushPool(vector<uint64_t> const & lengths, string const & pool)
+  struct PendingBlock
+  {
+    std::string m_pool;
+    vector<uint64_t> m_lengths;
+  };
+
+  void FlushPool()
   {
+    if (m_version == BlockedTextStorageVersion::V1 && !m_dictionaryWritten)
+    {
+      m_pendingSize += m_pool.size();
+      m_pending.push_back({std::move(m_pool), std::move(m_lengths)});
+      if (m_pendingSize >= impl::kTextStorageTrainingSize)
+        WritePendingBlocks();
+    }
+    else
+    {
+      WriteBlock(m_lengths, m_pool);
+    }
+    m_pool.clear();
+    m_lengths.clear();
+  }
+
+  // Trains the dictionary on the pending blocks and writes the dictionary and the blocks.
+  void WritePendingBlocks()
+  {
+    std::vector<std::string> strings;
+    for (auto const & block : m_pending)
+    {
+      uint64_t offset = 0;
+      for (auto const length : block.m_lengths)
+      {
+        strings.emplace_back(block.m_pool, offset, length);
+        offset += length;
+      }
+    }
+    m_dictionary = impl::TrainTextStorageDictionary(strings);
+
+    WriteVarUint(m_writer, m_dictionary.size());
+    m_writer.Write(m_dictionary.data(), m_dictionary.size());
+    m_dictionaryWritten = true;
+
+    for (auto const & block : m_pending)
+      WriteBlock(block.m_lengths, block.m_pool);
+    m_pending.clear();
+  }
+
+  void WriteBlock(vector<uint64_t> const & lengths, string const & pool)
+  {
+    m_blocks.emplace_back(m_writer.Pos() - m_dataOffset /* offset */, lengths.size() /* subs */);
     for (auto const & length : lengths)
       WriteVarUint(m_writer, length);
-    BWTCoder::EncodeAndWriteBlock(m_writer, pool.size(),
-                                  reinterpret_cast<uint8_t const *>(pool.c_str()));
+
+    switch (m_version)
+    {
+    case BlockedTextStorageVersion::V0:
+      BWTCoder::EncodeAndWriteBlock(m_writer, pool.size(),
+                                    reinterpret_cast<uint8_t const *>(pool.c_str()));
+      break;
+    case BlockedTextStorageVersion::V1:
+      impl::DeflateTextBlock(m_dictionary, pool, m_compressed);
+      WriteVarUint(m_writer, m_compressed.size());
+      m_writer.Write(m_compressed.data(), m_compressed.size());
+      break;
+    }
   }
 
   Writer & m_writer;
   uint64_t const m_blockSize;
+  BlockedTextStorageVersion const m_version;
   uint64_t m_startOffset = 0;
   uint64_t m_dataOffset = 0;
 
@@ -121,6 +219,13 @@ private:
 
   std::string m_pool;          // concatenated strings
   vector<uint64_t> m_lengths;  // lengths of strings inside the |m_pool|
+
+  // V1 blocks which are written after the dictionary is trained.
+  std::vector<PendingBlock> m_pending;
+  size_t m_pendingSize = 0;
+  std::string m_dictionary;
+  bool m_dictionaryWritten = false;
+  std::string m_compressed;
 };
 
 class BlockedTextStorageIndex
@@ -139,6 +244,8 @@ public:
     uint64_t m_subs = 0;    // number of strings in the block
   };
 
+  BlockedTextStorageVersion GetVersion() const { return m_version; }
+
   size_t GetNumBlockInfos() const { return m_blocks.size(); }
   size_t GetNumStrings() const { return m_blocks.empty() ? 0 : m_blocks.back().To(); }
 
@@ -178,7 +285,15 @@ public:
   template <typename Reader>
   void Read(Reader & reader)
   {
-    auto const indexOffset = ReadPrimitiveFromPos<uint64_t, Reader>(reader, 0);
+    auto indexOffset = ReadPrimitiveFromPos<uint64_t, Reader>(reader, 0);
+    m_version = BlockedTextStorageVersion::V0;
+    if ((indexOffset & impl::kTextStorageVersionedBit) != 0)
+    {
+      indexOffset &= ~impl::kTextStorageVersionedBit;
+      m_version = static_cast<BlockedTextStorageVersion>(
+          ReadPrimitiveFromPos<uint8_t, Reader>(reader, sizeof(uint64_t)));
+      CHECK_EQUAL(m_version, BlockedTextStorageVersion::V1, ());
+    }
 
     NonOwningReaderSource source(reader);
     source.Skip(indexOffset);
@@ -202,18 +317,98 @@ public:
   }
 
 private:
+  BlockedTextStorageVersion m_version = BlockedTextStorageVersion::V0;
   std::vector<BlockInfo> m_blocks;
 };
 
+// Strings of a block of a storage.
+struct DecodedTextBlock
+{
+  struct StringInfo
+  {
+    StringInfo() = default;
+    StringInfo(uint64_t offset, uint64_t length): m_offset(offset), m_length(length) {}
+
+    uint64_t m_offset = 0;  // offset of the string inside the decompressed block
+    uint64_t m_length = 0;  // length of the string
+  };
+
+  std::string m_value;             // concatenation of the strings
+  std::vector<StringInfo> m_subs;  // indices of individual strings
+};
+
+// Memory-bounded cache of decoded blocks of text storages. Readers of all storages share
+// the cache, so blocks of rarely read storages are evicted in favour of blocks which are
+// read often, and the memory doesn't grow with the number of open storages. Blocks are
+// keyed by the reader, which gets its id on construction. The least recently used
+// blocks are evicted.
+// This class is thread-safe.
+class DecodedTextBlockCache
+{
+public:
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+
+    uint64_t m_storageId = 0;
+    uint64_t m_blockIx = 0;
+  };
+
+  // A view of a cached block. It stays valid after the block is evicted.
+  using BlockPtr = std::shared_ptr<DecodedTextBlock const>;
+
+  static size_t constexpr kDefaultMemorySize = 16 * 1024 * 1024;
+
+  explicit DecodedTextBlockCache(size_t maxMemorySize);
+
+  static DecodedTextBlockCache & Instance();
+
+  // Returns a new id for the blocks of a storage, ids are unique within the process.
+  static uint64_t GetNewStorageId();
+
+  // Returns nullptr when the block is not cached.
+  BlockPtr Get(Key const & key);
+  void Put(Key const & key, BlockPtr block);
+
+  // Removes blocks of the storage.
+  void Remove(uint64_t storageId);
+  void Clear();
+
+  size_t GetSize() const;
+  size_t GetMemorySize() const;
+
+private:
+  mutable std::mutex m_mutex;
+  base::MemoryLruCache<Key, BlockPtr> m_cache;
+
+  DISALLOW_COPY_AND_MOVE(DecodedTextBlockCache);
+};
+
 class BlockedTextStorageReader
 {
 public:
+  BlockedTextStorageReader() : BlockedTextStorageReader(DecodedTextBlockCache::Instance()) {}
+
+  explicit BlockedTextStorageReader(DecodedTextBlockCache & cache)
+    : m_cache(&cache), m_storageId(DecodedTextBlockCache::GetNewStorageId())
+  {
+  }
+
+  ~BlockedTextStorageReader() { ClearCache(); }
+
   template <typename Reader>
   void InitializeIfNeeded(Reader & reader)
   {
     if (m_initialized)
       return;
     m_index.Read(reader);
+    if (m_index.GetVersion() == BlockedTextStorageVersion::V1)
+    {
+      NonOwningReaderSource source(reader);
+      source.Skip(sizeof(uint64_t) + sizeof(uint8_t));
+      m_dictionary.resize(ReadVarUint<uint64_t, NonOwningReaderSource>(source));
+      source.Read(&m_dictionary[0], m_dictionary.size());
+    }
     m_initialized = true;
   }
 
@@ -231,68 +426,74 @@ public:
     auto const blockIx = m_index.GetBlockIx(stringIx);
     CHECK_LESS(blockIx, m_index.GetNumBlockInfos(), ());
 
-    if (blockIx >= m_cache.size())
-      m_cache.resize(blockIx + 1);
-    ASSERT_LESS(blockIx, m_cache.size(), ());
-
     auto const & bi = m_index.GetBlockInfo(blockIx);
 
-    auto & entry = m_cache[blockIx];
-    if (!entry.m_valid)
+    DecodedTextBlockCache::Key const key = {m_storageId, blockIx};
+    auto block = m_cache->Get(key);
+    if (!block)
     {
-      NonOwningReaderSource source(reader);
-      source.Skip(bi.m_offset);
-
-      entry.m_value.clear();
-      entry.m_subs.resize(bi.m_subs);
-
-      uint64_t offset = 0;
-      for (size_t i = 0; i < entry.m_subs.size(); ++i)
-      {
-        auto & sub = entry.m_subs[i];
-        sub.m_offset = offset;
-        sub.m_length = ReadVarUint<uint64_t>(source);
-        CHECK_GREATER_OR_EQUAL(sub.m_offset + sub.m_length, sub.m_offset, ());
-        offset += sub.m_length;
-      }
-      BWTCoder::ReadAndDecodeBlock(source, std::back_inserter(entry.m_value));
-      entry.m_valid = true;
+      auto decoded = std::make_shared<DecodedTextBlock>();
+      ReadBlock(reader, bi, *decoded);
+      block = std::move(decoded);
+      m_cache->Put(key, block);
     }
-    ASSERT(entry.m_valid, ());
 
     ASSERT_GREATER_OR_EQUAL(stringIx, bi.From(), ());
     ASSERT_LESS(stringIx, bi.To(), ());
 
     stringIx -= bi.From();
-    ASSERT_LESS(stringIx, entry.m_subs.size(), ());
+    ASSERT_LESS(stringIx, block->m_subs.size(), ());
 
-    auto const & si = entry.m_subs[stringIx];
-    auto const & value = entry.m_value;
+    auto const & si = block->m_subs[stringIx];
+    auto const & value = block->m_value;
     ASSERT_LESS_OR_EQUAL(si.m_offset + si.m_length, value.size(), ());
     return value.substr(si.m_offset, si.m_length);
   }
 
-  void ClearCache() { m_cache.clear(); }
+  void ClearCache() { m_cache->Remove(m_storageId); }
 
 private:
-  struct StringInfo
+  template <typename Reader>
+  void ReadBlock(Reader & reader, BlockedTextStorageIndex::BlockInfo const & bi,
+                 DecodedTextBlock & block) const
   {
-    StringInfo() = default;
-    StringInfo(uint64_t offset, uint64_t length): m_offset(offset), m_length(length) {}
+    NonOwningReaderSource source(reader);
+    source.Skip(bi.m_offset);
 
-    uint64_t m_offset = 0;  // offset of the string inside the decompressed block
-    uint64_t m_length = 0;  // length of the string
-  };
+    block.m_subs.resize(bi.m_subs);
 
-  struct CacheEntry
-  {
-    std::string m_value;             // concatenation of the strings
-    std::vector<StringInfo> m_subs;  // indices of individual strings
-    bool m_valid = false;
-  };
+    uint64_t offset = 0;
+    for (size_t i = 0; i < block.m_subs.size(); ++i)
+    {
+      auto & sub = block.m_subs[i];
+      sub.m_offset = offset;
+      sub.m_length = ReadVarUint<uint64_t>(source);
+      CHECK_GREATER_OR_EQUAL(sub.m_offset + sub.m_length, sub.m_offset, ());
+      offset += sub.m_length;
+    }
+
+    switch (m_index.GetVersion())
+    {
+    case BlockedTextStorageVersion::V0:
+      BWTCoder::ReadAndDecodeBlock(source, std::back_inserter(block.m_value));
+      break;
+    case BlockedTextStorageVersion::V1:
+    {
+      std::string compressed(ReadVarUint<uint64_t>(source), '\0');
+      source.Read(&compressed[0], compressed.size());
+      impl::InflateTextBlock(m_dictionary, compressed.data(), compressed.size(), offset,
+                             block.m_value);
+      break;
+    }
+    }
+    CHECK_EQUAL(block.m_value.size(), offset, ());
+  }
 
+  DecodedTextBlockCache * m_cache;
+  // Copies of the reader share blocks in the cache because they read the same storage.
+  uint64_t m_storageId;
   BlockedTextStorageIndex m_index;
-  std::vector<CacheEntry> m_cache;
+  std::string m_dictionary;
   bool m_initialized = false;
 };
 
@@ -56,6 +56,56 @@ public:
     return pos + fullSize;
   }
 
+  // Reads records starting at |positions|, which must be sorted, and calls f(pos, data, size)
+  // for each of them. Records which are at most |maxGap| bytes apart are read by one
+  // Reader.Read() call, as long as the call reads less than |maxReadSize| bytes.
+  // |data| is valid only during the call of |f|.
+  template <typename F>
+  void ForEachRecordAt(vector<uint64_t> const & positions, uint32_t maxGap, uint32_t maxReadSize,
+                       vector<char> & buffer, F const & f) const
+  {
+    size_t i = 0;
+    while (i < positions.size())
+    {
+      uint64_t const start = positions[i];
+      size_t j = i + 1;
+      while (j < positions.size() && positions[j] - positions[j - 1] <= maxGap &&
+             positions[j] - start < maxReadSize)
+      {
+        ++j;
+      }
+
+      ASSERT_LESS(positions[j - 1], m_ReaderSize, ());
+      uint64_t const end = min(positions[j - 1] + m_ExpectedRecordSize, m_ReaderSize);
+      uint32_t readSize = static_cast<uint32_t>(end - start);
+      if (buffer.size() < readSize)
+        buffer.resize(readSize);
+      m_Reader.Read(start, &buffer[0], readSize);
+
+      for (size_t k = i; k < j; ++k)
+      {
+        ASSERT(k == i || positions[k - 1] <= positions[k], ());
+        uint32_t const recordPos = static_cast<uint32_t>(positions[k] - start);
+        ArrayByteSource source(&buffer[recordPos]);
+        uint32_t const recordSize = VarRecordSizeReaderFn(source);
+        uint32_t const recordSizeSize =
+            static_cast<uint32_t>(source.PtrC() - &buffer[recordPos]);
+        uint32_t const recordEnd = recordPos + recordSizeSize + recordSize;
+        ASSERT_LESS_OR_EQUAL(start + recordEnd, m_ReaderSize, ());
+        if (recordEnd > readSize)
+        {
+          // The record goes beyond the read bytes, so the read is extended to its end.
+          if (buffer.size() < recordEnd)
+            buffer.resize(recordEnd);
+          m_Reader.Read(start + readSize, &buffer[readSize], recordEnd - readSize);
+          readSize = recordEnd;
+        }
+        f(positions[k], &buffer[recordPos + recordSizeSize], recordSize);
+      }
+      i = j;
+    }
+  }
+
   template <typename F>
   void ForEachRecord(F const & f) const
   {
@@ -2,6 +2,9 @@
 
 #include "std/target_os.hpp"
 
+#include <atomic>
+#include <future>
+
 namespace coding
 {
 namespace
@@ -21,6 +24,87 @@ int ToInt(ZLib::Deflate::Level level)
   }
   CHECK_SWITCH();
 }
+
+// Deflate refers to at most 32 KB of the previous data.
+size_t constexpr kMaxDictionarySize = 32 * 1024;
+int constexpr kRawDeflateBits = -MAX_WBITS;
+
+void AppendUint32(uint32_t value, bool bigEndian, string & s)
+{
+  for (size_t i = 0; i < sizeof(value); ++i)
+  {
+    size_t const shift = CHAR_BIT * (bigEndian ? sizeof(value) - 1 - i : i);
+    s.push_back(static_cast<char>((value >> shift) & 0xFF));
+  }
+}
+
+// See RFC 1950 and RFC 1952.
+string MakeHeader(ZLib::Deflate::Format format, int level)
+{
+  using Format = ZLib::Deflate::Format;
+  switch (format)
+  {
+  case Format::ZLib:
+  {
+    // FLEVEL is only informational, the same values as in deflate.c are used.
+    uint32_t flevel = 2;
+    if (level == Z_NO_COMPRESSION || level == Z_BEST_SPEED)
+      flevel = 0;
+    else if (level == Z_BEST_COMPRESSION)
+      flevel = 3;
+
+    uint32_t header = (0x78 << 8) | (flevel << 6);
+    header += 31 - header % 31;
+    return {static_cast<char>(header >> 8), static_cast<char>(header & 0xFF)};
+  }
+  case Format::GZip:
+  {
+    char const xfl = level == Z_BEST_COMPRESSION ? 2 : (level == Z_BEST_SPEED ? 4 : 0);
+    // Magic, CM = deflate, FLG = 0, MTIME = 0, XFL, OS = unknown.
+    return {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, xfl, '\xff'};
+  }
+  }
+  CHECK_SWITCH();
+}
+
+// Compresses [data, data + size) to a raw deflate stream which is either finished or
+// byte-aligned by a sync flush, so the streams of consecutive chunks can be concatenated.
+bool DeflateChunk(int level, unsigned char const * dictionary, size_t dictionarySize,
+                  unsigned char const * data, size_t size, bool last, string & compressed)
+{
+  z_stream stream = {};
+  if (deflateInit2(&stream, level, Z_DEFLATED, kRawDeflateBits, 8 /* memLevel */,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+
+  bool ok = dictionarySize == 0 ||
+            deflateSetDictionary(&stream, dictionary, static_cast<uInt>(dictionarySize)) == Z_OK;
+
+  // See the comment about next_in in ZLib::Processor::Processor().
+  stream.next_in = const_cast<unsigned char *>(data);
+  stream.avail_in = static_cast<uInt>(size);
+  // The sync flush adds an empty stored block to the bound.
+  compressed.resize(deflateBound(&stream, static_cast<uLong>(size)) + 16);
+  int const flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+  while (ok)
+  {
+    stream.next_out = reinterpret_cast<unsigned char *>(&compressed[stream.total_out]);
+    stream.avail_out = static_cast<uInt>(compressed.size() - stream.total_out);
+    int const ret = deflate(&stream, flush);
+    if (ret != Z_OK && ret != Z_BUF_ERROR && ret != Z_STREAM_END)
+      ok = false;
+    else if (ret == Z_STREAM_END || (!last && stream.avail_out != 0))
+      break;
+    else
+      compressed.resize(compressed.size() * 2);
+  }
+
+  compressed.resize(stream.total_out);
+  deflateEnd(&stream);
+  return ok;
+}
 }  // namespace
 
 // ZLib::Processor ---------------------------------------------------------------------------------
@@ -42,6 +126,13 @@ ZLib::Processor::Processor(void const * data, size_t size) noexcept : m_init(fal
   m_stream.opaque = Z_NULL;
 }
 
+void ZLib::Processor::SetInput(void const * data, size_t size)
+{
+  ASSERT(IsInit(), ());
+  m_stream.next_in = static_cast<unsigned char *>(const_cast<void *>(data));
+  m_stream.avail_in = static_cast<unsigned int>(size);
+}
+
 bool ZLib::Processor::ConsumedAll() const
 {
   ASSERT(IsInit(), ());
@@ -84,7 +175,74 @@ int ZLib::DeflateProcessor::Process(int flush)
   return deflate(&m_stream, flush);
 }
 
+// ZLib::ParallelDeflate ---------------------------------------------------------------------------
+size_t constexpr ZLib::ParallelDeflate::kDefaultChunkSize;
+
+ZLib::ParallelDeflate::ParallelDeflate(Deflate::Format format, Deflate::Level level,
+                                       size_t threadsCount, size_t chunkSize) noexcept
+  : m_format(format), m_level(level), m_threadsCount(max<size_t>(threadsCount, 1)),
+    m_chunkSize(max(chunkSize, kMaxDictionarySize))
+{
+}
+
+bool ZLib::ParallelDeflate::Compress(void const * data, size_t size, vector<string> & parts) const
+{
+  auto const * bytes = static_cast<unsigned char const *>(data);
+  size_t const numChunks = max<size_t>((size + m_chunkSize - 1) / m_chunkSize, 1);
+  int const level = ToInt(m_level);
+  bool const zlib = m_format == Deflate::Format::ZLib;
+
+  parts.assign(numChunks + 2, {});
+  vector<uLong> checksums(numChunks);
+  std::atomic<size_t> nextChunk(0);
+  std::atomic<bool> ok(true);
+  auto const worker = [&]() {
+    for (size_t i = nextChunk++; i < numChunks && ok; i = nextChunk++)
+    {
+      size_t const begin = i * m_chunkSize;
+      size_t const chunkSize = min(m_chunkSize, size - begin);
+      size_t const dictionarySize = min(begin, kMaxDictionarySize);
+      if (!DeflateChunk(level, bytes + begin - dictionarySize, dictionarySize, bytes + begin,
+                        chunkSize, i + 1 == numChunks, parts[i + 1]))
+      {
+        ok = false;
+      }
+
+      auto const len = static_cast<uInt>(chunkSize);
+      checksums[i] = zlib ? adler32(adler32(0, nullptr, 0), bytes + begin, len)
+                          : crc32(crc32(0, nullptr, 0), bytes + begin, len);
+    }
+  };
+
+  vector<std::future<void>> threads;
+  for (size_t i = 1; i < min(m_threadsCount, numChunks); ++i)
+    threads.push_back(std::async(std::launch::async, worker));
+  worker();
+  for (auto & thread : threads)
+    thread.get();
+
+  if (!ok)
+    return false;
+
+  uLong checksum = checksums[0];
+  for (size_t i = 1; i < numChunks; ++i)
+  {
+    auto const len = static_cast<z_off_t>(min(m_chunkSize, size - i * m_chunkSize));
+    checksum = zlib ? adler32_combine(checksum, checksums[i], len)
+                    : crc32_combine(checksum, checksums[i], len);
+  }
+
+  parts.front() = MakeHeader(m_format, level);
+  auto & trailer = parts.back();
+  AppendUint32(static_cast<uint32_t>(checksum), zlib /* bigEndian */, trailer);
+  if (!zlib)
+    AppendUint32(static_cast<uint32_t>(size), false /* bigEndian */, trailer);
+  return true;
+}
+
 // ZLib::Inflate -----------------------------------------------------------------------------------
+size_t constexpr ZLib::Inflate::kSourceChunkSize;
+
 ZLib::InflateProcessor::InflateProcessor(Inflate::Format format, void const * data,
                                          size_t size) noexcept
   : Processor(data, size)
@@ -4,7 +4,9 @@
 #include "base/macros.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 #include "zlib.h"
 
@@ -46,10 +48,19 @@ public:
       return (*this)(s.c_str(), s.size(), out);
     }
 
+    // Decompresses the rest of |src|, which is read by parts of kSourceChunkSize bytes,
+    // so the whole compressed data is never in memory.
+    template <typename Source, typename OutIt>
+    bool FromSource(Source & src, OutIt out) const;
+
   private:
+    static size_t constexpr kSourceChunkSize = 64 * 1024;
+
     Format const m_format;
   };
 
+  class InflateStream;
+
   class Deflate
   {
   public:
@@ -89,6 +100,48 @@ public:
     Level const m_level;
   };
 
+  // Compresses the input by chunks of |chunkSize| bytes on |threadsCount| threads.
+  // The result is a usual zlib or gzip stream which can be read by Inflate: every chunk
+  // is compressed with the end of the previous one as a dictionary and is ended by a sync
+  // flush, so the compression ratio is close to the one of Deflate.
+  class ParallelDeflate
+  {
+  public:
+    static size_t constexpr kDefaultChunkSize = 128 * 1024;
+
+    ParallelDeflate(Deflate::Format format, Deflate::Level level, size_t threadsCount,
+                    size_t chunkSize = kDefaultChunkSize) noexcept;
+
+    template <typename OutIt>
+    bool operator()(void const * data, size_t size, OutIt out) const
+    {
+      if (data == nullptr)
+        return false;
+
+      vector<string> parts;
+      if (!Compress(data, size, parts))
+        return false;
+      for (auto const & part : parts)
+        out = copy(part.begin(), part.end(), out);
+      return true;
+    }
+
+    template <typename OutIt>
+    bool operator()(string const & s, OutIt out) const
+    {
+      return (*this)(s.c_str(), s.size(), out);
+    }
+
+  private:
+    // Fills |parts| with the header, the compressed chunks and the trailer of the stream.
+    bool Compress(void const * data, size_t size, vector<string> & parts) const;
+
+    Deflate::Format const m_format;
+    Deflate::Level const m_level;
+    size_t const m_threadsCount;
+    size_t const m_chunkSize;
+  };
+
 private:
   class Processor
   {
@@ -99,6 +152,7 @@ private:
     virtual ~Processor() noexcept = default;
 
     inline bool IsInit() const noexcept { return m_init; }
+    void SetInput(void const * data, size_t size);
     bool ConsumedAll() const;
     bool BufferIsFull() const;
 
@@ -173,4 +227,66 @@ private:
     return true;
   }
 };
+
+// Decompresses a stream which is passed by parts as it arrives, e.g. from the network.
+class ZLib::InflateStream
+{
+public:
+  explicit InflateStream(Inflate::Format format) noexcept
+    : m_processor(format, nullptr /* data */, 0 /* size */)
+  {
+  }
+
+  // Decompresses the next part of the stream to |out|. Returns false in case of errors,
+  // including data after the end of the stream.
+  template <typename OutIt>
+  bool operator()(void const * data, size_t size, OutIt out)
+  {
+    if (!m_processor.IsInit() || (data == nullptr && size != 0))
+      return false;
+    if (m_finished)
+      return size == 0;
+
+    m_processor.SetInput(data, size);
+    while (!m_finished)
+    {
+      int const ret = m_processor.Process(Z_NO_FLUSH);
+      if (ret == Z_STREAM_END)
+        m_finished = true;
+      else if (ret != Z_OK && ret != Z_BUF_ERROR)
+        return false;
+
+      bool const full = m_processor.BufferIsFull();
+      m_processor.MoveOut(out);
+      // Z_BUF_ERROR means that no progress is possible without more input.
+      if (!full && (ret == Z_BUF_ERROR || m_processor.ConsumedAll()))
+        break;
+    }
+    return !m_finished || m_processor.ConsumedAll();
+  }
+
+  // Returns true when the whole stream is decompressed.
+  bool IsFinished() const { return m_finished; }
+
+private:
+  InflateProcessor m_processor;
+  bool m_finished = false;
+
+  DISALLOW_COPY_AND_MOVE(InflateStream);
+};
+
+template <typename Source, typename OutIt>
+bool ZLib::Inflate::FromSource(Source & src, OutIt out) const
+{
+  InflateStream stream(m_format);
+  vector<uint8_t> buffer(kSourceChunkSize);
+  while (src.Size() != 0)
+  {
+    size_t const size = static_cast<size_t>(min<uint64_t>(src.Size(), buffer.size()));
+    src.Read(buffer.data(), size);
+    if (!stream(buffer.data(), size, out))
+      return false;
+  }
+  return stream.IsFinished();
+}
 }  // namespace coding
@@ -31,6 +31,8 @@
 #define INDEX_FILE_TAG "idx"
 #define SEARCH_INDEX_FILE_TAG "sdx"
 #define SEARCH_ADDRESS_FILE_TAG "addr"
+#define SEARCH_MATCHED_STREETS_FILE_TAG "matched_streets"
+#define SEARCH_LOCALITIES_FILE_TAG "localities"
 #define CITIES_BOUNDARIES_FILE_TAG "cities_boundaries"
 #define HEADER_FILE_TAG "header"
 #define VERSION_FILE_TAG "version"
@@ -52,8 +54,14 @@
 #define TRAFFIC_KEYS_FILE_TAG "traffic"
 #define TRANSIT_CROSS_MWM_FILE_TAG "transit_cross_mwm"
 #define TRANSIT_FILE_TAG "transit"
+#define TRANSIT_DISPLAY_FILE_TAG "transit_display"
 #define UGC_FILE_TAG "ugc"
 #define CITY_ROADS_FILE_TAG "city_roads"
+#define LANDMARKS_FILE_TAG "landmarks"
+#define ROUTING_MAPPED_FILE_TAG "routing_mapped"
+#define ROAD_SNAPPING_FILE_TAG "road_snapping"
+#define SPEED_PROFILES_FILE_TAG "speed_profiles"
+#define CHECKSUMS_FILE_TAG "checksums"
 
 #define LOCALITY_DATA_FILE_TAG "locdata"
 #define GEO_OBJECTS_INDEX_FILE_TAG "locidx"
@@ -94,6 +102,8 @@
 #define PACKED_POLYGONS_FILE "packed_polygons.bin"
 #define PACKED_POLYGONS_OBSOLETE_FILE "packed_polygons_obsolete.bin"
 
+#define MWM_INFO_CACHE_FILE "mwm_infos.bin"
+
 #define EXTERNAL_RESOURCES_FILE "external_resources.txt"
 
 #define GPS_TRACK_FILENAME "gps_track.dat"
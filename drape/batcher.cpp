@@ -14,20 +14,23 @@ namespace dp
 class Batcher::CallbacksWrapper : public BatchCallbacks
 {
 public:
-  CallbacksWrapper(RenderState const & state, ref_ptr<OverlayHandle> overlay, ref_ptr<Batcher> batcher)
+  CallbacksWrapper(RenderState const & state, ref_ptr<OverlayHandle> overlay,
+                   ref_ptr<Batcher> batcher, IndexStorage & indexStorage)
     : m_state(state)
     , m_overlay(overlay)
     , m_batcher(batcher)
+    , m_indexStorage(indexStorage)
   {}
 
-  void SetVAO(ref_ptr<VertexArrayBuffer> buffer)
+  void SetBucket(ref_ptr<RenderBucket> bucket)
   {
     // Invocation with non-null VAO will cause to invalid range of indices.
     // It means that VAO has been changed during batching.
     if (m_buffer != nullptr)
       m_vaoChanged = true;
 
-    m_buffer = buffer;
+    m_bucket = bucket;
+    m_buffer = bucket->GetBuffer();
     m_indicesRange.m_idxStart = m_buffer->GetIndexCount();
   }
 
@@ -81,6 +84,11 @@ public:
     return m_state;
   }
 
+  ref_ptr<RenderBucket> GetBucket() const
+  {
+    return m_bucket;
+  }
+
   IndicesRange const & Finish()
   {
     if (!m_vaoChanged)
@@ -95,14 +103,16 @@ private:
   RenderState const & m_state;
   ref_ptr<OverlayHandle> m_overlay;
   ref_ptr<Batcher> m_batcher;
+  ref_ptr<RenderBucket> m_bucket;
   ref_ptr<VertexArrayBuffer> m_buffer;
-  IndexStorage m_indexStorage;
+  IndexStorage & m_indexStorage;
   IndicesRange m_indicesRange;
   bool m_vaoChanged = false;
 };
 
 Batcher::Batcher(uint32_t indexBufferSize, uint32_t vertexBufferSize)
-  : m_indexBufferSize(indexBufferSize)
+  : m_lastBucket(m_buckets.end())
+  , m_indexBufferSize(indexBufferSize)
   , m_vertexBufferSize(vertexBufferSize)
 {}
 
@@ -212,6 +222,7 @@ void Batcher::ResetSession()
 {
   m_flushInterface = TFlushFn();
   m_buckets.clear();
+  m_lastBucket = m_buckets.end();
 }
 
 void Batcher::SetFeatureMinZoom(int minZoom)
@@ -227,22 +238,29 @@ void Batcher::ChangeBuffer(ref_ptr<GraphicsContext> context, ref_ptr<CallbacksWr
   RenderState const & state = wrapper->GetState();
   FinalizeBucket(context, state);
 
-  ref_ptr<RenderBucket> bucket = GetBucket(state);
-  wrapper->SetVAO(bucket->GetBuffer());
+  wrapper->SetBucket(GetBucket(state));
 }
 
 ref_ptr<RenderBucket> Batcher::GetBucket(RenderState const & state)
 {
+  // Shapes of the same kind usually go one after another, e.g. all POI icons of a tile
+  // share a state, so the last found bucket is checked before the lookup.
+  if (m_lastBucket != m_buckets.end() && m_lastBucket->first == state)
+    return make_ref(m_lastBucket->second);
+
   TBuckets::iterator it = m_buckets.find(state);
   if (it != m_buckets.end())
+  {
+    m_lastBucket = it;
     return make_ref(it->second);
+  }
 
   drape_ptr<VertexArrayBuffer> vao = make_unique_dp<VertexArrayBuffer>(m_indexBufferSize, m_vertexBufferSize);
   drape_ptr<RenderBucket> buffer = make_unique_dp<RenderBucket>(std::move(vao));
   ref_ptr<RenderBucket> result = make_ref(buffer);
   result->SetFeatureMinZoom(m_featureMinZoom);
 
-  m_buckets.emplace(state, std::move(buffer));
+  m_lastBucket = m_buckets.emplace(state, std::move(buffer)).first;
 
   return result;
 }
@@ -252,8 +270,10 @@ void Batcher::FinalizeBucket(ref_ptr<GraphicsContext> context, RenderState const
   TBuckets::iterator it = m_buckets.find(state);
   ASSERT(it != m_buckets.end(), ("Have no bucket for finalize with given state"));
   drape_ptr<RenderBucket> bucket = std::move(it->second);
-  m_buckets.erase(state);
+  m_buckets.erase(it);
+  m_lastBucket = m_buckets.end();
 
+  bucket->GetBuffer()->SetIndexBufferMutable(bucket->HasOverlayHandles());
   bucket->GetBuffer()->Preflush(context);
   m_flushInterface(state, std::move(bucket));
 }
@@ -264,11 +284,13 @@ void Batcher::Flush(ref_ptr<GraphicsContext> context)
   std::for_each(m_buckets.begin(), m_buckets.end(), [this, context](TBuckets::value_type & bucket)
   {
     ASSERT(bucket.second != nullptr, ());
+    bucket.second->GetBuffer()->SetIndexBufferMutable(bucket.second->HasOverlayHandles());
     bucket.second->GetBuffer()->Preflush(context);
     m_flushInterface(bucket.first, std::move(bucket.second));
   });
 
   m_buckets.clear();
+  m_lastBucket = m_buckets.end();
 }
 
 template <typename TBatcher, typename... TArgs>
@@ -277,14 +299,13 @@ IndicesRange Batcher::InsertPrimitives(ref_ptr<GraphicsContext> context, RenderS
                                        drape_ptr<OverlayHandle> && transferHandle,
                                        uint8_t vertexStride, TArgs... batcherArgs)
 {
-  ref_ptr<VertexArrayBuffer> vao = GetBucket(state)->GetBuffer();
   IndicesRange range;
 
   drape_ptr<OverlayHandle> handle = std::move(transferHandle);
 
   {
-    Batcher::CallbacksWrapper wrapper(state, make_ref(handle), make_ref(this));
-    wrapper.SetVAO(vao);
+    Batcher::CallbacksWrapper wrapper(state, make_ref(handle), make_ref(this), m_indexStorage);
+    wrapper.SetBucket(GetBucket(state));
 
     TBatcher batch(wrapper, batcherArgs ...);
     batch.SetCanDivideStreams(handle == nullptr);
@@ -292,10 +313,11 @@ IndicesRange Batcher::InsertPrimitives(ref_ptr<GraphicsContext> context, RenderS
     batch.BatchData(context, params);
 
     range = wrapper.Finish();
-  }
 
-  if (handle != nullptr)
-    GetBucket(state)->AddOverlayHandle(std::move(handle));
+    // The wrapper holds the bucket which has got the last portion of data.
+    if (handle != nullptr)
+      wrapper.GetBucket()->AddOverlayHandle(std::move(handle));
+  }
 
   return range;
 }
@@ -2,6 +2,7 @@
 
 #include "drape/attribute_provider.hpp"
 #include "drape/graphics_context.hpp"
+#include "drape/index_storage.hpp"
 #include "drape/overlay_handle.hpp"
 #include "drape/pointers.hpp"
 #include "drape/render_bucket.hpp"
@@ -90,6 +91,12 @@ private:
 
   using TBuckets = std::map<RenderState, drape_ptr<RenderBucket>>;
   TBuckets m_buckets;
+  // The bucket found by the last GetBucket call or m_buckets.end().
+  TBuckets::iterator m_lastBucket;
+
+  // Indices of primitives without overlay handles are generated here and uploaded
+  // right after, so the storage is reused by all insertions.
+  IndexStorage m_indexStorage;
 
   uint32_t m_indexBufferSize;
   uint32_t m_vertexBufferSize;
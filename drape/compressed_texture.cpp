@@ -0,0 +1,126 @@
+#include "drape/compressed_texture.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace dp
+{
+namespace
+{
+uint8_t const kKtxIdentifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31,
+                                  0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+// The value is read as is if the container is written with the byte order of the reader.
+uint32_t const kKtxEndianness = 0x04030201;
+
+// Header of a KTX 1.1 container which follows the identifier.
+struct KtxHeader
+{
+  uint32_t m_endianness;
+  uint32_t m_glType;
+  uint32_t m_glTypeSize;
+  uint32_t m_glFormat;
+  uint32_t m_glInternalFormat;
+  uint32_t m_glBaseInternalFormat;
+  uint32_t m_pixelWidth;
+  uint32_t m_pixelHeight;
+  uint32_t m_pixelDepth;
+  uint32_t m_numberOfArrayElements;
+  uint32_t m_numberOfFaces;
+  uint32_t m_numberOfMipmapLevels;
+  uint32_t m_bytesOfKeyValueData;
+};
+
+// KTX containers store OpenGL internal formats of textures.
+uint32_t GetKtxInternalFormat(TextureFormat format)
+{
+  switch (format)
+  {
+  case TextureFormat::ETC2: return 0x9278;  // GL_COMPRESSED_RGBA8_ETC2_EAC
+  case TextureFormat::ASTC: return 0x93B0;  // GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+  case TextureFormat::BC3: return 0x83F3;   // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+  case TextureFormat::PVRTC: return 0x8C02; // GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG
+  default: CHECK(false, ("Not a compressed format.")); return 0;
+  }
+}
+}  // namespace
+
+std::string GetCompressedTextureSuffix(TextureFormat format)
+{
+  switch (format)
+  {
+  case TextureFormat::ETC2: return ".etc2.ktx";
+  case TextureFormat::ASTC: return ".astc.ktx";
+  case TextureFormat::BC3: return ".bc3.ktx";
+  case TextureFormat::PVRTC: return ".pvrtc.ktx";
+  default: CHECK(false, ("Not a compressed format.")); return {};
+  }
+}
+
+bool DecodeKtx(std::vector<uint8_t> const & data, TextureFormat format, CompressedImage & image)
+{
+  size_t const kHeaderSize = sizeof(kKtxIdentifier) + sizeof(KtxHeader);
+  if (data.size() < kHeaderSize || memcmp(data.data(), kKtxIdentifier, sizeof(kKtxIdentifier)) != 0)
+    return false;
+
+  KtxHeader header;
+  memcpy(&header, data.data() + sizeof(kKtxIdentifier), sizeof(header));
+  if (header.m_endianness != kKtxEndianness)
+  {
+    LOG(LWARNING, ("KTX containers with another byte order are not supported."));
+    return false;
+  }
+
+  // A compressed texture has no type and format of pixels. Only plain 2D textures are used.
+  if (header.m_glType != 0 || header.m_glFormat != 0 ||
+      header.m_glInternalFormat != GetKtxInternalFormat(format) || header.m_pixelWidth == 0 ||
+      header.m_pixelHeight == 0 || header.m_pixelDepth != 0 ||
+      header.m_numberOfArrayElements != 0 || header.m_numberOfFaces != 1)
+  {
+    return false;
+  }
+
+  // PVRTC textures must be square.
+  if (format == TextureFormat::PVRTC && header.m_pixelWidth != header.m_pixelHeight)
+    return false;
+
+  size_t const imageSizePos = kHeaderSize + header.m_bytesOfKeyValueData;
+  if (imageSizePos < kHeaderSize || data.size() < imageSizePos + sizeof(uint32_t))
+    return false;
+
+  uint32_t imageSize;
+  memcpy(&imageSize, data.data() + imageSizePos, sizeof(imageSize));
+  if (imageSize != GetCompressedDataSize(format, header.m_pixelWidth, header.m_pixelHeight) ||
+      data.size() - imageSizePos - sizeof(uint32_t) < imageSize)
+  {
+    return false;
+  }
+
+  auto const imageBegin = data.cbegin() + imageSizePos + sizeof(uint32_t);
+  image.m_width = header.m_pixelWidth;
+  image.m_height = header.m_pixelHeight;
+  image.m_data.assign(imageBegin, imageBegin + imageSize);
+  return true;
+}
+
+bool ReadCompressedTexture(ReaderPtr<Reader> reader, TextureFormat format,
+                           CompressedImage & image)
+{
+  std::vector<uint8_t> data;
+  try
+  {
+    CHECK_LESS(reader.Size(), static_cast<uint64_t>(std::numeric_limits<size_t>::max()), ());
+    data.resize(static_cast<size_t>(reader.Size()));
+    reader.Read(0, data.data(), data.size());
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Error reading compressed texture:", e.what()));
+    return false;
+  }
+
+  return DecodeKtx(data, format, image);
+}
+}  // namespace dp
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "drape/texture_types.hpp"
+
+#include "coding/reader.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dp
+{
+// Top mip level of a precompressed texture.
+struct CompressedImage
+{
+  uint32_t m_width = 0;
+  uint32_t m_height = 0;
+  std::vector<uint8_t> m_data;
+};
+
+// Precompressed variants of a texture are stored next to its png in KTX 1.1 containers,
+// e.g. "symbols.astc.ktx" for "symbols.png". Returns the suffix of such a file name.
+std::string GetCompressedTextureSuffix(TextureFormat format);
+
+// Decodes the top mip level of a KTX 1.1 container. Returns false if the container is damaged
+// or contains a texture of another format than |format|.
+bool DecodeKtx(std::vector<uint8_t> const & data, TextureFormat format, CompressedImage & image);
+
+// Reads and decodes a KTX 1.1 container. Returns false if the container can't be read.
+bool ReadCompressedTexture(ReaderPtr<Reader> reader, TextureFormat format,
+                           CompressedImage & image);
+}  // namespace dp
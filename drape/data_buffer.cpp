@@ -54,6 +54,26 @@ void DataBuffer::MoveToGPU(ref_ptr<GraphicsContext> context, GPUBuffer::Target t
   }
 }
 
+void DataBuffer::MoveToSharedGPU(ref_ptr<GraphicsContext> context, GPUBuffer::Target target)
+{
+  uint32_t const currentSize = m_impl->GetCurrentSize();
+  auto const apiVersion = context->GetApiVersion();
+  if (currentSize != 0 &&
+      (apiVersion == dp::ApiVersion::OpenGLES2 || apiVersion == dp::ApiVersion::OpenGLES3))
+  {
+    uint8_t const elementSize = m_impl->GetElementSize();
+    auto const range = GpuBufferArena::Instance().Allocate(target, currentSize * elementSize);
+    if (range.IsValid())
+    {
+      m_impl = make_unique_dp<ArenaGpuBufferImpl>(target, range, m_impl->Data(), elementSize,
+                                                  currentSize);
+      return;
+    }
+  }
+
+  MoveToGPU(context, target);
+}
+
 DataBufferMapper::DataBufferMapper(ref_ptr<DataBuffer> buffer, uint32_t elementOffset,
                                    uint32_t elementCount)
   : m_buffer(buffer)
@@ -24,6 +24,9 @@ public:
   virtual void Bind() = 0;
   virtual void * Map(uint32_t elementOffset, uint32_t elementCount) = 0;
   virtual void Unmap() = 0;
+
+  // Offset of the data in the bound GPU buffer, which is non-zero for shared buffers only.
+  virtual uint32_t GetByteOffset() const { return 0; }
 };
 
 class DataBuffer
@@ -33,6 +36,9 @@ public:
 
   ref_ptr<DataBufferBase> GetBuffer() const;
   void MoveToGPU(ref_ptr<GraphicsContext> context, GPUBuffer::Target target);
+  // Moves filled data to a range of a shared GPU buffer of GpuBufferArena. Such buffer can't be
+  // mapped or filled further. Falls back to MoveToGPU when the arena can't take the data.
+  void MoveToSharedGPU(ref_ptr<GraphicsContext> context, GPUBuffer::Target target);
 
 private:
   // Definition of this method is in a .mm-file.
@@ -3,6 +3,7 @@
 #include "drape/cpu_buffer.hpp"
 #include "drape/data_buffer.hpp"
 #include "drape/gpu_buffer.hpp"
+#include "drape/gpu_buffer_arena.hpp"
 
 #include <cstdint>
 #include <utility>
@@ -99,4 +100,43 @@ public:
 
   void Unmap() override { m_buffer->Unmap(); }
 };
+
+// Implementation of data buffer in a range of a shared GPU buffer.
+class ArenaGpuBufferImpl : public DataBufferImpl<ArenaGPUBuffer>
+{
+public:
+  template <typename... Args>
+  ArenaGpuBufferImpl(Args &&... params)
+    : DataBufferImpl(std::forward<Args>(params)...)
+  {}
+
+  void const * Data() const override
+  {
+    ASSERT(false, ("Retrieving of raw data is unavailable for GPU buffer"));
+    return nullptr;
+  }
+
+  void UploadData(void const * data, uint32_t elementCount) override
+  {
+    m_buffer->UploadData(data, elementCount);
+  }
+
+  void UpdateData(void * destPtr, void const * srcPtr, uint32_t elementOffset,
+                  uint32_t elementCount) override
+  {
+    ASSERT(false, ("Data updating is unavailable for shared GPU buffer"));
+  }
+
+  void Bind() override { m_buffer->Bind(); }
+
+  void * Map(uint32_t elementOffset, uint32_t elementCount) override
+  {
+    ASSERT(false, ("Mapping is unavailable for shared GPU buffer"));
+    return nullptr;
+  }
+
+  void Unmap() override { ASSERT(false, ("Unmapping is unavailable for shared GPU buffer")); }
+
+  uint32_t GetByteOffset() const override { return m_buffer->GetByteOffset(); }
+};
 }  // namespace dp
@@ -0,0 +1,75 @@
+#include "testing/testing.hpp"
+
+#include "drape/compressed_texture.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+void PushUint32(std::vector<uint8_t> & data, uint32_t value)
+{
+  auto const pos = data.size();
+  data.resize(pos + sizeof(value));
+  memcpy(data.data() + pos, &value, sizeof(value));
+}
+
+std::vector<uint8_t> MakeKtx(uint32_t internalFormat, uint32_t width, uint32_t height,
+                             std::vector<uint8_t> const & image)
+{
+  std::vector<uint8_t> data = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31,
+                               0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  PushUint32(data, 0x04030201);      // endianness
+  PushUint32(data, 0);               // glType
+  PushUint32(data, 1);               // glTypeSize
+  PushUint32(data, 0);               // glFormat
+  PushUint32(data, internalFormat);  // glInternalFormat
+  PushUint32(data, 0x1908);          // glBaseInternalFormat
+  PushUint32(data, width);
+  PushUint32(data, height);
+  PushUint32(data, 0);               // pixelDepth
+  PushUint32(data, 0);               // numberOfArrayElements
+  PushUint32(data, 1);               // numberOfFaces
+  PushUint32(data, 1);               // numberOfMipmapLevels
+  PushUint32(data, 8);               // bytesOfKeyValueData
+  data.resize(data.size() + 8, 0);
+  PushUint32(data, static_cast<uint32_t>(image.size()));
+  data.insert(data.end(), image.begin(), image.end());
+  return data;
+}
+}  // namespace
+
+UNIT_TEST(DecodeKtx_Smoke)
+{
+  uint32_t constexpr kASTC4x4 = 0x93B0;
+  // 8x4 texture has two 4x4 blocks.
+  std::vector<uint8_t> image(32);
+  for (size_t i = 0; i < image.size(); ++i)
+    image[i] = static_cast<uint8_t>(i);
+
+  auto const data = MakeKtx(kASTC4x4, 8 /* width */, 4 /* height */, image);
+
+  dp::CompressedImage result;
+  TEST(dp::DecodeKtx(data, dp::TextureFormat::ASTC, result), ());
+  TEST_EQUAL(result.m_width, 8, ());
+  TEST_EQUAL(result.m_height, 4, ());
+  TEST_EQUAL(result.m_data, image, ());
+
+  // Another format.
+  TEST(!dp::DecodeKtx(data, dp::TextureFormat::ETC2, result), ());
+
+  // Truncated image.
+  auto truncated = data;
+  truncated.pop_back();
+  TEST(!dp::DecodeKtx(truncated, dp::TextureFormat::ASTC, result), ());
+
+  // Size of the image doesn't match the size of the texture.
+  TEST(!dp::DecodeKtx(MakeKtx(kASTC4x4, 8 /* width */, 8 /* height */, image),
+                      dp::TextureFormat::ASTC, result), ());
+
+  // Non-square PVRTC texture.
+  uint32_t constexpr kPVRTC4Bpp = 0x8C02;
+  TEST(!dp::DecodeKtx(MakeKtx(kPVRTC4Bpp, 8 /* width */, 4 /* height */, image),
+                      dp::TextureFormat::PVRTC, result), ());
+}
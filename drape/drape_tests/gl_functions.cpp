@@ -15,6 +15,8 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
   MOCK_CALL(Init(apiVersion));
 }
 
+void GLFunctions::ResetStateCache() {}
+
 void GLFunctions::glFlush() {}
 
 void GLFunctions::glFinish() {}
@@ -235,6 +237,12 @@ void GLFunctions::glTexSubImage2D(int x, int y, int width, int height, glConst l
   MOCK_CALL(glTexSubImage2D(x, y, width, height, layout, pixelType, data));
 }
 
+void GLFunctions::glCompressedTexImage2D(int width, int height, glConst internalFormat,
+                                         uint32_t dataSize, void const * data)
+{
+  MOCK_CALL(glCompressedTexImage2D(width, height, internalFormat, dataSize, data));
+}
+
 void GLFunctions::glTexParameter(glConst param, glConst value)
 {
   MOCK_CALL(glTexParameter(param, value));
@@ -315,6 +323,13 @@ void * GLFunctions::glMapBufferRange(glConst, uint32_t, uint32_t, glConst) { ret
 
 void GLFunctions::glUnmapBuffer(glConst target) {}
 
+bool GLFunctions::glGetProgramBinary(uint32_t, glConst &, std::vector<uint8_t> &) { return false; }
+
+bool GLFunctions::glProgramBinary(uint32_t, glConst, std::vector<uint8_t> const &)
+{
+  return false;
+}
+
 void GLFunctions::glDrawElements(glConst primitive, uint32_t sizeOfIndex,
                                  uint32_t indexCount, uint32_t startIndex) {}
 
@@ -80,6 +80,7 @@ public:
   MOCK_METHOD1(glBindTexture, void(uint32_t));
   MOCK_METHOD5(glTexImage2D, void(int, int, glConst, glConst, void const *));
   MOCK_METHOD7(glTexSubImage2D, void(int, int, int, int, glConst, glConst, void const *));
+  MOCK_METHOD5(glCompressedTexImage2D, void(int, int, glConst, uint32_t, void const *));
   MOCK_METHOD2(glTexParameter, void(glConst, glConst));
 
   MOCK_METHOD1(glGetInteger, int32_t(glConst));
@@ -0,0 +1,58 @@
+#include "testing/testing.hpp"
+
+#include "drape/gpu_buffer_arena.hpp"
+
+#include <cstdint>
+
+using namespace dp;
+
+UNIT_TEST(BufferRangeAllocator_FirstFit)
+{
+  BufferRangeAllocator allocator(100 /* size */);
+
+  uint32_t a = 0, b = 0, c = 0;
+  TEST(allocator.Allocate(30, a), ());
+  TEST(allocator.Allocate(30, b), ());
+  TEST(allocator.Allocate(30, c), ());
+  TEST_EQUAL(a, 0, ());
+  TEST_EQUAL(b, 30, ());
+  TEST_EQUAL(c, 60, ());
+  TEST_EQUAL(allocator.GetFreeSize(), 10, ());
+
+  uint32_t d = 0;
+  TEST(!allocator.Allocate(20, d), ());
+
+  // Freed range is reused.
+  allocator.Free(b, 30);
+  TEST(allocator.Allocate(20, d), ());
+  TEST_EQUAL(d, 30, ());
+}
+
+UNIT_TEST(BufferRangeAllocator_FreedRangesAreMerged)
+{
+  BufferRangeAllocator allocator(90 /* size */);
+
+  uint32_t a = 0, b = 0, c = 0;
+  TEST(allocator.Allocate(30, a), ());
+  TEST(allocator.Allocate(30, b), ());
+  TEST(allocator.Allocate(30, c), ());
+
+  allocator.Free(a, 30);
+  allocator.Free(c, 30);
+  uint32_t d = 0;
+  TEST(!allocator.Allocate(60, d), ());
+
+  // The middle range joins both neighbours.
+  allocator.Free(b, 30);
+  TEST(allocator.IsEmpty(), ());
+  TEST(allocator.Allocate(90, d), ());
+  TEST_EQUAL(d, 0, ());
+}
+
+UNIT_TEST(GpuBufferArena_Disabled)
+{
+  auto & arena = GpuBufferArena::Instance();
+  TEST(!arena.IsEnabled(), ());
+  TEST(!arena.Allocate(GPUBuffer::ElementBuffer, 1024).IsValid(), ());
+  TEST_EQUAL(arena.GetBlocksCount(GPUBuffer::ElementBuffer), 0, ());
+}
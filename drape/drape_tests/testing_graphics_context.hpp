@@ -18,6 +18,10 @@ public:
   dp::ApiVersion GetApiVersion() const override { return m_apiVersion; }
   std::string GetRendererName() const override { return {}; }
   std::string GetRendererVersion() const override { return {}; }
+  bool IsTextureFormatSupported(dp::TextureFormat format) const override
+  {
+    return !dp::IsCompressedFormat(format);
+  }
 
   void PushDebugLabel(std::string const & label) override {}
   void PopDebugLabel() override {}
@@ -237,24 +237,80 @@ void GlyphIndex::UploadResources(ref_ptr<Texture> texture)
   if (pendingNodes.empty())
     return;
 
-  for (size_t i = 0; i < pendingNodes.size(); ++i)
+  // Glyphs are packed in rows, so the glyphs which are packed one after another in a row
+  // are uploaded by a single call. Texels under the glyphs which are lower than the row
+  // are never used by other glyphs, they are zeroed.
+  std::sort(pendingNodes.begin(), pendingNodes.end(),
+            [](PendingNode const & l, PendingNode const & r)
+  {
+    if (l.first.minY() != r.first.minY())
+      return l.first.minY() < r.first.minY();
+    return l.first.minX() < r.first.minX();
+  });
+
+  std::vector<uint8_t> rowBuffer;
+  for (size_t i = 0; i < pendingNodes.size();)
   {
     GlyphManager::Glyph & glyph = pendingNodes[i].second;
     m2::RectU const rect = pendingNodes[i].first;
-    m2::PointU const zeroPoint = rect.LeftBottom();
     if (glyph.m_image.m_width == 0 || glyph.m_image.m_height == 0 || rect.SizeX() == 0 || rect.SizeY() == 0)
     {
       LOG(LWARNING, ("Glyph skipped", glyph.m_code));
+      glyph.m_image.Destroy();
+      ++i;
       continue;
     }
     ASSERT_EQUAL(glyph.m_image.m_width, rect.SizeX(), ());
     ASSERT_EQUAL(glyph.m_image.m_height, rect.SizeY(), ());
 
-    uint8_t * srcMemory = SharedBufferManager::GetRawPointer(glyph.m_image.m_data);
-    texture->UploadData(zeroPoint.x, zeroPoint.y, rect.SizeX(), rect.SizeY(), make_ref(srcMemory));
-    
-    glyph.m_image.Destroy();
+    size_t end = i + 1;
+    uint32_t maxY = rect.maxY();
+    while (end < pendingNodes.size() && IsUploadedWithPrevious(pendingNodes[end - 1].first,
+                                                               pendingNodes[end]))
+    {
+      maxY = std::max(maxY, pendingNodes[end].first.maxY());
+      ++end;
+    }
+
+    if (end == i + 1)
+    {
+      uint8_t * srcMemory = SharedBufferManager::GetRawPointer(glyph.m_image.m_data);
+      texture->UploadData(rect.minX(), rect.minY(), rect.SizeX(), rect.SizeY(), make_ref(srcMemory));
+      glyph.m_image.Destroy();
+      ++i;
+      continue;
+    }
+
+    uint32_t const width = pendingNodes[end - 1].first.maxX() - rect.minX();
+    uint32_t const height = maxY - rect.minY();
+    rowBuffer.assign(static_cast<size_t>(width) * height, 0);
+    for (; i < end; ++i)
+    {
+      GlyphManager::Glyph & g = pendingNodes[i].second;
+      uint32_t const offsetX = pendingNodes[i].first.minX() - rect.minX();
+      uint8_t const * srcMemory = SharedBufferManager::GetRawPointer(g.m_image.m_data);
+      for (uint32_t y = 0; y < g.m_image.m_height; ++y)
+      {
+        std::copy(srcMemory + y * g.m_image.m_width, srcMemory + (y + 1) * g.m_image.m_width,
+                  rowBuffer.data() + y * width + offsetX);
+      }
+      g.m_image.Destroy();
+    }
+    texture->UploadData(rect.minX(), rect.minY(), width, height, make_ref(rowBuffer.data()));
+  }
+}
+
+// static
+bool GlyphIndex::IsUploadedWithPrevious(m2::RectU const & previousRect, PendingNode const & node)
+{
+  m2::RectU const & rect = node.first;
+  GlyphManager::Glyph const & glyph = node.second;
+  if (glyph.m_image.m_width == 0 || glyph.m_image.m_height == 0 || rect.SizeX() == 0 ||
+      rect.SizeY() == 0)
+  {
+    return false;
   }
+  return rect.minY() == previousRect.minY() && rect.minX() == previousRect.maxX();
 }
 
 uint32_t GlyphIndex::GetAbsentGlyphsCount(strings::UniString const & text, int fixedHeight) const
@@ -106,6 +106,8 @@ private:
   using PendingNode = std::pair<m2::RectU, GlyphManager::Glyph>;
   using PendingNodes = std::vector<PendingNode>;
 
+  static bool IsUploadedWithPrevious(m2::RectU const & previousRect, PendingNode const & node);
+
   ResourceMapping m_index;
   PendingNodes m_pendingNodes;
   std::mutex m_mutex;
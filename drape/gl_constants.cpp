@@ -33,6 +33,22 @@
   #define GL_LUMINANCE_ALPHA 0x190A
 #endif
 
+#if !defined(GL_COMPRESSED_RGBA8_ETC2_EAC)
+  #define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+#if !defined(GL_COMPRESSED_RGBA_ASTC_4x4_KHR)
+  #define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+
+#if !defined(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+  #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#if !defined(GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG)
+  #define GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG 0x8C02
+#endif
+
 #if defined(GL_WRITE_ONLY)
   #define WRITE_ONLY_DEF GL_WRITE_ONLY
 #elif defined(GL_WRITE_ONLY_OES)
@@ -154,6 +170,11 @@ const glConst GLAlphaLuminance4     = GL_LUMINANCE8_ALPHA4_OES;
 const glConst GLRed                 = GL_RED;
 const glConst GLRedGreen            = GL_RG;
 
+const glConst GLCompressedRGBA8ETC2      = GL_COMPRESSED_RGBA8_ETC2_EAC;
+const glConst GLCompressedRGBAASTC4x4    = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+const glConst GLCompressedRGBAS3TCDXT5   = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+const glConst GLCompressedRGBAPVRTC4Bpp  = GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG;
+
 const glConst GL8BitOnChannel       = GL_UNSIGNED_BYTE;
 const glConst GL4BitOnChannel       = GL_UNSIGNED_SHORT_4_4_4_4;
 
@@ -72,6 +72,12 @@ extern const glConst GLAlphaLuminance4;
 extern const glConst GLRed;
 extern const glConst GLRedGreen;
 
+/// Compressed texture layouts
+extern const glConst GLCompressedRGBA8ETC2;
+extern const glConst GLCompressedRGBAASTC4x4;
+extern const glConst GLCompressedRGBAS3TCDXT5;
+extern const glConst GLCompressedRGBAPVRTC4Bpp;
+
 /// Pixel type for texture upload
 extern const glConst GL8BitOnChannel;
 extern const glConst GL4BitOnChannel;
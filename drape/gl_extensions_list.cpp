@@ -64,6 +64,17 @@ void GLExtensionsList::Init(dp::ApiVersion apiVersion)
     SetExtension(MapBufferRange, true);
   }
 #endif
+
+#if defined(OMIM_OS_MOBILE)
+  // ETC2 is a mandatory part of OpenGL ES3.
+  SetExtension(TextureCompressionETC2, apiVersion == dp::ApiVersion::OpenGLES3);
+#else
+  // Desktop drivers decompress ETC2 textures on upload, so they save no memory there.
+  SetExtension(TextureCompressionETC2, false);
+#endif
+  CheckExtension(TextureCompressionASTC, "GL_KHR_texture_compression_astc_ldr");
+  CheckExtension(TextureCompressionS3TC, "GL_EXT_texture_compression_s3tc");
+  CheckExtension(TextureCompressionPVRTC, "GL_IMG_texture_compression_pvrtc");
 }
 
 bool GLExtensionsList::IsSupported(ExtensionName extName) const
@@ -17,7 +17,11 @@ public:
     VertexArrayObject,
     MapBuffer,
     UintIndices,
-    MapBufferRange
+    MapBufferRange,
+    TextureCompressionETC2,
+    TextureCompressionASTC,
+    TextureCompressionS3TC,
+    TextureCompressionPVRTC
   };
 
   GLExtensionsList() = default;
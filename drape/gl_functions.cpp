@@ -11,6 +11,8 @@
 #include "std/target_os.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <limits>
 #include <map>
 #include <mutex>
@@ -40,6 +42,124 @@ std::mutex g_boundBuffersMutex;
 
 inline GLboolean convert(bool v) { return static_cast<GLboolean>(v ? GL_TRUE : GL_FALSE); }
 
+// Drivers don't filter out redundant state changes, and every call costs CPU time on the render
+// thread. The cache skips calls which don't change the state. GL state belongs to a context and
+// every rendering thread has its own context, so the cache is per thread.
+class GLStateCache
+{
+public:
+  // Returns false if |programId| is already used.
+  bool UseProgram(uint32_t programId)
+  {
+    if (m_isProgramKnown && m_program == programId)
+      return false;
+    m_program = programId;
+    m_isProgramKnown = true;
+    return true;
+  }
+
+  void OnProgramDeleted(uint32_t programId)
+  {
+    if (m_program == programId)
+      m_isProgramKnown = false;
+  }
+
+  bool ActiveTexture(glConst texBlock)
+  {
+    if (m_isActiveTextureKnown && m_activeTexture == texBlock)
+      return false;
+    m_activeTexture = texBlock;
+    m_isActiveTextureKnown = true;
+    return true;
+  }
+
+  bool BindTexture(uint32_t textureId)
+  {
+    // Names of deleted textures may be reused by new textures of any shared context.
+    auto const epoch = s_texturesEpoch.load();
+    if (m_texturesEpoch != epoch)
+    {
+      m_boundTextures.fill(kUnknownTexture);
+      m_texturesEpoch = epoch;
+    }
+
+    if (!m_isActiveTextureKnown || m_activeTexture < GL_TEXTURE0 ||
+        m_activeTexture - GL_TEXTURE0 >= m_boundTextures.size())
+    {
+      return true;
+    }
+
+    auto & boundTexture = m_boundTextures[m_activeTexture - GL_TEXTURE0];
+    if (boundTexture == textureId)
+      return false;
+    boundTexture = textureId;
+    return true;
+  }
+
+  static void OnTextureDeleted() { ++s_texturesEpoch; }
+
+  bool SetEnabled(glConst mode, bool isEnabled)
+  {
+    auto it = std::find_if(m_modes.begin(), m_modes.end(),
+                           [mode](std::pair<glConst, bool> const & m) { return m.first == mode; });
+    if (it == m_modes.end())
+    {
+      m_modes.emplace_back(mode, isEnabled);
+      return true;
+    }
+    if (it->second == isEnabled)
+      return false;
+    it->second = isEnabled;
+    return true;
+  }
+
+  bool DepthFunc(glConst depthFunc)
+  {
+    if (m_isDepthFuncKnown && m_depthFunc == depthFunc)
+      return false;
+    m_depthFunc = depthFunc;
+    m_isDepthFuncKnown = true;
+    return true;
+  }
+
+  void Reset()
+  {
+    m_isProgramKnown = false;
+    m_isActiveTextureKnown = false;
+    m_boundTextures.fill(kUnknownTexture);
+    m_modes.clear();
+    m_isDepthFuncKnown = false;
+  }
+
+private:
+  static uint32_t constexpr kUnknownTexture = std::numeric_limits<uint32_t>::max();
+  static std::atomic<uint32_t> s_texturesEpoch;
+
+  uint32_t m_program = 0;
+  bool m_isProgramKnown = false;
+
+  glConst m_activeTexture = 0;
+  bool m_isActiveTextureKnown = false;
+
+  // Textures bound to the first texture units, other units are not cached.
+  std::array<uint32_t, 8> m_boundTextures = {{kUnknownTexture, kUnknownTexture, kUnknownTexture,
+                                              kUnknownTexture, kUnknownTexture, kUnknownTexture,
+                                              kUnknownTexture, kUnknownTexture}};
+  uint32_t m_texturesEpoch = 0;
+
+  std::vector<std::pair<glConst, bool>> m_modes;
+
+  glConst m_depthFunc = 0;
+  bool m_isDepthFuncKnown = false;
+};
+
+// static
+uint32_t constexpr GLStateCache::kUnknownTexture;
+// static
+std::atomic<uint32_t> GLStateCache::s_texturesEpoch(0);
+
+thread_local GLStateCache g_stateCache;
+
 typedef void(DP_APIENTRY * TglClearColorFn)(GLfloat r, GLfloat g, GLfloat b, GLfloat a);
 typedef void(DP_APIENTRY * TglClearFn)(GLbitfield mask);
 typedef void(DP_APIENTRY * TglViewportFn)(GLint x, GLint y, GLsizei w, GLsizei h);
@@ -47,6 +167,9 @@ typedef void(DP_APIENTRY * TglScissorFn)(GLint x, GLint y, GLsizei w, GLsizei h)
 typedef void(DP_APIENTRY * TglFlushFn)();
 
 typedef void(DP_APIENTRY * TglActiveTextureFn)(GLenum texture);
+typedef void(DP_APIENTRY * TglCompressedTexImage2DFn)(GLenum target, GLint level, GLenum internalformat,
+                                                      GLsizei width, GLsizei height, GLint border,
+                                                      GLsizei imageSize, void const * data);
 typedef void(DP_APIENTRY * TglBlendEquationFn)(GLenum mode);
 
 typedef void(DP_APIENTRY * TglGenVertexArraysFn)(GLsizei n, GLuint * ids);
@@ -85,6 +208,11 @@ typedef void(DP_APIENTRY * TglDeleteProgramFn)(GLuint programID);
 typedef void(DP_APIENTRY * TglGetProgramivFn)(GLuint programID, GLenum name, GLint * p);
 typedef void(DP_APIENTRY * TglGetProgramInfoLogFn)(GLuint programID, GLsizei maxLength,
                                                    GLsizei * length, GLchar * infoLog);
+typedef void(DP_APIENTRY * TglGetProgramBinaryFn)(GLuint programID, GLsizei bufSize,
+                                                  GLsizei * length, GLenum * binaryFormat,
+                                                  GLvoid * binary);
+typedef void(DP_APIENTRY * TglProgramBinaryFn)(GLuint programID, GLenum binaryFormat,
+                                               GLvoid const * binary, GLsizei length);
 
 typedef void(DP_APIENTRY * TglUseProgramFn)(GLuint programID);
 typedef GLint(DP_APIENTRY * TglGetAttribLocationFn)(GLuint program, GLchar const * name);
@@ -130,6 +258,7 @@ TglScissorFn glScissorFn = nullptr;
 TglFlushFn glFlushFn = nullptr;
 
 TglActiveTextureFn glActiveTextureFn = nullptr;
+TglCompressedTexImage2DFn glCompressedTexImage2DFn = nullptr;
 TglBlendEquationFn glBlendEquationFn = nullptr;
 
 /// VAO
@@ -164,6 +293,8 @@ TglLinkProgramFn glLinkProgramFn = nullptr;
 TglDeleteProgramFn glDeleteProgramFn = nullptr;
 TglGetProgramivFn glGetProgramivFn = nullptr;
 TglGetProgramInfoLogFn glGetProgramInfoLogFn = nullptr;
+TglGetProgramBinaryFn glGetProgramBinaryFn = nullptr;
+TglProgramBinaryFn glProgramBinaryFn = nullptr;
 
 TglUseProgramFn glUseProgramFn = nullptr;
 TglGetAttribLocationFn glGetAttribLocationFn = nullptr;
@@ -198,6 +329,10 @@ TglGetStringiFn glGetStringiFn = nullptr;
   #define GL_NUM_EXTENSIONS 0x821D
 #endif
 
+#if !defined(GL_PROGRAM_BINARY_LENGTH)
+  #define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
 std::mutex s_mutex;
 bool s_inited = false;
 }  // namespace
@@ -281,6 +416,8 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
     glMapBufferRangeFn = ::glMapBufferRange;
     glFlushMappedBufferRangeFn = ::glFlushMappedBufferRange;
     glGetStringiFn = ::glGetStringi;
+    glGetProgramBinaryFn = ::glGetProgramBinary;
+    glProgramBinaryFn = ::glProgramBinary;
   }
   else
   {
@@ -306,6 +443,8 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
     glMapBufferRangeFn = &::glMapBufferRange;
     glFlushMappedBufferRangeFn = &::glFlushMappedBufferRange;
     glGetStringiFn = &::glGetStringi;
+    glGetProgramBinaryFn = &::glGetProgramBinary;
+    glProgramBinaryFn = &::glProgramBinary;
   }
   else
   {
@@ -329,6 +468,7 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
   glFlushFn = LOAD_GL_FUNC(TglFlushFn, glFlush);
 
   glActiveTextureFn = LOAD_GL_FUNC(TglActiveTextureFn, glActiveTexture);
+  glCompressedTexImage2DFn = LOAD_GL_FUNC(TglCompressedTexImage2DFn, glCompressedTexImage2D);
   glBlendEquationFn = LOAD_GL_FUNC(TglBlendEquationFn, glBlendEquation);
 
   /// VBO
@@ -392,6 +532,12 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
   glCheckFramebufferStatusFn = LOAD_GL_FUNC(TglCheckFramebufferStatusFn, glCheckFramebufferStatus);
 }
 
+// static
+void GLFunctions::ResetStateCache()
+{
+  g_stateCache.Reset();
+}
+
 bool GLFunctions::glHasExtension(std::string const & name)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
@@ -539,13 +685,15 @@ int32_t GLFunctions::glGetBufferParameter(glConst target, glConst name)
 void GLFunctions::glEnable(glConst mode)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
-  GLCHECK(::glEnable(mode));
+  if (g_stateCache.SetEnabled(mode, true /* isEnabled */))
+    GLCHECK(::glEnable(mode));
 }
 
 void GLFunctions::glDisable(glConst mode)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
-  GLCHECK(::glDisable(mode));
+  if (g_stateCache.SetEnabled(mode, false /* isEnabled */))
+    GLCHECK(::glDisable(mode));
 }
 
 void GLFunctions::glClearDepthValue(double depth)
@@ -567,7 +715,8 @@ void GLFunctions::glDepthMask(bool needWriteToDepthBuffer)
 void GLFunctions::glDepthFunc(glConst depthFunc)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
-  GLCHECK(::glDepthFunc(depthFunc));
+  if (g_stateCache.DepthFunc(depthFunc))
+    GLCHECK(::glDepthFunc(depthFunc));
 }
 
 void GLFunctions::glBlendEquation(glConst function)
@@ -789,10 +938,53 @@ bool GLFunctions::glLinkProgram(uint32_t programID, std::string & errorLog)
   return false;
 }
 
+bool GLFunctions::glGetProgramBinary(uint32_t programID, glConst & binaryFormat,
+                                     std::vector<uint8_t> & binary)
+{
+  ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
+  if (glGetProgramBinaryFn == nullptr)
+    return false;
+
+  ASSERT(glGetProgramivFn != nullptr, ());
+  GLint length = 0;
+  GLCHECK(glGetProgramivFn(programID, GL_PROGRAM_BINARY_LENGTH, &length));
+  if (length <= 0)
+    return false;
+
+  binary.resize(static_cast<size_t>(length));
+  GLsizei writtenLength = 0;
+  GLenum format = 0;
+  GLCHECK(glGetProgramBinaryFn(programID, length, &writtenLength, &format, binary.data()));
+  if (writtenLength <= 0)
+    return false;
+
+  binary.resize(static_cast<size_t>(writtenLength));
+  binaryFormat = format;
+  return true;
+}
+
+bool GLFunctions::glProgramBinary(uint32_t programID, glConst binaryFormat,
+                                  std::vector<uint8_t> const & binary)
+{
+  ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
+  if (glProgramBinaryFn == nullptr || binary.empty())
+    return false;
+
+  ASSERT(glGetProgramivFn != nullptr, ());
+  // A binary of another driver version is rejected with an unsuccessful link status.
+  GLCHECK(glProgramBinaryFn(programID, binaryFormat, binary.data(),
+                            static_cast<GLsizei>(binary.size())));
+
+  GLint result = GL_FALSE;
+  GLCHECK(glGetProgramivFn(programID, GL_LINK_STATUS, &result));
+  return result == GL_TRUE;
+}
+
 void GLFunctions::glDeleteProgram(uint32_t programID)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
   ASSERT(glDeleteProgramFn != nullptr, ());
+  g_stateCache.OnProgramDeleted(programID);
   GLCHECK(glDeleteProgramFn(programID));
 }
 
@@ -800,7 +992,8 @@ void GLFunctions::glUseProgram(uint32_t programID)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
   ASSERT(glUseProgramFn != nullptr, ());
-  GLCHECK(glUseProgramFn(programID));
+  if (g_stateCache.UseProgram(programID))
+    GLCHECK(glUseProgramFn(programID));
 }
 
 int8_t GLFunctions::glGetAttribLocation(uint32_t programID, std::string const & name)
@@ -967,7 +1160,8 @@ void GLFunctions::glActiveTexture(glConst texBlock)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
   ASSERT(glActiveTextureFn != nullptr, ());
-  GLCHECK(glActiveTextureFn(texBlock));
+  if (g_stateCache.ActiveTexture(texBlock))
+    GLCHECK(glActiveTextureFn(texBlock));
 }
 
 uint32_t GLFunctions::glGenTexture()
@@ -982,12 +1176,14 @@ void GLFunctions::glDeleteTexture(uint32_t id)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
   GLCHECK(::glDeleteTextures(1, &id));
+  GLStateCache::OnTextureDeleted();
 }
 
 void GLFunctions::glBindTexture(uint32_t textureID)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
-  GLCHECK(::glBindTexture(GL_TEXTURE_2D, textureID));
+  if (g_stateCache.BindTexture(textureID))
+    GLCHECK(::glBindTexture(GL_TEXTURE_2D, textureID));
 }
 
 void GLFunctions::glTexImage2D(int width, int height, glConst layout, glConst pixelType,
@@ -1036,6 +1232,15 @@ void GLFunctions::glTexSubImage2D(int x, int y, int width, int height, glConst l
   GLCHECK(::glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, layout, pixelType, data));
 }
 
+void GLFunctions::glCompressedTexImage2D(int width, int height, glConst internalFormat,
+                                         uint32_t dataSize, void const * data)
+{
+  ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
+  ASSERT(glCompressedTexImage2DFn != nullptr, ());
+  GLCHECK(glCompressedTexImage2DFn(GL_TEXTURE_2D, 0, internalFormat, width, height, 0,
+                                   static_cast<GLsizei>(dataSize), data));
+}
+
 void GLFunctions::glTexParameter(glConst param, glConst value)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
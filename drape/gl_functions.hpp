@@ -6,8 +6,10 @@
 
 #include "base/src_point.hpp"
 
+#include <cstdint>
 #include <string>
 #include <thread>
+#include <vector>
 
 class GLFunctions
 {
@@ -16,6 +18,9 @@ public:
   static dp::GLExtensionsList ExtensionsList;
 
   static void Init(dp::ApiVersion apiVersion);
+  // Forgets the state of the current thread's context, must be called when the context of
+  // the thread is created or recreated.
+  static void ResetStateCache();
 
   static bool glHasExtension(std::string const & name);
   static void glClearColor(float r, float g, float b, float a);
@@ -83,6 +88,12 @@ public:
   static void glAttachShader(uint32_t programID, uint32_t shaderID);
   static void glDetachShader(uint32_t programID, uint32_t shaderID);
   static bool glLinkProgram(uint32_t programID, std::string & errorLog);
+  /// Returns false if program binaries are not supported by the driver.
+  static bool glGetProgramBinary(uint32_t programID, glConst & binaryFormat,
+                                 std::vector<uint8_t> & binary);
+  /// Returns true if the program is linked successfully from |binary|.
+  static bool glProgramBinary(uint32_t programID, glConst binaryFormat,
+                              std::vector<uint8_t> const & binary);
   static void glDeleteProgram(uint32_t programID);
 
   static void glUseProgram(uint32_t programID);
@@ -135,6 +146,8 @@ public:
                            void const * data);
   static void glTexSubImage2D(int x, int y, int width, int height, glConst layout,
                               glConst pixelType, void const * data);
+  static void glCompressedTexImage2D(int width, int height, glConst internalFormat,
+                                     uint32_t dataSize, void const * data);
   static void glTexParameter(glConst param, glConst value);
 
   // Draw support
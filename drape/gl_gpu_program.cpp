@@ -35,9 +35,16 @@ GLGpuProgram::GLGpuProgram(std::string const & programName,
   }
 }
 
+GLGpuProgram::GLGpuProgram(std::string const & programName, uint32_t programID)
+  : GpuProgram(programName)
+  , m_programID(programID)
+{
+  LoadUniformLocations();
+}
+
 GLGpuProgram::~GLGpuProgram()
 {
-  if (SupportManager::Instance().IsTegraDevice())
+  if (SupportManager::Instance().IsTegraDevice() && m_vertexShader && m_fragmentShader)
   {
     GLFunctions::glDetachShader(m_programID, m_vertexShader->GetID());
     GLFunctions::glDetachShader(m_programID, m_fragmentShader->GetID());
@@ -16,8 +16,12 @@ class GLGpuProgram : public GpuProgram
 public:
   GLGpuProgram(std::string const & programName,
                ref_ptr<Shader> vertexShader, ref_ptr<Shader> fragmentShader);
+  // The program is already linked, e.g. it is loaded from a program binary.
+  GLGpuProgram(std::string const & programName, uint32_t programID);
   ~GLGpuProgram() override;
 
+  uint32_t GetID() const { return m_programID; }
+
   void Bind() override;
   void Unbind() override;
 
@@ -1,11 +1,19 @@
 #include "drape/glyph_generator.hpp"
 
+#include <algorithm>
 #include <iterator>
 
 using namespace std::placeholders;
 
 namespace dp
 {
+namespace
+{
+// Glyphs are split into tasks of this size to generate them on all threads of DrapeRoutine.
+// A new script on the screen (e.g. CJK) requests hundreds of glyphs at once.
+size_t constexpr kMaxGlyphsPerTask = 32;
+}  // namespace
+
 GlyphGenerator::GlyphGenerator(uint32_t sdfScale)
   : m_sdfScale(sdfScale)
 {}
@@ -78,8 +86,19 @@ void GlyphGenerator::GenerateGlyphs(ref_ptr<Listener> listener,
   std::swap(m_queue, queue);
   m_glyphsCounter += queue.size();
 
+  for (size_t i = 0; i < queue.size(); i += kMaxGlyphsPerTask)
+  {
+    auto const begin = std::make_move_iterator(queue.begin() + i);
+    auto const end = std::make_move_iterator(queue.begin() + std::min(i + kMaxGlyphsPerTask,
+                                                                      queue.size()));
+    RunTask(listener, GlyphGenerationDataArray(begin, end));
+  }
+}
+
+void GlyphGenerator::RunTask(ref_ptr<Listener> listener, GlyphGenerationDataArray && glyphs)
+{
   // Generate glyphs on the separate thread.
-  auto generateTask = std::make_shared<GenerateGlyphTask>(std::move(queue));
+  auto generateTask = std::make_shared<GenerateGlyphTask>(std::move(glyphs));
   auto result = DrapeRoutine::Run([this, listener, generateTask]() mutable
   {
     generateTask->Run(m_sdfScale);
@@ -87,9 +106,14 @@ void GlyphGenerator::GenerateGlyphs(ref_ptr<Listener> listener,
   });
 
   if (result)
+  {
     m_activeTasks.Add(generateTask, result);
+  }
   else
+  {
+    m_glyphsCounter -= generateTask->GetGlyphsCount();
     generateTask->DestroyAllGlyphs();
+  }
 }
 
 void GlyphGenerator::OnTaskFinished(ref_ptr<Listener> listener,
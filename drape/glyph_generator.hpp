@@ -55,6 +55,7 @@ public:
 
     GlyphGenerationDataArray && StealGeneratedGlyphs() { return std::move(m_generatedGlyphs); }
     bool IsCancelled() const { return m_isCancelled; }
+    size_t GetGlyphsCount() const { return m_glyphs.size(); }
     void DestroyAllGlyphs();
 
   private:
@@ -77,6 +78,8 @@ public:
   void FinishGeneration();
 
 private:
+  // Must be called under |m_mutex|.
+  void RunTask(ref_ptr<Listener> listener, GlyphGenerationDataArray && glyphs);
   void OnTaskFinished(ref_ptr<Listener> listener, std::shared_ptr<GenerateGlyphTask> const & task);
 
   uint32_t m_sdfScale;
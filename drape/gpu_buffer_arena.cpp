@@ -0,0 +1,220 @@
+#include "drape/gpu_buffer_arena.hpp"
+
+#include "drape/gl_functions.hpp"
+#include "drape/utils/gpu_mem_tracker.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace dp
+{
+namespace
+{
+glConst glTarget(GPUBuffer::Target t)
+{
+  if (t == GPUBuffer::ElementBuffer)
+    return gl_const::GLArrayBuffer;
+
+  return gl_const::GLElementArrayBuffer;
+}
+
+uint32_t AlignRangeSize(uint32_t size)
+{
+  uint32_t const alignment = GpuBufferArena::kRangeAlignment;
+  return (size + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+// BufferRangeAllocator ----------------------------------------------------------------------------
+BufferRangeAllocator::BufferRangeAllocator(uint32_t size) : m_size(size), m_freeSize(size)
+{
+  ASSERT_GREATER(m_size, 0, ());
+  m_freeRanges.emplace(0, m_size);
+}
+
+bool BufferRangeAllocator::Allocate(uint32_t size, uint32_t & offset)
+{
+  ASSERT_GREATER(size, 0, ());
+  auto const it = std::find_if(m_freeRanges.begin(), m_freeRanges.end(),
+                               [size](std::pair<uint32_t const, uint32_t> const & range)
+  {
+    return range.second >= size;
+  });
+  if (it == m_freeRanges.end())
+    return false;
+
+  offset = it->first;
+  uint32_t const rest = it->second - size;
+  m_freeRanges.erase(it);
+  if (rest != 0)
+    m_freeRanges.emplace(offset + size, rest);
+
+  m_freeSize -= size;
+  return true;
+}
+
+void BufferRangeAllocator::Free(uint32_t offset, uint32_t size)
+{
+  ASSERT_GREATER(size, 0, ());
+  ASSERT_LESS_OR_EQUAL(offset + size, m_size, ());
+
+  auto it = m_freeRanges.emplace(offset, size).first;
+  ASSERT_EQUAL(it->second, size, ("Range is freed twice"));
+  m_freeSize += size;
+
+  auto const next = std::next(it);
+  if (next != m_freeRanges.end())
+  {
+    ASSERT_LESS_OR_EQUAL(offset + size, next->first, ("Freed range overlaps a free one"));
+    if (offset + size == next->first)
+    {
+      it->second += next->second;
+      m_freeRanges.erase(next);
+    }
+  }
+
+  if (it != m_freeRanges.begin())
+  {
+    auto const prev = std::prev(it);
+    ASSERT_LESS_OR_EQUAL(prev->first + prev->second, offset, ("Freed range overlaps a free one"));
+    if (prev->first + prev->second == offset)
+    {
+      prev->second += it->second;
+      m_freeRanges.erase(it);
+    }
+  }
+}
+
+// GpuBufferArena ----------------------------------------------------------------------------------
+uint32_t constexpr GpuBufferArena::kBlockSize;
+uint32_t constexpr GpuBufferArena::kMaxRangeSize;
+uint32_t constexpr GpuBufferArena::kRangeAlignment;
+
+// static
+GpuBufferArena & GpuBufferArena::Instance()
+{
+  static GpuBufferArena arena;
+  return arena;
+}
+
+void GpuBufferArena::SetEnabled(bool enabled) { m_enabled = enabled; }
+
+bool GpuBufferArena::IsEnabled() const { return m_enabled; }
+
+GpuBufferRange GpuBufferArena::Allocate(GPUBuffer::Target target, uint32_t byteCount)
+{
+  GpuBufferRange range;
+  if (!m_enabled || byteCount == 0 || byteCount > kMaxRangeSize)
+    return range;
+
+  uint32_t const size = AlignRangeSize(byteCount);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto & blocks = m_blocks[target];
+  for (auto & block : blocks)
+  {
+    if (block.m_allocator.GetFreeSize() >= size &&
+        block.m_allocator.Allocate(size, range.m_byteOffset))
+    {
+      range.m_bufferID = block.m_bufferID;
+      break;
+    }
+  }
+
+  if (!range.IsValid())
+  {
+    uint32_t const bufferID = GLFunctions::glGenBuffer();
+    GLFunctions::glBindBuffer(bufferID, glTarget(target));
+    GLFunctions::glBufferData(glTarget(target), kBlockSize, nullptr, gl_const::GLStaticDraw);
+#if defined(TRACK_GPU_MEM)
+    dp::GPUMemTracker::Inst().AddAllocated("VBOArena", bufferID, kBlockSize);
+#endif
+
+    blocks.emplace_back(bufferID, kBlockSize);
+    VERIFY(blocks.back().m_allocator.Allocate(size, range.m_byteOffset), ());
+    range.m_bufferID = bufferID;
+  }
+
+  range.m_byteCount = size;
+
+#if defined(TRACK_GPU_MEM)
+  auto const it = std::find_if(blocks.begin(), blocks.end(), [&range](Block const & block)
+  {
+    return block.m_bufferID == range.m_bufferID;
+  });
+  dp::GPUMemTracker::Inst().SetUsed("VBOArena", range.m_bufferID,
+                                    kBlockSize - it->m_allocator.GetFreeSize());
+#endif
+  return range;
+}
+
+void GpuBufferArena::Free(GPUBuffer::Target target, GpuBufferRange const & range)
+{
+  if (!range.IsValid())
+    return;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto & blocks = m_blocks[target];
+  auto const it = std::find_if(blocks.begin(), blocks.end(), [&range](Block const & block)
+  {
+    return block.m_bufferID == range.m_bufferID;
+  });
+  CHECK(it != blocks.end(), ("Range of an unknown buffer", range.m_bufferID));
+
+  it->m_allocator.Free(range.m_byteOffset, range.m_byteCount);
+  if (!it->m_allocator.IsEmpty())
+  {
+#if defined(TRACK_GPU_MEM)
+    dp::GPUMemTracker::Inst().SetUsed("VBOArena", it->m_bufferID,
+                                      kBlockSize - it->m_allocator.GetFreeSize());
+#endif
+    return;
+  }
+
+  GLFunctions::glBindBuffer(0, glTarget(target));
+  GLFunctions::glDeleteBuffer(it->m_bufferID);
+#if defined(TRACK_GPU_MEM)
+  dp::GPUMemTracker::Inst().RemoveDeallocated("VBOArena", it->m_bufferID);
+#endif
+  blocks.erase(it);
+}
+
+size_t GpuBufferArena::GetBlocksCount(GPUBuffer::Target target) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_blocks.find(target);
+  return it != m_blocks.end() ? it->second.size() : 0;
+}
+
+// ArenaGPUBuffer ----------------------------------------------------------------------------------
+ArenaGPUBuffer::ArenaGPUBuffer(GPUBuffer::Target t, GpuBufferRange const & range,
+                               void const * data, uint8_t elementSize, uint32_t capacity)
+  : TBase(elementSize, capacity)
+  , m_t(t)
+  , m_range(range)
+{
+  ASSERT(m_range.IsValid(), ());
+  ASSERT_LESS_OR_EQUAL(capacity * elementSize, m_range.m_byteCount, ());
+  if (data != nullptr)
+    UploadData(data, capacity);
+}
+
+ArenaGPUBuffer::~ArenaGPUBuffer() { GpuBufferArena::Instance().Free(m_t, m_range); }
+
+void ArenaGPUBuffer::UploadData(void const * data, uint32_t elementCount)
+{
+  uint32_t const currentSize = GetCurrentSize();
+  uint8_t const elementSize = GetElementSize();
+  ASSERT(GetCapacity() >= elementCount + currentSize,
+         ("Not enough memory to upload ", elementCount, " elements"));
+
+  Bind();
+  GLFunctions::glBufferSubData(glTarget(m_t), elementCount * elementSize, data,
+                               m_range.m_byteOffset + currentSize * elementSize);
+  TBase::UploadData(elementCount);
+}
+
+void ArenaGPUBuffer::Bind() { GLFunctions::glBindBuffer(m_range.m_bufferID, glTarget(m_t)); }
+}  // namespace dp
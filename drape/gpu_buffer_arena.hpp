@@ -0,0 +1,109 @@
+#pragma once
+
+#include "drape/buffer_base.hpp"
+#include "drape/gpu_buffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace dp
+{
+// Keeps free ranges of a memory block. Allocation is first fit, freed ranges are merged
+// with adjacent free ones.
+class BufferRangeAllocator
+{
+public:
+  explicit BufferRangeAllocator(uint32_t size);
+
+  // Returns false when there is no free range of |size| bytes.
+  bool Allocate(uint32_t size, uint32_t & offset);
+  void Free(uint32_t offset, uint32_t size);
+
+  uint32_t GetSize() const { return m_size; }
+  uint32_t GetFreeSize() const { return m_freeSize; }
+  bool IsEmpty() const { return m_freeSize == m_size; }
+
+private:
+  uint32_t m_size;
+  uint32_t m_freeSize;
+  // Offset of a free range -> size of the range.
+  std::map<uint32_t, uint32_t> m_freeRanges;
+};
+
+struct GpuBufferRange
+{
+  bool IsValid() const { return m_bufferID != 0; }
+
+  uint32_t m_bufferID = 0;
+  uint32_t m_byteOffset = 0;
+  uint32_t m_byteCount = 0;
+};
+
+// Sub-allocates ranges of large GPU buffers, so static geometry of many render buckets
+// shares a few buffers instead of creating a buffer per bucket. Blocks are created on demand
+// and deleted when their last range is freed, so no buffer outlives the geometry, which
+// is destroyed with the graphics context.
+// Only OpenGL buffers are supported. This class is thread-safe.
+class GpuBufferArena
+{
+public:
+  static uint32_t constexpr kBlockSize = 4 * 1024 * 1024;
+  // Bigger buffers get their own GPU buffers.
+  static uint32_t constexpr kMaxRangeSize = kBlockSize / 4;
+  // Offsets of ranges are aligned, so that they suit any vertex attribute and index type.
+  static uint32_t constexpr kRangeAlignment = 16;
+
+  static GpuBufferArena & Instance();
+
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const;
+
+  // Returns an invalid range when the arena is disabled or |byteCount| doesn't fit it.
+  GpuBufferRange Allocate(GPUBuffer::Target target, uint32_t byteCount);
+  void Free(GPUBuffer::Target target, GpuBufferRange const & range);
+
+  size_t GetBlocksCount(GPUBuffer::Target target) const;
+
+private:
+  struct Block
+  {
+    Block(uint32_t bufferID, uint32_t size) : m_bufferID(bufferID), m_allocator(size) {}
+
+    uint32_t m_bufferID;
+    BufferRangeAllocator m_allocator;
+  };
+
+  GpuBufferArena() = default;
+
+  std::atomic<bool> m_enabled{false};
+
+  mutable std::mutex m_mutex;
+  std::map<GPUBuffer::Target, std::vector<Block>> m_blocks;
+};
+
+// GPU buffer which data are in a range of a shared buffer of GpuBufferArena. The data can be
+// only uploaded, mapping is unavailable.
+class ArenaGPUBuffer : public BufferBase
+{
+  using TBase = BufferBase;
+
+public:
+  // |range| must be allocated for |capacity| elements of |t|.
+  ArenaGPUBuffer(GPUBuffer::Target t, GpuBufferRange const & range, void const * data,
+                 uint8_t elementSize, uint32_t capacity);
+  ~ArenaGPUBuffer() override;
+
+  void UploadData(void const * data, uint32_t elementCount);
+  void Bind();
+
+  uint32_t GetByteOffset() const { return m_range.m_byteOffset; }
+
+private:
+  GPUBuffer::Target m_t;
+  GpuBufferRange m_range;
+};
+}  // namespace dp
@@ -2,6 +2,7 @@
 
 #include "drape/drape_global.hpp"
 #include "drape/pointers.hpp"
+#include "drape/texture_types.hpp"
 
 #include <string>
 
@@ -67,6 +68,7 @@ public:
   virtual ApiVersion GetApiVersion() const = 0;
   virtual std::string GetRendererName() const = 0;
   virtual std::string GetRendererVersion() const = 0;
+  virtual bool IsTextureFormatSupported(TextureFormat format) const = 0;
 
   virtual void DebugSynchronizeWithCPU() {}
   virtual void PushDebugLabel(std::string const & label) = 0;
@@ -60,6 +60,27 @@ void UnpackFormat(ref_ptr<dp::GraphicsContext> context, TextureFormat format,
     pixelType = gl_const::GLUnsignedIntType;
     return;
 
+  // Compressed textures are uploaded by internal format only.
+  case TextureFormat::ETC2:
+    layout = gl_const::GLCompressedRGBA8ETC2;
+    pixelType = 0;
+    return;
+
+  case TextureFormat::ASTC:
+    layout = gl_const::GLCompressedRGBAASTC4x4;
+    pixelType = 0;
+    return;
+
+  case TextureFormat::BC3:
+    layout = gl_const::GLCompressedRGBAS3TCDXT5;
+    pixelType = 0;
+    return;
+
+  case TextureFormat::PVRTC:
+    layout = gl_const::GLCompressedRGBAPVRTC4Bpp;
+    pixelType = 0;
+    return;
+
   case TextureFormat::Unspecified:
     CHECK(false, ());
     return;
@@ -117,7 +138,10 @@ void HWTexture::Create(ref_ptr<dp::GraphicsContext> context, Params const & para
   }
 
 #if defined(TRACK_GPU_MEM)
-  uint32_t const memSize = (CHAR_BIT * bytesPerPixel * m_params.m_width * m_params.m_height) >> 3;
+  uint32_t const memSize =
+      IsCompressedFormat(m_params.m_format)
+          ? GetCompressedDataSize(m_params.m_format, m_params.m_width, m_params.m_height)
+          : (CHAR_BIT * bytesPerPixel * m_params.m_width * m_params.m_height) >> 3;
   dp::GPUMemTracker::Inst().AddAllocated("Texture", m_textureID, memSize);
   dp::GPUMemTracker::Inst().SetUsed("Texture", m_textureID, memSize);
   if (params.m_usePixelBuffer)
@@ -176,8 +200,18 @@ void OpenGLHWTexture::Create(ref_ptr<dp::GraphicsContext> context, Params const
   UnpackFormat(context, m_params.m_format, m_unpackedLayout, m_unpackedPixelType);
 
   auto const f = DecodeTextureFilter(m_params.m_filter);
-  GLFunctions::glTexImage2D(m_params.m_width, m_params.m_height,
-                            m_unpackedLayout, m_unpackedPixelType, data.get());
+  if (IsCompressedFormat(m_params.m_format))
+  {
+    CHECK(data != nullptr, ("Compressed textures must be created with data."));
+    GLFunctions::glCompressedTexImage2D(
+        m_params.m_width, m_params.m_height, m_unpackedLayout,
+        GetCompressedDataSize(m_params.m_format, m_params.m_width, m_params.m_height), data.get());
+  }
+  else
+  {
+    GLFunctions::glTexImage2D(m_params.m_width, m_params.m_height,
+                              m_unpackedLayout, m_unpackedPixelType, data.get());
+  }
   GLFunctions::glTexParameter(gl_const::GLMinFilter, f);
   GLFunctions::glTexParameter(gl_const::GLMagFilter, f);
   GLFunctions::glTexParameter(gl_const::GLWrapS, DecodeTextureWrapping(m_params.m_wrapSMode));
@@ -200,6 +234,7 @@ void OpenGLHWTexture::UploadData(uint32_t x, uint32_t y, uint32_t width, uint32_
                                  ref_ptr<void> data)
 {
   ASSERT(Validate(), ());
+  CHECK(!IsCompressedFormat(m_params.m_format), ("Compressed textures are immutable."));
   uint32_t const mappingSize = height * width * m_pixelBufferElementSize;
   if (m_pixelBufferID != 0 && m_pixelBufferSize != 0 && m_pixelBufferSize >= mappingSize)
   {
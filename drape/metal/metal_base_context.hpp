@@ -37,6 +37,7 @@ public:
   ApiVersion GetApiVersion() const override;
   std::string GetRendererName() const override;
   std::string GetRendererVersion() const override;
+  bool IsTextureFormatSupported(TextureFormat format) const override;
 
   void DebugSynchronizeWithCPU() override;
   void PushDebugLabel(std::string const & label) override;
@@ -111,6 +111,21 @@ std::string MetalBaseContext::GetRendererVersion() const
   }
   return "Unknown";
 }
+
+bool MetalBaseContext::IsTextureFormatSupported(TextureFormat format) const
+{
+  switch (format)
+  {
+  // ETC2 and PVRTC are supported by all iOS GPUs with Metal, ASTC requires A8 and later.
+  case TextureFormat::ETC2: return true;
+  case TextureFormat::PVRTC: return true;
+  case TextureFormat::ASTC: return [m_device supportsFeatureSet:MTLFeatureSet_iOS_GPUFamily2_v1];
+  // BCn formats are available only on macOS.
+  case TextureFormat::BC3: return false;
+  case TextureFormat::Unspecified: return false;
+  default: return true;
+  }
+}
   
 void MetalBaseContext::PushDebugLabel(std::string const & label)
 {
@@ -29,12 +29,27 @@ MTLPixelFormat UnpackFormat(TextureFormat format)
   case TextureFormat::RedGreen: return MTLPixelFormatRG8Unorm;
   case TextureFormat::DepthStencil: return MTLPixelFormatDepth32Float_Stencil8;
   case TextureFormat::Depth: return MTLPixelFormatDepth32Float;
+  case TextureFormat::ETC2: return MTLPixelFormatEAC_RGBA8;
+  case TextureFormat::ASTC: return MTLPixelFormatASTC_4x4_LDR;
+  case TextureFormat::PVRTC: return MTLPixelFormatPVRTC_RGBA_4BPP;
+  case TextureFormat::BC3:
   case TextureFormat::Unspecified:
     CHECK(false, ());
     return MTLPixelFormatInvalid;
   }
   CHECK(false, ());
 }
+
+uint32_t GetRowBytes(TextureFormat format, uint32_t width)
+{
+  // PVRTC textures must be uploaded with zero row size.
+  if (format == TextureFormat::PVRTC)
+    return 0;
+  // A row of 4x4 blocks for block-compressed formats.
+  if (IsCompressedFormat(format))
+    return GetCompressedDataSize(format, width, 4 /* height */);
+  return width * GetBytesPerPixel(format);
+}
 }  // namespace
 
 drape_ptr<HWTexture> MetalTextureAllocator::CreateTexture(ref_ptr<dp::GraphicsContext> context)
@@ -71,7 +86,7 @@ void MetalTexture::Create(ref_ptr<dp::GraphicsContext> context, Params const & p
     m_texture = [metalDevice newTextureWithDescriptor:texDesc];
     CHECK(m_texture != nil, ());
     MTLRegion region = MTLRegionMake2D(0, 0, m_params.m_width, m_params.m_height);
-    auto const rowBytes = m_params.m_width * GetBytesPerPixel(m_params.m_format);
+    auto const rowBytes = GetRowBytes(m_params.m_format, m_params.m_width);
     [m_texture replaceRegion:region mipmapLevel:0 withBytes:data.get() bytesPerRow:rowBytes];
   }
 }
@@ -80,7 +95,7 @@ void MetalTexture::UploadData(uint32_t x, uint32_t y, uint32_t width, uint32_t h
 {
   CHECK(m_isMutable, ("Upload data is avaivable only for mutable textures."));
   MTLRegion region = MTLRegionMake2D(x, y, width, height);
-  auto const rowBytes = width * GetBytesPerPixel(m_params.m_format);
+  auto const rowBytes = GetRowBytes(m_params.m_format, width);
   [m_texture replaceRegion:region mipmapLevel:0 withBytes:data.get() bytesPerRow:rowBytes];
 }
 
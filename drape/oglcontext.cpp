@@ -54,6 +54,7 @@ glConst DecodeStencilAction(StencilAction stencilAction)
 void OGLContext::Init(ApiVersion apiVersion)
 {
   GLFunctions::Init(apiVersion);
+  GLFunctions::ResetStateCache();
 
   GLFunctions::glPixelStore(gl_const::GLUnpackAlignment, 1);
 
@@ -82,6 +83,25 @@ std::string OGLContext::GetRendererVersion() const
   return GLFunctions::glGetString(gl_const::GLVersion);
 }
 
+bool OGLContext::IsTextureFormatSupported(TextureFormat format) const
+{
+  switch (format)
+  {
+  case TextureFormat::ETC2:
+    return GLFunctions::ExtensionsList.IsSupported(GLExtensionsList::TextureCompressionETC2);
+  case TextureFormat::ASTC:
+    return GLFunctions::ExtensionsList.IsSupported(GLExtensionsList::TextureCompressionASTC);
+  case TextureFormat::BC3:
+    return GLFunctions::ExtensionsList.IsSupported(GLExtensionsList::TextureCompressionS3TC);
+  case TextureFormat::PVRTC:
+    return GLFunctions::ExtensionsList.IsSupported(GLExtensionsList::TextureCompressionPVRTC);
+  // OpenGL ES2 does not support texture-based depth-stencil.
+  case TextureFormat::DepthStencil: return GetApiVersion() != ApiVersion::OpenGLES2;
+  case TextureFormat::Unspecified: return false;
+  default: return true;
+  }
+}
+
 void OGLContext::DebugSynchronizeWithCPU()
 {
   GLFunctions::glFinish();
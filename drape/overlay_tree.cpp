@@ -84,6 +84,8 @@ void OverlayTree::Clear()
   for (auto & handles : m_handles)
     handles.clear();
   m_displacers.clear();
+  m_lastPlacingInput.Clear();
+  m_hasLastPlacing = false;
 }
 
 bool OverlayTree::Frame()
@@ -123,10 +125,9 @@ void OverlayTree::InvalidateOnNextFrame()
 void OverlayTree::StartOverlayPlacing(ScreenBase const & screen, int zoomLevel)
 {
   ASSERT(IsNeedUpdate(), ());
-  TBase::Clear();
-  m_handlesCache.clear();
+  // The tree of the previous placing is kept until EndOverlayPlacing,
+  // because it may be still valid.
   m_traits.SetModelView(screen);
-  m_displacementInfo.clear();
   m_zoomLevel = zoomLevel;
 }
 
@@ -152,10 +153,6 @@ void OverlayTree::Add(ref_ptr<OverlayHandle> handle)
 
   handle->SetCachingEnable(true);
 
-  // Skip duplicates.
-  if (m_handlesCache.find(handle) != m_handlesCache.end())
-    return;
-
   // Skip not-ready handles.
   if (!handle->Update(modelView))
   {
@@ -296,27 +293,22 @@ void OverlayTree::EndOverlayPlacing()
 {
   ASSERT(IsNeedUpdate(), ());
 
-  m_displacers.clear();
-
-#ifdef DEBUG_OVERLAYS_OUTPUT
-  LOG(LINFO, ("- BEGIN OVERLAYS PLACING"));
-#endif
-
   HandleComparator comparator(false /* enableMask */);
-
-  for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+  for (auto & handles : m_handles)
+    std::sort(handles.begin(), handles.end(), comparator);
+
+  // Candidates, their pixel rects and display flags are the same as last time, so placing
+  // would give the same result. It's usual when the overlay tree is updated periodically
+  // but the camera doesn't move.
+  PlacingInput input;
+  CollectPlacingInput(input);
+  if (!m_hasLastPlacing || input != m_lastPlacingInput)
   {
-    std::sort(m_handles[rank].begin(), m_handles[rank].end(), comparator);
-    for (auto const & handle : m_handles[rank])
-    {
-      ref_ptr<OverlayHandle> parentOverlay;
-      if (!CheckHandle(handle, rank, parentOverlay))
-        continue;
-
-      InsertHandle(handle, rank, parentOverlay);
-    }
+    m_lastPlacingInput = std::move(input);
+    m_hasLastPlacing = true;
+    PlaceOverlays();
   }
-  
+
   for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
   {
     for (auto const & handle : m_handles[rank])
@@ -338,6 +330,52 @@ void OverlayTree::EndOverlayPlacing()
 #endif
 }
 
+void OverlayTree::CollectPlacingInput(PlacingInput & input) const
+{
+  ScreenBase const & modelView = GetModelView();
+
+  input.Clear();
+  for (auto const & handles : m_handles)
+  {
+    for (auto const & handle : handles)
+    {
+      PlacingInputItem item;
+      item.m_handle = handle;
+      item.m_pixelRect = handle->GetExtendedPixelRect(modelView);
+      item.m_priority = handle->GetPriority();
+      item.m_displayFlag = handle->GetDisplayFlag();
+      input.m_items.push_back(item);
+    }
+  }
+  input.m_selectedFeatureID = m_selectedFeatureID;
+  input.m_isDisplacementEnabled = m_isDisplacementEnabled;
+  input.m_isPerspective = modelView.isPerspective();
+}
+
+void OverlayTree::PlaceOverlays()
+{
+  TBase::Clear();
+  m_handlesCache.clear();
+  m_displacers.clear();
+  m_displacementInfo.clear();
+
+#ifdef DEBUG_OVERLAYS_OUTPUT
+  LOG(LINFO, ("- BEGIN OVERLAYS PLACING"));
+#endif
+
+  for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+  {
+    for (auto const & handle : m_handles[rank])
+    {
+      ref_ptr<OverlayHandle> parentOverlay;
+      if (!CheckHandle(handle, rank, parentOverlay))
+        continue;
+
+      InsertHandle(handle, rank, parentOverlay);
+    }
+  }
+}
+
 bool OverlayTree::CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                               ref_ptr<OverlayHandle> & parentOverlay) const
 {
@@ -480,6 +518,27 @@ void OverlayTree::StoreDisplacementInfo(int caseIndex, ref_ptr<OverlayHandle> di
                                   dp::Color(0, 0, 255, 255));
 }
 
+bool OverlayTree::PlacingInputItem::operator==(PlacingInputItem const & rhs) const
+{
+  return m_handle == rhs.m_handle && m_pixelRect == rhs.m_pixelRect &&
+         m_priority == rhs.m_priority && m_displayFlag == rhs.m_displayFlag;
+}
+
+bool OverlayTree::PlacingInput::operator==(PlacingInput const & rhs) const
+{
+  return m_items == rhs.m_items && m_selectedFeatureID == rhs.m_selectedFeatureID &&
+         m_isDisplacementEnabled == rhs.m_isDisplacementEnabled &&
+         m_isPerspective == rhs.m_isPerspective;
+}
+
+void OverlayTree::PlacingInput::Clear()
+{
+  m_items.clear();
+  m_selectedFeatureID = FeatureID();
+  m_isDisplacementEnabled = true;
+  m_isPerspective = false;
+}
+
 void detail::OverlayTraits::SetVisualScale(double visualScale)
 {
   m_visualScale = visualScale;
@@ -110,6 +110,35 @@ private:
 
   void StoreDisplacementInfo(int caseIndex, ref_ptr<OverlayHandle> displacerHandle,
                              ref_ptr<OverlayHandle> displacedHandle);
+
+  // Everything which placing of overlays depends on. When the input of a placing is equal
+  // to the input of the previous one, the tree which is built last time is kept.
+  struct PlacingInputItem
+  {
+    bool operator==(PlacingInputItem const & rhs) const;
+
+    ref_ptr<OverlayHandle> m_handle;
+    m2::RectD m_pixelRect;
+    uint64_t m_priority = 0;
+    bool m_displayFlag = false;
+  };
+
+  struct PlacingInput
+  {
+    bool operator==(PlacingInput const & rhs) const;
+    bool operator!=(PlacingInput const & rhs) const { return !(*this == rhs); }
+
+    void Clear();
+
+    std::vector<PlacingInputItem> m_items;
+    FeatureID m_selectedFeatureID;
+    bool m_isDisplacementEnabled = true;
+    bool m_isPerspective = false;
+  };
+
+  void CollectPlacingInput(PlacingInput & input) const;
+  void PlaceOverlays();
+
   int m_frameCounter;
   std::array<std::vector<ref_ptr<OverlayHandle>>, dp::OverlayRanksCount> m_handles;
   HandlesCache m_handlesCache;
@@ -122,6 +151,10 @@ private:
   ref_ptr<DebugRenderer> m_debugRectRenderer;
 
   HandlesCache m_displacers;
+
+  PlacingInput m_lastPlacingInput;
+  bool m_hasLastPlacing = false;
+
   uint32_t m_frameUpdatePeriod;
   int m_zoomLevel = 1;
 };
@@ -1,4 +1,6 @@
 #include "drape/static_texture.hpp"
+#include "drape/compressed_texture.hpp"
+#include "drape/support_manager.hpp"
 
 #include "indexer/map_style_reader.hpp"
 
@@ -26,6 +28,29 @@ namespace
 using TLoadingCompletion = function<void(unsigned char *, uint32_t, uint32_t)>;
 using TLoadingFailure = function<void(std::string const &)>;
 
+ReaderPtr<Reader> GetTextureReader(std::string const & fullName, std::string const & skinPathName)
+{
+  return skinPathName == StaticTexture::kDefaultResource ?
+         GetStyleReader().GetDefaultResourceReader(fullName) :
+         GetStyleReader().GetResourceReader(fullName, skinPathName);
+}
+
+bool LoadCompressedData(std::string const & textureName, std::string const & skinPathName,
+                        TextureFormat format, CompressedImage & image)
+{
+  try
+  {
+    return ReadCompressedTexture(
+        GetTextureReader(textureName + GetCompressedTextureSuffix(format), skinPathName), format,
+        image);
+  }
+  catch (RootException const &)
+  {
+    // Precompressed variants are optional, the png is used without them.
+    return false;
+  }
+}
+
 bool LoadData(std::string const & textureName, std::string const & skinPathName,
               uint8_t bytesPerPixel, TLoadingCompletion const & completionHandler,
               TLoadingFailure const & failureHandler)
@@ -36,10 +61,7 @@ bool LoadData(std::string const & textureName, std::string const & skinPathName,
   std::vector<unsigned char> rawData;
   try
   {
-    std::string const fullName = textureName + ".png";
-    ReaderPtr<Reader> reader = skinPathName == StaticTexture::kDefaultResource ?
-                               GetStyleReader().GetDefaultResourceReader(fullName) :
-                               GetStyleReader().GetResourceReader(fullName, skinPathName);
+    ReaderPtr<Reader> reader = GetTextureReader(textureName + ".png", skinPathName);
 
     CHECK_LESS(reader.Size(), static_cast<uint64_t>(std::numeric_limits<size_t>::max()), ());
     size_t const size = static_cast<size_t>(reader.Size());
@@ -103,6 +125,28 @@ StaticTexture::StaticTexture(ref_ptr<dp::GraphicsContext> context,
 
 bool StaticTexture::Load(ref_ptr<dp::GraphicsContext> context, ref_ptr<HWTextureAllocator> allocator)
 {
+  // Only color textures have precompressed variants.
+  if (m_format == dp::TextureFormat::RGBA8)
+  {
+    auto const compressedFormat = SupportManager::Instance().GetCompressedTextureFormat(context);
+    CompressedImage image;
+    if (compressedFormat != dp::TextureFormat::Unspecified &&
+        LoadCompressedData(m_textureName, m_skinPathName, compressedFormat, image))
+    {
+      Texture::Params p;
+      // Compressed textures are immutable, so they don't need special allocators.
+      p.m_allocator = GetDefaultAllocator(context);
+      p.m_format = compressedFormat;
+      p.m_width = image.m_width;
+      p.m_height = image.m_height;
+      p.m_wrapSMode = TextureWrapping::Repeat;
+      p.m_wrapTMode = TextureWrapping::Repeat;
+
+      Create(context, p, make_ref(image.m_data.data()));
+      return true;
+    }
+  }
+
   auto completionHandler = [this, &allocator, context](unsigned char * data, uint32_t width,
                                                        uint32_t height)
   {
@@ -77,6 +77,20 @@ void SupportManager::Init(ref_ptr<GraphicsContext> context)
 //  }
 }
 
+TextureFormat SupportManager::GetCompressedTextureFormat(ref_ptr<GraphicsContext> context) const
+{
+  CHECK(context != nullptr, ());
+  // Formats are sorted by quality of symbols with sharp alpha edges.
+  TextureFormat const formats[] = {TextureFormat::ASTC, TextureFormat::ETC2, TextureFormat::BC3,
+                                   TextureFormat::PVRTC};
+  for (auto const format : formats)
+  {
+    if (context->IsTextureFormatSupported(format))
+      return format;
+  }
+  return TextureFormat::Unspecified;
+}
+
 SupportManager & SupportManager::Instance()
 {
   static SupportManager manager;
@@ -2,6 +2,7 @@
 
 #include "drape/graphics_context.hpp"
 #include "drape/pointers.hpp"
+#include "drape/texture_types.hpp"
 
 #include "base/macros.hpp"
 
@@ -24,6 +25,11 @@ public:
   int GetMaxLineWidth() const { return m_maxLineWidth; }
   bool IsAntialiasingEnabledByDefault() const { return m_isAntialiasingEnabledByDefault; }
 
+  // Returns the best compressed format of static textures which is supported by |context|
+  // or TextureFormat::Unspecified. It depends only on |context|, so it may be called on
+  // any rendering thread before Init.
+  TextureFormat GetCompressedTextureFormat(ref_ptr<GraphicsContext> context) const;
+
 private:
   SupportManager() = default;
 
@@ -1,4 +1,6 @@
 #include "drape/symbols_texture.hpp"
+#include "drape/compressed_texture.hpp"
+#include "drape/support_manager.hpp"
 #include "3party/stb_image/stb_image.h"
 
 #include "indexer/map_style_reader.hpp"
@@ -22,7 +24,8 @@ namespace dp
 namespace
 {
 using TDefinitionInserter = std::function<void(std::string const &, m2::RectF const &)>;
-using TSymbolsLoadingCompletion = std::function<void(unsigned char *, uint32_t, uint32_t)>;
+using TSymbolsLoadingCompletion =
+    std::function<void(unsigned char *, uint32_t, uint32_t, TextureFormat)>;
 using TSymbolsLoadingFailure = std::function<void(std::string const &)>;
 
 class DefinitionLoader
@@ -112,8 +115,36 @@ private:
   m2::RectF m_rect;
 };
 
+// Loads the precompressed variant of a skin image if the skin has it.
+bool LoadCompressedSymbols(std::string const & skinPathName, std::string const & textureName,
+                           TextureFormat format, uint32_t width, uint32_t height,
+                           CompressedImage & image)
+{
+  try
+  {
+    ReaderPtr<Reader> reader = GetStyleReader().GetResourceReader(
+        textureName + GetCompressedTextureSuffix(format), skinPathName);
+    if (!ReadCompressedTexture(reader, format, image))
+      return false;
+  }
+  catch (RootException const &)
+  {
+    return false;
+  }
+
+  if (image.m_width != width || image.m_height != height)
+  {
+    LOG(LWARNING, ("Compressed skin", textureName, "doesn't match its definition."));
+    return false;
+  }
+  return true;
+}
+
+// |compressedFormat| is a format of the precompressed skin image which is preferred to the png,
+// TextureFormat::Unspecified means the png only.
 void LoadSymbols(std::string const & skinPathName, std::string const & textureName,
-                 bool convertToUV, TDefinitionInserter const & definitionInserter,
+                 bool convertToUV, TextureFormat compressedFormat,
+                 TDefinitionInserter const & definitionInserter,
                  TSymbolsLoadingCompletion const & completionHandler,
                  TSymbolsLoadingFailure const & failureHandler)
 {
@@ -142,6 +173,14 @@ void LoadSymbols(std::string const & skinPathName, std::string const & textureNa
       height = loader.GetHeight();
     }
 
+    CompressedImage image;
+    if (compressedFormat != TextureFormat::Unspecified &&
+        LoadCompressedSymbols(skinPathName, textureName, compressedFormat, width, height, image))
+    {
+      completionHandler(image.m_data.data(), width, height, compressedFormat);
+      return;
+    }
+
     {
       ReaderPtr<Reader> reader =
           GetStyleReader().GetResourceReader(textureName + ".png", skinPathName);
@@ -165,7 +204,7 @@ void LoadSymbols(std::string const & skinPathName, std::string const & textureNa
 
   if (width == static_cast<uint32_t>(w) && height == static_cast<uint32_t>(h))
   {
-    completionHandler(data, width, height);
+    completionHandler(data, width, height, TextureFormat::RGBA8);
   }
   else
   {
@@ -214,11 +253,13 @@ void SymbolsTexture::Load(ref_ptr<dp::GraphicsContext> context, std::string cons
     m_definition.insert(std::make_pair(name, SymbolsTexture::SymbolInfo(rect)));
   };
 
-  auto completionHandler = [this, &allocator, context](unsigned char * data, uint32_t width, uint32_t height)
+  auto completionHandler = [this, &allocator, context](unsigned char * data, uint32_t width,
+                                                       uint32_t height, TextureFormat format)
   {
     Texture::Params p;
-    p.m_allocator = allocator;
-    p.m_format = dp::TextureFormat::RGBA8;
+    // Compressed textures are immutable, so they don't need special allocators.
+    p.m_allocator = IsCompressedFormat(format) ? GetDefaultAllocator(context) : allocator;
+    p.m_format = format;
     p.m_width = width;
     p.m_height = height;
 
@@ -231,7 +272,8 @@ void SymbolsTexture::Load(ref_ptr<dp::GraphicsContext> context, std::string cons
     Fail(context);
   };
 
-  LoadSymbols(skinPathName, m_name, true /* convertToUV */, definitionInserter,
+  LoadSymbols(skinPathName, m_name, true /* convertToUV */,
+              SupportManager::Instance().GetCompressedTextureFormat(context), definitionInserter,
               completionHandler, failureHandler);
 }
 
@@ -287,8 +329,9 @@ bool SymbolsTexture::DecodeToMemory(std::string const & skinPathName, std::strin
 
   bool result = true;
   auto completionHandler = [&result, &symbolsSkin, &skinWidth, &skinHeight](unsigned char * data,
-      uint32_t width, uint32_t height)
+      uint32_t width, uint32_t height, TextureFormat format)
   {
+    CHECK(format == TextureFormat::RGBA8, ());
     size_t size = 4 * width * height;
     symbolsSkin.resize(size);
     memcpy(symbolsSkin.data(), data, size);
@@ -303,7 +346,7 @@ bool SymbolsTexture::DecodeToMemory(std::string const & skinPathName, std::strin
     result = false;
   };
 
-  LoadSymbols(skinPathName, textureName, false /* convertToUV */,
+  LoadSymbols(skinPathName, textureName, false /* convertToUV */, TextureFormat::Unspecified,
               definitionInserter, completionHandler, failureHandler);
   return result;
 }
@@ -2,6 +2,7 @@
 
 #include "base/assert.hpp"
 
+#include <algorithm>
 #include <cstdint>
 
 namespace dp
@@ -13,6 +14,11 @@ enum class TextureFormat : uint8_t
   RedGreen,
   DepthStencil,
   Depth,
+  // Block-compressed formats of precompressed static textures.
+  ETC2,
+  ASTC,
+  BC3,
+  PVRTC,
   Unspecified
 };
 
@@ -38,8 +44,34 @@ inline uint8_t GetBytesPerPixel(TextureFormat format)
   case TextureFormat::RedGreen: result = 2; break;
   case TextureFormat::DepthStencil: result = 4; break;
   case TextureFormat::Depth: result = 4; break;
+  // Compressed formats have no whole number of bytes per pixel, use GetCompressedDataSize.
+  case TextureFormat::ETC2:
+  case TextureFormat::ASTC:
+  case TextureFormat::BC3:
+  case TextureFormat::PVRTC: result = 0; break;
   default: ASSERT(false, ()); break;
   }
   return result;
 }
+
+inline bool IsCompressedFormat(TextureFormat format)
+{
+  return format == TextureFormat::ETC2 || format == TextureFormat::ASTC ||
+         format == TextureFormat::BC3 || format == TextureFormat::PVRTC;
+}
+
+// Returns size of the top mip level of a compressed texture in bytes.
+inline uint32_t GetCompressedDataSize(TextureFormat format, uint32_t width, uint32_t height)
+{
+  switch (format)
+  {
+  // RGBA8 ETC2 with EAC alpha, ASTC 4x4 and DXT5 use 16 bytes per 4x4 block.
+  case TextureFormat::ETC2:
+  case TextureFormat::ASTC:
+  case TextureFormat::BC3: return ((width + 3) / 4) * ((height + 3) / 4) * 16;
+  // 4 bits per pixel, the smallest texture is 8x8.
+  case TextureFormat::PVRTC: return (std::max(width, 8u) * std::max(height, 8u) * 4 + 7) / 8;
+  default: ASSERT(false, ()); return 0;
+  }
+}
 }  // namespace dp
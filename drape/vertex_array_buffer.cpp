@@ -86,8 +86,9 @@ public:
     for (auto it = buffers.begin(); it != buffers.end(); ++it)
     {
       BindingInfo const & binding = it->first;
-      ref_ptr<DataBuffer> buffer = make_ref(it->second);
-      buffer->GetBuffer()->Bind();
+      ref_ptr<DataBufferBase> buffer = it->second->GetBuffer();
+      buffer->Bind();
+      uint32_t const byteOffset = buffer->GetByteOffset();
 
       for (uint16_t i = 0; i < binding.GetCount(); ++i)
       {
@@ -97,7 +98,7 @@ public:
         GLFunctions::glEnableVertexAttribute(attributeLocation);
         GLFunctions::glVertexAttributePointer(attributeLocation, decl.m_componentCount,
                                               decl.m_componentType, false, decl.m_stride,
-                                              decl.m_offset);
+                                              byteOffset + decl.m_offset);
       }
     }
   }
@@ -148,13 +149,16 @@ void VertexArrayBuffer::PreflushImpl(ref_ptr<GraphicsContext> context)
 
   // Buffers are ready, so moving them from CPU to GPU.
   for (auto & buffer : m_staticBuffers)
-    buffer.second->MoveToGPU(context, GPUBuffer::ElementBuffer);
+    buffer.second->MoveToSharedGPU(context, GPUBuffer::ElementBuffer);
 
   for (auto & buffer : m_dynamicBuffers)
     buffer.second->MoveToGPU(context, GPUBuffer::ElementBuffer);
 
   ASSERT(m_indexBuffer != nullptr, ());
-  m_indexBuffer->MoveToGPU(context, GPUBuffer::IndexBuffer);
+  if (m_isIndexBufferMutable)
+    m_indexBuffer->MoveToGPU(context, GPUBuffer::IndexBuffer);
+  else
+    m_indexBuffer->MoveToSharedGPU(context, GPUBuffer::IndexBuffer);
 
   // Preflush can be called on BR, where impl is not initialized.
   // For Metal rendering this code has no meaning.
@@ -187,7 +191,9 @@ void VertexArrayBuffer::RenderRange(ref_ptr<GraphicsContext> context,
     GetIndexBuffer()->Bind();
 
     CHECK(m_impl != nullptr, ());
-    m_impl->RenderRange(context, drawAsLine, range);
+    uint32_t const indexOffset = GetIndexBuffer()->GetByteOffset() / IndexStorage::SizeOfIndex();
+    m_impl->RenderRange(context, drawAsLine,
+                        IndicesRange(range.m_idxStart + indexOffset, range.m_idxCount));
 
     Unbind();
   }
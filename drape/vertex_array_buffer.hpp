@@ -71,6 +71,11 @@ public:
                      ref_ptr<IndexBufferMutator> indexMutator,
                      ref_ptr<AttributeBufferMutator> attrMutator);
 
+  // Static attribute buffers are moved to shared GPU buffers on preflushing when GpuBufferArena
+  // is enabled. The index buffer is shared too, unless it's rebuilt on rendering (e.g. by overlay
+  // handles).
+  void SetIndexBufferMutable(bool isMutable) { m_isIndexBufferMutable = isMutable; }
+
   void ResetChangingTracking() { m_isChanged = false; }
   bool IsChanged() const { return m_isChanged; }
 
@@ -105,5 +110,6 @@ private:
   bool m_isPreflushed = false;
   bool m_moveToGpuOnBuild = false;
   bool m_isChanged = false;
+  bool m_isIndexBufferMutable = true;
 };
 }  // namespace dp
@@ -67,6 +67,9 @@ uint32_t const kPathTextBaseTextIndex = 128;
 uint32_t const kShieldBaseTextIndex = 0;
 int const kShieldMinVisibleZoomLevel = 10;
 
+// Walls of smaller buildings take a few pixels, so such buildings are drawn flat.
+double const kMin3dBuildingSizeInPixels = 3.0;
+
 #ifdef LINES_GENERATION_CALC_FILTERED_POINTS
 class LinesStat
 {
@@ -806,6 +809,15 @@ void ApplyAreaFeature::CalculateBuildingOutline(bool calculateNormals, BuildingO
   }
 }
 
+bool ApplyAreaFeature::IsSmallBuilding() const
+{
+  m2::RectD rect;
+  for (auto const & pt : m_points)
+    rect.Add(pt);
+  double const sizeInPixels = std::max(rect.SizeX(), rect.SizeY()) * m_currentScaleGtoP;
+  return sizeInPixels < kMin3dBuildingSizeInPixels * VisualParams::Instance().GetVisualScale();
+}
+
 void ApplyAreaFeature::ProcessAreaRule(Stylist::TRuleWrapper const & rule)
 {
   drule::BaseRule const * pRule = rule.first;
@@ -833,7 +845,7 @@ void ApplyAreaFeature::ProcessAreaRule(Stylist::TRuleWrapper const & rule)
                                   areaRule->border().width() > 0.0;
       if (outline.m_generateOutline)
         params.m_outlineColor = ToDrapeColor(areaRule->border().color());
-      bool const calculateNormals = m_posZ > 0.0;
+      bool const calculateNormals = m_posZ > 0.0 && !IsSmallBuilding();
       CalculateBuildingOutline(calculateNormals, outline);
       params.m_is3D = !outline.m_indices.empty() && calculateNormals;
     }
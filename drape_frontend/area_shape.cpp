@@ -139,9 +139,9 @@ void AreaShape::DrawArea3D(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Bat
 
   glsl::vec2 const uv = glsl::ToVec2(colorUv);
 
-  std::vector<gpu::Area3dVertex> vertexes;
-  vertexes.reserve(m_vertexes.size() + m_buildingOutline.m_normals.size() * 6);
-
+  // A wall is a quad of 4 vertices, the batcher generates 2 triangles for it.
+  std::vector<gpu::Area3dVertex> walls;
+  walls.reserve(m_buildingOutline.m_normals.size() * dp::Batcher::VertexPerQuad);
   for (size_t i = 0; i < m_buildingOutline.m_normals.size(); i++)
   {
     int const startIndex = m_buildingOutline.m_indices[i * 2];
@@ -153,20 +153,19 @@ void AreaShape::DrawArea3D(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Bat
                                                          m_params.m_tileCenter, kShapeCoordScalar));
 
     glsl::vec3 normal(glsl::ToVec2(m_buildingOutline.m_normals[i]), 0.0f);
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_minPosZ), normal, uv));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_posZ), normal, uv));
-
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_posZ), normal, uv));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_posZ), normal, uv));
+    walls.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_minPosZ), normal, uv));
+    walls.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv));
+    walls.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_posZ), normal, uv));
+    walls.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_posZ), normal, uv));
   }
 
+  std::vector<gpu::Area3dVertex> roof;
+  roof.reserve(m_vertexes.size());
   glsl::vec3 const normal(0.0f, 0.0f, -1.0f);
   for (auto const & vertex : m_vertexes)
   {
     glsl::vec2 const pt = glsl::ToVec2(ConvertToLocal(vertex, m_params.m_tileCenter, kShapeCoordScalar));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(pt, -m_params.m_posZ), normal, uv));
+    roof.emplace_back(gpu::Area3dVertex(glsl::vec3(pt, -m_params.m_posZ), normal, uv));
   }
 
   auto state = CreateRenderState(gpu::Program::Area3d, DepthLayer::Geometry3dLayer);
@@ -174,8 +173,15 @@ void AreaShape::DrawArea3D(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Bat
   state.SetColorTexture(texture);
   state.SetBlending(dp::Blending(false /* isEnabled */));
 
-  dp::AttributeProvider provider(1, static_cast<uint32_t>(vertexes.size()));
-  provider.InitStream(0, gpu::Area3dVertex::GetBindingInfo(), make_ref(vertexes.data()));
+  if (!walls.empty())
+  {
+    dp::AttributeProvider wallsProvider(1, static_cast<uint32_t>(walls.size()));
+    wallsProvider.InitStream(0, gpu::Area3dVertex::GetBindingInfo(), make_ref(walls.data()));
+    batcher->InsertListOfStrip(context, state, make_ref(&wallsProvider), dp::Batcher::VertexPerQuad);
+  }
+
+  dp::AttributeProvider provider(1, static_cast<uint32_t>(roof.size()));
+  provider.InitStream(0, gpu::Area3dVertex::GetBindingInfo(), make_ref(roof.data()));
   batcher->InsertTriangleList(context, state, make_ref(&provider));
 
   // Generate outline.
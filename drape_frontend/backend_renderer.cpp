@@ -132,6 +132,8 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
         m_requestedTiles->GetParams(screen, have3dBuildings, forceRequest, forceUserMarksRequest);
         m_readManager->UpdateCoverage(screen, have3dBuildings, forceRequest, forceUserMarksRequest,
                                       tiles, m_texMng, make_ref(m_metalineManager));
+        m_readManager->Prefetch(m_requestedTiles->GetPrefetchTiles(), m_texMng,
+                                make_ref(m_metalineManager));
         m_updateCurrentCountryFn(screen.ClipRect().Center(), (*tiles.begin()).m_zoomLevel);
       }
       break;
@@ -185,6 +187,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       ref_ptr<TileReadEndMessage> msg = message;
       CHECK(m_context != nullptr, ());
       m_batchersPool->ReleaseBatcher(m_context, msg->GetKey());
+      PostFlushedGeometry();
       break;
     }
 
@@ -192,14 +195,24 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
     {
       ref_ptr<FinishTileReadMessage> msg = message;
       CHECK(m_context != nullptr, ());
+      TTilesCollection unchangedUserMarksTiles;
       if (msg->NeedForceUpdateUserMarks())
       {
         for (auto const & tileKey : msg->GetTiles())
-          m_userMarkGenerator->GenerateUserMarksGeometry(m_context, tileKey, m_texMng);
+        {
+          if (msg->IsChangedUserMarksOnly() && !m_userMarkGenerator->IsTileChanged(tileKey))
+            unchangedUserMarksTiles.insert(tileKey);
+          else
+            m_userMarkGenerator->GenerateUserMarksGeometry(m_context, tileKey, m_texMng);
+        }
+        if (msg->IsChangedUserMarksOnly())
+          m_userMarkGenerator->ResetChangedTiles();
       }
       m_commutator->PostMessage(ThreadsCommutator::RenderThread,
                                 make_unique_dp<FinishTileReadMessage>(msg->MoveTiles(),
-                                                                      msg->NeedForceUpdateUserMarks()),
+                                                                      msg->NeedForceUpdateUserMarks(),
+                                                                      msg->IsChangedUserMarksOnly(),
+                                                                      std::move(unchangedUserMarksTiles)),
                                 MessagePriority::Normal);
       break;
     }
@@ -231,7 +244,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
 #if defined(DRAPE_MEASURER) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().StartShapesGeneration();
 #endif
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
+        for (auto const & shape : msg->GetShapes())
         {
           batcher->SetFeatureMinZoom(shape->GetFeatureMinZoom());
           shape->Draw(m_context, batcher, m_texMng);
@@ -239,6 +252,8 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
 #if defined(DRAPE_MEASURER) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().EndShapesGeneration(static_cast<uint32_t>(msg->GetShapes().size()));
 #endif
+        // Buckets which are overflowed while shapes are batched.
+        PostFlushedGeometry();
       }
       break;
     }
@@ -256,7 +271,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
         DrapeMeasurer::Instance().StartOverlayShapesGeneration();
 #endif
         OverlayBatcher batcher(tileKey);
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
+        for (auto const & shape : msg->GetShapes())
           batcher.Batch(m_context, shape, m_texMng);
 
         TOverlaysRenderData renderData;
@@ -289,14 +304,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       m_userMarkGenerator->SetUserMarks(msg->AcceptMarkRenderParams());
       m_userMarkGenerator->SetUserLines(msg->AcceptLineRenderParams());
       m_userMarkGenerator->SetCreatedUserMarks(msg->AcceptCreatedIds());
-      break;
-    }
-
-  case Message::Type::UpdateUserMarkGroup:
-    {
-      ref_ptr<UpdateUserMarkGroupMessage> msg = message;
-      kml::MarkGroupId const groupId = msg->GetGroupId();
-      m_userMarkGenerator->SetGroup(groupId, msg->AcceptIds());
+      m_userMarkGenerator->SetGroups(msg->AcceptGroups());
       break;
     }
 
@@ -335,7 +343,10 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::Type::RemoveSubroute:
     {
       ref_ptr<RemoveSubrouteMessage> msg = message;
-      m_routeBuilder->ClearRouteCache();
+      if (msg->NeedDeactivateFollowing())
+        m_routeBuilder->ClearRouteCache();
+      else
+        m_routeBuilder->ClearRouteCache(msg->GetSegmentId());
       // We have to resend the message to FR, because it guaranties that
       // RemoveSubroute will be processed after FlushSubrouteMessage.
       m_commutator->PostMessage(ThreadsCommutator::RenderThread,
@@ -345,10 +356,22 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::Type::UpdateSubroute:
+    {
+      ref_ptr<UpdateSubrouteMessage> msg = message;
+      // The message is resent to FR after FlushSubrouteMessage of the same subroute.
+      m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                                make_unique_dp<UpdateSubrouteMessage>(msg->GetSubrouteId(),
+                                                                      msg->GetSubroute()),
+                                MessagePriority::Normal);
+      break;
+    }
+
   case Message::Type::SwitchMapStyle:
     {
       CHECK(m_context != nullptr, ());
       m_texMng->OnSwitchMapStyle(m_context);
+      m_readManager->ClearTileShapesCache();
       RecacheMapShapes();
       RecacheGui(m_lastWidgetsInfo, false /* needResetOldGui */);
 #ifdef RENDER_DEBUG_INFO_LABELS
@@ -416,18 +439,52 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       if (m_requestedTiles->CheckTileKey(tileKey) && m_readManager->CheckTileKey(tileKey))
       {
         CHECK(m_context != nullptr, ());
-        m_trafficGenerator->FlushSegmentsGeometry(m_context, tileKey, msg->GetSegments(), m_texMng);
+        m_trafficGenerator->FlushSegmentsGeometry(m_context, tileKey, std::move(msg->GetSegments()),
+                                                  m_texMng);
       }
+
+      // Geometry of the tiles is kept to regenerate them on traffic updates, so the cache is
+      // cleaned up from time to time.
+      size_t constexpr kMaxTrafficGeometryTiles = 128;
+      if (m_trafficGenerator->GetGeometryTilesCount() > kMaxTrafficGeometryTiles)
+        RemoveObsoleteTrafficTiles();
       break;
     }
 
   case Message::Type::UpdateTraffic:
     {
       ref_ptr<UpdateTrafficMessage> msg = message;
-      m_trafficGenerator->UpdateColoring(msg->GetSegmentsColoring());
-      m_commutator->PostMessage(ThreadsCommutator::RenderThread,
-                                make_unique_dp<RegenerateTrafficMessage>(),
-                                MessagePriority::Normal);
+      RemoveObsoleteTrafficTiles();
+
+      TrafficGenerator::TrafficTilesList changedTiles;
+      TrafficSegmentsColoring recoloredSegments;
+      if (!m_trafficGenerator->UpdateColoring(msg->GetSegmentsColoring(), changedTiles,
+                                              recoloredSegments))
+      {
+        m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  make_unique_dp<RegenerateTrafficMessage>(),
+                                  MessagePriority::Normal);
+        break;
+      }
+
+      // Colors of the rendered segments are updated in place.
+      if (!recoloredSegments.empty())
+      {
+        m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  make_unique_dp<RecolorTrafficMessage>(
+                                    m_trafficGenerator->GetSegmentsColors(recoloredSegments, m_texMng)),
+                                  MessagePriority::Normal);
+      }
+
+      // Only the tiles which contain appeared or disappeared segments are regenerated.
+      for (auto const & tile : changedTiles)
+      {
+        CHECK(m_context != nullptr, ());
+        m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  make_unique_dp<ClearTrafficTileDataMessage>(tile.first, tile.second),
+                                  MessagePriority::Normal);
+        m_trafficGenerator->RegenerateTile(m_context, tile.first, tile.second, m_texMng);
+      }
       break;
     }
 
@@ -596,6 +653,7 @@ void BackendRenderer::ReleaseResources()
   m_batchersPool.reset();
   m_routeBuilder.reset();
   m_overlays.clear();
+  m_flushedGeometry.clear();
   m_trafficGenerator.reset();
 
   m_texMng->Release();
@@ -626,6 +684,7 @@ void BackendRenderer::OnContextDestroy()
   m_metalineManager->Stop();
   m_texMng->Release();
   m_overlays.clear();
+  m_flushedGeometry.clear();
   m_trafficGenerator->ClearContextDependentResources();
 
   // Here we have to erase weak pointer to the context, since it
@@ -705,11 +764,25 @@ void BackendRenderer::RecacheMapShapes()
 void BackendRenderer::FlushGeometry(TileKey const & key, dp::RenderState const & state,
                                     drape_ptr<dp::RenderBucket> && buffer)
 {
+  if (!m_flushedGeometry.empty() && !m_flushedGeometryKey.EqualStrict(key))
+    PostFlushedGeometry();
+
+  m_flushedGeometryKey = key;
+  m_flushedGeometry.emplace_back(state, std::move(buffer));
+}
+
+void BackendRenderer::PostFlushedGeometry()
+{
+  if (m_flushedGeometry.empty())
+    return;
+
   CHECK(m_context != nullptr, ());
   m_context->Flush();
   m_commutator->PostMessage(ThreadsCommutator::RenderThread,
-                            make_unique_dp<FlushRenderBucketMessage>(key, state, std::move(buffer)),
+                            make_unique_dp<FlushRenderBucketMessage>(m_flushedGeometryKey,
+                                                                     std::move(m_flushedGeometry)),
                             MessagePriority::Normal);
+  m_flushedGeometry.clear();
 }
 
 void BackendRenderer::FlushTransitRenderData(TransitRenderData && renderData)
@@ -719,6 +792,14 @@ void BackendRenderer::FlushTransitRenderData(TransitRenderData && renderData)
                             MessagePriority::Normal);
 }
 
+void BackendRenderer::RemoveObsoleteTrafficTiles()
+{
+  m_trafficGenerator->RemoveObsoleteTiles([this](TileKey const & tileKey)
+  {
+    return m_requestedTiles->CheckTileKey(tileKey) && m_readManager->CheckTileKey(tileKey);
+  });
+}
+
 void BackendRenderer::FlushTrafficRenderData(TrafficRenderData && renderData)
 {
   m_commutator->PostMessage(ThreadsCommutator::RenderThread,
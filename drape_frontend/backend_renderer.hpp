@@ -16,6 +16,8 @@
 #include "drape/viewport.hpp"
 
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace dp
 {
@@ -100,9 +102,11 @@ private:
 
   void InitContextDependentResources();
   void FlushGeometry(TileKey const & key, dp::RenderState const & state, drape_ptr<dp::RenderBucket> && buffer);
+  void PostFlushedGeometry();
 
   void FlushTransitRenderData(TransitRenderData && renderData);
   void FlushTrafficRenderData(TrafficRenderData && renderData);
+  void RemoveObsoleteTrafficTiles();
   void FlushUserMarksRenderData(TUserMarksRenderData && renderData);
 
   void CleanupOverlays(TileKey const & tileKey);
@@ -121,6 +125,11 @@ private:
 
   TOverlaysRenderData m_overlays;
 
+  // Buckets which are flushed by a batcher while a message is processed. They are sent
+  // to the frontend renderer by one message, because a tile has tens of buckets.
+  TileKey m_flushedGeometryKey;
+  std::vector<std::pair<dp::RenderState, drape_ptr<dp::RenderBucket>>> m_flushedGeometry;
+
   TUpdateCurrentCountryFn m_updateCurrentCountryFn;
 
   drape_ptr<MetalineManager> m_metalineManager;
@@ -0,0 +1,69 @@
+#include "drape_frontend/custom_features_context.hpp"
+
+namespace df
+{
+namespace
+{
+// 16 bits per feature with two probes give about 1.4% of false positives.
+uint64_t constexpr kFilterBitsPerFeature = 16;
+uint64_t constexpr kMinFilterBits = 64;
+
+uint64_t Mix(uint64_t x)
+{
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+}  // namespace
+
+CustomFeaturesContext::CustomFeaturesContext(CustomFeatures && features)
+  : m_features(std::move(features))
+{
+  if (m_features.empty())
+    return;
+
+  uint64_t bitsCount = kMinFilterBits;
+  while (bitsCount < m_features.size() * kFilterBitsPerFeature)
+    bitsCount <<= 1;
+  m_filterMask = bitsCount - 1;
+  m_filter.assign(bitsCount / 64, 0);
+
+  for (auto const & feature : m_features)
+  {
+    auto const hash = Hash(feature.first);
+    auto const first = hash & m_filterMask;
+    auto const second = (hash >> 32) & m_filterMask;
+    m_filter[first / 64] |= 1ULL << (first % 64);
+    m_filter[second / 64] |= 1ULL << (second % 64);
+  }
+}
+
+bool CustomFeaturesContext::NeedDiscardGeometry(FeatureID const & id) const
+{
+  if (m_filter.empty() || !MayContain(Hash(id)))
+    return false;
+
+  auto const it = m_features.find(id);
+  if (it == m_features.cend())
+    return false;
+  return it->second;
+}
+
+// static
+uint64_t CustomFeaturesContext::Hash(FeatureID const & id)
+{
+  auto const mwm = reinterpret_cast<uintptr_t>(id.m_mwmId.GetInfo().get());
+  return Mix(Mix(static_cast<uint64_t>(mwm)) ^ id.m_index);
+}
+
+bool CustomFeaturesContext::MayContain(uint64_t hash) const
+{
+  auto const first = hash & m_filterMask;
+  auto const second = (hash >> 32) & m_filterMask;
+  return (m_filter[first / 64] & (1ULL << (first % 64))) != 0 &&
+         (m_filter[second / 64] & (1ULL << (second % 64))) != 0;
+}
+}  // namespace df
@@ -2,9 +2,11 @@
 
 #include "indexer/feature_decl.hpp"
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace df
 {
@@ -14,17 +16,18 @@ struct CustomFeaturesContext
 {
   CustomFeatures const m_features;
 
-  explicit CustomFeaturesContext(CustomFeatures && features)
-    : m_features(std::move(features))
-  {}
-
-  bool NeedDiscardGeometry(FeatureID const & id) const
-  {
-    auto const it = m_features.find(id);
-    if (it == m_features.cend())
-      return false;
-    return it->second;
-  }
+  explicit CustomFeaturesContext(CustomFeatures && features);
+
+  // Called for every read feature, so features which are not custom (almost all of them) are
+  // rejected by a bloom filter without searching |m_features|.
+  bool NeedDiscardGeometry(FeatureID const & id) const;
+
+private:
+  static uint64_t Hash(FeatureID const & id);
+  bool MayContain(uint64_t hash) const;
+
+  std::vector<uint64_t> m_filter;
+  uint64_t m_filterMask = 0;
 };
 
 using CustomFeaturesContextPtr = std::shared_ptr<CustomFeaturesContext>;
@@ -278,10 +278,10 @@ void DrapeEngine::UpdateUserMarks(UserMarksProvider * provider, bool firstTime)
     removedIdCollection->m_lineIds.assign(removedLineIds.begin(), removedLineIds.end());
   }
 
-  std::map<kml::MarkGroupId, drape_ptr<IDCollections>> dirtyMarkIds;
+  auto dirtyMarkIds = make_unique_dp<MarksIDGroups>();
   for (auto groupId : dirtyGroupIds)
   {
-    auto & idCollection = *(dirtyMarkIds.emplace(groupId, make_unique_dp<IDCollections>()).first->second);
+    auto & idCollection = *(dirtyMarkIds->emplace(groupId, make_unique_dp<IDCollections>()).first->second);
     bool const visibilityChanged = provider->IsGroupVisibilityChanged(groupId);
     bool const groupIsVisible = provider->IsGroupVisible(groupId);
     if (!groupIsVisible && !visibilityChanged)
@@ -322,26 +322,16 @@ void DrapeEngine::UpdateUserMarks(UserMarksProvider * provider, bool firstTime)
     }
   }
 
-  if (!marksRenderCollection->empty() || !linesRenderCollection->empty() ||
-      !removedIdCollection->IsEmpty() || !createdIdCollection->IsEmpty())
-  {
-    m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
-                                    make_unique_dp<UpdateUserMarksMessage>(
-                                      std::move(createdIdCollection),
-                                      std::move(removedIdCollection),
-                                      std::move(marksRenderCollection),
-                                      std::move(linesRenderCollection)),
-                                    MessagePriority::Normal);
-  }
-
-  for (auto & v : dirtyMarkIds)
-  {
-    m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
-                                    make_unique_dp<UpdateUserMarkGroupMessage>(
-                                      v.first,
-                                      std::move(v.second)),
-                                    MessagePriority::Normal);
-  }
+  // All the changes are sent in one message, so the backend updates its index and regenerates
+  // the changed tiles once per batch instead of once per group.
+  m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                                  make_unique_dp<UpdateUserMarksMessage>(
+                                    std::move(createdIdCollection),
+                                    std::move(removedIdCollection),
+                                    std::move(marksRenderCollection),
+                                    std::move(linesRenderCollection),
+                                    std::move(dirtyMarkIds)),
+                                  MessagePriority::Normal);
 }
 
 void DrapeEngine::SetRenderingEnabled(ref_ptr<dp::GraphicsContextFactory> contextFactory)
@@ -532,6 +522,13 @@ void DrapeEngine::RemoveSubroute(dp::DrapeID subrouteId, bool deactivateFollowin
                                   MessagePriority::Normal);
 }
 
+void DrapeEngine::UpdateSubroute(dp::DrapeID subrouteId, SubrouteConstPtr subroute)
+{
+  m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                                  make_unique_dp<UpdateSubrouteMessage>(subrouteId, subroute),
+                                  MessagePriority::Normal);
+}
+
 void DrapeEngine::DeactivateRouteFollowing()
 {
   m_threadCommutator->PostMessage(ThreadsCommutator::RenderThread,
@@ -861,6 +858,7 @@ drape_ptr<UserMarkRenderParams> DrapeEngine::GenerateMarkRenderInfo(UserPointMar
   renderInfo->m_index = mark->GetIndex();
   renderInfo->m_featureId = mark->GetFeatureID();
   renderInfo->m_hasCreationAnimation = mark->HasCreationAnimation();
+  renderInfo->m_isClusterable = mark->IsClusterable();
   return renderInfo;
 }
 
@@ -164,6 +164,8 @@ public:
   
   dp::DrapeID AddSubroute(SubrouteConstPtr subroute);
   void RemoveSubroute(dp::DrapeID subrouteId, bool deactivateFollowing);
+  // Keeps render data of |subrouteId| which has the same geometry as |subroute|.
+  void UpdateSubroute(dp::DrapeID subrouteId, SubrouteConstPtr subroute);
   void FollowRoute(int preferredZoomLevel, int preferredZoomLevel3d, bool enableAutoZoom);
   void DeactivateRouteFollowing();
   void SetSubrouteVisibility(dp::DrapeID subrouteId, bool isVisible);
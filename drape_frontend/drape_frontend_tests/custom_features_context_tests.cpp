@@ -0,0 +1,34 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/custom_features_context.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <cstdint>
+#include <memory>
+
+using namespace df;
+
+UNIT_TEST(CustomFeaturesContext_NeedDiscardGeometry)
+{
+  MwmSet::MwmId const first(std::make_shared<MwmInfo>());
+  MwmSet::MwmId const second(std::make_shared<MwmInfo>());
+
+  CustomFeatures features;
+  for (uint32_t i = 0; i < 1000; i += 10)
+  {
+    features[FeatureID(first, i)] = true;
+    features[FeatureID(second, i)] = false;
+  }
+  CustomFeaturesContext const context(std::move(features));
+
+  for (uint32_t i = 0; i < 1000; ++i)
+  {
+    TEST_EQUAL(context.NeedDiscardGeometry(FeatureID(first, i)), i % 10 == 0, (i));
+    TEST(!context.NeedDiscardGeometry(FeatureID(second, i)), (i));
+  }
+  TEST(!context.NeedDiscardGeometry(FeatureID(MwmSet::MwmId(), 0)), ());
+
+  CustomFeaturesContext const empty((CustomFeatures()));
+  TEST(!empty.NeedDiscardGeometry(FeatureID(first, 0)), ());
+}
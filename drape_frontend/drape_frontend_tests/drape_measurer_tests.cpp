@@ -0,0 +1,51 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/drape_measurer.hpp"
+
+#include <string>
+
+using namespace df;
+using namespace std;
+
+namespace
+{
+size_t CountOf(string const & str, string const & substr)
+{
+  size_t count = 0;
+  for (auto pos = str.find(substr); pos != string::npos; pos = str.find(substr, pos + 1))
+    ++count;
+  return count;
+}
+}  // namespace
+
+UNIT_TEST(DrapeMeasurer_Tracing)
+{
+  auto & measurer = DrapeMeasurer::Instance();
+
+  measurer.StartTracing();
+  TEST(measurer.IsTracingEnabled(), ());
+  {
+    DrapeMeasurer::TraceGuard guard("Scope", "frame");
+  }
+  auto const now = DrapeMeasurer::TraceClock::now();
+  measurer.AddTraceEvent("Quoted \"name\"", "message", now, now + std::chrono::milliseconds(2));
+  measurer.StopTracing();
+  TEST(!measurer.IsTracingEnabled(), ());
+
+  // Events are not collected after tracing is stopped.
+  {
+    DrapeMeasurer::TraceGuard guard("Scope", "frame");
+  }
+
+  auto const trace = measurer.ExportChromeTrace();
+  TEST_EQUAL(trace.find("{\"traceEvents\":["), 0, (trace));
+  TEST_EQUAL(CountOf(trace, "\"ph\":\"X\""), 2, (trace));
+  TEST_EQUAL(CountOf(trace, "\"name\":\"Scope\",\"cat\":\"frame\""), 1, (trace));
+  TEST_EQUAL(CountOf(trace, "\"name\":\"Quoted \\\"name\\\"\",\"cat\":\"message\""), 1, (trace));
+  TEST_EQUAL(CountOf(trace, "\"dur\":2000,"), 1, (trace));
+
+  // Events of the previous tracing are dropped.
+  measurer.StartTracing();
+  measurer.StopTracing();
+  TEST_EQUAL(CountOf(measurer.ExportChromeTrace(), "\"ph\":\"X\""), 0, ());
+}
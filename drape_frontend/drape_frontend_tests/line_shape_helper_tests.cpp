@@ -0,0 +1,133 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/line_shape_helper.hpp"
+
+#include "drape/glsl_func.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/timer.hpp"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace df;
+using namespace std;
+
+namespace
+{
+double constexpr kScalar = 1000.0;
+
+vector<m2::PointD> MakePath(size_t pointsCount, mt19937 & rng)
+{
+  uniform_real_distribution<double> dist(-0.01, 0.01);
+  vector<m2::PointD> path;
+  path.reserve(pointsCount);
+  m2::PointD pt(37.5, 67.5);
+  for (size_t i = 0; i < pointsCount; ++i)
+  {
+    // Every 10th segment is degenerate.
+    if (i % 10 != 9)
+      pt += m2::PointD(dist(rng), dist(rng));
+    path.push_back(pt);
+  }
+  return path;
+}
+
+bool AlmostEqual(glsl::vec2 const & v1, glsl::vec2 const & v2)
+{
+  float constexpr kEps = 1e-5f;
+  return base::AlmostEqualAbs(v1.x, v2.x, kEps) && base::AlmostEqualAbs(v1.y, v2.y, kEps);
+}
+}  // namespace
+
+UNIT_TEST(SplineSegments_Smoke)
+{
+  mt19937 rng(0);
+  m2::PointD const tileCenter(37.5, 67.5);
+  auto const path = MakePath(100 /* pointsCount */, rng);
+
+  SplineSegments segments;
+  segments.Build(path, tileCenter, kScalar);
+
+  size_t k = 0;
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
+      continue;
+
+    TEST_LESS(k, segments.GetCount(), ());
+    TEST_EQUAL(segments.GetPathIndex(k), i, ());
+
+    glsl::vec2 const p1 = glsl::ToVec2((path[i - 1] - tileCenter) * kScalar);
+    glsl::vec2 const p2 = glsl::ToVec2((path[i] - tileCenter) * kScalar);
+    glsl::vec2 tangent, leftNormal, rightNormal;
+    CalculateTangentAndNormals(p1, p2, tangent, leftNormal, rightNormal);
+
+    TEST(AlmostEqual(segments.GetStartPoint(k), p1), ());
+    TEST(AlmostEqual(segments.GetEndPoint(k), p2), ());
+    TEST(AlmostEqual(segments.GetTangent(k), tangent), ());
+    TEST(AlmostEqual(segments.GetLeftNormal(k), leftNormal), ());
+    TEST(AlmostEqual(segments.GetRightNormal(k), rightNormal), ());
+    TEST(base::AlmostEqualRel(segments.GetLength(k), glsl::length(p2 - p1), 1e-5f), ());
+    TEST(base::AlmostEqualRel(static_cast<double>(segments.GetGlobalLength(k)),
+                              (path[i] - path[i - 1]).Length(), 1e-5), ());
+    ++k;
+  }
+  TEST_EQUAL(k, segments.GetCount(), ());
+  TEST_EQUAL(k, 89, ());
+
+  // Storage is reused by a shorter path.
+  segments.Build({path[0], path[1]}, tileCenter, kScalar);
+  TEST_EQUAL(segments.GetCount(), 1, ());
+  TEST_EQUAL(segments.GetPathIndex(0), 1, ());
+}
+
+UNIT_TEST(SplineSegments_Benchmark)
+{
+  size_t constexpr kPathsCount = 2000;
+  size_t constexpr kPointsCount = 200;
+
+  mt19937 rng(0);
+  vector<vector<m2::PointD>> paths;
+  for (size_t i = 0; i < kPathsCount; ++i)
+    paths.push_back(MakePath(kPointsCount, rng));
+  m2::PointD const tileCenter(37.5, 67.5);
+
+  // Scalar calculation of segments, as line shapes did before.
+  float checksum1 = 0.0f;
+  base::Timer timer;
+  for (auto const & path : paths)
+  {
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+      if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
+        continue;
+
+      glsl::vec2 const p1 = glsl::ToVec2((path[i - 1] - tileCenter) * kScalar);
+      glsl::vec2 const p2 = glsl::ToVec2((path[i] - tileCenter) * kScalar);
+      glsl::vec2 tangent, leftNormal, rightNormal;
+      CalculateTangentAndNormals(p1, p2, tangent, leftNormal, rightNormal);
+      checksum1 += tangent.x + glsl::length(p2 - p1);
+    }
+  }
+  double const scalarTime = timer.ElapsedSeconds();
+
+  float checksum2 = 0.0f;
+  timer.Reset();
+  SplineSegments segments;
+  for (auto const & path : paths)
+  {
+    segments.Build(path, tileCenter, kScalar);
+    for (size_t i = 0; i < segments.GetCount(); ++i)
+      checksum2 += segments.GetTangent(i).x + segments.GetLength(i);
+  }
+  double const batchedTime = timer.ElapsedSeconds();
+
+  TEST(base::AlmostEqualRel(checksum1, checksum2, 1e-3f), (checksum1, checksum2));
+  LOG(LINFO, ("Segments of", kPathsCount, "paths: scalar", scalarTime, "s, batched", batchedTime,
+              "s"));
+}
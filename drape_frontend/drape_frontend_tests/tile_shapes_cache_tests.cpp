@@ -0,0 +1,79 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include <memory>
+
+using namespace df;
+
+namespace
+{
+std::shared_ptr<TileShapes const> MakeShapes() { return std::make_shared<TileShapes>(); }
+}  // namespace
+
+UNIT_TEST(TileShapesCache_LeastRecentlyUsedIsEvicted)
+{
+  TileShapesCache cache(2 /* maxTilesCount */);
+  TileKey const a(0, 0, 10);
+  TileKey const b(1, 0, 10);
+  TileKey const c(2, 0, 10);
+
+  auto const shapes = MakeShapes();
+  cache.Put(a, cache.GetGeneration(), shapes);
+  cache.Put(b, cache.GetGeneration(), MakeShapes());
+  TEST_EQUAL(cache.Get(a), shapes, ());
+
+  cache.Put(c, cache.GetGeneration(), MakeShapes());
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(!cache.Get(b), ());
+  TEST(cache.Get(c), ());
+
+  // Generations of tile keys are not considered.
+  TEST_EQUAL(cache.Get(TileKey(a, 5 /* generation */, 7 /* userMarksGeneration */)), shapes, ());
+}
+
+UNIT_TEST(TileShapesCache_Invalidation)
+{
+  TileShapesCache cache(10 /* maxTilesCount */);
+  TileKey const a(0, 0, 10);
+  TileKey const b(100, 100, 10);
+  TileKey const aChild(0, 0, 11);
+
+  auto const generation = cache.GetGeneration();
+  cache.Put(a, generation, MakeShapes());
+  cache.Put(b, generation, MakeShapes());
+  cache.Put(aChild, generation, MakeShapes());
+
+  cache.Erase(a.GetGlobalRect(false /* clipByDataMaxZoom */));
+  TEST(!cache.Get(a), ());
+  TEST(!cache.Get(aChild), ());
+  TEST(cache.Get(b), ());
+
+  // Shapes read before invalidation are discarded.
+  cache.Put(a, generation, MakeShapes());
+  TEST(!cache.Get(a), ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  cache.Put(a, cache.GetGeneration(), MakeShapes());
+  TEST(cache.Get(a), ());
+}
+
+UNIT_TEST(TileShapesCache_ContainsDoesNotChangeOrder)
+{
+  TileShapesCache cache(2 /* maxTilesCount */);
+  TileKey const a(0, 0, 10);
+  TileKey const b(1, 0, 10);
+  TileKey const c(2, 0, 10);
+
+  cache.Put(a, cache.GetGeneration(), MakeShapes());
+  cache.Put(b, cache.GetGeneration(), MakeShapes());
+  TEST(cache.Contains(a), ());
+  TEST(!cache.Contains(c), ());
+
+  cache.Put(c, cache.GetGeneration(), MakeShapes());
+  TEST(!cache.Contains(a), ());
+  TEST(cache.Contains(b), ());
+  TEST(cache.Contains(c), ());
+}
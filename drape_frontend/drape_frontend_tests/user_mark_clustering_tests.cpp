@@ -0,0 +1,57 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/user_mark_shapes.hpp"
+
+#include <algorithm>
+
+using namespace df;
+
+namespace
+{
+void AddMark(kml::MarkId id, m2::PointD const & pivot, bool isClusterable, uint16_t priority,
+             UserMarksRenderCollection & marks, kml::MarkIdCollection & ids)
+{
+  auto params = make_unique_dp<UserMarkRenderParams>();
+  params->m_pivot = pivot;
+  params->m_isClusterable = isClusterable;
+  params->m_priority = priority;
+  params->m_symbolNames = make_unique_dp<UserPointMark::SymbolNameZoomInfo>();
+  marks.emplace(id, std::move(params));
+  ids.push_back(id);
+}
+}  // namespace
+
+UNIT_TEST(ClusterUserMarks_Smoke)
+{
+  TileKey const tileKey(0, 0, 10);
+  m2::RectD const rect = tileKey.GetGlobalRect();
+  auto const point = [&rect](double x, double y)
+  {
+    return m2::PointD(rect.minX() + rect.SizeX() * x, rect.minY() + rect.SizeY() * y);
+  };
+
+  UserMarksRenderCollection marks;
+  kml::MarkIdCollection ids;
+  AddMark(1, point(0.1, 0.1), true /* isClusterable */, 0 /* priority */, marks, ids);
+  AddMark(2, point(0.15, 0.1), true /* isClusterable */, 2 /* priority */, marks, ids);
+  AddMark(3, point(0.2, 0.1), true /* isClusterable */, 1 /* priority */, marks, ids);
+  // Not clusterable mark in the same cell.
+  AddMark(4, point(0.1, 0.2), false /* isClusterable */, 0 /* priority */, marks, ids);
+  // The only mark of its cell.
+  AddMark(5, point(0.9, 0.9), true /* isClusterable */, 0 /* priority */, marks, ids);
+  // Invisible marks are skipped.
+  AddMark(6, point(0.1, 0.1), true /* isClusterable */, 0 /* priority */, marks, ids);
+  marks[6]->m_isVisible = false;
+
+  kml::MarkIdCollection separateIds;
+  UserMarkClusters clusters;
+  ClusterUserMarks(tileKey, ids, marks, separateIds, clusters);
+
+  std::sort(separateIds.begin(), separateIds.end());
+  TEST_EQUAL(separateIds, kml::MarkIdCollection({4, 5}), ());
+  TEST_EQUAL(clusters.size(), 1, ());
+  TEST_EQUAL(clusters[0].m_count, 3, ());
+  TEST_EQUAL(clusters[0].m_markId, 2, ());
+  TEST(clusters[0].m_pivot.EqualDxDy(point(0.15, 0.1), 1e-9), ());
+}
@@ -1,9 +1,33 @@
 #include "drape_frontend/drape_measurer.hpp"
 
 #include <iomanip>
+#include <sstream>
 
 namespace df
 {
+namespace
+{
+// Approximately 10 minutes of tracing with 60 fps.
+size_t constexpr kMaxTraceEventsCount = 500000;
+// Approximately 1 hour with 60 fps.
+size_t constexpr kMaxFrameStatisticCount = 216000;
+
+void WriteJsonString(std::ostringstream & ss, std::string const & str)
+{
+  ss << '"';
+  for (auto const c : str)
+  {
+    if (c == '"' || c == '\\')
+      ss << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      ss << ' ';
+    else
+      ss << c;
+  }
+  ss << '"';
+}
+}  // namespace
+
 DrapeMeasurer & DrapeMeasurer::Instance()
 {
   static DrapeMeasurer s_inst;
@@ -71,6 +95,128 @@ void DrapeMeasurer::StopBenchmark()
   m_isEnabled = false;
 }
 
+void DrapeMeasurer::StartTracing()
+{
+  std::lock_guard<std::mutex> lock(m_traceMutex);
+  m_tracingStartTime = TraceClock::now();
+  m_traceEvents.clear();
+  m_traceThreads.clear();
+  m_droppedTraceEventsCount = 0;
+  m_isTracingEnabled = true;
+}
+
+void DrapeMeasurer::StopTracing()
+{
+  m_isTracingEnabled = false;
+}
+
+void DrapeMeasurer::AddTraceEvent(std::string const & name, char const * category,
+                                  TraceClock::time_point const & start,
+                                  TraceClock::time_point const & end)
+{
+  using namespace std::chrono;
+
+  if (!m_isTracingEnabled)
+    return;
+
+  auto const tid = threads::GetCurrentThreadID();
+
+  std::lock_guard<std::mutex> lock(m_traceMutex);
+  if (m_traceEvents.size() >= kMaxTraceEventsCount)
+  {
+    ++m_droppedTraceEventsCount;
+    return;
+  }
+
+  auto const it = m_traceThreads.emplace(tid, static_cast<uint32_t>(m_traceThreads.size())).first;
+
+  TraceEvent event;
+  event.m_name = name;
+  event.m_category = category;
+  event.m_threadIndex = it->second;
+  event.m_startInUs = duration_cast<microseconds>(start - m_tracingStartTime).count();
+  event.m_durationInUs = duration_cast<microseconds>(end - start).count();
+  m_traceEvents.push_back(std::move(event));
+}
+
+std::string DrapeMeasurer::ExportChromeTrace() const
+{
+  std::ostringstream ss;
+
+  std::lock_guard<std::mutex> lock(m_traceMutex);
+  ss << "{\"traceEvents\":[";
+  for (size_t i = 0; i < m_traceEvents.size(); ++i)
+  {
+    auto const & event = m_traceEvents[i];
+    if (i != 0)
+      ss << ",";
+    ss << "\n{\"name\":";
+    WriteJsonString(ss, event.m_name);
+    ss << ",\"cat\":";
+    WriteJsonString(ss, event.m_category);
+    ss << ",\"ph\":\"X\",\"ts\":" << event.m_startInUs << ",\"dur\":" << event.m_durationInUs
+       << ",\"pid\":0,\"tid\":" << event.m_threadIndex << "}";
+  }
+  ss << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":"
+     << m_droppedTraceEventsCount << "}}\n";
+  return ss.str();
+}
+
+DrapeMeasurer::TraceGuard::TraceGuard(char const * name, char const * category)
+  : m_name(name)
+  , m_category(category)
+  , m_isEnabled(DrapeMeasurer::Instance().IsTracingEnabled())
+{
+  if (m_isEnabled)
+    m_start = TraceClock::now();
+}
+
+DrapeMeasurer::TraceGuard::~TraceGuard()
+{
+  if (m_isEnabled)
+    DrapeMeasurer::Instance().AddTraceEvent(m_name, m_category, m_start, TraceClock::now());
+}
+
+void DrapeMeasurer::StartFrameStatistic()
+{
+  std::lock_guard<std::mutex> lock(m_frameStatisticMutex);
+  m_frameStatistic.clear();
+  m_readTilesCount = 0;
+  m_isFrameStatisticEnabled = true;
+}
+
+void DrapeMeasurer::StopFrameStatistic()
+{
+  m_isFrameStatisticEnabled = false;
+}
+
+void DrapeMeasurer::AddFrameStatistic(FrameStatistic statistic)
+{
+  if (!m_isFrameStatisticEnabled)
+    return;
+
+  statistic.m_readTilesCount = m_readTilesCount.exchange(0);
+#ifdef TRACK_GPU_MEM
+  statistic.m_gpuMemoryInMb = dp::GPUMemTracker::Inst().GetMemorySnapshot().m_summaryAllocatedInMb;
+#endif
+
+  std::lock_guard<std::mutex> lock(m_frameStatisticMutex);
+  if (m_frameStatistic.size() < kMaxFrameStatisticCount)
+    m_frameStatistic.push_back(statistic);
+}
+
+void DrapeMeasurer::OnTileRead()
+{
+  if (m_isFrameStatisticEnabled)
+    ++m_readTilesCount;
+}
+
+std::vector<DrapeMeasurer::FrameStatistic> DrapeMeasurer::GetFrameStatistic() const
+{
+  std::lock_guard<std::mutex> lock(m_frameStatisticMutex);
+  return m_frameStatistic;
+}
+
 #ifdef GENERATING_STATISTIC
 void DrapeMeasurer::StartScenePreparing()
 {
@@ -7,11 +7,14 @@
 #include "base/thread.hpp"
 #include "base/timer.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -25,6 +28,63 @@ public:
   void StartBenchmark();
   void StopBenchmark();
 
+  // Tracing is enabled at runtime, so it works in release builds. Trace events are
+  // collected from all threads and exported in Chrome trace format, which is opened
+  // by chrome://tracing or Perfetto.
+  using TraceClock = std::chrono::steady_clock;
+
+  // Drops events of the previous tracing.
+  void StartTracing();
+  void StopTracing();
+  bool IsTracingEnabled() const { return m_isTracingEnabled; }
+
+  // Adds a complete event on the current thread. Does nothing if tracing is disabled.
+  void AddTraceEvent(std::string const & name, char const * category,
+                     TraceClock::time_point const & start, TraceClock::time_point const & end);
+
+  std::string ExportChromeTrace() const;
+
+  // Adds an event for the scope lifetime. |name| and |category| must be string literals.
+  class TraceGuard
+  {
+  public:
+    TraceGuard(char const * name, char const * category);
+    ~TraceGuard();
+
+  private:
+    char const * m_name;
+    char const * m_category;
+    bool m_isEnabled;
+    TraceClock::time_point m_start;
+  };
+
+  // Statistic of every frame is collected at runtime during scripted benchmarks.
+  struct FrameStatistic
+  {
+    // Time of the frame on the render thread without presentation.
+    double m_cpuTimeInMs = 0.0;
+    // Presentation waits for the GPU to process previous frames, so it's used
+    // as an estimation of GPU time.
+    double m_presentTimeInMs = 0.0;
+    double m_overlayPlacementTimeInMs = 0.0;
+    // Tiles read by the backend renderer since the previous frame.
+    uint32_t m_readTilesCount = 0;
+    uint32_t m_notFinishedTilesCount = 0;
+    // Memory is tracked in builds with TRACK_GPU_MEM only.
+    uint32_t m_gpuMemoryInMb = 0;
+  };
+
+  // Drops statistic of the previous frames.
+  void StartFrameStatistic();
+  void StopFrameStatistic();
+  bool IsFrameStatisticEnabled() const { return m_isFrameStatisticEnabled; }
+
+  // Must be called on the render thread. Tiles and memory are filled in by the measurer.
+  void AddFrameStatistic(FrameStatistic statistic);
+  void OnTileRead();
+
+  std::vector<FrameStatistic> GetFrameStatistic() const;
+
 #ifdef RENDER_STATISTIC
   struct RenderStatistic
   {
@@ -129,6 +189,27 @@ private:
 
   bool m_isEnabled = false;
 
+  struct TraceEvent
+  {
+    std::string m_name;
+    char const * m_category;
+    uint32_t m_threadIndex;
+    int64_t m_startInUs;
+    int64_t m_durationInUs;
+  };
+
+  std::atomic<bool> m_isTracingEnabled{false};
+  mutable std::mutex m_traceMutex;
+  TraceClock::time_point m_tracingStartTime;
+  std::vector<TraceEvent> m_traceEvents;
+  std::map<threads::ThreadID, uint32_t> m_traceThreads;
+  uint64_t m_droppedTraceEventsCount = 0;
+
+  std::atomic<bool> m_isFrameStatisticEnabled{false};
+  std::atomic<uint32_t> m_readTilesCount{0};
+  mutable std::mutex m_frameStatisticMutex;
+  std::vector<FrameStatistic> m_frameStatistic;
+
 #ifdef GENERATING_STATISTIC
   std::chrono::time_point<std::chrono::steady_clock> m_startScenePreparingTime;
   std::chrono::nanoseconds m_maxScenePreparingTime;
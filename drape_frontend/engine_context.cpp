@@ -1,6 +1,8 @@
 #include "drape_frontend/engine_context.hpp"
 
 #include "drape_frontend/message_subclasses.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
+
 #include "drape/texture_manager.hpp"
 
 #include <utility>
@@ -44,16 +46,40 @@ void EngineContext::BeginReadTile()
 
 void EngineContext::Flush(TMapShapes && shapes)
 {
+  if (m_recordedShapes)
+  {
+    auto & geometry = m_recordedShapes->m_geometry;
+    geometry.insert(geometry.end(), shapes.begin(), shapes.end());
+  }
+  if (m_recordOnly)
+    return;
   PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, std::move(shapes)));
 }
 
 void EngineContext::FlushOverlays(TMapShapes && shapes)
 {
+  if (m_recordedShapes)
+  {
+    auto & overlays = m_recordedShapes->m_overlays;
+    overlays.insert(overlays.end(), shapes.begin(), shapes.end());
+  }
+  if (m_recordOnly)
+    return;
   PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, std::move(shapes)));
 }
 
 void EngineContext::FlushTrafficGeometry(TrafficSegmentsGeometry && geometry)
 {
+  if (m_recordedShapes)
+  {
+    for (auto const & mwmGeometry : geometry)
+    {
+      auto & value = m_recordedShapes->m_trafficGeometry[mwmGeometry.first];
+      value.insert(value.end(), mwmGeometry.second.begin(), mwmGeometry.second.end());
+    }
+  }
+  if (m_recordOnly)
+    return;
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                             make_unique_dp<FlushTrafficGeometryMessage>(m_tileKey, std::move(geometry)),
                             MessagePriority::Low);
@@ -10,6 +10,7 @@
 #include "drape/pointers.hpp"
 
 #include <functional>
+#include <memory>
 
 namespace dp
 {
@@ -20,6 +21,7 @@ namespace df
 {
 class Message;
 class MetalineManager;
+struct TileShapes;
 
 class EngineContext
 {
@@ -44,6 +46,12 @@ public:
   ref_ptr<dp::TextureManager> GetTextureManager() const;
   ref_ptr<MetalineManager> GetMetalineManager() const;
 
+  // Copies of all flushed shapes are put to |shapes| when it's not nullptr.
+  void RecordShapes(std::shared_ptr<TileShapes> shapes) { m_recordedShapes = std::move(shapes); }
+  // Flushed shapes are only recorded and not sent to the backend renderer. It's used
+  // to prefetch tiles to TileShapesCache.
+  void SetRecordOnly(bool recordOnly) { m_recordOnly = recordOnly; }
+
   void BeginReadTile();
   void Flush(TMapShapes && shapes);
   void FlushOverlays(TMapShapes && shapes);
@@ -62,5 +70,7 @@ private:
   bool m_trafficEnabled;
   int m_displacementMode;
   TIsUGCFn m_isUGCFn;
+  std::shared_ptr<TileShapes> m_recordedShapes;
+  bool m_recordOnly = false;
 };
 }  // namespace df
@@ -18,6 +18,7 @@
 
 #include "drape/drape_global.hpp"
 #include "drape/framebuffer.hpp"
+#include "drape/gpu_buffer_arena.hpp"
 #include "drape/support_manager.hpp"
 #include "drape/utils/glyph_usage_tracker.hpp"
 #include "drape/utils/gpu_mem_tracker.hpp"
@@ -288,13 +289,15 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::Type::FlushTile:
     {
       ref_ptr<FlushRenderBucketMessage> msg = message;
-      dp::RenderState const & state = msg->GetState();
       TileKey const & key = msg->GetKey();
-      drape_ptr<dp::RenderBucket> bucket = msg->AcceptBuffer();
+      auto buckets = msg->AcceptBuckets();
       if (key.m_zoomLevel == m_currentZoomLevel && CheckTileGenerations(key))
       {
-        PrepareBucket(state, bucket);
-        AddToRenderGroup<RenderGroup>(state, std::move(bucket), key);
+        for (auto & stateBucket : buckets)
+        {
+          PrepareBucket(stateBucket.first, stateBucket.second);
+          AddToRenderGroup<RenderGroup>(stateBucket.first, std::move(stateBucket.second), key);
+        }
       }
       break;
     }
@@ -327,6 +330,27 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::Type::FinishTileRead:
     {
       ref_ptr<FinishTileReadMessage> msg = message;
+      // User marks of these tiles were not regenerated, the existing geometry is moved to
+      // the new generation to not be removed as an outdated one.
+      auto const & unchangedUserMarksTiles = msg->GetUnchangedUserMarksTiles();
+      if (!unchangedUserMarksTiles.empty())
+      {
+        for (RenderLayer & layer : m_layers)
+        {
+          for (auto & group : layer.m_renderGroups)
+          {
+            if (!group->IsUserMark() || group->IsPendingOnDelete())
+              continue;
+            auto const it = unchangedUserMarksTiles.find(group->GetTileKey());
+            if (it != unchangedUserMarksTiles.end() &&
+                group->GetTileKey().m_userMarksGeneration < it->m_userMarksGeneration)
+            {
+              group->SetUserMarksGeneration(it->m_userMarksGeneration);
+            }
+          }
+        }
+      }
+
       bool changed = false;
       for (auto const & tileKey : msg->GetTiles())
       {
@@ -587,6 +611,17 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::Type::UpdateSubroute:
+    {
+      ref_ptr<UpdateSubrouteMessage> msg = message;
+      m_routeRenderer->UpdateSubroute(msg->GetSubrouteId(), msg->GetSubroute());
+
+      // Route arrows depend on distances of turns which may be changed.
+      m_routeRenderer->UpdateRoute(m_userEventStream.GetCurrentScreen(),
+                                   std::bind(&FrontendRenderer::OnCacheRouteArrows, this, _1, _2));
+      break;
+    }
+
   case Message::Type::FollowRoute:
     {
       ref_ptr<FollowRouteMessage> const msg = message;
@@ -904,6 +939,20 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::Type::ClearTrafficTileData:
+    {
+      ref_ptr<ClearTrafficTileDataMessage> msg = message;
+      m_trafficRenderer->Clear(msg->GetMwmId(), msg->GetTileKey());
+      break;
+    }
+
+  case Message::Type::RecolorTraffic:
+    {
+      ref_ptr<RecolorTrafficMessage> msg = message;
+      m_trafficRenderer->UpdateColors(msg->GetColors());
+      break;
+    }
+
   case Message::Type::DrapeApiFlush:
     {
       ref_ptr<DrapeApiFlushMessage> msg = message;
@@ -1303,6 +1352,7 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFram
 #if defined(DRAPE_MEASURER) && (defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM))
   DrapeImmediateRenderingMeasurerGuard drapeMeasurerGuard(m_context);
 #endif
+  DrapeMeasurer::TraceGuard traceGuard("RenderScene", "frame");
 
   PreRender3dLayer(modelView);
 
@@ -1324,7 +1374,7 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFram
 
     m_context->Clear(clearBits, storeBits);
     m_context->ApplyFramebuffer("Static frame");
-    m_viewport.Apply(m_context);
+    m_postprocessRenderer->GetSceneViewport(m_viewport).Apply(m_context);
 
     Render2dLayer(modelView);
     RenderUserMarksLayer(modelView, DepthLayer::UserLineLayer);
@@ -1399,14 +1449,18 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFram
       m_debugRectRenderer->DrawArrow(m_context, modelView, arrow);
   }
 
-  if (!m_postprocessRenderer->EndFrame(m_context, make_ref(m_gpuProgramManager), m_viewport))
-    return;
+  {
+    DrapeMeasurer::TraceGuard postprocessTraceGuard("Postprocess", "frame");
+    if (!m_postprocessRenderer->EndFrame(m_context, make_ref(m_gpuProgramManager), m_viewport))
+      return;
+  }
 
   m_myPositionController->Render(m_context, make_ref(m_gpuProgramManager), modelView, m_currentZoomLevel,
                                  m_frameValues);
 
   if (m_guiRenderer != nullptr)
   {
+    DrapeMeasurer::TraceGuard guiTraceGuard("Gui", "frame");
     m_guiRenderer->Render(m_context, make_ref(m_gpuProgramManager), m_myPositionController->IsInRouting(),
                           modelView);
   }
@@ -1414,6 +1468,7 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFram
 
 void FrontendRenderer::Render2dLayer(ScreenBase const & modelView)
 {
+  DrapeMeasurer::TraceGuard traceGuard("Render2dLayer", "frame");
   RenderLayer & layer2d = m_layers[static_cast<size_t>(DepthLayer::GeometryLayer)];
   layer2d.Sort(make_ref(m_overlayTree));
 
@@ -1445,6 +1500,7 @@ void FrontendRenderer::PreRender3dLayer(ScreenBase const & modelView)
   
 void FrontendRenderer::Render3dLayer(ScreenBase const & modelView)
 {
+  DrapeMeasurer::TraceGuard traceGuard("Render3dLayer", "frame");
   RenderLayer & layer = m_layers[static_cast<size_t>(DepthLayer::Geometry3dLayer)];
   if (layer.m_renderGroups.empty())
     return;
@@ -1471,6 +1527,7 @@ void FrontendRenderer::Render3dLayer(ScreenBase const & modelView)
 
 void FrontendRenderer::RenderOverlayLayer(ScreenBase const & modelView)
 {
+  DrapeMeasurer::TraceGuard traceGuard("RenderOverlayLayer", "frame");
   CHECK(m_context != nullptr, ());
   DEBUG_LABEL(m_context, "Overlay Layer");
   RenderLayer & overlay = m_layers[static_cast<size_t>(DepthLayer::OverlayLayer)];
@@ -1520,6 +1577,7 @@ void FrontendRenderer::RenderTransitSchemeLayer(ScreenBase const & modelView)
 
 void FrontendRenderer::RenderTrafficLayer(ScreenBase const & modelView)
 {
+  DrapeMeasurer::TraceGuard traceGuard("RenderTrafficLayer", "frame");
   CHECK(m_context != nullptr, ());
   if (m_trafficRenderer->HasRenderData())
   {
@@ -1550,6 +1608,7 @@ void FrontendRenderer::RenderTransitBackground()
 
 void FrontendRenderer::RenderRouteLayer(ScreenBase const & modelView)
 {
+  DrapeMeasurer::TraceGuard traceGuard("RenderRouteLayer", "frame");
   if (HasTransitRouteData())
     RenderTransitBackground();
   
@@ -1565,6 +1624,7 @@ void FrontendRenderer::RenderRouteLayer(ScreenBase const & modelView)
 
 void FrontendRenderer::RenderUserMarksLayer(ScreenBase const & modelView, DepthLayer layerId)
 {
+  DrapeMeasurer::TraceGuard traceGuard("RenderUserMarksLayer", "frame");
   auto & renderGroups = m_layers[static_cast<size_t>(layerId)].m_renderGroups;
   if (renderGroups.empty())
     return;
@@ -1610,7 +1670,8 @@ void FrontendRenderer::RenderFrame()
 #if defined(DRAPE_MEASURER) && (defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM))
   DrapeMeasurerGuard drapeMeasurerGuard;
 #endif
-  
+  DrapeMeasurer::TraceGuard traceGuard("Frame", "frame");
+
   CHECK(m_context != nullptr, ());
   if (!m_context->Validate())
   {
@@ -1621,6 +1682,8 @@ void FrontendRenderer::RenderFrame()
 
   auto & scaleFpsHelper = gui::DrapeGui::Instance().GetScaleFpsHelper();
   m_frameData.m_timer.Reset();
+  m_frameData.m_overlayPlacementTime = 0.0;
+  uint64_t const frameIndex = ++m_frameIndex;
 
   ScreenBase modelView = ProcessEvents(m_frameData.m_modelViewChanged, m_frameData.m_viewportChanged);
   if (m_frameData.m_viewportChanged)
@@ -1650,6 +1713,7 @@ void FrontendRenderer::RenderFrame()
   m_frameData.m_framesFast += static_cast<uint64_t>(!isActiveFrameForScene);
 #endif
 
+  m_postprocessRenderer->UpdateFrameQuality(m_frameData.m_modelViewChanged, m_frameData.m_frameTime);
   RenderScene(modelView, isActiveFrameForScene);
 
   auto const hasForceUpdate = m_forceUpdateScene || m_forceUpdateUserMarks;
@@ -1678,6 +1742,22 @@ void FrontendRenderer::RenderFrame()
 
   bool const canSuspend = m_frameData.m_inactiveFramesCounter > FrameData::kMaxInactiveFrames;
   m_frameData.m_forceFullRedrawNextFrame = m_overlayTree->IsNeedUpdate();
+
+  if (!m_frameData.m_modelViewChanged && !m_frameData.m_forceFullRedrawNextFrame &&
+      m_notFinishedTiles.empty() && !AnimationSystem::Instance().HasAnimations() &&
+      !m_userEventStream.IsWaitingForActionCompletion())
+  {
+    m_lastReadyFrameIndex = frameIndex;
+  }
+
+  DrapeMeasurer::FrameStatistic frameStatistic;
+  if (DrapeMeasurer::Instance().IsFrameStatisticEnabled())
+  {
+    frameStatistic.m_cpuTimeInMs = m_frameData.m_timer.ElapsedSeconds() * 1000.0;
+    frameStatistic.m_overlayPlacementTimeInMs = m_frameData.m_overlayPlacementTime * 1000.0;
+    frameStatistic.m_notFinishedTilesCount = static_cast<uint32_t>(m_notFinishedTiles.size());
+  }
+
   if (canSuspend)
   {
     // Process a message or wait for a message.
@@ -1705,8 +1785,14 @@ void FrontendRenderer::RenderFrame()
   }
 
 #ifndef DISABLE_SCREEN_PRESENTATION
-  m_context->Present();
+  {
+    DrapeMeasurer::TraceGuard presentTraceGuard("Present", "frame");
+    base::Timer presentTimer;
+    m_context->Present();
+    frameStatistic.m_presentTimeInMs = presentTimer.ElapsedSeconds() * 1000.0;
+  }
 #endif
+  DrapeMeasurer::Instance().AddFrameStatistic(frameStatistic);
 
   // Limit fps in following mode.
   double constexpr kFrameTime = 1.0 / 30.0;
@@ -1724,6 +1810,8 @@ void FrontendRenderer::RenderFrame()
 
 void FrontendRenderer::BuildOverlayTree(ScreenBase const & modelView)
 {
+  DrapeMeasurer::TraceGuard traceGuard("OverlayPlacement", "frame");
+  base::Timer const timer;
   static std::vector<DepthLayer> layers = {DepthLayer::OverlayLayer,
                                            DepthLayer::LocalAdsMarkLayer,
                                            DepthLayer::NavigationLayer,
@@ -1740,6 +1828,7 @@ void FrontendRenderer::BuildOverlayTree(ScreenBase const & modelView)
   if (m_transitSchemeRenderer->IsSchemeVisible(m_currentZoomLevel) && !HasTransitRouteData())
     m_transitSchemeRenderer->CollectOverlays(make_ref(m_overlayTree), modelView);
   EndUpdateOverlayTree();
+  m_frameData.m_overlayPlacementTime += timer.ElapsedSeconds();
 }
 
 void FrontendRenderer::PrepareBucket(dp::RenderState const & state, drape_ptr<dp::RenderBucket> & bucket)
@@ -2092,6 +2181,8 @@ void FrontendRenderer::OnContextDestroy()
 {
   LOG(LINFO, ("On context destroy."));
 
+  dp::GpuBufferArena::Instance().SetEnabled(false);
+
   // Clear all graphics.
   for (RenderLayer & layer : m_layers)
   {
@@ -2150,6 +2241,13 @@ void FrontendRenderer::OnContextCreate()
 
   dp::SupportManager::Instance().Init(m_context);
 
+  // Adreno 200 GPUs aren't able to share OpenGL resources between contexts correctly,
+  // so buffers of every bucket are created on the render thread there.
+  bool const isOpenGL = m_apiVersion == dp::ApiVersion::OpenGLES2 ||
+                        m_apiVersion == dp::ApiVersion::OpenGLES3;
+  dp::GpuBufferArena::Instance().SetEnabled(isOpenGL &&
+                                            !dp::SupportManager::Instance().IsAdreno200Device());
+
   m_gpuProgramManager = make_unique_dp<gpu::ProgramManager>();
   m_gpuProgramManager->Init(m_context);
 
@@ -2351,9 +2449,10 @@ void FrontendRenderer::UpdateScene(ScreenBase const & modelView)
   {
     EmitModelViewChanged(modelView);
     m_lastReadedModelView = modelView;
+    auto tiles = ResolveTileKeys(modelView);
+    m_requestedTiles->SetPrefetchTiles(ResolvePrefetchTileKeys(modelView, tiles));
     m_requestedTiles->Set(modelView, m_isIsometry || modelView.isPerspective(),
-                          m_forceUpdateScene, m_forceUpdateUserMarks,
-                          ResolveTileKeys(modelView));
+                          m_forceUpdateScene, m_forceUpdateUserMarks, std::move(tiles));
     m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                               make_unique_dp<UpdateReadManagerMessage>(),
                               MessagePriority::UberHighSingleton);
@@ -2362,6 +2461,42 @@ void FrontendRenderer::UpdateScene(ScreenBase const & modelView)
   }
 }
 
+TTilesCollection FrontendRenderer::ResolvePrefetchTileKeys(ScreenBase const & screen,
+                                                           TTilesCollection const & tiles) const
+{
+  TTilesCollection prefetchTiles;
+  if (!AnimationSystem::Instance().HasMapAnimations())
+    return prefetchTiles;
+
+  ScreenBase targetScreen;
+  AnimationSystem::Instance().GetTargetScreen(screen, targetScreen);
+
+  // Tiles of another zoom level are not prefetched, they would be dropped on the way.
+  if (GetDrawTileScale(targetScreen) != m_currentZoomLevel)
+    return prefetchTiles;
+
+  // The screen in the middle of the way is also covered, because a long animation
+  // passes through tiles which are visible neither now nor at the end.
+  ScreenBase middleScreen = targetScreen;
+  middleScreen.SetOrg((screen.GetOrg() + targetScreen.GetOrg()) * 0.5);
+
+  double const vs = VisualParams::Instance().GetVisualScale();
+  int const dataZoomLevel = ClipTileZoomByMaxDataZoom(m_currentZoomLevel);
+  for (auto const & s : {targetScreen, middleScreen})
+  {
+    m2::RectD rect = s.ClipRect();
+    double const extension = vs * dp::kScreenPixelRectExtension * s.GetScale();
+    rect.Inflate(extension, extension);
+    CalcTilesCoverage(rect, dataZoomLevel, [this, &rect, &tiles, &prefetchTiles](int tileX, int tileY)
+    {
+      TileKey const key(tileX, tileY, m_currentZoomLevel);
+      if (rect.IsIntersect(key.GetGlobalRect()) && tiles.find(key) == tiles.end())
+        prefetchTiles.insert(key);
+    });
+  }
+  return prefetchTiles;
+}
+
 void FrontendRenderer::EmitModelViewChanged(ScreenBase const & modelView) const
 {
   m_modelViewChangedFn(modelView);
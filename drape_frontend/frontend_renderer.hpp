@@ -35,6 +35,7 @@
 #include "geometry/triangle2d.hpp"
 
 #include <array>
+#include <atomic>
 #include <functional>
 #include <unordered_set>
 #include <vector>
@@ -135,6 +136,11 @@ public:
 
   drape_ptr<ScenarioManager> const & GetScenarioManager() const;
 
+  // Scenarios wait for the scene to be completely rendered. The scene is ready if a frame
+  // started later than |frameIndex| has no not finished tiles, animations and overlays update.
+  uint64_t GetFrameIndex() const { return m_frameIndex; }
+  bool IsSceneReadyAfterFrame(uint64_t frameIndex) const { return m_lastReadyFrameIndex > frameIndex; }
+
 protected:
   void AcceptMessage(ref_ptr<Message> message) override;
   unique_ptr<threads::IRoutine> CreateRoutine() override;
@@ -185,6 +191,10 @@ private:
   void EmitModelViewChanged(ScreenBase const & modelView) const;
 
   TTilesCollection ResolveTileKeys(ScreenBase const & screen);
+  // Returns tiles which are not in |tiles| and are going to be visible when the current
+  // map animation (e.g. kinetic scroll or following of the position) is finished.
+  TTilesCollection ResolvePrefetchTileKeys(ScreenBase const & screen,
+                                           TTilesCollection const & tiles) const;
   void ResolveZoomLevel(ScreenBase const & screen);
   void UpdateDisplacementEnabled();
   void CheckIsometryMinScale(ScreenBase const & screen);
@@ -359,6 +369,7 @@ private:
     bool m_viewportChanged = true;
     uint32_t m_inactiveFramesCounter = 0;
     bool m_forceFullRedrawNextFrame = false;
+    double m_overlayPlacementTime = 0.0;
 #ifdef SHOW_FRAMES_STATS
     uint64_t m_framesOverall = 0;
     uint64_t m_framesFast = 0;
@@ -367,6 +378,9 @@ private:
   };
   FrameData m_frameData;
 
+  std::atomic<uint64_t> m_frameIndex{0};
+  std::atomic<uint64_t> m_lastReadyFrameIndex{0};
+
 #ifdef DEBUG
   bool m_isTeardowned;
 #endif
@@ -123,15 +123,41 @@ void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
   }
 
   if (wasChanged)
-  {
-    m_pointsSpline = m2::Spline(m_points.size());
-    for (size_t i = 0; i < m_points.size(); i++)
-      m_pointsSpline.AddPoint(m_points[i].m_point);
-  }
+    m_simplifiedTracks.clear();
 
   m_needUpdate = true;
 }
 
+GpsTrackRenderer::SimplifiedTrack const & GpsTrackRenderer::GetSimplifiedTrack(int zoomLevel,
+                                                                              double minDistance)
+{
+  auto it = m_simplifiedTracks.find(zoomLevel);
+  if (it != m_simplifiedTracks.end())
+    return it->second;
+
+  SimplifiedTrack & track = m_simplifiedTracks[zoomLevel];
+  track.m_spline = m2::Spline(m_points.size());
+  for (size_t i = 0; i < m_points.size(); i++)
+  {
+    GpsTrackPoint const & pt = m_points[i];
+    if (!track.m_indices.empty() && i + 1 < m_points.size())
+    {
+      // Ends of the segments with unknown distance are always kept to keep their color.
+      GpsTrackPoint const & last = m_points[track.m_indices.back()];
+      bool const isGap = pt.m_timestamp - m_points[i - 1].m_timestamp > kUnknownDistanceTime ||
+                         m_points[i + 1].m_timestamp - last.m_timestamp > kUnknownDistanceTime;
+      if (!isGap && (pt.m_point - last.m_point).Length() < minDistance)
+        continue;
+    }
+
+    size_t const size = track.m_spline.GetSize();
+    track.m_spline.AddPoint(pt.m_point);
+    if (track.m_spline.GetSize() != size)
+      track.m_indices.push_back(i);
+  }
+  return track;
+}
+
 size_t GpsTrackRenderer::GetAvailablePointsCount() const
 {
   size_t pointsCount = 0;
@@ -141,15 +167,16 @@ size_t GpsTrackRenderer::GetAvailablePointsCount() const
   return pointsCount;
 }
 
-dp::Color GpsTrackRenderer::CalculatePointColor(size_t pointIndex, m2::PointD const & curPoint,
-                                                double lengthFromStart, double fullLength) const
+dp::Color GpsTrackRenderer::CalculatePointColor(SimplifiedTrack const & track, size_t pointIndex,
+                                                m2::PointD const & curPoint, double lengthFromStart,
+                                                double fullLength) const
 {
-  ASSERT_LESS(pointIndex, m_points.size(), ());
-  if (pointIndex + 1 == m_points.size())
+  ASSERT_LESS(pointIndex, track.m_indices.size(), ());
+  if (pointIndex + 1 == track.m_indices.size())
     return dp::Color::Transparent();
 
-  GpsTrackPoint const & start = m_points[pointIndex];
-  GpsTrackPoint const & end = m_points[pointIndex + 1];
+  GpsTrackPoint const & start = m_points[track.m_indices[pointIndex]];
+  GpsTrackPoint const & end = m_points[track.m_indices[pointIndex + 1]];
 
   double startAlpha = kMinDayAlpha;
   double endAlpha = kMaxDayAlpha;
@@ -244,8 +271,12 @@ void GpsTrackRenderer::RenderTrack(ref_ptr<dp::GraphicsContext> context, ref_ptr
     }
     else
     {
+      // Circles are placed with the step, so closer points don't affect the track.
+      double const step = diameterMercator + kDistanceScalar * diameterMercator;
+      SimplifiedTrack const & track = GetSimplifiedTrack(zoomLevel, 0.25 * step);
+
       m2::Spline::iterator it;
-      it.Attach(m_pointsSpline);
+      it.Attach(track.m_spline);
       while (!it.BeginAgain())
       {
         m2::PointD const pt = it.m_pos;
@@ -253,7 +284,7 @@ void GpsTrackRenderer::RenderTrack(ref_ptr<dp::GraphicsContext> context, ref_ptr
                             pt.x + radiusMercator, pt.y + radiusMercator);
         if (screen.ClipRect().IsIntersect(pointRect))
         {
-          dp::Color const color = CalculatePointColor(it.GetIndex(), pt,
+          dp::Color const color = CalculatePointColor(track, it.GetIndex(), pt,
                                                       it.GetLength(), it.GetFullLength());
           m2::PointD const convertedPt = MapShape::ConvertToLocal(pt, m_pivot, kShapeCoordScalar);
           m_handlesCache[cacheIndex].first->SetPoint(m_handlesCache[cacheIndex].second,
@@ -269,7 +300,7 @@ void GpsTrackRenderer::RenderTrack(ref_ptr<dp::GraphicsContext> context, ref_ptr
             return;
           }
         }
-        it.Advance(diameterMercator + kDistanceScalar * diameterMercator);
+        it.Advance(step);
       }
 
 #ifdef GPS_TRACK_SHOW_RAW_POINTS
@@ -327,6 +358,7 @@ void GpsTrackRenderer::Update()
 void GpsTrackRenderer::Clear()
 {
   m_points.clear();
+  m_simplifiedTracks.clear();
   m_needUpdate = true;
 }
 }  // namespace df
@@ -38,15 +38,26 @@ public:
   void ClearRenderData();
 
 private:
+  // Track points downsampled for a zoom level: points which are closer to each other than
+  // circles on the zoom level are skipped.
+  struct SimplifiedTrack
+  {
+    m2::Spline m_spline;
+    // Indices of |m_points| which are in the spline.
+    std::vector<size_t> m_indices;
+  };
+
+  SimplifiedTrack const & GetSimplifiedTrack(int zoomLevel, double minDistance);
   size_t GetAvailablePointsCount() const;
-  dp::Color CalculatePointColor(size_t pointIndex, m2::PointD const & curPoint,
-                                double lengthFromStart, double fullLength) const;
+  dp::Color CalculatePointColor(SimplifiedTrack const & track, size_t pointIndex,
+                                m2::PointD const & curPoint, double lengthFromStart,
+                                double fullLength) const;
   dp::Color GetColorBySpeed(double speed) const;
 
   TRenderDataRequestFn m_dataRequestFn;
   std::vector<drape_ptr<CirclesPackRenderData>> m_renderData;
   std::vector<GpsTrackPoint> m_points;
-  m2::Spline m_pointsSpline;
+  std::map<int, SimplifiedTrack> m_simplifiedTracks;
   bool m_needUpdate;
   bool m_waitForRenderData;
   std::vector<std::pair<CirclesPackHandle *, size_t>> m_handlesCache;
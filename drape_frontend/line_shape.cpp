@@ -366,21 +366,21 @@ void LineShape::Construct<DashedLineBuilder>(DashedLineBuilder & builder) const
   vector<m2::PointD> const & path = m_spline->GetPath();
   ASSERT_GREATER(path.size(), 1, ());
 
+  SplineSegments segments;
+  segments.Build(path, m_params.m_tileCenter, kShapeCoordScalar);
+
   // build geometry
-  for (size_t i = 1; i < path.size(); ++i)
+  for (size_t i = 0; i < segments.GetCount(); ++i)
   {
-    if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
-      continue;
-
-    glsl::vec2 const p1 = glsl::ToVec2(ConvertToLocal(path[i - 1], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 const p2 = glsl::ToVec2(ConvertToLocal(path[i], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 tangent, leftNormal, rightNormal;
-    CalculateTangentAndNormals(p1, p2, tangent, leftNormal, rightNormal);
+    glsl::vec2 const p1 = segments.GetStartPoint(i);
+    glsl::vec2 const tangent = segments.GetTangent(i);
+    glsl::vec2 const leftNormal = segments.GetLeftNormal(i);
+    glsl::vec2 const rightNormal = segments.GetRightNormal(i);
 
     // calculate number of steps to cover line segment
-    float const initialGlobalLength = static_cast<float>((path[i] - path[i - 1]).Length());
+    float const initialGlobalLength = segments.GetGlobalLength(i);
     int const steps = std::max(1, builder.GetDashesCount(initialGlobalLength));
-    float const maskSize = glsl::length(p2 - p1) / steps;
+    float const maskSize = segments.GetLength(i) / steps;
     float const offsetSize = initialGlobalLength / steps;
 
     // generate vertices
@@ -414,19 +414,19 @@ void LineShape::Construct<SolidLineBuilder>(SolidLineBuilder & builder) const
   if (builder.GetHalfWidth() <= kJoinsGenerationThreshold)
     generateJoins = false;
 
+  SplineSegments segments;
+  segments.Build(path, m_params.m_tileCenter, kShapeCoordScalar);
+
   // build geometry
   glsl::vec2 firstPoint = glsl::ToVec2(ConvertToLocal(path.front(), m_params.m_tileCenter, kShapeCoordScalar));
   glsl::vec2 lastPoint;
   bool hasConstructedSegments = false;
-  for (size_t i = 1; i < path.size(); ++i)
+  for (size_t i = 0; i < segments.GetCount(); ++i)
   {
-    if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
-      continue;
-
-    glsl::vec2 const p1 = glsl::ToVec2(ConvertToLocal(path[i - 1], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 const p2 = glsl::ToVec2(ConvertToLocal(path[i], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 tangent, leftNormal, rightNormal;
-    CalculateTangentAndNormals(p1, p2, tangent, leftNormal, rightNormal);
+    glsl::vec2 const p1 = segments.GetStartPoint(i);
+    glsl::vec2 const p2 = segments.GetEndPoint(i);
+    glsl::vec2 const leftNormal = segments.GetLeftNormal(i);
+    glsl::vec2 const rightNormal = segments.GetRightNormal(i);
 
     glsl::vec3 const startPoint = glsl::vec3(p1, m_params.m_depth);
     glsl::vec3 const endPoint = glsl::vec3(p2, m_params.m_depth);
@@ -437,7 +437,7 @@ void LineShape::Construct<SolidLineBuilder>(SolidLineBuilder & builder) const
     builder.SubmitVertex(endPoint, leftNormal, true /* isLeft */);
 
     // generate joins
-    if (generateJoins && i < path.size() - 1)
+    if (generateJoins && segments.GetPathIndex(i) < path.size() - 1)
       builder.SubmitJoin(p2);
 
     lastPoint = p2;
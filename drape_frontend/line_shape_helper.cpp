@@ -4,6 +4,8 @@
 
 #include "base/assert.hpp"
 
+#include <cmath>
+
 namespace df
 {
 namespace
@@ -75,6 +77,53 @@ void UpdateNormalBetweenSegments(LineSegment * segment1, LineSegment * segment2)
 }
 }  // namespace
 
+void SplineSegments::Build(std::vector<m2::PointD> const & path, m2::PointD const & tileCenter,
+                           double scalar)
+{
+  ASSERT_GREATER(path.size(), 1, ());
+
+  m_stride = path.size() - 1;
+  if (m_data.size() < m_stride * ComponentsCount)
+    m_data.resize(m_stride * ComponentsCount);
+  m_pathIndices.clear();
+  m_count = 0;
+
+  float * startX = GetComponent(StartX);
+  float * startY = GetComponent(StartY);
+  float * endX = GetComponent(EndX);
+  float * endY = GetComponent(EndY);
+  float * globalLength = GetComponent(GlobalLength);
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
+      continue;
+
+    startX[m_count] = static_cast<float>((path[i - 1].x - tileCenter.x) * scalar);
+    startY[m_count] = static_cast<float>((path[i - 1].y - tileCenter.y) * scalar);
+    endX[m_count] = static_cast<float>((path[i].x - tileCenter.x) * scalar);
+    endY[m_count] = static_cast<float>((path[i].y - tileCenter.y) * scalar);
+    globalLength[m_count] = static_cast<float>((path[i] - path[i - 1]).Length());
+    m_pathIndices.push_back(static_cast<uint32_t>(i));
+    ++m_count;
+  }
+
+  float * tangentX = GetComponent(TangentX);
+  float * tangentY = GetComponent(TangentY);
+  float * length = GetComponent(Length);
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    float const dx = endX[i] - startX[i];
+    float const dy = endY[i] - startY[i];
+    length[i] = std::sqrt(dx * dx + dy * dy);
+  }
+
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    tangentX[i] = (endX[i] - startX[i]) / length[i];
+    tangentY[i] = (endY[i] - startY[i]) / length[i];
+  }
+}
+
 void CalculateTangentAndNormals(glsl::vec2 const & pt0, glsl::vec2 const & pt1,
                                 glsl::vec2 & tangent, glsl::vec2 & leftNormal,
                                 glsl::vec2 & rightNormal)
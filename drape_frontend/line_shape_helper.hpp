@@ -3,8 +3,13 @@
 #include "drape/drape_global.hpp"
 #include "drape/glsl_types.hpp"
 
+#include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include "base/assert.hpp"
+
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace df
@@ -49,6 +54,57 @@ struct LineSegment
   }
 };
 
+// Segments of a path in local coordinates of a tile. Degenerate segments are skipped.
+// Components of segments are kept in separate arrays, so tangents and lengths of all segments
+// are calculated by loops without branches, which the compiler vectorizes. Storage is reused
+// by the next Build, so one instance may serve many paths.
+class SplineSegments
+{
+public:
+  void Build(std::vector<m2::PointD> const & path, m2::PointD const & tileCenter, double scalar);
+
+  size_t GetCount() const { return m_count; }
+
+  glsl::vec2 GetStartPoint(size_t i) const { return {Get(StartX, i), Get(StartY, i)}; }
+  glsl::vec2 GetEndPoint(size_t i) const { return {Get(EndX, i), Get(EndY, i)}; }
+  glsl::vec2 GetTangent(size_t i) const { return {Get(TangentX, i), Get(TangentY, i)}; }
+  glsl::vec2 GetLeftNormal(size_t i) const { return {-Get(TangentY, i), Get(TangentX, i)}; }
+  glsl::vec2 GetRightNormal(size_t i) const { return {Get(TangentY, i), -Get(TangentX, i)}; }
+  // Length in local coordinates.
+  float GetLength(size_t i) const { return Get(Length, i); }
+  // Length in mercator.
+  float GetGlobalLength(size_t i) const { return Get(GlobalLength, i); }
+  // Index of the end point of the segment in the path.
+  size_t GetPathIndex(size_t i) const { return m_pathIndices[i]; }
+
+private:
+  enum Component
+  {
+    StartX,
+    StartY,
+    EndX,
+    EndY,
+    TangentX,
+    TangentY,
+    Length,
+    GlobalLength,
+    ComponentsCount
+  };
+
+  float Get(Component component, size_t i) const
+  {
+    ASSERT_LESS(i, m_count, ());
+    return m_data[component * m_stride + i];
+  }
+
+  float * GetComponent(Component component) { return m_data.data() + component * m_stride; }
+
+  std::vector<float> m_data;
+  std::vector<uint32_t> m_pathIndices;
+  size_t m_stride = 0;
+  size_t m_count = 0;
+};
+
 void CalculateTangentAndNormals(glsl::vec2 const & pt0, glsl::vec2 const & pt1,
                                 glsl::vec2 & tangent, glsl::vec2 & leftNormal,
                                 glsl::vec2 & rightNormal);
@@ -10,18 +10,21 @@ MapDataProvider::MapDataProvider(TReadIDsFn && idsReader,
                                  TReadFeaturesFn && featureReader,
                                  TFilterFeatureFn && filterFeatureFn,
                                  TIsCountryLoadedByNameFn && isCountryLoadedByNameFn,
-                                 TUpdateCurrentCountryFn && updateCurrentCountryFn)
+                                 TUpdateCurrentCountryFn && updateCurrentCountryFn,
+                                 TPrefetchDataFn && prefetchDataFn)
   : m_isCountryLoadedByName(std::move(isCountryLoadedByNameFn))
   , m_featureReader(std::move(featureReader))
   , m_idsReader(std::move(idsReader))
   , m_filterFeature(std::move(filterFeatureFn))
   , m_updateCurrentCountry(std::move(updateCurrentCountryFn))
+  , m_prefetchData(std::move(prefetchDataFn))
 {
   CHECK(m_isCountryLoadedByName != nullptr, ());
   CHECK(m_featureReader != nullptr, ());
   CHECK(m_idsReader != nullptr, ());
   CHECK(m_filterFeature != nullptr, ());
   CHECK(m_updateCurrentCountry != nullptr, ());
+  CHECK(m_prefetchData != nullptr, ());
 }
 
 void MapDataProvider::ReadFeaturesID(TReadCallback<FeatureID const> const & fn, m2::RectD const & r,
@@ -36,6 +39,11 @@ void MapDataProvider::ReadFeatures(TReadCallback<FeatureType> const & fn,
   m_featureReader(fn, ids);
 }
 
+void MapDataProvider::PrefetchData(m2::RectD const & r) const
+{
+  m_prefetchData(r);
+}
+
 MapDataProvider::TFilterFeatureFn const & MapDataProvider::GetFilter() const
 {
   return m_filterFeature;
@@ -23,16 +23,20 @@ public:
   using TIsCountryLoadedByNameFn = std::function<bool(string const &)>;
   using TUpdateCurrentCountryFn = std::function<void(m2::PointD const &, int)>;
   using TFilterFeatureFn = std::function<bool(FeatureType &)>;
+  using TPrefetchDataFn = std::function<void(m2::RectD const &)>;
 
   MapDataProvider(TReadIDsFn && idsReader,
                   TReadFeaturesFn && featureReader,
                   TFilterFeatureFn && filterFeatureFn,
                   TIsCountryLoadedByNameFn && isCountryLoadedByNameFn,
-                  TUpdateCurrentCountryFn && updateCurrentCountryFn);
+                  TUpdateCurrentCountryFn && updateCurrentCountryFn,
+                  TPrefetchDataFn && prefetchDataFn);
 
   void ReadFeaturesID(TReadCallback<FeatureID const> const & fn, m2::RectD const & r,
                       int scale) const;
   void ReadFeatures(TReadCallback<FeatureType> const & fn, std::vector<FeatureID> const & ids) const;
+  // Starts reading the data of |r| from disk in background, returns immediately.
+  void PrefetchData(m2::RectD const & r) const;
 
   TFilterFeatureFn const & GetFilter() const;
 
@@ -45,5 +49,6 @@ private:
   TReadIDsFn m_idsReader;
   TFilterFeatureFn m_filterFeature;
   TUpdateCurrentCountryFn m_updateCurrentCountry;
+  TPrefetchDataFn m_prefetchData;
 };
 }  // namespace df
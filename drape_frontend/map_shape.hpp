@@ -8,6 +8,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <memory>
 #include <vector>
 
 namespace dp
@@ -47,7 +48,8 @@ private:
   int m_minZoom = 0;
 };
 
-using TMapShapes = std::vector<drape_ptr<MapShape>>;
+// Shapes are shared, so the shapes of a tile may be kept in TileShapesCache after batching.
+using TMapShapes = std::vector<std::shared_ptr<MapShape>>;
 
 class MapShapeMessage : public Message
 {
@@ -20,7 +20,6 @@ std::string DebugPrint(Message::Type msgType)
   case Message::Type::UpdateReadManager: return "UpdateReadManager";
   case Message::Type::InvalidateRect: return "InvalidateRect";
   case Message::Type::InvalidateReadManagerRect: return "InvalidateReadManagerRect";
-  case Message::Type::UpdateUserMarkGroup: return "UpdateUserMarkGroup";
   case Message::Type::ClearUserMarkGroup: return "ClearUserMarkGroup";
   case Message::Type::ChangeUserMarkGroupVisibility: return "ChangeUserMarkGroupVisibility";
   case Message::Type::UpdateUserMarks: return "UpdateUserMarks";
@@ -37,6 +36,7 @@ std::string DebugPrint(Message::Type msgType)
   case Message::Type::SelectObject: return "SelectObject";
   case Message::Type::AddSubroute: return "AddSubroute";
   case Message::Type::RemoveSubroute: return "RemoveSubroute";
+  case Message::Type::UpdateSubroute: return "UpdateSubroute";
   case Message::Type::CacheSubrouteArrows: return "CacheSubrouteArrows";
   case Message::Type::FlushSubroute: return "FlushSubroute";
   case Message::Type::FlushSubrouteArrows: return "FlushSubrouteArrows";
@@ -72,6 +72,8 @@ std::string DebugPrint(Message::Type msgType)
   case Message::Type::UpdateTraffic: return "UpdateTraffic";
   case Message::Type::FlushTrafficData: return "FlushTrafficData";
   case Message::Type::ClearTrafficData: return "ClearTrafficData";
+  case Message::Type::ClearTrafficTileData: return "ClearTrafficTileData";
+  case Message::Type::RecolorTraffic: return "RecolorTraffic";
   case Message::Type::SetSimplifiedTrafficColors: return "SetSimplifiedTrafficColors";
   case Message::Type::DrapeApiAddLines: return "DrapeApiAddLines";
   case Message::Type::DrapeApiRemove: return "DrapeApiRemove";
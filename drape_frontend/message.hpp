@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 namespace df
@@ -21,7 +22,6 @@ public:
     UpdateReadManager,
     InvalidateRect,
     InvalidateReadManagerRect,
-    UpdateUserMarkGroup,
     ClearUserMarkGroup,
     ChangeUserMarkGroupVisibility,
     UpdateUserMarks,
@@ -38,6 +38,7 @@ public:
     SelectObject,
     AddSubroute,
     RemoveSubroute,
+    UpdateSubroute,
     CacheSubrouteArrows,
     FlushSubroute,
     FlushSubrouteArrows,
@@ -73,6 +74,8 @@ public:
     UpdateTraffic,
     FlushTrafficData,
     ClearTrafficData,
+    ClearTrafficTileData,
+    RecolorTraffic,
     SetSimplifiedTrafficColors,
     DrapeApiAddLines,
     DrapeApiRemove,
@@ -101,6 +104,14 @@ public:
   virtual ~Message() = default;
   virtual Type GetType() const { return Type::Unknown; }
   virtual bool IsGraphicsContextDependent() const { return false; }
+
+  // The time is set by MessageQueue only while tracing is enabled.
+  using Clock = std::chrono::steady_clock;
+  void SetPostTime(Clock::time_point const & postTime) { m_postTime = postTime; }
+  Clock::time_point const & GetPostTime() const { return m_postTime; }
+
+private:
+  Clock::time_point m_postTime;
 };
 
 enum class MessagePriority
@@ -1,5 +1,6 @@
 #include "drape_frontend/message_acceptor.hpp"
 
+#include "drape_frontend/drape_measurer.hpp"
 #include "drape_frontend/message.hpp"
 
 namespace df
@@ -17,7 +18,19 @@ bool MessageAcceptor::ProcessSingleMessage(bool waitForMessage)
   if (message == nullptr)
     return false;
 
+  if (!DrapeMeasurer::Instance().IsTracingEnabled())
+  {
+    AcceptMessage(make_ref(message));
+    return true;
+  }
+
+  // Durations of messages processing are traced by message types on both renderers,
+  // e.g. the backend ones show tasks of shapes recaching and flushing.
+  auto const type = message->GetType();
+  auto const startTime = DrapeMeasurer::TraceClock::now();
   AcceptMessage(make_ref(message));
+  DrapeMeasurer::Instance().AddTraceEvent(DebugPrint(type), "message", startTime,
+                                          DrapeMeasurer::TraceClock::now());
   return true;
 }
 
@@ -1,5 +1,7 @@
 #include "drape_frontend/message_queue.hpp"
 
+#include "drape_frontend/drape_measurer.hpp"
+
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
@@ -28,20 +30,32 @@ drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
   if (m_messages.empty() && m_lowPriorityMessages.empty())
     return nullptr;
 
+  drape_ptr<Message> msg;
   if (!m_messages.empty())
   {
-    drape_ptr<Message> msg = std::move(m_messages.front().first);
+    msg = std::move(m_messages.front().first);
     m_messages.pop_front();
-    return msg;
+  }
+  else
+  {
+    msg = std::move(m_lowPriorityMessages.front());
+    m_lowPriorityMessages.pop_front();
   }
 
-  drape_ptr<Message> msg = std::move(m_lowPriorityMessages.front());
-  m_lowPriorityMessages.pop_front();
+  // Messages which are posted before tracing is started have no post time.
+  if (msg->GetPostTime() != Message::Clock::time_point())
+  {
+    DrapeMeasurer::Instance().AddTraceEvent(DebugPrint(msg->GetType()), "message_queue_latency",
+                                            msg->GetPostTime(), Message::Clock::now());
+  }
   return msg;
 }
 
 void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority priority)
 {
+  if (DrapeMeasurer::Instance().IsTracingEnabled())
+    message->SetPostTime(Message::Clock::now());
+
   std::lock_guard<std::mutex> lock(m_mutex);
 
   if (m_filter != nullptr && m_filter(make_ref(message)))
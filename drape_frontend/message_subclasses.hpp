@@ -104,41 +104,51 @@ public:
 class FinishTileReadMessage : public Message
 {
 public:
-  template<typename T> FinishTileReadMessage(T && tiles, bool forceUpdateUserMarks)
+  // |changedUserMarksOnly| means that user marks of the tiles were generated before, so only
+  // the changed ones must be generated again. The others are listed in |unchangedUserMarksTiles|
+  // when the message is sent to the render thread.
+  template<typename T> FinishTileReadMessage(T && tiles, bool forceUpdateUserMarks,
+                                             bool changedUserMarksOnly = false,
+                                             TTilesCollection && unchangedUserMarksTiles = {})
     : m_tiles(std::forward<T>(tiles))
+    , m_unchangedUserMarksTiles(std::move(unchangedUserMarksTiles))
     , m_forceUpdateUserMarks(forceUpdateUserMarks)
+    , m_changedUserMarksOnly(changedUserMarksOnly)
   {}
 
   Type GetType() const override { return Type::FinishTileRead; }
 
   TTilesCollection const & GetTiles() const { return m_tiles; }
   TTilesCollection && MoveTiles() { return std::move(m_tiles); }
+  TTilesCollection const & GetUnchangedUserMarksTiles() const { return m_unchangedUserMarksTiles; }
   bool NeedForceUpdateUserMarks() const { return m_forceUpdateUserMarks; }
+  bool IsChangedUserMarksOnly() const { return m_changedUserMarksOnly; }
 
 private:
   TTilesCollection m_tiles;
+  TTilesCollection m_unchangedUserMarksTiles;
   bool m_forceUpdateUserMarks;
+  bool m_changedUserMarksOnly;
 };
 
+// Buckets of a tile which are flushed by its batcher at once are sent by one message.
 class FlushRenderBucketMessage : public BaseTileMessage
 {
 public:
-  FlushRenderBucketMessage(TileKey const & key, dp::RenderState const & state,
-                           drape_ptr<dp::RenderBucket> && buffer)
+  using Buckets = std::vector<std::pair<dp::RenderState, drape_ptr<dp::RenderBucket>>>;
+
+  FlushRenderBucketMessage(TileKey const & key, Buckets && buckets)
     : BaseTileMessage(key)
-    , m_state(state)
-    , m_buffer(std::move(buffer))
+    , m_buckets(std::move(buckets))
   {}
 
   Type GetType() const override { return Type::FlushTile; }
   bool IsGraphicsContextDependent() const override { return true; }
 
-  dp::RenderState const & GetState() const { return m_state; }
-  drape_ptr<dp::RenderBucket> && AcceptBuffer() { return std::move(m_buffer); }
+  Buckets && AcceptBuckets() { return std::move(m_buckets); }
 
 private:
-  dp::RenderState m_state;
-  drape_ptr<dp::RenderBucket> m_buffer;
+  Buckets m_buckets;
 };
 
 template <typename RenderDataType, Message::Type MessageType>
@@ -241,11 +251,13 @@ public:
   UpdateUserMarksMessage(drape_ptr<IDCollections> && createdIds,
                          drape_ptr<IDCollections> && removedIds,
                          drape_ptr<UserMarksRenderCollection> && marksRenderParams,
-                         drape_ptr<UserLinesRenderCollection> && linesRenderParams)
+                         drape_ptr<UserLinesRenderCollection> && linesRenderParams,
+                         drape_ptr<MarksIDGroups> && groups)
     : m_createdIds(std::move(createdIds))
     , m_removedIds(std::move(removedIds))
     , m_marksRenderParams(std::move(marksRenderParams))
     , m_linesRenderParams(std::move(linesRenderParams))
+    , m_groups(std::move(groups))
   {}
 
   Type GetType() const override { return Type::UpdateUserMarks; }
@@ -254,31 +266,15 @@ public:
   drape_ptr<UserLinesRenderCollection> AcceptLineRenderParams() { return std::move(m_linesRenderParams); }
   drape_ptr<IDCollections> AcceptRemovedIds() { return std::move(m_removedIds); }
   drape_ptr<IDCollections> AcceptCreatedIds() { return std::move(m_createdIds); }
+  drape_ptr<MarksIDGroups> AcceptGroups() { return std::move(m_groups); }
 
 private:
   drape_ptr<IDCollections> m_createdIds;
   drape_ptr<IDCollections> m_removedIds;
   drape_ptr<UserMarksRenderCollection> m_marksRenderParams;
   drape_ptr<UserLinesRenderCollection> m_linesRenderParams;
-};
-
-class UpdateUserMarkGroupMessage : public Message
-{
-public:
-  UpdateUserMarkGroupMessage(kml::MarkGroupId groupId,
-                             drape_ptr<IDCollections> && ids)
-    : m_groupId(groupId)
-    , m_ids(std::move(ids))
-  {}
-
-  Type GetType() const override { return Type::UpdateUserMarkGroup; }
-
-  kml::MarkGroupId GetGroupId() const { return m_groupId; }
-  drape_ptr<IDCollections> AcceptIds() { return std::move(m_ids); }
-
-private:
-  kml::MarkGroupId m_groupId;
-  drape_ptr<IDCollections> m_ids;
+  // Mark ids of the changed groups.
+  drape_ptr<MarksIDGroups> m_groups;
 };
 
 using FlushUserMarksMessage = FlushRenderDataMessage<TUserMarksRenderData,
@@ -601,6 +597,25 @@ private:
   bool m_deactivateFollowing;
 };
 
+// Replaces the subroute of already cached render data, the subroutes must have equal geometry.
+class UpdateSubrouteMessage : public Message
+{
+public:
+  UpdateSubrouteMessage(dp::DrapeID subrouteId, SubrouteConstPtr subroute)
+    : m_subrouteId(subrouteId)
+    , m_subroute(subroute)
+  {}
+
+  Type GetType() const override { return Type::UpdateSubroute; }
+
+  dp::DrapeID GetSubrouteId() const { return m_subrouteId; }
+  SubrouteConstPtr GetSubroute() const { return m_subroute; }
+
+private:
+  dp::DrapeID m_subrouteId;
+  SubrouteConstPtr m_subroute;
+};
+
 using FlushSubrouteMessage = FlushRenderDataMessage<drape_ptr<SubrouteData>,
                                                     Message::Type::FlushSubroute>;
 using FlushSubrouteArrowsMessage = FlushRenderDataMessage<drape_ptr<SubrouteArrowsData>,
@@ -988,6 +1003,39 @@ private:
   MwmSet::MwmId m_mwmId;
 };
 
+class ClearTrafficTileDataMessage : public Message
+{
+public:
+  ClearTrafficTileDataMessage(MwmSet::MwmId const & mwmId, TileKey const & tileKey)
+    : m_mwmId(mwmId)
+    , m_tileKey(tileKey)
+  {}
+
+  Type GetType() const override { return Type::ClearTrafficTileData; }
+
+  MwmSet::MwmId const & GetMwmId() const { return m_mwmId; }
+  TileKey const & GetTileKey() const { return m_tileKey; }
+
+private:
+  MwmSet::MwmId m_mwmId;
+  TileKey m_tileKey;
+};
+
+class RecolorTrafficMessage : public Message
+{
+public:
+  explicit RecolorTrafficMessage(TrafficSegmentsColors && colors)
+    : m_colors(std::move(colors))
+  {}
+
+  Type GetType() const override { return Type::RecolorTraffic; }
+
+  TrafficSegmentsColors const & GetColors() const { return m_colors; }
+
+private:
+  TrafficSegmentsColors m_colors;
+};
+
 class SetSimplifiedTrafficColorsMessage : public Message
 {
 public:
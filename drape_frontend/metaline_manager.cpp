@@ -29,11 +29,28 @@ void MetalineManager::Stop()
 void MetalineManager::Update(std::set<MwmSet::MwmId> const & mwms)
 {
   std::lock_guard<std::mutex> lock(m_mwmsMutex);
+
+  // Drop metalines of deregistered mwms, the updated ones get new ids.
+  for (auto it = m_mwms.begin(); it != m_mwms.end();)
+  {
+    if (it->IsAlive())
+    {
+      ++it;
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> cacheLock(m_metalineCacheMutex);
+      m_metalineCache.erase(*it);
+    }
+    it = m_mwms.erase(it);
+  }
+
   for (auto const & mwm : mwms)
   {
     auto const result = m_mwms.insert(mwm);
     if (!result.second)
-      return;
+      continue;
 
     auto readingTask = std::make_shared<ReadMetalineTask>(m_model, mwm);
     auto routineResult = dp::DrapeRoutine::Run([this, readingTask]()
@@ -50,8 +67,12 @@ void MetalineManager::Update(std::set<MwmSet::MwmId> const & mwms)
 m2::SharedSpline MetalineManager::GetMetaline(FeatureID const & fid) const
 {
   std::lock_guard<std::mutex> lock(m_metalineCacheMutex);
-  auto const metalineIt = m_metalineCache.find(fid);
-  if (metalineIt == m_metalineCache.end())
+  auto const mwmIt = m_metalineCache.find(fid.m_mwmId);
+  if (mwmIt == m_metalineCache.end())
+    return m2::SharedSpline();
+
+  auto const metalineIt = mwmIt->second.find(fid);
+  if (metalineIt == mwmIt->second.end())
     return m2::SharedSpline();
   return metalineIt->second;
 }
@@ -61,16 +82,15 @@ void MetalineManager::OnTaskFinished(std::shared_ptr<ReadMetalineTask> const & t
   if (task->IsCancelled())
     return;
 
-  std::lock_guard<std::mutex> lock(m_metalineCacheMutex);
-
-  // Update metalines cache.
-  auto const & metalines = task->GetMetalines();
-  for (auto const & metaline : metalines)
-    m_metalineCache[metaline.first] = metaline.second;
-
-  // Notify FR.
-  if (!metalines.empty())
+  if (!task->GetMetalines().empty())
   {
+    // Update metalines cache.
+    {
+      std::lock_guard<std::mutex> lock(m_metalineCacheMutex);
+      m_metalineCache[task->GetMwmId()] = task->ExtractMetalines();
+    }
+
+    // Notify FR.
     LOG(LDEBUG, ("Metalines prepared:", task->GetMwmId()));
     m_commutator->PostMessage(ThreadsCommutator::RenderThread,
                               make_unique_dp<UpdateMetalinesMessage>(),
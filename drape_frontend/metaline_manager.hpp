@@ -7,6 +7,7 @@
 
 #include "indexer/feature_decl.hpp"
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -36,7 +37,9 @@ private:
 
   dp::ActiveTasks<ReadMetalineTask> m_activeTasks;
 
-  MetalineCache m_metalineCache;
+  // Metalines are kept per mwm, so a finished task puts its whole cache at once
+  // and readers of other mwms are not blocked by merging of the caches.
+  std::map<MwmSet::MwmId, MetalineCache> m_metalineCache;
   mutable std::mutex m_metalineCacheMutex;
 
   std::set<MwmSet::MwmId> m_mwms;
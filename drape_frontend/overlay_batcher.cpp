@@ -23,7 +23,7 @@ OverlayBatcher::OverlayBatcher(TileKey const & key)
   });
 }
 
-void OverlayBatcher::Batch(ref_ptr<dp::GraphicsContext> context, drape_ptr<MapShape> const & shape,
+void OverlayBatcher::Batch(ref_ptr<dp::GraphicsContext> context, std::shared_ptr<MapShape> const & shape,
                            ref_ptr<dp::TextureManager> texMng)
 {
   m_batcher.SetFeatureMinZoom(shape->GetFeatureMinZoom());
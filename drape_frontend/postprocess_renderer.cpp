@@ -12,10 +12,22 @@
 
 #include "base/assert.hpp"
 
+#include <algorithm>
+
 namespace df
 {
 namespace
 {
+// Frames are expected to be rendered at 60 fps during the camera movement.
+double constexpr kTargetFrameTime = 1.0 / 60.0;
+double constexpr kSlowFrameTime = 1.3 * kTargetFrameTime;
+double constexpr kFastFrameTime = 1.1 * kTargetFrameTime;
+// The resolution is lowered quickly and restored slowly to avoid oscillations.
+uint32_t constexpr kSlowFramesToLowerResolution = 3;
+uint32_t constexpr kFastFramesToRaiseResolution = 60;
+double constexpr kResolutionScaleStep = 0.1;
+double constexpr kMinResolutionScale = 0.5;
+
 class SMAABaseRenderParams
 {
 public:
@@ -167,6 +179,7 @@ void PostprocessRenderer::ClearContextDependentResources()
   m_blendingWeightFramebuffer.reset();
   m_smaaFramebuffer.reset();
   m_isSmaaFramebufferRendered = false;
+  m_renderedResolutionScale = 1.0;
 }
 
 void PostprocessRenderer::Resize(ref_ptr<dp::GraphicsContext> context, uint32_t width, uint32_t height)
@@ -239,6 +252,72 @@ bool PostprocessRenderer::CanRenderAntialiasing() const
   return true;
 }
 
+bool PostprocessRenderer::IsDynamicResolutionSupported() const
+{
+  // Texture coordinates of the scaled scene are computed for OpenGL render targets.
+  return m_apiVersion == dp::ApiVersion::OpenGLES2 || m_apiVersion == dp::ApiVersion::OpenGLES3;
+}
+
+void PostprocessRenderer::UpdateFrameQuality(bool isCameraMoving, double frameTime)
+{
+  m_isCameraMoving = isCameraMoving;
+  if (!isCameraMoving || !IsDynamicResolutionSupported())
+  {
+    m_slowFramesCount = 0;
+    m_fastFramesCount = 0;
+    return;
+  }
+
+  if (frameTime > kSlowFrameTime)
+  {
+    m_fastFramesCount = 0;
+    if (++m_slowFramesCount >= kSlowFramesToLowerResolution)
+    {
+      m_resolutionScale = std::max(kMinResolutionScale, m_resolutionScale - kResolutionScaleStep);
+      m_slowFramesCount = 0;
+    }
+  }
+  else if (frameTime < kFastFrameTime)
+  {
+    m_slowFramesCount = 0;
+    if (++m_fastFramesCount >= kFastFramesToRaiseResolution)
+    {
+      m_resolutionScale = std::min(1.0, m_resolutionScale + kResolutionScaleStep);
+      m_fastFramesCount = 0;
+    }
+  }
+}
+
+double PostprocessRenderer::GetFrameResolutionScale() const
+{
+  if (m_isCameraMoving && IsDynamicResolutionSupported())
+    return m_resolutionScale;
+  return 1.0;
+}
+
+m2::PointU PostprocessRenderer::GetSceneSize() const
+{
+  if (m_renderedResolutionScale >= 1.0)
+    return m2::PointU(m_width, m_height);
+  return m2::PointU(std::max(1u, static_cast<uint32_t>(m_width * m_renderedResolutionScale)),
+                    std::max(1u, static_cast<uint32_t>(m_height * m_renderedResolutionScale)));
+}
+
+dp::Viewport PostprocessRenderer::GetSceneViewport(dp::Viewport const & viewport) const
+{
+  if (!IsEnabled() || m_renderedResolutionScale >= 1.0)
+    return viewport;
+
+  auto const size = GetSceneSize();
+  return dp::Viewport(viewport.GetX0(), viewport.GetY0(), size.x, size.y);
+}
+
+void PostprocessRenderer::SetScreenQuadTextureRect(m2::RectF const & rect)
+{
+  if (!(m_screenQuadRenderer->GetTextureRect() == rect))
+    m_screenQuadRenderer->SetTextureRect(rect);
+}
+
 bool PostprocessRenderer::BeginFrame(ref_ptr<dp::GraphicsContext> context, bool activeFrame)
 {
   if (!IsEnabled())
@@ -247,9 +326,17 @@ bool PostprocessRenderer::BeginFrame(ref_ptr<dp::GraphicsContext> context, bool
     return m_framebufferFallback();
   }
 
-  m_frameStarted = activeFrame || !m_isMainFramebufferRendered;
+  // The scene is rendered again if its resolution must be changed, e.g. full resolution
+  // is restored when the camera stops.
+  auto const resolutionScale = GetFrameResolutionScale();
+  m_frameStarted = activeFrame || !m_isMainFramebufferRendered ||
+                   resolutionScale != m_renderedResolutionScale;
   if (m_frameStarted)
+  {
     context->SetFramebuffer(make_ref(m_mainFramebuffer));
+    m_renderedResolutionScale = resolutionScale;
+    m_isSmaaFramebufferRendered = false;
+  }
 
   if (m_frameStarted && CanRenderAntialiasing())
     context->SetStencilTestEnabled(false);
@@ -265,9 +352,15 @@ bool PostprocessRenderer::EndFrame(ref_ptr<dp::GraphicsContext> context,
   if (!IsEnabled())
     return true;
 
-  // Subpixel Morphological Antialiasing (SMAA).
-  if (m_frameStarted && CanRenderAntialiasing())
+  // Subpixel Morphological Antialiasing (SMAA). Aliasing is hardly noticeable during the camera
+  // movement, so SMAA is skipped then. When the camera stops, the last frame is antialiased
+  // without rendering of the scene, the stencil buffer is kept since the scene was rendered.
+  if (!m_isSmaaFramebufferRendered && !m_isCameraMoving && CanRenderAntialiasing())
   {
+    // The full resolution is restored before the camera stops.
+    ASSERT_GREATER_OR_EQUAL(m_renderedResolutionScale, 1.0, ());
+    SetScreenQuadTextureRect(m2::RectF(0.0f, 0.0f, 1.0f, 1.0f));
+
     ASSERT(m_staticTextures->m_smaaAreaTexture != nullptr, ());
     ASSERT(m_staticTextures->m_smaaSearchTexture != nullptr, ());
 
@@ -345,10 +438,19 @@ bool PostprocessRenderer::EndFrame(ref_ptr<dp::GraphicsContext> context,
   }
 
   ref_ptr<dp::Framebuffer> finalFramebuffer;
+  m2::RectF textureRect(0.0f, 0.0f, 1.0f, 1.0f);
   if (m_isSmaaFramebufferRendered)
+  {
     finalFramebuffer = make_ref(m_smaaFramebuffer);
+  }
   else
+  {
     finalFramebuffer = make_ref(m_mainFramebuffer);
+    // The scaled scene occupies the bottom left part of the main framebuffer.
+    auto const sceneSize = GetSceneSize();
+    textureRect.setMaxX(static_cast<float>(sceneSize.x) / m_width);
+    textureRect.setMaxY(static_cast<float>(sceneSize.y) / m_height);
+  }
 
   CHECK(m_framebufferFallback != nullptr, ());
   bool m_wasRendered = false;
@@ -358,6 +460,7 @@ bool PostprocessRenderer::EndFrame(ref_ptr<dp::GraphicsContext> context,
     context->ApplyFramebuffer("Dynamic frame");
     viewport.Apply(context);
     
+    SetScreenQuadTextureRect(textureRect);
     DefaultScreenQuadRenderParams params;
     params.SetParams(finalFramebuffer->GetTexture());
 
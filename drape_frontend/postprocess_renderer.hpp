@@ -8,6 +8,9 @@
 #include "drape/render_state.hpp"
 #include "drape/viewport.hpp"
 
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
 #include <cstdint>
 
 namespace dp
@@ -54,6 +57,14 @@ public:
   bool OnFramebufferFallback(ref_ptr<dp::GraphicsContext> context);
   void OnChangedRouteFollowingMode(ref_ptr<dp::GraphicsContext> context, bool isRouteFollowingActive);
 
+  // Adapts quality of frames to the camera movement. During the movement SMAA is skipped and,
+  // if frames take longer than the vsync interval, the scene is rendered in lower resolution.
+  // The frame is rendered in full quality when the camera stops.
+  // |frameTime| is duration of the previous frame in seconds.
+  void UpdateFrameQuality(bool isCameraMoving, double frameTime);
+  // Returns the viewport in which the scene of the started frame must be rendered.
+  dp::Viewport GetSceneViewport(dp::Viewport const & viewport) const;
+
   bool BeginFrame(ref_ptr<dp::GraphicsContext> context, bool activeFrame);
   bool EndFrame(ref_ptr<dp::GraphicsContext> context, ref_ptr<gpu::ProgramManager> gpuProgramManager,
                 dp::Viewport const & viewport);
@@ -64,6 +75,10 @@ public:
 private:
   void UpdateFramebuffers(ref_ptr<dp::GraphicsContext> context, uint32_t width, uint32_t height);
   bool CanRenderAntialiasing() const;
+  bool IsDynamicResolutionSupported() const;
+  double GetFrameResolutionScale() const;
+  m2::PointU GetSceneSize() const;
+  void SetScreenQuadTextureRect(m2::RectF const & rect);
 
   dp::ApiVersion m_apiVersion;
   uint32_t m_effects = 0;
@@ -83,6 +98,14 @@ private:
 
   bool m_frameStarted = false;
   bool m_isRouteFollowingActive = false;
+
+  bool m_isCameraMoving = false;
+  // Resolution scale of the scene during the camera movement.
+  double m_resolutionScale = 1.0;
+  // Resolution scale of the scene in the main framebuffer.
+  double m_renderedResolutionScale = 1.0;
+  uint32_t m_slowFramesCount = 0;
+  uint32_t m_fastFramesCount = 0;
 };
 
 class StencilWriterGuard
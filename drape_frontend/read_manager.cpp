@@ -1,4 +1,5 @@
 #include "drape_frontend/read_manager.hpp"
+#include "drape_frontend/map_data_provider.hpp"
 #include "drape_frontend/message_subclasses.hpp"
 #include "drape_frontend/metaline_manager.hpp"
 #include "drape_frontend/visual_params.hpp"
@@ -9,7 +10,10 @@
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
+#include <list>
+#include <vector>
 
 namespace df
 {
@@ -59,6 +63,8 @@ ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider
   , m_userMarksGenerationCounter(0)
   , m_isUGCFn(std::move(isUGCFn))
 {
+  if (kTileShapesCacheSize != 0)
+    m_tileShapesCache = make_unique_dp<TileShapesCache>(kTileShapesCacheSize);
   Start();
 }
 
@@ -91,7 +97,15 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
   ASSERT(dynamic_cast<ReadMWMTask *>(task) != NULL, ());
   auto t = static_cast<ReadMWMTask *>(task);
 
-  // finish tiles
+  // Prefetched tiles are not counted and not sent to the renderer.
+  if (t->IsPrefetched())
+  {
+    std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
+    auto const it = m_prefetchedTiles.find(t->GetTileKey());
+    if (it != m_prefetchedTiles.end() && it->second == t->GetTileInfo())
+      m_prefetchedTiles.erase(it);
+  }
+  else
   {
     std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
 
@@ -128,6 +142,18 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
   m_tasksPool.Return(t);
 }
 
+template <typename Tiles>
+void ReadManager::PrefetchTilesData(Tiles const & tiles)
+{
+  if (tiles.empty())
+    return;
+
+  m2::RectD rect;
+  for (auto const & tileKey : tiles)
+    rect.Add(tileKey.GetGlobalRect());
+  m_model.PrefetchData(rect);
+}
+
 void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings,
                                  bool forceUpdate, bool forceUpdateUserMarks,
                                  TTilesCollection const & tiles,
@@ -139,6 +165,10 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
 
   if (m_modeChanged || forceUpdate || MustDropAllTiles(screen))
   {
+    // Shapes of revisited tiles are still valid when only the viewport is changed.
+    if (m_modeChanged || forceUpdate)
+      ClearTileShapesCache();
+
     m_modeChanged = false;
 
     for (auto const & info : m_tileInfos)
@@ -149,6 +179,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     ++m_generationCounter;
     ++m_userMarksGenerationCounter;
 
+    PrefetchTilesData(tiles);
     for (auto const & tileKey : tiles)
       PushTaskBackForTileKey(tileKey, texMng, metalineMng);
   }
@@ -179,15 +210,87 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     if (forceUpdateUserMarks)
       ++m_userMarksGenerationCounter;
     CheckFinishedTiles(readyTiles, forceUpdateUserMarks);
+    PrefetchTilesData(newTiles);
     for (auto const & tileKey : newTiles)
       PushTaskBackForTileKey(tileKey, texMng, metalineMng);
   }
 
+  PrioritizeTasks(screen);
   m_currentViewport = screen;
 }
 
+void ReadManager::Prefetch(TTilesCollection const & tiles, ref_ptr<dp::TextureManager> texMng,
+                           ref_ptr<MetalineManager> metalineMng)
+{
+  if (!m_tileShapesCache || m_pool == nullptr)
+    return;
+
+  std::vector<std::shared_ptr<TileInfo>> newTiles;
+  {
+    std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
+    for (auto it = m_prefetchedTiles.begin(); it != m_prefetchedTiles.end();)
+    {
+      if (tiles.find(it->first) == tiles.end())
+      {
+        it->second->Cancel();
+        it = m_prefetchedTiles.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    for (auto const & tileKey : tiles)
+    {
+      if (m_prefetchedTiles.size() >= kMaxPrefetchedTilesCount)
+        break;
+
+      if (m_prefetchedTiles.find(tileKey) != m_prefetchedTiles.end() ||
+          std::binary_search(m_tileInfos.begin(), m_tileInfos.end(), tileKey, LessCoverageCell()) ||
+          m_tileShapesCache->Contains(tileKey))
+      {
+        continue;
+      }
+
+      auto context = make_unique_dp<EngineContext>(TileKey(tileKey, m_generationCounter, m_userMarksGenerationCounter),
+                                                   m_commutator, texMng, metalineMng,
+                                                   m_customFeaturesContext,
+                                                   m_have3dBuildings && m_allow3dBuildings,
+                                                   m_trafficEnabled, m_displacementMode,
+                                                   m_ugcRenderingEnabled ? m_isUGCFn : nullptr);
+      auto tileInfo = TileInfo::CreatePrefetched(std::move(context), make_ref(m_tileShapesCache));
+      m_prefetchedTiles.emplace(tileKey, tileInfo);
+      newTiles.push_back(std::move(tileInfo));
+    }
+  }
+
+  for (auto const & tileInfo : newTiles)
+  {
+    ReadMWMTask * task = m_tasksPool.Get();
+    task->Init(tileInfo);
+    m_pool->PushBack(task);
+  }
+}
+
+void ReadManager::CancelPrefetching()
+{
+  std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
+  for (auto const & tile : m_prefetchedTiles)
+    tile.second->Cancel();
+  m_prefetchedTiles.clear();
+}
+
 void ReadManager::Invalidate(TTilesCollection const & keyStorage)
 {
+  if (m_tileShapesCache)
+  {
+    m2::RectD rect;
+    for (auto const & tileKey : keyStorage)
+      rect.Add(tileKey.GetGlobalRect(false /* clipByDataMaxZoom */));
+    m_tileShapesCache->Erase(rect);
+  }
+
   TTileSet tilesToErase;
   for (auto const & info : m_tileInfos)
   {
@@ -204,6 +307,9 @@ void ReadManager::Invalidate(TTilesCollection const & keyStorage)
 
 void ReadManager::InvalidateAll()
 {
+  ClearTileShapesCache();
+  CancelPrefetching();
+
   for (auto const & info : m_tileInfos)
     CancelTileInfo(info);
   m_tileInfos.clear();
@@ -239,7 +345,8 @@ void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
                                                m_have3dBuildings && m_allow3dBuildings,
                                                m_trafficEnabled, m_displacementMode,
                                                m_ugcRenderingEnabled ? m_isUGCFn : nullptr);
-  std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context));
+  std::shared_ptr<TileInfo> tileInfo =
+      std::make_shared<TileInfo>(std::move(context), make_ref(m_tileShapesCache));
   m_tileInfos.insert(tileInfo);
   ReadMWMTask * task = m_tasksPool.Get();
 
@@ -247,10 +354,77 @@ void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
   {
     std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
     m_activeTiles.insert(TileKey(tileKey, m_generationCounter, m_userMarksGenerationCounter));
+
+    // The tile is read by this task now, its unfinished prefetching is useless.
+    auto const it = m_prefetchedTiles.find(tileKey);
+    if (it != m_prefetchedTiles.end())
+    {
+      it->second->Cancel();
+      m_prefetchedTiles.erase(it);
+    }
   }
   m_pool->PushBack(task);
 }
 
+void ReadManager::PrioritizeTasks(ScreenBase const & screen)
+{
+  if (m_pool == nullptr)
+    return;
+
+  struct TaskInfo
+  {
+    bool operator<(TaskInfo const & rhs) const
+    {
+      if (m_isCancelled != rhs.m_isCancelled)
+        return m_isCancelled;
+      if (m_isPrefetched != rhs.m_isPrefetched)
+        return !m_isPrefetched;
+      if (m_zoomLevelDiff != rhs.m_zoomLevelDiff)
+        return m_zoomLevelDiff < rhs.m_zoomLevelDiff;
+      return m_squaredDistance < rhs.m_squaredDistance;
+    }
+
+    threads::IRoutine * m_task = nullptr;
+    bool m_isCancelled = false;
+    bool m_isPrefetched = false;
+    int m_zoomLevelDiff = 0;
+    double m_squaredDistance = 0.0;
+  };
+
+  m2::PointD const center = screen.GlobalRect().GlobalCenter();
+  int const zoomLevel = df::GetDrawTileScale(screen);
+
+  m_pool->ProcessTasks([&](std::list<threads::IRoutine *> & tasks)
+  {
+    if (tasks.size() < 2)
+      return;
+
+    // Priorities are calculated before sorting because tasks may be cancelled concurrently.
+    std::vector<TaskInfo> infos;
+    infos.reserve(tasks.size());
+    for (auto * task : tasks)
+    {
+      ASSERT(dynamic_cast<ReadMWMTask *>(task) != nullptr, ());
+      auto const * readTask = static_cast<ReadMWMTask *>(task);
+      auto const & tileKey = readTask->GetTileKey();
+
+      TaskInfo info;
+      info.m_task = task;
+      info.m_isCancelled = task->IsCancelled();
+      info.m_isPrefetched = readTask->IsPrefetched();
+      info.m_zoomLevelDiff = std::abs(tileKey.m_zoomLevel - zoomLevel);
+      info.m_squaredDistance = tileKey.GetGlobalRect().Center().SquaredLength(center);
+      infos.push_back(info);
+    }
+
+    std::stable_sort(infos.begin(), infos.end());
+
+    auto it = tasks.begin();
+    for (auto const & info : infos)
+      *it++ = info.m_task;
+  });
+}
+
 void ReadManager::CheckFinishedTiles(TTileInfoCollection const & requestedTiles, bool forceUpdateUserMarks)
 {
   if (requestedTiles.empty())
@@ -282,7 +456,8 @@ void ReadManager::CheckFinishedTiles(TTileInfoCollection const & requestedTiles,
   {
     m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                               make_unique_dp<FinishTileReadMessage>(std::move(finishedTiles),
-                                                                    forceUpdateUserMarks),
+                                                                    forceUpdateUserMarks,
+                                                                    true /* changedUserMarksOnly */),
                               MessagePriority::Normal);
   }
 }
@@ -342,6 +517,7 @@ void ReadManager::SetDisplacementMode(int displacementMode)
 
 void ReadManager::SetCustomFeatures(CustomFeatures && ids)
 {
+  ClearTileShapesCache();
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(ids));
 }
 
@@ -370,6 +546,7 @@ bool ReadManager::RemoveCustomFeatures(MwmSet::MwmId const & mwmId)
   if (features.size() == m_customFeaturesContext->m_features.size())
     return false;
 
+  ClearTileShapesCache();
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(features));
   return true;
 }
@@ -379,13 +556,22 @@ bool ReadManager::RemoveAllCustomFeatures()
   if (!m_customFeaturesContext || m_customFeaturesContext->m_features.empty())
     return false;
 
+  ClearTileShapesCache();
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(CustomFeatures());
   return true;
 }
 
 void ReadManager::EnableUGCRendering(bool enabled)
 {
+  if (m_ugcRenderingEnabled != enabled)
+    ClearTileShapesCache();
   m_ugcRenderingEnabled = enabled;
 }
 
+void ReadManager::ClearTileShapesCache()
+{
+  if (m_tileShapesCache)
+    m_tileShapesCache->Clear();
+}
+
 } // namespace df
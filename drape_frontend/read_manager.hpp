@@ -3,6 +3,7 @@
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/read_mwm_task.hpp"
 #include "drape_frontend/tile_info.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/tile_utils.hpp"
 
 #include "geometry/screenbase.hpp"
@@ -12,6 +13,7 @@
 
 #include "base/thread_pool.hpp"
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -28,6 +30,10 @@ class MapDataProvider;
 class MetalineManager;
 
 uint8_t constexpr kReadingThreadsCount = 2;
+// Maximum number of tiles whose shapes are kept in TileShapesCache. Zero disables the cache.
+size_t constexpr kTileShapesCacheSize = 64;
+// Maximum number of tiles which are prefetched at the same time.
+size_t constexpr kMaxPrefetchedTilesCount = 16;
 
 class ReadManager
 {
@@ -43,6 +49,11 @@ public:
                       bool forceUpdate, bool forceUpdateUserMarks,
                       TTilesCollection const & tiles, ref_ptr<dp::TextureManager> texMng,
                       ref_ptr<MetalineManager> metalineMng);
+  // Reads |tiles| to TileShapesCache with the lowest priority, so they are shown quickly
+  // when they are requested by UpdateCoverage. Prefetching of tiles which are not in
+  // |tiles| is cancelled. Does nothing when TileShapesCache is disabled.
+  void Prefetch(TTilesCollection const & tiles, ref_ptr<dp::TextureManager> texMng,
+                ref_ptr<MetalineManager> metalineMng);
   void Invalidate(TTilesCollection const & keyStorage);
   void InvalidateAll();
 
@@ -62,6 +73,9 @@ public:
 
   void EnableUGCRendering(bool enabled);
 
+  // Must be called when texture regions are changed, e.g. on switching of the map style.
+  void ClearTileShapesCache();
+
 private:
   void OnTaskFinished(threads::IRoutine * task);
   bool MustDropAllTiles(ScreenBase const & screen) const;
@@ -69,11 +83,22 @@ private:
   void PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
                               ref_ptr<MetalineManager> metalineMng);
 
+  void CancelPrefetching();
+
+  // Starts reading the data of |tiles| from disk before their tasks are run.
+  template <typename Tiles>
+  void PrefetchTilesData(Tiles const & tiles);
+
+  // Reorders not started tasks: cancelled ones go first to be finished without reading,
+  // then tiles of the |screen| zoom level closest to its center, prefetched tiles go last.
+  void PrioritizeTasks(ScreenBase const & screen);
+
   ref_ptr<ThreadsCommutator> m_commutator;
 
   MapDataProvider & m_model;
 
   drape_ptr<threads::ThreadPool> m_pool;
+  drape_ptr<TileShapesCache> m_tileShapesCache;
 
   ScreenBase m_currentViewport;
   bool m_have3dBuildings;
@@ -101,6 +126,8 @@ private:
 
   using TTileInfoCollection = buffer_vector<std::shared_ptr<TileInfo>, 8>;
   TTilesCollection m_activeTiles;
+  // Guarded by m_finishedTilesMutex, since finished tiles are erased on reading threads.
+  std::map<TileKey, std::shared_ptr<TileInfo>> m_prefetchedTiles;
 
   CustomFeaturesContextPtr m_customFeaturesContext;
 
@@ -7,7 +7,7 @@
 #include "drape_frontend/threads_commutator.hpp"
 
 #include "coding/file_container.hpp"
-#include "coding/reader_wrapper.hpp"
+#include "coding/reader.hpp"
 #include "coding/varint.hpp"
 
 #include "indexer/feature_decl.hpp"
@@ -27,17 +27,22 @@ double const kPointEqualityEps = 1e-7;
 struct MetalineData
 {
   std::vector<FeatureID> m_features;
-  std::set<FeatureID> m_reversed;
+  std::vector<bool> m_reversed;
 };
 
 std::vector<MetalineData> ReadMetalinesFromFile(MwmSet::MwmId const & mwmId)
-{ 
+{
   try
   {
     std::vector<MetalineData> model;
-    ModelReaderPtr reader = FilesContainerR(mwmId.GetInfo()->GetLocalFile().GetPath(MapOptions::Map))
-                                            .GetReader(METALINES_FILE_TAG);
-    ReaderSrc src(reader.GetPtr());
+    // The section is parsed in place, without copying it through a file reader cache.
+    FilesMappingContainer const cont(mwmId.GetInfo()->GetLocalFile().GetPath(MapOptions::Map));
+    if (!cont.IsExist(METALINES_FILE_TAG))
+      return {};
+
+    auto const handle = cont.Map(METALINES_FILE_TAG);
+    MemReaderWithExceptions reader(handle.GetData<char>(), static_cast<size_t>(handle.GetSize()));
+    ReaderSource<MemReaderWithExceptions> src(reader);
     auto const version = ReadPrimitiveFromSource<uint8_t>(src);
     if (version == 1)
     {
@@ -47,10 +52,8 @@ std::vector<MetalineData> ReadMetalinesFromFile(MwmSet::MwmId const & mwmId)
         for (auto i = ReadVarUint<uint32_t>(src); i > 0; --i)
         {
           auto const fid = ReadVarInt<int32_t>(src);
-          FeatureID const featureId(mwmId, static_cast<uint32_t>(std::abs(fid)));
-          data.m_features.emplace_back(featureId);
-          if (fid <= 0)
-            data.m_reversed.insert(featureId);
+          data.m_features.emplace_back(mwmId, static_cast<uint32_t>(std::abs(fid)));
+          data.m_reversed.push_back(fid <= 0);
         }
         if (!data.m_features.empty())
           model.push_back(std::move(data));
@@ -64,62 +67,31 @@ std::vector<MetalineData> ReadMetalinesFromFile(MwmSet::MwmId const & mwmId)
   }
 }
 
-std::map<FeatureID, std::vector<m2::PointD>> ReadPoints(df::MapDataProvider & model,
-                                                        MetalineData const & metaline)
-{
-  bool failed = false;
-  auto features = metaline.m_features;
-  std::sort(features.begin(), features.end());
-
-  std::map<FeatureID, std::vector<m2::PointD>> result;
-  model.ReadFeatures([&metaline, &failed, &result](FeatureType & ft)
-  {
-    if (failed)
-      return;
-
-    std::vector<m2::PointD> featurePoints;
-    featurePoints.reserve(5);
-    ft.ForEachPoint([&featurePoints](m2::PointD const & pt)
-    {
-      if (featurePoints.empty() || !featurePoints.back().EqualDxDy(pt, kPointEqualityEps))
-        featurePoints.push_back(pt);
-    }, scales::GetUpperScale());
-
-    if (featurePoints.size() < 2)
-    {
-      failed = true;
-      return;
-    }
-    if (metaline.m_reversed.find(ft.GetID()) != metaline.m_reversed.cend())
-      std::reverse(featurePoints.begin(), featurePoints.end());
-
-    result.insert(std::make_pair(ft.GetID(), std::move(featurePoints)));
-  }, features);
-
-  if (failed)
-    return {};
-
-  return result;
-};
-
 std::vector<m2::PointD> MergePoints(std::map<FeatureID, std::vector<m2::PointD>> const & points,
-                                    std::vector<FeatureID> const & featuresOrder)
+                                    MetalineData const & metaline)
 {
   size_t sz = 0;
-  for (auto const & p : points)
-    sz += p.second.size();
+  for (auto const & f : metaline.m_features)
+  {
+    auto const it = points.find(f);
+    if (it == points.cend())
+      return {};
+    sz += it->second.size();
+  }
 
   std::vector<m2::PointD> result;
   result.reserve(sz);
-  for (auto const & f : featuresOrder)
+  auto const addPoint = [&result](m2::PointD const & pt) {
+    if (result.empty() || !result.back().EqualDxDy(pt, kPointEqualityEps))
+      result.push_back(pt);
+  };
+  for (size_t i = 0; i < metaline.m_features.size(); ++i)
   {
-    auto const it = points.find(f);
-    ASSERT(it != points.cend(), ());
-    for (auto const & pt : it->second)
-    {
-      if (result.empty() || !result.back().EqualDxDy(pt, kPointEqualityEps))
-        result.push_back(pt);
-    }
+    auto const & featurePoints = points.find(metaline.m_features[i])->second;
+    if (metaline.m_reversed[i])
+      std::for_each(featurePoints.crbegin(), featurePoints.crend(), addPoint);
+    else
+      std::for_each(featurePoints.cbegin(), featurePoints.cend(), addPoint);
   }
   return result;
 }
@@ -155,28 +127,51 @@ void ReadMetalineTask::Run()
     return;
 
   auto metalines = ReadMetalinesFromFile(m_mwmId);
-  for (auto const & metaline : metalines)
+
+  // A feature belongs to the first metaline it's met in, the metalines sharing
+  // features with the previous ones are skipped.
+  std::set<FeatureID> features;
+  metalines.erase(std::remove_if(metalines.begin(), metalines.end(),
+                                 [&features](MetalineData const & metaline) {
+                                   for (auto const & fid : metaline.m_features)
+                                   {
+                                     if (features.find(fid) != features.cend())
+                                       return true;
+                                   }
+                                   features.insert(metaline.m_features.cbegin(),
+                                                   metaline.m_features.cend());
+                                   return false;
+                                 }),
+                  metalines.end());
+  if (metalines.empty() || m_isCancelled)
+    return;
+
+  // Features of all the metalines are read at once, sorted by ids.
+  std::map<FeatureID, std::vector<m2::PointD>> points;
+  m_model.ReadFeatures([this, &points](FeatureType & ft)
   {
     if (m_isCancelled)
       return;
 
-    bool failed = false;
-    for (auto const & fid : metaline.m_features)
+    std::vector<m2::PointD> featurePoints;
+    featurePoints.reserve(5);
+    ft.ForEachPoint([&featurePoints](m2::PointD const & pt)
     {
-      if (m_metalines.find(fid) != m_metalines.end())
-      {
-        failed = true;
-        break;
-      }
-    }
-    if (failed)
-      continue;
+      if (featurePoints.empty() || !featurePoints.back().EqualDxDy(pt, kPointEqualityEps))
+        featurePoints.push_back(pt);
+    }, scales::GetUpperScale());
 
-    auto const points = ReadPoints(m_model, metaline);
-    if (points.size() != metaline.m_features.size())
-      continue;
+    // Metalines with degenerate features are skipped.
+    if (featurePoints.size() >= 2)
+      points.emplace(ft.GetID(), std::move(featurePoints));
+  }, std::vector<FeatureID>(features.cbegin(), features.cend()));
+
+  for (auto const & metaline : metalines)
+  {
+    if (m_isCancelled)
+      return;
 
-    std::vector<m2::PointD> const mergedPoints = MergePoints(points, metaline.m_features);
+    std::vector<m2::PointD> const mergedPoints = MergePoints(points, metaline);
     if (mergedPoints.empty())
       continue;
 
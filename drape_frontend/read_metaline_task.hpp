@@ -8,6 +8,7 @@
 
 #include <atomic>
 #include <map>
+#include <utility>
 
 namespace df
 {
@@ -25,6 +26,7 @@ public:
   bool IsCancelled() const;
 
   MetalineCache const & GetMetalines() const { return m_metalines; }
+  MetalineCache && ExtractMetalines() { return std::move(m_metalines); }
   MwmSet::MwmId const & GetMwmId() const { return m_mwmId; }
 
 private:
@@ -14,6 +14,7 @@ void ReadMWMTask::Init(std::shared_ptr<TileInfo> const & tileInfo)
 {
   m_tileInfo = tileInfo;
   m_tileKey = tileInfo->GetTileKey();
+  m_isPrefetched = tileInfo->IsPrefetched();
 #ifdef DEBUG
   m_checker = true;
 #endif
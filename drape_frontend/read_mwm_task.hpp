@@ -19,10 +19,13 @@ public:
   void Reset() override;
   bool IsCancelled() const override;
   TileKey const & GetTileKey() const { return m_tileKey; }
+  bool IsPrefetched() const { return m_isPrefetched; }
+  std::shared_ptr<TileInfo> GetTileInfo() const { return m_tileInfo.lock(); }
 
 private:
   std::weak_ptr<TileInfo> m_tileInfo;
   TileKey m_tileKey;
+  bool m_isPrefetched = false;
   MapDataProvider & m_model;
 
 #ifdef DEBUG
@@ -35,6 +35,8 @@ public:
 
   dp::RenderState const & GetState() const { return m_state; }
   TileKey const & GetTileKey() const { return m_tileKey; }
+  // Unchanged user marks geometry is kept between user marks generations.
+  void SetUserMarksGeneration(uint64_t generation) { m_tileKey.m_userMarksGeneration = generation; }
 
   virtual void UpdateAnimation();
   virtual void Render(ref_ptr<dp::GraphicsContext> context, ref_ptr<gpu::ProgramManager> mng, ScreenBase const & screen,
@@ -23,6 +23,22 @@ TTilesCollection RequestedTiles::GetTiles()
   return tiles;
 }
 
+void RequestedTiles::SetPrefetchTiles(TTilesCollection && tiles)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_prefetchTiles = move(tiles);
+}
+
+TTilesCollection RequestedTiles::GetPrefetchTiles()
+{
+  TTilesCollection tiles;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_prefetchTiles.swap(tiles);
+  }
+  return tiles;
+}
+
 void RequestedTiles::GetParams(ScreenBase & screen, bool & have3dBuildings,
                                bool & forceRequest, bool & forceUserMarksRequest)
 {
@@ -15,12 +15,16 @@ public:
   void Set(ScreenBase const & screen, bool have3dBuildings, bool forceRequest,
            bool forceUserMarksRequest, TTilesCollection && tiles);
   TTilesCollection GetTiles();
+  // Tiles which are going to be visible soon, e.g. at the end of a map animation.
+  void SetPrefetchTiles(TTilesCollection && tiles);
+  TTilesCollection GetPrefetchTiles();
   void GetParams(ScreenBase & screen, bool & have3dBuildings,
                  bool & forceRequest, bool & forceUserMarksRequest);
   bool CheckTileKey(TileKey const & tileKey) const;
 
 private:
   TTilesCollection m_tiles;
+  TTilesCollection m_prefetchTiles;
   ScreenBase m_screen;
   bool m_have3dBuildings = false;
   bool m_forceRequest = false;
@@ -54,6 +54,11 @@ void RouteBuilder::ClearRouteCache()
   m_routeCache.clear();
 }
 
+void RouteBuilder::ClearRouteCache(dp::DrapeID subrouteId)
+{
+  m_routeCache.erase(subrouteId);
+}
+
 void RouteBuilder::BuildArrows(ref_ptr<dp::GraphicsContext> context, dp::DrapeID subrouteId,
                                std::vector<ArrowBorders> const & borders, ref_ptr<dp::TextureManager> textures,
                                int recacheId)
@@ -38,6 +38,7 @@ public:
                    std::vector<ArrowBorders> const & borders, ref_ptr<dp::TextureManager> textures, int recacheId);
 
   void ClearRouteCache();
+  void ClearRouteCache(dp::DrapeID subrouteId);
 
 private:
   FlushFn m_flushFn;
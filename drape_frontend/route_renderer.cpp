@@ -645,6 +645,24 @@ void RouteRenderer::RemoveSubrouteData(dp::DrapeID subrouteId)
     m_subroutes.erase(it);
 }
 
+void RouteRenderer::UpdateSubroute(dp::DrapeID subrouteId, SubrouteConstPtr subroute)
+{
+  auto const it = FindSubroute(m_subroutes, subrouteId);
+  if (it == m_subroutes.end())
+    return;
+
+  ASSERT(it->m_subroute->HasEqualGeometry(*subroute), ());
+  it->m_subroute = subroute;
+  for (auto & subrouteData : it->m_subrouteData)
+    subrouteData->m_subroute = subroute;
+
+  std::sort(m_subroutes.begin(), m_subroutes.end(),
+            [](SubrouteInfo const & info1, SubrouteInfo const & info2)
+  {
+    return info1.m_subroute->m_baseDistance > info2.m_subroute->m_baseDistance;
+  });
+}
+
 void RouteRenderer::AddPreviewRenderData(ref_ptr<dp::GraphicsContext> context,
                                          drape_ptr<CirclesPackRenderData> && renderData,
                                          ref_ptr<gpu::ProgramManager> mng)
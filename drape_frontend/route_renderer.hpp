@@ -65,6 +65,8 @@ public:
   Subroutes const & GetSubroutes() const;
 
   void RemoveSubrouteData(dp::DrapeID subrouteId);
+  // Replaces the subroute of |subrouteId| by |subroute| with the same geometry, render data are kept.
+  void UpdateSubroute(dp::DrapeID subrouteId, SubrouteConstPtr subroute);
 
   void AddSubrouteArrowsData(ref_ptr<dp::GraphicsContext> context,
                              drape_ptr<SubrouteArrowsData> && subrouteArrowsData,
@@ -175,6 +175,34 @@ void Subroute::AddStyle(SubrouteStyle const & style)
   }
 }
 
+bool Subroute::HasEqualGeometry(Subroute const & subroute) const
+{
+  // Markers geometry contains distances from the beginning of the route.
+  if (!m_markers.empty() || !subroute.m_markers.empty())
+    return false;
+
+  if (m_routeType != subroute.m_routeType || m_styleType != subroute.m_styleType ||
+      m_baseDepthIndex != subroute.m_baseDepthIndex ||
+      m_maxPixelWidth != subroute.m_maxPixelWidth || m_traffic != subroute.m_traffic ||
+      m_polyline.GetPoints() != subroute.m_polyline.GetPoints() ||
+      m_style.size() != subroute.m_style.size())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < m_style.size(); ++i)
+  {
+    auto const & style = m_style[i];
+    auto const & otherStyle = subroute.m_style[i];
+    if (style != otherStyle || style.m_startIndex != otherStyle.m_startIndex ||
+        style.m_endIndex != otherStyle.m_endIndex)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::PointD const & pivot,
                                  std::vector<glsl::vec4> const & segmentsColors, float baseDepth,
                                  TGeometryBuffer & geometry, TGeometryBuffer & joinsGeometry)
@@ -139,6 +139,10 @@ struct Subroute
 {
   void AddStyle(SubrouteStyle const & style);
 
+  // Returns true if render data of |subroute| is the same as render data of this subroute,
+  // i.e. the subroutes may differ only in distances from the beginning of the route.
+  bool HasEqualGeometry(Subroute const & subroute) const;
+
   df::RouteType m_routeType;
   m2::PolylineD m_polyline;
   std::vector<double> m_turns;
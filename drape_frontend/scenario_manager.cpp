@@ -1,11 +1,24 @@
 #include "drape_frontend/scenario_manager.hpp"
 
 #include "drape_frontend/user_event_stream.hpp"
+#include "drape_frontend/visual_params.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/mercator.hpp"
+
+#include "base/math.hpp"
 
 #include <memory>
 
 namespace df
 {
+namespace
+{
+// The viewport is moved along a path 30 times per second.
+std::chrono::milliseconds constexpr kFollowPathStep(33);
+std::chrono::milliseconds constexpr kWaitForTilesStep(10);
+}  // namespace
+
 
 ScenarioManager::ScenarioManager(FrontendRenderer * frontendRenderer)
   : m_frontendRenderer(frontendRenderer)
@@ -75,13 +88,11 @@ void ScenarioManager::ThreadRoutine()
   for (auto const & action : m_scenarioData.m_scenario)
   {
     // Interrupt scenario if it's necessary.
+    if (IsInterrupted())
     {
       std::lock_guard<std::mutex> lock(m_mutex);
-      if (m_needInterrupt)
-      {
-        m_needInterrupt = false;
-        break;
-      }
+      m_needInterrupt = false;
+      break;
     }
 
     switch(action->GetType())
@@ -103,6 +114,29 @@ void ScenarioManager::ThreadRoutine()
         break;
       }
 
+    case ActionType::Rotate:
+      {
+        RotateAction * rotateAction = static_cast<RotateAction *>(action.get());
+        m_frontendRenderer->AddUserEvent(make_unique_dp<RotateEvent>(rotateAction->GetAzimuth()));
+        break;
+      }
+
+    case ActionType::SetPerspective:
+      {
+        SetPerspectiveAction * perspectiveAction = static_cast<SetPerspectiveAction *>(action.get());
+        m_frontendRenderer->AddUserEvent(
+          make_unique_dp<SetAutoPerspectiveEvent>(perspectiveAction->IsPerspective()));
+        break;
+      }
+
+    case ActionType::FollowPath:
+      FollowPath(*static_cast<FollowPathAction *>(action.get()));
+      break;
+
+    case ActionType::WaitForTiles:
+      WaitForTiles(*static_cast<WaitForTilesAction *>(action.get()));
+      break;
+
     default:
       LOG(LINFO, ("Unknown action in scenario"));
     }
@@ -124,6 +158,71 @@ void ScenarioManager::ThreadRoutine()
     handler(scenarioName);
 }
 
+bool ScenarioManager::IsInterrupted()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_needInterrupt;
+}
+
+void ScenarioManager::FollowPath(FollowPathAction const & action)
+{
+  auto const & path = action.GetPath();
+  if (path.size() < 2 || action.GetSpeed() <= 0.0)
+  {
+    LOG(LWARNING, ("Invalid path in scenario"));
+    return;
+  }
+
+  double const stepInMeters = action.GetSpeed() *
+    std::chrono::duration_cast<std::chrono::duration<double>>(kFollowPathStep).count();
+  double passedInMeters = 0.0;
+  for (size_t i = 0; i + 1 < path.size(); ++i)
+  {
+    auto const & from = path[i];
+    auto const & to = path[i + 1];
+    double const segmentInMeters = MercatorBounds::DistanceOnEarth(from, to);
+    if (segmentInMeters == 0.0)
+      continue;
+
+    // The direction of the movement is upwards, so the viewport is rotated by the angle
+    // between the segment and the vertical axis.
+    auto const dir = to - from;
+    ang::AngleD const angle(atan2(dir.y, dir.x) - math::pi2);
+    for (; passedInMeters < segmentInMeters; passedInMeters += stepInMeters)
+    {
+      if (IsInterrupted())
+        return;
+
+      auto const center = from + dir * (passedInMeters / segmentInMeters);
+      auto const rect = GetRectForDrawScale(action.GetZoomLevel(), center);
+      m2::RectD const localRect(-rect.SizeX() * 0.5, -rect.SizeY() * 0.5,
+                                rect.SizeX() * 0.5, rect.SizeY() * 0.5);
+      m_frontendRenderer->AddUserEvent(make_unique_dp<SetAnyRectEvent>(
+        m2::AnyRectD(center, angle, localRect), false /* isAnim */));
+      std::this_thread::sleep_for(kFollowPathStep);
+    }
+    passedInMeters -= segmentInMeters;
+  }
+}
+
+void ScenarioManager::WaitForTiles(WaitForTilesAction const & action)
+{
+  auto const frameIndex = m_frontendRenderer->GetFrameIndex();
+  auto const startTime = std::chrono::steady_clock::now();
+  while (!m_frontendRenderer->IsSceneReadyAfterFrame(frameIndex))
+  {
+    if (IsInterrupted())
+      return;
+
+    if (std::chrono::steady_clock::now() - startTime > action.GetTimeout())
+    {
+      LOG(LWARNING, ("Tiles are not ready in scenario", m_scenarioData.m_name));
+      return;
+    }
+    std::this_thread::sleep_for(kWaitForTilesStep);
+  }
+}
+
 void ScenarioManager::InterruptImpl()
 {
   if (m_thread == nullptr)
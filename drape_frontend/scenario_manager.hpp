@@ -24,7 +24,11 @@ public:
   enum class ActionType
   {
     CenterViewport,
-    WaitForTime
+    WaitForTime,
+    Rotate,
+    SetPerspective,
+    FollowPath,
+    WaitForTiles
   };
 
   class Action
@@ -64,6 +68,66 @@ public:
     Duration m_duration;
   };
 
+  class RotateAction : public Action
+  {
+  public:
+    explicit RotateAction(double azimuth) : m_azimuth(azimuth) {}
+
+    ActionType GetType() override { return ActionType::Rotate; }
+
+    // In radians.
+    double GetAzimuth() const { return m_azimuth; }
+  private:
+    double const m_azimuth;
+  };
+
+  class SetPerspectiveAction : public Action
+  {
+  public:
+    explicit SetPerspectiveAction(bool isPerspective) : m_isPerspective(isPerspective) {}
+
+    ActionType GetType() override { return ActionType::SetPerspective; }
+
+    bool IsPerspective() const { return m_isPerspective; }
+  private:
+    bool const m_isPerspective;
+  };
+
+  // Moves the viewport along the path with the given speed, the direction of the movement
+  // is kept upwards like in the route following mode.
+  class FollowPathAction : public Action
+  {
+  public:
+    FollowPathAction(std::vector<m2::PointD> && path, int zoomLevel, double speedInMetersPerSec)
+      : m_path(std::move(path)), m_zoomLevel(zoomLevel), m_speed(speedInMetersPerSec) {}
+
+    ActionType GetType() override { return ActionType::FollowPath; }
+
+    std::vector<m2::PointD> const & GetPath() const { return m_path; }
+    int GetZoomLevel() const { return m_zoomLevel; }
+    double GetSpeed() const { return m_speed; }
+  private:
+    std::vector<m2::PointD> const m_path;
+    int const m_zoomLevel;
+    double const m_speed;
+  };
+
+  // Waits until all the requested tiles are rendered and animations are finished, so
+  // measurements of the next steps don't depend on the speed of reading of the previous ones.
+  class WaitForTilesAction : public Action
+  {
+  public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    explicit WaitForTilesAction(Duration const & timeout) : m_timeout(timeout) {}
+
+    ActionType GetType() override { return ActionType::WaitForTiles; }
+
+    Duration const & GetTimeout() const { return m_timeout; }
+  private:
+    Duration m_timeout;
+  };
+
   using Scenario = std::vector<std::unique_ptr<Action>>;
   using ScenarioCallback = std::function<void(std::string const & name)>;
 
@@ -84,6 +148,10 @@ public:
 private:
   void ThreadRoutine();
   void InterruptImpl();
+  bool IsInterrupted();
+
+  void FollowPath(FollowPathAction const & action);
+  void WaitForTiles(WaitForTilesAction const & action);
 
   FrontendRenderer * m_frontendRenderer;
 
@@ -5,6 +5,7 @@
 #include "drape_frontend/metaline_manager.hpp"
 #include "drape_frontend/rule_drawer.hpp"
 #include "drape_frontend/stylist.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 
 #include "indexer/scales.hpp"
 
@@ -12,6 +13,7 @@
 
 #include "base/scope_guard.hpp"
 #include "base/logging.hpp"
+#include "base/profiler.hpp"
 
 #include <algorithm>
 #include <functional>
@@ -20,10 +22,26 @@ using namespace std::placeholders;
 
 namespace df
 {
-TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext)
+TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext,
+                   ref_ptr<TileShapesCache> shapesCache)
   : m_context(std::move(engineContext))
   , m_isCanceled(false)
-{}
+  , m_shapesCache(shapesCache)
+{
+  if (m_shapesCache)
+    m_shapesCacheGeneration = m_shapesCache->GetGeneration();
+}
+
+// static
+std::shared_ptr<TileInfo> TileInfo::CreatePrefetched(drape_ptr<EngineContext> && engineContext,
+                                                     ref_ptr<TileShapesCache> shapesCache)
+{
+  CHECK(shapesCache != nullptr, ());
+  engineContext->SetRecordOnly(true);
+  auto tileInfo = std::make_shared<TileInfo>(std::move(engineContext), shapesCache);
+  tileInfo->m_isPrefetched = true;
+  return tileInfo;
+}
 
 m2::RectD TileInfo::GetGlobalRect() const
 {
@@ -37,6 +55,7 @@ void TileInfo::ReadFeatureIndex(MapDataProvider const & model)
 
   CheckCanceled();
 
+  base::ProfilerZone zone("ReadFeatureIndex", "drape");
   size_t const kAverageFeaturesCount = 256;
   m_featureInfo.reserve(kAverageFeaturesCount);
 
@@ -51,37 +70,116 @@ void TileInfo::ReadFeatureIndex(MapDataProvider const & model)
     }
     m_featureInfo.push_back(id);
   }, GetGlobalRect(), GetZoomLevel());
+
+  static auto & featuresHistogram = base::Profiler::Instance().GetHistogram("drape.tile_features");
+  featuresHistogram.Add(m_featureInfo.size());
 }
 
 void TileInfo::ReadFeatures(MapDataProvider const & model)
 {
+  if (m_isPrefetched)
+  {
+    PrefetchFeatures(model);
+    return;
+  }
+
 #if defined(DRAPE_MEASURER) && defined(TILES_STATISTIC)
   DrapeMeasurer::Instance().StartTileReading();
 #endif
+  base::ProfilerZone zone("ReadTile", "drape");
   m_context->BeginReadTile();
 
   // Reading can be interrupted by exception throwing
   SCOPE_GUARD(ReleaseReadTile, std::bind(&EngineContext::EndReadTile, m_context.get()));
 
+  if (ReadCachedShapes())
+  {
+    DrapeMeasurer::Instance().OnTileRead();
+    return;
+  }
+
+  std::shared_ptr<TileShapes> shapes;
+  if (m_shapesCache)
+  {
+    shapes = std::make_shared<TileShapes>();
+    m_context->RecordShapes(shapes);
+  }
+
   ReadFeatureIndex(model);
   CheckCanceled();
 
   m_context->GetMetalineManager()->Update(m_mwms);
 
-  if (!m_featureInfo.empty())
+  ReadAndDrawFeatures(model);
+
+  // Shapes of a cancelled tile may be incomplete.
+  if (shapes && !IsCancelled())
   {
-    std::sort(m_featureInfo.begin(), m_featureInfo.end());
-    auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
-    RuleDrawer drawer(std::bind(&TileInfo::InitStylist, this, deviceLang, _1, _2),
-                      std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
-                      model.GetFilter(), make_ref(m_context));
-    model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
+    m_context->RecordShapes(nullptr);
+    shapes->m_mwms = m_mwms;
+    m_shapesCache->Put(GetTileKey(), m_shapesCacheGeneration, std::move(shapes));
   }
+  DrapeMeasurer::Instance().OnTileRead();
 #if defined(DRAPE_MEASURER) && defined(TILES_STATISTIC)
   DrapeMeasurer::Instance().EndTileReading();
 #endif
 }
 
+void TileInfo::PrefetchFeatures(MapDataProvider const & model)
+{
+  // The tile is already cached, e.g. it has been visible recently.
+  if (m_shapesCache->Contains(GetTileKey()))
+    return;
+
+  auto shapes = std::make_shared<TileShapes>();
+  m_context->RecordShapes(shapes);
+
+  ReadFeatureIndex(model);
+  CheckCanceled();
+  ReadAndDrawFeatures(model);
+
+  m_context->RecordShapes(nullptr);
+  if (IsCancelled())
+    return;
+  shapes->m_mwms = m_mwms;
+  m_shapesCache->Put(GetTileKey(), m_shapesCacheGeneration, std::move(shapes));
+}
+
+void TileInfo::ReadAndDrawFeatures(MapDataProvider const & model)
+{
+  if (m_featureInfo.empty())
+    return;
+
+  base::ProfilerZone zone("DrawFeatures", "drape");
+  std::sort(m_featureInfo.begin(), m_featureInfo.end());
+  auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
+  RuleDrawer drawer(std::bind(&TileInfo::InitStylist, this, deviceLang, _1, _2),
+                    std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
+                    model.GetFilter(), make_ref(m_context));
+  model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
+}
+
+bool TileInfo::ReadCachedShapes()
+{
+  if (!m_shapesCache)
+    return false;
+
+  auto const shapes = m_shapesCache->Get(GetTileKey());
+  if (!shapes)
+    return false;
+
+  CheckCanceled();
+
+  m_context->GetMetalineManager()->Update(shapes->m_mwms);
+  if (!shapes->m_geometry.empty())
+    m_context->Flush(TMapShapes(shapes->m_geometry));
+  if (!shapes->m_overlays.empty())
+    m_context->FlushOverlays(TMapShapes(shapes->m_overlays));
+  if (!shapes->m_trafficGeometry.empty())
+    m_context->FlushTrafficGeometry(TrafficSegmentsGeometry(shapes->m_trafficGeometry));
+  return true;
+}
+
 void TileInfo::Cancel()
 {
   m_isCanceled = true;
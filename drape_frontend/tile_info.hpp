@@ -10,6 +10,8 @@
 #include "base/macros.hpp"
 
 #include <atomic>
+#include <cstdint>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -19,23 +21,35 @@ namespace df
 {
 class MapDataProvider;
 class Stylist;
+struct TileShapes;
+class TileShapesCache;
 
 class TileInfo
 {
 public:
   DECLARE_EXCEPTION(ReadCanceledException, RootException);
 
-  TileInfo(drape_ptr<EngineContext> && engineContext);
+  // |shapesCache| may be nullptr.
+  TileInfo(drape_ptr<EngineContext> && engineContext, ref_ptr<TileShapesCache> shapesCache);
+
+  // Shapes of a prefetched tile are only put to |shapesCache|, the tile is not rendered.
+  static std::shared_ptr<TileInfo> CreatePrefetched(drape_ptr<EngineContext> && engineContext,
+                                                    ref_ptr<TileShapesCache> shapesCache);
 
   void ReadFeatures(MapDataProvider const & model);
   void Cancel();
   bool IsCancelled() const;
+  bool IsPrefetched() const { return m_isPrefetched; }
 
   m2::RectD GetGlobalRect() const;
   TileKey const & GetTileKey() const { return m_context->GetTileKey(); }
   bool operator <(TileInfo const & other) const { return GetTileKey() < other.GetTileKey(); }
 
 private:
+  // Returns false when there are no cached shapes of the tile.
+  bool ReadCachedShapes();
+  void PrefetchFeatures(MapDataProvider const & model);
+  void ReadAndDrawFeatures(MapDataProvider const & model);
   void ReadFeatureIndex(MapDataProvider const & model);
   void InitStylist(int8_t deviceLang, FeatureType & f, Stylist & s);
   void CheckCanceled() const;
@@ -49,6 +63,10 @@ private:
   std::atomic<bool> m_isCanceled;
   std::set<MwmSet::MwmId> m_mwms;
 
+  ref_ptr<TileShapesCache> m_shapesCache;
+  uint64_t m_shapesCacheGeneration = 0;
+  bool m_isPrefetched = false;
+
   DISALLOW_COPY_AND_MOVE(TileInfo);
 };
 }  // namespace df
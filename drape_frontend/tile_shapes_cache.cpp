@@ -0,0 +1,66 @@
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <utility>
+
+namespace df
+{
+TileShapesCache::TileShapesCache(size_t maxTilesCount) : m_cache(maxTilesCount)
+{
+  ASSERT_GREATER(maxTilesCount, 0, ());
+}
+
+uint64_t TileShapesCache::GetGeneration() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_generation;
+}
+
+std::shared_ptr<TileShapes const> TileShapesCache::Get(TileKey const & tileKey)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const * shapes = m_cache.Find(tileKey);
+  return shapes ? *shapes : nullptr;
+}
+
+bool TileShapesCache::Contains(TileKey const & tileKey) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache.Contains(tileKey);
+}
+
+void TileShapesCache::Put(TileKey const & tileKey, uint64_t generation,
+                          std::shared_ptr<TileShapes const> shapes)
+{
+  CHECK(shapes, ());
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (generation != m_generation)
+    return;
+
+  m_cache.Put(tileKey, std::move(shapes), 1 /* memorySize */);
+}
+
+void TileShapesCache::Erase(m2::RectD const & rect)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache.EraseIf([&rect](TileKey const & tileKey) {
+    return tileKey.GetGlobalRect(false /* clipByDataMaxZoom */).IsIntersect(rect);
+  });
+  ++m_generation;
+}
+
+void TileShapesCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache.Clear();
+  ++m_generation;
+}
+
+size_t TileShapesCache::GetSize() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache.GetSize();
+}
+}  // namespace df
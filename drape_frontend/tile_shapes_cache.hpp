@@ -0,0 +1,68 @@
+#pragma once
+
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/traffic_generator.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "base/memory_lru_cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace df
+{
+// Shapes of a tile which are read, styled and prepared by RuleDrawer.
+struct TileShapes
+{
+  std::set<MwmSet::MwmId> m_mwms;
+  TMapShapes m_geometry;
+  TMapShapes m_overlays;
+  TrafficSegmentsGeometry m_trafficGeometry;
+};
+
+// LRU cache of shapes of recently read tiles. When a tile is read again, its cached shapes
+// are passed to the backend renderer directly, so decoding of features, styling and
+// tessellation of shapes are skipped. Shapes are only batched again.
+//
+// Shapes depend on the rendering mode and on texture regions, so the cache must be
+// cleared whenever they change. The cache is thread-safe.
+class TileShapesCache
+{
+public:
+  explicit TileShapesCache(size_t maxTilesCount);
+
+  // Entries put with another generation are discarded, so tiles which are read while
+  // the cache is being cleared don't get to the cache.
+  uint64_t GetGeneration() const;
+
+  // Returns nullptr when there are no shapes for |tileKey|. Generations of |tileKey|
+  // are not considered.
+  std::shared_ptr<TileShapes const> Get(TileKey const & tileKey);
+
+  // Unlike Get, doesn't make the entry recently used.
+  bool Contains(TileKey const & tileKey) const;
+
+  void Put(TileKey const & tileKey, uint64_t generation, std::shared_ptr<TileShapes const> shapes);
+
+  // Erases shapes of all tiles intersecting |rect|, on all zoom levels. Changes generation.
+  void Erase(m2::RectD const & rect);
+
+  // Changes generation.
+  void Clear();
+
+  size_t GetSize() const;
+
+private:
+  mutable std::mutex m_mutex;
+  // Every tile has size one, so the cache is bounded by the number of tiles.
+  base::MemoryLruCache<TileKey, std::shared_ptr<TileShapes const>> m_cache;
+  uint64_t m_generation = 0;
+};
+}  // namespace df
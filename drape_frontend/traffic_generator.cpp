@@ -18,6 +18,7 @@
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 
 using namespace std::placeholders;
@@ -51,15 +52,28 @@ static std::array<float, static_cast<size_t>(traffic::SpeedGroup::Count)> kMinCo
   0.0f,   // Unknown
 }};
 
+uint8_t constexpr kDynamicStreamID = 0x7F;
+
 dp::BindingInfo const & GetTrafficStaticBindingInfo()
 {
   static std::unique_ptr<dp::BindingInfo> s_info;
   if (s_info == nullptr)
   {
-    dp::BindingFiller<TrafficStaticVertex> filler(3);
+    dp::BindingFiller<TrafficStaticVertex> filler(2);
     filler.FillDecl<TrafficStaticVertex::TPosition>("a_position");
     filler.FillDecl<TrafficStaticVertex::TNormal>("a_normal");
-    filler.FillDecl<TrafficStaticVertex::TTexCoord>("a_colorTexCoord");
+    s_info = std::make_unique<dp::BindingInfo>(filler.m_info);
+  }
+  return *s_info;
+}
+
+dp::BindingInfo const & GetTrafficDynamicBindingInfo()
+{
+  static std::unique_ptr<dp::BindingInfo> s_info;
+  if (s_info == nullptr)
+  {
+    dp::BindingFiller<TrafficDynamicVertex> filler(1, kDynamicStreamID);
+    filler.FillDecl<TrafficDynamicVertex::TTexCoord>("a_colorTexCoord");
     s_info = std::make_unique<dp::BindingInfo>(filler.m_info);
   }
   return *s_info;
@@ -70,9 +84,20 @@ dp::BindingInfo const & GetTrafficLineStaticBindingInfo()
   static std::unique_ptr<dp::BindingInfo> s_info;
   if (s_info == nullptr)
   {
-    dp::BindingFiller<TrafficLineStaticVertex> filler(2);
+    dp::BindingFiller<TrafficLineStaticVertex> filler(1);
     filler.FillDecl<TrafficLineStaticVertex::TPosition>("a_position");
-    filler.FillDecl<TrafficLineStaticVertex::TTexCoord>("a_colorTexCoord");
+    s_info = std::make_unique<dp::BindingInfo>(filler.m_info);
+  }
+  return *s_info;
+}
+
+dp::BindingInfo const & GetTrafficLineDynamicBindingInfo()
+{
+  static std::unique_ptr<dp::BindingInfo> s_info;
+  if (s_info == nullptr)
+  {
+    dp::BindingFiller<TrafficLineDynamicVertex> filler(1, kDynamicStreamID);
+    filler.FillDecl<TrafficLineDynamicVertex::TTexCoord>("a_colorTexCoord");
     s_info = std::make_unique<dp::BindingInfo>(filler.m_info);
   }
   return *s_info;
@@ -83,35 +108,105 @@ dp::BindingInfo const & GetTrafficCircleStaticBindingInfo()
   static std::unique_ptr<dp::BindingInfo> s_info;
   if (s_info == nullptr)
   {
-    dp::BindingFiller<TrafficCircleStaticVertex> filler(3);
+    dp::BindingFiller<TrafficCircleStaticVertex> filler(2);
     filler.FillDecl<TrafficCircleStaticVertex::TPosition>("a_position");
     filler.FillDecl<TrafficCircleStaticVertex::TNormal>("a_normal");
-    filler.FillDecl<TrafficCircleStaticVertex::TTexCoord>("a_colorTexCoord");
     s_info = std::make_unique<dp::BindingInfo>(filler.m_info);
   }
   return *s_info;
 }
 
 void SubmitStaticVertex(glsl::vec3 const & pivot, glsl::vec2 const & normal, float side,
-                        float offsetFromStart, glsl::vec4 const & texCoord,
-                        std::vector<TrafficStaticVertex> & staticGeom)
+                        float offsetFromStart, glsl::vec4 const & texCoord, bool isEnd,
+                        std::vector<TrafficStaticVertex> & staticGeom,
+                        std::vector<TrafficDynamicVertex> & dynamicGeom,
+                        std::vector<bool> & isEndVertex)
 {
-  staticGeom.emplace_back(pivot, TrafficStaticVertex::TNormal(normal, side, offsetFromStart), texCoord);
+  staticGeom.emplace_back(pivot, TrafficStaticVertex::TNormal(normal, side, offsetFromStart));
+  dynamicGeom.emplace_back(texCoord);
+  isEndVertex.push_back(isEnd);
 }
 
 void SubmitCircleStaticVertices(RoadClass roadClass, glsl::vec3 const & pivot,
-                                glsl::vec2 const & rightNormal, glsl::vec2 const & uv,
+                                glsl::vec2 const & rightNormal,
                                 std::vector<TrafficCircleStaticVertex> & circlesGeometry)
 {
   // Here we use an equilateral triangle to render circle (incircle of a triangle).
   static float const kSqrt3 = sqrt(3.0f);
   auto const p = glsl::vec4(pivot, static_cast<float>(roadClass));
-  circlesGeometry.emplace_back(p, glsl::vec4(rightNormal, -kSqrt3, -1.0f), uv);
-  circlesGeometry.emplace_back(p, glsl::vec4(rightNormal, kSqrt3, -1.0f), uv);
-  circlesGeometry.emplace_back(p, glsl::vec4(rightNormal, 0.0f, 2.0f), uv);
+  circlesGeometry.emplace_back(p, glsl::vec4(rightNormal, -kSqrt3, -1.0f));
+  circlesGeometry.emplace_back(p, glsl::vec4(rightNormal, kSqrt3, -1.0f));
+  circlesGeometry.emplace_back(p, glsl::vec4(rightNormal, 0.0f, 2.0f));
 }
 }  // namespace
 
+TrafficHandle::TrafficHandle(traffic::TrafficInfo::RoadSegmentId const & segmentId,
+                             TrafficSegmentColor const & color, std::vector<bool> && isEndVertex)
+  : TBase(FeatureID(), dp::Anchor::Center, 0 /* priority */, 1 /* minVisibleScale */,
+          false /* isBillboard */)
+  , m_segmentId(segmentId)
+  , m_color(color)
+  , m_isEndVertex(std::move(isEndVertex))
+{}
+
+void TrafficHandle::GetAttributeMutation(ref_ptr<dp::AttributeBufferMutator> mutator) const
+{
+  if (!m_needUpdate)
+    return;
+
+  // Lines and circles have 2-component texture coordinates, they are the first components of
+  // the texture coordinates of triangles.
+  TOffsetNode const & node = GetOffsetNode(kDynamicStreamID);
+  uint32_t const elementSize = node.first.GetElementSize();
+  ASSERT_LESS_OR_EQUAL(elementSize, sizeof(TrafficDynamicVertex::TTexCoord), ());
+  ASSERT_EQUAL(node.second.m_count, m_isEndVertex.size(), ());
+
+  TrafficDynamicVertex::TTexCoord const startTexCoord(m_color.m_texCoord, m_color.m_vOffset, 1.0f);
+  TrafficDynamicVertex::TTexCoord const endTexCoord(m_color.m_texCoord, m_color.m_vOffset,
+                                                    m_color.m_minU);
+  auto buffer = static_cast<uint8_t *>(
+      mutator->AllocateMutationBuffer(static_cast<uint32_t>(m_isEndVertex.size()) * elementSize));
+  for (size_t i = 0; i < m_isEndVertex.size(); ++i)
+  {
+    auto const & texCoord = m_isEndVertex[i] ? endTexCoord : startTexCoord;
+    memcpy(buffer + i * elementSize, glsl::value_ptr(texCoord), elementSize);
+  }
+
+  dp::MutateNode mutateNode;
+  mutateNode.m_region = node.second;
+  mutateNode.m_data = make_ref(buffer);
+  mutator->AddMutation(node.first, mutateNode);
+
+  m_needUpdate = false;
+}
+
+bool TrafficHandle::Update(ScreenBase const & screen)
+{
+  UNUSED_VALUE(screen);
+  return true;
+}
+
+bool TrafficHandle::IndexesRequired() const { return false; }
+
+m2::RectD TrafficHandle::GetPixelRect(ScreenBase const & screen, bool perspective) const
+{
+  UNUSED_VALUE(screen);
+  UNUSED_VALUE(perspective);
+  return m2::RectD();
+}
+
+void TrafficHandle::GetPixelShape(ScreenBase const & screen, bool perspective, Rects & rects) const
+{
+  UNUSED_VALUE(screen);
+  UNUSED_VALUE(perspective);
+}
+
+void TrafficHandle::SetColor(TrafficSegmentColor const & color)
+{
+  m_color = color;
+  m_needUpdate = true;
+}
+
 bool TrafficGenerator::m_simplifiedColorScheme = true;
 
 void TrafficGenerator::Init()
@@ -126,8 +221,11 @@ void TrafficGenerator::Init()
   m_circlesBatcher = make_unique_dp<dp::Batcher>(kCirclesBatchSize, kCirclesBatchSize);
 
   m_providerLines.InitStream(0 /* stream index */, GetTrafficLineStaticBindingInfo(), nullptr);
+  m_providerLines.InitStream(1 /* stream index */, GetTrafficLineDynamicBindingInfo(), nullptr);
   m_providerTriangles.InitStream(0 /* stream index */, GetTrafficStaticBindingInfo(), nullptr);
+  m_providerTriangles.InitStream(1 /* stream index */, GetTrafficDynamicBindingInfo(), nullptr);
   m_providerCircles.InitStream(0 /* stream index */, GetTrafficCircleStaticBindingInfo(), nullptr);
+  m_providerCircles.InitStream(1 /* stream index */, GetTrafficLineDynamicBindingInfo(), nullptr);
 }
 
 void TrafficGenerator::ClearContextDependentResources()
@@ -175,112 +273,268 @@ void TrafficGenerator::GenerateSegmentsGeometry(ref_ptr<dp::GraphicsContext> con
     if (coloringIt == coloring.cend() || coloringIt->second == traffic::SpeedGroup::Unknown)
       continue;
 
-    auto const & colorRegion = m_colorsCache[static_cast<size_t>(coloringIt->second)];
-    auto const vOffset = kCoordVOffsets[static_cast<size_t>(coloringIt->second)];
-    auto const minU = kMinCoordU[static_cast<size_t>(coloringIt->second)];
+    auto const color = GetSegmentColor(coloringIt->second);
 
     TrafficSegmentGeometry const & g = geomPair.second;
     ref_ptr<dp::Batcher> batcher =
       m_batchersPool->GetBatcher(TrafficBatcherKey(mwmId, tileKey, g.m_roadClass));
 
-    auto const finalDepth = kRoadClassDepths[static_cast<size_t>(g.m_roadClass)] +
-                            static_cast<float>(coloringIt->second);
+    // The depth doesn't depend on the speed group, since segments are recolored without
+    // regeneration of their geometry.
+    auto const depth = kRoadClassDepths[static_cast<size_t>(g.m_roadClass)];
 
     int width = 0;
     if (TrafficRenderer::CanBeRenderedAsLine(g.m_roadClass, tileKey.m_zoomLevel, width))
     {
       std::vector<TrafficLineStaticVertex> staticGeometry;
-      GenerateLineSegment(colorRegion, g.m_polyline, tileKey.GetGlobalRect().Center(), finalDepth,
-                          staticGeometry);
+      GenerateLineSegment(g.m_polyline, tileKey.GetGlobalRect().Center(), depth, staticGeometry);
       if (staticGeometry.empty())
         continue;
 
+      std::vector<TrafficLineDynamicVertex> dynamicGeometry(staticGeometry.size(),
+                                                            TrafficLineDynamicVertex(color.m_texCoord));
       m_providerLines.Reset(static_cast<uint32_t>(staticGeometry.size()));
       m_providerLines.UpdateStream(0 /* stream index */, make_ref(staticGeometry.data()));
+      m_providerLines.UpdateStream(1 /* stream index */, make_ref(dynamicGeometry.data()));
 
       dp::RenderState curLineState = lineState;
       curLineState.SetLineWidth(width);
-      batcher->InsertLineStrip(context, curLineState, make_ref(&m_providerLines));
+      batcher->InsertLineStrip(context, curLineState, make_ref(&m_providerLines),
+                               make_unique_dp<TrafficHandle>(geomPair.first, color,
+                                                             std::vector<bool>(staticGeometry.size())));
     }
     else
     {
       std::vector<TrafficStaticVertex> staticGeometry;
+      std::vector<TrafficDynamicVertex> dynamicGeometry;
+      std::vector<bool> isEndVertex;
       bool const generateCircles =
         (tileKey.m_zoomLevel > kGenerateCirclesZoomLevel[static_cast<uint32_t>(g.m_roadClass)]);
 
       std::vector<TrafficCircleStaticVertex> circlesGeometry;
-      GenerateSegment(g.m_roadClass, colorRegion, g.m_polyline, tileKey.GetGlobalRect().Center(),
-                      generateCircles, finalDepth, vOffset, minU, isLeftHand, staticGeometry,
-                      circlesGeometry);
+      GenerateSegment(g.m_roadClass, color, g.m_polyline, tileKey.GetGlobalRect().Center(),
+                      generateCircles, depth, isLeftHand, staticGeometry, dynamicGeometry,
+                      isEndVertex, circlesGeometry);
       if (staticGeometry.empty())
         continue;
 
       m_providerTriangles.Reset(static_cast<uint32_t>(staticGeometry.size()));
       m_providerTriangles.UpdateStream(0 /* stream index */, make_ref(staticGeometry.data()));
-      batcher->InsertTriangleList(context, state, make_ref(&m_providerTriangles));
+      m_providerTriangles.UpdateStream(1 /* stream index */, make_ref(dynamicGeometry.data()));
+      batcher->InsertTriangleList(context, state, make_ref(&m_providerTriangles),
+                                  make_unique_dp<TrafficHandle>(geomPair.first, color,
+                                                                std::move(isEndVertex)));
 
       if (circlesGeometry.empty())
         continue;
 
+      std::vector<TrafficLineDynamicVertex> circlesDynamicGeometry(
+          circlesGeometry.size(), TrafficLineDynamicVertex(color.m_texCoord));
       m_providerCircles.Reset(static_cast<uint32_t>(circlesGeometry.size()));
       m_providerCircles.UpdateStream(0 /* stream index */, make_ref(circlesGeometry.data()));
-      m_circlesBatcher->InsertTriangleList(context, circleState, make_ref(&m_providerCircles));
+      m_providerCircles.UpdateStream(1 /* stream index */, make_ref(circlesDynamicGeometry.data()));
+      m_circlesBatcher->InsertTriangleList(context, circleState, make_ref(&m_providerCircles),
+                                           make_unique_dp<TrafficHandle>(
+                                               geomPair.first, color,
+                                               std::vector<bool>(circlesGeometry.size())));
     }
   }
 }
 
 void TrafficGenerator::FlushSegmentsGeometry(ref_ptr<dp::GraphicsContext> context,
                                              TileKey const & tileKey,
-                                             TrafficSegmentsGeometry const & geom,
+                                             TrafficSegmentsGeometry && geom,
                                              ref_ptr<dp::TextureManager> textures)
 {
   FillColorsCache(textures);
 
+  for (auto const & g : geom)
+  {
+    auto coloringIt = m_coloring.find(g.first);
+    if (coloringIt != m_coloring.cend())
+      FlushMwmSegmentsGeometry(context, g.first, tileKey, g.second, coloringIt->second, textures);
+  }
+
+  context->Flush();
+
+  // Tile keys are compared without generations, so the entry is replaced to keep the actual one.
+  m_tilesGeometry.erase(tileKey);
+  m_tilesGeometry.emplace(tileKey, std::move(geom));
+}
+
+void TrafficGenerator::FlushMwmSegmentsGeometry(ref_ptr<dp::GraphicsContext> context,
+                                                MwmSet::MwmId const & mwmId,
+                                                TileKey const & tileKey,
+                                                TrafficSegmentsGeometryValue const & geometry,
+                                                traffic::TrafficInfo::Coloring const & coloring,
+                                                ref_ptr<dp::TextureManager> textures)
+{
   static std::vector<RoadClass> const kRoadClasses = {RoadClass::Class0, RoadClass::Class1,
                                                       RoadClass::Class2};
-  for (auto const & g : geom)
+  for (auto const & roadClass : kRoadClasses)
+    m_batchersPool->ReserveBatcher(TrafficBatcherKey(mwmId, tileKey, roadClass));
+
+  m_circlesBatcher->StartSession([this, mwmId, tileKey](dp::RenderState const & state,
+                                                        drape_ptr<dp::RenderBucket> && renderBucket)
   {
-    auto const & mwmId = g.first;
-    auto coloringIt = m_coloring.find(mwmId);
-    if (coloringIt == m_coloring.cend())
+    FlushGeometry(TrafficBatcherKey(mwmId, tileKey, RoadClass::Class0), state,
+                  std::move(renderBucket));
+  });
+
+  GenerateSegmentsGeometry(context, mwmId, tileKey, geometry, coloring, textures);
+
+  for (auto const & roadClass : kRoadClasses)
+    m_batchersPool->ReleaseBatcher(context, TrafficBatcherKey(mwmId, tileKey, roadClass));
+
+  m_circlesBatcher->EndSession(context);
+}
+
+bool TrafficGenerator::UpdateColoring(TrafficSegmentsColoring const & coloring,
+                                      TrafficTilesList & changedTiles,
+                                      TrafficSegmentsColoring & recoloredSegments)
+{
+  using SegmentId = traffic::TrafficInfo::RoadSegmentId;
+
+  // Segments of unknown speed groups are not rendered.
+  auto const isRendered = [](traffic::SpeedGroup speedGroup)
+  {
+    return speedGroup != traffic::SpeedGroup::Unknown;
+  };
+
+  changedTiles.clear();
+  recoloredSegments.clear();
+  bool changedTilesKnown = true;
+  std::map<MwmSet::MwmId, std::vector<SegmentId>> changedSegments;
+  for (auto const & p : coloring)
+  {
+    auto it = m_coloring.find(p.first);
+    if (it == m_coloring.end())
+    {
+      changedTilesKnown = false;
+      m_coloring.emplace(p.first, p.second);
       continue;
+    }
 
-    for (auto const & roadClass : kRoadClasses)
-      m_batchersPool->ReserveBatcher(TrafficBatcherKey(mwmId, tileKey, roadClass));
+    // Both colorings are sorted by segment ids, so the changed segments are found in one pass.
+    // Segments which appear or disappear change the geometry, others are only recolored.
+    std::vector<SegmentId> & segments = changedSegments[p.first];
+    traffic::TrafficInfo::Coloring & recolored = recoloredSegments[p.first];
+    auto oldIt = it->second.cbegin();
+    auto newIt = p.second.cbegin();
+    while (oldIt != it->second.cend() || newIt != p.second.cend())
+    {
+      if (newIt == p.second.cend() || (oldIt != it->second.cend() && oldIt->first < newIt->first))
+      {
+        if (isRendered(oldIt->second))
+          segments.push_back(oldIt->first);
+        ++oldIt;
+      }
+      else if (oldIt == it->second.cend() || newIt->first < oldIt->first)
+      {
+        if (isRendered(newIt->second))
+          segments.push_back(newIt->first);
+        ++newIt;
+      }
+      else
+      {
+        if (oldIt->second != newIt->second)
+        {
+          if (isRendered(oldIt->second) && isRendered(newIt->second))
+            recolored.emplace_hint(recolored.end(), newIt->first, newIt->second);
+          else
+            segments.push_back(newIt->first);
+        }
+        ++oldIt;
+        ++newIt;
+      }
+    }
+    it->second = p.second;
+    if (recolored.empty())
+      recoloredSegments.erase(p.first);
+  }
 
-    m_circlesBatcher->StartSession([this, mwmId, tileKey](dp::RenderState const & state,
-                                                          drape_ptr<dp::RenderBucket> && renderBucket)
+  if (!changedTilesKnown)
+    return false;
+
+  for (auto const & tileGeometry : m_tilesGeometry)
+  {
+    for (auto const & g : tileGeometry.second)
     {
-      FlushGeometry(TrafficBatcherKey(mwmId, tileKey, RoadClass::Class0), state,
-                    std::move(renderBucket));
-    });
+      auto const segmentsIt = changedSegments.find(g.first);
+      if (segmentsIt == changedSegments.cend() || segmentsIt->second.empty())
+        continue;
 
-    GenerateSegmentsGeometry(context, mwmId, tileKey, g.second, coloringIt->second, textures);
+      auto const & segments = segmentsIt->second;
+      bool const isChanged = std::any_of(g.second.cbegin(), g.second.cend(),
+                                         [&segments](auto const & segment)
+      {
+        return std::binary_search(segments.cbegin(), segments.cend(), segment.first);
+      });
+      if (isChanged)
+        changedTiles.emplace_back(g.first, tileGeometry.first);
+    }
+  }
+  return true;
+}
 
-    for (auto const & roadClass : kRoadClasses)
-      m_batchersPool->ReleaseBatcher(context, TrafficBatcherKey(mwmId, tileKey, roadClass));
+TrafficSegmentsColors TrafficGenerator::GetSegmentsColors(TrafficSegmentsColoring const & coloring,
+                                                          ref_ptr<dp::TextureManager> textures)
+{
+  FillColorsCache(textures);
 
-    m_circlesBatcher->EndSession(context);
+  TrafficSegmentsColors colors;
+  for (auto const & p : coloring)
+  {
+    auto & mwmColors = colors[p.first];
+    mwmColors.reserve(p.second.size());
+    for (auto const & segment : p.second)
+      mwmColors.emplace_back(segment.first, GetSegmentColor(segment.second));
   }
+  return colors;
+}
+
+void TrafficGenerator::RegenerateTile(ref_ptr<dp::GraphicsContext> context,
+                                      MwmSet::MwmId const & mwmId, TileKey const & tileKey,
+                                      ref_ptr<dp::TextureManager> textures)
+{
+  auto const tileIt = m_tilesGeometry.find(tileKey);
+  if (tileIt == m_tilesGeometry.cend())
+    return;
+
+  auto const geometryIt = tileIt->second.find(mwmId);
+  auto const coloringIt = m_coloring.find(mwmId);
+  if (geometryIt == tileIt->second.cend() || coloringIt == m_coloring.cend())
+    return;
 
+  FillColorsCache(textures);
+  FlushMwmSegmentsGeometry(context, mwmId, tileKey, geometryIt->second, coloringIt->second,
+                           textures);
   context->Flush();
 }
 
-void TrafficGenerator::UpdateColoring(TrafficSegmentsColoring const & coloring)
+void TrafficGenerator::RemoveObsoleteTiles(CheckTileFn const & isActualTile)
 {
-  for (auto const & p : coloring)
-    m_coloring[p.first] = p.second;
+  for (auto it = m_tilesGeometry.begin(); it != m_tilesGeometry.end();)
+  {
+    if (isActualTile(it->first))
+      ++it;
+    else
+      it = m_tilesGeometry.erase(it);
+  }
 }
 
 void TrafficGenerator::ClearCache()
 {
   InvalidateTexturesCache();
   m_coloring.clear();
+  m_tilesGeometry.clear();
 }
 
 void TrafficGenerator::ClearCache(MwmSet::MwmId const & mwmId)
 {
   m_coloring.erase(mwmId);
+  for (auto & tileGeometry : m_tilesGeometry)
+    tileGeometry.second.erase(mwmId);
 }
 
 void TrafficGenerator::InvalidateTexturesCache()
@@ -299,12 +553,13 @@ void TrafficGenerator::FlushGeometry(TrafficBatcherKey const & key, dp::RenderSt
   m_flushRenderDataFn(std::move(renderData));
 }
 
-void TrafficGenerator::GenerateSegment(RoadClass roadClass,
-                                       dp::TextureManager::ColorRegion const & colorRegion,
+void TrafficGenerator::GenerateSegment(RoadClass roadClass, TrafficSegmentColor const & color,
                                        m2::PolylineD const & polyline,
                                        m2::PointD const & tileCenter, bool generateCircles,
-                                       float depth, float vOffset, float minU, bool isLeftHand,
+                                       float depth, bool isLeftHand,
                                        std::vector<TrafficStaticVertex> & staticGeometry,
+                                       std::vector<TrafficDynamicVertex> & dynamicGeometry,
+                                       std::vector<bool> & isEndVertex,
                                        std::vector<TrafficCircleStaticVertex> & circlesGeometry)
 {
   auto const & path = polyline.GetPoints();
@@ -312,6 +567,8 @@ void TrafficGenerator::GenerateSegment(RoadClass roadClass,
 
   size_t const kAverageSize = (path.size() - 1) * 6;
   staticGeometry.reserve(staticGeometry.size() + kAverageSize);
+  dynamicGeometry.reserve(dynamicGeometry.size() + kAverageSize);
+  isEndVertex.reserve(isEndVertex.size() + kAverageSize);
   circlesGeometry.reserve(circlesGeometry.size() + path.size() * 3);
 
   // Build geometry.
@@ -319,49 +576,51 @@ void TrafficGenerator::GenerateSegment(RoadClass roadClass,
   bool firstFilled = false;
   auto const circleDepth = depth - 0.5f;
 
-  glsl::vec4 const uvStart = glsl::vec4(glsl::ToVec2(colorRegion.GetTexRect().Center()), vOffset, 1.0f);
-  glsl::vec4 const uvEnd = glsl::vec4(uvStart.x, uvStart.y, uvStart.z, minU);
-  for (size_t i = 1; i < path.size(); ++i)
+  glsl::vec4 const uvStart = glsl::vec4(color.m_texCoord, color.m_vOffset, 1.0f);
+  glsl::vec4 const uvEnd = glsl::vec4(uvStart.x, uvStart.y, uvStart.z, color.m_minU);
+  auto const submitVertex = [&](glsl::vec3 const & pivot, glsl::vec2 const & normal, float side,
+                                float offsetFromStart, bool isEnd)
   {
-    if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
-      continue;
+    SubmitStaticVertex(pivot, normal, side, offsetFromStart, isEnd ? uvEnd : uvStart, isEnd,
+                       staticGeometry, dynamicGeometry, isEndVertex);
+  };
 
-    glsl::vec2 const p1 = glsl::ToVec2(MapShape::ConvertToLocal(path[i - 1], tileCenter, kShapeCoordScalar));
-    glsl::vec2 const p2 = glsl::ToVec2(MapShape::ConvertToLocal(path[i], tileCenter, kShapeCoordScalar));
-    glsl::vec2 tangent, leftNormal, rightNormal;
-    CalculateTangentAndNormals(p1, p2, tangent, leftNormal, rightNormal);
+  m_splineSegments.Build(path, tileCenter, kShapeCoordScalar);
+  for (size_t i = 0; i < m_splineSegments.GetCount(); ++i)
+  {
+    glsl::vec2 const p1 = m_splineSegments.GetStartPoint(i);
+    glsl::vec2 const p2 = m_splineSegments.GetEndPoint(i);
+    glsl::vec2 leftNormal = m_splineSegments.GetLeftNormal(i);
+    glsl::vec2 rightNormal = m_splineSegments.GetRightNormal(i);
 
     if (isLeftHand)
       std::swap(leftNormal, rightNormal);
 
-    float const maskSize = static_cast<float>((path[i] - path[i - 1]).Length());
+    float const maskSize = m_splineSegments.GetGlobalLength(i);
 
     glsl::vec3 const startPivot = glsl::vec3(p1, depth);
     glsl::vec3 const endPivot = glsl::vec3(p2, depth);
     if (isLeftHand)
     {
-      SubmitStaticVertex(startPivot, leftNormal, 1.0f, 0.0f, uvStart, staticGeometry);
-      SubmitStaticVertex(startPivot, rightNormal, -1.0f, 0.0f, uvStart, staticGeometry);
-      SubmitStaticVertex(endPivot, leftNormal, 1.0f, maskSize, uvEnd, staticGeometry);
-      SubmitStaticVertex(endPivot, leftNormal, 1.0f, maskSize, uvEnd, staticGeometry);
-      SubmitStaticVertex(startPivot, rightNormal, -1.0f, 0.0f, uvStart, staticGeometry);
-      SubmitStaticVertex(endPivot, rightNormal, -1.0f, maskSize, uvEnd, staticGeometry);
+      submitVertex(startPivot, leftNormal, 1.0f, 0.0f, false /* isEnd */);
+      submitVertex(startPivot, rightNormal, -1.0f, 0.0f, false /* isEnd */);
+      submitVertex(endPivot, leftNormal, 1.0f, maskSize, true /* isEnd */);
+      submitVertex(endPivot, leftNormal, 1.0f, maskSize, true /* isEnd */);
+      submitVertex(startPivot, rightNormal, -1.0f, 0.0f, false /* isEnd */);
+      submitVertex(endPivot, rightNormal, -1.0f, maskSize, true /* isEnd */);
     }
     else
     {
-      SubmitStaticVertex(startPivot, rightNormal, -1.0f, 0.0f, uvStart, staticGeometry);
-      SubmitStaticVertex(startPivot, leftNormal, 1.0f, 0.0f, uvStart, staticGeometry);
-      SubmitStaticVertex(endPivot, rightNormal, -1.0f, maskSize, uvEnd, staticGeometry);
-      SubmitStaticVertex(endPivot, rightNormal, -1.0f, maskSize, uvEnd, staticGeometry);
-      SubmitStaticVertex(startPivot, leftNormal, 1.0f, 0.0f, uvStart, staticGeometry);
-      SubmitStaticVertex(endPivot, leftNormal, 1.0f, maskSize, uvEnd, staticGeometry);
+      submitVertex(startPivot, rightNormal, -1.0f, 0.0f, false /* isEnd */);
+      submitVertex(startPivot, leftNormal, 1.0f, 0.0f, false /* isEnd */);
+      submitVertex(endPivot, rightNormal, -1.0f, maskSize, true /* isEnd */);
+      submitVertex(endPivot, rightNormal, -1.0f, maskSize, true /* isEnd */);
+      submitVertex(startPivot, leftNormal, 1.0f, 0.0f, false /* isEnd */);
+      submitVertex(endPivot, leftNormal, 1.0f, maskSize, true /* isEnd */);
     }
 
     if (generateCircles && !firstFilled)
-    {
-      SubmitCircleStaticVertices(roadClass, glsl::vec3(p1, circleDepth), rightNormal,
-                                 uvStart.xy(), circlesGeometry);
-    }
+      SubmitCircleStaticVertices(roadClass, glsl::vec3(p1, circleDepth), rightNormal, circlesGeometry);
 
     firstFilled = true;
     lastRightNormal = rightNormal;
@@ -371,13 +630,13 @@ void TrafficGenerator::GenerateSegment(RoadClass roadClass,
   if (generateCircles && firstFilled)
   {
     SubmitCircleStaticVertices(roadClass, glsl::vec3(lastPoint, circleDepth), lastRightNormal,
-                               uvStart.xy(), circlesGeometry);
+                               circlesGeometry);
   }
 }
 
-void TrafficGenerator::GenerateLineSegment(dp::TextureManager::ColorRegion const & colorRegion,
-                                           m2::PolylineD const & polyline, m2::PointD const & tileCenter,
-                                           float depth, std::vector<TrafficLineStaticVertex> & staticGeometry)
+void TrafficGenerator::GenerateLineSegment(m2::PolylineD const & polyline,
+                                           m2::PointD const & tileCenter, float depth,
+                                           std::vector<TrafficLineStaticVertex> & staticGeometry)
 {
   auto const & path = polyline.GetPoints();
   ASSERT_GREATER(path.size(), 1, ());
@@ -386,11 +645,10 @@ void TrafficGenerator::GenerateLineSegment(dp::TextureManager::ColorRegion const
   staticGeometry.reserve(staticGeometry.size() + kAverageSize);
 
   // Build geometry.
-  glsl::vec2 const uv = glsl::ToVec2(colorRegion.GetTexRect().Center());
   for (size_t i = 0; i < path.size(); ++i)
   {
     glsl::vec2 const p = glsl::ToVec2(MapShape::ConvertToLocal(path[i], tileCenter, kShapeCoordScalar));
-    staticGeometry.emplace_back(glsl::vec3(p, depth), uv);
+    staticGeometry.emplace_back(glsl::vec3(p, depth));
   }
 }
 
@@ -457,4 +715,15 @@ void TrafficGenerator::FillColorsCache(ref_ptr<dp::TextureManager> textures)
     m_colorsCacheValid = true;
   }
 }
+
+TrafficSegmentColor TrafficGenerator::GetSegmentColor(traffic::SpeedGroup speedGroup) const
+{
+  ASSERT(m_colorsCacheValid, ());
+  auto const index = static_cast<size_t>(speedGroup);
+  TrafficSegmentColor color;
+  color.m_texCoord = glsl::ToVec2(m_colorsCache[index].GetTexRect().Center());
+  color.m_vOffset = kCoordVOffsets[index];
+  color.m_minU = kMinCoordU[index];
+  return color;
+}
 }  // namespace df
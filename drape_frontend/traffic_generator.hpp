@@ -2,11 +2,13 @@
 
 #include "drape_frontend/batchers_pool.hpp"
 #include "drape_frontend/color_constants.hpp"
+#include "drape_frontend/line_shape_helper.hpp"
 #include "drape_frontend/render_state_extension.hpp"
 #include "drape_frontend/tile_key.hpp"
 
 #include "drape/color.hpp"
 #include "drape/glsl_types.hpp"
+#include "drape/overlay_handle.hpp"
 #include "drape/render_bucket.hpp"
 #include "drape/texture_manager.hpp"
 
@@ -104,55 +106,108 @@ struct TrafficStaticVertex
 {
   using TPosition = glsl::vec3;
   using TNormal = glsl::vec4;
-  using TTexCoord = glsl::vec4;
 
   TrafficStaticVertex() = default;
-  TrafficStaticVertex(TPosition const & position, TNormal const & normal,
-                      TTexCoord const & colorTexCoord)
+  TrafficStaticVertex(TPosition const & position, TNormal const & normal)
     : m_position(position)
     , m_normal(normal)
-    , m_colorTexCoord(colorTexCoord)
   {}
 
   TPosition m_position;
   TNormal m_normal;
-  TTexCoord m_colorTexCoord;
 };
 
 struct TrafficLineStaticVertex
 {
   using TPosition = glsl::vec3;
-  using TTexCoord = glsl::vec2;
 
   TrafficLineStaticVertex() = default;
-  TrafficLineStaticVertex(TPosition const & position, TTexCoord const & colorTexCoord)
-    : m_position(position)
-    , m_colorTexCoord(colorTexCoord)
-  {}
+  explicit TrafficLineStaticVertex(TPosition const & position) : m_position(position) {}
 
   TPosition m_position;
-  TTexCoord m_colorTexCoord;
 };
 
 struct TrafficCircleStaticVertex
 {
   using TPosition = glsl::vec4;
   using TNormal = glsl::vec4;
-  using TTexCoord = glsl::vec2;
 
   TrafficCircleStaticVertex() = default;
-  TrafficCircleStaticVertex(TPosition const & position, TNormal const & normal,
-                            TTexCoord const & colorTexCoord)
+  TrafficCircleStaticVertex(TPosition const & position, TNormal const & normal)
     : m_position(position)
     , m_normal(normal)
-    , m_colorTexCoord(colorTexCoord)
   {}
 
   TPosition m_position;
   TNormal m_normal;
+};
+
+// Color texture coordinates of traffic vertices are kept in dynamic streams, so recoloring
+// of a segment doesn't require regeneration of its geometry.
+struct TrafficDynamicVertex
+{
+  using TTexCoord = glsl::vec4;
+
+  TrafficDynamicVertex() = default;
+  explicit TrafficDynamicVertex(TTexCoord const & colorTexCoord) : m_colorTexCoord(colorTexCoord) {}
+
+  TTexCoord m_colorTexCoord;
+};
+
+// Dynamic vertex of traffic lines and circles.
+struct TrafficLineDynamicVertex
+{
+  using TTexCoord = glsl::vec2;
+
+  TrafficLineDynamicVertex() = default;
+  explicit TrafficLineDynamicVertex(TTexCoord const & colorTexCoord)
+    : m_colorTexCoord(colorTexCoord)
+  {}
+
   TTexCoord m_colorTexCoord;
 };
 
+// Color of a segment of the speed group: the center of the color region and the coordinates
+// of the arrow in the traffic-arrow texture.
+struct TrafficSegmentColor
+{
+  glsl::vec2 m_texCoord;
+  float m_vOffset = 0.0f;
+  float m_minU = 0.0f;
+};
+
+// Colors of the recolored segments of mwms sorted by segment ids.
+using TrafficSegmentsColors =
+    std::map<MwmSet::MwmId, std::vector<std::pair<traffic::TrafficInfo::RoadSegmentId,
+                                                  TrafficSegmentColor>>>;
+
+// Keeps color texture coordinates of a traffic segment and updates them in the dynamic stream
+// of the render bucket when the segment is recolored.
+class TrafficHandle : public dp::OverlayHandle
+{
+  using TBase = dp::OverlayHandle;
+
+public:
+  // |isEndVertex| marks the vertices of the segment which lie at the ends of arrows.
+  TrafficHandle(traffic::TrafficInfo::RoadSegmentId const & segmentId,
+                TrafficSegmentColor const & color, std::vector<bool> && isEndVertex);
+
+  void GetAttributeMutation(ref_ptr<dp::AttributeBufferMutator> mutator) const override;
+  bool Update(ScreenBase const & screen) override;
+  m2::RectD GetPixelRect(ScreenBase const & screen, bool perspective) const override;
+  void GetPixelShape(ScreenBase const & screen, bool perspective, Rects & rects) const override;
+  bool IndexesRequired() const override;
+
+  traffic::TrafficInfo::RoadSegmentId const & GetSegmentId() const { return m_segmentId; }
+  void SetColor(TrafficSegmentColor const & color);
+
+private:
+  traffic::TrafficInfo::RoadSegmentId const m_segmentId;
+  TrafficSegmentColor m_color;
+  std::vector<bool> const m_isEndVertex;
+  mutable bool m_needUpdate = false;
+};
+
 using TrafficTexCoords = std::unordered_map<size_t, glsl::vec2>;
 
 class TrafficGenerator final
@@ -162,17 +217,36 @@ public:
 
   explicit TrafficGenerator(FlushRenderDataFn flushFn)
     : m_flushRenderDataFn(std::move(flushFn))
-    , m_providerTriangles(1 /* stream count */, 0 /* vertices count*/)
-    , m_providerLines(1 /* stream count */, 0 /* vertices count*/)
-    , m_providerCircles(1 /* stream count */, 0 /* vertices count*/)
+    , m_providerTriangles(2 /* stream count */, 0 /* vertices count*/)
+    , m_providerLines(2 /* stream count */, 0 /* vertices count*/)
+    , m_providerCircles(2 /* stream count */, 0 /* vertices count*/)
   {}
 
   void Init();
   void ClearContextDependentResources();
 
+  using TrafficTilesList = std::vector<std::pair<MwmSet::MwmId, TileKey>>;
+  using CheckTileFn = std::function<bool(TileKey const & tileKey)>;
+
+  // Generates the traffic of the tile and keeps its geometry to regenerate the tile when
+  // the coloring changes.
   void FlushSegmentsGeometry(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKey,
-                             TrafficSegmentsGeometry const & geom, ref_ptr<dp::TextureManager> textures);
-  void UpdateColoring(TrafficSegmentsColoring const & coloring);
+                             TrafficSegmentsGeometry && geom, ref_ptr<dp::TextureManager> textures);
+  // Updates the coloring. The segments which are still rendered but with other colors are
+  // collected to |recoloredSegments|, they are recolored in place. The tiles which contain
+  // the segments appeared or disappeared are collected to |changedTiles|.
+  // Returns false if such tiles are unknown, so the traffic of all the tiles must be regenerated.
+  bool UpdateColoring(TrafficSegmentsColoring const & coloring, TrafficTilesList & changedTiles,
+                      TrafficSegmentsColoring & recoloredSegments);
+  // Returns the colors of the segments to update them in the rendered geometry.
+  TrafficSegmentsColors GetSegmentsColors(TrafficSegmentsColoring const & coloring,
+                                          ref_ptr<dp::TextureManager> textures);
+  // Regenerates the traffic of the mwm in the tile by the kept geometry.
+  void RegenerateTile(ref_ptr<dp::GraphicsContext> context, MwmSet::MwmId const & mwmId,
+                      TileKey const & tileKey, ref_ptr<dp::TextureManager> textures);
+  // Drops the kept geometry of the tiles which are not actual anymore.
+  void RemoveObsoleteTiles(CheckTileFn const & isActualTile);
+  size_t GetGeometryTilesCount() const { return m_tilesGeometry.size(); }
 
   void ClearCache();
   void ClearCache(MwmSet::MwmId const & mwmId);
@@ -211,18 +285,25 @@ private:
     }
   };
 
-  void GenerateSegment(RoadClass roadClass, dp::TextureManager::ColorRegion const & colorRegion,
+  void GenerateSegment(RoadClass roadClass, TrafficSegmentColor const & color,
                        m2::PolylineD const & polyline, m2::PointD const & tileCenter,
-                       bool generateCircles, float depth, float vOffset, float minU,
-                       bool isLeftHand, std::vector<TrafficStaticVertex> & staticGeometry,
+                       bool generateCircles, float depth, bool isLeftHand,
+                       std::vector<TrafficStaticVertex> & staticGeometry,
+                       std::vector<TrafficDynamicVertex> & dynamicGeometry,
+                       std::vector<bool> & isEndVertex,
                        std::vector<TrafficCircleStaticVertex> & circlesGeometry);
-  void GenerateLineSegment(dp::TextureManager::ColorRegion const & colorRegion,
-                           m2::PolylineD const & polyline, m2::PointD const & tileCenter, float depth,
-                           std::vector<TrafficLineStaticVertex> & staticGeometry);
+  void GenerateLineSegment(m2::PolylineD const & polyline, m2::PointD const & tileCenter,
+                           float depth, std::vector<TrafficLineStaticVertex> & staticGeometry);
   void FillColorsCache(ref_ptr<dp::TextureManager> textures);
+  TrafficSegmentColor GetSegmentColor(traffic::SpeedGroup speedGroup) const;
 
   void FlushGeometry(TrafficBatcherKey const & key, dp::RenderState const & state,
                      drape_ptr<dp::RenderBucket> && buffer);
+  void FlushMwmSegmentsGeometry(ref_ptr<dp::GraphicsContext> context, MwmSet::MwmId const & mwmId,
+                                TileKey const & tileKey,
+                                TrafficSegmentsGeometryValue const & geometry,
+                                traffic::TrafficInfo::Coloring const & coloring,
+                                ref_ptr<dp::TextureManager> textures);
   void GenerateSegmentsGeometry(ref_ptr<dp::GraphicsContext> context, MwmSet::MwmId const & mwmId,
                                 TileKey const & tileKey,
                                 TrafficSegmentsGeometryValue const & geometry,
@@ -230,6 +311,10 @@ private:
                                 ref_ptr<dp::TextureManager> texturesMgr);
 
   TrafficSegmentsColoring m_coloring;
+  // Geometry of the generated tiles.
+  std::map<TileKey, TrafficSegmentsGeometry> m_tilesGeometry;
+  // Reused by all segments to avoid allocations.
+  SplineSegments m_splineSegments;
 
   std::array<dp::TextureManager::ColorRegion, static_cast<size_t>(traffic::SpeedGroup::Count)> m_colorsCache;
   bool m_colorsCacheValid = false;
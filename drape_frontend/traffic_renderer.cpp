@@ -256,6 +256,43 @@ void TrafficRenderer::Clear(MwmSet::MwmId const & mwmId)
                                     m_renderData.end());
 }
 
+void TrafficRenderer::Clear(MwmSet::MwmId const & mwmId, TileKey const & tileKey)
+{
+  auto removePredicate = [&mwmId, &tileKey](TrafficRenderData const & data)
+  {
+    return data.m_mwmId == mwmId && data.m_tileKey == tileKey;
+  };
+
+  m_renderData.erase(std::remove_if(m_renderData.begin(), m_renderData.end(), removePredicate),
+                                    m_renderData.end());
+}
+
+void TrafficRenderer::UpdateColors(TrafficSegmentsColors const & colors)
+{
+  using SegmentColor = TrafficSegmentsColors::mapped_type::value_type;
+  for (TrafficRenderData & renderData : m_renderData)
+  {
+    auto const it = colors.find(renderData.m_mwmId);
+    if (it == colors.cend())
+      continue;
+
+    auto const & segmentsColors = it->second;
+    for (size_t i = 0; i < renderData.m_bucket->GetOverlayHandlesCount(); ++i)
+    {
+      ref_ptr<TrafficHandle> handle = renderData.m_bucket->GetOverlayHandle(i);
+      auto const colorIt = std::lower_bound(segmentsColors.cbegin(), segmentsColors.cend(),
+                                            handle->GetSegmentId(),
+                                            [](SegmentColor const & c,
+                                               traffic::TrafficInfo::RoadSegmentId const & id)
+      {
+        return c.first < id;
+      });
+      if (colorIt != segmentsColors.cend() && colorIt->first == handle->GetSegmentId())
+        handle->SetColor(colorIt->second);
+    }
+  }
+}
+
 // static
 float TrafficRenderer::GetTwoWayOffset(RoadClass const & roadClass, int zoomLevel)
 {
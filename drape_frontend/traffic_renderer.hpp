@@ -31,6 +31,9 @@ public:
 
   void ClearContextDependentResources();
   void Clear(MwmSet::MwmId const & mwmId);
+  void Clear(MwmSet::MwmId const & mwmId, TileKey const & tileKey);
+  // Updates colors of the segments in the rendered geometry.
+  void UpdateColors(TrafficSegmentsColors const & colors);
 
   void OnUpdateViewport(CoverageResult const & coverage, int currentZoomLevel,
                         buffer_vector<TileKey, 8> const & tilesToDelete);
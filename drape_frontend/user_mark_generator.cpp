@@ -22,15 +22,37 @@ UserMarkGenerator::UserMarkGenerator(TFlushFn const & flushFn)
 
 void UserMarkGenerator::RemoveGroup(kml::MarkGroupId groupId)
 {
+  MarkGroupTilesChanged(groupId);
   m_groupsVisibility.erase(groupId);
   m_groups.erase(groupId);
-  UpdateIndex(groupId);
+  m_indexedMarks.erase(groupId);
+  for (auto & tileGroups : m_index)
+    tileGroups.second->erase(groupId);
+  CleanIndex();
+}
+
+void UserMarkGenerator::SetGroups(drape_ptr<MarksIDGroups> && groups)
+{
+  if (groups == nullptr)
+    return;
+  for (auto & group : *groups)
+    SetGroup(group.first, std::move(group.second));
+  m_updatedLines.clear();
+  CleanIndex();
 }
 
 void UserMarkGenerator::SetGroup(kml::MarkGroupId groupId, drape_ptr<IDCollections> && ids)
 {
-  m_groups[groupId] = std::move(ids);
-  UpdateIndex(groupId);
+  UpdateMarksIndex(groupId, *ids);
+
+  auto & group = m_groups[groupId];
+  bool linesChanged = group == nullptr || group->m_lineIds != ids->m_lineIds;
+  for (size_t i = 0; i < ids->m_lineIds.size() && !linesChanged; ++i)
+    linesChanged = m_updatedLines.count(ids->m_lineIds[i]) != 0;
+
+  group = std::move(ids);
+  if (linesChanged)
+    UpdateLinesIndex(groupId, *group);
 }
 
 void UserMarkGenerator::SetRemovedUserMarks(drape_ptr<IDCollections> && ids)
@@ -38,9 +60,18 @@ void UserMarkGenerator::SetRemovedUserMarks(drape_ptr<IDCollections> && ids)
   if (ids == nullptr)
     return;
   for (auto const & id : ids->m_markIds)
-    m_marks.erase(id);
+  {
+    auto const it = m_marks.find(id);
+    if (it == m_marks.end())
+      continue;
+    MarkMarkTilesChanged({it->second->m_pivot, it->second->m_minZoom});
+    m_marks.erase(it);
+  }
   for (auto const & id : ids->m_lineIds)
+  {
     m_lines.erase(id);
+    m_updatedLines.insert(id);
+  }
 }
 
 void UserMarkGenerator::SetCreatedUserMarks(drape_ptr<IDCollections> && ids)
@@ -57,9 +88,16 @@ void UserMarkGenerator::SetUserMarks(drape_ptr<UserMarksRenderCollection> && mar
   {
     auto it = m_marks.find(pair.first);
     if (it != m_marks.end())
+    {
+      // New marks are taken into account when they are indexed, the index is also updated for
+      // moved marks. Tiles of marks which stay in place are changed here.
+      MarkMarkTilesChanged({it->second->m_pivot, it->second->m_minZoom});
       it->second = std::move(pair.second);
+    }
     else
+    {
       m_marks.emplace(pair.first, std::move(pair.second));
+    }
   }
 }
 
@@ -67,6 +105,7 @@ void UserMarkGenerator::SetUserLines(drape_ptr<UserLinesRenderCollection> && lin
 {
   for (auto & pair : *lines)
   {
+    m_updatedLines.insert(pair.first);
     auto it = m_lines.find(pair.first);
     if (it != m_lines.end())
       it->second = std::move(pair.second);
@@ -75,36 +114,65 @@ void UserMarkGenerator::SetUserLines(drape_ptr<UserLinesRenderCollection> && lin
   }
 }
 
-void UserMarkGenerator::UpdateIndex(kml::MarkGroupId groupId)
+void UserMarkGenerator::UpdateMarksIndex(kml::MarkGroupId groupId, IDCollections const & ids)
 {
-  for (auto & tileGroups : m_index)
+  auto & positions = m_indexedMarks[groupId];
+
+  // Removed and moved marks are erased from the index at once, so every index tile is
+  // traversed once however many marks are erased from it.
+  TileMarkIds removedMarkIds;
+  std::unordered_set<kml::MarkId> const markIds(ids.m_markIds.begin(), ids.m_markIds.end());
+  for (auto it = positions.begin(); it != positions.end();)
   {
-    auto itGroupIndexes = tileGroups.second->find(groupId);
-    if (itGroupIndexes != tileGroups.second->end())
+    if (markIds.count(it->first) == 0)
     {
-      itGroupIndexes->second->m_markIds.clear();
-      itGroupIndexes->second->m_lineIds.clear();
+      AddMarkTiles(it->first, it->second, removedMarkIds);
+      it = positions.erase(it);
+    }
+    else
+    {
+      ++it;
     }
   }
 
-  auto const groupIt = m_groups.find(groupId);
-  if (groupIt == m_groups.end())
-    return;
+  std::vector<kml::MarkId> addedMarkIds;
+  for (auto markId : ids.m_markIds)
+  {
+    UserMarkRenderParams const & params = *m_marks[markId];
+    MarkPosition const position = {params.m_pivot, params.m_minZoom};
 
-  IDCollections & idCollection = *groupIt->second;
+    auto const it = positions.find(markId);
+    if (it != positions.end())
+    {
+      if (it->second.m_pivot == position.m_pivot && it->second.m_minZoom == position.m_minZoom)
+        continue;
+      AddMarkTiles(markId, it->second, removedMarkIds);
+    }
+    addedMarkIds.push_back(markId);
+    positions[markId] = position;
+  }
 
-  for (auto markId : idCollection.m_markIds)
+  RemoveMarksFromIndex(groupId, removedMarkIds);
+  for (auto markId : addedMarkIds)
+    AddMarkToIndex(groupId, markId, positions[markId]);
+
+  if (positions.empty())
+    m_indexedMarks.erase(groupId);
+}
+
+void UserMarkGenerator::UpdateLinesIndex(kml::MarkGroupId groupId, IDCollections const & ids)
+{
+  for (auto & tileGroups : m_index)
   {
-    UserMarkRenderParams const & params = *m_marks[markId];
-    for (int zoomLevel = params.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
+    auto itGroupIndexes = tileGroups.second->find(groupId);
+    if (itGroupIndexes != tileGroups.second->end() && !itGroupIndexes->second->m_lineIds.empty())
     {
-      TileKey const tileKey = GetTileKeyByPoint(params.m_pivot, zoomLevel);
-      auto groupIDs = GetIdCollection(tileKey, groupId);
-      groupIDs->m_markIds.push_back(markId);
+      itGroupIndexes->second->m_lineIds.clear();
+      m_changedTiles.insert(tileGroups.first);
     }
   }
 
-  for (auto lineId : idCollection.m_lineIds)
+  for (auto lineId : ids.m_lineIds)
   {
     UserLineRenderParams const & params = *m_lines[lineId];
 
@@ -125,13 +193,98 @@ void UserMarkGenerator::UpdateIndex(kml::MarkGroupId groupId)
           TileKey const tileKey(tileX, tileY, zoomLevel);
           auto groupIDs = GetIdCollection(tileKey, groupId);
           groupIDs->m_lineIds.push_back(lineId);
+          m_changedTiles.insert(tileKey);
         });
         return true;
       });
     }
   }
+}
 
-  CleanIndex();
+void UserMarkGenerator::AddMarkToIndex(kml::MarkGroupId groupId, kml::MarkId markId,
+                                       MarkPosition const & position)
+{
+  for (int zoomLevel = position.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
+  {
+    TileKey const tileKey = GetTileKeyByPoint(position.m_pivot, zoomLevel);
+    GetIdCollection(tileKey, groupId)->m_markIds.push_back(markId);
+    m_changedTiles.insert(tileKey);
+  }
+}
+
+// static
+void UserMarkGenerator::AddMarkTiles(kml::MarkId markId, MarkPosition const & position,
+                                     TileMarkIds & tileMarkIds)
+{
+  for (int zoomLevel = position.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
+    tileMarkIds[GetTileKeyByPoint(position.m_pivot, zoomLevel)].insert(markId);
+}
+
+void UserMarkGenerator::RemoveMarksFromIndex(kml::MarkGroupId groupId,
+                                             TileMarkIds const & tileMarkIds)
+{
+  for (auto const & tileMarks : tileMarkIds)
+  {
+    auto const & tileKey = tileMarks.first;
+    auto const & removedIds = tileMarks.second;
+    m_changedTiles.insert(tileKey);
+
+    auto const itTileGroups = m_index.find(tileKey);
+    if (itTileGroups == m_index.end())
+      continue;
+    auto const itGroupIDs = itTileGroups->second->find(groupId);
+    if (itGroupIDs == itTileGroups->second->end())
+      continue;
+
+    auto & markIds = itGroupIDs->second->m_markIds;
+    markIds.erase(std::remove_if(markIds.begin(), markIds.end(),
+                                 [&removedIds](kml::MarkId markId) {
+                                   return removedIds.count(markId) != 0;
+                                 }),
+                  markIds.end());
+  }
+}
+
+void UserMarkGenerator::MarkMarkTilesChanged(MarkPosition const & position)
+{
+  for (int zoomLevel = position.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
+    m_changedTiles.insert(GetTileKeyByPoint(position.m_pivot, zoomLevel));
+}
+
+void UserMarkGenerator::MarkGroupTilesChanged(kml::MarkGroupId groupId)
+{
+  for (auto const & tileGroups : m_index)
+  {
+    if (tileGroups.second->find(groupId) != tileGroups.second->end())
+      m_changedTiles.insert(tileGroups.first);
+  }
+}
+
+bool UserMarkGenerator::IsTileChanged(TileKey const & tileKey) const
+{
+  if (m_allTilesChanged)
+    return true;
+
+  // The same index tiles as in GenerateUserMarksGeometry().
+  auto const clippedTileKey =
+      TileKey(tileKey.m_x, tileKey.m_y, ClipTileZoomByMaxDataZoom(tileKey.m_zoomLevel));
+  if (m_changedTiles.find(clippedTileKey) != m_changedTiles.end())
+    return true;
+
+  bool changed = false;
+  int const lineZoom = GetNearestLineIndexZoom(clippedTileKey.m_zoomLevel);
+  CalcTilesCoverage(clippedTileKey.GetGlobalRect(), lineZoom,
+                    [this, &changed, lineZoom](int tileX, int tileY)
+  {
+    changed |= m_changedTiles.find(TileKey(tileX, tileY, lineZoom)) != m_changedTiles.end();
+  });
+  return changed;
+}
+
+void UserMarkGenerator::ResetChangedTiles()
+{
+  m_changedTiles.clear();
+  m_allTilesChanged = false;
 }
 
 ref_ptr<IDCollections> UserMarkGenerator::GetIdCollection(TileKey const & tileKey, kml::MarkGroupId groupId)
@@ -189,10 +342,10 @@ void UserMarkGenerator::CleanIndex()
 
 void UserMarkGenerator::SetGroupVisibility(kml::MarkGroupId groupId, bool isVisible)
 {
-  if (isVisible)
-    m_groupsVisibility.insert(groupId);
-  else
-    m_groupsVisibility.erase(groupId);
+  bool const changed = isVisible ? m_groupsVisibility.insert(groupId).second
+                                 : m_groupsVisibility.erase(groupId) != 0;
+  if (changed)
+    MarkGroupTilesChanged(groupId);
 }
 
 ref_ptr<MarksIDGroups> UserMarkGenerator::GetUserMarksGroups(TileKey const & tileKey)
@@ -270,7 +423,20 @@ void UserMarkGenerator::CacheUserMarks(ref_ptr<dp::GraphicsContext> context,
     kml::MarkGroupId groupId = groupPair.first;
     if (m_groupsVisibility.find(groupId) == m_groupsVisibility.end())
       continue;
-    df::CacheUserMarks(context, tileKey, textures, groupPair.second->m_markIds, m_marks, batcher);
+
+    auto const & markIds = groupPair.second->m_markIds;
+    if (tileKey.m_zoomLevel > kMaxUserMarksClusteringZoom)
+    {
+      df::CacheUserMarks(context, tileKey, textures, markIds, m_marks, batcher);
+      continue;
+    }
+
+    // Shapes of the clustered marks are not generated on low zoom levels.
+    kml::MarkIdCollection separateMarkIds;
+    UserMarkClusters clusters;
+    ClusterUserMarks(tileKey, markIds, m_marks, separateMarkIds, clusters);
+    df::CacheUserMarks(context, tileKey, textures, separateMarkIds, m_marks, batcher);
+    df::CacheUserMarkClusters(context, tileKey, textures, clusters, m_marks, batcher);
   }
 }
 
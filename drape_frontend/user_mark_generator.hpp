@@ -9,11 +9,12 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace df
 {
-using MarksIDGroups = std::map<kml::MarkGroupId, drape_ptr<IDCollections>>;
 using MarksIndex = std::map<TileKey, drape_ptr<MarksIDGroups>>;
 
 class UserMarkGenerator
@@ -28,15 +29,38 @@ public:
   void SetRemovedUserMarks(drape_ptr<IDCollections> && ids);
   void SetCreatedUserMarks(drape_ptr<IDCollections> && ids);
 
-  void SetGroup(kml::MarkGroupId groupId, drape_ptr<IDCollections> && ids);
+  void SetGroups(drape_ptr<MarksIDGroups> && groups);
   void RemoveGroup(kml::MarkGroupId groupId);
   void SetGroupVisibility(kml::MarkGroupId groupId, bool isVisible);
 
   void GenerateUserMarksGeometry(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKey,
                                  ref_ptr<dp::TextureManager> textures);
 
+  // Tiles which geometry differs from the generated one since the last ResetChangedTiles().
+  // Geometry of other tiles can be kept when user marks are invalidated.
+  bool IsTileChanged(TileKey const & tileKey) const;
+  void ResetChangedTiles();
+
 private:
-  void UpdateIndex(kml::MarkGroupId groupId);
+  struct MarkPosition
+  {
+    m2::PointD m_pivot;
+    int m_minZoom = 1;
+  };
+  using MarkPositions = std::unordered_map<kml::MarkId, MarkPosition>;
+  // Marks to remove from index tiles.
+  using TileMarkIds = std::map<TileKey, std::unordered_set<kml::MarkId>>;
+
+  void SetGroup(kml::MarkGroupId groupId, drape_ptr<IDCollections> && ids);
+  void UpdateMarksIndex(kml::MarkGroupId groupId, IDCollections const & ids);
+  void UpdateLinesIndex(kml::MarkGroupId groupId, IDCollections const & ids);
+  void AddMarkToIndex(kml::MarkGroupId groupId, kml::MarkId markId,
+                      MarkPosition const & position);
+  static void AddMarkTiles(kml::MarkId markId, MarkPosition const & position,
+                           TileMarkIds & tileMarkIds);
+  void RemoveMarksFromIndex(kml::MarkGroupId groupId, TileMarkIds const & tileMarkIds);
+  void MarkMarkTilesChanged(MarkPosition const & position);
+  void MarkGroupTilesChanged(kml::MarkGroupId groupId);
 
   ref_ptr<IDCollections> GetIdCollection(TileKey const & tileKey, kml::MarkGroupId groupId);
   void CleanIndex();
@@ -58,8 +82,16 @@ private:
 
   UserMarksRenderCollection m_marks;
   UserLinesRenderCollection m_lines;
+  // Lines which params were set since their groups were indexed.
+  std::unordered_set<kml::TrackId> m_updatedLines;
 
   MarksIndex m_index;
+  // Positions of marks in |m_index| by groups.
+  std::unordered_map<kml::MarkGroupId, MarkPositions> m_indexedMarks;
+
+  // Index tiles of marks and lines, see IsTileChanged().
+  std::set<TileKey> m_changedTiles;
+  bool m_allTilesChanged = true;
 
   TFlushFn m_flushFn;
 };
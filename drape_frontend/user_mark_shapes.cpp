@@ -22,7 +22,11 @@
 #include "geometry/clipping.hpp"
 #include "geometry/mercator.hpp"
 
+#include "base/math.hpp"
+#include "base/string_utils.hpp"
+
 #include <cmath>
+#include <map>
 #include <vector>
 
 namespace df
@@ -467,6 +471,128 @@ void CacheUserMarks(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKe
   }
 }
 
+void ClusterUserMarks(TileKey const & tileKey, kml::MarkIdCollection const & marksId,
+                      UserMarksRenderCollection const & renderParams,
+                      kml::MarkIdCollection & separateMarksId, UserMarkClusters & clusters)
+{
+  // The tile is split into cells of about 64 pixels.
+  uint32_t constexpr kCellsPerSide = 4;
+
+  separateMarksId.clear();
+  clusters.clear();
+
+  m2::RectD const tileRect = tileKey.GetGlobalRect();
+  auto const getCellCoord = [](double coord, double minCoord, double size)
+  {
+    auto const cell = static_cast<int>((coord - minCoord) / size * kCellsPerSide);
+    return static_cast<uint32_t>(base::clamp(cell, 0, static_cast<int>(kCellsPerSide) - 1));
+  };
+
+  std::map<uint32_t, kml::MarkIdCollection> cells;
+  for (auto const id : marksId)
+  {
+    auto const it = renderParams.find(id);
+    if (it == renderParams.end() || !it->second->m_isVisible)
+      continue;
+
+    UserMarkRenderParams const & renderInfo = *it->second;
+    if (!renderInfo.m_isClusterable || renderInfo.m_symbolNames == nullptr)
+    {
+      separateMarksId.push_back(id);
+      continue;
+    }
+
+    uint32_t const x = getCellCoord(renderInfo.m_pivot.x, tileRect.minX(), tileRect.SizeX());
+    uint32_t const y = getCellCoord(renderInfo.m_pivot.y, tileRect.minY(), tileRect.SizeY());
+    cells[y * kCellsPerSide + x].push_back(id);
+  }
+
+  for (auto const & cell : cells)
+  {
+    auto const & ids = cell.second;
+    if (ids.size() == 1)
+    {
+      separateMarksId.push_back(ids.front());
+      continue;
+    }
+
+    // The cluster is placed at the center of its marks and is represented by the mark with
+    // the highest priority.
+    UserMarkCluster cluster;
+    cluster.m_count = static_cast<uint32_t>(ids.size());
+    m2::PointD pivotsSum(0.0, 0.0);
+    uint16_t maxPriority = 0;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      UserMarkRenderParams const & renderInfo = *renderParams.at(ids[i]);
+      pivotsSum += renderInfo.m_pivot;
+      if (i == 0 || renderInfo.m_priority > maxPriority)
+      {
+        cluster.m_markId = ids[i];
+        maxPriority = renderInfo.m_priority;
+      }
+    }
+    cluster.m_pivot = pivotsSum / static_cast<double>(ids.size());
+    clusters.push_back(cluster);
+  }
+}
+
+void CacheUserMarkClusters(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKey,
+                           ref_ptr<dp::TextureManager> textures, UserMarkClusters const & clusters,
+                           UserMarksRenderCollection const & renderParams, dp::Batcher & batcher)
+{
+  float constexpr kCountTextSize = 12.0f;
+  auto const vs = static_cast<float>(df::VisualParams::Instance().GetVisualScale());
+  m2::PointD const tileCenter = tileKey.GetGlobalRect().Center();
+
+  for (auto const & cluster : clusters)
+  {
+    auto const it = renderParams.find(cluster.m_markId);
+    if (it == renderParams.end())
+      continue;
+
+    UserMarkRenderParams const & renderInfo = *it->second;
+    auto const symbolName = GetSymbolNameForZoomLevel(renderInfo.m_symbolNames, tileKey);
+    if (symbolName.empty())
+      continue;
+
+    uint32_t const overlayIndex = kStartUserMarkOverlayIndex + renderInfo.m_index;
+
+    PoiSymbolViewParams params(renderInfo.m_featureId);
+    params.m_tileCenter = tileCenter;
+    params.m_depthTestEnabled = renderInfo.m_depthTestEnabled;
+    params.m_depth = renderInfo.m_depth;
+    params.m_depthLayer = renderInfo.m_depthLayer;
+    params.m_minVisibleScale = renderInfo.m_minZoom;
+    params.m_specialDisplacement = SpecialDisplacement::UserMark;
+    params.m_specialPriority = renderInfo.m_priority;
+    params.m_symbolName = symbolName;
+    params.m_anchor = renderInfo.m_anchor;
+    PoiSymbolShape(cluster.m_pivot, params, tileKey, overlayIndex).Draw(context, &batcher, textures);
+
+    dp::TextureManager::SymbolRegion region;
+    textures->GetSymbolRegion(symbolName, region);
+
+    TextViewParams textParams;
+    textParams.m_featureID = renderInfo.m_featureId;
+    textParams.m_tileCenter = tileCenter;
+    textParams.m_titleDecl.m_primaryText = strings::to_string(cluster.m_count);
+    textParams.m_titleDecl.m_primaryTextFont =
+        dp::FontDecl(dp::Color::Black(), kCountTextSize * vs, true /* isSdf */, dp::Color::White());
+    textParams.m_titleDecl.m_anchor = dp::Top;
+    textParams.m_depthTestEnabled = renderInfo.m_depthTestEnabled;
+    textParams.m_depth = renderInfo.m_depth;
+    textParams.m_depthLayer = renderInfo.m_depthLayer;
+    textParams.m_minVisibleScale = renderInfo.m_minZoom;
+    textParams.m_specialDisplacement = SpecialDisplacement::UserMark;
+    textParams.m_specialPriority = renderInfo.m_priority;
+    textParams.m_startOverlayRank = dp::OverlayRank1;
+    TextShape(cluster.m_pivot, textParams, tileKey, region.GetPixelSize(),
+              m2::PointF(0.0f, 0.0f) /* symbolOffset */, renderInfo.m_anchor, overlayIndex)
+        .Draw(context, &batcher, textures);
+  }
+}
+
 void ProcessSplineSegmentRects(m2::SharedSpline const & spline, double maxSegmentLength,
                                const std::function<bool(const m2::RectD & segmentRect)> & func)
 {
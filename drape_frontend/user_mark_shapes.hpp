@@ -37,6 +37,7 @@ struct UserMarkRenderParams
   bool m_hasCreationAnimation = false;
   bool m_justCreated = false;
   bool m_isVisible = true;
+  bool m_isClusterable = false;
   FeatureID m_featureId;
 };
 
@@ -80,6 +81,19 @@ struct UserMarkRenderData
 
 using TUserMarksRenderData = std::vector<UserMarkRenderData>;
 
+// Marks are clustered on the zoom levels up to this one.
+int constexpr kMaxUserMarksClusteringZoom = 12;
+
+struct UserMarkCluster
+{
+  // The mark which symbol represents the cluster.
+  kml::MarkId m_markId = 0;
+  m2::PointD m_pivot;
+  uint32_t m_count = 0;
+};
+
+using UserMarkClusters = std::vector<UserMarkCluster>;
+
 void ProcessSplineSegmentRects(m2::SharedSpline const & spline, double maxSegmentLength,
                                std::function<bool(m2::RectD const & segmentRect)> const & func);
 
@@ -87,6 +101,17 @@ void CacheUserMarks(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKe
                     ref_ptr<dp::TextureManager> textures, kml::MarkIdCollection const & marksId,
                     UserMarksRenderCollection & renderParams, dp::Batcher & batcher);
 
+// Splits the marks of the tile into the marks which are rendered separately and clusters of
+// clusterable marks which fall into the same cell of the grid over the tile.
+void ClusterUserMarks(TileKey const & tileKey, kml::MarkIdCollection const & marksId,
+                      UserMarksRenderCollection const & renderParams,
+                      kml::MarkIdCollection & separateMarksId, UserMarkClusters & clusters);
+
+// Caches the symbol of the representative mark and the number of marks for every cluster.
+void CacheUserMarkClusters(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKey,
+                           ref_ptr<dp::TextureManager> textures, UserMarkClusters const & clusters,
+                           UserMarksRenderCollection const & renderParams, dp::Batcher & batcher);
+
 void CacheUserLines(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKey,
                     ref_ptr<dp::TextureManager> textures, kml::TrackIdCollection const & linesId,
                     UserLinesRenderCollection & renderParams, dp::Batcher & batcher);
@@ -13,6 +13,7 @@
 
 #include "geometry/polyline2d.hpp"
 
+#include <map>
 #include <vector>
 
 namespace df
@@ -34,6 +35,8 @@ struct IDCollections
   }
 };
 
+using MarksIDGroups = std::map<kml::MarkGroupId, drape_ptr<IDCollections>>;
+
 class UserPointMark
 {
 public:
@@ -78,6 +81,8 @@ public:
   virtual int GetMinTitleZoom() const = 0;
   virtual FeatureID GetFeatureID() const = 0;
   virtual bool HasCreationAnimation() const = 0;
+  // Marks which are close to each other on low zoom levels are rendered as clusters.
+  virtual bool IsClusterable() const = 0;
   virtual df::ColorConstant GetColorConstant() const = 0;
 
 private:
@@ -1,22 +1,32 @@
 #include "editor/editable_feature_source.hpp"
 
-#include "editor/osm_editor.hpp"
+EditableFeatureSource::EditableFeatureSource(MwmSet::MwmHandle const & handle)
+  : FeatureSource(handle), m_edits(osm::Editor::Instance().GetMwmEdits(handle.GetId()))
+{
+}
 
 FeatureStatus EditableFeatureSource::GetFeatureStatus(uint32_t index) const
 {
-  osm::Editor & editor = osm::Editor::Instance();
-  return editor.GetFeatureStatus(m_handle.GetId(), index);
+  if (!m_edits)
+    return FeatureStatus::Untouched;
+
+  return m_edits->GetFeatureStatus(index);
 }
 
 bool EditableFeatureSource::GetModifiedFeature(uint32_t index, FeatureType & feature) const
 {
-  osm::Editor & editor = osm::Editor::Instance();
-  return editor.GetEditedFeature(m_handle.GetId(), index, feature);
+  if (!m_edits)
+    return false;
+
+  return m_edits->GetEditedFeature(index, feature);
 }
 
 void EditableFeatureSource::ForEachAdditionalFeature(m2::RectD const & rect, int scale,
                                                      std::function<void(uint32_t)> const & fn) const
 {
+  if (!m_edits)
+    return;
+
   osm::Editor & editor = osm::Editor::Instance();
   editor.ForEachCreatedFeature(m_handle.GetId(), fn, rect, scale);
 }
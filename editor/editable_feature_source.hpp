@@ -1,5 +1,7 @@
 #pragma once
 
+#include "editor/osm_editor.hpp"
+
 #include "indexer/feature.hpp"
 #include "indexer/feature_source.hpp"
 #include "indexer/mwm_set.hpp"
@@ -10,16 +12,21 @@
 #include <functional>
 #include <memory>
 
+// Checks features against edits of the mwm made at the moment the source is created.
 class EditableFeatureSource final : public FeatureSource
 {
 public:
-  explicit EditableFeatureSource(MwmSet::MwmHandle const & handle) : FeatureSource(handle) {}
+  explicit EditableFeatureSource(MwmSet::MwmHandle const & handle);
 
   // FeatureSource overrides:
   FeatureStatus GetFeatureStatus(uint32_t index) const override;
   bool GetModifiedFeature(uint32_t index, FeatureType & feature) const override;
   void ForEachAdditionalFeature(m2::RectD const & rect, int scale,
                                 std::function<void(uint32_t)> const & fn) const override;
+
+private:
+  // nullptr if the mwm is not edited.
+  std::shared_ptr<osm::Editor::MwmEdits const> m_edits;
 };
 
 class EditableFeatureSourceFactory : public FeatureSourceFactory
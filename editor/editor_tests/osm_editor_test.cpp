@@ -434,6 +434,63 @@ void EditorTest::GetFeatureStatusTest()
   TEST_EQUAL(editor.GetFeatureStatus(emo.GetID()), FeatureStatus::Created, ());
 }
 
+void EditorTest::GetMwmEditsTest()
+{
+  auto & editor = osm::Editor::Instance();
+
+  auto const mwmId = ConstructTestMwm([](TestMwmBuilder & builder)
+  {
+    TestCafe cafe(m2::PointD(1.0, 1.0), "London Cafe", "en");
+    TestCafe unnamedCafe(m2::PointD(2.0, 2.0), "", "en");
+
+    builder.Add(cafe);
+    builder.Add(unnamedCafe);
+  });
+
+  TEST(!editor.GetMwmEdits(mwmId), ());
+
+  FeatureID cafeId;
+  ForEachCafeAtPoint(m_dataSource, m2::PointD(1.0, 1.0), [&editor, &cafeId](FeatureType & ft)
+  {
+    cafeId = ft.GetID();
+    osm::EditableMapObject emo;
+    FillEditableMapObject(editor, ft, emo);
+    emo.SetBuildingLevels("1");
+    TEST_EQUAL(editor.SaveEditedFeature(emo), osm::Editor::SaveResult::SavedSuccessfully, ());
+  });
+
+  FeatureID unnamedCafeId;
+  ForEachCafeAtPoint(m_dataSource, m2::PointD(2.0, 2.0), [&unnamedCafeId](FeatureType & ft)
+  {
+    unnamedCafeId = ft.GetID();
+  });
+
+  auto const edits = editor.GetMwmEdits(mwmId);
+  TEST(edits, ());
+  TEST(edits == editor.GetMwmEdits(mwmId), ());
+  TEST_EQUAL(edits->GetFeatureStatus(cafeId.m_index), FeatureStatus::Modified, ());
+  TEST_EQUAL(edits->GetFeatureStatus(unnamedCafeId.m_index), FeatureStatus::Untouched, ());
+
+  FeatureType feature;
+  TEST(edits->GetEditedFeature(cafeId.m_index, feature), ());
+  TEST_EQUAL(feature.GetMetadata().Get(feature::Metadata::FMD_BUILDING_LEVELS), "1", ());
+  TEST(!edits->GetEditedFeature(unnamedCafeId.m_index, feature), ());
+
+  editor.DeleteFeature(unnamedCafeId);
+  osm::EditableMapObject emo;
+  CreateCafeAtPoint({1.5, 1.5}, mwmId, emo);
+
+  // Old edits are not changed.
+  TEST_EQUAL(edits->GetFeatureStatus(unnamedCafeId.m_index), FeatureStatus::Untouched, ());
+  TEST_EQUAL(edits->GetFeatureStatus(emo.GetID().m_index), FeatureStatus::Untouched, ());
+
+  auto const newEdits = editor.GetMwmEdits(mwmId);
+  TEST(newEdits, ());
+  TEST_EQUAL(newEdits->GetFeatureStatus(cafeId.m_index), FeatureStatus::Modified, ());
+  TEST_EQUAL(newEdits->GetFeatureStatus(unnamedCafeId.m_index), FeatureStatus::Deleted, ());
+  TEST_EQUAL(newEdits->GetFeatureStatus(emo.GetID().m_index), FeatureStatus::Created, ());
+}
+
 void EditorTest::IsFeatureUploadedTest()
 {
   auto & editor = osm::Editor::Instance();
@@ -1394,4 +1451,6 @@ UNIT_CLASS_TEST(EditorTest, SaveEditedFeatureTest)
 }
 
 UNIT_CLASS_TEST(EditorTest, SaveTransactionTest) { EditorTest::SaveTransactionTest(); }
+
+UNIT_CLASS_TEST(EditorTest, GetMwmEditsTest) { EditorTest::GetMwmEditsTest(); }
 }  // namespace
@@ -43,6 +43,7 @@ public:
   void LoadMapEditsTest();
   void SaveEditedFeatureTest();
   void SaveTransactionTest();
+  void GetMwmEditsTest();
 
 private:
   template <typename TBuildFn>
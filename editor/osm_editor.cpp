@@ -348,6 +348,33 @@ FeatureStatus Editor::GetFeatureStatus(FeatureID const & fid) const
   return GetFeatureStatusImpl(*features, fid.m_mwmId, fid.m_index);
 }
 
+shared_ptr<Editor::MwmEdits const> Editor::GetMwmEdits(MwmSet::MwmId const & mwmId) const
+{
+  auto const features = m_features.Get();
+  // Most popular case optimization.
+  if (features->empty())
+    return nullptr;
+
+  lock_guard<mutex> lock(m_mwmEditsMutex);
+  if (m_mwmEditsSource != features)
+  {
+    m_mwmEditsSource = features;
+    m_mwmEdits.clear();
+  }
+
+  auto const it = m_mwmEdits.find(mwmId);
+  if (it != m_mwmEdits.cend())
+    return it->second;
+
+  shared_ptr<MwmEdits const> edits;
+  auto const matchedMwm = features->find(mwmId);
+  if (matchedMwm != features->cend() && !matchedMwm->second.empty())
+    edits = make_shared<MwmEdits>(features, matchedMwm->second);
+
+  m_mwmEdits.emplace(mwmId, edits);
+  return edits;
+}
+
 bool Editor::IsFeatureUploaded(MwmSet::MwmId const & mwmId, uint32_t index) const
 {
   auto const features = m_features.Get();
@@ -1310,6 +1337,57 @@ bool Editor::IsFeatureUploadedImpl(FeaturesContainer const & features, MwmSet::M
   return info && info->m_uploadStatus == kUploaded;
 }
 
+// Editor::MwmEdits -------------------------------------------------------------------------------
+Editor::MwmEdits::MwmEdits(shared_ptr<FeaturesContainer const> const & features,
+                           map<uint32_t, FeatureTypeInfo> const & mwmFeatures)
+  : m_features(features), m_mwmFeatures(mwmFeatures)
+{
+  for (auto const & indexAndInfo : m_mwmFeatures)
+  {
+    auto const index = indexAndInfo.first;
+    if (feature::FakeFeatureIds::IsEditorCreatedFeature(index))
+      continue;
+
+    if (index >= m_edited.size())
+      m_edited.resize(index + 1, false);
+    m_edited[index] = true;
+  }
+}
+
+FeatureStatus Editor::MwmEdits::GetFeatureStatus(uint32_t index) const
+{
+  auto const * featureInfo = Find(index);
+  if (featureInfo == nullptr)
+    return FeatureStatus::Untouched;
+
+  return featureInfo->m_status;
+}
+
+bool Editor::MwmEdits::GetEditedFeature(uint32_t index, FeatureType & outFeature) const
+{
+  auto const * featureInfo = Find(index);
+  if (featureInfo == nullptr)
+    return false;
+
+  outFeature = featureInfo->m_feature;
+  return true;
+}
+
+Editor::FeatureTypeInfo const * Editor::MwmEdits::Find(uint32_t index) const
+{
+  if (!feature::FakeFeatureIds::IsEditorCreatedFeature(index) &&
+      (index >= m_edited.size() || !m_edited[index]))
+  {
+    return nullptr;
+  }
+
+  auto const it = m_mwmFeatures.find(index);
+  if (it == m_mwmFeatures.cend())
+    return nullptr;
+
+  return &it->second;
+}
+
 const char * const Editor::kPlaceDoesNotExistMessage =
     "The place has gone or never existed. This is an auto-generated note from MAPS.ME application: "
     "a user reports a POI that is visible on a map (which can be outdated), but cannot be found on "
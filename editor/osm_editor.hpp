@@ -21,6 +21,7 @@
 #include "std/ctime.hpp"
 #include "std/function.hpp"
 #include "std/map.hpp"
+#include "std/mutex.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 
@@ -130,6 +131,12 @@ public:
   FeatureStatus GetFeatureStatus(MwmSet::MwmId const & mwmId, uint32_t index) const;
   FeatureStatus GetFeatureStatus(FeatureID const & fid) const;
 
+  class MwmEdits;
+  /// @returns edits of the mwm at the moment of the call or nullptr if the mwm is not edited.
+  /// The edits are not changed by later calls of the editor, so readers may keep them to check
+  /// many features without any synchronization.
+  shared_ptr<MwmEdits const> GetMwmEdits(MwmSet::MwmId const & mwmId) const;
+
   /// @returns true if a feature was uploaded to osm.
   bool IsFeatureUploaded(MwmSet::MwmId const & mwmId, uint32_t index) const;
 
@@ -256,6 +263,11 @@ private:
   /// Deleted, edited and created features.
   base::AtomicSharedPtr<FeaturesContainer> m_features;
 
+  /// Edits of mwms made of |m_mwmEditsSource| by GetMwmEdits().
+  mutable mutex m_mwmEditsMutex;
+  mutable shared_ptr<FeaturesContainer const> m_mwmEditsSource;
+  mutable map<MwmSet::MwmId, shared_ptr<MwmEdits const>> m_mwmEdits;
+
   unique_ptr<Delegate> m_delegate;
 
   /// Invalidate map viewport after edits.
@@ -275,5 +287,27 @@ private:
   DECLARE_THREAD_CHECKER(MainThreadChecker);
 };  // class Editor
 
+// Edits of one mwm. Features which are not edited are told apart by a single bit test.
+class Editor::MwmEdits
+{
+public:
+  MwmEdits(shared_ptr<FeaturesContainer const> const & features,
+           map<uint32_t, FeatureTypeInfo> const & mwmFeatures);
+
+  FeatureStatus GetFeatureStatus(uint32_t index) const;
+  /// @returns false if feature wasn't edited.
+  bool GetEditedFeature(uint32_t index, FeatureType & outFeature) const;
+
+private:
+  FeatureTypeInfo const * Find(uint32_t index) const;
+
+  // Keeps |m_mwmFeatures| alive.
+  shared_ptr<FeaturesContainer const> m_features;
+  map<uint32_t, FeatureTypeInfo> const & m_mwmFeatures;
+  // A bit per feature of the mwm file. Features created by the editor are not in the file,
+  // they are looked up in |m_mwmFeatures|.
+  vector<bool> m_edited;
+};
+
 string DebugPrint(Editor::SaveResult const saveResult);
 }  // namespace osm
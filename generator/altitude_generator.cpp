@@ -28,6 +28,8 @@
 #include "defines.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -45,16 +47,33 @@ using namespace routing;
 class SrtmGetter : public AltitudeGetter
 {
 public:
-  SrtmGetter(std::string const & srtmDir) : m_srtmManager(srtmDir) {}
+  SrtmGetter(SrtmParams const & params)
+    : m_srtmManager(params.m_dir, params.m_cacheDir, params.m_maxTilesCount)
+    , m_bilinear(params.m_bilinear)
+  {
+  }
 
   // AltitudeGetter overrides:
   feature::TAltitude GetAltitude(m2::PointD const & p) override
   {
-    return m_srtmManager.GetHeight(MercatorBounds::ToLatLon(p));
+    std::vector<feature::TAltitude> altitudes;
+    GetAltitudes({p}, altitudes);
+    return altitudes.front();
+  }
+
+  void GetAltitudes(std::vector<m2::PointD> const & points,
+                    feature::TAltitudes & altitudes) override
+  {
+    std::vector<ms::LatLon> coords;
+    coords.reserve(points.size());
+    for (auto const & p : points)
+      coords.push_back(MercatorBounds::ToLatLon(p));
+    m_srtmManager.GetHeights(coords, m_bilinear, altitudes);
   }
 
 private:
   generator::SrtmTileManager m_srtmManager;
+  bool const m_bilinear;
 };
 
 class Processor
@@ -88,17 +107,15 @@ public:
 
   TAltitude GetMinAltitude() const { return m_minAltitude; }
 
+  // Collects the points of the roads, altitudes are calculated by CalcAltitudes().
   void operator()(FeatureType & f, uint32_t const & id)
   {
-    if (id != m_altitudeAvailabilityBuilder.size())
+    if (id != m_featuresCount)
     {
       LOG(LERROR, ("There's a gap in feature id order."));
       return;
     }
-
-    bool hasAltitude = false;
-    SCOPE_GUARD(altitudeAvailabilityBuilding,
-                [&]() { m_altitudeAvailabilityBuilder.push_back(hasAltitude); });
+    ++m_featuresCount;
 
     if (!routing::IsRoad(feature::TypesHolder(f)))
       return;
@@ -108,32 +125,60 @@ public:
     if (pointsCount == 0)
       return;
 
-    TAltitudes altitudes;
-    TAltitude minFeatureAltitude = kInvalidAltitude;
+    m_roads.emplace_back();
+    auto & road = m_roads.back();
+    road.m_featureId = id;
+    road.m_points.reserve(pointsCount);
     for (size_t i = 0; i < pointsCount; ++i)
+      road.m_points.push_back(f.GetPoint(i));
+  }
+
+  // Calculates altitudes of the collected roads on |threadsCount| threads.
+  void CalcAltitudes(size_t threadsCount)
+  {
+    CHECK_GREATER(threadsCount, 0, ());
+
+    std::vector<TAltitudes> altitudes(m_roads.size());
+    std::atomic<size_t> next(0);
+    auto const calc = [&]() {
+      for (size_t i = next++; i < m_roads.size(); i = next++)
+        m_altitudeGetter.GetAltitudes(m_roads[i].m_points, altitudes[i]);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadsCount; ++i)
+      threads.emplace_back(calc);
+    calc();
+    for (auto & thread : threads)
+      thread.join();
+
+    std::vector<bool> hasAltitude(m_featuresCount, false);
+    for (size_t i = 0; i < m_roads.size(); ++i)
     {
-      TAltitude const a = m_altitudeGetter.GetAltitude(f.GetPoint(i));
-      if (a == kInvalidAltitude)
+      auto & roadAltitudes = altitudes[i];
+      CHECK_EQUAL(roadAltitudes.size(), m_roads[i].m_points.size(), ());
+
+      // One invalid point invalidates the whole feature.
+      if (std::find(roadAltitudes.cbegin(), roadAltitudes.cend(), kInvalidAltitude) !=
+          roadAltitudes.cend())
       {
-        // One invalid point invalidates the whole feature.
-        return;
+        continue;
       }
 
-      if (minFeatureAltitude == kInvalidAltitude)
-        minFeatureAltitude = a;
+      TAltitude const minFeatureAltitude =
+          *std::min_element(roadAltitudes.cbegin(), roadAltitudes.cend());
+      if (m_minAltitude == kInvalidAltitude)
+        m_minAltitude = minFeatureAltitude;
       else
-        minFeatureAltitude = std::min(minFeatureAltitude, a);
+        m_minAltitude = std::min(minFeatureAltitude, m_minAltitude);
 
-      altitudes.push_back(a);
+      hasAltitude[m_roads[i].m_featureId] = true;
+      m_featureAltitudes.emplace_back(m_roads[i].m_featureId, Altitudes(std::move(roadAltitudes)));
     }
 
-    hasAltitude = true;
-    m_featureAltitudes.emplace_back(id, Altitudes(std::move(altitudes)));
-
-    if (m_minAltitude == kInvalidAltitude)
-      m_minAltitude = minFeatureAltitude;
-    else
-      m_minAltitude = std::min(minFeatureAltitude, m_minAltitude);
+    for (bool const has : hasAltitude)
+      m_altitudeAvailabilityBuilder.push_back(has);
+    m_roads.clear();
   }
 
   bool HasAltitudeInfo() const { return !m_featureAltitudes.empty(); }
@@ -145,7 +190,15 @@ public:
   }
 
 private:
+  struct Road
+  {
+    uint32_t m_featureId = 0;
+    std::vector<m2::PointD> m_points;
+  };
+
   AltitudeGetter & m_altitudeGetter;
+  uint32_t m_featuresCount = 0;
+  std::vector<Road> m_roads;
   TFeatureAltitudes m_featureAltitudes;
   succinct::bit_vector_builder m_altitudeAvailabilityBuilder;
   TAltitude m_minAltitude;
@@ -154,13 +207,15 @@ private:
 
 namespace routing
 {
-void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter)
+void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter,
+                        size_t threadsCount)
 {
   try
   {
     // Preparing altitude information.
     Processor processor(altitudeGetter);
     feature::ForEachFromDat(mwmPath, processor);
+    processor.CalcAltitudes(threadsCount);
 
     if (!processor.HasAltitudeInfo())
     {
@@ -235,8 +290,17 @@ void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGe
 
 void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir)
 {
-  LOG(LINFO, ("mwmPath =", mwmPath, "srtmDir =", srtmDir));
-  SrtmGetter srtmGetter(srtmDir);
-  BuildRoadAltitudes(mwmPath, srtmGetter);
+  SrtmParams params;
+  params.m_dir = srtmDir;
+  BuildRoadAltitudes(mwmPath, params, 1 /* threadsCount */);
+}
+
+void BuildRoadAltitudes(std::string const & mwmPath, SrtmParams const & params,
+                        size_t threadsCount)
+{
+  LOG(LINFO, ("mwmPath =", mwmPath, "srtmDir =", params.m_dir, "srtmCacheDir =",
+              params.m_cacheDir, "threads =", threadsCount));
+  SrtmGetter srtmGetter(params);
+  BuildRoadAltitudes(mwmPath, srtmGetter, threadsCount);
 }
 }  // namespace routing
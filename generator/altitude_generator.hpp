@@ -4,7 +4,9 @@
 
 #include "indexer/feature_altitude.hpp"
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace routing
 {
@@ -12,6 +14,27 @@ class AltitudeGetter
 {
 public:
   virtual feature::TAltitude GetAltitude(m2::PointD const & p) = 0;
+
+  // Fills |altitudes| with altitudes of the points of a road.
+  virtual void GetAltitudes(std::vector<m2::PointD> const & points,
+                            feature::TAltitudes & altitudes)
+  {
+    altitudes.clear();
+    for (auto const & p : points)
+      altitudes.push_back(GetAltitude(p));
+  }
+};
+
+struct SrtmParams
+{
+  // Directory with zipped SRTM tiles.
+  std::string m_dir;
+  // When not empty, tiles are unzipped to this directory once and are memory mapped.
+  std::string m_cacheDir;
+  // When positive, at most this number of tiles are kept in memory.
+  size_t m_maxTilesCount = 0;
+  // Altitudes are interpolated by the nearest SRTM samples instead of taking one sample.
+  bool m_bilinear = false;
 };
 
 /// \brief Adds altitude section to mwm. It has the following format:
@@ -24,6 +47,11 @@ public:
 /// 16                  altitude availability feat. table offset - 16
 /// feat. table offset  feature table         alt. info offset - feat. table offset
 /// alt. info offset    altitude info         end of section - alt. info offset
-void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter);
+/// \note When |threadsCount| is greater than one, altitudes of roads are got from
+/// |altitudeGetter| on several threads, so it should be thread safe.
+void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter,
+                        size_t threadsCount = 1);
 void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir);
+void BuildRoadAltitudes(std::string const & mwmPath, SrtmParams const & params,
+                        size_t threadsCount);
 }  // namespace routing
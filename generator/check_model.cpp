@@ -6,40 +6,286 @@
 #include "indexer/classificator.hpp"
 #include "indexer/feature_visibility.hpp"
 
+#include "coding/file_container.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/sha1.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
 
 using namespace feature;
+using namespace std;
+
+namespace
+{
+uint8_t const kChecksumsVersion = 0;
+// Features are handed to threads by blocks to keep reading of every thread sequential.
+uint32_t const kFeaturesBlockSize = 1024;
+
+struct SectionChecksum
+{
+  string m_tag;
+  uint64_t m_size = 0;
+  coding::SHA1::Hash m_hash = {};
+};
+
+// Calls |fn(i)| for all i in [0, count) on |threadsCount| threads.
+void ForEachIndex(size_t count, size_t threadsCount, function<void(size_t)> const & fn)
+{
+  threadsCount = max(min(threadsCount, count), size_t(1));
+  if (threadsCount == 1)
+  {
+    for (size_t i = 0; i < count; ++i)
+      fn(i);
+    return;
+  }
+
+  atomic<size_t> next(0);
+  vector<thread> threads;
+  for (size_t i = 0; i < threadsCount; ++i)
+  {
+    threads.emplace_back([&]() {
+      for (size_t j = next++; j < count; j = next++)
+        fn(j);
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+}
+
+void CheckFeature(Classificator const & c, FeatureType & ft)
+{
+  TypesHolder types(ft);
+
+  vector<uint32_t> vTypes;
+  for (uint32_t t : types)
+  {
+    CHECK_EQUAL(c.GetTypeForIndex(c.GetIndexForType(t)), t, ());
+    vTypes.push_back(t);
+  }
+
+  sort(vTypes.begin(), vTypes.end());
+  CHECK(unique(vTypes.begin(), vTypes.end()) == vTypes.end(), ());
+
+  m2::RectD const r = ft.GetLimitRect(FeatureType::BEST_GEOMETRY);
+  CHECK(r.IsValid(), ());
+
+  EGeomType const type = ft.GetFeatureType();
+  if (type == GEOM_LINE)
+    CHECK_GREATER(ft.GetPointsCount(), 1, ());
+
+  IsDrawableLike(vTypes, ft.GetFeatureType());
+}
+
+// Calculates checksums of all sections of |fName| except the checksums one, sorted by tags.
+vector<SectionChecksum> CalculateChecksums(string const & fName, size_t threadsCount)
+{
+  vector<SectionChecksum> checksums;
+  {
+    FilesContainerR const cont(fName);
+    cont.ForEachTag([&](FilesContainerR::Tag const & tag) {
+      if (tag == CHECKSUMS_FILE_TAG)
+        return;
+      SectionChecksum checksum;
+      checksum.m_tag = tag;
+      checksum.m_size = cont.GetAbsoluteOffsetAndSize(tag).second;
+      checksums.push_back(checksum);
+    });
+  }
+  sort(checksums.begin(), checksums.end(),
+       [](SectionChecksum const & lhs, SectionChecksum const & rhs) { return lhs.m_tag < rhs.m_tag; });
+
+  FilesMappingContainer const cont(fName);
+  ForEachIndex(checksums.size(), threadsCount, [&](size_t i) {
+    auto & checksum = checksums[i];
+    coding::SHA1 sha1;
+    if (checksum.m_size != 0)
+    {
+      auto const handle = cont.Map(checksum.m_tag);
+      sha1.Update(handle.GetData<uint8_t>(), static_cast<size_t>(handle.GetSize()));
+    }
+    checksum.m_hash = sha1.Final();
+  });
+  return checksums;
+}
+
+// Checks that sections of |fName| are inside the file and don't overlap.
+bool CheckLayout(string const & fName)
+{
+  FilesContainerR const cont(fName);
+  vector<pair<uint64_t, uint64_t>> sections;
+  bool ok = true;
+  cont.ForEachTag([&](FilesContainerR::Tag const & tag) {
+    auto const offsetAndSize = cont.GetAbsoluteOffsetAndSize(tag);
+    if (offsetAndSize.first + offsetAndSize.second > cont.GetFileSize())
+    {
+      LOG(LWARNING, ("Section", tag, "is out of file", fName));
+      ok = false;
+    }
+    sections.emplace_back(offsetAndSize.first, offsetAndSize.first + offsetAndSize.second);
+  });
+
+  sort(sections.begin(), sections.end());
+  for (size_t i = 1; i < sections.size(); ++i)
+  {
+    if (sections[i].first < sections[i - 1].second)
+    {
+      LOG(LWARNING, ("Sections overlap in", fName, "at offset", sections[i].first));
+      ok = false;
+    }
+  }
+  return ok;
+}
+}  // namespace
 
 namespace check_model
 {
-  void ReadFeatures(std::string const & fName)
+  void ReadFeatures(std::string const & fName, size_t threadsCount)
   {
     Classificator const & c = classif();
 
-    FeaturesVectorTest(fName).GetVector().ForEach([&](FeatureType & ft, uint32_t) {
-      TypesHolder types(ft);
+    size_t const featuresCount = FeaturesVectorTest(fName).GetVector().GetNumFeatures();
+    size_t const blocksCount = (featuresCount + kFeaturesBlockSize - 1) / kFeaturesBlockSize;
+    threadsCount = max(min(threadsCount, blocksCount), size_t(1));
+
+    // Every thread reads features with its own vector.
+    vector<unique_ptr<FeaturesVectorTest>> vectors;
+    for (size_t i = 0; i < threadsCount; ++i)
+      vectors.push_back(make_unique<FeaturesVectorTest>(fName));
 
-      vector<uint32_t> vTypes;
-      for (uint32_t t : types)
+    atomic<size_t> nextBlock(0);
+    vector<thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+      threads.emplace_back([&, i]() {
+        auto const & features = vectors[i]->GetVector();
+        FeatureType ft;
+        for (size_t block = nextBlock++; block < blocksCount; block = nextBlock++)
+        {
+          size_t const end = min(featuresCount, (block + 1) * kFeaturesBlockSize);
+          for (size_t index = block * kFeaturesBlockSize; index < end; ++index)
+          {
+            features.GetByIndex(static_cast<uint32_t>(index), ft);
+            CheckFeature(c, ft);
+          }
+        }
+      });
+    }
+    for (auto & t : threads)
+      t.join();
+
+    LOG(LINFO, ("OK"));
+  }
+
+  bool WriteSectionsChecksums(std::string const & fName, size_t threadsCount)
+  {
+    try
+    {
+      auto const checksums = CalculateChecksums(fName, threadsCount);
+
+      vector<uint8_t> buffer;
+      MemWriter<vector<uint8_t>> writer(buffer);
+      WriteToSink(writer, kChecksumsVersion);
+      WriteVarUint(writer, checksums.size());
+      for (auto const & checksum : checksums)
       {
-        CHECK_EQUAL(c.GetTypeForIndex(c.GetIndexForType(t)), t, ());
-        vTypes.push_back(t);
+        rw::Write(writer, checksum.m_tag);
+        WriteVarUint(writer, checksum.m_size);
+        writer.Write(checksum.m_hash.data(), checksum.m_hash.size());
       }
 
-      sort(vTypes.begin(), vTypes.end());
-      CHECK(unique(vTypes.begin(), vTypes.end()) == vTypes.end(), ());
+      FilesContainerW cont(fName, FileWriter::OP_WRITE_EXISTING);
+      cont.Write(buffer, CHECKSUMS_FILE_TAG);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LERROR, ("Can't write checksums of", fName, e.Msg()));
+      return false;
+    }
+    return true;
+  }
 
-      m2::RectD const r = ft.GetLimitRect(FeatureType::BEST_GEOMETRY);
-      CHECK(r.IsValid(), ());
+  bool CheckSections(std::string const & fName, size_t threadsCount)
+  {
+    try
+    {
+      if (!CheckLayout(fName))
+        return false;
 
-      EGeomType const type = ft.GetFeatureType();
-      if (type == GEOM_LINE)
-        CHECK_GREATER(ft.GetPointsCount(), 1, ());
+      vector<SectionChecksum> expected;
+      {
+        FilesContainerR const cont(fName);
+        if (!cont.IsExist(CHECKSUMS_FILE_TAG))
+        {
+          LOG(LINFO, ("No checksums in", fName, "only layout of sections is checked."));
+          return true;
+        }
 
-      IsDrawableLike(vTypes, ft.GetFeatureType());
-    });
+        ReaderSource<FilesContainerR::TReader> src(cont.GetReader(CHECKSUMS_FILE_TAG));
+        auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+        if (version != kChecksumsVersion)
+        {
+          LOG(LWARNING, ("Unknown version of checksums:", version, "in", fName));
+          return false;
+        }
 
-    LOG(LINFO, ("OK"));
+        expected.resize(ReadVarUint<uint64_t>(src));
+        for (auto & checksum : expected)
+        {
+          rw::Read(src, checksum.m_tag);
+          checksum.m_size = ReadVarUint<uint64_t>(src);
+          src.Read(checksum.m_hash.data(), checksum.m_hash.size());
+        }
+      }
+
+      auto const actual = CalculateChecksums(fName, threadsCount);
+      bool ok = true;
+      size_t i = 0;
+      size_t j = 0;
+      while (i < expected.size() || j < actual.size())
+      {
+        if (j == actual.size() || (i < expected.size() && expected[i].m_tag < actual[j].m_tag))
+        {
+          LOG(LWARNING, ("Section", expected[i].m_tag, "is missing in", fName));
+          ok = false;
+          ++i;
+        }
+        else if (i == expected.size() || actual[j].m_tag < expected[i].m_tag)
+        {
+          LOG(LWARNING, ("Section", actual[j].m_tag, "has no checksum in", fName));
+          ok = false;
+          ++j;
+        }
+        else
+        {
+          if (expected[i].m_size != actual[j].m_size || expected[i].m_hash != actual[j].m_hash)
+          {
+            LOG(LWARNING, ("Section", actual[j].m_tag, "of", fName, "is damaged."));
+            ok = false;
+          }
+          ++i;
+          ++j;
+        }
+      }
+
+      if (ok)
+        LOG(LINFO, ("OK"));
+      return ok;
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't check sections of", fName, e.Msg()));
+      return false;
+    }
   }
 }
@@ -1,7 +1,17 @@
 #pragma once
+#include <cstddef>
 #include <string>
 
 namespace check_model
 {
-  void ReadFeatures(std::string const & fName);
+  /// Checks all features of |fName|, the features are split between |threadsCount| threads.
+  void ReadFeatures(std::string const & fName, size_t threadsCount = 1);
+
+  /// Writes sizes and SHA1 hashes of all the other sections of |fName| to the checksums
+  /// section. Should be called after all the sections are written.
+  bool WriteSectionsChecksums(std::string const & fName, size_t threadsCount = 1);
+
+  /// Fast check of |fName| without parsing of features: checks that sections are inside the file
+  /// and don't overlap, and compares the sections with their checksums if they are written.
+  bool CheckSections(std::string const & fName, size_t threadsCount = 1);
 }
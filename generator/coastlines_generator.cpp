@@ -2,15 +2,23 @@
 
 #include "generator/feature_builder.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/point_to_integer.hpp"
 #include "coding/pointd_to_pointu.hpp"
 
 #include "geometry/region2d/binary_operators.hpp"
 
+#include "base/checked_cast.hpp"
 #include "base/string_utils.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <queue>
 #include <thread>
 #include <utility>
 
@@ -20,13 +28,33 @@ using RegionT = m2::RegionI;
 using PointT = m2::PointI;
 using RectT = m2::RectI;
 
-CoastlineFeaturesGenerator::CoastlineFeaturesGenerator(uint32_t coastType)
-  : m_merger(POINT_COORD_BITS), m_coastType(coastType)
+CoastlineFeaturesGenerator::CoastlineFeaturesGenerator(uint32_t coastType,
+                                                       string const & waysFile)
+  : m_coastType(coastType), m_waysFile(waysFile), m_waysWriter(make_unique<FileWriter>(waysFile))
 {
 }
 
+CoastlineFeaturesGenerator::~CoastlineFeaturesGenerator()
+{
+  m_waysWriter.reset();
+  base::DeleteFileX(m_waysFile);
+}
+
 namespace
 {
+  // Several buckets per thread balance the threads when sizes of buckets differ.
+  size_t constexpr kBucketsPerThread = 4;
+
+  size_t GetThreadsCount()
+  {
+    size_t const threadsCount = thread::hardware_concurrency();
+    CHECK_GREATER(threadsCount, 0, ("Not supported platform"));
+    return threadsCount;
+  }
+
+  // The same key as FeatureMergeProcessor uses to join ways.
+  int64_t GetKey(m2::PointD const & p) { return PointToInt64Obsolete(p, POINT_COORD_BITS); }
+
   m2::RectD GetLimitRect(RegionT const & rgn)
   {
     RectT r = rgn.GetRect();
@@ -82,6 +110,7 @@ void CoastlineFeaturesGenerator::AddRegionToTree(FeatureBuilder1 const & fb)
 {
   ASSERT ( fb.IsGeometryClosed(), () );
 
+  lock_guard<mutex> lock(m_treeMutex);
   DoCreateRegion<TTree> createRgn(m_tree);
   fb.ForEachGeometryPointEx(createRgn);
 }
@@ -89,9 +118,60 @@ void CoastlineFeaturesGenerator::AddRegionToTree(FeatureBuilder1 const & fb)
 void CoastlineFeaturesGenerator::operator()(FeatureBuilder1 const & fb)
 {
   if (fb.IsGeometryClosed())
+  {
     AddRegionToTree(fb);
-  else
-    m_merger(fb);
+    return;
+  }
+
+  CHECK(m_waysWriter, ("Coastline ways are added after Finish()."));
+  FeatureBuilder1::Buffer buffer;
+  fb.Serialize(buffer);
+
+  auto const & points = fb.GetOuterGeometry();
+  CHECK(!points.empty(), ());
+
+  Way way;
+  way.m_offset = m_waysWriter->Pos();
+  way.m_size = base::checked_cast<uint32_t>(buffer.size());
+  way.m_pointsCount = base::checked_cast<uint32_t>(points.size());
+  way.m_key = GetKey(points.front());
+  m_waysWriter->Write(buffer.data(), buffer.size());
+  m_ways.push_back(way);
+
+  int64_t const lastKey = GetKey(points.back());
+  Unite(way.m_key, lastKey);
+  // FeatureMergeProcessor joins ways with equal end keys by their middle points too.
+  if (way.m_key == lastKey)
+  {
+    for (auto const & p : points)
+      Unite(way.m_key, GetKey(p));
+  }
+}
+
+uint32_t CoastlineFeaturesGenerator::GetNode(int64_t key)
+{
+  auto const res = m_keyToNode.emplace(key, base::checked_cast<uint32_t>(m_parents.size()));
+  if (res.second)
+    m_parents.push_back(res.first->second);
+  return res.first->second;
+}
+
+uint32_t CoastlineFeaturesGenerator::FindRoot(uint32_t node)
+{
+  while (m_parents[node] != node)
+  {
+    m_parents[node] = m_parents[m_parents[node]];
+    node = m_parents[node];
+  }
+  return node;
+}
+
+void CoastlineFeaturesGenerator::Unite(int64_t key1, int64_t key2)
+{
+  uint32_t const root1 = FindRoot(GetNode(key1));
+  uint32_t const root2 = FindRoot(GetNode(key2));
+  if (root1 != root2)
+    m_parents[root2] = root1;
 }
 
 namespace
@@ -125,11 +205,6 @@ namespace
       }
     }
 
-    bool HasNotMergedCoasts() const
-    {
-      return m_notMergedCoastsCount != 0;
-    }
-
     size_t GetNotMergedCoastsCount() const
     {
       return m_notMergedCoastsCount;
@@ -144,13 +219,105 @@ namespace
 
 bool CoastlineFeaturesGenerator::Finish()
 {
-  DoAddToTree doAdd(*this);
-  m_merger.DoMerge(doAdd);
+  CHECK(m_waysWriter, ("Finish() is called twice."));
+  m_waysWriter.reset();
 
-  if (doAdd.HasNotMergedCoasts())
+  // Connected sets of ways.
+  vector<vector<uint32_t>> components;
+  vector<uint64_t> componentsPoints;
   {
-    LOG(LINFO, ("Total not merged coasts:", doAdd.GetNotMergedCoastsCount()));
-    LOG(LINFO, ("Total points in not merged coasts:", doAdd.GetNotMergedCoastsPoints()));
+    unordered_map<uint32_t, size_t> rootToComponent;
+    for (size_t i = 0; i < m_ways.size(); ++i)
+    {
+      uint32_t const root = FindRoot(GetNode(m_ways[i].m_key));
+      auto const res = rootToComponent.emplace(root, components.size());
+      if (res.second)
+      {
+        components.emplace_back();
+        componentsPoints.push_back(0);
+      }
+      components[res.first->second].push_back(base::checked_cast<uint32_t>(i));
+      componentsPoints[res.first->second] += m_ways[i].m_pointsCount;
+    }
+  }
+  m_keyToNode = {};
+  m_parents = {};
+
+  // The largest sets go first to the least loaded buckets.
+  size_t const threadsCount = GetThreadsCount();
+  vector<vector<uint32_t>> buckets(min(components.size(), threadsCount * kBucketsPerThread));
+  {
+    vector<size_t> order(components.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    sort(order.begin(), order.end(), [&componentsPoints](size_t lhs, size_t rhs) {
+      return componentsPoints[lhs] > componentsPoints[rhs];
+    });
+
+    using Load = pair<uint64_t, size_t>;
+    priority_queue<Load, vector<Load>, greater<Load>> loads;
+    for (size_t i = 0; i < buckets.size(); ++i)
+      loads.emplace(0, i);
+    for (auto const c : order)
+    {
+      auto load = loads.top();
+      loads.pop();
+      auto & bucket = buckets[load.second];
+      bucket.insert(bucket.end(), components[c].begin(), components[c].end());
+      load.first += componentsPoints[c];
+      loads.push(load);
+    }
+  }
+  components = {};
+
+  LOG(LINFO, ("Merging", m_ways.size(), "coastline ways in", buckets.size(), "buckets"));
+
+  vector<DoAddToTree> emitters(threadsCount, DoAddToTree(*this));
+  atomic<size_t> nextBucket(0);
+  vector<thread> threads;
+  for (size_t i = 0; i < threadsCount; ++i)
+  {
+    threads.emplace_back([this, &buckets, &nextBucket, &emitter = emitters[i]]() {
+      FileReader reader(m_waysFile);
+      FeatureBuilder1::Buffer buffer;
+      for (size_t b = nextBucket++; b < buckets.size(); b = nextBucket++)
+      {
+        // Ways are read in the order of the file.
+        auto & bucket = buckets[b];
+        sort(bucket.begin(), bucket.end());
+
+        FeatureMergeProcessor merger(POINT_COORD_BITS);
+        for (auto const w : bucket)
+        {
+          auto const & way = m_ways[w];
+          buffer.resize(way.m_size);
+          reader.Read(way.m_offset, buffer.data(), buffer.size());
+
+          FeatureBuilder1 fb;
+          fb.Deserialize(buffer);
+          merger(fb);
+        }
+        merger.DoMerge(emitter);
+      }
+    });
+  }
+
+  for (auto & thread : threads)
+    thread.join();
+  m_ways = {};
+
+  size_t notMergedCoastsCount = 0;
+  size_t notMergedCoastsPoints = 0;
+  for (auto const & emitter : emitters)
+  {
+    notMergedCoastsCount += emitter.GetNotMergedCoastsCount();
+    notMergedCoastsPoints += emitter.GetNotMergedCoastsPoints();
+  }
+
+  if (notMergedCoastsCount != 0)
+  {
+    LOG(LINFO, ("Total not merged coasts:", notMergedCoastsCount));
+    LOG(LINFO, ("Total points in not merged coasts:", notMergedCoastsPoints));
     return false;
   }
 
@@ -317,15 +484,12 @@ public:
   }
 };
 
-void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
+void CoastlineFeaturesGenerator::GetFeatures(function<void(FeatureBuilder1 &)> const & fn)
 {
-  size_t const maxThreads = thread::hardware_concurrency();
-  CHECK_GREATER(maxThreads, 0, ("Not supported platform"));
-
   mutex featuresMutex;
   RegionInCellSplitter::Process(
-      maxThreads, RegionInCellSplitter::kStartLevel, m_tree,
-      [&features, &featuresMutex, this](RegionInCellSplitter::TCell const & cell, DoDifference & cellData)
+      GetThreadsCount(), RegionInCellSplitter::kStartLevel, m_tree,
+      [&fn, &featuresMutex, this](RegionInCellSplitter::TCell const & cell, DoDifference & cellData)
       {
         FeatureBuilder1 fb;
         fb.SetCoastCell(cell.ToInt64(RegionInCellSplitter::kHighLevel + 1));
@@ -340,6 +504,6 @@ void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
 
         // save result
         lock_guard<mutex> lock(featuresMutex);
-        features.emplace_back(move(fb));
+        fn(fb);
       });
 }
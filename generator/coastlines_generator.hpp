@@ -7,26 +7,61 @@
 #include "geometry/tree4d.hpp"
 #include "geometry/region2d.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class FeatureBuilder1;
+class FileWriter;
 
 class CoastlineFeaturesGenerator
 {
-  FeatureMergeProcessor m_merger;
-
   using TTree = m4::Tree<m2::RegionI>;
   TTree m_tree;
+  std::mutex m_treeMutex;
 
   uint32_t m_coastType;
 
+  /// Not closed coastline ways are spilled to |m_waysFile| and only their end points are kept
+  /// in memory until Finish().
+  struct Way
+  {
+    uint64_t m_offset = 0;
+    uint32_t m_size = 0;
+    uint32_t m_pointsCount = 0;
+    int64_t m_key = 0;
+  };
+
+  std::string m_waysFile;
+  std::unique_ptr<FileWriter> m_waysWriter;
+  std::vector<Way> m_ways;
+  /// Ids of sets of ways which are connected by end points (disjoint set union).
+  std::vector<uint32_t> m_parents;
+  std::unordered_map<int64_t, uint32_t> m_keyToNode;
+
+  uint32_t GetNode(int64_t key);
+  uint32_t FindRoot(uint32_t node);
+  void Unite(int64_t key1, int64_t key2);
+
 public:
-  CoastlineFeaturesGenerator(uint32_t coastType);
+  /// \param waysFile is a temporary file for not closed coastline ways.
+  CoastlineFeaturesGenerator(uint32_t coastType, std::string const & waysFile);
+  ~CoastlineFeaturesGenerator();
 
   void AddRegionToTree(FeatureBuilder1 const & fb);
 
   void operator() (FeatureBuilder1 const & fb);
+  /// Merges not closed ways on several threads. Ways are merged only with ways connected to them,
+  /// so connected sets of ways are merged independently.
   /// @return false if coasts are not merged and FLAG_fail_on_coasts is set
   bool Finish();
 
-  void GetFeatures(vector<FeatureBuilder1> & vecFb);
+  /// Calls |fn| for coast cells features. |fn| is called from several threads, but the calls are
+  /// serialized.
+  void GetFeatures(std::function<void(FeatureBuilder1 &)> const & fn);
 };
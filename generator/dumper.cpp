@@ -5,6 +5,7 @@
 
 #include "indexer/classificator.hpp"
 #include "indexer/feature_processor.hpp"
+#include "indexer/packed_trie_reader.hpp"
 #include "indexer/trie_reader.hpp"
 #include "indexer/search_delimiters.hpp"
 #include "indexer/search_string_utils.hpp"
@@ -202,11 +203,29 @@ namespace feature
     serial::GeometryCodingParams codingParams(
         trie::GetGeometryCodingParams(header.GetDefGeometryCodingParams()));
 
-    auto const trieRoot = trie::ReadTrie<ModelReaderPtr, ValueList<TValue>>(
-        container.GetReader(SEARCH_INDEX_FILE_TAG), SingleValueSerializer<TValue>(codingParams));
+    auto const reader = container.GetReader(SEARCH_INDEX_FILE_TAG);
+    SingleValueSerializer<TValue> const serializer(codingParams);
 
     SearchTokensCollector<TValue> f;
-    trie::ForEachRef(*trieRoot, f, strings::UniString());
+    switch (SearchIndexHeader::Read(reader))
+    {
+    case SearchIndexVersion::V0:
+    {
+      auto const trieRoot = trie::ReadTrie<ModelReaderPtr, ValueList<TValue>>(reader, serializer);
+      trie::ForEachRef(*trieRoot, f, strings::UniString());
+      break;
+    }
+    case SearchIndexVersion::V1:
+    {
+      vector<uint8_t> data(static_cast<size_t>(reader.Size()));
+      reader.Read(0 /* pos */, data.data(), data.size());
+      auto const trieRoot = trie::ReadPackedTrie<ValueList<TValue>>(
+          data.data() + SearchIndexHeader::kSize, data.size() - SearchIndexHeader::kSize,
+          serializer);
+      trie::ForEachRef(trieRoot, f, strings::UniString());
+      break;
+    }
+    }
     f.Finish();
 
     for (size_t i = 0; i < min(maxTokensToShow, f.m_tokens.size()); ++i)
@@ -3,6 +3,8 @@
 #include "generator/feature_builder.hpp"
 #include "generator/emitter_interface.hpp"
 
+#include "coding/file_name_utils.hpp"
+
 #include "base/macros.hpp"
 
 #include <fstream>
@@ -12,13 +14,27 @@ using namespace std;
 
 namespace generator
 {
+namespace
+{
+// Features are matched to sponsored objects in parallel by batches of this size.
+size_t constexpr kPendingFeaturesBatchSize = 10000;
+
+string GetMatchesCachePath(feature::GenerateInfo const & info, string const & datasetName)
+{
+  if (info.m_sponsoredMatchesCacheDir.empty())
+    return {};
+  return base::JoinPath(info.m_sponsoredMatchesCacheDir, datasetName + ".matches");
+}
+}  // namespace
+
 EmitterPlanet::EmitterPlanet(feature::GenerateInfo const & info) :
   m_skippedElementsPath(info.GetIntermediateFileName("skipped_elements", ".lst")),
   m_failOnCoasts(info.m_failOnCoasts),
-  m_bookingDataset(info.m_bookingDatafileName),
-  m_opentableDataset(info.m_opentableDatafileName),
+  m_bookingDataset(info.m_bookingDatafileName, GetMatchesCachePath(info, "booking")),
+  m_opentableDataset(info.m_opentableDatafileName, GetMatchesCachePath(info, "opentable")),
   m_viatorDataset(info.m_viatorDatafileName),
-  m_boundariesTable(info.m_boundariesTable)
+  m_boundariesTable(info.m_boundariesTable),
+  m_threadsCount(info.m_threadsCount)
 {
   Classificator const & c = classif();
   char const * arr[][2] = {
@@ -35,7 +51,8 @@ EmitterPlanet::EmitterPlanet(feature::GenerateInfo const & info) :
 
   if (info.m_makeCoasts)
   {
-    m_coasts.reset(new CoastlineFeaturesGenerator(Type(NATURAL_COASTLINE)));
+    m_coasts.reset(new CoastlineFeaturesGenerator(
+        Type(NATURAL_COASTLINE), info.GetTmpFileName(WORLD_COASTS_FILE_NAME, ".ways")));
 
     m_coastsHolder.reset(new feature::FeaturesAndRawGeometryCollector(
                            m_srcCoastsFile,
@@ -55,6 +72,33 @@ EmitterPlanet::EmitterPlanet(feature::GenerateInfo const & info) :
 }
 
 void EmitterPlanet::operator()(FeatureBuilder1 & fb)
+{
+  if (m_threadsCount <= 1)
+  {
+    ProcessFeature(fb);
+    return;
+  }
+
+  // Features are processed in the order they are emitted, only matching is done in advance.
+  m_pendingFeatures.push_back(fb);
+  if (m_pendingFeatures.size() >= kPendingFeaturesBatchSize)
+    FlushPendingFeatures();
+}
+
+void EmitterPlanet::FlushPendingFeatures()
+{
+  if (m_pendingFeatures.empty())
+    return;
+
+  m_bookingDataset.MatchObjects(m_pendingFeatures, m_threadsCount);
+  m_opentableDataset.MatchObjects(m_pendingFeatures, m_threadsCount);
+
+  for (auto & fb : m_pendingFeatures)
+    ProcessFeature(fb);
+  m_pendingFeatures.clear();
+}
+
+void EmitterPlanet::ProcessFeature(FeatureBuilder1 & fb)
 {
   uint32_t const type = GetPlaceType(fb.GetParams());
 
@@ -110,6 +154,8 @@ void EmitterPlanet::operator()(FeatureBuilder1 & fb)
 
 void EmitterPlanet::EmitCityBoundary(FeatureBuilder1 const & fb, FeatureParams const & params)
 {
+  FlushPendingFeatures();
+
   if (!m_boundariesTable)
     return;
 
@@ -127,6 +173,10 @@ void EmitterPlanet::EmitCityBoundary(FeatureBuilder1 const & fb, FeatureParams c
 /// @return false if coasts are not merged and FLAG_fail_on_coasts is set
 bool EmitterPlanet::Finish()
 {
+  FlushPendingFeatures();
+  m_bookingDataset.SaveMatches();
+  m_opentableDataset.SaveMatches();
+
   DumpSkippedElements();
 
   // Emit all required booking objects to the map.
@@ -155,17 +205,15 @@ bool EmitterPlanet::Finish()
     size_t totalPoints = 0;
     size_t totalPolygons = 0;
 
-    vector<FeatureBuilder1> vecFb;
-    m_coasts->GetFeatures(vecFb);
-
-    for (auto & fb : vecFb)
-    {
+    // Features are written as soon as they are made, so that all the polygons aren't kept in
+    // memory.
+    m_coasts->GetFeatures([&](FeatureBuilder1 & fb) {
       (*m_coastsHolder)(fb);
 
       ++totalFeatures;
       totalPoints += fb.GetPointsCount();
       totalPolygons += fb.GetPolygonsCount();
-    }
+    });
     LOG(LINFO, ("Total features:", totalFeatures, "total polygons:", totalPolygons,
                 "total points:", totalPoints));
   }
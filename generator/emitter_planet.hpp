@@ -14,10 +14,12 @@
 
 #include "indexer/feature_data.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace generator
 {
@@ -47,6 +49,8 @@ private:
     TYPES_COUNT
   };
 
+  void ProcessFeature(FeatureBuilder1 & fb);
+  void FlushPendingFeatures();
   void Emit(FeatureBuilder1 & fb);
   void DumpSkippedElements();
   uint32_t Type(TypeIndex i) const { return m_types[i]; }
@@ -69,5 +73,8 @@ private:
   /// Used to prepare a list of cities to serve as a list of nodes
   /// for building a highway graph with OSRM for low zooms.
   m4::Tree<Place> m_places;
+  size_t m_threadsCount;
+  /// Features which are waiting for matching to sponsored objects.
+  std::vector<FeatureBuilder1> m_pendingFeatures;
 };
 }  // namespace generator
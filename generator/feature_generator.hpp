@@ -68,5 +68,5 @@ public:
   uint32_t operator()(FeatureBuilder1 const & f) override;
 };
 
-uint32_t CheckedFilePosCast(FileWriter const & f);
+uint32_t CheckedFilePosCast(Writer const & f);
 }
@@ -21,6 +21,7 @@
 #include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/writer.hpp"
 
 #include "geometry/polygon.hpp"
 
@@ -31,15 +32,23 @@
 
 #include "defines.hpp"
 
+#include <atomic>
 #include <list>
 #include <limits>
 #include <memory>
+#include <thread>
 #include <vector>
 
 using namespace std;
 
 namespace feature
 {
+/// Simplify geometry for the upper scale.
+FeatureBuilder2 & GetFeatureBuilder2(FeatureBuilder1 & fb)
+{
+  return static_cast<FeatureBuilder2 &>(fb);
+}
+
 class FeaturesCollector2 : public FeaturesCollector
 {
 public:
@@ -136,9 +145,111 @@ public:
 
   uint32_t operator()(FeatureBuilder2 & fb)
   {
-    GeometryHolder holder([this](int i) -> FileWriter & { return *m_geoFile[i]; },
-    [this](int i) -> FileWriter & { return *m_trgFile[i]; }, fb, m_header);
+    GeometryHolder holder([this](int i) -> Writer & { return *m_geoFile[i]; },
+                          [this](int i) -> Writer & { return *m_trgFile[i]; }, fb, m_header);
+    MakeGeometry(fb, holder);
+    return WriteFeature(fb, holder);
+  }
+
+  // Does the same as operator() for each of |fbs| in order. Geometry of the features is made
+  // by |threadsCount| threads into memory and then it is appended to the geometry files.
+  void operator()(vector<FeatureBuilder1> & fbs, size_t threadsCount)
+  {
+    size_t const scalesCount = m_header.GetScalesCount();
+    vector<FeatureGeometry> geometries(fbs.size());
+
+    atomic<size_t> next(0);
+    auto const makeGeometry = [&]() {
+      for (size_t i = next++; i < fbs.size(); i = next++)
+      {
+        auto & geometry = geometries[i];
+        geometry.m_geo.resize(scalesCount);
+        geometry.m_trg.resize(scalesCount);
+        for (size_t j = 0; j < scalesCount; ++j)
+        {
+          geometry.m_geoWriters.push_back(make_unique<BufferWriter>(geometry.m_geo[j]));
+          geometry.m_trgWriters.push_back(make_unique<BufferWriter>(geometry.m_trg[j]));
+        }
+
+        auto & fb = GetFeatureBuilder2(fbs[i]);
+        geometry.m_holder = make_unique<GeometryHolder>(
+            [&geometry](int j) -> Writer & { return *geometry.m_geoWriters[j]; },
+            [&geometry](int j) -> Writer & { return *geometry.m_trgWriters[j]; }, fb, m_header);
+        MakeGeometry(fb, *geometry.m_holder);
+      }
+    };
+
+    vector<thread> threads;
+    for (size_t i = 1; i < threadsCount; ++i)
+      threads.emplace_back(makeGeometry);
+    makeGeometry();
+    for (auto & t : threads)
+      t.join();
+
+    for (size_t i = 0; i < fbs.size(); ++i)
+    {
+      auto & geometry = geometries[i];
+      auto & buffer = geometry.m_holder->GetBuffer();
+      AppendGeometry(geometry.m_geo, buffer.m_ptsMask, m_geoFile, buffer.m_ptsOffset);
+      AppendGeometry(geometry.m_trg, buffer.m_trgMask, m_trgFile, buffer.m_trgOffset);
+      WriteFeature(GetFeatureBuilder2(fbs[i]), *geometry.m_holder);
+    }
+  }
+
+private:
+  using Points = vector<m2::PointD>;
+  using Polygons = list<Points>;
+
+  class TmpFile : public FileWriter
+  {
+  public:
+    explicit TmpFile(string const & filePath) : FileWriter(filePath) {}
+    ~TmpFile() { DeleteFileX(GetName()); }
+  };
+
+  using TmpFiles = vector<unique_ptr<TmpFile>>;
+
+  using Buffer = vector<uint8_t>;
+  using BufferWriter = MemWriter<Buffer>;
+
+  // Geometry of a feature which is written to memory to be appended to files later.
+  struct FeatureGeometry
+  {
+    vector<Buffer> m_geo;
+    vector<Buffer> m_trg;
+    vector<unique_ptr<BufferWriter>> m_geoWriters;
+    vector<unique_ptr<BufferWriter>> m_trgWriters;
+    unique_ptr<GeometryHolder> m_holder;
+  };
+
+  enum
+  {
+    METADATA = 0,
+    SEARCH_TOKENS = 1,
+    FILES_COUNT = 2
+  };
+
+  // Appends |buffers| to |files| and turns |offsets| in the buffers into offsets in the files.
+  // Scales are written from the upper one, so the offsets are in the same order.
+  static void AppendGeometry(vector<Buffer> const & buffers, uint8_t mask, TmpFiles & files,
+                             vector<uint32_t> & offsets)
+  {
+    size_t k = 0;
+    for (size_t i = buffers.size(); i > 0; --i)
+    {
+      if ((mask & (1 << (i - 1))) == 0)
+        continue;
 
+      auto & file = *files[i - 1];
+      CHECK_LESS(k, offsets.size(), ());
+      offsets[k++] += CheckedFilePosCast(file);
+      file.Write(buffers[i - 1].data(), buffers[i - 1].size());
+    }
+    CHECK_EQUAL(k, offsets.size(), ());
+  }
+
+  void MakeGeometry(FeatureBuilder2 & fb, GeometryHolder & holder) const
+  {
     bool const isLine = fb.IsLine();
     bool const isArea = fb.IsArea();
 
@@ -210,7 +321,10 @@ public:
         }
       }
     }
+  }
 
+  uint32_t WriteFeature(FeatureBuilder2 & fb, GeometryHolder & holder)
+  {
     uint32_t featureId = kInvalidFeatureId;
     auto & buffer = holder.GetBuffer();
     if (fb.PreSerializeAndRemoveUselessNames(buffer))
@@ -241,26 +355,6 @@ public:
     return featureId;
   }
 
-private:
-  using Points = vector<m2::PointD>;
-  using Polygons = list<Points>;
-
-  class TmpFile : public FileWriter
-  {
-  public:
-    explicit TmpFile(string const & filePath) : FileWriter(filePath) {}
-    ~TmpFile() { DeleteFileX(GetName()); }
-  };
-
-  using TmpFiles = vector<unique_ptr<TmpFile>>;
-
-  enum
-  {
-    METADATA = 0,
-    SEARCH_TOKENS = 1,
-    FILES_COUNT = 2
-  };
-
   static bool IsGoodArea(Points const & poly, int level)
   {
     // Area has the same first and last points. That's why minimal number of points for
@@ -276,8 +370,8 @@ private:
 
   bool IsCountry() const { return m_header.GetType() == feature::DataHeader::country; }
 
-  void SimplifyPoints(int level, bool isCoast, m2::RectD const & rect, Points const & in,
-                      Points & out)
+  static void SimplifyPoints(int level, bool isCoast, m2::RectD const & rect, Points const & in,
+                             Points & out)
   {
     if (isCoast)
     {
@@ -306,14 +400,11 @@ private:
   DISALLOW_COPY_AND_MOVE(FeaturesCollector2);
 };
 
-/// Simplify geometry for the upper scale.
-FeatureBuilder2 & GetFeatureBuilder2(FeatureBuilder1 & fb)
-{
-  return static_cast<FeatureBuilder2 &>(fb);
-}
-
 bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & name, int mapType)
 {
+  // Geometry of a batch is made concurrently when there are several threads.
+  size_t const kFeaturesBatchSize = 1024;
+
   string const srcFilePath = info.GetTmpFileName(name);
   string const datFilePath = info.GetTargetFileName(name);
 
@@ -359,6 +450,7 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & na
     {
       FeaturesCollector2 collector(datFilePath, header, regionData, info.m_versionDate);
 
+      vector<FeatureBuilder1> batch;
       for (auto const & point : midPoints.GetVector())
       {
         ReaderSource<FileReader> src(reader);
@@ -368,8 +460,21 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & na
         ReadFromSourceRawFormat(src, f);
 
         // emit the feature
-        collector(GetFeatureBuilder2(f));
+        if (info.m_threadsCount <= 1)
+        {
+          collector(GetFeatureBuilder2(f));
+          continue;
+        }
+
+        batch.push_back(move(f));
+        if (batch.size() == kFeaturesBatchSize)
+        {
+          collector(batch, info.m_threadsCount);
+          batch.clear();
+        }
       }
+      if (!batch.empty())
+        collector(batch, info.m_threadsCount);
 
       // Update bounds with the limit rect corresponding to region borders.
       // Bounds before update can be too big because of big invisible features like a
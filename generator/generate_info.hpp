@@ -8,6 +8,7 @@
 
 #include "defines.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,13 +21,15 @@ struct GenerateInfo
   {
     Memory,
     Index,
-    File
+    File,
+    Packed
   };
 
   enum class OsmSourceType
   {
     XML,
-    O5M
+    O5M,
+    PBF
   };
 
   // Directory for .mwm.tmp files.
@@ -48,6 +51,10 @@ struct GenerateInfo
   std::string m_bookingDatafileName;
   std::string m_opentableDatafileName;
   std::string m_viatorDatafileName;
+  // Directory where matches of osm features to sponsored objects are kept between builds.
+  std::string m_sponsoredMatchesCacheDir;
+  // Directory where results of the slow steps of the world generation are kept between builds.
+  std::string m_worldCacheDir;
 
   std::string m_popularPlacesFilename;
 
@@ -55,6 +62,10 @@ struct GenerateInfo
 
   uint32_t m_versionDate = 0;
 
+  // Count of threads of the preprocessing, feature generation and mwm finalization stages,
+  // the stages are single-threaded when it is 1.
+  size_t m_threadsCount = 1;
+
   std::vector<std::string> m_bucketNames;
 
   bool m_createWorld = false;
@@ -74,6 +85,8 @@ struct GenerateInfo
       m_osmFileType = OsmSourceType::XML;
     else if (type == "o5m")
       m_osmFileType = OsmSourceType::O5M;
+    else if (type == "pbf")
+      m_osmFileType = OsmSourceType::PBF;
     else
       LOG(LCRITICAL, ("Unknown source type:", type));
   }
@@ -86,6 +99,8 @@ struct GenerateInfo
       m_nodeStorageType = NodeStorageType::Index;
     else if (type == "mem")
       m_nodeStorageType = NodeStorageType::Memory;
+    else if (type == "packed")
+      m_nodeStorageType = NodeStorageType::Packed;
     else
       LOG(LCRITICAL, ("Incorrect node_storage type:", type));
   }
@@ -27,7 +27,9 @@
 
 #include "defines.hpp"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 using namespace feature;
 using namespace generator;
@@ -138,11 +140,18 @@ void TestAltitudes(DataSource const & dataSource, MwmSet::MwmId const & mwmId,
   AltitudeLoader loader(dataSource, mwmId);
   TEST_EQUAL(loader.HasAltitudes(), hasAltitudeExpected, ());
 
-  auto processor = [&expectedAltitudes, &loader](FeatureType & f, uint32_t const & id) {
+  vector<uint32_t> featureIds;
+  vector<size_t> pointCounts;
+  vector<TAltitudes> expected;
+  auto processor = [&](FeatureType & f, uint32_t const & id) {
     f.ParseGeometry(FeatureType::BEST_GEOMETRY);
     size_t const pointsCount = f.GetPointsCount();
     TAltitudes const altitudes = loader.GetAltitudes(id, pointsCount);
 
+    featureIds.push_back(id);
+    pointCounts.push_back(pointsCount);
+    expected.push_back(altitudes);
+
     if (!routing::IsRoad(feature::TypesHolder(f)))
     {
       TEST(altitudes.empty(), ());
@@ -159,6 +168,15 @@ void TestAltitudes(DataSource const & dataSource, MwmSet::MwmId const & mwmId,
     }
   };
   feature::ForEachFromDat(mwmPath, processor);
+
+  // Batch reading should return the same altitudes in any order of features.
+  reverse(featureIds.begin(), featureIds.end());
+  reverse(pointCounts.begin(), pointCounts.end());
+  reverse(expected.begin(), expected.end());
+  AltitudeLoader batchLoader(dataSource, mwmId);
+  vector<TAltitudes> altitudes;
+  batchLoader.GetAltitudes(featureIds, pointCounts, altitudes);
+  TEST_EQUAL(altitudes, expected, ());
 }
 
 void TestAltitudesBuilding(vector<TPoint3DList> const & roads, bool hasAltitudeExpected,
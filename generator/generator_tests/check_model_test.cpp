@@ -0,0 +1,59 @@
+#include "testing/testing.hpp"
+
+#include "generator/check_model.hpp"
+
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "defines.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace platform::tests_support;
+using namespace std;
+
+UNIT_TEST(CheckModel_SectionsChecksums)
+{
+  ScopedFile const mwm("check_model_test.mwm", ScopedFile::Mode::DoNotCreate);
+  auto const & path = mwm.GetFullPath();
+  {
+    FilesContainerW cont(path);
+    cont.Write(vector<uint8_t>{1, 2, 3, 4, 5}, "first");
+    cont.Write(vector<uint8_t>(10000, 7), "second");
+    cont.Write(vector<uint8_t>(), "empty");
+  }
+
+  // Checksums aren't required.
+  TEST(check_model::CheckSections(path), ());
+
+  TEST(check_model::WriteSectionsChecksums(path, 2 /* threadsCount */), ());
+  TEST(FilesContainerR(path).IsExist(CHECKSUMS_FILE_TAG), ());
+  TEST(check_model::CheckSections(path, 2 /* threadsCount */), ());
+
+  // Rewriting keeps the section correct.
+  TEST(check_model::WriteSectionsChecksums(path), ());
+  TEST(check_model::CheckSections(path), ());
+
+  uint64_t offset;
+  {
+    FilesContainerR const cont(path);
+    offset = cont.GetAbsoluteOffsetAndSize("second").first;
+  }
+  {
+    FileWriter writer(path, FileWriter::OP_WRITE_EXISTING);
+    writer.Seek(offset + 100);
+    uint8_t const damaged = 8;
+    writer.Write(&damaged, sizeof(damaged));
+  }
+  TEST(!check_model::CheckSections(path, 2 /* threadsCount */), ());
+
+  {
+    FilesContainerW cont(path, FileWriter::OP_WRITE_EXISTING);
+    cont.Write(vector<uint8_t>{1}, "third");
+  }
+  TEST(!check_model::CheckSections(path), ());
+}
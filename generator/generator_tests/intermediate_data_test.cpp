@@ -19,14 +19,26 @@
 #include "generator/intermediate_elements.hpp"
 #include "generator/osm_source.hpp"
 
+#include "geometry/latlon.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
 #include "base/control_flow.hpp"
 #include "base/macros.hpp"
+#include "base/math.hpp"
+#include "base/scope_guard.hpp"
+#include "base/string_utils.hpp"
 
 #include "defines.hpp"
 
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 
 using namespace generator;
@@ -183,6 +195,153 @@ UNIT_TEST(Intermediate_Data_relation_element_save_load_test)
   TEST_NOT_EQUAL(e2.tags["key2old"], "value2old", ());
 }
 
+UNIT_TEST(IntermediateData_ConcurrentReads)
+{
+  string const kFileName = "intermediate_data_concurrent_reads.dat";
+  SCOPE_GUARD(deleteFiles, [&kFileName]() {
+    FileWriter::DeleteFileX(kFileName);
+    FileWriter::DeleteFileX(kFileName + OFFSET_EXT);
+  });
+
+  uint64_t const kWaysCount = 1000;
+  {
+    OSMElementCacheWriter writer(kFileName);
+    for (uint64_t id = 1; id <= kWaysCount; ++id)
+    {
+      WayElement way(id);
+      for (uint64_t i = 0; i < id % 10 + 1; ++i)
+        way.nodes.push_back(id * 100 + i);
+      writer.Write(id, way);
+    }
+    writer.SaveOffsets();
+  }
+
+  for (bool const preload : {false, true})
+  {
+    OSMElementCacheReader reader(kFileName, preload);
+    reader.LoadOffsets();
+
+    vector<thread> threads;
+    for (size_t t = 0; t < 4; ++t)
+    {
+      threads.emplace_back([&reader, kWaysCount, preload]() {
+        for (uint64_t id = 1; id <= kWaysCount; ++id)
+        {
+          WayElement way(id);
+          TEST(reader.Read(id, way), (id, preload));
+          TEST_EQUAL(way.nodes.size(), id % 10 + 1, (id, preload));
+          TEST_EQUAL(way.nodes.back(), id * 100 + id % 10, (id, preload));
+        }
+      });
+    }
+    for (auto & thread : threads)
+      thread.join();
+  }
+}
+
+UNIT_TEST(IntermediateData_ReadMany)
+{
+  string const kFileName = "intermediate_data_read_many.dat";
+  SCOPE_GUARD(deleteFiles, [&kFileName]() {
+    FileWriter::DeleteFileX(kFileName);
+    FileWriter::DeleteFileX(kFileName + OFFSET_EXT);
+  });
+
+  // Every 500th way is larger than a chunk.
+  auto const nodesCount = [](uint64_t id) -> uint64_t { return id % 500 == 0 ? 80000 : id % 10 + 1; };
+  uint64_t const kWaysCount = 2000;
+  {
+    OSMElementCacheWriter writer(kFileName);
+    for (uint64_t id = 1; id <= kWaysCount; ++id)
+    {
+      WayElement way(id);
+      for (uint64_t i = 0; i < nodesCount(id); ++i)
+        way.nodes.push_back(id * 100000 + i);
+      writer.Write(id, way);
+    }
+    writer.SaveOffsets();
+  }
+
+  vector<Key> ids = {kWaysCount + 1, 0};
+  for (uint64_t id = kWaysCount; id > 7; id -= 7)
+    ids.push_back(id);
+  ids.push_back(kWaysCount);
+
+  for (bool const preload : {false, true})
+  {
+    OSMElementCacheReader reader(kFileName, preload);
+    reader.LoadOffsets();
+
+    vector<thread> threads;
+    for (size_t t = 0; t < 4; ++t)
+    {
+      threads.emplace_back([&]() {
+        map<Key, size_t> read;
+        reader.ReadMany<WayElement>(ids, [&](Key id, WayElement const & way) {
+          ++read[id];
+          WayElement expected(id);
+          TEST(reader.Read(id, expected), (id, preload));
+          TEST_EQUAL(way.nodes, expected.nodes, (id, preload));
+          TEST_EQUAL(way.nodes.size(), nodesCount(id), (id, preload));
+        });
+        TEST_EQUAL(read.size(), ids.size() - 3, (preload));
+        TEST_EQUAL(read[kWaysCount], 2, (preload));
+      });
+    }
+    for (auto & thread : threads)
+      thread.join();
+  }
+}
+
+UNIT_TEST(IntermediateData_PackedPointStorage)
+{
+  string const kFileName = "intermediate_data_packed_nodes.dat";
+  SCOPE_GUARD(deleteFile, [&kFileName]() { FileWriter::DeleteFileX(kFileName + ".packed"); });
+
+  // Ids have gaps within blocks and between them, coordinates take the whole range.
+  vector<pair<uint64_t, ms::LatLon>> nodes;
+  uint64_t id = 3;
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    id += i % 1000 == 0 ? 5000 : 1 + i % 3;
+    double const lat = i % 777 == 0 ? -89.9999999 : 55.0 + i * 1e-6;
+    double const lon = i % 777 == 1 ? 179.9999999 : 37.0 - i * 1e-6;
+    nodes.emplace_back(id, ms::LatLon(lat, lon));
+  }
+
+  {
+    auto writer = CreatePointStorageWriter(GenerateInfo::NodeStorageType::Packed, kFileName);
+    for (auto const & node : nodes)
+      writer->AddPoint(node.first, node.second.lat, node.second.lon);
+    TEST_EQUAL(writer->GetNumProcessedPoints(), nodes.size(), ());
+  }
+
+  // Nearby nodes take a few bytes.
+  TEST_LESS(FileReader(kFileName + ".packed").Size(), nodes.size() * sizeof(LatLon), ());
+
+  auto const reader = CreatePointStorageReader(GenerateInfo::NodeStorageType::Packed, kFileName);
+  vector<thread> threads;
+  for (size_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&reader, &nodes]() {
+      double lat = 0.0;
+      double lon = 0.0;
+      for (auto const & node : nodes)
+      {
+        TEST(reader->GetPoint(node.first, lat, lon), (node.first));
+        TEST(base::AlmostEqualAbs(lat, node.second.lat, 1e-7), (node.first, lat));
+        TEST(base::AlmostEqualAbs(lon, node.second.lon, 1e-7), (node.first, lon));
+        TEST(!reader->GetPoint(node.first + 1000000000, lat, lon), (node.first));
+      }
+      TEST(!reader->GetPoint(0, lat, lon), ());
+      TEST(!reader->GetPoint(nodes.front().first - 1, lat, lon), ());
+      TEST(!reader->GetPoint(nodes.back().first + 1, lat, lon), ());
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+}
+
 UNIT_TEST(IntermediateData_CameraNodesToWays_test_1)
 {
   string const osmSourceXML = R"(
@@ -310,4 +469,80 @@ UNIT_TEST(IntermediateData_CameraNodesToWays_test_5)
 
   TestIntermediateData_SpeedCameraNodesToWays(osmSourceXML, trueAnswers, /* number of nodes in xml = */ 1);
 }
+UNIT_TEST(IntermediateData_ParallelPreprocessing)
+{
+  // There are more elements than in a batch of the pipeline.
+  ostringstream osmSourceXML;
+  osmSourceXML << R"(<osm version="0.6" generator="osmconvert 0.8.4">)";
+  uint64_t const kNodesCount = 25000;
+  for (uint64_t i = 1; i <= kNodesCount; ++i)
+  {
+    osmSourceXML << "<node id=\"" << i << "\" lat=\"" << 55.0 + i * 1e-5 << "\" lon=\""
+                 << 37.0 + i * 1e-5 << "\" version=\"1\">";
+    if (i % 1000 == 0)
+    {
+      osmSourceXML << R"(<tag k="place" v="town"/><tag k="population" v=")" << 10000 + i
+                   << "\"/>";
+    }
+    if (i % 777 == 0)
+      osmSourceXML << kSpeedCameraTag;
+    osmSourceXML << "</node>";
+  }
+  for (uint64_t i = 1; i < kNodesCount; i += 5)
+  {
+    osmSourceXML << "<way id=\"" << i << "\" version=\"1\">";
+    for (uint64_t j = i; j < i + 5; ++j)
+      osmSourceXML << "<nd ref=\"" << j << "\"/>";
+    osmSourceXML << R"(<tag k="highway" v="primary"/></way>)";
+  }
+  for (uint64_t i = 1; i < 100; ++i)
+  {
+    osmSourceXML << "<relation id=\"" << i << "\" version=\"1\">"
+                 << "<member type=\"way\" ref=\"" << 5 * i + 1 << "\" role=\"outer\"/>"
+                 << "<member type=\"node\" ref=\"" << i << "\" role=\"\"/>"
+                 << R"(<tag k="type" v="multipolygon"/></relation>)";
+  }
+  osmSourceXML << "</osm>";
+
+  static string const kTestDir = "parallel_preprocessing_test";
+  WritableDirChanger writableDirChanger(kTestDir);
+  string const & writableDir = GetPlatform().WritableDir();
+  ScopedDir const scopedDir(kTestDir);
+
+  string const osmRelativePath = base::JoinPath(kTestDir, "planet" OSM_DATA_FILE_EXTENSION);
+  ScopedFile const osmScopedFile(osmRelativePath, osmSourceXML.str());
+
+  auto const generate = [&](size_t threadsCount) {
+    string const dir = base::JoinPath(kTestDir, strings::to_string(threadsCount));
+    auto scopedResultDir = make_unique<ScopedDir>(dir);
+
+    GenerateInfo genInfo;
+    genInfo.m_intermediateDir = base::JoinPath(writableDir, dir);
+    genInfo.m_nodeStorageType = feature::GenerateInfo::NodeStorageType::Index;
+    genInfo.m_osmFileName = base::JoinPath(writableDir, osmRelativePath);
+    genInfo.m_osmFileType = feature::GenerateInfo::OsmSourceType::XML;
+    genInfo.m_threadsCount = threadsCount;
+    TEST(GenerateIntermediateData(genInfo), (threadsCount));
+
+    // The files are compared as they are, whatever intermediate data is written.
+    Platform::TFilesWithType filesList;
+    Platform::GetFilesByType(base::AddSlashIfNeeded(genInfo.m_intermediateDir),
+                             Platform::FILE_TYPE_REGULAR, filesList);
+    map<string, string> files;
+    for (auto const & file : filesList)
+    {
+      string const path = base::JoinPath(genInfo.m_intermediateDir, file.first);
+      {
+        FileReader reader(path);
+        reader.ReadAsString(files[file.first]);
+      }
+      FileWriter::DeleteFileX(path);
+    }
+    return files;
+  };
+
+  auto const expected = generate(1 /* threadsCount */);
+  TEST(!expected.empty(), ());
+  TEST_EQUAL(expected, generate(4 /* threadsCount */), ());
+}
 }  // namespace
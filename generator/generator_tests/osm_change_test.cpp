@@ -0,0 +1,184 @@
+#include "testing/testing.hpp"
+
+#include "generator/borders_loader.hpp"
+#include "generator/generate_info.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/osm_change.hpp"
+#include "generator/osm_element.hpp"
+#include "generator/osm_source.hpp"
+
+#include "platform/platform.hpp"
+#include "platform/platform_tests_support/scoped_dir.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+#include "platform/platform_tests_support/writable_dir_changer.hpp"
+
+#include "coding/file_name_utils.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "defines.hpp"
+
+using namespace generator;
+using namespace platform::tests_support;
+using namespace std;
+
+namespace
+{
+// Lat, lon of nodes. Way 10 consists of nodes 1, 2, 3 and way 11 consists of nodes 4, 5.
+// Relation 20 has way 11 as a member.
+string const kOsmSourceXML = R"(
+<osm version="0.6">
+  <node id="1" lat="5" lon="1" version="1"/>
+  <node id="2" lat="5" lon="2" version="1"/>
+  <node id="3" lat="5" lon="3" version="1"/>
+  <node id="4" lat="5" lon="15" version="1"/>
+  <node id="5" lat="5" lon="16" version="1"/>
+  <node id="6" lat="35" lon="5" version="1"/>
+  <way id="10" version="1"><nd ref="1"/><nd ref="2"/><nd ref="3"/></way>
+  <way id="11" version="1"><nd ref="4"/><nd ref="5"/></way>
+  <relation id="20" version="1">
+    <member type="way" ref="11" role="outer"/>
+    <tag k="type" v="multipolygon"/>
+  </relation>
+</osm>
+)";
+
+void AddCountry(string const & name, m2::RectD const & latLonRect,
+                borders::CountriesContainer & countries)
+{
+  auto const rect = MercatorBounds::FromLatLonRect(latLonRect);
+  vector<m2::PointD> points = {rect.LeftBottom(), rect.RightBottom(), rect.RightTop(),
+                               rect.LeftTop()};
+  borders::Region region(points.begin(), points.end());
+
+  borders::CountryPolygons country(name);
+  country.m_regions.Add(region, region.GetRect());
+  countries.Add(country, region.GetRect());
+}
+
+vector<string> GetAffectedCountries(cache::IntermediateDataReader & holder,
+                                    borders::CountriesContainer const & countries,
+                                    string const & change)
+{
+  istringstream stream("<osmChange version=\"0.6\">" + change + "</osmChange>");
+  SourceReader reader(stream);
+
+  OsmChangePoints points(holder);
+  ProcessOsmChangeFromXML(reader, [&points](OsmChangeAction action, OsmElement * e) {
+    points.Add(action, *e);
+  });
+  return GetAffectedCountries(points, countries);
+}
+
+UNIT_TEST(OsmChange_Parse)
+{
+  istringstream stream(R"(
+<osmChange version="0.6" generator="osmosis">
+  <create><node id="7" lat="35" lon="6" version="1"/></create>
+  <modify>
+    <way id="10" version="2"><nd ref="1"/><nd ref="2"/><tag k="highway" v="primary"/></way>
+    <node id="2" lat="5" lon="12" version="2"/>
+  </modify>
+  <delete><relation id="20" version="2"/></delete>
+</osmChange>
+)");
+  SourceReader reader(stream);
+
+  vector<pair<OsmChangeAction, OsmElement>> changes;
+  ProcessOsmChangeFromXML(reader, [&changes](OsmChangeAction action, OsmElement * e) {
+    changes.emplace_back(action, *e);
+  });
+
+  TEST_EQUAL(changes.size(), 4, ());
+
+  TEST_EQUAL(changes[0].first, OsmChangeAction::Create, ());
+  TEST(changes[0].second.IsNode(), ());
+  TEST_EQUAL(changes[0].second.id, 7, ());
+  TEST_EQUAL(changes[0].second.lon, 6.0, ());
+
+  TEST_EQUAL(changes[1].first, OsmChangeAction::Modify, ());
+  TEST(changes[1].second.IsWay(), ());
+  TEST_EQUAL(changes[1].second.Nodes(), vector<uint64_t>({1, 2}), ());
+  TEST_EQUAL(changes[1].second.Tags().size(), 1, ());
+
+  TEST_EQUAL(changes[2].first, OsmChangeAction::Modify, ());
+  TEST(changes[2].second.IsNode(), ());
+  TEST_EQUAL(changes[2].second.id, 2, ());
+
+  TEST_EQUAL(changes[3].first, OsmChangeAction::Delete, ());
+  TEST(changes[3].second.IsRelation(), ());
+  TEST_EQUAL(changes[3].second.id, 20, ());
+}
+
+UNIT_TEST(OsmChange_AffectedCountries)
+{
+  static string const kTestDir = "osm_change_test";
+  WritableDirChanger writableDirChanger(kTestDir);
+  string const & writableDir = GetPlatform().WritableDir();
+  ScopedDir const scopedDir(kTestDir);
+
+  string const osmRelativePath = base::JoinPath(kTestDir, "planet" OSM_DATA_FILE_EXTENSION);
+  ScopedFile const osmScopedFile(osmRelativePath, kOsmSourceXML);
+
+  feature::GenerateInfo genInfo;
+  genInfo.m_intermediateDir = base::JoinPath(writableDir, kTestDir);
+  genInfo.m_nodeStorageType = feature::GenerateInfo::NodeStorageType::Index;
+  genInfo.m_osmFileName = base::JoinPath(writableDir, osmRelativePath);
+  genInfo.m_osmFileType = feature::GenerateInfo::OsmSourceType::XML;
+  TEST(GenerateIntermediateData(genInfo), ());
+
+  auto nodes = cache::CreatePointStorageReader(genInfo.m_nodeStorageType,
+                                               genInfo.GetIntermediateFileName(NODES_FILE));
+  cache::IntermediateDataReader holder(nodes, genInfo);
+  holder.LoadIndex();
+
+  borders::CountriesContainer countries;
+  AddCountry("West", m2::RectD(0, 0, 10, 10), countries);
+  AddCountry("East", m2::RectD(10, 0, 20, 10), countries);
+  AddCountry("North", m2::RectD(0, 30, 20, 40), countries);
+
+  // A node is moved from West to East.
+  TEST_EQUAL(GetAffectedCountries(
+                 holder, countries,
+                 R"(<modify><node id="2" lat="5" lon="12" version="2"/></modify>)"),
+             vector<string>({"East", "West"}), ());
+
+  TEST_EQUAL(GetAffectedCountries(holder, countries,
+                                  R"(<delete><way id="11" version="2"/></delete>)"),
+             vector<string>({"East"}), ());
+
+  TEST_EQUAL(GetAffectedCountries(
+                 holder, countries,
+                 R"(<create><node id="7" lat="35" lon="6" version="1"/></create>)"),
+             vector<string>({"North"}), ());
+
+  // Only tags of the relation are changed, so the countries of its members are affected.
+  TEST_EQUAL(GetAffectedCountries(holder, countries, R"(
+<modify>
+  <relation id="20" version="2">
+    <member type="way" ref="11" role="outer"/>
+    <tag k="type" v="multipolygon"/><tag k="landuse" v="forest"/>
+  </relation>
+</modify>)"),
+             vector<string>({"East"}), ());
+
+  // A new way refers to a new node and to an old one.
+  TEST_EQUAL(GetAffectedCountries(holder, countries, R"(
+<create>
+  <node id="8" lat="35" lon="7" version="1"/>
+  <way id="12" version="1"><nd ref="6"/><nd ref="8"/></way>
+</create>)"),
+             vector<string>({"North"}), ());
+
+  // The way is shortened, both versions of it are in West.
+  TEST_EQUAL(GetAffectedCountries(holder, countries, R"(
+<modify><way id="10" version="2"><nd ref="1"/><nd ref="2"/></way></modify>)"),
+             vector<string>({"West"}), ());
+}
+}  // namespace
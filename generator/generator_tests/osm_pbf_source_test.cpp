@@ -0,0 +1,257 @@
+#include "testing/testing.hpp"
+
+#include "generator/osm_element.hpp"
+#include "generator/osm_pbf_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+// Writer of the protobuf wire format.
+class ProtoWriter
+{
+public:
+  void Varint(uint32_t field, uint64_t value)
+  {
+    Key(field, 0 /* wireType */);
+    WriteVarint(m_data, value);
+  }
+
+  void Bytes(uint32_t field, string const & value)
+  {
+    Key(field, 2 /* wireType */);
+    WriteVarint(m_data, value.size());
+    m_data += value;
+  }
+
+  void Message(uint32_t field, ProtoWriter const & message) { Bytes(field, message.m_data); }
+
+  void PackedVarints(uint32_t field, vector<uint64_t> const & values)
+  {
+    string packed;
+    for (auto const value : values)
+      WriteVarint(packed, value);
+    Bytes(field, packed);
+  }
+
+  // Values are delta coded if |isDelta|.
+  void PackedSVarints(uint32_t field, vector<int64_t> const & values, bool isDelta)
+  {
+    string packed;
+    int64_t prev = 0;
+    for (auto const value : values)
+    {
+      auto const coded = isDelta ? value - prev : value;
+      WriteVarint(packed, (static_cast<uint64_t>(coded) << 1) ^ static_cast<uint64_t>(coded >> 63));
+      prev = value;
+    }
+    Bytes(field, packed);
+  }
+
+  string const & GetData() const { return m_data; }
+
+private:
+  static void WriteVarint(string & data, uint64_t value)
+  {
+    for (; value >= 0x80; value >>= 7)
+      data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    data.push_back(static_cast<char>(value));
+  }
+
+  void Key(uint32_t field, uint32_t wireType) { WriteVarint(m_data, (field << 3) | wireType); }
+
+  string m_data;
+};
+
+void WriteBlob(string const & type, string const & data, bool compress, string & file)
+{
+  ProtoWriter blob;
+  if (compress)
+  {
+    string compressed;
+    coding::ZLib::Deflate deflate(coding::ZLib::Deflate::Format::ZLib,
+                                  coding::ZLib::Deflate::Level::BestCompression);
+    TEST(deflate(data, back_inserter(compressed)), ());
+    blob.Varint(2 /* raw_size */, data.size());
+    blob.Bytes(3 /* zlib_data */, compressed);
+  }
+  else
+  {
+    blob.Bytes(1 /* raw */, data);
+  }
+
+  ProtoWriter header;
+  header.Bytes(1 /* type */, type);
+  header.Varint(3 /* datasize */, blob.GetData().size());
+
+  auto const headerSize = static_cast<uint32_t>(header.GetData().size());
+  for (int shift = 24; shift >= 0; shift -= 8)
+    file.push_back(static_cast<char>((headerSize >> shift) & 0xFF));
+  file += header.GetData();
+  file += blob.GetData();
+}
+
+// Strings of the blocks.
+vector<string> const kStrings = {"", "amenity", "cafe", "highway", "residential",
+                                 "type", "multipolygon", "outer", "name", "Wall"};
+
+ProtoWriter MakeStringTable()
+{
+  ProtoWriter stringTable;
+  for (auto const & s : kStrings)
+    stringTable.Bytes(1, s);
+  return stringTable;
+}
+
+string MakeNodesBlock()
+{
+  // Dense nodes 10 and 12 have tags, node 11 has no tags.
+  ProtoWriter dense;
+  dense.PackedSVarints(1 /* id */, {10, 11, 12}, true /* isDelta */);
+  dense.PackedSVarints(8 /* lat */, {555000000, 555000100, 554999900}, true /* isDelta */);
+  dense.PackedSVarints(9 /* lon */, {376000000, 376000200, 376000100}, true /* isDelta */);
+  dense.PackedVarints(10 /* keys_vals */, {1, 2, 8, 9, 0, 0, 1, 2, 0});
+
+  // A node which is not dense.
+  ProtoWriter node;
+  node.Varint(1 /* id */, 13 << 1);
+  node.PackedVarints(2 /* keys */, {8});
+  node.PackedVarints(3 /* vals */, {9});
+  node.Varint(8 /* lat */, 555000200 << 1);
+  node.Varint(9 /* lon */, 376000300 << 1);
+
+  ProtoWriter denseGroup;
+  denseGroup.Message(2 /* dense */, dense);
+  ProtoWriter nodeGroup;
+  nodeGroup.Message(1 /* nodes */, node);
+
+  ProtoWriter block;
+  block.Message(1 /* stringtable */, MakeStringTable());
+  block.Message(2 /* primitivegroup */, denseGroup);
+  block.Message(2 /* primitivegroup */, nodeGroup);
+  return block.GetData();
+}
+
+string MakeWaysAndRelationsBlock()
+{
+  ProtoWriter way;
+  way.Varint(1 /* id */, 20);
+  way.PackedVarints(2 /* keys */, {3});
+  way.PackedVarints(3 /* vals */, {4});
+  way.PackedSVarints(8 /* refs */, {10, 11, 12, 10}, true /* isDelta */);
+
+  ProtoWriter relation;
+  relation.Varint(1 /* id */, 30);
+  relation.PackedVarints(2 /* keys */, {5});
+  relation.PackedVarints(3 /* vals */, {6});
+  relation.PackedVarints(8 /* roles_sid */, {7, 0});
+  relation.PackedSVarints(9 /* memids */, {20, 13}, true /* isDelta */);
+  relation.PackedVarints(10 /* types */, {1 /* way */, 0 /* node */});
+
+  ProtoWriter wayGroup;
+  wayGroup.Message(3 /* ways */, way);
+  ProtoWriter relationGroup;
+  relationGroup.Message(4 /* relations */, relation);
+
+  ProtoWriter block;
+  block.Message(1 /* stringtable */, MakeStringTable());
+  block.Message(2 /* primitivegroup */, wayGroup);
+  block.Message(2 /* primitivegroup */, relationGroup);
+  return block.GetData();
+}
+
+string MakeFile()
+{
+  ProtoWriter header;
+  header.Bytes(4 /* required_features */, "OsmSchema-V0.6");
+  header.Bytes(4 /* required_features */, "DenseNodes");
+
+  string file;
+  WriteBlob("OSMHeader", header.GetData(), false /* compress */, file);
+  WriteBlob("OSMData", MakeNodesBlock(), true /* compress */, file);
+  WriteBlob("UnknownBlob", "data", false /* compress */, file);
+  WriteBlob("OSMData", MakeWaysAndRelationsBlock(), false /* compress */, file);
+  return file;
+}
+
+vector<OsmElement> ReadElements(string const & file, size_t threadsCount)
+{
+  istringstream stream(file);
+  osm::PbfSource source([&stream](uint8_t * buffer, size_t size)
+  {
+    return static_cast<size_t>(stream.read(reinterpret_cast<char *>(buffer), size).gcount());
+  }, threadsCount);
+
+  vector<OsmElement> elements;
+  source.ForEachElement([&elements](OsmElement & element) { elements.push_back(element); });
+  return elements;
+}
+}  // namespace
+
+UNIT_TEST(OSM_PBF_Source_ReadElements)
+{
+  auto const elements = ReadElements(MakeFile(), 1 /* threadsCount */);
+  TEST_EQUAL(elements.size(), 6, ());
+
+  vector<uint64_t> const ids = {10, 11, 12, 13, 20, 30};
+  for (size_t i = 0; i < ids.size(); ++i)
+    TEST_EQUAL(elements[i].id, ids[i], ());
+
+  auto const & cafe = elements[0];
+  TEST(cafe.IsNode(), ());
+  TEST(base::AlmostEqualAbs(cafe.lat, 55.5, 1e-7), ());
+  TEST(base::AlmostEqualAbs(cafe.lon, 37.6, 1e-7), ());
+  TEST_EQUAL(cafe.GetTag("amenity"), "cafe", ());
+  TEST_EQUAL(cafe.GetTag("name"), "Wall", ());
+
+  TEST(elements[1].Tags().empty(), ());
+  TEST(base::AlmostEqualAbs(elements[1].lat, 55.50001, 1e-7), ());
+  TEST_EQUAL(elements[2].GetTag("amenity"), "cafe", ());
+  TEST(base::AlmostEqualAbs(elements[2].lon, 37.60001, 1e-7), ());
+
+  auto const & node = elements[3];
+  TEST(node.IsNode(), ());
+  TEST(base::AlmostEqualAbs(node.lat, 55.50002, 1e-7), ());
+  TEST(base::AlmostEqualAbs(node.lon, 37.60003, 1e-7), ());
+  TEST_EQUAL(node.GetTag("name"), "Wall", ());
+
+  auto const & way = elements[4];
+  TEST(way.IsWay(), ());
+  TEST_EQUAL(way.Nodes(), vector<uint64_t>({10, 11, 12, 10}), ());
+  TEST_EQUAL(way.GetTag("highway"), "residential", ());
+
+  auto const & relation = elements[5];
+  TEST(relation.IsRelation(), ());
+  TEST_EQUAL(relation.GetTag("type"), "multipolygon", ());
+  auto const & members = relation.Members();
+  TEST_EQUAL(members.size(), 2, ());
+  TEST_EQUAL(members[0].ref, 20, ());
+  TEST_EQUAL(members[0].type, OsmElement::EntityType::Way, ());
+  TEST_EQUAL(members[0].role, "outer", ());
+  TEST_EQUAL(members[1].ref, 13, ());
+  TEST_EQUAL(members[1].type, OsmElement::EntityType::Node, ());
+  TEST_EQUAL(members[1].role, "", ());
+}
+
+UNIT_TEST(OSM_PBF_Source_ParallelDecoding)
+{
+  // Elements of many blobs are passed in the order of the file.
+  string file;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    WriteBlob("OSMData", MakeNodesBlock(), i % 2 == 0 /* compress */, file);
+    WriteBlob("OSMData", MakeWaysAndRelationsBlock(), i % 2 == 1 /* compress */, file);
+  }
+
+  auto const expected = ReadElements(file, 1 /* threadsCount */);
+  TEST_EQUAL(expected.size(), 60, ());
+  TEST_EQUAL(ReadElements(file, 4 /* threadsCount */), expected, ());
+}
@@ -2,12 +2,42 @@
 
 #include "generator/srtm_parser.hpp"
 
+#include "platform/platform_tests_support/scoped_dir.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "coding/file_name_utils.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
 using namespace generator;
+using namespace platform::tests_support;
 
 namespace
 {
 inline std::string GetBase(ms::LatLon const & coord) { return SrtmTile::GetBase(coord); }
 
+size_t constexpr kSamplesInRow = 3601;
+
+// Returns an unzipped tile with big-endian heights given by |fn(row, col)|.
+template <typename Fn>
+std::string MakeTile(Fn && fn)
+{
+  std::string tile(kSamplesInRow * kSamplesInRow * 2, 0);
+  for (size_t row = 0; row < kSamplesInRow; ++row)
+  {
+    for (size_t col = 0; col < kSamplesInRow; ++col)
+    {
+      auto const height = static_cast<uint16_t>(fn(row, col));
+      size_t const ix = 2 * (row * kSamplesInRow + col);
+      tile[ix] = static_cast<char>(height >> 8);
+      tile[ix + 1] = static_cast<char>(height & 0xFF);
+    }
+  }
+  return tile;
+}
+
 UNIT_TEST(FilenameTests)
 {
   auto name = GetBase({56.4566, 37.3467});
@@ -25,4 +55,33 @@ UNIT_TEST(FilenameTests)
   name = GetBase({-34.622358, -58.383654});
   TEST_EQUAL(name, "S35W059", ());
 }
+
+UNIT_TEST(SrtmTileManager_CachedTiles)
+{
+  std::string const kCacheDir = "srtm_cache_test";
+  ScopedDir const cacheDir(kCacheDir);
+  ScopedFile const tile1(base::JoinPath(kCacheDir, "N00E000.hgt"),
+                         MakeTile([](size_t /* row */, size_t col) { return 4 * col; }));
+  ScopedFile const tile2(base::JoinPath(kCacheDir, "N00E001.hgt"),
+                         MakeTile([](size_t /* row */, size_t /* col */) { return 7; }));
+
+  // Zipped tiles aren't available, so the tiles are read from the cache only.
+  SrtmTileManager manager("" /* dir */, cacheDir.GetFullPath(), 1 /* maxTilesCount */);
+
+  // The point is in the middle between columns 360 and 361.
+  ms::LatLon const point(0.5, 360.5 / 3600.0);
+  TEST_EQUAL(manager.GetHeight(point), 4 * 360, ());
+
+  std::vector<feature::TAltitude> heights;
+  manager.GetHeights({point, {0.5, 1.5}}, true /* bilinear */, heights);
+  TEST_EQUAL(heights, std::vector<feature::TAltitude>({4 * 360 + 2, 7}), ());
+  TEST_EQUAL(manager.GetTilesCount(), 1, ());
+
+  manager.GetHeights({point}, false /* bilinear */, heights);
+  TEST_EQUAL(heights, std::vector<feature::TAltitude>({4 * 360}), ());
+  TEST_EQUAL(manager.GetTilesCount(), 1, ());
+
+  // There is no such tile.
+  TEST_EQUAL(manager.GetHeight({10.5, 10.5}), feature::kInvalidAltitude, ());
+}
 }  // namespace
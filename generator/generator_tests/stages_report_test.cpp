@@ -0,0 +1,49 @@
+#include "testing/testing.hpp"
+
+#include "generator/statistics.hpp"
+
+#include "3party/jansson/myjansson.hpp"
+
+#include <string>
+
+using namespace std;
+
+namespace
+{
+UNIT_TEST(StagesReport_Smoke)
+{
+  stats::StagesReport report;
+  {
+    stats::ScopedStage const stage("Preprocess", "" /* country */, &report);
+  }
+  {
+    stats::ScopedStage stage("Geometry", "Belarus", &report);
+    stage.SetItemsCount(10);
+  }
+  {
+    stats::ScopedStage const stage("Index", "Belarus", &report);
+  }
+
+  base::Json const json(report.ToJSON());
+  auto * countries = base::GetJSONObligatoryField(json.get(), "countries");
+  TEST_EQUAL(json_array_size(base::GetJSONObligatoryField(countries, "planet")), 1, ());
+
+  auto * belarus = base::GetJSONObligatoryField(countries, "Belarus");
+  TEST_EQUAL(json_array_size(belarus), 2, ());
+
+  string stage;
+  FromJSONObject(json_array_get(belarus, 0), "stage", stage);
+  TEST_EQUAL(stage, "Geometry", ());
+  uint64_t items = 0;
+  FromJSONObject(json_array_get(belarus, 0), "items", items);
+  TEST_EQUAL(items, 10, ());
+
+  auto * total = base::GetJSONObligatoryField(json.get(), "total");
+  double cpuSeconds = -1;
+  FromJSONObject(total, "cpu_seconds", cpuSeconds);
+  TEST_GREATER_OR_EQUAL(cpuSeconds, 0.0, ());
+
+  base::Json const countryJson(report.ToJSON("Belarus"));
+  TEST_EQUAL(json_array_size(base::GetJSONObligatoryField(countryJson.get(), "stages")), 2, ());
+}
+}  // namespace
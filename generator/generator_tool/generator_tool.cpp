@@ -14,6 +14,7 @@
 #include "generator/geo_objects/geo_objects.hpp"
 #include "generator/locality_sorter.hpp"
 #include "generator/metalines_builder.hpp"
+#include "generator/osm_change.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/popular_places_section_builder.hpp"
 #include "generator/regions/collector_region_info.hpp"
@@ -30,6 +31,7 @@
 
 #include "routing/cross_mwm_ids.hpp"
 
+#include "indexer/categories_holder.hpp"
 #include "indexer/classificator.hpp"
 #include "indexer/classificator_loader.hpp"
 #include "indexer/data_header.hpp"
@@ -41,19 +43,26 @@
 #include "indexer/map_style_reader.hpp"
 #include "indexer/rank_table.hpp"
 
+#include "storage/country.hpp"
 #include "storage/country_parent_getter.hpp"
 
 #include "platform/platform.hpp"
 
 #include "coding/endianness.hpp"
 #include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/transliteration.hpp"
 
+#include "base/logging.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "defines.hpp"
 
@@ -72,6 +81,15 @@ char const * GetDataPathHelp()
       Platform::GetCurrentWorkingDirectory() + "/../../data'.";
   return kHelp.c_str();
 }
+
+// Extension of reports of generation stages of a country, see stats::StagesReport.
+char const kStagesReportExtension[] = ".stages.json";
+
+uint64_t GetFeaturesCount(string const & datFile)
+{
+  FeaturesVectorTest features(datFile);
+  return features.GetVector().GetNumFeatures();
+}
 }  // namespace
 
 // Coastlines.
@@ -82,19 +100,29 @@ DEFINE_bool(emit_coasts, false,
 
 // Generator settings and paths.
 DEFINE_string(osm_file_name, "", "Input osm area file.");
-DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m].");
+DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m, pbf].");
 DEFINE_string(data_path, "", GetDataPathHelp());
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_string(intermediate_data_path, "", "Path to stored nodes, ways, relations.");
 DEFINE_string(output, "", "File name for process (without 'mwm' ext).");
 DEFINE_bool(preload_cache, false, "Preload all ways and relations cache.");
 DEFINE_string(node_storage, "map",
-              "Type of storage for intermediate points representation. Available: raw, map, mem.");
+              "Type of storage for intermediate points representation. Available: raw, map, mem, "
+              "packed (requires nodes sorted by ids).");
 DEFINE_uint64(planet_version, base::SecondsSinceEpoch(),
               "Version as seconds since epoch, by default - now.");
 
 // Preprocessing and feature generator.
+DEFINE_string(osm_change_file, "",
+              "Input .osc file with changes of the planet since the intermediate data was created.");
+DEFINE_string(affected_countries_file, "",
+              "Output file with names of countries affected by --osm_change_file. It is written "
+              "before --preprocess since the old intermediate data is needed.");
 DEFINE_bool(preprocess, false, "1st pass - create nodes/ways/relations data.");
+DEFINE_uint64(threads_count, 1,
+              "Count of threads of the preprocessing, feature generation and mwm finalization "
+              "passes, 0 means all the cores. Mwms are finalized concurrently, so the peak memory "
+              "grows with the count.");
 DEFINE_bool(generate_features, false, "2nd pass - generate intermediate features.");
 DEFINE_bool(generate_region_features, false,
             "Generate intermediate features for regions to use in regions index and borders generation.");
@@ -104,6 +132,8 @@ DEFINE_bool(generate_geometry, false,
             "3rd pass - split and simplify geometry and triangles for features.");
 DEFINE_bool(generate_index, false, "4rd pass - generate index.");
 DEFINE_bool(generate_search_index, false, "5th pass - generate search index.");
+DEFINE_bool(packed_search_index, false,
+            "Write the trie of the search index in the packed format, which is read in place.");
 DEFINE_bool(generate_geo_objects_index, false,
             "Generate objects and index for server-side reverse geocoder.");
 DEFINE_bool(generate_regions, false,
@@ -127,11 +157,22 @@ DEFINE_bool(make_routing_index, false, "Make sections with the routing informati
 DEFINE_bool(make_cross_mwm, false,
             "Make section for cross mwm routing (for dynamic indexed routing).");
 DEFINE_bool(make_transit_cross_mwm, false, "Make section for cross mwm transit routing.");
+DEFINE_bool(make_landmarks, false,
+            "Make section with landmarks distances for ALT heuristic of car routing.");
+DEFINE_bool(make_mapped_routing_index, false,
+            "Make section with routing index which is used in mapped memory without copying.");
+DEFINE_bool(make_road_snapping_index, false,
+            "Make section with grid of roads which is used to snap points to roads.");
 DEFINE_bool(disable_cross_mwm_progress, false,
             "Disable log of cross mwm section building progress.");
 DEFINE_string(srtm_path, "",
               "Path to srtm directory. If set, generates a section with altitude information "
               "about roads.");
+DEFINE_string(srtm_cache_path, "",
+              "Path to directory with unzipped srtm tiles. If set, tiles are unzipped there once "
+              "and memory mapped instead of being read into memory.");
+DEFINE_uint64(srtm_max_tiles, 0, "Max number of srtm tiles kept loaded, 0 means no limit.");
+DEFINE_bool(srtm_bilinear, false, "Use bilinear interpolation of srtm heights.");
 DEFINE_string(transit_path, "", "Path to directory with transit graphs in json.");
 DEFINE_bool(generate_cameras, false, "Generate section with speed cameras info.");
 DEFINE_bool(
@@ -142,6 +183,11 @@ DEFINE_bool(
 DEFINE_string(booking_data, "", "Path to booking data in .tsv format.");
 DEFINE_string(opentable_data, "", "Path to opentable data in .tsv format.");
 DEFINE_string(viator_data, "", "Path to viator data in .tsv format.");
+DEFINE_string(sponsored_matches_cache_dir, "",
+              "Directory where matches of booking and opentable objects are cached between "
+              "builds.");
+DEFINE_string(world_cache_dir, "",
+              "Directory where water splits of World boundaries are cached between builds.");
 
 DEFINE_string(ugc_data, "", "Input UGC source database file name.");
 
@@ -162,9 +208,17 @@ DEFINE_string(dump_feature_names, "", "Print all feature names by 2-letter local
 // Service functions.
 DEFINE_bool(generate_classif, false, "Generate classificator.");
 DEFINE_bool(generate_packed_borders, false, "Generate packed file with country polygons.");
+DEFINE_string(compile_categories, "",
+              "Compile categories.txt to the form which is loaded faster (specify the output file).");
+DEFINE_string(compile_countries, "",
+              "Compile countries.txt to the form which is loaded faster (specify the output file).");
 DEFINE_string(unpack_borders, "", "Convert packed_polygons to a directory of polygon files (specify folder).");
 DEFINE_bool(unpack_mwm, false, "Unpack each section of mwm into a separate file with name filePath.sectionName.");
 DEFINE_bool(check_mwm, false, "Check map file to be correct.");
+DEFINE_bool(check_mwm_sections, false,
+            "Fast check of map file: layout of sections and their checksums, features are not read.");
+DEFINE_bool(make_checksums, false,
+            "Write checksums of all sections of map file, should be the last generation step.");
 DEFINE_string(delete_section, "", "Delete specified section (defines.hpp) from container.");
 DEFINE_bool(generate_addresses_file, false, "Generate .addr file (for '--output' option) with full addresses list.");
 DEFINE_bool(generate_traffic_keys, false,
@@ -181,6 +235,9 @@ DEFINE_string(regions_features, "", "Input tmp.mwm file with regions.");
 
 // Common.
 DEFINE_bool(verbose, false, "Provide more detailed output.");
+DEFINE_string(stages_report, "",
+              "Output JSON file with time, CPU time, peak memory and I/O of generation stages. "
+              "A report of every country is also written to the intermediate data path.");
 
 using namespace generator;
 
@@ -229,20 +286,35 @@ int main(int argc, char ** argv)
   genInfo.m_bookingDatafileName = FLAGS_booking_data;
   genInfo.m_opentableDatafileName = FLAGS_opentable_data;
   genInfo.m_viatorDatafileName = FLAGS_viator_data;
+  genInfo.m_sponsoredMatchesCacheDir = FLAGS_sponsored_matches_cache_dir;
+  genInfo.m_worldCacheDir = FLAGS_world_cache_dir;
   genInfo.m_popularPlacesFilename = FLAGS_popular_places_data;
   genInfo.m_boundariesTable = make_shared<generator::OsmIdToBoundariesTable>();
 
   genInfo.m_versionDate = static_cast<uint32_t>(FLAGS_planet_version);
+  genInfo.m_threadsCount = FLAGS_threads_count == 0 ? max(thread::hardware_concurrency(), 1u)
+                                                    : static_cast<size_t>(FLAGS_threads_count);
 
   if (!FLAGS_node_storage.empty())
     genInfo.SetNodeStorageType(FLAGS_node_storage);
   if (!FLAGS_osm_file_type.empty())
     genInfo.SetOsmFileType(FLAGS_osm_file_type);
 
+  stats::StagesReport stagesReport;
+
+  if (!FLAGS_osm_change_file.empty())
+  {
+    CHECK(!FLAGS_affected_countries_file.empty(), ("Use --affected_countries_file."));
+    LOG(LINFO, ("Finding countries affected by", FLAGS_osm_change_file));
+    if (!GenerateAffectedCountries(genInfo, FLAGS_osm_change_file, FLAGS_affected_countries_file))
+      return -1;
+  }
+
   // Generate intermediate files.
   if (FLAGS_preprocess)
   {
     LOG(LINFO, ("Generating intermediate data ...."));
+    stats::ScopedStage const stage("Preprocess", "" /* country */, &stagesReport);
     if (!GenerateIntermediateData(genInfo))
     {
       return -1;
@@ -259,17 +331,22 @@ int main(int argc, char ** argv)
       FLAGS_calc_statistics || FLAGS_type_statistics || FLAGS_dump_types || FLAGS_dump_prefixes ||
       FLAGS_dump_feature_names != "" || FLAGS_check_mwm || FLAGS_srtm_path != "" ||
       FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
-      FLAGS_make_city_roads || FLAGS_generate_traffic_keys || FLAGS_transit_path != "" ||
+      FLAGS_make_landmarks || FLAGS_make_mapped_routing_index || FLAGS_make_city_roads ||
+      FLAGS_make_road_snapping_index ||
+      FLAGS_generate_traffic_keys || FLAGS_transit_path != "" ||
       FLAGS_ugc_data != "" || FLAGS_popular_places_data != "" || FLAGS_generate_geo_objects_features ||
-      FLAGS_geo_objects_key_value != "")
+      FLAGS_geo_objects_key_value != "" || FLAGS_compile_categories != "")
   {
     classificator::Load();
   }
 
   // Load mwm tree only if we need it
   unique_ptr<storage::CountryParentGetter> countryParentGetter;
-  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm)
+  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
+      FLAGS_make_landmarks || FLAGS_make_road_snapping_index)
+  {
     countryParentGetter = make_unique<storage::CountryParentGetter>();
+  }
 
   // Generate dat file.
   if (FLAGS_generate_features || FLAGS_make_coasts)
@@ -285,9 +362,12 @@ int main(int argc, char ** argv)
     genInfo.m_fileName = FLAGS_output;
     genInfo.m_genAddresses = FLAGS_generate_addresses_file;
 
-    auto emitter = CreateEmitter(EmitterType::Planet, genInfo);
-    if (!GenerateFeatures(genInfo, emitter))
-      return -1;
+    {
+      stats::ScopedStage const stage("Features", "" /* country */, &stagesReport);
+      auto emitter = CreateEmitter(EmitterType::Planet, genInfo);
+      if (!GenerateFeatures(genInfo, emitter))
+        return -1;
+    }
 
     if (FLAGS_generate_world)
     {
@@ -406,17 +486,23 @@ int main(int argc, char ** argv)
     }
   }
 
-  // Enumerate over all dat files that were created.
-  size_t const count = genInfo.m_bucketNames.size();
-  for (size_t i = 0; i < count; ++i)
+  if ((FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
+       FLAGS_make_landmarks || FLAGS_make_road_snapping_index) && !countryParentGetter)
   {
-    string const & country = genInfo.m_bucketNames[i];
+    // All the mwms should use proper VehicleModels.
+    LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt or "
+                    "countries_obsolete.txt). File must be located in data directory."));
+    return -1;
+  }
+
+  auto const finalizeCountry = [&](string const & country) {
     string const datFile = base::JoinPath(path, country + DATA_FILE_EXTENSION);
     string const osmToFeatureFilename =
         genInfo.GetTargetFileName(country) + OSM2FEATURE_FILE_EXTENSION;
 
     if (FLAGS_generate_geometry)
     {
+      stats::ScopedStage stage("Geometry", country, &stagesReport);
       int mapType = feature::DataHeader::country;
       if (country == WORLD_FILE_NAME)
         mapType = feature::DataHeader::world;
@@ -427,11 +513,12 @@ int main(int argc, char ** argv)
 
       LOG(LINFO, ("Generating result features for", country));
       if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
-        continue;
+        return;
 
       LOG(LINFO, ("Generating offsets table for", datFile));
       if (!feature::BuildOffsetsTable(datFile))
-        continue;
+        return;
+      stage.SetItemsCount(GetFeaturesCount(datFile));
 
       if (mapType == feature::DataHeader::country)
       {
@@ -446,20 +533,25 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_index)
     {
+      stats::ScopedStage stage("Index", country, &stagesReport);
       LOG(LINFO, ("Generating index for", datFile));
 
       if (!indexer::BuildIndexFromDataFile(datFile, FLAGS_intermediate_data_path + country))
         LOG(LCRITICAL, ("Error generating index."));
+      stage.SetItemsCount(GetFeaturesCount(datFile));
     }
 
     if (FLAGS_generate_search_index)
     {
+      stats::ScopedStage stage("Search index", country, &stagesReport);
       LOG(LINFO, ("Generating search index for", datFile));
 
       /// @todo Make threads count according to environment (single mwm build or planet build).
-      if (!indexer::BuildSearchIndexFromDataFile(datFile, true /* forceRebuild */,
-                                                 1 /* threadsCount */))
+      if (!indexer::BuildSearchIndexFromDataFile(
+              datFile, true /* forceRebuild */, 1 /* threadsCount */,
+              FLAGS_packed_search_index ? SearchIndexVersion::V1 : SearchIndexVersion::V0))
         LOG(LCRITICAL, ("Error generating search index."));
+      stage.SetItemsCount(GetFeaturesCount(datFile));
 
       LOG(LINFO, ("Generating rank table for", datFile));
       if (!search::SearchRankTableBuilder::CreateIfNotExists(datFile))
@@ -472,6 +564,7 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_cities_boundaries)
     {
+      stats::ScopedStage const stage("Cities boundaries", country, &stagesReport);
       CHECK(!FLAGS_cities_boundaries_data.empty(), ());
       LOG(LINFO, ("Generating cities boundaries for", datFile));
       generator::OsmIdToBoundariesTable table;
@@ -482,13 +575,25 @@ int main(int argc, char ** argv)
     }
 
     if (!FLAGS_srtm_path.empty())
-      routing::BuildRoadAltitudes(datFile, FLAGS_srtm_path);
+    {
+      stats::ScopedStage const stage("Altitudes", country, &stagesReport);
+      routing::SrtmParams params;
+      params.m_dir = FLAGS_srtm_path;
+      params.m_cacheDir = FLAGS_srtm_cache_path;
+      params.m_maxTilesCount = static_cast<size_t>(FLAGS_srtm_max_tiles);
+      params.m_bilinear = FLAGS_srtm_bilinear;
+      routing::BuildRoadAltitudes(datFile, params, genInfo.m_threadsCount);
+    }
 
     if (!FLAGS_transit_path.empty())
+    {
+      stats::ScopedStage const stage("Transit", country, &stagesReport);
       routing::transit::BuildTransit(path, country, osmToFeatureFilename, FLAGS_transit_path);
+    }
 
     if (FLAGS_generate_cameras)
     {
+      stats::ScopedStage const stage("Cameras", country, &stagesReport);
       string const camerasFilename =
           genInfo.GetIntermediateFileName(CAMERAS_TO_WAYS_FILENAME);
 
@@ -497,14 +602,7 @@ int main(int argc, char ** argv)
 
     if (FLAGS_make_routing_index)
     {
-      if (!countryParentGetter)
-      {
-        // All the mwms should use proper VehicleModels.
-        LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt or "
-                        "countries_obsolete.txt). File must be located in data directory."));
-        return -1;
-      }
-
+      stats::ScopedStage const stage("Routing index", country, &stagesReport);
       string const restrictionsFilename =
           genInfo.GetIntermediateFileName(RESTRICTIONS_FILENAME);
       string const roadAccessFilename =
@@ -517,6 +615,7 @@ int main(int argc, char ** argv)
 
     if (FLAGS_make_city_roads)
     {
+      stats::ScopedStage const stage("City roads", country, &stagesReport);
       CHECK(!FLAGS_cities_boundaries_data.empty(), ());
       LOG(LINFO, ("Generating cities boundaries roads for", datFile));
       generator::OsmIdToBoundariesTable table;
@@ -528,26 +627,40 @@ int main(int argc, char ** argv)
 
     if (FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm)
     {
-      if (!countryParentGetter)
-      {
-        // All the mwms should use proper VehicleModels.
-        LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt or "
-                        "countries_obsolete.txt). File must be located in data directory."));
-        return -1;
-      }
-
+      stats::ScopedStage const stage("Cross mwm", country, &stagesReport);
       if (FLAGS_make_cross_mwm)
       {
         routing::BuildRoutingCrossMwmSection(path, datFile, country, *countryParentGetter,
-                                             osmToFeatureFilename, FLAGS_disable_cross_mwm_progress);
+                                             osmToFeatureFilename, FLAGS_disable_cross_mwm_progress,
+                                             genInfo.m_threadsCount);
       }
 
       if (FLAGS_make_transit_cross_mwm)
         routing::BuildTransitCrossMwmSection(path, datFile, country, *countryParentGetter);
     }
 
+    if (FLAGS_make_landmarks)
+    {
+      stats::ScopedStage const stage("Landmarks", country, &stagesReport);
+      routing::BuildLandmarksSection(path, datFile, country, *countryParentGetter);
+    }
+
+    if (FLAGS_make_mapped_routing_index)
+    {
+      stats::ScopedStage const stage("Mapped routing index", country, &stagesReport);
+      if (!routing::BuildMappedRoutingIndexSection(datFile))
+        LOG(LCRITICAL, ("Error generating mapped routing index section."));
+    }
+
+    if (FLAGS_make_road_snapping_index)
+    {
+      stats::ScopedStage const stage("Road snapping index", country, &stagesReport);
+      routing::BuildRoadSnappingSection(datFile, country, *countryParentGetter);
+    }
+
     if (!FLAGS_ugc_data.empty())
     {
+      stats::ScopedStage const stage("UGC", country, &stagesReport);
       if (!BuildUgcMwmSection(FLAGS_ugc_data, datFile, osmToFeatureFilename))
       {
         LOG(LCRITICAL, ("Error generating UGC mwm section."));
@@ -556,6 +669,7 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_popular_places)
     {
+      stats::ScopedStage const stage("Popular places", country, &stagesReport);
       if (!BuildPopularPlacesMwmSection(genInfo.m_popularPlacesFilename, datFile,
                                         osmToFeatureFilename))
       {
@@ -565,9 +679,57 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_traffic_keys)
     {
+      stats::ScopedStage const stage("Traffic keys", country, &stagesReport);
       if (!traffic::GenerateTrafficKeysFromDataFile(datFile))
         LOG(LCRITICAL, ("Error generating traffic keys."));
     }
+
+    // Must be the last step, as checksums of all the written sections are calculated.
+    if (FLAGS_make_checksums)
+    {
+      stats::ScopedStage const stage("Checksums", country, &stagesReport);
+      if (!check_model::WriteSectionsChecksums(datFile, genInfo.m_threadsCount))
+        LOG(LCRITICAL, ("Error generating checksums of sections."));
+    }
+  };
+
+  auto const processCountry = [&](string const & country) {
+    finalizeCountry(country);
+    if (!FLAGS_stages_report.empty())
+    {
+      stagesReport.Save(genInfo.GetIntermediateFileName(country, kStagesReportExtension),
+                        country);
+    }
+  };
+
+  // Enumerate over all dat files that were created. Sections of an mwm are written one by
+  // one, but different mwms are independent, so they are finalized by a pool of threads.
+  size_t const count = genInfo.m_bucketNames.size();
+  size_t const threadsCount = min(genInfo.m_threadsCount, count);
+  if (threadsCount <= 1)
+  {
+    for (auto const & country : genInfo.m_bucketNames)
+      processCountry(country);
+  }
+  else
+  {
+    atomic<size_t> next(0);
+    vector<thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+      threads.emplace_back([&]() {
+        for (size_t j = next++; j < count; j = next++)
+          processCountry(genInfo.m_bucketNames[j]);
+      });
+    }
+    for (auto & t : threads)
+      t.join();
+  }
+
+  if (!FLAGS_stages_report.empty())
+  {
+    LOG(LINFO, ("Saving stages report to", FLAGS_stages_report));
+    stagesReport.Save(FLAGS_stages_report);
   }
 
   string const datFile = base::JoinPath(path, FLAGS_output + DATA_FILE_EXTENSION);
@@ -614,11 +776,36 @@ int main(int argc, char ** argv)
   if (FLAGS_generate_packed_borders)
     borders::GeneratePackedBorders(path);
 
+  if (!FLAGS_compile_categories.empty())
+  {
+    CategoriesHolder const holder(GetPlatform().GetReader(SEARCH_CATEGORIES_FILE_NAME));
+    FileWriter writer(FLAGS_compile_categories);
+    holder.Serialize(writer);
+  }
+
+  if (!FLAGS_compile_countries.empty())
+  {
+    string countries;
+    ReaderPtr<Reader>(GetPlatform().GetReader(COUNTRIES_FILE)).ReadAsString(countries);
+    FileWriter writer(FLAGS_compile_countries);
+    if (!storage::CompileCountries(countries, writer))
+    {
+      LOG(LCRITICAL, ("Error compiling countries."));
+      return -1;
+    }
+  }
+
   if (!FLAGS_unpack_borders.empty())
     borders::UnpackBorders(path, FLAGS_unpack_borders);
 
   if (FLAGS_check_mwm)
-    check_model::ReadFeatures(datFile);
+    check_model::ReadFeatures(datFile, genInfo.m_threadsCount);
+
+  if (FLAGS_check_mwm_sections && !check_model::CheckSections(datFile, genInfo.m_threadsCount))
+  {
+    LOG(LERROR, ("Sections of", datFile, "are damaged."));
+    return -1;
+  }
 
   return 0;
 }
@@ -23,7 +23,7 @@ namespace feature
 class GeometryHolder
 {
 public:
-  using FileGetter = std::function<FileWriter &(int i)>;
+  using FileGetter = std::function<Writer &(int i)>;
   using Points = std::vector<m2::PointD>;
   using Polygons = std::list<Points>;
 
@@ -1,13 +1,21 @@
 #include "generator/intermediate_data.hpp"
 
-#include <new>
-#include <set>
-#include <string>
+#include "coding/bit_streams.hpp"
+#include "coding/endianness.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <set>
+#include <string>
+
 #include "defines.hpp"
 
 using namespace std;
@@ -21,6 +29,9 @@ namespace
 size_t const kFlushCount = 1024;
 double const kValueOrder = 1e7;
 string const kShortExtension = ".short";
+string const kPackedExtension = ".packed";
+// Multipolygon relations often share ways of their borders.
+size_t const kWaysCacheSize = size_t{1} << 17;
 
 // An estimation.
 // OSM had around 4.1 billion nodes on 2017-11-08,
@@ -255,7 +266,206 @@ public:
   }
 
 private:
-  FileWriter m_fileWriter;
+  AsyncFileWriter m_fileWriter;
+  uint64_t m_numProcessedPoints = 0;
+};
+
+// Packed storage ----------------------------------------------------------------------------------
+// Nodes are grouped into blocks by ranges of kBlockSize ids. A block is a bitmap of ids of its
+// nodes, the minimal coordinates of the nodes and bit widths of differences of coordinates of
+// the nodes with the minimal ones, then the differences packed with these widths. Nodes which
+// are created together have close ids and coordinates, so the differences are short, and any
+// node is read in O(1) by the rank of its id in the bitmap.
+//
+// The file is: blocks, 8 bytes of padding for loads of packed values, offsets of blocks and of
+// the end of blocks aligned to 8 bytes (uint64 each), the count of blocks (uint64) and the
+// position of offsets (uint64). Blocks without nodes are empty.
+uint32_t const kBlockSize = 256;
+uint32_t const kBitmapWordsCount = kBlockSize / 64;
+
+struct PackedBlockHeader
+{
+  uint64_t m_bitmap[kBitmapWordsCount] = {};
+  int32_t m_minLat = 0;
+  int32_t m_minLon = 0;
+  uint8_t m_latBits = 0;
+  uint8_t m_lonBits = 0;
+  // Counts of nodes before words of the bitmap.
+  uint8_t m_ranks[kBitmapWordsCount] = {};
+  uint8_t m_padding[2] = {};
+};
+static_assert(sizeof(PackedBlockHeader) == 48, "Invalid structure size");
+static_assert(std::is_trivially_copyable<PackedBlockHeader>::value, "");
+
+// PackedFilePointStorageReader --------------------------------------------------------------------
+class PackedFilePointStorageReader : public PointStorageReaderInterface
+{
+public:
+  explicit PackedFilePointStorageReader(string const & name)
+    : m_mmapReader(name + kPackedExtension)
+  {
+    uint64_t const size = m_mmapReader.Size();
+    CHECK_GREATER_OR_EQUAL(size, 2 * sizeof(uint64_t), ("Damaged file."));
+
+    m_data = m_mmapReader.Data();
+    uint64_t offsetsPos = 0;
+    memcpy(&m_blocksCount, m_data + size - 2 * sizeof(uint64_t), sizeof(m_blocksCount));
+    memcpy(&offsetsPos, m_data + size - sizeof(uint64_t), sizeof(offsetsPos));
+    CHECK_EQUAL(offsetsPos % sizeof(uint64_t), 0, ("Damaged file."));
+    CHECK_EQUAL(offsetsPos + (m_blocksCount + 3) * sizeof(uint64_t), size, ("Damaged file."));
+    m_offsets = reinterpret_cast<uint64_t const *>(m_data + offsetsPos);
+  }
+
+  // PointStorageReaderInterface overrides:
+  bool GetPoint(uint64_t id, double & lat, double & lon) const override
+  {
+    uint64_t const block = id / kBlockSize;
+    if (block >= m_blocksCount || m_offsets[block] == m_offsets[block + 1])
+      return false;
+
+    auto const & header = *reinterpret_cast<PackedBlockHeader const *>(m_data + m_offsets[block]);
+    uint32_t const bit = id % kBlockSize;
+    uint64_t const word = header.m_bitmap[bit / 64];
+    if (((word >> (bit % 64)) & 1) == 0)
+      return false;
+
+    uint64_t const rank =
+        header.m_ranks[bit / 64] + bits::PopCount(word & ((uint64_t{1} << (bit % 64)) - 1));
+
+    uint8_t const * values = m_data + m_offsets[block] + sizeof(PackedBlockHeader);
+    uint64_t const pos = rank * (header.m_latBits + header.m_lonBits);
+    LatLon ll;
+    ll.m_lat = static_cast<int32_t>(header.m_minLat + ReadBits(values, pos, header.m_latBits));
+    ll.m_lon = static_cast<int32_t>(header.m_minLon +
+                                    ReadBits(values, pos + header.m_latBits, header.m_lonBits));
+    return FromLatLon(ll, lat, lon);
+  }
+
+private:
+  // Reads |numBits| <= 32 bits at bit position |pos|.
+  static int64_t ReadBits(uint8_t const * values, uint64_t pos, uint8_t numBits)
+  {
+    uint64_t word;
+    memcpy(&word, values + pos / CHAR_BIT, sizeof(word));
+    word = SwapIfBigEndianMacroBased(word) >> (pos % CHAR_BIT);
+    return static_cast<int64_t>(word & bits::GetFullMask(numBits));
+  }
+
+  MmapReader m_mmapReader;
+  uint8_t const * m_data = nullptr;
+  uint64_t const * m_offsets = nullptr;
+  uint64_t m_blocksCount = 0;
+};
+
+// PackedFilePointStorageWriter --------------------------------------------------------------------
+class PackedFilePointStorageWriter : public PointStorageWriterBase
+{
+public:
+  explicit PackedFilePointStorageWriter(string const & name)
+    : m_fileWriter(name + kPackedExtension)
+  {
+  }
+
+  ~PackedFilePointStorageWriter()
+  {
+    FlushBlock();
+    m_offsets.push_back(m_fileWriter.Pos());
+
+    uint64_t const zero = 0;
+    m_fileWriter.Write(&zero, sizeof(zero));
+    uint64_t const padding =
+        (sizeof(uint64_t) - m_fileWriter.Pos() % sizeof(uint64_t)) % sizeof(uint64_t);
+    m_fileWriter.Write(&zero, static_cast<size_t>(padding));
+
+    uint64_t const offsetsPos = m_fileWriter.Pos();
+    uint64_t const blocksCount = m_offsets.size() - 1;
+    m_fileWriter.Write(m_offsets.data(), m_offsets.size() * sizeof(uint64_t));
+    m_fileWriter.Write(&blocksCount, sizeof(blocksCount));
+    m_fileWriter.Write(&offsetsPos, sizeof(offsetsPos));
+  }
+
+  // PointStorageWriterInterface overrides:
+  void AddPoint(uint64_t id, double lat, double lon) override
+  {
+    CHECK(m_numProcessedPoints == 0 || id > m_lastId,
+          ("Nodes must be sorted by ids for the packed node storage:", id, "after", m_lastId));
+
+    uint64_t const block = id / kBlockSize;
+    if (m_numProcessedPoints == 0 || block != m_offsets.size() - 1)
+    {
+      FlushBlock();
+      while (m_offsets.size() <= block)
+        m_offsets.push_back(m_fileWriter.Pos());
+    }
+
+    LatLon ll;
+    ToLatLon(lat, lon, ll);
+    m_ids.push_back(static_cast<uint32_t>(id % kBlockSize));
+    m_points.push_back(ll);
+
+    m_lastId = id;
+    ++m_numProcessedPoints;
+  }
+
+  uint64_t GetNumProcessedPoints() const override { return m_numProcessedPoints; }
+
+private:
+  void FlushBlock()
+  {
+    if (m_points.empty())
+      return;
+
+    PackedBlockHeader header;
+    header.m_minLat = header.m_minLon = numeric_limits<int32_t>::max();
+    int32_t maxLat = numeric_limits<int32_t>::min();
+    int32_t maxLon = numeric_limits<int32_t>::min();
+    for (size_t i = 0; i < m_points.size(); ++i)
+    {
+      header.m_bitmap[m_ids[i] / 64] |= uint64_t{1} << (m_ids[i] % 64);
+      header.m_minLat = min(header.m_minLat, m_points[i].m_lat);
+      header.m_minLon = min(header.m_minLon, m_points[i].m_lon);
+      maxLat = max(maxLat, m_points[i].m_lat);
+      maxLon = max(maxLon, m_points[i].m_lon);
+    }
+    for (uint32_t i = 1; i < kBitmapWordsCount; ++i)
+    {
+      header.m_ranks[i] =
+          static_cast<uint8_t>(header.m_ranks[i - 1] + bits::PopCount(header.m_bitmap[i - 1]));
+    }
+    header.m_latBits = static_cast<uint8_t>(
+        bits::NumUsedBits(static_cast<uint64_t>(int64_t{maxLat} - header.m_minLat)));
+    header.m_lonBits = static_cast<uint8_t>(
+        bits::NumUsedBits(static_cast<uint64_t>(int64_t{maxLon} - header.m_minLon)));
+    m_fileWriter.Write(&header, sizeof(header));
+
+    {
+      BitWriter<AsyncFileWriter> bitWriter(m_fileWriter);
+      for (auto const & ll : m_points)
+      {
+        bitWriter.WriteAtMost32Bits(static_cast<uint32_t>(int64_t{ll.m_lat} - header.m_minLat),
+                                    header.m_latBits);
+        bitWriter.WriteAtMost32Bits(static_cast<uint32_t>(int64_t{ll.m_lon} - header.m_minLon),
+                                    header.m_lonBits);
+      }
+    }
+
+    // Headers of blocks are aligned for direct access.
+    uint64_t const zero = 0;
+    uint64_t const padding =
+        (sizeof(uint64_t) - m_fileWriter.Pos() % sizeof(uint64_t)) % sizeof(uint64_t);
+    m_fileWriter.Write(&zero, static_cast<size_t>(padding));
+
+    m_ids.clear();
+    m_points.clear();
+  }
+
+  AsyncFileWriter m_fileWriter;
+  // Offsets of blocks which are started.
+  vector<uint64_t> m_offsets;
+  // Nodes of the current block.
+  vector<uint32_t> m_ids;
+  vector<LatLon> m_points;
+  uint64_t m_lastId = 0;
   uint64_t m_numProcessedPoints = 0;
 };
 }  // namespace
@@ -334,8 +544,38 @@ OSMElementCacheReader::OSMElementCacheReader(string const & name, bool preload)
   m_fileReader.Read(0, m_data.data(), sz);
 }
 
+uint64_t constexpr OSMElementCacheReader::kMaxChunkSize;
+uint64_t constexpr OSMElementCacheReader::kChunkTailSize;
+
 void OSMElementCacheReader::LoadOffsets() { m_offsets.ReadAll(); }
 
+// WaysCache ---------------------------------------------------------------------------------------
+WaysCache::WayPtr WaysCache::Get(Key id)
+{
+  lock_guard<mutex> lock(m_lock);
+  auto const it = m_index.find(id);
+  if (it == m_index.end())
+    return nullptr;
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->second;
+}
+
+void WaysCache::Put(Key id, WayPtr way)
+{
+  lock_guard<mutex> lock(m_lock);
+  if (m_index.find(id) != m_index.end())
+    return;
+
+  m_entries.emplace_front(id, move(way));
+  m_index.emplace(id, m_entries.begin());
+  if (m_entries.size() > m_maxSize)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+}
+
 // OSMElementCacheWriter ---------------------------------------------------------------------------
 OSMElementCacheWriter::OSMElementCacheWriter(string const & name, bool preload)
   : m_fileWriter(name), m_offsets(name + OFFSET_EXT), m_name(name), m_preload(preload)
@@ -352,7 +592,43 @@ IntermediateDataReader::IntermediateDataReader(shared_ptr<PointStorageReaderInte
     m_relations(info.GetIntermediateFileName(RELATIONS_FILE), info.m_preloadCache),
     m_nodeToRelations(info.GetIntermediateFileName(NODES_FILE, ID2REL_EXT)),
     m_wayToRelations(info.GetIntermediateFileName(WAYS_FILE, ID2REL_EXT))
-{}
+{
+  if (!info.m_preloadCache)
+    m_waysCache = make_unique<WaysCache>(kWaysCacheSize);
+}
+
+void IntermediateDataReader::GetWays(vector<Key> const & ids, vector<WaysCache::WayPtr> & ways)
+{
+  ways.assign(ids.size(), nullptr);
+  vector<Key> missing;
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    if (m_waysCache)
+      ways[i] = m_waysCache->Get(ids[i]);
+    if (!ways[i])
+      missing.push_back(ids[i]);
+  }
+
+  if (missing.empty())
+    return;
+
+  unordered_map<Key, WaysCache::WayPtr> read;
+  m_ways.ReadMany<WayElement>(missing, [&](Key id, WayElement & way) {
+    auto ptr = make_shared<WayElement const>(move(way));
+    if (m_waysCache)
+      m_waysCache->Put(id, ptr);
+    read.emplace(id, move(ptr));
+  });
+
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    if (ways[i])
+      continue;
+    auto const it = read.find(ids[i]);
+    if (it != read.end())
+      ways[i] = it->second;
+  }
+}
 
 void IntermediateDataReader::LoadIndex()
 {
@@ -406,6 +682,8 @@ CreatePointStorageReader(feature::GenerateInfo::NodeStorageType type, string con
     return make_shared<MapFilePointStorageReader>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return make_shared<RawMemPointStorageReader>(name);
+  case feature::GenerateInfo::NodeStorageType::Packed:
+    return make_shared<PackedFilePointStorageReader>(name);
   }
   CHECK_SWITCH();
 }
@@ -421,6 +699,8 @@ CreatePointStorageWriter(feature::GenerateInfo::NodeStorageType type, string con
     return make_shared<MapFilePointStorageWriter>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return make_shared<RawMemPointStorageWriter>(name);
+  case feature::GenerateInfo::NodeStorageType::Packed:
+    return make_shared<PackedFilePointStorageWriter>(name);
   }
   CHECK_SWITCH();
 }
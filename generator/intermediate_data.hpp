@@ -3,6 +3,7 @@
 #include "generator/generate_info.hpp"
 #include "generator/intermediate_elements.hpp"
 
+#include "coding/async_file_writer.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
@@ -15,7 +16,11 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -129,6 +134,7 @@ class OSMElementCacheReader
 public:
   explicit OSMElementCacheReader(std::string const & name, bool preload = false);
 
+  // This method is thread-safe.
   template <class Value>
   bool Read(Key id, Value & value)
   {
@@ -139,27 +145,108 @@ public:
       return false;
     }
 
-    uint32_t valueSize = m_preload ? *(reinterpret_cast<uint32_t *>(m_data.data() + pos)) : 0;
-    size_t offset = pos + sizeof(uint32_t);
+    if (m_preload)
+    {
+      uint32_t const valueSize = *(reinterpret_cast<uint32_t const *>(m_data.data() + pos));
+      MemReader reader(m_data.data() + pos + sizeof(uint32_t), valueSize);
+      value.Read(reader);
+      return true;
+    }
 
-    if (!m_preload)
+    // in case not-in-memory work we read buffer
+    thread_local std::vector<uint8_t> buffer;
     {
-      // in case not-in-memory work we read buffer
+      std::lock_guard<std::mutex> lock(*m_fileLock);
+      uint32_t valueSize = 0;
       m_fileReader.Read(pos, &valueSize, sizeof(valueSize));
-      m_data.resize(valueSize);
-      m_fileReader.Read(pos + sizeof(valueSize), m_data.data(), valueSize);
-      offset = 0;
+      buffer.resize(valueSize);
+      m_fileReader.Read(pos + sizeof(valueSize), buffer.data(), valueSize);
     }
 
-    MemReader reader(m_data.data() + offset, valueSize);
+    MemReader reader(buffer.data(), buffer.size());
     value.Read(reader);
     return true;
   }
 
+  // Reads values of |ids| and calls |toDo(id, value)| for the found ones, in the order of
+  // their positions in the file. Values which are close in the file are read by one chunk.
+  // This method is thread-safe.
+  template <class Value, class ToDo>
+  void ReadMany(std::vector<Key> const & ids, ToDo && toDo)
+  {
+    if (m_preload)
+    {
+      for (auto const id : ids)
+      {
+        Value value(id);
+        if (Read(id, value))
+          toDo(id, value);
+      }
+      return;
+    }
+
+    std::vector<std::pair<uint64_t, Key>> positions;
+    positions.reserve(ids.size());
+    for (auto const id : ids)
+    {
+      uint64_t pos = 0;
+      if (m_offsets.GetValueByKey(id, pos))
+        positions.emplace_back(pos, id);
+      else
+        LOG_SHORT(LWARNING, ("Can't find offset in file", m_name + OFFSET_EXT, "by id", id));
+    }
+    std::sort(positions.begin(), positions.end());
+
+    uint64_t const fileSize = m_fileReader.Size();
+    thread_local std::vector<uint8_t> chunk;
+    for (size_t i = 0; i < positions.size();)
+    {
+      uint64_t const chunkPos = positions[i].first;
+      size_t j = i + 1;
+      while (j < positions.size() && positions[j].first - chunkPos < kMaxChunkSize)
+        ++j;
+
+      uint64_t const chunkEnd = std::min(positions[j - 1].first + kChunkTailSize, fileSize);
+      chunk.resize(static_cast<size_t>(chunkEnd - chunkPos));
+      {
+        std::lock_guard<std::mutex> lock(*m_fileLock);
+        m_fileReader.Read(chunkPos, chunk.data(), chunk.size());
+      }
+
+      for (; i < j; ++i)
+      {
+        Key const id = positions[i].second;
+        Value value(id);
+        size_t const offset = static_cast<size_t>(positions[i].first - chunkPos);
+        uint32_t valueSize = 0;
+        if (offset + sizeof(valueSize) <= chunk.size())
+          memcpy(&valueSize, chunk.data() + offset, sizeof(valueSize));
+
+        if (offset + sizeof(valueSize) + valueSize <= chunk.size())
+        {
+          MemReader reader(chunk.data() + offset + sizeof(valueSize), valueSize);
+          value.Read(reader);
+        }
+        else if (!Read(id, value))
+        {
+          continue;
+        }
+        toDo(id, value);
+      }
+    }
+  }
+
   void LoadOffsets();
 
 protected:
+  // Values which are closer in the file than kMaxChunkSize are read at once. The chunk is
+  // followed by kChunkTailSize bytes, so most of the last value is read with the chunk too.
+  static uint64_t constexpr kMaxChunkSize = 256 * 1024;
+  static uint64_t constexpr kChunkTailSize = 4 * 1024;
+
   FileReader m_fileReader;
+  // Guards the file position of |m_fileReader|. It is a pointer to keep the reader movable.
+  std::unique_ptr<std::mutex> m_fileLock = std::make_unique<std::mutex>();
   IndexFileReader m_offsets;
   std::string m_name;
   std::vector<uint8_t> m_data;
@@ -189,13 +276,36 @@ public:
   void SaveOffsets();
 
 protected:
-  FileWriter m_fileWriter;
+  AsyncFileWriter m_fileWriter;
   IndexFileWriter m_offsets;
   std::string m_name;
   std::vector<uint8_t> m_data;
   bool m_preload = false;
 };
 
+// Least recently used decoded ways. This class is thread-safe.
+class WaysCache
+{
+public:
+  using WayPtr = std::shared_ptr<WayElement const>;
+
+  explicit WaysCache(size_t maxSize) : m_maxSize(maxSize) {}
+
+  // Returns nullptr when the way is not cached.
+  WayPtr Get(Key id);
+  void Put(Key id, WayPtr way);
+
+private:
+  using Entries = std::list<std::pair<Key, WayPtr>>;
+
+  std::mutex m_lock;
+  // The most recently used ways are at the front.
+  Entries m_entries;
+  std::unordered_map<Key, Entries::iterator> m_index;
+  size_t const m_maxSize;
+};
+
+// Reading of elements is thread-safe after LoadIndex().
 class IntermediateDataReader
 {
 public:
@@ -203,6 +313,10 @@ public:
 
   bool GetNode(Key id, double & lat, double & lon) const { return m_nodes->GetPoint(id, lat, lon); }
   bool GetWay(Key id, WayElement & e) { return m_ways.Read(id, e); }
+  // Fills |ways| by ways of |ids|, or by nullptr for missing ones. Ways of relations are
+  // requested together: cached ones are taken from an LRU, others are read by one batch.
+  void GetWays(std::vector<Key> const & ids, std::vector<WaysCache::WayPtr> & ways);
+  bool GetRelation(Key id, RelationElement & e) { return m_relations.Read(id, e); }
   void LoadIndex();
 
   template <typename ToDo>
@@ -265,6 +379,8 @@ private:
 
   std::shared_ptr<PointStorageReaderInterface> m_nodes;
   cache::OSMElementCacheReader m_ways;
+  // It is null when ways are preloaded.
+  std::unique_ptr<WaysCache> m_waysCache;
   cache::OSMElementCacheReader m_relations;
   cache::IndexFileReader m_nodeToRelations;
   cache::IndexFileReader m_wayToRelations;
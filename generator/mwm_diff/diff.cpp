@@ -1,16 +1,23 @@
 #include "generator/mwm_diff/diff.hpp"
 
+#include "coding/file_container.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/read_write_utils.hpp"
 #include "coding/reader.hpp"
+#include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 #include "coding/writer.hpp"
 #include "coding/zlib.hpp"
 
 #include "base/logging.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "3party/bsdiff-courgette/bsdiff/bsdiff.h"
@@ -23,9 +30,128 @@ enum Version
 {
   // Format Version 0: bsdiff+gzip.
   VERSION_V0 = 0,
-  VERSION_LATEST = VERSION_V0
+  // Format Version 1: sections of the new mwm in the order of their offsets. A section is
+  // either copied from the old mwm, or patched by bsdiff, or stored. Patches and stored
+  // sections are compressed by blocks.
+  VERSION_V1 = 1,
+  VERSION_LATEST = VERSION_V1
 };
 
+enum class SectionKind : uint8_t
+{
+  Copy = 0,
+  Patch = 1,
+  Data = 2
+};
+
+// Size of uncompressed blocks of patches and stored sections and of buffers for copying.
+size_t const kBlockSize = 1 << 20;
+
+// Writes data to |m_writer| by big portions and calculates its checksum.
+class CrcSink
+{
+public:
+  explicit CrcSink(Writer & writer) : m_writer(writer) { m_buffer.reserve(kBufferSize); }
+  ~CrcSink() { Flush(); }
+
+  void Write(void const * p, size_t size)
+  {
+    auto const * data = static_cast<uint8_t const *>(p);
+    if (m_buffer.size() + size > kBufferSize)
+    {
+      Flush();
+      if (size > kBufferSize)
+      {
+        Process(data, size);
+        return;
+      }
+    }
+    m_buffer.insert(m_buffer.end(), data, data + size);
+  }
+
+  void Flush()
+  {
+    Process(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+  }
+
+  uint64_t Size() const { return m_size + m_buffer.size(); }
+
+  // Call Flush() before.
+  uint32_t Crc() const { return m_crc; }
+
+private:
+  static size_t const kBufferSize = 1 << 16;
+
+  void Process(uint8_t const * data, size_t size)
+  {
+    m_crc = static_cast<uint32_t>(crc32(m_crc, data, static_cast<uInt>(size)));
+    m_writer.Write(data, size);
+    m_size += size;
+  }
+
+  Writer & m_writer;
+  vector<uint8_t> m_buffer;
+  uint32_t m_crc = 0;
+  uint64_t m_size = 0;
+};
+
+size_t const CrcSink::kBufferSize;
+
+uint32_t CalculateCrc(vector<uint8_t> const & data)
+{
+  return static_cast<uint32_t>(crc32(0, data.data(), static_cast<uInt>(data.size())));
+}
+
+vector<uint8_t> ReadSection(FilesContainerR const & container, string const & tag)
+{
+  auto const reader = container.GetReader(tag);
+  vector<uint8_t> data(reader.Size());
+  reader.Read(0, data.data(), data.size());
+  return data;
+}
+
+void WriteBlocks(vector<uint8_t> const & data, FileWriter & writer)
+{
+  using Deflate = coding::ZLib::Deflate;
+  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+
+  uint64_t const count = (data.size() + kBlockSize - 1) / kBlockSize;
+  WriteVarUint(writer, count);
+
+  vector<uint8_t> block;
+  for (size_t pos = 0; pos < data.size(); pos += kBlockSize)
+  {
+    block.clear();
+    deflate(data.data() + pos, min(kBlockSize, data.size() - pos), back_inserter(block));
+    WriteVarUint(writer, static_cast<uint64_t>(block.size()));
+    writer.Write(block.data(), block.size());
+  }
+}
+
+// Calls |fn| for every uncompressed block.
+template <typename Fn>
+bool ReadBlocks(ReaderSource<FileReader> & src, Fn && fn)
+{
+  using Inflate = coding::ZLib::Inflate;
+  Inflate inflate(Inflate::Format::ZLib);
+
+  auto const count = ReadVarUint<uint64_t>(src);
+  vector<uint8_t> deflated;
+  vector<uint8_t> block;
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    deflated.resize(ReadVarUint<uint64_t>(src));
+    src.Read(deflated.data(), deflated.size());
+
+    block.clear();
+    if (!inflate(deflated.data(), deflated.size(), back_inserter(block)))
+      return false;
+    fn(block);
+  }
+  return true;
+}
+
 bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter & diffFileWriter)
 {
   vector<uint8_t> diffBuf;
@@ -52,6 +178,63 @@ bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter
   return true;
 }
 
+bool MakeDiffVersion1(FilesContainerR const & oldContainer, FilesContainerR const & newContainer,
+                      FileWriter & diffFileWriter)
+{
+  vector<pair<uint64_t, string>> sections;
+  newContainer.ForEachTag([&](FilesContainerR::Tag const & tag) {
+    sections.emplace_back(newContainer.GetAbsoluteOffsetAndSize(tag).first, tag);
+  });
+  sort(sections.begin(), sections.end());
+
+  WriteToSink(diffFileWriter, static_cast<uint32_t>(VERSION_V1));
+  WriteVarUint(diffFileWriter, static_cast<uint64_t>(sections.size()));
+
+  for (auto const & section : sections)
+  {
+    auto const & tag = section.second;
+    auto const newData = ReadSection(newContainer, tag);
+
+    auto kind = SectionKind::Data;
+    vector<uint8_t> patch;
+    if (oldContainer.IsExist(tag))
+    {
+      auto const oldData = ReadSection(oldContainer, tag);
+      if (oldData == newData)
+      {
+        kind = SectionKind::Copy;
+      }
+      else
+      {
+        MemReader oldReader(oldData.data(), oldData.size());
+        MemReader newReader(newData.data(), newData.size());
+        MemWriter<vector<uint8_t>> patchWriter(patch);
+        auto const status = bsdiff::CreateBinaryPatch(oldReader, newReader, patchWriter);
+        if (status != bsdiff::BSDiffStatus::OK)
+        {
+          LOG(LERROR, ("Could not create patch with bsdiff for section", tag, ":", status));
+          return false;
+        }
+        kind = SectionKind::Patch;
+      }
+    }
+
+    rw::Write(diffFileWriter, tag);
+    WriteToSink(diffFileWriter, static_cast<uint8_t>(kind));
+    WriteToSink(diffFileWriter, static_cast<uint64_t>(newData.size()));
+    WriteToSink(diffFileWriter, CalculateCrc(newData));
+
+    switch (kind)
+    {
+    case SectionKind::Copy: break;
+    case SectionKind::Patch: WriteBlocks(patch, diffFileWriter); break;
+    case SectionKind::Data: WriteBlocks(newData, diffFileWriter); break;
+    }
+  }
+
+  return true;
+}
+
 bool ApplyDiffVersion0(FileReader & oldReader, FileWriter & newWriter,
                        ReaderSource<FileReader> & diffFileSource)
 {
@@ -76,6 +259,100 @@ bool ApplyDiffVersion0(FileReader & oldReader, FileWriter & newWriter,
 
   return true;
 }
+
+bool ApplySection(FilesContainerR const & oldContainer, string const & tag, SectionKind kind,
+                  ReaderSource<FileReader> & diffFileSource, CrcSink & sink)
+{
+  switch (kind)
+  {
+  case SectionKind::Copy:
+  {
+    if (!oldContainer.IsExist(tag))
+      return false;
+
+    ReaderSource<FilesContainerR::TReader> src(oldContainer.GetReader(tag));
+    vector<uint8_t> buffer(kBlockSize);
+    while (src.Size() > 0)
+    {
+      size_t const size = static_cast<size_t>(min<uint64_t>(src.Size(), buffer.size()));
+      src.Read(buffer.data(), size);
+      sink.Write(buffer.data(), size);
+    }
+    return true;
+  }
+  case SectionKind::Patch:
+  {
+    if (!oldContainer.IsExist(tag))
+      return false;
+
+    vector<uint8_t> patch;
+    if (!ReadBlocks(diffFileSource, [&patch](vector<uint8_t> const & block) {
+          patch.insert(patch.end(), block.begin(), block.end());
+        }))
+    {
+      return false;
+    }
+
+    auto oldReader = oldContainer.GetReader(tag);
+    MemReader patchReader(patch.data(), patch.size());
+    auto const status = bsdiff::ApplyBinaryPatch(oldReader, sink, patchReader);
+    if (status != bsdiff::BSDiffStatus::OK)
+    {
+      LOG(LERROR, ("Could not apply patch with bsdiff to section", tag, ":", status));
+      return false;
+    }
+    return true;
+  }
+  case SectionKind::Data:
+    return ReadBlocks(diffFileSource, [&sink](vector<uint8_t> const & block) {
+      sink.Write(block.data(), block.size());
+    });
+  }
+  return false;
+}
+
+bool ApplyDiffVersion1(FilesContainerR const & oldContainer, string const & newMwmPath,
+                       ReaderSource<FileReader> & diffFileSource,
+                       generator::mwm_diff::ApplyProgressFn const & progress)
+{
+  uint64_t const diffSize = diffFileSource.Size() + diffFileSource.Pos();
+  FilesContainerW newContainer(newMwmPath);
+
+  auto const count = ReadVarUint<uint64_t>(diffFileSource);
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    string tag;
+    rw::Read(diffFileSource, tag);
+    auto const kind = static_cast<SectionKind>(ReadPrimitiveFromSource<uint8_t>(diffFileSource));
+    auto const size = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+    auto const crc = ReadPrimitiveFromSource<uint32_t>(diffFileSource);
+
+    bool ok = false;
+    uint64_t written = 0;
+    uint32_t writtenCrc = 0;
+    {
+      FileWriter writer = newContainer.GetWriter(tag);
+      CrcSink sink(writer);
+      ok = ApplySection(oldContainer, tag, kind, diffFileSource, sink);
+      sink.Flush();
+      written = sink.Size();
+      writtenCrc = sink.Crc();
+    }
+
+    if (!ok || written != size || writtenCrc != crc)
+    {
+      LOG(LERROR, ("Could not apply diff to section", tag, "size:", written, "expected:", size,
+                   "crc:", writtenCrc, "expected:", crc));
+      return false;
+    }
+
+    if (progress)
+      progress(diffFileSource.Pos(), diffSize);
+  }
+
+  newContainer.Finish();
+  return true;
+}
 }  // namespace
 
 namespace generator
@@ -90,12 +367,27 @@ bool MakeDiff(string const & oldMwmPath, string const & newMwmPath, string const
     FileReader newReader(newMwmPath);
     FileWriter diffFileWriter(diffPath);
 
-    switch (VERSION_LATEST)
+    unique_ptr<FilesContainerR> oldContainer;
+    unique_ptr<FilesContainerR> newContainer;
+    try
+    {
+      oldContainer = make_unique<FilesContainerR>(oldMwmPath);
+      newContainer = make_unique<FilesContainerR>(newMwmPath);
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG(LINFO, ("Files are not containers, making a diff of the whole files:", e.Msg()));
+    }
+
+    // Only whole files can be diffed if they are not containers.
+    auto const version = newContainer ? VERSION_LATEST : VERSION_V0;
+    switch (version)
     {
     case VERSION_V0: return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+    case VERSION_V1: return MakeDiffVersion1(*oldContainer, *newContainer, diffFileWriter);
     default:
       LOG(LERROR,
-          ("Making mwm diffs with diff format version", VERSION_LATEST, "is not implemented"));
+          ("Making mwm diffs with diff format version", version, "is not implemented"));
     }
   }
   catch (Reader::Exception const & e)
@@ -113,11 +405,15 @@ bool MakeDiff(string const & oldMwmPath, string const & newMwmPath, string const
 }
 
 bool ApplyDiff(string const & oldMwmPath, string const & newMwmPath, string const & diffPath)
+{
+  return ApplyDiff(oldMwmPath, newMwmPath, diffPath, nullptr /* progress */);
+}
+
+bool ApplyDiff(string const & oldMwmPath, string const & newMwmPath, string const & diffPath,
+               ApplyProgressFn const & progress)
 {
   try
   {
-    FileReader oldReader(oldMwmPath);
-    FileWriter newWriter(newMwmPath);
     FileReader diffFileReader(diffPath);
 
     ReaderSource<FileReader> diffFileSource(diffFileReader);
@@ -125,7 +421,17 @@ bool ApplyDiff(string const & oldMwmPath, string const & newMwmPath, string cons
 
     switch (version)
     {
-    case VERSION_V0: return ApplyDiffVersion0(oldReader, newWriter, diffFileSource);
+    case VERSION_V0:
+    {
+      FileReader oldReader(oldMwmPath);
+      FileWriter newWriter(newMwmPath);
+      bool const result = ApplyDiffVersion0(oldReader, newWriter, diffFileSource);
+      if (result && progress)
+        progress(diffFileReader.Size(), diffFileReader.Size());
+      return result;
+    }
+    case VERSION_V1:
+      return ApplyDiffVersion1(FilesContainerR(oldMwmPath), newMwmPath, diffFileSource, progress);
     default: LOG(LERROR, ("Unknown version format of mwm diff:", version));
     }
   }
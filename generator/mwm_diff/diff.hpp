@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
 
 namespace generator
@@ -9,16 +11,25 @@ namespace mwm_diff
 // Makes a diff that, when applied to the mwm at |oldMwmPath|, will
 // result in the mwm at |newMwmPath|. The diff is stored at |diffPath|.
 // It is assumed that the files at |oldMwmPath| and |newMwmPath| are valid mwms.
+// A diff of the whole files is made when they are not file containers.
 // Returns true on success and false on failure.
 bool MakeDiff(std::string const & oldMwmPath, std::string const & newMwmPath,
               std::string const & diffPath);
 
+// Called with the number of processed bytes of the diff and the size of the diff.
+using ApplyProgressFn = std::function<void(uint64_t processed, uint64_t total)>;
+
 // Applies the diff at |diffPath| to the mwm at |oldMwmPath|. The resulting
 // mwm is stored at |newMwmPath|.
 // It is assumed that the file at |oldMwmPath| is a valid mwm and the file
 // at |diffPath| is a valid mwmdiff.
+// Diffs of mwm containers are applied section by section, so neither the whole
+// diff nor the whole mwm are kept in memory, and a checksum of every section is verified
+// as soon as the section is written.
 // Returns true on success and false on failure.
 bool ApplyDiff(std::string const & oldMwmPath, std::string const & newMwmPath,
                std::string const & diffPath);
+bool ApplyDiff(std::string const & oldMwmPath, std::string const & newMwmPath,
+               std::string const & diffPath, ApplyProgressFn const & progress);
 }  // namespace mwm_diff
 }  // namespace generator
@@ -4,12 +4,17 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
 
+#include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 
+#include <string>
+#include <vector>
+
 using namespace std;
 
 namespace generator
@@ -41,5 +46,70 @@ UNIT_TEST(IncrementalUpdates_Smoke)
 
   TEST(base::IsEqualFiles(newMwmPath1, newMwmPath2), ());
 }
+
+UNIT_TEST(IncrementalUpdates_Sections)
+{
+  string const oldMwmPath = base::JoinFoldersToPath(GetPlatform().WritableDir(), "sections.mwm");
+  string const newMwmPath1 =
+      base::JoinFoldersToPath(GetPlatform().WritableDir(), "sections-new1.mwm");
+  string const newMwmPath2 =
+      base::JoinFoldersToPath(GetPlatform().WritableDir(), "sections-new2.mwm");
+  string const diffPath = base::JoinFoldersToPath(GetPlatform().WritableDir(), "sections.mwmdiff");
+
+  SCOPE_GUARD(cleanup, [&] {
+    FileWriter::DeleteFileX(oldMwmPath);
+    FileWriter::DeleteFileX(newMwmPath1);
+    FileWriter::DeleteFileX(newMwmPath2);
+    FileWriter::DeleteFileX(diffPath);
+  });
+
+  vector<uint8_t> same(3000000);
+  for (size_t i = 0; i < same.size(); ++i)
+    same[i] = static_cast<uint8_t>(i * 7 % 251);
+  vector<uint8_t> changed = same;
+  vector<uint8_t> const added(100, 'a');
+
+  {
+    FilesContainerW writer(oldMwmPath);
+    writer.Write(same, "same");
+    writer.Write(same, "changed");
+    writer.Write(added, "removed");
+  }
+
+  changed[10] = 'x';
+  changed.insert(changed.begin() + 2000000, added.begin(), added.end());
+  {
+    FilesContainerW writer(newMwmPath1);
+    writer.Write(changed, "changed");
+    writer.Write(added, "added");
+    writer.Write(same, "same");
+  }
+
+  TEST(MakeDiff(oldMwmPath, newMwmPath1, diffPath), ());
+
+  uint64_t lastProcessed = 0;
+  uint64_t total = 0;
+  TEST(ApplyDiff(oldMwmPath, newMwmPath2, diffPath,
+                 [&](uint64_t processed, uint64_t size) {
+                   TEST_GREATER(processed, lastProcessed, ());
+                   lastProcessed = processed;
+                   total = size;
+                 }),
+       ());
+  TEST_EQUAL(lastProcessed, total, ());
+
+  TEST(base::IsEqualFiles(newMwmPath1, newMwmPath2), ());
+
+  // A section of the old mwm is broken.
+  {
+    FilesContainerW writer(oldMwmPath);
+    writer.Write(changed, "same");
+    writer.Write(same, "changed");
+  }
+  {
+    base::ScopedLogAbortLevelChanger const logAbortLevel(LCRITICAL);
+    TEST(!ApplyDiff(oldMwmPath, newMwmPath2, diffPath), ());
+  }
+}
 }  // namespace mwm_diff
 }  // namespace generator
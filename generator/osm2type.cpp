@@ -115,22 +115,26 @@ public:
 
   bool GetLangByKey(string const & k, string & lang)
   {
+    // Tokens are not copied because it's called for all tags of all elements.
     strings::SimpleTokenizer token(k, "\t :");
     if (!token)
       return false;
 
     // Is this an international (latin) name.
-    if (*token == "int_name")
+    if (token.GetView() == "int_name")
     {
-      lang = *token;
+      lang = "int_name";
       return m_savedNames.insert(lang).second;
     }
 
-    if (*token != "name")
+    if (token.GetView() != "name")
       return false;
 
     ++token;
-    lang = (token ? *token : "default");
+    if (token)
+      lang.assign(token.GetView().data(), token.GetView().size());
+    else
+      lang = "default";
 
     // Do not consider languages with suffixes, like "en:pronunciation".
     if (++token)
@@ -0,0 +1,305 @@
+#include "generator/osm_change.hpp"
+
+#include "generator/osm_xml_source.hpp"
+
+#include "coding/file_writer.hpp"
+#include "coding/parse_xml.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace generator
+{
+namespace
+{
+// Passes objects of osmChange/{create,modify,delete} to XMLSource as if they were children
+// of the root tag of an ordinary OSM XML file.
+class XMLChangeSource
+{
+public:
+  using Processor = function<void(OsmChangeAction, OsmElement *)>;
+
+  explicit XMLChangeSource(Processor const & processor)
+    : m_source([this, processor](OsmElement * e) { processor(m_action, e); })
+  {
+  }
+
+  void CharData(string const & data) { m_source.CharData(data); }
+
+  void AddAttr(string const & key, string const & value)
+  {
+    if (m_depth != kActionDepth)
+      m_source.AddAttr(key, value);
+  }
+
+  bool Push(string const & tagName)
+  {
+    if (++m_depth != kActionDepth)
+      return m_source.Push(tagName);
+
+    if (tagName == "create")
+    {
+      m_action = OsmChangeAction::Create;
+    }
+    else if (tagName == "delete")
+    {
+      m_action = OsmChangeAction::Delete;
+    }
+    else
+    {
+      if (tagName != "modify")
+        LOG(LWARNING, ("Unknown change action", tagName));
+      m_action = OsmChangeAction::Modify;
+    }
+    return true;
+  }
+
+  void Pop(string const & v)
+  {
+    if (m_depth-- != kActionDepth)
+      m_source.Pop(v);
+  }
+
+private:
+  static size_t constexpr kActionDepth = 2;
+
+  XMLSource m_source;
+  OsmChangeAction m_action = OsmChangeAction::Modify;
+  size_t m_depth = 0;
+};
+
+size_t constexpr XMLChangeSource::kActionDepth;
+}  // namespace
+
+string DebugPrint(OsmChangeAction action)
+{
+  switch (action)
+  {
+  case OsmChangeAction::Create: return "Create";
+  case OsmChangeAction::Modify: return "Modify";
+  case OsmChangeAction::Delete: return "Delete";
+  }
+  CHECK_SWITCH();
+}
+
+void ProcessOsmChangeFromXML(SourceReader & stream,
+                             function<void(OsmChangeAction, OsmElement *)> processor)
+{
+  XMLChangeSource parser(processor);
+  ParseXMLSequence(stream, parser);
+}
+
+// OsmChangePoints ---------------------------------------------------------------------------------
+OsmChangePoints::OsmChangePoints(cache::IntermediateDataReader & holder) : m_holder(holder) {}
+
+void OsmChangePoints::Add(OsmChangeAction action, OsmElement const & element)
+{
+  if (action != OsmChangeAction::Delete)
+  {
+    if (element.IsNode())
+      m_nodes[element.id] = MercatorBounds::FromLatLon(element.lat, element.lon);
+    else if (element.IsWay())
+      m_ways[element.id] = element.Nodes();
+  }
+  m_changes.push_back({action, element});
+}
+
+void OsmChangePoints::ForEachPoint(PointFn const & toDo)
+{
+  for (auto const & change : m_changes)
+  {
+    auto const & e = change.m_element;
+    bool const hasOld = change.m_action != OsmChangeAction::Create;
+    bool const hasNew = change.m_action != OsmChangeAction::Delete;
+
+    m2::PointD pt;
+    switch (e.type)
+    {
+    case OsmElement::EntityType::Node:
+      if (hasOld && GetOldPoint(e.id, pt))
+        toDo(pt);
+      if (hasNew && GetNewPoint(e.id, pt))
+        toDo(pt);
+      break;
+    case OsmElement::EntityType::Way:
+      if (hasOld)
+        ForEachOldWayPoint(e.id, toDo);
+      if (hasNew)
+        ForEachNewWayPoint(e.id, toDo);
+      break;
+    case OsmElement::EntityType::Relation:
+      if (hasOld)
+        ForEachOldRelationPoint(e.id, toDo);
+      if (hasNew)
+        ForEachNewRelationPoint(e, toDo);
+      break;
+    default:
+      LOG(LWARNING, ("Unexpected element in change:", e.ToString()));
+    }
+  }
+}
+
+bool OsmChangePoints::GetOldPoint(uint64_t id, m2::PointD & pt) const
+{
+  // Nodes are stored in mercator.
+  return m_holder.GetNode(id, pt.y, pt.x);
+}
+
+bool OsmChangePoints::GetNewPoint(uint64_t id, m2::PointD & pt) const
+{
+  auto const it = m_nodes.find(id);
+  if (it == m_nodes.end())
+    return GetOldPoint(id, pt);
+
+  pt = it->second;
+  return true;
+}
+
+void OsmChangePoints::ForEachOldWayPoint(uint64_t id, PointFn const & toDo)
+{
+  WayElement way(id);
+  if (!m_holder.GetWay(id, way))
+    return;
+
+  m2::PointD pt;
+  for (auto const node : way.nodes)
+  {
+    if (GetOldPoint(node, pt))
+      toDo(pt);
+  }
+}
+
+void OsmChangePoints::ForEachNewWayPoint(uint64_t id, PointFn const & toDo)
+{
+  auto const it = m_ways.find(id);
+  if (it == m_ways.end())
+  {
+    // The way itself is unchanged, but its nodes may be moved by the change.
+    WayElement way(id);
+    if (!m_holder.GetWay(id, way))
+      return;
+
+    m2::PointD pt;
+    for (auto const node : way.nodes)
+    {
+      if (GetNewPoint(node, pt))
+        toDo(pt);
+    }
+    return;
+  }
+
+  m2::PointD pt;
+  for (auto const node : it->second)
+  {
+    if (GetNewPoint(node, pt))
+      toDo(pt);
+  }
+}
+
+void OsmChangePoints::ForEachNewRelationPoint(OsmElement const & relation, PointFn const & toDo)
+{
+  m2::PointD pt;
+  for (auto const & member : relation.Members())
+  {
+    switch (member.type)
+    {
+    case OsmElement::EntityType::Node:
+      if (GetNewPoint(member.ref, pt))
+        toDo(pt);
+      break;
+    case OsmElement::EntityType::Way: ForEachNewWayPoint(member.ref, toDo); break;
+    // Subrelations are not stored in the intermediate data.
+    default: break;
+    }
+  }
+}
+
+void OsmChangePoints::ForEachOldRelationPoint(uint64_t id, PointFn const & toDo)
+{
+  RelationElement relation;
+  if (!m_holder.GetRelation(id, relation))
+    return;
+
+  m2::PointD pt;
+  for (auto const & node : relation.nodes)
+  {
+    if (GetOldPoint(node.first, pt))
+      toDo(pt);
+  }
+  for (auto const & way : relation.ways)
+    ForEachOldWayPoint(way.first, toDo);
+}
+
+vector<string> GetAffectedCountries(OsmChangePoints & points,
+                                    borders::CountriesContainer const & countries)
+{
+  set<string> affected;
+  points.ForEachPoint([&](m2::PointD const & pt) {
+    m2::RectD const rect(pt, pt);
+    countries.ForEachInRect(rect, [&](borders::CountryPolygons const & country) {
+      if (affected.count(country.m_name) != 0)
+        return;
+
+      bool contains = false;
+      country.m_regions.ForEachInRect(rect, [&](borders::Region const & region) {
+        contains = contains || region.Contains(pt);
+      });
+      if (contains)
+        affected.insert(country.m_name);
+    });
+  });
+  return vector<string>(affected.begin(), affected.end());
+}
+
+bool GenerateAffectedCountries(feature::GenerateInfo & info, string const & oscFileName,
+                               string const & outFileName)
+{
+  borders::CountriesContainer countries;
+  if (!borders::LoadCountriesList(info.m_targetDir, countries))
+  {
+    LOG(LERROR, ("Can't load countries borders from", info.m_targetDir));
+    return false;
+  }
+
+  auto nodes = cache::CreatePointStorageReader(info.m_nodeStorageType,
+                                               info.GetIntermediateFileName(NODES_FILE));
+  cache::IntermediateDataReader holder(nodes, info);
+  holder.LoadIndex();
+
+  OsmChangePoints points(holder);
+  SourceReader reader = oscFileName.empty() ? SourceReader() : SourceReader(oscFileName);
+  ProcessOsmChangeFromXML(reader, [&points](OsmChangeAction action, OsmElement * e) {
+    points.Add(action, *e);
+  });
+
+  auto const affected = GetAffectedCountries(points, countries);
+  LOG(LINFO, (affected.size(), "countries are affected by", oscFileName));
+
+  try
+  {
+    FileWriter writer(outFileName);
+    for (auto const & name : affected)
+    {
+      writer.Write(name.data(), name.size());
+      writer.Write("\n", 1);
+    }
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LERROR, ("Can't write affected countries to", outFileName, e.what()));
+    return false;
+  }
+  return true;
+}
+}  // namespace generator
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "generator/borders_loader.hpp"
+#include "generator/generate_info.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/intermediate_elements.hpp"
+#include "generator/osm_element.hpp"
+#include "generator/osm_source.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace generator
+{
+// Kind of a change of an OSM object in an OsmChange (.osc) file.
+enum class OsmChangeAction
+{
+  Create,
+  Modify,
+  Delete
+};
+
+std::string DebugPrint(OsmChangeAction action);
+
+// Calls |processor| for every object of an OsmChange XML file, see
+// https://wiki.openstreetmap.org/wiki/OsmChange
+void ProcessOsmChangeFromXML(SourceReader & stream,
+                             std::function<void(OsmChangeAction, OsmElement *)> processor);
+
+// Collects the places where OSM objects were changed. Both old positions taken from the
+// intermediate data and new positions taken from the change are collected, so a feature
+// which has been moved into another country affects both countries.
+class OsmChangePoints
+{
+public:
+  using PointFn = std::function<void(m2::PointD const & pt)>;
+
+  explicit OsmChangePoints(cache::IntermediateDataReader & holder);
+
+  void Add(OsmChangeAction action, OsmElement const & element);
+
+  // Calls |toDo| for every changed point in mercator. A point may be passed more than once.
+  void ForEachPoint(PointFn const & toDo);
+
+private:
+  struct Change
+  {
+    OsmChangeAction m_action;
+    OsmElement m_element;
+  };
+
+  bool GetOldPoint(uint64_t id, m2::PointD & pt) const;
+  bool GetNewPoint(uint64_t id, m2::PointD & pt) const;
+
+  void ForEachOldWayPoint(uint64_t id, PointFn const & toDo);
+  void ForEachNewWayPoint(uint64_t id, PointFn const & toDo);
+  void ForEachNewRelationPoint(OsmElement const & relation, PointFn const & toDo);
+  void ForEachOldRelationPoint(uint64_t id, PointFn const & toDo);
+
+  cache::IntermediateDataReader & m_holder;
+  std::vector<Change> m_changes;
+  // New positions of created and modified nodes.
+  std::unordered_map<uint64_t, m2::PointD> m_nodes;
+  // New versions of created and modified ways.
+  std::unordered_map<uint64_t, std::vector<uint64_t>> m_ways;
+};
+
+// Returns sorted names of |countries| which contain at least one of the changed points.
+std::vector<std::string> GetAffectedCountries(OsmChangePoints & points,
+                                              borders::CountriesContainer const & countries);
+
+// Finds countries affected by the OsmChange file |oscFileName| applied to the planet which
+// intermediate data is described by |info|, and writes their names to |outFileName|, one
+// per line. Only these countries need to be regenerated after the planet is updated.
+bool GenerateAffectedCountries(feature::GenerateInfo & info, std::string const & oscFileName,
+                               std::string const & outFileName);
+}  // namespace generator
@@ -0,0 +1,509 @@
+#include "generator/osm_pbf_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <utility>
+
+using namespace std;
+
+namespace osm
+{
+namespace
+{
+// Limits of the format.
+uint32_t constexpr kMaxBlobHeaderSize = 64 * 1024;
+uint32_t constexpr kMaxBlobSize = 32 * 1024 * 1024;
+
+double constexpr kCoordinatesUnit = 1e-9;
+
+// Wire types of the protobuf format.
+uint32_t constexpr kVarint = 0;
+uint32_t constexpr kFixed64 = 1;
+uint32_t constexpr kLengthDelimited = 2;
+uint32_t constexpr kFixed32 = 5;
+
+// Reader of the protobuf wire format. Messages of the format are simple, so they are read
+// without generated code and without copying of the data.
+class ProtoReader
+{
+public:
+  ProtoReader() = default;
+  ProtoReader(uint8_t const * data, size_t size) : m_pos(data), m_end(data + size) {}
+
+  // Moves to the next field of the message. Returns false at the end of the message.
+  bool Next()
+  {
+    if (m_pos == m_end)
+      return false;
+
+    auto const key = ReadVarint();
+    m_field = static_cast<uint32_t>(key >> 3);
+    m_wireType = static_cast<uint32_t>(key & 0x7);
+    return true;
+  }
+
+  uint32_t GetField() const { return m_field; }
+  bool Empty() const { return m_pos == m_end; }
+
+  uint64_t ReadVarint()
+  {
+    uint64_t result = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      CHECK(m_pos != m_end, ("Broken PBF data."));
+      uint8_t const byte = *m_pos++;
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return result;
+    }
+    CHECK(false, ("Broken PBF varint."));
+    return 0;
+  }
+
+  int64_t ReadSVarint()
+  {
+    auto const value = ReadVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  uint64_t GetVarint()
+  {
+    CHECK_EQUAL(m_wireType, kVarint, ());
+    return ReadVarint();
+  }
+
+  int64_t GetSVarint()
+  {
+    CHECK_EQUAL(m_wireType, kVarint, ());
+    return ReadSVarint();
+  }
+
+  // Returns a reader of a nested message or of a packed repeated field.
+  ProtoReader GetMessage()
+  {
+    CHECK_EQUAL(m_wireType, kLengthDelimited, ());
+    auto const size = ReadVarint();
+    CHECK_LESS_OR_EQUAL(size, static_cast<uint64_t>(m_end - m_pos), ("Broken PBF data."));
+    ProtoReader reader(m_pos, static_cast<size_t>(size));
+    m_pos += size;
+    return reader;
+  }
+
+  pair<uint8_t const *, size_t> GetBytes()
+  {
+    auto const reader = GetMessage();
+    return {reader.m_pos, static_cast<size_t>(reader.m_end - reader.m_pos)};
+  }
+
+  string GetString()
+  {
+    auto const bytes = GetBytes();
+    return string(reinterpret_cast<char const *>(bytes.first), bytes.second);
+  }
+
+  void Skip()
+  {
+    switch (m_wireType)
+    {
+    case kVarint: ReadVarint(); break;
+    case kFixed64: SkipBytes(8); break;
+    case kLengthDelimited: GetMessage(); break;
+    case kFixed32: SkipBytes(4); break;
+    default: CHECK(false, ("Unsupported PBF wire type:", m_wireType));
+    }
+  }
+
+private:
+  void SkipBytes(size_t size)
+  {
+    CHECK_LESS_OR_EQUAL(size, static_cast<size_t>(m_end - m_pos), ("Broken PBF data."));
+    m_pos += size;
+  }
+
+  uint8_t const * m_pos = nullptr;
+  uint8_t const * m_end = nullptr;
+  uint32_t m_field = 0;
+  uint32_t m_wireType = 0;
+};
+
+// Info of elements (field 4 of Node, Way, Relation and field 5 of DenseNodes) is not used.
+struct PrimitiveBlock
+{
+  vector<string> m_strings;
+  vector<ProtoReader> m_groups;
+  int64_t m_granularity = 100;
+  int64_t m_latOffset = 0;
+  int64_t m_lonOffset = 0;
+
+  string const & GetString(uint64_t index) const
+  {
+    CHECK_LESS(index, m_strings.size(), ("Broken PBF string table."));
+    return m_strings[index];
+  }
+
+  double GetLat(int64_t lat) const
+  {
+    return kCoordinatesUnit * static_cast<double>(m_latOffset + m_granularity * lat);
+  }
+
+  double GetLon(int64_t lon) const
+  {
+    return kCoordinatesUnit * static_cast<double>(m_lonOffset + m_granularity * lon);
+  }
+};
+
+void AddTags(PrimitiveBlock const & block, ProtoReader keys, ProtoReader values,
+             OsmElement & element)
+{
+  while (!keys.Empty())
+  {
+    CHECK(!values.Empty(), ("Different count of keys and values."));
+    element.AddTag(block.GetString(keys.ReadVarint()), block.GetString(values.ReadVarint()));
+  }
+}
+
+void DecodeNode(PrimitiveBlock const & block, ProtoReader node, vector<OsmElement> & elements)
+{
+  elements.emplace_back();
+  auto & element = elements.back();
+  element.type = OsmElement::EntityType::Node;
+
+  ProtoReader keys, values;
+  while (node.Next())
+  {
+    switch (node.GetField())
+    {
+    case 1: element.id = static_cast<uint64_t>(node.GetSVarint()); break;
+    case 2: keys = node.GetMessage(); break;
+    case 3: values = node.GetMessage(); break;
+    case 8: element.lat = block.GetLat(node.GetSVarint()); break;
+    case 9: element.lon = block.GetLon(node.GetSVarint()); break;
+    default: node.Skip();
+    }
+  }
+  AddTags(block, keys, values, element);
+}
+
+// Ids, coordinates and tags of dense nodes are stored in parallel arrays, ids and
+// coordinates are delta coded.
+void DecodeDenseNodes(PrimitiveBlock const & block, ProtoReader dense,
+                      vector<OsmElement> & elements)
+{
+  ProtoReader ids, lats, lons, keysValues;
+  while (dense.Next())
+  {
+    switch (dense.GetField())
+    {
+    case 1: ids = dense.GetMessage(); break;
+    case 8: lats = dense.GetMessage(); break;
+    case 9: lons = dense.GetMessage(); break;
+    case 10: keysValues = dense.GetMessage(); break;
+    default: dense.Skip();
+    }
+  }
+
+  int64_t id = 0, lat = 0, lon = 0;
+  while (!ids.Empty())
+  {
+    CHECK(!lats.Empty() && !lons.Empty(), ("Broken PBF dense nodes."));
+    id += ids.ReadSVarint();
+    lat += lats.ReadSVarint();
+    lon += lons.ReadSVarint();
+
+    elements.emplace_back();
+    auto & element = elements.back();
+    element.type = OsmElement::EntityType::Node;
+    element.id = static_cast<uint64_t>(id);
+    element.lat = block.GetLat(lat);
+    element.lon = block.GetLon(lon);
+
+    // Tags of a node are ended by 0, the array is empty if there are no tags in the block.
+    while (!keysValues.Empty())
+    {
+      auto const key = keysValues.ReadVarint();
+      if (key == 0)
+        break;
+      element.AddTag(block.GetString(key), block.GetString(keysValues.ReadVarint()));
+    }
+  }
+}
+
+void DecodeWay(PrimitiveBlock const & block, ProtoReader way, vector<OsmElement> & elements)
+{
+  elements.emplace_back();
+  auto & element = elements.back();
+  element.type = OsmElement::EntityType::Way;
+
+  ProtoReader keys, values, refs;
+  while (way.Next())
+  {
+    switch (way.GetField())
+    {
+    case 1: element.id = way.GetVarint(); break;
+    case 2: keys = way.GetMessage(); break;
+    case 3: values = way.GetMessage(); break;
+    case 8: refs = way.GetMessage(); break;
+    default: way.Skip();
+    }
+  }
+
+  int64_t ref = 0;
+  while (!refs.Empty())
+  {
+    ref += refs.ReadSVarint();
+    element.AddNd(static_cast<uint64_t>(ref));
+  }
+  AddTags(block, keys, values, element);
+}
+
+OsmElement::EntityType GetMemberType(uint64_t type)
+{
+  switch (type)
+  {
+  case 0: return OsmElement::EntityType::Node;
+  case 1: return OsmElement::EntityType::Way;
+  case 2: return OsmElement::EntityType::Relation;
+  default: return OsmElement::EntityType::Unknown;
+  }
+}
+
+void DecodeRelation(PrimitiveBlock const & block, ProtoReader relation,
+                    vector<OsmElement> & elements)
+{
+  elements.emplace_back();
+  auto & element = elements.back();
+  element.type = OsmElement::EntityType::Relation;
+
+  ProtoReader keys, values, roles, memberIds, types;
+  while (relation.Next())
+  {
+    switch (relation.GetField())
+    {
+    case 1: element.id = relation.GetVarint(); break;
+    case 2: keys = relation.GetMessage(); break;
+    case 3: values = relation.GetMessage(); break;
+    case 8: roles = relation.GetMessage(); break;
+    case 9: memberIds = relation.GetMessage(); break;
+    case 10: types = relation.GetMessage(); break;
+    default: relation.Skip();
+    }
+  }
+
+  int64_t memberId = 0;
+  while (!memberIds.Empty())
+  {
+    CHECK(!roles.Empty() && !types.Empty(), ("Broken PBF relation."));
+    memberId += memberIds.ReadSVarint();
+    auto const & role = block.GetString(roles.ReadVarint());
+    element.AddMember(static_cast<uint64_t>(memberId), GetMemberType(types.ReadVarint()), role);
+  }
+  AddTags(block, keys, values, element);
+}
+
+vector<uint8_t> Decompress(vector<uint8_t> const & blob)
+{
+  ProtoReader reader(blob.data(), blob.size());
+  vector<uint8_t> data;
+  uint64_t rawSize = 0;
+  pair<uint8_t const *, size_t> zlibData(nullptr, 0);
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1:
+    {
+      auto const raw = reader.GetBytes();
+      data.assign(raw.first, raw.first + raw.second);
+      return data;
+    }
+    case 2: rawSize = reader.GetVarint(); break;
+    case 3: zlibData = reader.GetBytes(); break;
+    case 4:
+    case 5:
+    case 6:
+    case 7: CHECK(false, ("Only raw and zlib PBF blobs are supported."));
+    default: reader.Skip();
+    }
+  }
+
+  CHECK(zlibData.first != nullptr, ("Empty PBF blob."));
+  CHECK_LESS_OR_EQUAL(rawSize, kMaxBlobSize, ());
+  data.reserve(static_cast<size_t>(rawSize));
+  coding::ZLib::Inflate inflate(coding::ZLib::Inflate::Format::ZLib);
+  CHECK(inflate(zlibData.first, zlibData.second, back_inserter(data)), ("Broken PBF zlib data."));
+  CHECK_EQUAL(data.size(), rawSize, ("Broken PBF zlib data."));
+  return data;
+}
+
+void CheckHeader(vector<uint8_t> const & data)
+{
+  ProtoReader header(data.data(), data.size());
+  while (header.Next())
+  {
+    // Required features.
+    if (header.GetField() != 4)
+    {
+      header.Skip();
+      continue;
+    }
+
+    auto const feature = header.GetString();
+    CHECK(feature == "OsmSchema-V0.6" || feature == "DenseNodes",
+          ("Unsupported feature of PBF file:", feature));
+  }
+}
+
+vector<OsmElement> DecodeData(vector<uint8_t> const & blob)
+{
+  auto const data = Decompress(blob);
+
+  PrimitiveBlock block;
+  ProtoReader reader(data.data(), data.size());
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1:
+    {
+      auto strings = reader.GetMessage();
+      while (strings.Next())
+      {
+        if (strings.GetField() == 1)
+          block.m_strings.push_back(strings.GetString());
+        else
+          strings.Skip();
+      }
+      break;
+    }
+    case 2: block.m_groups.push_back(reader.GetMessage()); break;
+    case 17: block.m_granularity = static_cast<int64_t>(reader.GetVarint()); break;
+    case 19: block.m_latOffset = static_cast<int64_t>(reader.GetVarint()); break;
+    case 20: block.m_lonOffset = static_cast<int64_t>(reader.GetVarint()); break;
+    default: reader.Skip();
+    }
+  }
+
+  vector<OsmElement> elements;
+  for (auto group : block.m_groups)
+  {
+    while (group.Next())
+    {
+      switch (group.GetField())
+      {
+      case 1: DecodeNode(block, group.GetMessage(), elements); break;
+      case 2: DecodeDenseNodes(block, group.GetMessage(), elements); break;
+      case 3: DecodeWay(block, group.GetMessage(), elements); break;
+      case 4: DecodeRelation(block, group.GetMessage(), elements); break;
+      default: group.Skip();
+      }
+    }
+  }
+  return elements;
+}
+}  // namespace
+
+PbfSource::PbfSource(ReadFn const & reader, size_t threadsCount)
+  : m_reader(reader), m_threadsCount(threadsCount)
+{
+  CHECK_GREATER(m_threadsCount, 0, ());
+}
+
+void PbfSource::ForEachElement(ElementFn const & fn)
+{
+  auto const processElements = [&fn](vector<OsmElement> && elements)
+  {
+    for (auto & element : elements)
+      fn(element);
+  };
+
+  // The reader is ahead of the consumer by a limited count of blobs to limit memory usage.
+  size_t const maxPendingCount = 2 * m_threadsCount;
+  deque<future<vector<OsmElement>>> pending;
+
+  Blob blob;
+  while (ReadBlob(blob))
+  {
+    if (blob.m_type == "OSMHeader")
+    {
+      CheckHeader(Decompress(blob.m_data));
+      continue;
+    }
+
+    // Blobs of unknown types must be skipped.
+    if (blob.m_type != "OSMData")
+      continue;
+
+    if (m_threadsCount == 1)
+    {
+      processElements(DecodeData(blob.m_data));
+      continue;
+    }
+
+    if (pending.size() == maxPendingCount)
+    {
+      processElements(pending.front().get());
+      pending.pop_front();
+    }
+    pending.push_back(async(launch::async, [](vector<uint8_t> data) { return DecodeData(data); },
+                            move(blob.m_data)));
+  }
+
+  for (; !pending.empty(); pending.pop_front())
+    processElements(pending.front().get());
+}
+
+bool PbfSource::ReadBlob(Blob & blob)
+{
+  uint8_t sizeBuffer[4];
+  auto const readBytes = m_reader(sizeBuffer, sizeof(sizeBuffer));
+  if (readBytes == 0)
+    return false;
+  CHECK_EQUAL(readBytes, sizeof(sizeBuffer), ("Unexpected end of PBF file."));
+
+  // The size of the header is in network byte order.
+  uint32_t const headerSize = (static_cast<uint32_t>(sizeBuffer[0]) << 24) |
+                              (static_cast<uint32_t>(sizeBuffer[1]) << 16) |
+                              (static_cast<uint32_t>(sizeBuffer[2]) << 8) |
+                              static_cast<uint32_t>(sizeBuffer[3]);
+  CHECK_LESS_OR_EQUAL(headerSize, kMaxBlobHeaderSize, ("Broken PBF blob header."));
+
+  vector<uint8_t> header(headerSize);
+  ReadExactly(header.data(), header.size());
+
+  blob.m_type.clear();
+  uint64_t dataSize = 0;
+  ProtoReader reader(header.data(), header.size());
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1: blob.m_type = reader.GetString(); break;
+    case 3: dataSize = reader.GetVarint(); break;
+    default: reader.Skip();
+    }
+  }
+  CHECK_LESS_OR_EQUAL(dataSize, kMaxBlobSize, ("Broken PBF blob header."));
+
+  blob.m_data.resize(static_cast<size_t>(dataSize));
+  ReadExactly(blob.m_data.data(), blob.m_data.size());
+  return true;
+}
+
+void PbfSource::ReadExactly(uint8_t * buffer, size_t size)
+{
+  while (size != 0)
+  {
+    auto const readBytes = m_reader(buffer, size);
+    CHECK_NOT_EQUAL(readBytes, 0, ("Unexpected end of PBF file."));
+    buffer += readBytes;
+    size -= readBytes;
+  }
+}
+}  // namespace osm
@@ -0,0 +1,43 @@
+// See PBF Format definition at https://wiki.openstreetmap.org/wiki/PBF_Format
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace osm
+{
+// Unlike o5m, PBF file consists of blobs of up to 8000 elements which are compressed and
+// coded independently. So blobs are decompressed and decoded by a pool of threads, and
+// the elements are passed to the consumer in the order of the file.
+class PbfSource
+{
+public:
+  using ReadFn = std::function<size_t(uint8_t *, size_t)>;
+  using ElementFn = std::function<void(OsmElement &)>;
+
+  // Blobs are decoded on the calling thread if |threadsCount| is 1.
+  PbfSource(ReadFn const & reader, size_t threadsCount);
+
+  // Calls |fn| for all the elements of the file in their order.
+  void ForEachElement(ElementFn const & fn);
+
+private:
+  struct Blob
+  {
+    std::string m_type;
+    std::vector<uint8_t> m_data;
+  };
+
+  // Returns false at the end of the file.
+  bool ReadBlob(Blob & blob);
+  void ReadExactly(uint8_t * buffer, size_t size);
+
+  ReadFn m_reader;
+  size_t const m_threadsCount;
+};
+}  // namespace osm
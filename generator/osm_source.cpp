@@ -11,6 +11,7 @@
 #include "generator/node_mixer.hpp"
 #include "generator/osm_element.hpp"
 #include "generator/osm_o5m_source.hpp"
+#include "generator/osm_pbf_source.hpp"
 #include "generator/osm_xml_source.hpp"
 #include "generator/polygonizer.hpp"
 #include "generator/regions/collector_region_info.hpp"
@@ -36,8 +37,15 @@
 #include "coding/file_name_utils.hpp"
 #include "coding/parse_xml.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <vector>
 
 #include "defines.hpp"
 
@@ -71,36 +79,47 @@ uint64_t SourceReader::Read(char * buffer, uint64_t bufferSize)
 }
 
 // Functions ---------------------------------------------------------------------------------------
-void AddElementToCache(cache::IntermediateDataWriter & cache,
-                       CameraNodeIntermediateDataProcessor & cameras, OsmElement & em)
+namespace
+{
+// Records of the intermediate data which are computed from an element alone, so elements are
+// prepared in parallel and only adding of the records to the intermediate data is sequential.
+struct ElementRecords
+{
+  m2::PointD m_point;
+  WayElement m_way = WayElement(0);
+  RelationElement m_relation;
+};
+
+struct PreparedElement
+{
+  OsmElement m_element;
+  ElementRecords m_records;
+};
+
+using PreparedBatch = vector<PreparedElement>;
+
+void PrepareRecords(OsmElement const & em, ElementRecords & records)
 {
   switch (em.type)
   {
   case OsmElement::EntityType::Node:
   {
-    auto const pt = MercatorBounds::FromLatLon(em.lat, em.lon);
-    cache.AddNode(em.id, pt.y, pt.x);
-    cameras.ProcessNode(em);
+    records.m_point = MercatorBounds::FromLatLon(em.lat, em.lon);
     break;
   }
   case OsmElement::EntityType::Way:
   {
     // Store way.
-    WayElement way(em.id);
+    WayElement & way = records.m_way;
+    way = WayElement(em.id);
     for (uint64_t nd : em.Nodes())
       way.nodes.push_back(nd);
-
-    if (way.IsValid())
-    {
-      cache.AddWay(em.id, way);
-      cameras.ProcessWay(em.id, way);
-    }
     break;
   }
   case OsmElement::EntityType::Relation:
   {
     // store relation
-    RelationElement relation;
+    RelationElement & relation = records.m_relation;
     for (auto const & member : em.Members())
     {
       switch (member.type) {
@@ -120,10 +139,6 @@ void AddElementToCache(cache::IntermediateDataWriter & cache,
 
     for (auto const & tag : em.Tags())
       relation.tags.emplace(tag.key, tag.value);
-
-    if (relation.IsValid())
-      cache.AddRelation(em.id, relation);
-
     break;
   }
   default:
@@ -131,6 +146,176 @@ void AddElementToCache(cache::IntermediateDataWriter & cache,
   }
 }
 
+void AddRecordsToCache(cache::IntermediateDataWriter & cache,
+                       CameraNodeIntermediateDataProcessor & cameras, OsmElement & em,
+                       ElementRecords const & records)
+{
+  switch (em.type)
+  {
+  case OsmElement::EntityType::Node:
+    cache.AddNode(em.id, records.m_point.y, records.m_point.x);
+    cameras.ProcessNode(em);
+    break;
+  case OsmElement::EntityType::Way:
+    if (records.m_way.IsValid())
+    {
+      cache.AddWay(em.id, records.m_way);
+      cameras.ProcessWay(em.id, records.m_way);
+    }
+    break;
+  case OsmElement::EntityType::Relation:
+    if (records.m_relation.IsValid())
+      cache.AddRelation(em.id, records.m_relation);
+    break;
+  default:
+    break;
+  }
+}
+
+// Pipeline of the preprocessing stage. The calling thread parses OSM data into batches of
+// elements, batches are prepared by a pool of threads, and a single writer thread adds them
+// to the intermediate data in the order of the source. So the intermediate data are the same
+// as the ones written by one thread, whichever node storage is used.
+//
+// o5m data are parsed by one thread because o5m is delta coded: an element depends on all
+// the elements after the last reset of the stream. PBF blobs are decoded in parallel by
+// the source itself.
+class IntermediateDataPipeline
+{
+public:
+  IntermediateDataPipeline(cache::IntermediateDataWriter & cache, TownsDumper & towns,
+                           CameraNodeIntermediateDataProcessor & cameras, size_t threadsCount)
+    : m_cache(cache)
+    , m_towns(towns)
+    , m_cameras(cameras)
+    , m_maxPendingCount(2 * threadsCount)
+    , m_writer(&IntermediateDataPipeline::WriteBatches, this)
+  {
+    CHECK_GREATER(threadsCount, 0, ());
+    m_batch.reserve(kBatchSize);
+  }
+
+  ~IntermediateDataPipeline()
+  {
+    if (m_writer.joinable())
+      Stop();
+  }
+
+  void operator()(OsmElement * em)
+  {
+    m_batch.emplace_back();
+    m_batch.back().m_element = move(*em);
+    if (m_batch.size() == kBatchSize)
+      PushBatch();
+  }
+
+  // Waits until all the elements are added to the intermediate data. Rethrows an exception
+  // thrown by the writer thread.
+  void Finish()
+  {
+    if (!m_batch.empty())
+      PushBatch();
+    Stop();
+
+    if (m_exception)
+      rethrow_exception(m_exception);
+  }
+
+private:
+  static size_t constexpr kBatchSize = 10000;
+
+  void Stop()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_done = true;
+    }
+    m_cv.notify_all();
+    m_writer.join();
+  }
+
+  void PushBatch()
+  {
+    auto prepared = async(launch::async, [](PreparedBatch batch)
+    {
+      for (auto & prepared : batch)
+        PrepareRecords(prepared.m_element, prepared.m_records);
+      return batch;
+    }, move(m_batch));
+
+    m_batch.clear();
+    m_batch.reserve(kBatchSize);
+
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_pending.size() < m_maxPendingCount || m_exception; });
+    m_pending.push_back(move(prepared));
+    m_cv.notify_all();
+  }
+
+  void WriteBatches()
+  {
+    while (true)
+    {
+      future<PreparedBatch> prepared;
+      {
+        unique_lock<mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return !m_pending.empty() || m_done; });
+        if (m_pending.empty())
+          return;
+        prepared = move(m_pending.front());
+        m_pending.pop_front();
+      }
+      m_cv.notify_all();
+
+      try
+      {
+        auto batch = prepared.get();
+        for (auto & element : batch)
+        {
+          m_towns.CheckElement(element.m_element);
+          AddRecordsToCache(m_cache, m_cameras, element.m_element, element.m_records);
+        }
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lock(m_mutex);
+        m_exception = current_exception();
+        // Pending batches are dropped, the reader is not blocked anymore.
+        m_pending.clear();
+        m_done = true;
+        m_cv.notify_all();
+        return;
+      }
+    }
+  }
+
+  cache::IntermediateDataWriter & m_cache;
+  TownsDumper & m_towns;
+  CameraNodeIntermediateDataProcessor & m_cameras;
+  size_t const m_maxPendingCount;
+
+  PreparedBatch m_batch;
+
+  mutex m_mutex;
+  condition_variable m_cv;
+  deque<future<PreparedBatch>> m_pending;
+  bool m_done = false;
+  exception_ptr m_exception;
+
+  thread m_writer;
+};
+
+size_t constexpr IntermediateDataPipeline::kBatchSize;
+}  // namespace
+
+void AddElementToCache(cache::IntermediateDataWriter & cache,
+                       CameraNodeIntermediateDataProcessor & cameras, OsmElement & em)
+{
+  ElementRecords records;
+  PrepareRecords(em, records);
+  AddRecordsToCache(cache, cameras, em, records);
+}
+
 void BuildIntermediateDataFromXML(SourceReader & stream, cache::IntermediateDataWriter & cache,
                                   TownsDumper & towns, CameraNodeIntermediateDataProcessor & cameras)
 {
@@ -161,6 +346,25 @@ void BuildIntermediateDataFromO5M(SourceReader & stream, cache::IntermediateData
   ProcessOsmElementsFromO5M(stream, processor);
 }
 
+void BuildIntermediateDataFromPbf(SourceReader & stream, cache::IntermediateDataWriter & cache,
+                                  TownsDumper & towns, CameraNodeIntermediateDataProcessor & cameras)
+{
+  ProcessOsmElementsFromPbf(stream, [&cache, &cameras, &towns](OsmElement * em) {
+    towns.CheckElement(*em);
+    AddElementToCache(cache, cameras, *em);
+  }, 1 /* threadsCount */);
+}
+
+void ProcessOsmElementsFromPbf(SourceReader & stream, function<void(OsmElement *)> processor,
+                               size_t threadsCount)
+{
+  osm::PbfSource source([&stream](uint8_t * buffer, size_t size)
+  {
+    return stream.Read(reinterpret_cast<char *>(buffer), size);
+  }, threadsCount);
+  source.ForEachElement([&processor](OsmElement & em) { processor(&em); });
+}
+
 void ProcessOsmElementsFromO5M(SourceReader & stream, function<void(OsmElement *)> processor)
 {
   using Type = osm::O5MSource::EntityType;
@@ -256,6 +460,9 @@ static bool GenerateRaw(feature::GenerateInfo & info, PreEmit const & preEmit,
     case feature::GenerateInfo::OsmSourceType::O5M:
       ProcessOsmElementsFromO5M(reader, fn);
       break;
+    case feature::GenerateInfo::OsmSourceType::PBF:
+      ProcessOsmElementsFromPbf(reader, fn, info.m_threadsCount);
+      break;
     }
 
     LOG(LINFO, ("Processing", info.m_osmFileName, "done."));
@@ -360,14 +567,39 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
 
     LOG(LINFO, ("Data source:", info.m_osmFileName));
 
-    switch (info.m_osmFileType)
+    if (info.m_threadsCount > 1)
     {
-    case feature::GenerateInfo::OsmSourceType::XML:
-      BuildIntermediateDataFromXML(reader, cache, towns, cameras);
-      break;
-    case feature::GenerateInfo::OsmSourceType::O5M:
-      BuildIntermediateDataFromO5M(reader, cache, towns, cameras);
-      break;
+      LOG(LINFO, ("Preprocessing by", info.m_threadsCount, "threads"));
+      IntermediateDataPipeline pipeline(cache, towns, cameras, info.m_threadsCount);
+      auto const processor = [&pipeline](OsmElement * em) { pipeline(em); };
+      switch (info.m_osmFileType)
+      {
+      case feature::GenerateInfo::OsmSourceType::XML:
+        ProcessOsmElementsFromXML(reader, processor);
+        break;
+      case feature::GenerateInfo::OsmSourceType::O5M:
+        ProcessOsmElementsFromO5M(reader, processor);
+        break;
+      case feature::GenerateInfo::OsmSourceType::PBF:
+        ProcessOsmElementsFromPbf(reader, processor, info.m_threadsCount);
+        break;
+      }
+      pipeline.Finish();
+    }
+    else
+    {
+      switch (info.m_osmFileType)
+      {
+      case feature::GenerateInfo::OsmSourceType::XML:
+        BuildIntermediateDataFromXML(reader, cache, towns, cameras);
+        break;
+      case feature::GenerateInfo::OsmSourceType::O5M:
+        BuildIntermediateDataFromO5M(reader, cache, towns, cameras);
+        break;
+      case feature::GenerateInfo::OsmSourceType::PBF:
+        BuildIntermediateDataFromPbf(reader, cache, towns, cameras);
+        break;
+      }
     }
 
     cache.SaveIndex();
@@ -47,4 +47,8 @@ bool GenerateIntermediateData(feature::GenerateInfo & info);
 
 void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElement *)> processor);
 void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void(OsmElement *)> processor);
+// Blobs of the file are decoded by |threadsCount| threads, elements are processed in the order
+// of the file on the calling thread.
+void ProcessOsmElementsFromPbf(SourceReader & stream, std::function<void(OsmElement *)> processor,
+                               size_t threadsCount);
 }  // namespace generator
@@ -51,6 +51,8 @@ struct RegionsFixer
   RegionsBuilder::Regions & FixRegions()
   {
     SortRegionsByArea();
+    auto const index = RegionsBuilder::MakeRegionsIndex(m_regionsWithAdminCenter);
+    std::vector<RegionsBuilder::RegionsIndex::value_type> containing;
     std::vector<bool> unsuitable;
     unsuitable.resize(m_regionsWithAdminCenter.size());
     for (size_t i = 0; i < m_regionsWithAdminCenter.size(); ++i)
@@ -70,9 +72,13 @@ struct RegionsFixer
       auto const placeType = adminCenter.GetPlaceType();
       if (placeType == PlaceType::Town || placeType == PlaceType::City)
       {
-        for (size_t j = i + 1; j + 1 < m_regionsWithAdminCenter.size(); ++j)
+        containing.clear();
+        index.query(boost::geometry::index::covers(regionWithAdminCenter.GetRect()),
+                    std::back_inserter(containing));
+        for (auto const & value : containing)
         {
-          if (m_regionsWithAdminCenter[j].ContainsRect(regionWithAdminCenter))
+          auto const j = value.second;
+          if (j > i && j + 1 < m_regionsWithAdminCenter.size())
             unsuitable[j] = true;
         }
       }
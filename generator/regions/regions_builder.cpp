@@ -90,13 +90,34 @@ RegionsBuilder::IdStringList RegionsBuilder::ToIdStringList(Node::Ptr tree) cons
   return result;
 }
 
+RegionsBuilder::RegionsIndex RegionsBuilder::MakeRegionsIndex(Regions const & regions)
+{
+  std::vector<RegionsIndex::value_type> values;
+  values.reserve(regions.size());
+  for (size_t i = 0; i < regions.size(); ++i)
+    values.emplace_back(regions[i].GetRect(), i);
+
+  // The packing constructor builds a better tree than insertions one by one.
+  return RegionsIndex(values);
+}
+
 Node::PtrList RegionsBuilder::MakeSelectedRegionsByCountry(Region const & country,
-                                                           Regions const & allRegions)
+                                                           Regions const & allRegions,
+                                                           RegionsIndex const & index)
 {
+  // Regions whose rects are covered by the country rect, in the order of |allRegions|.
+  std::vector<RegionsIndex::value_type> values;
+  index.query(boost::geometry::index::covered_by(country.GetRect()), std::back_inserter(values));
+  std::vector<size_t> selected;
+  selected.reserve(values.size());
+  for (auto const & value : values)
+    selected.push_back(value.second);
+  std::sort(std::begin(selected), std::end(selected));
+
   Regions regionsInCountry;
-  auto filterCopy = [&country] (const Region & r) { return country.ContainsRect(r); };
-  std::copy_if(std::begin(allRegions), std::end(allRegions),
-               std::back_inserter(regionsInCountry), filterCopy);
+  regionsInCountry.reserve(selected.size() + 1);
+  for (auto const i : selected)
+    regionsInCountry.push_back(allRegions[i]);
 
   regionsInCountry.emplace_back(country);
   auto const comp = [](const Region & l, const Region & r)
@@ -116,9 +137,10 @@ Node::PtrList RegionsBuilder::MakeSelectedRegionsByCountry(Region const & countr
 }
 
 Node::Ptr RegionsBuilder::BuildCountryRegionTree(Region const & country,
-                                                 Regions const & allRegions)
+                                                 Regions const & allRegions,
+                                                 RegionsIndex const & index)
 {
-  auto nodes = MakeSelectedRegionsByCountry(country, allRegions);
+  auto nodes = MakeSelectedRegionsByCountry(country, allRegions, index);
   while (nodes.size() > 1)
   {
     auto itFirstNode = std::rbegin(nodes);
@@ -163,14 +185,17 @@ Node::Ptr RegionsBuilder::BuildCountryRegionTree(Region const & country,
 
 void RegionsBuilder::MakeCountryTrees(Regions const & regions)
 {
+  auto const index = MakeRegionsIndex(regions);
   std::vector<std::future<Node::Ptr>> results;
   {
     int const cpuCount = m_cpuCount > 0 ? m_cpuCount : std::thread::hardware_concurrency();
     ASSERT_GREATER(cpuCount, 0, ());
     ThreadPool threadPool(cpuCount);
+    // All the tasks share |regions|, a task copies only the regions of its country.
     for (auto const & country : GetCountries())
     {
-      auto result = threadPool.enqueue(&RegionsBuilder::BuildCountryRegionTree, country, regions);
+      auto result = threadPool.enqueue(&RegionsBuilder::BuildCountryRegionTree, std::cref(country),
+                                       std::cref(regions), std::cref(index));
       results.emplace_back(std::move(result));
     }
   }
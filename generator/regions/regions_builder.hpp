@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/geometry/index/rtree.hpp>
+
 namespace generator
 {
 namespace regions
@@ -22,6 +24,9 @@ public:
   using StringsList = std::vector<std::string>;
   using IdStringList = std::vector<std::pair<base::GeoObjectId, std::string>>;
   using CountryTrees = std::multimap<std::string, Node::Ptr>;
+  // Rects of regions with their indices in Regions.
+  using RegionsIndex = boost::geometry::index::rtree<std::pair<BoostRect, size_t>,
+                                                     boost::geometry::index::quadratic<16>>;
 
   explicit RegionsBuilder(Regions && regions,
                           std::unique_ptr<ToStringPolicyInterface> toStringPolicy,
@@ -34,10 +39,14 @@ public:
   IdStringList ToIdStringList(Node::Ptr tree) const;
   Node::Ptr GetNormalizedCountryTree(std::string const & name);
 
+  static RegionsIndex MakeRegionsIndex(Regions const & regions);
+
 private:
   static Node::PtrList MakeSelectedRegionsByCountry(Region const & country,
-                                                    Regions const & allRegions);
-  static Node::Ptr BuildCountryRegionTree(Region const & country, Regions const & allRegions);
+                                                    Regions const & allRegions,
+                                                    RegionsIndex const & index);
+  static Node::Ptr BuildCountryRegionTree(Region const & country, Regions const & allRegions,
+                                          RegionsIndex const & index);
   void MakeCountryTrees(Regions const & regions);
 
   std::unique_ptr<ToStringPolicyInterface> m_toStringPolicy;
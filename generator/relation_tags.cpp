@@ -4,8 +4,8 @@
 
 namespace generator
 {
-RelationTagsBase::RelationTagsBase(routing::TagsProcessor & tagsProcessor) :
-  m_routingTagsProcessor(tagsProcessor),
+RelationTagsBase::RelationTagsBase(RestrictionFn const & restrictionFn) :
+  m_restrictionFn(restrictionFn),
   m_cache(14 /* logCacheSize */)
 {
 }
@@ -35,8 +35,8 @@ void RelationTagsBase::AddCustomTag(std::pair<std::string, std::string> const &
   m_current->AddTag(p.first, p.second);
 }
 
-RelationTagsNode::RelationTagsNode(routing::TagsProcessor & tagsProcessor) :
-  RelationTagsBase(tagsProcessor)
+RelationTagsNode::RelationTagsNode(RestrictionFn const & restrictionFn) :
+  RelationTagsBase(restrictionFn)
 {
 }
 
@@ -48,7 +48,7 @@ void RelationTagsNode::Process(RelationElement const & e)
 
   if (type == "restriction")
   {
-    m_routingTagsProcessor.m_restrictionWriter.Write(e);
+    m_restrictionFn(e);
     return;
   }
 
@@ -73,8 +73,8 @@ void RelationTagsNode::Process(RelationElement const & e)
   }
 }
 
-RelationTagsWay::RelationTagsWay(routing::TagsProcessor & routingTagsProcessor) :
-  RelationTagsBase(routingTagsProcessor)
+RelationTagsWay::RelationTagsWay(RestrictionFn const & restrictionFn) :
+  RelationTagsBase(restrictionFn)
 {
 }
 
@@ -119,7 +119,7 @@ void RelationTagsWay::Process(RelationElement const & e)
 
   if (type == "restriction")
   {
-    m_routingTagsProcessor.m_restrictionWriter.Write(e);
+    m_restrictionFn(e);
     return;
   }
 
@@ -1,14 +1,15 @@
 #pragma once
 
 #include "generator/intermediate_elements.hpp"
-#include "generator/routing_helpers.hpp"
 
 #include "base/assert.hpp"
 #include "base/cache.hpp"
 #include "base/control_flow.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 struct OsmElement;
@@ -20,7 +21,10 @@ namespace generator
 class RelationTagsBase
 {
 public:
-  explicit RelationTagsBase(routing::TagsProcessor & tagsProcessor);
+  // Called for restriction relations of elements.
+  using RestrictionFn = std::function<void(RelationElement const &)>;
+
+  explicit RelationTagsBase(RestrictionFn const & restrictionFn);
 
   virtual ~RelationTagsBase() {}
 
@@ -46,7 +50,7 @@ protected:
 
   uint64_t m_featureID;
   OsmElement * m_current;
-  routing::TagsProcessor & m_routingTagsProcessor;
+  RestrictionFn m_restrictionFn;
 
 private:
   base::Cache<uint64_t, RelationElement> m_cache;
@@ -55,7 +59,7 @@ private:
 class RelationTagsNode : public RelationTagsBase
 {
 public:
-  explicit RelationTagsNode(routing::TagsProcessor & tagsProcessor);
+  explicit RelationTagsNode(RestrictionFn const & restrictionFn);
 
 protected:
   void Process(RelationElement const & e) override;
@@ -67,7 +71,7 @@ private:
 class RelationTagsWay : public RelationTagsBase
 {
 public:
-  explicit RelationTagsWay(routing::TagsProcessor & routingTagsProcessor);
+  explicit RelationTagsWay(RestrictionFn const & restrictionFn);
 
 private:
   using Base = RelationTagsBase;
@@ -11,6 +11,10 @@
 #include "routing/index_graph.hpp"
 #include "routing/index_graph_loader.hpp"
 #include "routing/index_graph_serialization.hpp"
+#include "routing/landmarks.hpp"
+#include "routing/landmarks_serialization.hpp"
+#include "routing/mapped_index_graph.hpp"
+#include "routing/road_snapping_index.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "routing_common/bicycle_model.hpp"
@@ -39,10 +43,12 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -54,6 +60,9 @@ using namespace std::placeholders;
 
 namespace
 {
+// Number of landmarks for the ALT heuristic. Every landmark takes 4 bytes per joint.
+size_t constexpr kLandmarksNumber = 8;
+
 class VehicleMaskBuilder final
 {
 public:
@@ -386,65 +395,92 @@ void CalcCrossMwmConnectors(
 template <typename CrossMwmId>
 void FillWeights(string const & path, string const & mwmFile, string const & country,
                  CountryParentNameGetterFn const & countryParentNameGetterFn,
-                 bool disableCrossMwmProgress, CrossMwmConnector<CrossMwmId> & connector)
+                 bool disableCrossMwmProgress, size_t threadsCount,
+                 CrossMwmConnector<CrossMwmId> & connector)
 {
+  CHECK_GREATER(threadsCount, 0, ());
   base::Timer timer;
 
   shared_ptr<VehicleModelInterface> vehicleModel =
       CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
-  IndexGraph graph(
-      make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel)),
-      EdgeEstimator::Create(VehicleType::Car, *vehicleModel, nullptr /* trafficStash */));
 
-  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
-  DeserializeIndexGraph(mwmValue, VehicleType::Car, graph);
+  auto const & enters = connector.GetEnters();
+  auto const & exits = connector.GetExits();
+  auto const numEnters = enters.size();
+  auto const numExits = exits.size();
 
-  map<Segment, map<Segment, RouteWeight>> weights;
-  auto const numEnters = connector.GetEnters().size();
-  size_t foundCount = 0;
-  size_t notFoundCount = 0;
-  for (size_t i = 0; i < numEnters; ++i)
-  {
-    if (!disableCrossMwmProgress && (i % 10 == 0) && (i != 0))
-      LOG(LINFO, ("Building leaps:", i, "/", numEnters, "waves passed"));
+  map<Segment, size_t> exitIndices;
+  for (size_t i = 0; i < numExits; ++i)
+    exitIndices.emplace(exits[i], i);
 
-    Segment const & enter = connector.GetEnter(i);
+  // Row i holds the weights from the enter i, every row is written by a single thread.
+  vector<double> weights(numEnters * numExits, connector::kNoRoute);
+  atomic<size_t> nextEnter(0);
+  atomic<size_t> foundCount(0);
+
+  // Geometry and index graph cache roads, so every thread has its own graph.
+  auto const propagateWaves = [&]() {
+    IndexGraph graph(
+        make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel)),
+        EdgeEstimator::Create(VehicleType::Car, *vehicleModel, nullptr /* trafficStash */));
+    MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+    DeserializeIndexGraph(mwmValue, VehicleType::Car, graph);
 
     AStarAlgorithm<DijkstraWrapper> astar;
     DijkstraWrapper wrapper(graph);
     AStarAlgorithm<DijkstraWrapper>::Context context;
-    astar.PropagateWave(wrapper, enter,
-                        [](Segment const & /* vertex */) { return true; } /* visitVertex */,
-                        context);
-
-    for (Segment const & exit : connector.GetExits())
+    for (size_t i = nextEnter++; i < numEnters; i = nextEnter++)
     {
-      if (context.HasDistance(exit))
+      if (!disableCrossMwmProgress && (i % 10 == 0) && (i != 0))
+        LOG(LINFO, ("Building leaps:", i, "/", numEnters, "waves passed"));
+
+      // Distances of settled vertices are final, so the wave is stopped when all the exits
+      // are settled.
+      size_t numSettledExits = 0;
+      astar.PropagateWave(wrapper, enters[i],
+                          [&](Segment const & vertex) {
+                            if (exitIndices.count(vertex) != 0)
+                              ++numSettledExits;
+                            return numSettledExits < numExits;
+                          } /* visitVertex */,
+                          context);
+
+      double * row = weights.data() + i * numExits;
+      size_t found = 0;
+      for (size_t j = 0; j < numExits; ++j)
       {
-        weights[enter][exit] = context.GetDistance(exit);
-        ++foundCount;
-      }
-      else
-      {
-        ++notFoundCount;
+        if (context.HasDistance(exits[j]))
+        {
+          row[j] = context.GetDistance(exits[j]).ToCrossMwmWeight();
+          ++found;
+        }
       }
+      foundCount += found;
     }
-  }
+  };
 
-  connector.FillWeights([&](Segment const & enter, Segment const & exit) {
-    auto it0 = weights.find(enter);
-    if (it0 == weights.end())
-      return connector::kNoRoute;
+  threadsCount = min(threadsCount, max(numEnters, size_t(1)));
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(propagateWaves);
+  propagateWaves();
+  for (auto & thread : threads)
+    thread.join();
 
-    auto it1 = it0->second.find(exit);
-    if (it1 == it0->second.end())
-      return connector::kNoRoute;
+  map<Segment, size_t> enterIndices;
+  for (size_t i = 0; i < numEnters; ++i)
+    enterIndices.emplace(enters[i], i);
 
-    return it1->second.ToCrossMwmWeight();
+  connector.FillWeights([&](Segment const & enter, Segment const & exit) {
+    auto const enterIt = enterIndices.find(enter);
+    auto const exitIt = exitIndices.find(exit);
+    CHECK(enterIt != enterIndices.cend() && exitIt != exitIndices.cend(), (enter, exit));
+    return weights[enterIt->second * numExits + exitIt->second];
   });
 
-  LOG(LINFO, ("Leaps finished, elapsed:", timer.ElapsedSeconds(), "seconds, routes found:",
-              foundCount, ", not found:", notFoundCount));
+  LOG(LINFO, ("Leaps finished, elapsed:", timer.ElapsedSeconds(), "seconds, threads:",
+              threadsCount, ", routes found:", foundCount.load(), ", not found:",
+              numEnters * numExits - foundCount.load()));
 }
 
 serial::GeometryCodingParams LoadGeometryCodingParams(string const & mwmFile)
@@ -508,7 +544,8 @@ void SerializeCrossMwm(string const & mwmFile, string const & sectionName,
 void BuildRoutingCrossMwmSection(string const & path, string const & mwmFile,
                                  string const & country,
                                  CountryParentNameGetterFn const & countryParentNameGetterFn,
-                                 string const & osmToFeatureFile, bool disableCrossMwmProgress)
+                                 string const & osmToFeatureFile, bool disableCrossMwmProgress,
+                                 size_t threadsCount)
 {
   LOG(LINFO, ("Building cross mwm section for", country));
   using CrossMwmId = base::GeoObjectId;
@@ -521,12 +558,123 @@ void BuildRoutingCrossMwmSection(string const & path, string const & mwmFile,
   // We use leaps for cars only. To use leaps for other vehicle types add weights generation
   // here and change WorldGraph mode selection rule in IndexRouter::CalculateSubroute.
   FillWeights(path, mwmFile, country, countryParentNameGetterFn, disableCrossMwmProgress,
-              connectors[static_cast<size_t>(VehicleType::Car)]);
+              threadsCount, connectors[static_cast<size_t>(VehicleType::Car)]);
 
   CHECK(connectors[static_cast<size_t>(VehicleType::Transit)].IsEmpty(), ());
   SerializeCrossMwm(mwmFile, CROSS_MWM_FILE_TAG, connectors, transitions);
 }
 
+void BuildLandmarksSection(string const & path, string const & mwmFile, string const & country,
+                           CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building landmarks section for", country));
+  base::Timer timer;
+
+  shared_ptr<VehicleModelInterface> vehicleModel =
+      CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+  IndexGraph graph(
+      make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel)),
+      EdgeEstimator::Create(VehicleType::Car, *vehicleModel, nullptr /* trafficStash */));
+
+  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+  DeserializeIndexGraph(mwmValue, VehicleType::Car, graph);
+
+  Landmarks const landmarks = BuildLandmarks(graph, kLandmarksNumber);
+  if (landmarks.IsEmpty())
+  {
+    LOG(LINFO, ("No landmarks for", country));
+    return;
+  }
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  FileWriter writer = cont.GetWriter(LANDMARKS_FILE_TAG);
+  auto const startPos = writer.Pos();
+  LandmarksSerializer::Serialize(writer, landmarks);
+  auto const sectionSize = writer.Pos() - startPos;
+
+  LOG(LINFO, ("Landmarks section generated in", timer.ElapsedSeconds(), "seconds, size:",
+              sectionSize, "bytes"));
+}
+
+bool BuildMappedRoutingIndexSection(string const & mwmFile)
+{
+  LOG(LINFO, ("Building", ROUTING_MAPPED_FILE_TAG, "section for", mwmFile));
+  base::Timer timer;
+
+  // Transit routing uses pedestrian index graph.
+  vector<VehicleType> const vehicleTypes = {VehicleType::Pedestrian, VehicleType::Bicycle,
+                                            VehicleType::Car};
+  vector<IndexGraph> graphs(vehicleTypes.size());
+  try
+  {
+    FilesContainerR cont(mwmFile);
+    if (!cont.IsExist(ROUTING_FILE_TAG))
+    {
+      LOG(LERROR, ("No", ROUTING_FILE_TAG, "section in", mwmFile));
+      return false;
+    }
+
+    for (size_t i = 0; i < vehicleTypes.size(); ++i)
+    {
+      FilesContainerR::TReader reader(cont.GetReader(ROUTING_FILE_TAG));
+      ReaderSource<FilesContainerR::TReader> src(reader);
+      IndexGraphSerializer::Deserialize(graphs[i], src, GetVehicleMask(vehicleTypes[i]));
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error while reading", ROUTING_FILE_TAG, "section of", mwmFile, ":", e.Msg()));
+    return false;
+  }
+
+  vector<pair<VehicleType, IndexGraph const *>> vehicleGraphs;
+  for (size_t i = 0; i < vehicleTypes.size(); ++i)
+    vehicleGraphs.emplace_back(vehicleTypes[i], &graphs[i]);
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  FileWriter writer = cont.GetWriter(ROUTING_MAPPED_FILE_TAG);
+  auto const startPos = writer.Pos();
+  MappedIndexGraphSerializer::Serialize(vehicleGraphs, writer);
+  auto const sectionSize = writer.Pos() - startPos;
+
+  LOG(LINFO, (ROUTING_MAPPED_FILE_TAG, "section generated in", timer.ElapsedSeconds(),
+              "seconds, size:", sectionSize, "bytes"));
+  return true;
+}
+
+void BuildRoadSnappingSection(string const & mwmFile, string const & country,
+                              CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building", ROAD_SNAPPING_FILE_TAG, "section for", country));
+  base::Timer timer;
+
+  VehicleMaskBuilder const maskBuilder(country, countryParentNameGetterFn);
+  vector<RoadSnappingIndex::Road> roads;
+  feature::ForEachFromDat(mwmFile, [&](FeatureType & f, uint32_t id) {
+    VehicleMask const mask = maskBuilder.CalcRoadMask(f);
+    if (mask == 0)
+      return;
+
+    RoadSnappingIndex::Road road;
+    road.m_featureId = id;
+    road.m_mask = mask;
+    f.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    road.m_points.reserve(f.GetPointsCount());
+    for (size_t i = 0; i < f.GetPointsCount(); ++i)
+      road.m_points.push_back(f.GetPoint(i));
+    roads.push_back(move(road));
+  });
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  FileWriter writer = cont.GetWriter(ROAD_SNAPPING_FILE_TAG);
+  auto const startPos = writer.Pos();
+  RoadSnappingIndex::Serialize(roads, writer);
+  auto const sectionSize = writer.Pos() - startPos;
+
+  LOG(LINFO, (ROAD_SNAPPING_FILE_TAG, "section generated in", timer.ElapsedSeconds(),
+              "seconds, roads:", roads.size(), "size:", sectionSize, "bytes"));
+}
+
 void BuildTransitCrossMwmSection(string const & path, string const & mwmFile,
                                  string const & country,
                                  CountryParentNameGetterFn const & countryParentNameGetterFn)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -15,11 +16,31 @@ bool BuildRoutingIndex(std::string const & filename, std::string const & country
 /// \note Before call of this method
 /// * all features and feature geometry should be generated
 /// * city_roads section should be generated
+/// \param threadsCount is the number of threads the weights of leaps are calculated on, every
+/// thread loads its own index graph.
 void BuildRoutingCrossMwmSection(std::string const & path, std::string const & mwmFile,
                                  std::string const & country,
                                  CountryParentNameGetterFn const & countryParentNameGetterFn,
                                  std::string const & osmToFeatureFile,
-                                 bool disableCrossMwmProgress);
+                                 bool disableCrossMwmProgress, size_t threadsCount);
+/// \brief Builds LANDMARKS_FILE_TAG section with distances from landmarks for the car ALT
+/// heuristic.
+/// \note Before call of this method routing and city_roads sections should be built.
+void BuildLandmarksSection(std::string const & path, std::string const & mwmFile,
+                           std::string const & country,
+                           CountryParentNameGetterFn const & countryParentNameGetterFn);
+
+/// \brief Builds ROUTING_MAPPED_FILE_TAG section with road and joint indices which are used
+/// directly in mapped memory instead of deserializing ROUTING_FILE_TAG section.
+/// \note Before call of this method routing section should be built.
+bool BuildMappedRoutingIndexSection(std::string const & mwmFile);
+
+/// \brief Builds ROAD_SNAPPING_FILE_TAG section with a grid of road features which is used to
+/// snap points to roads.
+/// \note Before call of this method all features and feature geometry should be generated.
+void BuildRoadSnappingSection(std::string const & mwmFile, std::string const & country,
+                              CountryParentNameGetterFn const & countryParentNameGetterFn);
+
 /// \brief Builds TRANSIT_CROSS_MWM_FILE_TAG section.
 /// \note Before a call of this method TRANSIT_FILE_TAG should be built.
 void BuildTransitCrossMwmSection(std::string const & path, std::string const & mwmFile,
@@ -1,6 +1,9 @@
 #include "search_index_builder.hpp"
 
 #include "search/common.hpp"
+#include "search/features_layer_matcher.hpp"
+#include "search/localities_index.hpp"
+#include "search/matched_streets_table.hpp"
 #include "search/mwm_context.hpp"
 #include "search/reverse_geocoder.hpp"
 #include "search/search_index_values.hpp"
@@ -16,6 +19,7 @@
 #include "indexer/feature_visibility.hpp"
 #include "indexer/features_vector.hpp"
 #include "indexer/ftypes_matcher.hpp"
+#include "indexer/packed_trie_builder.hpp"
 #include "indexer/search_delimiters.hpp"
 #include "indexer/search_string_utils.hpp"
 #include "indexer/trie_builder.hpp"
@@ -25,8 +29,13 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/file_sort.hpp"
+#include "coding/byte_stream.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/fixed_bits_ddvector.hpp"
 #include "coding/reader_writer_ops.hpp"
+#include "coding/varint.hpp"
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
@@ -37,9 +46,12 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <future>
 #include <map>
 #include <mutex>
+#include <queue>
 #include <unordered_map>
 #include <vector>
 #include <thread>
@@ -330,35 +342,294 @@ void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
       synonyms.get(), keyValuePairs, categoriesHolder, header.GetScaleRange(), valueBuilder));
 }
 
-bool GetStreetIndex(search::MwmContext & ctx, uint32_t featureID, string const & streetName,
-                    uint32_t & result)
+// Token pairs of the search index kept in memory by all threads of AddFeatureNameIndexPairs,
+// the rest are sorted and spilled to disk.
+size_t constexpr kMaxPairsInMemory = 1 << 22;
+// Features are handed out to threads of AddFeatureNameIndexPairs by chunks of this size.
+uint32_t constexpr kFeaturesChunkSize = 4096;
+
+// Sorted runs of <key, value> pairs in a temporary file. A pair is written as
+// [vu pair size][vu key size][vu key char] ... [vu key char][vu value feature id].
+class KeyValueRunsWriter
 {
-  size_t streetIndex = 0;
-  strings::UniString const street = search::GetStreetNameAsKey(streetName);
+public:
+  using Pair = pair<strings::UniString, FeatureIndexValue>;
 
-  bool const hasStreet = !street.empty();
-  if (hasStreet)
+  explicit KeyValueRunsWriter(string const & fileName) : m_writer(fileName) {}
+
+  string GetFileName() const { return m_writer.GetName(); }
+
+  // Sorts |pairs|, writes them as a new run and clears |pairs|.
+  void Flush(vector<Pair> & pairs)
+  {
+    if (pairs.empty())
+      return;
+
+    sort(pairs.begin(), pairs.end());
+
+    uint64_t const beg = m_writer.Pos();
+    vector<uint8_t> record;
+    vector<uint8_t> buffer;
+    for (auto const & kv : pairs)
+    {
+      record.clear();
+      PushBackByteSink<vector<uint8_t>> recordSink(record);
+      WriteVarUint(recordSink, static_cast<uint32_t>(kv.first.size()));
+      for (auto const c : kv.first)
+        WriteVarUint(recordSink, c);
+      WriteVarUint(recordSink, kv.second.m_featureId);
+
+      PushBackByteSink<vector<uint8_t>> sink(buffer);
+      WriteVarUint(sink, static_cast<uint32_t>(record.size()));
+      buffer.insert(buffer.end(), record.begin(), record.end());
+      if (buffer.size() >= kWriteChunkSize)
+      {
+        m_writer.Write(buffer.data(), buffer.size());
+        buffer.clear();
+      }
+    }
+    m_writer.Write(buffer.data(), buffer.size());
+    m_runs.emplace_back(beg, m_writer.Pos());
+    pairs.clear();
+  }
+
+  // Returns [begin, end) positions of runs in the file.
+  vector<pair<uint64_t, uint64_t>> const & GetRuns() const { return m_runs; }
+
+  void Finish() { m_writer.Flush(); }
+
+private:
+  static size_t constexpr kWriteChunkSize = 64 * 1024;
+
+  FileWriter m_writer;
+  vector<pair<uint64_t, uint64_t>> m_runs;
+};
+
+size_t constexpr KeyValueRunsWriter::kWriteChunkSize;
+
+// Reads pairs of a run [beg, end) written by KeyValueRunsWriter by chunks.
+class KeyValueRunReader
+{
+public:
+  using Pair = KeyValueRunsWriter::Pair;
+
+  KeyValueRunReader(FileReader const & reader, uint64_t beg, uint64_t end)
+    : m_reader(reader), m_pos(beg), m_end(end)
+  {
+  }
+
+  bool Next(Pair & kv)
+  {
+    Fill(kMaxSizeBytes);
+    if (m_bufferPos == m_buffer.size())
+      return false;
+
+    ArrayByteSource sizeSrc(&m_buffer[m_bufferPos]);
+    uint32_t const size = ReadVarUint<uint32_t>(sizeSrc);
+    m_bufferPos = static_cast<size_t>(sizeSrc.PtrUC() - m_buffer.data());
+    Fill(size);
+    CHECK_GREATER_OR_EQUAL(m_buffer.size() - m_bufferPos, size,
+                           ("Truncated run of", m_reader.GetName()));
+
+    ArrayByteSource src(&m_buffer[m_bufferPos]);
+    uint32_t const keySize = ReadVarUint<uint32_t>(src);
+    kv.first.resize(keySize);
+    for (auto & c : kv.first)
+      c = ReadVarUint<uint32_t>(src);
+    kv.second.m_featureId = ReadVarUint<uint64_t>(src);
+    m_bufferPos += size;
+    return true;
+  }
+
+private:
+  static size_t constexpr kReadChunkSize = 64 * 1024;
+  // Upper bound of the varint size of a pair.
+  static size_t constexpr kMaxSizeBytes = 5;
+
+  // Makes at least |bytes| bytes available in the buffer unless the run ends earlier.
+  void Fill(size_t bytes)
+  {
+    size_t const available = m_buffer.size() - m_bufferPos;
+    if (available >= bytes || m_pos == m_end)
+      return;
+
+    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_bufferPos);
+    m_bufferPos = 0;
+    size_t const count =
+        static_cast<size_t>(min<uint64_t>(max(bytes - available, kReadChunkSize), m_end - m_pos));
+    m_buffer.resize(available + count);
+    m_reader.Read(m_pos, m_buffer.data() + available, count);
+    m_pos += count;
+  }
+
+  FileReader const & m_reader;
+  uint64_t m_pos;
+  uint64_t const m_end;
+  vector<uint8_t> m_buffer;
+  size_t m_bufferPos = 0;
+};
+
+size_t constexpr KeyValueRunReader::kReadChunkSize;
+size_t constexpr KeyValueRunReader::kMaxSizeBytes;
+
+// Calls |toDo| for pairs of all |runs| in the sorted order by a k-way merge.
+template <typename ToDo>
+void MergeKeyValueRuns(vector<unique_ptr<KeyValueRunsWriter>> const & runs, ToDo && toDo)
+{
+  using Pair = KeyValueRunsWriter::Pair;
+  using Item = pair<Pair, size_t>;
+
+  vector<FileReader> files;
+  for (auto const & writer : runs)
+    files.emplace_back(writer->GetFileName());
+
+  vector<KeyValueRunReader> readers;
+  for (size_t i = 0; i < runs.size(); ++i)
+  {
+    for (auto const & run : runs[i]->GetRuns())
+      readers.emplace_back(files[i], run.first, run.second);
+  }
+
+  auto const greater = [](Item const & lhs, Item const & rhs) { return rhs.first < lhs.first; };
+  priority_queue<Item, vector<Item>, decltype(greater)> queue(greater);
+  auto const push = [&](size_t i) {
+    Item item;
+    item.second = i;
+    if (readers[i].Next(item.first))
+      queue.push(move(item));
+  };
+
+  for (size_t i = 0; i < readers.size(); ++i)
+    push(i);
+
+  while (!queue.empty())
+  {
+    toDo(queue.top().first);
+    size_t const i = queue.top().second;
+    queue.pop();
+    push(i);
+  }
+}
+
+// Collects token pairs of |container| by |threadsCount| threads. Pairs of every thread are
+// sorted and spilled to a temporary file by runs, which bounds memory used for the pairs.
+vector<unique_ptr<KeyValueRunsWriter>> AddFeatureNameIndexPairs(
+    FilesContainerR const & container, CategoriesHolder const & categoriesHolder,
+    uint32_t threadsCount)
+{
+  using Key = strings::UniString;
+  using Value = FeatureIndexValue;
+
+  FeaturesVectorTest features(container);
+  feature::DataHeader const & header = features.GetHeader();
+  auto const featuresCount =
+      base::checked_cast<uint32_t>(features.GetVector().GetNumFeatures());
+  size_t const maxPairsInRun = kMaxPairsInMemory / threadsCount;
+
+  unique_ptr<SynonymsHolder> synonyms;
+  if (header.GetType() == feature::DataHeader::world)
+    synonyms.reset(new SynonymsHolder(GetPlatform().WritablePathForFile(SYNONYMS_FILE)));
+
+  vector<unique_ptr<KeyValueRunsWriter>> runs;
+  for (uint32_t i = 0; i < threadsCount; ++i)
   {
+    runs.push_back(make_unique<KeyValueRunsWriter>(container.GetFileName() + "." +
+                                                   SEARCH_INDEX_FILE_TAG + ".runs" +
+                                                   strings::to_string(i) + EXTENSION_TMP));
+  }
+
+  atomic<uint32_t> nextChunk(0);
+  auto const collect = [&](uint32_t threadIdx) {
+    // FeaturesVector is not thread safe, every thread reads features through its own file.
+    FeaturesVectorTest threadFeatures(container.GetFileName());
+    ValueBuilder<Value> valueBuilder;
+    vector<pair<Key, Value>> pairs;
+    FeatureInserter<Key, Value> inserter(synonyms.get(), pairs, categoriesHolder,
+                                         header.GetScaleRange(), valueBuilder);
+
+    auto const & featuresVector = threadFeatures.GetVector();
+    vector<uint32_t> indices;
     FeatureType ft;
-    VERIFY(ctx.GetFeature(featureID, ft), ());
+    while (true)
+    {
+      uint32_t const beg = nextChunk.fetch_add(kFeaturesChunkSize);
+      if (beg >= featuresCount)
+        break;
+
+      uint32_t const end = beg + min(featuresCount - beg, kFeaturesChunkSize);
+      indices.clear();
+      for (uint32_t i = beg; i < end; ++i)
+        indices.push_back(i);
+
+      featuresVector.ForEachByIndices(indices, ft, [&](uint32_t index, FeatureType & f) {
+        // The same as FeaturesVector::ForEach does, the index is needed to load metadata.
+        f.SetID(FeatureID(MwmSet::MwmId(), index));
+        inserter(f, index);
+      });
+
+      if (pairs.size() >= maxPairsInRun)
+        runs[threadIdx]->Flush(pairs);
+    }
+    runs[threadIdx]->Flush(pairs);
+    runs[threadIdx]->Finish();
+  };
 
+  vector<future<void>> collected;
+  for (uint32_t i = 0; i < threadsCount; ++i)
+    collected.push_back(async(launch::async, collect, i));
+  for (auto & f : collected)
+    f.get();
+
+  return runs;
+}
+
+// Streets which are not computed for features that are neither houses nor have streets.
+uint32_t constexpr kUnknownMatchedStreet = search::MatchedStreetsTable::kNoStreet - 1;
+
+// Besides the index of the street of the feature, |matchedStreet| is set to the id of
+// the street search will match the feature with, see FeaturesLayerMatcher.
+bool GetStreetIndex(search::MwmContext & ctx, uint32_t featureID, string const & streetName,
+                    uint32_t & result, uint32_t & matchedStreet)
+{
+  strings::UniString const street = search::GetStreetNameAsKey(streetName);
+  bool const hasStreet = !street.empty();
+  matchedStreet = kUnknownMatchedStreet;
+
+  FeatureType ft;
+  VERIFY(ctx.GetFeature(featureID, ft), ());
+
+  if (hasStreet || !ft.GetHouseNumber().empty())
+  {
     using TStreet = search::ReverseGeocoder::Street;
     vector<TStreet> streets;
     search::ReverseGeocoder::GetNearbyStreets(ctx, feature::GetCenter(ft), streets);
 
-    streetIndex = search::ReverseGeocoder::GetMatchedStreetIndex(street, streets);
-    if (streetIndex < streets.size())
+    bool found = false;
+    if (hasStreet)
     {
-      result = base::checked_cast<uint32_t>(streetIndex);
-      return true;
+      size_t const streetIndex = search::ReverseGeocoder::GetMatchedStreetIndex(street, streets);
+      if (streetIndex < streets.size())
+      {
+        result = base::checked_cast<uint32_t>(streetIndex);
+        found = true;
+      }
     }
+
+    matchedStreet = search::FeaturesLayerMatcher::ChooseMatchingStreet(
+        streets, found ? &result : nullptr);
+    if (matchedStreet == search::FeaturesLayerMatcher::kInvalidId)
+      matchedStreet = search::MatchedStreetsTable::kNoStreet;
+
+    if (found)
+      return true;
   }
 
   result = hasStreet ? 1 : 0;
   return false;
 }
 
-void BuildAddressTable(FilesContainerR & container, Writer & writer, uint32_t threadsCount)
+void BuildAddressTable(FilesContainerR & container, Writer & writer, Writer & matchedStreetsWriter,
+                       uint32_t threadsCount)
 {
   // Read all street names to memory.
   ReaderSource<ModelReaderPtr> src(container.GetReader(SEARCH_TOKENS_FILE_TAG));
@@ -387,6 +658,7 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer, uint32_t th
 
   uint32_t const kEmptyResult = uint32_t(-1);
   vector<uint32_t> results(featuresCount, kEmptyResult);
+  vector<uint32_t> matchedStreets(featuresCount, kUnknownMatchedStreet);
 
   mutex resMutex;
 
@@ -399,11 +671,15 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer, uint32_t th
     for (uint32_t i = beg; i < end; ++i)
     {
       uint32_t streetIndex;
-      bool const found = GetStreetIndex(*(contexts[threadIdx]), i,
-                                        addrs[i].Get(feature::AddressData::STREET), streetIndex);
+      uint32_t matchedStreet;
+      bool const found =
+          GetStreetIndex(*(contexts[threadIdx]), i, addrs[i].Get(feature::AddressData::STREET),
+                         streetIndex, matchedStreet);
 
       lock_guard<mutex> guard(resMutex);
 
+      matchedStreets[i] = matchedStreet;
+
       if (found)
       {
         results[i] = streetIndex;
@@ -445,17 +721,44 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer, uint32_t th
     LOG(LINFO, ("Address: Building -> Street (opt, all)", building2Street.GetCount()));
   }
 
+  {
+    search::MatchedStreetsTableBuilder builder;
+    for (uint32_t i = 0; i < featuresCount; ++i)
+    {
+      if (matchedStreets[i] != kUnknownMatchedStreet)
+        builder.Put(i, matchedStreets[i]);
+    }
+    builder.Freeze(matchedStreetsWriter);
+  }
+
   double matchedPercent = 100;
   if (address > 0)
     matchedPercent = 100.0 * (1.0 - static_cast<double>(missing) / static_cast<double>(address));
   LOG(LINFO, ("Address: Matched percent", matchedPercent));
   LOG(LINFO, ("Address: Upper bounds", bounds));
 }
+
+void BuildLocalitiesIndex(FilesContainerR & container, Writer & writer)
+{
+  FeaturesVectorTest features(container);
+  search::LocalitiesIndexBuilder builder;
+  uint32_t numLocalities = 0;
+  features.GetVector().ForEach([&](FeatureType & ft, uint32_t index) {
+    uint64_t population;
+    if (!search::IsIndexedLocality(ft, population))
+      return;
+    builder.Put(index, feature::GetCenter(ft));
+    ++numLocalities;
+  });
+  builder.Freeze(writer);
+  LOG(LINFO, ("Localities:", numLocalities));
+}
 }  // namespace
 
 namespace indexer
 {
-bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild, uint32_t threadsCount)
+bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild, uint32_t threadsCount,
+                                  SearchIndexVersion version)
 {
   Platform & platform = GetPlatform();
 
@@ -465,21 +768,34 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild, ui
 
   string const indexFilePath = filename + "." + SEARCH_INDEX_FILE_TAG EXTENSION_TMP;
   string const addrFilePath = filename + "." + SEARCH_ADDRESS_FILE_TAG EXTENSION_TMP;
+  string const matchedStreetsFilePath =
+      filename + "." + SEARCH_MATCHED_STREETS_FILE_TAG EXTENSION_TMP;
+  string const localitiesFilePath = filename + "." + SEARCH_LOCALITIES_FILE_TAG EXTENSION_TMP;
   SCOPE_GUARD(indexFileGuard, bind(&FileWriter::DeleteFileX, indexFilePath));
   SCOPE_GUARD(addrFileGuard, bind(&FileWriter::DeleteFileX, addrFilePath));
+  SCOPE_GUARD(matchedStreetsFileGuard, bind(&FileWriter::DeleteFileX, matchedStreetsFilePath));
+  SCOPE_GUARD(localitiesFileGuard, bind(&FileWriter::DeleteFileX, localitiesFilePath));
 
   try
   {
     {
       FileWriter writer(indexFilePath);
-      BuildSearchIndex(readContainer, writer);
+      BuildSearchIndex(readContainer, writer, threadsCount, version);
       LOG(LINFO, ("Search index size =", writer.Size()));
     }
-    if (filename != WORLD_FILE_NAME && filename != WORLD_COASTS_FILE_NAME)
+    bool const hasAddresses = filename != WORLD_FILE_NAME && filename != WORLD_COASTS_FILE_NAME;
+    if (hasAddresses)
     {
       FileWriter writer(addrFilePath);
-      BuildAddressTable(readContainer, writer, threadsCount);
+      FileWriter matchedStreetsWriter(matchedStreetsFilePath);
+      BuildAddressTable(readContainer, writer, matchedStreetsWriter, threadsCount);
       LOG(LINFO, ("Search address table size =", writer.Size()));
+      LOG(LINFO, ("Search matched streets table size =", matchedStreetsWriter.Size()));
+    }
+    {
+      FileWriter writer(localitiesFilePath);
+      BuildLocalitiesIndex(readContainer, writer);
+      LOG(LINFO, ("Search localities index size =", writer.Size()));
     }
     {
       // The behaviour of generator_tool's generate_search_index
@@ -499,14 +815,32 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild, ui
       // Separate scopes because FilesContainerW cannot write two sections at once.
       {
         FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
-        FileWriter writer = writeContainer.GetWriter(SEARCH_INDEX_FILE_TAG);
-        rw_ops::Reverse(FileReader(indexFilePath), writer);
+        if (version == SearchIndexVersion::V0)
+        {
+          FileWriter writer = writeContainer.GetWriter(SEARCH_INDEX_FILE_TAG);
+          rw_ops::Reverse(FileReader(indexFilePath), writer);
+        }
+        else
+        {
+          writeContainer.Write(indexFilePath, SEARCH_INDEX_FILE_TAG);
+        }
       }
 
       {
         FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
         writeContainer.Write(addrFilePath, SEARCH_ADDRESS_FILE_TAG);
       }
+
+      if (hasAddresses)
+      {
+        FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
+        writeContainer.Write(matchedStreetsFilePath, SEARCH_MATCHED_STREETS_FILE_TAG);
+      }
+
+      {
+        FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
+        writeContainer.Write(localitiesFilePath, SEARCH_LOCALITIES_FILE_TAG);
+      }
     }
   }
   catch (Reader::Exception const & e)
@@ -523,12 +857,13 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild, ui
   return true;
 }
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, uint32_t threadsCount,
+                      SearchIndexVersion version)
 {
   using Key = strings::UniString;
   using Value = FeatureIndexValue;
 
-  LOG(LINFO, ("Start building search index for", container.GetFileName()));
+  LOG(LINFO, ("Start building search index", version, "for", container.GetFileName()));
   base::Timer timer;
 
   auto const & categoriesHolder = GetDefaultCategories();
@@ -538,14 +873,55 @@ void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
       trie::GetGeometryCodingParams(features.GetHeader().GetDefGeometryCodingParams());
   SingleValueSerializer<Value> serializer(codingParams);
 
-  vector<pair<Key, Value>> searchIndexKeyValuePairs;
-  AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
+  if (version != SearchIndexVersion::V0)
+    SearchIndexHeader::Write(indexWriter, version);
+
+  auto const buildFromSorted = [&](auto && forEachPair) {
+    switch (version)
+    {
+    case SearchIndexVersion::V0:
+      trie::BuildFromSorted<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(
+          indexWriter, serializer, forEachPair);
+      return;
+    case SearchIndexVersion::V1:
+      trie::BuildPackedFromSorted<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(
+          indexWriter, serializer, forEachPair);
+      return;
+    }
+    CHECK_SWITCH();
+  };
+
+  // Features are read by indices in the parallel mode, which needs the offsets table.
+  if (threadsCount > 1 && features.GetVector().GetNumFeatures() != 0)
+  {
+    auto runs = AddFeatureNameIndexPairs(container, categoriesHolder, threadsCount);
+    LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
+
+    SCOPE_GUARD(runsGuard, [&runs]() {
+      for (auto & writer : runs)
+      {
+        string const fileName = writer->GetFileName();
+        writer.reset();
+        FileWriter::DeleteFileX(fileName);
+      }
+    });
 
-  sort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end());
-  LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
+    buildFromSorted([&runs](auto && toDo) { MergeKeyValueRuns(runs, toDo); });
+  }
+  else
+  {
+    vector<pair<Key, Value>> searchIndexKeyValuePairs;
+    AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
 
-  trie::Build<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(
-      indexWriter, serializer, searchIndexKeyValuePairs);
+    ParallelSort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end(),
+                 less<pair<Key, Value>>(), thread::hardware_concurrency());
+    LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
+
+    buildFromSorted([&searchIndexKeyValuePairs](auto && toDo) {
+      for (auto const & e : searchIndexKeyValuePairs)
+        toDo(e);
+    });
+  }
 
   LOG(LINFO, ("End building search index, elapsed seconds:", timer.ElapsedSeconds()));
 }
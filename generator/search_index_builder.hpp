@@ -1,5 +1,8 @@
 #pragma once
 
+#include "search/search_index_values.hpp"
+
+#include <cstdint>
 #include <string>
 
 class FilesContainerR;
@@ -11,8 +14,16 @@ namespace indexer
 // An attempt to rewrite the search index of an old mwm may result in a future crash
 // when using search because this function does not update mwm's version. This results
 // in version mismatch when trying to read the index.
+//
+// V1 is read in place and needs the whole section in memory, so until all platforms map mwms
+// the section is written in V0 by default.
 bool BuildSearchIndexFromDataFile(std::string const & filename, bool forceRebuild,
-                                  uint32_t threadsCount);
+                                  uint32_t threadsCount,
+                                  SearchIndexVersion version = SearchIndexVersion::V0);
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter);
+// With |threadsCount| > 1 token pairs of features are collected by several threads into sorted
+// runs of temporary files, which are merged into the index, so memory for them is bounded.
+// A V0 index is written reversed, see indexer/trie_builder.hpp.
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, uint32_t threadsCount,
+                      SearchIndexVersion version = SearchIndexVersion::V0);
 }  // namespace indexer
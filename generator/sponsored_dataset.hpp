@@ -4,8 +4,13 @@
 
 #include "base/newtype.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class FeatureBuilder1;
 
@@ -21,12 +26,22 @@ public:
   static double constexpr kDistanceLimitInMeters = 150;
   static size_t constexpr kMaxSelectedElements = 3;
 
-  explicit SponsoredDataset(std::string const & dataPath);
+  /// \param matchesCachePath is a file where matches of osm features are kept between builds.
+  /// Matches are taken from the file only when the dataset and the features aren't changed.
+  /// Caching is disabled if the path is empty.
+  explicit SponsoredDataset(std::string const & dataPath,
+                            std::string const & matchesCachePath = std::string());
 
   /// @return true if |fb| satisfies some necessary conditions to match one or serveral
   /// objects from dataset.
   bool NecessaryMatchingConditionHolds(FeatureBuilder1 const & fb) const;
+  /// \note Thread safe.
   ObjectId FindMatchingObjectId(FeatureBuilder1 const & e) const;
+  /// Finds matching objects of |features| on |threadsCount| threads in advance, so that
+  /// FindMatchingObjectId() takes the matches from the cache.
+  void MatchObjects(std::vector<FeatureBuilder1> const & features, size_t threadsCount) const;
+  /// Writes matches found or used in this build to the matches cache file.
+  void SaveMatches() const;
 
   // Applies changes to a given osm object (for example, remove hotel type)
   // and passes the result to |fn|.
@@ -44,7 +59,27 @@ private:
   /// @return an id of a matched object or kInvalidObjectId on failure.
   ObjectId FindMatchingObjectIdImpl(FeatureBuilder1 const & fb) const;
 
+  struct Match
+  {
+    // First bytes of SHA1 of the serialized feature.
+    uint64_t m_featureHash = 0;
+    ObjectId m_objectId = Object::InvalidObjectId();
+    bool m_used = false;
+  };
+
+  // Bump the version when matching changes.
+  static uint32_t constexpr kMatchesCacheVersion = 0;
+
+  static uint64_t GetFeatureHash(FeatureBuilder1 const & fb);
+  void LoadMatches();
+
   SponsoredObjectStorage<Object> m_storage;
+
+  std::string m_matchesCachePath;
+  std::string m_datasetHash;
+  mutable std::mutex m_matchesMutex;
+  // Matches by encoded osm ids.
+  mutable std::unordered_map<uint64_t, Match> m_matches;
 };
 }  // namespace generator
 
@@ -1,11 +1,21 @@
 #include "generator/sponsored_dataset.hpp"
 
+#include "generator/feature_builder.hpp"
 #include "generator/utils.hpp"
 
 #include "search/reverse_geocoder.hpp"
 
 #include "indexer/data_source.hpp"
 
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/sha1.hpp"
+#include "coding/write_to_sink.hpp"
+
 #include "geometry/latlon.hpp"
 #include "geometry/mercator.hpp"
 
@@ -13,6 +23,10 @@
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 namespace generator
 {
 class AddressMatcher
@@ -40,10 +54,23 @@ private:
 
 // SponsoredDataset --------------------------------------------------------------------------------
 template <typename SponsoredObject>
-SponsoredDataset<SponsoredObject>::SponsoredDataset(std::string const & dataPath)
+SponsoredDataset<SponsoredObject>::SponsoredDataset(std::string const & dataPath,
+                                                    std::string const & matchesCachePath)
   : m_storage(kDistanceLimitInMeters, kMaxSelectedElements)
 {
   m_storage.LoadData(dataPath);
+
+  if (matchesCachePath.empty() || m_storage.Size() == 0)
+    return;
+
+  // Matches depend on the objects of the dataset and on the excluded objects.
+  m_matchesCachePath = matchesCachePath;
+  m_datasetHash = coding::SHA1::CalculateBase64(dataPath);
+  auto const excludedIdsPath = SponsoredObjectStorage<Object>::GetExcludedIdsPath();
+  if (Platform::IsFileExistsByFullPath(excludedIdsPath))
+    m_datasetHash += coding::SHA1::CalculateBase64(excludedIdsPath);
+
+  LoadMatches();
 }
 
 template <typename SponsoredObject>
@@ -57,8 +84,142 @@ template <typename SponsoredObject>
 typename SponsoredDataset<SponsoredObject>::ObjectId
 SponsoredDataset<SponsoredObject>::FindMatchingObjectId(FeatureBuilder1 const & fb) const
 {
-  if (NecessaryMatchingConditionHolds(fb))
-    return FindMatchingObjectIdImpl(fb);
-  return Object::InvalidObjectId();
+  if (m_storage.Size() == 0 || !NecessaryMatchingConditionHolds(fb))
+    return Object::InvalidObjectId();
+
+  auto const osmId = fb.GetMostGenericOsmId().GetEncodedId();
+  auto const featureHash = GetFeatureHash(fb);
+  {
+    std::lock_guard<std::mutex> lock(m_matchesMutex);
+    auto const it = m_matches.find(osmId);
+    if (it != m_matches.end() && it->second.m_featureHash == featureHash)
+    {
+      it->second.m_used = true;
+      return it->second.m_objectId;
+    }
+  }
+
+  auto const objectId = FindMatchingObjectIdImpl(fb);
+
+  std::lock_guard<std::mutex> lock(m_matchesMutex);
+  auto & match = m_matches[osmId];
+  match.m_featureHash = featureHash;
+  match.m_objectId = objectId;
+  match.m_used = true;
+  return objectId;
+}
+
+template <typename SponsoredObject>
+void SponsoredDataset<SponsoredObject>::MatchObjects(std::vector<FeatureBuilder1> const & features,
+                                                     size_t threadsCount) const
+{
+  if (m_storage.Size() == 0)
+    return;
+
+  std::atomic<size_t> nextFeature(0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < std::min(threadsCount, features.size()); ++i)
+  {
+    threads.emplace_back([this, &features, &nextFeature]() {
+      for (size_t j = nextFeature++; j < features.size(); j = nextFeature++)
+        FindMatchingObjectId(features[j]);
+    });
+  }
+
+  for (auto & thread : threads)
+    thread.join();
+}
+
+template <typename SponsoredObject>
+void SponsoredDataset<SponsoredObject>::SaveMatches() const
+{
+  if (m_matchesCachePath.empty())
+    return;
+
+  std::lock_guard<std::mutex> lock(m_matchesMutex);
+  uint64_t const count = std::count_if(m_matches.cbegin(), m_matches.cend(),
+                                       [](auto const & item) { return item.second.m_used; });
+
+  // Matches of features which are absent in this build are dropped.
+  FileWriter writer(m_matchesCachePath);
+  WriteToSink(writer, static_cast<uint32_t>(kMatchesCacheVersion));
+  rw::Write(writer, m_datasetHash);
+  WriteToSink(writer, count);
+  for (auto const & item : m_matches)
+  {
+    if (!item.second.m_used)
+      continue;
+
+    WriteToSink(writer, item.first);
+    WriteToSink(writer, item.second.m_featureHash);
+    WriteToSink(writer, item.second.m_objectId.Get());
+  }
+  LOG(LINFO, ("Saved", count, "matches to", m_matchesCachePath));
+}
+
+// static
+template <typename SponsoredObject>
+uint64_t SponsoredDataset<SponsoredObject>::GetFeatureHash(FeatureBuilder1 const & fb)
+{
+  // Only the data which is used by matching is hashed.
+  coding::SHA1 sha1;
+  auto const name = fb.GetName(StringUtf8Multilang::kDefaultCode);
+  sha1.Update(name.data(), name.size());
+  auto const point = fb.GetKeyPoint();
+  sha1.Update(&point.x, sizeof(point.x));
+  sha1.Update(&point.y, sizeof(point.y));
+  auto const & types = fb.GetTypes();
+  sha1.Update(types.data(), types.size() * sizeof(types[0]));
+
+  auto const hash = sha1.Final();
+  uint64_t result = 0;
+  for (size_t i = 0; i < sizeof(result); ++i)
+    result = (result << 8) | hash[i];
+  return result;
+}
+
+template <typename SponsoredObject>
+void SponsoredDataset<SponsoredObject>::LoadMatches()
+{
+  if (!Platform::IsFileExistsByFullPath(m_matchesCachePath))
+    return;
+
+  try
+  {
+    FileReader reader(m_matchesCachePath);
+    ReaderSource<FileReader> src(reader);
+
+    auto const version = ReadPrimitiveFromSource<uint32_t>(src);
+    std::string datasetHash;
+    rw::Read(src, datasetHash);
+    if (version != kMatchesCacheVersion || datasetHash != m_datasetHash)
+    {
+      LOG(LINFO, ("Matches cache", m_matchesCachePath, "is outdated."));
+      return;
+    }
+
+    auto const count = ReadPrimitiveFromSource<uint64_t>(src);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      auto const osmId = ReadPrimitiveFromSource<uint64_t>(src);
+      Match match;
+      match.m_featureHash = ReadPrimitiveFromSource<uint64_t>(src);
+      match.m_objectId = ObjectId(ReadPrimitiveFromSource<typename ObjectId::RepType>(src));
+      if (match.m_objectId != Object::InvalidObjectId() &&
+          m_storage.GetObjects().count(match.m_objectId) == 0)
+      {
+        MYTHROW(Reader::Exception, ("Unknown object id", match.m_objectId));
+      }
+      m_matches.emplace(osmId, match);
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read matches cache", m_matchesCachePath, ":", e.Msg()));
+    m_matches.clear();
+    return;
+  }
+
+  LOG(LINFO, ("Loaded", m_matches.size(), "matches from", m_matchesCachePath));
 }
 }  // namespace generator
@@ -72,9 +72,12 @@ public:
       return;
     }
 
-    auto const excludedIdsPath = base::JoinPath(GetPlatform().ResourcesDir(), BOOKING_EXCLUDED_FILE);
+    LoadData(dataSource, LoadExcludedIds(GetExcludedIdsPath()));
+  }
 
-    LoadData(dataSource, LoadExcludedIds(excludedIdsPath));
+  static std::string GetExcludedIdsPath()
+  {
+    return base::JoinPath(GetPlatform().ResourcesDir(), BOOKING_EXCLUDED_FILE);
   }
 
   ExcludedIdsContainer LoadExcludedIds(std::string const & excludedIdsPath)
@@ -1,12 +1,22 @@
 #include "generator/srtm_parser.hpp"
 
+#include "platform/platform.hpp"
+
 #include "coding/endianness.hpp"
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
 #include "coding/zip_reader.hpp"
 
+#include "base/assert.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 namespace generator
 {
@@ -41,16 +51,66 @@ SrtmTile::SrtmTile()
   Invalidate();
 }
 
-SrtmTile::SrtmTile(SrtmTile && rhs) : m_data(move(rhs.m_data)), m_valid(rhs.m_valid)
+SrtmTile::SrtmTile(SrtmTile && rhs)
+  : m_data(move(rhs.m_data)), m_mmap(move(rhs.m_mmap)), m_valid(rhs.m_valid)
 {
   rhs.Invalidate();
 }
 
 void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord)
+{
+  Init(dir, std::string() /* cacheDir */, coord);
+}
+
+void SrtmTile::Init(std::string const & dir, std::string const & cacheDir,
+                    ms::LatLon const & coord)
 {
   Invalidate();
 
   std::string const base = GetBase(coord);
+  if (cacheDir.empty())
+  {
+    Unzip(dir, base);
+    return;
+  }
+
+  std::string const cached = base::JoinPath(cacheDir, base + ".hgt");
+  if (!Platform::IsFileExistsByFullPath(cached))
+  {
+    Unzip(dir, base);
+    if (!IsValid())
+      return;
+
+    // The copy is written under a unique name and renamed, so other threads and processes
+    // never map a partially written copy.
+    std::ostringstream tmp;
+    tmp << cached << ".tmp" << std::hash<std::thread::id>()(std::this_thread::get_id());
+    {
+      FileWriter writer(tmp.str());
+      writer.Write(m_data.data(), m_data.size());
+    }
+    if (!base::RenameFileX(tmp.str(), cached))
+    {
+      LOG(LWARNING, ("Can't cache SRTM tile:", cached));
+      base::DeleteFileX(tmp.str());
+      return;
+    }
+  }
+
+  Invalidate();
+  m_mmap = std::make_unique<MmapReader>(cached);
+  if (m_mmap->Size() != kSrtmTileSize)
+  {
+    LOG(LWARNING, ("Bad size of cached SRTM file:", cached, m_mmap->Size()));
+    Invalidate();
+    return;
+  }
+
+  m_valid = true;
+}
+
+void SrtmTile::Unzip(std::string const & dir, std::string const & base)
+{
   std::string const cont = dir + base + ".SRTMGL1.hgt.zip";
   std::string file = base + ".hgt";
 
@@ -84,7 +144,7 @@ void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord)
   m_valid = true;
 }
 
-feature::TAltitude SrtmTile::GetHeight(ms::LatLon const & coord)
+feature::TAltitude SrtmTile::GetHeight(ms::LatLon const & coord) const
 {
   if (!IsValid())
     return feature::kInvalidAltitude;
@@ -107,6 +167,42 @@ feature::TAltitude SrtmTile::GetHeight(ms::LatLon const & coord)
   return ReverseByteOrder(Data()[ix]);
 }
 
+feature::TAltitude SrtmTile::GetBilinearHeight(ms::LatLon const & coord) const
+{
+  if (!IsValid())
+    return feature::kInvalidAltitude;
+
+  double ln = coord.lon - static_cast<int>(coord.lon);
+  if (ln < 0)
+    ln += 1;
+  double lt = coord.lat - static_cast<int>(coord.lat);
+  if (lt < 0)
+    lt += 1;
+  lt = 1 - lt;  // from North to South
+
+  // Samples on the edges of a tile are shared with the neighbouring tiles, so the next row and
+  // column are in the tile.
+  double const row = kArcSecondsInDegree * lt;
+  double const col = kArcSecondsInDegree * ln;
+  size_t const row0 = std::min(static_cast<size_t>(row), kArcSecondsInDegree - 1);
+  size_t const col0 = std::min(static_cast<size_t>(col), kArcSecondsInDegree - 1);
+
+  feature::TAltitude const h00 = GetSample(row0, col0);
+  feature::TAltitude const h01 = GetSample(row0, col0 + 1);
+  feature::TAltitude const h10 = GetSample(row0 + 1, col0);
+  feature::TAltitude const h11 = GetSample(row0 + 1, col0 + 1);
+  if (h00 == feature::kInvalidAltitude || h01 == feature::kInvalidAltitude ||
+      h10 == feature::kInvalidAltitude || h11 == feature::kInvalidAltitude)
+  {
+    return feature::kInvalidAltitude;
+  }
+
+  double const dr = row - row0;
+  double const dc = col - col0;
+  double const h = (1 - dr) * ((1 - dc) * h00 + dc * h01) + dr * ((1 - dc) * h10 + dc * h11);
+  return static_cast<feature::TAltitude>(std::lround(h));
+}
+
 std::string SrtmTile::GetBase(ms::LatLon coord)
 {
   std::ostringstream ss;
@@ -136,36 +232,110 @@ std::string SrtmTile::GetBase(ms::LatLon coord)
   return ss.str();
 }
 
+feature::TAltitude SrtmTile::GetSample(size_t row, size_t col) const
+{
+  size_t const ix = row * (kArcSecondsInDegree + 1) + col;
+  if (ix >= Size())
+    return feature::kInvalidAltitude;
+  return ReverseByteOrder(Data()[ix]);
+}
+
 void SrtmTile::Invalidate()
 {
   m_data.clear();
   m_data.shrink_to_fit();
+  m_mmap.reset();
   m_valid = false;
 }
 
 // SrtmTileManager ---------------------------------------------------------------------------------
-SrtmTileManager::SrtmTileManager(std::string const & dir) : m_dir(dir) {}
+SrtmTileManager::SrtmTileManager(std::string const & dir)
+  : SrtmTileManager(dir, std::string() /* cacheDir */, 0 /* maxTilesCount */)
+{
+}
+
+SrtmTileManager::SrtmTileManager(std::string const & dir, std::string const & cacheDir,
+                                 size_t maxTilesCount)
+  : m_dir(dir), m_cacheDir(cacheDir), m_maxTilesCount(maxTilesCount)
+{
+}
+
 feature::TAltitude SrtmTileManager::GetHeight(ms::LatLon const & coord)
 {
-  std::string const base = SrtmTile::GetBase(coord);
-  auto it = m_tiles.find(base);
-  if (it == m_tiles.end())
+  return GetTile(coord)->GetHeight(coord);
+}
+
+void SrtmTileManager::GetHeights(std::vector<ms::LatLon> const & points, bool bilinear,
+                                 std::vector<feature::TAltitude> & heights)
+{
+  heights.clear();
+  heights.reserve(points.size());
+
+  TilePtr tile;
+  std::string tileBase;
+  for (auto const & point : points)
   {
-    SrtmTile tile;
-    try
+    auto const base = SrtmTile::GetBase(point);
+    if (!tile || base != tileBase)
     {
-      tile.Init(m_dir, coord);
+      tile = GetTile(point);
+      tileBase = base;
     }
-    catch (RootException const & e)
+    heights.push_back(bilinear ? tile->GetBilinearHeight(point) : tile->GetHeight(point));
+  }
+}
+
+size_t SrtmTileManager::GetTilesCount() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_tiles.size();
+}
+
+SrtmTileManager::TilePtr SrtmTileManager::GetTile(ms::LatLon const & coord)
+{
+  std::string const base = SrtmTile::GetBase(coord);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_index.find(base);
+    if (it != m_index.end())
     {
-      LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
+      m_tiles.splice(m_tiles.begin(), m_tiles, it->second);
+      return it->second->second;
     }
+  }
 
-    // It's OK to store even invalid tiles and return invalid height
-    // for them later.
-    it = m_tiles.emplace(base, std::move(tile)).first;
+  // Tiles are loaded without the lock, so threads which need other tiles aren't blocked.
+  auto tile = std::make_shared<SrtmTile>();
+  try
+  {
+    tile->Init(m_dir, m_cacheDir, coord);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_index.find(base);
+  if (it != m_index.end())
+  {
+    // The tile is loaded by another thread meanwhile.
+    m_tiles.splice(m_tiles.begin(), m_tiles, it->second);
+    return it->second->second;
   }
 
-  return it->second.GetHeight(coord);
+  // It's OK to store even invalid tiles and return invalid height
+  // for them later.
+  m_tiles.emplace_front(base, std::move(tile));
+  m_index.emplace(base, m_tiles.begin());
+  auto result = m_tiles.front().second;
+
+  // Evicted tiles are freed when the threads using them release them.
+  while (m_maxTilesCount != 0 && m_tiles.size() > m_maxTilesCount)
+  {
+    m_index.erase(m_tiles.back().first);
+    m_tiles.pop_back();
+  }
+  return result;
 }
 }  // namespace generator
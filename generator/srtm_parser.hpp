@@ -4,11 +4,18 @@
 
 #include "indexer/feature_altitude.hpp"
 
+#include "coding/mmap_reader.hpp"
+
 #include "base/macros.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace generator
 {
@@ -19,38 +26,75 @@ public:
   SrtmTile(SrtmTile && rhs);
 
   void Init(std::string const & dir, ms::LatLon const & coord);
+  // When |cacheDir| is not empty, the tile is memory mapped from the uncompressed copy in
+  // |cacheDir|, the copy is created from the archive in |dir| if it doesn't exist.
+  void Init(std::string const & dir, std::string const & cacheDir, ms::LatLon const & coord);
 
   inline bool IsValid() const { return m_valid; }
   // Returns height in meters at |coord| or kInvalidAltitude.
-  feature::TAltitude GetHeight(ms::LatLon const & coord);
+  feature::TAltitude GetHeight(ms::LatLon const & coord) const;
+  // Returns height in meters at |coord| interpolated by the four nearest samples or
+  // kInvalidAltitude if some of the samples are missing.
+  feature::TAltitude GetBilinearHeight(ms::LatLon const & coord) const;
 
   static std::string GetBase(ms::LatLon coord);
 
 private:
   inline feature::TAltitude const * Data() const
   {
-    return reinterpret_cast<feature::TAltitude const *>(m_data.data());
+    return m_mmap ? reinterpret_cast<feature::TAltitude const *>(m_mmap->Data())
+                  : reinterpret_cast<feature::TAltitude const *>(m_data.data());
   };
 
-  inline size_t Size() const { return m_data.size() / sizeof(feature::TAltitude); }
+  inline size_t Size() const
+  {
+    return (m_mmap ? m_mmap->Size() : m_data.size()) / sizeof(feature::TAltitude);
+  }
+
+  // Returns the sample in |row| and |col|, rows go from North to South.
+  feature::TAltitude GetSample(size_t row, size_t col) const;
+  void Unzip(std::string const & dir, std::string const & base);
   void Invalidate();
 
   std::string m_data;
+  std::unique_ptr<MmapReader> m_mmap;
   bool m_valid;
 
   DISALLOW_COPY(SrtmTile);
 };
 
+// NOTE: this class is thread safe.
 class SrtmTileManager
 {
 public:
   SrtmTileManager(std::string const & dir);
+  // Tiles are memory mapped from |cacheDir| when it's not empty, see SrtmTile::Init(). When
+  // |maxTilesCount| is positive, the least recently used tiles are dropped to keep at most
+  // |maxTilesCount| tiles. Zero means all the tiles are kept.
+  SrtmTileManager(std::string const & dir, std::string const & cacheDir, size_t maxTilesCount);
 
   feature::TAltitude GetHeight(ms::LatLon const & coord);
 
+  // Fills |heights| with heights of |points|, e.g. of a polyline. Heights are interpolated
+  // when |bilinear| is true. A tile is looked up once for a run of points in the same tile.
+  void GetHeights(std::vector<ms::LatLon> const & points, bool bilinear,
+                  std::vector<feature::TAltitude> & heights);
+
+  size_t GetTilesCount() const;
+
 private:
-  std::string m_dir;
-  std::unordered_map<std::string, SrtmTile> m_tiles;
+  using TilePtr = std::shared_ptr<SrtmTile const>;
+
+  TilePtr GetTile(ms::LatLon const & coord);
+
+  std::string const m_dir;
+  std::string const m_cacheDir;
+  size_t const m_maxTilesCount;
+
+  mutable std::mutex m_mutex;
+  // Tiles in the order of their use, the most recently used tile is the first.
+  std::list<std::pair<std::string, TilePtr>> m_tiles;
+  std::unordered_map<std::string, decltype(m_tiles)::iterator> m_index;
 
   DISALLOW_COPY(SrtmTileManager);
 };
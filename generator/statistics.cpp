@@ -5,15 +5,24 @@
 #include "indexer/feature_impl.hpp"
 #include "indexer/feature_processor.hpp"
 
+#include "coding/file_writer.hpp"
+
 #include "geometry/triangle2d.hpp"
 
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
 
+#include "std/target_os.hpp"
+
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
 
+#include <sys/resource.h>
+
+#include "3party/jansson/myjansson.hpp"
+
 using namespace feature;
 using namespace std;
 
@@ -203,4 +212,165 @@ namespace stats
       PrintInfo(GetKey(it->first).c_str(), it->second, true);
     }
   }
+
+  ResourceUsage GetResourceUsage()
+  {
+    ResourceUsage result;
+
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+      auto const toSeconds = [](timeval const & t) { return t.tv_sec + t.tv_usec / 1e6; };
+      result.m_cpuSeconds = toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+#if defined(OMIM_OS_MAC)
+      // ru_maxrss is in bytes on Mac and in kilobytes on Linux.
+      result.m_peakRssBytes = static_cast<uint64_t>(usage.ru_maxrss);
+#else
+      result.m_peakRssBytes = static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+
+#if defined(OMIM_OS_LINUX)
+    ifstream io("/proc/self/io");
+    string key;
+    uint64_t value;
+    while (io >> key >> value)
+    {
+      if (key == "rchar:")
+        result.m_readBytes = value;
+      else if (key == "wchar:")
+        result.m_writtenBytes = value;
+    }
+#endif
+    return result;
+  }
+
+  namespace
+  {
+  base::JSONPtr StageToJSON(StageInfo const & info)
+  {
+    auto stage = base::NewJSONObject();
+    ToJSONObject(*stage, "stage", info.m_stage);
+    ToJSONObject(*stage, "wall_seconds", info.m_wallSeconds);
+    ToJSONObject(*stage, "cpu_seconds", info.m_usage.m_cpuSeconds);
+    ToJSONObject(*stage, "peak_rss_bytes", info.m_usage.m_peakRssBytes);
+    ToJSONObject(*stage, "read_bytes", info.m_usage.m_readBytes);
+    ToJSONObject(*stage, "written_bytes", info.m_usage.m_writtenBytes);
+    ToJSONObject(*stage, "items", info.m_itemsCount);
+    double const itemsPerSecond =
+        info.m_wallSeconds > 0 ? static_cast<double>(info.m_itemsCount) / info.m_wallSeconds : 0;
+    ToJSONObject(*stage, "items_per_second", itemsPerSecond);
+    return stage;
+  }
+
+  string DumpJSON(base::JSONPtr const & root)
+  {
+    unique_ptr<char, JSONFreeDeleter> buffer(json_dumps(root.get(), JSON_INDENT(2)));
+    return buffer.get();
+  }
+
+  bool SaveString(string const & filePath, string const & data)
+  {
+    try
+    {
+      FileWriter writer(filePath);
+      writer.Write(data.data(), data.size());
+    }
+    catch (Writer::Exception const & e)
+    {
+      LOG(LERROR, ("Can't write stages report to", filePath, e.what()));
+      return false;
+    }
+    return true;
+  }
+
+  string const kPlanetName = "planet";
+  }  // namespace
+
+  void StagesReport::Add(StageInfo const & info)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_stages.push_back(info);
+  }
+
+  string StagesReport::ToJSON() const
+  {
+    auto countries = base::NewJSONObject();
+    {
+      lock_guard<mutex> lock(m_mutex);
+      for (auto const & info : m_stages)
+      {
+        auto const & name = info.m_country.empty() ? kPlanetName : info.m_country;
+        json_t * stages = json_object_get(countries.get(), name.c_str());
+        if (stages == nullptr)
+        {
+          stages = json_array();
+          json_object_set_new(countries.get(), name.c_str(), stages);
+        }
+        json_array_append_new(stages, StageToJSON(info).release());
+      }
+    }
+
+    auto const usage = GetResourceUsage();
+    auto total = base::NewJSONObject();
+    ToJSONObject(*total, "wall_seconds", m_timer.ElapsedSeconds());
+    ToJSONObject(*total, "cpu_seconds", usage.m_cpuSeconds);
+    ToJSONObject(*total, "peak_rss_bytes", usage.m_peakRssBytes);
+    ToJSONObject(*total, "read_bytes", usage.m_readBytes);
+    ToJSONObject(*total, "written_bytes", usage.m_writtenBytes);
+
+    auto root = base::NewJSONObject();
+    ToJSONObject(*root, "total", total);
+    ToJSONObject(*root, "countries", countries);
+    return DumpJSON(root);
+  }
+
+  string StagesReport::ToJSON(string const & country) const
+  {
+    auto stages = base::NewJSONArray();
+    {
+      lock_guard<mutex> lock(m_mutex);
+      for (auto const & info : m_stages)
+      {
+        if (info.m_country == country)
+          json_array_append_new(stages.get(), StageToJSON(info).release());
+      }
+    }
+
+    auto root = base::NewJSONObject();
+    ToJSONObject(*root, "country", country.empty() ? kPlanetName : country);
+    ToJSONObject(*root, "stages", stages);
+    return DumpJSON(root);
+  }
+
+  bool StagesReport::Save(string const & filePath) const { return SaveString(filePath, ToJSON()); }
+
+  bool StagesReport::Save(string const & filePath, string const & country) const
+  {
+    return SaveString(filePath, ToJSON(country));
+  }
+
+  ScopedStage::ScopedStage(string const & stage, string const & country, StagesReport * report)
+    : m_start(GetResourceUsage()), m_report(report)
+  {
+    m_info.m_stage = stage;
+    m_info.m_country = country;
+  }
+
+  ScopedStage::~ScopedStage()
+  {
+    auto const usage = GetResourceUsage();
+    m_info.m_wallSeconds = m_timer.ElapsedSeconds();
+    m_info.m_usage.m_cpuSeconds = usage.m_cpuSeconds - m_start.m_cpuSeconds;
+    m_info.m_usage.m_peakRssBytes = usage.m_peakRssBytes;
+    m_info.m_usage.m_readBytes = usage.m_readBytes - m_start.m_readBytes;
+    m_info.m_usage.m_writtenBytes = usage.m_writtenBytes - m_start.m_writtenBytes;
+
+    LOG(LINFO, (m_info.m_stage, "for", m_info.m_country.empty() ? kPlanetName : m_info.m_country,
+                "took", m_info.m_wallSeconds, "seconds, CPU", m_info.m_usage.m_cpuSeconds,
+                "seconds. Peak memory:", m_info.m_usage.m_peakRssBytes / (1024 * 1024), "MB."));
+
+    if (m_report)
+      m_report->Add(m_info);
+  }
 }
@@ -2,9 +2,13 @@
 
 #include "indexer/feature.hpp"
 
+#include "base/timer.hpp"
+
 #include <cstdint>
 #include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace stats
 {
@@ -54,4 +58,68 @@ namespace stats
   void CalcStatistic(std::string const & fPath, MapInfo & info);
   void PrintStatistic(MapInfo & info);
   void PrintTypeStatistic(MapInfo & info);
+
+  // Resources used by the process so far.
+  struct ResourceUsage
+  {
+    double m_cpuSeconds = 0;
+    uint64_t m_peakRssBytes = 0;
+    // Bytes passed through read and write calls, memory mapped files are not counted.
+    // Zeroes if the platform does not provide them.
+    uint64_t m_readBytes = 0;
+    uint64_t m_writtenBytes = 0;
+  };
+
+  ResourceUsage GetResourceUsage();
+
+  // Resources of a stage of the generation of |m_country|, an empty country is
+  // the whole planet. Usage is counted for the process, so stages of mwms which
+  // are generated in parallel overlap. |m_peakRssBytes| is the peak of the process
+  // at the end of the stage.
+  struct StageInfo
+  {
+    std::string m_stage;
+    std::string m_country;
+    double m_wallSeconds = 0;
+    ResourceUsage m_usage;
+    // Number of features, elements etc. processed by the stage, 0 if unknown.
+    uint64_t m_itemsCount = 0;
+  };
+
+  // Collects stages of a generator run, thread safe.
+  class StagesReport
+  {
+  public:
+    void Add(StageInfo const & info);
+
+    // Json object with stages grouped by countries and resources of the whole run.
+    std::string ToJSON() const;
+    // Json object with stages of |country| only.
+    std::string ToJSON(std::string const & country) const;
+
+    bool Save(std::string const & filePath) const;
+    bool Save(std::string const & filePath, std::string const & country) const;
+
+  private:
+    mutable std::mutex m_mutex;
+    std::vector<StageInfo> m_stages;
+    base::Timer m_timer;
+  };
+
+  // Measures resources of a stage from construction to destruction, logs them and
+  // adds them to |report| if it is not null.
+  class ScopedStage
+  {
+  public:
+    ScopedStage(std::string const & stage, std::string const & country, StagesReport * report);
+    ~ScopedStage();
+
+    void SetItemsCount(uint64_t count) { m_info.m_itemsCount = count; }
+
+  private:
+    StageInfo m_info;
+    ResourceUsage const m_start;
+    base::Timer m_timer;
+    StagesReport * m_report;
+  };
 }
@@ -11,8 +11,12 @@
 #include "storage/country_info_getter.hpp"
 #include "storage/routing_helpers.hpp"
 
+#include "transit/transit_display_section.hpp"
 #include "transit/transit_types.hpp"
 
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/features_vector.hpp"
 #include "indexer/mwm_set.hpp"
 
 #include "geometry/point2d.hpp"
@@ -28,6 +32,7 @@
 #include "base/exception.hpp"
 #include "base/logging.hpp"
 
+#include <set>
 #include <vector>
 
 #include "defines.hpp"
@@ -64,6 +69,29 @@ string GetMwmPath(string const & mwmDir, TCountryId const & countryId)
   return base::JoinPath(mwmDir, countryId + DATA_FILE_EXTENSION);
 }
 
+/// \returns names and centers of features of stops of |graphData|, which are needed to show
+/// the transit scheme.
+vector<DisplayFeature> CollectDisplayFeatures(string const & mwmPath, GraphData const & graphData)
+{
+  set<uint32_t> featureIds;
+  for (auto const & stop : graphData.GetStops())
+  {
+    if (stop.GetFeatureId() != kInvalidFeatureId)
+      featureIds.insert(stop.GetFeatureId());
+  }
+
+  FeaturesVectorTest features(mwmPath);
+  vector<DisplayFeature> displayFeatures;
+  displayFeatures.reserve(featureIds.size());
+  FeatureType ft;
+  for (auto const featureId : featureIds)
+  {
+    features.GetVector().GetByIndex(featureId, ft);
+    displayFeatures.emplace_back(featureId, feature::GetCenter(ft), ft.GetNames());
+  }
+  return displayFeatures;
+}
+
 /// \brief Calculates best pedestrian segment for every gate in |graphData.m_gates|.
 /// The result of the calculation is set to |Gate::m_bestPedestrianSegment| of every gate
 /// from |graphData.m_gates|.
@@ -208,10 +236,17 @@ void BuildTransit(string const & mwmDir, TCountryId const & countryId,
 
   ProcessGraph(mwmPath, countryId, mapping, jointData);
   jointData.CheckValidSortedUnique();
+  auto displayFeatures = CollectDisplayFeatures(mwmPath, jointData);
 
   FilesContainerW cont(mwmPath, FileWriter::OP_WRITE_EXISTING);
-  FileWriter writer = cont.GetWriter(TRANSIT_FILE_TAG);
-  jointData.Serialize(writer);
+  {
+    FileWriter writer = cont.GetWriter(TRANSIT_FILE_TAG);
+    jointData.Serialize(writer);
+  }
+  {
+    FileWriter writer = cont.GetWriter(TRANSIT_DISPLAY_FILE_TAG);
+    DisplaySection::Serialize(move(displayFeatures), writer);
+  }
 }
 }  // namespace transit
 }  // namespace routing
@@ -17,19 +17,26 @@
 #include "base/assert.hpp"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace generator
 {
+namespace
+{
+size_t constexpr kBatchSize = 1000;
+}  // namespace
+
 TranslatorPlanet::TranslatorPlanet(std::shared_ptr<EmitterInterface> emitter,
                                    cache::IntermediateDataReader & holder,
                                    feature::GenerateInfo const & info) :
   m_emitter(emitter),
   m_cache(holder),
   m_coastType(info.m_makeCoasts ? classif().GetCoastType() : 0),
-  m_nodeRelations(m_routingTagsProcessor),
-  m_wayRelations(m_routingTagsProcessor),
-  m_metalinesBuilder(info.GetIntermediateFileName(METALINES_FILENAME))
+  m_nodeRelations([this](RelationElement const & relation) { WriteRestriction(relation); }),
+  m_wayRelations([this](RelationElement const & relation) { WriteRestriction(relation); }),
+  m_metalinesBuilder(
+      std::make_unique<feature::MetalinesBuilder>(info.GetIntermediateFileName(METALINES_FILENAME)))
 {
   auto const addrFilePath = info.GetAddressesFileName();
   if (!addrFilePath.empty())
@@ -52,12 +59,99 @@ TranslatorPlanet::TranslatorPlanet(std::shared_ptr<EmitterInterface> emitter,
     m_routingTagsProcessor.m_cameraNodeWriter.Open(camerasToWaysFilePath, camerasNodesToWaysFilePath,
                                                    camerasMaxSpeedFilePath);
   }
+
+  if (info.m_threadsCount > 1)
+  {
+    for (size_t i = 0; i < info.m_threadsCount; ++i)
+      m_workers.emplace_back(new TranslatorPlanet(*this));
+  }
+}
+
+TranslatorPlanet::TranslatorPlanet(TranslatorPlanet const & writer) :
+  m_cache(writer.m_cache),
+  m_coastType(writer.m_coastType),
+  m_nodeRelations([this](RelationElement const & relation) { WriteRestriction(relation); }),
+  m_wayRelations([this](RelationElement const & relation) { WriteRestriction(relation); })
+{
 }
 
 void TranslatorPlanet::EmitElement(OsmElement * p)
 {
   CHECK(p, ("Tried to emit a null OsmElement"));
 
+  if (m_workers.empty())
+  {
+    Translate(p);
+    return;
+  }
+
+  m_batch.push_back(*p);
+  if (m_batch.size() == kBatchSize)
+    PushBatch();
+}
+
+bool TranslatorPlanet::Finish()
+{
+  if (!m_batch.empty())
+    PushBatch();
+
+  while (!m_pending.empty())
+  {
+    auto outputs = m_pending.front().get();
+    m_pending.pop_front();
+    WriteOutputs(outputs);
+  }
+
+  return m_emitter->Finish();
+}
+
+void TranslatorPlanet::GetNames(std::vector<std::string> & names) const
+{
+  m_emitter->GetNames(names);
+}
+
+void TranslatorPlanet::PushBatch()
+{
+  // The oldest batch is translated by the next worker.
+  if (m_pending.size() == m_workers.size())
+  {
+    auto outputs = m_pending.front().get();
+    m_pending.pop_front();
+    WriteOutputs(outputs);
+  }
+
+  auto & worker = *m_workers[m_nextWorker];
+  m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+  m_pending.push_back(std::async(std::launch::async, [&worker](std::vector<OsmElement> batch)
+  {
+    Outputs outputs;
+    worker.m_outputs = &outputs;
+    for (auto & element : batch)
+      worker.Translate(&element);
+    worker.m_outputs = nullptr;
+    return outputs;
+  }, std::move(m_batch)));
+
+  m_batch.clear();
+  m_batch.reserve(kBatchSize);
+}
+
+void TranslatorPlanet::WriteOutputs(Outputs & outputs)
+{
+  for (auto & output : outputs)
+    output(*this);
+}
+
+void TranslatorPlanet::WriteRestriction(RelationElement const & relation)
+{
+  Write([](TranslatorPlanet & writer, RelationElement const & relation)
+  {
+    writer.m_routingTagsProcessor.m_restrictionWriter.Write(relation);
+  }, relation);
+}
+
+void TranslatorPlanet::Translate(OsmElement * p)
+{
   FeatureParams params;
   switch (p->type)
   {
@@ -106,7 +200,10 @@ void TranslatorPlanet::EmitElement(OsmElement * p)
       ft.SetAreaAddHoles(processor.GetHoles());
     });
 
-    m_metalinesBuilder(*p, params);
+    Write([](TranslatorPlanet & writer, OsmElement const & element, FeatureParams const & params)
+    {
+      (*writer.m_metalinesBuilder)(element, params);
+    }, *p, params);
     EmitLine(ft, params, isCoastline);
     break;
   }
@@ -147,16 +244,6 @@ void TranslatorPlanet::EmitElement(OsmElement * p)
   }
 }
 
-bool TranslatorPlanet::Finish()
-{
-  return m_emitter->Finish();
-}
-
-void TranslatorPlanet::GetNames(std::vector<std::string> & names) const
-{
-  m_emitter->GetNames(names);
-}
-
 bool TranslatorPlanet::ParseType(OsmElement * p, FeatureParams & params)
 {
   // Get tags from parent relations.
@@ -176,13 +263,16 @@ bool TranslatorPlanet::ParseType(OsmElement * p, FeatureParams & params)
   if (!params.IsValid())
     return false;
 
-  m_routingTagsProcessor.m_cameraNodeWriter.Process(*p, params, m_cache);
-  m_routingTagsProcessor.m_roadAccessWriter.Process(*p);
+  Write([](TranslatorPlanet & writer, OsmElement & element, FeatureParams const & params)
+  {
+    writer.m_routingTagsProcessor.m_cameraNodeWriter.Process(element, params, writer.m_cache);
+    writer.m_routingTagsProcessor.m_roadAccessWriter.Process(element);
+  }, *p, params);
   return true;
 }
 
 void TranslatorPlanet::EmitPoint(m2::PointD const & pt, FeatureParams params,
-                                 base::GeoObjectId id) const
+                                 base::GeoObjectId id)
 {
   if (!feature::RemoveNoDrawableTypes(params.m_types, feature::GEOM_POINT))
     return;
@@ -193,7 +283,7 @@ void TranslatorPlanet::EmitPoint(m2::PointD const & pt, FeatureParams params,
   EmitFeatureBase(ft, params);
 }
 
-void TranslatorPlanet::EmitLine(FeatureBuilder1 & ft, FeatureParams params, bool isCoastLine) const
+void TranslatorPlanet::EmitLine(FeatureBuilder1 & ft, FeatureParams params, bool isCoastLine)
 {
   if (!isCoastLine && !feature::RemoveNoDrawableTypes(params.m_types, feature::GEOM_LINE))
     return;
@@ -223,7 +313,10 @@ void TranslatorPlanet::EmitArea(FeatureBuilder1 & ft, FeatureParams params,
   {
     auto fb = ft;
     fn(fb);
-    m_emitter->EmitCityBoundary(fb, params);
+    Write([](TranslatorPlanet & writer, FeatureBuilder1 const & fb, FeatureParams const & params)
+    {
+      writer.m_emitter->EmitCityBoundary(fb, params);
+    }, fb, params);
   }
 
   // Key point here is that IsDrawableLike and RemoveNoDrawableTypes
@@ -242,21 +335,23 @@ void TranslatorPlanet::EmitArea(FeatureBuilder1 & ft, FeatureParams params,
   }
 }
 
-void TranslatorPlanet::EmitFeatureBase(FeatureBuilder1 & ft,
-                                       FeatureParams const & params) const
+void TranslatorPlanet::EmitFeatureBase(FeatureBuilder1 & ft, FeatureParams const & params)
 {
   ft.SetParams(params);
   if (!ft.PreSerializeAndRemoveUselessNames())
     return;
 
-  std::string addr;
-  if (m_addrWriter &&
-      ftypes::IsBuildingChecker::Instance()(params.m_types) &&
-      ft.FormatFullAddress(addr))
+  Write([](TranslatorPlanet & writer, FeatureBuilder1 & ft, FeatureParams const & params)
   {
-    m_addrWriter->Write(addr.c_str(), addr.size());
-  }
+    std::string addr;
+    if (writer.m_addrWriter &&
+        ftypes::IsBuildingChecker::Instance()(params.m_types) &&
+        ft.FormatFullAddress(addr))
+    {
+      writer.m_addrWriter->Write(addr.c_str(), addr.size());
+    }
 
-  (*m_emitter)(ft);
+    (*writer.m_emitter)(ft);
+  }, ft, params);
 }
 }  // namespace generator
@@ -10,9 +10,14 @@
 
 #include "base/geo_object_id.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <future>
 #include <memory>
+#include <utility>
+#include <vector>
 
 struct OsmElement;
 class FeatureBuilder1;
@@ -30,6 +35,13 @@ class IntermediateDataReader;
 }  // namespace cache
 
 // Osm to feature translator for planet.
+//
+// When info.m_threadsCount is greater than 1, elements are translated by a pool of worker
+// translators which share |holder|. Workers don't write anything: features, restrictions,
+// cameras, road access, metalines and addresses of every batch of elements are recorded and
+// written by this translator in the order of elements. So the emitter gets the same features
+// in the same order as in the single-threaded mode, and coastlines, the World and countries
+// are generated as before.
 class TranslatorPlanet : public TranslatorInterface
 {
 public:
@@ -42,11 +54,37 @@ public:
   void GetNames(std::vector<std::string> & names) const override;
 
 private:
+  // An output of translation, which is written by the translator passed as the argument.
+  using Output = std::function<void(TranslatorPlanet & writer)>;
+  using Outputs = std::vector<Output>;
+
+  // Constructs a worker of |writer|.
+  explicit TranslatorPlanet(TranslatorPlanet const & writer);
+
+  // Calls |fn| with the writer and |values|: immediately with this translator, or later with
+  // the writer of this worker. In the latter case |values| are copied.
+  template <typename Fn, typename... Values>
+  void Write(Fn && fn, Values &&... values)
+  {
+    if (!m_outputs)
+    {
+      fn(*this, std::forward<Values>(values)...);
+      return;
+    }
+    m_outputs->emplace_back(std::bind(std::forward<Fn>(fn), std::placeholders::_1,
+                                      std::decay_t<Values>(std::forward<Values>(values))...));
+  }
+
+  void Translate(OsmElement * p);
+  void WriteRestriction(RelationElement const & relation);
+  void PushBatch();
+  void WriteOutputs(Outputs & outputs);
+
   bool ParseType(OsmElement * p, FeatureParams & params);
-  void EmitFeatureBase(FeatureBuilder1 & ft, FeatureParams const & params) const;
+  void EmitFeatureBase(FeatureBuilder1 & ft, FeatureParams const & params);
   /// @param[in]  params  Pass by value because it can be modified.
-  void EmitPoint(m2::PointD const & pt, FeatureParams params, base::GeoObjectId id) const;
-  void EmitLine(FeatureBuilder1 & ft, FeatureParams params, bool isCoastLine) const;
+  void EmitPoint(m2::PointD const & pt, FeatureParams params, base::GeoObjectId id);
+  void EmitLine(FeatureBuilder1 & ft, FeatureParams params, bool isCoastLine);
   void EmitArea(FeatureBuilder1 & ft, FeatureParams params, std::function<void(FeatureBuilder1 &)> fn);
 
 private:
@@ -57,6 +95,17 @@ private:
   routing::TagsProcessor m_routingTagsProcessor;
   RelationTagsNode m_nodeRelations;
   RelationTagsWay m_wayRelations;
-  feature::MetalinesBuilder m_metalinesBuilder;
+  // It is null in workers.
+  std::unique_ptr<feature::MetalinesBuilder> m_metalinesBuilder;
+
+  // Outputs of the current batch of a worker, null when outputs are written immediately.
+  Outputs * m_outputs = nullptr;
+
+  std::vector<std::unique_ptr<TranslatorPlanet>> m_workers;
+  std::vector<OsmElement> m_batch;
+  // Batches being translated, in the order of elements. The batch i is translated by the
+  // worker i % m_workers.size(), so a worker has one batch at a time.
+  std::deque<std::future<Outputs>> m_pending;
+  size_t m_nextWorker = 0;
 };
 }  // namespace generator
@@ -1,5 +1,7 @@
 #include "generator/ways_merger.hpp"
 
+#include <set>
+
 namespace generator
 {
 AreaWayMerger::AreaWayMerger(cache::IntermediateDataReader & holder) :
@@ -7,13 +9,28 @@ AreaWayMerger::AreaWayMerger(cache::IntermediateDataReader & holder) :
 {
 }
 
-void AreaWayMerger::AddWay(uint64_t id)
+void AreaWayMerger::AddWay(uint64_t id) { m_pendingIds.push_back(id); }
+
+void AreaWayMerger::ReadPendingWays()
 {
-  auto e = std::make_shared<WayElement>(id);
-  if (m_holder.GetWay(id, *e) && e->IsValid())
+  if (m_pendingIds.empty())
+    return;
+
+  std::vector<std::shared_ptr<WayElement const>> ways;
+  m_holder.GetWays(m_pendingIds, ways);
+
+  // Ways are compared by pointers while merging, so a way added twice has to be a distinct copy.
+  std::set<WayElement const *> added;
+  for (auto & e : ways)
   {
+    if (!e || !e->IsValid())
+      continue;
+    if (!added.insert(e.get()).second)
+      e = std::make_shared<WayElement const>(*e);
+
     m_map.emplace(e->nodes.front(), e);
     m_map.emplace(e->nodes.back(), e);
   }
+  m_pendingIds.clear();
 }
 }  // namespace generator
@@ -16,17 +16,20 @@ namespace generator
 class AreaWayMerger
 {
   using PointSeq = std::vector<m2::PointD>;
-  using WayMap = std::multimap<uint64_t, std::shared_ptr<WayElement>>;
+  using WayMap = std::multimap<uint64_t, std::shared_ptr<WayElement const>>;
   using WayMapIterator = WayMap::iterator;
 
 public:
   explicit AreaWayMerger(cache::IntermediateDataReader & holder);
 
+  // Ways are read at once by the first ForEachArea() call.
   void AddWay(uint64_t id);
 
   template <class ToDo>
   void ForEachArea(bool collectID, ToDo toDo)
   {
+    ReadPendingWays();
+
     while (!m_map.empty())
     {
       // start
@@ -39,7 +42,7 @@ public:
       do
       {
         // process way points
-        std::shared_ptr<WayElement> e = i->second;
+        std::shared_ptr<WayElement const> e = i->second;
         if (collectID)
           ids.push_back(e->m_wayOsmId);
 
@@ -76,7 +79,10 @@ public:
   }
 
 private:
+  void ReadPendingWays();
+
   cache::IntermediateDataReader & m_holder;
+  std::vector<uint64_t> m_pendingIds;
   WayMap m_map;
 };
 }  // namespace generator
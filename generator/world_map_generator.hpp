@@ -9,7 +9,16 @@
 #include "indexer/classificator.hpp"
 #include "indexer/scales.hpp"
 
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/pointd_to_pointu.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/sha1.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "platform/platform.hpp"
 
 #include "geometry/polygon.hpp"
 #include "geometry/region2d.hpp"
@@ -30,6 +39,13 @@ namespace
 {
 class WaterBoundaryChecker
 {
+  // Land parts of a boundary from the previous run.
+  struct CachedParts
+  {
+    std::vector<FeatureBuilder1::PointSeq> m_parts;
+    bool m_used = false;
+  };
+
   uint32_t m_boundaryType;
 
   struct RegionTraits
@@ -37,24 +53,43 @@ class WaterBoundaryChecker
     m2::RectD const & LimitRect(m2::RegionD const & r) const { return r.GetRect(); }
   };
   m4::Tree<m2::RegionD, RegionTraits> m_tree;
+  std::string m_rawGeometryFileName;
+  bool m_waterLoaded = false;
+
+  // Boundaries are split by the water geometry point by point, which is the slowest part
+  // of the world generation. As most boundaries don't change between runs, their parts are
+  // cached by hashes of their points for the same water geometry.
+  std::string m_cachePath;
+  std::string m_waterHash;
+  std::map<coding::SHA1::Hash, CachedParts> m_cache;
 
   size_t m_totalFeatures = 0;
   size_t m_totalBorders = 0;
   size_t m_skippedBorders = 0;
   size_t m_selectedPolygons = 0;
+  size_t m_cachedBorders = 0;
 
 public:
   WaterBoundaryChecker(feature::GenerateInfo const & info)
+    : m_rawGeometryFileName(
+          info.GetIntermediateFileName(WORLD_COASTS_FILE_NAME, RAW_GEOM_FILE_EXTENSION))
   {
     m_boundaryType = classif().GetTypeByPath({"boundary", "administrative"});
-    LoadWaterGeometry(
-        info.GetIntermediateFileName(WORLD_COASTS_FILE_NAME, RAW_GEOM_FILE_EXTENSION));
+    if (!info.m_worldCacheDir.empty())
+    {
+      m_cachePath = base::JoinPath(info.m_worldCacheDir, "world_boundaries.cache");
+      m_waterHash = coding::SHA1::CalculateBase64(m_rawGeometryFileName);
+      LoadCache();
+    }
   }
 
   ~WaterBoundaryChecker()
   {
     LOG_SHORT(LINFO, ("Features checked:", m_totalFeatures, "borders checked:", m_totalBorders,
-                "borders skipped:", m_skippedBorders, "selected polygons:", m_selectedPolygons));
+                "borders skipped:", m_skippedBorders, "selected polygons:", m_selectedPolygons,
+                "borders from cache:", m_cachedBorders));
+    if (!m_cachePath.empty())
+      SaveCache();
   }
 
   void LoadWaterGeometry(std::string const & rawGeometryFileName)
@@ -110,6 +145,33 @@ public:
   {
     auto const & line = boundary.GetGeometry().front();
 
+    coding::SHA1::Hash key = {};
+    if (!m_cachePath.empty())
+    {
+      coding::SHA1 sha1;
+      sha1.Update(line.data(), line.size() * sizeof(m2::PointD));
+      key = sha1.Final();
+
+      auto const it = m_cache.find(key);
+      if (it != m_cache.end())
+      {
+        ++m_cachedBorders;
+        it->second.m_used = true;
+        for (auto const & points : it->second.m_parts)
+          AddPart(boundary, points, parts);
+        if (parts.empty())
+          m_skippedBorders++;
+        return;
+      }
+    }
+
+    // The water geometry isn't needed if all the boundaries are taken from the cache.
+    if (!m_waterLoaded)
+    {
+      LoadWaterGeometry(m_rawGeometryFileName);
+      m_waterLoaded = true;
+    }
+
     double constexpr kExtension = 0.01;
     ProcessState state = ProcessState::Initial;
 
@@ -161,12 +223,7 @@ public:
         if (inWater)
         {
           if (points.size() > 1)
-          {
-            parts.push_back(boundary);
-            parts.back().ResetGeometry();
-            for (auto const & pt : points)
-              parts.back().AddPoint(pt);
-          }
+            AddPart(boundary, points, parts);
           points.clear();
           state = ProcessState::Water;
         }
@@ -180,15 +237,100 @@ public:
     }
 
     if (points.size() > 1)
-    {
-      parts.push_back(boundary);
-      parts.back().ResetGeometry();
-      for (auto const & pt : points)
-        parts.back().AddPoint(pt);
-    }
+      AddPart(boundary, points, parts);
 
     if (parts.empty())
       m_skippedBorders++;
+
+    if (!m_cachePath.empty())
+    {
+      auto & cached = m_cache[key];
+      cached.m_used = true;
+      for (auto const & part : parts)
+        cached.m_parts.push_back(part.GetGeometry().front());
+    }
+  }
+
+private:
+  static uint32_t GetCacheVersion() { return 0; }
+
+  static void AddPart(FeatureBuilder1 const & boundary, FeatureBuilder1::PointSeq const & points,
+                      std::vector<FeatureBuilder1> & parts)
+  {
+    parts.push_back(boundary);
+    parts.back().ResetGeometry();
+    for (auto const & pt : points)
+      parts.back().AddPoint(pt);
+  }
+
+  void LoadCache()
+  {
+    if (!Platform::IsFileExistsByFullPath(m_cachePath))
+      return;
+
+    try
+    {
+      FileReader reader(m_cachePath);
+      ReaderSource<FileReader> src(reader);
+      auto const version = ReadPrimitiveFromSource<uint32_t>(src);
+      std::string waterHash;
+      rw::Read(src, waterHash);
+      if (version != GetCacheVersion() || waterHash != m_waterHash)
+      {
+        LOG_SHORT(LINFO, ("Cache of world boundaries is outdated:", m_cachePath));
+        return;
+      }
+
+      for (auto count = ReadVarUint<uint64_t>(src); count > 0; --count)
+      {
+        coding::SHA1::Hash key;
+        src.Read(key.data(), key.size());
+        auto & cached = m_cache[key];
+        cached.m_parts.resize(ReadVarUint<uint64_t>(src));
+        for (auto & points : cached.m_parts)
+        {
+          points.resize(ReadVarUint<uint64_t>(src));
+          src.Read(points.data(), points.size() * sizeof(m2::PointD));
+        }
+      }
+      LOG_SHORT(LINFO, ("Loaded", m_cache.size(), "cached world boundaries from", m_cachePath));
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG_SHORT(LWARNING, ("Can't read cache of world boundaries", m_cachePath, e.Msg()));
+      m_cache.clear();
+    }
+  }
+
+  // Only the boundaries of the current run are saved, so the cache doesn't grow with
+  // removed and changed boundaries.
+  void SaveCache() const
+  {
+    try
+    {
+      FileWriter writer(m_cachePath);
+      WriteToSink(writer, GetCacheVersion());
+      rw::Write(writer, m_waterHash);
+      uint64_t const count = std::count_if(m_cache.cbegin(), m_cache.cend(),
+                                           [](auto const & kv) { return kv.second.m_used; });
+      WriteVarUint(writer, count);
+      for (auto const & kv : m_cache)
+      {
+        if (!kv.second.m_used)
+          continue;
+        writer.Write(kv.first.data(), kv.first.size());
+        WriteVarUint(writer, static_cast<uint64_t>(kv.second.m_parts.size()));
+        for (auto const & points : kv.second.m_parts)
+        {
+          WriteVarUint(writer, static_cast<uint64_t>(points.size()));
+          writer.Write(points.data(), points.size() * sizeof(m2::PointD));
+        }
+      }
+    }
+    catch (Writer::Exception const & e)
+    {
+      LOG_SHORT(LWARNING, ("Can't save cache of world boundaries", m_cachePath, e.Msg()));
+    }
   }
 };
 } // namespace
@@ -132,7 +132,7 @@ vector<Geocoder::Layer> & Geocoder::Context::GetLayers() { return m_layers; }
 vector<Geocoder::Layer> const & Geocoder::Context::GetLayers() const { return m_layers; }
 
 // Geocoder ----------------------------------------------------------------------------------------
-Geocoder::Geocoder(string pathToJsonHierarchy) : m_hierarchy(pathToJsonHierarchy) {}
+Geocoder::Geocoder(string pathToHierarchy) : m_hierarchy(pathToHierarchy) {}
 
 void Geocoder::ProcessQuery(string const & query, vector<Result> & results) const
 {
@@ -30,6 +30,9 @@ namespace geocoder
 //
 // Note that search index, locality index, scale index, and, generally, mwm
 // features are currently not used at all.
+//
+// *NOTE* The hierarchy is not changed after construction and all the query state is kept in
+// Context, so ProcessQuery() may be called from several threads at once.
 class Geocoder
 {
 public:
@@ -84,7 +87,8 @@ public:
     std::vector<Layer> m_layers;
   };
 
-  explicit Geocoder(std::string pathToJsonHierarchy);
+  // See Hierarchy::Hierarchy() for the supported formats of the hierarchy file.
+  explicit Geocoder(std::string pathToHierarchy);
 
   void ProcessQuery(std::string const & query, std::vector<Result> & results) const;
 
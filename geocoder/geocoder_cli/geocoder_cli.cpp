@@ -1,11 +1,16 @@
 #include "geocoder/geocoder.hpp"
 #include "geocoder/result.hpp"
 
+#include "coding/file_writer.hpp"
+
 #include "base/string_utils.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "3party/gflags/src/gflags/gflags.h"
@@ -16,6 +21,9 @@ using namespace std;
 DEFINE_string(hierarchy_path, "", "Path to the hierarchy file for the geocoder");
 DEFINE_string(queries_path, "", "Path to the file with queries");
 DEFINE_int32(top, 5, "Number of top results to show for every query, -1 to show all results");
+DEFINE_string(save_binary_path, "",
+              "Path to save the hierarchy in the binary format, which is much faster to load");
+DEFINE_int32(threads, 1, "Number of threads to process queries from --queries_path");
 
 void PrintResults(vector<Result> const & results)
 {
@@ -31,32 +39,47 @@ void PrintResults(vector<Result> const & results)
   }
 }
 
-void ProcessQueriesFromFile(string const & path)
+void ProcessQueriesFromFile(Geocoder const & geocoder, string const & path)
 {
   ifstream stream(path.c_str());
   CHECK(stream.is_open(), ("Can't open", path));
 
-  Geocoder geocoder(FLAGS_hierarchy_path);
-
-  vector<Result> results;
+  vector<string> queries;
   string s;
   while (getline(stream, s))
   {
     strings::Trim(s);
-    if (s.empty())
-      continue;
+    if (!s.empty())
+      queries.push_back(s);
+  }
 
-    cout << s << endl;
-    geocoder.ProcessQuery(s, results);
-    PrintResults(results);
+  // Queries are processed in parallel but printed in the order of the file.
+  vector<vector<Result>> results(queries.size());
+  atomic<size_t> nextQuery(0);
+  auto const processQueries = [&]() {
+    for (size_t i = nextQuery++; i < queries.size(); i = nextQuery++)
+      geocoder.ProcessQuery(queries[i], results[i]);
+  };
+
+  size_t const numThreads =
+      min(static_cast<size_t>(max(FLAGS_threads, 1)), max(queries.size(), static_cast<size_t>(1)));
+  vector<thread> threads;
+  for (size_t i = 1; i < numThreads; ++i)
+    threads.emplace_back(processQueries);
+  processQueries();
+  for (auto & t : threads)
+    t.join();
+
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    cout << queries[i] << endl;
+    PrintResults(results[i]);
     cout << endl;
   }
 }
 
-void ProcessQueriesFromCommandLine()
+void ProcessQueriesFromCommandLine(Geocoder const & geocoder)
 {
-  Geocoder geocoder(FLAGS_hierarchy_path);
-
   string query;
   vector<Result> results;
   while (true)
@@ -78,12 +101,21 @@ int main(int argc, char * argv[])
   google::SetUsageMessage("Geocoder command line interface.");
   google::ParseCommandLineFlags(&argc, &argv, true);
 
+  Geocoder geocoder(FLAGS_hierarchy_path);
+
+  if (!FLAGS_save_binary_path.empty())
+  {
+    FileWriter writer(FLAGS_save_binary_path);
+    geocoder.GetHierarchy().Serialize(writer);
+    return 0;
+  }
+
   if (!FLAGS_queries_path.empty())
   {
-    ProcessQueriesFromFile(FLAGS_queries_path);
+    ProcessQueriesFromFile(geocoder, FLAGS_queries_path);
     return 0;
   }
 
-  ProcessQueriesFromCommandLine();
+  ProcessQueriesFromCommandLine(geocoder);
   return 0;
 }
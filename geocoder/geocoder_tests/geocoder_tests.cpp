@@ -6,6 +6,8 @@
 
 #include "platform/platform_tests_support/scoped_file.hpp"
 
+#include "coding/file_writer.hpp"
+
 #include "base/geo_object_id.hpp"
 #include "base/math.hpp"
 #include "base/stl_helpers.hpp"
@@ -79,4 +81,29 @@ UNIT_TEST(Geocoder_Hierarchy)
              ());
   TEST_EQUAL((*entries)[0].m_address[static_cast<size_t>(Type::Subregion)], Split("florencia"), ());
 }
+
+UNIT_TEST(Geocoder_BinaryHierarchy)
+{
+  ScopedFile const regionsJsonFile("regions.jsonl", kRegionsData);
+  ScopedFile const regionsBinaryFile("regions.bin", ScopedFile::Mode::DoNotCreate);
+  {
+    Hierarchy const hierarchy(regionsJsonFile.GetFullPath());
+    FileWriter writer(regionsBinaryFile.GetFullPath());
+    hierarchy.Serialize(writer);
+  }
+
+  Geocoder geocoder(regionsBinaryFile.GetFullPath());
+
+  auto entries = geocoder.GetHierarchy().GetEntries(Split("ciego de avila"));
+  TEST(entries, ());
+  TEST_EQUAL(entries->size(), 1, ());
+  TEST_EQUAL((*entries)[0].m_name, "Ciego de Ávila", ());
+  TEST_EQUAL((*entries)[0].m_type, Type::Region, ());
+  TEST_EQUAL((*entries)[0].m_nameTokens, Split("ciego de avila"), ());
+  TEST_EQUAL((*entries)[0].m_address[static_cast<size_t>(Type::Country)], Split("cuba"), ());
+
+  base::GeoObjectId const florenciaId(0xc00000000059d6b5);
+  base::GeoObjectId const cubaId(0xc00000000004b279);
+  TestGeocoder(geocoder, "cuba florencia", {{florenciaId, 1.0}, {cubaId, 0.5}});
+}
 }  // namespace geocoder
@@ -2,15 +2,61 @@
 
 #include "indexer/search_string_utils.hpp"
 
+#include "coding/mmap_reader.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
 #include "base/assert.hpp"
 #include "base/exception.hpp"
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 
+#include <cstring>
 #include <fstream>
 
 using namespace std;
 
+namespace
+{
+string const kBinaryHeader = "geocoder hierarchy v1";
+
+template <typename Sink>
+void WriteTokens(Sink & sink, geocoder::Tokens const & tokens,
+                 map<strings::UniString, uint32_t> const & tokenIds)
+{
+  WriteVarUint(sink, static_cast<uint32_t>(tokens.size()));
+  for (auto const & token : tokens)
+  {
+    auto const it = tokenIds.find(token);
+    CHECK(it != tokenIds.end(), ());
+    WriteVarUint(sink, it->second);
+  }
+}
+
+template <typename Source>
+void ReadTokens(Source & src, vector<strings::UniString> const & tokens, geocoder::Tokens & result)
+{
+  auto const size = ReadVarUint<uint32_t>(src);
+  result.resize(size);
+  for (auto & token : result)
+  {
+    auto const id = ReadVarUint<uint32_t>(src);
+    CHECK_LESS(id, tokens.size(), ());
+    token = tokens[id];
+  }
+}
+
+bool IsBinaryHierarchy(string const & path)
+{
+  ifstream ifs(path, ios::binary);
+  string header(kBinaryHeader.size(), '\0');
+  if (!ifs.read(&header[0], header.size()))
+    return false;
+  return header == kBinaryHeader;
+}
+}  // namespace
+
 namespace geocoder
 {
 // Hierarchy::Entry --------------------------------------------------------------------------------
@@ -86,7 +132,96 @@ void Hierarchy::Entry::DeserializeFromJSONImpl(json_t * const root, string const
 }
 
 // Hierarchy ---------------------------------------------------------------------------------------
-Hierarchy::Hierarchy(string const & pathToJsonHierarchy)
+Hierarchy::Hierarchy(string const & pathToHierarchy)
+{
+  if (IsBinaryHierarchy(pathToHierarchy))
+    LoadFromBinary(pathToHierarchy);
+  else
+    LoadFromJson(pathToHierarchy);
+}
+
+void Hierarchy::Serialize(Writer & writer) const
+{
+  map<strings::UniString, uint32_t> tokenIds;
+  vector<strings::UniString const *> tokens;
+  auto const intern = [&](Tokens const & ts) {
+    for (auto const & token : ts)
+    {
+      if (tokenIds.emplace(token, static_cast<uint32_t>(tokens.size())).second)
+        tokens.push_back(&token);
+    }
+  };
+
+  uint64_t numEntries = 0;
+  for (auto const & entries : m_entries)
+  {
+    for (auto const & entry : entries.second)
+    {
+      intern(entry.m_nameTokens);
+      for (auto const & address : entry.m_address)
+        intern(address);
+      ++numEntries;
+    }
+  }
+
+  writer.Write(kBinaryHeader.data(), kBinaryHeader.size());
+
+  WriteVarUint(writer, static_cast<uint32_t>(tokens.size()));
+  for (auto const * token : tokens)
+    rw::Write(writer, strings::ToUtf8(*token));
+
+  WriteVarUint(writer, numEntries);
+  for (auto const & entries : m_entries)
+  {
+    for (auto const & entry : entries.second)
+    {
+      WriteToSink(writer, entry.m_osmId.GetEncodedId());
+      rw::Write(writer, entry.m_name);
+      WriteToSink(writer, static_cast<uint8_t>(entry.m_type));
+      WriteTokens(writer, entry.m_nameTokens, tokenIds);
+      for (auto const & address : entry.m_address)
+        WriteTokens(writer, address, tokenIds);
+    }
+  }
+}
+
+void Hierarchy::LoadFromBinary(string const & pathToBinaryHierarchy)
+{
+  MmapReader reader(pathToBinaryHierarchy);
+  reader.Advise(ModelReader::Advice::Sequential);
+  ReaderSource<MmapReader> src(reader);
+  src.Skip(kBinaryHeader.size());
+
+  vector<strings::UniString> tokens(ReadVarUint<uint32_t>(src));
+  string buffer;
+  for (auto & token : tokens)
+  {
+    rw::Read(src, buffer);
+    token = strings::MakeUniString(buffer);
+  }
+
+  auto const numEntries = ReadVarUint<uint64_t>(src);
+  for (uint64_t i = 0; i < numEntries; ++i)
+  {
+    Entry entry;
+    entry.m_osmId = base::GeoObjectId(ReadPrimitiveFromSource<uint64_t>(src));
+    rw::Read(src, entry.m_name);
+    auto const type = ReadPrimitiveFromSource<uint8_t>(src);
+    CHECK_LESS(type, static_cast<uint8_t>(Type::Count), ("Wrong entry type in", pathToBinaryHierarchy));
+    entry.m_type = static_cast<Type>(type);
+    ReadTokens(src, tokens, entry.m_nameTokens);
+    for (auto & address : entry.m_address)
+      ReadTokens(src, tokens, address);
+
+    size_t const t = static_cast<size_t>(entry.m_type);
+    auto & entries = m_entries[entry.m_address[t]];
+    entries.emplace_back(move(entry));
+  }
+
+  LOG(LINFO, ("Finished reading the binary hierarchy. Entries:", numEntries, "tokens:", tokens.size()));
+}
+
+void Hierarchy::LoadFromJson(string const & pathToJsonHierarchy)
 {
   ifstream ifs(pathToJsonHierarchy);
   string line;
@@ -2,6 +2,9 @@
 
 #include "geocoder/types.hpp"
 
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
 #include "base/geo_object_id.hpp"
 #include "base/string_utils.hpp"
 
@@ -70,7 +73,14 @@ public:
     std::array<Tokens, static_cast<size_t>(Type::Count) + 1> m_address;
   };
 
-  explicit Hierarchy(std::string const & pathToJsonHierarchy);
+  // Reads the hierarchy either from a file with an osm id and a json entry per line or from
+  // a file written by Serialize(). The format is detected by the beginning of the file.
+  explicit Hierarchy(std::string const & pathToHierarchy);
+
+  // Writes the hierarchy in the binary format: a table of interned tokens followed by entries
+  // which refer to the tokens by their positions in the table. The binary hierarchy is read
+  // without any json parsing and normalization of strings.
+  void Serialize(Writer & writer) const;
 
   // Returns a pointer to entries whose names exactly match |tokens|
   // (the order matters) or nullptr if there are no such entries.
@@ -81,6 +91,9 @@ public:
   std::vector<Entry> const * const GetEntries(std::vector<strings::UniString> const & tokens) const;
 
 private:
+  void LoadFromJson(std::string const & pathToJsonHierarchy);
+  void LoadFromBinary(std::string const & pathToBinaryHierarchy);
+
   std::map<Tokens, std::vector<Entry>> m_entries;
 };
 }  // namespace geocoder
@@ -47,6 +47,47 @@ double DistanceOnEarth(LatLon const & ll1, LatLon const & ll2)
   return DistanceOnEarth(ll1.lat, ll1.lon, ll2.lat, ll2.lon);
 }
 
+void DistancesOnEarth(vector<LatLon> const & points, vector<double> & distances)
+{
+  distances.clear();
+  if (points.size() < 2)
+    return;
+
+  // Plain loops over contiguous arrays without branches, so compilers can vectorize them.
+  size_t const count = points.size();
+  vector<double> lats(count);
+  vector<double> lons(count);
+  vector<double> cosLats(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    lats[i] = base::DegToRad(points[i].lat);
+    lons[i] = base::DegToRad(points[i].lon);
+  }
+  for (size_t i = 0; i < count; ++i)
+    cosLats[i] = cos(lats[i]);
+
+  distances.resize(count - 1);
+  for (size_t i = 1; i < count; ++i)
+  {
+    // The same operations as in DistanceOnSphere() to get the same results.
+    double const dlat = sin((lats[i] - lats[i - 1]) * 0.5);
+    double const dlon = sin((lons[i] - lons[i - 1]) * 0.5);
+    double const y = dlat * dlat + dlon * dlon * cosLats[i - 1] * cosLats[i];
+    distances[i - 1] = kEarthRadiusMeters * (2.0 * atan2(sqrt(y), sqrt(max(0.0, 1.0 - y))));
+  }
+}
+
+double LengthOnEarth(vector<LatLon> const & points)
+{
+  vector<double> distances;
+  DistancesOnEarth(points, distances);
+
+  double length = 0.0;
+  for (double const d : distances)
+    length += d;
+  return length;
+}
+
 double AreaOnEarth(LatLon const & ll1, LatLon const & ll2, LatLon const & ll3)
 {
   return kOneDegreeEquatorLengthMeters * kOneDegreeEquatorLengthMeters *
@@ -4,6 +4,8 @@
 
 #include "base/base.hpp"
 
+#include <vector>
+
 // namespace ms - "math on sphere", similar to namespace m2.
 namespace ms
 {
@@ -20,5 +22,13 @@ double DistanceOnEarth(double lat1Deg, double lon1Deg, double lat2Deg, double lo
 
 double DistanceOnEarth(LatLon const & ll1, LatLon const & ll2);
 
+// Distances in meters on Earth between consecutive |points|, |distances| gets
+// points.size() - 1 values. Every distance is calculated by the formula of DistanceOnEarth(),
+// but radians and the cosine of latitude are calculated once per point instead of twice.
+void DistancesOnEarth(std::vector<LatLon> const & points, std::vector<double> & distances);
+
+// Length in meters of the polyline |points|, i.e. the sum of DistancesOnEarth().
+double LengthOnEarth(std::vector<LatLon> const & points);
+
 double AreaOnEarth(LatLon const & ll1, LatLon const & ll2, LatLon const & ll3);
 }  // namespace ms
@@ -5,6 +5,12 @@
 #include "base/math.hpp"
 #include "base/macros.hpp"
 #include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace std;
 
 
 UNIT_TEST(Mercator_Grid)
@@ -81,3 +87,57 @@ UNIT_TEST(Mercator_Sample1)
   LOG(LINFO, (MercatorBounds::XToLon(27.531491200000001385),
               MercatorBounds::YToLat(64.392864299248202542)));
 }
+
+UNIT_TEST(Mercator_Batch)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> step(-1e-3, 1e-3);
+  size_t const kPointsCount = 1000000;
+
+  // A random walk like a long GPS track.
+  vector<ms::LatLon> lls;
+  ms::LatLon ll(55.75, 37.61);
+  for (size_t i = 0; i < kPointsCount; ++i)
+  {
+    lls.push_back(ll);
+    ll.lat += step(rng);
+    ll.lon += step(rng);
+  }
+
+  vector<m2::PointD> points;
+  MercatorBounds::FromLatLon(lls, points);
+  vector<ms::LatLon> lls2;
+  MercatorBounds::ToLatLon(points, lls2);
+  TEST_EQUAL(points.size(), kPointsCount, ());
+  TEST_EQUAL(lls2.size(), kPointsCount, ());
+  for (size_t i = 0; i < kPointsCount; i += 1000)
+  {
+    TEST_EQUAL(points[i], MercatorBounds::FromLatLon(lls[i]), (i));
+    TEST_EQUAL(lls2[i], MercatorBounds::ToLatLon(points[i]), (i));
+  }
+
+  base::Timer timer;
+  double scalarLength = 0.0;
+  for (size_t i = 1; i < points.size(); ++i)
+    scalarLength += MercatorBounds::DistanceOnEarth(points[i - 1], points[i]);
+  double const scalarTime = timer.ElapsedSeconds();
+
+  timer.Reset();
+  double const batchLength = MercatorBounds::LengthOnEarth(points);
+  double const batchTime = timer.ElapsedSeconds();
+
+  TEST(base::AlmostEqualRel(scalarLength, batchLength, 1e-12), (scalarLength, batchLength));
+  LOG(LINFO, ("Length of", kPointsCount, "mercator points: scalar", scalarTime, "s, batched",
+              batchTime, "s"));
+
+  vector<double> distances;
+  MercatorBounds::DistancesOnEarth(points, distances);
+  TEST_EQUAL(distances.size(), kPointsCount - 1, ());
+  TEST(base::AlmostEqualAbs(distances[0], MercatorBounds::DistanceOnEarth(points[0], points[1]),
+                            1e-9),
+       ());
+
+  MercatorBounds::DistancesOnEarth({points[0]}, distances);
+  TEST(distances.empty(), ());
+  TEST_EQUAL(MercatorBounds::LengthOnEarth({}), 0.0, ());
+}
@@ -0,0 +1,101 @@
+#include "testing/testing.hpp"
+
+#include "geometry/packed_tree4d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+using R = m2::RectD;
+
+struct Traits
+{
+  m2::RectD LimitRect(m2::RectD const & r) const { return r; }
+};
+
+using PackedTree = m4::PackedTree<R, Traits>;
+
+template <typename Tree>
+vector<R> GetRectsInRect(Tree const & tree, R const & rect)
+{
+  vector<R> result;
+  tree.ForEachInRect(rect, [&result](R const & r) { result.push_back(r); });
+  sort(result.begin(), result.end(), [](R const & lhs, R const & rhs) {
+    return lhs.LeftBottom() < rhs.LeftBottom() ||
+           (lhs.LeftBottom() == rhs.LeftBottom() && lhs.RightTop() < rhs.RightTop());
+  });
+  return result;
+}
+}  // namespace
+
+UNIT_TEST(PackedTree4D_Smoke)
+{
+  PackedTree tree;
+  tree.Build();
+  TEST(tree.IsEmpty(), ());
+  TEST(GetRectsInRect(tree, R(0, 0, 10, 10)).empty(), ());
+
+  R const arr[] = {R(0, 0, 1, 1), R(1, 1, 2, 2), R(2, 2, 3, 3)};
+  for (auto const & r : arr)
+    tree.Add(r);
+  tree.Build();
+  TEST_EQUAL(tree.GetSize(), 3, ());
+
+  auto test = GetRectsInRect(tree, R(1.5, 1.5, 1.5, 1.5));
+  TEST_EQUAL(test, vector<R>({arr[1]}), ());
+
+  // Touching rects don't intersect.
+  test = GetRectsInRect(tree, R(3, 3, 4, 4));
+  TEST(test.empty(), ());
+
+  test = GetRectsInRect(tree, R(0.5, 0.5, 2.5, 2.5));
+  TEST_EQUAL(test.size(), 3, ());
+
+  tree.Add(R(5, 5, 6, 6));
+  tree.Build();
+  test = GetRectsInRect(tree, R(4, 4, 10, 10));
+  TEST_EQUAL(test, vector<R>({R(5, 5, 6, 6)}), ());
+
+  tree.Clear();
+  tree.Build();
+  TEST(tree.IsEmpty(), ());
+  TEST(GetRectsInRect(tree, R(0, 0, 10, 10)).empty(), ());
+}
+
+UNIT_TEST(PackedTree4D_SameAsTree)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(-100.0, 100.0);
+  uniform_real_distribution<double> size(0.0, 5.0);
+
+  m4::Tree<R, Traits> tree;
+  PackedTree packedTree;
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    double const x = coord(rng);
+    double const y = coord(rng);
+    R const r(x, y, x + size(rng), y + size(rng));
+    tree.Add(r);
+    packedTree.Add(r);
+  }
+  packedTree.Build();
+  TEST_EQUAL(packedTree.GetSize(), tree.GetSize(), ());
+
+  for (size_t i = 0; i < 200; ++i)
+  {
+    double const x = coord(rng);
+    double const y = coord(rng);
+    double const side = size(rng) * 4;
+    R const rect(x, y, x + side, y + side);
+    TEST_EQUAL(GetRectsInRect(packedTree, rect), GetRectsInRect(tree, rect), (rect));
+  }
+
+  R const all(-200, -200, 200, 200);
+  TEST_EQUAL(GetRectsInRect(packedTree, all).size(), packedTree.GetSize(), ());
+}
@@ -0,0 +1,88 @@
+#include "testing/testing.hpp"
+
+#include "geometry/prepared_region2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include "base/math.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+// Star-shaped polygon with |count| vertices around (0, 0).
+m2::RegionD MakeStar(size_t count, mt19937 & rng)
+{
+  uniform_real_distribution<double> radius(50.0, 100.0);
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double const angle = 2 * math::pi * i / count;
+    double const r = radius(rng);
+    points.emplace_back(r * cos(angle), r * sin(angle));
+  }
+  return m2::RegionD(move(points));
+}
+}  // namespace
+
+UNIT_TEST(PreparedRegion_SameAsRegion)
+{
+  mt19937 rng(0);
+  m2::RegionD const region = MakeStar(1000, rng);
+  m2::PreparedRegionD const prepared(region);
+
+  uniform_real_distribution<double> coord(-110.0, 110.0);
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < 10000; ++i)
+    points.emplace_back(coord(rng), coord(rng));
+  // Vertices and middles of edges are on the border.
+  for (size_t i = 0; i < region.Size(); i += 10)
+  {
+    points.push_back(region.Data()[i]);
+    points.push_back((region.Data()[i] + region.Data()[(i + 1) % region.Size()]) / 2);
+  }
+
+  vector<bool> const batch = prepared.Contains(points);
+  TEST_EQUAL(batch.size(), points.size(), ());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    auto const & pt = points[i];
+    bool const contains = region.Contains(pt);
+    TEST_EQUAL(prepared.Contains(pt), contains, (pt));
+    TEST_EQUAL(batch[i], contains, (pt));
+    TEST_EQUAL(prepared.AtBorder(pt, 1.0), region.AtBorder(pt, 1.0), (pt));
+  }
+}
+
+UNIT_TEST(PreparedRegion_Int)
+{
+  vector<m2::PointI> const points = {{0, 0}, {10, 0}, {10, 10}, {5, 5}, {0, 10}};
+  m2::RegionI const region(points);
+  m2::PreparedRegionI const prepared(region);
+
+  for (int x = -1; x <= 11; ++x)
+  {
+    for (int y = -1; y <= 11; ++y)
+    {
+      m2::PointI const pt(x, y);
+      TEST_EQUAL(prepared.Contains(pt), region.Contains(pt), (pt));
+      TEST_EQUAL(prepared.AtBorder(pt, 0.5), region.AtBorder(pt, 0.5), (pt));
+    }
+  }
+
+  TEST(prepared.Contains(m2::PointI(5, 2)), ());
+  TEST(!prepared.Contains(m2::PointI(5, 8)), ());
+}
+
+UNIT_TEST(PreparedRegion_Flat)
+{
+  // All points of a degenerate region are in one slab.
+  m2::RegionD const region(vector<m2::PointD>{{0, 0}, {1, 0}, {2, 0}});
+  m2::PreparedRegionD const prepared(region);
+  TEST(prepared.Contains(m2::PointD(1, 0)), ());
+  TEST(!prepared.Contains(m2::PointD(3, 0)), ());
+  TEST(prepared.AtBorder(m2::PointD(0.5, 0), 0.1), ());
+}
@@ -82,6 +82,20 @@ void SimplifyNearOptimal20(m2::PointD const * f, m2::PointD const * l, double e,
   SimplifyNearOptimal(20, f, l, e, distFn, out);
 }
 
+// Recursive Douglas-Peucker to compare with.
+void SimplifyDPRecursive(P const * first, P const * last, double eps, DistanceFn & distFn,
+                         vector<P> & out)
+{
+  auto const maxDist = impl::MaxDistance(first, last, distFn);
+  if (maxDist.second == last || maxDist.first < eps)
+  {
+    out.push_back(*last);
+    return;
+  }
+  SimplifyDPRecursive(first, maxDist.second, eps, distFn, out);
+  SimplifyDPRecursive(maxDist.second, last, eps, distFn, out);
+}
+
 void CheckDPStrict(P const * arr, size_t n, double eps, size_t expectedCount)
 {
   vector<P> vec;
@@ -120,6 +134,41 @@ UNIT_TEST(Simplification_DP_Polyline)
                            &SimplifyDP<DistanceFn>);
 }
 
+UNIT_TEST(Simplification_DP_SameAsRecursive)
+{
+  P const * points = LargePolylineTestData::m_Data;
+  size_t const count = LargePolylineTestData::m_Size;
+  DistanceFn distFn;
+  for (double epsilon = 0.00001; epsilon < 0.11; epsilon *= 10)
+  {
+    vector<P> expected = {points[0]};
+    SimplifyDPRecursive(points, points + count - 1, epsilon, distFn, expected);
+
+    vector<P> result;
+    SimplifyDP(points, points + count, epsilon, distFn, base::MakeBackInsertFunctor(result));
+    TEST_EQUAL(result, expected, (epsilon));
+  }
+}
+
+UNIT_TEST(Simplification_DP_Parabola)
+{
+  vector<P> points;
+  for (size_t i = 0; i < 20000; ++i)
+    points.emplace_back(i * 1e-3, i * i * 1e-6);
+
+  for (double epsilon : {1e-12, 1e-9, 1e-6})
+  {
+    DistanceFn distFn;
+    vector<P> expected = {points.front()};
+    SimplifyDPRecursive(points.data(), points.data() + points.size() - 1, epsilon, distFn,
+                        expected);
+
+    vector<P> result;
+    SimplifyDP(points.begin(), points.end(), epsilon, distFn, base::MakeBackInsertFunctor(result));
+    TEST_EQUAL(result, expected, (epsilon));
+  }
+}
+
 UNIT_TEST(Simplification_Opt_Smoke) { TestSimplificationSmoke(&SimplifyNearOptimal10); }
 
 UNIT_TEST(Simplification_Opt_Line) { TestSimplificationOfLine(&SimplifyNearOptimal10); }
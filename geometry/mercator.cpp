@@ -50,6 +50,34 @@ double MercatorBounds::DistanceOnEarth(m2::PointD const & p1, m2::PointD const &
   return ms::DistanceOnEarth(ToLatLon(p1), ToLatLon(p2));
 }
 
+void MercatorBounds::FromLatLon(vector<ms::LatLon> const & lls, vector<m2::PointD> & points)
+{
+  points.resize(lls.size());
+  for (size_t i = 0; i < lls.size(); ++i)
+    points[i] = FromLatLon(lls[i]);
+}
+
+void MercatorBounds::ToLatLon(vector<m2::PointD> const & points, vector<ms::LatLon> & lls)
+{
+  lls.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    lls[i] = ToLatLon(points[i]);
+}
+
+void MercatorBounds::DistancesOnEarth(vector<m2::PointD> const & points, vector<double> & distances)
+{
+  vector<ms::LatLon> lls;
+  ToLatLon(points, lls);
+  ms::DistancesOnEarth(lls, distances);
+}
+
+double MercatorBounds::LengthOnEarth(vector<m2::PointD> const & points)
+{
+  vector<ms::LatLon> lls;
+  ToLatLon(points, lls);
+  return ms::LengthOnEarth(lls);
+}
+
 double MercatorBounds::AreaOnEarth(m2::PointD const & p1, m2::PointD const & p2,
                                    m2::PointD const & p3)
 {
@@ -6,6 +6,8 @@
 
 #include "base/math.hpp"
 
+#include <vector>
+
 struct MercatorBounds
 {
   static double minX;
@@ -101,9 +103,23 @@ struct MercatorBounds
                      YToLat(mercatorRect.maxY()), XToLon(mercatorRect.maxX()));
   }
 
+  /// Batch versions of FromLatLon() and ToLatLon() for bulk paths.
+  //@{
+  static void FromLatLon(std::vector<ms::LatLon> const & lls, std::vector<m2::PointD> & points);
+  static void ToLatLon(std::vector<m2::PointD> const & points, std::vector<ms::LatLon> & lls);
+  //@}
+
   /// Calculates distance on Earth in meters between two mercator points.
   static double DistanceOnEarth(m2::PointD const & p1, m2::PointD const & p2);
 
+  /// Calculates distances on Earth in meters between consecutive mercator points. Every point
+  /// is converted to lat lon once, see ms::DistancesOnEarth().
+  static void DistancesOnEarth(std::vector<m2::PointD> const & points,
+                               std::vector<double> & distances);
+
+  /// Calculates length on Earth in meters of a mercator polyline.
+  static double LengthOnEarth(std::vector<m2::PointD> const & points);
+
   /// Calculates area of a triangle on Earth in m² by three mercator points.
   static double AreaOnEarth(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3);
 };
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace m4
+{
+// Static R-tree packed by the Hilbert order of the rect centers (the Hilbert R-tree bulk load).
+//
+// Values are added with Add() and then Build() sorts them and builds all levels at once,
+// which is much faster than inserting into Tree one by one. The tree is read-only after
+// Build(): adding more values requires one more Build().
+//
+// Bounding boxes of all levels are stored contiguously in four coordinate arrays: values
+// first, then the nodes of each level from the bottom up to the root. So children of a node
+// lie next to each other and are tested against the query rect in a single branchless loop
+// which compilers vectorize.
+//
+// Rects intersect the same way as in Tree: touching rects don't intersect.
+template <typename T, typename Traits = TraitsDef<T>>
+class PackedTree
+{
+public:
+  static size_t constexpr kNodeSize = 16;
+
+  PackedTree(Traits const & traits = Traits()) : m_traits(traits) {}
+
+  template <typename U>
+  void Add(U && obj)
+  {
+    Add(std::forward<U>(obj), m_traits.LimitRect(obj));
+  }
+
+  template <typename U>
+  void Add(U && obj, m2::RectD const & rect)
+  {
+    if (m_isBuilt)
+      DropNodes();
+
+    m_values.emplace_back(std::forward<U>(obj));
+    AddBox(rect.minX(), rect.minY(), rect.maxX(), rect.maxY());
+  }
+
+  void Build()
+  {
+    if (m_isBuilt)
+      return;
+
+    m_isBuilt = true;
+    size_t const count = m_values.size();
+    if (count == 0)
+      return;
+
+    SortValues();
+
+    size_t levelBegin = 0;
+    size_t levelEnd = count;
+    do
+    {
+      for (size_t first = levelBegin; first < levelEnd; first += kNodeSize)
+      {
+        size_t const last = std::min(first + kNodeSize, levelEnd);
+        m_children.emplace_back(static_cast<uint32_t>(first), static_cast<uint32_t>(last));
+
+        double minX = m_minX[first];
+        double minY = m_minY[first];
+        double maxX = m_maxX[first];
+        double maxY = m_maxY[first];
+        for (size_t i = first + 1; i < last; ++i)
+        {
+          minX = std::min(minX, m_minX[i]);
+          minY = std::min(minY, m_minY[i]);
+          maxX = std::max(maxX, m_maxX[i]);
+          maxY = std::max(maxY, m_maxY[i]);
+        }
+        AddBox(minX, minY, maxX, maxY);
+      }
+      levelBegin = levelEnd;
+      levelEnd = m_minX.size();
+    } while (levelEnd - levelBegin > 1);
+  }
+
+  template <typename ToDo>
+  void ForEach(ToDo && toDo) const
+  {
+    for (T const & v : m_values)
+      toDo(v);
+  }
+
+  template <typename ToDo>
+  void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    ForEachInRectEx(rect, [&toDo](m2::RectD const &, T const & v) { toDo(v); });
+  }
+
+  template <typename ToDo>
+  void ForEachInRectEx(m2::RectD const & rect, ToDo && toDo) const
+  {
+    ASSERT(m_isBuilt, ("Build() must be called before queries."));
+    if (m_values.empty())
+      return;
+
+    uint32_t const root = static_cast<uint32_t>(m_minX.size() - 1);
+    if (!IsIntersect(root, rect))
+      return;
+
+    size_t const count = m_values.size();
+    bool hits[kNodeSize];
+    std::vector<uint32_t> stack = {root};
+    while (!stack.empty())
+    {
+      uint32_t const node = stack.back();
+      stack.pop_back();
+
+      auto const & children = m_children[node - count];
+      size_t const first = children.first;
+      size_t const size = children.second - first;
+      for (size_t i = 0; i < size; ++i)
+      {
+        size_t const j = first + i;
+        hits[i] = (m_maxX[j] > rect.minX()) & (m_minX[j] < rect.maxX()) &
+                  (m_maxY[j] > rect.minY()) & (m_minY[j] < rect.maxY());
+      }
+
+      for (size_t i = 0; i < size; ++i)
+      {
+        if (!hits[i])
+          continue;
+
+        size_t const j = first + i;
+        if (j < count)
+          toDo(m2::RectD(m_minX[j], m_minY[j], m_maxX[j], m_maxY[j]), m_values[j]);
+        else
+          stack.push_back(static_cast<uint32_t>(j));
+      }
+    }
+  }
+
+  bool IsEmpty() const { return m_values.empty(); }
+
+  size_t GetSize() const { return m_values.size(); }
+
+  void Clear()
+  {
+    m_values.clear();
+    m_minX.clear();
+    m_minY.clear();
+    m_maxX.clear();
+    m_maxY.clear();
+    m_children.clear();
+    m_isBuilt = false;
+  }
+
+private:
+  void AddBox(double minX, double minY, double maxX, double maxY)
+  {
+    m_minX.push_back(minX);
+    m_minY.push_back(minY);
+    m_maxX.push_back(maxX);
+    m_maxY.push_back(maxY);
+  }
+
+  bool IsIntersect(size_t i, m2::RectD const & rect) const
+  {
+    return m_maxX[i] > rect.minX() && m_minX[i] < rect.maxX() && m_maxY[i] > rect.minY() &&
+           m_minY[i] < rect.maxY();
+  }
+
+  void DropNodes()
+  {
+    size_t const count = m_values.size();
+    m_minX.resize(count);
+    m_minY.resize(count);
+    m_maxX.resize(count);
+    m_maxY.resize(count);
+    m_children.clear();
+    m_isBuilt = false;
+  }
+
+  // Sorts values and their boxes by the Hilbert index of the box center.
+  void SortValues()
+  {
+    size_t const count = m_values.size();
+
+    double minX = m_minX[0];
+    double minY = m_minY[0];
+    double maxX = m_maxX[0];
+    double maxY = m_maxY[0];
+    for (size_t i = 1; i < count; ++i)
+    {
+      minX = std::min(minX, m_minX[i]);
+      minY = std::min(minY, m_minY[i]);
+      maxX = std::max(maxX, m_maxX[i]);
+      maxY = std::max(maxY, m_maxY[i]);
+    }
+
+    double const scaleX = maxX > minX ? kMaxHilbertCoord / (maxX - minX) : 0.0;
+    double const scaleY = maxY > minY ? kMaxHilbertCoord / (maxY - minY) : 0.0;
+
+    std::vector<uint32_t> hilbert(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      double const x = ((m_minX[i] + m_maxX[i]) / 2 - minX) * scaleX;
+      double const y = ((m_minY[i] + m_maxY[i]) / 2 - minY) * scaleY;
+      hilbert[i] = HilbertIndex(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+    }
+
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&hilbert](uint32_t lhs, uint32_t rhs) { return hilbert[lhs] < hilbert[rhs]; });
+
+    std::vector<T> values;
+    values.reserve(count);
+    for (uint32_t const i : order)
+      values.emplace_back(std::move(m_values[i]));
+    m_values.swap(values);
+
+    Permute(order, m_minX);
+    Permute(order, m_minY);
+    Permute(order, m_maxX);
+    Permute(order, m_maxY);
+  }
+
+  static void Permute(std::vector<uint32_t> const & order, std::vector<double> & coords)
+  {
+    std::vector<double> result(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      result[i] = coords[order[i]];
+    coords.swap(result);
+  }
+
+  static uint32_t constexpr kHilbertBits = 16;
+  static uint32_t constexpr kMaxHilbertCoord = (1 << kHilbertBits) - 1;
+
+  // Index of (x, y) in the Hilbert curve over the 2^kHilbertBits x 2^kHilbertBits grid.
+  static uint32_t HilbertIndex(uint32_t x, uint32_t y)
+  {
+    uint32_t index = 0;
+    for (uint32_t s = 1 << (kHilbertBits - 1); s > 0; s >>= 1)
+    {
+      uint32_t const rx = (x & s) > 0 ? 1 : 0;
+      uint32_t const ry = (y & s) > 0 ? 1 : 0;
+      index += s * s * ((3 * rx) ^ ry);
+      if (ry == 0)
+      {
+        if (rx == 1)
+        {
+          x = kMaxHilbertCoord - x;
+          y = kMaxHilbertCoord - y;
+        }
+        std::swap(x, y);
+      }
+    }
+    return index;
+  }
+
+  Traits m_traits;
+  std::vector<T> m_values;
+  std::vector<double> m_minX;
+  std::vector<double> m_minY;
+  std::vector<double> m_maxX;
+  std::vector<double> m_maxY;
+  // Node -> [first, last) indices of its children in the box arrays. Nodes are numbered from
+  // m_values.size().
+  std::vector<std::pair<uint32_t, uint32_t>> m_children;
+  bool m_isBuilt = false;
+};
+
+// static
+template <typename T, typename Traits>
+size_t constexpr PackedTree<T, Traits>::kNodeSize;
+}  // namespace m4
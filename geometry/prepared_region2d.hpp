@@ -0,0 +1,204 @@
+#pragma once
+
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/region2d.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace m2
+{
+// Region with an index of its edges for repeated point queries.
+//
+// The limit rect of the region is cut into about sqrt(n) horizontal slabs and every slab keeps
+// the edges which intersect it. A horizontal ray from a point crosses only the edges of the
+// point's slab, so Contains() and AtBorder() look at about sqrt(n) edges instead of n and give
+// the same results as Region.
+template <typename Point>
+class PreparedRegion
+{
+public:
+  using RegionT = Region<Point>;
+  using Coord = typename RegionT::Coord;
+  using Traits = typename RegionT::Traits;
+
+  explicit PreparedRegion(RegionT region) : m_region(std::move(region)) { BuildSlabs(); }
+
+  RegionT const & GetRegion() const { return m_region; }
+
+  bool Contains(Point const & pt) const
+  {
+    if (!m_region.GetRect().IsPointInside(pt))
+      return false;
+    return ContainsInSlab(pt, GetSlab(pt.y));
+  }
+
+  // Returns for every point of |points| whether the region contains it. Points are processed
+  // slab by slab, so edges of a slab are read from memory once per batch.
+  std::vector<bool> Contains(std::vector<Point> const & points) const
+  {
+    std::vector<bool> result(points.size(), false);
+
+    size_t const slabsCount = m_slabBegins.size() - 1;
+    std::vector<uint32_t> slabs(points.size(), kNoSlab);
+    std::vector<uint32_t> begins(slabsCount + 1, 0);
+    auto const & rect = m_region.GetRect();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      if (!rect.IsPointInside(points[i]))
+        continue;
+      slabs[i] = GetSlab(points[i].y);
+      ++begins[slabs[i] + 1];
+    }
+    for (size_t i = 1; i < begins.size(); ++i)
+      begins[i] += begins[i - 1];
+
+    std::vector<uint32_t> order(begins.back());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      if (slabs[i] != kNoSlab)
+        order[begins[slabs[i]]++] = static_cast<uint32_t>(i);
+    }
+
+    for (uint32_t const i : order)
+      result[i] = ContainsInSlab(points[i], slabs[i]);
+    return result;
+  }
+
+  bool AtBorder(Point const & pt, double const delta) const
+  {
+    if (!m_region.GetRect().IsPointInside(pt))
+      return false;
+
+    typename Traits::EqualType equalF;
+    double const squaredDelta = delta * delta;
+    auto const & points = m_region.Data();
+    size_t const numPoints = points.size();
+
+    uint32_t const first = GetSlab(pt.y - delta - kPadding);
+    uint32_t const last = GetSlab(pt.y + delta + kPadding);
+    for (uint32_t slab = first; slab <= last; ++slab)
+    {
+      for (uint32_t i = m_slabBegins[slab]; i < m_slabBegins[slab + 1]; ++i)
+      {
+        uint32_t const curr = m_slabEdges[i];
+
+        // Borders often have same points with ways
+        if (equalF.EqualPoints(points[curr], pt))
+          return true;
+
+        Point const & prev = points[curr == 0 ? numPoints - 1 : curr - 1];
+        ParametrizedSegment<Point> segment(prev, points[curr]);
+        if (segment.SquaredDistanceToPoint(pt) < squaredDelta)
+          return true;
+      }
+    }
+
+    return false;
+  }
+
+private:
+  static uint32_t constexpr kNoSlab = std::numeric_limits<uint32_t>::max();
+  // Points equal to a vertex with the precision of Region must get to the slabs of its edges.
+  static double constexpr kPadding =
+      std::is_floating_point<Coord>::value ? detail::DefEqualFloat::kPrecision : 0.0;
+
+  // Edge i goes from the point i - 1 to the point i, edge 0 closes the region.
+  void BuildSlabs()
+  {
+    auto const & points = m_region.Data();
+    size_t const numPoints = points.size();
+    size_t const slabsCount =
+        std::max(static_cast<size_t>(1), static_cast<size_t>(std::sqrt(numPoints)));
+
+    auto const & rect = m_region.GetRect();
+    m_minY = static_cast<double>(rect.minY());
+    double const height = static_cast<double>(rect.maxY()) - m_minY;
+    m_slabHeight = height > 0 ? height / slabsCount : 0.0;
+    m_slabBegins.assign(slabsCount + 1, 0);
+
+    auto const forEachEdgeSlab = [&](auto && fn) {
+      for (size_t curr = 0; curr < numPoints; ++curr)
+      {
+        size_t const prev = curr == 0 ? numPoints - 1 : curr - 1;
+        double const y1 = static_cast<double>(points[prev].y);
+        double const y2 = static_cast<double>(points[curr].y);
+        uint32_t const last = GetSlab(std::max(y1, y2) + kPadding);
+        for (uint32_t slab = GetSlab(std::min(y1, y2) - kPadding); slab <= last; ++slab)
+          fn(static_cast<uint32_t>(curr), slab);
+      }
+    };
+
+    forEachEdgeSlab([this](uint32_t, uint32_t slab) { ++m_slabBegins[slab + 1]; });
+    for (size_t i = 1; i < m_slabBegins.size(); ++i)
+      m_slabBegins[i] += m_slabBegins[i - 1];
+
+    m_slabEdges.resize(m_slabBegins.back());
+    std::vector<uint32_t> ends(m_slabBegins.begin(), m_slabBegins.end() - 1);
+    forEachEdgeSlab([&](uint32_t edge, uint32_t slab) { m_slabEdges[ends[slab]++] = edge; });
+  }
+
+  uint32_t GetSlab(double y) const
+  {
+    uint32_t const lastSlab = static_cast<uint32_t>(m_slabBegins.size() - 2);
+    if (m_slabHeight == 0.0 || y <= m_minY)
+      return 0;
+
+    double const slab = std::floor((y - m_minY) / m_slabHeight);
+    if (slab >= lastSlab)
+      return lastSlab;
+    return static_cast<uint32_t>(slab);
+  }
+
+  bool ContainsInSlab(Point const & pt, uint32_t slab) const
+  {
+    using BigPoint = ::m2::Point<typename Traits::BigType>;
+    using EqualFn = typename Traits::EqualType;
+
+    EqualFn equalF;
+    detail::RayCrossings<BigPoint, EqualFn> crossings(equalF);
+    auto const & points = m_region.Data();
+    size_t const numPoints = points.size();
+    BigPoint const bigPt(pt);
+
+    for (uint32_t i = m_slabBegins[slab]; i < m_slabBegins[slab + 1]; ++i)
+    {
+      uint32_t const curr = m_slabEdges[i];
+      if (equalF.EqualPoints(points[curr], pt))
+        return true;
+
+      uint32_t const prev = curr == 0 ? static_cast<uint32_t>(numPoints - 1) : curr - 1;
+      crossings.AddEdge(BigPoint(points[prev]) - bigPt, BigPoint(points[curr]) - bigPt);
+    }
+
+    return crossings.IsInsideOrAtEdge();
+  }
+
+  RegionT m_region;
+  double m_minY = 0.0;
+  double m_slabHeight = 0.0;
+  // Edges of slab i are m_slabEdges[m_slabBegins[i], m_slabBegins[i + 1]).
+  std::vector<uint32_t> m_slabBegins;
+  std::vector<uint32_t> m_slabEdges;
+};
+
+// static
+template <typename Point>
+uint32_t constexpr PreparedRegion<Point>::kNoSlab;
+
+// static
+template <typename Point>
+double constexpr PreparedRegion<Point>::kPadding;
+
+using PreparedRegionD = PreparedRegion<m2::PointD>;
+using PreparedRegionI = PreparedRegion<m2::PointI>;
+using PreparedRegionU = PreparedRegion<m2::PointU>;
+}  // namespace m2
@@ -80,6 +80,59 @@ struct Traitsype<0>
   typedef DefEqualInt EqualType;
   typedef int64_t BigType;
 };
+
+// Counts crossings of a polygon's edges with the rays going to the left and to the right from
+// a point. Taken from Computational Geometry in C and modified.
+template <typename BigPoint, typename EqualFn>
+class RayCrossings
+{
+public:
+  explicit RayCrossings(EqualFn const & equalF) : m_equalF(equalF) {}
+
+  // |prev| and |curr| are the ends of an edge relative to the point.
+  void AddEdge(BigPoint const & prev, BigPoint const & curr)
+  {
+    bool const rCheck = ((curr.y > 0) != (prev.y > 0));
+    bool const lCheck = ((curr.y < 0) != (prev.y < 0));
+
+    if (!rCheck && !lCheck)
+      return;
+
+    ASSERT_NOT_EQUAL(curr.y, prev.y, ());
+
+    auto const delta = prev.y - curr.y;
+    auto const cp = CrossProduct(curr, prev);
+
+    // Squared precision is needed here because of comparison between cross product of two
+    // std::vectors and zero. It's impossible to compare them relatively, so they're compared
+    // absolutely, and, as cross product is proportional to product of lengths of both
+    // operands precision must be squared too.
+    if (m_equalF.EqualZeroSquarePrecision(cp))
+      return;
+
+    bool const PrevGreaterCurr = delta > 0.0;
+
+    if (rCheck && ((cp > 0) == PrevGreaterCurr))
+      ++m_rCross;
+    if (lCheck && ((cp > 0) != PrevGreaterCurr))
+      ++m_lCross;
+  }
+
+  bool IsInsideOrAtEdge() const
+  {
+    /* q on the edge if left and right cross are not the same parity. */
+    if ((m_rCross & 1) != (m_lCross & 1))
+      return true;  // on the edge
+
+    /* q inside if an odd number of crossings. */
+    return (m_rCross & 1) != 0;
+  }
+
+private:
+  EqualFn const & m_equalF;
+  int m_rCross = 0; /* number of right edge/ray crossings */
+  int m_lCross = 0; /* number of left edge/ray crossings */
+};
 }  // namespace detail
 
 template <typename Point>
@@ -194,13 +247,10 @@ public:
     if (!m_rect.IsPointInside(pt))
       return false;
 
-    int rCross = 0; /* number of right edge/ray crossings */
-    int lCross = 0; /* number of left edge/ray crossings */
-
     size_t const numPoints = m_points.size();
 
-    using BigCoord = typename Traits::BigType;
-    using BigPoint = ::m2::Point<BigCoord>;
+    using BigPoint = ::m2::Point<typename Traits::BigType>;
+    detail::RayCrossings<BigPoint, EqualFn> crossings(equalF);
 
     BigPoint prev = BigPoint(m_points[numPoints - 1]) - BigPoint(pt);
     for (size_t i = 0; i < numPoints; ++i)
@@ -209,44 +259,11 @@ public:
         return true;
 
       BigPoint const curr = BigPoint(m_points[i]) - BigPoint(pt);
-
-      bool const rCheck = ((curr.y > 0) != (prev.y > 0));
-      bool const lCheck = ((curr.y < 0) != (prev.y < 0));
-
-      if (rCheck || lCheck)
-      {
-        ASSERT_NOT_EQUAL(curr.y, prev.y, ());
-
-        BigCoord const delta = prev.y - curr.y;
-        BigCoord const cp = CrossProduct(curr, prev);
-
-        // Squared precision is needed here because of comparison between cross product of two
-        // std::vectors and zero. It's impossible to compare them relatively, so they're compared
-        // absolutely, and, as cross product is proportional to product of lengths of both
-        // operands precision must be squared too.
-        if (!equalF.EqualZeroSquarePrecision(cp))
-        {
-          bool const PrevGreaterCurr = delta > 0.0;
-
-          if (rCheck && ((cp > 0) == PrevGreaterCurr))
-            ++rCross;
-          if (lCheck && ((cp > 0) != PrevGreaterCurr))
-            ++lCross;
-        }
-      }
-
+      crossings.AddEdge(prev, curr);
       prev = curr;
     }
 
-    /* q on the edge if left and right cross are not the same parity. */
-    if ((rCross & 1) != (lCross & 1))
-      return true;  // on the edge
-
-    /* q inside if an odd number of crossings. */
-    if (rCross & 1)
-      return true;  // inside
-    else
-      return false;  // outside
+    return crossings.IsInsideOrAtEdge();
   }
 
   bool Contains(Point const & pt) const { return Contains(pt, typename Traits::EqualType()); }
@@ -3,6 +3,7 @@
 #include "geometry/point2d.hpp"
 
 #include "base/base.hpp"
+#include "base/buffer_vector.hpp"
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 
@@ -28,9 +29,11 @@ std::pair<double, Iter> MaxDistance(Iter first, Iter last, DistanceFn & distFn)
   if (std::distance(first, last) <= 1)
     return res;
 
+  m2::PointD const a(*first);
+  m2::PointD const b(*last);
   for (Iter i = first + 1; i != last; ++i)
   {
-    double const d = distFn(m2::PointD(*first), m2::PointD(*last), m2::PointD(*i));
+    double const d = distFn(a, b, m2::PointD(*i));
     if (res.first < d)
     {
       res.first = d;
@@ -41,19 +44,48 @@ std::pair<double, Iter> MaxDistance(Iter first, Iter last, DistanceFn & distFn)
   return res;
 }
 
-// Actual SimplifyDP implementation.
-template <typename DistanceFn, typename Iter, typename Out>
-void SimplifyDP(Iter first, Iter last, double epsilon, DistanceFn & distFn, Out & out)
+// Returns true when all the points strictly between |first| and |last| are closer than
+// |epsilon| to the segment [first, last]. It's MaxDistance(first, last, distFn).first < epsilon
+// which stops at the first far point.
+template <typename DistanceFn, typename Iter>
+bool IsMaxDistanceLess(Iter first, Iter last, double epsilon, DistanceFn & distFn)
 {
-  std::pair<double, Iter> maxDist = impl::MaxDistance(first, last, distFn);
-  if (maxDist.second == last || maxDist.first < epsilon)
+  if (!(0.0 < epsilon))
+    return false;
+
+  m2::PointD const a(*first);
+  m2::PointD const b(*last);
+  for (Iter i = first + 1; i < last; ++i)
   {
-    out(*last);
+    if (!(distFn(a, b, m2::PointD(*i)) < epsilon))
+      return false;
   }
-  else
+  return true;
+}
+
+// Actual SimplifyDP implementation. Ranges are processed by a stack instead of recursion,
+// the points are passed to |out| in the same order as the recursive algorithm does.
+template <typename DistanceFn, typename Iter, typename Out>
+void SimplifyDP(Iter first, Iter last, double epsilon, DistanceFn & distFn, Out & out)
+{
+  buffer_vector<std::pair<Iter, Iter>, 32> ranges;
+  ranges.emplace_back(first, last);
+  while (!ranges.empty())
   {
-    impl::SimplifyDP(first, maxDist.second, epsilon, distFn, out);
-    impl::SimplifyDP(maxDist.second, last, epsilon, distFn, out);
+    auto const range = ranges.back();
+    ranges.pop_back();
+
+    std::pair<double, Iter> maxDist = impl::MaxDistance(range.first, range.second, distFn);
+    if (maxDist.second == range.second || maxDist.first < epsilon)
+    {
+      out(*range.second);
+    }
+    else
+    {
+      // The left part is on the top to be processed first.
+      ranges.emplace_back(maxDist.second, range.second);
+      ranges.emplace_back(range.first, maxDist.second);
+    }
   }
 }
 //@}
@@ -109,7 +141,7 @@ void SimplifyNearOptimal(int maxFalseLookAhead, Iter beg, Iter end, double epsil
       uint32_t const newPointCount = F[j].m_PointCount + 1;
       if (newPointCount < F[i].m_PointCount)
       {
-        if (impl::MaxDistance(beg + i, beg + j, distFn).first < epsilon)
+        if (impl::IsMaxDistanceLess(beg + i, beg + j, epsilon, distFn))
         {
           F[i].m_NextPoint = j;
           F[i].m_PointCount = newPointCount;
@@ -5,6 +5,7 @@
 #include "coding/reader.hpp"
 #include "coding/succinct_mapper.hpp"
 
+#include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/thread.hpp"
@@ -34,7 +35,7 @@ void LoadAndMap(size_t dataSize, ReaderSource<FilesContainerR::TReader> & src, T
 namespace feature
 {
 AltitudeLoader::AltitudeLoader(DataSource const & dataSource, MwmSet::MwmId const & mwmId)
-  : m_handle(dataSource.GetMwmHandleById(mwmId))
+  : m_cache(kLogCacheSize), m_handle(dataSource.GetMwmHandleById(mwmId))
 {
   if (!m_handle.IsAlive())
     return;
@@ -73,21 +74,124 @@ bool AltitudeLoader::HasAltitudes() const
 
 TAltitudes const & AltitudeLoader::GetAltitudes(uint32_t featureId, size_t pointCount)
 {
+  bool found = false;
+  TAltitudes & altitudes = m_cache.Find(featureId, found);
+  if (found && altitudes.size() == pointCount)
+    return altitudes;
+
   if (!HasAltitudes())
   {
     // The version of mwm is less than version::Format::v8 or there's no altitude section in mwm.
-    return m_cache.insert(make_pair(featureId, TAltitudes(pointCount, kDefaultAltitudeMeters))).first->second;
+    altitudes.assign(pointCount, kDefaultAltitudeMeters);
+    return altitudes;
+  }
+
+  Record record;
+  if (!GetRecord(featureId, record))
+  {
+    altitudes.assign(pointCount, m_header.m_minAltitude);
+    return altitudes;
+  }
+
+  try
+  {
+    ReaderSource<FilesContainerR::TReader> src(*m_reader);
+    src.Skip(m_header.m_altitudesOffset + record.m_begin);
+    ReadAltitudes(featureId, pointCount, src, altitudes);
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Feature Id", featureId, "of", m_countryFileName, ". Error while getting altitude data:", e.Msg()));
+    altitudes.assign(pointCount, m_header.m_minAltitude);
+  }
+  return altitudes;
+}
+
+void AltitudeLoader::GetAltitudes(vector<uint32_t> const & featureIds,
+                                  vector<size_t> const & pointCounts,
+                                  vector<TAltitudes> & altitudes)
+{
+  CHECK_EQUAL(featureIds.size(), pointCounts.size(), ());
+
+  // Records which are closer to each other than |kMaxGap| bytes are read by one call.
+  uint64_t constexpr kMaxGap = 1024;
+
+  altitudes.clear();
+  altitudes.resize(featureIds.size());
+
+  vector<Record> records;
+  for (size_t i = 0; i < featureIds.size(); ++i)
+  {
+    bool found = false;
+    TAltitudes const & cached = m_cache.Find(featureIds[i], found);
+    if (found && cached.size() == pointCounts[i])
+    {
+      altitudes[i] = cached;
+      continue;
+    }
+
+    Record record;
+    if (HasAltitudes() && GetRecord(featureIds[i], record))
+    {
+      record.m_index = i;
+      records.push_back(record);
+      continue;
+    }
+
+    altitudes[i].assign(pointCounts[i],
+                        HasAltitudes() ? m_header.m_minAltitude : kDefaultAltitudeMeters);
   }
 
-  auto const it = m_cache.find(featureId);
-  if (it != m_cache.end())
-    return it->second;
+  sort(records.begin(), records.end(),
+       [](Record const & lhs, Record const & rhs) { return lhs.m_begin < rhs.m_begin; });
+
+  vector<uint8_t> buffer;
+  for (size_t i = 0; i < records.size();)
+  {
+    uint64_t const begin = records[i].m_begin;
+    uint64_t end = records[i].m_end;
+    size_t j = i + 1;
+    for (; j < records.size() && records[j].m_begin <= end + kMaxGap; ++j)
+      end = max(end, records[j].m_end);
+
+    try
+    {
+      buffer.resize(base::checked_cast<size_t>(end - begin));
+      m_reader->Read(m_header.m_altitudesOffset + begin, buffer.data(), buffer.size());
+      for (; i < j; ++i)
+      {
+        auto const & record = records[i];
+        MemReader reader(buffer.data() + (record.m_begin - begin), record.m_end - record.m_begin);
+        ReaderSource<MemReader> src(reader);
+        ReadAltitudes(featureIds[record.m_index], pointCounts[record.m_index], src,
+                      altitudes[record.m_index]);
+      }
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG(LERROR, ("File", m_countryFileName, ". Error while getting altitude data:", e.Msg()));
+      for (; i < j; ++i)
+      {
+        auto const index = records[i].m_index;
+        altitudes[index].assign(pointCounts[index], m_header.m_minAltitude);
+      }
+    }
+  }
+
+  for (auto const & record : records)
+  {
+    bool found = false;
+    m_cache.Find(featureIds[record.m_index], found) = altitudes[record.m_index];
+  }
+}
 
+bool AltitudeLoader::GetRecord(uint32_t featureId, Record & record) const
+{
   if (!m_altitudeAvailability[featureId])
   {
     LOG(LDEBUG, ("Feature Id", featureId, "of", m_countryFileName,
                  "does not contain any altitude information."));
-    return m_cache.insert(make_pair(featureId, TAltitudes(pointCount, m_header.m_minAltitude))).first->second;
+    return false;
   }
 
   uint64_t const r = m_altitudeAvailability.rank(featureId);
@@ -98,30 +202,33 @@ TAltitudes const & AltitudeLoader::GetAltitudes(uint32_t featureId, size_t point
   uint64_t const altitudeInfoOffsetInSection = m_header.m_altitudesOffset + offset;
   CHECK_LESS(altitudeInfoOffsetInSection, m_reader->Size(), ("Feature Id", featureId, "of", m_countryFileName));
 
-  try
-  {
-    Altitudes altitudes;
-    ReaderSource<FilesContainerR::TReader> src(*m_reader);
-    src.Skip(altitudeInfoOffsetInSection);
-    bool const isDeserialized = altitudes.Deserialize(m_header.m_minAltitude, pointCount,
-                                                      m_countryFileName, featureId,  src);
-
-    bool const allValid = isDeserialized
-        && none_of(altitudes.m_altitudes.begin(), altitudes.m_altitudes.end(),
-                   [](TAltitude a) { return a == kInvalidAltitude; });
-    if (!allValid)
-    {
-      LOG(LERROR, ("Only a part point of a feature has a valid altitdue. Altitudes: ", altitudes.m_altitudes,
-                   ". Feature Id", featureId, "of", m_countryFileName));
-      return m_cache.insert(make_pair(featureId, TAltitudes(pointCount, m_header.m_minAltitude))).first->second;
-    }
+  record.m_begin = offset;
+  // Altitudes of the last feature are followed by the padding of the section.
+  record.m_end = r + 1 < m_featureTable.num_ones() ? m_featureTable.select(r + 1)
+                                                  : m_header.GetAltitudeInfoSize();
+  CHECK_LESS(record.m_begin, record.m_end, ("Feature Id", featureId, "of", m_countryFileName));
+  return true;
+}
 
-    return m_cache.insert(make_pair(featureId, move(altitudes.m_altitudes))).first->second;
-  }
-  catch (Reader::OpenException const & e)
+template <typename Source>
+void AltitudeLoader::ReadAltitudes(uint32_t featureId, size_t pointCount, Source & src,
+                                   TAltitudes & altitudes)
+{
+  Altitudes decoded;
+  bool const isDeserialized =
+      decoded.Deserialize(m_header.m_minAltitude, pointCount, m_countryFileName, featureId, src);
+
+  bool const allValid = isDeserialized
+      && none_of(decoded.m_altitudes.begin(), decoded.m_altitudes.end(),
+                 [](TAltitude a) { return a == kInvalidAltitude; });
+  if (!allValid)
   {
-    LOG(LERROR, ("Feature Id", featureId, "of", m_countryFileName, ". Error while getting altitude data:", e.Msg()));
-    return m_cache.insert(make_pair(featureId, TAltitudes(pointCount, m_header.m_minAltitude))).first->second;
+    LOG(LERROR, ("Only a part point of a feature has a valid altitdue. Altitudes: ", decoded.m_altitudes,
+                 ". Feature Id", featureId, "of", m_countryFileName));
+    altitudes.assign(pointCount, m_header.m_minAltitude);
+    return;
   }
+
+  altitudes = move(decoded.m_altitudes);
 }
 }  // namespace feature
@@ -4,6 +4,10 @@
 
 #include "coding/memory_region.hpp"
 
+#include "base/cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -27,13 +31,37 @@ public:
 
   /// \returns altitude of feature with |featureId|. All items of the returned vector are valid
   /// or the returned vector is empty.
+  /// \note The returned reference is valid until the next call of the loader.
   TAltitudes const & GetAltitudes(uint32_t featureId, size_t pointCount);
 
+  /// \brief Fills |altitudes| with altitudes of features |featureIds| which have |pointCounts|
+  /// points. Altitudes are read in the order of the section and records which are close to
+  /// each other are read by one call.
+  void GetAltitudes(std::vector<uint32_t> const & featureIds,
+                    std::vector<size_t> const & pointCounts, std::vector<TAltitudes> & altitudes);
+
   bool HasAltitudes() const;
 
-  void ClearCache() { m_cache.clear(); }
+  void ClearCache() { m_cache.Reset(); }
 
 private:
+  // Altitudes of 1024 features are cached.
+  static uint32_t constexpr kLogCacheSize = 10;
+
+  // Range of altitudes of a feature in the altitudes part of the section.
+  struct Record
+  {
+    uint64_t m_begin = 0;
+    uint64_t m_end = 0;
+    size_t m_index = 0;
+  };
+
+  // Returns false if the feature has no altitudes in the section.
+  bool GetRecord(uint32_t featureId, Record & record) const;
+
+  template <typename Source>
+  void ReadAltitudes(uint32_t featureId, size_t pointCount, Source & src, TAltitudes & altitudes);
+
   std::unique_ptr<CopiedMemoryRegion> m_altitudeAvailabilityRegion;
   std::unique_ptr<CopiedMemoryRegion> m_featureTableRegion;
 
@@ -41,7 +69,7 @@ private:
   succinct::elias_fano m_featureTable;
 
   std::unique_ptr<FilesContainerR::TReader> m_reader;
-  std::map<uint32_t, TAltitudes> m_cache;
+  base::Cache<uint32_t, TAltitudes> m_cache;
   AltitudeHeader m_header;
   std::string m_countryFileName;
   MwmSet::MwmHandle m_handle;
@@ -3,16 +3,165 @@
 #include "indexer/search_delimiters.hpp"
 #include "indexer/search_string_utils.hpp"
 
+#include "coding/endianness.hpp"
 #include "coding/reader.hpp"
 #include "coding/reader_streambuf.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
 
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <cstring>
+
 using namespace std;
 
+// The compiled form of CategoriesHolder:
+//   [kCompiledTag] [1: version]
+//   [vu: number of names] [names in the sorted order, every one is front-coded:
+//     [vu: size of the prefix shared with the previous name] [vu: size of the rest] [the rest]]
+//   [vu: number of categories] [categories: [vu: number of synonyms] [synonyms]]
+//   [vu: number of pairs] [pairs of m_type2cat in its order: [vu: type] [vu: category id]]
+//   [vu: number of groups] [groups: [vu: group name id] [vu: number of synonyms] [synonyms]]
+//   [vu: number of locales] [locales: [1: locale] [vu: size of the table] [tokens table]]
+//
+// A synonym is [1: locale] [1: prefix length to suggest] [vu: name id].
+//
+// A tokens table contains the utf8 tokens of one locale in the sorted order:
+//   [vu: number of tokens]
+//   [4 * number of blocks: offsets of blocks from the beginning of the table]
+//   [block] ... [block]
+// Every block contains kTokensBlockSize tokens except the last one. Tokens are front-coded
+// like names, the size of the shared prefix is omitted for the first token of a block.
+// Every token is followed by its types: [vu: number of types] [vu: type] ...
 namespace
 {
+char const kCompiledTag[] = "MWM_CATEGORIES";
+size_t constexpr kCompiledTagSize = sizeof(kCompiledTag) - 1;
+uint8_t constexpr kCompiledVersion = 0;
+size_t constexpr kTokensBlockSize = 16;
+
+using Synonym = CategoriesHolder::Category::Name;
+using Tokens = vector<pair<string, vector<uint32_t>>>;
+
+uint32_t ReadUint32(uint8_t const * p)
+{
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return SwapIfBigEndianMacroBased(value);
+}
+
+void WriteUint32(uint32_t value, uint8_t * p)
+{
+  value = SwapIfBigEndianMacroBased(value);
+  memcpy(p, &value, sizeof(value));
+}
+
+size_t GetCommonPrefixSize(string const & lhs, string const & rhs)
+{
+  size_t const size = min(lhs.size(), rhs.size());
+  return mismatch(lhs.begin(), lhs.begin() + size, rhs.begin()).first - lhs.begin();
+}
+
+template <typename Sink>
+void WriteString(Sink & sink, string const & s, size_t common)
+{
+  WriteVarUint(sink, s.size() - common);
+  sink.Write(s.data() + common, s.size() - common);
+}
+
+void ReadString(ArrayByteSource & source, size_t common, string & s)
+{
+  size_t const size = ReadVarUint<uint32_t>(source);
+  CHECK_LESS_OR_EQUAL(common, s.size(), ());
+  s.resize(common);
+  s.append(source.PtrC(), size);
+  source.Advance(size);
+}
+
+template <typename Synonyms, typename GetId>
+void WriteSynonyms(Writer & writer, Synonyms const & synonyms, GetId const & getId)
+{
+  WriteVarUint(writer, synonyms.size());
+  for (auto const & synonym : synonyms)
+  {
+    WriteToSink(writer, synonym.m_locale);
+    WriteToSink(writer, synonym.m_prefixLengthToSuggest);
+    WriteVarUint(writer, getId(synonym.m_name));
+  }
+}
+
+template <typename Synonyms>
+void ReadSynonyms(ArrayByteSource & source, vector<string> const & names, Synonyms & synonyms)
+{
+  for (auto count = ReadVarUint<uint32_t>(source); count > 0; --count)
+  {
+    Synonym synonym;
+    synonym.m_locale = static_cast<int8_t>(source.ReadByte());
+    synonym.m_prefixLengthToSuggest = source.ReadByte();
+    auto const id = ReadVarUint<uint32_t>(source);
+    CHECK_LESS(id, names.size(), ());
+    synonym.m_name = names[id];
+    synonyms.push_back(move(synonym));
+  }
+}
+
+void WriteTokensTable(Tokens const & tokens, vector<uint8_t> & table)
+{
+  PushBackByteSink<vector<uint8_t>> sink(table);
+  WriteVarUint(sink, tokens.size());
+  size_t const offsetsPos = table.size();
+  size_t const numBlocks = (tokens.size() + kTokensBlockSize - 1) / kTokensBlockSize;
+  table.resize(table.size() + sizeof(uint32_t) * numBlocks);
+
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    auto const & token = tokens[i].first;
+    size_t common = 0;
+    if (i % kTokensBlockSize == 0)
+    {
+      WriteUint32(base::checked_cast<uint32_t>(table.size()),
+                  table.data() + offsetsPos + sizeof(uint32_t) * (i / kTokensBlockSize));
+    }
+    else
+    {
+      common = GetCommonPrefixSize(token, tokens[i - 1].first);
+      WriteVarUint(sink, common);
+    }
+    WriteString(sink, token, common);
+
+    auto const & types = tokens[i].second;
+    WriteVarUint(sink, types.size());
+    for (auto const type : types)
+      WriteVarUint(sink, type);
+  }
+}
+
+void SkipTypes(ArrayByteSource & source)
+{
+  for (auto count = ReadVarUint<uint32_t>(source); count > 0; --count)
+    ReadVarUint<uint32_t>(source);
+}
+
+// Calls |fn| for every token of |table| in the sorted order, |fn| must read the types
+// of the token from the source.
+template <typename Fn>
+void ForEachToken(uint8_t const * table, Fn && fn)
+{
+  ArrayByteSource source(table);
+  size_t const numTokens = ReadVarUint<uint32_t>(source);
+  size_t const numBlocks = (numTokens + kTokensBlockSize - 1) / kTokensBlockSize;
+  source.Advance(sizeof(uint32_t) * numBlocks);
+
+  string token;
+  for (size_t i = 0; i < numTokens; ++i)
+  {
+    size_t const common = i % kTokensBlockSize == 0 ? 0 : ReadVarUint<uint32_t>(source);
+    ReadString(source, common, token);
+    fn(static_cast<string const &>(token), source);
+  }
+}
+
 enum State
 {
   EParseTypes,
@@ -187,9 +336,25 @@ vector<string> CategoriesHolder::kDisabledLanguages = {"el", "he", "sw"};
 
 CategoriesHolder::CategoriesHolder(unique_ptr<Reader> && reader)
 {
-  ReaderStreamBuf buffer(move(reader));
-  istream s(&buffer);
-  LoadFromStream(s);
+  string tag;
+  if (reader->Size() >= kCompiledTagSize)
+  {
+    tag.resize(kCompiledTagSize);
+    reader->Read(0 /* pos */, &tag[0], tag.size());
+  }
+
+  if (tag == kCompiledTag)
+  {
+    vector<uint8_t> data(base::checked_cast<size_t>(reader->Size()));
+    reader->Read(0 /* pos */, data.data(), data.size());
+    LoadCompiled(move(data));
+  }
+  else
+  {
+    ReaderStreamBuf buffer(move(reader));
+    istream s(&buffer);
+    LoadFromStream(s);
+  }
 
 #if defined(DEBUG)
   for (auto const & entry : kLocaleMapping)
@@ -318,6 +483,219 @@ void CategoriesHolder::LoadFromStream(istream & s)
   TrimGroupTranslations(m_groupTranslations);
 }
 
+void CategoriesHolder::LoadCompiled(vector<uint8_t> && data)
+{
+  m_compiled = move(data);
+  ArrayByteSource source(m_compiled.data() + kCompiledTagSize);
+  auto const version = source.ReadByte();
+  CHECK_EQUAL(version, kCompiledVersion, ());
+
+  vector<string> names(ReadVarUint<uint32_t>(source));
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    size_t common = 0;
+    if (i != 0)
+    {
+      common = ReadVarUint<uint32_t>(source);
+      names[i] = names[i - 1];
+    }
+    ReadString(source, common, names[i]);
+  }
+
+  vector<shared_ptr<Category>> categories(ReadVarUint<uint32_t>(source));
+  for (auto & category : categories)
+  {
+    category = make_shared<Category>();
+    ReadSynonyms(source, names, category->m_synonyms);
+  }
+
+  for (auto count = ReadVarUint<uint32_t>(source); count > 0; --count)
+  {
+    auto const type = ReadVarUint<uint32_t>(source);
+    auto const id = ReadVarUint<uint32_t>(source);
+    CHECK_LESS(id, categories.size(), ());
+    m_type2cat.emplace(type, categories[id]);
+  }
+
+  for (auto count = ReadVarUint<uint32_t>(source); count > 0; --count)
+  {
+    auto const id = ReadVarUint<uint32_t>(source);
+    CHECK_LESS(id, names.size(), ());
+    ReadSynonyms(source, names, m_groupTranslations[names[id]]);
+  }
+
+  m_localeTokens.assign(kMaxSupportedLocaleIndex + 1, {0 /* offset */, 0 /* size */});
+  for (auto count = ReadVarUint<uint32_t>(source); count > 0; --count)
+  {
+    auto const locale = source.ReadByte();
+    CHECK_LESS_OR_EQUAL(locale, kMaxSupportedLocaleIndex, ());
+    auto const size = ReadVarUint<uint32_t>(source);
+    auto const offset = static_cast<uint32_t>(source.PtrUC() - m_compiled.data());
+    m_localeTokens[locale] = {offset, size};
+    source.Advance(size);
+  }
+  CHECK_EQUAL(source.PtrUC(), m_compiled.data() + m_compiled.size(), ());
+
+  m_name2typeBuilt = false;
+}
+
+void CategoriesHolder::Serialize(Writer & writer) const
+{
+  vector<string> names;
+  ForEachName([&names](Category::Name const & name) { names.push_back(name.m_name); });
+  for (auto const & group : m_groupTranslations)
+  {
+    names.push_back(group.first);
+    for (auto const & synonym : group.second)
+      names.push_back(synonym.m_name);
+  }
+  base::SortUnique(names);
+  auto const getId = [&names](string const & name) {
+    auto const it = lower_bound(names.begin(), names.end(), name);
+    ASSERT(it != names.end() && *it == name, ());
+    return static_cast<uint32_t>(distance(names.begin(), it));
+  };
+
+  writer.Write(kCompiledTag, kCompiledTagSize);
+  WriteToSink(writer, kCompiledVersion);
+
+  WriteVarUint(writer, names.size());
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    size_t common = 0;
+    if (i != 0)
+    {
+      common = GetCommonPrefixSize(names[i], names[i - 1]);
+      WriteVarUint(writer, common);
+    }
+    WriteString(writer, names[i], common);
+  }
+
+  // A category is shared by all its types.
+  map<Category const *, uint32_t> ids;
+  vector<Category const *> categories;
+  for (auto const & p : m_type2cat)
+  {
+    if (ids.emplace(p.second.get(), static_cast<uint32_t>(categories.size())).second)
+      categories.push_back(p.second.get());
+  }
+  WriteVarUint(writer, categories.size());
+  for (auto const * category : categories)
+    WriteSynonyms(writer, category->m_synonyms, getId);
+  WriteVarUint(writer, m_type2cat.size());
+  for (auto const & p : m_type2cat)
+  {
+    WriteVarUint(writer, p.first);
+    WriteVarUint(writer, ids[p.second.get()]);
+  }
+
+  WriteVarUint(writer, m_groupTranslations.size());
+  for (auto const & group : m_groupTranslations)
+  {
+    WriteVarUint(writer, getId(group.first));
+    WriteSynonyms(writer, group.second, getId);
+  }
+
+  map<int8_t, Tokens> localeTokens;
+  GetNameToTypesTrie().ForEachInTrie([&localeTokens](String const & key, uint32_t type) {
+    CHECK(!key.empty(), ());
+    auto & tokens = localeTokens[static_cast<int8_t>(key[0])];
+    auto token = strings::ToUtf8(String(key.begin() + 1, key.end()));
+    if (tokens.empty() || tokens.back().first != token)
+      tokens.emplace_back(move(token), vector<uint32_t>());
+    tokens.back().second.push_back(type);
+  });
+
+  WriteVarUint(writer, localeTokens.size());
+  for (auto & entry : localeTokens)
+  {
+    auto & tokens = entry.second;
+    sort(tokens.begin(), tokens.end());
+
+    vector<uint8_t> table;
+    WriteTokensTable(tokens, table);
+    WriteToSink(writer, entry.first);
+    WriteVarUint(writer, table.size());
+    writer.Write(table.data(), table.size());
+  }
+}
+
+CategoriesHolder::Trie const & CategoriesHolder::GetNameToTypesTrie() const
+{
+  lock_guard<mutex> lock(m_name2typeMutex);
+  if (!m_name2typeBuilt)
+  {
+    for (size_t locale = 0; locale < m_localeTokens.size(); ++locale)
+    {
+      if (m_localeTokens[locale].second == 0)
+        continue;
+
+      auto const localePrefix = String(1, static_cast<strings::UniChar>(locale));
+      ForEachToken(m_compiled.data() + m_localeTokens[locale].first,
+                   [&](string const & token, ArrayByteSource & source) {
+                     auto const key = localePrefix + strings::MakeUniString(token);
+                     for (auto count = ReadVarUint<uint32_t>(source); count > 0; --count)
+                       m_name2type.Add(key, ReadVarUint<uint32_t>(source));
+                   });
+    }
+    m_name2typeBuilt = true;
+  }
+  return m_name2type;
+}
+
+uint8_t const * CategoriesHolder::FindCompiledTypes(int8_t locale, String const & name) const
+{
+  if (locale < 0 || static_cast<size_t>(locale) >= m_localeTokens.size() ||
+      m_localeTokens[locale].second == 0)
+  {
+    return nullptr;
+  }
+
+  uint8_t const * table = m_compiled.data() + m_localeTokens[locale].first;
+  ArrayByteSource source(table);
+  size_t const numTokens = ReadVarUint<uint32_t>(source);
+  size_t const numBlocks = (numTokens + kTokensBlockSize - 1) / kTokensBlockSize;
+  if (numBlocks == 0)
+    return nullptr;
+
+  uint8_t const * offsets = source.PtrUC();
+  auto const getBlock = [&](size_t i) {
+    return table + ReadUint32(offsets + sizeof(uint32_t) * i);
+  };
+
+  // Finds the last block whose first token is not greater than |token|.
+  string const token = strings::ToUtf8(name);
+  size_t lo = 0;
+  size_t hi = numBlocks;
+  while (hi - lo > 1)
+  {
+    size_t const mid = lo + (hi - lo) / 2;
+    ArrayByteSource block(getBlock(mid));
+    size_t const size = ReadVarUint<uint32_t>(block);
+    if (token.compare(0, string::npos, block.PtrC(), size) < 0)
+      hi = mid;
+    else
+      lo = mid;
+  }
+
+  ArrayByteSource block(getBlock(lo));
+  string current;
+  size_t const blockBegin = lo * kTokensBlockSize;
+  size_t const blockEnd = min(numTokens, blockBegin + kTokensBlockSize);
+  for (size_t i = blockBegin; i < blockEnd; ++i)
+  {
+    size_t const common = i == blockBegin ? 0 : ReadVarUint<uint32_t>(block);
+    ReadString(block, common, current);
+    int const cmp = token.compare(current);
+    if (cmp == 0)
+      return block.PtrUC();
+    if (cmp < 0)
+      return nullptr;
+    SkipTypes(block);
+  }
+  return nullptr;
+}
+
 bool CategoriesHolder::GetNameByType(uint32_t type, int8_t locale, string & name) const
 {
   auto const range = m_type2cat.equal_range(type);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "coding/byte_stream.hpp"
+#include "coding/varint.hpp"
+
 #include "base/mem_trie.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
@@ -9,12 +12,14 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 class Reader;
+class Writer;
 
 class CategoriesHolder
 {
@@ -57,10 +62,19 @@ private:
 
   // Maps locale and category token to the list of corresponding types.
   // Locale is treated as a special symbol prepended to the token.
-  Trie m_name2type;
+  // When the holder is loaded from the compiled form the trie is built on the first
+  // GetNameToTypesTrie() call only, exact lookups use |m_compiled|.
+  mutable Trie m_name2type;
+  mutable bool m_name2typeBuilt = true;
+  mutable std::mutex m_name2typeMutex;
 
   GroupTranslations m_groupTranslations;
 
+  // The compiled form and the positions of the tokens tables of locales in it,
+  // see categories_holder.cpp.
+  std::vector<uint8_t> m_compiled;
+  std::vector<std::pair<uint32_t, uint32_t>> m_localeTokens;
+
 public:
   static int8_t constexpr kEnglishCode = 1;
   static int8_t constexpr kUnsupportedLocaleCode = -1;
@@ -120,8 +134,19 @@ public:
   template <class ToDo>
   void ForEachTypeByName(int8_t locale, String const & name, ToDo && toDo) const
   {
-    auto const localePrefix = String(1, static_cast<strings::UniChar>(locale));
-    m_name2type.ForEachInNode(localePrefix + name, std::forward<ToDo>(toDo));
+    if (m_compiled.empty())
+    {
+      auto const localePrefix = String(1, static_cast<strings::UniChar>(locale));
+      m_name2type.ForEachInNode(localePrefix + name, std::forward<ToDo>(toDo));
+      return;
+    }
+
+    uint8_t const * types = FindCompiledTypes(locale, name);
+    if (!types)
+      return;
+    ArrayByteSource source(types);
+    for (auto count = ReadVarUint<uint32_t>(source); count > 0; --count)
+      toDo(ReadVarUint<uint32_t>(source));
   }
 
   GroupTranslations const & GetGroupTranslations() const { return m_groupTranslations; }
@@ -135,15 +160,24 @@ public:
   std::string GetReadableFeatureType(uint32_t type, int8_t locale) const;
 
   // Exposes the tries that map category tokens to types.
-  Trie const & GetNameToTypesTrie() const { return m_name2type; }
+  Trie const & GetNameToTypesTrie() const;
   bool IsTypeExist(uint32_t type) const;
 
   void Swap(CategoriesHolder & r)
   {
     m_type2cat.swap(r.m_type2cat);
     std::swap(m_name2type, r.m_name2type);
+    std::swap(m_name2typeBuilt, r.m_name2typeBuilt);
+    m_groupTranslations.swap(r.m_groupTranslations);
+    m_compiled.swap(r.m_compiled);
+    m_localeTokens.swap(r.m_localeTokens);
   }
 
+  // Writes the compiled form of the holder, which is loaded instead of categories.txt without
+  // parsing, classificator lookups and normalization of names. Names are front-coded and
+  // tokens of every locale are stored as a sorted table which is looked up in place.
+  void Serialize(Writer & writer) const;
+
   // Converts any language |locale| from UI to the corresponding
   // internal integer code.
   static int8_t MapLocaleToInteger(std::string const & locale);
@@ -155,6 +189,9 @@ public:
 
 private:
   void LoadFromStream(std::istream & s);
+  void LoadCompiled(std::vector<uint8_t> && data);
+  // Returns the types list of |name| in |locale| in the compiled form or nullptr.
+  uint8_t const * FindCompiledTypes(int8_t locale, String const & name) const;
   void AddCategory(Category & cat, std::vector<uint32_t> & types);
   static bool ValidKeyToken(String const & s);
 };
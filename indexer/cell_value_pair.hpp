@@ -29,6 +29,8 @@ public:
   }
 
   uint64_t GetCell() const { return UINT64_FROM_UINT32(m_cellHi, m_cellLo); }
+  // See RadixSortKey in coding/file_sort.hpp.
+  uint64_t GetSortKey() const { return GetCell(); }
   Value GetValue() const { return m_value; }
 
 private:
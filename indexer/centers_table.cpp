@@ -2,6 +2,7 @@
 
 #include "indexer/feature_processor.hpp"
 
+#include "coding/bit_streams.hpp"
 #include "coding/endianness.hpp"
 #include "coding/file_container.hpp"
 #include "coding/geometry_coding.hpp"
@@ -14,9 +15,12 @@
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <unordered_map>
 
 #include "3party/succinct/elias_fano.hpp"
@@ -225,6 +229,222 @@ private:
 
   unordered_map<uint32_t, vector<m2::PointU>> m_cache;
 };
+
+// V1 of CentersTable.  Has the following format:
+//
+// File offset (bytes)  Field name          Field size (bytes)
+// 0                    common header       4
+// 4                    blocks offset       4
+// 8                    values offset       4
+// 12                   end of section      4
+// 16                   identifiers table   blocks offset - 16
+// blocks offset        blocks table        values offset - blocks offset
+// values offset        values              end of section - values offset
+//
+// All offsets are in little-endian format.
+//
+// Identifiers table is the same as in V0.
+//
+// Blocks table is an array of kBlockDescSize-bytes descriptors of
+// blocks of kBlockSize consecutive centers: min x and min y of the
+// centers in the block, offset of values of the block and widths of x
+// and y values in bits. Values of a block are x - min x and y - min y
+// for each center, packed with these widths starting from the least
+// significant bit. Values are followed by kPaddingSize zero bytes, so
+// any value is read by one 8-byte load. Blocks table and values are
+// in little-endian format.
+//
+// So a center is read in O(1) without decoding of its block, and the
+// table works right over its memory, e.g. over a mapped section.
+class CentersTableV1 : public CentersTable
+{
+public:
+  static uint32_t const kBlockSize = 64;
+  static uint32_t const kBlockDescSize = 16;
+  static uint32_t const kPaddingSize = 8;
+
+  struct Header
+  {
+    void Read(Reader & reader)
+    {
+      m_base.Read(reader);
+
+      NonOwningReaderSource source(reader);
+      source.Skip(sizeof(m_base));
+      m_blocksOffset = ReadPrimitiveFromSource<uint32_t>(source);
+      m_valuesOffset = ReadPrimitiveFromSource<uint32_t>(source);
+      m_endOffset = ReadPrimitiveFromSource<uint32_t>(source);
+    }
+
+    void Write(Writer & writer)
+    {
+      m_base.Write(writer);
+
+      WriteToSink(writer, m_blocksOffset);
+      WriteToSink(writer, m_valuesOffset);
+      WriteToSink(writer, m_endOffset);
+    }
+
+    bool IsValid() const
+    {
+      if (!m_base.IsValid())
+      {
+        LOG(LERROR, ("Base header is not valid!"));
+        return false;
+      }
+      if (m_blocksOffset < sizeof(Header))
+      {
+        LOG(LERROR, ("Blocks before header:", m_blocksOffset, sizeof(Header)));
+        return false;
+      }
+      if (m_valuesOffset < m_blocksOffset)
+      {
+        LOG(LERROR, ("Values before blocks:", m_valuesOffset, m_blocksOffset));
+        return false;
+      }
+      if (m_endOffset < m_valuesOffset + kPaddingSize)
+      {
+        LOG(LERROR, ("No padding after values:", m_endOffset, m_valuesOffset));
+        return false;
+      }
+      return true;
+    }
+
+    CentersTable::Header m_base;
+    uint32_t m_blocksOffset = 0;
+    uint32_t m_valuesOffset = 0;
+    uint32_t m_endOffset = 0;
+  };
+
+  static_assert(sizeof(Header) == 16, "Wrong header size.");
+
+  struct Block
+  {
+    void Read(uint8_t const * p)
+    {
+      m_minX = ReadUint32(p);
+      m_minY = ReadUint32(p + 4);
+      m_offset = ReadUint32(p + 8);
+      m_xBits = p[12];
+      m_yBits = p[13];
+    }
+
+    void Write(Writer & writer) const
+    {
+      WriteToSink(writer, m_minX);
+      WriteToSink(writer, m_minY);
+      WriteToSink(writer, m_offset);
+      WriteToSink(writer, m_xBits);
+      WriteToSink(writer, m_yBits);
+      WriteToSink(writer, static_cast<uint16_t>(0));
+    }
+
+    uint32_t m_minX = 0;
+    uint32_t m_minY = 0;
+    uint32_t m_offset = 0;
+    uint8_t m_xBits = 0;
+    uint8_t m_yBits = 0;
+  };
+
+  CentersTableV1(unique_ptr<MemoryRegion> region, serial::GeometryCodingParams const & codingParams)
+    : m_region(move(region)), m_codingParams(codingParams)
+  {
+  }
+
+  // CentersTable overrides:
+  bool Get(uint32_t id, m2::PointD & center) override
+  {
+    if (id >= m_ids.size() || !m_ids[id])
+      return false;
+    uint64_t const rank = m_ids.rank(id);
+
+    Block block;
+    block.Read(m_blocks + (rank / kBlockSize) * kBlockDescSize);
+
+    uint64_t const pos = static_cast<uint64_t>(block.m_offset) * CHAR_BIT +
+                         (rank % kBlockSize) * (block.m_xBits + block.m_yBits);
+    m2::PointU const point(block.m_minX + ReadBits(pos, block.m_xBits),
+                           block.m_minY + ReadBits(pos + block.m_xBits, block.m_yBits));
+    center = PointUToPointD(point, m_codingParams.GetCoordBits());
+    return true;
+  }
+
+private:
+  static uint32_t ReadUint32(uint8_t const * p)
+  {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return SwapIfBigEndianMacroBased(value);
+  }
+
+  // Reads |numBits| <= 32 bits of values at bit position |pos|.
+  uint32_t ReadBits(uint64_t pos, uint8_t numBits) const
+  {
+    uint64_t word;
+    memcpy(&word, m_values + pos / CHAR_BIT, sizeof(word));
+    word = SwapIfBigEndianMacroBased(word) >> (pos % CHAR_BIT);
+    return static_cast<uint32_t>(word & bits::GetFullMask(numBits));
+  }
+
+  // CentersTable overrides:
+  bool Init() override
+  {
+    MemReader reader(m_region->ImmutableData(), m_region->Size());
+    if (reader.Size() < sizeof(m_header))
+      return false;
+    m_header.Read(reader);
+
+    if (!m_header.IsValid() || m_header.m_endOffset > m_region->Size())
+      return false;
+
+    uint8_t const * data = m_region->ImmutableData();
+    {
+      bool const isHostBigEndian = IsBigEndianMacroBased();
+      bool const isDataBigEndian = m_header.m_base.m_endianness == 1;
+      uint8_t const * ids = data + sizeof(m_header);
+
+      bool const endiannesMismatch = isHostBigEndian != isDataBigEndian;
+
+      // Succinct structures are mapped from 8-byte aligned memory only.
+      if (endiannesMismatch || !coding::IsAlign8(reinterpret_cast<uintptr_t>(ids)))
+      {
+        vector<uint8_t> idsData(ids, data + m_header.m_blocksOffset);
+        m_idsRegion = make_unique<CopiedMemoryRegion>(move(idsData));
+        EndiannessAwareMap(endiannesMismatch, *m_idsRegion, m_ids);
+      }
+      else
+      {
+        succinct::rs_bit_vector bv;
+        coding::MapVisitor visitor(ids);
+        bv.map(visitor);
+        bv.swap(m_ids);
+      }
+    }
+
+    uint64_t const blocksCount = (m_ids.num_ones() + kBlockSize - 1) / kBlockSize;
+    if (blocksCount * kBlockDescSize != m_header.m_valuesOffset - m_header.m_blocksOffset)
+    {
+      LOG(LERROR, ("Wrong size of blocks table:", blocksCount, m_header.m_blocksOffset,
+                   m_header.m_valuesOffset));
+      return false;
+    }
+
+    m_blocks = data + m_header.m_blocksOffset;
+    m_values = data + m_header.m_valuesOffset;
+    return true;
+  }
+
+  Header m_header;
+  unique_ptr<MemoryRegion> m_region;
+  serial::GeometryCodingParams const m_codingParams;
+
+  // A copy of the identifiers table when it can't be mapped right from |m_region|.
+  unique_ptr<CopiedMemoryRegion> m_idsRegion;
+  succinct::rs_bit_vector m_ids;
+
+  uint8_t const * m_blocks = nullptr;
+  uint8_t const * m_values = nullptr;
+};
 }  // namespace
 
 // CentersTable::Header ----------------------------------------------------------------------------
@@ -253,13 +473,39 @@ unique_ptr<CentersTable> CentersTable::Load(Reader & reader,
                                             serial::GeometryCodingParams const & codingParams)
 {
   uint16_t const version = ReadPrimitiveFromPos<uint16_t>(reader, 0 /* pos */);
-  if (version != 0)
+
+  unique_ptr<CentersTable> table;
+  switch (static_cast<Version>(version))
+  {
+  case Version::V0: table = make_unique<CentersTableV0>(reader, codingParams); break;
+  case Version::V1:
+  {
+    vector<uint8_t> data(static_cast<size_t>(reader.Size()));
+    reader.Read(0 /* pos */, data.data(), data.size());
+    table = make_unique<CentersTableV1>(make_unique<CopiedMemoryRegion>(move(data)), codingParams);
+    break;
+  }
+  default: return unique_ptr<CentersTable>();
+  }
+
+  if (!table->Init())
     return unique_ptr<CentersTable>();
+  return table;
+}
 
-  // Only single version of centers table is supported now.  If you
-  // need to implement new versions of CentersTable, implement
-  // dispatching based on first-four-bytes version.
-  unique_ptr<CentersTable> table = make_unique<CentersTableV0>(reader, codingParams);
+unique_ptr<CentersTable> CentersTable::Load(unique_ptr<MemoryRegion> region,
+                                            serial::GeometryCodingParams const & codingParams)
+{
+  CHECK(region, ());
+  if (region->Size() < sizeof(Header))
+    return unique_ptr<CentersTable>();
+
+  uint16_t version;
+  memcpy(&version, region->ImmutableData(), sizeof(version));
+  if (static_cast<Version>(SwapIfBigEndianMacroBased(version)) != Version::V1)
+    return unique_ptr<CentersTable>();
+
+  unique_ptr<CentersTable> table = make_unique<CentersTableV1>(move(region), codingParams);
   if (!table->Init())
     return unique_ptr<CentersTable>();
   return table;
@@ -275,23 +521,24 @@ void CentersTableBuilder::Put(uint32_t featureId, m2::PointD const & center)
   m_ids.push_back(featureId);
 }
 
-void CentersTableBuilder::Freeze(Writer & writer) const
+void CentersTableBuilder::Freeze(Writer & writer, CentersTable::Version version) const
+{
+  switch (version)
+  {
+  case CentersTable::Version::V0: FreezeV0(writer); return;
+  case CentersTable::Version::V1: FreezeV1(writer); return;
+  }
+  CHECK(false, ("Unknown version", static_cast<int>(version)));
+}
+
+void CentersTableBuilder::FreezeV0(Writer & writer) const
 {
   CentersTableV0::Header header;
 
   auto const startOffset = writer.Pos();
   header.Write(writer);
 
-  {
-    uint64_t const numBits = m_ids.empty() ? 0 : m_ids.back() + 1;
-
-    succinct::bit_vector_builder builder(numBits);
-    for (auto const & id : m_ids)
-      builder.set(id, true);
-
-    coding::FreezeVisitor<Writer> visitor(writer);
-    succinct::rs_bit_vector(&builder).map(visitor);
-  }
+  FreezeIds(writer);
 
   vector<uint32_t> offsets;
   vector<uint8_t> deltas;
@@ -336,4 +583,76 @@ void CentersTableBuilder::Freeze(Writer & writer) const
   header.Write(writer);
   writer.Seek(endOffset);
 }
+
+void CentersTableBuilder::FreezeV1(Writer & writer) const
+{
+  CentersTableV1::Header header;
+  header.m_base.m_version = static_cast<uint16_t>(CentersTable::Version::V1);
+
+  auto const startOffset = writer.Pos();
+  header.Write(writer);
+
+  FreezeIds(writer);
+
+  vector<uint8_t> values;
+  {
+    header.m_blocksOffset = base::checked_cast<uint32_t>(writer.Pos() - startOffset);
+
+    MemWriter<vector<uint8_t>> valuesWriter(values);
+    for (size_t i = 0; i < m_centers.size(); i += CentersTableV1::kBlockSize)
+    {
+      auto const end = min(i + CentersTableV1::kBlockSize, m_centers.size());
+
+      CentersTableV1::Block block;
+      block.m_minX = block.m_minY = numeric_limits<uint32_t>::max();
+      uint32_t maxX = 0;
+      uint32_t maxY = 0;
+      for (size_t j = i; j < end; ++j)
+      {
+        block.m_minX = min(block.m_minX, m_centers[j].x);
+        block.m_minY = min(block.m_minY, m_centers[j].y);
+        maxX = max(maxX, m_centers[j].x);
+        maxY = max(maxY, m_centers[j].y);
+      }
+      block.m_xBits = static_cast<uint8_t>(bits::NumUsedBits(maxX - block.m_minX));
+      block.m_yBits = static_cast<uint8_t>(bits::NumUsedBits(maxY - block.m_minY));
+      block.m_offset = base::checked_cast<uint32_t>(values.size());
+      block.Write(writer);
+
+      // Each block starts at a byte boundary, the bit writer is flushed at the end of scope.
+      BitWriter<MemWriter<vector<uint8_t>>> bitWriter(valuesWriter);
+      for (size_t j = i; j < end; ++j)
+      {
+        bitWriter.WriteAtMost32Bits(m_centers[j].x - block.m_minX, block.m_xBits);
+        bitWriter.WriteAtMost32Bits(m_centers[j].y - block.m_minY, block.m_yBits);
+      }
+    }
+  }
+
+  {
+    header.m_valuesOffset = base::checked_cast<uint32_t>(writer.Pos() - startOffset);
+    values.resize(values.size() + CentersTableV1::kPaddingSize, 0);
+    writer.Write(values.data(), values.size());
+    header.m_endOffset = base::checked_cast<uint32_t>(writer.Pos() - startOffset);
+  }
+
+  auto const endOffset = writer.Pos();
+
+  writer.Seek(startOffset);
+  CHECK_EQUAL(header.m_base.m_endianness, 0, ("|m_endianness| should be set to little-endian."));
+  header.Write(writer);
+  writer.Seek(endOffset);
+}
+
+void CentersTableBuilder::FreezeIds(Writer & writer) const
+{
+  uint64_t const numBits = m_ids.empty() ? 0 : m_ids.back() + 1;
+
+  succinct::bit_vector_builder builder(numBits);
+  for (auto const & id : m_ids)
+    builder.set(id, true);
+
+  coding::FreezeVisitor<Writer> visitor(writer);
+  succinct::rs_bit_vector(&builder).map(visitor);
+}
 }  // namespace search
@@ -9,6 +9,7 @@
 #include <vector>
 
 class FilesContainerR;
+class MemoryRegion;
 class Reader;
 class Writer;
 
@@ -32,6 +33,16 @@ namespace search
 class CentersTable
 {
 public:
+  enum class Version : uint16_t
+  {
+    // Delta-coded blocks of centers, a block is decoded and cached on access.
+    V0 = 0,
+    // Bit-packed centers with fixed width in a block, any center is read without decoding
+    // of its block.
+    V1 = 1,
+    Latest = V1
+  };
+
   struct Header
   {
     void Read(Reader & reader);
@@ -56,6 +67,11 @@ public:
   static std::unique_ptr<CentersTable> Load(Reader & reader,
                                             serial::GeometryCodingParams const & codingParams);
 
+  // Loads CentersTable instance which works right over |region|, e.g. over a mapped section.
+  // Only V1 tables in the host endianness can be loaded this way, returns nullptr otherwise.
+  static std::unique_ptr<CentersTable> Load(std::unique_ptr<MemoryRegion> region,
+                                            serial::GeometryCodingParams const & codingParams);
+
 private:
   virtual bool Init() = 0;
 };
@@ -69,9 +85,15 @@ public:
   }
 
   void Put(uint32_t featureId, m2::PointD const & center);
-  void Freeze(Writer & writer) const;
+  void Freeze(Writer & writer, CentersTable::Version version = CentersTable::Version::Latest) const;
 
 private:
+  void FreezeV0(Writer & writer) const;
+  void FreezeV1(Writer & writer) const;
+
+  // Writes the identifiers table.
+  void FreezeIds(Writer & writer) const;
+
   serial::GeometryCodingParams m_codingParams;
 
   std::vector<m2::PointU> m_centers;
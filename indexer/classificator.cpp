@@ -2,6 +2,11 @@
 #include "indexer/map_style_reader.hpp"
 #include "indexer/tree_structure.hpp"
 
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/string_utils.hpp"
@@ -20,6 +25,14 @@ namespace
     bool operator() (int l, drule::Key const & r) const { return l < r.m_scale; }
     bool operator() (drule::Key const & l, drule::Key const & r) const { return l.m_scale < r.m_scale; }
   };
+
+  // The compiled form:
+  //   [kCompiledTag] [1: version]
+  //   [the tree in the preorder: [vu: name size] [name] [vu: number of children] [children]]
+  //   [vu: number of types] [vu: type for the index 0] ...
+  char const kCompiledTag[] = "MWM_CLASSIFICATOR";
+  size_t constexpr kCompiledTagSize = sizeof(kCompiledTag) - 1;
+  uint8_t constexpr kCompiledVersion = 0;
 }  // namespace
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -373,6 +386,61 @@ void Classificator::ReadClassificator(istream & s)
   m_coastType = GetTypeByPath({ "natural", "coastline" });
 }
 
+void Classificator::WriteCompiled(Writer & writer) const
+{
+  writer.Write(kCompiledTag, kCompiledTagSize);
+  WriteToSink(writer, kCompiledVersion);
+
+  WriteTree(m_root, writer);
+
+  auto const & types = m_mapping.GetTypes();
+  WriteVarUint(writer, types.size());
+  for (auto const type : types)
+    WriteVarUint(writer, type);
+}
+
+void Classificator::ReadCompiled(Reader const & reader)
+{
+  Clear();
+
+  NonOwningReaderSource source(reader);
+  string tag(kCompiledTagSize, '\0');
+  source.Read(&tag[0], tag.size());
+  CHECK_EQUAL(tag, kCompiledTag, ());
+  auto const version = ReadPrimitiveFromSource<uint8_t>(source);
+  CHECK_EQUAL(version, kCompiledVersion, ());
+
+  ReadTree(source, m_root);
+
+  vector<uint32_t> types(ReadVarUint<uint32_t>(source));
+  for (auto & type : types)
+    type = ReadVarUint<uint32_t>(source);
+  m_mapping.Load(types);
+  CHECK_EQUAL(source.Size(), 0, ());
+
+  m_coastType = GetTypeByPath({ "natural", "coastline" });
+}
+
+// static
+void Classificator::WriteTree(ClassifObject const & obj, Writer & writer)
+{
+  WriteVarUint(writer, obj.m_name.size());
+  writer.Write(obj.m_name.data(), obj.m_name.size());
+  WriteVarUint(writer, obj.m_objs.size());
+  for (auto const & child : obj.m_objs)
+    WriteTree(child, writer);
+}
+
+// static
+void Classificator::ReadTree(NonOwningReaderSource & source, ClassifObject & obj)
+{
+  obj.m_name.resize(ReadVarUint<uint32_t>(source));
+  source.Read(&obj.m_name[0], obj.m_name.size());
+  obj.m_objs.resize(ReadVarUint<uint32_t>(source));
+  for (auto & child : obj.m_objs)
+    ReadTree(source, child);
+}
+
 template <typename Iter>
 uint32_t Classificator::GetTypeByPathImpl(Iter beg, Iter end) const
 {
@@ -16,6 +16,9 @@
 #include <vector>
 
 class ClassifObject;
+class NonOwningReaderSource;
+class Reader;
+class Writer;
 
 namespace ftype
 {
@@ -144,6 +147,8 @@ public:
   //@}
 
 private:
+  friend class Classificator;
+
   std::string m_name;
   std::vector<drule::Key> m_drawRule;
   std::vector<ClassifObject> m_objs;
@@ -166,6 +171,11 @@ public:
   //@{
   void ReadClassificator(std::istream & s);
   void ReadTypesMapping(std::istream & s);
+
+  // The compiled form contains the tree and the types mapping without drawing rules, which
+  // depend on the map style. It is read much faster than the text files.
+  void WriteCompiled(Writer & writer) const;
+  void ReadCompiled(Reader const & reader);
   //@}
 
   void Clear();
@@ -233,6 +243,9 @@ private:
   template <typename Iter>
   uint32_t GetTypeByPathImpl(Iter beg, Iter end) const;
 
+  static void WriteTree(ClassifObject const & obj, Writer & writer);
+  static void ReadTree(NonOwningReaderSource & source, ClassifObject & obj);
+
   ClassifObject m_root;
   IndexAndTypeMapping m_mapping;
   uint32_t m_coastType;
@@ -7,12 +7,14 @@
 
 #include "coding/reader.hpp"
 #include "coding/reader_streambuf.hpp"
+#include "coding/writer.hpp"
 
 #include "base/logging.hpp"
 
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -50,6 +52,9 @@ void Load()
 
   MapStyle const originMapStyle = GetStyleReader().GetCurrentStyle();
 
+  // The text files are the same for all styles, they are parsed once and the classificator
+  // is restored from the compiled form for other styles.
+  std::vector<uint8_t> compiled;
   for (size_t i = 0; i < MapStyleCount; ++i)
   {
     auto const mapStyle = static_cast<MapStyle>(i);
@@ -57,8 +62,17 @@ void Load()
     if (mapStyle != MapStyleMerged || originMapStyle == MapStyleMerged)
     {
       GetStyleReader().SetCurrentStyle(mapStyle);
-      ReadCommon(p.GetReader("classificator.txt"),
-                 p.GetReader("types.txt"));
+      if (compiled.empty())
+      {
+        ReadCommon(p.GetReader("classificator.txt"),
+                   p.GetReader("types.txt"));
+        MemWriter<std::vector<uint8_t>> writer(compiled);
+        classif().WriteCompiled(writer);
+      }
+      else
+      {
+        classif().ReadCompiled(MemReader(compiled.data(), compiled.size()));
+      }
 
       drule::LoadRules();
     }
@@ -108,6 +108,7 @@ namespace feature
   void DataHeader::Load(FilesContainerR const & cont)
   {
     ModelReaderPtr headerReader = cont.GetReader(HEADER_FILE_TAG);
+    headerReader.Advise(ModelReader::Advice::WillNeed);
     version::MwmVersion version;
 
     if (version::ReadVersion(cont, version))
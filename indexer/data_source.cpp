@@ -36,7 +36,7 @@ public:
       feature::DataHeader const & header = mwmValue->GetHeader();
       CheckUniqueIndexes checkUnique(header.GetFormat() >= version::Format::v5);
 
-      // In case of WorldCoasts we should pass correct scale in ForEachInIntervalAndScale.
+      // In case of WorldCoasts we should pass correct scale in ForEachInIntervalsAndScale.
       auto const lastScale = header.GetLastScale();
       if (scale > lastScale)
         scale = lastScale;
@@ -45,15 +45,11 @@ public:
       covering::Intervals const & intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
       ScaleIndex<ModelReaderPtr> index(mwmValue->m_cont.GetReader(INDEX_FILE_TAG), mwmValue->m_factory);
 
-      // iterate through intervals
-      for (auto const & i : intervals)
-      {
-        index.ForEachInIntervalAndScale(i.first, i.second, scale, [&](uint32_t index) {
-          if (!checkUnique(index))
-            return;
-          m_fn(index, *src);
-        });
-      }
+      index.ForEachInIntervalsAndScale(intervals, scale, [&](uint32_t index) {
+        if (!checkUnique(index))
+          return;
+        m_fn(index, *src);
+      });
     }
     // Check created features container.
     // Need to do it on a per-mwm basis, because Drape relies on features in a sorted order.
@@ -67,9 +63,10 @@ private:
   Fn m_fn;
 };
 
-void ReadFeatureType(function<void(FeatureType &)> const & fn, FeatureSource & src, uint32_t index)
+// |feature| is reused for all features read by one call, so its memory is allocated once.
+void ReadFeatureType(function<void(FeatureType &)> const & fn, FeatureSource & src, uint32_t index,
+                     FeatureType & feature)
 {
-  FeatureType feature;
   switch (src.GetFeatureStatus(index))
   {
   case FeatureStatus::Deleted:
@@ -151,22 +148,35 @@ WARN_UNUSED_RESULT bool FeaturesLoaderGuard::GetOriginalFeatureByIndex(uint32_t
 // DataSource ----------------------------------------------------------------------------------
 unique_ptr<MwmInfo> DataSource::CreateInfo(platform::LocalCountryFile const & localFile) const
 {
-  MwmValue value(localFile);
+  auto info = make_unique<MwmInfoEx>();
+  MwmInfoCache::Entry entry;
 
-  feature::DataHeader const & h = value.GetHeader();
-  if (!h.IsMWMSuitable())
-    return nullptr;
+  MwmInfoCache * infoCache = m_infoCache;
+  if (!infoCache || !infoCache->Find(localFile, entry))
+  {
+    MwmValue value(localFile);
 
-  auto info = make_unique<MwmInfoEx>();
-  info->m_bordersRect = h.GetBounds();
+    feature::DataHeader const & h = value.GetHeader();
+    if (!h.IsMWMSuitable())
+      return nullptr;
 
-  pair<int, int> const scaleR = h.GetScaleRange();
-  info->m_minScale = static_cast<uint8_t>(scaleR.first);
-  info->m_maxScale = static_cast<uint8_t>(scaleR.second);
-  info->m_version = value.GetMwmVersion();
-  // Copying to drop the const qualifier.
-  feature::RegionData regionData(value.GetRegionData());
-  info->m_data = regionData;
+    entry.m_bordersRect = h.GetBounds();
+
+    pair<int, int> const scaleR = h.GetScaleRange();
+    entry.m_minScale = static_cast<uint8_t>(scaleR.first);
+    entry.m_maxScale = static_cast<uint8_t>(scaleR.second);
+    entry.m_version = value.GetMwmVersion();
+    entry.m_data = value.GetRegionData();
+
+    if (infoCache)
+      infoCache->Put(localFile, entry);
+  }
+
+  info->m_bordersRect = entry.m_bordersRect;
+  info->m_minScale = entry.m_minScale;
+  info->m_maxScale = entry.m_maxScale;
+  info->m_version = entry.m_version;
+  info->m_data = move(entry.m_data);
 
   return unique_ptr<MwmInfo>(move(info));
 }
@@ -176,8 +186,16 @@ unique_ptr<MwmSet::MwmValueBase> DataSource::CreateValue(MwmInfo & info) const
   // Create a section with rank table if it does not exist.
   platform::LocalCountryFile const & localFile = info.GetLocalFile();
   unique_ptr<MwmValue> p(new MwmValue(localFile));
+
+  // The info may be taken from MwmInfoCache without opening the file, so the file is checked
+  // here. The exception deregisters the mwm, see MwmSet::LockValue().
+  if (!p->GetHeader().IsMWMSuitable() ||
+      p->GetMwmVersion().GetSecondsSinceEpoch() != info.m_version.GetSecondsSinceEpoch())
+  {
+    MYTHROW(StaleInfoException, ("Mwm", localFile, "doesn't match its registered info."));
+  }
+
   p->SetTable(dynamic_cast<MwmInfoEx &>(info));
-  ASSERT(p->GetHeader().IsMWMSuitable(), ());
   return unique_ptr<MwmSet::MwmValueBase>(move(p));
 }
 
@@ -186,20 +204,36 @@ pair<MwmSet::MwmId, MwmSet::RegResult> DataSource::RegisterMap(LocalCountryFile
   return Register(localFile);
 }
 
+vector<pair<MwmSet::MwmId, MwmSet::RegResult>> DataSource::RegisterMaps(
+    vector<LocalCountryFile> const & localFiles, MwmInfoCache * infoCache, size_t threadsCount)
+{
+  m_infoCache = infoCache;
+  auto results = Register(localFiles, threadsCount);
+  m_infoCache = nullptr;
+  return results;
+}
+
 bool DataSource::DeregisterMap(CountryFile const & countryFile) { return Deregister(countryFile); }
 
 void DataSource::ForEachInIntervals(ReaderCallback const & fn, covering::CoveringMode mode,
                                     m2::RectD const & rect, int scale) const
 {
-  vector<shared_ptr<MwmInfo>> mwms;
-  GetMwmsInfo(mwms);
+  covering::CoveringGetter cov(rect, mode, &m_coveringCache);
+  ForEachInIntervals(fn, cov, scale);
+}
 
-  covering::CoveringGetter cov(rect, mode);
+void DataSource::ForEachInIntervals(ReaderCallback const & fn, covering::CoveringGetter & cov,
+                                    int scale) const
+{
+  // The request reads the mwms of the snapshot even if the registry is changed meanwhile.
+  auto const snapshot = GetSnapshot();
 
+  m2::RectD const & rect = cov.GetRect();
   MwmId worldID[2];
 
-  for (shared_ptr<MwmInfo> const & info : mwms)
+  for (auto const & p : *snapshot)
   {
+    shared_ptr<MwmInfo> const & info = p.second;
     if (info->m_minScale <= scale && scale <= info->m_maxScale &&
         rect.IsIntersect(info->m_bordersRect))
     {
@@ -234,18 +268,33 @@ void DataSource::ForEachFeatureIDInRect(FeatureIdCallback const & f, m2::RectD c
 
 void DataSource::ForEachInRect(FeatureCallback const & f, m2::RectD const & rect, int scale) const
 {
-  auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-    ReadFeatureType(f, src, index);
+  FeatureType feature;
+  auto readFeatureType = [&f, &feature](uint32_t index, FeatureSource & src) {
+    ReadFeatureType(f, src, index, feature);
   };
 
   ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
   ForEachInIntervals(readFunctor, covering::ViewportWithLowLevels, rect, scale);
 }
 
+void DataSource::ForEachInRectExcept(FeatureCallback const & f, m2::RectD const & rect,
+                                     m2::RectD const & prevRect, int scale) const
+{
+  FeatureType feature;
+  auto readFeatureType = [&f, &feature](uint32_t index, FeatureSource & src) {
+    ReadFeatureType(f, src, index, feature);
+  };
+
+  ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
+  covering::CoveringGetter cov(rect, prevRect, &m_coveringCache);
+  ForEachInIntervals(readFunctor, cov, scale);
+}
+
 void DataSource::ForEachInScale(FeatureCallback const & f, int scale) const
 {
-  auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-    ReadFeatureType(f, src, index);
+  FeatureType feature;
+  auto readFeatureType = [&f, &feature](uint32_t index, FeatureSource & src) {
+    ReadFeatureType(f, src, index, feature);
   };
 
   ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
@@ -259,8 +308,9 @@ void DataSource::ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const
   if (handle.IsAlive())
   {
     covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
-    auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-      ReadFeatureType(f, src, index);
+    FeatureType feature;
+    auto readFeatureType = [&f, &feature](uint32_t index, FeatureSource & src) {
+      ReadFeatureType(f, src, index, feature);
     };
     ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
     readFunctor(handle, cov, scale);
@@ -281,19 +331,33 @@ void DataSource::ReadFeatures(FeatureCallback const & fn, vector<FeatureID> cons
     {
       // Prepare features reading.
       auto src = (*m_factory)(handle);
+      FeatureType featureType;
+      // Runs of original features are read in batches. Features are passed to |fn| in the order
+      // of |features|, so a pending run is read before any edited feature.
+      vector<uint32_t> originalIndices;
+      auto const readOriginalFeatures = [&]()
+      {
+        src->ForEachOriginalFeature(originalIndices, featureType, fn);
+        originalIndices.clear();
+      };
       do
       {
         auto const fts = src->GetFeatureStatus(fidIter->m_index);
         ASSERT_NOT_EQUAL(
             FeatureStatus::Deleted, fts,
             ("Deleted feature was cached. It should not be here. Please review your code."));
-        FeatureType featureType;
         if (fts == FeatureStatus::Modified || fts == FeatureStatus::Created)
+        {
+          readOriginalFeatures();
           VERIFY(src->GetModifiedFeature(fidIter->m_index, featureType), ());
+          fn(featureType);
+        }
         else
-          src->GetOriginalFeature(fidIter->m_index, featureType);
-        fn(featureType);
+        {
+          originalIndices.push_back(fidIter->m_index);
+        }
       } while (++fidIter != endIter && id == fidIter->m_mwmId);
+      readOriginalFeatures();
     }
     else
     {
@@ -6,14 +6,17 @@
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/feature_source.hpp"
 #include "indexer/features_vector.hpp"
+#include "indexer/mwm_info_cache.hpp"
 #include "indexer/mwm_set.hpp"
 #include "indexer/scale_index.hpp"
 #include "indexer/unique_index.hpp"
 
 #include "coding/file_container.hpp"
 
+#include "base/exception.hpp"
 #include "base/macros.hpp"
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -30,9 +33,19 @@ public:
 
   ~DataSource() override = default;
 
+  DECLARE_EXCEPTION(StaleInfoException, RootException);
+
   /// Registers a new map.
   std::pair<MwmId, RegResult> RegisterMap(platform::LocalCountryFile const & localFile);
 
+  /// Registers |localFiles| by |threadsCount| threads, see MwmSet::Register(). Infos of files
+  /// which are not changed since they were put to |infoCache| are taken from the cache
+  /// without opening the files, such files are validated when they are used for the first
+  /// time. Infos of other files are put to |infoCache|. |infoCache| may be nullptr.
+  std::vector<std::pair<MwmId, RegResult>> RegisterMaps(
+      std::vector<platform::LocalCountryFile> const & localFiles, MwmInfoCache * infoCache,
+      size_t threadsCount);
+
   /// Deregisters a map from internal records.
   ///
   /// \param countryFile A countryFile denoting a map to be deregistered.
@@ -42,6 +55,12 @@ public:
 
   void ForEachFeatureIDInRect(FeatureIdCallback const & f, m2::RectD const & rect, int scale) const;
   void ForEachInRect(FeatureCallback const & f, m2::RectD const & rect, int scale) const;
+  // Reads features of |rect| which are out of |prevRect|, e.g. when a viewport is moved and the
+  // features of |prevRect| were read with the same |scale|. Only index cells of |rect| covering
+  // which are not in |prevRect| covering are read. Created and edited features are read for
+  // the whole |rect|.
+  void ForEachInRectExcept(FeatureCallback const & f, m2::RectD const & rect,
+                           m2::RectD const & prevRect, int scale) const;
   void ForEachInScale(FeatureCallback const & f, int scale) const;
   void ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const & rect, int scale,
                            MwmId const & id) const;
@@ -61,6 +80,8 @@ protected:
 
   void ForEachInIntervals(ReaderCallback const & fn, covering::CoveringMode mode,
                           m2::RectD const & rect, int scale) const;
+  void ForEachInIntervals(ReaderCallback const & fn, covering::CoveringGetter & cov,
+                          int scale) const;
 
   /// MwmSet overrides:
   std::unique_ptr<MwmInfo> CreateInfo(platform::LocalCountryFile const & localFile) const override;
@@ -70,6 +91,9 @@ private:
   friend class FeaturesLoaderGuard;
 
   std::unique_ptr<FeatureSourceFactory> m_factory;
+  // Is set only while RegisterMaps() works.
+  std::atomic<MwmInfoCache *> m_infoCache{nullptr};
+  mutable covering::CoveringCache m_coveringCache;
 };
 
 // DataSource which operates with features from mwm file and does not support features creation
@@ -0,0 +1,112 @@
+#include "indexer/decoded_geometry_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+namespace feature
+{
+bool DecodedGeometryCache::Key::operator<(Key const & rhs) const
+{
+  return tie(m_id, m_scaleIndex, m_kind) < tie(rhs.m_id, rhs.m_scaleIndex, rhs.m_kind);
+}
+
+size_t constexpr DecodedGeometryCache::kDefaultMemorySize;
+size_t constexpr DecodedGeometryCache::kShardsCount;
+
+DecodedGeometryCache::DecodedGeometryCache(size_t maxMemorySize)
+{
+  m_shards.reserve(kShardsCount);
+  for (size_t i = 0; i < kShardsCount; ++i)
+    m_shards.emplace_back(make_unique<Shard>(maxMemorySize / kShardsCount));
+}
+
+// static
+DecodedGeometryCache & DecodedGeometryCache::Instance()
+{
+  static DecodedGeometryCache cache(kDefaultMemorySize);
+  return cache;
+}
+
+DecodedGeometryCache::GeometryPtr DecodedGeometryCache::Get(Key const & key)
+{
+  auto & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_lock);
+  auto const * geometry = shard.m_cache.Find(key);
+  if (!geometry)
+  {
+    ++shard.m_stats.m_misses;
+    return nullptr;
+  }
+
+  ++shard.m_stats.m_hits;
+  return *geometry;
+}
+
+void DecodedGeometryCache::Put(Key const & key, GeometryPtr geometry)
+{
+  CHECK(geometry, ());
+  // Approximate size of the entry of the cache and of the geometry.
+  size_t const memorySize = sizeof(Key) + sizeof(GeometryPtr) + 4 * sizeof(void *) +
+                            sizeof(Geometry) + geometry->m_points.capacity() * sizeof(m2::PointD);
+
+  auto & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_lock);
+  shard.m_cache.Put(key, move(geometry), memorySize);
+}
+
+void DecodedGeometryCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard->m_lock);
+    shard->m_cache.Clear();
+  }
+}
+
+size_t DecodedGeometryCache::GetSize() const
+{
+  size_t size = 0;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard->m_lock);
+    size += shard->m_cache.GetSize();
+  }
+  return size;
+}
+
+size_t DecodedGeometryCache::GetMemorySize() const
+{
+  size_t size = 0;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard->m_lock);
+    size += shard->m_cache.GetMemorySize();
+  }
+  return size;
+}
+
+DecodedGeometryCache::Stats DecodedGeometryCache::GetStats() const
+{
+  Stats stats;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard->m_lock);
+    stats.m_hits += shard->m_stats.m_hits;
+    stats.m_misses += shard->m_stats.m_misses;
+  }
+  return stats;
+}
+
+DecodedGeometryCache::Shard & DecodedGeometryCache::GetShard(Key const & key)
+{
+  size_t const h = hash<MwmInfo const *>()(key.m_id.m_mwmId.GetInfo().get()) ^
+                   hash<uint32_t>()(key.m_id.m_index);
+  return *m_shards[h % kShardsCount];
+}
+}  // namespace feature
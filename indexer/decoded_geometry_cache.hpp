@@ -0,0 +1,95 @@
+#pragma once
+
+#include "indexer/feature_decl.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/macros.hpp"
+#include "base/memory_lru_cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace feature
+{
+// Memory-bounded cache of outer geometry of features, which is decoded from geometry and
+// triangles sections of mwms. Drape, routing and search load geometry of the same features
+// again and again, and FeatureType takes decoded points from here instead of decoding them.
+//
+// Geometry is keyed by the feature and the index of its geometry in the mwm, so it doesn't
+// depend on a file of an mwm: a new version of the mwm has another MwmId. Entries are spread
+// over shards with own locks, each shard evicts least recently used entries.
+// This class is thread-safe.
+class DecodedGeometryCache
+{
+public:
+  enum class Kind : uint8_t
+  {
+    Points,
+    Triangles
+  };
+
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+
+    ::FeatureID m_id;
+    int m_scaleIndex = 0;
+    Kind m_kind = Kind::Points;
+  };
+
+  struct Geometry
+  {
+    std::vector<m2::PointD> m_points;
+    // Size of the encoded geometry in the section, in bytes.
+    uint32_t m_encodedSize = 0;
+  };
+
+  // A view of cached geometry. It stays valid after the geometry is evicted.
+  using GeometryPtr = std::shared_ptr<Geometry const>;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  static size_t constexpr kDefaultMemorySize = 32 * 1024 * 1024;
+
+  explicit DecodedGeometryCache(size_t maxMemorySize);
+
+  static DecodedGeometryCache & Instance();
+
+  // Returns nullptr when the geometry is not cached.
+  GeometryPtr Get(Key const & key);
+  void Put(Key const & key, GeometryPtr geometry);
+
+  void Clear();
+
+  size_t GetSize() const;
+  size_t GetMemorySize() const;
+  // Returns hits and misses of Get() since the cache is created.
+  Stats GetStats() const;
+
+private:
+  static size_t constexpr kShardsCount = 8;
+
+  struct Shard
+  {
+    explicit Shard(size_t maxMemorySize) : m_cache(maxMemorySize) {}
+
+    mutable std::mutex m_lock;
+    base::MemoryLruCache<Key, GeometryPtr> m_cache;
+    Stats m_stats;
+  };
+
+  Shard & GetShard(Key const & key);
+
+  std::vector<std::unique_ptr<Shard>> m_shards;
+
+  DISALLOW_COPY_AND_MOVE(DecodedGeometryCache);
+};
+}  // namespace feature
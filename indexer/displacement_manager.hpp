@@ -50,7 +50,16 @@ public:
   CellFeaturePair const & GetCellFeaturePair() const { return m_pair; }
   uint32_t GetBucket() const { return m_bucket; }
 
+  // See RadixSortKey in coding/file_sort.hpp. Cells take less than kBucketShift bits.
+  uint64_t GetSortKey() const
+  {
+    ASSERT_LESS(m_pair.GetCell(), uint64_t{1} << kBucketShift, ());
+    return (static_cast<uint64_t>(m_bucket) << kBucketShift) | m_pair.GetCell();
+  }
+
 private:
+  static uint8_t constexpr kBucketShift = 56;
+
   CellFeaturePair m_pair;
   uint32_t m_bucket;
 };
@@ -1,6 +1,7 @@
 #include "indexer/feature.hpp"
 
 #include "indexer/classificator.hpp"
+#include "indexer/decoded_geometry_cache.hpp"
 #include "indexer/editable_map_object.hpp"
 #include "indexer/feature_algo.hpp"
 #include "indexer/feature_impl.hpp"
@@ -190,6 +191,8 @@ void FeatureType::Deserialize(SharedLoadInfo const * loadInfo, Buffer buffer)
   m_offsets.Reset();
   m_ptsSimpMask = 0;
   m_limitRect = m2::RectD::GetEmptyRect();
+  m_points.clear();
+  m_triangles.clear();
   m_parsed.Reset();
   m_innerStats.MakeZero();
 }
@@ -256,7 +259,20 @@ void FeatureType::ParseCommon()
 
   ArrayByteSource source(m_data + m_offsets.m_common);
   uint8_t const h = Header(m_data);
-  m_params.Read(source, h);
+
+  // Names are skipped here and read by ParseNames on demand.
+  if (h & HEADER_HAS_NAME)
+  {
+    m_offsets.m_names = CalcOffset(source, m_data);
+    uint32_t const namesSize = ReadVarUint<uint32_t>(source) + 1;
+    source.Advance(namesSize);
+  }
+
+  m_params.layer = 0;
+  m_params.rank = 0;
+  m_params.ref.clear();
+  m_params.house.Clear();
+  m_params.Read(source, static_cast<uint8_t>(h & ~HEADER_HAS_NAME));
 
   if (GetFeatureType() == GEOM_POINT)
   {
@@ -308,6 +324,7 @@ void FeatureType::ReplaceBy(osm::EditableMapObject const & emo)
   else
     m_params.house.Set(house);
   m_parsed.m_common = true;
+  m_parsed.m_names = true;
 
   m_metadata = emo.GetMetadata();
   m_parsed.m_metadata = true;
@@ -326,6 +343,7 @@ void FeatureType::ParseEverything()
 {
   // Also calls ParseCommon() and ParseTypes().
   ParseHeader2();
+  ParseNames();
   ParseGeometry(FeatureType::BEST_GEOMETRY);
   ParseTriangles(FeatureType::BEST_GEOMETRY);
   ParseMetadata();
@@ -436,14 +454,17 @@ uint32_t FeatureType::ParseGeometry(int scale)
         int const ind = GetScaleIndex(*m_loadInfo, scale, m_offsets.m_pts);
         if (ind != -1)
         {
-          ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetGeometryReader(ind));
-          src.Skip(m_offsets.m_pts[ind]);
+          sz = LoadOuterGeometry(DecodedGeometryCache::Kind::Points, ind, [&]()
+          {
+            ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetGeometryReader(ind));
+            src.Skip(m_offsets.m_pts[ind]);
 
-          serial::GeometryCodingParams cp = m_loadInfo->GetGeometryCodingParams(ind);
-          cp.SetBasePoint(m_points[0]);
-          serial::LoadOuterPath(src, cp, m_points);
+            serial::GeometryCodingParams cp = m_loadInfo->GetGeometryCodingParams(ind);
+            cp.SetBasePoint(m_points[0]);
+            serial::LoadOuterPath(src, cp, m_points);
 
-          sz = static_cast<uint32_t>(src.Pos() - m_offsets.m_pts[ind]);
+            return static_cast<uint32_t>(src.Pos() - m_offsets.m_pts[ind]);
+          });
         }
       }
       else
@@ -475,6 +496,32 @@ uint32_t FeatureType::ParseGeometry(int scale)
   return sz;
 }
 
+template <typename Decode>
+uint32_t FeatureType::LoadOuterGeometry(DecodedGeometryCache::Kind kind, int scaleIndex,
+                                        Decode && decode)
+{
+  auto & points = kind == DecodedGeometryCache::Kind::Points ? m_points : m_triangles;
+
+  // Features which are not bound to an mwm can't be told apart in the cache.
+  if (!m_id.IsValid())
+    return decode();
+
+  auto & cache = DecodedGeometryCache::Instance();
+  DecodedGeometryCache::Key const key = {m_id, scaleIndex, kind};
+  if (auto const geometry = cache.Get(key))
+  {
+    points.assign(geometry->m_points.begin(), geometry->m_points.end());
+    return geometry->m_encodedSize;
+  }
+
+  uint32_t const sz = decode();
+  auto geometry = make_shared<DecodedGeometryCache::Geometry>();
+  geometry->m_points.assign(points.begin(), points.end());
+  geometry->m_encodedSize = sz;
+  cache.Put(key, move(geometry));
+  return sz;
+}
+
 uint32_t FeatureType::ParseTriangles(int scale)
 {
   uint32_t sz = 0;
@@ -490,11 +537,15 @@ uint32_t FeatureType::ParseTriangles(int scale)
         auto const ind = GetScaleIndex(*m_loadInfo, scale, m_offsets.m_trg);
         if (ind != -1)
         {
-          ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetTrianglesReader(ind));
-          src.Skip(m_offsets.m_trg[ind]);
-          serial::LoadOuterTriangles(src, m_loadInfo->GetGeometryCodingParams(ind), m_triangles);
-
-          sz = static_cast<uint32_t>(src.Pos() - m_offsets.m_trg[ind]);
+          sz = LoadOuterGeometry(DecodedGeometryCache::Kind::Triangles, ind, [&]()
+          {
+            ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetTrianglesReader(ind));
+            src.Skip(m_offsets.m_trg[ind]);
+            serial::LoadOuterTriangles(src, m_loadInfo->GetGeometryCodingParams(ind),
+                                       m_triangles);
+
+            return static_cast<uint32_t>(src.Pos() - m_offsets.m_trg[ind]);
+          });
         }
       }
 
@@ -511,6 +562,7 @@ void FeatureType::ParseMetadata()
     return;
 
   CHECK(m_loadInfo, ());
+  m_metadata = feature::Metadata();
   try
   {
     struct TMetadataIndexEntry
@@ -545,9 +597,28 @@ void FeatureType::ParseMetadata()
   m_parsed.m_metadata = true;
 }
 
-StringUtf8Multilang const & FeatureType::GetNames()
+void FeatureType::ParseNames()
 {
+  if (m_parsed.m_names)
+    return;
+
   ParseCommon();
+
+  if (Header(m_data) & HEADER_HAS_NAME)
+  {
+    ArrayByteSource source(m_data + m_offsets.m_names);
+    m_params.name.Read(source);
+  }
+  else
+  {
+    m_params.name.Clear();
+  }
+  m_parsed.m_names = true;
+}
+
+StringUtf8Multilang const & FeatureType::GetNames()
+{
+  ParseNames();
   return m_params.name;
 }
 
@@ -564,6 +635,7 @@ void FeatureType::SetNames(StringUtf8Multilang const & newNames)
     m_header = m_header & ~feature::HEADER_HAS_NAME;
   else
     m_header = m_header | feature::HEADER_HAS_NAME;
+  m_parsed.m_names = true;
 }
 
 void FeatureType::SetMetadata(feature::Metadata const & newMetadata)
@@ -587,6 +659,7 @@ void FeatureType::UpdateHeader(bool commonParsed, bool metadataParsed)
   m_parsed.m_types = true;
 
   m_parsed.m_common = commonParsed;
+  m_parsed.m_names = commonParsed;
   m_parsed.m_metadata = metadataParsed;
 }
 
@@ -631,7 +704,7 @@ namespace
 
 string FeatureType::DebugString(int scale)
 {
-  ParseCommon();
+  ParseNames();
 
   Classificator const & c = classif();
 
@@ -820,7 +893,7 @@ bool FeatureType::GetName(int8_t lang, string & name)
   if (!HasName())
     return false;
 
-  ParseCommon();
+  ParseNames();
   return m_params.name.GetString(lang, name);
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "indexer/cell_id.hpp"
+#include "indexer/decoded_geometry_cache.hpp"
 #include "indexer/feature_altitude.hpp"
 #include "indexer/feature_data.hpp"
 
@@ -27,12 +28,16 @@ class EditableMapObject;
 }
 
 // Lazy feature loader. Loads needed data and caches it.
+// Names are decoded separately from the rest of common data, so that callers which need only
+// types, center, layer or rank don't pay for copying names in all languages.
 class FeatureType
 {
 public:
   using Buffer = char const *;
   using GeometryOffsets = buffer_vector<uint32_t, feature::DataHeader::MAX_SCALES_COUNT>;
 
+  // Drops everything parsed from the previous buffer, so one FeatureType may be reused for many
+  // features, keeping the memory allocated for names and geometry.
   void Deserialize(feature::SharedLoadInfo const * loadInfo, Buffer buffer);
 
   feature::EGeomType GetFeatureType() const;
@@ -51,7 +56,7 @@ public:
     if (!HasName())
       return false;
 
-    ParseCommon();
+    ParseNames();
     m_params.name.ForEach(std::forward<T>(fn));
     return true;
   }
@@ -213,24 +218,29 @@ private:
   {
     bool m_types = false;
     bool m_common = false;
+    bool m_names = false;
     bool m_header2 = false;
     bool m_points = false;
     bool m_triangles = false;
     bool m_metadata = false;
 
-    void Reset() { m_types = m_common = m_header2 = m_points = m_triangles = m_metadata = false; }
+    void Reset()
+    {
+      m_types = m_common = m_names = m_header2 = m_points = m_triangles = m_metadata = false;
+    }
   };
 
   struct Offsets
   {
     uint32_t m_common = 0;
+    uint32_t m_names = 0;
     uint32_t m_header2 = 0;
     GeometryOffsets m_pts;
     GeometryOffsets m_trg;
 
     void Reset()
     {
-      m_common = m_header2 = 0;
+      m_common = m_names = m_header2 = 0;
       m_pts.clear();
       m_trg.clear();
     }
@@ -238,10 +248,17 @@ private:
 
   void ParseTypes();
   void ParseCommon();
+  void ParseNames();
   void ParseHeader2();
   void ParseMetadata();
   void ParseGeometryAndTriangles(int scale);
 
+  // Takes outer geometry of |kind| from the decoded geometry cache or calls |decode| which
+  // returns the size of the encoded geometry. Returns the size of the encoded geometry.
+  template <typename Decode>
+  uint32_t LoadOuterGeometry(feature::DecodedGeometryCache::Kind kind, int scaleIndex,
+                             Decode && decode);
+
   uint8_t m_header = 0;
   std::array<uint32_t, feature::kMaxTypesCount> m_types;
 
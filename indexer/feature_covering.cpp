@@ -204,4 +204,28 @@ Intervals SortAndMergeIntervals(Intervals const & v)
   SortAndMergeIntervals(v, res);
   return res;
 }
+
+Intervals SubtractIntervals(Intervals const & from, Intervals const & what)
+{
+  Intervals res;
+  auto it = what.cbegin();
+  for (auto interval : from)
+  {
+    while (it != what.cend() && it->second <= interval.first)
+      ++it;
+
+    for (auto jt = it; jt != what.cend() && jt->first < interval.second; ++jt)
+    {
+      if (interval.first < jt->first)
+        res.emplace_back(interval.first, jt->first);
+      interval.first = max(interval.first, jt->second);
+      if (interval.first >= interval.second)
+        break;
+    }
+
+    if (interval.first < interval.second)
+      res.push_back(interval);
+  }
+  return res;
+}
 }
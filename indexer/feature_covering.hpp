@@ -11,7 +11,11 @@
 #include "base/logging.hpp"
 
 #include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
 #include <set>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -38,6 +42,10 @@ std::vector<int64_t> CoverRegion(indexer::LocalityObject const & o, int cellDept
 Intervals SortAndMergeIntervals(Intervals const & intervals);
 void SortAndMergeIntervals(Intervals v, Intervals & res);
 
+// Given sorted and merged intervals |from| and |what|, returns the parts of |from| which are
+// not covered by |what|.
+Intervals SubtractIntervals(Intervals const & from, Intervals const & what);
+
 template <int DEPTH_LEVELS>
 m2::CellId<DEPTH_LEVELS> GetRectIdAsIs(m2::RectD const & r)
 {
@@ -88,6 +96,59 @@ void CoverViewportAndAppendLowerLevels(m2::RectD const & r, int cellDepth, Inter
   SortAndMergeIntervals(intervals, res);
 }
 
+// Thread-safe cache of viewport coverings. Readers often request coverings of the same rects,
+// e.g. Drape reads a tile again when it's invalidated, so the coverings are kept for the last
+// |capacity| rects.
+class CoveringCache
+{
+public:
+  explicit CoveringCache(size_t capacity = 64) : m_capacity(capacity) {}
+
+  template <int DEPTH_LEVELS>
+  void CoverViewportAndAppendLowerLevels(m2::RectD const & r, int cellDepth, Intervals & res)
+  {
+    Key const key(r.minX(), r.minY(), r.maxX(), r.maxY(), DEPTH_LEVELS, cellDepth);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto const it = m_coverings.find(key);
+      if (it != m_coverings.end())
+      {
+        res = it->second;
+        return;
+      }
+    }
+
+    covering::CoverViewportAndAppendLowerLevels<DEPTH_LEVELS>(r, cellDepth, res);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_coverings.emplace(key, res).second)
+      return;
+
+    m_order.push_back(key);
+    if (m_order.size() > m_capacity)
+    {
+      m_coverings.erase(m_order.front());
+      m_order.pop_front();
+    }
+  }
+
+  size_t GetSize() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_coverings.size();
+  }
+
+private:
+  // Rect, depth levels and cell depth.
+  using Key = std::tuple<double, double, double, double, int, int>;
+
+  size_t const m_capacity;
+  mutable std::mutex m_mutex;
+  std::map<Key, Intervals> m_coverings;
+  // Keys in the order of insertion, the oldest one is removed first.
+  std::deque<Key> m_order;
+};
+
 enum CoveringMode
 {
   ViewportWithLowLevels = 0,
@@ -99,12 +160,30 @@ enum CoveringMode
 class CoveringGetter
 {
   Intervals m_res[2];
+  bool m_isCalculated[2] = {false, false};
 
   m2::RectD const & m_rect;
   CoveringMode m_mode;
+  CoveringCache * m_cache = nullptr;
+
+  bool m_hasPrevRect = false;
+  m2::RectD m_prevRect;
 
 public:
-  CoveringGetter(m2::RectD const & r, CoveringMode mode) : m_rect(r), m_mode(mode) {}
+  // |cache| is optional, it's used for ViewportWithLowLevels coverings.
+  CoveringGetter(m2::RectD const & r, CoveringMode mode, CoveringCache * cache = nullptr)
+    : m_rect(r), m_mode(mode), m_cache(cache)
+  {
+  }
+
+  // Incremental ViewportWithLowLevels covering: only intervals of |r| covering which are not
+  // in |prevRect| covering. It's used when a rect is moved and features of |prevRect| are
+  // already read.
+  CoveringGetter(m2::RectD const & r, m2::RectD const & prevRect, CoveringCache * cache = nullptr)
+    : m_rect(r), m_mode(ViewportWithLowLevels), m_cache(cache), m_hasPrevRect(true),
+      m_prevRect(prevRect)
+  {
+  }
 
   m2::RectD const & GetRect() const { return m_rect; }
 
@@ -114,13 +193,22 @@ public:
     int const cellDepth = GetCodingDepth<DEPTH_LEVELS>(scale);
     int const ind = (cellDepth == DEPTH_LEVELS ? 0 : 1);
 
-    if (m_res[ind].empty())
+    if (!m_isCalculated[ind])
     {
+      m_isCalculated[ind] = true;
       switch (m_mode)
       {
       case ViewportWithLowLevels:
-        CoverViewportAndAppendLowerLevels<DEPTH_LEVELS>(m_rect, cellDepth, m_res[ind]);
+      {
+        CoverViewport<DEPTH_LEVELS>(m_rect, cellDepth, m_res[ind]);
+        if (m_hasPrevRect)
+        {
+          Intervals prev;
+          CoverViewport<DEPTH_LEVELS>(m_prevRect, cellDepth, prev);
+          m_res[ind] = SubtractIntervals(m_res[ind], prev);
+        }
         break;
+      }
 
       case LowLevelsOnly:
       {
@@ -167,5 +255,15 @@ public:
 
     return m_res[ind];
   }
+
+private:
+  template <int DEPTH_LEVELS>
+  void CoverViewport(m2::RectD const & r, int cellDepth, Intervals & res) const
+  {
+    if (m_cache)
+      m_cache->CoverViewportAndAppendLowerLevels<DEPTH_LEVELS>(r, cellDepth, res);
+    else
+      CoverViewportAndAppendLowerLevels<DEPTH_LEVELS>(r, cellDepth, res);
+  }
 };
 }
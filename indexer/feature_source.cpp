@@ -42,6 +42,19 @@ bool FeatureSource::GetOriginalFeature(uint32_t index, FeatureType & feature) co
   return true;
 }
 
+void FeatureSource::ForEachOriginalFeature(std::vector<uint32_t> const & indices,
+                                           FeatureType & feature,
+                                           std::function<void(FeatureType &)> const & fn) const
+{
+  ASSERT(m_handle.IsAlive(), ());
+  ASSERT(m_vector != nullptr, ());
+  m_vector->ForEachByIndices(indices, feature, [&](uint32_t index, FeatureType & ft)
+  {
+    ft.SetID(FeatureID(m_handle.GetId(), index));
+    fn(ft);
+  });
+}
+
 FeatureStatus FeatureSource::GetFeatureStatus(uint32_t index) const
 {
   return FeatureStatus::Untouched;
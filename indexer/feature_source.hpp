@@ -10,6 +10,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 enum class FeatureStatus
 {
@@ -35,6 +36,10 @@ public:
 
   bool GetOriginalFeature(uint32_t index, FeatureType & feature) const;
 
+  // Reads original features with sorted |indices| in batches. |feature| is reused for all of them.
+  void ForEachOriginalFeature(std::vector<uint32_t> const & indices, FeatureType & feature,
+                              std::function<void(FeatureType &)> const & fn) const;
+
   FeatureID GetFeatureId(uint32_t index) const { return FeatureID(m_handle.GetId(), index); }
 
   virtual FeatureStatus GetFeatureStatus(uint32_t index) const;
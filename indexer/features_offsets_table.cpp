@@ -146,6 +146,44 @@ namespace feature
     return static_cast<uint32_t>(m_table.select(index));
   }
 
+  void FeaturesOffsetsTable::GetFeatureOffsets(vector<uint32_t> const & indices,
+                                               vector<uint64_t> & offsets) const
+  {
+    // A new select is cheaper than decoding of a longer gap.
+    size_t constexpr kMaxSequentialGap = 16;
+
+    offsets.clear();
+    offsets.reserve(indices.size());
+    if (indices.empty())
+      return;
+
+    succinct::elias_fano::select_enumerator it(m_table, indices.front());
+    size_t next = indices.front();
+    uint64_t offset = 0;
+    for (auto const index : indices)
+    {
+      ASSERT_LESS(index, size(), ("Index out of bounds", index, size()));
+      ASSERT(offsets.empty() || index + 1 >= next, ("Indices are not sorted"));
+      if (index + 1 == next && !offsets.empty())
+      {
+        offsets.push_back(offset);
+        continue;
+      }
+
+      if (index - next > kMaxSequentialGap)
+      {
+        it = succinct::elias_fano::select_enumerator(m_table, index);
+        next = index;
+      }
+      for (; next < index; ++next)
+        it.next();
+
+      offset = it.next();
+      ++next;
+      offsets.push_back(offset);
+    }
+  }
+
   size_t FeaturesOffsetsTable::GetFeatureIndexbyOffset(uint32_t offset) const
   {
     ASSERT_GREATER(size(), 0, ("We must not ask empty table"));
@@ -3,6 +3,8 @@
 #include "coding/file_container.hpp"
 #include "coding/mmap_reader.hpp"
 
+#include "base/assert.hpp"
+
 #include "defines.hpp"
 
 #include <cstdint>
@@ -92,6 +94,26 @@ namespace feature
     /// \return offset a feature
     uint32_t GetFeatureOffset(size_t index) const;
 
+    /// Replaces |offsets| by offsets of features with |indices|, which must be sorted.
+    /// Close indices are walked sequentially instead of a select per feature.
+    void GetFeatureOffsets(std::vector<uint32_t> const & indices,
+                           std::vector<uint64_t> & offsets) const;
+
+    /// Calls |fn(index, offset)| for features in [begin, end) in the increasing order.
+    /// Makes one select, every next offset is decoded in O(1).
+    template <typename Fn>
+    void ForEachOffset(size_t begin, size_t end, Fn && fn) const
+    {
+      ASSERT_LESS_OR_EQUAL(begin, end, ());
+      ASSERT_LESS_OR_EQUAL(end, size(), ());
+      if (begin == end)
+        return;
+
+      succinct::elias_fano::select_enumerator it(m_table, begin);
+      for (size_t i = begin; i < end; ++i)
+        fn(i, static_cast<uint32_t>(it.next()));
+    }
+
     /// \param offset offset of a feature
     /// \return index of a feature
     size_t GetFeatureIndexbyOffset(uint32_t offset) const;
@@ -102,7 +124,12 @@ namespace feature
     /// \return byte size of a table, may be slightly different from a
     ///         real byte size in memory or on disk due to alignment, but
     ///         can be used in benchmarks, logging, etc.
-    // size_t byte_size() { return static_cast<size_t>(succinct::mapper::size_of(m_table)); }
+    size_t byte_size() const
+    {
+      // size_of() only visits the table, but it takes a non-const reference.
+      return static_cast<size_t>(
+          succinct::mapper::size_of(const_cast<succinct::elias_fano &>(m_table)));
+    }
 
   private:
     FeaturesOffsetsTable(succinct::elias_fano::elias_fano_builder & builder);
@@ -14,6 +14,20 @@ void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
   ft.Deserialize(&m_loadInfo, &m_buffer[offset]);
 }
 
+uint32_t constexpr FeaturesVector::kMaxGapSize;
+uint32_t constexpr FeaturesVector::kMaxReadSize;
+
+void FeaturesVector::FillPositions(vector<uint32_t> const & indices) const
+{
+  if (m_table)
+  {
+    m_table->GetFeatureOffsets(indices, m_positions);
+    return;
+  }
+
+  m_positions.assign(indices.begin(), indices.end());
+}
+
 size_t FeaturesVector::GetNumFeatures() const
 {
   return m_table ? m_table->size() : 0;
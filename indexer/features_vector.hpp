@@ -23,10 +23,31 @@ public:
 
   void GetByIndex(uint32_t index, FeatureType & ft) const;
 
+  // Calls |toDo(index, ft)| for features with |indices|, which must be sorted. Features which are
+  // close to each other in the file are read together. |ft| is reused for all features.
+  template <class ToDo>
+  void ForEachByIndices(vector<uint32_t> const & indices, FeatureType & ft, ToDo && toDo) const
+  {
+    if (indices.empty())
+      return;
+
+    FillPositions(indices);
+    size_t i = 0;
+    m_recordReader.ForEachRecordAt(m_positions, kMaxGapSize, kMaxReadSize, m_batchBuffer,
+                                   [&](uint64_t /* pos */, char const * data, uint32_t /* size */)
+    {
+      ft.Deserialize(&m_loadInfo, data);
+      toDo(indices[i++], ft);
+    });
+  }
+
   size_t GetNumFeatures() const;
 
   template <class ToDo> void ForEach(ToDo && toDo) const
   {
+    auto const reader = m_loadInfo.GetDataReader();
+    reader.Advise(ModelReader::Advice::Sequential);
+
     uint32_t index = 0;
     m_recordReader.ForEachRecord([&](uint32_t pos, char const * data, uint32_t /*size*/) {
       FeatureType ft;
@@ -39,10 +60,13 @@ public:
       ft.SetID(FeatureID(MwmSet::MwmId(), index));
       toDo(ft, m_table ? index++ : pos);
     });
+
+    reader.Advise(ModelReader::Advice::Normal);
   }
 
   template <class ToDo> static void ForEachOffset(ModelReaderPtr reader, ToDo && toDo)
   {
+    reader.Advise(ModelReader::Advice::Sequential);
     VarRecordReader<ModelReaderPtr, &VarRecordSizeReaderVarint> recordReader(reader, 256);
     recordReader.ForEachRecord([&] (uint32_t pos, char const * /*data*/, uint32_t /*size*/)
     {
@@ -53,9 +77,19 @@ public:
 private:
   friend class FeaturesVectorTest;
 
+  // A gap of skipped bytes between features read together, usually a page of the file.
+  static uint32_t constexpr kMaxGapSize = 4 * 1024;
+  static uint32_t constexpr kMaxReadSize = 64 * 1024;
+
+  void FillPositions(vector<uint32_t> const & indices) const;
+
   feature::SharedLoadInfo m_loadInfo;
   VarRecordReader<FilesContainerR::TReader, &VarRecordSizeReaderVarint> m_recordReader;
   mutable vector<char> m_buffer;
+  // Buffers of ForEachByIndices. They are separate from |m_buffer|, so features may be read
+  // by GetByIndex from callbacks.
+  mutable vector<uint64_t> m_positions;
+  mutable vector<char> m_batchBuffer;
   feature::FeaturesOffsetsTable const * m_table;
 };
 
@@ -70,6 +70,22 @@ public:
   }
 };
 
+size_t constexpr kMaxCompiledLevel = 2;
+
+// Returns the key of |type| truncated to |level|, which is not greater than
+// kMaxCompiledLevel. The root level value takes the high bits of the key, so
+// keys of types under one root are close to each other.
+bool GetMatchKey(uint32_t type, size_t level, uint32_t & key)
+{
+  uint8_t value = 0;
+  if (!ftype::GetValue(type, 0 /* level */, value))
+    return false;
+  key = static_cast<uint32_t>(value) << 8;
+  if (level > 1 && ftype::GetValue(type, 1 /* level */, value))
+    key |= static_cast<uint32_t>(value) + 1;
+  return true;
+}
+
 char const * HighwayClassToString(ftypes::HighwayClass const cls)
 {
   switch (cls)
@@ -124,7 +140,40 @@ uint32_t BaseChecker::PrepareToMatch(uint32_t type, uint8_t level)
 
 bool BaseChecker::IsMatched(uint32_t type) const
 {
-  return (find(m_types.begin(), m_types.end(), PrepareToMatch(type, m_level)) != m_types.end());
+  call_once(m_compileOnce, [this]() { Compile(); });
+
+  if (m_level > kMaxCompiledLevel)
+    return find(m_types.begin(), m_types.end(), PrepareToMatch(type, m_level)) != m_types.end();
+
+  uint32_t key = 0;
+  if (!GetMatchKey(type, m_level, key) || key < m_minKey)
+    return false;
+  key -= m_minKey;
+  return key < m_bits.size() && m_bits[key];
+}
+
+void BaseChecker::Compile() const
+{
+  if (m_level > kMaxCompiledLevel)
+    return;
+
+  vector<uint32_t> keys;
+  keys.reserve(m_types.size());
+  for (auto const t : m_types)
+  {
+    uint32_t key = 0;
+    // Types from deeper levels are never matched as the matched types are truncated.
+    if (ftype::GetLevel(t) <= m_level && GetMatchKey(t, m_level, key))
+      keys.push_back(key);
+  }
+  if (keys.empty())
+    return;
+
+  auto const minMax = minmax_element(keys.cbegin(), keys.cend());
+  m_minKey = *minMax.first;
+  m_bits.assign(*minMax.second - m_minKey + 1, false);
+  for (auto const key : keys)
+    m_bits[key - m_minKey] = true;
 }
 
 bool BaseChecker::operator()(feature::TypesHolder const & types) const
@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -42,6 +43,17 @@ public:
   bool operator()(FeatureType & ft) const;
   bool operator()(std::vector<uint32_t> const & types) const;
 
+  // Calls |fn| for every type of |types| which is matched by the checker.
+  template <typename Types, typename Fn>
+  void ForEachMatchedType(Types const & types, Fn && fn) const
+  {
+    for (uint32_t const t : types)
+    {
+      if (IsMatched(t))
+        fn(t);
+    }
+  }
+
   static uint32_t PrepareToMatch(uint32_t type, uint8_t level);
 
   template <typename TFn>
@@ -49,6 +61,18 @@ public:
   {
     std::for_each(m_types.cbegin(), m_types.cend(), std::forward<TFn>(fn));
   }
+
+private:
+  // Builds |m_bits| from |m_types|. It is done on the first match because |m_types| is
+  // filled by constructors of derived classes.
+  void Compile() const;
+
+  mutable std::once_flag m_compileOnce;
+  // A bit for every match key in [m_minKey, m_minKey + m_bits.size()), see GetMatchKey()
+  // in ftypes_matcher.cpp. Types are matched by |m_types| directly when |m_level| is
+  // greater than two.
+  mutable std::vector<bool> m_bits;
+  mutable uint32_t m_minKey = 0;
 };
 
 class IsPeakChecker : public BaseChecker
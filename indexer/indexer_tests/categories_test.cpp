@@ -7,11 +7,14 @@
 
 #include "coding/multilang_utf8_string.hpp"
 #include "coding/reader.hpp"
+#include "coding/writer.hpp"
 
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 using namespace indexer;
@@ -276,6 +279,87 @@ UNIT_TEST(CategoriesHolder_ForEach)
   }
 }
 
+UNIT_TEST(CategoriesHolder_Compiled)
+{
+  string categories = string(g_testCategoriesTxt) +
+                      "\n\n"
+                      "@shop\n"
+                      "en:shop\n"
+                      "ru:магазин\n"
+                      "\n"
+                      "shop-bakery|@shop\n"
+                      "en:^buns|bakery\n"
+                      "\n"
+                      "amenity-cafe|place-village\n"
+                      "en:";
+  // Enough tokens for several blocks of the tokens table.
+  for (size_t i = 0; i < 100; ++i)
+    categories += "cafe" + strings::to_string(i * 7) + (i % 3 == 0 ? " bench|" : "|");
+  categories += "\n";
+
+  classificator::Load();
+  CategoriesHolder const holder(make_unique<MemReader>(categories.data(), categories.size()));
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    holder.Serialize(writer);
+  }
+  CategoriesHolder const compiled(make_unique<MemReader>(buffer.data(), buffer.size()));
+
+  auto const getCategories = [](CategoriesHolder const & h) {
+    vector<pair<uint32_t, vector<string>>> result;
+    h.ForEachTypeAndCategory([&result](uint32_t type, CategoriesHolder::Category const & cat) {
+      result.emplace_back(type, vector<string>());
+      for (auto const & synonym : cat.m_synonyms)
+      {
+        result.back().second.push_back(strings::to_string(synonym.m_locale) + ":" +
+                                       strings::to_string(synonym.m_prefixLengthToSuggest) +
+                                       synonym.m_name);
+      }
+    });
+    return result;
+  };
+  TEST_EQUAL(getCategories(compiled), getCategories(holder), ());
+  TEST_EQUAL(compiled.GetGroupTranslations().size(), 1, ());
+  TEST_EQUAL(compiled.GetGroupTranslations().count("@shop"), 1, ());
+
+  auto const getTypes = [](CategoriesHolder const & h, int8_t locale, string const & name) {
+    vector<uint32_t> types;
+    h.ForEachTypeByName(locale, strings::MakeUniString(name),
+                        [&types](uint32_t type) { types.push_back(type); });
+    return types;
+  };
+
+  // Types by names are looked up in the compiled form and the trie is built on request.
+  vector<pair<strings::UniString, uint32_t>> entries;
+  holder.GetNameToTypesTrie().ForEachInTrie([&entries](strings::UniString const & key,
+                                                       uint32_t type) {
+    entries.emplace_back(key, type);
+  });
+  TEST_GREATER(entries.size(), 100, ());
+  for (auto const & entry : entries)
+  {
+    auto const locale = static_cast<int8_t>(entry.first[0]);
+    auto const name =
+        strings::ToUtf8(strings::UniString(entry.first.begin() + 1, entry.first.end()));
+    TEST_EQUAL(getTypes(compiled, locale, name), getTypes(holder, locale, name), (name));
+  }
+  for (auto const & name : {"", "a", "cafe", "cafe1", "cafe700", "zzz", "bench"})
+  {
+    TEST_EQUAL(getTypes(compiled, CategoriesHolder::kEnglishCode, name),
+               getTypes(holder, CategoriesHolder::kEnglishCode, name), (name));
+  }
+  TEST(getTypes(compiled, CategoriesHolder::kUnsupportedLocaleCode, "cafe7").empty(), ());
+
+  vector<pair<strings::UniString, uint32_t>> compiledEntries;
+  compiled.GetNameToTypesTrie().ForEachInTrie(
+      [&compiledEntries](strings::UniString const & key, uint32_t type) {
+        compiledEntries.emplace_back(key, type);
+      });
+  TEST(compiledEntries == entries, ());
+}
+
 UNIT_TEST(CategoriesIndex_Smoke)
 {
   classificator::Load();
@@ -9,6 +9,7 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/memory_region.hpp"
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
@@ -16,6 +17,9 @@
 #include "geometry/point2d.hpp"
 
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,6 +31,8 @@ namespace
 {
 using TBuffer = vector<uint8_t>;
 
+CentersTable::Version const kVersions[] = {CentersTable::Version::V0, CentersTable::Version::V1};
+
 struct CentersTableTest
 {
   CentersTableTest() { classificator::Load(); }
@@ -41,32 +47,35 @@ UNIT_CLASS_TEST(CentersTableTest, Smoke)
 
   FeaturesVectorTest fv(kMap);
 
-  TBuffer buffer;
-
+  for (auto const version : kVersions)
   {
-    CentersTableBuilder builder;
+    TBuffer buffer;
 
-    builder.SetGeometryCodingParams(codingParams);
-    fv.GetVector().ForEach(
-        [&](FeatureType & ft, uint32_t id) { builder.Put(id, feature::GetCenter(ft)); });
+    {
+      CentersTableBuilder builder;
 
-    MemWriter<TBuffer> writer(buffer);
-    builder.Freeze(writer);
-  }
+      builder.SetGeometryCodingParams(codingParams);
+      fv.GetVector().ForEach(
+          [&](FeatureType & ft, uint32_t id) { builder.Put(id, feature::GetCenter(ft)); });
 
-  {
-    MemReader reader(buffer.data(), buffer.size());
-    auto table = CentersTable::Load(reader, codingParams);
-    TEST(table.get(), ());
+      MemWriter<TBuffer> writer(buffer);
+      builder.Freeze(writer, version);
+    }
 
-    fv.GetVector().ForEach([&](FeatureType & ft, uint32_t id) {
-      m2::PointD actual;
-      TEST(table->Get(id, actual), ());
+    {
+      MemReader reader(buffer.data(), buffer.size());
+      auto table = CentersTable::Load(reader, codingParams);
+      TEST(table.get(), ());
 
-      m2::PointD expected = feature::GetCenter(ft);
+      fv.GetVector().ForEach([&](FeatureType & ft, uint32_t id) {
+        m2::PointD actual;
+        TEST(table->Get(id, actual), ());
 
-      TEST_LESS_OR_EQUAL(MercatorBounds::DistanceOnEarth(actual, expected), 1, (id));
-    });
+        m2::PointD expected = feature::GetCenter(ft);
+
+        TEST_LESS_OR_EQUAL(MercatorBounds::DistanceOnEarth(actual, expected), 1, (id));
+      });
+    }
   }
 }
 
@@ -77,19 +86,20 @@ UNIT_CLASS_TEST(CentersTableTest, Subset)
 
   serial::GeometryCodingParams codingParams;
 
-  TBuffer buffer;
+  for (auto const version : kVersions)
   {
-    CentersTableBuilder builder;
+    TBuffer buffer;
+    {
+      CentersTableBuilder builder;
 
-    builder.SetGeometryCodingParams(codingParams);
-    for (auto const & feature : features)
-      builder.Put(feature.first, feature.second);
+      builder.SetGeometryCodingParams(codingParams);
+      for (auto const & feature : features)
+        builder.Put(feature.first, feature.second);
 
-    MemWriter<TBuffer> writer(buffer);
-    builder.Freeze(writer);
-  }
+      MemWriter<TBuffer> writer(buffer);
+      builder.Freeze(writer, version);
+    }
 
-  {
     MemReader reader(buffer.data(), buffer.size());
     auto table = CentersTable::Load(reader, codingParams);
     TEST(table.get(), ());
@@ -118,4 +128,62 @@ UNIT_CLASS_TEST(CentersTableTest, Subset)
     }
   }
 }
+
+UNIT_CLASS_TEST(CentersTableTest, MemoryRegion)
+{
+  serial::GeometryCodingParams codingParams;
+  mt19937 rng(0);
+  vector<pair<uint32_t, m2::PointD>> features;
+  for (uint32_t id = 0; id < 1000; ++id)
+  {
+    if (rng() % 3 == 0)
+      continue;
+    // Shifts make blocks with different widths of values.
+    double const size = id < 500 ? 0.01 : 100;
+    features.emplace_back(id, m2::PointD(10 + size * (rng() % 1000) / 1000.0,
+                                         20 + size * (rng() % 1000) / 1000.0));
+  }
+
+  map<CentersTable::Version, TBuffer> buffers;
+  for (auto const version : kVersions)
+  {
+    CentersTableBuilder builder;
+    builder.SetGeometryCodingParams(codingParams);
+    for (auto const & feature : features)
+      builder.Put(feature.first, feature.second);
+
+    MemWriter<TBuffer> writer(buffers[version]);
+    builder.Freeze(writer, version);
+  }
+
+  MemReader reader(buffers[CentersTable::Version::V0].data(),
+                   buffers[CentersTable::Version::V0].size());
+  auto v0 = CentersTable::Load(reader, codingParams);
+  TEST(v0, ());
+  TEST(!CentersTable::Load(
+           make_unique<CopiedMemoryRegion>(TBuffer(buffers[CentersTable::Version::V0])),
+           codingParams),
+       ());
+
+  auto v1 = CentersTable::Load(
+      make_unique<CopiedMemoryRegion>(move(buffers[CentersTable::Version::V1])), codingParams);
+  TEST(v1, ());
+
+  size_t j = 0;
+  for (uint32_t id = 0; id < 1100; ++id)
+  {
+    m2::PointD expected;
+    m2::PointD actual;
+    bool const has = j < features.size() && features[j].first == id;
+    TEST_EQUAL(v0->Get(id, expected), has, (id));
+    TEST_EQUAL(v1->Get(id, actual), has, (id));
+    if (!has)
+      continue;
+
+    // Both versions quantize centers in the same way.
+    TEST_EQUAL(actual, expected, (id));
+    TEST_LESS_OR_EQUAL(MercatorBounds::DistanceOnEarth(actual, features[j].second), 1, (id));
+    ++j;
+  }
+}
 }  // namespace
@@ -80,6 +80,15 @@ vector<uint32_t> GetBridgeAndTunnelTypes()
   };
   return GetTypes(arr, ARRAY_SIZE(arr));
 }
+
+class TestChecker : public ftypes::BaseChecker
+{
+public:
+  TestChecker(size_t level, vector<uint32_t> const & types) : ftypes::BaseChecker(level)
+  {
+    m_types = types;
+  }
+};
 }
 
 UNIT_TEST(IsTypeConformed)
@@ -162,3 +171,35 @@ UNIT_TEST(GetHighwayClassTest)
   types4.Add(c.GetTypeByPath({"highway"}));
   TEST_EQUAL(ftypes::GetHighwayClass(types4), ftypes::HighwayClass::Error, ());
 }
+
+UNIT_TEST(BaseChecker_IsMatched)
+{
+  classificator::Load();
+
+  Classificator const & c = classif();
+  vector<uint32_t> const types = {c.GetTypeByPath({"amenity"}),
+                                  c.GetTypeByPath({"highway", "primary"}),
+                                  c.GetTypeByPath({"highway", "trunk", "bridge"}),
+                                  c.GetTypeByPath({"place", "city"})};
+
+  for (size_t level = 1; level <= 3; ++level)
+  {
+    TestChecker const checker(level, types);
+    c.ForEachTree([&](ClassifObject const * /* obj */, uint32_t type) {
+      auto const truncated = ftypes::BaseChecker::PrepareToMatch(type, static_cast<uint8_t>(level));
+      bool const expected = find(types.begin(), types.end(), truncated) != types.end();
+      TEST_EQUAL(checker.IsMatched(type), expected, (level, c.GetReadableObjectName(type)));
+    });
+  }
+
+  TestChecker const checker(2 /* level */, types);
+  feature::TypesHolder holder;
+  holder.Add(c.GetTypeByPath({"highway", "primary", "bridge"}));
+  holder.Add(c.GetTypeByPath({"highway", "secondary"}));
+  holder.Add(c.GetTypeByPath({"amenity"}));
+  vector<uint32_t> matched;
+  checker.ForEachMatchedType(holder, [&matched](uint32_t type) { matched.push_back(type); });
+  TEST_EQUAL(matched, vector<uint32_t>({c.GetTypeByPath({"highway", "primary", "bridge"}),
+                                        c.GetTypeByPath({"amenity"})}),
+             ());
+}
@@ -1,12 +1,17 @@
 #include "testing/testing.hpp"
 
 #include "indexer/classificator.hpp"
+#include "indexer/classificator_loader.hpp"
 
 #include "generator/generator_tests_support/test_with_classificator.hpp"
 
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
 #include <algorithm>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace generator::tests_support;
@@ -82,3 +87,46 @@ UNIT_CLASS_TEST(TestWithClassificator, Classificator_Subtree)
 
   TEST_EQUAL(expectedTypes, subtreeTypes, ());
 }
+
+UNIT_TEST(Classificator_Compiled)
+{
+  string const kClassificator =
+      "world +\n"
+      "  natural +\n"
+      "    peak -\n"
+      "    coastline -\n"
+      "  {}\n"
+      "  amenity +\n"
+      "    bench -\n"
+      "    atm -\n"
+      "  {}\n"
+      "{}\n";
+  string const kTypes = "natural|coastline\namenity|bench\nnatural|peak\namenity\n";
+  classificator::LoadTypes(kClassificator, kTypes);
+
+  Classificator & c = classif();
+  auto const getState = [&c]() {
+    vector<pair<uint32_t, string>> state;
+    c.ForEachTree([&](ClassifObject const * /* obj */, uint32_t type) {
+      state.emplace_back(type, c.GetReadableObjectName(type));
+    });
+    for (uint32_t i = 0; i < 4; ++i)
+      state.emplace_back(c.GetTypeForIndex(i), to_string(c.GetIndexForType(c.GetTypeForIndex(i))));
+    return state;
+  };
+  auto const expected = getState();
+  TEST_EQUAL(expected.size(), 10, ());
+
+  vector<uint8_t> compiled;
+  {
+    MemWriter<vector<uint8_t>> writer(compiled);
+    c.WriteCompiled(writer);
+  }
+
+  c.Clear();
+  c.ReadCompiled(MemReader(compiled.data(), compiled.size()));
+  TEST_EQUAL(getState(), expected, ());
+  TEST_EQUAL(c.GetCoastType(), c.GetTypeByPath({"natural", "coastline"}), ());
+  TEST_EQUAL(c.GetTypeByPathSafe({"amenity", "atm"}),
+             c.GetTypeByReadableObjectName("amenity-atm"), ());
+}
@@ -0,0 +1,88 @@
+#include "testing/testing.hpp"
+
+#include "indexer/decoded_geometry_cache.hpp"
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace feature;
+using namespace std;
+
+namespace
+{
+using Cache = DecodedGeometryCache;
+
+Cache::GeometryPtr MakeGeometry(size_t pointsCount, uint32_t encodedSize)
+{
+  auto geometry = make_shared<Cache::Geometry>();
+  for (size_t i = 0; i < pointsCount; ++i)
+    geometry->m_points.emplace_back(static_cast<double>(i), static_cast<double>(i));
+  geometry->m_encodedSize = encodedSize;
+  return geometry;
+}
+}  // namespace
+
+UNIT_TEST(DecodedGeometryCache_Smoke)
+{
+  Cache cache(Cache::kDefaultMemorySize);
+  MwmSet::MwmId const mwmId(make_shared<MwmInfo>());
+
+  Cache::Key const points = {FeatureID(mwmId, 1), 2 /* scaleIndex */, Cache::Kind::Points};
+  Cache::Key const triangles = {FeatureID(mwmId, 1), 2 /* scaleIndex */, Cache::Kind::Triangles};
+  Cache::Key const otherScale = {FeatureID(mwmId, 1), 3 /* scaleIndex */, Cache::Kind::Points};
+  Cache::Key const otherMwm = {FeatureID(MwmSet::MwmId(make_shared<MwmInfo>()), 1),
+                               2 /* scaleIndex */, Cache::Kind::Points};
+
+  TEST(!cache.Get(points), ());
+  cache.Put(points, MakeGeometry(10 /* pointsCount */, 25 /* encodedSize */));
+
+  auto const geometry = cache.Get(points);
+  TEST(geometry, ());
+  TEST_EQUAL(geometry->m_points.size(), 10, ());
+  TEST_EQUAL(geometry->m_points[5], m2::PointD(5.0, 5.0), ());
+  TEST_EQUAL(geometry->m_encodedSize, 25, ());
+
+  TEST(!cache.Get(triangles), ());
+  TEST(!cache.Get(otherScale), ());
+  TEST(!cache.Get(otherMwm), ());
+  TEST_EQUAL(cache.GetSize(), 1, ());
+  TEST_EQUAL(cache.GetStats().m_hits, 1, ());
+  TEST_EQUAL(cache.GetStats().m_misses, 4, ());
+
+  cache.Clear();
+  TEST(!cache.Get(points), ());
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST_EQUAL(cache.GetMemorySize(), 0, ());
+  // Views of geometry outlive the cache entries.
+  TEST_EQUAL(geometry->m_points.size(), 10, ());
+}
+
+UNIT_TEST(DecodedGeometryCache_MemoryLimit)
+{
+  size_t const kMemorySize = 64 * 1024;
+  Cache cache(kMemorySize);
+  MwmSet::MwmId const mwmId(make_shared<MwmInfo>());
+
+  for (uint32_t i = 0; i < 1000; ++i)
+  {
+    cache.Put({FeatureID(mwmId, i), 0 /* scaleIndex */, Cache::Kind::Points},
+              MakeGeometry(32 /* pointsCount */, 64 /* encodedSize */));
+    TEST_LESS_OR_EQUAL(cache.GetMemorySize(), kMemorySize, ());
+  }
+  TEST_GREATER(cache.GetSize(), 0, ());
+  TEST_LESS(cache.GetSize(), 1000, ());
+
+  // Recently used geometry is kept.
+  TEST(cache.Get({FeatureID(mwmId, 999), 0 /* scaleIndex */, Cache::Kind::Points}), ());
+  TEST(!cache.Get({FeatureID(mwmId, 0), 0 /* scaleIndex */, Cache::Kind::Points}), ());
+
+  // Geometry which is larger than a part of the budget is not cached.
+  Cache::Key const large = {FeatureID(mwmId, 5000), 0 /* scaleIndex */, Cache::Kind::Points};
+  cache.Put(large, MakeGeometry(kMemorySize / sizeof(m2::PointD), 64 /* encodedSize */));
+  TEST(!cache.Get(large), ());
+}
@@ -15,7 +15,9 @@
 
 #include <functional>
 #include <memory>
+#include <random>
 #include <string>
+#include <vector>
 
 using namespace platform;
 using namespace std;
@@ -65,6 +67,43 @@ namespace feature
     TEST_EQUAL(static_cast<size_t>(7), table->GetFeatureIndexbyOffset(1024), ());
   }
 
+  UNIT_TEST(FeaturesOffsetsTable_Sequential)
+  {
+    mt19937 rng(0);
+    uniform_int_distribution<uint32_t> offsetGap(1, 3000);
+
+    FeaturesOffsetsTable::Builder builder;
+    uint32_t offset = 0;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      offset += offsetGap(rng);
+      builder.PushOffset(offset);
+    }
+    unique_ptr<FeaturesOffsetsTable> table(FeaturesOffsetsTable::Build(builder));
+    TEST(table.get(), ());
+
+    size_t expectedIndex = 10;
+    table->ForEachOffset(10 /* begin */, 500 /* end */, [&](size_t index, uint32_t offset) {
+      TEST_EQUAL(index, expectedIndex, ());
+      TEST_EQUAL(offset, table->GetFeatureOffset(index), (index));
+      ++expectedIndex;
+    });
+    TEST_EQUAL(expectedIndex, 500, ());
+
+    // Both short and long gaps between indices, and repeated indices.
+    uniform_int_distribution<uint32_t> indexGap(0, 40);
+    vector<uint32_t> indices;
+    for (uint32_t index = indexGap(rng); index < table->size(); index += indexGap(rng))
+      indices.push_back(index);
+    indices.push_back(static_cast<uint32_t>(table->size() - 1));
+
+    vector<uint64_t> offsets;
+    table->GetFeatureOffsets(indices, offsets);
+    TEST_EQUAL(offsets.size(), indices.size(), ());
+    for (size_t i = 0; i < indices.size(); ++i)
+      TEST_EQUAL(offsets[i], table->GetFeatureOffset(indices[i]), (indices[i]));
+  }
+
   UNIT_TEST(FeaturesOffsetsTable_CreateIfNotExistsAndLoad)
   {
     string const testFileName = "minsk-pass";
@@ -9,6 +9,8 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -286,3 +288,49 @@ UNIT_TEST(IntervalIndex_Simple5)
   }
 }
 
+
+UNIT_TEST(IntervalIndex_ForEachInIntervals)
+{
+  mt19937 rng(0);
+  vector<CellIdFeaturePairForTest> data;
+  for (uint32_t i = 0; i < 3000; ++i)
+    data.emplace_back(rng() % 0x1000000ULL, i);
+  sort(data.begin(), data.end(),
+       [](CellIdFeaturePairForTest const & lhs, CellIdFeaturePairForTest const & rhs) {
+         return lhs.GetCell() < rhs.GetCell();
+       });
+
+  vector<char> serialIndex;
+  MemWriter<vector<char>> writer(serialIndex);
+  BuildIntervalIndex(data.begin(), data.end(), writer, 24);
+  MemReader reader(&serialIndex[0], serialIndex.size());
+  IntervalIndex<MemReader, uint32_t> index(reader);
+  IntervalIndex<MemReader, uint32_t> cachedIndex(reader);
+  cachedIndex.LoadTopLevels(static_cast<uint32_t>(serialIndex.size()) / 4);
+
+  for (size_t test = 0; test < 100; ++test)
+  {
+    // Unsorted and overlapping intervals.
+    vector<pair<uint64_t, uint64_t>> intervals;
+    for (size_t i = 0; i < 1 + rng() % 20; ++i)
+    {
+      uint64_t const beg = rng() % 0x1000000ULL;
+      intervals.emplace_back(beg, beg + rng() % 0x10000ULL);
+    }
+
+    vector<uint32_t> expected;
+    for (auto const & interval : intervals)
+      index.ForEach(base::MakeBackInsertFunctor(expected), interval.first, interval.second);
+    base::SortUnique(expected);
+
+    vector<uint32_t> values;
+    index.ForEach(base::MakeBackInsertFunctor(values), intervals);
+    sort(values.begin(), values.end());
+    TEST_EQUAL(values, expected, (intervals));
+
+    vector<uint32_t> cachedValues;
+    cachedIndex.ForEach(base::MakeBackInsertFunctor(cachedValues), intervals);
+    sort(cachedValues.begin(), cachedValues.end());
+    TEST_EQUAL(cachedValues, expected, (intervals));
+  }
+}
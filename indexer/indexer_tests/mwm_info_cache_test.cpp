@@ -0,0 +1,120 @@
+#include "testing/testing.hpp"
+
+#include "indexer/mwm_info_cache.hpp"
+
+#include "platform/country_file.hpp"
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "coding/file_name_utils.hpp"
+
+#include <string>
+
+#include "defines.hpp"
+
+using namespace platform;
+using namespace platform::tests_support;
+using namespace std;
+
+namespace
+{
+string const kCacheFile = "mwm_info_cache_test.bin";
+
+MwmInfoCache::Entry MakeEntry(uint8_t minScale)
+{
+  MwmInfoCache::Entry entry;
+  entry.m_bordersRect = m2::RectD(-1.5, 2.25, 3.125, 4.5);
+  entry.m_minScale = minScale;
+  entry.m_maxScale = 17;
+  entry.m_version.SetFormat(version::Format::lastFormat);
+  entry.m_version.SetSecondsSinceEpoch(1500000000);
+  entry.m_data.SetLanguages({"en", "de"});
+  return entry;
+}
+
+void TestEqual(MwmInfoCache::Entry const & lhs, MwmInfoCache::Entry const & rhs)
+{
+  TEST_EQUAL(lhs.m_bordersRect, rhs.m_bordersRect, ());
+  TEST_EQUAL(lhs.m_minScale, rhs.m_minScale, ());
+  TEST_EQUAL(lhs.m_maxScale, rhs.m_maxScale, ());
+  TEST_EQUAL(lhs.m_version.GetFormat(), rhs.m_version.GetFormat(), ());
+  TEST_EQUAL(lhs.m_version.GetSecondsSinceEpoch(), rhs.m_version.GetSecondsSinceEpoch(), ());
+  TEST(lhs.m_data.Equals(rhs.m_data), ());
+}
+}  // namespace
+
+UNIT_TEST(MwmInfoCache_SaveLoad)
+{
+  string const dir = GetPlatform().WritableDir();
+  LocalCountryFile const first(dir, CountryFile("First"), 0 /* version */);
+  LocalCountryFile const second(dir, CountryFile("Second"), 0 /* version */);
+  LocalCountryFile const absent(dir, CountryFile("Absent"), 0 /* version */);
+
+  ScopedFile const firstFile("First" DATA_FILE_EXTENSION, "first");
+  ScopedFile const secondFile("Second" DATA_FILE_EXTENSION, "second");
+  ScopedFile const cacheFile(kCacheFile, ScopedFile::Mode::DoNotCreate);
+  string const cachePath = base::JoinPath(dir, kCacheFile);
+
+  {
+    MwmInfoCache cache(cachePath);
+    TEST(!cache.Load(), ());
+
+    cache.Put(first, MakeEntry(1));
+    cache.Put(second, MakeEntry(2));
+    // Files which don't exist are not cached.
+    cache.Put(absent, MakeEntry(3));
+    TEST_EQUAL(cache.GetSize(), 2, ());
+    TEST(cache.Save(), ());
+  }
+
+  {
+    MwmInfoCache cache(cachePath);
+    TEST(cache.Load(), ());
+    TEST_EQUAL(cache.GetSize(), 2, ());
+
+    MwmInfoCache::Entry entry;
+    TEST(cache.Find(first, entry), ());
+    TestEqual(entry, MakeEntry(1));
+    TEST(!cache.Find(absent, entry), ());
+
+    // Only the found entry is saved, the second mwm is considered to be removed.
+    TEST(cache.Save(), ());
+  }
+
+  {
+    MwmInfoCache cache(cachePath);
+    TEST(cache.Load(), ());
+    TEST_EQUAL(cache.GetSize(), 1, ());
+
+    MwmInfoCache::Entry entry;
+    TEST(!cache.Find(second, entry), ());
+    TEST(cache.Find(first, entry), ());
+  }
+}
+
+UNIT_TEST(MwmInfoCache_ChangedFile)
+{
+  string const dir = GetPlatform().WritableDir();
+  LocalCountryFile const localFile(dir, CountryFile("Changed"), 0 /* version */);
+
+  MwmInfoCache cache(base::JoinPath(dir, kCacheFile));
+  MwmInfoCache::Entry entry;
+  {
+    ScopedFile const file("Changed" DATA_FILE_EXTENSION, "old");
+    cache.Put(localFile, MakeEntry(1));
+    TEST(cache.Find(localFile, entry), ());
+  }
+
+  ScopedFile const file("Changed" DATA_FILE_EXTENSION, "new contents");
+  TEST(!cache.Find(localFile, entry), ());
+}
+
+UNIT_TEST(MwmInfoCache_BrokenFile)
+{
+  ScopedFile const cacheFile(kCacheFile, string("\0\5\3abc", 6));
+
+  MwmInfoCache cache(cacheFile.GetFullPath());
+  TEST(!cache.Load(), ());
+  TEST_EQUAL(cache.GetSize(), 0, ());
+}
@@ -7,7 +7,9 @@
 #include "base/macros.hpp"
 
 #include <initializer_list>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 using namespace std;
 using platform::CountryFile;
@@ -158,3 +160,141 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+UNIT_TEST(MwmSetCacheTest)
+{
+  TestMwmSet mwmSet;
+  auto const id = mwmSet.Register(LocalCountryFile::MakeForTesting("0")).first;
+
+  TEST(mwmSet.GetMwmHandleById(id).IsAlive(), ());
+  auto stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(stats.m_valuesCount, 1, (stats));
+  TEST_EQUAL(stats.m_hits, 0, (stats));
+  TEST_EQUAL(stats.m_misses, 1, (stats));
+
+  TEST(mwmSet.GetMwmHandleById(id).IsAlive(), ());
+  stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(stats.m_valuesCount, 1, (stats));
+  TEST_EQUAL(stats.m_hits, 1, (stats));
+  TEST_GREATER(stats.m_memorySize, 0, (stats));
+
+  TEST(mwmSet.Deregister(CountryFile("0")), ());
+  TEST_EQUAL(mwmSet.GetCacheStats().m_valuesCount, 0, ());
+}
+
+UNIT_TEST(MwmSetCacheMemoryLimitTest)
+{
+  // Only the last released value of a shard fits the cache.
+  TestMwmSet mwmSet(MwmSet::kDefaultCacheSize, 0 /* cacheMemorySize */);
+  auto const id = mwmSet.Register(LocalCountryFile::MakeForTesting("0")).first;
+  {
+    auto const handle0 = mwmSet.GetMwmHandleById(id);
+    auto const handle1 = mwmSet.GetMwmHandleById(id);
+    TEST(handle0.IsAlive(), ());
+    TEST(handle1.IsAlive(), ());
+  }
+
+  auto const stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(stats.m_valuesCount, 1, (stats));
+  TEST_EQUAL(stats.m_evictions, 1, (stats));
+}
+
+UNIT_TEST(MwmSetConcurrentLockTest)
+{
+  TestMwmSet mwmSet;
+  vector<MwmSet::MwmId> ids;
+  for (auto const & name : {"0", "1", "2", "3"})
+    ids.push_back(mwmSet.Register(LocalCountryFile::MakeForTesting(name)).first);
+
+  vector<thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&mwmSet, &ids, i]()
+    {
+      for (size_t j = 0; j < 1000; ++j)
+      {
+        auto const handle = mwmSet.GetMwmHandleById(ids[(i + j) % ids.size()]);
+        TEST(handle.IsAlive(), ());
+      }
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  for (auto const & id : ids)
+    TEST_EQUAL(id.GetInfo()->GetNumRefs(), 0, ());
+  TEST_EQUAL(mwmSet.GetCacheStats().m_hits + mwmSet.GetCacheStats().m_misses, 4000, ());
+
+  TEST(mwmSet.Deregister(CountryFile("2")), ());
+  TEST(!ids[2].IsAlive(), ());
+}
+
+UNIT_TEST(MwmSetBatchRegisterTest)
+{
+  TestMwmSet mwmSet;
+  UNUSED_VALUE(mwmSet.Register(LocalCountryFile::MakeForTesting("4", 2 /* version */)));
+
+  vector<LocalCountryFile> files;
+  for (auto const & name : {"0", "1", "2", "3"})
+    files.push_back(LocalCountryFile::MakeForTesting(name));
+  // A newer version of an already registered mwm and an older one.
+  files.push_back(LocalCountryFile::MakeForTesting("4", 3 /* version */));
+  files.push_back(LocalCountryFile::MakeForTesting("4", 1 /* version */));
+
+  auto const results = mwmSet.Register(files, 3 /* threadsCount */);
+  TEST_EQUAL(results.size(), files.size(), ());
+  for (size_t i = 0; i < 5; ++i)
+  {
+    TEST_EQUAL(results[i].second, MwmSet::RegResult::Success, (i));
+    TEST(results[i].first.IsAlive(), (i));
+    TEST_EQUAL(results[i].first.GetInfo()->GetCountryName(), files[i].GetCountryName(), ());
+    TEST_EQUAL(results[i].first.GetInfo()->m_maxScale, i, ());
+  }
+  TEST_EQUAL(results[4].first.GetInfo()->GetVersion(), 3, ());
+  TEST_EQUAL(results[5].second, MwmSet::RegResult::VersionTooOld, ());
+
+  MwmsInfo mwmsInfo;
+  GetMwmsInfo(mwmSet, mwmsInfo);
+  TestFilesPresence(mwmsInfo, {"0", "1", "2", "3", "4"});
+}
+
+UNIT_TEST(MwmSetSnapshotTest)
+{
+  TestMwmSet mwmSet;
+  UNUSED_VALUE(mwmSet.Register(LocalCountryFile::MakeForTesting("0")));
+  UNUSED_VALUE(mwmSet.Register(LocalCountryFile::MakeForTesting("1", 1 /* version */)));
+
+  auto const snapshot = mwmSet.GetSnapshot();
+  TEST_EQUAL(snapshot->size(), 2, ());
+
+  // Lock and release of values don't change the registry.
+  {
+    auto const handle = mwmSet.GetMwmHandleByCountryFile(CountryFile("0"));
+    TEST(handle.IsAlive(), ());
+  }
+  TEST_EQUAL(mwmSet.GetSnapshot(), snapshot, ());
+
+  {
+    // The handle of the old version of "1" stays valid after the update.
+    MwmSet::MwmId const oldId(snapshot->at("1"));
+    auto const handle = mwmSet.GetMwmHandleById(oldId);
+    TEST(handle.IsAlive(), ());
+
+    UNUSED_VALUE(mwmSet.Register(LocalCountryFile::MakeForTesting("1", 2 /* version */)));
+    TEST(mwmSet.Deregister(CountryFile("0")), ());
+    TEST(handle.IsAlive(), ());
+    TEST_EQUAL(oldId.GetInfo()->GetStatus(), MwmInfo::STATUS_MARKED_TO_DEREGISTER, ());
+  }
+
+  // The held snapshot is not changed.
+  TEST_EQUAL(snapshot->size(), 2, ());
+  TEST_EQUAL(snapshot->at("1")->GetVersion(), 1, ());
+  TEST_EQUAL(snapshot->at("1")->GetStatus(), MwmInfo::STATUS_DEREGISTERED, ());
+  TEST_EQUAL(snapshot->at("0")->GetStatus(), MwmInfo::STATUS_DEREGISTERED, ());
+
+  auto const newSnapshot = mwmSet.GetSnapshot();
+  TEST_EQUAL(newSnapshot->size(), 1, ());
+  TEST_EQUAL(newSnapshot->at("1")->GetVersion(), 2, ());
+  TEST(mwmSet.IsLoaded(CountryFile("1")), ());
+  TEST(!mwmSet.IsLoaded(CountryFile("0")), ());
+}
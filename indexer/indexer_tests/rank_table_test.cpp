@@ -30,6 +30,17 @@ void TestTable(vector<uint8_t> const & ranks, search::RankTable const & table)
   TEST_EQUAL(table.GetVersion(), search::RankTable::V0, ());
   for (size_t i = 0; i < ranks.size(); ++i)
     TEST_EQUAL(ranks[i], table.Get(i), ());
+
+  // Features created in the Editor have no ranks.
+  vector<uint32_t> ids = {static_cast<uint32_t>(ranks.size())};
+  for (size_t i = ranks.size(); i > 0; i -= min(i, size_t(3)))
+    ids.push_back(static_cast<uint32_t>(i - 1));
+  vector<uint8_t> batch;
+  table.GetRanks(ids, batch);
+  TEST_EQUAL(batch.size(), ids.size(), ());
+  TEST_EQUAL(batch[0], 0, ());
+  for (size_t i = 1; i < ids.size(); ++i)
+    TEST_EQUAL(batch[i], ranks[ids[i]], (ids[i]));
 }
 
 void TestTable(vector<uint8_t> const & ranks, string const & path)
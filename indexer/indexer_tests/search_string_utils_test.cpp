@@ -89,6 +89,24 @@ UNIT_TEST(NormalizeAndSimplifyStringWithOurTambourines)
     TEST_EQUAL(arr[i + 1], ToUtf8(NormalizeAndSimplifyString(arr[i])), (i));
 }
 
+UNIT_TEST(NormalizeAndSimplifyString_ASCII)
+{
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Hello, World! @[`{ AZ az"),
+             "hello, world! @[`{ az az", ());
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Building #12"), "building  12", ());
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8("#hashtag"), "#hashtag", ());
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8(""), "", ());
+
+  // The same buffer is reused for ASCII and non-ASCII strings.
+  UniString buffer;
+  NormalizeAndSimplifyString("A LONG STREET NAME WHICH DOESN'T FIT IN THE STATIC BUFFER", buffer);
+  TEST_EQUAL(ToUtf8(buffer), "a long street name which doesn't fit in the static buffer", ());
+  NormalizeAndSimplifyString("ØøÆæ Street", buffer);
+  TEST_EQUAL(ToUtf8(buffer), "ooaeae street", ());
+  NormalizeAndSimplifyString("Main St", buffer);
+  TEST_EQUAL(ToUtf8(buffer), "main st", ());
+}
+
 UNIT_TEST(Contains)
 {
   constexpr char const * kTestStr = "ØøÆæŒœ Ўвага!";
@@ -1,5 +1,7 @@
 #include "testing/testing.hpp"
+#include "indexer/cell_id.hpp"
 #include "indexer/feature_covering.hpp"
+#include "indexer/scales.hpp"
 
 #include <vector>
 
@@ -64,3 +66,47 @@ UNIT_TEST(SortAndMergeIntervals_ContainAndTouchBorder)
 
 
 
+
+UNIT_TEST(SubtractIntervals_Smoke)
+{
+  using covering::Intervals;
+  Intervals const from = {{1, 5}, {7, 10}, {12, 20}};
+  TEST_EQUAL(covering::SubtractIntervals(from, {}), from, ());
+  TEST_EQUAL(covering::SubtractIntervals(from, from), Intervals(), ());
+  TEST_EQUAL(covering::SubtractIntervals(from, {{0, 30}}), Intervals(), ());
+  TEST_EQUAL(covering::SubtractIntervals(from, {{2, 3}, {4, 8}, {13, 14}, {19, 25}}),
+             Intervals({{1, 2}, {3, 4}, {8, 10}, {12, 13}, {14, 19}}), ());
+  TEST_EQUAL(covering::SubtractIntervals(from, {{5, 7}, {10, 12}}), from, ());
+}
+
+UNIT_TEST(CoveringGetter_PrevRect)
+{
+  int constexpr kDepthLevels = RectId::DEPTH_LEVELS;
+  int const scale = scales::GetUpperScale();
+  m2::RectD const rect(10.0, 10.0, 10.1, 10.1);
+  m2::RectD const prevRect(10.05, 10.0, 10.15, 10.1);
+
+  covering::CoveringCache cache;
+  covering::CoveringGetter full(rect, covering::ViewportWithLowLevels, &cache);
+  covering::CoveringGetter prev(prevRect, covering::ViewportWithLowLevels, &cache);
+  covering::CoveringGetter increment(rect, prevRect, &cache);
+
+  auto const & fullIntervals = full.Get<kDepthLevels>(scale);
+  auto const & prevIntervals = prev.Get<kDepthLevels>(scale);
+  auto const & incrementIntervals = increment.Get<kDepthLevels>(scale);
+  TEST_EQUAL(cache.GetSize(), 2, ());
+
+  TEST(!incrementIntervals.empty(), ());
+  TEST_EQUAL(covering::SubtractIntervals(fullIntervals, prevIntervals), incrementIntervals, ());
+
+  // Increment and previous intervals together give the full covering.
+  covering::Intervals all = incrementIntervals;
+  all.insert(all.end(), prevIntervals.begin(), prevIntervals.end());
+  TEST_EQUAL(covering::SubtractIntervals(fullIntervals, covering::SortAndMergeIntervals(all)),
+             covering::Intervals(), ());
+
+  covering::Intervals uncached;
+  covering::CoverViewportAndAppendLowerLevels<kDepthLevels>(
+      rect, covering::GetCodingDepth<kDepthLevels>(scale), uncached);
+  TEST_EQUAL(uncached, fullIntervals, ());
+}
@@ -1,5 +1,7 @@
 #include "testing/testing.hpp"
 
+#include "indexer/packed_trie_builder.hpp"
+#include "indexer/packed_trie_reader.hpp"
 #include "indexer/trie.hpp"
 #include "indexer/trie_builder.hpp"
 #include "indexer/trie_reader.hpp"
@@ -219,7 +221,121 @@ UNIT_TEST(TrieBuilder_Build)
         trie::ForEachRef(*root, addKeyValuePair, Key{});
         sort(res.begin(), res.end());
         TEST_EQUAL(v, res, ());
+
+        vector<uint8_t> packedBuf;
+        PushBackByteSink<vector<uint8_t>> packedSink(packedBuf);
+        trie::BuildPacked<PushBackByteSink<vector<uint8_t>>, Key, ValueList<uint32_t>,
+                          SingleValueSerializer<uint32_t>>(packedSink, serializer, v);
+
+        auto const packedRoot = trie::ReadPackedTrie<ValueList<uint32_t>>(
+            packedBuf.data(), packedBuf.size(), serializer);
+        res.clear();
+        trie::ForEachRef(packedRoot, addKeyValuePair, Key{});
+        sort(res.begin(), res.end());
+        TEST_EQUAL(v, res, ());
       }
     }
   }
 }
+
+UNIT_TEST(TrieBuilder_BuildPacked)
+{
+  using Key = buffer_vector<trie::TrieChar, 8>;
+  using KeyValuePair = pair<Key, uint32_t>;
+
+  auto makeKey = [](string const & s) { return Key(s.begin(), s.end()); };
+
+  vector<KeyValuePair> const data = {{makeKey("abc"), 1},  {makeKey("abcde"), 2},
+                                     {makeKey("abcde"), 3}, {makeKey("abx"), 4},
+                                     {makeKey("z"), 5},     {makeKey("z"), 5}};
+
+  vector<uint8_t> buf;
+  PushBackByteSink<vector<uint8_t>> sink(buf);
+  SingleValueSerializer<uint32_t> serializer;
+  trie::BuildPacked<PushBackByteSink<vector<uint8_t>>, Key, ValueList<uint32_t>,
+                    SingleValueSerializer<uint32_t>>(sink, serializer, data);
+  TEST_EQUAL(buf.size() % 4, 0, ());
+
+  auto const root =
+      trie::ReadPackedTrie<ValueList<uint32_t>>(buf.data(), buf.size(), serializer);
+  TEST(!root.HasValues(), ());
+  TEST_EQUAL(root.GetEdgesCount(), 2, ());
+  TEST_EQUAL(root.FindEdge('y'), root.GetEdgesCount(), ());
+
+  // Nodes without values and with a single child are merged into the edge.
+  size_t const ab = root.FindEdge('a');
+  TEST_LESS(ab, root.GetEdgesCount(), ());
+  auto const abLabel = root.GetEdgeLabel(ab);
+  TEST_EQUAL(Key(abLabel.begin(), abLabel.end()), makeKey("ab"), ());
+
+  auto const abNode = root.GoToEdge(ab);
+  TEST_EQUAL(abNode.GetEdgesCount(), 2, ());
+  TEST_EQUAL(abNode.GetEdgeFirstChar(0), 'c', ());
+  TEST_EQUAL(abNode.GetEdgeFirstChar(1), 'x', ());
+
+  auto const abcNode = abNode.GoToEdge(abNode.FindEdge('c'));
+  vector<uint32_t> values;
+  abcNode.ForEachValue([&values](uint32_t v) { values.push_back(v); });
+  TEST_EQUAL(values, vector<uint32_t>{1}, ());
+
+  size_t const de = abcNode.FindEdge('d');
+  auto const deLabel = abcNode.GetEdgeLabel(de);
+  TEST_EQUAL(Key(deLabel.begin(), deLabel.end()), makeKey("de"), ());
+
+  auto const abcdeNode = abcNode.GoToEdge(de);
+  TEST_EQUAL(abcdeNode.GetEdgesCount(), 0, ());
+  values.clear();
+  abcdeNode.ForEachValue([&values](uint32_t v) { values.push_back(v); });
+  TEST_EQUAL(values, vector<uint32_t>({2, 3}), ());
+
+  // Equal pairs are added once.
+  auto const zNode = root.GoToEdge(root.FindEdge('z'));
+  values.clear();
+  zNode.ForEachValue([&values](uint32_t v) { values.push_back(v); });
+  TEST_EQUAL(values, vector<uint32_t>{5}, ());
+}
+
+UNIT_TEST(TrieBuilder_BuildFromSorted)
+{
+  using Key = buffer_vector<trie::TrieChar, 8>;
+  using KeyValuePair = pair<Key, uint32_t>;
+
+  auto makeKey = [](string const & s) { return Key(s.begin(), s.end()); };
+
+  // Two sorted runs with a common pair, as they are merged by the search index builder.
+  vector<KeyValuePair> const run1 = {{makeKey("a"), 1}, {makeKey("ab"), 2}, {makeKey("b"), 3}};
+  vector<KeyValuePair> const run2 = {{makeKey("ab"), 2}, {makeKey("ab"), 4}, {makeKey("ba"), 5}};
+
+  vector<KeyValuePair> all = run1;
+  all.insert(all.end(), run2.begin(), run2.end());
+  sort(all.begin(), all.end());
+
+  using Sink = PushBackByteSink<vector<uint8_t>>;
+  SingleValueSerializer<uint32_t> serializer;
+
+  vector<uint8_t> expected;
+  {
+    Sink sink(expected);
+    trie::Build<Sink, Key, ValueList<uint32_t>, SingleValueSerializer<uint32_t>>(sink, serializer,
+                                                                                   all);
+  }
+
+  vector<uint8_t> merged;
+  {
+    Sink sink(merged);
+    trie::BuildFromSorted<Sink, Key, ValueList<uint32_t>, SingleValueSerializer<uint32_t>>(
+        sink, serializer, [&](auto && toDo) {
+          size_t i1 = 0;
+          size_t i2 = 0;
+          while (i1 < run1.size() || i2 < run2.size())
+          {
+            if (i2 == run2.size() || (i1 < run1.size() && run1[i1] < run2[i2]))
+              toDo(run1[i1++]);
+            else
+              toDo(run2[i2++]);
+          }
+        });
+  }
+
+  TEST_EQUAL(expected, merged, ());
+}
@@ -7,7 +7,11 @@
 #include "base/assert.hpp"
 #include "base/buffer_vector.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
 
 class IntervalIndexBase
 {
@@ -70,19 +74,196 @@ public:
     }
   }
 
+  // Calls |f| for values with keys in any of half-open |intervals|, which may be unsorted and
+  // may overlap. Unlike calling ForEach() for each interval, the tree is walked once, so nodes
+  // shared by adjacent intervals are read once. A value is reported once even if its key is
+  // in several intervals.
+  template <typename F, typename Intervals>
+  void ForEach(F const & f, Intervals const & intervals) const
+  {
+    if (m_Header.m_Levels == 0)
+      return;
+
+    // Inclusive key ranges, sorted and merged.
+    std::vector<KeyRange> ranges;
+    ranges.reserve(intervals.size());
+    for (auto const & interval : intervals)
+    {
+      uint64_t const beg = std::min(static_cast<uint64_t>(interval.first), KeyEnd());
+      uint64_t const end = std::min(static_cast<uint64_t>(interval.second), KeyEnd());
+      if (beg < end)
+        ranges.emplace_back(beg, end - 1);
+    }
+    if (ranges.empty())
+      return;
+
+    std::sort(ranges.begin(), ranges.end());
+    size_t last = 0;
+    for (size_t i = 1; i < ranges.size(); ++i)
+    {
+      if (ranges[i].first <= ranges[last].second + 1)
+        ranges[last].second = std::max(ranges[last].second, ranges[i].second);
+      else
+        ranges[++last] = ranges[i];
+    }
+    ranges.resize(last + 1);
+
+    ForEachNodeInRanges(f, ranges.data(), ranges.data() + ranges.size(), 0 /* base */,
+                        m_Header.m_Levels, 0,
+                        m_LevelOffsets[m_Header.m_Levels + 1] - m_LevelOffsets[m_Header.m_Levels]);
+  }
+
+  // Keeps the top levels of the tree which fit |maxSize| bytes in memory, so queries don't read
+  // them. Useful for indexes which live long and serve many queries.
+  void LoadTopLevels(uint32_t maxSize)
+  {
+    if (m_Header.m_Levels == 0)
+      return;
+
+    uint32_t const end = m_LevelOffsets[m_Header.m_Levels + 1];
+    int level = m_Header.m_Levels;
+    while (level > 0 && end - m_LevelOffsets[level - 1] <= maxSize)
+      --level;
+    if (end - m_LevelOffsets[level] > maxSize)
+      return;
+
+    m_TopLevelsOffset = m_LevelOffsets[level];
+    m_TopLevels.resize(end - m_TopLevelsOffset);
+    if (!m_TopLevels.empty())
+      m_Reader.Read(m_TopLevelsOffset, m_TopLevels.data(), m_TopLevels.size());
+  }
+
 private:
+  using KeyRange = std::pair<uint64_t, uint64_t>;
+
+  // Returns a pointer to |size| bytes of a node at |offset|, which are either kept in memory by
+  // LoadTopLevels() or read into |data|.
+  template <typename Buffer>
+  uint8_t const * ReadNode(uint32_t offset, uint32_t size, Buffer & data) const
+  {
+    if (!m_TopLevels.empty() && offset >= m_TopLevelsOffset)
+    {
+      ASSERT_LESS_OR_EQUAL(offset - m_TopLevelsOffset + size, m_TopLevels.size(), ());
+      return m_TopLevels.data() + (offset - m_TopLevelsOffset);
+    }
+
+    data.resize_no_init(size);
+    m_Reader.Read(offset, &data[0], size);
+    return &data[0];
+  }
+
+  // Children of a node are iterated by ForEachChild(), which calls |fn(i, childOffset,
+  // childSize)| for children with numbers in [0, maxChild].
+  template <typename Fn>
+  void ForEachChild(uint8_t const * pData, uint32_t size, uint32_t maxChild, Fn && fn) const
+  {
+    ArrayByteSource src(pData);
+
+    uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
+    uint32_t childOffset = offsetAndFlag >> 1;
+    if (offsetAndFlag & 1)
+    {
+      // Reading bitmap.
+      uint8_t const * pBitmap = static_cast<uint8_t const *>(src.Ptr());
+      src.Advance(BitmapSize(m_Header.m_BitsPerLevel));
+      for (uint32_t i = 0; i <= maxChild; ++i)
+      {
+        if (bits::GetBit(pBitmap, i))
+        {
+          uint32_t const childSize = ReadVarUint<uint32_t>(src);
+          if (!fn(i, childOffset, childSize))
+            return;
+          childOffset += childSize;
+        }
+      }
+    }
+    else
+    {
+      void const * pEnd = pData + size;
+      while (src.Ptr() < pEnd)
+      {
+        uint8_t const i = src.ReadByte();
+        if (i > maxChild)
+          break;
+        uint32_t const childSize = ReadVarUint<uint32_t>(src);
+        if (!fn(i, childOffset, childSize))
+          return;
+        childOffset += childSize;
+      }
+    }
+  }
+
+  // |first| and |last| are sorted disjoint inclusive ranges of absolute keys, which intersect
+  // keys of the node. |base| is the first key of the node.
+  template <typename F>
+  void ForEachNodeInRanges(F const & f, KeyRange const * first, KeyRange const * last,
+                           uint64_t base, int level, uint32_t offset, uint32_t size) const
+  {
+    offset += m_LevelOffsets[level];
+
+    if (level == 0)
+    {
+      buffer_vector<uint8_t, 1024> data;
+      uint8_t const * pData = ReadNode(offset, size, data);
+      ArrayByteSource src(pData);
+
+      void const * pEnd = pData + size;
+      Value value = 0;
+      while (src.Ptr() < pEnd)
+      {
+        uint32_t key = 0;
+        src.Read(&key, m_Header.m_LeafBytes);
+        uint64_t const absKey = base + SwapIfBigEndianMacroBased(key);
+        value += ReadVarInt<int64_t>(src);
+        while (first != last && first->second < absKey)
+          ++first;
+        if (first == last)
+          break;
+        if (absKey >= first->first)
+          f(value);
+      }
+      return;
+    }
+
+    uint8_t const skipBits = (m_Header.m_LeafBytes << 3) + (level - 1) * m_Header.m_BitsPerLevel;
+    uint64_t const levelBytesFF = (1ULL << skipBits) - 1;
+
+    buffer_vector<uint8_t, 576> data;
+    uint8_t const * pData = ReadNode(offset, size, data);
+
+    uint32_t const maxChild = static_cast<uint32_t>(std::min<uint64_t>(
+        ((last - 1)->second - base) >> skipBits, (1ULL << m_Header.m_BitsPerLevel) - 1));
+    ForEachChild(pData, size, maxChild,
+                 [&](uint32_t i, uint32_t childOffset, uint32_t childSize)
+                 {
+                   uint64_t const childBeg = base + (static_cast<uint64_t>(i) << skipBits);
+                   uint64_t const childEnd = childBeg + levelBytesFF;
+                   while (first != last && first->second < childBeg)
+                     ++first;
+                   if (first == last)
+                     return false;
+
+                   auto childLast = first;
+                   while (childLast != last && childLast->first <= childEnd)
+                     ++childLast;
+                   if (childLast != first)
+                   {
+                     ForEachNodeInRanges(f, first, childLast, childBeg, level - 1, childOffset,
+                                         childSize);
+                   }
+                   return true;
+                 });
+  }
 
   template <typename F>
   void ForEachLeaf(F const & f, uint64_t const beg, uint64_t const end,
                    uint32_t const offset, uint32_t const size) const
   {
     buffer_vector<uint8_t, 1024> data;
-    data.resize_no_init(size);
+    uint8_t const * pData = ReadNode(offset, size, data);
+    ArrayByteSource src(pData);
 
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
-
-    void const * pEnd = &data[0] + size;
+    void const * pEnd = pData + size;
     Value value = 0;
     while (src.Ptr() < pEnd)
     {
@@ -118,10 +299,8 @@ private:
     ASSERT_LESS(end0, (1U << m_Header.m_BitsPerLevel), (beg, end, skipBits));
 
     buffer_vector<uint8_t, 576> data;
-    data.resize_no_init(size);
-
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
+    uint8_t const * pData = ReadNode(offset, size, data);
+    ArrayByteSource src(pData);
 
     uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
     uint32_t childOffset = offsetAndFlag >> 1;
@@ -145,12 +324,12 @@ private:
         }
       }
       ASSERT(end0 != (static_cast<uint32_t>(1) << m_Header.m_BitsPerLevel) - 1 ||
-             static_cast<uint8_t const *>(src.Ptr()) - &data[0] == size,
-             (beg, end, beg0, end0, offset, size, src.Ptr(), &data[0]));
+             static_cast<uint8_t const *>(src.Ptr()) - pData == size,
+             (beg, end, beg0, end0, offset, size, src.Ptr(), pData));
     }
     else
     {
-      void const * pEnd = &data[0] + size;
+      void const * pEnd = pData + size;
       while (src.Ptr() < pEnd)
       {
         uint8_t const i = src.ReadByte();
@@ -171,4 +350,7 @@ private:
   ReaderT m_Reader;
   Header m_Header;
   buffer_vector<uint32_t, 7> m_LevelOffsets;
+  // Top levels of the tree, see LoadTopLevels().
+  std::vector<uint8_t> m_TopLevels;
+  uint32_t m_TopLevelsOffset = 0;
 };
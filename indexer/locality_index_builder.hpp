@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace covering
@@ -36,8 +37,10 @@ void BuildLocalityIndex(ObjectsVector const & objects, Writer & writer,
     FileWriter cellsToValueWriter(cellsToValueFile);
 
     WriterFunctor<FileWriter> out(cellsToValueWriter);
-    FileSorter<CellValuePair<uint64_t>, WriterFunctor<FileWriter>> sorter(
-        1024 * 1024 /* bufferBytes */, tmpFilePrefix + CELL2LOCALITY_TMP_EXT, out);
+    FileSorter<CellValuePair<uint64_t>, WriterFunctor<FileWriter>,
+               std::less<CellValuePair<uint64_t>>, RadixSorter>
+        sorter(16 * 1024 * 1024 /* bufferBytes */, tmpFilePrefix + CELL2LOCALITY_TMP_EXT, out,
+               std::less<CellValuePair<uint64_t>>(), std::thread::hardware_concurrency());
     objects.ForEach([&sorter, &coverLocality](indexer::LocalityObject const & o) {
       std::vector<int64_t> const cells =
           coverLocality(o, GetCodingDepth<DEPTH_LEVELS>(scales::GetUpperScale()));
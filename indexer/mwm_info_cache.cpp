@@ -0,0 +1,199 @@
+#include "indexer/mwm_info_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+uint8_t constexpr kFormatVersion = 0;
+
+template <typename Sink>
+void WriteDouble(Sink & sink, double d)
+{
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  WriteToSink(sink, bits);
+}
+
+template <typename Source>
+double ReadDouble(Source & src)
+{
+  auto const bits = ReadPrimitiveFromSource<uint64_t>(src);
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+}  // namespace
+
+bool MwmInfoCache::Load()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_records.clear();
+
+  if (!Platform::IsFileExistsByFullPath(m_path))
+    return false;
+
+  try
+  {
+    FileReader reader(m_path);
+    ReaderSource<FileReader> src(reader);
+
+    if (ReadPrimitiveFromSource<uint8_t>(src) != kFormatVersion)
+    {
+      LOG(LINFO, ("Unknown format of", m_path));
+      return false;
+    }
+
+    auto const count = ReadVarUint<uint32_t>(src);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      string path;
+      rw::Read(src, path);
+
+      Record record;
+      record.m_fileSize = ReadVarUint<uint64_t>(src);
+      record.m_modificationTime = ReadVarUint<uint64_t>(src);
+
+      Entry & entry = record.m_entry;
+      double const minX = ReadDouble(src);
+      double const minY = ReadDouble(src);
+      double const maxX = ReadDouble(src);
+      double const maxY = ReadDouble(src);
+      entry.m_bordersRect = m2::RectD(minX, minY, maxX, maxY);
+      entry.m_minScale = ReadPrimitiveFromSource<uint8_t>(src);
+      entry.m_maxScale = ReadPrimitiveFromSource<uint8_t>(src);
+      entry.m_version.SetFormat(static_cast<version::Format>(ReadVarInt<int32_t>(src)));
+      entry.m_version.SetSecondsSinceEpoch(ReadVarUint<uint64_t>(src));
+      entry.m_data.Deserialize(src);
+
+      m_records[path] = move(record);
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read", m_path, e.Msg()));
+    m_records.clear();
+    return false;
+  }
+  return true;
+}
+
+bool MwmInfoCache::Save() const
+{
+  lock_guard<mutex> lock(m_mutex);
+
+  // The cache is written to a temporary file first, so a crash while saving doesn't leave a
+  // truncated cache behind.
+  string const tmpPath = m_path + ".tmp";
+  try
+  {
+    FileWriter writer(tmpPath);
+    WriteToSink(writer, kFormatVersion);
+
+    uint32_t count = 0;
+    for (auto const & record : m_records)
+    {
+      if (record.second.m_used)
+        ++count;
+    }
+    WriteVarUint(writer, count);
+
+    for (auto const & pathAndRecord : m_records)
+    {
+      Record const & record = pathAndRecord.second;
+      if (!record.m_used)
+        continue;
+
+      rw::Write(writer, pathAndRecord.first);
+      WriteVarUint(writer, record.m_fileSize);
+      WriteVarUint(writer, record.m_modificationTime);
+
+      Entry const & entry = record.m_entry;
+      WriteDouble(writer, entry.m_bordersRect.minX());
+      WriteDouble(writer, entry.m_bordersRect.minY());
+      WriteDouble(writer, entry.m_bordersRect.maxX());
+      WriteDouble(writer, entry.m_bordersRect.maxY());
+      WriteToSink(writer, entry.m_minScale);
+      WriteToSink(writer, entry.m_maxScale);
+      WriteVarInt(writer, static_cast<int32_t>(entry.m_version.GetFormat()));
+      WriteVarUint(writer, entry.m_version.GetSecondsSinceEpoch());
+      entry.m_data.Serialize(writer);
+    }
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't write", tmpPath, e.Msg()));
+    base::DeleteFileX(tmpPath);
+    return false;
+  }
+
+  if (!base::RenameFileX(tmpPath, m_path))
+  {
+    base::DeleteFileX(tmpPath);
+    return false;
+  }
+  return true;
+}
+
+bool MwmInfoCache::Find(platform::LocalCountryFile const & localFile, Entry & entry)
+{
+  string const path = localFile.GetPath(MapOptions::Map);
+
+  uint64_t size;
+  uint64_t modificationTime;
+  if (!GetFileStamp(path, size, modificationTime))
+    return false;
+
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_records.find(path);
+  if (it == m_records.end())
+    return false;
+
+  Record & record = it->second;
+  if (record.m_fileSize != size || record.m_modificationTime != modificationTime)
+    return false;
+
+  record.m_used = true;
+  entry = record.m_entry;
+  return true;
+}
+
+void MwmInfoCache::Put(platform::LocalCountryFile const & localFile, Entry const & entry)
+{
+  string const path = localFile.GetPath(MapOptions::Map);
+
+  Record record;
+  if (!GetFileStamp(path, record.m_fileSize, record.m_modificationTime))
+    return;
+  record.m_entry = entry;
+  record.m_used = true;
+
+  lock_guard<mutex> lock(m_mutex);
+  m_records[path] = move(record);
+}
+
+size_t MwmInfoCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_records.size();
+}
+
+// static
+bool MwmInfoCache::GetFileStamp(string const & path, uint64_t & size, uint64_t & modificationTime)
+{
+  return Platform::GetFileSizeByFullPath(path, size) &&
+         Platform::GetFileModificationTimeByFullPath(path, modificationTime);
+}
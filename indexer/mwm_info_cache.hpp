@@ -0,0 +1,64 @@
+#pragma once
+
+#include "indexer/feature_meta.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/mwm_version.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Persistent cache of the parts of mwm headers which are needed to register mwms. It lets
+// DataSource register an mwm without opening its file when the file is not changed since the
+// info was cached. Files are identified by their full paths, sizes and modification times.
+//
+// *NOTE* This class is thread-safe.
+class MwmInfoCache
+{
+public:
+  struct Entry
+  {
+    m2::RectD m_bordersRect;
+    uint8_t m_minScale = 0;
+    uint8_t m_maxScale = 0;
+    version::MwmVersion m_version;
+    feature::RegionData m_data;
+  };
+
+  explicit MwmInfoCache(std::string const & path) : m_path(path) {}
+
+  // Reads the cache from disk. Returns false when there is no cache or it is broken, the
+  // cache is empty in this case.
+  bool Load();
+
+  // Writes entries which were found or put since Load(). Other entries belong to removed or
+  // updated mwms and are dropped.
+  bool Save() const;
+
+  // Returns false when there is no entry for |localFile| or the file has changed.
+  bool Find(platform::LocalCountryFile const & localFile, Entry & entry);
+  void Put(platform::LocalCountryFile const & localFile, Entry const & entry);
+
+  size_t GetSize() const;
+
+private:
+  struct Record
+  {
+    uint64_t m_fileSize = 0;
+    uint64_t m_modificationTime = 0;
+    Entry m_entry;
+    bool m_used = false;
+  };
+
+  static bool GetFileStamp(std::string const & path, uint64_t & size, uint64_t & modificationTime);
+
+  std::string const m_path;
+
+  mutable std::mutex m_mutex;
+  // Full path of an mwm -> its record.
+  std::unordered_map<std::string, Record> m_records;
+};
@@ -1,18 +1,23 @@
 #include "indexer/mwm_set.hpp"
 #include "indexer/scales.hpp"
 
+#include "coding/mmap_reader.hpp"
 #include "coding/reader.hpp"
 
+#include "platform/constants.hpp"
 #include "platform/local_country_file_utils.hpp"
 
 #include "base/assert.hpp"
 #include "base/exception.hpp"
 #include "base/logging.hpp"
-#include "base/stl_helpers.hpp"
 
 #include <algorithm>
 #include <exception>
+#include <functional>
 #include <sstream>
+#include <thread>
+
+#include "std/target_os.hpp"
 
 #include "defines.hpp"
 
@@ -20,6 +25,29 @@ using namespace std;
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
+namespace
+{
+FilesContainerR::TReader GetMwmReader(LocalCountryFile const & localFile)
+{
+#if defined(OMIM_OS_LINUX)
+  // On 64-bit servers there is enough address space to map all mwms, so sections are read
+  // from mappings instead of caches of file readers.
+  if (sizeof(void *) == 8 && !localFile.GetDirectory().empty())
+  {
+    try
+    {
+      return make_unique<MmapReader>(localFile.GetPath(MapOptions::Map));
+    }
+    catch (Reader::OpenException const & ex)
+    {
+      LOG(LWARNING, ("Can't map", localFile, ex.Msg()));
+    }
+  }
+#endif
+  return platform::GetCountryReader(localFile, MapOptions::Map);
+}
+}  // namespace
+
 MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0) {}
 
 MwmInfo::MwmTypeT MwmInfo::GetType() const
@@ -84,6 +112,118 @@ MwmSet::MwmHandle & MwmSet::MwmHandle::operator=(MwmHandle && handle)
   return *this;
 }
 
+// MwmSet::ValueCache ------------------------------------------------------------------------------
+size_t constexpr MwmSet::ValueCache::kShardsCount;
+
+MwmSet::ValueCache::ValueCache(size_t maxValuesCount, size_t maxMemorySize)
+  : m_maxShardValuesCount((maxValuesCount + kShardsCount - 1) / kShardsCount)
+  , m_maxShardMemorySize(maxMemorySize / kShardsCount)
+{
+}
+
+unique_ptr<MwmSet::MwmValueBase> MwmSet::ValueCache::Take(MwmId const & id)
+{
+  auto & shard = GetShard(id);
+  lock_guard<mutex> lock(shard.m_lock);
+  auto & entries = shard.m_entries;
+  // The most recently released value is taken, it is most likely to be warm.
+  auto const it = find_if(entries.rbegin(), entries.rend(),
+                          [&id](Entry const & entry) { return entry.m_id == id; });
+  if (it == entries.rend())
+  {
+    ++m_misses;
+    return nullptr;
+  }
+
+  ++m_hits;
+  unique_ptr<MwmValueBase> value = move(it->m_value);
+  shard.m_memorySize -= it->m_memorySize;
+  entries.erase(next(it).base());
+  return value;
+}
+
+void MwmSet::ValueCache::Put(MwmId const & id, unique_ptr<MwmValueBase> value)
+{
+  ASSERT(value, ());
+  size_t const memorySize = value->GetMemorySize();
+
+  // Evicted values are destroyed without the lock, as it closes their files.
+  vector<unique_ptr<MwmValueBase>> evicted;
+  {
+    auto & shard = GetShard(id);
+    lock_guard<mutex> lock(shard.m_lock);
+    auto & entries = shard.m_entries;
+    entries.push_back({id, move(value), memorySize});
+    shard.m_memorySize += memorySize;
+
+    while (entries.size() > m_maxShardValuesCount ||
+           (entries.size() > 1 && shard.m_memorySize > m_maxShardMemorySize))
+    {
+      shard.m_memorySize -= entries.front().m_memorySize;
+      evicted.push_back(move(entries.front().m_value));
+      entries.pop_front();
+    }
+  }
+  m_evictions += evicted.size();
+}
+
+vector<unique_ptr<MwmSet::MwmValueBase>> MwmSet::ValueCache::Erase(MwmId const & id)
+{
+  vector<unique_ptr<MwmValueBase>> erased;
+  auto & shard = GetShard(id);
+  lock_guard<mutex> lock(shard.m_lock);
+  auto & entries = shard.m_entries;
+  for (auto it = entries.begin(); it != entries.end();)
+  {
+    if (it->m_id != id)
+    {
+      ++it;
+      continue;
+    }
+    shard.m_memorySize -= it->m_memorySize;
+    erased.push_back(move(it->m_value));
+    it = entries.erase(it);
+  }
+  return erased;
+}
+
+void MwmSet::ValueCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    deque<Entry> entries;
+    {
+      lock_guard<mutex> lock(shard.m_lock);
+      entries.swap(shard.m_entries);
+      shard.m_memorySize = 0;
+    }
+  }
+}
+
+MwmSet::CacheStats MwmSet::ValueCache::GetStats() const
+{
+  CacheStats stats;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_lock);
+    stats.m_valuesCount += shard.m_entries.size();
+    stats.m_memorySize += shard.m_memorySize;
+  }
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  stats.m_evictions = m_evictions;
+  return stats;
+}
+
+MwmSet::ValueCache::Shard & MwmSet::ValueCache::GetShard(MwmId const & id)
+{
+  return m_shards[hash<MwmInfo const *>()(id.GetInfo().get()) % kShardsCount];
+}
+
+// MwmSet ------------------------------------------------------------------------------------------
+size_t constexpr MwmSet::kDefaultCacheSize;
+size_t constexpr MwmSet::kDefaultCacheMemorySize;
+
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFileImpl(CountryFile const & countryFile) const
 {
   string const & name = countryFile.GetName();
@@ -96,68 +236,122 @@ MwmSet::MwmId MwmSet::GetMwmIdByCountryFileImpl(CountryFile const & countryFile)
 
 pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::Register(LocalCountryFile const & localFile)
 {
-  pair<MwmSet::MwmId, MwmSet::RegResult> result;
-  auto registerFile = [&](EventList & events)
-  {
-    CountryFile const & countryFile = localFile.GetCountryFile();
-    MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
-    if (!id.IsAlive())
-    {
-      result = RegisterImpl(localFile, events);
-      return;
-    }
+  // The info is created without the lock, as it reads the file. It can throw an exception
+  // for a bad mwm file.
+  unique_ptr<MwmInfo> info = CreateInfo(localFile);
 
-    shared_ptr<MwmInfo> info = id.GetInfo();
+  pair<MwmSet::MwmId, MwmSet::RegResult> result;
+  WithEventLog([&](EventList & events)
+               {
+                 result = RegisterImpl(localFile, [&]() { return move(info); }, events);
+               });
+  return result;
+}
 
-    // Deregister old mwm for the country.
-    if (info->GetVersion() < localFile.GetVersion())
-    {
-      EventList subEvents;
-      DeregisterImpl(id, subEvents);
-      result = RegisterImpl(localFile, subEvents);
-
-      // In the case of success all sub-events are
-      // replaced with a single UPDATE event. Otherwise,
-      // sub-events are reported as is.
-      if (result.second == MwmSet::RegResult::Success)
-        events.Add(Event(Event::TYPE_UPDATED, localFile, info->GetLocalFile()));
-      else
-        events.Append(subEvents);
-      return;
-    }
+vector<pair<MwmSet::MwmId, MwmSet::RegResult>> MwmSet::Register(
+    vector<LocalCountryFile> const & localFiles, size_t threadsCount)
+{
+  vector<unique_ptr<MwmInfo>> infos(localFiles.size());
+  // Nonzero for files CreateInfo() throws for. Each element is written by a single thread and
+  // read after the threads are joined, so char is used instead of the packed vector<bool>.
+  vector<char> bad(localFiles.size(), 0);
+  atomic<size_t> next(0);
 
-    string const name = countryFile.GetName();
-    // Update the status of the mwm with the same version.
-    if (info->GetVersion() == localFile.GetVersion())
+  auto createInfos = [&]() {
+    for (size_t i = next++; i < localFiles.size(); i = next++)
     {
-      LOG(LINFO, ("Updating already registered mwm:", name));
-      SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
-      info->m_file = localFile;
-      result = make_pair(id, RegResult::VersionAlreadyExists);
-      return;
+      try
+      {
+        infos[i] = CreateInfo(localFiles[i]);
+      }
+      catch (RootException const & ex)
+      {
+        LOG(LERROR, ("IO error while adding", localFiles[i].GetCountryName(), "map.", ex.Msg()));
+        bad[i] = 1;
+      }
     }
-
-    LOG(LWARNING, ("Trying to add too old (", localFile.GetVersion(), ") mwm (", name,
-                   "), current version:", info->GetVersion()));
-    result = make_pair(MwmId(), RegResult::VersionTooOld);
-    return;
   };
 
-  WithEventLog(registerFile);
-  return result;
+  threadsCount = min(threadsCount, localFiles.size());
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(createInfos);
+  createInfos();
+  for (auto & t : threads)
+    t.join();
+
+  vector<pair<MwmId, RegResult>> results(localFiles.size());
+  WithEventLog([&](EventList & events)
+               {
+                 for (size_t i = 0; i < localFiles.size(); ++i)
+                 {
+                   if (bad[i] != 0)
+                   {
+                     results[i] = make_pair(MwmId(), RegResult::BadFile);
+                     continue;
+                   }
+                   results[i] = RegisterImpl(localFiles[i], [&]() { return move(infos[i]); },
+                                             events);
+                 }
+               });
+  return results;
 }
 
 pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterImpl(LocalCountryFile const & localFile,
+                                                            CreateInfoFn const & createInfo,
                                                             EventList & events)
 {
-  // This function can throw an exception for a bad mwm file.
-  shared_ptr<MwmInfo> info(CreateInfo(localFile));
+  CountryFile const & countryFile = localFile.GetCountryFile();
+  MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
+  if (!id.IsAlive())
+    return RegisterNewImpl(localFile, createInfo, events);
+
+  shared_ptr<MwmInfo> info = id.GetInfo();
+
+  // Deregister old mwm for the country.
+  if (info->GetVersion() < localFile.GetVersion())
+  {
+    EventList subEvents;
+    DeregisterImpl(id, subEvents);
+    auto const result = RegisterNewImpl(localFile, createInfo, subEvents);
+
+    // In the case of success all sub-events are
+    // replaced with a single UPDATE event. Otherwise,
+    // sub-events are reported as is.
+    if (result.second == MwmSet::RegResult::Success)
+      events.Add(Event(Event::TYPE_UPDATED, localFile, info->GetLocalFile()));
+    else
+      events.Append(subEvents);
+    return result;
+  }
+
+  string const name = countryFile.GetName();
+  // Update the status of the mwm with the same version.
+  if (info->GetVersion() == localFile.GetVersion())
+  {
+    LOG(LINFO, ("Updating already registered mwm:", name));
+    SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
+    info->m_file = localFile;
+    return make_pair(id, RegResult::VersionAlreadyExists);
+  }
+
+  LOG(LWARNING, ("Trying to add too old (", localFile.GetVersion(), ") mwm (", name,
+                 "), current version:", info->GetVersion()));
+  return make_pair(MwmId(), RegResult::VersionTooOld);
+}
+
+pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterNewImpl(LocalCountryFile const & localFile,
+                                                               CreateInfoFn const & createInfo,
+                                                               EventList & events)
+{
+  shared_ptr<MwmInfo> info(createInfo());
   if (!info)
     return make_pair(MwmId(), RegResult::UnsupportedFileFormat);
 
   info->m_file = localFile;
   SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
   m_info[localFile.GetCountryName()].push_back(info);
+  m_isSnapshotStale = true;
 
   return make_pair(MwmId(info), RegResult::Success);
 }
@@ -173,14 +367,8 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     SetStatus(*info, MwmInfo::STATUS_DEREGISTERED, events);
     vector<shared_ptr<MwmInfo>> & infos = m_info[info->GetCountryName()];
     infos.erase(remove(infos.begin(), infos.end(), info), infos.end());
-    for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
-    {
-      if (it->first == id)
-      {
-        m_cache.erase(it);
-        break;
-      }
-    }
+    m_isSnapshotStale = true;
+    events.AddReleasedValues(m_cache.Erase(id));
     return true;
   }
 
@@ -204,28 +392,38 @@ bool MwmSet::DeregisterImpl(CountryFile const & countryFile, EventList & events)
   if (!id.IsAlive())
     return false;
   bool const deregistered = DeregisterImpl(id, events);
-  ClearCache(id);
+  ClearCache(id, events);
   return deregistered;
 }
 
 bool MwmSet::IsLoaded(CountryFile const & countryFile) const
 {
-  lock_guard<mutex> lock(m_lock);
-
-  MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
+  MwmId const id = GetMwmIdByCountryFile(countryFile);
   return id.IsAlive() && id.GetInfo()->IsRegistered();
 }
 
 void MwmSet::GetMwmsInfo(vector<shared_ptr<MwmInfo>> & info) const
 {
-  lock_guard<mutex> lock(m_lock);
+  auto const snapshot = GetSnapshot();
   info.clear();
-  info.reserve(m_info.size());
+  info.reserve(snapshot->size());
+  for (auto const & p : *snapshot)
+    info.push_back(p.second);
+}
+
+void MwmSet::PublishSnapshot()
+{
+  if (!m_isSnapshotStale)
+    return;
+  m_isSnapshotStale = false;
+
+  auto snapshot = make_shared<Snapshot>();
   for (auto const & p : m_info)
   {
     if (!p.second.empty())
-      info.push_back(p.second.back());
+      snapshot->emplace_hint(snapshot->end(), p.first, p.second.back());
   }
+  atomic_store(&m_snapshot, shared_ptr<Snapshot const>(move(snapshot)));
 }
 
 void MwmSet::SetStatus(MwmInfo & info, MwmInfo::Status status, EventList & events)
@@ -267,38 +465,27 @@ void MwmSet::ProcessEventList(EventList & events)
 
 unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValue(MwmId const & id)
 {
-  unique_ptr<MwmSet::MwmValueBase> result;
-  WithEventLog([&](EventList & events)
-               {
-                 result = LockValueImpl(id, events);
-               });
-  return result;
-}
-
-unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
-{
-  if (!id.IsAlive())
-    return nullptr;
-  shared_ptr<MwmInfo> info = id.GetInfo();
-
-  // It's better to return valid "value pointer" even for "out-of-date" files,
-  // because they can be locked for a long time by other algos.
-  //if (!info->IsUpToDate())
-  //  return TMwmValueBasePtr();
+  shared_ptr<MwmInfo> info;
+  {
+    lock_guard<mutex> lock(m_lock);
+    if (!id.IsAlive())
+      return nullptr;
+    info = id.GetInfo();
 
-  ++info->m_numRefs;
+    // It's better to return valid "value pointer" even for "out-of-date" files,
+    // because they can be locked for a long time by other algos.
+    //if (!info->IsUpToDate())
+    //  return TMwmValueBasePtr();
 
-  // Search in cache.
-  for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
-  {
-    if (it->first == id)
-    {
-      unique_ptr<MwmValueBase> result = move(it->second);
-      m_cache.erase(it);
-      return result;
-    }
+    ++info->m_numRefs;
   }
 
+  // The mwm can't be deregistered while it is referenced, so the cache and CreateValue()
+  // are used without |m_lock|.
+  unique_ptr<MwmValueBase> value = m_cache.Take(id);
+  if (value)
+    return value;
+
   try
   {
     return CreateValue(*info);
@@ -306,116 +493,99 @@ unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventLi
   catch (Reader::TooManyFilesException const & ex)
   {
     LOG(LERROR, ("Too many open files, can't open:", info->GetCountryName()));
-    --info->m_numRefs;
+    WithEventLog([&](EventList & events) { ReleaseRefImpl(id, events); });
     return nullptr;
   }
   catch (exception const & ex)
   {
     LOG(LERROR, ("Can't create MWMValue for", info->GetCountryName(), "Reason", ex.what()));
 
-    --info->m_numRefs;
-    DeregisterImpl(id, events);
+    WithEventLog([&](EventList & events)
+                 {
+                   ReleaseRefImpl(id, events);
+                   DeregisterImpl(id, events);
+                 });
     return nullptr;
   }
 }
 
 void MwmSet::UnlockValue(MwmId const & id, unique_ptr<MwmValueBase> p)
-{
-  WithEventLog([&](EventList & events)
-               {
-                 UnlockValueImpl(id, move(p), events);
-               });
-}
-
-void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p, EventList & events)
 {
   ASSERT(id.IsAlive(), (id));
   ASSERT(p.get() != nullptr, ());
   if (!id.IsAlive() || !p)
     return;
 
+  WithEventLog([&](EventList & events) { ReleaseRefImpl(id, events); });
+
+  shared_ptr<MwmInfo> const & info = id.GetInfo();
+  if (!info->IsUpToDate())
+    return;
+
+  /// @todo Probably, it's better to store only "unique by id" free caches here.
+  /// But it's no obvious if we have many threads working with the single mwm.
+  m_cache.Put(id, move(p));
+
+  // The mwm may be deregistered after its reference is released and before the value is
+  // cached. Deregistration changes the status before it clears the cache, so either
+  // the cache is cleared after the value is put, or the new status is seen here.
+  if (!info->IsUpToDate())
+    UNUSED_VALUE(m_cache.Erase(id));
+}
+
+void MwmSet::ReleaseRefImpl(MwmId const & id, EventList & events)
+{
   shared_ptr<MwmInfo> const & info = id.GetInfo();
   ASSERT_GREATER(info->m_numRefs, 0, ());
   --info->m_numRefs;
   if (info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
     VERIFY(DeregisterImpl(id, events), ());
-
-  if (info->IsUpToDate())
-  {
-    /// @todo Probably, it's better to store only "unique by id" free caches here.
-    /// But it's no obvious if we have many threads working with the single mwm.
-
-    m_cache.push_back(make_pair(id, move(p)));
-    if (m_cache.size() > m_cacheSize)
-    {
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
-      m_cache.pop_front();
-    }
-  }
 }
 
 void MwmSet::Clear()
 {
-  lock_guard<mutex> lock(m_lock);
-  ClearCacheImpl(m_cache.begin(), m_cache.end());
-  m_info.clear();
+  {
+    lock_guard<mutex> lock(m_lock);
+    m_info.clear();
+    m_isSnapshotStale = true;
+    PublishSnapshot();
+  }
+  // The cache has its own locks, values are destroyed without |m_lock|.
+  m_cache.Clear();
 }
 
-void MwmSet::ClearCache()
-{
-  lock_guard<mutex> lock(m_lock);
-  ClearCacheImpl(m_cache.begin(), m_cache.end());
-}
+void MwmSet::ClearCache() { m_cache.Clear(); }
 
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
 {
-  lock_guard<mutex> lock(m_lock);
-  return GetMwmIdByCountryFileImpl(countryFile);
+  string const & name = countryFile.GetName();
+  ASSERT(!name.empty(), ());
+  auto const snapshot = GetSnapshot();
+  auto const it = snapshot->find(name);
+  if (it == snapshot->cend())
+    return MwmId();
+  return MwmId(it->second);
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleByCountryFile(CountryFile const & countryFile)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-               {
-                 handle = GetMwmHandleByIdImpl(GetMwmIdByCountryFileImpl(countryFile), events);
-               });
-  return handle;
+  return GetMwmHandleById(GetMwmIdByCountryFile(countryFile));
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleById(MwmId const & id)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-               {
-                 handle = GetMwmHandleByIdImpl(id, events);
-               });
-  return handle;
+  return MwmHandle(*this, id, LockValue(id));
 }
 
-MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & events)
+void MwmSet::ClearCache(MwmId const & id, EventList & events)
 {
-  unique_ptr<MwmValueBase> value;
-  if (id.IsAlive())
-    value = LockValueImpl(id, events);
-  return MwmHandle(*this, id, move(value));
-}
-
-void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end) { m_cache.erase(beg, end); }
-
-void MwmSet::ClearCache(MwmId const & id)
-{
-  auto sameId = [&id](pair<MwmSet::MwmId, unique_ptr<MwmSet::MwmValueBase>> const & p)
-  {
-    return (p.first == id);
-  };
-  ClearCacheImpl(base::RemoveIfKeepValid(m_cache.begin(), m_cache.end(), sameId), m_cache.end());
+  events.AddReleasedValues(m_cache.Erase(id));
 }
 
 // MwmValue ----------------------------------------------------------------------------------------
 
 MwmValue::MwmValue(LocalCountryFile const & localFile)
-  : m_cont(platform::GetCountryReader(localFile, MapOptions::Map)), m_file(localFile)
+  : m_cont(GetMwmReader(localFile)), m_file(localFile)
 {
   m_factory.Load(m_cont);
 }
@@ -426,6 +596,7 @@ void MwmValue::SetTable(MwmInfoEx & info)
   if (version < version::Format::v5)
     return;
 
+  lock_guard<mutex> lock(info.m_tableLock);
   m_table = info.m_table.lock();
   if (!m_table)
   {
@@ -437,6 +608,14 @@ void MwmValue::SetTable(MwmInfoEx & info)
   }
 }
 
+size_t MwmValue::GetMemorySize() const
+{
+  size_t size = sizeof(*this) + (size_t(1) << (READER_CHUNK_LOG_SIZE + READER_CHUNK_LOG_COUNT));
+  if (m_table)
+    size += m_table->byte_size();
+  return size;
+}
+
 string DebugPrint(MwmSet::RegResult result)
 {
   switch (result)
@@ -455,6 +634,15 @@ string DebugPrint(MwmSet::RegResult result)
   CHECK_SWITCH();
 }
 
+string DebugPrint(MwmSet::CacheStats const & stats)
+{
+  ostringstream os;
+  os << "CacheStats [ values: " << stats.m_valuesCount << ", memory: " << stats.m_memorySize
+     << ", hits: " << stats.m_hits << ", misses: " << stats.m_misses
+     << ", evictions: " << stats.m_evictions << " ]";
+  return os.str();
+}
+
 string DebugPrint(MwmSet::Event::Type type)
 {
   switch (type)
@@ -12,8 +12,11 @@
 #include "indexer/feature_meta.hpp"
 #include "indexer/features_offsets_table.hpp"
 
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -98,10 +101,10 @@ private:
   // MwmSet's cache. We can't use shared_ptr because of offsets table
   // must be removed as soon as the last corresponding MwmValue is
   // destroyed. Also, note that this value must be used and modified
-  // only in MwmValue::SetTable() method, which, in turn, is called
-  // only in the MwmSet critical section, protected by a lock.  So,
-  // there's an implicit synchronization on this field.
+  // only in MwmValue::SetTable() method under |m_tableLock|, because
+  // values of the same mwm may be created by several threads at once.
   std::weak_ptr<feature::FeaturesOffsetsTable> m_table;
+  std::mutex m_tableLock;
 };
 
 class MwmSet
@@ -133,13 +136,34 @@ public:
   };
 
 public:
-  explicit MwmSet(size_t cacheSize = 64) : m_cacheSize(cacheSize) {}
+  static size_t constexpr kDefaultCacheSize = 64;
+  static size_t constexpr kDefaultCacheMemorySize = 256 * 1024 * 1024;
+
+  // The cache of values keeps at most |cacheSize| values, which take at most |cacheMemorySize|
+  // bytes. The last released value of a shard is kept even if it is bigger.
+  explicit MwmSet(size_t cacheSize = kDefaultCacheSize,
+                  size_t cacheMemorySize = kDefaultCacheMemorySize)
+    : m_cache(cacheSize, cacheMemorySize)
+  {
+  }
   virtual ~MwmSet() = default;
 
   class MwmValueBase
   {
   public:
     virtual ~MwmValueBase() = default;
+
+    // Returns an estimation of memory which is held by the value, in bytes.
+    virtual size_t GetMemorySize() const { return sizeof(*this); }
+  };
+
+  struct CacheStats
+  {
+    size_t m_valuesCount = 0;
+    size_t m_memorySize = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
   };
 
   // Mwm handle, which is used to refer to mwm and prevent it from
@@ -222,10 +246,19 @@ public:
       m_events.insert(m_events.end(), events.m_events.begin(), events.m_events.end());
     }
 
+    // Values of deregistered mwms are destroyed with the list, i.e. after the lock of MwmSet
+    // is released, because it closes their files.
+    void AddReleasedValues(std::vector<std::unique_ptr<MwmValueBase>> && values)
+    {
+      for (auto & value : values)
+        m_releasedValues.push_back(std::move(value));
+    }
+
     std::vector<Event> const & Get() const { return m_events; }
 
   private:
     std::vector<Event> m_events;
+    std::vector<std::unique_ptr<MwmValueBase>> m_releasedValues;
 
     DISALLOW_COPY_AND_MOVE(EventList);
   };
@@ -270,10 +303,24 @@ public:
   /// are older than the localFile (in this case mwm handle will point
   /// to just-registered file).
 protected:
-  pair<MwmId, RegResult> RegisterImpl(platform::LocalCountryFile const & localFile, EventList & events);
+  using CreateInfoFn = std::function<std::unique_ptr<MwmInfo>()>;
+
+  // Registers |localFile| or updates an already registered mwm of the same country.
+  // |createInfo| is called only when the file really has to be registered.
+  pair<MwmId, RegResult> RegisterImpl(platform::LocalCountryFile const & localFile,
+                                      CreateInfoFn const & createInfo, EventList & events);
+  pair<MwmId, RegResult> RegisterNewImpl(platform::LocalCountryFile const & localFile,
+                                         CreateInfoFn const & createInfo, EventList & events);
 
 public:
   pair<MwmId, RegResult> Register(platform::LocalCountryFile const & localFile);
+
+  /// Registers all |localFiles| as Register() does, results are in the order of |localFiles|.
+  /// Infos of the files are created by up to |threadsCount| threads at once without the
+  /// lock, so a slow file doesn't block other users of MwmSet. Infos are created for all
+  /// files, even the ones which turn out to be already registered.
+  std::vector<pair<MwmId, RegResult>> Register(
+      std::vector<platform::LocalCountryFile> const & localFiles, size_t threadsCount);
   //@}
 
   /// @name Remove mwm.
@@ -300,6 +347,15 @@ public:
   /// Returns true when country is registered and can be used.
   bool IsLoaded(platform::CountryFile const & countryFile) const;
 
+  /// Immutable registry of the latest infos of countries. A new snapshot is published on each
+  /// change of the registry, so a reader which holds a snapshot sees the same mwms for the
+  /// whole request and doesn't wait for registrations. Infos of the snapshot stay valid while
+  /// it is held, values of deregistered mwms are destroyed when their handles are released.
+  using Snapshot = std::map<std::string, std::shared_ptr<MwmInfo>>;
+
+  /// Lock-free, may be called from any thread.
+  std::shared_ptr<Snapshot const> GetSnapshot() const { return std::atomic_load(&m_snapshot); }
+
   /// Get ids of all mwms. Some of them may be with not active status.
   /// In that case, LockValue returns NULL.
   void GetMwmsInfo(std::vector<std::shared_ptr<MwmInfo>> & info) const;
@@ -309,6 +365,8 @@ public:
 
   void ClearCache();
 
+  CacheStats GetCacheStats() const { return m_cache.GetStats(); }
+
   MwmId GetMwmIdByCountryFile(platform::CountryFile const & countryFile) const;
 
   MwmHandle GetMwmHandleByCountryFile(platform::CountryFile const & countryFile);
@@ -328,7 +386,51 @@ protected:
   virtual std::unique_ptr<MwmValueBase> CreateValue(MwmInfo & info) const = 0;
 
 private:
-  using Cache = std::deque<std::pair<MwmId, std::unique_ptr<MwmValueBase>>>;
+  // Cache of released values. Values are spread over shards by their mwms, and each shard has
+  // its own lock, so threads which lock values of different mwms don't wait for each other.
+  // Each shard evicts its least recently released values.
+  class ValueCache
+  {
+  public:
+    ValueCache(size_t maxValuesCount, size_t maxMemorySize);
+
+    // Returns nullptr when there are no cached values of |id|.
+    std::unique_ptr<MwmValueBase> Take(MwmId const & id);
+    void Put(MwmId const & id, std::unique_ptr<MwmValueBase> value);
+    // Returns the erased values, so the caller decides where they are destroyed.
+    std::vector<std::unique_ptr<MwmValueBase>> Erase(MwmId const & id);
+    void Clear();
+
+    CacheStats GetStats() const;
+
+  private:
+    static size_t constexpr kShardsCount = 8;
+
+    struct Entry
+    {
+      MwmId m_id;
+      std::unique_ptr<MwmValueBase> m_value;
+      size_t m_memorySize;
+    };
+
+    struct Shard
+    {
+      mutable std::mutex m_lock;
+      // Least recently released values are at the front.
+      std::deque<Entry> m_entries;
+      size_t m_memorySize = 0;
+    };
+
+    Shard & GetShard(MwmId const & id);
+
+    std::array<Shard, kShardsCount> m_shards;
+    size_t const m_maxShardValuesCount;
+    size_t const m_maxShardMemorySize;
+
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+  };
 
   // This is the only valid way to take |m_lock| and use *Impl()
   // functions. The reason is that event processing requires
@@ -344,45 +446,51 @@ private:
     {
       std::lock_guard<std::mutex> lock(m_lock);
       fn(events);
+      PublishSnapshot();
     }
     ProcessEventList(events);
   }
 
+  /// Makes a snapshot of |m_info| available to readers if |m_info| is changed.
+  /// @precondition This function is always called under mutex m_lock.
+  void PublishSnapshot();
+
   // Sets |status| in |info|, adds corresponding event to |event|.
   void SetStatus(MwmInfo & info, MwmInfo::Status status, EventList & events);
 
   // Triggers observers on each event in |events|.
   void ProcessEventList(EventList & events);
 
-  /// @precondition This function is always called under mutex m_lock.
-  MwmHandle GetMwmHandleByIdImpl(MwmId const & id, EventList & events);
-
+  // Only the reference counter of the mwm is changed under |m_lock|. Values are taken from
+  // the cache and created without it.
   std::unique_ptr<MwmValueBase> LockValue(MwmId const & id);
-  std::unique_ptr<MwmValueBase> LockValueImpl(MwmId const & id, EventList & events);
   void UnlockValue(MwmId const & id, std::unique_ptr<MwmValueBase> p);
-  void UnlockValueImpl(MwmId const & id, std::unique_ptr<MwmValueBase> p, EventList & events);
 
-  /// Do the cleaning for [beg, end) without acquiring the mutex.
+  /// Decrements the reference counter and deregisters the mwm if it was marked to.
   /// @precondition This function is always called under mutex m_lock.
-  void ClearCacheImpl(Cache::iterator beg, Cache::iterator end);
+  void ReleaseRefImpl(MwmId const & id, EventList & events);
 
-  Cache m_cache;
-  size_t const m_cacheSize;
+  ValueCache m_cache;
 
 protected:
   /// @precondition This function is always called under mutex m_lock.
-  void ClearCache(MwmId const & id);
+  void ClearCache(MwmId const & id, EventList & events);
 
   /// Find mwm with a given name.
   /// @precondition This function is always called under mutex m_lock.
   MwmId GetMwmIdByCountryFileImpl(platform::CountryFile const & countryFile) const;
 
   std::map<std::string, std::vector<std::shared_ptr<MwmInfo>>> m_info;
+  // Is set when |m_info| is changed after the last published snapshot.
+  bool m_isSnapshotStale = false;
 
   mutable std::mutex m_lock;
 
 private:
-  base::ObserverListSafe<Observer> m_observers;
+  // Is accessed by std::atomic_load() and std::atomic_store() only.
+  std::shared_ptr<Snapshot const> m_snapshot = std::make_shared<Snapshot const>();
+
+  base::ObserverListCopyOnWrite<Observer> m_observers;
 }; // class MwmSet
 
 class MwmValue : public MwmSet::MwmValueBase
@@ -397,6 +505,10 @@ public:
   explicit MwmValue(platform::LocalCountryFile const & localFile);
   void SetTable(MwmInfoEx & info);
 
+  // Counts the offsets table and the chunk cache of the file reader, which is counted
+  // by its limit.
+  size_t GetMemorySize() const override;
+
   feature::DataHeader const & GetHeader() const  { return m_factory.GetHeader(); }
   feature::RegionData const & GetRegionData() const { return m_factory.GetRegionData(); }
   version::MwmVersion const & GetMwmVersion() const { return m_factory.GetMwmVersion(); }
@@ -408,5 +520,6 @@ public:
 
 
 std::string DebugPrint(MwmSet::RegResult result);
+std::string DebugPrint(MwmSet::CacheStats const & stats);
 std::string DebugPrint(MwmSet::Event::Type type);
 std::string DebugPrint(MwmSet::Event const & event);
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "indexer/trie.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Packed trie format:
+// [node] ... [node]
+// [4: root offset]
+//
+// Unlike the format of trie_builder.hpp, nodes have a fixed layout and are traversed in place
+// by trie::PackedTrieIterator: labels and offsets of children are arrays of uint32, so moving
+// along an edge neither decodes nor allocates anything. All numbers are little-endian uint32.
+// Nodes are written in post-order, so offsets of children are known when their parent is
+// written. Offsets are counted from the beginning of the trie and are multiples of 4.
+//
+// Node format:
+// [4: childCount]
+// [4: valuesSize]
+// [4 * childCount: first chars of edges], in the ascending order
+// [4 * childCount: offsets of children]
+// [4 * (childCount + 1): label begins], edge i is labels[labelBegins[i], labelBegins[i + 1])
+// [4 * labelBegins[childCount]: labels]
+// [valuesSize: valueList]
+// [padding to 4]
+
+namespace trie
+{
+namespace impl
+{
+struct PackedChildInfo
+{
+  std::vector<TrieChar> m_label;
+  uint32_t m_offset = 0;
+};
+
+template <typename Value>
+struct PackedNodeInfo
+{
+  explicit PackedNodeInfo(TrieChar c) : m_char(c) {}
+
+  TrieChar m_char;
+  std::vector<Value> m_values;
+  std::vector<PackedChildInfo> m_children;
+};
+
+// Writes |node| and returns its offset from |trieBeg|.
+template <typename Sink, typename ValueList, typename Serializer, typename Value>
+uint32_t WritePackedNode(Sink & sink, uint64_t trieBeg, Serializer const & serializer,
+                         PackedNodeInfo<Value> const & node)
+{
+  // Values are serialized first because their size precedes the edges.
+  buffer_vector<uint8_t, 64> values;
+  {
+    ValueList valueList;
+    valueList.Init(node.m_values);
+    PushBackByteSink<buffer_vector<uint8_t, 64>> valuesSink(values);
+    valueList.Serialize(valuesSink, serializer);
+  }
+
+  uint32_t const offset = base::asserted_cast<uint32_t>(sink.Pos() - trieBeg);
+  ASSERT_EQUAL(offset % 4, 0, ());
+
+  auto const & children = node.m_children;
+  WriteToSink(sink, base::asserted_cast<uint32_t>(children.size()));
+  WriteToSink(sink, base::asserted_cast<uint32_t>(values.size()));
+  for (auto const & child : children)
+    WriteToSink(sink, child.m_label[0]);
+  for (auto const & child : children)
+    WriteToSink(sink, child.m_offset);
+
+  uint32_t labelBegin = 0;
+  WriteToSink(sink, labelBegin);
+  for (auto const & child : children)
+  {
+    labelBegin += base::asserted_cast<uint32_t>(child.m_label.size());
+    WriteToSink(sink, labelBegin);
+  }
+  for (auto const & child : children)
+  {
+    for (auto const c : child.m_label)
+      WriteToSink(sink, c);
+  }
+
+  sink.Write(values.data(), values.size());
+  while ((sink.Pos() - trieBeg) % 4 != 0)
+    WriteToSink(sink, static_cast<uint8_t>(0));
+  return offset;
+}
+
+template <typename Sink, typename ValueList, typename Serializer, typename Nodes>
+void PopPackedNodes(Sink & sink, uint64_t trieBeg, Serializer const & serializer, Nodes & nodes,
+                    size_t nodesToPop)
+{
+  ASSERT_GREATER(nodes.size(), nodesToPop, ());
+  for (; nodesToPop > 0; --nodesToPop)
+  {
+    auto & node = nodes.back();
+    auto & prevNode = nodes[nodes.size() - 2];
+
+    PackedChildInfo child;
+    if (node.m_values.empty() && node.m_children.size() == 1)
+    {
+      // The node is merged with its only child into a longer edge.
+      child = std::move(node.m_children[0]);
+      child.m_label.insert(child.m_label.begin(), node.m_char);
+    }
+    else
+    {
+      child.m_label.push_back(node.m_char);
+      child.m_offset = WritePackedNode<Sink, ValueList>(sink, trieBeg, serializer, node);
+    }
+    prevNode.m_children.emplace_back(std::move(child));
+
+    nodes.pop_back();
+  }
+}
+}  // namespace impl
+
+// Builds the packed trie of <key, value> pairs passed by |forEachPair(toDo)| to |toDo|, which
+// must be called for pairs in the sorted order, as for trie::BuildFromSorted(). Unlike there,
+// the result is written in the reading order and must not be reversed.
+template <typename Sink, typename Key, typename ValueList, typename Serializer,
+          typename ForEachPair>
+void BuildPackedFromSorted(Sink & sink, Serializer const & serializer, ForEachPair && forEachPair)
+{
+  using Value = typename ValueList::Value;
+  using NodeInfo = impl::PackedNodeInfo<Value>;
+
+  uint64_t const trieBeg = sink.Pos();
+  std::vector<NodeInfo> nodes;
+  nodes.emplace_back(kDefaultChar);
+
+  std::pair<Key, Value> prevE;  // e for "element".
+  bool isFirst = true;
+
+  forEachPair([&](std::pair<Key, Value> const & e) {
+    if (!isFirst && e == prevE)
+      return;
+    isFirst = false;
+
+    auto const & key = e.first;
+    auto const & prevKey = prevE.first;
+    CHECK(!(key < prevKey), (key, prevKey));
+    size_t nCommon = 0;
+    while (nCommon < std::min(key.size(), prevKey.size()) && prevKey[nCommon] == key[nCommon])
+      ++nCommon;
+
+    // Root is also a common node.
+    impl::PopPackedNodes<Sink, ValueList>(sink, trieBeg, serializer, nodes,
+                                          nodes.size() - nCommon - 1);
+    for (size_t i = nCommon; i < key.size(); ++i)
+      nodes.emplace_back(key[i]);
+
+    // Values of a key come in the sorted order, only equal neighbours are to be skipped.
+    auto & values = nodes.back().m_values;
+    if (values.empty() || !(values.back() == e.second))
+      values.push_back(e.second);
+
+    prevE = e;
+  });
+
+  impl::PopPackedNodes<Sink, ValueList>(sink, trieBeg, serializer, nodes, nodes.size() - 1);
+
+  uint32_t const rootOffset =
+      impl::WritePackedNode<Sink, ValueList>(sink, trieBeg, serializer, nodes.back());
+  WriteToSink(sink, rootOffset);
+}
+
+template <typename Sink, typename Key, typename ValueList, typename Serializer>
+void BuildPacked(Sink & sink, Serializer const & serializer,
+                 std::vector<std::pair<Key, typename ValueList::Value>> const & data)
+{
+  BuildPackedFromSorted<Sink, Key, ValueList, Serializer>(sink, serializer,
+                                                          [&data](auto && toDo) {
+                                                            for (auto const & e : data)
+                                                              toDo(e);
+                                                          });
+}
+}  // namespace trie
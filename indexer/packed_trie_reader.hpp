@@ -0,0 +1,144 @@
+#pragma once
+
+#include "indexer/trie.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/reader.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace trie
+{
+// Node of a trie in the packed format, see packed_trie_builder.hpp.
+//
+// The iterator points into the memory of the trie: it is cheap to copy, edges and labels are
+// read in place and GoToEdge() allocates nothing. Values are deserialized on every
+// ForEachValue() call. The memory of the trie must outlive iterators.
+template <typename ValueList, typename Serializer>
+class PackedTrieIterator
+{
+public:
+  using Value = typename ValueList::Value;
+
+  class Label
+  {
+  public:
+    Label(TrieChar const * begin, TrieChar const * end) : m_begin(begin), m_end(end) {}
+
+    TrieChar const * begin() const { return m_begin; }
+    TrieChar const * end() const { return m_end; }
+    size_t size() const { return static_cast<size_t>(m_end - m_begin); }
+    TrieChar const & operator[](size_t i) const
+    {
+      ASSERT_LESS(i, size(), ());
+      return m_begin[i];
+    }
+
+  private:
+    TrieChar const * m_begin;
+    TrieChar const * m_end;
+  };
+
+  PackedTrieIterator(uint32_t const * trie, uint32_t offset, Serializer const & serializer)
+    : m_trie(trie), m_node(trie + offset / 4), m_serializer(serializer)
+  {
+    ASSERT_EQUAL(offset % 4, 0, ());
+  }
+
+  size_t GetEdgesCount() const { return m_node[0]; }
+
+  TrieChar GetEdgeFirstChar(size_t i) const
+  {
+    ASSERT_LESS(i, GetEdgesCount(), ());
+    return GetFirstChars()[i];
+  }
+
+  Label GetEdgeLabel(size_t i) const
+  {
+    ASSERT_LESS(i, GetEdgesCount(), ());
+    uint32_t const * labelBegins = GetLabelBegins();
+    TrieChar const * labels = labelBegins + GetEdgesCount() + 1;
+    return Label(labels + labelBegins[i], labels + labelBegins[i + 1]);
+  }
+
+  // Returns the index of the edge which starts with |c| or GetEdgesCount() if there is none.
+  size_t FindEdge(TrieChar c) const
+  {
+    TrieChar const * begin = GetFirstChars();
+    TrieChar const * end = begin + GetEdgesCount();
+    TrieChar const * it = std::lower_bound(begin, end, c);
+    return it != end && *it == c ? static_cast<size_t>(it - begin) : GetEdgesCount();
+  }
+
+  PackedTrieIterator GoToEdge(size_t i) const
+  {
+    ASSERT_LESS(i, GetEdgesCount(), ());
+    return PackedTrieIterator(m_trie, GetChildOffsets()[i], m_serializer);
+  }
+
+  bool HasValues() const { return m_node[1] != 0; }
+
+  template <typename ToDo>
+  void ForEachValue(ToDo && toDo) const
+  {
+    if (!HasValues())
+      return;
+
+    size_t const count = GetEdgesCount();
+    uint32_t const * labelBegins = GetLabelBegins();
+    uint32_t const * values = labelBegins + count + 1 + labelBegins[count];
+    MemReader reader(values, m_node[1]);
+    ReaderSource<MemReader> source(reader);
+
+    ValueList valueList;
+    valueList.Deserialize(source, m_serializer);
+    valueList.ForEach(toDo);
+  }
+
+private:
+  TrieChar const * GetFirstChars() const { return m_node + 2; }
+  uint32_t const * GetChildOffsets() const { return m_node + 2 + GetEdgesCount(); }
+  uint32_t const * GetLabelBegins() const { return m_node + 2 + 2 * GetEdgesCount(); }
+
+  uint32_t const * m_trie;
+  uint32_t const * m_node;
+  Serializer m_serializer;
+};
+
+// Returns iterator to the root of the packed trie in [data, data + size). |data| must be
+// aligned by 4 bytes, which holds for mwm sections as they are aligned by 8 bytes.
+template <typename ValueList, typename Serializer>
+PackedTrieIterator<ValueList, Serializer> ReadPackedTrie(void const * data, size_t size,
+                                                         Serializer const & serializer)
+{
+  // Numbers are read in place, so the byte order of the format must be the native one.
+  CHECK(IsLittleEndian(), ());
+  CHECK_EQUAL(reinterpret_cast<uintptr_t>(data) % 4, 0, ());
+  CHECK_GREATER_OR_EQUAL(size, sizeof(uint32_t), ());
+  CHECK_EQUAL(size % 4, 0, ());
+
+  auto const * trie = static_cast<uint32_t const *>(data);
+  uint32_t const rootOffset = trie[size / 4 - 1];
+  CHECK_LESS(rootOffset, size, ());
+  return PackedTrieIterator<ValueList, Serializer>(trie, rootOffset, serializer);
+}
+
+template <typename ValueList, typename Serializer, typename ToDo, typename String>
+void ForEachRef(PackedTrieIterator<ValueList, Serializer> const & it, ToDo && toDo,
+                String const & s)
+{
+  it.ForEachValue([&toDo, &s](typename ValueList::Value const & value) { toDo(s, value); });
+
+  for (size_t i = 0; i < it.GetEdgesCount(); ++i)
+  {
+    String s1(s);
+    auto const label = it.GetEdgeLabel(i);
+    s1.insert(s1.end(), label.begin(), label.end());
+    ForEachRef(it.GoToEdge(i), toDo, s1);
+  }
+}
+}  // namespace trie
@@ -0,0 +1,435 @@
+#include "indexer/classificator.hpp"
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "coding/multilang_utf8_string.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include "pyhelpers/scoped_gil_release.hpp"
+
+// These headers are necessary for cross-python compilation.
+// Python3 does not have PyString_* methods. One should use PyBytes_* instead.
+// bytesobject.h contains a mapping from PyBytes_* to PyString_*.
+// See https://docs.python.org/2/howto/cporting.html for more.
+#include "Python.h"
+#include "bytesobject.h"
+
+#include <boost/python.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+void Init(string const & resource_path, string const & mwm_path)
+{
+  auto & platform = GetPlatform();
+  if (!resource_path.empty())
+    platform.SetResourceDir(resource_path);
+  if (!mwm_path.empty())
+    platform.SetWritableDirForTests(mwm_path);
+
+  classificator::Load();
+}
+
+string GetTypeName(uint32_t type) { return classif().GetReadableObjectName(type); }
+
+// Features of a batch are stored by columns. Columns of variable length values are
+// concatenations of the values and offsets of the values, the offsets have one more element
+// than the number of features.
+struct NativeBatch
+{
+  string m_mwm;
+  vector<uint32_t> m_featureIds;
+  vector<uint32_t> m_types;
+  vector<uint32_t> m_typeOffsets = {0};
+  // Mercator x and y of centers of the features.
+  vector<double> m_centers;
+  // UTF-8 names of the features, empty when a feature has no name in the language.
+  string m_names;
+  vector<uint32_t> m_nameOffsets = {0};
+  // Values of feature::EGeomType.
+  vector<uint8_t> m_geomTypes;
+  // Mercator x and y of points of lines and of vertices of triangles of areas.
+  vector<double> m_points;
+  vector<uint32_t> m_pointOffsets = {0};
+};
+
+template <typename T>
+boost::python::object ToBytes(vector<T> const & v)
+{
+  auto const bytes = PyBytes_FromStringAndSize(reinterpret_cast<char const *>(v.data()),
+                                               v.size() * sizeof(T));
+  if (bytes == nullptr)
+    boost::python::throw_error_already_set();
+  return boost::python::object(boost::python::handle<>(bytes));
+}
+
+boost::python::object ToBytes(string const & s)
+{
+  auto const bytes = PyBytes_FromStringAndSize(s.data(), s.size());
+  if (bytes == nullptr)
+    boost::python::throw_error_already_set();
+  return boost::python::object(boost::python::handle<>(bytes));
+}
+
+// Columns are bytes which can be wrapped without copying, e.g. by
+// numpy.frombuffer(batch.centers, dtype=numpy.float64).
+struct Batch
+{
+  Batch() = default;
+
+  explicit Batch(NativeBatch const & batch)
+    : m_mwm(batch.m_mwm)
+    , m_size(batch.m_featureIds.size())
+    , m_featureIds(ToBytes(batch.m_featureIds))
+    , m_types(ToBytes(batch.m_types))
+    , m_typeOffsets(ToBytes(batch.m_typeOffsets))
+    , m_centers(ToBytes(batch.m_centers))
+    , m_names(ToBytes(batch.m_names))
+    , m_nameOffsets(ToBytes(batch.m_nameOffsets))
+    , m_geomTypes(ToBytes(batch.m_geomTypes))
+    , m_points(ToBytes(batch.m_points))
+    , m_pointOffsets(ToBytes(batch.m_pointOffsets))
+  {
+  }
+
+  size_t Size() const { return m_size; }
+
+  string m_mwm;
+  size_t m_size = 0;
+  boost::python::object m_featureIds;
+  boost::python::object m_types;
+  boost::python::object m_typeOffsets;
+  boost::python::object m_centers;
+  boost::python::object m_names;
+  boost::python::object m_nameOffsets;
+  boost::python::object m_geomTypes;
+  boost::python::object m_points;
+  boost::python::object m_pointOffsets;
+};
+
+struct ReadParams
+{
+  int8_t m_lang = StringUtf8Multilang::kDefaultCode;
+  size_t m_batchSize = 0;
+  bool m_withGeometry = true;
+  // Features are read when their centers are in the rect.
+  m2::RectD m_rect;
+};
+
+// Decodes features of mwms on several threads. Batches are queued by the threads and
+// are taken by Python, the threads wait while the queue is full.
+class FeaturesStream
+{
+public:
+  FeaturesStream(shared_ptr<FrozenDataSource> dataSource, vector<MwmSet::MwmId> && mwms,
+                 ReadParams const & params, size_t numThreads)
+    : m_dataSource(move(dataSource))
+    , m_mwms(move(mwms))
+    , m_params(params)
+    , m_maxQueueSize(2 * numThreads)
+  {
+    numThreads = min(numThreads, m_mwms.size());
+    m_numActiveThreads = numThreads;
+    for (size_t i = 0; i < numThreads; ++i)
+      m_threads.emplace_back(&FeaturesStream::Decode, this);
+  }
+
+  ~FeaturesStream()
+  {
+    {
+      lock_guard<mutex> lock(m_mu);
+      m_shutdown = true;
+    }
+    m_cv.notify_all();
+
+    scoped_gil_release const release;
+    for (auto & thread : m_threads)
+      thread.join();
+  }
+
+  Batch Next()
+  {
+    unique_ptr<NativeBatch> batch;
+    {
+      scoped_gil_release const release;
+      unique_lock<mutex> lock(m_mu);
+      m_cv.wait(lock, [this]() { return !m_batches.empty() || m_numActiveThreads == 0; });
+      if (!m_batches.empty())
+      {
+        batch = move(m_batches.front());
+        m_batches.pop();
+      }
+    }
+    m_cv.notify_all();
+
+    if (!batch)
+    {
+      PyErr_SetString(PyExc_StopIteration, "No more batches.");
+      boost::python::throw_error_already_set();
+    }
+    return Batch(*batch);
+  }
+
+private:
+  void Decode()
+  {
+    while (true)
+    {
+      size_t i = 0;
+      {
+        lock_guard<mutex> lock(m_mu);
+        if (m_shutdown || m_nextMwm == m_mwms.size())
+          break;
+        i = m_nextMwm++;
+      }
+
+      if (!DecodeMwm(m_mwms[i]))
+        break;
+    }
+
+    {
+      lock_guard<mutex> lock(m_mu);
+      --m_numActiveThreads;
+    }
+    m_cv.notify_all();
+  }
+
+  // Returns false when the stream is destroyed.
+  bool DecodeMwm(MwmSet::MwmId const & id)
+  {
+    FeaturesLoaderGuard const guard(*m_dataSource, id);
+    auto const mwm = id.GetInfo()->GetCountryName();
+    auto batch = make_unique<NativeBatch>();
+    batch->m_mwm = mwm;
+
+    FeatureType ft;
+    size_t const numFeatures = guard.GetNumFeatures();
+    for (size_t i = 0; i < numFeatures; ++i)
+    {
+      if (!guard.GetFeatureByIndex(base::checked_cast<uint32_t>(i), ft))
+        continue;
+
+      auto const center = feature::GetCenter(ft);
+      if (!m_params.m_rect.IsPointInside(center))
+        continue;
+
+      AddFeature(base::checked_cast<uint32_t>(i), center, ft, *batch);
+      if (batch->m_featureIds.size() == m_params.m_batchSize)
+      {
+        if (!Push(move(batch)))
+          return false;
+        batch = make_unique<NativeBatch>();
+        batch->m_mwm = mwm;
+      }
+    }
+
+    if (batch->m_featureIds.empty())
+      return true;
+    return Push(move(batch));
+  }
+
+  void AddFeature(uint32_t featureId, m2::PointD const & center, FeatureType & ft,
+                  NativeBatch & batch) const
+  {
+    batch.m_featureIds.push_back(featureId);
+
+    ft.ForEachType([&batch](uint32_t type) { batch.m_types.push_back(type); });
+    batch.m_typeOffsets.push_back(base::checked_cast<uint32_t>(batch.m_types.size()));
+
+    batch.m_centers.push_back(center.x);
+    batch.m_centers.push_back(center.y);
+
+    string name;
+    if (ft.GetName(m_params.m_lang, name))
+      batch.m_names += name;
+    batch.m_nameOffsets.push_back(base::checked_cast<uint32_t>(batch.m_names.size()));
+
+    auto const geomType = ft.GetFeatureType();
+    batch.m_geomTypes.push_back(static_cast<uint8_t>(geomType));
+    if (m_params.m_withGeometry)
+    {
+      auto const addPoint = [&batch](m2::PointD const & p) {
+        batch.m_points.push_back(p.x);
+        batch.m_points.push_back(p.y);
+      };
+      if (geomType == feature::GEOM_AREA)
+      {
+        ft.ForEachTriangle(
+            [&addPoint](m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3) {
+              addPoint(p1);
+              addPoint(p2);
+              addPoint(p3);
+            },
+            FeatureType::BEST_GEOMETRY);
+      }
+      else
+      {
+        ft.ForEachPoint(addPoint, FeatureType::BEST_GEOMETRY);
+      }
+    }
+    batch.m_pointOffsets.push_back(base::checked_cast<uint32_t>(batch.m_points.size() / 2));
+  }
+
+  // Returns false when the stream is destroyed.
+  bool Push(unique_ptr<NativeBatch> batch)
+  {
+    {
+      unique_lock<mutex> lock(m_mu);
+      m_cv.wait(lock, [this]() { return m_shutdown || m_batches.size() < m_maxQueueSize; });
+      if (m_shutdown)
+        return false;
+      m_batches.push(move(batch));
+    }
+    m_cv.notify_all();
+    return true;
+  }
+
+  shared_ptr<FrozenDataSource> m_dataSource;
+  vector<MwmSet::MwmId> const m_mwms;
+  ReadParams const m_params;
+  size_t const m_maxQueueSize;
+
+  mutex m_mu;
+  condition_variable m_cv;
+  // The following fields are guarded by |m_mu|.
+  size_t m_nextMwm = 0;
+  size_t m_numActiveThreads = 0;
+  queue<unique_ptr<NativeBatch>> m_batches;
+  bool m_shutdown = false;
+
+  vector<thread> m_threads;
+};
+
+boost::python::object Identity(boost::python::object const & self) { return self; }
+
+struct FeaturesReader
+{
+  // Zero |numThreads| means the number of hardware threads.
+  explicit FeaturesReader(size_t numThreads = 0)
+    : m_dataSource(make_shared<FrozenDataSource>())
+    , m_numThreads(numThreads != 0 ? numThreads
+                                   : max(static_cast<size_t>(thread::hardware_concurrency()),
+                                         size_t(1)))
+  {
+    vector<platform::LocalCountryFile> mwms;
+    platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max() /* the latest version */,
+                                         mwms);
+    for (auto & mwm : mwms)
+    {
+      mwm.SyncWithDisk();
+      m_dataSource->RegisterMap(mwm);
+    }
+  }
+
+  boost::python::list GetMwms() const
+  {
+    vector<shared_ptr<MwmInfo>> infos;
+    m_dataSource->GetMwmsInfo(infos);
+
+    boost::python::list mwms;
+    for (auto const & info : infos)
+      mwms.append(info->GetCountryName());
+    return mwms;
+  }
+
+  // Reads features of all mwms in batches of up to |batch_size| features of the same mwm.
+  // When |rect| is a tuple (min_x, min_y, max_x, max_y) in mercator, only features with centers
+  // in the rect are read.
+  shared_ptr<FeaturesStream> Read(string const & lang, size_t batch_size, bool with_geometry,
+                                  boost::python::object const & rect) const
+  {
+    CHECK_GREATER(batch_size, 0, ());
+
+    ReadParams params;
+    params.m_lang = StringUtf8Multilang::GetLangIndex(lang);
+    CHECK_NOT_EQUAL(params.m_lang, StringUtf8Multilang::kUnsupportedLanguageCode,
+                    ("Unsupported language:", lang));
+    params.m_batchSize = batch_size;
+    params.m_withGeometry = with_geometry;
+    if (rect.is_none())
+    {
+      params.m_rect.MakeInfinite();
+    }
+    else
+    {
+      using boost::python::extract;
+      params.m_rect = m2::RectD(extract<double>(rect[0]), extract<double>(rect[1]),
+                                extract<double>(rect[2]), extract<double>(rect[3]));
+    }
+
+    vector<shared_ptr<MwmInfo>> infos;
+    m_dataSource->GetMwmsInfo(infos);
+
+    vector<MwmSet::MwmId> mwms;
+    for (auto const & info : infos)
+    {
+      if (info->m_bordersRect.IsIntersect(params.m_rect))
+        mwms.emplace_back(info);
+    }
+
+    return make_shared<FeaturesStream>(m_dataSource, move(mwms), params, m_numThreads);
+  }
+
+  shared_ptr<FrozenDataSource> m_dataSource;
+  size_t m_numThreads;
+};
+}  // namespace
+
+BOOST_PYTHON_MODULE(pyindexer)
+{
+  using namespace boost::python;
+
+  def("init", &Init);
+  def("type_name", &GetTypeName);
+
+  class_<Batch>("Batch")
+      .def_readonly("mwm", &Batch::m_mwm)
+      .def_readonly("feature_ids", &Batch::m_featureIds)
+      .def_readonly("types", &Batch::m_types)
+      .def_readonly("type_offsets", &Batch::m_typeOffsets)
+      .def_readonly("centers", &Batch::m_centers)
+      .def_readonly("names", &Batch::m_names)
+      .def_readonly("name_offsets", &Batch::m_nameOffsets)
+      .def_readonly("geom_types", &Batch::m_geomTypes)
+      .def_readonly("points", &Batch::m_points)
+      .def_readonly("point_offsets", &Batch::m_pointOffsets)
+      .def("__len__", &Batch::Size);
+
+  class_<FeaturesStream, shared_ptr<FeaturesStream>, boost::noncopyable>("FeaturesStream",
+                                                                        no_init)
+      .def("__iter__", &Identity)
+      .def("__next__", &FeaturesStream::Next)
+      .def("next", &FeaturesStream::Next);
+
+  class_<FeaturesReader>("FeaturesReader", init<optional<size_t>>())
+      .def("mwms", &FeaturesReader::GetMwms)
+      .def("read", &FeaturesReader::Read,
+           (boost::python::arg("lang") = "default", boost::python::arg("batch_size") = 100000,
+            boost::python::arg("with_geometry") = true, boost::python::arg("rect") = object()));
+}
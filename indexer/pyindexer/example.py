@@ -0,0 +1,43 @@
+from __future__ import print_function
+from pyindexer import FeaturesReader, init, type_name
+import argparse
+import collections
+import numpy as np
+
+parser = argparse.ArgumentParser(description='Example usage of pyindexer.')
+parser.add_argument("--data_path", dest="data_path", default="",
+                    help="Path to the directory that contains classificator.txt and types.txt.")
+parser.add_argument("--mwm_path", dest="mwm_path", default="", help="Path to mwm files.")
+parser.add_argument("--lang", dest="lang", default="en", help="Language of names.")
+parser.add_argument("--threads", dest="threads", type=int, default=0,
+                    help="Number of decoding threads, zero means all hardware threads.")
+
+options = parser.parse_args()
+init(options.data_path, options.mwm_path)
+
+reader = FeaturesReader(options.threads)
+print("Mwms:", reader.mwms())
+
+num_features = 0
+num_named = 0
+type_counts = collections.Counter()
+for batch in reader.read(lang=options.lang, batch_size=100000, with_geometry=False):
+  num_features += len(batch)
+
+  # Columns are wrapped without copying.
+  types = np.frombuffer(batch.types, dtype=np.uint32)
+  type_offsets = np.frombuffer(batch.type_offsets, dtype=np.uint32)
+  centers = np.frombuffer(batch.centers, dtype=np.float64).reshape(-1, 2)
+  name_offsets = np.frombuffer(batch.name_offsets, dtype=np.uint32)
+
+  # The first type of every feature.
+  type_counts.update(types[type_offsets[:-1]].tolist())
+  num_named += int(np.count_nonzero(np.diff(name_offsets)))
+
+  if len(batch) != 0:
+    first_name = batch.names[name_offsets[0]:name_offsets[1]].decode('utf-8')
+    print(batch.mwm, len(batch), "features, first:", first_name, centers[0])
+
+print("Features:", num_features, "with names:", num_named)
+for t, count in type_counts.most_common(10):
+  print(type_name(t), count)
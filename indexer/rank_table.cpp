@@ -103,6 +103,13 @@ public:
 
     return m_coding.Get(i);
   }
+  void GetRanks(vector<uint32_t> const & ids, vector<uint8_t> & ranks) const override
+  {
+    uint64_t const size = Size();
+    ranks.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+      ranks[i] = ids[i] < size ? m_coding.Get(ids[i]) : 0;
+  }
   uint64_t Size() const override { return m_coding.Size(); }
   RankTable::Version GetVersion() const override { return V0; }
   void Serialize(Writer & writer, bool preserveHostEndianness) override
@@ -294,6 +301,13 @@ unique_ptr<RankTable> CreateSearchRankTableIfNotExists(FilesContainerR & rcont)
 }
 }  // namespace
 
+void RankTable::GetRanks(vector<uint32_t> const & ids, vector<uint8_t> & ranks) const
+{
+  ranks.resize(ids.size());
+  for (size_t i = 0; i < ids.size(); ++i)
+    ranks[i] = Get(ids[i]);
+}
+
 // static
 unique_ptr<RankTable> RankTable::Load(FilesContainerR const & rcont, string const & sectionName)
 {
@@ -51,6 +51,10 @@ public:
   // Returns rank of the i-th feature.
   virtual uint8_t Get(uint64_t i) const = 0;
 
+  // Replaces |ranks| by ranks of features |ids|. It is a batch version of Get() which needs
+  // a single virtual call for all features.
+  virtual void GetRanks(std::vector<uint32_t> const & ids, std::vector<uint8_t> & ranks) const;
+
   // Returns total number of ranks (or features, as there is a 1-1 correspondence).
   virtual uint64_t Size() const = 0;
 
@@ -62,6 +62,28 @@ public:
     }
   }
 
+  // Calls |fn| for features from all |intervals| on |scale|. Each index is walked once for
+  // all intervals, see IntervalIndex::ForEach().
+  template <typename Intervals>
+  void ForEachInIntervalsAndScale(Intervals const & intervals, int scale,
+                                  std::function<void(uint32_t)> const & fn) const
+  {
+    auto const scaleBucket = BucketByScale(scale);
+    if (scaleBucket < m_IndexForScale.size())
+    {
+      for (size_t i = 0; i <= scaleBucket; ++i)
+        m_IndexForScale[i]->ForEach(fn, intervals);
+    }
+  }
+
+  // Keeps top levels of each index which fit |maxSize| bytes in memory,
+  // see IntervalIndex::LoadTopLevels().
+  void LoadTopLevels(uint32_t maxSize)
+  {
+    for (auto & index : m_IndexForScale)
+      index->LoadTopLevels(maxSize);
+  }
+
 private:
   std::vector<std::unique_ptr<IntervalIndex<Reader, uint32_t>>> m_IndexForScale;
 };
@@ -21,7 +21,9 @@
 #include "base/scope_guard.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -135,10 +137,12 @@ void IndexScales(feature::DataHeader const & header, FeaturesVector const & feat
   {
     FileWriter cellsToFeaturesAllBucketsWriter(cellsToFeatureAllBucketsFile);
 
-    using TSorter = FileSorter<CellFeatureBucketTuple, WriterFunctor<FileWriter>>;
+    using TSorter = FileSorter<CellFeatureBucketTuple, WriterFunctor<FileWriter>,
+                               std::less<CellFeatureBucketTuple>, RadixSorter>;
     using TDisplacementManager = DisplacementManager<TSorter>;
     WriterFunctor<FileWriter> out(cellsToFeaturesAllBucketsWriter);
-    TSorter sorter(1024 * 1024 /* bufferBytes */, tmpFilePrefix + CELL2FEATURE_TMP_EXT, out);
+    TSorter sorter(16 * 1024 * 1024 /* bufferBytes */, tmpFilePrefix + CELL2FEATURE_TMP_EXT, out,
+                   std::less<CellFeatureBucketTuple>(), std::thread::hardware_concurrency());
     // Heuristically rearrange and filter single-point features to simplify
     // the runtime decision of whether we should draw a feature
     // or sacrifice it for the sake of more important ones.
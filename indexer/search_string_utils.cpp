@@ -44,7 +44,28 @@ void RemoveNumeroSigns(UniString & s)
 
 UniString NormalizeAndSimplifyString(string const & s)
 {
-  UniString uniString = MakeUniString(s);
+  UniString uniString;
+  NormalizeAndSimplifyString(s, uniString);
+  return uniString;
+}
+
+void NormalizeAndSimplifyString(string const & s, UniString & uniString)
+{
+  MakeUniStringInplace(s, uniString);
+
+  // ASCII fast path: none of the replacements below touches ASCII chars, normalization
+  // doesn't change them and case folding of ASCII is just the lower case of latin letters.
+  if (IsASCIIString(s))
+  {
+    for (UniChar & c : uniString)
+    {
+      if (c >= 'A' && c <= 'Z')
+        c += 'a' - 'A';
+    }
+    RemoveNumeroSigns(uniString);
+    return;
+  }
+
   for (size_t i = 0; i < uniString.size(); ++i)
   {
     UniChar & c = uniString[i];
@@ -101,8 +122,6 @@ UniString NormalizeAndSimplifyString(string const & s)
 
   RemoveNumeroSigns(uniString);
 
-  return uniString;
-
   /// @todo Restore this logic to distinguish и-й in future.
   /*
   // Just after lower casing is a correct place to avoid normalization for specific chars.
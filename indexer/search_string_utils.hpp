@@ -15,6 +15,9 @@ namespace search
 // This function should be used for all search strings normalization.
 // It does some magic text transformation which greatly helps us to improve our search.
 strings::UniString NormalizeAndSimplifyString(std::string const & s);
+// Same as above, but reuses memory of |result|, so it's better to call it in loops over many
+// strings with the same |result|.
+void NormalizeAndSimplifyString(std::string const & s, strings::UniString & result);
 
 template <class Delims, typename Fn>
 void SplitUniString(strings::UniString const & uniS, Fn && f, Delims const & delims)
@@ -23,6 +26,14 @@ void SplitUniString(strings::UniString const & uniS, Fn && f, Delims const & del
     f(iter.GetUniString());
 }
 
+// Same as above, but |f| is called with views of |uniS|, so tokens are not copied.
+template <class Delims, typename Fn>
+void SplitUniStringToViews(strings::UniString const & uniS, Fn && f, Delims const & delims)
+{
+  for (strings::TokenizeIterator<Delims> iter(uniS, delims); iter; ++iter)
+    f(iter.GetUniStringView());
+}
+
 template <typename Tokens, typename Delims>
 void NormalizeAndTokenizeString(std::string const & s, Tokens & tokens, Delims const & delims)
 {
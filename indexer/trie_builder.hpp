@@ -230,9 +230,12 @@ void AppendValue(NodeInfo & node, Value const & value)
     LOG(LERROR, ("Cannot append to a finalized value list."));
 }
 
-template <typename Sink, typename Key, typename ValueList, typename Serializer>
-void Build(Sink & sink, Serializer const & serializer,
-           std::vector<std::pair<Key, typename ValueList::Value>> const & data)
+// Builds the trie of <key, value> pairs passed by |forEachPair(toDo)| to |toDo|, which
+// must be called for pairs in the sorted order. Pairs may be produced on the fly, e.g. by
+// a merge of sorted runs, so they do not have to be kept in memory all together.
+template <typename Sink, typename Key, typename ValueList, typename Serializer,
+          typename ForEachPair>
+void BuildFromSorted(Sink & sink, Serializer const & serializer, ForEachPair && forEachPair)
 {
   using Value = typename ValueList::Value;
   using NodeInfo = NodeInfo<ValueList>;
@@ -240,16 +243,16 @@ void Build(Sink & sink, Serializer const & serializer,
   std::vector<NodeInfo> nodes;
   nodes.emplace_back(sink.Pos(), kDefaultChar);
 
-  Key prevKey;
   std::pair<Key, Value> prevE;  // e for "element".
+  bool isFirst = true;
 
-  for (auto it = data.begin(); it != data.end(); ++it)
-  {
-    auto e = *it;
-    if (it != data.begin() && e == prevE)
-      continue;
+  forEachPair([&](std::pair<Key, Value> const & e) {
+    if (!isFirst && e == prevE)
+      return;
+    isFirst = false;
 
     auto const & key = e.first;
+    auto const & prevKey = prevE.first;
     CHECK(!(key < prevKey), (key, prevKey));
     size_t nCommon = 0;
     while (nCommon < std::min(key.size(), prevKey.size()) && prevKey[nCommon] == key[nCommon])
@@ -262,9 +265,8 @@ void Build(Sink & sink, Serializer const & serializer,
       nodes.emplace_back(pos, key[i]);
     AppendValue(nodes.back(), e.second);
 
-    prevKey = key;
-    std::swap(e, prevE);
-  }
+    prevE = e;
+  });
 
   // Pop all the nodes from the stack.
   PopNodes(sink, serializer, nodes, nodes.size() - 1);
@@ -272,4 +274,14 @@ void Build(Sink & sink, Serializer const & serializer,
   // Write the root.
   WriteNodeReverse(sink, serializer, kDefaultChar /* baseChar */, nodes.back(), true /* isRoot */);
 }
+
+template <typename Sink, typename Key, typename ValueList, typename Serializer>
+void Build(Sink & sink, Serializer const & serializer,
+           std::vector<std::pair<Key, typename ValueList::Value>> const & data)
+{
+  BuildFromSorted<Sink, Key, ValueList, Serializer>(sink, serializer, [&data](auto && toDo) {
+    for (auto const & e : data)
+      toDo(e);
+  });
+}
 }  // namespace trie
@@ -35,6 +35,13 @@ void IndexAndTypeMapping::Load(istream & s)
   }
 }
 
+void IndexAndTypeMapping::Load(vector<uint32_t> const & types)
+{
+  Clear();
+  for (size_t i = 0; i < types.size(); ++i)
+    Add(static_cast<uint32_t>(i), types[i]);
+}
+
 void IndexAndTypeMapping::Add(uint32_t ind, uint32_t type)
 {
   ASSERT_EQUAL ( ind, m_types.size(), () );
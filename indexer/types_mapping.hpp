@@ -12,8 +12,12 @@ class IndexAndTypeMapping
 public:
   void Clear();
   void Load(std::istream & s);
+  // Loads the mapping where |types[i]| is the type of the index i.
+  void Load(std::vector<uint32_t> const & types);
   bool IsLoaded() const { return !m_types.empty(); }
 
+  std::vector<uint32_t> const & GetTypes() const { return m_types; }
+
   // Throws std::out_of_range exception.
   uint32_t GetType(uint32_t ind) const
   {
@@ -10,8 +10,20 @@ namespace kml
 {
 namespace binary
 {
+enum class Version : uint8_t
+{
+  V0 = 0,
+  V1 = 1, // 11th April 2018 (new Point2D storage, added deviceId, feature name -> custom name).
+  V2 = 2, // 25th April 2018 (added serverId).
+  V3 = 3, // 7th May 2018 (persistent feature types).
+  V4 = 4, // 14th October 2026 (added bookmarks index).
+  Latest = V4
+};
+
 struct Header
 {
+  explicit Header(Version version = Version::Latest) : m_version(version) {}
+
   template <typename Visitor>
   void Visit(Visitor & visitor)
   {
@@ -19,6 +31,8 @@ struct Header
     visitor(m_bookmarksOffset, "bookmarksOffset");
     visitor(m_tracksOffset, "tracksOffset");
     visitor(m_stringsOffset, "stringsOffset");
+    if (m_version >= Version::V4)
+      visitor(m_bookmarksIndexOffset, "bookmarksIndexOffset");
     visitor(m_eosOffset, "eosOffset");
   }
 
@@ -48,7 +62,11 @@ struct Header
   uint64_t m_bookmarksOffset = 0;
   uint64_t m_tracksOffset = 0;
   uint64_t m_stringsOffset = 0;
+  uint64_t m_bookmarksIndexOffset = 0;
   uint64_t m_eosOffset = 0;
+
+  // Is not serialized, defines the set of sections.
+  Version m_version;
 };
 }  // namespace binary
 }  // namespace kml
@@ -5,6 +5,8 @@
 
 #include "indexer/classificator_loader.hpp"
 
+#include "geometry/mercator.hpp"
+
 #include "coding/file_name_utils.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
@@ -482,7 +484,7 @@ UNIT_TEST(Kml_Serialization_Bin_Memory)
 
   std::vector<uint8_t> buffer;
   {
-    kml::binary::SerializerKml ser(data);
+    kml::binary::SerializerKml ser(data, kml::binary::Version::V3);
     MemWriter<decltype(buffer)> sink(buffer);
     ser.Serialize(sink);
   }
@@ -664,3 +666,113 @@ UNIT_TEST(Kml_Serialization_Text_File)
   }
   TEST_EQUAL(dataFromMemory, data, ());
 }
+
+// 8. Check random access to bookmarks of the binary file with the bookmarks index.
+UNIT_TEST(Kml_Bin_Bookmarks_Index)
+{
+  auto data = GenerateKmlFileData();
+  auto bookmark = data.m_bookmarksData.front();
+  bookmark.m_point = m2::PointD(10.0, 20.0);
+  bookmark.m_name[kDefaultLang] = "Second bookmark";
+  data.m_bookmarksData.push_back(bookmark);
+  bookmark.m_point = m2::PointD(-30.0, 40.0);
+  bookmark.m_name[kDefaultLang] = "Third bookmark";
+  data.m_bookmarksData.push_back(bookmark);
+
+  std::vector<uint8_t> buffer;
+  {
+    kml::binary::SerializerKml ser(data);
+    MemWriter<decltype(buffer)> sink(buffer);
+    ser.Serialize(sink);
+  }
+
+  kml::FileData dataFromBin;
+  {
+    kml::binary::DeserializerKml des(dataFromBin);
+    MemReader reader(buffer.data(), buffer.size());
+    des.Deserialize(reader);
+  }
+  TEST_EQUAL(data, dataFromBin, ());
+
+  MemReader reader(buffer.data(), buffer.size());
+  kml::binary::IndexedDeserializerKml des(reader);
+  TEST_EQUAL(des.GetBookmarksCount(), 3, ());
+  for (uint32_t i = 0; i < des.GetBookmarksCount(); ++i)
+    TEST_EQUAL(des.GetBookmark(i), data.m_bookmarksData[i], ());
+
+  std::vector<uint32_t> indices;
+  des.ForEachBookmarkInRect(m2::RectD(0.0, 0.0, 50.0, 60.0),
+                            [&indices](uint32_t index, m2::PointD const &) {
+                              indices.push_back(index);
+                            });
+  TEST_EQUAL(indices, std::vector<uint32_t>({1, 0}), ());
+
+  indices.clear();
+  des.ForEachBookmarkInRect(m2::RectD(-40.0, 30.0, -20.0, 50.0),
+                            [&indices](uint32_t index, m2::PointD const & pt) {
+                              indices.push_back(index);
+                              TEST(m2::PointD(-30.0, 40.0).EqualDxDy(pt, 1e-5), (pt));
+                            });
+  TEST_EQUAL(indices, std::vector<uint32_t>({2}), ());
+
+  // Files of previous versions have no index.
+  MemReader oldReader(kBinKml.data(), kBinKml.size());
+  TEST_ANY_THROW(kml::binary::IndexedDeserializerKml oldDes(oldReader), ());
+}
+
+// 9. Check parsing of coordinates of points and tracks, including invalid ones.
+UNIT_TEST(Kml_Deserialization_Coordinates)
+{
+  char const * kKml = R"(<?xml version="1.0" encoding="UTF-8"?>
+<kml xmlns="http://earth.google.com/kml/2.2">
+<Document>
+  <Placemark>
+    <name>Point</name>
+    <Point><coordinates>
+      27.566765 , 53.900047,0
+    </coordinates></Point>
+  </Placemark>
+  <Placemark>
+    <name>Line</name>
+    <LineString><coordinates>
+      45.9242,49.326859,0 45.9242,49.326859 45.2244,48.941288
+      1e,2 200,10 45.1964,49.401948,15.5
+    </coordinates></LineString>
+  </Placemark>
+  <Placemark>
+    <name>Track</name>
+    <gx:Track>
+      <gx:coord>37.5 55.75 100</gx:coord>
+      <gx:coord>37.6 55.8</gx:coord>
+      <gx:coord>37.7 invalid</gx:coord>
+    </gx:Track>
+  </Placemark>
+</Document>
+</kml>)";
+
+  kml::FileData data;
+  {
+    kml::DeserializerKml des(data);
+    MemReader reader(kKml, strlen(kKml));
+    des.Deserialize(reader);
+  }
+
+  TEST_EQUAL(data.m_bookmarksData.size(), 1, ());
+  TEST(data.m_bookmarksData[0].m_point.EqualDxDy(
+           MercatorBounds::FromLatLon(53.900047, 27.566765), 1e-9), ());
+
+  TEST_EQUAL(data.m_tracksData.size(), 2, ());
+  std::vector<m2::PointD> const linePoints = {MercatorBounds::FromLatLon(49.326859, 45.9242),
+                                              MercatorBounds::FromLatLon(48.941288, 45.2244),
+                                              MercatorBounds::FromLatLon(49.401948, 45.1964)};
+  std::vector<m2::PointD> const trackPoints = {MercatorBounds::FromLatLon(55.75, 37.5),
+                                               MercatorBounds::FromLatLon(55.8, 37.6)};
+  auto const testPoints = [](std::vector<m2::PointD> const & points,
+                             std::vector<m2::PointD> const & expected) {
+    TEST_EQUAL(points.size(), expected.size(), ());
+    for (size_t i = 0; i < expected.size(); ++i)
+      TEST(points[i].EqualDxDy(expected[i], 1e-9), (points[i], expected[i]));
+  };
+  testPoints(data.m_tracksData[0].m_points, linePoints);
+  testPoints(data.m_tracksData[1].m_points, trackPoints);
+}
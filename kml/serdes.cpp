@@ -12,6 +12,9 @@
 #include "base/string_utils.hpp"
 #include "base/timer.hpp"
 
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 using namespace std::string_literals;
@@ -27,6 +30,7 @@ std::string const kStyleMap = "StyleMap";
 std::string const kStyleUrl = "styleUrl";
 std::string const kPair = "Pair";
 std::string const kExtendedData = "ExtendedData";
+std::string const kEmptyTag;
 
 std::string const kKmlHeader =
   "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
@@ -485,6 +489,34 @@ void SaveTrackData(KmlWriter::WriterWrapper & writer, TrackData const & trackDat
 
   writer << kIndent2 << "</Placemark>\n";
 }
+
+bool IsDelimiter(char c, char const * delims) { return c != '\0' && strchr(delims, c) != nullptr; }
+
+// Finds the next token of [it, end) separated by |delims| and moves |it| to the end of the token.
+// Returns false if there are no more tokens.
+bool NextToken(char const *& it, char const * end, char const * delims, char const *& tokenBegin,
+               char const *& tokenEnd)
+{
+  while (it != end && IsDelimiter(*it, delims))
+    ++it;
+  if (it == end)
+    return false;
+
+  tokenBegin = it;
+  while (it != end && !IsDelimiter(*it, delims))
+    ++it;
+  tokenEnd = it;
+  return true;
+}
+
+// Same as strings::to_double but without a copy of the token. The token must be followed by
+// a character which is not a part of a number, e.g. a delimiter or the null character.
+bool ParseDouble(char const * begin, char const * end, double & d)
+{
+  char * stop;
+  d = strtod(begin, &stop);
+  return stop == end && begin != end && std::isfinite(d);
+}
 }  // namespace
 
 KmlWriter::WriterWrapper & KmlWriter::WriterWrapper::operator<<(std::string const & str)
@@ -545,23 +577,32 @@ void KmlParser::ResetPoint()
 }
 
 bool KmlParser::ParsePoint(std::string const & s, char const * delim, m2::PointD & pt)
+{
+  return ParsePoint(s.c_str(), s.c_str() + s.size(), delim, pt);
+}
+
+bool KmlParser::ParsePoint(char const * begin, char const * end, char const * delim,
+                           m2::PointD & pt)
 {
   // Order in string is: lon, lat, z.
-  strings::SimpleTokenizer iter(s, delim);
-  if (!iter)
+  char const * tokenBegin;
+  char const * tokenEnd;
+  double lon;
+  if (!NextToken(begin, end, delim, tokenBegin, tokenEnd) ||
+      !ParseDouble(tokenBegin, tokenEnd, lon) || !MercatorBounds::ValidLon(lon))
+  {
     return false;
+  }
 
-  double lon;
-  if (strings::to_double(*iter, lon) && MercatorBounds::ValidLon(lon) && ++iter)
+  double lat;
+  if (!NextToken(begin, end, delim, tokenBegin, tokenEnd) ||
+      !ParseDouble(tokenBegin, tokenEnd, lat) || !MercatorBounds::ValidLat(lat))
   {
-    double lat;
-    if (strings::to_double(*iter, lat) && MercatorBounds::ValidLat(lat))
-    {
-      pt = MercatorBounds::FromLatLon(lat, lon);
-      return true;
-    }
+    return false;
   }
-  return false;
+
+  pt = MercatorBounds::FromLatLon(lat, lon);
+  return true;
 }
 
 void KmlParser::SetOrigin(std::string const & s)
@@ -578,16 +619,19 @@ void KmlParser::ParseLineCoordinates(std::string const & s, char const * blockSe
 {
   m_geometryType = GEOMETRY_TYPE_LINE;
 
-  strings::SimpleTokenizer tupleIter(s, blockSeparator);
-  while (tupleIter)
+  // Tracks may have many thousands of points, so tuples are parsed in place.
+  char const * it = s.c_str();
+  char const * const end = it + s.size();
+  char const * tupleBegin;
+  char const * tupleEnd;
+  while (NextToken(it, end, blockSeparator, tupleBegin, tupleEnd))
   {
     m2::PointD pt;
-    if (ParsePoint(*tupleIter, coordSeparator, pt))
+    if (ParsePoint(tupleBegin, tupleEnd, coordSeparator, pt))
     {
       if (m_points.empty() || !pt.EqualDxDy(m_points.back(), 1e-5 /* eps */))
         m_points.push_back(std::move(pt));
     }
-    ++tupleIter;
   }
 }
 
@@ -731,7 +775,7 @@ void KmlParser::Pop(std::string const & tag)
         data.m_description = std::move(m_description);
         data.m_layers = std::move(m_trackLayers);
         data.m_timestamp = m_timestamp;
-        data.m_points = m_points;
+        data.m_points = std::move(m_points);
         m_data.m_tracksData.push_back(std::move(data));
       }
     }
@@ -769,7 +813,7 @@ void KmlParser::Pop(std::string const & tag)
   m_tags.pop_back();
 }
 
-void KmlParser::CharData(std::string value)
+void KmlParser::CharData(std::string & value)
 {
   strings::Trim(value);
 
@@ -778,8 +822,8 @@ void KmlParser::CharData(std::string value)
   {
     std::string const & currTag = m_tags[count - 1];
     std::string const & prevTag = m_tags[count - 2];
-    std::string const ppTag = count > 2 ? m_tags[count - 3] : std::string();
-    std::string const pppTag = count > 3 ? m_tags[count - 4] : std::string();
+    std::string const & ppTag = count > 2 ? m_tags[count - 3] : kEmptyTag;
+    std::string const & pppTag = count > 3 ? m_tags[count - 4] : kEmptyTag;
 
     if (prevTag == kDocument)
     {
@@ -70,7 +70,7 @@ public:
                         std::string const & attrInLowerCase) const;
   std::string const & GetTagFromEnd(size_t n) const;
   void Pop(std::string const & tag);
-  void CharData(std::string value);
+  void CharData(std::string & value);
 
   static kml::TrackLayer GetDefaultTrackLayer();
 
@@ -84,6 +84,9 @@ private:
 
   void ResetPoint();
   bool ParsePoint(std::string const & s, char const * delim, m2::PointD & pt);
+  // Parses the point in [begin, end) in place. |end| must point to a delimiter or to the end
+  // of a null terminated string.
+  bool ParsePoint(char const * begin, char const * end, char const * delim, m2::PointD & pt);
   void SetOrigin(std::string const & s);
   void ParseLineCoordinates(std::string const & s, char const * blockSeparator,
                             char const * coordSeparator);
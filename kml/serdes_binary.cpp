@@ -4,9 +4,12 @@ namespace kml
 {
 namespace binary
 {
-SerializerKml::SerializerKml(FileData & data)
+SerializerKml::SerializerKml(FileData & data, Version version)
   : m_data(data)
+  , m_version(version)
 {
+  CHECK(m_version == Version::V3 || m_version == Version::Latest, (static_cast<int>(m_version)));
+
   ClearCollectionIndex();
 
   // Collect all strings and substitute each for index.
@@ -34,5 +37,88 @@ DeserializerKml::DeserializerKml(FileData & data)
 {
   m_data = {};
 }
+
+IndexedDeserializerKml::IndexedDeserializerKml(Reader const & reader)
+{
+  NonOwningReaderSource source(reader);
+  auto const v = ReadPrimitiveFromSource<Version>(source);
+  if (v < Version::V4 || v > Version::Latest)
+  {
+    MYTHROW(DeserializerKml::DeserializeException,
+            ("No bookmarks index in the file version", static_cast<int>(v)));
+  }
+
+  // Skip device id and server id.
+  source.Skip(ReadVarUint<uint32_t>(source));
+  source.Skip(ReadVarUint<uint32_t>(source));
+
+  m_doubleBits = ReadPrimitiveFromSource<uint8_t>(source);
+  if (m_doubleBits == 0 || m_doubleBits > 32)
+    MYTHROW(DeserializerKml::DeserializeException, ("Incorrect double bits count: ", m_doubleBits));
+
+  auto subReader = reader.CreateSubReader(source.Pos(), source.Size());
+  Header header(v);
+  {
+    NonOwningReaderSource headerSource(*subReader);
+    header.Deserialize(headerSource);
+  }
+  if (header.m_bookmarksOffset > header.m_tracksOffset ||
+      header.m_stringsOffset > header.m_bookmarksIndexOffset ||
+      header.m_bookmarksIndexOffset > header.m_eosOffset)
+  {
+    MYTHROW(DeserializerKml::DeserializeException, ("Incorrect header."));
+  }
+
+  m_bookmarksReader = subReader->CreateSubReader(header.m_bookmarksOffset,
+                                                 header.m_tracksOffset - header.m_bookmarksOffset);
+  m_stringsReader = subReader->CreateSubReader(header.m_stringsOffset,
+                                               header.m_bookmarksIndexOffset - header.m_stringsOffset);
+  m_indexReader = subReader->CreateSubReader(header.m_bookmarksIndexOffset,
+                                             header.m_eosOffset - header.m_bookmarksIndexOffset);
+
+  m_bookmarksCount = ReadPrimitiveFromPos<uint32_t>(*m_indexReader, 0);
+  auto const expectedSize = sizeof(uint32_t) * (1 + uint64_t{m_bookmarksCount}) +
+                            kBookmarksIndexEntrySize * uint64_t{m_bookmarksCount};
+  if (m_indexReader->Size() != expectedSize)
+    MYTHROW(DeserializerKml::DeserializeException, ("Incorrect bookmarks index size."));
+
+  m_strings = std::make_unique<coding::BlockedTextStorage<Reader>>(*m_stringsReader);
+}
+
+BookmarkData IndexedDeserializerKml::GetBookmark(uint32_t index) const
+{
+  CHECK_LESS(index, m_bookmarksCount, ());
+  auto const offset = ReadPrimitiveFromPos<uint32_t>(*m_indexReader, sizeof(uint32_t) * (1 + index));
+  auto const bookmarkReader = m_bookmarksReader->CreateSubReader(offset,
+                                                                 m_bookmarksReader->Size() - offset);
+
+  BookmarkData data;
+  {
+    NonOwningReaderSource src(*bookmarkReader);
+    BookmarkDeserializerVisitor<decltype(src)> visitor(src, m_doubleBits);
+    visitor(data);
+  }
+
+  DeserializedStringCollector<Reader> collector(*m_strings);
+  CollectorVisitor<decltype(collector)> visitor(collector);
+  visitor(data);
+  CollectorVisitor<decltype(collector)> clearVisitor(collector, true /* clear index */);
+  clearVisitor(data);
+  return data;
+}
+
+BookmarksIndexEntry IndexedDeserializerKml::ReadEntry(uint32_t i) const
+{
+  auto const pos = sizeof(uint32_t) * (1 + uint64_t{m_bookmarksCount}) +
+                   kBookmarksIndexEntrySize * uint64_t{i};
+  uint32_t buffer[3];
+  m_indexReader->Read(pos, buffer, sizeof(buffer));
+
+  BookmarksIndexEntry entry;
+  entry.m_point = m2::PointU(SwapIfBigEndianMacroBased(buffer[0]),
+                             SwapIfBigEndianMacroBased(buffer[1]));
+  entry.m_index = SwapIfBigEndianMacroBased(buffer[2]);
+  return entry;
+}
 }  // namespace binary
 }  // namespace kml
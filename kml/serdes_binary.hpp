@@ -4,12 +4,15 @@
 #include "kml/types.hpp"
 #include "kml/visitors.hpp"
 
+#include "coding/pointd_to_pointu.hpp"
 #include "coding/read_write_utils.hpp"
 #include "coding/sha1.hpp"
 #include "coding/text_storage.hpp"
 
 #include "platform/platform.hpp"
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -17,19 +20,31 @@ namespace kml
 {
 namespace binary
 {
-enum class Version : uint8_t
+// The bookmarks index (V4) is a fixed-width section which allows to read bookmarks one by one:
+//   uint32_t count;
+//   uint32_t offsets[count];            // Offsets of bookmarks in the bookmarks section.
+//   BookmarksIndexEntry entries[count]; // Sorted by points.
+struct BookmarksIndexEntry
 {
-  V0 = 0,
-  V1 = 1, // 11th April 2018 (new Point2D storage, added deviceId, feature name -> custom name).
-  V2 = 2, // 25th April 2018 (added serverId).
-  V3 = 3, // 7th May 2018 (persistent feature types).
-  Latest = V3
+  bool operator<(BookmarksIndexEntry const & rhs) const
+  {
+    if (m_point.x != rhs.m_point.x)
+      return m_point.x < rhs.m_point.x;
+    return m_point.y < rhs.m_point.y;
+  }
+
+  m2::PointU m_point;
+  uint32_t m_index = 0;
 };
 
+uint32_t constexpr kBookmarksIndexCoordBits = POINT_COORD_BITS;
+uint32_t constexpr kBookmarksIndexEntrySize = 3 * sizeof(uint32_t);
+
 class SerializerKml
 {
 public:
-  explicit SerializerKml(FileData & data);
+  // |version| is Version::V3 or Version::Latest.
+  explicit SerializerKml(FileData & data, Version version = Version::Latest);
   ~SerializerKml();
 
   void ClearCollectionIndex();
@@ -38,7 +53,7 @@ public:
   void Serialize(Sink & sink)
   {
     // Write format version.
-    WriteToSink(sink, Version::Latest);
+    WriteToSink(sink, m_version);
 
     // Write device id.
     {
@@ -60,7 +75,7 @@ public:
     auto const startPos = sink.Pos();
 
     // Reserve place for the header.
-    Header header;
+    Header header(m_version);
     WriteZeroesToSink(sink, header.Size());
 
     // Serialize category.
@@ -79,6 +94,13 @@ public:
     header.m_stringsOffset = sink.Pos() - startPos;
     SerializeStrings(sink);
 
+    // Serialize bookmarks index.
+    if (m_version >= Version::V4)
+    {
+      header.m_bookmarksIndexOffset = sink.Pos() - startPos;
+      SerializeBookmarksIndex(sink);
+    }
+
     // Fill header.
     header.m_eosOffset = sink.Pos() - startPos;
     sink.Seek(startPos);
@@ -96,8 +118,19 @@ public:
   template <typename Sink>
   void SerializeBookmarks(Sink & sink)
   {
+    // The same as visiting the vector, but offsets of bookmarks are remembered for the index.
+    auto const startPos = sink.Pos();
+    auto const & bookmarks = m_data.m_bookmarksData;
+    m_bookmarkOffsets.clear();
+    m_bookmarkOffsets.reserve(bookmarks.size());
+
     BookmarkSerializerVisitor<Sink> visitor(sink, kDoubleBits);
-    visitor(m_data.m_bookmarksData);
+    WriteVarUint(sink, static_cast<uint32_t>(bookmarks.size()));
+    for (auto const & bookmark : bookmarks)
+    {
+      m_bookmarkOffsets.push_back(static_cast<uint32_t>(sink.Pos() - startPos));
+      visitor(bookmark);
+    }
   }
 
   template <typename Sink>
@@ -116,9 +149,37 @@ public:
       writer.Append(str);
   }
 
+  // Must be called after SerializeBookmarks().
+  template <typename Sink>
+  void SerializeBookmarksIndex(Sink & sink)
+  {
+    auto const & bookmarks = m_data.m_bookmarksData;
+    CHECK_EQUAL(m_bookmarkOffsets.size(), bookmarks.size(), ());
+
+    std::vector<BookmarksIndexEntry> entries(bookmarks.size());
+    for (size_t i = 0; i < bookmarks.size(); ++i)
+    {
+      entries[i].m_point = PointDToPointU(bookmarks[i].m_point, kBookmarksIndexCoordBits);
+      entries[i].m_index = static_cast<uint32_t>(i);
+    }
+    std::sort(entries.begin(), entries.end());
+
+    WriteToSink(sink, static_cast<uint32_t>(bookmarks.size()));
+    for (auto const offset : m_bookmarkOffsets)
+      WriteToSink(sink, offset);
+    for (auto const & entry : entries)
+    {
+      WriteToSink(sink, entry.m_point.x);
+      WriteToSink(sink, entry.m_point.y);
+      WriteToSink(sink, entry.m_index);
+    }
+  }
+
 private:
   FileData & m_data;
+  Version const m_version;
   std::vector<std::string> m_strings;
+  std::vector<uint32_t> m_bookmarkOffsets;
 };
 
 class DeserializerKml
@@ -135,8 +196,9 @@ public:
     NonOwningReaderSource source(reader);
     auto const v = ReadPrimitiveFromSource<Version>(source);
 
-    if (v != Version::Latest && v != Version::V2)
+    if (v < Version::V2 || v > Version::Latest)
       MYTHROW(DeserializeException, ("Incorrect file version."));
+    m_header = Header(v);
 
     // Read device id.
     {
@@ -255,5 +317,60 @@ private:
   uint8_t m_doubleBits = 0;
   bool m_initialized = false;
 };
+
+// Reads bookmarks of a V4 file one by one using the bookmarks index, so only the requested
+// bookmarks and the blocks of their strings are decoded. Use it with MmapReader to read them
+// straight from a mapping.
+class IndexedDeserializerKml
+{
+public:
+  // Throws DeserializerKml::DeserializeException when the file has no bookmarks index.
+  explicit IndexedDeserializerKml(Reader const & reader);
+
+  uint32_t GetBookmarksCount() const { return m_bookmarksCount; }
+
+  // Calls |fn(index, point)| for each bookmark inside |rect|, ordered by points.
+  template <typename Fn>
+  void ForEachBookmarkInRect(m2::RectD const & rect, Fn && fn) const
+  {
+    auto const minPt = PointDToPointU(rect.LeftBottom(), kBookmarksIndexCoordBits);
+    auto const maxPt = PointDToPointU(rect.RightTop(), kBookmarksIndexCoordBits);
+
+    // Binary search for the first entry with x >= minPt.x.
+    uint32_t lo = 0;
+    uint32_t hi = m_bookmarksCount;
+    while (lo < hi)
+    {
+      auto const mid = lo + (hi - lo) / 2;
+      if (ReadEntry(mid).m_point.x < minPt.x)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    for (uint32_t i = lo; i < m_bookmarksCount; ++i)
+    {
+      auto const entry = ReadEntry(i);
+      if (entry.m_point.x > maxPt.x)
+        break;
+      if (entry.m_point.y < minPt.y || entry.m_point.y > maxPt.y)
+        continue;
+      fn(entry.m_index, PointUToPointD(entry.m_point, kBookmarksIndexCoordBits));
+    }
+  }
+
+  // |index| is the index of the bookmark in FileData::m_bookmarksData.
+  BookmarkData GetBookmark(uint32_t index) const;
+
+private:
+  BookmarksIndexEntry ReadEntry(uint32_t i) const;
+
+  std::unique_ptr<Reader> m_bookmarksReader;
+  std::unique_ptr<Reader> m_indexReader;
+  std::unique_ptr<Reader> m_stringsReader;
+  std::unique_ptr<coding::BlockedTextStorage<Reader>> m_strings;
+  uint32_t m_bookmarksCount = 0;
+  uint8_t m_doubleBits = 0;
+};
 }  // namespace binary
 }  // namespace kml
@@ -1,5 +1,7 @@
 #include "map/benchmark_tool/api.hpp"
 
+#include "base/macros.hpp"
+
 #include "std/iostream.hpp"
 #include "std/numeric.hpp"
 #include "std/algorithm.hpp"
@@ -34,6 +36,53 @@ void Result::CalcMetrics()
     m_all = -1.0;
 }
 
+void ReadPathResult::Print()
+{
+  static char const * const kStageNames[] = {"index",  "offsets", "records",
+                                             "header", "types",   "names",
+                                             "common", "geometry", "triangles"};
+  static_assert(ARRAY_SIZE(kStageNames) == StagesResult::Count, "");
+
+  cout << m_name << " (" << m_fileSize << " bytes)" << endl;
+  if (m_scales.empty())
+  {
+    cout << "No frames" << endl;
+    return;
+  }
+
+  cout << fixed << setprecision(3);
+  for (auto const & scaleAndResult : m_scales)
+  {
+    StagesResult const & r = scaleAndResult.second;
+    cout << "SCALE " << scaleAndResult.first << " viewports:" << r.m_viewports
+         << " features:" << r.m_features << " records:" << r.m_recordBytes
+         << "B geometry:" << r.m_geometryBytes << "B" << endl;
+
+    double total = 0.0;
+    for (size_t i = 0; i < StagesResult::Count; ++i)
+    {
+      total += r.m_times[i];
+      double const perFeature = r.m_features == 0 ? 0.0 : r.m_times[i] * 1e9 / r.m_features;
+      cout << "  " << setw(10) << std::left << kStageNames[i] << std::right << setw(12)
+           << r.m_times[i] * 1000 << " ms " << setw(10) << perFeature << " ns/feature" << endl;
+    }
+    cout << "  " << setw(10) << std::left << "total" << std::right << setw(12) << total * 1000 << " ms"
+         << endl;
+  }
+
+  cout << "SECTIONS" << endl;
+  for (auto const & tagAndStats : m_sections)
+  {
+    SharedPageCache::Stats const & s = tagAndStats.second;
+    uint64_t const pages = s.m_pageHits + s.m_pageMisses;
+    cout << "  " << setw(16) << std::left << tagAndStats.first << std::right << " reads:" << s.m_reads
+         << " bytes:" << s.m_readBytes << " page hits:" << s.m_pageHits << "/" << pages << endl;
+  }
+
+  uint64_t const lookups = m_geometryCache.m_hits + m_geometryCache.m_misses;
+  cout << "DECODED GEOMETRY CACHE hits:" << m_geometryCache.m_hits << "/" << lookups << endl;
+}
+
 void AllResult::Print()
 {
   //m_reading.PrintAllTimes();
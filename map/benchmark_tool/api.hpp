@@ -1,5 +1,12 @@
 #pragma once
 
+#include "indexer/decoded_geometry_cache.hpp"
+
+#include "coding/shared_page_cache.hpp"
+
+#include "std/array.hpp"
+#include "std/cstdint.hpp"
+#include "std/map.hpp"
 #include "std/vector.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
@@ -43,4 +50,55 @@ namespace bench
 
   /// @param[in] count number of times to run benchmark
   void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleR, AllResult & res);
+
+  // Times of the stages of reading features of the viewports at one scale.
+  struct StagesResult
+  {
+    enum Stage
+    {
+      // Covering of a viewport and the walk of the scale index.
+      Index,
+      // Lookups of feature offsets in the offsets table.
+      Offsets,
+      // Reads of feature records from the features section.
+      Records,
+      // Deserialization of the feature header.
+      Header,
+      Types,
+      Names,
+      // Parsing of the common params except names: layer, rank, house number, etc.
+      Common,
+      // Parsing of the geometry header and outer/inner points.
+      Geometry,
+      // Parsing of the triangles of areas.
+      Triangles,
+      Count
+    };
+
+    array<double, Count> m_times = {};
+    uint64_t m_viewports = 0;
+    uint64_t m_features = 0;
+    uint64_t m_recordBytes = 0;
+    // Size of the encoded geometry and triangles of the parsed features.
+    uint64_t m_geometryBytes = 0;
+  };
+
+  class ReadPathResult
+  {
+  public:
+    string m_name;
+    uint64_t m_fileSize = 0;
+    // Scale -> stages of reading at the scale.
+    map<int, StagesResult> m_scales;
+    // Section tag -> reads of the section.
+    map<string, SharedPageCache::Stats> m_sections;
+    feature::DecodedGeometryCache::Stats m_geometryCache;
+
+    void Print();
+  };
+
+  // Reads features of the mwm in the same viewports as RunFeaturesLoadingBenchmark() does, but
+  // times each stage of reading separately. Sections of the mwm are read through
+  // SharedPageCache, so bytes read from the file and page hits are counted per section.
+  void RunReadPathBenchmark(string const & file, pair<int, int> scaleRange, ReadPathResult & res);
 }
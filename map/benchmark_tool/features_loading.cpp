@@ -2,16 +2,30 @@
 
 #include "map/feature_vec_model.hpp"
 
+#include "indexer/data_factory.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_covering.hpp"
 #include "indexer/feature_visibility.hpp"
+#include "indexer/features_offsets_table.hpp"
+#include "indexer/scale_index.hpp"
 #include "indexer/scales.hpp"
+#include "indexer/shared_load_info.hpp"
 
 #include "platform/platform.hpp"
 
+#include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
+#include "coding/var_record_reader.hpp"
 
 #include "base/macros.hpp"
+#include "base/stl_helpers.hpp"
 #include "base/timer.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/unique_ptr.hpp"
+
+#include "defines.hpp"
+
 
 namespace bench
 {
@@ -57,16 +71,173 @@ namespace
     }
   };
 
-  void RunBenchmark(model::FeaturesFetcher const & src, m2::RectD const & rect,
-                    pair<int, int> const & scaleRange, AllResult & res)
+  // Reads features of viewports stage by stage, each stage is done for all the features of
+  // a viewport before the next one, so the stages are timed without interleaving.
+  class StagesReader
+  {
+  public:
+    StagesReader(platform::LocalCountryFile const & localFile, MwmSet::MwmId const & mwmId,
+                 SharedPageCache & pageCache)
+      : m_mwmId(mwmId)
+      , m_cont(localFile.GetPath(MapOptions::Map), pageCache)
+      , m_factory(LoadFactory(m_cont))
+      , m_loadInfo(m_cont, m_factory.GetHeader())
+      , m_index(m_cont.GetReader(INDEX_FILE_TAG), m_factory)
+      , m_recordReader(m_loadInfo.GetDataReader(), 256 /* expectedRecordSize */)
+    {
+      auto const format = m_factory.GetHeader().GetFormat();
+      if (format == version::Format::v5)
+        m_table = feature::FeaturesOffsetsTable::CreateIfNotExistsAndLoad(localFile, m_cont);
+      else if (format > version::Format::v5)
+        m_table = feature::FeaturesOffsetsTable::Load(m_cont);
+    }
+
+    // Returns the number of features visible in |rect| at |scale|.
+    size_t Read(m2::RectD const & rect, int scale, StagesResult & res)
+    {
+      using Stage = StagesResult::Stage;
+
+      // Use last coding scale for covering (see index_builder.cpp).
+      auto const lastScale = m_factory.GetHeader().GetLastScale();
+      scale = min(scale, lastScale);
+
+      Measure(Stage::Index, res, [&]()
+      {
+        m_indices.clear();
+        covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
+        covering::Intervals const & intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
+        m_index.ForEachInIntervalsAndScale(intervals, scale,
+                                           [&](uint32_t index) { m_indices.push_back(index); });
+        base::SortUnique(m_indices);
+      });
+
+      size_t const count = m_indices.size();
+      ++res.m_viewports;
+      res.m_features += count;
+      if (count == 0)
+        return 0;
+
+      Measure(Stage::Offsets, res, [&]()
+      {
+        m_offsets.resize(count);
+        for (size_t i = 0; i < count; ++i)
+          m_offsets[i] = m_table ? m_table->GetFeatureOffset(m_indices[i]) : m_indices[i];
+      });
+
+      if (m_buffers.size() < count)
+        m_buffers.resize(count);
+      m_recordOffsets.resize(count);
+      Measure(Stage::Records, res, [&]()
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          uint32_t size = 0;
+          m_recordReader.ReadRecord(m_offsets[i], m_buffers[i], m_recordOffsets[i], size);
+          res.m_recordBytes += size;
+        }
+      });
+
+      if (m_features.size() < count)
+        m_features.resize(count);
+      Measure(Stage::Header, res, [&]()
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          m_features[i].Deserialize(&m_loadInfo, &m_buffers[i][m_recordOffsets[i]]);
+          m_features[i].SetID(FeatureID(m_mwmId, m_indices[i]));
+        }
+      });
+
+      uint32_t typesSum = 0;
+      Measure(Stage::Types, res, [&]()
+      {
+        for (size_t i = 0; i < count; ++i)
+          m_features[i].ForEachType([&typesSum](uint32_t type) { typesSum += type; });
+      });
+      UNUSED_VALUE(typesSum);
+
+      Measure(Stage::Names, res, [&]()
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          if (m_features[i].HasName())
+            UNUSED_VALUE(m_features[i].GetNames());
+        }
+      });
+
+      Measure(Stage::Common, res, [&]()
+      {
+        for (size_t i = 0; i < count; ++i)
+          UNUSED_VALUE(m_features[i].GetLayer());
+      });
+
+      Measure(Stage::Geometry, res, [&]()
+      {
+        for (size_t i = 0; i < count; ++i)
+          res.m_geometryBytes += m_features[i].ParseGeometry(scale);
+      });
+
+      Measure(Stage::Triangles, res, [&]()
+      {
+        for (size_t i = 0; i < count; ++i)
+          res.m_geometryBytes += m_features[i].ParseTriangles(scale);
+      });
+
+      return count;
+    }
+
+  private:
+    static IndexFactory LoadFactory(FilesContainerR const & cont)
+    {
+      IndexFactory factory;
+      factory.Load(cont);
+      return factory;
+    }
+
+    template <typename Fn>
+    static void Measure(StagesResult::Stage stage, StagesResult & res, Fn && fn)
+    {
+      base::Timer timer;
+      fn();
+      res.m_times[stage] += timer.ElapsedSeconds();
+    }
+
+    MwmSet::MwmId const m_mwmId;
+    FilesContainerR const m_cont;
+    IndexFactory const m_factory;
+    feature::SharedLoadInfo const m_loadInfo;
+    ScaleIndex<ModelReaderPtr> m_index;
+    VarRecordReader<FilesContainerR::TReader, &VarRecordSizeReaderVarint> m_recordReader;
+    unique_ptr<feature::FeaturesOffsetsTable> m_table;
+
+    // Buffers are reused for all the viewports.
+    vector<uint32_t> m_indices;
+    vector<uint64_t> m_offsets;
+    vector<vector<char>> m_buffers;
+    vector<uint32_t> m_recordOffsets;
+    vector<FeatureType> m_features;
+  };
+
+  bool ClampScaleRange(MwmInfo const & info, pair<int, int> & scaleRange)
+  {
+    if (info.m_minScale > scaleRange.first)
+      scaleRange.first = info.m_minScale;
+    if (info.m_maxScale < scaleRange.second)
+      scaleRange.second = info.m_maxScale;
+    return scaleRange.first <= scaleRange.second;
+  }
+
+  // Calls |fn(rect, scale)| for the viewports of the benchmark. Viewports are made by dividing
+  // |rect| until they are empty or reach the upper scale of |scaleRange|. |fn| returns false
+  // for empty viewports.
+  template <typename Fn>
+  void ForEachViewport(m2::RectD const & rect, pair<int, int> const & scaleRange, Fn && fn)
   {
     ASSERT_LESS_OR_EQUAL(scaleRange.first, scaleRange.second, ());
 
     vector<m2::RectD> rects;
     rects.push_back(rect);
 
-    Accumulator acc(res.m_reading);
-
     while (!rects.empty())
     {
       m2::RectD const r = rects.back();
@@ -75,15 +246,7 @@ namespace
       bool doDivide = true;
       int const scale = scales::GetScaleLevel(r);
       if (scale >= scaleRange.first)
-      {
-        acc.Reset(scale);
-
-        base::Timer timer;
-        src.ForEachFeature(r, acc, scale);
-        res.Add(timer.ElapsedSeconds());
-
-        doDivide = !acc.IsEmpty();
-      }
+        doDivide = fn(r, scale);
 
       if (doDivide && scale < scaleRange.second)
       {
@@ -94,6 +257,23 @@ namespace
       }
     }
   }
+
+  void RunBenchmark(model::FeaturesFetcher const & src, m2::RectD const & rect,
+                    pair<int, int> const & scaleRange, AllResult & res)
+  {
+    Accumulator acc(res.m_reading);
+
+    ForEachViewport(rect, scaleRange, [&](m2::RectD const & r, int scale)
+    {
+      acc.Reset(scale);
+
+      base::Timer timer;
+      src.ForEachFeature(r, acc, scale);
+      res.Add(timer.ElapsedSeconds());
+
+      return !acc.IsEmpty();
+    });
+  }
 }
 
 void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleRange, AllResult & res)
@@ -110,17 +290,70 @@ void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleRange,
   if (r.second != MwmSet::RegResult::Success)
     return;
 
-  uint8_t const minScale = r.first.GetInfo()->m_minScale;
-  uint8_t const maxScale = r.first.GetInfo()->m_maxScale;
-  if (minScale > scaleRange.first)
-    scaleRange.first = minScale;
-  if (maxScale < scaleRange.second)
-    scaleRange.second = maxScale;
-
-  if (scaleRange.first > scaleRange.second)
+  if (!ClampScaleRange(*r.first.GetInfo(), scaleRange))
     return;
 
   RunBenchmark(src, r.first.GetInfo()->m_bordersRect, scaleRange, res);
 }
 
+void RunReadPathBenchmark(string const & file, pair<int, int> scaleRange, ReadPathResult & res)
+{
+  string fileName = file;
+  base::GetNameFromFullPath(fileName);
+  base::GetNameWithoutExt(fileName);
+  res.m_name = fileName;
+
+  platform::LocalCountryFile localFile =
+      platform::LocalCountryFile::MakeForTesting(fileName);
+
+  // The mwm is registered to get ids of its features only. The ids are keys of the decoded
+  // geometry cache, so FeatureType uses the cache as it does for features of DataSource.
+  model::FeaturesFetcher src;
+  auto const r = src.RegisterMap(localFile);
+  if (r.second != MwmSet::RegResult::Success)
+    return;
+
+  if (!ClampScaleRange(*r.first.GetInfo(), scaleRange))
+    return;
+
+  UNUSED_VALUE(Platform::GetFileSizeByFullPath(localFile.GetPath(MapOptions::Map), res.m_fileSize));
+
+  // Caches are cleared, so results don't depend on mwms benchmarked before. Stats of the caches
+  // are not reset by Clear().
+  auto & pageCache = SharedPageCache::Instance();
+  auto & geometryCache = feature::DecodedGeometryCache::Instance();
+  pageCache.Clear();
+  geometryCache.Clear();
+  auto const sectionsBefore = pageCache.GetStats();
+  auto const geometryBefore = geometryCache.GetStats();
+
+  {
+    StagesReader reader(localFile, r.first, pageCache);
+    ForEachViewport(r.first.GetInfo()->m_bordersRect, scaleRange,
+                    [&](m2::RectD const & rect, int scale)
+    {
+      return reader.Read(rect, scale, res.m_scales[scale]) != 0;
+    });
+  }
+
+  for (auto const & tagAndStats : pageCache.GetStats())
+  {
+    SharedPageCache::Stats stats = tagAndStats.second;
+    auto const it = sectionsBefore.find(tagAndStats.first);
+    if (it != sectionsBefore.cend())
+    {
+      stats.m_reads -= it->second.m_reads;
+      stats.m_readBytes -= it->second.m_readBytes;
+      stats.m_pageHits -= it->second.m_pageHits;
+      stats.m_pageMisses -= it->second.m_pageMisses;
+    }
+    if (stats.m_reads != 0)
+      res.m_sections[tagAndStats.first] = stats;
+  }
+
+  auto const geometryAfter = geometryCache.GetStats();
+  res.m_geometryCache.m_hits = geometryAfter.m_hits - geometryBefore.m_hits;
+  res.m_geometryCache.m_misses = geometryAfter.m_misses - geometryBefore.m_misses;
+}
+
 }
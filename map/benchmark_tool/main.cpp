@@ -3,6 +3,8 @@
 #include "indexer/classificator_loader.hpp"
 #include "indexer/data_header.hpp"
 
+#include "base/string_utils.hpp"
+
 #include "std/iostream.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
@@ -12,6 +14,9 @@ DEFINE_string(input, "", "MWM file name in the data directory");
 DEFINE_int32(lowS, 10, "Low processing scale");
 DEFINE_int32(highS, 17, "High processing scale");
 DEFINE_bool(print_scales, false, "Print geometry scales for MWM and exit");
+DEFINE_bool(stages, false,
+            "Time the stages of feature reading separately. Input may be a comma-separated list "
+            "of MWMs");
 
 
 int main(int argc, char ** argv)
@@ -37,6 +42,19 @@ int main(int argc, char ** argv)
     return 0;
   }
 
+  if (!FLAGS_input.empty() && FLAGS_stages)
+  {
+    using namespace bench;
+
+    for (auto const & file : strings::Tokenize(FLAGS_input, ","))
+    {
+      ReadPathResult res;
+      RunReadPathBenchmark(file, make_pair(FLAGS_lowS, FLAGS_highS), res);
+      res.Print();
+    }
+    return 0;
+  }
+
   if (!FLAGS_input.empty())
   {
     using namespace bench;
@@ -10,20 +10,29 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/reader.hpp"
 
 #include "geometry/mercator.hpp"
 
+#include "base/math.hpp"
+#include "base/timer.hpp"
+
 #include "3party/jansson/myjansson.hpp"
 
 #include <algorithm>
 #include <atomic>
+#include <ctime>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace
 {
+// Tiles are not awaited longer by default.
+json_int_t constexpr kDefaultWaitForTilesTimeoutInSeconds = 30;
+
 struct BenchmarkHandle
 {
   std::vector<df::ScenarioManager::ScenarioData> m_scenariosToRun;
@@ -31,15 +40,74 @@ struct BenchmarkHandle
   std::vector<storage::TCountryId> m_regionsToDownload;
   size_t m_regionsToDownloadCounter = 0;
 
+  std::vector<std::pair<std::string, std::vector<df::DrapeMeasurer::FrameStatistic>>> m_frameStatistic;
+
 #ifdef DRAPE_MEASURER
   std::vector<std::pair<string, df::DrapeMeasurer::DrapeStatistic>> m_drapeStatistic;
 #endif
 };
 
+m2::PointD ReadPoint(json_t * pointNode)
+{
+  double lat = 0.0, lon = 0.0;
+  FromJSONObject(pointNode, "lat", lat);
+  FromJSONObject(pointNode, "lon", lon);
+  return MercatorBounds::FromLatLon(lat, lon);
+}
+
+// Results are saved in the machine-readable format to compare devices and builds.
+void SaveFrameStatistic(std::shared_ptr<BenchmarkHandle> handle)
+{
+  auto root = base::NewJSONObject();
+  ToJSONObject(*root, "device", GetPlatform().DeviceModel());
+  ToJSONObject(*root, "time", base::TimestampToString(time(nullptr)));
+
+  auto scenariosNode = base::NewJSONArray();
+  for (auto const & scenario : handle->m_frameStatistic)
+  {
+    auto framesNode = base::NewJSONArray();
+    for (auto const & frame : scenario.second)
+    {
+      auto frameNode = base::NewJSONObject();
+      ToJSONObject(*frameNode, "cpuMs", frame.m_cpuTimeInMs);
+      ToJSONObject(*frameNode, "presentMs", frame.m_presentTimeInMs);
+      ToJSONObject(*frameNode, "overlayPlacementMs", frame.m_overlayPlacementTimeInMs);
+      ToJSONObject(*frameNode, "readTiles", frame.m_readTilesCount);
+      ToJSONObject(*frameNode, "notFinishedTiles", frame.m_notFinishedTilesCount);
+      ToJSONObject(*frameNode, "gpuMemoryMb", frame.m_gpuMemoryInMb);
+      json_array_append_new(framesNode.get(), frameNode.release());
+    }
+
+    auto scenarioNode = base::NewJSONObject();
+    ToJSONObject(*scenarioNode, "name", scenario.first);
+    ToJSONObject(*scenarioNode, "frames", framesNode);
+    json_array_append_new(scenariosNode.get(), scenarioNode.release());
+  }
+  ToJSONObject(*root, "scenarios", scenariosNode);
+
+  std::unique_ptr<char, JSONFreeDeleter> buffer(
+    json_dumps(root.get(), JSON_COMPACT | JSON_ENSURE_ASCII));
+  std::string const data(buffer.get());
+
+  auto const fn = base::JoinPath(GetPlatform().WritableDir(), "graphics_benchmark_results.json");
+  try
+  {
+    FileWriter writer(fn);
+    writer.Write(data.data(), data.size());
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error writing benchmark results: ", e.what()));
+    return;
+  }
+  LOG(LINFO, ("Benchmark results are saved to", fn));
+}
+
 void RunScenario(Framework * framework, std::shared_ptr<BenchmarkHandle> handle)
 {
   if (handle->m_currentScenario >= handle->m_scenariosToRun.size())
   {
+    SaveFrameStatistic(handle);
 #ifdef DRAPE_MEASURER
     for (auto const & it : handle->m_drapeStatistic)
     {
@@ -57,19 +125,23 @@ void RunScenario(Framework * framework, std::shared_ptr<BenchmarkHandle> handle)
   framework->GetDrapeEngine()->RunScenario(std::move(scenarioData),
                                            [handle](std::string const & name)
   {
+    df::DrapeMeasurer::Instance().StartFrameStatistic();
 #ifdef DRAPE_MEASURER
     df::DrapeMeasurer::Instance().StartBenchmark();
 #endif
   },
   [framework, handle](std::string const & name)
   {
+    df::DrapeMeasurer::Instance().StopFrameStatistic();
+    auto frameStatistic = df::DrapeMeasurer::Instance().GetFrameStatistic();
 #ifdef DRAPE_MEASURER
     df::DrapeMeasurer::Instance().StopBenchmark();
     auto const drapeStatistic = df::DrapeMeasurer::Instance().GetDrapeStatistic();
     handle->m_drapeStatistic.push_back(make_pair(name, drapeStatistic));
 #endif
-    GetPlatform().RunTask(Platform::Thread::Gui, [framework, handle]()
+    GetPlatform().RunTask(Platform::Thread::Gui, [framework, handle, name, frameStatistic]()
     {
+      handle->m_frameStatistic.emplace_back(name, std::move(frameStatistic));
       handle->m_currentScenario++;
       RunScenario(framework, handle);
     });
@@ -143,16 +215,57 @@ void RunGraphicsBenchmark(Framework * framework)
             json_t * centerNode = json_object_get(stepElem, "center");
             if (centerNode == nullptr)
               return;
-            double lat = 0.0, lon = 0.0;
-            FromJSONObject(centerNode, "lat", lat);
-            FromJSONObject(centerNode, "lon", lon);
             json_int_t zoomLevel = -1;
             FromJSONObject(stepElem, "zoomLevel", zoomLevel);
-            m2::PointD const pt = MercatorBounds::FromLatLon(lat, lon);
+            m2::PointD const pt = ReadPoint(centerNode);
             points.push_back(pt);
             scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
                                  new ScenarioManager::CenterViewportAction(pt, static_cast<int>(zoomLevel))));
           }
+          else if (actionType == "rotate")
+          {
+            double azimuthInDegrees = 0.0;
+            FromJSONObject(stepElem, "azimuth", azimuthInDegrees);
+            scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
+                                 new ScenarioManager::RotateAction(base::DegToRad(azimuthInDegrees))));
+          }
+          else if (actionType == "setPerspective")
+          {
+            bool isPerspective = false;
+            FromJSONObject(stepElem, "enable", isPerspective);
+            scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
+                                 new ScenarioManager::SetPerspectiveAction(isPerspective)));
+          }
+          else if (actionType == "followPath")
+          {
+            json_t * pathNode = json_object_get(stepElem, "path");
+            if (pathNode == nullptr || !json_is_array(pathNode))
+              return;
+            std::vector<m2::PointD> path;
+            path.reserve(json_array_size(pathNode));
+            for (size_t k = 0; k < json_array_size(pathNode); ++k)
+            {
+              path.push_back(ReadPoint(json_array_get(pathNode, k)));
+              points.push_back(path.back());
+            }
+            json_int_t zoomLevel = -1;
+            FromJSONObject(stepElem, "zoomLevel", zoomLevel);
+            double speed = 0.0;
+            FromJSONObject(stepElem, "speed", speed);
+            scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
+                                 new ScenarioManager::FollowPathAction(std::move(path),
+                                                                       static_cast<int>(zoomLevel),
+                                                                       speed)));
+          }
+          else if (actionType == "waitForTiles")
+          {
+            json_int_t timeoutInSeconds = 0;
+            FromJSONObjectOptionalField(stepElem, "timeout", timeoutInSeconds);
+            if (timeoutInSeconds <= 0)
+              timeoutInSeconds = kDefaultWaitForTilesTimeoutInSeconds;
+            scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
+                                 new ScenarioManager::WaitForTilesAction(seconds(timeoutInSeconds))));
+          }
         }
       }
     }
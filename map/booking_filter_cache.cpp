@@ -27,7 +27,9 @@ void Cache::Reserve(std::string const & hotelId)
 {
   ASSERT(m_hotelToStatus.find(hotelId) == m_hotelToStatus.end(), ());
 
-  m_notReadyHotels.emplace(hotelId, Item());
+  Item item;
+  Push(hotelId, item.m_timestamp);
+  m_notReadyHotels.emplace(hotelId, std::move(item));
 }
 
 void Cache::Insert(std::string const & hotelId, HotelStatus const s)
@@ -38,6 +40,7 @@ void Cache::Insert(std::string const & hotelId, HotelStatus const s)
   RemoveExtra();
 
   Item item(s);
+  Push(hotelId, item.m_timestamp);
   m_hotelToStatus[hotelId] = std::move(item);
   m_notReadyHotels.erase(hotelId);
 }
@@ -47,14 +50,20 @@ void Cache::RemoveOutdated()
   if (m_expiryPeriodSeconds == 0)
     return;
 
-  RemoveOutdated(m_hotelToStatus);
-  RemoveOutdated(m_notReadyHotels);
+  while (!m_expiryQueue.empty() && IsExpired(m_expiryQueue.front().first))
+  {
+    auto const & entry = m_expiryQueue.front();
+    RemoveIfNotUpdated(m_hotelToStatus, entry.second, entry.first);
+    RemoveIfNotUpdated(m_notReadyHotels, entry.second, entry.first);
+    m_expiryQueue.pop_front();
+  }
 }
 
 void Cache::Clear()
 {
   m_hotelToStatus.clear();
   m_notReadyHotels.clear();
+  m_expiryQueue.clear();
 }
 
 void Cache::RemoveExtra()
@@ -86,15 +95,20 @@ Cache::HotelStatus Cache::Get(HotelsMap & src, std::string const & hotelId)
   return it->second.m_status;
 }
 
-void Cache::RemoveOutdated(HotelsMap & src)
+void Cache::Push(std::string const & hotelId, Clock::time_point const & timestamp)
 {
-  for (auto it = src.begin(); it != src.end();)
-  {
-    if (IsExpired(it->second.m_timestamp))
-      it = src.erase(it);
-    else
-      ++it;
-  }
+  if (m_expiryPeriodSeconds == 0)
+    return;
+
+  m_expiryQueue.emplace_back(timestamp, hotelId);
+}
+
+void Cache::RemoveIfNotUpdated(HotelsMap & src, std::string const & hotelId,
+                               Clock::time_point const & timestamp)
+{
+  auto const it = src.find(hotelId);
+  if (it != src.end() && it->second.m_timestamp <= timestamp)
+    src.erase(it);
 }
 
 std::string DebugPrint(Cache::HotelStatus status)
@@ -3,7 +3,10 @@
 #include "base/macros.hpp"
 
 #include <chrono>
+#include <deque>
 #include <map>
+#include <string>
+#include <utility>
 
 namespace booking
 {
@@ -55,10 +58,16 @@ private:
   void RemoveExtra();
   bool IsExpired(Clock::time_point const & timestamp) const;
   HotelStatus Get(HotelsMap & src, std::string const & hotelId);
-  void RemoveOutdated(HotelsMap & src);
+  void Push(std::string const & hotelId, Clock::time_point const & timestamp);
+  void RemoveIfNotUpdated(HotelsMap & src, std::string const & hotelId,
+                          Clock::time_point const & timestamp);
 
   HotelsMap m_hotelToStatus;
   HotelsMap m_notReadyHotels;
+  // Hotels in the order of insertion into the containers above. Since all the items live for
+  // the same period, only the front of the queue has to be checked to find outdated items.
+  // An entry is stale when the hotel is gone from the containers or is reinserted later.
+  std::deque<std::pair<Clock::time_point, std::string>> m_expiryQueue;
   // Max count of |m_hotelToStatus| container.
   // Count is unlimited when |m_maxCount| is equal to zero.
   size_t const m_maxCount = 1000;
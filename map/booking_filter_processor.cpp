@@ -91,8 +91,16 @@ void FilterProcessor::ApplyConsecutively(search::Results const & results, TasksI
 void FilterProcessor::ApplyIndependently(search::Results const & results,
                                          TasksInternal const & tasks)
 {
-  for (auto const & task : tasks)
-    m_filters.at(task.m_type)->ApplyFilter(results, task.m_filterParams);
+  // Every filter sends its own request, post different tasks on the file thread so the request
+  // of the first filter is sent before the data for the next one is prepared.
+  for (size_t i = 1; i < tasks.size(); ++i)
+  {
+    GetPlatform().RunTask(Platform::Thread::File, [this, results, task = tasks[i]]()
+    {
+      m_filters.at(task.m_type)->ApplyFilter(results, task.m_filterParams);
+    });
+  }
+  m_filters.at(tasks.front().m_type)->ApplyFilter(results, tasks.front().m_filterParams);
 }
 }  // namespace filter
 }  // namespace booking
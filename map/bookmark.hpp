@@ -21,6 +21,7 @@ public:
   kml::BookmarkData const & GetData() const;
 
   bool HasCreationAnimation() const override;
+  bool IsClusterable() const override { return true; }
 
   std::string GetPreferredName() const;
 
@@ -35,12 +35,14 @@
 #include "3party/Alohalytics/src/alohalytics.h"
 
 #include <algorithm>
+#include <atomic>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <list>
 #include <memory>
 #include <sstream>
+#include <thread>
 
 using namespace std::placeholders;
 
@@ -195,6 +197,26 @@ Cloud::ConvertionResult ConvertAfterDownloading(std::string const & filePath,
   result.m_isSuccessful = SaveKmlFile(*kmlData, convertedFilePath, KmlFileType::Binary);
   return result;
 }
+
+// Calls |fn| for all the indices of [0, count) on a few threads.
+template <typename Fn>
+void ForEachIndexInParallel(size_t count, Fn && fn)
+{
+  std::atomic<size_t> next(0);
+  auto routine = [&]() {
+    for (size_t i = next++; i < count; i = next++)
+      fn(i);
+  };
+
+  size_t const threadsCount =
+      std::min(static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)), count);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(routine);
+  routine();
+  for (auto & t : threads)
+    t.join();
+}
 }  // namespace
 
 namespace migration
@@ -260,26 +282,33 @@ bool ConvertBookmarks(std::vector<std::string> const & files,
     return false;
   }
 
-  // Convert all files to kmb.
-  std::vector<std::string> convertedFiles;
-  convertedFiles.reserve(files.size());
-  for (auto const & f : files)
-  {
-    std::string fileName = base::GetNameFromFullPathWithoutExt(f);
-    auto const kmbPath = base::JoinPath(conversionFolder, fileName + kKmbExtension);
+  // Convert all files to kmb. Files are converted in parallel, the order of |convertedFiles|
+  // is the order of |files|.
+  std::vector<std::string> kmbPaths(files.size());
+  ForEachIndexInParallel(files.size(), [&](size_t i) {
+    std::string fileName = base::GetNameFromFullPathWithoutExt(files[i]);
+    auto kmbPath = base::JoinPath(conversionFolder, fileName + kKmbExtension);
     if (!GetPlatform().IsFileExistsByFullPath(kmbPath))
     {
-      auto kmlData = LoadKmlFile(f, KmlFileType::Text);
+      auto kmlData = LoadKmlFile(files[i], KmlFileType::Text);
       if (kmlData == nullptr)
-        continue;
+        return;
 
       if (!SaveKmlFile(*kmlData, kmbPath, KmlFileType::Binary))
       {
         base::DeleteFileX(kmbPath);
-        continue;
+        return;
       }
     }
-    convertedFiles.push_back(kmbPath);
+    kmbPaths[i] = std::move(kmbPath);
+  });
+
+  std::vector<std::string> convertedFiles;
+  convertedFiles.reserve(files.size());
+  for (auto & kmbPath : kmbPaths)
+  {
+    if (!kmbPath.empty())
+      convertedFiles.push_back(std::move(kmbPath));
   }
   convertedCount = convertedFiles.size();
 
@@ -766,18 +795,21 @@ void BookmarkManager::NotifyChanges()
 kml::MarkIdSet const & BookmarkManager::GetUserMarkIds(kml::MarkGroupId groupId) const
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
+  MaterializeCategory(groupId);
   return GetGroup(groupId)->GetUserMarks();
 }
 
 kml::TrackIdSet const & BookmarkManager::GetTrackIds(kml::MarkGroupId groupId) const
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
+  MaterializeCategory(groupId);
   return GetGroup(groupId)->GetUserLines();
 }
 
 void BookmarkManager::ClearGroup(kml::MarkGroupId groupId)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
+  m_pendingMarks.erase(groupId);
   auto * group = GetGroup(groupId);
   for (auto markId : group->GetUserMarks())
   {
@@ -885,6 +917,8 @@ UserMark const * BookmarkManager::FindMarkInRect(kml::MarkGroupId groupId, m2::A
 void BookmarkManager::SetIsVisible(kml::MarkGroupId groupId, bool visible)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
+  if (visible)
+    MaterializeCategory(groupId);
   GetGroup(groupId)->SetIsVisible(visible);
 }
 
@@ -983,19 +1017,28 @@ BookmarkManager::KMLDataCollectionPtr BookmarkManager::LoadBookmarks(
   Platform::FilesList files;
   Platform::GetFilesByExt(dir, ext, files);
 
+  // Files are decoded in parallel, the order of the collection is the order of |files|.
+  std::vector<std::unique_ptr<kml::FileData>> kmlDatas(files.size());
+  ForEachIndexInParallel(files.size(), [&](size_t i) {
+    if (m_needTeardown)
+      return;
+    auto kmlData = LoadKmlFile(base::JoinPath(dir, files[i]), fileType);
+    if (kmlData != nullptr && (!checker || checker(*kmlData)))
+      kmlDatas[i] = std::move(kmlData);
+  });
+
   auto collection = std::make_shared<KMLDataCollection>();
+  if (m_needTeardown)
+    return collection;
+
   collection->reserve(files.size());
   cloudFilePaths.reserve(files.size());
-  for (auto const & file : files)
+  for (size_t i = 0; i < files.size(); ++i)
   {
-    auto const filePath = base::JoinPath(dir, file);
-    auto kmlData = LoadKmlFile(filePath, fileType);
+    auto & kmlData = kmlDatas[i];
     if (kmlData == nullptr)
       continue;
-    if (checker && !checker(*kmlData))
-      continue;
-    if (m_needTeardown)
-      break;
+    auto const filePath = base::JoinPath(dir, files[i]);
     if (!kmlData->m_bookmarksData.empty() || !kmlData->m_tracksData.empty())
       cloudFilePaths.push_back(filePath);
     collection->emplace_back(filePath, std::move(kmlData));
@@ -1145,7 +1188,7 @@ void BookmarkManager::NotifyAboutFinishAsyncLoading(KMLDataCollectionPtr && coll
     }
     if (!collection->empty())
     {
-      CreateCategories(std::move(*collection));
+      CreateCategories(std::move(*collection), true /* autoSave */, true /* lazy */);
     }
     else if (!m_loadBookmarksFinished)
     {
@@ -1511,7 +1554,8 @@ UserMarkLayer * BookmarkManager::GetGroup(kml::MarkGroupId groupId)
   return it != m_categories.end() ? it->second.get() : nullptr;
 }
 
-void BookmarkManager::CreateCategories(KMLDataCollection && dataCollection, bool autoSave)
+void BookmarkManager::CreateCategories(KMLDataCollection && dataCollection, bool autoSave,
+                                       bool lazy)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
   kml::GroupIdSet loadedGroups;
@@ -1572,6 +1616,16 @@ void BookmarkManager::CreateCategories(KMLDataCollection && dataCollection, bool
       group->EnableAutoSave(autoSave);
     }
 
+    if (lazy && !group->IsVisible() &&
+        (!fileData.m_bookmarksData.empty() || !fileData.m_tracksData.empty()))
+    {
+      auto & pending = m_pendingMarks[groupId];
+      pending.m_bookmarksData = std::move(fileData.m_bookmarksData);
+      pending.m_tracksData = std::move(fileData.m_tracksData);
+      UserMarkIdStorage::Instance().EnableSaving(true);
+      continue;
+    }
+
     for (auto & bmData : fileData.m_bookmarksData)
     {
       auto * bm = CreateBookmark(std::move(bmData));
@@ -1597,6 +1651,61 @@ void BookmarkManager::CreateCategories(KMLDataCollection && dataCollection, bool
     auto * group = GetBmCategory(groupId);
     group->EnableAutoSave(autoSave);
   }
+
+  if (lazy && !m_pendingMarks.empty())
+    MaterializePendingCategories();
+}
+
+void BookmarkManager::MaterializeCategory(kml::MarkGroupId groupId) const
+{
+  CHECK_THREAD_CHECKER(m_threadChecker, ());
+  if (m_pendingMarks.empty())
+    return;
+  auto const it = m_pendingMarks.find(groupId);
+  if (it == m_pendingMarks.end())
+    return;
+
+  auto pending = std::move(it->second);
+  m_pendingMarks.erase(it);
+
+  auto & self = const_cast<BookmarkManager &>(*this);
+  auto * group = self.GetBmCategory(groupId);
+  UserMarkIdStorage::Instance().EnableSaving(false);
+  for (auto & bmData : pending.m_bookmarksData)
+  {
+    auto * bm = self.CreateBookmark(std::move(bmData));
+    bm->Attach(groupId);
+    group->AttachUserMark(bm->GetId());
+  }
+  for (auto & trackData : pending.m_tracksData)
+  {
+    auto * t = self.AddTrack(make_unique<Track>(std::move(trackData)));
+    t->Attach(groupId);
+    group->AttachTrack(t->GetId());
+  }
+  UserMarkIdStorage::Instance().EnableSaving(true);
+}
+
+void BookmarkManager::MaterializePendingCategories()
+{
+  // One category per task, so the GUI thread is not blocked by large hidden categories.
+  GetPlatform().RunTask(Platform::Thread::Gui, [this]()
+  {
+    if (m_needTeardown || m_pendingMarks.empty())
+      return;
+
+    auto const groupId = m_pendingMarks.begin()->first;
+    auto * group = GetBmCategory(groupId);
+    // The marks are read from the file of the category, there is no need to rewrite it.
+    bool const autoSave = group->IsAutoSaveEnabled();
+    group->EnableAutoSave(false);
+    MaterializeCategory(groupId);
+    NotifyChanges();
+    group->EnableAutoSave(autoSave);
+
+    if (!m_pendingMarks.empty())
+      MaterializePendingCategories();
+  });
 }
 
 bool BookmarkManager::HasDuplicatedIds(kml::FileData const & fileData) const
@@ -1619,11 +1728,35 @@ bool BookmarkManager::HasDuplicatedIds(kml::FileData const & fileData) const
     if (m_tracks.count(t.m_id) > 0)
       return true;
   }
+
+  if (m_pendingMarks.empty())
+    return false;
+
+  kml::MarkIdSet pendingMarkIds;
+  kml::TrackIdSet pendingTrackIds;
+  for (auto const & pending : m_pendingMarks)
+  {
+    for (auto const & b : pending.second.m_bookmarksData)
+      pendingMarkIds.insert(b.m_id);
+    for (auto const & t : pending.second.m_tracksData)
+      pendingTrackIds.insert(t.m_id);
+  }
+  for (auto const & b : fileData.m_bookmarksData)
+  {
+    if (pendingMarkIds.count(b.m_id) > 0)
+      return true;
+  }
+  for (auto const & t : fileData.m_tracksData)
+  {
+    if (pendingTrackIds.count(t.m_id) > 0)
+      return true;
+  }
   return false;
 }
 
 std::unique_ptr<kml::FileData> BookmarkManager::CollectBmGroupKMLData(BookmarkCategory const * group) const
 {
+  MaterializeCategory(group->GetID());
   auto kmlData = std::make_unique<kml::FileData>();
   kmlData->m_deviceId = GetPlatform().UniqueClientId();
   kmlData->m_serverId = group->GetServerId();
@@ -1801,6 +1934,7 @@ void BookmarkManager::PrepareFileForSharing(kml::MarkGroupId categoryId, Sharing
 bool BookmarkManager::IsCategoryEmpty(kml::MarkGroupId categoryId) const
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
+  MaterializeCategory(categoryId);
   return GetBmCategory(categoryId)->IsEmpty();
 }
 
@@ -1874,6 +2008,8 @@ void BookmarkManager::SetAllCategoriesVisibility(CategoryFilterType const filter
     auto const fromCatalog = IsCategoryFromCatalog(category.first) && !IsMyCategory(category.first);
     if (!IsValidFilterType(filter, fromCatalog))
       continue;
+    if (visible)
+      MaterializeCategory(category.first);
     category.second->SetIsVisible(visible);
   }
 }
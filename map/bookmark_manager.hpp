@@ -319,7 +319,10 @@ public:
   void EnableTestMode(bool enable);
   bool SaveBookmarkCategory(kml::MarkGroupId groupId);
   bool SaveBookmarkCategory(kml::MarkGroupId groupId, Writer & writer, KmlFileType fileType) const;
-  void CreateCategories(KMLDataCollection && dataCollection, bool autoSave = true);
+  // When |lazy| is true, bookmarks and tracks of hidden categories are created later: on the
+  // first access to them or in the background after the visible categories are shown.
+  void CreateCategories(KMLDataCollection && dataCollection, bool autoSave = true,
+                        bool lazy = false);
   static std::string RemoveInvalidSymbols(std::string const & name, std::string const & defaultName);
   static std::string GenerateUniqueFileName(std::string const & path, std::string name, std::string const & fileExt);
   static std::string GenerateValidAndUniqueFilePathForKML(std::string const & fileName);
@@ -500,6 +503,11 @@ private:
   void FinishConversion(ConversionHandler const & handler, bool result);
 
   bool HasDuplicatedIds(kml::FileData const & fileData) const;
+
+  // Creates bookmarks and tracks of a category which were deferred by CreateCategories().
+  // It's const since deferred marks are not observable, so the accessors of marks call it.
+  void MaterializeCategory(kml::MarkGroupId groupId) const;
+  void MaterializePendingCategories();
   bool CheckVisibility(CategoryFilterType const filter, bool isVisible) const;
   ThreadChecker m_threadChecker;
 
@@ -522,6 +530,14 @@ private:
   CategoriesCollection m_categories;
   kml::GroupIdCollection m_bmGroupsIdList;
 
+  struct PendingMarks
+  {
+    std::vector<kml::BookmarkData> m_bookmarksData;
+    std::vector<kml::TrackData> m_tracksData;
+  };
+  // Hidden categories loaded by CreateCategories() whose marks are not created yet.
+  mutable std::map<kml::MarkGroupId, PendingMarks> m_pendingMarks;
+
   std::string m_lastCategoryUrl;
   kml::MarkGroupId m_lastEditedGroupId = kml::kInvalidMarkGroupId;
   kml::PredefinedColor m_lastColor = kml::PredefinedColor::Red;
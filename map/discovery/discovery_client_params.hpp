@@ -2,6 +2,7 @@
 
 #include "platform/preferred_languages.hpp"
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -26,5 +27,7 @@ struct ClientParams
   std::string m_lang = languages::GetCurrentNorm();
   size_t m_itemsCount = kDefaultItemsCount;
   ItemTypes m_itemTypes;
+  // Zero means no timeout, see discovery::Manager::Params.
+  std::chrono::milliseconds m_searchTimeout{0};
 };
 }  // namespace discovery
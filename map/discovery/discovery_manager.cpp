@@ -8,6 +8,9 @@
 
 namespace
 {
+// Hotels, attractions and cafes are searched concurrently.
+size_t constexpr kSearchThreadsCount = 3;
+
 std::string GetQuery(discovery::ItemType const type)
 {
   switch (type)
@@ -31,9 +34,21 @@ Manager::Manager(DataSource const & dataSource, search::CityFinder & cityFinder,
   , m_searchApi(apis.m_search)
   , m_viatorApi(apis.m_viator)
   , m_localsApi(apis.m_locals)
+  , m_searchThreads(kSearchThreadsCount)
 {
 }
 
+void Manager::Cancel(ItemType const type)
+{
+  CHECK_THREAD_CHECKER(m_threadChecker, ());
+  auto const it = m_cancellables.find(type);
+  if (it == m_cancellables.end())
+    return;
+
+  it->second->Cancel();
+  m_cancellables.erase(it);
+}
+
 // static
 DiscoverySearchParams Manager::GetSearchParams(Manager::Params const & params, ItemType const type)
 {
@@ -61,6 +76,16 @@ std::string Manager::GetLocalExpertsUrl(m2::PointD const & point) const
   return os.str();
 }
 
+std::shared_ptr<base::Cancellable> Manager::ResetCancellable(ItemType const type)
+{
+  auto & cancellable = m_cancellables[type];
+  if (cancellable)
+    cancellable->Cancel();
+
+  cancellable = std::make_shared<base::Cancellable>();
+  return cancellable;
+}
+
 std::string Manager::GetCityViatorId(m2::PointD const & point) const
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
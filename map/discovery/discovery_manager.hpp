@@ -18,9 +18,13 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include "base/cancellable.hpp"
 #include "base/thread_checker.hpp"
+#include "base/worker_thread.hpp"
 
+#include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -53,12 +57,18 @@ public:
     m2::PointD m_viewportCenter;
     m2::RectD m_viewport;
     ItemTypes m_itemTypes;
+    // Results of searches for hotels, attractions and cafes which are found before the timeout
+    // are delivered when it expires. Zero means no timeout.
+    std::chrono::milliseconds m_searchTimeout{0};
   };
 
   using ErrorCalback = std::function<void(uint32_t const requestId, ItemType const type)>;
 
   Manager(DataSource const & dataSource, search::CityFinder & cityFinder, APIs const & apis);
 
+  /// Requests of all |params.m_itemTypes| are run concurrently, results of every type are
+  /// delivered as soon as they are ready. A new request cancels the previous requests of the
+  /// same types.
   template <typename ResultCallback>
   uint32_t Discover(Params && params, ResultCallback const & onResult, ErrorCalback const & onError)
   {
@@ -69,8 +79,13 @@ public:
     auto const & types = params.m_itemTypes;
     ASSERT(!types.empty(), ("Types must contain at least one element."));
 
+    auto const deadline = params.m_searchTimeout.count() == 0
+                              ? std::chrono::steady_clock::time_point::max()
+                              : std::chrono::steady_clock::now() + params.m_searchTimeout;
+
     for (auto const type : types)
     {
+      auto const cancellable = ResetCancellable(type);
       switch (type)
       {
       case ItemType::Viator:
@@ -95,9 +110,12 @@ public:
 
         m_viatorApi.GetTop5Products(
             sponsoredId, params.m_curency,
-            [this, requestId, sponsoredId, onResult, onError](std::string const & destId,
-                                                     std::vector<viator::Product> const & products) {
+            [this, requestId, sponsoredId, onResult, onError, cancellable](
+                std::string const & destId, std::vector<viator::Product> const & products) {
               CHECK_THREAD_CHECKER(m_threadChecker, ());
+              if (cancellable->IsCancelled())
+                return;
+
               if (destId == sponsoredId)
               {
                 if (products.empty())
@@ -116,20 +134,31 @@ public:
       case ItemType::Hotels:
       {
         auto p = GetSearchParams(params, type);
+        p.m_cancellable = cancellable;
+        p.m_deadline = deadline;
         auto const viewportCenter = params.m_viewportCenter;
         p.m_onResults =
-          [requestId, onResult, type, viewportCenter](search::Results const & results,
+          [requestId, onResult, type, viewportCenter, cancellable](search::Results const & results,
                                                       std::vector<search::ProductInfo> const & productInfo) {
           GetPlatform().RunTask(Platform::Thread::Gui,
-                                [requestId, onResult, type, results, productInfo, viewportCenter] {
+                                [requestId, onResult, type, results, productInfo, viewportCenter,
+                                 cancellable] {
+            if (cancellable->IsCancelled())
+              return;
             onResult(requestId, results, productInfo, type, viewportCenter);
           });
         };
 
         if (type == ItemType::Hotels)
-          ProcessSearchIntent(std::make_shared<SearchHotels>(m_dataSource, p, m_searchApi));
+        {
+          ProcessSearchIntent(std::make_shared<SearchHotels>(m_dataSource, p, m_searchApi),
+                              m_searchThreads);
+        }
         else
-          ProcessSearchIntent(std::make_shared<SearchPopularPlaces>(m_dataSource, p, m_searchApi));
+        {
+          ProcessSearchIntent(std::make_shared<SearchPopularPlaces>(m_dataSource, p, m_searchApi),
+                              m_searchThreads);
+        }
 
         break;
       }
@@ -139,15 +168,19 @@ public:
         auto constexpr pageNumber = 1;
         m_localsApi.GetLocals(
             latLon.lat, latLon.lon, params.m_lang, params.m_itemsCount, pageNumber,
-            [this, requestId, onResult](uint64_t id, std::vector<locals::LocalExpert> const & locals,
-                                        size_t /* pageNumber */, size_t /* countPerPage */,
-                                        bool /* hasPreviousPage */, bool /* hasNextPage */) {
+            [this, requestId, onResult, cancellable](
+                uint64_t id, std::vector<locals::LocalExpert> const & locals,
+                size_t /* pageNumber */, size_t /* countPerPage */, bool /* hasPreviousPage */,
+                bool /* hasNextPage */) {
               CHECK_THREAD_CHECKER(m_threadChecker, ());
-              onResult(requestId, locals);
+              if (!cancellable->IsCancelled())
+                onResult(requestId, locals);
             },
-            [this, requestId, onError, type](uint64_t id, int errorCode, std::string const & errorMessage) {
+            [this, requestId, onError, type, cancellable](uint64_t id, int errorCode,
+                                                          std::string const & errorMessage) {
               CHECK_THREAD_CHECKER(m_threadChecker, ());
-              onError(requestId, type);
+              if (!cancellable->IsCancelled())
+                onError(requestId, type);
             });
         break;
       }
@@ -156,12 +189,17 @@ public:
     return requestId;
   }
 
+  /// Results of the requests of |type| are not delivered after the call.
+  void Cancel(ItemType const type);
+
   std::string GetViatorUrl(m2::PointD const & point) const;
   std::string GetLocalExpertsUrl(m2::PointD const & point) const;
 
 private:
   static DiscoverySearchParams GetSearchParams(Manager::Params const & params, ItemType const type);
   std::string GetCityViatorId(m2::PointD const & point) const;
+  // Cancels the previous request of |type| and returns the cancellable of a new one.
+  std::shared_ptr<base::Cancellable> ResetCancellable(ItemType const type);
 
   DataSource const & m_dataSource;
   search::CityFinder & m_cityFinder;
@@ -174,5 +212,10 @@ private:
   // We save last succeed viator result for the nearest city and rewrite it when the nearest city
   // was changed.
   std::pair<std::string, std::vector<viator::Product>> m_cachedViator;
+
+  std::map<ItemType, std::shared_ptr<base::Cancellable>> m_cancellables;
+  // Searches of different item types are run on different threads.
+  // m_searchThreads must be the last member to be destroyed first.
+  base::WorkerThread m_searchThreads;
 };
 }  // namespace discovery
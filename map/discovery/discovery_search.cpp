@@ -1,5 +1,6 @@
 #include "map/discovery/discovery_search.hpp"
 
+#include "search/cancel_exception.hpp"
 #include "search/intermediate_result.hpp"
 #include "search/utils.hpp"
 
@@ -12,6 +13,7 @@
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <set>
 #include <utility>
@@ -58,6 +60,27 @@ FeatureType MakeFeatureTypeWithCachedGuard(DataSource const & dataSource, MwmSet
   return ft;
 }
 
+// Interrupts the search when it is cancelled or when the deadline passes.
+class Interrupter : public base::Cancellable
+{
+public:
+  explicit Interrupter(discovery::DiscoverySearchParams const & params) : m_params(params) {}
+
+  bool IsCancelledByClient() const
+  {
+    return m_params.m_cancellable && m_params.m_cancellable->IsCancelled();
+  }
+
+  // base::Cancellable overrides:
+  bool IsCancelled() const override
+  {
+    return IsCancelledByClient() || std::chrono::steady_clock::now() >= m_params.m_deadline;
+  }
+
+private:
+  discovery::DiscoverySearchParams const & m_params;
+};
+
 class GreaterRating
 {
 public:
@@ -92,20 +115,30 @@ SearchBase::SearchBase(DataSource const & dataSource, DiscoverySearchParams cons
 
 void SearchBase::Search()
 {
+  Interrupter const interrupter(m_params);
   MwmSet::MwmId currentMwmId;
-  search::ForEachOfTypesInRect(m_dataSource,
-                               search::GetCategoryTypes(m_params.m_query, "en", GetDefaultCategories()),
-                               m_params.m_viewport,
-                               [this, &currentMwmId](FeatureID const & id)
-                               {
-                                 if (currentMwmId != id.m_mwmId)
+  try
+  {
+    search::ForEachOfTypesInRect(m_dataSource,
+                                 search::GetCategoryTypes(m_params.m_query, "en", GetDefaultCategories()),
+                                 m_params.m_viewport, interrupter,
+                                 [this, &currentMwmId](FeatureID const & id)
                                  {
-                                   currentMwmId = id.m_mwmId;
-                                   OnMwmChanged(m_dataSource.GetMwmHandleById(id.m_mwmId));
-                                 }
+                                   if (currentMwmId != id.m_mwmId)
+                                   {
+                                     currentMwmId = id.m_mwmId;
+                                     OnMwmChanged(m_dataSource.GetMwmHandleById(id.m_mwmId));
+                                   }
+
+                                   ProcessFeatureId(id);
+                                 });
+  }
+  catch (search::CancelException const &)
+  {
+  }
 
-                                 ProcessFeatureId(id);
-                               });
+  if (interrupter.IsCancelledByClient())
+    return;
 
   ProcessAccumulated();
 
@@ -275,11 +308,11 @@ void SearchPopularPlaces::ProcessAccumulated()
   }
 }
 
-void ProcessSearchIntent(std::shared_ptr<SearchBase> intent)
+void ProcessSearchIntent(std::shared_ptr<SearchBase> intent, base::TaskLoop & taskLoop)
 {
   if (!intent)
     return;
 
-  GetPlatform().RunTask(Platform::Thread::File, [intent]() { intent->Search(); });
+  taskLoop.Push([intent]() { intent->Search(); });
 }
 }  // namespace discovery
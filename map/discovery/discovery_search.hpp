@@ -9,6 +9,8 @@
 
 #include "search/result.hpp"
 
+#include "base/task_loop.hpp"
+
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -80,5 +82,5 @@ private:
   std::multimap<uint8_t, FeatureID, std::greater<uint8_t>> m_accumulatedResults;
 };
 
-void ProcessSearchIntent(std::shared_ptr<SearchBase> intent);
+void ProcessSearchIntent(std::shared_ptr<SearchBase> intent, base::TaskLoop & taskLoop);
 }  // namespace discovery
@@ -8,8 +8,12 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include "base/cancellable.hpp"
+
+#include <chrono>
 #include <cstddef>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -24,5 +28,9 @@ struct DiscoverySearchParams
   size_t m_itemsCount = 0;
   m2::RectD m_viewport;
   OnResults m_onResults = nullptr;
+  // Results are not delivered when the search is cancelled.
+  std::shared_ptr<base::Cancellable> m_cancellable;
+  // Results which are found before the deadline are delivered when it passes.
+  std::chrono::steady_clock::time_point m_deadline = std::chrono::steady_clock::time_point::max();
 };
 }  // namespace discovery
@@ -9,7 +9,9 @@
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
+#include "std/thread.hpp"
 
 using platform::CountryFile;
 using platform::LocalCountryFile;
@@ -69,6 +71,27 @@ pair<MwmSet::MwmId, MwmSet::RegResult> FeaturesFetcher::RegisterMap(
   }
 }
 
+vector<pair<MwmSet::MwmId, MwmSet::RegResult>> FeaturesFetcher::RegisterMaps(
+    vector<LocalCountryFile> const & localFiles, MwmInfoCache * infoCache)
+{
+  size_t const threadsCount = max(thread::hardware_concurrency(), 1U);
+  auto results = m_dataSource.RegisterMaps(localFiles, infoCache, threadsCount);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    if (results[i].second != MwmSet::RegResult::Success)
+    {
+      LOG(LWARNING, ("Can't add map", localFiles[i].GetCountryName(), "(", results[i].second,
+                     ").", "Probably it's already added or has newer data version."));
+      continue;
+    }
+
+    MwmSet::MwmId const & id = results[i].first;
+    ASSERT(id.IsAlive(), ());
+    m_rect.Add(id.GetInfo()->m_bordersRect);
+  }
+  return results;
+}
+
 bool FeaturesFetcher::DeregisterMap(CountryFile const & countryFile)
 {
   return m_dataSource.Deregister(countryFile);
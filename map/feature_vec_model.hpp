@@ -3,6 +3,7 @@
 #include "editor/editable_data_source.hpp"
 
 #include "indexer/data_header.hpp"
+#include "indexer/mwm_info_cache.hpp"
 #include "indexer/mwm_set.hpp"
 
 #include "geometry/rect2d.hpp"
@@ -14,6 +15,7 @@
 #include "base/macros.hpp"
 
 #include <functional>
+#include <vector>
 
 namespace model
 {
@@ -53,6 +55,10 @@ class FeaturesFetcher : public MwmSet::Observer
     pair<MwmSet::MwmId, MwmSet::RegResult> RegisterMap(
         platform::LocalCountryFile const & localFile);
 
+    /// Registers maps by several threads, see DataSource::RegisterMaps().
+    std::vector<pair<MwmSet::MwmId, MwmSet::RegResult>> RegisterMaps(
+        std::vector<platform::LocalCountryFile> const & localFiles, MwmInfoCache * infoCache);
+
     /// Deregisters a map denoted by file from internal records.
     bool DeregisterMap(platform::CountryFile const & countryFile);
 
@@ -708,20 +708,33 @@ void Framework::RegisterAllMaps()
 
   vector<shared_ptr<LocalCountryFile>> maps;
   m_storage.GetLocalMaps(maps);
+  vector<LocalCountryFile> localFiles;
+  localFiles.reserve(maps.size());
   for (auto const & localFile : maps)
+    localFiles.push_back(*localFile);
+
+  // Headers of unchanged maps are taken from the cache, so most of maps are registered
+  // without opening their files.
+  MwmInfoCache infoCache(base::JoinPath(GetPlatform().WritableDir(), MWM_INFO_CACHE_FILE));
+  infoCache.Load();
+  auto const results = m_model.RegisterMaps(localFiles, &infoCache);
+  infoCache.Save();
+
+  for (size_t i = 0; i < results.size(); ++i)
   {
-    auto p = RegisterMap(*localFile);
-    if (p.second != MwmSet::RegResult::Success)
+    if (results[i].second != MwmSet::RegResult::Success)
       continue;
 
-    MwmSet::MwmId const & id = p.first;
+    MwmSet::MwmId const & id = results[i].first;
     ASSERT(id.IsAlive(), ());
     minFormat = min(minFormat, static_cast<int>(id.GetInfo()->m_version.GetFormat()));
     if (needStatisticsUpdate)
     {
-      listRegisteredMaps << localFile->GetCountryName() << ":" << id.GetInfo()->GetVersion() << ";";
+      listRegisteredMaps << localFiles[i].GetCountryName() << ":" << id.GetInfo()->GetVersion()
+                         << ";";
     }
   }
+  LOG(LINFO, ("Registered", results.size(), "maps,", infoCache.GetSize(), "infos are cached."));
 
   if (needStatisticsUpdate)
   {
@@ -847,7 +860,12 @@ void Framework::FillInfoFromFeatureType(FeatureType & ft, place_page::Info & inf
   info.SetLocalizedWifiString(m_stringsBundle.GetString("wifi"));
 
   if (ftypes::IsAddressObjectChecker::Instance()(ft))
-    info.SetAddress(GetAddressInfoAtPoint(feature::GetCenter(ft)).FormatHouseAndStreet());
+  {
+    if (m_deferPlacePageAddress)
+      info.SetPendingAddress(feature::GetCenter(ft));
+    else
+      info.SetAddress(GetAddressInfoAtPoint(feature::GetCenter(ft)).FormatHouseAndStreet());
+  }
 
   info.SetFromFeatureType(ft);
 
@@ -1334,6 +1352,14 @@ void Framework::MemoryWarning()
   LOG(LINFO, ("MemoryWarning"));
   ClearAllCaches();
   SharedBufferManager::instance().clearReserved();
+  TrimMemory(base::CacheRegistry::Pressure::Critical);
+}
+
+void Framework::TrimMemory(base::CacheRegistry::Pressure pressure)
+{
+  auto & registry = base::CacheRegistry::Instance();
+  LOG(LINFO, ("Trim memory:", pressure, ", caches use", registry.GetTotalSize(), "bytes"));
+  registry.OnMemoryPressure(pressure);
 }
 
 void Framework::EnterBackground()
@@ -1344,6 +1370,7 @@ void Framework::EnterBackground()
   SaveViewport();
 
   m_ugcApi->SaveUGCOnDisk();
+  eye::Eye::Instance().Flush();
 
   m_trafficManager.OnEnterBackground();
   m_routingManager.SetAllowSendingPoints(false);
@@ -1651,6 +1678,21 @@ void Framework::FillSearchResultsMarks(search::Results::ConstIter begin,
     editSession.ClearGroup(UserMark::Type::SEARCH);
   editSession.SetIsVisible(UserMark::Type::SEARCH, true);
 
+  // Ratings of all the results are read at once, each mwm is read only once.
+  vector<FeatureID> ugcFeatures;
+  for (auto it = begin; it != end; ++it)
+  {
+    if (it->HasPoint() && it->GetResultType() == search::Result::Type::Feature &&
+        !it->m_metadata.m_isSponsoredHotel)
+    {
+      ugcFeatures.push_back(it->GetFeatureID());
+    }
+  }
+  ASSERT(m_ugcApi, ());
+  auto const ugcs =
+      m_ugcApi->GetLoader().GetUGC(ugcFeatures, ugc::binary::Fields::WithoutTexts);
+  size_t ugcIndex = 0;
+
   for (auto it = begin; it != end; ++it)
   {
     auto const & r = *it;
@@ -1672,11 +1714,12 @@ void Framework::FillSearchResultsMarks(search::Results::ConstIter begin,
     }
     else if (isFeature)
     {
-      auto product = GetProductInfo(r);
-      if (product.m_ugcRating != search::ProductInfo::kInvalidRating)
+      ASSERT_LESS(ugcIndex, ugcs.size(), ());
+      auto const rating = ugcs[ugcIndex++].m_totalRating;
+      if (rating != search::ProductInfo::kInvalidRating)
       {
         mark->SetMarkType(SearchMarkType::UGC);
-        mark->SetRating(product.m_ugcRating);
+        mark->SetRating(rating);
       }
     }
 
@@ -1782,12 +1825,31 @@ void Framework::CreateDrapeEngine(ref_ptr<dp::GraphicsContextFactory> contextFac
 
   auto isUGCFn = [this](FeatureID const & id)
   {
-    auto const ugc = m_ugcApi->GetLoader().GetUGC(id);
+    auto const ugc = m_ugcApi->GetLoader().GetUGC(id, ugc::binary::Fields::WithoutTexts);
     return !ugc.IsEmpty();
   };
   auto isCountryLoadedByNameFn = bind(&Framework::IsCountryLoadedByName, this, _1);
   auto updateCurrentCountryFn = bind(&Framework::OnUpdateCurrentCountry, this, _1, _2);
 
+  // Sections which are read first for every tile are prefetched while the tiles are queued.
+  auto prefetchDataFn = [this](m2::RectD const & r)
+  {
+    auto * prefetcher = GetPlatform().GetFilePrefetcher();
+    if (prefetcher == nullptr)
+      return;
+
+    vector<shared_ptr<MwmInfo>> infos;
+    m_model.GetDataSource().GetMwmsInfo(infos);
+    for (auto const & info : infos)
+    {
+      if (info->IsRegistered() && info->m_bordersRect.IsIntersect(r))
+      {
+        prefetcher->PrefetchSections(info->GetLocalFile().GetPath(MapOptions::Map),
+                                     {INDEX_FILE_TAG, FEATURE_OFFSETS_FILE_TAG});
+      }
+    }
+  };
+
   bool allow3d;
   bool allow3dBuildings;
   Load3dMode(allow3d, allow3dBuildings);
@@ -1801,7 +1863,8 @@ void Framework::CreateDrapeEngine(ref_ptr<dp::GraphicsContextFactory> contextFac
       params.m_apiVersion, contextFactory,
       dp::Viewport(0, 0, params.m_surfaceWidth, params.m_surfaceHeight),
       df::MapDataProvider(move(idReadFn), move(featureReadFn), move(filterFeatureFn),
-                          move(isCountryLoadedByNameFn), move(updateCurrentCountryFn)),
+                          move(isCountryLoadedByNameFn), move(updateCurrentCountryFn),
+                          move(prefetchDataFn)),
       params.m_hints, params.m_visualScale, fontsScaleFactor, move(params.m_widgetsInitInfo),
       make_pair(params.m_initialMyPositionState, params.m_hasMyPositionState),
       move(myPositionModeChangedFn), allow3dBuildings, trafficEnabled,
@@ -2199,12 +2262,38 @@ void Framework::ActivateMapSelection(bool needAnimation, df::SelectionShape::ESe
     m_activateMapSelectionFn(info);
   else
     LOG(LWARNING, ("m_activateMapSelectionFn has not been set up."));
+
+  RequestPlacePageAddress(info);
+}
+
+void Framework::RequestPlacePageAddress(place_page::Info const & info)
+{
+  uint64_t const requestId = ++m_placePageRequestId;
+  if (!info.IsAddressPending())
+    return;
+
+  // Reverse geocoding reads several features around the point, so it's done off the UI thread
+  // and the place page is updated when the address is ready.
+  GetPlatform().RunTask(Platform::Thread::Background, [this, info = info, requestId]()
+  {
+    auto const address = GetAddressInfoAtPoint(info.GetPendingAddressPoint()).FormatHouseAndStreet();
+    GetPlatform().RunTask(Platform::Thread::Gui, [this, info, address, requestId]() mutable
+    {
+      if (requestId != m_placePageRequestId || m_lastTapEvent == nullptr)
+        return;
+
+      info.UpdateAddress(address);
+      if (m_activateMapSelectionFn)
+        m_activateMapSelectionFn(info);
+    });
+  });
 }
 
 void Framework::DeactivateMapSelection(bool notifyUI)
 {
   bool const somethingWasAlreadySelected = (m_lastTapEvent != nullptr);
   m_lastTapEvent.reset();
+  ++m_placePageRequestId;
 
   if (notifyUI && m_deactivateMapSelectionFn)
     m_deactivateMapSelectionFn(!somethingWasAlreadySelected);
@@ -2351,6 +2440,9 @@ df::SelectionShape::ESelectedObject Framework::OnTapEventImpl(TapEvent const & t
   if (m_drapeEngine == nullptr)
     return df::SelectionShape::OBJECT_EMPTY;
 
+  m_deferPlacePageAddress = true;
+  SCOPE_GUARD(addressGuard, [this]() { m_deferPlacePageAddress = false; });
+
   auto const & tapInfo = tapEvent.m_info;
 
   if (tapInfo.m_isMyPositionTapped)
@@ -2662,9 +2754,16 @@ discovery::Manager::Params Framework::GetDiscoveryParams(
   p.m_lang = clientParams.m_lang;
   p.m_itemsCount = clientParams.m_itemsCount;
   p.m_itemTypes = move(clientParams.m_itemTypes);
+  p.m_searchTimeout = clientParams.m_searchTimeout;
   return p;
 }
 
+void Framework::CancelDiscovery(discovery::ItemType const type)
+{
+  CHECK(m_discoveryManager.get(), ());
+  m_discoveryManager->Cancel(type);
+}
+
 std::string Framework::GetDiscoveryViatorUrl() const
 {
   return m_discoveryManager->GetViatorUrl(GetDiscoveryViewportCenter());
@@ -3494,7 +3593,8 @@ search::ProductInfo Framework::GetProductInfo(search::Result const & result) con
 
   productInfo.m_isLocalAdsCustomer = m_localAdsManager.Contains(result.GetFeatureID());
 
-  auto const ugc = m_ugcApi->GetLoader().GetUGC(result.GetFeatureID());
+  auto const ugc =
+      m_ugcApi->GetLoader().GetUGC(result.GetFeatureID(), ugc::binary::Fields::WithoutTexts);
   productInfo.m_ugcRating = ugc.m_totalRating;
 
   return productInfo;
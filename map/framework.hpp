@@ -73,6 +73,7 @@
 #include "geometry/rect2d.hpp"
 #include "geometry/screenbase.hpp"
 
+#include "base/cache_registry.hpp"
 #include "base/deferred_task.hpp"
 #include "base/macros.hpp"
 #include "base/strings_bundle.hpp"
@@ -442,6 +443,16 @@ private:
                                     TapEvent::Source source) const;
   UserMark const * FindUserMarkInTapPosition(df::TapInfo const & tapInfo) const;
   FeatureID FindBuildingAtPoint(m2::PointD const & mercator) const;
+  /// Looks up the pending address of |info| on the background thread and notifies UI
+  /// with the updated info if the selection is not changed meanwhile.
+  void RequestPlacePageAddress(place_page::Info const & info);
+
+  /// When true, FillInfoFromFeatureType() doesn't reverse geocode the address of a feature
+  /// and leaves it pending. It's set while place page info for a tap is assembled so
+  /// the place page is shown without waiting for the address.
+  bool m_deferPlacePageAddress = false;
+  /// Incremented on each selection change, used to drop addresses of stale selections.
+  uint64_t m_placePageRequestId = 0;
 
   void UpdateMinBuildingsTapZoom();
 
@@ -710,6 +721,8 @@ public:
   WARN_UNUSED_RESULT bool GetFeatureByID(FeatureID const & fid, FeatureType & ft) const;
 
   void MemoryWarning();
+  // Shrinks caches registered in base::CacheRegistry according to |pressure|.
+  void TrimMemory(base::CacheRegistry::Pressure pressure);
   void EnterBackground();
   void EnterForeground();
 
@@ -795,6 +808,7 @@ public:
   }
 
   discovery::Manager::Params GetDiscoveryParams(discovery::ClientParams && clientParams) const;
+  void CancelDiscovery(discovery::ItemType const type);
 
   std::string GetDiscoveryViatorUrl() const;
   std::string GetDiscoveryLocalExpertsUrl() const;
@@ -177,10 +177,15 @@ void GpsTrack::InitCollection(hours duration)
     // All origin points have been written in the storage,
     // and filtered points are inserted in the runtime collection.
 
+    // Points older than the duration would be evicted from the collection anyway,
+    // so only the tail of the storage is read.
+    double const minTimestamp =
+        m_storage->GetMaxTimestamp() - duration_cast<seconds>(duration).count();
+
     vector<location::GpsInfo> originPoints;
     originPoints.reserve(kItemBlockSize);
 
-    m_storage->ForEach([this, &originPoints](location::GpsInfo const & originPoint)->bool
+    m_storage->ForEachSince(minTimestamp, [this, &originPoints](location::GpsInfo const & originPoint)->bool
     {
       originPoints.emplace_back(originPoint);
       if (originPoints.size() == originPoints.capacity())
@@ -1,9 +1,15 @@
 #include "map/gps_track_storage.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/endianness.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/array.hpp"
+#include "std/cmath.hpp"
 #include "std/cstring.hpp"
 
 #include "base/assert.hpp"
@@ -13,7 +19,10 @@ namespace
 {
 
 // Current file format version
-uint32_t constexpr kCurrentVersion = 1;
+uint32_t constexpr kCurrentVersion = 2;
+
+// Version with items written as plain values, such files are converted on open
+uint32_t constexpr kVersion1 = 1;
 
 // Header size in bytes, header consists of uint32_t 'version' only
 uint32_t constexpr kHeaderSize = sizeof(uint32_t);
@@ -21,11 +30,31 @@ uint32_t constexpr kHeaderSize = sizeof(uint32_t);
 // Number of items for batch processing
 size_t constexpr kItemBlockSize = 1000;
 
-// TODO
-// Now GpsInfo written as plain values, but values can be compressed.
+// Size of the buffer to copy blocks
+size_t constexpr kCopyBufferSize = 64 * 1024;
+
+// Max number of items in a block of the file
+size_t constexpr kBlockItemCount = 256;
+
+// Block header consists of payload size, number of items and min and max timestamps of items.
+// Payload contains items, each value of an item is quantized and written as a varint delta
+// from the value of the previous item of the block. Values which can't be quantized are
+// written as plain doubles, they are marked by bits of the byte which starts an item.
+size_t constexpr kBlockHeaderSize = 2 * sizeof(uint32_t) + 2 * sizeof(double);
+
+// Size of point in bytes in the version 1 file
+size_t constexpr kVersion1PointSize = 8 * sizeof(double) + sizeof(uint8_t);
+
+// Quantization factors of the item values: timestamp is kept with millisecond precision,
+// coordinates with 1e-7 degree (about 1 cm) precision, other values with 0.01 precision.
+size_t constexpr kValuesCount = 8;
+array<double, kValuesCount> const kFactors = {{1e3, 1e7, 1e7, 1e2, 1e2, 1e2, 1e2, 1e2}};
 
-// Size of point in bytes to write in file of read from file
-size_t constexpr kPointSize = 8 * sizeof(double) + sizeof(uint8_t);
+// Max absolute value of a quantized value, bigger values are written as plain doubles.
+double constexpr kMaxQuantizedValue = static_cast<double>(1LL << 52);
+
+using TRawValues = array<double, kValuesCount>;
+using TValues = array<int64_t, kValuesCount>;
 
 // Writes value in memory in LittleEndian
 template <typename T>
@@ -44,22 +73,7 @@ T MemRead(void const * ptr)
   return SwapIfBigEndianMacroBased(value);
 }
 
-void Pack(char * p, location::GpsInfo const & info)
-{  
-  MemWrite<double>(p + 0 * sizeof(double), info.m_timestamp);
-  MemWrite<double>(p + 1 * sizeof(double), info.m_latitude);
-  MemWrite<double>(p + 2 * sizeof(double), info.m_longitude);
-  MemWrite<double>(p + 3 * sizeof(double), info.m_altitude);
-  MemWrite<double>(p + 4 * sizeof(double), info.m_speedMpS);
-  MemWrite<double>(p + 5 * sizeof(double), info.m_bearing);
-  MemWrite<double>(p + 6 * sizeof(double), info.m_horizontalAccuracy);
-  MemWrite<double>(p + 7 * sizeof(double), info.m_verticalAccuracy);
-  ASSERT_LESS_OR_EQUAL(static_cast<int>(info.m_source), 255, ());
-  uint8_t const source = static_cast<uint8_t>(info.m_source);
-  MemWrite<uint8_t>(p + 8 * sizeof(double), source);
-}
-
-void Unpack(char const * p, location::GpsInfo & info)
+void UnpackVersion1(char const * p, location::GpsInfo & info)
 {
   info.m_timestamp = MemRead<double>(p + 0 * sizeof(double));
   info.m_latitude = MemRead<double>(p + 1 * sizeof(double));
@@ -73,15 +87,97 @@ void Unpack(char const * p, location::GpsInfo & info)
   info.m_source = static_cast<location::TLocationSource>(source);
 }
 
-inline size_t GetItemOffset(size_t itemIndex)
+TRawValues GetValues(location::GpsInfo const & info)
 {
-  return kHeaderSize + itemIndex * kPointSize;
+  return {{info.m_timestamp, info.m_latitude, info.m_longitude, info.m_altitude,
+           info.m_speedMpS, info.m_bearing, info.m_horizontalAccuracy, info.m_verticalAccuracy}};
+}
+
+void SetValues(TRawValues const & values, location::GpsInfo & info)
+{
+  info.m_timestamp = values[0];
+  info.m_latitude = values[1];
+  info.m_longitude = values[2];
+  info.m_altitude = values[3];
+  info.m_speedMpS = values[4];
+  info.m_bearing = values[5];
+  info.m_horizontalAccuracy = values[6];
+  info.m_verticalAccuracy = values[7];
+}
+
+void Encode(vector<location::GpsInfo> const & items, vector<uint8_t> & buffer)
+{
+  static_assert(kValuesCount <= 8, "Plain values mask must fit a byte.");
+
+  PushBackByteSink<vector<uint8_t>> sink(buffer);
+  TValues prev = {};
+  for (auto const & item : items)
+  {
+    TRawValues const values = GetValues(item);
+
+    uint8_t plainMask = 0;
+    for (size_t i = 0; i < kValuesCount; ++i)
+    {
+      if (!(fabs(values[i] * kFactors[i]) < kMaxQuantizedValue))
+        plainMask |= 1 << i;
+    }
+    WriteToSink(sink, plainMask);
+
+    for (size_t i = 0; i < kValuesCount; ++i)
+    {
+      if (plainMask & (1 << i))
+      {
+        uint64_t bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        WriteToSink(sink, bits);
+        continue;
+      }
+      int64_t const value = static_cast<int64_t>(llround(values[i] * kFactors[i]));
+      WriteVarInt(sink, value - prev[i]);
+      prev[i] = value;
+    }
+
+    ASSERT_LESS_OR_EQUAL(static_cast<int>(item.m_source), 255, ());
+    WriteToSink(sink, static_cast<uint8_t>(item.m_source));
+  }
 }
 
-inline size_t GetItemCount(size_t fileSize)
+// Returns false if |fn| stopped decoding.
+template <typename TFn>
+bool Decode(uint8_t const * payload, uint32_t payloadSize, uint32_t itemCount, TFn && fn)
 {
-  ASSERT_GREATER_OR_EQUAL(fileSize, kHeaderSize, ());
-  return (fileSize - kHeaderSize) / kPointSize;
+  uint8_t const * end = payload + payloadSize;
+  ArrayByteSource src(payload);
+  TValues prev = {};
+  for (uint32_t i = 0; i < itemCount; ++i)
+  {
+    uint8_t const plainMask = src.ReadByte();
+
+    TRawValues values;
+    for (size_t j = 0; j < kValuesCount; ++j)
+    {
+      if (plainMask & (1 << j))
+      {
+        uint64_t bits;
+        src.Read(&bits, sizeof(bits));
+        bits = SwapIfBigEndianMacroBased(bits);
+        memcpy(&values[j], &bits, sizeof(bits));
+        continue;
+      }
+      prev[j] += ReadVarInt<int64_t>(src);
+      values[j] = prev[j] / kFactors[j];
+    }
+
+    location::GpsInfo item;
+    SetValues(values, item);
+    item.m_source = static_cast<location::TLocationSource>(src.ReadByte());
+    if (src.PtrUC() > end)
+      MYTHROW(GpsTrackStorage::ReadException, ("Broken block."));
+
+    if (!fn(item))
+      return false;
+  }
+  return true;
 }
 
 inline bool WriteVersion(fstream & f, uint32_t version)
@@ -120,42 +216,24 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
 
     if (version == kCurrentVersion)
     {
-      // Seek to end to get file size
-      m_stream.seekp(0, ios::end);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
-
-      size_t const fileSize = m_stream.tellp();
-
-      m_itemCount = GetItemCount(fileSize);
-
-      // Set write position after last item position
-      size_t const offset = GetItemOffset(m_itemCount);
-      m_stream.seekp(offset, ios::beg);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the offset error:", offset, m_filePath));
+      m_stream.close();
+      LoadBlocks();
+    }
+    else if (version == kVersion1)
+    {
+      vector<TItem> const items = ReadVersion1Items();
+      m_stream.close();
+      CreateFile();
+      Append(items);
     }
     else
     {
       m_stream.close();
-      // TODO: migration for file m_filePath from version 'version' to version 'kCurrentVersion'
-      // TODO: For now we support only one version, but in future migration may be needed.
     }
   }
 
-  if (!m_stream)
-  {
-    // Create new file
-    m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
-
-    if (!m_stream)
-      MYTHROW(OpenException, ("Open file error.", m_filePath));
-
-    if (!WriteVersion(m_stream, kCurrentVersion))
-      MYTHROW(OpenException, ("Write version error.", m_filePath));
-
-    m_itemCount = 0;
-  }
+  if (!m_stream.is_open())
+    CreateFile();
 }
 
 void GpsTrackStorage::Append(vector<TItem> const & items)
@@ -170,21 +248,21 @@ void GpsTrackStorage::Append(vector<TItem> const & items)
   if (needTrunc)
     TruncFile();
 
-  // Write position must be after last item position
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(m_itemCount)), ());
-
-  vector<char> buff(min(kItemBlockSize, items.size()) * kPointSize);
   for (size_t i = 0; i < items.size();)
   {
-    size_t const n = min(items.size() - i, kItemBlockSize);
+    if (m_lastBlockItems.empty())
+    {
+      Block block;
+      block.m_offset = GetEndOffset();
+      m_blocks.push_back(block);
+    }
 
-    for (size_t j = 0; j < n; ++j)
-      Pack(&buff[0] + j * kPointSize, items[i + j]);
+    size_t const n = min(items.size() - i, kBlockItemCount - m_lastBlockItems.size());
+    m_lastBlockItems.insert(m_lastBlockItems.end(), items.begin() + i, items.begin() + i + n);
+    WriteBlock(m_lastBlockItems, m_blocks.back());
 
-    m_stream.write(&buff[0], n * kPointSize);
-    if (!m_stream.good())
-      MYTHROW(WriteException, ("File:", m_filePath));
+    if (m_lastBlockItems.size() == kBlockItemCount)
+      m_lastBlockItems.clear();
 
     i += n;
   }
@@ -201,6 +279,8 @@ void GpsTrackStorage::Clear()
   ASSERT(m_stream.is_open(), ());
 
   m_itemCount = 0;
+  m_blocks.clear();
+  m_lastBlockItems.clear();
 
   m_stream.close();
 
@@ -211,42 +291,224 @@ void GpsTrackStorage::Clear()
 
   if (!WriteVersion(m_stream, kCurrentVersion))
     MYTHROW(WriteException, ("File:", m_filePath));
-
-  // Write position is set to the first item in the file
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(0)), ());
 }
 
 void GpsTrackStorage::ForEach(std::function<bool(TItem const & item)> const & fn)
 {
-  ASSERT(m_stream.is_open(), ());
+  ForEachImpl(GetFirstItemIndex(), numeric_limits<double>::lowest(), fn);
+}
+
+void GpsTrackStorage::ForEachSince(double minTimestamp,
+                                   std::function<bool(TItem const & item)> const & fn)
+{
+  // Timestamps are not guaranteed to be monotonic, so blocks are checked from the end
+  // until the first block which is older than |minTimestamp|.
+  size_t firstBlock = m_blocks.size();
+  while (firstBlock > 0 && m_blocks[firstBlock - 1].m_maxTimestamp >= minTimestamp)
+    --firstBlock;
+
+  size_t firstItemIndex = 0;
+  for (size_t i = 0; i < firstBlock; ++i)
+    firstItemIndex += m_blocks[i].m_itemCount;
+
+  ForEachImpl(max(firstItemIndex, GetFirstItemIndex()), minTimestamp, fn);
+}
+
+double GpsTrackStorage::GetMaxTimestamp() const
+{
+  return m_blocks.empty() ? 0.0 : m_blocks.back().m_maxTimestamp;
+}
+
+void GpsTrackStorage::CreateFile()
+{
+  m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
+
+  if (!m_stream)
+    MYTHROW(OpenException, ("Open file error.", m_filePath));
+
+  if (!WriteVersion(m_stream, kCurrentVersion))
+    MYTHROW(OpenException, ("Write version error.", m_filePath));
+
+  m_itemCount = 0;
+  m_blocks.clear();
+  m_lastBlockItems.clear();
+}
+
+void GpsTrackStorage::LoadBlocks()
+{
+  uint64_t fileSize = 0;
+  uint64_t validSize = kHeaderSize;
+  try
+  {
+    MmapReader reader(m_filePath);
+    uint8_t const * data = reader.Data();
+    fileSize = reader.Size();
+
+    // Only block headers are read here. A block which is not completely written is dropped.
+    while (validSize + kBlockHeaderSize <= fileSize)
+    {
+      uint8_t const * p = data + validSize;
+      Block block;
+      block.m_offset = validSize;
+      block.m_payloadSize = MemRead<uint32_t>(p);
+      block.m_itemCount = MemRead<uint32_t>(p + sizeof(uint32_t));
+      block.m_minTimestamp = MemRead<double>(p + 2 * sizeof(uint32_t));
+      block.m_maxTimestamp = MemRead<double>(p + 2 * sizeof(uint32_t) + sizeof(double));
+
+      if (block.m_itemCount == 0 || block.m_itemCount > kBlockItemCount ||
+          validSize + kBlockHeaderSize + block.m_payloadSize > fileSize)
+      {
+        break;
+      }
+
+      m_blocks.push_back(block);
+      m_itemCount += block.m_itemCount;
+      validSize += kBlockHeaderSize + block.m_payloadSize;
+    }
+
+    if (!m_blocks.empty() && m_blocks.back().m_itemCount < kBlockItemCount)
+    {
+      Block const & block = m_blocks.back();
+      Decode(data + block.m_offset + kBlockHeaderSize, block.m_payloadSize, block.m_itemCount,
+             [this](TItem const & item)
+      {
+        m_lastBlockItems.push_back(item);
+        return true;
+      });
+    }
+  }
+  catch (RootException const & e)
+  {
+    MYTHROW(OpenException, ("Read blocks error.", m_filePath, e.Msg()));
+  }
+
+  if (validSize < fileSize)
+  {
+    LOG(LWARNING, ("Broken tail of", m_filePath, "is dropped, size:", fileSize - validSize));
+    try
+    {
+      base::FileData(m_filePath, base::FileData::OP_WRITE_EXISTING).Truncate(validSize);
+    }
+    catch (RootException const & e)
+    {
+      MYTHROW(OpenException, ("Truncate error.", m_filePath, e.Msg()));
+    }
+  }
 
-  size_t i = GetFirstItemIndex();
+  m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::ate);
+  if (!m_stream)
+    MYTHROW(OpenException, ("Open file error.", m_filePath));
+
+  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(GetEndOffset()), ());
+}
 
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
+vector<GpsTrackStorage::TItem> GpsTrackStorage::ReadVersion1Items()
+{
+  m_stream.seekg(0, ios::end);
   if (!m_stream.good())
-    MYTHROW(ReadException, ("File:", m_filePath));
+    MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
+
+  size_t const fileSize = m_stream.tellg();
+  size_t const itemCount = (fileSize - kHeaderSize) / kVersion1PointSize;
+  size_t i = (itemCount > m_maxItemCount) ? (itemCount - m_maxItemCount) : 0;
+
+  m_stream.seekg(kHeaderSize + i * kVersion1PointSize, ios::beg);
+  if (!m_stream.good())
+    MYTHROW(OpenException, ("Seek to the first item error.", m_filePath));
 
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  vector<TItem> items;
+  items.reserve(itemCount - i);
+
+  vector<char> buff(min(kItemBlockSize, itemCount) * kVersion1PointSize);
+  for (; i < itemCount;)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
+    size_t const n = min(itemCount - i, kItemBlockSize);
 
-    m_stream.read(&buff[0], n * kPointSize);
+    m_stream.read(&buff[0], n * kVersion1PointSize);
     if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
+      MYTHROW(OpenException, ("Read error.", m_filePath));
 
     for (size_t j = 0; j < n; ++j)
-    {      
+    {
       TItem item;
-      Unpack(&buff[0] + j * kPointSize, item);
-      if (!fn(item))
-        return;
+      UnpackVersion1(&buff[0] + j * kVersion1PointSize, item);
+      items.push_back(item);
     }
 
     i += n;
   }
+  return items;
+}
+
+void GpsTrackStorage::WriteBlock(vector<TItem> const & items, Block & block)
+{
+  ASSERT(!items.empty(), ());
+  ASSERT_LESS_OR_EQUAL(items.size(), kBlockItemCount, ());
+
+  vector<uint8_t> buff(kBlockHeaderSize);
+  Encode(items, buff);
+
+  block.m_payloadSize = static_cast<uint32_t>(buff.size() - kBlockHeaderSize);
+  block.m_itemCount = static_cast<uint32_t>(items.size());
+  block.m_minTimestamp = items.front().m_timestamp;
+  block.m_maxTimestamp = items.front().m_timestamp;
+  for (auto const & item : items)
+  {
+    block.m_minTimestamp = min(block.m_minTimestamp, item.m_timestamp);
+    block.m_maxTimestamp = max(block.m_maxTimestamp, item.m_timestamp);
+  }
+
+  uint8_t * p = buff.data();
+  MemWrite<uint32_t>(p, block.m_payloadSize);
+  MemWrite<uint32_t>(p + sizeof(uint32_t), block.m_itemCount);
+  MemWrite<double>(p + 2 * sizeof(uint32_t), block.m_minTimestamp);
+  MemWrite<double>(p + 2 * sizeof(uint32_t) + sizeof(double), block.m_maxTimestamp);
+
+  m_stream.seekp(block.m_offset, ios::beg);
+  m_stream.write(reinterpret_cast<char const *>(buff.data()), buff.size());
+  if (!m_stream.good())
+    MYTHROW(WriteException, ("File:", m_filePath));
+}
+
+void GpsTrackStorage::ForEachImpl(size_t firstItemIndex, double minTimestamp,
+                                  std::function<bool(TItem const & item)> const & fn)
+{
+  ASSERT(m_stream.is_open(), ());
+
+  if (firstItemIndex >= m_itemCount)
+    return;
+
+  try
+  {
+    MmapReader reader(m_filePath);
+    uint8_t const * data = reader.Data();
+    if (GetEndOffset() > reader.Size())
+      MYTHROW(ReadException, ("File is shorter than expected:", m_filePath));
+
+    size_t index = 0;
+    for (auto const & block : m_blocks)
+    {
+      if (index + block.m_itemCount <= firstItemIndex)
+      {
+        index += block.m_itemCount;
+        continue;
+      }
+
+      bool const proceed = Decode(data + block.m_offset + kBlockHeaderSize, block.m_payloadSize,
+                                  block.m_itemCount, [&](TItem const & item)
+      {
+        if (index++ < firstItemIndex || item.m_timestamp < minTimestamp)
+          return true;
+        return fn(item);
+      });
+      if (!proceed)
+        return;
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    MYTHROW(ReadException, ("File:", m_filePath, e.Msg()));
+  }
 }
 
 void GpsTrackStorage::TruncFile()
@@ -262,31 +524,41 @@ void GpsTrackStorage::TruncFile()
   if (!WriteVersion(tmp, kCurrentVersion))
     MYTHROW(WriteException, ("File:", tmpFilePath));
 
-  size_t i = GetFirstItemIndex();
+  // Find the block of the first item, blocks from it are copied as is
+  size_t const firstItemIndex = GetFirstItemIndex();
+  size_t firstBlock = 0;
+  size_t removedItemCount = 0;
+  while (firstBlock < m_blocks.size() &&
+         removedItemCount + m_blocks[firstBlock].m_itemCount <= firstItemIndex)
+  {
+    removedItemCount += m_blocks[firstBlock].m_itemCount;
+    ++firstBlock;
+  }
 
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
+  uint64_t const beginOffset =
+      firstBlock < m_blocks.size() ? m_blocks[firstBlock].m_offset : GetEndOffset();
+  uint64_t const endOffset = GetEndOffset();
+
+  // Set read position to the first block
+  m_stream.seekg(beginOffset, ios::beg);
   if (!m_stream.good())
     MYTHROW(ReadException, ("File:", m_filePath));
 
-  size_t newItemCount = 0;
-
-  // Copy items
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  // Copy blocks
+  vector<char> buff(min<uint64_t>(kCopyBufferSize, endOffset - beginOffset));
+  for (uint64_t offset = beginOffset; offset < endOffset;)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
+    size_t const n = static_cast<size_t>(min<uint64_t>(endOffset - offset, buff.size()));
 
-    m_stream.read(&buff[0], n * kPointSize);
+    m_stream.read(&buff[0], n);
     if (!m_stream.good())
       MYTHROW(ReadException, ("File:", m_filePath));
 
-    tmp.write(&buff[0], n * kPointSize);
+    tmp.write(&buff[0], n);
     if (!tmp.good())
       MYTHROW(WriteException, ("File:", tmpFilePath));
 
-    i += n;
-    newItemCount += n;
+    offset += n;
   }
   buff.clear();
   buff.shrink_to_fit();
@@ -307,14 +579,26 @@ void GpsTrackStorage::TruncFile()
   if (!m_stream)
     MYTHROW(WriteException, ("File:", m_filePath));
 
-  m_itemCount = newItemCount;
+  m_blocks.erase(m_blocks.begin(), m_blocks.begin() + firstBlock);
+  for (auto & block : m_blocks)
+    block.m_offset -= beginOffset - kHeaderSize;
+  m_itemCount -= removedItemCount;
+  if (m_blocks.empty())
+    m_lastBlockItems.clear();
 
-  // Write position must be after last item position (end of file)
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(m_itemCount)), ());
+  // Write position must be after last block (end of file)
+  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(GetEndOffset()), ());
 }
 
 size_t GpsTrackStorage::GetFirstItemIndex() const
 {
   return (m_itemCount > m_maxItemCount) ? (m_itemCount - m_maxItemCount) : 0; // see NOTE in declaration
 }
+
+uint64_t GpsTrackStorage::GetEndOffset() const
+{
+  if (m_blocks.empty())
+    return kHeaderSize;
+  Block const & block = m_blocks.back();
+  return block.m_offset + kBlockHeaderSize + block.m_payloadSize;
+}
@@ -9,6 +9,7 @@
 #include "std/function.hpp"
 #include "std/limits.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 class GpsTrackStorage final
 {
@@ -39,16 +40,45 @@ public:
   /// @exceptions ReadException if read fails.
   void ForEach(std::function<bool(TItem const & item)> const & fn);
 
+  /// Same as ForEach, but only for items with timestamp not less than |minTimestamp|.
+  /// Blocks of older items are skipped by the index without being read.
+  /// @exceptions ReadException if read fails.
+  void ForEachSince(double minTimestamp, std::function<bool(TItem const & item)> const & fn);
+
+  /// Returns the max timestamp of the items in the last block or 0 if the storage is empty.
+  double GetMaxTimestamp() const;
+
 private:
   DISALLOW_COPY_AND_MOVE(GpsTrackStorage);
 
+  // Items are stored in delta-coded blocks, the index of blocks is kept in memory.
+  struct Block
+  {
+    uint64_t m_offset = 0;
+    uint32_t m_payloadSize = 0;
+    uint32_t m_itemCount = 0;
+    double m_minTimestamp = 0.0;
+    double m_maxTimestamp = 0.0;
+  };
+
+  void CreateFile();
+  void LoadBlocks();
+  vector<TItem> ReadVersion1Items();
+  void WriteBlock(vector<TItem> const & items, Block & block);
+  void ForEachImpl(size_t firstItemIndex, double minTimestamp,
+                   std::function<bool(TItem const & item)> const & fn);
   void TruncFile();
   size_t GetFirstItemIndex() const;
+  uint64_t GetEndOffset() const;
 
   string const m_filePath;
   size_t const m_maxItemCount;
   fstream m_stream;
   size_t m_itemCount; // current number of items in file, read note
+  vector<Block> m_blocks;
+  // Items of the last block if it is not full. New items are added to this block, and the
+  // block is rewritten in place, other blocks are never changed.
+  vector<TItem> m_lastBlockItems;
 
   // NOTE
   // New items append to the end of file, when file become too big, it is truncated.
@@ -61,4 +91,5 @@ private:
   // exceed 2 x m_maxItemCount, then second half of file - m_maxItemCount items is copying to the tmp file,
   // which replaces origin file. That means that trunc will happens only then new m_maxItemCount items will be
   // added but not every time.
+  // Blocks are copied as is, so up to a block of items before the second half is copied too.
 };
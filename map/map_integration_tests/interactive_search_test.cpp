@@ -180,5 +180,45 @@ UNIT_CLASS_TEST(InteractiveSearchTest, NearbyFeaturesInViewport)
          ());
   }
 }
+
+UNIT_CLASS_TEST(InteractiveSearchTest, IncrementalViewportSearch)
+{
+  TestCafe cafe1(m2::PointD(0.0, 0.0));
+  TestCafe cafe2(m2::PointD(0.3, 0.0));
+  TestCafe cafe3(m2::PointD(0.6, 0.0));
+  TestCafe cafe4(m2::PointD(0.9, 0.0));
+
+  auto const id = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(cafe1);
+    builder.Add(cafe2);
+    builder.Add(cafe3);
+    builder.Add(cafe4);
+  });
+
+  SearchParams params;
+  params.m_query = "cafe ";
+  params.m_inputLocale = "en";
+  params.m_mode = Mode::Viewport;
+  params.m_suggestsEnabled = false;
+  params.m_incremental = true;
+
+  auto const search = [&](m2::RectD const & viewport, TRules const & rules) {
+    params.m_viewport = viewport;
+    TestSearchRequest request(m_engine, params);
+    request.Run();
+    TEST(MatchResults(m_dataSource, rules, request.Results()), (viewport));
+  };
+
+  // Panning to the right and back. The viewports overlap, so the results of the previous
+  // viewport may be reused.
+  search(m2::RectD(-0.1, -0.5, 0.5, 0.5), {ExactMatch(id, cafe1), ExactMatch(id, cafe2)});
+  search(m2::RectD(0.2, -0.5, 0.8, 0.5), {ExactMatch(id, cafe2), ExactMatch(id, cafe3)});
+  search(m2::RectD(0.4, -0.5, 1.0, 0.5), {ExactMatch(id, cafe3), ExactMatch(id, cafe4)});
+  search(m2::RectD(0.2, -0.5, 0.8, 0.5), {ExactMatch(id, cafe2), ExactMatch(id, cafe3)});
+  search(m2::RectD(0.25, -0.5, 0.85, 0.5), {ExactMatch(id, cafe2), ExactMatch(id, cafe3)});
+
+  // The same viewport without changes.
+  search(m2::RectD(0.25, -0.5, 0.85, 0.5), {ExactMatch(id, cafe2), ExactMatch(id, cafe3)});
+}
 }  // namespace
 }  // namespace search
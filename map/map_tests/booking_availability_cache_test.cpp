@@ -4,6 +4,8 @@
 
 #include <chrono>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace booking::filter::availability;
 using namespace std::chrono;
@@ -52,4 +54,23 @@ UNIT_TEST(AvailabilityCache_RemoveExtra)
 
   TEST_EQUAL(cache.Get("4"), Cache::HotelStatus::Available, ());
 }
+
+UNIT_TEST(AvailabilityCache_RemoveOutdated)
+{
+  Cache cache(0 /* maxCount */, 1 /* expiryPeriodSeconds */);
+
+  cache.Insert("1", Cache::HotelStatus::Available);
+  cache.Reserve("2");
+  cache.Insert("2", Cache::HotelStatus::Unavailable);
+
+  std::this_thread::sleep_for(milliseconds(1100));
+
+  cache.Insert("2", Cache::HotelStatus::Available);
+  cache.Reserve("3");
+  cache.RemoveOutdated();
+
+  TEST_EQUAL(cache.Get("1"), Cache::HotelStatus::Absent, ());
+  TEST_EQUAL(cache.Get("2"), Cache::HotelStatus::Available, ());
+  TEST_EQUAL(cache.Get("3"), Cache::HotelStatus::NotReady, ());
+}
 }  // namespace
@@ -206,6 +206,28 @@ UNIT_CLASS_TEST(Runner, Bookmarks_ImportKML)
   TEST_EQUAL(bmManager.IsVisible(groupId), false, ());
 }
 
+UNIT_CLASS_TEST(Runner, Bookmarks_LazyImportKML)
+{
+  User user;
+  BookmarkManager bmManager(user, (BookmarkManager::Callbacks(bmCallbacks)));
+  bmManager.EnableTestMode(true);
+
+  BookmarkManager::KMLDataCollection kmlDataCollection;
+
+  kmlDataCollection.emplace_back(""/* filePath */,
+                                 LoadKmlData(MemReader(kmlString, strlen(kmlString)), KmlFileType::Text));
+  TEST(kmlDataCollection.back().second, ());
+  bmManager.CreateCategories(std::move(kmlDataCollection), false /* autoSave */, true /* lazy */);
+  TEST_EQUAL(bmManager.GetBmGroupsIdList().size(), 1, ());
+
+  // The category is hidden, its bookmarks are created on the first access.
+  auto const groupId = bmManager.GetBmGroupsIdList().front();
+  TEST_EQUAL(bmManager.IsVisible(groupId), false, ());
+  TEST(!bmManager.IsCategoryEmpty(groupId), ());
+  CheckBookmarks(bmManager, groupId);
+  TEST_EQUAL(bmManager.GetCategoryName(groupId), "MapName", ());
+}
+
 UNIT_CLASS_TEST(Runner, Bookmarks_ExportKML)
 {
   string const dir = BookmarkManager::GetActualBookmarksDirectory();
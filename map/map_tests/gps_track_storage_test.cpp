@@ -6,13 +6,16 @@
 
 #include "coding/file_name_utils.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
 
 #include "geometry/latlon.hpp"
 
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/chrono.hpp"
+#include "std/cmath.hpp"
 
 namespace
 {
@@ -184,3 +187,52 @@ UNIT_TEST(GpsTrackStorage_WriteReadWithTrunc)
     TEST_EQUAL(i, 0, ());
   }
 }
+
+UNIT_TEST(GpsTrackStorage_ForEachSince)
+{
+  double const timestamp = 1500000000;
+
+  string const filePath = GetGpsTrackFilePath();
+  SCOPE_GUARD(gpsTestFileDeleter, bind(FileWriter::DeleteFileX, filePath));
+  FileWriter::DeleteFileX(filePath);
+
+  size_t const fileMaxItemCount = 10000;
+  size_t const pointsCount = 1000;
+
+  vector<location::GpsInfo> points;
+  points.reserve(pointsCount);
+  for (size_t i = 0; i < pointsCount; ++i)
+    points.emplace_back(Make(timestamp + i * 0.5, ms::LatLon(55.75 + i * 1e-5, 37.61 - i * 1e-5), 1.25));
+
+  // Write points by small portions, the last block is not full when the storage is reopened.
+  size_t const portionSize = 7;
+  for (size_t i = 0; i < pointsCount; i += portionSize)
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    size_t const n = min(portionSize, pointsCount - i);
+    stg.Append(vector<location::GpsInfo>(points.begin() + i, points.begin() + i + n));
+  }
+
+  GpsTrackStorage stg(filePath, fileMaxItemCount);
+  TEST_EQUAL(stg.GetMaxTimestamp(), points.back().m_timestamp, ());
+
+  size_t const firstIndex = 700;
+  size_t i = firstIndex;
+  stg.ForEachSince(points[firstIndex].m_timestamp, [&](location::GpsInfo const & point)->bool
+  {
+    TEST_LESS(i, pointsCount, ());
+    TEST_EQUAL(point.m_timestamp, points[i].m_timestamp, ());
+    TEST_LESS(fabs(point.m_latitude - points[i].m_latitude), 1e-7, ());
+    TEST_LESS(fabs(point.m_longitude - points[i].m_longitude), 1e-7, ());
+    TEST_EQUAL(point.m_speedMpS, points[i].m_speedMpS, ());
+    TEST_EQUAL(static_cast<int>(point.m_source), static_cast<int>(points[i].m_source), ());
+    ++i;
+    return true;
+  });
+  TEST_EQUAL(i, pointsCount, ());
+
+  // Compressed items take much less space than plain values.
+  uint64_t fileSize = 0;
+  TEST(base::GetFileSize(filePath, fileSize), ());
+  TEST_LESS(fileSize, pointsCount * 8 * sizeof(double) / 3, ());
+}
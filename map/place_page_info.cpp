@@ -49,11 +49,31 @@ bool Info::ShouldShowUGC() const
 void Info::SetFromFeatureType(FeatureType & ft)
 {
   MapObject::SetFromFeatureType(ft);
+  m_sortedTypes = m_types;
+  m_sortedTypes.SortBySpec();
+  FillUiStrings();
+
+  m_hotelType = ftypes::IsHotelChecker::Instance().GetHotelType(ft);
+}
+
+void Info::SetPendingAddress(m2::PointD const & addressPoint)
+{
+  m_isAddressPending = true;
+  m_pendingAddressPoint = addressPoint;
+}
+
+void Info::UpdateAddress(std::string const & address)
+{
+  m_isAddressPending = false;
+  m_address = address;
+  FillUiStrings();
+}
+
+void Info::FillUiStrings()
+{
   std::string primaryName;
   std::string secondaryName;
   GetPrefferedNames(primaryName, secondaryName);
-  m_sortedTypes = m_types;
-  m_sortedTypes.SortBySpec();
   if (IsBookmark())
   {
     m_uiTitle = GetBookmarkName();
@@ -84,8 +104,6 @@ void Info::SetFromFeatureType(FeatureType & ft)
     m_uiSubtitle = FormatSubtitle(false /* withType */);
     m_uiAddress = m_address;
   }
-
-  m_hotelType = ftypes::IsHotelChecker::Instance().GetHotelType(ft);
 }
 
 string Info::FormatSubtitle(bool withType) const
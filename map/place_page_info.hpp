@@ -117,6 +117,12 @@ public:
   void SetCustomName(std::string const & name);
   void SetCustomNameWithCoordinates(m2::PointD const & mercator, std::string const & name);
   void SetAddress(std::string const & address) { m_address = address; }
+  /// The address is looked up at |addressPoint| after the place page is shown.
+  void SetPendingAddress(m2::PointD const & addressPoint);
+  /// Sets the looked up address and updates UI strings which depend on it.
+  void UpdateAddress(std::string const & address);
+  bool IsAddressPending() const { return m_isAddressPending; }
+  m2::PointD const & GetPendingAddressPoint() const { return m_pendingAddressPoint; }
   void SetIsMyPosition() { m_isMyPosition = true; }
   void SetCanEditOrAdd(bool canEditOrAdd) { m_canEditOrAdd = canEditOrAdd; }
   void SetLocalizedWifiString(std::string const & str) { m_localizedWifiString = str; }
@@ -227,6 +233,7 @@ private:
   /// @returns empty string or GetStars() count of ★ symbol.
   std::string FormatStars() const;
   void SetTitlesForBookmark();
+  void FillUiStrings();
 
   /// UI
   std::string m_uiTitle;
@@ -262,6 +269,8 @@ private:
   std::string m_apiUrl;
   /// Formatted feature address for inner using.
   std::string m_address;
+  bool m_isAddressPending = false;
+  m2::PointD m_pendingAddressPoint;
 
   /// Routing
   RouteMarkType m_routeMarkType;
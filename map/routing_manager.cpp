@@ -38,6 +38,7 @@
 #include "3party/Alohalytics/src/alohalytics.h"
 #include "3party/jansson/myjansson.hpp"
 
+#include <algorithm>
 #include <iomanip>
 #include <ios>
 #include <map>
@@ -442,8 +443,8 @@ void RoutingManager::RemoveRoute(bool deactivateFollowing)
     if (lock)
     {
       lock_guard<mutex> lockSubroutes(m_drapeSubroutesMutex);
-      for (auto const & subrouteId : m_drapeSubroutes)
-        lock.Get()->RemoveSubroute(subrouteId, false /* deactivateFollowing */);
+      for (auto const & subroute : m_drapeSubroutes)
+        lock.Get()->RemoveSubroute(subroute.first, false /* deactivateFollowing */);
     }
   }
 
@@ -459,7 +460,15 @@ void RoutingManager::InsertRoute(Route const & route)
   if (!m_drapeEngine)
     return;
 
-  // TODO: Now we always update whole route, so we need to remove previous one.
+  // Subroutes of the previous route with the same geometry keep their render data, e.g. the
+  // subroutes after the current one on rerouting. Transit subroutes are always recached
+  // together with transit marks.
+  vector<pair<dp::DrapeID, df::SubrouteConstPtr>> prevSubroutes;
+  if (m_currentRouterType != RouterType::Transit)
+  {
+    lock_guard<mutex> lock(m_drapeSubroutesMutex);
+    prevSubroutes.swap(m_drapeSubroutes);
+  }
   RemoveRoute(false /* deactivateFollowing */);
 
   shared_ptr<TransitRouteDisplay> transitRouteDisplay;
@@ -553,13 +562,37 @@ void RoutingManager::InsertRoute(Route const & route)
       default: ASSERT(false, ("Unknown router type"));
     }
 
-    auto const subrouteId = m_drapeEngine.SafeCallWithResult(&df::DrapeEngine::AddSubroute,
-                                                             df::SubrouteConstPtr(subroute.release()));
+    df::SubrouteConstPtr subroutePtr(subroute.release());
+    auto const prevIt = find_if(prevSubroutes.begin(), prevSubroutes.end(),
+                                [&subroutePtr](pair<dp::DrapeID, df::SubrouteConstPtr> const & s)
+    {
+      return s.second->HasEqualGeometry(*subroutePtr);
+    });
+
+    dp::DrapeID subrouteId;
+    if (prevIt != prevSubroutes.end())
+    {
+      subrouteId = prevIt->first;
+      prevSubroutes.erase(prevIt);
+      m_drapeEngine.SafeCall(&df::DrapeEngine::UpdateSubroute, subrouteId, subroutePtr);
+    }
+    else
+    {
+      subrouteId = m_drapeEngine.SafeCallWithResult(&df::DrapeEngine::AddSubroute, subroutePtr);
+    }
 
     // TODO: we will send subrouteId to routing subsystem when we can partly update route.
     //route.SetSubrouteUid(subrouteIndex, static_cast<SubrouteUid>(subrouteId));
     lock_guard<mutex> lock(m_drapeSubroutesMutex);
-    m_drapeSubroutes.push_back(subrouteId);
+    m_drapeSubroutes.emplace_back(subrouteId, move(subroutePtr));
+  }
+
+  // Subroutes of the previous route are removed after the new ones are added, so the route
+  // does not disappear from the screen until the new subroutes are cached.
+  for (auto const & subroute : prevSubroutes)
+  {
+    m_drapeEngine.SafeCall(&df::DrapeEngine::RemoveSubroute, subroute.first,
+                           false /* deactivateFollowing */);
   }
 
   {
@@ -1346,6 +1379,6 @@ void RoutingManager::SetSubroutesVisibility(bool visible)
     return;
 
   lock_guard<mutex> lockSubroutes(m_drapeSubroutesMutex);
-  for (auto const & subrouteId : m_drapeSubroutes)
-    lock.Get()->SetSubrouteVisibility(subrouteId, visible);
+  for (auto const & subroute : m_drapeSubroutes)
+    lock.Get()->SetSubrouteVisibility(subroute.first, visible);
 }
@@ -303,7 +303,7 @@ private:
   BookmarkManager * m_bmManager = nullptr;
   extrapolation::Extrapolator m_extrapolator;
 
-  std::vector<dp::DrapeID> m_drapeSubroutes;
+  std::vector<std::pair<dp::DrapeID, df::SubrouteConstPtr>> m_drapeSubroutes;
   mutable std::mutex m_drapeSubroutesMutex;
 
   std::unique_ptr<location::GpsInfo> m_gpsInfoCache;
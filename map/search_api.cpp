@@ -200,6 +200,7 @@ bool SearchAPI::SearchInViewport(ViewportSearchParams const & params)
   p.m_suggestsEnabled = false;
   p.m_needAddress = false;
   p.m_needHighlighting = false;
+  p.m_incremental = true;
   p.m_hotelsFilter = params.m_hotelsFilter;
 
   p.m_onStarted = [this, params] {
@@ -128,6 +128,7 @@ void TrafficManager::Clear()
   m_activeRoutingMwms.clear();
   m_requestedMwms.clear();
   m_trafficETags.clear();
+  m_trafficValues.clear();
 }
 
 void TrafficManager::SetDrapeEngine(ref_ptr<df::DrapeEngine> engine)
@@ -252,13 +253,20 @@ void TrafficManager::ThreadRoutine()
       traffic::TrafficInfo info(mwm, m_currentDataVersion);
 
       string tag;
+      traffic::TrafficInfo::PackedValues lastValues;
       {
         lock_guard<mutex> lock(m_mutex);
         tag = m_trafficETags[mwm];
+        lastValues = m_trafficValues[mwm];
       }
 
-      if (info.ReceiveTrafficData(tag))
+      if (info.ReceiveTrafficData(tag, lastValues))
       {
+        if (!info.GetValues().IsEmpty())
+        {
+          lock_guard<mutex> lock(m_mutex);
+          m_trafficValues[mwm] = info.GetValues();
+        }
         OnTrafficDataResponse(move(info));
       }
       else
@@ -457,6 +465,7 @@ void TrafficManager::ClearCache(MwmSet::MwmId const & mwmId)
   }
   m_mwmCache.erase(it);
   m_trafficETags.erase(mwmId);
+  m_trafficValues.erase(mwmId);
   m_activeDrapeMwms.erase(mwmId);
   m_activeRoutingMwms.erase(mwmId);
   m_lastDrapeMwmsByRect.clear();
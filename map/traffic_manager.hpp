@@ -175,6 +175,8 @@ private:
   // It is one of several mechanisms that HTTP provides for web cache validation,
   // which allows a client to make conditional requests.
   map<MwmSet::MwmId, string> m_trafficETags;
+  // Values received with the ETags, the server may send only the changed values against them.
+  map<MwmSet::MwmId, traffic::TrafficInfo::PackedValues> m_trafficValues;
 
   atomic<bool> m_isPaused;
 
@@ -1,11 +1,15 @@
 #include "map/transit/transit_reader.hpp"
 
+#include "transit/transit_display_section.hpp"
 #include "transit/transit_graph_data.hpp"
 
 #include "indexer/data_source.hpp"
 #include "indexer/drawing_rules.hpp"
 #include "indexer/drules_include.hpp"
 #include "indexer/feature_algo.hpp"
+#include "indexer/feature_utils.hpp"
+
+#include "platform/preferred_languages.hpp"
 
 #include "metrics/eye.hpp"
 
@@ -99,9 +103,35 @@ void ReadTransitTask::Do()
   FillItemsByIdMap(graphData.GetLines(), m_transitInfo->m_lines);
   FillItemsByIdMap(graphData.GetShapes(), m_transitInfo->m_shapes);
 
+  unique_ptr<transit::DisplaySection> displaySection;
+  if (mwmValue.m_cont.IsExist(TRANSIT_DISPLAY_FILE_TAG))
+  {
+    auto displayReader = mwmValue.m_cont.GetReader(TRANSIT_DISPLAY_FILE_TAG);
+    CHECK(displayReader.GetPtr() != nullptr, ());
+    displaySection = make_unique<transit::DisplaySection>(*displayReader.GetPtr());
+  }
+
+  // Features of stops are taken from the display section if it's possible.
+  // Only gates and features which are absent in the section are read from mwm.
+  auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
+  transit::DisplayFeature displayFeature;
   vector<FeatureID> features;
   for (auto & id : m_transitInfo->m_features)
+  {
+    auto & featureInfo = id.second;
+    if (displaySection && !featureInfo.m_isGate &&
+        displaySection->Find(id.first.m_index, displayFeature))
+    {
+      if (!displayFeature.m_names.IsEmpty())
+      {
+        feature::GetReadableName(mwmValue.GetRegionData(), displayFeature.m_names, deviceLang,
+                                 false /* allowTranslit */, featureInfo.m_title);
+      }
+      featureInfo.m_point = displayFeature.m_point;
+      continue;
+    }
     features.push_back(id.first);
+  }
   sort(features.begin(), features.end());
 
   m_readFeaturesFn([this](FeatureType & ft)
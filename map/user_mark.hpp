@@ -77,6 +77,7 @@ public:
   int GetMinTitleZoom() const override { return GetMinZoom(); }
   FeatureID GetFeatureID() const override { return FeatureID(); }
   bool HasCreationAnimation() const override { return false; }
+  bool IsClusterable() const override { return false; }
   df::ColorConstant GetColorConstant() const override { return {}; }
 
   ms::LatLon GetLatLon() const;
@@ -9,12 +9,18 @@
 #include "geometry/mercator.hpp"
 
 #include "base/string_utils.hpp"
+#include "base/thread.hpp"
+#include "base/timer.hpp"
 
+#include "std/condition_variable.hpp"
+#include "std/deque.hpp"
 #include "std/exception.hpp"
 #include "std/fstream.hpp"
 #include "std/iomanip.hpp"
 #include "std/iostream.hpp"
+#include "std/mutex.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
 
@@ -27,6 +33,8 @@ DEFINE_string(datapath, "", "Path to data directory");
 DEFINE_string(mwmpath, "", "Path to mwm files");
 DEFINE_int32(width, 480, "Resulting image width");
 DEFINE_int32(height, 640, "Resulting image height");
+DEFINE_int32(threads, 1, "Number of threads which render images in parallel");
+DEFINE_int32(render_threads, 1, "Number of threads which rasterize every image");
 //----------------------------------------------------------------------------------------
 
 namespace
@@ -66,28 +74,14 @@ string FilenameSeq(string const & path)
   return filename.str();
 }
 
-unique_ptr<software_renderer::CPUDrawer> cpuDrawer;
-
-bool IsFrameRendererInitialized()
-{
-  return cpuDrawer != nullptr;
-}
-
-void InitFrameRenderer(float visualScale)
+unique_ptr<software_renderer::CPUDrawer> CreateFrameRenderer(float visualScale)
 {
   using namespace software_renderer;
 
-  if (cpuDrawer == nullptr)
-  {
-    string resPostfix = df::VisualParams::GetResourcePostfix(visualScale);
-    cpuDrawer = make_unique_dp<CPUDrawer>(CPUDrawer::Params(resPostfix, visualScale));
-  }
-}
-
-void ReleaseFrameRenderer()
-{
-  if (IsFrameRendererInitialized())
-    cpuDrawer.reset();
+  string resPostfix = df::VisualParams::GetResourcePostfix(visualScale);
+  CPUDrawer::Params params(resPostfix, visualScale);
+  params.m_threadsCount = static_cast<size_t>(max(FLAGS_render_threads, 1));
+  return make_unique<CPUDrawer>(params);
 }
 
 /// @param center - map center in Mercator
@@ -101,51 +95,50 @@ void ReleaseFrameRenderer()
 ///                   It must be equal render buffer height. For retina it's equal 2.0 * displayHeight
 /// @param symbols - configuration for symbols on the frame
 /// @param image [out] - result image
-void DrawFrame(Framework & framework,
+void DrawFrame(Framework & framework, software_renderer::CPUDrawer & cpuDrawer,
                m2::PointD const & center, int zoomModifier,
                uint32_t pxWidth, uint32_t pxHeight,
                software_renderer::FrameSymbols const & symbols,
                software_renderer::FrameImage & image)
 {
-  ASSERT(IsFrameRendererInitialized(), ());
-
   int resultZoom = -1;
-  ScreenBase screen = cpuDrawer->CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
+  ScreenBase screen = cpuDrawer.CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
   ASSERT_GREATER(resultZoom, 0, ());
 
   uint32_t const bgColor = drule::rules().GetBgColor(resultZoom);
-  cpuDrawer->BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
+  cpuDrawer.BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
 
   m2::RectD renderRect = m2::RectD(0, 0, pxWidth, pxHeight);
   m2::RectD selectRect;
   m2::RectD clipRect;
-  double const inflationSize = 24 * cpuDrawer->GetVisualScale();
+  double const inflationSize = 24 * cpuDrawer.GetVisualScale();
   screen.PtoG(m2::Inflate(renderRect, inflationSize, inflationSize), clipRect);
   screen.PtoG(renderRect, selectRect);
 
   uint32_t const tileSize = static_cast<uint32_t>(df::CalculateTileSize(pxWidth, pxHeight));
-  int const drawScale = df::GetDrawTileScale(screen, tileSize, cpuDrawer->GetVisualScale());
-  software_renderer::FeatureProcessor doDraw(make_ref(cpuDrawer), clipRect, screen, drawScale);
+  int const drawScale = df::GetDrawTileScale(screen, tileSize, cpuDrawer.GetVisualScale());
+  software_renderer::FeatureProcessor doDraw(make_ref(&cpuDrawer), clipRect, screen, drawScale);
 
   int const upperScale = scales::GetUpperScale();
 
-  framework.GetIndex().ForEachInRect([&doDraw](FeatureType & ft) { doDraw(ft); }, selectRect, min(upperScale, drawScale));
+  framework.GetDataSource().ForEachInRect([&doDraw](FeatureType & ft) { doDraw(ft); }, selectRect, min(upperScale, drawScale));
 
-  cpuDrawer->Flush();
-  //cpuDrawer->DrawMyPosition(screen.GtoP(center));
+  cpuDrawer.Flush();
+  //cpuDrawer.DrawMyPosition(screen.GtoP(center));
 
   if (symbols.m_showSearchResult)
   {
     if (!screen.PixelRect().IsPointInside(screen.GtoP(symbols.m_searchResult)))
-      cpuDrawer->DrawSearchArrow(ang::AngleTo(center, symbols.m_searchResult));
+      cpuDrawer.DrawSearchArrow(ang::AngleTo(center, symbols.m_searchResult));
     else
-      cpuDrawer->DrawSearchResult(screen.GtoP(symbols.m_searchResult));
+      cpuDrawer.DrawSearchResult(screen.GtoP(symbols.m_searchResult));
   }
 
-  cpuDrawer->EndFrame(image);
+  cpuDrawer.EndFrame(image);
 }
 
-void RenderPlace(Framework & framework, Place const & place, string const & filename)
+void RenderPlace(Framework & framework, software_renderer::CPUDrawer & cpuDrawer,
+                 Place const & place, string const & filename)
 {
   software_renderer::FrameImage frame;
   software_renderer::FrameSymbols sym;
@@ -155,13 +148,106 @@ void RenderPlace(Framework & framework, Place const & place, string const & file
   // It is almost UpperComfortScale but there is some magic involved.
   int constexpr kMagicBaseScale = 17;
 
-  DrawFrame(framework, MercatorBounds::FromLatLon(place.lat, place.lon),
+  DrawFrame(framework, cpuDrawer, MercatorBounds::FromLatLon(place.lat, place.lon),
             place.zoom - kMagicBaseScale, place.width, place.height, sym, frame);
 
   ofstream file(filename.c_str());
   file.write(reinterpret_cast<char const *>(frame.m_data.data()), frame.m_data.size());
   file.close();
 }
+
+struct Job
+{
+  string m_source;
+  Place m_place;
+  string m_filename;
+};
+
+// Places are read on the main thread while worker threads render them. Each worker has its
+// own CPUDrawer because a drawer keeps the frame and the glyph cache. The data source and the
+// drawing rules are read-only while rendering and are shared by all the workers.
+class RenderQueue
+{
+public:
+  RenderQueue(Framework & framework, size_t threadsCount, float visualScale)
+    : m_framework(framework)
+  {
+    for (size_t i = 0; i < threadsCount; ++i)
+      m_drawers.push_back(CreateFrameRenderer(visualScale));
+    for (auto & drawer : m_drawers)
+      m_threads.emplace_back(&RenderQueue::Process, this, std::ref(*drawer));
+  }
+
+  ~RenderQueue() { Finish(); }
+
+  void Push(string const & place)
+  {
+    Job job;
+    job.m_source = place;
+    job.m_place = ParsePlace(place);
+    job.m_place.width = FLAGS_width;
+    job.m_place.height = FLAGS_height;
+    job.m_filename = FilenameSeq(FLAGS_outpath);
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_jobs.push_back(move(job));
+    }
+    m_cv.notify_one();
+  }
+
+  // Waits for all the pushed places to be rendered.
+  void Finish()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      if (m_finished)
+        return;
+      m_finished = true;
+    }
+    m_cv.notify_all();
+    for (auto & thread : m_threads)
+      thread.join();
+  }
+
+  size_t GetRenderedCount() const
+  {
+    lock_guard<mutex> lock(m_mutex);
+    return m_renderedCount;
+  }
+
+private:
+  void Process(software_renderer::CPUDrawer & cpuDrawer)
+  {
+    while (true)
+    {
+      Job job;
+      {
+        unique_lock<mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_finished || !m_jobs.empty(); });
+        if (m_jobs.empty())
+          return;
+        job = move(m_jobs.front());
+        m_jobs.pop_front();
+      }
+
+      RenderPlace(m_framework, cpuDrawer, job.m_place, job.m_filename);
+
+      lock_guard<mutex> lock(m_mutex);
+      ++m_renderedCount;
+      cout << "Rendering " << job.m_source << " into " << job.m_filename << " is finished." << endl;
+    }
+  }
+
+  Framework & m_framework;
+  vector<unique_ptr<software_renderer::CPUDrawer>> m_drawers;
+  vector<threads::SimpleThread> m_threads;
+
+  mutable mutex m_mutex;
+  condition_variable m_cv;
+  deque<Job> m_jobs;
+  bool m_finished = false;
+  size_t m_renderedCount = 0;
+};
 }  // namespace
 
 int main(int argc, char * argv[])
@@ -186,36 +272,35 @@ int main(int argc, char * argv[])
   {
     Framework f(FrameworkParams(false /* m_enableLocalAds */, false /* m_enableDiffs */));
 
-    auto processPlace = [&](string const & place)
-    {
-      Place p = ParsePlace(place);
-      p.width = FLAGS_width;
-      p.height = FLAGS_height;
-      string const & filename = FilenameSeq(FLAGS_outpath);
-      RenderPlace(f, p, filename);
-      cout << "Rendering " << place << " into " << filename << " is finished." << endl;
-    };
-
     // This magic constant was determined in several attempts.
     // It is a scale level, basically, dpi factor. 1 means 90 or 96, it seems,
     // and with 1.1 the map looks subjectively better.
-    InitFrameRenderer(1.1 /* visualScale */);
+    float constexpr kVisualScale = 1.1f;
+
+    base::Timer timer;
+    RenderQueue queue(f, static_cast<size_t>(max(FLAGS_threads, 1)), kVisualScale);
 
     if (!FLAGS_place.empty())
-      processPlace(FLAGS_place);
+      queue.Push(FLAGS_place);
 
     if (FLAGS_c)
     {
       for (string line; getline(cin, line);)
-        processPlace(line);
+        queue.Push(line);
     }
 
-    ReleaseFrameRenderer();
+    queue.Finish();
+
+    double const seconds = timer.ElapsedSeconds();
+    size_t const count = queue.GetRenderedCount();
+    cout << "Rendered " << count << " images in " << seconds << " s";
+    if (seconds > 0)
+      cout << ", " << count / seconds << " images/s";
+    cout << "." << endl;
     return 0;
   }
   catch (exception & e)
   {
-    ReleaseFrameRenderer();
     cerr << e.what() << endl;
   }
   return 1;
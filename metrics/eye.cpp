@@ -21,6 +21,8 @@ namespace
 {
 // Three months.
 auto constexpr kMapObjectEventsExpirePeriod = std::chrono::hours(24 * 30 * 3);
+// Changes made during the period are written to disk at once.
+auto constexpr kSaveDelay = std::chrono::seconds(10);
 
 void Load(Info & info)
 {
@@ -63,13 +65,6 @@ bool SaveMapObjects(MapObjects const & mapObjects)
   return Storage::SaveMapObjects(fileData);
 }
 
-bool SaveMapObjectEvent(MapObject const & mapObject, MapObject::Event const & event)
-{
-  std::vector<int8_t> eventData;
-  Serdes::SerializeMapObjectEvent(mapObject, event, eventData);
-
-  return Storage::AppendMapObjectEvent(eventData);
-}
 }  // namespace
 
 namespace eye
@@ -111,13 +106,45 @@ void Eye::TrimExpired()
   });
 }
 
-bool Eye::Save(InfoType const & info)
+void Eye::Flush()
 {
-  if (!::Save(*info))
-    return false;
+  GetPlatform().RunTask(Platform::Thread::File, [this]
+  {
+    Save();
+  });
+}
 
+void Eye::UpdateInfo(InfoType const & info)
+{
   m_info.Set(info);
-  return true;
+  m_infoChanged = true;
+  ScheduleSave();
+}
+
+void Eye::ScheduleSave()
+{
+  if (m_saveScheduled)
+    return;
+
+  m_saveScheduled = true;
+  GetPlatform().RunDelayedTask(Platform::Thread::File, kSaveDelay, [this]
+  {
+    Save();
+  });
+}
+
+void Eye::Save()
+{
+  m_saveScheduled = false;
+
+  if (m_infoChanged && ::Save(*m_info.Get()))
+    m_infoChanged = false;
+
+  if (!m_pendingMapObjectEvents.empty() &&
+      Storage::AppendMapObjectEvent(m_pendingMapObjectEvents))
+  {
+    m_pendingMapObjectEvents.clear();
+  }
 }
 
 void Eye::TrimExpiredMapObjectEvents()
@@ -148,7 +175,11 @@ void Eye::TrimExpiredMapObjectEvents()
   }
 
   if (changed && SaveMapObjects(editableInfo->m_mapObjects))
+  {
     m_info.Set(editableInfo);
+    // The rewritten file already contains the events which are not appended yet.
+    m_pendingMapObjectEvents.clear();
+  }
 }
 
 void Eye::RegisterTipClick(Tip::Type type, Tip::Event event)
@@ -178,8 +209,7 @@ void Eye::RegisterTipClick(Tip::Type type, Tip::Event event)
     editableTips.push_back(tip);
   }
 
-  if (!Save(editableInfo))
-    return;
+  UpdateInfo(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, tip]
   {
@@ -198,8 +228,7 @@ void Eye::UpdateBookingFilterUsedTime()
 
   editableInfo->m_booking.m_lastFilterUsedTime = now;
 
-  if (!Save(editableInfo))
-    return;
+  UpdateInfo(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, now]
   {
@@ -218,8 +247,7 @@ void Eye::UpdateBoomarksCatalogShownTime()
 
   editableInfo->m_bookmarks.m_lastOpenedTime = now;
 
-  if (!Save(editableInfo))
-    return;
+  UpdateInfo(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, now]
   {
@@ -238,8 +266,7 @@ void Eye::UpdateDiscoveryShownTime()
 
   editableInfo->m_discovery.m_lastOpenedTime = now;
 
-  if (!Save(editableInfo))
-    return;
+  UpdateInfo(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, now]
   {
@@ -258,8 +285,7 @@ void Eye::IncrementDiscoveryItem(Discovery::Event event)
   editableInfo->m_discovery.m_lastClickedTime = Clock::now();
   editableInfo->m_discovery.m_eventCounters.Increment(event);
 
-  if (!Save(editableInfo))
-    return;
+  UpdateInfo(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, event]
   {
@@ -297,8 +323,7 @@ void Eye::RegisterLayerShown(Layer::Type type)
     editableLayers.emplace_back(layer);
   }
 
-  if (!Save(editableInfo))
-    return;
+  UpdateInfo(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, layer]
   {
@@ -334,10 +359,13 @@ void Eye::RegisterMapObjectEvent(MapObject const & mapObject, MapObject::Event::
     events = it->second;
   }
 
-  if (!SaveMapObjectEvent(mapObject, event))
-    return;
+  std::vector<int8_t> eventData;
+  Serdes::SerializeMapObjectEvent(mapObject, event, eventData);
+  m_pendingMapObjectEvents.insert(m_pendingMapObjectEvents.end(), eventData.cbegin(),
+                                  eventData.cend());
 
   m_info.Set(editableInfo);
+  ScheduleSave();
   GetPlatform().RunTask(Platform::Thread::Gui, [this, mapObject, events]
   {
     for (auto subscriber : m_subscribers)
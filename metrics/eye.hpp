@@ -27,6 +27,8 @@ public:
 
 // Note This class IS thread-safe.
 // All write operations are asynchronous and work on Platform::Thread::File thread.
+// Changes are written to disk in batches: info is rewritten and map object events are appended
+// to their file some time after the first unsaved change or on Flush() call.
 // Read operations are synchronous and return shared pointer with constant copy of internal
 // container.
 class Eye
@@ -65,11 +67,16 @@ public:
   void UnsubscribeAll();
 
   void TrimExpired();
+  // Writes unsaved changes to disk.
+  void Flush();
 
 private:
   Eye();
 
-  bool Save(InfoType const & info);
+  // Sets |info| and schedules its saving.
+  void UpdateInfo(InfoType const & info);
+  void ScheduleSave();
+  void Save();
   void TrimExpiredMapObjectEvents();
 
   // Event processing:
@@ -85,6 +92,12 @@ private:
   base::AtomicSharedPtr<Info> m_info;
   std::vector<Subscriber *> m_subscribers;
 
+  // The fields below are used on Platform::Thread::File thread only.
+  bool m_infoChanged = false;
+  bool m_saveScheduled = false;
+  // Serialized map object events which are not appended to the file yet.
+  std::vector<int8_t> m_pendingMapObjectEvents;
+
   DISALLOW_COPY_AND_MOVE(Eye);
 };
 }  // namespace eye
@@ -599,3 +599,37 @@ UNIT_CLASS_TEST(ScopedEyeForTesting, RegisterMapObjectEvent)
     }
   }
 }
+
+UNIT_CLASS_TEST(ScopedEyeForTesting, SaveBatchedChanges)
+{
+  MapObject poi;
+  poi.m_bestType = "cafe";
+  poi.m_pos = {53.652005, 108.143448};
+  m2::PointD const userPos = {53.016347, 158.683327};
+
+  EyeForTesting::RegisterMapObjectEvent(poi, MapObject::Event::Type::Open, userPos);
+  EyeForTesting::RegisterMapObjectEvent(poi, MapObject::Event::Type::RouteToCreated, userPos);
+  EyeForTesting::AppendLayer(Layer::Type::TrafficJams);
+
+  std::vector<int8_t> infoData;
+  std::vector<int8_t> mapObjectsData;
+  TEST(!Storage::LoadInfo(infoData), ());
+  TEST(!Storage::LoadMapObjects(mapObjectsData), ());
+
+  EyeForTesting::Save();
+
+  TEST(Storage::LoadInfo(infoData), ());
+  TEST(Storage::LoadMapObjects(mapObjectsData), ());
+
+  Info result;
+  Serdes::DeserializeInfo(infoData, result);
+  Serdes::DeserializeMapObjects(mapObjectsData, result.m_mapObjects);
+
+  TEST_EQUAL(result.m_layers.size(), 1, ());
+  TEST_EQUAL(result.m_layers[0].m_type, Layer::Type::TrafficJams, ());
+  TEST_EQUAL(result.m_mapObjects.size(), 1, ());
+  auto const & events = result.m_mapObjects.begin()->second;
+  TEST_EQUAL(events.size(), 2, ());
+  TEST_EQUAL(events[0].m_type, MapObject::Event::Type::Open, ());
+  TEST_EQUAL(events[1].m_type, MapObject::Event::Type::RouteToCreated, ());
+}
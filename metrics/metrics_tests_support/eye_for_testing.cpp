@@ -19,6 +19,10 @@ void EyeForTesting::ResetEye()
   UNUSED_VALUE(GetPlatform().MkDirChecked(Storage::GetEyeDir()));
 
   SetInfo({});
+  auto & eye = Eye::Instance();
+  eye.m_infoChanged = false;
+  eye.m_saveScheduled = false;
+  eye.m_pendingMapObjectEvents.clear();
 
   auto path = Storage::GetInfoFilePath();
   uint64_t unused;
@@ -84,4 +88,10 @@ void EyeForTesting::RegisterMapObjectEvent(MapObject const & mapObject, MapObjec
 {
   Eye::Instance().RegisterMapObjectEvent(mapObject, type, userPos);
 }
+
+// static
+void EyeForTesting::Save()
+{
+  Eye::Instance().Save();
+}
 }  // namespace eye
@@ -20,6 +20,7 @@ public:
   static void TrimExpiredMapObjectEvents();
   static void RegisterMapObjectEvent(MapObject const & mapObject, MapObject::Event::Type type,
                                      m2::PointD const & userPos);
+  static void Save();
 };
 
 class ScopedEyeForTesting
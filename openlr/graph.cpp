@@ -1,35 +1,63 @@
 #include "openlr/graph.hpp"
 
+#include <functional>
+#include <utility>
+
 using namespace routing;
+using namespace std;
 
 namespace openlr
 {
-namespace
+// EdgesCache --------------------------------------------------------------------------------
+void EdgesCache::GetRegularOutgoingEdges(Junction const & junction, IRoadGraph const & graph,
+                                         EdgeVector & edges)
 {
-using EdgeGetter = void (IRoadGraph::*)(Junction const &, RoadGraphBase::TEdgeVector &) const;
+  GetEdges(junction, graph, &IRoadGraph::GetRegularOutgoingEdges, &Shard::m_outgoing, edges);
+}
 
-void GetRegularEdges(Junction const & junction, IRoadGraph const & graph,
-                     EdgeGetter const edgeGetter,
-                     map<openlr::Graph::Junction, Graph::EdgeVector> & cache,
-                     Graph::EdgeVector & edges)
+void EdgesCache::GetRegularIngoingEdges(Junction const & junction, IRoadGraph const & graph,
+                                        EdgeVector & edges)
 {
-  auto const it = cache.find(junction);
-  if (it == end(cache))
-  {
-    auto & es = cache[junction];
-    (graph.*edgeGetter)(junction, es);
-    edges.insert(end(edges), begin(es), end(es));
-  }
-  else
+  GetEdges(junction, graph, &IRoadGraph::GetRegularIngoingEdges, &Shard::m_ingoing, edges);
+}
+
+void EdgesCache::GetEdges(Junction const & junction, IRoadGraph const & graph, EdgeGetter getter,
+                          ShardCache cache, EdgeVector & edges)
+{
+  auto & shard = GetShard(junction);
   {
-    auto const & es = it->second;
-    edges.insert(end(edges), begin(es), end(es));
+    lock_guard<mutex> lock(shard.m_mutex);
+    auto const & es = shard.*cache;
+    auto const it = es.find(junction);
+    if (it != es.end())
+    {
+      edges.insert(end(edges), begin(it->second), end(it->second));
+      return;
+    }
   }
+
+  // Edges are read without the lock. Several threads may read the same junction at once,
+  // they get equal edges.
+  EdgeVector es;
+  (graph.*getter)(junction, es);
+  edges.insert(end(edges), begin(es), end(es));
+
+  lock_guard<mutex> lock(shard.m_mutex);
+  (shard.*cache).emplace(junction, move(es));
+}
+
+EdgesCache::Shard & EdgesCache::GetShard(Junction const & junction)
+{
+  auto const & p = junction.GetPoint();
+  auto const h = hash<double>()(p.x) * 31 + hash<double>()(p.y);
+  return m_shards[h % kShardsCount];
 }
-}  // namespace
 
-Graph::Graph(DataSource const & dataSource, shared_ptr<CarModelFactory> carModelFactory)
+// Graph -------------------------------------------------------------------------------------
+Graph::Graph(DataSource const & dataSource, shared_ptr<CarModelFactory> carModelFactory,
+             shared_ptr<EdgesCache> edgesCache)
   : m_graph(dataSource, IRoadGraph::Mode::ObeyOnewayTag, carModelFactory)
+  , m_edgesCache(edgesCache ? move(edgesCache) : make_shared<EdgesCache>())
 {
 }
 
@@ -47,12 +75,12 @@ void Graph::GetIngoingEdges(Junction const & junction, EdgeVector & edges)
 
 void Graph::GetRegularOutgoingEdges(Junction const & junction, EdgeVector & edges)
 {
-  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularOutgoingEdges, m_outgoingCache, edges);
+  m_edgesCache->GetRegularOutgoingEdges(junction, m_graph, edges);
 }
 
 void Graph::GetRegularIngoingEdges(Junction const & junction, EdgeVector & edges)
 {
-  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularIngoingEdges, m_ingoingCache, edges);
+  m_edgesCache->GetRegularIngoingEdges(junction, m_graph, edges);
 }
 
 void Graph::FindClosestEdges(m2::PointD const & point, uint32_t const count,
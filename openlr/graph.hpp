@@ -7,15 +7,54 @@
 
 #include "geometry/point2d.hpp"
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class DataSource;
 
 namespace openlr
 {
+// Cache of regular edges of junctions. Edges keep mwm ids of the data source they are read
+// from, so the cache may be shared only by graphs built over the same data source.
+//
+// *NOTE* This class is thread-safe.
+class EdgesCache
+{
+public:
+  using EdgeVector = routing::FeaturesRoadGraph::TEdgeVector;
+  using Junction = routing::Junction;
+
+  // Append regular edges of |junction| to |edges|. Edges which are not cached yet are read
+  // from |graph|.
+  void GetRegularOutgoingEdges(Junction const & junction, routing::IRoadGraph const & graph,
+                               EdgeVector & edges);
+  void GetRegularIngoingEdges(Junction const & junction, routing::IRoadGraph const & graph,
+                              EdgeVector & edges);
+
+private:
+  static size_t constexpr kShardsCount = 64;
+
+  struct Shard
+  {
+    std::mutex m_mutex;
+    std::map<Junction, EdgeVector> m_outgoing;
+    std::map<Junction, EdgeVector> m_ingoing;
+  };
+
+  using EdgeGetter = void (routing::IRoadGraph::*)(Junction const &, EdgeVector &) const;
+  using ShardCache = std::map<Junction, EdgeVector> Shard::*;
+
+  void GetEdges(Junction const & junction, routing::IRoadGraph const & graph, EdgeGetter getter,
+                ShardCache cache, EdgeVector & edges);
+  Shard & GetShard(Junction const & junction);
+
+  std::array<Shard, kShardsCount> m_shards;
+};
+
 // TODO(mgsergio): Inherit from FeaturesRoadGraph.
 class Graph
 {
@@ -24,7 +63,9 @@ public:
   using EdgeVector = routing::FeaturesRoadGraph::TEdgeVector;
   using Junction = routing::Junction;
 
-  Graph(DataSource const & dataSource, std::shared_ptr<routing::CarModelFactory> carModelFactory);
+  // When |edgesCache| is null the graph keeps its own cache.
+  Graph(DataSource const & dataSource, std::shared_ptr<routing::CarModelFactory> carModelFactory,
+        std::shared_ptr<EdgesCache> edgesCache = nullptr);
 
   // Appends edges such as that edge.GetStartJunction() == junction to the |edges|.
   void GetOutgoingEdges(routing::Junction const & junction, EdgeVector & edges);
@@ -51,7 +92,6 @@ public:
 
 private:
   routing::FeaturesRoadGraph m_graph;
-  std::map<Junction, EdgeVector> m_outgoingCache;
-  std::map<Junction, EdgeVector> m_ingoingCache;
+  std::shared_ptr<EdgesCache> m_edgesCache;
 };
 }  // namespace openlr
@@ -35,6 +35,7 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <functional>
@@ -212,7 +213,10 @@ void CopyWithoutOffsets(InputIterator const start, InputIterator const stop, Out
 class SegmentsDecoderV1
 {
 public:
-  SegmentsDecoderV1(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf)
+  // |edgesCache| is not used: this version of the algorithm routes over FeaturesRoadGraph
+  // directly.
+  SegmentsDecoderV1(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf,
+                    shared_ptr<EdgesCache> const & /* edgesCache */)
     : m_roadGraph(dataSource, IRoadGraph::Mode::ObeyOnewayTag, move(cmf))
     , m_infoGetter(dataSource)
     , m_router(m_roadGraph, m_infoGetter)
@@ -281,8 +285,9 @@ private:
 class SegmentsDecoderV2
 {
 public:
-  SegmentsDecoderV2(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf)
-    : m_dataSource(dataSource), m_graph(dataSource, move(cmf)), m_infoGetter(dataSource)
+  SegmentsDecoderV2(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf,
+                    shared_ptr<EdgesCache> const & edgesCache)
+    : m_dataSource(dataSource), m_graph(dataSource, move(cmf), edgesCache), m_infoGetter(dataSource)
   {
   }
 
@@ -402,8 +407,11 @@ bool OpenLRDecoder::SegmentsFilter::Matches(LinearSegment const & segment) const
 
 // OpenLRDecoder -----------------------------------------------------------------------------
 OpenLRDecoder::OpenLRDecoder(vector<FrozenDataSource> const & dataSources,
-                             CountryParentNameGetter const & countryParentNameGetter)
-  : m_dataSources(dataSources), m_countryParentNameGetter(countryParentNameGetter)
+                             CountryParentNameGetter const & countryParentNameGetter,
+                             bool shareGraphCache)
+  : m_dataSources(dataSources)
+  , m_countryParentNameGetter(countryParentNameGetter)
+  , m_shareGraphCache(shareGraphCache)
 {
 }
 
@@ -423,16 +431,30 @@ template <typename Decoder, typename Stats>
 void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
                            uint32_t const numThreads, vector<DecodedPath> & paths)
 {
-  auto const worker = [&segments, &paths, numThreads, this](size_t threadNum, DataSource const & dataSource,
-                                                            Stats & stat) {
+  CHECK_GREATER(numThreads, 0, ());
+  CHECK(!m_dataSources.empty(), ());
+  if (!m_shareGraphCache)
+    CHECK_GREATER_OR_EQUAL(m_dataSources.size(), numThreads, ());
+
+  shared_ptr<EdgesCache> edgesCache;
+  if (m_shareGraphCache)
+    edgesCache = make_shared<EdgesCache>();
+
+  // Threads take batches of segments one by one, so a thread which gets hard segments
+  // (e.g. dense city roads) doesn't leave others idle at the end.
+  atomic<size_t> nextBatch(0);
+  auto const worker = [&segments, &paths, &nextBatch, &edgesCache, this](
+                          size_t threadNum, DataSource const & dataSource, Stats & stat) {
     size_t constexpr kBatchSize = GetOptimalBatchSize();
     size_t constexpr kProgressFrequency = 100;
 
     size_t const numSegments = segments.size();
 
-    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter));
+    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter),
+                    edgesCache);
     base::Timer timer;
-    for (size_t i = threadNum * kBatchSize; i < numSegments; i += numThreads * kBatchSize)
+    for (size_t i = nextBatch.fetch_add(kBatchSize); i < numSegments;
+         i = nextBatch.fetch_add(kBatchSize))
     {
       for (size_t j = i; j < numSegments && j < i + kBatchSize; ++j)
       {
@@ -440,7 +462,7 @@ void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
           ++stat.m_routesFailed;
         ++stat.m_routesHandled;
 
-        if (stat.m_routesHandled % kProgressFrequency == 0 || i == segments.size() - 1)
+        if (stat.m_routesHandled % kProgressFrequency == 0 || j == numSegments - 1)
         {
           LOG(LINFO, ("Thread", threadNum, "processed", stat.m_routesHandled,
                       "failed:", stat.m_routesFailed));
@@ -450,12 +472,16 @@ void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
     }
   };
 
+  auto const & getDataSource = [this](size_t threadNum) -> DataSource const & {
+    return m_dataSources[m_shareGraphCache ? 0 : threadNum];
+  };
+
   vector<Stats> stats(numThreads);
   vector<thread> workers;
   for (size_t i = 1; i < numThreads; ++i)
-    workers.emplace_back(worker, i, ref(m_dataSources[i]), ref(stats[i]));
+    workers.emplace_back(worker, i, ref(getDataSource(i)), ref(stats[i]));
 
-  worker(0 /* threadNum */, m_dataSources[0], stats[0]);
+  worker(0 /* threadNum */, getDataSource(0), stats[0]);
   for (auto & worker : workers)
     worker.join();
 
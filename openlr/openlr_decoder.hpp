@@ -40,8 +40,12 @@ public:
     bool const m_multipointsOnly;
   };
 
+  // When |shareGraphCache| is true all threads decode over the first data source and share
+  // the cache of road graph edges. Otherwise each thread uses its own data source and cache,
+  // so there should be at least as many data sources as threads.
   OpenLRDecoder(std::vector<FrozenDataSource> const & dataSources,
-                CountryParentNameGetter const & countryParentNameGetter);
+                CountryParentNameGetter const & countryParentNameGetter,
+                bool shareGraphCache = false);
 
   // Maps partner segments to mwm paths. |segments| should be sorted by partner id.
   void DecodeV1(std::vector<LinearSegment> const & segments, uint32_t const numThreads,
@@ -57,5 +61,6 @@ private:
 
   std::vector<FrozenDataSource> const & m_dataSources;
   CountryParentNameGetter m_countryParentNameGetter;
+  bool const m_shareGraphCache;
 };
 }  // namespace openlr
@@ -5,6 +5,7 @@
 
 #include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/cstring.hpp"
 #include "std/type_traits.hpp"
 
@@ -82,6 +83,10 @@ bool ParseValueIfExists(pugi::xml_node const & node, Value & value)
 
 namespace  // OpenLR tools and abstractions
 {
+char const kSegmentOpenTag[] = "<reportSegments";
+char const kSegmentCloseTag[] = "</reportSegments>";
+size_t constexpr kReadChunkSize = 64 * 1024;
+
 bool FirstCoordinateFromXML(pugi::xml_node const & node, ms::LatLon & latLon)
 {
   int32_t lat, lon;
@@ -293,4 +298,89 @@ bool SegmentFromXML(pugi::xml_node const & segmentNode, LinearSegment & segment)
   auto const locRefNode = GetLinearLocationReference(segmentNode);
   return LinearLocationReferenceFromXML(locRefNode, segment.m_locationReference);
 }
+
+// SegmentsReader ----------------------------------------------------------------------------
+bool SegmentsReader::Read(size_t maxCount, vector<LinearSegment> & segments)
+{
+  size_t count = 0;
+  string xml;
+  while (count < maxCount && ReadElement(xml))
+  {
+    pugi::xml_document document;
+    if (!document.load_buffer(xml.data(), xml.size(),
+                              pugi::parse_default | pugi::parse_fragment))
+    {
+      LOG(LERROR, ("Can't parse segment xml"));
+      return false;
+    }
+
+    auto const segmentNode = document.child("reportSegments");
+    if (NoLocationReferenceButCoordinates(segmentNode))
+    {
+      LOG(LWARNING, ("A segment with <coordinates> instead of <optionLinearLocationReference> "
+                     "encounted, skipping..."));
+      continue;
+    }
+
+    LinearSegment segment;
+    if (!SegmentFromXML(segmentNode, segment))
+      return false;
+
+    segments.push_back(segment);
+    ++count;
+  }
+  return true;
+}
+
+bool SegmentsReader::ReadElement(string & xml)
+{
+  size_t constexpr kOpenTagSize = sizeof(kSegmentOpenTag) - 1;
+  size_t constexpr kCloseTagSize = sizeof(kSegmentCloseTag) - 1;
+
+  while (true)
+  {
+    auto const begin = FindOpenTag(0 /* from */);
+    if (begin != string::npos)
+    {
+      auto const end = m_buffer.find(kSegmentCloseTag, begin + kOpenTagSize);
+      if (end != string::npos)
+      {
+        xml.assign(m_buffer, begin, end + kCloseTagSize - begin);
+        m_buffer.erase(0, end + kCloseTagSize);
+        return true;
+      }
+      m_buffer.erase(0, begin);
+    }
+    else if (m_buffer.size() > kOpenTagSize)
+    {
+      // Only a tail of the buffer may be a beginning of the open tag.
+      m_buffer.erase(0, m_buffer.size() - kOpenTagSize);
+    }
+
+    char chunk[kReadChunkSize];
+    m_input.read(chunk, kReadChunkSize);
+    auto const readSize = static_cast<size_t>(m_input.gcount());
+    if (readSize == 0)
+      return false;
+    m_buffer.append(chunk, readSize);
+  }
+}
+
+size_t SegmentsReader::FindOpenTag(size_t from) const
+{
+  size_t constexpr kOpenTagSize = sizeof(kSegmentOpenTag) - 1;
+
+  for (auto pos = m_buffer.find(kSegmentOpenTag, from); pos != string::npos;
+       pos = m_buffer.find(kSegmentOpenTag, pos + 1))
+  {
+    // The tag name may be a prefix of another name, e.g. <reportSegmentsList>.
+    auto const next = pos + kOpenTagSize;
+    if (next < m_buffer.size() && strchr("> \t\r\n", m_buffer[next]) != nullptr)
+      return pos;
+    // The rest of the tag is not read yet.
+    if (next >= m_buffer.size())
+      return pos;
+  }
+  return string::npos;
+}
 }  // namespace openlr
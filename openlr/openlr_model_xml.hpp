@@ -1,5 +1,8 @@
 #pragma once
 
+#include "std/cstdint.hpp"
+#include "std/iostream.hpp"
+#include "std/string.hpp"
 #include "std/vector.hpp"
 
 namespace pugi
@@ -15,4 +18,25 @@ struct LinearSegment;
 bool SegmentFromXML(pugi::xml_node const & segmentNode, LinearSegment & segment);
 
 bool ParseOpenlr(pugi::xml_document const & document, vector<LinearSegment> & segments);
+
+// Reads <reportSegments> elements of an OpenLR document from a stream one by one, so the whole
+// document is never kept in memory. Each element is parsed as a separate XML fragment. That's
+// enough because namespace prefixes of elements are matched literally.
+class SegmentsReader
+{
+public:
+  explicit SegmentsReader(istream & input) : m_input(input) {}
+
+  // Appends at most |maxCount| segments to |segments|. Returns false when a segment can't be
+  // parsed. Nothing is appended at the end of the input.
+  bool Read(size_t maxCount, vector<LinearSegment> & segments);
+
+private:
+  // Moves the next <reportSegments> element to |xml|. Returns false at the end of the input.
+  bool ReadElement(string & xml);
+  size_t FindOpenTag(size_t from) const;
+
+  istream & m_input;
+  string m_buffer;
+};
 }  // namespace openlr
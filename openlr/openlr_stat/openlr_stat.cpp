@@ -29,11 +29,12 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <iostream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
-DEFINE_string(input, "", "Path to OpenLR file.");
+DEFINE_string(input, "", "Path to OpenLR file. With --batch_size, \"-\" reads stdin.");
 DEFINE_string(spark_output, "", "Path to output file in spark-oriented format");
 DEFINE_string(assessment_output, "", "Path to output file in assessment-tool oriented format");
 
@@ -44,11 +45,16 @@ DEFINE_string(resources_path, "", "Path to a folder with resources.");
 DEFINE_int32(limit, -1, "Max number of segments to handle. -1 for all.");
 DEFINE_bool(multipoints_only, false, "Only segments with multiple points to handle.");
 DEFINE_int32(num_threads, 1, "Number of threads.");
+DEFINE_bool(shared_graph_cache, false,
+            "Decode over one data source and share the road graph cache between threads.");
 DEFINE_string(ids_path, "", "Path to a file with segment ids to process.");
 DEFINE_string(countries_filename, "",
               "Name of countries file which describes mwm tree. Used to get country specific "
               "routing restrictions.");
 DEFINE_int32(algo_version, 0, "Use new decoding algorithm");
+DEFINE_int32(batch_size, 0,
+             "Read the input incrementally and decode it in batches of this many segments. "
+             "Results are written after each batch. 0 to read the whole input at once.");
 
 using namespace openlr;
 
@@ -165,16 +171,101 @@ bool const g_numThreadsDummy =
 bool const g_mwmsPathDummy = google::RegisterFlagValidator(&FLAGS_mwms_path, &ValidateMwmPath);
 bool const g_algoVersion = google::RegisterFlagValidator(&FLAGS_algo_version, &ValidateVersion);
 
+void SaveNonMatchedIds(std::ostream & ost, std::vector<DecodedPath> const & paths)
+{
+  for (auto const & p : paths)
+  {
+    if (p.m_path.empty())
+      ost << p.m_segmentId << std::endl;
+  }
+}
+
 void SaveNonMatchedIds(std::string const & filename, std::vector<DecodedPath> const & paths)
 {
   if (filename.empty())
     return;
 
   std::ofstream ofs(filename);
-  for (auto const & p : paths)
+  SaveNonMatchedIds(ofs, paths);
+}
+
+void DecodeSegments(OpenLRDecoder & decoder, std::vector<LinearSegment> const & segments,
+                    uint32_t numThreads, std::vector<DecodedPath> & paths)
+{
+  switch (FLAGS_algo_version)
   {
-    if (p.m_path.empty())
-      ofs << p.m_segmentId << std::endl;
+  case 1: decoder.DecodeV1(segments, numThreads, paths); break;
+  case 2: decoder.DecodeV2(segments, numThreads, paths); break;
+  default: ASSERT(false, ("There should be no way to fall here"));
+  }
+}
+
+// Decodes the input batch by batch, so memory doesn't grow with the input size and an unbounded
+// feed can be processed.
+void DecodeStream(OpenLRDecoder & decoder, uint32_t numThreads)
+{
+  if (!FLAGS_assessment_output.empty())
+  {
+    LOG(LERROR, ("--assessment_output can't be used with --batch_size"));
+    exit(-1);
+  }
+
+  std::ifstream file;
+  if (FLAGS_input != "-")
+  {
+    file.open(FLAGS_input);
+    if (!file.is_open())
+    {
+      LOG(LERROR, ("Can't open file", FLAGS_input));
+      exit(-1);
+    }
+  }
+  SegmentsReader reader(FLAGS_input == "-" ? std::cin : file);
+
+  std::ofstream nonMatchedIds;
+  if (!FLAGS_non_matched_ids.empty())
+    nonMatchedIds.open(FLAGS_non_matched_ids);
+  std::ofstream spark;
+  if (!FLAGS_spark_output.empty())
+    spark.open(FLAGS_spark_output);
+
+  OpenLRDecoder::SegmentsFilter filter(FLAGS_ids_path, FLAGS_multipoints_only);
+  auto const batchSize = static_cast<size_t>(FLAGS_batch_size);
+  size_t numRead = 0;
+  std::vector<LinearSegment> segments;
+  std::vector<DecodedPath> paths;
+  while (true)
+  {
+    auto maxCount = batchSize;
+    if (FLAGS_limit != kHandleAllSegments && FLAGS_limit >= 0)
+      maxCount = std::min(maxCount, static_cast<size_t>(FLAGS_limit) - numRead);
+    if (maxCount == 0)
+      break;
+
+    segments.clear();
+    if (!reader.Read(maxCount, segments))
+    {
+      LOG(LERROR, ("Can't parse data."));
+      exit(-1);
+    }
+    if (segments.empty())
+      break;
+    numRead += segments.size();
+
+    base::EraseIf(segments,
+                  [&filter](LinearSegment const & segment) { return !filter.Matches(segment); });
+    std::sort(segments.begin(), segments.end(), base::LessBy(&LinearSegment::m_segmentId));
+
+    paths.assign(segments.size(), DecodedPath());
+    DecodeSegments(decoder, segments, numThreads, paths);
+
+    if (nonMatchedIds.is_open())
+      SaveNonMatchedIds(nonMatchedIds, paths);
+    if (spark.is_open())
+    {
+      WriteAsMappingForSpark(spark, paths);
+      spark.flush();
+    }
   }
 }
 
@@ -260,12 +351,20 @@ int main(int argc, char * argv[])
 
   auto const numThreads = static_cast<uint32_t>(FLAGS_num_threads);
 
-  std::vector<FrozenDataSource> dataSources(numThreads);
+  std::vector<FrozenDataSource> dataSources(FLAGS_shared_graph_cache ? 1 : numThreads);
 
   LoadDataSources(FLAGS_mwms_path, dataSources);
 
-  OpenLRDecoder decoder(dataSources, storage::CountryParentGetter(FLAGS_countries_filename,
-                                                              GetPlatform().ResourcesDir()));
+  OpenLRDecoder decoder(dataSources,
+                        storage::CountryParentGetter(FLAGS_countries_filename,
+                                                     GetPlatform().ResourcesDir()),
+                        FLAGS_shared_graph_cache);
+
+  if (FLAGS_batch_size > 0)
+  {
+    DecodeStream(decoder, numThreads);
+    return 0;
+  }
 
   pugi::xml_document document;
   auto const load_result = document.load_file(FLAGS_input.data());
@@ -278,12 +377,7 @@ int main(int argc, char * argv[])
   auto const segments = LoadSegments(document);
 
   std::vector<DecodedPath> paths(segments.size());
-  switch (FLAGS_algo_version)
-  {
-  case 1: decoder.DecodeV1(segments, numThreads, paths); break;
-  case 2: decoder.DecodeV2(segments, numThreads, paths); break;
-  default: ASSERT(false, ("There should be no way to fall here"));
-  }
+  DecodeSegments(decoder, segments, numThreads, paths);
 
   SaveNonMatchedIds(FLAGS_non_matched_ids, paths);
   if (!FLAGS_assessment_output.empty())
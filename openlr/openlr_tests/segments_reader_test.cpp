@@ -0,0 +1,66 @@
+#include "testing/testing.hpp"
+
+#include "openlr/openlr_model.hpp"
+#include "openlr/openlr_model_xml.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace openlr;
+using namespace std;
+
+namespace
+{
+string MakeSegment(uint32_t id)
+{
+  string const point =
+      "<olr:coordinate><olr:latitude>2796619</olr:latitude>"
+      "<olr:longitude>1752597</olr:longitude></olr:coordinate>"
+      "<olr:lineProperties>"
+      "<olr:frc olr:table=\"olr001_FunctionalRoadClass\" olr:code=\"2\"/>"
+      "<olr:fow olr:table=\"olr002_FormOfWay\" olr:code=\"3\"/>"
+      "<olr:bearing><olr:value>10</olr:value></olr:bearing>"
+      "</olr:lineProperties>";
+  return "<reportSegments>\n<ReportSegmentID>" + to_string(id) +
+         "</ReportSegmentID><segmentLength>100</segmentLength>"
+         "<segmentRefSpeed>40</segmentRefSpeed>"
+         "<olr:locationReference><olr:optionLinearLocationReference>"
+         "<olr:first>" + point +
+         "<olr:pathProperties><olr:lfrcnp olr:table=\"olr001_FunctionalRoadClass\" olr:code=\"4\"/>"
+         "<olr:dnp><olr:value>100</olr:value></olr:dnp>"
+         "<olr:againstDrivingDirection>false</olr:againstDrivingDirection></olr:pathProperties>"
+         "</olr:first><olr:last>" + point + "</olr:last>"
+         "</olr:optionLinearLocationReference></olr:locationReference>"
+         "</reportSegments>\n";
+}
+}  // namespace
+
+UNIT_TEST(SegmentsReader_Batches)
+{
+  stringstream input;
+  input << "<?xml version=\"1.0\"?>\n<Dictionary xmlns:olr=\"http://www.openlr.org/openlr\">"
+        << "<reportSegmentsList/>" << MakeSegment(1)
+        << "<reportSegments><ReportSegmentID>2</ReportSegmentID><coordinates/></reportSegments>"
+        << MakeSegment(3) << MakeSegment(4) << "</Dictionary>";
+
+  SegmentsReader reader(input);
+  vector<LinearSegment> segments;
+
+  TEST(reader.Read(2 /* maxCount */, segments), ());
+  TEST_EQUAL(segments.size(), 2, ());
+  TEST_EQUAL(segments[0].m_segmentId, 1, ());
+  // Segments with coordinates only are skipped.
+  TEST_EQUAL(segments[1].m_segmentId, 3, ());
+  TEST_EQUAL(segments[1].GetLRPs().size(), 2, ());
+  TEST_EQUAL(segments[1].GetLRPs()[0].m_distanceToNextPoint, 100, ());
+
+  segments.clear();
+  TEST(reader.Read(2 /* maxCount */, segments), ());
+  TEST_EQUAL(segments.size(), 1, ());
+  TEST_EQUAL(segments[0].m_segmentId, 4, ());
+
+  segments.clear();
+  TEST(reader.Read(2 /* maxCount */, segments), ());
+  TEST(segments.empty(), ());
+}
@@ -60,6 +60,21 @@ bool RunSimpleHttpRequest(bool const needAuth, string const & url, string & resu
   return request.RunHttpRequest(result);
 }
 
+// Place page of the same hotel is often opened several times in a row.
+// Descriptions of hotels are changed rarely.
+partners_api::http::ResponseCache g_extendedInfoCache(100 /* maxCount */, hours(1) /* ttl */);
+partners_api::http::ResponseCache g_blockAvailabilityCache(100 /* maxCount */,
+                                                           minutes(5) /* ttl */);
+
+bool RunCachedHttpRequest(partners_api::http::ResponseCache & cache, bool const needAuth,
+                          string const & url, string & result)
+{
+  return cache.Get(url, [needAuth, &url](string & response)
+  {
+    return RunSimpleHttpRequest(needAuth, url, response);
+  }, result);
+}
+
 std::string FormatTime(system_clock::time_point p)
 {
   return partners_api::FormatTime(p, "%Y-%m-%d");
@@ -414,7 +429,7 @@ bool RawApi::GetExtendedInfo(string const & hotelId, string const & lang, string
 {
   ostringstream os;
   os << kExtendedHotelInfoBaseUrl << "?hotel_id=" << hotelId << "&lang=" << lang;
-  return RunSimpleHttpRequest(false, os.str(), result);
+  return RunCachedHttpRequest(g_extendedInfoCache, false, os.str(), result);
 }
 
 // static
@@ -430,7 +445,7 @@ bool RawApi::BlockAvailability(BlockParams const & params, string & result)
 {
   string url = MakeApiUrlV2("blockAvailability", params.Get());
 
-  return RunSimpleHttpRequest(true, url, result);
+  return RunCachedHttpRequest(g_blockAvailabilityCache, true, url, result);
 }
 
 string Api::GetBookHotelUrl(string const & baseUrl) const
@@ -0,0 +1,99 @@
+#include "testing/testing.hpp"
+
+#include "partners_api/utils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace partners_api::http;
+using namespace std::chrono;
+
+namespace
+{
+UNIT_TEST(ResponseCache_Smoke)
+{
+  ResponseCache cache(2 /* maxCount */, hours(1) /* ttl */);
+  size_t requestsCount = 0;
+  auto const request = [&requestsCount](std::string & response)
+  {
+    ++requestsCount;
+    response = "response";
+    return true;
+  };
+
+  std::string response;
+  TEST(cache.Get("url", request, response), ());
+  TEST_EQUAL(response, "response", ());
+  TEST(cache.Get("url", request, response), ());
+  TEST_EQUAL(response, "response", ());
+  TEST_EQUAL(requestsCount, 1, ());
+
+  TEST(cache.Get("url2", request, response), ());
+  TEST(cache.Get("url3", request, response), ());
+  TEST_EQUAL(requestsCount, 3, ());
+
+  cache.Clear();
+  TEST(cache.Get("url", request, response), ());
+  TEST_EQUAL(requestsCount, 4, ());
+}
+
+UNIT_TEST(ResponseCache_FailedAndExpired)
+{
+  ResponseCache cache(10 /* maxCount */, seconds(0) /* ttl */);
+  size_t requestsCount = 0;
+  std::string response;
+
+  auto const failed = [&requestsCount](std::string & /* response */)
+  {
+    ++requestsCount;
+    return false;
+  };
+  TEST(!cache.Get("url", failed, response), ());
+  TEST(!cache.Get("url", failed, response), ());
+  TEST_EQUAL(requestsCount, 2, ());
+
+  auto const succeeded = [&requestsCount](std::string & response)
+  {
+    ++requestsCount;
+    response = "response";
+    return true;
+  };
+  TEST(cache.Get("url", succeeded, response), ());
+  TEST(cache.Get("url", succeeded, response), ());
+  TEST_EQUAL(requestsCount, 4, ());
+}
+
+UNIT_TEST(ResponseCache_Coalescing)
+{
+  ResponseCache cache(10 /* maxCount */, hours(1) /* ttl */);
+  std::atomic<size_t> requestsCount(0);
+  auto const request = [&requestsCount](std::string & response)
+  {
+    ++requestsCount;
+    std::this_thread::sleep_for(milliseconds(100));
+    response = "response";
+    return true;
+  };
+
+  size_t constexpr kThreadsCount = 4;
+  std::vector<std::string> responses(kThreadsCount);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadsCount; ++i)
+  {
+    threads.emplace_back([&cache, &request, &responses, i]()
+    {
+      TEST(cache.Get("url", request, responses[i]), ());
+    });
+  }
+
+  for (auto & thread : threads)
+    thread.join();
+
+  TEST_EQUAL(requestsCount, 1, ());
+  for (auto const & response : responses)
+    TEST_EQUAL(response, "response", ());
+}
+}  // namespace
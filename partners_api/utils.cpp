@@ -1,8 +1,11 @@
 #include "partners_api/utils.hpp"
 
+#include "base/assert.hpp"
+
 #include <ctime>
 #include <iomanip>
 #include <sstream>
+#include <utility>
 
 using namespace std;
 using namespace std::chrono;
@@ -21,6 +24,82 @@ Result RunSimpleRequest(std::string const & url)
 
   return {result, request.ErrorCode(), request.ServerResponse()};
 }
+
+ResponseCache::ResponseCache(size_t maxCount, Clock::duration const & ttl)
+  : m_maxCount(maxCount), m_ttl(ttl)
+{
+  CHECK_GREATER(m_maxCount, 0, ());
+}
+
+bool ResponseCache::Get(string const & key, Request const & request, string & response)
+{
+  {
+    unique_lock<mutex> lock(m_mutex);
+    while (true)
+    {
+      auto const it = m_responses.find(key);
+      if (it != m_responses.end())
+      {
+        if (Clock::now() < it->second.m_expiryTime)
+        {
+          response = it->second.m_response;
+          return true;
+        }
+        m_responses.erase(it);
+      }
+
+      if (m_requestsInProgress.count(key) == 0)
+        break;
+
+      // The same request is run by another thread. Its response is taken from the cache,
+      // the request is repeated when it is failed.
+      m_cv.wait(lock);
+    }
+    m_requestsInProgress.insert(key);
+  }
+
+  string result;
+  bool const success = request(result);
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_requestsInProgress.erase(key);
+    if (success)
+    {
+      RemoveExtra();
+      m_responses[key] = {Clock::now() + m_ttl, result};
+    }
+  }
+  m_cv.notify_all();
+
+  if (success)
+    response = move(result);
+  return success;
+}
+
+void ResponseCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_responses.clear();
+}
+
+void ResponseCache::RemoveExtra()
+{
+  if (m_responses.size() < m_maxCount)
+    return;
+
+  auto const now = Clock::now();
+  for (auto it = m_responses.begin(); it != m_responses.end();)
+  {
+    if (now >= it->second.m_expiryTime)
+      it = m_responses.erase(it);
+    else
+      ++it;
+  }
+
+  while (!m_responses.empty() && m_responses.size() >= m_maxCount)
+    m_responses.erase(m_responses.begin());
+}
 }  // namespace http
 
 string FormatTime(system_clock::time_point p, string const & format)
@@ -3,6 +3,12 @@
 #include "platform/http_client.hpp"
 
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
 
 namespace partners_api
@@ -24,6 +30,40 @@ struct Result
 };
 
 Result RunSimpleRequest(std::string const & url);
+
+// Thread-safe cache of successful responses. Concurrent requests with the same key are
+// coalesced: the request is run once and the others wait for its response.
+class ResponseCache
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  // Runs the request, returns false when it is failed.
+  using Request = std::function<bool(std::string & response)>;
+
+  ResponseCache(size_t maxCount, Clock::duration const & ttl);
+
+  // Returns the response for |key| from the cache or from |request|.
+  bool Get(std::string const & key, Request const & request, std::string & response);
+  void Clear();
+
+private:
+  struct Entry
+  {
+    Clock::time_point m_expiryTime;
+    std::string m_response;
+  };
+
+  // Removes expired entries and, if it is not enough, the first ones.
+  void RemoveExtra();
+
+  size_t const m_maxCount;
+  Clock::duration const m_ttl;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::map<std::string, Entry> m_responses;
+  std::set<std::string> m_requestsInProgress;
+};
 }  // namespace http
 
 std::string FormatTime(std::chrono::system_clock::time_point p, std::string const & format);
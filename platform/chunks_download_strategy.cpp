@@ -5,12 +5,38 @@
 #include "coding/varint.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/limits.hpp"
 
 
 namespace downloader
 {
+namespace
+{
+// A chunk should be downloaded during about this time, in seconds.
+double const kChunkTime = 5.0;
+// A chunk should be downloaded during at least this number of server latencies, so that
+// waiting for the first byte doesn't take most of the time on slow mobile networks.
+double const kChunkLatencies = 4.0;
+// Chunk sizes are in [initial size / kChunkSizeRatio, initial size * kChunkSizeRatio].
+int64_t const kChunkSizeRatio = 8;
+// Weight of the last measurement in smoothed throughput and latency.
+double const kSmoothing = 0.5;
+// A chunk is moved to another server only if it's being downloaded for at least this time,
+// in seconds, and the other server is expected to download it at least kStealSpeedup times
+// faster than the current one finishes it.
+double const kMinStealTime = 3.0;
+double const kStealSpeedup = 2.0;
+// Minimal time of a measurement, in seconds.
+double const kMinMeasureTime = 1e-3;
+
+double Smooth(double value, double sample)
+{
+  return value == 0.0 ? sample : kSmoothing * sample + (1.0 - kSmoothing) * value;
+}
+}  // namespace
 
 ChunksDownloadStrategy::ChunksDownloadStrategy(vector<string> const & urls)
 {
@@ -36,8 +62,210 @@ ChunksDownloadStrategy::GetChunk(RangeT const & range)
   }
 }
 
+double ChunksDownloadStrategy::Now() const
+{
+  return m_timeForTesting >= 0.0 ? m_timeForTesting : m_timer.ElapsedSeconds();
+}
+
+ChunksDownloadStrategy::ServerT * ChunksDownloadStrategy::GetServerByChunk(int chunkIndex)
+{
+  for (auto & server : m_servers)
+  {
+    if (server.m_chunkIndex == chunkIndex)
+      return &server;
+  }
+  return nullptr;
+}
+
+ChunksDownloadStrategy::ServerT * ChunksDownloadStrategy::GetBestFreeServer()
+{
+  ServerT * best = nullptr;
+  for (auto & server : m_servers)
+  {
+    if (server.m_chunkIndex != SERVER_READY)
+      continue;
+    if (!server.IsMeasured())
+      return &server;
+    if (best == nullptr ||
+        server.ExpectedTime(m_initialChunkSize) < best->ExpectedTime(m_initialChunkSize))
+    {
+      best = &server;
+    }
+  }
+  return best;
+}
+
+int64_t ChunksDownloadStrategy::GetChunkSize(ServerT const & server) const
+{
+  if (m_initialChunkSize == 0)
+    return 0;
+  if (!server.IsMeasured())
+    return m_initialChunkSize;
+
+  double const time = max(kChunkTime, kChunkLatencies * server.m_latency);
+  int64_t const size = static_cast<int64_t>(server.m_throughput * time);
+  return base::clamp(size, max(m_initialChunkSize / kChunkSizeRatio, int64_t(1)),
+                   m_initialChunkSize * kChunkSizeRatio);
+}
+
+void ChunksDownloadStrategy::FitChunk(size_t index, int64_t size)
+{
+  if (size <= 0)
+    return;
+
+  int64_t const pos = m_chunks[index].m_pos;
+
+  // Merge the following free chunks while they fit into |size|.
+  size_t next = index + 1;
+  while (m_chunks[next].m_status == CHUNK_FREE && m_chunks[next + 1].m_pos - pos <= size)
+    ++next;
+  if (next > index + 1)
+  {
+    m_chunks.erase(m_chunks.begin() + index + 1, m_chunks.begin() + next);
+    ShiftChunkIndices(index, -static_cast<int>(next - index - 1));
+  }
+
+  // Split the chunk if it's too big, the rest of it remains free.
+  if (m_chunks[index + 1].m_pos - pos > size + size / 2)
+  {
+    m_chunks.insert(m_chunks.begin() + index + 1, ChunkT(pos + size, CHUNK_FREE));
+    ShiftChunkIndices(index, 1);
+  }
+}
+
+void ChunksDownloadStrategy::ShiftChunkIndices(size_t index, int delta)
+{
+  for (auto & server : m_servers)
+  {
+    if (server.m_chunkIndex != SERVER_READY && server.m_chunkIndex > static_cast<int>(index))
+      server.m_chunkIndex += delta;
+  }
+}
+
+void ChunksDownloadStrategy::AssignChunk(ServerT & server, size_t index, string & outUrl,
+                                         RangeT & range)
+{
+  server.m_chunkIndex = static_cast<int>(index);
+  server.m_chunkStartTime = Now();
+  server.m_firstByteTime = -1.0;
+  server.m_chunkDownloaded = 0;
+  outUrl = server.m_url;
+
+  range.first = m_chunks[index].m_pos;
+  range.second = m_chunks[index + 1].m_pos - 1;
+
+  m_chunks[index].m_status = CHUNK_DOWNLOADING;
+}
+
+bool ChunksDownloadStrategy::StealChunk(string & outUrl, RangeT & range)
+{
+  // The fastest free server with measurements.
+  ServerT * fast = nullptr;
+  for (auto & server : m_servers)
+  {
+    if (server.m_chunkIndex != SERVER_READY || !server.IsMeasured())
+      continue;
+    if (fast == nullptr ||
+        server.ExpectedTime(m_initialChunkSize) < fast->ExpectedTime(m_initialChunkSize))
+    {
+      fast = &server;
+    }
+  }
+  if (fast == nullptr)
+    return false;
+
+  double const now = Now();
+  ServerT * slow = nullptr;
+  double maxGain = 0.0;
+  for (auto & server : m_servers)
+  {
+    if (server.m_chunkIndex == SERVER_READY || now - server.m_chunkStartTime < kMinStealTime)
+      continue;
+
+    size_t const index = static_cast<size_t>(server.m_chunkIndex);
+    int64_t const size = m_chunks[index + 1].m_pos - m_chunks[index].m_pos;
+
+    // Remaining time of the current server is estimated by its speed on this chunk.
+    double remainingTime = numeric_limits<double>::max();
+    if (server.m_chunkDownloaded > 0)
+    {
+      double const speed =
+          server.m_chunkDownloaded / max(now - server.m_firstByteTime, kMinMeasureTime);
+      remainingTime = (size - server.m_chunkDownloaded) / speed;
+    }
+
+    double const fastTime = fast->ExpectedTime(size);
+    if (remainingTime > kStealSpeedup * fastTime && remainingTime - fastTime > maxGain)
+    {
+      slow = &server;
+      maxGain = remainingTime - fastTime;
+    }
+  }
+  if (slow == nullptr)
+    return false;
+
+  size_t const index = static_cast<size_t>(slow->m_chunkIndex);
+  LOG(LDEBUG, ("Chunk", index, "is moved from", slow->m_url, "to", fast->m_url));
+
+  // Measurements of the slow server are updated with its partial results.
+  if (slow->m_chunkDownloaded > 0)
+  {
+    slow->m_throughput = Smooth(slow->m_throughput, slow->m_chunkDownloaded /
+                                max(now - slow->m_firstByteTime, kMinMeasureTime));
+  }
+  else
+  {
+    // A server which hasn't sent a single byte is considered very slow.
+    slow->m_latency = Smooth(slow->m_latency, now - slow->m_chunkStartTime);
+    if (!slow->IsMeasured())
+      slow->m_throughput = 1.0;
+  }
+  slow->m_chunkIndex = SERVER_READY;
+
+  AssignChunk(*fast, index, outUrl, range);
+  return true;
+}
+
+void ChunksDownloadStrategy::UpdateMeasurements(ServerT & server, int64_t chunkSize)
+{
+  double const now = Now();
+  double latency = 0.0;
+  if (server.m_firstByteTime >= 0.0)
+    latency = server.m_firstByteTime - server.m_chunkStartTime;
+  double const transferTime = max(now - server.m_chunkStartTime - latency, kMinMeasureTime);
+
+  server.m_latency = Smooth(server.m_latency, latency);
+  server.m_throughput = Smooth(server.m_throughput, chunkSize / transferTime);
+}
+
+void ChunksDownloadStrategy::ChunkReceived(int64_t offset, int64_t size)
+{
+  auto const it = upper_bound(m_chunks.begin(), m_chunks.end(), offset, LessChunks());
+  if (it == m_chunks.begin())
+    return;
+
+  ServerT * server = GetServerByChunk(static_cast<int>(distance(m_chunks.begin(), it) - 1));
+  if (server == nullptr)
+    return;
+
+  if (server->m_firstByteTime < 0.0)
+    server->m_firstByteTime = Now();
+  server->m_chunkDownloaded += size;
+}
+
+int64_t ChunksDownloadStrategy::GetCompletePrefixSize() const
+{
+  for (size_t i = 0; i + 1 < m_chunks.size(); ++i)
+  {
+    if (m_chunks[i].m_status != CHUNK_COMPLETE)
+      return m_chunks[i].m_pos;
+  }
+  return m_chunks.empty() ? 0 : m_chunks.back().m_pos;
+}
+
 void ChunksDownloadStrategy::InitChunks(int64_t fileSize, int64_t chunkSize, ChunkStatusT status)
 {
+  m_initialChunkSize = chunkSize;
   m_chunks.reserve(fileSize / chunkSize + 2);
   for (int64_t i = 0; i < fileSize; i += chunkSize)
     m_chunks.push_back(ChunkT(i, status));
@@ -105,6 +333,7 @@ int64_t ChunksDownloadStrategy::LoadOrInitChunks(string const & fName, int64_t f
 
       m_chunks.resize(count);
       src.Read(&m_chunks[0], stSize * count);
+      m_initialChunkSize = chunkSize;
 
       // Reset status "downloading" to "free".
       int64_t downloadedSize = 0;
@@ -142,6 +371,8 @@ string ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range)
         url = m_servers[s].m_url;
         if (success)
         {
+          UpdateMeasurements(m_servers[s], range.second - range.first + 1);
+
           // mark server as free and chunk as ready
           m_servers[s].m_chunkIndex = SERVER_READY;
           res.first->m_status = CHUNK_COMPLETE;
@@ -168,16 +399,7 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
   if (m_servers.empty())
     return EDownloadFailed;
 
-  // Find first free server.
-  ServerT * server = 0;
-  for (size_t i = 0; i < m_servers.size(); ++i)
-  {
-    if (m_servers[i].m_chunkIndex == SERVER_READY)
-    {
-      server = &m_servers[i];
-      break;
-    }
-  }
+  ServerT * server = GetBestFreeServer();
   if (server == 0)
     return ENoFreeServers;
 
@@ -189,13 +411,8 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
     switch (m_chunks[i].m_status)
     {
     case CHUNK_FREE:
-      server->m_chunkIndex = static_cast<int>(i);
-      outUrl = server->m_url;
-
-      range.first = m_chunks[i].m_pos;
-      range.second = m_chunks[i+1].m_pos - 1;
-
-      m_chunks[i].m_status = CHUNK_DOWNLOADING;
+      FitChunk(i, GetChunkSize(*server));
+      AssignChunk(*server, i, outUrl, range);
       return ENextChunk;
 
     case CHUNK_DOWNLOADING:
@@ -204,7 +421,10 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
     }
   }
 
-  return (allChunksDownloaded ? EDownloadSucceeded : ENoFreeServers);
+  if (allChunksDownloaded)
+    return EDownloadSucceeded;
+
+  return StealChunk(outUrl, range) ? ENextChunk : ENoFreeServers;
 }
 
 } // namespace downloader
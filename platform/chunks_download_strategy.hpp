@@ -1,5 +1,7 @@
 #pragma once
 
+#include "base/timer.hpp"
+
 #include "std/string.hpp"
 #include "std/vector.hpp"
 #include "std/utility.hpp"
@@ -10,6 +12,9 @@ namespace downloader
 {
 
 /// Single-threaded code
+/// Chunks grow on fast servers and shrink on slow ones, so that a chunk takes about the same
+/// time on every server. Free servers are ordered by measured throughput and latency, and a
+/// fast free server takes over a chunk from a much slower one when there are no free chunks.
 class ChunksDownloadStrategy
 {
 public:
@@ -40,11 +45,33 @@ private:
     string m_url;
     int m_chunkIndex;
 
+    /// Time when the current chunk was requested and when its first byte came, in seconds.
+    double m_chunkStartTime = 0.0;
+    double m_firstByteTime = -1.0;
+    /// Received bytes of the current chunk.
+    int64_t m_chunkDownloaded = 0;
+
+    /// Smoothed measurements of finished chunks, zero if there are no measurements yet.
+    /// Bytes per second.
+    double m_throughput = 0.0;
+    /// Seconds before the first byte.
+    double m_latency = 0.0;
+
     ServerT(string const & url, int ind) : m_url(url), m_chunkIndex(ind) {}
+
+    bool IsMeasured() const { return m_throughput > 0.0; }
+    /// @return Expected time to download |size| bytes from the server.
+    double ExpectedTime(int64_t size) const { return m_latency + size / m_throughput; }
   };
 
   vector<ServerT> m_servers;
 
+  /// Chunk size which is passed to InitChunks(). Zero means that chunks are not adapted.
+  int64_t m_initialChunkSize = 0;
+
+  base::Timer m_timer;
+  double m_timeForTesting = -1.0;
+
   struct LessChunks
   {
     bool operator() (ChunkT const & r1, ChunkT const & r2) const { return r1.m_pos < r2.m_pos; }
@@ -57,6 +84,27 @@ private:
   /// @return Chunk pointer and it's index for given file offsets range.
   pair<ChunkT *, int> GetChunk(RangeT const & range);
 
+  double Now() const;
+
+  /// @return Server which is downloading chunk |chunkIndex| or nullptr.
+  ServerT * GetServerByChunk(int chunkIndex);
+  /// @return Free server which should be used first or nullptr.
+  /// Servers without measurements go first to get them measured.
+  ServerT * GetBestFreeServer();
+  /// @return Chunk size which takes about the same time on |server|, or zero if chunks
+  /// should not be adapted.
+  int64_t GetChunkSize(ServerT const & server) const;
+  /// Merges free chunks following chunk |index| or splits it to make its size close to |size|.
+  void FitChunk(size_t index, int64_t size);
+  /// Shifts indices of downloading chunks after |index| by |delta| when chunks are merged or split.
+  void ShiftChunkIndices(size_t index, int delta);
+
+  void AssignChunk(ServerT & server, size_t index, string & outUrl, RangeT & range);
+  /// Moves a chunk from a much slower server to a free fast one.
+  /// @return true if a chunk was moved and should be requested with |outUrl| and |range|.
+  bool StealChunk(string & outUrl, RangeT & range);
+  void UpdateMeasurements(ServerT & server, int64_t chunkSize);
+
 public:
   ChunksDownloadStrategy(vector<string> const & urls);
 
@@ -66,6 +114,9 @@ public:
   /// Used in unit tests only!
   void AddChunk(RangeT const & range, ChunkStatusT status);
 
+  /// Should be called for every received part of a chunk.
+  void ChunkReceived(int64_t offset, int64_t size);
+
   void SaveChunks(int64_t fileSize, string const & fName);
   /// @return Already downloaded size.
   int64_t LoadOrInitChunks(string const & fName, int64_t fileSize, int64_t chunkSize);
@@ -76,6 +127,9 @@ public:
 
   size_t ActiveServersCount() const { return m_servers.size(); }
 
+  /// @return Size of the downloaded part at the beginning of the file.
+  int64_t GetCompletePrefixSize() const;
+
   enum ResultT
   {
     ENextChunk,
@@ -84,7 +138,12 @@ public:
     EDownloadSucceeded
   };
   /// Should be called until returns ENextChunk
+  /// @note Returned |range| may be already requested from a slower server, in that case
+  /// the old request should be cancelled.
   ResultT NextChunk(string & outUrl, RangeT & range);
+
+  /// Used in unit tests only! Sets current time in seconds.
+  void SetTimeForTesting(double seconds) { m_timeForTesting = seconds; }
 };
 
 } // namespace downloader
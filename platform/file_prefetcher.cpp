@@ -0,0 +1,130 @@
+#include "platform/file_prefetcher.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/target_os.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID) || defined(OMIM_OS_MAC) || \
+    defined(OMIM_OS_IPHONE)
+#define OMIM_FILE_PREFETCHER_ADVISE
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+void ReadAhead(string const & filePath, uint64_t offset, uint64_t size)
+{
+#ifdef OMIM_FILE_PREFETCHER_ADVISE
+  int const fd = open(filePath.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+
+#if defined(OMIM_OS_MAC) || defined(OMIM_OS_IPHONE)
+  // F_RDADVISE takes an int count, so large ranges are advised by parts.
+  uint64_t constexpr kMaxCount = numeric_limits<int>::max() / 2;
+  for (uint64_t pos = offset; pos < offset + size; pos += kMaxCount)
+  {
+    radvisory advice;
+    advice.ra_offset = static_cast<off_t>(pos);
+    advice.ra_count = static_cast<int>(min(kMaxCount, offset + size - pos));
+    if (fcntl(fd, F_RDADVISE, &advice) == -1)
+      break;
+  }
+#else
+  UNUSED_VALUE(posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(size),
+                             POSIX_FADV_WILLNEED));
+#endif
+
+  close(fd);
+#else
+  try
+  {
+    base::FileData file(filePath, base::FileData::OP_READ);
+    vector<char> buffer(1024 * 1024);
+    for (uint64_t pos = offset; pos < offset + size; pos += buffer.size())
+    {
+      auto const toRead = static_cast<size_t>(min<uint64_t>(buffer.size(), offset + size - pos));
+      file.Read(pos, buffer.data(), toRead);
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LDEBUG, ("Can't prefetch", filePath, e.Msg()));
+  }
+#endif
+}
+}  // namespace
+
+namespace platform
+{
+FilePrefetcher::FilePrefetcher() = default;
+
+FilePrefetcher::~FilePrefetcher() { m_thread.ShutdownAndJoin(); }
+
+void FilePrefetcher::Prefetch(string const & filePath, uint64_t offset, uint64_t size)
+{
+  if (size == 0)
+    return;
+  m_thread.Push([filePath, offset, size] { ReadAhead(filePath, offset, size); });
+}
+
+void FilePrefetcher::PrefetchSections(string const & filePath, vector<string> const & tags)
+{
+  vector<string> newTags;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    for (auto const & tag : tags)
+    {
+      if (m_pending.emplace(filePath, tag).second)
+        newTags.push_back(tag);
+    }
+  }
+
+  if (newTags.empty())
+    return;
+
+  bool const pushed = m_thread.Push([this, filePath, newTags] {
+    PrefetchSectionsImpl(filePath, newTags);
+  });
+
+  if (!pushed)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    for (auto const & tag : newTags)
+      m_pending.erase(Section(filePath, tag));
+  }
+}
+
+void FilePrefetcher::PrefetchSectionsImpl(string const & filePath, vector<string> const & tags)
+{
+  try
+  {
+    // Only the table of contents is read here, readers of the file have their own handles.
+    FilesContainerR const container(filePath);
+    for (auto const & tag : tags)
+    {
+      if (!container.IsExist(tag))
+        continue;
+      auto const offsetAndSize = container.GetAbsoluteOffsetAndSize(tag);
+      ReadAhead(filePath, offsetAndSize.first, offsetAndSize.second);
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LDEBUG, ("Can't prefetch", filePath, e.Msg()));
+  }
+
+  lock_guard<mutex> lock(m_mutex);
+  for (auto const & tag : tags)
+    m_pending.erase(Section(filePath, tag));
+}
+}  // namespace platform
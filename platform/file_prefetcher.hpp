@@ -0,0 +1,47 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/worker_thread.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace platform
+{
+// Reads parts of files into the page cache of the OS in background, so the following reads
+// of them by readers don't wait for the disk. Reads are only started with
+// posix_fadvise(POSIX_FADV_WILLNEED) on Linux and Android and with fcntl(F_RDADVISE) on Apple
+// platforms. On other platforms the data is read and dropped.
+//
+// *NOTE* Prefetch* methods are thread-safe and return immediately. Errors are ignored
+// because prefetching is only a hint.
+class FilePrefetcher
+{
+public:
+  FilePrefetcher();
+  ~FilePrefetcher();
+
+  void Prefetch(std::string const & filePath, uint64_t offset, uint64_t size);
+
+  // Prefetches sections of the container |filePath| with |tags|, absent sections are skipped.
+  // Sections which are being prefetched are not requested again.
+  void PrefetchSections(std::string const & filePath, std::vector<std::string> const & tags);
+
+private:
+  using Section = std::pair<std::string, std::string>;
+
+  void PrefetchSectionsImpl(std::string const & filePath, std::vector<std::string> const & tags);
+
+  std::mutex m_mutex;
+  // File path and tag of sections which are being prefetched.
+  std::set<Section> m_pending;
+
+  base::WorkerThread m_thread;
+
+  DISALLOW_COPY_AND_MOVE(FilePrefetcher);
+};
+}  // namespace platform
@@ -38,6 +38,7 @@ extern NSString * gBrowserUserAgent;
 #include "base/logging.hpp"
 
 @interface Connection: NSObject<NSURLSessionDelegate>
++ (NSURLSession *)session;
 + (nullable NSData *)sendSynchronousRequest:(NSURLRequest *)request
                           returningResponse:(NSURLResponse **)response
                                       error:(NSError **)error;
@@ -45,30 +46,35 @@ extern NSString * gBrowserUserAgent;
 
 @implementation Connection
 
-+ (NSData *)sendSynchronousRequest:(NSURLRequest *)request
-                 returningResponse:(NSURLResponse * __autoreleasing *)response
-                             error:(NSError * __autoreleasing *)error
++ (NSURLSession *)session
 {
-  Connection * connection = [[Connection alloc] init];
-  return [connection sendSynchronousRequest:request returningResponse:response error:error];
+  static NSURLSession * session = nil;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    // All requests share a single session, so connections to the same hosts are kept alive
+    // and reused, and requests to HTTP/2 servers are multiplexed over one connection.
+    // A session retains its delegate, so the delegate lives as long as the session.
+    session = [NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration ephemeralSessionConfiguration]
+                                            delegate:[[Connection alloc] init]
+                                       delegateQueue:nil];
+  });
+  return session;
 }
 
-- (NSData *)sendSynchronousRequest:(NSURLRequest *)request
++ (NSData *)sendSynchronousRequest:(NSURLRequest *)request
                  returningResponse:(NSURLResponse * __autoreleasing *)response
                              error:(NSError * __autoreleasing *)error
 {
-  NSURLSession * session = [NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration ephemeralSessionConfiguration]
-                                                        delegate:self
-                                                   delegateQueue:nil];
   __block NSData * resultData = nil;
   __block NSURLResponse * resultResponse = nil;
   __block NSError * resultError = nil;
 
   dispatch_group_t group = dispatch_group_create();
   dispatch_group_enter(group);
-  [[session dataTaskWithRequest:request completionHandler:^(NSData * _Nullable data,
-                                                            NSURLResponse * _Nullable response,
-                                                            NSError * _Nullable error)
+  [[[Connection session] dataTaskWithRequest:request
+                           completionHandler:^(NSData * _Nullable data,
+                                               NSURLResponse * _Nullable response,
+                                               NSError * _Nullable error)
   {
     resultData = data;
     resultResponse = response;
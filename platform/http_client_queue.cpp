@@ -0,0 +1,87 @@
+#include "platform/http_client_queue.hpp"
+
+#include "base/assert.hpp"
+#include "base/thread.hpp"
+
+#include <utility>
+
+using namespace std;
+
+namespace platform
+{
+class HttpClientQueue::Routine : public threads::IRoutine
+{
+public:
+  Routine(unique_ptr<HttpClient> request, Completion const & completion)
+    : m_request(move(request)), m_completion(completion)
+  {
+  }
+
+  // threads::IRoutine overrides:
+  void Do() override
+  {
+    m_result = m_request->RunHttpRequest() ? Result::Success : Result::Failure;
+  }
+
+  void Complete()
+  {
+    if (m_completion)
+      m_completion(*m_request, m_result);
+  }
+
+private:
+  unique_ptr<HttpClient> m_request;
+  Completion m_completion;
+  // Stays Cancelled when the pool doesn't run the routine.
+  Result m_result = Result::Cancelled;
+};
+
+HttpClientQueue::HttpClientQueue(size_t threadsCount)
+  : m_pool(threadsCount, [](threads::IRoutine * routine) {
+    unique_ptr<Routine> r(static_cast<Routine *>(routine));
+    r->Complete();
+  })
+{
+  ASSERT_GREATER(threadsCount, 0, ());
+}
+
+HttpClientQueue::~HttpClientQueue() { Stop(); }
+
+void HttpClientQueue::Push(unique_ptr<HttpClient> request, Completion const & completion)
+{
+  CHECK(request, ());
+  auto routine = make_unique<Routine>(move(request), completion);
+  {
+    lock_guard<mutex> lock(m_mutex);
+    // Routines pushed before Stop() are either run or cancelled by the pool.
+    if (!m_stopped)
+    {
+      m_pool.PushBack(routine.release());
+      return;
+    }
+  }
+  routine->Complete();
+}
+
+void HttpClientQueue::Stop()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_stopped)
+      return;
+    m_stopped = true;
+  }
+  m_pool.Stop();
+}
+
+string DebugPrint(HttpClientQueue::Result result)
+{
+  switch (result)
+  {
+  case HttpClientQueue::Result::Success: return "Success";
+  case HttpClientQueue::Result::Failure: return "Failure";
+  case HttpClientQueue::Result::Cancelled: return "Cancelled";
+  }
+  CHECK_SWITCH();
+}
+}  // namespace platform
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "platform/http_client.hpp"
+
+#include "base/macros.hpp"
+#include "base/thread_pool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace platform
+{
+// Runs HttpClient requests asynchronously on a fixed number of threads. Platform
+// implementations of HttpClient share connections to the same hosts, so a few threads are
+// enough to run many small requests without opening a connection per request.
+//
+// *NOTE* Completions are called on the threads of the queue. Requests which are not started
+// when the queue is stopped are completed with Result::Cancelled on the stopping thread.
+class HttpClientQueue
+{
+public:
+  enum class Result
+  {
+    // HttpClient::RunHttpRequest() returned true, check HttpClient::ErrorCode().
+    Success,
+    // HttpClient::RunHttpRequest() returned false.
+    Failure,
+    // The request was not run.
+    Cancelled
+  };
+
+  using Completion = std::function<void(HttpClient & request, Result result)>;
+
+  explicit HttpClientQueue(size_t threadsCount);
+  ~HttpClientQueue();
+
+  // Requests are run in the order they are pushed, up to |threadsCount| at once.
+  void Push(std::unique_ptr<HttpClient> request, Completion const & completion);
+
+  // Waits for running requests and cancels pending ones. Requests pushed after Stop() are
+  // cancelled immediately.
+  void Stop();
+
+private:
+  class Routine;
+
+  std::mutex m_mutex;
+  bool m_stopped = false;
+  threads::ThreadPool m_pool;
+
+  DISALLOW_COPY_AND_MOVE(HttpClientQueue);
+};
+
+std::string DebugPrint(HttpClientQueue::Result result);
+}  // namespace platform
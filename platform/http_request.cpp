@@ -11,11 +11,13 @@
 
 #include "coding/internal/file_data.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/sha1.hpp"
 
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
 
 #include "std/list.hpp"
+#include "std/map.hpp"
 #include "std/unique_ptr.hpp"
 
 #include "3party/Alohalytics/src/alohalytics.h"
@@ -137,6 +139,22 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
   size_t m_goodChunksCount;
   bool m_doCleanProgressFiles;
 
+  /// SHA1 of the file is calculated while chunks arrive, so the file is not read again
+  /// when the download is finished. Data of a chunk is kept in memory until the chunk is
+  /// finished, and finished chunks are kept until all the preceding data is hashed.
+  struct ChunkData
+  {
+    string m_data;
+    bool m_isValid = true;
+  };
+  /// Begin of a chunk -> data of the chunk.
+  map<int64_t, ChunkData> m_receivedChunks;
+  map<int64_t, string> m_finishedChunks;
+  size_t m_finishedChunksSize = 0;
+  coding::SHA1 m_sha1;
+  int64_t m_hashedSize = 0;
+  string m_sha1Base64;
+
   ChunksDownloadStrategy::ResultT StartThreads()
   {
     string url;
@@ -144,6 +162,11 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     ChunksDownloadStrategy::ResultT result;
     while ((result = m_strategy.NextChunk(url, range)) == ChunksDownloadStrategy::ENextChunk)
     {
+      // The chunk is moved from a slower server, cancel its request.
+      if (find_if(m_threads.begin(), m_threads.end(), ThreadByPos(range.first)) != m_threads.end())
+        RemoveHttpThreadByKey(range.first);
+
+      m_receivedChunks[range.first] = ChunkData();
       HttpThread * p = CreateNativeHttpThread(url, *this, range.first, range.second, m_progress.second);
       ASSERT ( p, () );
       m_threads.push_back(make_pair(p, range.first));
@@ -187,6 +210,8 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     {
       m_writer->Seek(offset);
       m_writer->Write(buffer, size);
+      m_strategy.ChunkReceived(offset, size);
+      SaveChunkData(offset, buffer, size);
       return true;
     }
     catch (Writer::Exception const & e)
@@ -196,6 +221,106 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     }
   }
 
+  void SaveChunkData(int64_t offset, void const * buffer, size_t size)
+  {
+    auto it = m_receivedChunks.upper_bound(offset);
+    if (it == m_receivedChunks.begin())
+      return;
+    ChunkData & chunk = (--it)->second;
+    if (!chunk.m_isValid)
+      return;
+
+    // Data of a chunk is expected to arrive sequentially, otherwise the chunk is read from
+    // the file after the download is finished.
+    if (it->first + static_cast<int64_t>(chunk.m_data.size()) != offset)
+    {
+      chunk.m_isValid = false;
+      chunk.m_data.clear();
+      chunk.m_data.shrink_to_fit();
+      return;
+    }
+    chunk.m_data.append(static_cast<char const *>(buffer), size);
+  }
+
+  void OnChunkDataFinished(int64_t begRange, bool isChunkOk)
+  {
+    auto const it = m_receivedChunks.find(begRange);
+    if (it == m_receivedChunks.end())
+      return;
+
+    ChunkData chunk = move(it->second);
+    m_receivedChunks.erase(it);
+    if (!isChunkOk || !chunk.m_isValid)
+      return;
+
+    if (begRange != m_hashedSize)
+    {
+      // Finished chunks which can't be hashed yet are dropped above the limit and read from
+      // the file after the download is finished.
+      size_t constexpr kMaxFinishedChunksSize = 16 * 1024 * 1024;
+      if (begRange > m_hashedSize &&
+          m_finishedChunksSize + chunk.m_data.size() <= kMaxFinishedChunksSize)
+      {
+        m_finishedChunksSize += chunk.m_data.size();
+        m_finishedChunks[begRange] = move(chunk.m_data);
+      }
+      return;
+    }
+
+    m_sha1.Update(chunk.m_data.data(), chunk.m_data.size());
+    m_hashedSize += chunk.m_data.size();
+
+    while (!m_finishedChunks.empty() && m_finishedChunks.begin()->first == m_hashedSize)
+    {
+      string const & data = m_finishedChunks.begin()->second;
+      m_sha1.Update(data.data(), data.size());
+      m_hashedSize += data.size();
+      m_finishedChunksSize -= data.size();
+      m_finishedChunks.erase(m_finishedChunks.begin());
+    }
+  }
+
+  /// Hashes the part of the downloading file which is not hashed yet up to |size|.
+  bool HashFile(int64_t size)
+  {
+    if (m_hashedSize >= size)
+      return true;
+
+    try
+    {
+      base::FileData file(m_filePath + DOWNLOADING_FILE_EXTENSION, base::FileData::OP_READ);
+      vector<char> buffer(64 * 1024);
+      while (m_hashedSize < size)
+      {
+        auto const toRead = static_cast<size_t>(
+            min(static_cast<int64_t>(buffer.size()), size - m_hashedSize));
+        file.Read(m_hashedSize, buffer.data(), toRead);
+        m_sha1.Update(buffer.data(), toRead);
+        m_hashedSize += toRead;
+      }
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG(LWARNING, ("Can't hash", m_filePath, e.Msg()));
+      return false;
+    }
+    return true;
+  }
+
+  void FinishSha1()
+  {
+    m_receivedChunks.clear();
+    m_finishedChunks.clear();
+    m_finishedChunksSize = 0;
+
+    int64_t const streamedSize = m_hashedSize;
+    if (!HashFile(m_progress.second))
+      return;
+    if (streamedSize != m_progress.second)
+      LOG(LINFO, (m_progress.second - streamedSize, "bytes of", m_filePath, "are hashed from the file"));
+    m_sha1Base64 = coding::SHA1::EncodeBase64(m_sha1.Final());
+  }
+
   void SaveResumeChunks()
   {
     try
@@ -219,8 +344,13 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     ASSERT_EQUAL(id, threads::GetCurrentThreadID(), ("OnFinish called from different threads"));
 #endif
 
+    // The request was cancelled because its chunk had been moved to a faster server.
+    if (find_if(m_threads.begin(), m_threads.end(), ThreadByPos(begRange)) == m_threads.end())
+      return;
+
     bool const isChunkOk = (httpOrErrorCode == 200);
     string const urlError = m_strategy.ChunkFinished(isChunkOk, make_pair(begRange, endRange));
+    OnChunkDataFinished(begRange, isChunkOk);
 
     // remove completed chunk from the list, beg is the key
     RemoveHttpThreadByKey(begRange);
@@ -269,6 +399,7 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     // 3. Clean up resume file with chunks range on success
     if (m_status == Status::Completed)
     {
+      FinishSha1();
       base::DeleteFileX(m_filePath + RESUME_FILE_EXTENSION);
 
       // Rename finished file to it's original name.
@@ -324,6 +455,10 @@ public:
         m_strategy.InitChunks(fileSize, chunkSize);
     }
 
+    // Downloaded part of the file is hashed once, the rest is hashed while it's downloaded.
+    if (openMode == FileWriter::OP_WRITE_EXISTING)
+      HashFile(m_strategy.GetCompletePrefixSize());
+
     // Create file and reserve needed size.
     unique_ptr<FileWriter> writer(new FileWriter(filePath + DOWNLOADING_FILE_EXTENSION, openMode));
     // Reserving disk space is very slow on a device.
@@ -363,6 +498,11 @@ public:
   {
     return m_filePath;
   }
+
+  virtual string const & GetSha1Base64() const
+  {
+    return m_sha1Base64;
+  }
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -376,6 +516,12 @@ HttpRequest::~HttpRequest()
 {
 }
 
+string const & HttpRequest::GetSha1Base64() const
+{
+  static string const kEmpty;
+  return kEmpty;
+}
+
 HttpRequest * HttpRequest::Get(string const & url, Callback const & onFinish, Callback const & onProgress)
 {
   return new MemoryHttpRequest(url, onFinish, onProgress);
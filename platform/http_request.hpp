@@ -49,6 +49,9 @@ public:
   Progress const & GetProgress() const { return m_progress; }
   /// Either file path (for chunks) or downloaded data
   virtual string const & GetData() const = 0;
+  /// Base64 encoded SHA1 of the downloaded file. It's calculated while the file is downloaded,
+  /// so it's available right after the download is completed. Empty for other requests.
+  virtual string const & GetSha1Base64() const;
 
   /// Response saved to memory buffer and retrieved with Data()
   static HttpRequest * Get(string const & url,
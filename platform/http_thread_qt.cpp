@@ -11,6 +11,7 @@
 #include <QNetworkRequest>
 #include <QSslError>
 #include <QUrl>
+#include <QtGlobal>
 
 HttpThread::HttpThread(string const & url,
                        downloader::IHttpThreadCallback & cb,
@@ -48,6 +49,12 @@ HttpThread::HttpThread(string const & url,
     request.setRawHeader("User-Agent", uid.c_str());
   }
 
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+  // Chunks of a file are requested from the same hosts, so they are multiplexed over a single
+  // connection when a server supports HTTP/2.
+  request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+#endif
+
   /// Use single instance for whole app
   static QNetworkAccessManager netManager;
 
@@ -307,6 +307,7 @@ void Platform::ShutdownThreads()
   m_networkThread.reset();
   m_fileThread.reset();
   m_backgroundThread.reset();
+  m_filePrefetcher.reset();
 }
 
 void Platform::RunThreads()
@@ -315,6 +316,7 @@ void Platform::RunThreads()
   m_networkThread = make_unique<base::WorkerThread>();
   m_fileThread = make_unique<base::WorkerThread>();
   m_backgroundThread = make_unique<base::WorkerThread>();
+  m_filePrefetcher = make_unique<platform::FilePrefetcher>();
 }
 
 string DebugPrint(Platform::EError err)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "platform/country_defines.hpp"
+#include "platform/file_prefetcher.hpp"
 #include "platform/gui_thread.hpp"
 #include "platform/http_user_agent.hpp"
 #include "platform/marketing_service.hpp"
@@ -131,6 +132,8 @@ protected:
   std::unique_ptr<base::WorkerThread> m_fileThread;
   std::unique_ptr<base::WorkerThread> m_backgroundThread;
 
+  std::unique_ptr<platform::FilePrefetcher> m_filePrefetcher;
+
 public:
   Platform();
   virtual ~Platform() = default;
@@ -231,6 +234,9 @@ public:
   /// @return false if file is not exist
   /// @note Try do not use in client production code
   static bool GetFileSizeByFullPath(std::string const & filePath, uint64_t & size);
+  /// @return false if file is not exist
+  static bool GetFileModificationTimeByFullPath(std::string const & filePath,
+                                                uint64_t & secondsSinceEpoch);
   //@}
 
   /// Used to check available free storage space for downloading.
@@ -291,6 +297,9 @@ public:
   platform::HttpUserAgent & GetAppUserAgent() { return m_appUserAgent; }
   platform::HttpUserAgent const & GetAppUserAgent() const { return m_appUserAgent; }
 
+  /// \returns nullptr when platform threads are not run.
+  platform::FilePrefetcher * GetFilePrefetcher() { return m_filePrefetcher.get(); }
+
   /// \brief Placing an executable object |task| on a queue of |thread|. Then the object will be
   /// executed on |thread|.
   /// \note |task| cannot be moved in case of |Thread::Gui|. This way unique_ptr cannot be used
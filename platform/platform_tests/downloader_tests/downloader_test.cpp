@@ -9,6 +9,7 @@
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/sha1.hpp"
 
 #include "base/logging.hpp"
 #include "base/std_serialization.hpp"
@@ -333,6 +334,84 @@ UNIT_TEST(ChunksDownloadStrategyFAIL)
   TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::EDownloadFailed, ());
 }
 
+UNIT_TEST(ChunksDownloadStrategyAdaptive)
+{
+  string const S1 = "UrlOfServer1";
+  string const S2 = "UrlOfServer2";
+
+  typedef pair<int64_t, int64_t> RangeT;
+
+  int64_t const FILE_SIZE = 8000;
+  int64_t const CHUNK_SIZE = 1000;
+
+  {
+    // The fast server gets all the rest of the file and then takes over the chunk
+    // of the slow one.
+    ChunksDownloadStrategy strategy({S1, S2});
+    strategy.InitChunks(FILE_SIZE, CHUNK_SIZE);
+    strategy.SetTimeForTesting(0.0);
+
+    string s1, s2;
+    RangeT r1, r2;
+    TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+    TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
+    TEST_EQUAL(s1, S1, ());
+    TEST_EQUAL(r1, RangeT(0, 999), ());
+    TEST_EQUAL(s2, S2, ());
+    TEST_EQUAL(r2, RangeT(1000, 1999), ());
+
+    strategy.SetTimeForTesting(0.1);
+    strategy.ChunkReceived(0, 1000);
+    strategy.SetTimeForTesting(0.2);
+    TEST_EQUAL(strategy.ChunkFinished(true, r1), S1, ());
+
+    TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+    TEST_EQUAL(s1, S1, ());
+    TEST_EQUAL(r1, RangeT(2000, 7999), ());
+
+    strategy.SetTimeForTesting(0.3);
+    strategy.ChunkReceived(2000, 6000);
+    strategy.SetTimeForTesting(0.9);
+    TEST_EQUAL(strategy.ChunkFinished(true, r1), S1, ());
+
+    strategy.SetTimeForTesting(1.0);
+    strategy.ChunkReceived(1000, 10);
+    string sEmpty;
+    RangeT rEmpty;
+    TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+
+    strategy.SetTimeForTesting(4.0);
+    TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+    TEST_EQUAL(s1, S1, ());
+    TEST_EQUAL(r1, r2, ());
+    TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+
+    strategy.SetTimeForTesting(4.5);
+    TEST_EQUAL(strategy.ChunkFinished(true, r1), S1, ());
+    TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::EDownloadSucceeded, ());
+  }
+
+  {
+    // Chunks are smaller on a slow server.
+    ChunksDownloadStrategy strategy({S1});
+    strategy.InitChunks(FILE_SIZE, CHUNK_SIZE);
+    strategy.SetTimeForTesting(0.0);
+
+    string s1;
+    RangeT r1;
+    TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+    TEST_EQUAL(r1, RangeT(0, 999), ());
+
+    strategy.SetTimeForTesting(1.0);
+    strategy.ChunkReceived(0, 1000);
+    strategy.SetTimeForTesting(11.0);
+    TEST_EQUAL(strategy.ChunkFinished(true, r1), S1, ());
+
+    TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+    TEST_EQUAL(r1, RangeT(1000, 1499), ());
+  }
+}
+
 namespace
 {
   string ReadFileAsString(string const & file)
@@ -454,6 +533,7 @@ UNIT_TEST(DownloadChunks)
     QCoreApplication::exec();
 
     observer.TestOk();
+    TEST_EQUAL(request->GetSha1Base64(), coding::SHA1::CalculateBase64(FILENAME), ());
 
     FinishDownloadSuccess(FILENAME);
   }
@@ -582,6 +662,7 @@ UNIT_TEST(DownloadResumeChunks)
     strategy.AddChunk(make_pair(beg1, end1), ChunksDownloadStrategy::CHUNK_FREE);
     strategy.AddChunk(make_pair(end1+1, beg2-1), ChunksDownloadStrategy::CHUNK_COMPLETE);
     strategy.AddChunk(make_pair(beg2, end2), ChunksDownloadStrategy::CHUNK_FREE);
+    TEST_EQUAL(strategy.GetCompletePrefixSize(), beg1, ());
 
     strategy.SaveChunks(FILESIZE, RESUME_FILENAME);
   }
@@ -594,6 +675,7 @@ UNIT_TEST(DownloadResumeChunks)
                                                          bind(&ResumeChecker::OnProgress, &checker, _1)));
     QCoreApplication::exec();
 
+    TEST_EQUAL(request->GetSha1Base64(), coding::SHA1::CalculateBase64(FILENAME), ());
     FinishDownloadSuccess(FILENAME);
   }
 }
@@ -0,0 +1,41 @@
+#include "testing/testing.hpp"
+
+#include "platform/file_prefetcher.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <string>
+
+using namespace platform;
+using namespace std;
+
+UNIT_TEST(FilePrefetcher_Smoke)
+{
+  string const fileName = "file_prefetcher_test.tmp";
+  SCOPE_GUARD(deleteFile, [&fileName] { FileWriter::DeleteFileX(fileName); });
+
+  string const data = "some section data";
+  {
+    FilesContainerW writer(fileName);
+    FileWriter w = writer.GetWriter("section");
+    w.Write(data.data(), data.size());
+  }
+
+  {
+    FilePrefetcher prefetcher;
+    prefetcher.PrefetchSections(fileName, {"section", "absent"});
+    prefetcher.PrefetchSections(fileName, {"section"});
+    prefetcher.PrefetchSections("absent_file.tmp", {"section"});
+    prefetcher.Prefetch(fileName, 0, data.size());
+    // Pending requests are not waited for on destruction.
+  }
+
+  // Prefetching doesn't change the file.
+  FilesContainerR reader(fileName);
+  string read;
+  reader.GetReader("section").ReadAsString(read);
+  TEST_EQUAL(read, data, ());
+}
@@ -0,0 +1,36 @@
+#include "testing/testing.hpp"
+
+#include "platform/http_client.hpp"
+#include "platform/http_client_queue.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace platform;
+using namespace std;
+
+UNIT_TEST(HttpClientQueue_PushAfterStop)
+{
+  HttpClientQueue queue(2 /* threadsCount */);
+  queue.Stop();
+
+  vector<pair<string, HttpClientQueue::Result>> results;
+  for (auto const & url : {"http://localhost/0", "http://localhost/1"})
+  {
+    queue.Push(make_unique<HttpClient>(url), [&results](HttpClient & request,
+                                                        HttpClientQueue::Result result) {
+      results.emplace_back(request.UrlRequested(), result);
+    });
+  }
+
+  // Requests are cancelled on the calling thread and are never run.
+  TEST_EQUAL(results.size(), 2, ());
+  TEST_EQUAL(results[0].first, "http://localhost/0", ());
+  TEST_EQUAL(results[1].first, "http://localhost/1", ());
+  for (auto const & result : results)
+    TEST_EQUAL(result.second, HttpClientQueue::Result::Cancelled, ());
+
+  // Stop is idempotent.
+  queue.Stop();
+}
@@ -0,0 +1,72 @@
+#include "testing/testing.hpp"
+
+#include "platform/platform.hpp"
+#include "platform/string_storage_base.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <string>
+
+using namespace platform;
+using namespace std;
+
+namespace
+{
+string GetValue(StringStorageBase const & storage, string const & key)
+{
+  string value;
+  if (!storage.GetValue(key, value))
+    return "<none>";
+  return value;
+}
+}  // namespace
+
+UNIT_TEST(StringStorageBase_LogIsApplied)
+{
+  string const path = base::JoinPath(GetPlatform().WritableDir(), "string_storage_test.ini");
+  auto const deleteFiles = [&path] {
+    base::DeleteFileX(path);
+    base::DeleteFileX(path + ".log");
+  };
+  deleteFiles();
+  SCOPE_GUARD(cleanup, deleteFiles);
+
+  {
+    StringStorageBase storage(path);
+    storage.SetValue("first", "1");
+    storage.SetValue("second", "2");
+    storage.Save();
+
+    // These changes are only written to the log.
+    storage.SetValue("first", "one");
+    storage.SetValue("third", "3");
+    storage.DeleteKeyAndValue("second");
+    TEST_EQUAL(GetValue(storage, "first"), "one", ());
+    TEST_EQUAL(GetValue(storage, "second"), "<none>", ());
+  }
+
+  {
+    StringStorageBase storage(path);
+    TEST_EQUAL(GetValue(storage, "first"), "one", ());
+    TEST_EQUAL(GetValue(storage, "second"), "<none>", ());
+    TEST_EQUAL(GetValue(storage, "third"), "3", ());
+    // The log is merged into the storage file on load.
+    TEST(!Platform::IsFileExistsByFullPath(path + ".log"), ());
+
+    for (size_t i = 0; i < 1000; ++i)
+      storage.SetValue("counter", to_string(i));
+  }
+
+  {
+    StringStorageBase storage(path);
+    TEST_EQUAL(GetValue(storage, "counter"), "999", ());
+    storage.Clear();
+    TEST_EQUAL(GetValue(storage, "first"), "<none>", ());
+  }
+
+  StringStorageBase storage(path);
+  TEST_EQUAL(GetValue(storage, "first"), "<none>", ());
+}
@@ -194,6 +194,17 @@ bool Platform::GetFileSizeByFullPath(string const & filePath, uint64_t & size)
   else return false;
 }
 
+// static
+bool Platform::GetFileModificationTimeByFullPath(string const & filePath,
+                                                 uint64_t & secondsSinceEpoch)
+{
+  struct stat s;
+  if (stat(filePath.c_str(), &s) != 0)
+    return false;
+  secondsSinceEpoch = static_cast<uint64_t>(s.st_mtime);
+  return true;
+}
+
 Platform::TStorageStatus Platform::GetWritableStorageStatus(uint64_t neededSize) const
 {
   struct statfs st;
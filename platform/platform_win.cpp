@@ -210,3 +210,13 @@ bool Platform::GetFileSizeByFullPath(string const & filePath, uint64_t & size)
   }
   return false;
 }
+
+bool Platform::GetFileModificationTimeByFullPath(string const & filePath,
+                                                 uint64_t & secondsSinceEpoch)
+{
+  struct _stat64 s;
+  if (_stat64(filePath.c_str(), &s) != 0)
+    return false;
+  secondsSinceEpoch = static_cast<uint64_t>(s.st_mtime);
+  return true;
+}
@@ -1,67 +1,130 @@
-#include "string_storage_base.hpp"
+#include "platform/string_storage_base.hpp"
+
+#include "platform/platform.hpp"
 
 #include "coding/reader_streambuf.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
 
 #include "base/exception.hpp"
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <atomic>
 #include <istream>
+#include <utility>
 
 using namespace std;
 
 namespace
 {
 constexpr char kDelimChar = '=';
+// The log is merged into the storage file when it has this number of records.
+size_t constexpr kMaxLogRecordsCount = 100;
+
+// Calls |fn| for every key and value of the file |path|. Values may be empty.
+template <typename Fn>
+size_t ForEachRecord(string const & path, Fn && fn)
+{
+  ReaderStreamBuf buffer(make_unique<FileReader>(path));
+  istream stream(&buffer);
+
+  size_t count = 0;
+  string line;
+  while (getline(stream, line))
+  {
+    if (line.empty())
+      continue;
+
+    size_t const delimPos = line.find(kDelimChar);
+    if (delimPos == string::npos)
+      continue;
+
+    string key = line.substr(0, delimPos);
+    if (key.empty())
+      continue;
+
+    fn(move(key), line.substr(delimPos + 1));
+    ++count;
+  }
+  return count;
+}
 }  // namespace
 
 namespace platform
 {
-StringStorageBase::StringStorageBase(string const & path) : m_path(path)
+StringStorageBase::StringStorageBase(string const & path)
+  : m_path(path), m_logPath(path + ".log")
 {
+  LOG(LINFO, ("Settings path:", m_path));
+
+  auto values = make_shared<Container>();
   try
   {
-    LOG(LINFO, ("Settings path:", m_path));
-    ReaderStreamBuf buffer(make_unique<FileReader>(m_path));
-    istream stream(&buffer);
-
-    string line;
-    while (getline(stream, line))
-    {
-      if (line.empty())
-        continue;
-
-      size_t const delimPos = line.find(kDelimChar);
-      if (delimPos == string::npos)
-        continue;
-
-      string const key = line.substr(0, delimPos);
-      string const value = line.substr(delimPos + 1);
-      if (!key.empty() && !value.empty())
-        m_values[key] = value;
-    }
+    ForEachRecord(m_path, [&values](string && key, string && value) {
+      if (!value.empty())
+        (*values)[move(key)] = move(value);
+    });
   }
   catch (RootException const & ex)
   {
     LOG(LWARNING, ("Loading settings:", ex.Msg()));
   }
+
+  size_t logRecordsCount = 0;
+  if (Platform::IsFileExistsByFullPath(m_logPath))
+  {
+    try
+    {
+      logRecordsCount = ForEachRecord(m_logPath, [&values](string && key, string && value) {
+        if (value.empty())
+          values->erase(key);
+        else
+          (*values)[move(key)] = move(value);
+      });
+    }
+    catch (RootException const & ex)
+    {
+      LOG(LWARNING, ("Loading settings log:", ex.Msg()));
+    }
+  }
+
+  m_values = move(values);
+  if (logRecordsCount != 0)
+    SaveImpl(*m_values);
 }
 
 void StringStorageBase::Save() const
 {
+  lock_guard<mutex> guard(m_mutex);
+  SaveImpl(*m_values);
+}
+
+void StringStorageBase::SaveImpl(Container const & values) const
+{
+  // The storage is written to a temporary file, so the log is still applied to the old
+  // storage file if saving is interrupted.
+  string const tmpPath = m_path + ".tmp";
   try
   {
-    FileWriter file(m_path);
-    for (auto const & value : m_values)
     {
-      string line(value.first);
-      line += kDelimChar;
-      line += value.second;
-      line += '\n';
-      file.Write(line.data(), line.size());
+      FileWriter file(tmpPath);
+      for (auto const & value : values)
+      {
+        string line(value.first);
+        line += kDelimChar;
+        line += value.second;
+        line += '\n';
+        file.Write(line.data(), line.size());
+      }
     }
+
+    if (!base::RenameFileX(tmpPath, m_path))
+      return;
+
+    base::DeleteFileX(m_logPath);
+    m_logRecordsCount = 0;
   }
   catch (RootException const & ex)
   {
@@ -70,19 +133,50 @@ void StringStorageBase::Save() const
   }
 }
 
+void StringStorageBase::Log(string const & key, string const & value) const
+{
+  if (m_logRecordsCount >= kMaxLogRecordsCount)
+  {
+    SaveImpl(*m_values);
+    return;
+  }
+
+  try
+  {
+    string line(key);
+    line += kDelimChar;
+    line += value;
+    line += '\n';
+
+    FileWriter file(m_logPath, FileWriter::OP_APPEND);
+    file.Write(line.data(), line.size());
+    ++m_logRecordsCount;
+  }
+  catch (RootException const & ex)
+  {
+    LOG(LWARNING, ("Saving settings log:", ex.Msg()));
+    SaveImpl(*m_values);
+  }
+}
+
+shared_ptr<StringStorageBase::Container const> StringStorageBase::GetValues() const
+{
+  return atomic_load(&m_values);
+}
+
 void StringStorageBase::Clear()
 {
   lock_guard<mutex> guard(m_mutex);
-  m_values.clear();
-  Save();
+  atomic_store(&m_values, make_shared<Container const>());
+  SaveImpl(*m_values);
 }
 
 bool StringStorageBase::GetValue(string const & key, string & outValue) const
 {
-  lock_guard<mutex> guard(m_mutex);
+  auto const values = GetValues();
 
-  auto const found = m_values.find(key);
-  if (found == m_values.end())
+  auto const found = values->find(key);
+  if (found == values->end())
     return false;
 
   outValue = found->second;
@@ -93,19 +187,31 @@ void StringStorageBase::SetValue(string const & key, string && value)
 {
   lock_guard<mutex> guard(m_mutex);
 
-  m_values[key] = move(value);
-  Save();
+  auto const found = m_values->find(key);
+  if (found != m_values->end() && found->second == value)
+    return;
+
+  auto values = make_shared<Container>(*m_values);
+  auto & newValue = (*values)[key];
+  newValue = move(value);
+  atomic_store(&m_values, shared_ptr<Container const>(move(values)));
+
+  if (newValue.empty())
+    SaveImpl(*m_values);
+  else
+    Log(key, newValue);
 }
 
 void StringStorageBase::DeleteKeyAndValue(string const & key)
 {
   lock_guard<mutex> guard(m_mutex);
 
-  auto const found = m_values.find(key);
-  if (found != m_values.end())
-  {
-    m_values.erase(found);
-    Save();
-  }
+  if (m_values->find(key) == m_values->end())
+    return;
+
+  auto values = make_shared<Container>(*m_values);
+  values->erase(key);
+  atomic_store(&m_values, shared_ptr<Container const>(move(values)));
+  Log(key, string());
 }
 }  // namespace platform
@@ -1,25 +1,43 @@
 #pragma once
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 
 namespace platform
 {
+// Key-value storage which is kept in memory and persisted to |path|.
+//
+// Readers don't wait for writers: values are replaced as a whole on every change and
+// GetValue() only loads the current snapshot. Changes are appended to a log next to the
+// storage file, and the log is merged into the storage file when it grows, on Save() and
+// on the next start, so a change doesn't rewrite the whole file.
 class StringStorageBase
 {
 public:
   StringStorageBase(std::string const & path);
+  // Writes all values to the storage file and clears the log.
   void Save() const;
   void Clear();
   bool GetValue(std::string const & key, std::string & outValue) const;
   void SetValue(std::string const & key, std::string && value);
   void DeleteKeyAndValue(std::string const & key);
-  
+
 private:
   using Container = std::map<std::string, std::string>;
-  Container m_values;
+
+  std::shared_ptr<Container const> GetValues() const;
+  void SaveImpl(Container const & values) const;
+  // Writes a change of |key| to the log, an empty |value| means that the key is deleted.
+  void Log(std::string const & key, std::string const & value) const;
+
+  std::shared_ptr<Container const> m_values;
+  // Guards changes of values and writes to files.
   mutable std::mutex m_mutex;
+  mutable size_t m_logRecordsCount = 0;
   std::string const m_path;
+  std::string const m_logPath;
 };
 }  // namespace platform
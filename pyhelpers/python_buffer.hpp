@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Python.h"
+
+#include <boost/python.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+using namespace boost::python;
+
+// A read-only view of an object which supports the buffer protocol, e.g. Python2 str,
+// Python3 bytes, bytearray or memoryview. The data is not copied, the view keeps the
+// object alive and must be destroyed with the GIL held.
+class python_buffer
+{
+public:
+  explicit python_buffer(object const & obj)
+  {
+    if (PyObject_GetBuffer(obj.ptr(), &m_buffer, PyBUF_SIMPLE) != 0)
+      throw_error_already_set();
+  }
+
+  python_buffer(python_buffer && rhs) : m_buffer(rhs.m_buffer) { rhs.m_buffer.obj = nullptr; }
+
+  ~python_buffer()
+  {
+    if (m_buffer.obj != nullptr)
+      PyBuffer_Release(&m_buffer);
+  }
+
+  uint8_t const * data() const { return static_cast<uint8_t const *>(m_buffer.buf); }
+  size_t size() const { return static_cast<size_t>(m_buffer.len); }
+
+private:
+  python_buffer(python_buffer const &) = delete;
+  python_buffer & operator=(python_buffer const &) = delete;
+  python_buffer & operator=(python_buffer &&) = delete;
+
+  Py_buffer m_buffer;
+};
+}  // namespace
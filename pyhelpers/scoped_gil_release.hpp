@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Python.h"
+
+namespace
+{
+// Releases the GIL while the object is alive, so other Python threads run while a native
+// computation is in progress. Python objects must not be touched meanwhile.
+class scoped_gil_release
+{
+public:
+  scoped_gil_release() : m_state(PyEval_SaveThread()) {}
+  ~scoped_gil_release() { PyEval_RestoreThread(m_state); }
+
+private:
+  scoped_gil_release(scoped_gil_release const &) = delete;
+  scoped_gil_release & operator=(scoped_gil_release const &) = delete;
+
+  PyThreadState * m_state;
+};
+}  // namespace
@@ -64,6 +64,9 @@ void QtRenderOGLContext::Resize(int w, int h)
 
   m_frontFrame = std::make_unique<QOpenGLFramebufferObject>(size, QOpenGLFramebufferObject::Depth);
   m_backFrame = std::make_unique<QOpenGLFramebufferObject>(size, QOpenGLFramebufferObject::Depth);
+
+  // Qt changes bindings of textures behind drape.
+  GLFunctions::ResetStateCache();
 }
 
 void QtRenderOGLContext::LockFrame()
@@ -1,16 +1,23 @@
 #pragma once
 
+#include "routing/base/astar_vertex_store.hpp"
 #include "routing/base/astar_weight.hpp"
 #include "routing/base/routing_result.hpp"
 
 #include "base/assert.hpp"
 #include "base/cancellable.hpp"
+#include "base/thread.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <queue>
+#include <set>
+#include <utility>
 #include <vector>
 
 namespace routing
@@ -81,6 +88,11 @@ public:
     base::Cancellable const & m_cancellable;
     OnVisitedVertexCallback const m_onVisitedVertexCallback;
     CheckLengthCallback const m_checkLengthCallback;
+    // Used for FindPathBidirectional. If true forward and backward waves are propagated
+    // in two threads. Calls of |m_graph| methods and callbacks are serialized in this case,
+    // so the waves run mostly in turn when most of the time is spent in |m_graph|.
+    // Off by default until the graphs may be used by both waves without the lock.
+    bool m_runWavesInParallel = false;
   };
 
   struct ParamsForTests
@@ -108,42 +120,35 @@ public:
     base::Cancellable const m_cancellable;
     OnVisitedVertexCallback const m_onVisitedVertexCallback;
     CheckLengthCallback const m_checkLengthCallback;
+    bool m_runWavesInParallel = false;
   };
   class Context final
   {
   public:
-    void Clear()
-    {
-      m_distanceMap.clear();
-      m_parents.clear();
-    }
+    void Clear() { m_store.Clear(); }
 
-    bool HasDistance(Vertex const & vertex) const
-    {
-      return m_distanceMap.find(vertex) != m_distanceMap.cend();
-    }
+    bool HasDistance(Vertex const & vertex) const { return m_store.GetDistance(vertex) != nullptr; }
 
     Weight GetDistance(Vertex const & vertex) const
     {
-      auto const & it = m_distanceMap.find(vertex);
-      if (it == m_distanceMap.cend())
+      Weight const * distance = m_store.GetDistance(vertex);
+      if (distance == nullptr)
         return kInfiniteDistance;
 
-      return it->second;
+      return *distance;
     }
 
     void SetDistance(Vertex const & vertex, Weight const & distance)
     {
-      m_distanceMap[vertex] = distance;
+      m_store.SetDistance(vertex, distance);
     }
 
-    void SetParent(Vertex const & parent, Vertex const & child) { m_parents[parent] = child; }
+    void SetParent(Vertex const & parent, Vertex const & child) { m_store.SetParent(parent, child); }
 
     void ReconstructPath(Vertex const & v, std::vector<Vertex> & path) const;
 
   private:
-    std::map<Vertex, Weight> m_distanceMap;
-    std::map<Vertex, Vertex> m_parents;
+    typename AStarVertexStore<Graph>::Type m_store;
   };
 
   // VisitVertex returns true: wave will continue
@@ -163,6 +168,31 @@ public:
   template <typename P>
   Result FindPathBidirectional(P & params, RoutingResult<Vertex, Weight> & result) const;
 
+  struct AlternativesParams
+  {
+    size_t m_maxAlternatives = 2;
+    // Max ratio of the length of an alternative to the length of the shortest path.
+    double m_maxStretch = 1.25;
+    // Max ratio of the length an alternative shares with the shortest path and with the chosen
+    // alternatives to the length of the shortest path.
+    double m_maxSharing = 0.8;
+    // Subpaths of an alternative around its via vertex which are not longer than the ratio of
+    // the length of the shortest path should be shortest paths.
+    double m_localOptimality = 0.25;
+  };
+
+  /// \brief Finds the shortest path as FindPathBidirectional() does and up to
+  /// |alternativesParams.m_maxAlternatives| alternative paths with the via vertex method.
+  /// The waves are propagated a bit further than for the shortest path only, an alternative
+  /// consists of the paths from the start to a vertex settled by both waves and from the vertex
+  /// to the finish in their search trees. Alternatives are sorted by length.
+  /// \note The waves are propagated in one thread regardless of |params.m_runWavesInParallel|.
+  template <typename P>
+  Result FindPathBidirectionalWithAlternatives(
+      P & params, AlternativesParams const & alternativesParams,
+      RoutingResult<Vertex, Weight> & result,
+      std::vector<RoutingResult<Vertex, Weight>> & alternatives) const;
+
   // Adjust route to the previous one.
   // Expects |params.m_checkLengthCallback| to check wave propagation limit.
   template <typename P>
@@ -173,6 +203,9 @@ private:
   // Periodicity of switching a wave of bidirectional algorithm.
   static uint32_t constexpr kQueueSwitchPeriod = 128;
 
+  // Max number of via vertices which paths are checked for being alternatives.
+  static size_t constexpr kMaxCheckedAlternativesNumber = 64;
+
   // Precision of comparison weights.
   static Weight constexpr kEpsilon = GetAStarWeightEpsilon<Weight>();
   static Weight constexpr kZeroDistance = GetAStarWeightZero<Weight>();
@@ -275,6 +308,51 @@ private:
     Weight pS;
   };
 
+  // Bidirectional search state shared by the waves which are propagated in parallel.
+  // |m_graphMutex| serializes all the calls of the graph and of the callbacks because graphs
+  // are not thread-safe. |m_waveMutexes| guard |bestDistance| and |parent| of each wave:
+  // a wave locks its own mutex for writing only, the other wave locks it for reading.
+  struct ParallelSearchState
+  {
+    std::mutex m_graphMutex;
+    std::mutex m_waveMutexes[2];
+    // Guards the fields below except atomic ones.
+    std::mutex m_bestPathMutex;
+    bool m_foundAnyPath = false;
+    Weight m_bestPathReducedLength = kZeroDistance;
+    Weight m_bestPathRealLength = kZeroDistance;
+    Vertex m_bestForwardVertex;
+    Vertex m_bestBackwardVertex;
+    // Lower bounds of reduced distances of vertices which may be settled by each wave later.
+    Weight m_waveTops[2] = {kZeroDistance, kZeroDistance};
+    // True if the queue of the wave is exhausted, i.e. all its vertices are settled.
+    bool m_waveExhausted[2] = {false, false};
+    std::atomic<bool> m_finished{false};
+    std::atomic<bool> m_cancelled{false};
+  };
+
+  template <typename P>
+  Result FindPathBidirectionalParallel(P & params, RoutingResult<Vertex, Weight> & result) const;
+
+  // Propagates |forward| and |backward| waves in turn until the shortest path is found and
+  // the reduced lengths of paths through the vertices which are not settled yet exceed the
+  // length of the shortest path by more than |maxStretch| times.
+  // The shortest path passes |forward.bestVertex| and |backward.bestVertex|.
+  template <typename P>
+  Result PropagateBidirectionalWaves(P & params, double maxStretch,
+                                     BidirectionalStepContext & forward,
+                                     BidirectionalStepContext & backward,
+                                     Weight & bestPathRealLength) const;
+
+  // Returns true if there's no path from |from| to |to| shorter than |length|.
+  bool IsShortestPath(Graph & graph, Vertex const & from, Vertex const & to,
+                      Weight const & length) const;
+
+  template <typename P>
+  void PropagateBidirectionalWave(P & params, BidirectionalStepContext & cur,
+                                  BidirectionalStepContext & nxt,
+                                  ParallelSearchState & state) const;
+
   static void ReconstructPath(Vertex const & v, std::map<Vertex, Vertex> const & parent,
                               std::vector<Vertex> & path);
   static void ReconstructPathBidirectional(Vertex const & v, Vertex const & w,
@@ -448,16 +526,41 @@ template <typename P>
 typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectional(
     P & params, RoutingResult<Vertex, Weight> & result) const
 {
+  if (params.m_runWavesInParallel)
+    return FindPathBidirectionalParallel(params, result);
+
   auto & graph = params.m_graph;
+  BidirectionalStepContext forward(true /* forward */, params.m_startVertex, params.m_finalVertex,
+                                   graph);
+  BidirectionalStepContext backward(false /* forward */, params.m_startVertex,
+                                    params.m_finalVertex, graph);
+
+  Weight bestPathRealLength = kZeroDistance;
+  auto const resultCode =
+      PropagateBidirectionalWaves(params, 1.0 /* maxStretch */, forward, backward,
+                                  bestPathRealLength);
+  if (resultCode != Result::OK)
+    return resultCode;
+
+  ReconstructPathBidirectional(forward.bestVertex, backward.bestVertex, forward.parent,
+                               backward.parent, result.m_path);
+  result.m_distance = bestPathRealLength;
+  CHECK(!result.m_path.empty(), ());
+  return Result::OK;
+}
+
+template <typename Graph>
+template <typename P>
+typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::PropagateBidirectionalWaves(
+    P & params, double maxStretch, BidirectionalStepContext & forward,
+    BidirectionalStepContext & backward, Weight & bestPathRealLength) const
+{
   auto const & finalVertex = params.m_finalVertex;
   auto const & startVertex = params.m_startVertex;
 
-  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
-  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
-
   bool foundAnyPath = false;
   auto bestPathReducedLength = kZeroDistance;
-  auto bestPathRealLength = kZeroDistance;
+  bestPathRealLength = kZeroDistance;
 
   forward.bestDistance[startVertex] = kZeroDistance;
   forward.queue.push(State(startVertex, kZeroDistance));
@@ -480,20 +583,30 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectio
   uint32_t steps = 0;
   PeriodicPollCancellable periodicCancellable(params.m_cancellable);
 
-  while (!cur->queue.empty() && !nxt->queue.empty())
+  // Looking for alternatives a wave is propagated after the other one is exhausted
+  // because via vertices should be reached by both waves.
+  auto const lookForAlternatives = [&]() { return foundAnyPath && maxStretch > 1.0; };
+  while ((!cur->queue.empty() && !nxt->queue.empty()) ||
+         (lookForAlternatives() && (!cur->queue.empty() || !nxt->queue.empty())))
   {
     ++steps;
 
     if (periodicCancellable.IsCancelled())
       return Result::Cancelled;
 
-    if (steps % kQueueSwitchPeriod == 0)
+    if (steps % kQueueSwitchPeriod == 0 && !nxt->queue.empty())
       std::swap(cur, nxt);
 
+    if (cur->queue.empty())
+    {
+      std::swap(cur, nxt);
+      continue;
+    }
+
     if (foundAnyPath)
     {
       auto const curTop = cur->TopDistance();
-      auto const nxtTop = nxt->TopDistance();
+      auto const nxtTop = nxt->queue.empty() ? kZeroDistance : nxt->TopDistance();
 
       // The intuition behind this is that we cannot obtain a path shorter
       // than the left side of the inequality because that is how any path we find
@@ -506,17 +619,17 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectio
       // several top states in a priority queue may have equal reduced path lengths and
       // different real path lengths.
 
-      if (curTop + nxtTop >= bestPathReducedLength - kEpsilon)
+      // Reduced lengths of paths differ from their real lengths by the same value, so
+      // the waves are propagated to the paths not longer than |maxStretch| times of the shortest.
+      auto stopLength = bestPathReducedLength;
+      if (maxStretch > 1.0)
+        stopLength += (maxStretch - 1.0) * bestPathRealLength;
+
+      if (curTop + nxtTop >= stopLength - kEpsilon)
       {
         if (!params.m_checkLengthCallback(bestPathRealLength))
           return Result::NoPath;
 
-        ReconstructPathBidirectional(cur->bestVertex, nxt->bestVertex, cur->parent, nxt->parent,
-                                     result.m_path);
-        result.m_distance = bestPathRealLength;
-        CHECK(!result.m_path.empty(), ());
-        if (!cur->forward)
-          reverse(result.m_path.begin(), result.m_path.end());
         return Result::OK;
       }
     }
@@ -582,9 +695,396 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectio
     }
   }
 
+  // With |maxStretch| greater than one a queue may be exhausted after the shortest path is found.
+  if (foundAnyPath && maxStretch > 1.0)
+    return params.m_checkLengthCallback(bestPathRealLength) ? Result::OK : Result::NoPath;
+
   return Result::NoPath;
 }
 
+template <typename Graph>
+template <typename P>
+typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectionalWithAlternatives(
+    P & params, AlternativesParams const & alternativesParams,
+    RoutingResult<Vertex, Weight> & result,
+    std::vector<RoutingResult<Vertex, Weight>> & alternatives) const
+{
+  alternatives.clear();
+
+  auto & graph = params.m_graph;
+  BidirectionalStepContext forward(true /* forward */, params.m_startVertex, params.m_finalVertex,
+                                   graph);
+  BidirectionalStepContext backward(false /* forward */, params.m_startVertex,
+                                    params.m_finalVertex, graph);
+
+  Weight bestPathRealLength = kZeroDistance;
+  auto const resultCode =
+      PropagateBidirectionalWaves(params, alternativesParams.m_maxStretch, forward, backward,
+                                  bestPathRealLength);
+  if (resultCode != Result::OK)
+    return resultCode;
+
+  ReconstructPathBidirectional(forward.bestVertex, backward.bestVertex, forward.parent,
+                               backward.parent, result.m_path);
+  result.m_distance = bestPathRealLength;
+  CHECK(!result.m_path.empty(), ());
+
+  if (alternativesParams.m_maxAlternatives == 0)
+    return Result::OK;
+
+  // Real distances from the start and to the finish, see ConsistentHeuristic().
+  auto const getDistance = [](BidirectionalStepContext const & context, Vertex const & v) {
+    return context.bestDistance.at(v) - context.ConsistentHeuristic(v) + context.pS;
+  };
+
+  // Via vertices are the vertices reached by both waves.
+  Weight const maxLength = alternativesParams.m_maxStretch * bestPathRealLength;
+  std::vector<std::pair<Weight, Vertex>> candidates;
+  for (auto const & kv : forward.bestDistance)
+  {
+    if (backward.bestDistance.count(kv.first) == 0)
+      continue;
+
+    auto const length = getDistance(forward, kv.first) + getDistance(backward, kv.first);
+    if (length <= maxLength + kEpsilon)
+      candidates.emplace_back(length, kv.first);
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](std::pair<Weight, Vertex> const & lhs, std::pair<Weight, Vertex> const & rhs) {
+              return lhs.first < rhs.first;
+            });
+
+  // Edges of the shortest path and of the chosen alternatives.
+  std::set<std::pair<Vertex, Vertex>> usedEdges;
+  // Via vertices of the same path give the same path, so the vertices of checked paths are
+  // skipped.
+  std::set<Vertex> checked;
+  auto const usePath = [&](std::vector<Vertex> const & path) {
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+      checked.insert(path[i]);
+      if (i != 0)
+        usedEdges.emplace(path[i - 1], path[i]);
+    }
+  };
+  usePath(result.m_path);
+
+  Weight const maxSharing = alternativesParams.m_maxSharing * bestPathRealLength;
+  Weight const halfLocalLength =
+      (0.5 * alternativesParams.m_localOptimality) * bestPathRealLength;
+  size_t checkedPathsNumber = 0;
+  std::vector<Vertex> path;
+  std::vector<Vertex> backwardPath;
+  std::vector<Weight> distances;
+  for (auto const & candidate : candidates)
+  {
+    if (alternatives.size() >= alternativesParams.m_maxAlternatives ||
+        checkedPathsNumber >= kMaxCheckedAlternativesNumber)
+    {
+      break;
+    }
+
+    auto const & viaVertex = candidate.second;
+    if (checked.count(viaVertex) != 0)
+      continue;
+
+    if (!params.m_checkLengthCallback(candidate.first))
+      continue;
+
+    ++checkedPathsNumber;
+    ReconstructPath(viaVertex, forward.parent, path);
+    size_t const viaIdx = path.size() - 1;
+    ReconstructPath(viaVertex, backward.parent, backwardPath);
+    path.insert(path.end(), backwardPath.rbegin() + 1, backwardPath.rend());
+
+    // Distances from the start along the path.
+    distances.resize(path.size());
+    for (size_t i = 0; i <= viaIdx; ++i)
+      distances[i] = getDistance(forward, path[i]);
+    for (size_t i = viaIdx + 1; i < path.size(); ++i)
+      distances[i] = candidate.first - getDistance(backward, path[i]);
+
+    bool isSimple = true;
+    Weight sharing = kZeroDistance;
+    std::set<Vertex> pathVertices;
+    for (size_t i = 0; i < path.size() && isSimple; ++i)
+    {
+      isSimple = pathVertices.insert(path[i]).second;
+      if (i != 0 && usedEdges.count(std::make_pair(path[i - 1], path[i])) != 0)
+        sharing += distances[i] - distances[i - 1];
+    }
+
+    auto const isAccepted = [&]() {
+      if (!isSimple || sharing > maxSharing)
+        return false;
+
+      // T-test: the subpath around the via vertex should be the shortest path.
+      size_t fromIdx = viaIdx;
+      while (fromIdx > 0 && distances[viaIdx] - distances[fromIdx] < halfLocalLength)
+        --fromIdx;
+      size_t toIdx = viaIdx;
+      while (toIdx + 1 < path.size() && distances[toIdx] - distances[viaIdx] < halfLocalLength)
+        ++toIdx;
+      return IsShortestPath(graph, path[fromIdx], path[toIdx], distances[toIdx] - distances[fromIdx]);
+    };
+
+    if (isAccepted())
+    {
+      usePath(path);
+      RoutingResult<Vertex, Weight> alternative;
+      alternative.m_path = path;
+      alternative.m_distance = candidate.first;
+      alternatives.push_back(std::move(alternative));
+    }
+    else
+    {
+      checked.insert(path.cbegin(), path.cend());
+    }
+  }
+
+  return Result::OK;
+}
+
+template <typename Graph>
+bool AStarAlgorithm<Graph>::IsShortestPath(Graph & graph, Vertex const & from, Vertex const & to,
+                                           Weight const & length) const
+{
+  if (from == to)
+    return true;
+
+  // A* with the heuristic to |to|. Reduced distances of the vertices of paths from |from| to |to|
+  // which are not longer than |length| don't exceed |maxReducedLength|.
+  auto const fromHeuristic = graph.HeuristicCostEstimate(from, to);
+  auto const maxReducedLength = length - fromHeuristic + kEpsilon;
+  bool reached = false;
+  Context context;
+  PropagateWave(
+      graph, from,
+      [&to, &reached](Vertex const & v) {
+        reached = v == to;
+        return !reached;
+      } /* visitVertex */,
+      [&graph, &to](Vertex const & v, Edge const & edge) {
+        auto const reducedWeight = edge.GetWeight() +
+                                   graph.HeuristicCostEstimate(edge.GetTarget(), to) -
+                                   graph.HeuristicCostEstimate(v, to);
+        return std::max(reducedWeight, kZeroDistance);
+      } /* adjustEdgeWeight */,
+      [&maxReducedLength](State const & state) {
+        return state.distance <= maxReducedLength;
+      } /* filterStates */,
+      context);
+
+  if (!reached)
+    return true;
+
+  return context.GetDistance(to) + fromHeuristic >= length - kEpsilon;
+}
+
+template <typename Graph>
+template <typename P>
+typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectionalParallel(
+    P & params, RoutingResult<Vertex, Weight> & result) const
+{
+  auto & graph = params.m_graph;
+  auto const & finalVertex = params.m_finalVertex;
+  auto const & startVertex = params.m_startVertex;
+
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+
+  forward.bestDistance[startVertex] = kZeroDistance;
+  forward.queue.push(State(startVertex, kZeroDistance));
+
+  backward.bestDistance[finalVertex] = kZeroDistance;
+  backward.queue.push(State(finalVertex, kZeroDistance));
+
+  ParallelSearchState state;
+  // An exception thrown by a wave stops both waves and is rethrown after the threads are joined.
+  auto const propagate = [&](BidirectionalStepContext & cur, BidirectionalStepContext & nxt,
+                             std::exception_ptr & exception) {
+    try
+    {
+      PropagateBidirectionalWave(params, cur, nxt, state);
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+      state.m_finished = true;
+    }
+  };
+
+  std::exception_ptr forwardException;
+  std::exception_ptr backwardException;
+  threads::SimpleThread backwardThread(
+      [&]() { propagate(backward, forward, backwardException); });
+  propagate(forward, backward, forwardException);
+  backwardThread.join();
+
+  if (forwardException)
+    std::rethrow_exception(forwardException);
+  if (backwardException)
+    std::rethrow_exception(backwardException);
+
+  if (state.m_cancelled)
+    return Result::Cancelled;
+
+  if (!state.m_foundAnyPath || !params.m_checkLengthCallback(state.m_bestPathRealLength))
+    return Result::NoPath;
+
+  ReconstructPathBidirectional(state.m_bestForwardVertex, state.m_bestBackwardVertex,
+                               forward.parent, backward.parent, result.m_path);
+  result.m_distance = state.m_bestPathRealLength;
+  CHECK(!result.m_path.empty(), ());
+  return Result::OK;
+}
+
+// Propagates wave |cur| until the best path is found by any of the waves.
+// The vertices are inserted to the wave's own |bestDistance| before looking them up in
+// the other wave's |bestDistance|. So if both waves reach a vertex simultaneously at least one
+// of them notices the meeting.
+template <typename Graph>
+template <typename P>
+void AStarAlgorithm<Graph>::PropagateBidirectionalWave(P & params,
+                                                       BidirectionalStepContext & cur,
+                                                       BidirectionalStepContext & nxt,
+                                                       ParallelSearchState & state) const
+{
+  size_t const curIdx = cur.forward ? 0 : 1;
+  size_t const nxtIdx = cur.forward ? 1 : 0;
+  std::mutex & curMutex = state.m_waveMutexes[curIdx];
+  std::mutex & nxtMutex = state.m_waveMutexes[nxtIdx];
+
+  PeriodicPollCancellable periodicCancellable(params.m_cancellable);
+
+  // Target of an edge with its full weight and consistent heuristic.
+  struct Adjacent
+  {
+    Vertex m_target;
+    Weight m_weight;
+    Weight m_heuristic;
+  };
+
+  std::vector<Edge> adj;
+  std::vector<Adjacent> adjacents;
+
+  while (!state.m_finished)
+  {
+    if (cur.queue.empty())
+    {
+      std::lock_guard<std::mutex> guard(state.m_bestPathMutex);
+      state.m_waveExhausted[curIdx] = true;
+      // If no path is found the vertex the other wave is started from is unreachable.
+      // Otherwise the other wave goes on to check the rest of possible meeting vertices.
+      if (!state.m_foundAnyPath || state.m_waveExhausted[nxtIdx])
+        state.m_finished = true;
+      return;
+    }
+
+    if (periodicCancellable.IsCancelled())
+    {
+      state.m_cancelled = true;
+      state.m_finished = true;
+      return;
+    }
+
+    State const stateV = cur.queue.top();
+    cur.queue.pop();
+
+    // Only this thread changes |cur.bestDistance| so it may be read without locking.
+    if (stateV.distance > cur.bestDistance.at(stateV.vertex))
+      continue;
+
+    {
+      std::lock_guard<std::mutex> guard(state.m_bestPathMutex);
+      state.m_waveTops[curIdx] = stateV.distance;
+      // See the comment on the stop condition in FindPathBidirectional(). |m_waveTops| of
+      // the other wave may be stale but it may only grow, so the condition is not met too early.
+      // Reduced distances of an exhausted wave are final so its top is not taken into account.
+      auto const nxtTop =
+          state.m_waveExhausted[nxtIdx] ? kZeroDistance : state.m_waveTops[nxtIdx];
+      if (state.m_foundAnyPath &&
+          state.m_waveTops[curIdx] + nxtTop >= state.m_bestPathReducedLength - kEpsilon)
+      {
+        state.m_finished = true;
+        return;
+      }
+    }
+
+    Weight pV;
+    {
+      std::lock_guard<std::mutex> guard(state.m_graphMutex);
+      params.m_onVisitedVertexCallback(stateV.vertex,
+                                       cur.forward ? cur.finalVertex : cur.startVertex);
+
+      cur.GetAdjacencyList(stateV.vertex, adj);
+      pV = cur.ConsistentHeuristic(stateV.vertex);
+      adjacents.clear();
+      for (auto const & edge : adj)
+      {
+        if (edge.GetTarget() == stateV.vertex)
+          continue;
+
+        auto const weight = edge.GetWeight();
+        auto const fullLength = weight + stateV.distance + cur.pS - pV;
+        if (!params.m_checkLengthCallback(fullLength))
+          continue;
+
+        adjacents.push_back({edge.GetTarget(), weight, cur.ConsistentHeuristic(edge.GetTarget())});
+      }
+    }
+
+    for (auto const & adjacent : adjacents)
+    {
+      auto const & vertexW = adjacent.m_target;
+      auto const reducedWeight = adjacent.m_weight + adjacent.m_heuristic - pV;
+
+      CHECK_GREATER_OR_EQUAL(reducedWeight, -kEpsilon, ("Invariant violated."));
+      auto const newReducedDist = stateV.distance + std::max(reducedWeight, kZeroDistance);
+
+      auto const itCur = cur.bestDistance.find(vertexW);
+      if (itCur != cur.bestDistance.end() && newReducedDist >= itCur->second - kEpsilon)
+        continue;
+
+      {
+        std::lock_guard<std::mutex> guard(curMutex);
+        cur.bestDistance[vertexW] = newReducedDist;
+        cur.parent[vertexW] = stateV.vertex;
+      }
+      cur.queue.push(State(vertexW, newReducedDist));
+
+      Weight distW;
+      {
+        std::lock_guard<std::mutex> guard(nxtMutex);
+        auto const itNxt = nxt.bestDistance.find(vertexW);
+        if (itNxt == nxt.bestDistance.end())
+          continue;
+        distW = itNxt->second;
+      }
+
+      auto const curPathReducedLength = newReducedDist + distW;
+      Weight pNxtW;
+      {
+        std::lock_guard<std::mutex> guard(state.m_graphMutex);
+        pNxtW = nxt.ConsistentHeuristic(vertexW);
+      }
+
+      std::lock_guard<std::mutex> guard(state.m_bestPathMutex);
+      // No epsilon here: it is ok to overshoot slightly.
+      if (state.m_foundAnyPath && state.m_bestPathReducedLength <= curPathReducedLength)
+        continue;
+
+      state.m_bestPathReducedLength = curPathReducedLength;
+      state.m_bestPathRealLength = stateV.distance + adjacent.m_weight + distW;
+      state.m_bestPathRealLength += cur.pS - pV;
+      state.m_bestPathRealLength += nxt.pS - pNxtW;
+      state.m_foundAnyPath = true;
+      state.m_bestForwardVertex = cur.forward ? stateV.vertex : vertexW;
+      state.m_bestBackwardVertex = cur.forward ? vertexW : stateV.vertex;
+    }
+  }
+}
+
 template <typename Graph>
 template <typename P>
 typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
@@ -615,6 +1115,46 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
     remainingDistance += it->GetWeight();
   }
 
+  // The wave is guided to |prevRoute| with potential pi(v) = min(h(v, w) + r(w)),
+  // where w is a vertex of |prevRoute| which may be reached within the wave limit
+  // and r(w) is the remaining distance of |prevRoute| from w. The potential is consistent
+  // as a minimum of consistent potentials. Since pi(w) <= r(w) the full distance via any
+  // vertex which is not visited yet is not less than the reduced distance of the queue top
+  // plus pi(startVertex). So the wave is stopped when it's not less than the best full distance.
+  std::vector<std::pair<Vertex, Weight>> attractors;
+  for (auto const & vertexAndDistance : remainingDistances)
+  {
+    if (params.m_checkLengthCallback(
+            graph.HeuristicCostEstimate(startVertex, vertexAndDistance.first)))
+    {
+      attractors.push_back(vertexAndDistance);
+    }
+  }
+
+  if (attractors.empty())
+    return Result::NoPath;
+
+  std::map<Vertex, Weight> potentials;
+  auto const getPotential = [&](Vertex const & vertex) {
+    auto const it = potentials.find(vertex);
+    if (it != potentials.cend())
+      return it->second;
+
+    auto potential = kInfiniteDistance;
+    for (auto const & attractor : attractors)
+    {
+      potential = std::min(potential,
+                           graph.HeuristicCostEstimate(vertex, attractor.first) + attractor.second);
+    }
+    potentials.emplace(vertex, potential);
+    return potential;
+  };
+
+  auto const startPotential = getPotential(startVertex);
+  auto const reducedToFullLength = [&](Vertex const & vertex, Weight const & reducedLength) {
+    return reducedLength + getPotential(vertex) - startPotential;
+  };
+
   Context context;
   PeriodicPollCancellable periodicCancellable(params.m_cancellable);
 
@@ -626,12 +1166,19 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
       return false;
     }
 
+    auto const reducedDistance = context.GetDistance(vertex);
+    if (minDistance != kInfiniteDistance &&
+        reducedDistance + startPotential >= minDistance - kEpsilon)
+    {
+      return false;
+    }
+
     params.m_onVisitedVertexCallback(startVertex, vertex);
 
     auto it = remainingDistances.find(vertex);
     if (it != remainingDistances.cend())
     {
-      auto const fullDistance = context.GetDistance(vertex) + it->second;
+      auto const fullDistance = reducedToFullLength(vertex, reducedDistance) + it->second;
       if (fullDistance < minDistance)
       {
         minDistance = fullDistance;
@@ -642,12 +1189,17 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
     return true;
   };
 
-  auto const adjustEdgeWeight = [](Vertex const & /* vertex */, Edge const & edge) {
-    return edge.GetWeight();
+  auto const adjustEdgeWeight = [&](Vertex const & vertexV, Edge const & edge) {
+    auto const reducedWeight =
+        edge.GetWeight() - getPotential(vertexV) + getPotential(edge.GetTarget());
+
+    CHECK_GREATER_OR_EQUAL(reducedWeight, -kEpsilon, ("Invariant violated."));
+
+    return std::max(reducedWeight, kZeroDistance);
   };
 
   auto const filterStates = [&](State const & state) {
-    return params.m_checkLengthCallback(state.distance);
+    return params.m_checkLengthCallback(reducedToFullLength(state.vertex, state.distance));
   };
 
   PropagateWave(graph, startVertex, visitVertex, adjustEdgeWeight, filterStates, context);
@@ -678,7 +1230,8 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
 
   auto const & it = remainingDistances.find(returnVertex);
   CHECK(it != remainingDistances.end(), ());
-  result.m_distance = context.GetDistance(returnVertex) + it->second;
+  result.m_distance = reducedToFullLength(returnVertex, context.GetDistance(returnVertex)) +
+                      it->second;
   return Result::OK;
 }
 
@@ -722,6 +1275,16 @@ template <typename Graph>
 void AStarAlgorithm<Graph>::Context::ReconstructPath(Vertex const & v,
                                                      std::vector<Vertex> & path) const
 {
-  AStarAlgorithm<Graph>::ReconstructPath(v, m_parents, path);
+  path.clear();
+  Vertex cur = v;
+  Vertex parent;
+  while (true)
+  {
+    path.push_back(cur);
+    if (!m_store.GetParent(cur, parent))
+      break;
+    cur = parent;
+  }
+  reverse(path.begin(), path.end());
 }
 }  // namespace routing
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <map>
+
+namespace routing
+{
+// Distances and parents of vertices of an A* wave kept in maps.
+// A graph may define Graph::VertexStore with the same interface to keep vertex states
+// in a more compact way.
+template <typename Vertex, typename Weight>
+class MapVertexStore final
+{
+public:
+  void Clear()
+  {
+    m_distances.clear();
+    m_parents.clear();
+  }
+
+  /// \returns nullptr if the distance of |vertex| is not set.
+  Weight const * GetDistance(Vertex const & vertex) const
+  {
+    auto const it = m_distances.find(vertex);
+    return it == m_distances.cend() ? nullptr : &it->second;
+  }
+
+  void SetDistance(Vertex const & vertex, Weight const & distance)
+  {
+    m_distances[vertex] = distance;
+  }
+
+  /// \returns false if |vertex| has no parent.
+  bool GetParent(Vertex const & vertex, Vertex & parent) const
+  {
+    auto const it = m_parents.find(vertex);
+    if (it == m_parents.cend())
+      return false;
+
+    parent = it->second;
+    return true;
+  }
+
+  void SetParent(Vertex const & vertex, Vertex const & parent) { m_parents[vertex] = parent; }
+
+private:
+  std::map<Vertex, Weight> m_distances;
+  std::map<Vertex, Vertex> m_parents;
+};
+
+namespace impl
+{
+template <typename... Ts>
+struct MakeVoid
+{
+  using Type = void;
+};
+}  // namespace impl
+
+// AStarVertexStore<Graph>::Type is Graph::VertexStore if the graph defines it
+// and MapVertexStore otherwise.
+template <typename Graph, typename = void>
+struct AStarVertexStore
+{
+  using Type = MapVertexStore<typename Graph::Vertex, typename Graph::Weight>;
+};
+
+template <typename Graph>
+struct AStarVertexStore<Graph, typename impl::MakeVoid<typename Graph::VertexStore>::Type>
+{
+  using Type = typename Graph::VertexStore;
+};
+}  // namespace routing
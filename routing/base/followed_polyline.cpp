@@ -8,6 +8,9 @@ namespace routing
 using namespace std;
 using Iter = routing::FollowedPolyline::Iter;
 
+// static
+size_t constexpr FollowedPolyline::kBlockSize;
+
 Iter FollowedPolyline::Begin() const
 {
   ASSERT(IsValid(), ());
@@ -77,6 +80,7 @@ void FollowedPolyline::Swap(FollowedPolyline & rhs)
   m_poly.Swap(rhs.m_poly);
   m_segDistance.swap(rhs.m_segDistance);
   m_segProj.swap(rhs.m_segProj);
+  m_blockRects.swap(rhs.m_blockRects);
   swap(m_current, rhs.m_current);
   swap(m_nextCheckpointIndex, rhs.m_nextCheckpointIndex);
 }
@@ -91,6 +95,8 @@ void FollowedPolyline::Update()
   m_segDistance.reserve(n);
   m_segProj.clear();
   m_segProj.reserve(n);
+  m_blockRects.clear();
+  m_blockRects.reserve((n + kBlockSize - 1) / kBlockSize);
 
   double dist = 0.0;
   for (size_t i = 0; i < n; ++i)
@@ -102,6 +108,10 @@ void FollowedPolyline::Update()
 
     m_segDistance.emplace_back(dist);
     m_segProj.emplace_back(p1, p2);
+
+    if (i % kBlockSize == 0)
+      m_blockRects.emplace_back(p1, p1);
+    m_blockRects.back().Add(p2);
   }
 
   m_current = Iter(m_poly.Front(), 0);
@@ -4,7 +4,9 @@
 
 #include "geometry/point2d.hpp"
 #include "geometry/polyline2d.hpp"
+#include "geometry/rect2d.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -96,19 +98,33 @@ public:
 
     m2::PointD const currPos = posRect.Center();
 
-    for (size_t i = startIdx; i < endIdx; ++i)
+    size_t i = startIdx;
+    while (i < endIdx)
     {
-      m2::PointD const & pt = m_segProj[i].ClosestPointTo(currPos);
-
-      if (!posRect.IsPointInside(pt))
+      // A projection inside |posRect| is possible only to the segments of a block whose rect
+      // intersects |posRect|.
+      size_t const blockIdx = i / kBlockSize;
+      size_t const blockEndIdx = std::min(endIdx, (blockIdx + 1) * kBlockSize);
+      if (!m_blockRects[blockIdx].IsIntersect(posRect))
+      {
+        i = blockEndIdx;
         continue;
+      }
 
-      Iter it(pt, i);
-      double const dp = distFn(it);
-      if (dp < minDist)
+      for (; i < blockEndIdx; ++i)
       {
-        res = it;
-        minDist = dp;
+        m2::PointD const & pt = m_segProj[i].ClosestPointTo(currPos);
+
+        if (!posRect.IsPointInside(pt))
+          continue;
+
+        Iter it(pt, i);
+        double const dp = distFn(it);
+        if (dp < minDist)
+        {
+          res = it;
+          minDist = dp;
+        }
       }
     }
 
@@ -116,6 +132,8 @@ public:
   }
 
 private:
+  static size_t constexpr kBlockSize = 32;
+
   /// \returns iterator to the best projection of center of |posRect| to the |m_poly|.
   /// If there's a good projection of center of |posRect| to two closest segments of |m_poly|
   /// after |m_current| the iterator corresponding of the projection is returned.
@@ -134,5 +152,8 @@ private:
   std::vector<m2::ParametrizedSegment<m2::PointD>> m_segProj;
   /// Accumulated cache of segments length in meters.
   std::vector<double> m_segDistance;
+  /// Bounding rects of blocks of |kBlockSize| consecutive segments of |m_segProj|. Route segments
+  /// which are far from a position are skipped by blocks while the projection is looked for.
+  std::vector<m2::RectD> m_blockRects;
 };
 }  // namespace routing
@@ -20,9 +20,15 @@
 #include "geometry/mercator.hpp"
 #include "geometry/point2d.hpp"
 
+#include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
+#include "base/timer.hpp"
+
 #include <algorithm>
 #include <cstdlib>
+#include <limits>
 #include <numeric>
+#include <thread>
 #include <utility>
 
 namespace
@@ -32,6 +38,19 @@ using namespace routing::turns;
 using namespace std;
 using namespace traffic;
 
+// Number of features which are read by a thread at once.
+size_t constexpr kFeaturesChunkSize = 256;
+
+// LoadedPathSegment with the edges of its last junction. The edges are used to get turn candidates
+// after the features are loaded.
+struct PendingPathSegment
+{
+  LoadedPathSegment m_pathSegment;
+  Edge m_inEdge;
+  IRoadGraph::TEdgeVector m_outgoingEdges;
+  size_t m_ingoingEdgesCount = 0;
+};
+
 class RoutingResult : public IRoutingResult
 {
 public:
@@ -172,8 +191,11 @@ bool BicycleDirectionsEngine::Generate(IndexRoadGraph const & graph, vector<Junc
 {
   CHECK(m_numMwmIds, ());
 
+  m_turnsGenerationSec = 0.0;
   m_adjacentEdges.clear();
   m_pathSegments.clear();
+  m_featureIds.clear();
+  m_featureAttrs.clear();
   turns.clear();
   streetNames.clear();
   routeGeometry.clear();
@@ -201,7 +223,9 @@ bool BicycleDirectionsEngine::Generate(IndexRoadGraph const & graph, vector<Junc
   ::RoutingResult resultGraph(routeEdges, m_adjacentEdges, m_pathSegments);
   RouterDelegate delegate;
 
+  base::Timer timer;
   MakeTurnAnnotation(resultGraph, *m_numMwmIds, delegate, routeGeometry, turns, streetNames, segments);
+  m_turnsGenerationSec = timer.ElapsedSeconds();
   CHECK_EQUAL(routeGeometry.size(), pathSize, ());
   // In case of bicycle routing |m_pathSegments| may have an empty
   // |LoadedPathSegment::m_segments| fields. In that case |segments| is empty
@@ -211,41 +235,88 @@ bool BicycleDirectionsEngine::Generate(IndexRoadGraph const & graph, vector<Junc
   return true;
 }
 
-FeaturesLoaderGuard & BicycleDirectionsEngine::GetLoader(MwmSet::MwmId const & id)
+void BicycleDirectionsEngine::LoadFeatureAttrs()
 {
-  if (!m_loader || id != m_loader->GetId())
-    m_loader = make_unique<FeaturesLoaderGuard>(m_dataSource, id);
-  return *m_loader;
+  m_featureAttrs.assign(m_featureIds.size(), FeatureAttrs());
+  if (m_featureIds.empty())
+    return;
+
+  size_t const chunksNumber = (m_featureIds.size() + kFeaturesChunkSize - 1) / kFeaturesChunkSize;
+  size_t const threadsNumber =
+      min(chunksNumber, static_cast<size_t>(max(thread::hardware_concurrency(), 1U)));
+
+  // FeaturesLoaderGuard is not thread-safe, so every thread uses its own instance. Features of
+  // a chunk are sorted by mwm and index, so the loader is seldom recreated.
+  auto const loadChunks = [&](size_t threadIdx) {
+    unique_ptr<FeaturesLoaderGuard> loader;
+    for (size_t chunk = threadIdx; chunk < chunksNumber; chunk += threadsNumber)
+    {
+      size_t const end = min((chunk + 1) * kFeaturesChunkSize, m_featureIds.size());
+      for (size_t i = chunk * kFeaturesChunkSize; i < end; ++i)
+      {
+        FeatureID const & featureId = m_featureIds[i];
+        if (!loader || loader->GetId() != featureId.m_mwmId)
+          loader = make_unique<FeaturesLoaderGuard>(m_dataSource, featureId.m_mwmId);
+
+        FeatureType ft;
+        if (!loader->GetFeatureByIndex(featureId.m_index, ft))
+          continue;
+
+        FeatureAttrs & attrs = m_featureAttrs[i];
+        attrs.m_highwayClass = ftypes::GetHighwayClass(feature::TypesHolder(ft));
+        ASSERT_NOT_EQUAL(attrs.m_highwayClass, ftypes::HighwayClass::Error, ());
+        ASSERT_NOT_EQUAL(attrs.m_highwayClass, ftypes::HighwayClass::Undefined, ());
+        attrs.m_isLink = ftypes::IsLinkChecker::Instance()(ft);
+        ft.GetName(StringUtf8Multilang::kDefaultCode, attrs.m_name);
+        attrs.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(ft);
+        attrs.m_isLoaded = true;
+      }
+    }
+  };
+
+  vector<threads::SimpleThread> threads;
+  for (size_t i = 1; i < threadsNumber; ++i)
+    threads.emplace_back(loadChunks, i);
+
+  loadChunks(0);
+
+  for (auto & thread : threads)
+    thread.join();
+}
+
+BicycleDirectionsEngine::FeatureAttrs const * BicycleDirectionsEngine::GetFeatureAttrs(
+    FeatureID const & featureId) const
+{
+  auto const it = lower_bound(m_featureIds.cbegin(), m_featureIds.cend(), featureId);
+  if (it == m_featureIds.cend() || *it != featureId)
+    return nullptr;
+
+  FeatureAttrs const & attrs = m_featureAttrs[distance(m_featureIds.cbegin(), it)];
+  return attrs.m_isLoaded ? &attrs : nullptr;
 }
 
-void BicycleDirectionsEngine::LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment)
+void BicycleDirectionsEngine::LoadPathAttributes(FeatureID const & featureId,
+                                                 LoadedPathSegment & pathSegment) const
 {
   if (!featureId.IsValid())
     return;
 
-  FeatureType ft;
-  if(!GetLoader(featureId.m_mwmId).GetFeatureByIndex(featureId.m_index, ft))
+  FeatureAttrs const * attrs = GetFeatureAttrs(featureId);
+  if (!attrs)
     return;
 
-  auto const highwayClass = ftypes::GetHighwayClass(feature::TypesHolder(ft));
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Error, ());
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Undefined, ());
-
-  pathSegment.m_highwayClass = highwayClass;
-  pathSegment.m_isLink = ftypes::IsLinkChecker::Instance()(ft);
-  ft.GetName(StringUtf8Multilang::kDefaultCode, pathSegment.m_name);
-  pathSegment.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(ft);
+  pathSegment.m_highwayClass = attrs->m_highwayClass;
+  pathSegment.m_isLink = attrs->m_isLink;
+  pathSegment.m_name = attrs->m_name;
+  pathSegment.m_onRoundabout = attrs->m_onRoundabout;
 }
 
-void BicycleDirectionsEngine::GetSegmentRangeAndAdjacentEdges(
-    IRoadGraph::TEdgeVector const & outgoingEdges, Edge const & inEdge, uint32_t startSegId,
-    uint32_t endSegId, SegmentRange & segmentRange, TurnCandidates & outgoingTurns)
+void BicycleDirectionsEngine::GetAdjacentEdges(IRoadGraph::TEdgeVector const & outgoingEdges,
+                                               Edge const & inEdge,
+                                               TurnCandidates & outgoingTurns) const
 {
   outgoingTurns.isCandidatesAngleValid = true;
   outgoingTurns.candidates.reserve(outgoingEdges.size());
-  segmentRange = SegmentRange(inEdge.GetFeatureId(), startSegId, endSegId, inEdge.IsForward(),
-                              inEdge.GetStartPoint(), inEdge.GetEndPoint());
-  CHECK(segmentRange.IsCorrect(), ());
   m2::PointD const & ingoingPoint = inEdge.GetStartJunction().GetPoint();
   m2::PointD const & junctionPoint = inEdge.GetEndJunction().GetPoint();
 
@@ -254,17 +325,10 @@ void BicycleDirectionsEngine::GetSegmentRangeAndAdjacentEdges(
     if (edge.IsFake())
       continue;
 
-    auto const & outFeatureId = edge.GetFeatureId();
-    FeatureType ft;
-    if (!GetLoader(outFeatureId.m_mwmId).GetFeatureByIndex(outFeatureId.m_index, ft))
+    FeatureAttrs const * attrs = GetFeatureAttrs(edge.GetFeatureId());
+    if (!attrs)
       continue;
 
-    auto const highwayClass = ftypes::GetHighwayClass(feature::TypesHolder(ft));
-    ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Error, ());
-    ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Undefined, ());
-
-    bool const isLink = ftypes::IsLinkChecker::Instance()(ft);
-
     double angle = 0;
 
     if (inEdge.GetFeatureId().m_mwmId == edge.GetFeatureId().m_mwmId)
@@ -284,7 +348,7 @@ void BicycleDirectionsEngine::GetSegmentRangeAndAdjacentEdges(
       outgoingTurns.isCandidatesAngleValid = false;
     }
     outgoingTurns.candidates.emplace_back(angle, ConvertEdgeToSegment(*m_numMwmIds, edge),
-                                          highwayClass, isLink);
+                                          attrs->m_highwayClass, attrs->m_isLink);
   }
 
   if (outgoingTurns.isCandidatesAngleValid)
@@ -309,7 +373,9 @@ void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
   size_t const pathSize = path.size();
   CHECK_GREATER(pathSize, 1, ());
   CHECK_EQUAL(routeEdges.size() + 1, pathSize, ());
-  // Filling |m_adjacentEdges|.
+  // Features are not read while the path is split into path segments. Features of all the path
+  // segments and their turn candidates are read together after that in LoadFeatureAttrs().
+  vector<PendingPathSegment> pendingSegments;
   auto constexpr kInvalidSegId = numeric_limits<uint32_t>::max();
   // |startSegId| is a value to keep start segment id of a new instance of LoadedPathSegment.
   uint32_t startSegId = kInvalidSegId;
@@ -351,25 +417,57 @@ void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
 
     prevJunctions.push_back(currJunction);
 
-    AdjacentEdges adjacentEdges(ingoingEdges.size());
-    SegmentRange segmentRange;
-    GetSegmentRangeAndAdjacentEdges(outgoingEdges, inEdge, startSegId, inSegId, segmentRange,
-                                    adjacentEdges.m_outgoingTurns);
+    PendingPathSegment pending;
+    SegmentRange & segmentRange = pending.m_pathSegment.m_segmentRange;
+    segmentRange = SegmentRange(inEdge.GetFeatureId(), startSegId, inSegId, inEdge.IsForward(),
+                                inEdge.GetStartPoint(), inEdge.GetEndPoint());
+    CHECK(segmentRange.IsCorrect(), ());
 
     size_t const prevJunctionSize = prevJunctions.size();
-    LoadedPathSegment pathSegment;
-    LoadPathAttributes(segmentRange.GetFeature(), pathSegment);
-    pathSegment.m_segmentRange = segmentRange;
-    pathSegment.m_path = move(prevJunctions);
+    pending.m_pathSegment.m_path = move(prevJunctions);
     // @TODO(bykoianko) |pathSegment.m_weight| should be filled here.
 
     // |prevSegments| contains segments which corresponds to road edges between joints. In case of a fake edge
     // a fake segment is created.
     CHECK_EQUAL(prevSegments.size() + 1, prevJunctionSize, ());
-    pathSegment.m_segments = move(prevSegments);
+    pending.m_pathSegment.m_segments = move(prevSegments);
+
+    if (inFeatureId.IsValid())
+      m_featureIds.push_back(inFeatureId);
+    for (auto const & edge : outgoingEdges)
+    {
+      if (!edge.IsFake())
+        m_featureIds.push_back(edge.GetFeatureId());
+    }
+
+    pending.m_inEdge = inEdge;
+    pending.m_outgoingEdges = move(outgoingEdges);
+    pending.m_ingoingEdgesCount = ingoingEdges.size();
+    pendingSegments.push_back(move(pending));
+
+    prevJunctions.clear();
+    prevSegments.clear();
+    startSegId = kInvalidSegId;
+  }
+
+  if (cancellable.IsCancelled())
+    return;
+
+  base::SortUnique(m_featureIds);
+  LoadFeatureAttrs();
+
+  m_pathSegments.reserve(pendingSegments.size());
+  for (auto & pending : pendingSegments)
+  {
+    LoadedPathSegment & pathSegment = pending.m_pathSegment;
+    SegmentRange const & segmentRange = pathSegment.m_segmentRange;
+    LoadPathAttributes(segmentRange.GetFeature(), pathSegment);
 
     if (!segmentRange.IsEmpty())
     {
+      AdjacentEdges adjacentEdges(pending.m_ingoingEdgesCount);
+      GetAdjacentEdges(pending.m_outgoingEdges, pending.m_inEdge, adjacentEdges.m_outgoingTurns);
+
       auto const it = m_adjacentEdges.find(segmentRange);
       // A route may be built through intermediate points. So it may contain the same |segmentRange|
       // several times. But in that case |adjacentEdges| corresponding to |segmentRange|
@@ -381,10 +479,6 @@ void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
     }
 
     m_pathSegments.push_back(move(pathSegment));
-
-    prevJunctions.clear();
-    prevSegments.clear();
-    startSegId = kInvalidSegId;
   }
 }
 }  // namespace routing
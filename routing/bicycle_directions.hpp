@@ -8,9 +8,12 @@
 #include "routing_common/num_mwm_id.hpp"
 
 #include "indexer/data_source.hpp"
+#include "indexer/feature_decl.hpp"
 
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace routing
 {
@@ -37,12 +40,25 @@ public:
                 vector<Segment> & segments) override;
 
 private:
-  FeaturesLoaderGuard & GetLoader(MwmSet::MwmId const & id);
-  void LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment);
-  void GetSegmentRangeAndAdjacentEdges(IRoadGraph::TEdgeVector const & outgoingEdges,
-                                       Edge const & inEdge, uint32_t startSegId, uint32_t endSegId,
-                                       SegmentRange & segmentRange,
-                                       turns::TurnCandidates & outgoingTurns);
+  /// \brief Attributes of a feature which are used for turn generation.
+  struct FeatureAttrs
+  {
+    std::string m_name;
+    ftypes::HighwayClass m_highwayClass = ftypes::HighwayClass::Undefined;
+    bool m_isLink = false;
+    bool m_onRoundabout = false;
+    bool m_isLoaded = false;
+  };
+
+  /// \brief Loads attributes of |m_featureIds| to |m_featureAttrs|. |m_featureIds| should be
+  /// sorted. The features are read in chunks of features of the same mwm sorted by index
+  /// and the chunks are read in parallel.
+  void LoadFeatureAttrs();
+  /// \returns attributes of |featureId| or nullptr if the feature is not loaded.
+  FeatureAttrs const * GetFeatureAttrs(FeatureID const & featureId) const;
+  void LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment) const;
+  void GetAdjacentEdges(IRoadGraph::TEdgeVector const & outgoingEdges, Edge const & inEdge,
+                        turns::TurnCandidates & outgoingTurns) const;
   /// \brief The method gathers sequence of segments according to IsJoint() method
   /// and fills |m_adjacentEdges| and |m_pathSegments|.
   void FillPathSegmentsAndAdjacentEdgesMap(IndexRoadGraph const & graph,
@@ -56,8 +72,10 @@ private:
 
   AdjacentEdgesMap m_adjacentEdges;
   TUnpackedPathSegments m_pathSegments;
+  // Features of the route and of the turn candidates and their attributes.
+  std::vector<FeatureID> m_featureIds;
+  std::vector<FeatureAttrs> m_featureAttrs;
   DataSource const & m_dataSource;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
-  std::unique_ptr<FeaturesLoaderGuard> m_loader;
 };
 }  // namespace routing
@@ -1,4 +1,5 @@
 #include "routing/cross_mwm_graph.hpp"
+#include "routing/index_graph_loader.hpp"
 #include "routing/routing_exceptions.hpp"
 #include "routing/transit_graph.hpp"
 
@@ -154,6 +155,15 @@ void CrossMwmGraph::DeserializeTransitTransitions(vector<NumMwmId> const & mwmId
   }
 }
 
+void CrossMwmGraph::PrefetchNeighbors(vector<NumMwmId> const & mwmIds)
+{
+  for (auto const mwmId : mwmIds)
+  {
+    if (m_prefetchedMwms.insert(mwmId).second)
+      IndexGraphLoader::Prefetch(m_dataSource, m_numMwmIds->GetFile(mwmId));
+  }
+}
+
 void CrossMwmGraph::GetTwins(Segment const & s, bool isOutgoing, vector<Segment> & twins)
 {
   CHECK(IsTransition(s, isOutgoing),
@@ -173,6 +183,7 @@ void CrossMwmGraph::GetTwins(Segment const & s, bool isOutgoing, vector<Segment>
   CHECK_NOT_EQUAL(currentMwmStatus, MwmStatus::NotLoaded,
                   ("Current mwm is not loaded. Mwm:", m_numMwmIds->GetFile(s.GetMwmId()),
                    "currentMwmStatus:", currentMwmStatus));
+  PrefetchNeighbors(neighbors);
 
   if (TransitGraph::IsTransitSegment(s) && TransitCrossMwmSectionExists(s.GetMwmId()))
   {
@@ -16,6 +16,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -147,6 +148,9 @@ private:
   /// \brief Deserizlize transitions for mwm with |ids|.
   void DeserializeTransitions(std::vector<NumMwmId> const & mwmIds);
   void DeserializeTransitTransitions(std::vector<NumMwmId> const & mwmIds);
+  /// \brief Prefetches graph sections of |mwmIds| which are not prefetched yet. Routes which
+  /// leave an mwm usually go on through its neighbors, so their graph is loaded soon.
+  void PrefetchNeighbors(std::vector<NumMwmId> const & mwmIds);
 
   DataSource & m_dataSource;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
@@ -155,6 +159,7 @@ private:
   CourntryRectFn const & m_countryRectFn;
   CrossMwmIndexGraph<base::GeoObjectId> m_crossMwmIndexGraph;
   CrossMwmIndexGraph<connector::TransitId> m_crossMwmTransitGraph;
+  std::set<NumMwmId> m_prefetchedMwms;
 };
 
 string DebugPrint(CrossMwmGraph::MwmStatus status);
@@ -0,0 +1,96 @@
+#include "routing/cross_mwm_traffic_weights.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+
+#include "routing/cross_mwm_connector.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/route_weight.hpp"
+
+#include "base/assert.hpp"
+
+#include <set>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+using namespace routing;
+
+// Calculates leaps from |enter| to |exits| in the way it's done while cross mwm sections are
+// generated. The wave is stopped when all the exits are reached.
+void CalcLeaps(Segment const & enter, vector<Segment> const & exits, IndexGraph & graph,
+               vector<SegmentEdge> & edges)
+{
+  set<Segment> notReachedExits(exits.cbegin(), exits.cend());
+
+  AStarAlgorithm<IndexGraph> astar;
+  AStarAlgorithm<IndexGraph>::Context context;
+  astar.PropagateWave(graph, enter,
+                      [&notReachedExits](Segment const & vertex) {
+                        notReachedExits.erase(vertex);
+                        return !notReachedExits.empty();
+                      } /* visitVertex */,
+                      context);
+
+  for (Segment const & exit : exits)
+  {
+    if (!context.HasDistance(exit))
+      continue;
+
+    double const weight = context.GetDistance(exit).ToCrossMwmWeight();
+    // @TODO Double and uint32_t are compared below. The same comparison is in CrossMwmConnector.
+    if (weight != connector::kNoRoute)
+      edges.emplace_back(exit, RouteWeight::FromCrossMwmWeight(weight));
+  }
+}
+}  // namespace
+
+namespace routing
+{
+CrossMwmTrafficWeights::CrossMwmTrafficWeights(shared_ptr<TrafficStash> trafficStash)
+  : m_trafficStash(move(trafficStash))
+{
+  CHECK(m_trafficStash, ());
+}
+
+bool CrossMwmTrafficWeights::GetOutgoingEdgeList(Segment const & enter,
+                                                 vector<Segment> const & exits,
+                                                 IndexGraph & graph, vector<SegmentEdge> & edges)
+{
+  NumMwmId const mwmId = enter.GetMwmId();
+  auto coloring = m_trafficStash->GetColoring(mwmId);
+  if (!coloring)
+    return false;
+
+  // Rows are calculated under the lock, so a row requested by several graphs at once is
+  // calculated only once.
+  lock_guard<mutex> guard(m_mutex);
+  MwmWeights & mwmWeights = m_mwmToWeights[mwmId];
+  // Traffic of the mwm was updated. Weights of other mwms stay valid.
+  if (mwmWeights.m_coloring != coloring)
+  {
+    mwmWeights.m_enterToEdges.clear();
+    mwmWeights.m_coloring = move(coloring);
+  }
+
+  auto it = mwmWeights.m_enterToEdges.find(enter);
+  if (it == mwmWeights.m_enterToEdges.end())
+  {
+    it = mwmWeights.m_enterToEdges.emplace(enter, vector<SegmentEdge>()).first;
+    CalcLeaps(enter, exits, graph, it->second);
+  }
+
+  edges.insert(edges.end(), it->second.cbegin(), it->second.cend());
+  return true;
+}
+
+size_t CrossMwmTrafficWeights::GetRowsNumber() const
+{
+  lock_guard<mutex> guard(m_mutex);
+  size_t rowsNumber = 0;
+  for (auto const & kv : m_mwmToWeights)
+    rowsNumber += kv.second.m_enterToEdges.size();
+  return rowsNumber;
+}
+}  // namespace routing
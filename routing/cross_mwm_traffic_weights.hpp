@@ -0,0 +1,64 @@
+#pragma once
+
+#include "routing/segment.hpp"
+#include "routing/traffic_stash.hpp"
+
+#include "traffic/traffic_info.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace routing
+{
+class IndexGraph;
+
+/// \brief Leap weights (weights of routes from mwm enters to mwm exits) which take traffic into
+/// account.
+/// \note Leap weights of cross mwm sections are calculated without traffic while the maps are
+/// generated. For mwms with traffic the weights are calculated with |trafficStash| lazily: a row
+/// of weights from an enter to all the exits of the mwm is calculated when it's requested for
+/// the first time. The rows are kept between routing requests and dropped only for mwms whose
+/// traffic was updated.
+/// \note The class is thread-safe: it's shared by routing graphs of one router which may
+/// calculate subroutes of a route in parallel.
+class CrossMwmTrafficWeights final
+{
+public:
+  explicit CrossMwmTrafficWeights(std::shared_ptr<TrafficStash> trafficStash);
+
+  /// \brief Fills |edges| with leaps from |enter| to |exits| of the same mwm weighted with
+  /// current traffic. |graph| is the index graph of |enter| mwm with an edge estimator which uses
+  /// the traffic stash of the class.
+  /// \returns false if there's no traffic for |enter| mwm. |edges| is not changed in that case
+  /// and leaps with the weights of cross mwm section should be used.
+  bool GetOutgoingEdgeList(Segment const & enter, std::vector<Segment> const & exits,
+                           IndexGraph & graph, std::vector<SegmentEdge> & edges);
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_mwmToWeights.clear();
+  }
+
+  /// \returns number of calculated rows of weights for all mwms.
+  size_t GetRowsNumber() const;
+
+private:
+  struct MwmWeights
+  {
+    // Traffic coloring the weights are calculated with.
+    std::shared_ptr<traffic::TrafficInfo::Coloring const> m_coloring;
+    std::map<Segment, std::vector<SegmentEdge>> m_enterToEdges;
+  };
+
+  std::shared_ptr<TrafficStash> m_trafficStash;
+  mutable std::mutex m_mutex;
+  std::unordered_map<NumMwmId, MwmWeights> m_mwmToWeights;
+};
+}  // namespace routing
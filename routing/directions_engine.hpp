@@ -27,5 +27,11 @@ public:
                         base::Cancellable const & cancellable, Route::TTurns & turns,
                         Route::TStreets & streetNames, vector<Junction> & routeGeometry,
                         vector<Segment> & segments) = 0;
+
+  /// \returns time of turn generation of the last Generate() call in seconds.
+  double GetTurnsGenerationSec() const { return m_turnsGenerationSec; }
+
+protected:
+  double m_turnsGenerationSec = 0.0;
 };
 }  // namespace routing
@@ -111,6 +111,37 @@ double EdgeEstimator::CalcOffroadWeight(m2::PointD const & from, m2::PointD cons
   return TimeBetweenSec(from, to, m_offroadSpeedMpS);
 }
 
+void EdgeEstimator::SetSpeedProfiles(NumMwmId mwmId, shared_ptr<SpeedProfiles const> profiles)
+{
+  if (mwmId >= m_speedProfiles.size())
+    m_speedProfiles.resize(mwmId + 1);
+  m_speedProfiles[mwmId] = move(profiles);
+}
+
+void EdgeEstimator::SetDepartureTime(time_t utcTime, double lon)
+{
+  m_hasDepartureTime = true;
+  m_departureWeekTimeSec = SpeedProfiles::GetWeekTimeSec(utcTime, lon);
+}
+
+double EdgeEstimator::ApplySpeedProfile(Segment const & segment, RoadGeometry const & road,
+                                        double timeSec) const
+{
+  NumMwmId const mwmId = segment.GetMwmId();
+  if (!m_hasDepartureTime || mwmId >= m_speedProfiles.size() || !m_speedProfiles[mwmId])
+    return timeSec;
+
+  double const factor = m_speedProfiles[mwmId]->GetFactor(
+      segment.GetFeatureId(), segment.IsForward(), m_departureWeekTimeSec);
+  if (factor == 1.0)
+    return timeSec;
+
+  double const minTimeSec =
+      TimeBetweenSec(road.GetPoint(segment.GetPointId(false /* front */)),
+                     road.GetPoint(segment.GetPointId(true /* front */)), m_maxWeightSpeedMpS);
+  return max(timeSec / factor, minTimeSec);
+}
+
 // PedestrianEstimator -----------------------------------------------------------------------------
 class PedestrianEstimator final : public EdgeEstimator
 {
@@ -213,15 +244,17 @@ double CarEstimator::CalcSegment(Purpose purpose, Segment const & segment, RoadG
 
   double result = CalcClimbSegment(purpose, segment, road, GetCarClimbPenalty);
 
-  if (m_trafficStash)
-  {
-    SpeedGroup const speedGroup = m_trafficStash->GetSpeedGroup(segment);
-    ASSERT_LESS(speedGroup, SpeedGroup::Count, ());
-    double const trafficFactor = CalcTrafficFactor(speedGroup);
-    result *= trafficFactor;
-    if (speedGroup != SpeedGroup::Unknown && speedGroup != SpeedGroup::G5)
-      result *= kTimePenalty;
-  }
+  SpeedGroup const speedGroup =
+      m_trafficStash ? m_trafficStash->GetSpeedGroup(segment) : SpeedGroup::Unknown;
+  ASSERT_LESS(speedGroup, SpeedGroup::Count, ());
+  // Live traffic is more accurate than historical speeds.
+  if (speedGroup == SpeedGroup::Unknown)
+    return ApplySpeedProfile(segment, road, result);
+
+  double const trafficFactor = CalcTrafficFactor(speedGroup);
+  result *= trafficFactor;
+  if (speedGroup != SpeedGroup::G5)
+    result *= kTimePenalty;
 
   return result;
 }
@@ -2,6 +2,7 @@
 
 #include "routing/geometry.hpp"
 #include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
 #include "routing/traffic_stash.hpp"
 #include "routing/vehicle_mask.hpp"
 
@@ -14,7 +15,10 @@
 
 #include "geometry/point2d.hpp"
 
+#include <cstdint>
+#include <ctime>
 #include <memory>
+#include <vector>
 
 namespace routing
 {
@@ -45,6 +49,12 @@ public:
   // Check wherether leap is allowed on specified mwm or not.
   virtual bool LeapIsAllowed(NumMwmId mwmId) const = 0;
 
+  // Historical speed profiles of |mwmId| are applied by estimators which support them
+  // at the week time of the departure.
+  void SetSpeedProfiles(NumMwmId mwmId, std::shared_ptr<SpeedProfiles const> profiles);
+  // |lon| is the longitude of the start, see SpeedProfiles::GetWeekTimeSec().
+  void SetDepartureTime(time_t utcTime, double lon);
+
   static std::shared_ptr<EdgeEstimator> Create(VehicleType vehicleType, double maxWeighSpeedKMpH,
                                                double offroadSpeedKMpH,
                                                std::shared_ptr<TrafficStash>);
@@ -53,8 +63,18 @@ public:
                                                VehicleModelInterface const & vehicleModel,
                                                std::shared_ptr<TrafficStash>);
 
+protected:
+  // Divides |timeSec| of |segment| by its historical speed factor. The result is not less than
+  // the time at the max speed, so CalcHeuristic() is still a lower bound.
+  double ApplySpeedProfile(Segment const & segment, RoadGeometry const & road,
+                           double timeSec) const;
+
 private:
   double const m_maxWeightSpeedMpS;
   double const m_offroadSpeedMpS;
+  // Indexed by NumMwmId, null for mwms without profiles.
+  std::vector<std::shared_ptr<SpeedProfiles const>> m_speedProfiles;
+  bool m_hasDepartureTime = false;
+  uint32_t m_departureWeekTimeSec = 0;
 };
 }  // namespace routing
@@ -1,24 +1,36 @@
 #pragma once
 
 #include "base/assert.hpp"
-#include "base/stl_helpers.hpp"
-#include "base/stl_iterator.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <map>
-#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace routing
 {
+// Fake graph is queried for every edge which is expanded near the endings, so fake segments
+// with their vertices and edges are stored in one vector sorted by segments. Fake segments are
+// numbered consecutively, so as a rule they are appended to the end of the vector.
+// *NOTE* References returned by the methods are invalidated by adding of vertices.
 template <typename SegmentType, typename VertexType>
 class FakeGraph final
 {
 public:
+  // Sorted unique segments.
+  using Segments = std::vector<SegmentType>;
+
+  // Preallocates memory for |segmentsCount| fake segments.
+  void Reserve(size_t segmentsCount) { m_entries.reserve(segmentsCount); }
+
   // Adds vertex with no connections.
   void AddStandaloneVertex(SegmentType const & newSegment, VertexType const & newVertex)
   {
-    m_segmentToVertex[newSegment] = newVertex;
+    GetOrCreateEntry(newSegment).m_vertex = newVertex;
     m_vertexToSegment[newVertex] = newSegment;
   }
 
@@ -29,96 +41,92 @@ public:
                  VertexType const & newVertex, bool isOutgoing, bool isPartOfReal,
                  SegmentType const & real)
   {
+    CHECK(FindEntry(existentSegment) != nullptr,
+          ("Segment", existentSegment, "does not exist in fake graph."));
     AddStandaloneVertex(newSegment, newVertex);
     auto const & segmentFrom = isOutgoing ? existentSegment : newSegment;
     auto const & segmentTo = isOutgoing ? newSegment : existentSegment;
-    m_outgoing[segmentFrom].insert(segmentTo);
-    m_ingoing[segmentTo].insert(segmentFrom);
+    Connect(segmentFrom, segmentTo);
     if (isPartOfReal)
     {
-      m_realToFake[real].insert(newSegment);
-      m_fakeToReal[newSegment] = real;
+      InsertUnique(m_realToFake[real], newSegment);
+      auto & entry = GetOrCreateEntry(newSegment);
+      entry.m_isPartOfReal = true;
+      entry.m_real = real;
     }
   }
 
   // Adds connection from existent fake segment |from| to existent fake segment |to|
   void AddConnection(SegmentType const & from, SegmentType const & to)
   {
-    ASSERT(m_segmentToVertex.find(from) != m_segmentToVertex.end(),
-           ("Segment", from, "does not exist in fake graph."));
-    ASSERT(m_segmentToVertex.find(to) != m_segmentToVertex.end(),
-           ("Segment", to, "does not exist in fake graph."));
-    m_outgoing[from].insert(to);
-    m_ingoing[to].insert(from);
+    ASSERT(FindEntry(from) != nullptr, ("Segment", from, "does not exist in fake graph."));
+    ASSERT(FindEntry(to) != nullptr, ("Segment", to, "does not exist in fake graph."));
+    Connect(from, to);
   }
 
   // Merges |rhs| into this.
   void Append(FakeGraph const & rhs)
   {
-    auto IsIntersectionEmpty = [](std::map<SegmentType, VertexType> const & lhs,
-                                  std::map<SegmentType, VertexType> const & rhs) {
-      auto const counter =
-          std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), CounterIterator(),
-                                base::LessBy(&std::pair<SegmentType, VertexType>::first));
-      return counter.GetCount() == 0;
+    std::vector<Entry> entries;
+    entries.reserve(m_entries.size() + rhs.m_entries.size());
+    std::merge(m_entries.begin(), m_entries.end(), rhs.m_entries.begin(), rhs.m_entries.end(),
+               std::back_inserter(entries), LessBySegment());
+    auto const IsEqual = [](Entry const & lhs, Entry const & rhs) {
+      return !(lhs.m_segment < rhs.m_segment) && !(rhs.m_segment < lhs.m_segment);
     };
-
-    CHECK(IsIntersectionEmpty(m_segmentToVertex, rhs.m_segmentToVertex),
+    CHECK(std::adjacent_find(entries.begin(), entries.end(), IsEqual) == entries.end(),
           ("Fake segments are not unique."));
+    m_entries = std::move(entries);
 
-    m_segmentToVertex.insert(rhs.m_segmentToVertex.begin(), rhs.m_segmentToVertex.end());
     m_vertexToSegment.insert(rhs.m_vertexToSegment.begin(), rhs.m_vertexToSegment.end());
 
-    for (auto const & kv : rhs.m_outgoing)
-      m_outgoing[kv.first].insert(kv.second.begin(), kv.second.end());
-
-    for (auto const & kv : rhs.m_ingoing)
-      m_ingoing[kv.first].insert(kv.second.begin(), kv.second.end());
-
     for (auto const & kv : rhs.m_realToFake)
-      m_realToFake[kv.first].insert(kv.second.begin(), kv.second.end());
-
-    m_fakeToReal.insert(rhs.m_fakeToReal.begin(), rhs.m_fakeToReal.end());
+    {
+      auto & fake = m_realToFake[kv.first];
+      Segments merged;
+      merged.reserve(fake.size() + kv.second.size());
+      std::set_union(fake.begin(), fake.end(), kv.second.begin(), kv.second.end(),
+                     std::back_inserter(merged));
+      fake = std::move(merged);
+    }
   }
 
   // Returns Vertex which corresponds |segment|. Segment must be a part of the fake graph.
   VertexType const & GetVertex(SegmentType const & segment) const
   {
-    auto const it = m_segmentToVertex.find(segment);
-    CHECK(it != m_segmentToVertex.end(), ("Vertex for invalid fake segment requested."));
-    return it->second;
+    auto const * entry = FindEntry(segment);
+    CHECK(entry != nullptr, ("Vertex for invalid fake segment requested."));
+    return entry->m_vertex;
   }
 
   // Returns outgoing/ingoing edges set for specified segment.
-  std::set<SegmentType> const & GetEdges(SegmentType const & segment, bool isOutgoing) const
+  Segments const & GetEdges(SegmentType const & segment, bool isOutgoing) const
   {
-    auto const & adjacentEdges = isOutgoing ? m_outgoing : m_ingoing;
-
-    auto const it = adjacentEdges.find(segment);
-    if (it != adjacentEdges.end())
-      return it->second;
+    auto const * entry = FindEntry(segment);
+    if (entry == nullptr)
+      return GetEmptySegments();
 
-    return kEmptySet;
+    return isOutgoing ? entry->m_outgoing : entry->m_ingoing;
   }
 
-  size_t GetSize() const { return m_segmentToVertex.size(); }
+  size_t GetSize() const { return m_entries.size(); }
 
-  std::set<SegmentType> const & GetFake(SegmentType const & real) const
+  Segments const & GetFake(SegmentType const & real) const
   {
     auto const it = m_realToFake.find(real);
     if (it != m_realToFake.end())
       return it->second;
 
-    return kEmptySet;
+    return GetEmptySegments();
   }
 
   bool FindReal(SegmentType const & fake, SegmentType & real) const
   {
-    auto const it = m_fakeToReal.find(fake);
-    if (it == m_fakeToReal.end())
+    auto const * entry = FindEntry(fake);
+    if (entry == nullptr || !entry->m_isPartOfReal)
       return false;
 
-    real = it->second;
+    real = entry->m_real;
     return true;
   }
 
@@ -133,20 +141,81 @@ public:
   }
 
 private:
-  // Key is fake segment, value is set of outgoing fake segments.
-  std::map<SegmentType, std::set<SegmentType>> m_outgoing;
-  // Key is fake segment, value is set of ingoing fake segments.
-  std::map<SegmentType, std::set<SegmentType>> m_ingoing;
-  // Key is fake segment, value is fake vertex which corresponds fake segment.
-  std::map<SegmentType, VertexType> m_segmentToVertex;
+  struct Entry
+  {
+    SegmentType m_segment;
+    VertexType m_vertex;
+    // Outgoing and ingoing fake segments.
+    Segments m_outgoing;
+    Segments m_ingoing;
+    // Real segment if the fake segment has type VertexType::Type::PartOfReal.
+    bool m_isPartOfReal = false;
+    SegmentType m_real;
+  };
+
+  struct LessBySegment
+  {
+    bool operator()(Entry const & lhs, Entry const & rhs) const
+    {
+      return lhs.m_segment < rhs.m_segment;
+    }
+    bool operator()(Entry const & lhs, SegmentType const & rhs) const
+    {
+      return lhs.m_segment < rhs;
+    }
+  };
+
+  // To return empty segments by const reference.
+  static Segments const & GetEmptySegments()
+  {
+    static Segments const kEmptySegments;
+    return kEmptySegments;
+  }
+
+  static void InsertUnique(Segments & segments, SegmentType const & segment)
+  {
+    auto const it = std::lower_bound(segments.begin(), segments.end(), segment);
+    if (it == segments.end() || segment < *it)
+      segments.insert(it, segment);
+  }
+
+  Entry const * FindEntry(SegmentType const & segment) const
+  {
+    auto const it =
+        std::lower_bound(m_entries.begin(), m_entries.end(), segment, LessBySegment());
+    if (it == m_entries.end() || segment < it->m_segment)
+      return nullptr;
+    return &*it;
+  }
+
+  Entry & GetOrCreateEntry(SegmentType const & segment)
+  {
+    auto it = m_entries.end();
+    if (!m_entries.empty() && !(m_entries.back().m_segment < segment))
+    {
+      it = std::lower_bound(m_entries.begin(), m_entries.end(), segment, LessBySegment());
+      if (!(segment < it->m_segment))
+        return *it;
+    }
+
+    it = m_entries.emplace(it);
+    it->m_segment = segment;
+    return *it;
+  }
+
+  void Connect(SegmentType const & from, SegmentType const & to)
+  {
+    InsertUnique(GetOrCreateEntry(from).m_outgoing, to);
+    InsertUnique(GetOrCreateEntry(to).m_ingoing, from);
+  }
+
+  // Fake segments sorted by segments.
+  std::vector<Entry> m_entries;
   // Key is fake vertex value is fake segment which corresponds fake vertex.
+  // It's used while the graph is built only, so it's not flat.
   std::map<VertexType, SegmentType> m_vertexToSegment;
-  // Key is fake segment of type VertexType::Type::PartOfReal, value is corresponding real segment.
-  std::map<SegmentType, SegmentType> m_fakeToReal;
-  // Key is real segment, value is set of fake segments with type VertexType::Type::PartOfReal
+  // Key is real segment, value is fake segments with type VertexType::Type::PartOfReal
   // which are parts of this real segment.
-  std::map<SegmentType, std::set<SegmentType>> m_realToFake;
-  // To return empty set by const reference.
-  std::set<SegmentType> const kEmptySet = std::set<SegmentType>();
+  std::unordered_map<SegmentType, Segments> m_realToFake;
 };
 }  // namespace routing
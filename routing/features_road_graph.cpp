@@ -13,9 +13,13 @@
 
 #include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/stl_helpers.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/limits.hpp"
 
+#include "defines.hpp"
+
 namespace routing
 {
 
@@ -38,6 +42,25 @@ FeaturesRoadGraph::Value::Value(DataSource const & dataSource, MwmSet::MwmHandle
     return;
 
   m_altitudeLoader = make_unique<feature::AltitudeLoader>(dataSource, m_mwmHandle.GetId());
+
+  auto const & cont = m_mwmHandle.GetValue<MwmValue>()->m_cont;
+  if (!cont.IsExist(ROAD_SNAPPING_FILE_TAG))
+    return;
+
+  try
+  {
+    auto const reader = cont.GetReader(ROAD_SNAPPING_FILE_TAG);
+    vector<uint8_t> data(static_cast<size_t>(reader.Size()));
+    reader.Read(0 /* pos */, data.data(), data.size());
+    m_snappingIndex = make_unique<RoadSnappingIndex>();
+    if (!m_snappingIndex->Init(move(data)))
+      m_snappingIndex.reset();
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Error while reading", ROAD_SNAPPING_FILE_TAG, "section.", e.Msg()));
+    m_snappingIndex.reset();
+  }
 }
 
 FeaturesRoadGraph::CrossCountryVehicleModel::CrossCountryVehicleModel(
@@ -74,6 +97,12 @@ bool FeaturesRoadGraph::CrossCountryVehicleModel::IsPassThroughAllowed(FeatureTy
   return GetVehicleModel(f.GetID())->IsPassThroughAllowed(f);
 }
 
+VehicleModelInterface::RoadInfo FeaturesRoadGraph::CrossCountryVehicleModel::GetRoadInfo(
+    FeatureType & f, bool inCity) const
+{
+  return GetVehicleModel(f.GetID())->GetRoadInfo(f, inCity);
+}
+
 VehicleModelInterface * FeaturesRoadGraph::CrossCountryVehicleModel::GetVehicleModel(
     FeatureID const & featureId) const
 {
@@ -109,8 +138,12 @@ void FeaturesRoadGraph::RoadInfoCache::Clear()
   m_cache.clear();
 }
 FeaturesRoadGraph::FeaturesRoadGraph(DataSource const & dataSource, IRoadGraph::Mode mode,
-                                     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory)
-  : m_dataSource(dataSource), m_mode(mode), m_vehicleModel(vehicleModelFactory)
+                                     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
+                                     VehicleMask snappingMask)
+  : m_dataSource(dataSource)
+  , m_mode(mode)
+  , m_snappingMask(snappingMask)
+  , m_vehicleModel(vehicleModelFactory)
 {
 }
 
@@ -185,9 +218,117 @@ void FeaturesRoadGraph::FindClosestEdges(m2::PointD const & point, uint32_t coun
     finder.AddInformationSource(featureId, roadInfo.m_junctions, roadInfo.m_bidirectional);
   };
 
-  m_dataSource.ForEachInRect(
-      f, MercatorBounds::RectByCenterXYAndSizeInMeters(point, kMwmCrossingNodeEqualityRadiusMeters),
-      GetStreetReadScale());
+  m2::RectD const rect =
+      MercatorBounds::RectByCenterXYAndSizeInMeters(point, kMwmCrossingNodeEqualityRadiusMeters);
+  int const scale = GetStreetReadScale();
+
+  // Only road features are read from mwms with road snapping index, other mwms are read
+  // entirely in |rect|.
+  vector<shared_ptr<MwmInfo>> mwms;
+  m_dataSource.GetMwmsInfo(mwms);
+  vector<FeatureID> features;
+  for (auto const & info : mwms)
+  {
+    if (info->m_minScale > scale || scale > info->m_maxScale ||
+        !rect.IsIntersect(info->m_bordersRect))
+    {
+      continue;
+    }
+
+    MwmSet::MwmId const mwmId(info);
+    if (!mwmId.IsAlive())
+      continue;
+
+    Value const & value = LockMwm(mwmId);
+    if (!value.IsAlive())
+      continue;
+
+    if (!value.m_snappingIndex)
+    {
+      m_dataSource.ForEachInRectForMWM(f, rect, scale, mwmId);
+      continue;
+    }
+
+    value.m_snappingIndex->ForEachFeature(rect, m_snappingMask, [&](uint32_t featureId) {
+      features.emplace_back(mwmId, featureId);
+    });
+  }
+
+  base::SortUnique(features);
+
+  // Features are read mwm by mwm, so altitudes of roads which are not cached yet are read
+  // by one batch per mwm.
+  vector<pair<FeatureID, RoadInfo>> roads;
+  vector<size_t> uncached;
+  vector<uint32_t> featureIds;
+  vector<size_t> pointCounts;
+  vector<feature::TAltitudes> altitudes;
+  auto const loadAltitudes = [&]() {
+    if (uncached.empty())
+      return;
+
+    Value const & value = LockMwm(roads[uncached.front()].first.m_mwmId);
+    CHECK(value.m_altitudeLoader, ());
+
+    featureIds.clear();
+    pointCounts.clear();
+    for (auto const i : uncached)
+    {
+      featureIds.push_back(roads[i].first.m_index);
+      pointCounts.push_back(roads[i].second.m_junctions.size());
+    }
+    value.m_altitudeLoader->GetAltitudes(featureIds, pointCounts, altitudes);
+
+    for (size_t i = 0; i < uncached.size(); ++i)
+    {
+      auto & road = roads[uncached[i]];
+      auto & junctions = road.second.m_junctions;
+      CHECK_EQUAL(altitudes[i].size(), junctions.size(), (road.first));
+      for (size_t j = 0; j < junctions.size(); ++j)
+        junctions[j] = Junction(junctions[j].GetPoint(), altitudes[i][j]);
+
+      bool found = false;
+      m_cache.Find(road.first, found) = road.second;
+    }
+    uncached.clear();
+  };
+
+  m_dataSource.ReadFeatures(
+      [&](FeatureType & ft) {
+        if (!m_vehicleModel.IsRoad(ft))
+          return;
+
+        FeatureID const featureId = ft.GetID();
+        if (!uncached.empty() && roads[uncached.front()].first.m_mwmId != featureId.m_mwmId)
+          loadAltitudes();
+
+        auto constexpr invalidSpeed = numeric_limits<double>::max();
+        bool found = false;
+        RoadInfo const & cached = m_cache.Find(featureId, found);
+        if (found)
+        {
+          CHECK_EQUAL(cached.m_speedKMPH, invalidSpeed, ());
+          roads.emplace_back(featureId, cached);
+          return;
+        }
+
+        // The cache entry is filled by loadAltitudes().
+        ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+        RoadInfo ri;
+        ri.m_bidirectional = !IsOneWay(ft);
+        ri.m_speedKMPH = invalidSpeed;
+        ri.m_junctions.reserve(ft.GetPointsCount());
+        for (size_t i = 0; i < ft.GetPointsCount(); ++i)
+          ri.m_junctions.emplace_back(ft.GetPoint(i), feature::kDefaultAltitudeMeters);
+
+        uncached.push_back(roads.size());
+        roads.emplace_back(featureId, move(ri));
+      },
+      features);
+  loadAltitudes();
+
+  for (auto const & road : roads)
+    finder.AddInformationSource(road.first, road.second.m_junctions, road.second.m_bidirectional);
 
   finder.MakeResult(vicinities, count);
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "routing/road_graph.hpp"
+#include "routing/road_snapping_index.hpp"
+#include "routing/vehicle_mask.hpp"
 
 #include "routing_common/vehicle_model.hpp"
 
@@ -36,6 +38,7 @@ private:
     bool IsOneWay(FeatureType & f) const override;
     bool IsRoad(FeatureType & f) const override;
     bool IsPassThroughAllowed(FeatureType & f) const override;
+    VehicleModelInterface::RoadInfo GetRoadInfo(FeatureType & f, bool inCity) const override;
 
     void Clear();
 
@@ -62,8 +65,11 @@ private:
   };
 
 public:
+  /// \param snappingMask vehicles whose roads are taken from road snapping index by
+  /// FindClosestEdges(). Roads are checked by |vehicleModelFactory| models anyway.
   FeaturesRoadGraph(DataSource const & dataSource, IRoadGraph::Mode mode,
-                    shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory);
+                    shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
+                    VehicleMask snappingMask = kAllVehiclesMask);
 
   static int GetStreetReadScale();
 
@@ -94,6 +100,8 @@ private:
 
     MwmSet::MwmHandle m_mwmHandle;
     unique_ptr<feature::AltitudeLoader> m_altitudeLoader;
+    // Null if the mwm has no road snapping section.
+    unique_ptr<RoadSnappingIndex> m_snappingIndex;
   };
 
   bool IsOneWay(FeatureType & ft) const;
@@ -113,6 +121,7 @@ private:
 
   DataSource const & m_dataSource;
   IRoadGraph::Mode const m_mode;
+  VehicleMask const m_snappingMask;
   mutable RoadInfoCache m_cache;
   mutable CrossCountryVehicleModel m_vehicleModel;
   mutable map<MwmSet::MwmId, Value> m_mwmLocks;
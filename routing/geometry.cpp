@@ -72,7 +72,6 @@ void GeometryLoaderImpl::Load(uint32_t featureId, RoadGeometry & road)
     altitudes = &(m_altitudeLoader.GetAltitudes(featureId, feature.GetPointsCount()));
 
   road.Load(*m_vehicleModel, feature, altitudes, m_cityRoads->IsCityRoad(featureId));
-  m_altitudeLoader.ClearCache();
 }
 
 // FileGeometryLoader ------------------------------------------------------------------------------
@@ -133,10 +132,11 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
 {
   CHECK(altitudes == nullptr || altitudes->size() == feature.GetPointsCount(), ());
 
-  m_valid = vehicleModel.IsRoad(feature);
-  m_isOneWay = vehicleModel.IsOneWay(feature);
-  m_speed = vehicleModel.GetSpeed(feature, inCity);
-  m_isPassThroughAllowed = vehicleModel.IsPassThroughAllowed(feature);
+  auto const roadInfo = vehicleModel.GetRoadInfo(feature, inCity);
+  m_valid = roadInfo.m_isRoad;
+  m_isOneWay = roadInfo.m_isOneWay;
+  m_speed = roadInfo.m_speed;
+  m_isPassThroughAllowed = roadInfo.m_isPassThroughAllowed;
 
   m_junctions.clear();
   m_junctions.reserve(feature.GetPointsCount());
@@ -160,10 +160,27 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
 
 // Geometry ----------------------------------------------------------------------------------------
 Geometry::Geometry(unique_ptr<GeometryLoader> loader)
-    : m_loader(move(loader))
-    , m_featureIdToRoad(make_unique<FifoCache<uint32_t, RoadGeometry>>(
+  : m_loader(move(loader))
+  , m_featureIdToRoad(make_unique<FifoCache<uint32_t, RoadGeometryCache::RoadPtr>>(
+        kRoadsCacheSize, [this](uint32_t featureId, RoadGeometryCache::RoadPtr & road) {
+          auto loaded = make_shared<RoadGeometry>();
+          m_loader->Load(featureId, *loaded);
+          road = move(loaded);
+        }))
+{
+  CHECK(m_loader, ());
+}
+
+Geometry::Geometry(unique_ptr<GeometryLoader> loader, RoadGeometryCache & sharedCache,
+                   RoadGeometryCache::MwmKey const & mwmKey)
+  : m_loader(move(loader))
+  , m_featureIdToRoad(make_unique<FifoCache<uint32_t, RoadGeometryCache::RoadPtr>>(
         kRoadsCacheSize,
-        [this](uint32_t featureId, RoadGeometry & road) { m_loader->Load(featureId, road); }))
+        [this, &sharedCache, mwmKey](uint32_t featureId, RoadGeometryCache::RoadPtr & road) {
+          road = sharedCache.GetRoad(mwmKey, featureId, [this, featureId](RoadGeometry & loaded) {
+            m_loader->Load(featureId, loaded);
+          });
+        }))
 {
   CHECK(m_loader, ());
 }
@@ -173,7 +190,9 @@ RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
   ASSERT(m_featureIdToRoad, ());
   ASSERT(m_loader, ());
 
-  return m_featureIdToRoad->GetValue(featureId);
+  auto const & road = m_featureIdToRoad->GetValue(featureId);
+  ASSERT(road, ());
+  return *road;
 }
 
 // static
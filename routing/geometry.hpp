@@ -3,6 +3,7 @@
 #include "routing/city_roads.hpp"
 #include "routing/road_point.hpp"
 #include "routing/road_graph.hpp"
+#include "routing/road_geometry_cache.hpp"
 
 #include "routing_common/vehicle_model.hpp"
 
@@ -96,11 +97,15 @@ public:
 /// On the other hand methods GetRoad() and GetPoint() return geometry information by reference.
 /// The reference may be invalid after the next call of GetRoad() or GetPoint() because the cache
 /// item which is referred by returned reference may be evicted. It's done for performance reasons.
+/// \note If |sharedCache| is set roads are taken from it and loaded with |loader| only if they
+/// are not cached yet. So the roads are loaded once for all the routers of the process.
 class Geometry final
 {
 public:
   Geometry() = default;
   explicit Geometry(std::unique_ptr<GeometryLoader> loader);
+  Geometry(std::unique_ptr<GeometryLoader> loader, RoadGeometryCache & sharedCache,
+           RoadGeometryCache::MwmKey const & mwmKey);
 
   /// \note The reference returned by the method is valid until the next call of GetRoad()
   /// of GetPoint() methods.
@@ -115,6 +120,8 @@ public:
 
 private:
   std::unique_ptr<GeometryLoader> m_loader;
-  std::unique_ptr<FifoCache<uint32_t, RoadGeometry>> m_featureIdToRoad;
+  // Keeps the roads alive while they may be referred, even if they are evicted from the shared
+  // cache.
+  std::unique_ptr<FifoCache<uint32_t, RoadGeometryCache::RoadPtr>> m_featureIdToRoad;
 };
 }  // namespace routing
@@ -1,10 +1,12 @@
 #include "routing/index_graph.hpp"
 
+#include "routing/mapped_index_graph.hpp"
 #include "routing/restrictions_serialization.hpp"
 
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 #include "base/exception.hpp"
+#include "base/stl_helpers.hpp"
 
 #include <algorithm>
 #include <limits>
@@ -21,14 +23,22 @@ bool IsUTurn(Segment const & u, Segment const & v)
          u.IsForward() != v.IsForward();
 }
 
-bool IsRestricted(RestrictionVec const & restrictions, Segment const & u, Segment const & v,
-                  bool isOutgoing)
+uint64_t GetRestrictionKey(uint32_t featureIdFrom, uint32_t featureIdTo)
+{
+  return (static_cast<uint64_t>(featureIdFrom) << 32) | featureIdTo;
+}
+
+bool IsRestricted(vector<uint64_t> const & restrictions, vector<bool> const & restrictionFeatures,
+                  Segment const & u, Segment const & v, bool isOutgoing)
 {
   uint32_t const featureIdFrom = isOutgoing ? u.GetFeatureId() : v.GetFeatureId();
   uint32_t const featureIdTo = isOutgoing ? v.GetFeatureId() : u.GetFeatureId();
 
+  if (featureIdFrom >= restrictionFeatures.size() || !restrictionFeatures[featureIdFrom])
+    return false;
+
   if (!binary_search(restrictions.cbegin(), restrictions.cend(),
-                     Restriction(Restriction::Type::No, {featureIdFrom, featureIdTo})))
+                     GetRestrictionKey(featureIdFrom, featureIdTo)))
   {
     return false;
   }
@@ -93,14 +103,41 @@ void IndexGraph::Import(vector<Joint> const & joints)
   Build(checked_cast<uint32_t>(joints.size()));
 }
 
+void IndexGraph::Map(shared_ptr<MappedIndexGraph const> mappedGraph)
+{
+  CHECK(mappedGraph, ());
+  m_roadIndex.Map(mappedGraph->GetNumRoads(), mappedGraph->GetFeatureIds(),
+                  mappedGraph->GetRoadOffsets(), mappedGraph->GetRoadJointIds());
+  m_jointIndex.Map(mappedGraph->GetNumJoints(), mappedGraph->GetJointOffsets(),
+                   mappedGraph->GetJointPoints());
+  m_mappedGraph = move(mappedGraph);
+}
+
 void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
 {
   ASSERT(is_sorted(restrictions.cbegin(), restrictions.cend()), ());
-  m_restrictions = move(restrictions);
+
+  // Only No restrictions of two features are checked in GetNeighboringEdge().
+  m_restrictions.clear();
+  m_restrictionFeatures.clear();
+  for (auto const & restriction : restrictions)
+  {
+    if (restriction.m_type != Restriction::Type::No || restriction.m_featureIds.size() != 2)
+      continue;
+
+    uint32_t const featureIdFrom = restriction.m_featureIds[0];
+    m_restrictions.push_back(GetRestrictionKey(featureIdFrom, restriction.m_featureIds[1]));
+    if (featureIdFrom >= m_restrictionFeatures.size())
+      m_restrictionFeatures.resize(featureIdFrom + 1, false);
+    m_restrictionFeatures[featureIdFrom] = true;
+  }
+  base::SortUnique(m_restrictions);
 }
 
 void IndexGraph::SetRoadAccess(RoadAccess && roadAccess) { m_roadAccess = move(roadAccess); }
 
+void IndexGraph::SetLandmarks(Landmarks && landmarks) { m_landmarks = move(landmarks); }
+
 void IndexGraph::GetOutgoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges)
 {
   edges.clear();
@@ -161,7 +198,7 @@ void IndexGraph::GetNeighboringEdge(Segment const & from, Segment const & to, bo
     return;
   }
 
-  if (IsRestricted(m_restrictions, from, to, isOutgoing))
+  if (IsRestricted(m_restrictions, m_restrictionFeatures, from, to, isOutgoing))
     return;
 
   if (m_roadAccess.GetFeatureType(to.GetFeatureId()) == RoadAccess::Type::No)
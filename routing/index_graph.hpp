@@ -4,11 +4,13 @@
 #include "routing/geometry.hpp"
 #include "routing/joint.hpp"
 #include "routing/joint_index.hpp"
+#include "routing/landmarks.hpp"
 #include "routing/restrictions_serialization.hpp"
 #include "routing/road_access.hpp"
 #include "routing/road_index.hpp"
 #include "routing/road_point.hpp"
 #include "routing/segment.hpp"
+#include "routing/segment_vertex_store.hpp"
 
 #include "geometry/point2d.hpp"
 
@@ -20,6 +22,8 @@
 
 namespace routing
 {
+class MappedIndexGraph;
+
 class IndexGraph final
 {
 public:
@@ -27,6 +31,7 @@ public:
   using Vertex = Segment;
   using Edge = SegmentEdge;
   using Weight = RouteWeight;
+  using VertexStore = SegmentVertexStore;
 
   IndexGraph() = default;
   IndexGraph(shared_ptr<Geometry> geometry, shared_ptr<EdgeEstimator> estimator);
@@ -40,6 +45,8 @@ public:
   bool IsRoad(uint32_t featureId) const { return m_roadIndex.IsRoad(featureId); }
   RoadJointIds const & GetRoad(uint32_t featureId) const { return m_roadIndex.GetRoad(featureId); }
 
+  Landmarks const & GetLandmarks() const { return m_landmarks; }
+
   RoadAccess::Type GetAccessType(Segment const & segment) const
   {
     return m_roadAccess.GetFeatureType(segment.GetFeatureId());
@@ -51,9 +58,12 @@ public:
 
   void Build(uint32_t numJoints);
   void Import(vector<Joint> const & joints);
+  // Makes road and joint indices refer to |mappedGraph| instead of building them in memory.
+  void Map(shared_ptr<MappedIndexGraph const> mappedGraph);
 
   void SetRestrictions(RestrictionVec && restrictions);
   void SetRoadAccess(RoadAccess && roadAccess);
+  void SetLandmarks(Landmarks && landmarks);
 
   // Interface for AStarAlgorithm:
   void GetOutgoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges);
@@ -93,7 +103,13 @@ private:
   shared_ptr<EdgeEstimator> m_estimator;
   RoadIndex m_roadIndex;
   JointIndex m_jointIndex;
-  RestrictionVec m_restrictions;
+  // Keeps mapped memory |m_roadIndex| and |m_jointIndex| refer to. May be nullptr.
+  shared_ptr<MappedIndexGraph const> m_mappedGraph;
+  // Keys (from << 32 | to) of No restrictions, sorted. Bits of |m_restrictionFeatures| are set
+  // for the first features of restrictions, so most of edges are not looked up.
+  vector<uint64_t> m_restrictions;
+  vector<bool> m_restrictionFeatures;
   RoadAccess m_roadAccess;
+  Landmarks m_landmarks;
 };
 }  // namespace routing
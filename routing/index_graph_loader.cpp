@@ -2,14 +2,21 @@
 
 #include "routing/city_roads.hpp"
 #include "routing/index_graph_serialization.hpp"
+#include "routing/landmarks_serialization.hpp"
+#include "routing/mapped_index_graph.hpp"
 #include "routing/restriction_loader.hpp"
 #include "routing/road_access_serialization.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_exceptions.hpp"
 #include "routing/speed_camera_ser_des.hpp"
+#include "routing/speed_profiles.hpp"
 
 #include "indexer/data_source.hpp"
 
+#include "platform/file_prefetcher.hpp"
+#include "platform/platform.hpp"
+
 #include "coding/file_container.hpp"
 
 #include "base/assert.hpp"
@@ -24,6 +31,29 @@ namespace
 using namespace routing;
 using namespace std;
 
+shared_ptr<SpeedProfiles const> ReadSpeedProfilesFromMwm(MwmValue const & mwmValue)
+{
+  if (!mwmValue.m_cont.IsExist(SPEED_PROFILES_FILE_TAG))
+    return nullptr;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(SPEED_PROFILES_FILE_TAG);
+    vector<uint8_t> data(static_cast<size_t>(reader.Size()));
+    reader.Read(0 /* pos */, data.data(), data.size());
+
+    auto profiles = make_shared<SpeedProfiles>();
+    if (!profiles->Init(data))
+      return nullptr;
+    return profiles;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Error while reading", SPEED_PROFILES_FILE_TAG, "section.", e.Msg()));
+    return nullptr;
+  }
+}
+
 class IndexGraphLoaderImpl final : public IndexGraphLoader
 {
 public:
@@ -184,8 +214,11 @@ IndexGraphLoaderImpl::GraphAttrs & IndexGraphLoaderImpl::CreateGeometry(NumMwmId
       m_vehicleModelFactory->GetVehicleModelForCountry(file.GetName());
 
   auto & graph = m_graphs[numMwmId];
-  graph.m_geometry = make_shared<Geometry>(GeometryLoader::Create(
-      m_dataSource, handle, vehicleModel, LoadCityRoads(m_dataSource, handle), m_loadAltitudes));
+  graph.m_geometry = make_shared<Geometry>(
+      GeometryLoader::Create(m_dataSource, handle, vehicleModel,
+                             LoadCityRoads(m_dataSource, handle), m_loadAltitudes),
+      RoadGeometryCache::Instance(),
+      RoadGeometryCache::MwmKey(handle.GetId(), m_vehicleType, m_loadAltitudes));
   return graph;
 }
 
@@ -204,6 +237,10 @@ IndexGraphLoaderImpl::GraphAttrs & IndexGraphLoaderImpl::CreateIndexGraph(
   DeserializeIndexGraph(mwmValue, m_vehicleType, *graph.m_indexGraph);
   LOG(LINFO, (ROUTING_FILE_TAG, "section for", file.GetName(), "loaded in", timer.ElapsedSeconds(),
       "seconds"));
+
+  // Speed profiles are built from car tracks only.
+  if (m_vehicleType == VehicleType::Car)
+    m_estimator->SetSpeedProfiles(numMwmId, ReadSpeedProfilesFromMwm(mwmValue));
   return graph;
 }
 
@@ -229,6 +266,53 @@ bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, VehicleType vehicleType,
   }
   return true;
 }
+
+// \returns true if road and joint indices of |graph| refer to the mapped section of the mwm.
+// The section is mapped every time an index graph is loaded. Pages of the section are shared
+// by all the mappings of the process, so the section isn't copied for every routing request.
+bool MapIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
+{
+  if (!mwmValue.m_cont.IsExist(ROUTING_MAPPED_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const offsetAndSize = mwmValue.m_cont.GetAbsoluteOffsetAndSize(ROUTING_MAPPED_FILE_TAG);
+    shared_ptr<MappedIndexGraph const> mappedGraph =
+        MappedIndexGraph::Map(mwmValue.m_cont.GetFileName(), offsetAndSize.first,
+                              offsetAndSize.second, vehicleType);
+    if (!mappedGraph)
+      return false;
+
+    graph.Map(move(mappedGraph));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error while mapping", ROUTING_MAPPED_FILE_TAG, "section.", e.Msg()));
+    return false;
+  }
+  return true;
+}
+
+void ReadLandmarksFromMwm(MwmValue const & mwmValue, IndexGraph & graph)
+{
+  if (!mwmValue.m_cont.IsExist(LANDMARKS_FILE_TAG))
+    return;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(LANDMARKS_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+
+    Landmarks landmarks;
+    LandmarksSerializer::Deserialize(src, graph.GetNumJoints(), landmarks);
+    graph.SetLandmarks(move(landmarks));
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", LANDMARKS_FILE_TAG, "section.", e.Msg()));
+  }
+}
 }  // namespace
 
 namespace routing
@@ -243,11 +327,32 @@ unique_ptr<IndexGraphLoader> IndexGraphLoader::Create(
                                            estimator, dataSource);
 }
 
+// static
+void IndexGraphLoader::Prefetch(DataSource const & dataSource, platform::CountryFile const & file)
+{
+  auto * prefetcher = GetPlatform().GetFilePrefetcher();
+  if (prefetcher == nullptr)
+    return;
+
+  auto const info = dataSource.GetMwmIdByCountryFile(file).GetInfo();
+  if (!info)
+    return;
+
+  prefetcher->PrefetchSections(info->GetLocalFile().GetPath(MapOptions::Map),
+                               {ROUTING_FILE_TAG, ROUTING_MAPPED_FILE_TAG, RESTRICTIONS_FILE_TAG,
+                                ROAD_ACCESS_FILE_TAG, LANDMARKS_FILE_TAG, CROSS_MWM_FILE_TAG,
+                                ALTITUDES_FILE_TAG, CITY_ROADS_FILE_TAG, SPEED_PROFILES_FILE_TAG});
+}
+
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
 {
-  FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
-  ReaderSource<FilesContainerR::TReader> src(reader);
-  IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
+  if (!MapIndexGraph(mwmValue, vehicleType, graph))
+  {
+    FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
+    ReaderSource<FilesContainerR::TReader> src(reader);
+    IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
+  }
+
   RestrictionLoader restrictionLoader(mwmValue, graph);
   if (restrictionLoader.HasRestrictions())
     graph.SetRestrictions(restrictionLoader.StealRestrictions());
@@ -255,5 +360,9 @@ void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, I
   RoadAccess roadAccess;
   if (ReadRoadAccessFromMwm(mwmValue, vehicleType, roadAccess))
     graph.SetRoadAccess(move(roadAccess));
+
+  // Landmarks section is built for car routing only. See BuildLandmarksSection().
+  if (vehicleType == VehicleType::Car)
+    ReadLandmarksFromMwm(mwmValue, graph);
 }
 }  // namespace routing
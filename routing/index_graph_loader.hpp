@@ -14,6 +14,11 @@
 class MwmValue;
 class DataSource;
 
+namespace platform
+{
+class CountryFile;
+}  // namespace platform
+
 namespace routing
 {
 class IndexGraphLoader
@@ -32,6 +37,10 @@ public:
       VehicleType vehicleType, bool loadAltitudes, std::shared_ptr<NumMwmIds> numMwmIds,
       std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
       std::shared_ptr<EdgeEstimator> estimator, DataSource & dataSource);
+
+  // Starts reading sections which are needed to load the graph of |file| from disk in
+  // background, so the graph is loaded faster when it's needed.
+  static void Prefetch(DataSource const & dataSource, platform::CountryFile const & file);
 };
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph);
@@ -5,6 +5,8 @@
 #include "geometry/mercator.hpp"
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
 #include <map>
 
 namespace
@@ -23,6 +25,13 @@ void FillNumMwmIds(set<Segment> const & segments, set<NumMwmId> & mwms)
   for (auto const & s : segments)
     mwms.insert(s.GetMwmId());
 }
+
+// Returns the upper bound of the number of fake segments which are added for |ending|:
+// a pure fake segment, and a projection segment and two parts of real per projection.
+size_t GetMaxFakeSegmentsCount(FakeEnding const & ending)
+{
+  return 1 + 3 * ending.m_projections.size();
+}
 }  // namespace
 
 namespace routing
@@ -57,25 +66,23 @@ IndexGraphStarter::IndexGraphStarter(FakeEnding const & startEnding,
                                      bool strictForward, WorldGraph & graph)
   : m_graph(graph)
 {
+  m_fake.Reserve(GetMaxFakeSegmentsCount(startEnding) + GetMaxFakeSegmentsCount(finishEnding));
   m_start.m_id = fakeNumerationStart;
   AddStart(startEnding, finishEnding, strictForward, fakeNumerationStart);
   m_finish.m_id = fakeNumerationStart;
   AddFinish(finishEnding, startEnding, fakeNumerationStart);
-  auto const startPoint = GetPoint(GetStartSegment(), false /* front */);
-  auto const finishPoint = GetPoint(GetFinishSegment(), true /* front */);
-  m_startToFinishDistanceM = MercatorBounds::DistanceOnEarth(startPoint, finishPoint);
+  UpdateStartToFinishDistance();
 }
 
 void IndexGraphStarter::Append(FakeEdgesContainer const & container)
 {
   m_finish = container.m_finish;
   m_fake.Append(container.m_fake);
+  m_finishLandmarks = EndingLandmarks();
 
   // It's important to calculate distance after m_fake.Append() because
   // we don't have finish segment in fake graph before m_fake.Append().
-  auto const startPoint = GetPoint(GetStartSegment(), false /* front */);
-  auto const finishPoint = GetPoint(GetFinishSegment(), true /* front */);
-  m_startToFinishDistanceM = MercatorBounds::DistanceOnEarth(startPoint, finishPoint);
+  UpdateStartToFinishDistance();
 }
 
 Junction const & IndexGraphStarter::GetStartJunction() const
@@ -219,6 +226,43 @@ void IndexGraphStarter::GetEdgesList(Segment const & segment, bool isOutgoing,
   AddFakeEdges(segment, isOutgoing, edges);
 }
 
+RouteWeight IndexGraphStarter::HeuristicCostEstimate(Vertex const & from, Vertex const & to) const
+{
+  RouteWeight const heuristic = m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */),
+                                                              GetPoint(to, true /* front */));
+  // The landmark bound from a fake segment is estimated with its points of the road graph.
+  // An ending itself is estimated with the nearest of its projections, so the bound stays
+  // consistent near the endings. It's consistent for the searches to the start or to the finish
+  // only, that's why it isn't applied to other targets, real segments included.
+  if (to != GetStartSegment() && to != GetFinishSegment())
+    return heuristic;
+
+  PointsLandmarks const & toPoints = GetEndingLandmarks(to == GetStartSegment());
+  if (toPoints.empty())
+    return heuristic;
+
+  PointsLandmarks fromPoints;
+  GetLandmarkPoints(from, fromPoints);
+  if (fromPoints.empty())
+    return heuristic;
+
+  double landmarkHeuristic = numeric_limits<double>::max();
+  for (auto const & fromPoint : fromPoints)
+  {
+    for (auto const & toPoint : toPoints)
+    {
+      // Landmarks of different mwms are not comparable.
+      if (fromPoint.m_mwmId != toPoint.m_mwmId)
+        return heuristic;
+
+      landmarkHeuristic = min(landmarkHeuristic,
+                              CalcLandmarkHeuristic(fromPoint.m_distances, toPoint.m_distances));
+    }
+  }
+
+  return max(heuristic, RouteWeight(landmarkHeuristic));
+}
+
 RouteWeight IndexGraphStarter::CalcSegmentWeight(Segment const & segment) const
 {
   if (!IsFakeSegment(segment))
@@ -353,6 +397,107 @@ void IndexGraphStarter::AddFinish(FakeEnding const & finishEnding, FakeEnding co
             fakeNumerationStart);
 }
 
+void IndexGraphStarter::UpdateStartToFinishDistance()
+{
+  auto const startPoint = GetPoint(GetStartSegment(), false /* front */);
+  auto const finishPoint = GetPoint(GetFinishSegment(), true /* front */);
+  m_startToFinishDistanceM = MercatorBounds::DistanceOnEarth(startPoint, finishPoint);
+}
+
+void IndexGraphStarter::GetLandmarkPoints(Segment const & segment, PointsLandmarks & points) const
+{
+  points.clear();
+  if (segment == GetStartSegment() || segment == GetFinishSegment())
+  {
+    points = GetEndingLandmarks(segment == GetStartSegment());
+    return;
+  }
+
+  PointLandmarks pointLandmarks;
+  if (!IsFakeSegment(segment))
+  {
+    pointLandmarks.m_mwmId = segment.GetMwmId();
+    if (m_graph.GetLandmarkDistances(segment, true /* front */, pointLandmarks.m_distances))
+      points.push_back(move(pointLandmarks));
+    return;
+  }
+
+  Segment real;
+  if (m_fake.FindReal(segment, real))
+  {
+    if (CalcPointLandmarks(real, GetPoint(segment, true /* front */), pointLandmarks))
+      points.push_back(move(pointLandmarks));
+    return;
+  }
+
+  // Segment between an ending and its projection. The landmark bound is estimated with
+  // the projection which is an end of the fake parts of real the segment is connected to.
+  for (bool const isOutgoing : {true, false})
+  {
+    for (auto const & s : m_fake.GetEdges(segment, isOutgoing))
+    {
+      if (!m_fake.FindReal(s, real))
+        continue;
+
+      if (CalcPointLandmarks(real, GetPoint(segment, isOutgoing /* front */), pointLandmarks))
+        points.push_back(move(pointLandmarks));
+      return;
+    }
+  }
+}
+
+bool IndexGraphStarter::CalcPointLandmarks(Segment const & real, m2::PointD const & point,
+                                           PointLandmarks & pointLandmarks) const
+{
+  // Points are interpolated along the forward segment, so the distances of a point don't depend
+  // on the direction of the segment.
+  Segment const forward(real.GetMwmId(), real.GetFeatureId(), real.GetSegmentIdx(),
+                        true /* forward */);
+  LandmarkDistances back;
+  LandmarkDistances front;
+  if (!m_graph.GetLandmarkDistances(forward, false /* front */, back) ||
+      !m_graph.GetLandmarkDistances(forward, true /* front */, front))
+  {
+    return false;
+  }
+
+  auto const & backPoint = GetPoint(forward, false /* front */);
+  auto const fullLen = MercatorBounds::DistanceOnEarth(backPoint, GetPoint(forward, true /* front */));
+  double const ratio =
+      fullLen == 0.0 ? 0.0 : min(1.0, MercatorBounds::DistanceOnEarth(backPoint, point) / fullLen);
+
+  pointLandmarks.m_mwmId = real.GetMwmId();
+  InterpolateLandmarkDistances(back, front, ratio, pointLandmarks.m_distances);
+  return true;
+}
+
+IndexGraphStarter::PointsLandmarks const & IndexGraphStarter::GetEndingLandmarks(
+    bool isStart) const
+{
+  auto & ending = isStart ? m_startLandmarks : m_finishLandmarks;
+  if (ending.m_isCalculated && ending.m_mode == m_graph.GetMode())
+    return ending.m_points;
+
+  ending.m_isCalculated = true;
+  ending.m_mode = m_graph.GetMode();
+  ending.m_points.clear();
+
+  Segment const segment = isStart ? GetStartSegment() : GetFinishSegment();
+  PointsLandmarks points;
+  for (auto const & projection : m_fake.GetEdges(segment, isStart /* isOutgoing */))
+  {
+    GetLandmarkPoints(projection, points);
+    // The bound is not applicable if landmarks of a projection are unknown.
+    if (points.empty())
+    {
+      ending.m_points.clear();
+      break;
+    }
+    move(points.begin(), points.end(), back_inserter(ending.m_points));
+  }
+  return ending.m_points;
+}
+
 void IndexGraphStarter::AddFakeEdges(Segment const & segment, bool isOutgoing, vector<SegmentEdge> & edges) const
 {
   vector<SegmentEdge> fakeEdges;
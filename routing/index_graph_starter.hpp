@@ -33,6 +33,7 @@ public:
   using Vertex = IndexGraph::Vertex;
   using Edge = IndexGraph::Edge;
   using Weight = IndexGraph::Weight;
+  using VertexStore = IndexGraph::VertexStore;
 
   friend class FakeEdgesContainer;
 
@@ -94,11 +95,7 @@ public:
     GetEdgesList(segment, false /* isOutgoing */, edges);
   }
 
-  RouteWeight HeuristicCostEstimate(Vertex const & from, Vertex const & to) const
-  {
-    return m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */),
-                                         GetPoint(to, true /* front */));
-  }
+  RouteWeight HeuristicCostEstimate(Vertex const & from, Vertex const & to) const;
 
   RouteWeight CalcSegmentWeight(Segment const & segment) const;
   RouteWeight CalcRouteSegmentWeight(std::vector<Segment> const & route, size_t segmentIndex) const;
@@ -116,6 +113,24 @@ private:
     std::set<Segment> m_real;
   };
 
+  // Distances from the landmarks of an mwm to a point of its road graph.
+  struct PointLandmarks
+  {
+    NumMwmId m_mwmId = kFakeNumMwmId;
+    LandmarkDistances m_distances;
+  };
+
+  using PointsLandmarks = std::vector<PointLandmarks>;
+
+  // Landmark distances of the projections of an ending. They are calculated on demand
+  // for the mode of the graph.
+  struct EndingLandmarks
+  {
+    bool m_isCalculated = false;
+    WorldGraph::Mode m_mode = WorldGraph::Mode::NoLeaps;
+    PointsLandmarks m_points;
+  };
+
   static Segment GetFakeSegment(uint32_t segmentIdx)
   {
     // We currently ignore |isForward| and use FakeGraph to get ingoing/outgoing.
@@ -138,6 +153,16 @@ private:
                 uint32_t & fakeNumerationStart);
   void AddFinish(FakeEnding const & finishEnding, FakeEnding const & startEnding,
                  uint32_t & fakeNumerationStart);
+  void UpdateStartToFinishDistance();
+
+  // Fills |points| with the points of the road graph which are used to estimate the landmark
+  // bound from |segment|, see HeuristicCostEstimate(). |points| is empty if the landmarks
+  // are not applicable.
+  void GetLandmarkPoints(Segment const & segment, PointsLandmarks & points) const;
+  // Calculates landmark distances of |point| which lies on |real| segment.
+  bool CalcPointLandmarks(Segment const & real, m2::PointD const & point,
+                          PointLandmarks & pointLandmarks) const;
+  PointsLandmarks const & GetEndingLandmarks(bool isStart) const;
 
   // Adds fake edges of type PartOfReal which correspond real edges from |edges| and are connected
   // to |segment|
@@ -158,5 +183,8 @@ private:
   Ending m_finish;
   double m_startToFinishDistanceM;
   FakeGraph<Segment, FakeVertex> m_fake;
+
+  mutable EndingLandmarks m_startLandmarks;
+  mutable EndingLandmarks m_finishLandmarks;
 };
 }  // namespace routing
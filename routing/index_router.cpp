@@ -3,6 +3,7 @@
 #include "routing/base/astar_progress.hpp"
 
 #include "routing/bicycle_directions.hpp"
+#include "routing/fake_edges_container.hpp"
 #include "routing/routing_exceptions.hpp"
 #include "routing/fake_ending.hpp"
 #include "routing/index_graph.hpp"
@@ -12,6 +13,7 @@
 #include "routing/index_road_graph.hpp"
 #include "routing/pedestrian_directions.hpp"
 #include "routing/restriction_loader.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_helpers.hpp"
 #include "routing/single_vehicle_world_graph.hpp"
@@ -37,10 +39,16 @@
 #include "platform/mwm_traits.hpp"
 
 #include "base/exception.hpp"
+#include "base/math.hpp"
+#include "base/profiler.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
+#include "base/timer.hpp"
 
 #include <algorithm>
+#include <ctime>
 #include <map>
+#include <thread>
 #include <utility>
 
 #include "defines.hpp"
@@ -84,6 +92,37 @@ double CalcOffroadSpeed(VehicleModelFactoryInterface const & vehicleModelFactory
   return vehicleModelFactory.GetVehicleModel()->GetOffroadSpeed();
 }
 
+IRoadGraph::Mode GetRoadGraphMode(VehicleType vehicleType)
+{
+  return vehicleType == VehicleType::Pedestrian || vehicleType == VehicleType::Transit
+             ? IRoadGraph::Mode::IgnoreOnewayTag
+             : IRoadGraph::Mode::ObeyOnewayTag;
+}
+
+// Transit routing snaps to pedestrian roads.
+VehicleMask GetRoadGraphSnappingMask(VehicleType vehicleType)
+{
+  return vehicleType == VehicleType::Transit ? kPedestrianMask : GetVehicleMask(vehicleType);
+}
+
+// \returns true if |lhs| and |rhs| have projections to the same segment in any direction.
+bool HaveCommonSegment(FakeEnding const & lhs, FakeEnding const & rhs)
+{
+  for (auto const & l : lhs.m_projections)
+  {
+    for (auto const & r : rhs.m_projections)
+    {
+      if (l.m_segment.GetMwmId() == r.m_segment.GetMwmId() &&
+          l.m_segment.GetFeatureId() == r.m_segment.GetFeatureId() &&
+          l.m_segment.GetSegmentIdx() == r.m_segment.GetSegmentIdx())
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 shared_ptr<VehicleModelFactoryInterface> CreateVehicleModelFactory(
     VehicleType vehicleType, CountryParentNameGetterFn const & countryParentNameGetterFn)
 {
@@ -213,6 +252,20 @@ void PushPassedSubroutes(Checkpoints const & checkpoints, vector<Route::Subroute
   }
 }
 
+// A subroute of a route with intermediate points.
+struct SubrouteLeg
+{
+  // Start segment the leg is calculated from and the projection of its finish.
+  Segment m_start;
+  Segment m_finish;
+  uint32_t m_fakeNumerationStart = 0;
+  unique_ptr<IndexGraphStarter> m_starter;
+  RouterResultCode m_result = RouterResultCode::NoError;
+  IndexRouter::Statistics m_statistics;
+  vector<Segment> m_subroute;
+  vector<vector<Segment>> m_alternatives;
+};
+
 bool GetLastRealOrPart(IndexGraphStarter const & starter, vector<Segment> const & route,
                        Segment & real)
 {
@@ -288,14 +341,14 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
   , m_numMwmIds(move(numMwmIds))
   , m_numMwmTree(move(numMwmTree))
   , m_trafficStash(CreateTrafficStash(m_vehicleType, m_numMwmIds, trafficCache))
-  , m_roadGraph(m_dataSource,
-                vehicleType == VehicleType::Pedestrian || vehicleType == VehicleType::Transit
-                    ? IRoadGraph::Mode::IgnoreOnewayTag
-                    : IRoadGraph::Mode::ObeyOnewayTag,
-                m_vehicleModelFactory)
-  , m_estimator(EdgeEstimator::Create(
-        m_vehicleType, CalcMaxSpeed(*m_numMwmIds, *m_vehicleModelFactory, m_vehicleType),
-        CalcOffroadSpeed(*m_vehicleModelFactory), m_trafficStash))
+  , m_crossMwmTrafficWeights(m_trafficStash ? make_shared<CrossMwmTrafficWeights>(m_trafficStash)
+                                            : nullptr)
+  , m_roadGraph(m_dataSource, GetRoadGraphMode(vehicleType), m_vehicleModelFactory,
+                GetRoadGraphSnappingMask(vehicleType))
+  , m_maxWeightSpeedKMpH(CalcMaxSpeed(*m_numMwmIds, *m_vehicleModelFactory, m_vehicleType))
+  , m_offroadSpeedKMpH(CalcOffroadSpeed(*m_vehicleModelFactory))
+  , m_estimator(EdgeEstimator::Create(m_vehicleType, m_maxWeightSpeedKMpH, m_offroadSpeedKMpH,
+                                      m_trafficStash))
   , m_directionsEngine(CreateDirectionsEngine(m_vehicleType, m_numMwmIds, m_dataSource))
 {
   CHECK(!m_name.empty(), ());
@@ -322,11 +375,49 @@ bool IndexRouter::FindBestSegment(m2::PointD const & point, m2::PointD const & d
                          dummy /* best segment is almost codirectional */);
 }
 
+RouterResultCode IndexRouter::CalculateRouteWithAlternatives(Checkpoints const & checkpoints,
+                                                             m2::PointD const & startDirection,
+                                                             size_t maxAlternatives,
+                                                             RouterDelegate const & delegate,
+                                                             Route & route,
+                                                             vector<Route> & alternatives)
+{
+  base::ProfilerZone zone("CalculateRouteWithAlternatives", "routing");
+  alternatives.clear();
+
+  vector<string> outdatedMwms;
+  GetOutdatedMwms(m_dataSource, outdatedMwms);
+
+  if (!outdatedMwms.empty())
+  {
+    for (string const & mwm : outdatedMwms)
+      route.AddAbsentCountry(mwm);
+
+    return RouterResultCode::FileTooOld;
+  }
+
+  m_lastStatistics = Statistics();
+  try
+  {
+    return DoCalculateRoute(checkpoints, startDirection, maxAlternatives, delegate, route,
+                            alternatives);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't find path from", MercatorBounds::ToLatLon(checkpoints.GetStart()), "to",
+      MercatorBounds::ToLatLon(checkpoints.GetFinish()), ":\n ", e.what()));
+    alternatives.clear();
+    return RouterResultCode::InternalError;
+  }
+}
+
 RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
                                              m2::PointD const & startDirection,
                                              bool adjustToPrevRoute,
                                              RouterDelegate const & delegate, Route & route)
 {
+  base::ProfilerZone zone("CalculateRoute", "routing");
+
   vector<string> outdatedMwms;
   GetOutdatedMwms(m_dataSource, outdatedMwms);
 
@@ -341,6 +432,7 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
   auto const & startPoint = checkpoints.GetStart();
   auto const & finalPoint = checkpoints.GetFinish();
 
+  m_lastStatistics = Statistics();
   try
   {
     if (adjustToPrevRoute && m_lastRoute && m_lastFakeEdges &&
@@ -360,7 +452,9 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
           MercatorBounds::ToLatLon(finalPoint)));
       }
     }
-    return DoCalculateRoute(checkpoints, startDirection, delegate, route);
+    vector<Route> alternatives;
+    return DoCalculateRoute(checkpoints, startDirection, 0 /* maxAlternatives */, delegate, route,
+                            alternatives);
   }
   catch (RootException const & e)
   {
@@ -370,9 +464,253 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
   }
 }
 
+RouterResultCode IndexRouter::CalculateRoutesMatrix(vector<m2::PointD> const & origins,
+                                                    vector<m2::PointD> const & destinations,
+                                                    double maxWeightSec,
+                                                    RouterDelegate const & delegate,
+                                                    RoutesMatrix & matrix)
+{
+  matrix.assign(origins.size(), vector<RoutesMatrixItem>(destinations.size()));
+
+  vector<string> outdatedMwms;
+  GetOutdatedMwms(m_dataSource, outdatedMwms);
+  if (!outdatedMwms.empty())
+    return RouterResultCode::FileTooOld;
+
+  try
+  {
+    return DoCalculateRoutesMatrix(origins, destinations, maxWeightSec, delegate, matrix);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate routes matrix for", origins.size(), "origins and",
+                 destinations.size(), "destinations:\n ", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
+RouterResultCode IndexRouter::DoCalculateRoutesMatrix(vector<m2::PointD> const & origins,
+                                                      vector<m2::PointD> const & destinations,
+                                                      double maxWeightSec,
+                                                      RouterDelegate const & delegate,
+                                                      RoutesMatrix & matrix)
+{
+  vector<m2::PointD> points(origins);
+  points.insert(points.end(), destinations.cbegin(), destinations.cend());
+
+  for (auto const & point : points)
+  {
+    string const countryName = m_countryFileFn(point);
+    if (countryName.empty())
+    {
+      LOG(LWARNING, ("For point", MercatorBounds::ToLatLon(point),
+                     "CountryInfoGetter returns an empty CountryFile()."));
+      return RouterResultCode::InternalError;
+    }
+
+    platform::CountryFile const country(countryName);
+    if (!m_dataSource.IsLoaded(country))
+      return RouterResultCode::NeedMoreMaps;
+    IndexGraphLoader::Prefetch(m_dataSource, country);
+  }
+
+  TrafficStash::Guard guard(m_trafficStash);
+  auto graph = MakeWorldGraph();
+  graph->SetMode(WorldGraph::Mode::NoLeaps);
+
+  vector<vector<pair<Edge, Junction>>> candidates;
+  FindClosestEdges(points, candidates);
+
+  // Endings are made once for every point and are shared by all the waves.
+  vector<FakeEnding> endings(points.size());
+  vector<bool> hasEnding(points.size(), false);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    bool const isOrigin = i < origins.size();
+    Segment segment;
+    bool dummy = false;
+    if (!SelectBestSegment(points[i], m2::PointD::Zero() /* direction */, isOrigin /* isOutgoing */,
+                           *graph, move(candidates[i]), segment,
+                           dummy /* bestSegmentIsAlmostCodirectional */))
+    {
+      continue;
+    }
+
+    endings[i] = MakeFakeEnding(segment, points[i], *graph);
+    hasEnding[i] = true;
+  }
+
+  for (size_t i = 0; i < origins.size(); ++i)
+  {
+    auto & row = matrix[i];
+    if (!hasEnding[i])
+    {
+      for (auto & item : row)
+        item.m_code = RouterResultCode::StartPointNotFound;
+      continue;
+    }
+
+    // IndexGraphStarter connects start and finish endings which have projections to the same
+    // segment with special fake edges. So routes to such destinations are calculated with
+    // separate waves.
+    vector<size_t> sharedWaveDestinations;
+    vector<size_t> separateWaveDestinations;
+    for (size_t j = 0; j < destinations.size(); ++j)
+    {
+      size_t const pointIdx = origins.size() + j;
+      if (!hasEnding[pointIdx])
+        row[j].m_code = RouterResultCode::EndPointNotFound;
+      else if (HaveCommonSegment(endings[i], endings[pointIdx]))
+        separateWaveDestinations.push_back(j);
+      else
+        sharedWaveDestinations.push_back(j);
+    }
+
+    vector<FakeEnding const *> destinationEndings;
+    vector<RoutesMatrixItem> items;
+    for (auto const j : sharedWaveDestinations)
+      destinationEndings.push_back(&endings[origins.size() + j]);
+
+    auto code = CalculateRoutesMatrixRow(endings[i], destinationEndings, maxWeightSec, delegate,
+                                         *graph, items);
+    if (code != RouterResultCode::NoError)
+      return code;
+
+    for (size_t k = 0; k < sharedWaveDestinations.size(); ++k)
+      row[sharedWaveDestinations[k]] = items[k];
+
+    for (auto const j : separateWaveDestinations)
+    {
+      code = CalculateRoutesMatrixRow(endings[i], {&endings[origins.size() + j]}, maxWeightSec,
+                                      delegate, *graph, items);
+      if (code != RouterResultCode::NoError)
+        return code;
+
+      row[j] = items.front();
+    }
+  }
+
+  return RouterResultCode::NoError;
+}
+
+RouterResultCode IndexRouter::CalculateRoutesMatrixRow(
+    FakeEnding const & originEnding, vector<FakeEnding const *> const & destinationEndings,
+    double maxWeightSec, RouterDelegate const & delegate, WorldGraph & graph,
+    vector<RoutesMatrixItem> & items) const
+{
+  items.assign(destinationEndings.size(), {});
+  if (destinationEndings.empty())
+    return RouterResultCode::NoError;
+
+  // All the destinations are added to one starter as finishes of consecutive subroutes.
+  IndexGraphStarter starter(originEnding, *destinationEndings.front(),
+                            0 /* fakeNumerationStart */, false /* strictForward */, graph);
+  map<Segment, size_t> finishToDestination;
+  finishToDestination.emplace(starter.GetFinishSegment(), 0);
+  for (size_t i = 1; i < destinationEndings.size(); ++i)
+  {
+    IndexGraphStarter destinationStarter(originEnding, *destinationEndings[i],
+                                         starter.GetNumFakeSegments(), false /* strictForward */,
+                                         graph);
+    finishToDestination.emplace(destinationStarter.GetFinishSegment(), i);
+    starter.Append(FakeEdgesContainer(move(destinationStarter)));
+  }
+
+  using Algorithm = AStarAlgorithm<IndexGraphStarter>;
+  Algorithm algorithm;
+  Algorithm::Context context;
+  size_t reachedNumber = 0;
+  bool cancelled = false;
+  auto const visitVertex = [&](Segment const & vertex) {
+    if (delegate.IsCancelled())
+    {
+      cancelled = true;
+      return false;
+    }
+
+    if (context.GetDistance(vertex).GetWeight() > maxWeightSec)
+      return false;
+
+    return finishToDestination.count(vertex) == 0 ||
+           ++reachedNumber != finishToDestination.size();
+  };
+
+  algorithm.PropagateWave(starter, starter.GetStartSegment(), visitVertex, context);
+  if (cancelled)
+    return RouterResultCode::Cancelled;
+
+  vector<Segment> path;
+  for (auto const & finishAndDestination : finishToDestination)
+  {
+    auto const & finish = finishAndDestination.first;
+    auto const weight = context.GetDistance(finish).GetWeight();
+    // Distances of the vertices which are not visited by the wave are not final. But if such
+    // a vertex is a finish its distance is greater than |maxWeightSec|.
+    if (!context.HasDistance(finish) || weight > maxWeightSec)
+      continue;
+
+    auto & item = items[finishAndDestination.second];
+    item.m_code = RouterResultCode::NoError;
+    item.m_weight = weight;
+
+    context.ReconstructPath(finish, path);
+    for (auto const & segment : path)
+    {
+      item.m_etaSec += starter.CalcSegmentETA(segment);
+      item.m_distanceM += MercatorBounds::DistanceOnEarth(
+          starter.GetPoint(segment, false /* front */), starter.GetPoint(segment, true /* front */));
+    }
+  }
+
+  return RouterResultCode::NoError;
+}
+
+void IndexRouter::PrefetchRouteCorridor(Checkpoints const & checkpoints) const
+{
+  // Half-width of the corridor is a part of the distance between checkpoints, in mercator.
+  double constexpr kCorridorWidthFactor = 0.1;
+  double constexpr kMinCorridorWidth = 0.05;
+  double constexpr kMaxCorridorWidth = 0.5;
+  size_t constexpr kMaxSamplesCount = 64;
+  // Mwms which are far along the corridor are reached last, if at all, and the graph of the
+  // nearest ones is prefetched by CrossMwmGraph during the search anyway.
+  size_t constexpr kMaxMwmsCount = 32;
+
+  vector<NumMwmId> mwmIds;
+  auto const & points = checkpoints.GetPoints();
+  for (size_t i = 0; i + 1 < points.size() && mwmIds.size() < kMaxMwmsCount; ++i)
+  {
+    m2::PointD const & from = points[i];
+    m2::PointD const & to = points[i + 1];
+    double const length = from.Length(to);
+    double const width =
+        base::clamp(length * kCorridorWidthFactor, kMinCorridorWidth, kMaxCorridorWidth);
+    size_t const samplesCount =
+        base::clamp(static_cast<size_t>(length / width), size_t(1), kMaxSamplesCount);
+
+    for (size_t j = 0; j <= samplesCount && mwmIds.size() < kMaxMwmsCount; ++j)
+    {
+      m2::PointD const p = from + (to - from) * (static_cast<double>(j) / samplesCount);
+      m2::RectD const rect(p.x - width, p.y - width, p.x + width, p.y + width);
+      m_numMwmTree->ForEachInRect(rect, [&](NumMwmId id) {
+        if (find(mwmIds.cbegin(), mwmIds.cend(), id) == mwmIds.cend())
+          mwmIds.push_back(id);
+      });
+    }
+  }
+
+  if (mwmIds.size() > kMaxMwmsCount)
+    mwmIds.resize(kMaxMwmsCount);
+
+  for (auto const id : mwmIds)
+    IndexGraphLoader::Prefetch(m_dataSource, m_numMwmIds->GetFile(id));
+}
+
 RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
                                                m2::PointD const & startDirection,
-                                               RouterDelegate const & delegate, Route & route)
+                                               size_t maxAlternatives,
+                                               RouterDelegate const & delegate, Route & route,
+                                               vector<Route> & alternatives)
 {
   m_lastRoute.reset();
 
@@ -390,61 +728,171 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
     auto const country = platform::CountryFile(countryName);
     if (!m_dataSource.IsLoaded(country))
       route.AddAbsentCountry(country.GetName());
+    else
+      IndexGraphLoader::Prefetch(m_dataSource, country);
   }
 
   if (!route.GetAbsentCountries().empty())
     return RouterResultCode::NeedMoreMaps;
 
+  PrefetchRouteCorridor(checkpoints);
+
   TrafficStash::Guard guard(m_trafficStash);
+  time_t const departureTime = time(nullptr);
+  double const departureLon = MercatorBounds::XToLon(checkpoints.GetPointFrom().x);
+  m_estimator->SetDepartureTime(departureTime, departureLon);
   auto graph = MakeWorldGraph();
 
   vector<Segment> segments;
 
   Segment startSegment;
   bool startSegmentIsAlmostCodirectionalDirection = false;
+  base::Timer timer;
   if (!FindBestSegment(checkpoints.GetPointFrom(), startDirection, true /* isOutgoing */, *graph,
                        startSegment, startSegmentIsAlmostCodirectionalDirection))
   {
     return RouterResultCode::StartPointNotFound;
   }
+  m_lastStatistics.m_nearestEdgesSec += timer.ElapsedSeconds();
+
+  size_t const passedIdx = checkpoints.GetPassedIdx();
+  vector<SubrouteLeg> legs(checkpoints.GetNumSubroutes() - passedIdx);
+
+  // Finishes are projected one after another on the same graph. Legs after the first finish
+  // which isn't found are not calculated.
+  size_t projectedNumber = 0;
+  for (; projectedNumber < legs.size(); ++projectedNumber)
+  {
+    bool dummy = false;
+    timer.Reset();
+    if (!FindBestSegment(checkpoints.GetPoint(passedIdx + projectedNumber + 1),
+                         m2::PointD::Zero() /* direction */, false /* isOutgoing */, *graph,
+                         legs[projectedNumber].m_finish,
+                         dummy /* bestSegmentIsAlmostCodirectional */))
+    {
+      break;
+    }
+    m_lastStatistics.m_nearestEdgesSec += timer.ElapsedSeconds();
+  }
+
+  // World graphs and edge estimators are not thread-safe, so legs are calculated by several
+  // threads with their own graphs. The first thread uses |graph|.
+  size_t const threadsNumber =
+      max(min({projectedNumber, m_maxSubroutesThreadsNumber,
+               static_cast<size_t>(thread::hardware_concurrency())}),
+          size_t(1));
+  vector<unique_ptr<WorldGraph>> graphs;
+  graphs.push_back(move(graph));
+  for (size_t i = 1; i < threadsNumber; ++i)
+  {
+    auto estimator = EdgeEstimator::Create(m_vehicleType, m_maxWeightSpeedKMpH,
+                                           m_offroadSpeedKMpH, m_trafficStash);
+    estimator->SetDepartureTime(departureTime, departureLon);
+    graphs.push_back(MakeWorldGraph(move(estimator)));
+  }
+
+  auto const makeStarter = [&](size_t legIdx, Segment const & start,
+                               uint32_t fakeNumerationStart) {
+    size_t const subrouteIdx = passedIdx + legIdx;
+    bool isStartSegmentStrictForward = (m_vehicleType == VehicleType::Car);
+    if (legIdx == 0)
+      isStartSegmentStrictForward = startSegmentIsAlmostCodirectionalDirection;
+
+    auto & legGraph = *graphs[legIdx % threadsNumber];
+    auto & leg = legs[legIdx];
+    leg.m_start = start;
+    leg.m_fakeNumerationStart = fakeNumerationStart;
+    leg.m_starter = make_unique<IndexGraphStarter>(
+        MakeFakeEnding(start, checkpoints.GetPoint(subrouteIdx), legGraph),
+        MakeFakeEnding(leg.m_finish, checkpoints.GetPoint(subrouteIdx + 1), legGraph),
+        fakeNumerationStart, isStartSegmentStrictForward, legGraph);
+  };
+
+  // Alternatives of routes through intermediate points are not calculated.
+  size_t const legMaxAlternatives = legs.size() == 1 ? maxAlternatives : 0;
+  auto const calcLeg = [&](size_t legIdx) {
+    auto & leg = legs[legIdx];
+    leg.m_statistics = Statistics();
+    try
+    {
+      leg.m_result =
+          CalculateSubroute(checkpoints, passedIdx + legIdx, delegate, *leg.m_starter,
+                            legMaxAlternatives, leg.m_statistics, leg.m_subroute,
+                            leg.m_alternatives);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LERROR, ("Can't calculate subroute", passedIdx + legIdx, ":\n ", e.what()));
+      leg.m_result = RouterResultCode::InternalError;
+    }
+  };
+
+  // A leg starts where the previous one ends, which is known only when the previous leg is
+  // calculated. The legs are calculated in parallel supposing that every leg ends on the
+  // projection of its finish. When it's wrong, e.g. a route comes to an intermediate point on
+  // a two-way road from the opposite direction, the next leg is recalculated below.
+  // With one thread the legs are calculated below one by one.
+  if (threadsNumber > 1)
+  {
+    uint32_t fakeNumerationStart = 0;
+    for (size_t i = 0; i < projectedNumber; ++i)
+    {
+      makeStarter(i, i == 0 ? startSegment : legs[i - 1].m_finish, fakeNumerationStart);
+      fakeNumerationStart += legs[i].m_starter->GetNumFakeSegments();
+    }
+
+    auto const calcLegs = [&](size_t threadIdx) {
+      for (size_t i = threadIdx; i < projectedNumber; i += threadsNumber)
+        calcLeg(i);
+    };
+
+    vector<threads::SimpleThread> threads;
+    for (size_t i = 1; i < threadsNumber; ++i)
+      threads.emplace_back(calcLegs, i);
+
+    calcLegs(0);
+
+    for (auto & thread : threads)
+      thread.join();
+  }
 
   size_t subrouteSegmentsBegin = 0;
   vector<Route::SubrouteAttrs> subroutes;
   PushPassedSubroutes(checkpoints, subroutes);
+  vector<Route::SubrouteAttrs> const passedSubroutes = subroutes;
   unique_ptr<IndexGraphStarter> starter;
+  size_t recalculatedNumber = 0;
 
   for (size_t i = checkpoints.GetPassedIdx(); i < checkpoints.GetNumSubroutes(); ++i)
   {
-    bool const isFirstSubroute = i == checkpoints.GetPassedIdx();
     bool const isLastSubroute = i == checkpoints.GetNumSubroutes() - 1;
-    auto const & startCheckpoint = checkpoints.GetPoint(i);
-    auto const & finishCheckpoint = checkpoints.GetPoint(i + 1);
-
-    Segment finishSegment;
-    bool dummy = false;
-    if (!FindBestSegment(finishCheckpoint, m2::PointD::Zero() /* direction */,
-                         false /* isOutgoing */, *graph, finishSegment,
-                         dummy /* bestSegmentIsAlmostCodirectional */))
+    size_t const legIdx = i - passedIdx;
+    if (legIdx == projectedNumber)
     {
       return isLastSubroute ? RouterResultCode::EndPointNotFound
                             : RouterResultCode::IntermediatePointNotFound;
     }
 
-    bool isStartSegmentStrictForward = (m_vehicleType == VehicleType::Car);
-    if (isFirstSubroute)
-      isStartSegmentStrictForward = startSegmentIsAlmostCodirectionalDirection;
+    auto & leg = legs[legIdx];
+    uint32_t const numFakeSegments = starter ? starter->GetNumFakeSegments() : 0;
+    if (!leg.m_starter || leg.m_start != startSegment ||
+        leg.m_fakeNumerationStart != numFakeSegments)
+    {
+      if (leg.m_starter)
+        ++recalculatedNumber;
+      makeStarter(legIdx, startSegment, numFakeSegments);
+      calcLeg(legIdx);
+    }
 
-    IndexGraphStarter subrouteStarter(MakeFakeEnding(startSegment, startCheckpoint, *graph),
-                                      MakeFakeEnding(finishSegment, finishCheckpoint, *graph),
-                                      starter ? starter->GetNumFakeSegments() : 0,
-                                      isStartSegmentStrictForward, *graph);
+    m_lastStatistics.m_astarSec += leg.m_statistics.m_astarSec;
+    m_lastStatistics.m_leapsSec += leg.m_statistics.m_leapsSec;
+    m_lastStatistics.m_settledVertices += leg.m_statistics.m_settledVertices;
 
-    vector<Segment> subroute;
-    auto const result = CalculateSubroute(checkpoints, i, delegate, subrouteStarter, subroute);
-
-    if (result != RouterResultCode::NoError)
-      return result;
+    if (leg.m_result != RouterResultCode::NoError)
+      return leg.m_result;
 
+    auto & subrouteStarter = *leg.m_starter;
+    auto const & subroute = leg.m_subroute;
     IndexGraphStarter::CheckValidRoute(subroute);
 
     segments.insert(segments.end(), subroute.begin(), subroute.end());
@@ -461,12 +909,21 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
       starter->Append(FakeEdgesContainer(move(subrouteStarter)));
   }
 
+  if (threadsNumber > 1)
+  {
+    LOG(LINFO, ("Subroutes are calculated by", threadsNumber, "threads,", recalculatedNumber,
+                "of", legs.size(), "are recalculated."));
+  }
+
   route.SetCurrentSubrouteIdx(checkpoints.GetPassedIdx());
   route.SetSubroteAttrs(move(subroutes));
 
   IndexGraphStarter::CheckValidRoute(segments);
 
+  timer.Reset();
   auto redressResult = RedressRoute(segments, delegate, *starter, route);
+  m_lastStatistics.m_directionsSec = timer.ElapsedSeconds();
+  m_lastStatistics.m_turnsSec = m_directionsEngine->GetTurnsGenerationSec();
   if (redressResult != RouterResultCode::NoError)
     return redressResult;
 
@@ -475,8 +932,28 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
   for (Segment const & segment : segments)
     m_lastRoute->AddStep(segment, starter->GetPoint(segment, true /* front */));
 
+  // Alternatives use the fake segments of |starter| which has the only subroute.
+  for (auto const & alternativeSegments : legs.front().m_alternatives)
+  {
+    CHECK_EQUAL(legs.size(), 1, ());
+    IndexGraphStarter::CheckValidRoute(alternativeSegments);
+
+    Route alternative(GetName(), 0 /* routeId */);
+    vector<Route::SubrouteAttrs> alternativeSubroutes = passedSubroutes;
+    alternativeSubroutes.emplace_back(starter->GetStartJunction(), starter->GetFinishJunction(),
+                                      0 /* beginSegmentIdx */, alternativeSegments.size());
+    alternative.SetCurrentSubrouteIdx(checkpoints.GetPassedIdx());
+    alternative.SetSubroteAttrs(move(alternativeSubroutes));
+    if (RedressRoute(alternativeSegments, delegate, *starter, alternative) ==
+        RouterResultCode::NoError)
+    {
+      alternatives.push_back(move(alternative));
+    }
+  }
+
   m_lastFakeEdges = make_unique<FakeEdgesContainer>(move(*starter));
 
+  LOG(LDEBUG, (RoadGeometryCache::Instance().GetStats()));
   return RouterResultCode::NoError;
 }
 
@@ -484,9 +961,14 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
                                                 size_t subrouteIdx,
                                                 RouterDelegate const & delegate,
                                                 IndexGraphStarter & starter,
-                                                vector<Segment> & subroute)
+                                                size_t maxAlternatives,
+                                                Statistics & statistics,
+                                                vector<Segment> & subroute,
+                                                vector<vector<Segment>> & alternativeSubroutes)
 {
+  base::ProfilerZone zone("CalculateSubroute", "routing");
   subroute.clear();
+  alternativeSubroutes.clear();
 
   // We use leaps for cars only. Other vehicle types do not have weights in their cross-mwm sections.
   switch (m_vehicleType)
@@ -540,12 +1022,36 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
       delegate, onVisitJunction, checkLength);
 
   set<NumMwmId> const mwmIds = starter.GetMwms();
-  RouterResultCode const result = FindPath<IndexGraphStarter>(params, mwmIds, routingResult);
+  base::Timer timer;
+  RouterResultCode result = RouterResultCode::NoError;
+  vector<RoutingResult<Segment, RouteWeight>> alternatives;
+  if (maxAlternatives != 0 && starter.GetGraph().GetMode() == WorldGraph::Mode::NoLeaps)
+  {
+    // Alternatives are chosen from the search spaces of the bidirectional search. It's not used
+    // in LeapsOnly mode.
+    AStarAlgorithm<IndexGraphStarter> algorithm;
+    AStarAlgorithm<IndexGraphStarter>::AlternativesParams alternativesParams;
+    alternativesParams.m_maxAlternatives = maxAlternatives;
+    result = ConvertTransitResult(
+        mwmIds, ConvertResult<IndexGraphStarter>(algorithm.FindPathBidirectionalWithAlternatives(
+                    params, alternativesParams, routingResult, alternatives)));
+  }
+  else
+  {
+    result = FindPath<IndexGraphStarter>(params, mwmIds, routingResult);
+  }
+  statistics.m_astarSec += timer.ElapsedSeconds();
+  statistics.m_settledVertices += visitCount;
   if (result != RouterResultCode::NoError)
     return result;
 
+  for (auto const & alternative : alternatives)
+    alternativeSubroutes.push_back(alternative.m_path);
+
+  timer.Reset();
   RouterResultCode const leapsResult =
       ProcessLeaps(routingResult.m_path, delegate, starter.GetGraph().GetMode(), starter, subroute);
+  statistics.m_leapsSec += timer.ElapsedSeconds();
   if (leapsResult != RouterResultCode::NoError)
     return leapsResult;
 
@@ -558,11 +1064,12 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
 {
   base::Timer timer;
   TrafficStash::Guard guard(m_trafficStash);
+  m2::PointD const & pointFrom = checkpoints.GetPointFrom();
+  m_estimator->SetDepartureTime(time(nullptr), MercatorBounds::XToLon(pointFrom.x));
   auto graph = MakeWorldGraph();
   graph->SetMode(WorldGraph::Mode::NoLeaps);
 
   Segment startSegment;
-  m2::PointD const & pointFrom = checkpoints.GetPointFrom();
   bool bestSegmentIsAlmostCodirectional = false;
   if (!FindBestSegment(pointFrom, startDirection, true /* isOutgoing */, *graph, startSegment,
                        bestSegmentIsAlmostCodirectional))
@@ -662,7 +1169,9 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
   return RouterResultCode::NoError;
 }
 
-unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
+unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph() { return MakeWorldGraph(m_estimator); }
+
+unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph(shared_ptr<EdgeEstimator> estimator)
 {
   auto crossMwmGraph = make_unique<CrossMwmGraph>(
       m_numMwmIds, m_numMwmTree, m_vehicleModelFactory,
@@ -670,20 +1179,57 @@ unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
       m_countryRectFn, m_dataSource);
   auto indexGraphLoader = IndexGraphLoader::Create(
       m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType,
-      m_loadAltitudes, m_numMwmIds, m_vehicleModelFactory, m_estimator, m_dataSource);
+      m_loadAltitudes, m_numMwmIds, m_vehicleModelFactory, estimator, m_dataSource);
   if (m_vehicleType != VehicleType::Transit)
   {
     return make_unique<SingleVehicleWorldGraph>(move(crossMwmGraph), move(indexGraphLoader),
-                                                m_estimator);
+                                                estimator, m_crossMwmTrafficWeights);
   }
-  auto transitGraphLoader = TransitGraphLoader::Create(m_dataSource, m_numMwmIds, m_estimator);
+  auto transitGraphLoader = TransitGraphLoader::Create(m_dataSource, m_numMwmIds, estimator);
   return make_unique<TransitWorldGraph>(move(crossMwmGraph), move(indexGraphLoader),
-                                        move(transitGraphLoader), m_estimator);
+                                        move(transitGraphLoader), estimator);
+}
+
+void IndexRouter::FindClosestEdges(vector<m2::PointD> const & points,
+                                   vector<vector<pair<Edge, Junction>>> & candidates) const
+{
+  candidates.assign(points.size(), {});
+  size_t const threadsNumber =
+      min(points.size(), static_cast<size_t>(max(thread::hardware_concurrency(), 1U)));
+
+  // FeaturesRoadGraph is not thread-safe, so every thread uses its own instance.
+  auto const findClosestEdges = [&](size_t threadIdx) {
+    FeaturesRoadGraph roadGraph(m_dataSource, GetRoadGraphMode(m_vehicleType),
+                                m_vehicleModelFactory, GetRoadGraphSnappingMask(m_vehicleType));
+    for (size_t i = threadIdx; i < points.size(); i += threadsNumber)
+      roadGraph.FindClosestEdges(points[i], kMaxRoadCandidates, candidates[i]);
+  };
+
+  vector<threads::SimpleThread> threads;
+  for (size_t i = 1; i < threadsNumber; ++i)
+    threads.emplace_back(findClosestEdges, i);
+
+  if (threadsNumber != 0)
+    findClosestEdges(0);
+
+  for (auto & thread : threads)
+    thread.join();
 }
 
 bool IndexRouter::FindBestSegment(m2::PointD const & point, m2::PointD const & direction,
                                   bool isOutgoing, WorldGraph & worldGraph, Segment & bestSegment,
                                   bool & bestSegmentIsAlmostCodirectional) const
+{
+  vector<pair<Edge, Junction>> candidates;
+  m_roadGraph.FindClosestEdges(point, kMaxRoadCandidates, candidates);
+  return SelectBestSegment(point, direction, isOutgoing, worldGraph, move(candidates), bestSegment,
+                           bestSegmentIsAlmostCodirectional);
+}
+
+bool IndexRouter::SelectBestSegment(m2::PointD const & point, m2::PointD const & direction,
+                                    bool isOutgoing, WorldGraph & worldGraph,
+                                    vector<pair<Edge, Junction>> candidates, Segment & bestSegment,
+                                    bool & bestSegmentIsAlmostCodirectional) const
 {
   auto const file = platform::CountryFile(m_countryFileFn(point));
   MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleByCountryFile(file);
@@ -693,9 +1239,6 @@ bool IndexRouter::FindBestSegment(m2::PointD const & point, m2::PointD const & d
   auto const mwmId = MwmSet::MwmId(handle.GetInfo());
   NumMwmId const numMwmId = m_numMwmIds->GetId(file);
 
-  vector<pair<Edge, Junction>> candidates;
-  m_roadGraph.FindClosestEdges(point, kMaxRoadCandidates, candidates);
-
   auto const getSegmentByEdge = [&numMwmId](Edge const & edge) {
     return Segment(numMwmId, edge.GetFeatureId().m_index, edge.GetSegId(), edge.IsForward());
   };
@@ -731,6 +1274,7 @@ RouterResultCode IndexRouter::ProcessLeaps(vector<Segment> const & input,
                                            IndexGraphStarter & starter,
                                            vector<Segment> & output)
 {
+  base::ProfilerZone zone("ProcessLeaps", "routing");
   if (prevMode != WorldGraph::Mode::LeapsOnly)
   {
     output = input;
@@ -849,6 +1393,7 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
                                            RouterDelegate const & delegate,
                                            IndexGraphStarter & starter, Route & route) const
 {
+  base::ProfilerZone zone("RedressRoute", "routing");
   CHECK(!segments.empty(), ());
   vector<Junction> junctions;
   size_t const numPoints = IndexGraphStarter::GetRouteNumPoints(segments);
@@ -4,8 +4,10 @@
 #include "routing/base/routing_result.hpp"
 
 #include "routing/cross_mwm_graph.hpp"
+#include "routing/cross_mwm_traffic_weights.hpp"
 #include "routing/directions_engine.hpp"
 #include "routing/edge_estimator.hpp"
+#include "routing/fake_ending.hpp"
 #include "routing/fake_edges_container.hpp"
 #include "routing/features_road_graph.hpp"
 #include "routing/joint.hpp"
@@ -23,9 +25,11 @@
 
 #include "std/unique_ptr.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 class DataSource;
@@ -62,6 +66,34 @@ public:
     m2::PointD const m_direction;
   };
 
+  /// \brief Result of route calculation between an origin and a destination of a routes matrix.
+  struct RoutesMatrixItem
+  {
+    RouterResultCode m_code = RouterResultCode::RouteNotFound;
+    // Route weight in seconds.
+    double m_weight = 0.0;
+    double m_etaSec = 0.0;
+    double m_distanceM = 0.0;
+  };
+
+  // |RoutesMatrix[i][j]| is the route from the origin |i| to the destination |j|.
+  using RoutesMatrix = std::vector<std::vector<RoutesMatrixItem>>;
+
+  /// \brief Time of route calculation phases and size of the search of the last
+  /// CalculateRoute() call. It's intended for benchmarks.
+  struct Statistics
+  {
+    double m_nearestEdgesSec = 0.0;
+    double m_astarSec = 0.0;
+    double m_leapsSec = 0.0;
+    // Route reconstruction with IDirectionsEngine including |m_turnsSec|.
+    double m_directionsSec = 0.0;
+    double m_turnsSec = 0.0;
+    // Number of vertices settled by A* while the route is searched. Vertices settled
+    // while leaps are processed are not counted.
+    uint64_t m_settledVertices = 0;
+  };
+
   IndexRouter(VehicleType vehicleType, bool loadAltitudes,
               CountryParentNameGetterFn const & countryParentNameGetterFn,
               TCountryFileFn const & countryFileFn, CourntryRectFn const & countryRectFn,
@@ -78,19 +110,81 @@ public:
                                   bool adjustToPrevRoute, RouterDelegate const & delegate,
                                   Route & route) override;
 
+  /// \brief Calculates the route as CalculateRoute() does and up to |maxAlternatives|
+  /// alternative routes which are found by the same bidirectional search.
+  /// \note Alternatives are calculated for routes with one remaining subroute which are
+  /// searched without leaps only, |alternatives| is empty for other routes.
+  RouterResultCode CalculateRouteWithAlternatives(Checkpoints const & checkpoints,
+                                                  m2::PointD const & startDirection,
+                                                  size_t maxAlternatives,
+                                                  RouterDelegate const & delegate, Route & route,
+                                                  std::vector<Route> & alternatives);
+
+  /// \brief Calculates routes from every point of |origins| to every point of |destinations|.
+  /// One Dijkstra wave is propagated from every origin until all the destinations are reached
+  /// or route weight exceeds |maxWeightSec|. Leaps are not used, so the method is intended
+  /// for points which are not too far from each other.
+  /// \returns RouterResultCode::NoError if the matrix is calculated. Codes of the matrix items
+  /// show whether the routes are found.
+  RouterResultCode CalculateRoutesMatrix(std::vector<m2::PointD> const & origins,
+                                         std::vector<m2::PointD> const & destinations,
+                                         double maxWeightSec, RouterDelegate const & delegate,
+                                         RoutesMatrix & matrix);
+
+  Statistics const & GetLastStatistics() const { return m_lastStatistics; }
+
+  /// \brief Sets the maximum number of threads which calculate subroutes of routes with
+  /// intermediate points. Every additional thread uses its own world graph. Subroutes are
+  /// calculated one by one by default.
+  void SetMaxSubroutesThreadsNumber(size_t threadsNumber)
+  {
+    m_maxSubroutesThreadsNumber = threadsNumber;
+  }
+
 private:
   RouterResultCode DoCalculateRoute(Checkpoints const & checkpoints,
-                                    m2::PointD const & startDirection,
-                                    RouterDelegate const & delegate, Route & route);
+                                    m2::PointD const & startDirection, size_t maxAlternatives,
+                                    RouterDelegate const & delegate, Route & route,
+                                    std::vector<Route> & alternatives);
+  /// \note The method may be called for different subroutes in parallel if |graph|s use
+  /// different world graphs. |statistics| is filled with the time of the subroute search.
+  /// Up to |maxAlternatives| alternatives of |subroute| are put to |alternativeSubroutes|
+  /// if the subroute is searched without leaps.
   RouterResultCode CalculateSubroute(Checkpoints const & checkpoints, size_t subrouteIdx,
                                      RouterDelegate const & delegate, IndexGraphStarter & graph,
-                                     std::vector<Segment> & subroute);
+                                     size_t maxAlternatives, Statistics & statistics,
+                                     std::vector<Segment> & subroute,
+                                     std::vector<std::vector<Segment>> & alternativeSubroutes);
 
   RouterResultCode AdjustRoute(Checkpoints const & checkpoints,
                                m2::PointD const & startDirection,
                                RouterDelegate const & delegate, Route & route);
 
+  RouterResultCode DoCalculateRoutesMatrix(std::vector<m2::PointD> const & origins,
+                                           std::vector<m2::PointD> const & destinations,
+                                           double maxWeightSec, RouterDelegate const & delegate,
+                                           RoutesMatrix & matrix);
+  // Fills |items| with routes from |originEnding| to every ending of |destinationEndings|
+  // calculated with one wave.
+  RouterResultCode CalculateRoutesMatrixRow(
+      FakeEnding const & originEnding, std::vector<FakeEnding const *> const & destinationEndings,
+      double maxWeightSec, RouterDelegate const & delegate, WorldGraph & graph,
+      std::vector<RoutesMatrixItem> & items) const;
+
   std::unique_ptr<WorldGraph> MakeWorldGraph();
+  /// \brief Makes a graph which weights edges with |estimator|. Graphs with different estimators
+  /// may be used in different threads.
+  std::unique_ptr<WorldGraph> MakeWorldGraph(std::shared_ptr<EdgeEstimator> estimator);
+
+  /// \brief Prefetches graph sections of mwms which a route through |checkpoints| likely
+  /// crosses: mwms near the straight lines between consecutive checkpoints, in the order they
+  /// are met along the lines.
+  void PrefetchRouteCorridor(Checkpoints const & checkpoints) const;
+
+  /// \brief Fills |candidates| with the closest edges of every point of |points|.
+  /// The points are processed in parallel.
+  void FindClosestEdges(std::vector<m2::PointD> const & points,
+                        std::vector<std::vector<std::pair<Edge, Junction>>> & candidates) const;
 
   /// \brief Finds the best segment (edge) which may be considered as the start of the finish of the route.
   /// According to current implementation if a segment is near |point| and is almost codirectional
@@ -104,6 +198,11 @@ private:
   bool FindBestSegment(m2::PointD const & point, m2::PointD const & direction, bool isOutgoing,
                        WorldGraph & worldGraph, Segment & bestSegment,
                        bool & bestSegmentIsAlmostCodirectional) const;
+  /// \brief The same as FindBestSegment() but the best segment is chosen from |candidates|
+  /// which are the closest edges to |point|.
+  bool SelectBestSegment(m2::PointD const & point, m2::PointD const & direction, bool isOutgoing,
+                         WorldGraph & worldGraph, std::vector<std::pair<Edge, Junction>> candidates,
+                         Segment & bestSegment, bool & bestSegmentIsAlmostCodirectional) const;
 
   // Input route may contains 'leaps': shortcut edges from mwm border enter to exit.
   // ProcessLeaps replaces each leap with calculated route through mwm.
@@ -157,11 +256,17 @@ private:
   std::shared_ptr<NumMwmIds> m_numMwmIds;
   std::shared_ptr<m4::Tree<NumMwmId>> m_numMwmTree;
   std::shared_ptr<TrafficStash> m_trafficStash;
+  // Leap weights with traffic. They're kept between routing requests.
+  std::shared_ptr<CrossMwmTrafficWeights> m_crossMwmTrafficWeights;
   FeaturesRoadGraph m_roadGraph;
 
+  double const m_maxWeightSpeedKMpH;
+  double const m_offroadSpeedKMpH;
   std::shared_ptr<EdgeEstimator> m_estimator;
   std::unique_ptr<IDirectionsEngine> m_directionsEngine;
   std::unique_ptr<SegmentedRoute> m_lastRoute;
   std::unique_ptr<FakeEdgesContainer> m_lastFakeEdges;
+  Statistics m_lastStatistics;
+  size_t m_maxSubroutesThreadsNumber = 1;
 };
 }  // namespace routing
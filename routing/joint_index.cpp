@@ -6,6 +6,8 @@ namespace routing
 {
 void JointIndex::Build(RoadIndex const & roadIndex, uint32_t numJoints)
 {
+  CHECK(!IsMapped(), ());
+
   // + 1 is protection for 'End' method from out of bounds.
   // Call End(numJoints-1) requires more size, so add one more item.
   // Therefore m_offsets.size() == numJoints + 1,
@@ -44,4 +46,17 @@ void JointIndex::Build(RoadIndex const & roadIndex, uint32_t numJoints)
   CHECK_EQUAL(m_offsets[0], 0, ());
   CHECK_EQUAL(m_offsets.back(), m_points.size(), ());
 }
+
+void JointIndex::Map(uint32_t numJoints, uint32_t const * offsets, uint32_t const * points)
+{
+  CHECK(offsets, ());
+  CHECK(points, ());
+  CHECK_EQUAL(offsets[0], 0, ());
+
+  m_offsets.clear();
+  m_points.clear();
+  m_numMappedJoints = numJoints;
+  m_mappedOffsets = offsets;
+  m_mappedPoints = points;
+}
 }  // namespace routing
@@ -20,26 +20,49 @@ public:
   // Read comments in Build method about -1.
   uint32_t GetNumJoints() const
   {
+    if (IsMapped())
+      return m_numMappedJoints;
+
     CHECK_GREATER(m_offsets.size(), 0, ());
     return static_cast<uint32_t>(m_offsets.size() - 1);
   }
 
-  uint32_t GetNumPoints() const { return static_cast<uint32_t>(m_points.size()); }
-  RoadPoint GetPoint(Joint::Id jointId) const { return m_points[Begin(jointId)]; }
+  uint32_t GetNumPoints() const
+  {
+    return IsMapped() ? m_mappedOffsets[m_numMappedJoints]
+                      : static_cast<uint32_t>(m_points.size());
+  }
+
+  RoadPoint GetPoint(Joint::Id jointId) const { return GetPointByIndex(Begin(jointId)); }
 
   template <typename F>
   void ForEachPoint(Joint::Id jointId, F && f) const
   {
     for (uint32_t i = Begin(jointId); i < End(jointId); ++i)
-      f(m_points[i]);
+      f(GetPointByIndex(i));
   }
 
   void Build(RoadIndex const & roadIndex, uint32_t numJoints);
 
+  /// \brief Makes the index refer to joints of a mapped section without copying them.
+  /// The arrays should be valid while the index is used.
+  /// \param offsets |numJoints| + 1 offsets of the joints points. The same layout as
+  /// |m_offsets| has after Build().
+  /// \param points pairs of feature id and point id.
+  void Map(uint32_t numJoints, uint32_t const * offsets, uint32_t const * points);
+
 private:
+  bool IsMapped() const { return m_mappedOffsets != nullptr; }
+
   // Begin index for jointId entries.
   uint32_t Begin(Joint::Id jointId) const
   {
+    if (IsMapped())
+    {
+      ASSERT_LESS(jointId, m_numMappedJoints, ());
+      return m_mappedOffsets[jointId];
+    }
+
     ASSERT_LESS(jointId, m_offsets.size(), ());
     return m_offsets[jointId];
   }
@@ -48,11 +71,29 @@ private:
   uint32_t End(Joint::Id jointId) const
   {
     Joint::Id const nextId = jointId + 1;
+    if (IsMapped())
+    {
+      ASSERT_LESS_OR_EQUAL(nextId, m_numMappedJoints, ());
+      return m_mappedOffsets[nextId];
+    }
+
     ASSERT_LESS(nextId, m_offsets.size(), ());
     return m_offsets[nextId];
   }
 
+  RoadPoint GetPointByIndex(uint32_t i) const
+  {
+    if (IsMapped())
+      return RoadPoint(m_mappedPoints[2 * i], m_mappedPoints[2 * i + 1]);
+
+    return m_points[i];
+  }
+
   vector<uint32_t> m_offsets;
   vector<RoadPoint> m_points;
+
+  uint32_t m_numMappedJoints = 0;
+  uint32_t const * m_mappedOffsets = nullptr;
+  uint32_t const * m_mappedPoints = nullptr;
 };
 }  // namespace routing
@@ -0,0 +1,371 @@
+#include "routing/landmarks.hpp"
+
+#include "routing/index_graph.hpp"
+#include "routing/road_index.hpp"
+#include "routing/road_point.hpp"
+#include "routing/routing_helpers.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/buffer_vector.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+using Distance = Landmarks::Distance;
+
+// Distances are accumulated in 64-bit integers to avoid overflow on long roads.
+using LongDistance = uint64_t;
+
+LongDistance constexpr kInfiniteLongDistance = numeric_limits<LongDistance>::max();
+double constexpr kMillisecondsInSecond = 1000.0;
+
+struct JointEdge
+{
+  JointEdge(Joint::Id target, Distance weight) : m_target(target), m_weight(weight) {}
+
+  Joint::Id m_target;
+  Distance m_weight;
+};
+
+using JointAdjacency = vector<vector<JointEdge>>;
+
+// Builds undirected graph whose vertices are joints of |graph| and edges are parts of roads
+// between neighboring joints.
+void BuildJointAdjacency(IndexGraph & graph, JointAdjacency & adjacency)
+{
+  adjacency.assign(graph.GetNumJoints(), {});
+  Geometry & geometry = graph.GetGeometry();
+  graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const & road) {
+    RoadGeometry const & roadGeometry = geometry.GetRoad(featureId);
+    if (!roadGeometry.IsValid())
+      return;
+
+    Joint::Id prevJointId = Joint::kInvalidId;
+    LongDistance weight = 0;
+    for (uint32_t pointId = 0; pointId < roadGeometry.GetPointsCount(); ++pointId)
+    {
+      if (pointId != 0)
+        weight += CalcLandmarkSegmentWeight(roadGeometry, pointId - 1);
+
+      Joint::Id const jointId = road.GetJointId(pointId);
+      if (jointId == Joint::kInvalidId)
+        continue;
+
+      if (prevJointId != Joint::kInvalidId && prevJointId != jointId)
+      {
+        auto const edgeWeight = static_cast<Distance>(
+            min(weight, static_cast<LongDistance>(Landmarks::kInfiniteDistance - 1)));
+        adjacency[prevJointId].emplace_back(jointId, edgeWeight);
+        adjacency[jointId].emplace_back(prevJointId, edgeWeight);
+      }
+
+      prevJointId = jointId;
+      weight = 0;
+    }
+  });
+}
+
+void CalcDistances(JointAdjacency const & adjacency, Joint::Id source,
+                   vector<LongDistance> & distances)
+{
+  using State = pair<LongDistance, Joint::Id>;
+
+  distances.assign(adjacency.size(), kInfiniteLongDistance);
+  priority_queue<State, vector<State>, greater<State>> queue;
+
+  distances[source] = 0;
+  queue.emplace(0, source);
+  while (!queue.empty())
+  {
+    State const state = queue.top();
+    queue.pop();
+
+    if (state.first > distances[state.second])
+      continue;
+
+    for (auto const & edge : adjacency[state.second])
+    {
+      LongDistance const distance = state.first + edge.m_weight;
+      if (distance >= distances[edge.m_target])
+        continue;
+
+      distances[edge.m_target] = distance;
+      queue.emplace(distance, edge.m_target);
+    }
+  }
+}
+
+// \returns a joint of the largest connected component of |adjacency|.
+Joint::Id FindLargestComponentJoint(JointAdjacency const & adjacency)
+{
+  vector<bool> visited(adjacency.size(), false);
+  vector<Joint::Id> stack;
+  Joint::Id bestJoint = Joint::kInvalidId;
+  size_t bestSize = 0;
+
+  for (Joint::Id jointId = 0; jointId < adjacency.size(); ++jointId)
+  {
+    if (visited[jointId])
+      continue;
+
+    size_t size = 0;
+    visited[jointId] = true;
+    stack.push_back(jointId);
+    while (!stack.empty())
+    {
+      Joint::Id const current = stack.back();
+      stack.pop_back();
+      ++size;
+      for (auto const & edge : adjacency[current])
+      {
+        if (visited[edge.m_target])
+          continue;
+
+        visited[edge.m_target] = true;
+        stack.push_back(edge.m_target);
+      }
+    }
+
+    if (size > bestSize)
+    {
+      bestSize = size;
+      bestJoint = jointId;
+    }
+  }
+
+  return bestJoint;
+}
+
+// \returns the reachable joint with the largest |distances| value.
+Joint::Id FindFarthestJoint(vector<LongDistance> const & distances)
+{
+  Joint::Id farthest = Joint::kInvalidId;
+  LongDistance farthestDistance = 0;
+  for (Joint::Id jointId = 0; jointId < distances.size(); ++jointId)
+  {
+    auto const distance = distances[jointId];
+    if (distance == kInfiniteLongDistance)
+      continue;
+
+    if (farthest == Joint::kInvalidId || distance > farthestDistance)
+    {
+      farthest = jointId;
+      farthestDistance = distance;
+    }
+  }
+  return farthest;
+}
+
+LongDistance AddDistance(Distance landmarkDistance, LongDistance weight)
+{
+  if (landmarkDistance == Landmarks::kInfiniteDistance)
+    return kInfiniteLongDistance;
+  return static_cast<LongDistance>(landmarkDistance) + weight;
+}
+
+using PointDistances = buffer_vector<LongDistance, Landmarks::kMaxNumLandmarks>;
+
+// Calculates distances from all the landmarks to |rp|. If |rp| is not a joint it can be reached
+// only along its road through the neighboring joints, so the distances are exact for the
+// undirected graph the landmarks were built for.
+void CalcPointDistances(IndexGraph & graph, RoadPoint const & rp, PointDistances & distances)
+{
+  Landmarks const & landmarks = graph.GetLandmarks();
+  size_t const numLandmarks = landmarks.GetNumLandmarks();
+  distances.clear();
+  distances.resize(numLandmarks, kInfiniteLongDistance);
+
+  Joint::Id const jointId = graph.GetJointId(rp);
+  if (jointId != Joint::kInvalidId)
+  {
+    for (size_t i = 0; i < numLandmarks; ++i)
+      distances[i] = AddDistance(landmarks.GetDistance(i, jointId), 0 /* weight */);
+    return;
+  }
+
+  if (!graph.IsRoad(rp.GetFeatureId()))
+    return;
+
+  RoadJointIds const & road = graph.GetRoad(rp.GetFeatureId());
+  RoadGeometry const & roadGeometry = graph.GetGeometry().GetRoad(rp.GetFeatureId());
+  if (!roadGeometry.IsValid())
+    return;
+
+  uint32_t const pointId = rp.GetPointId();
+  for (bool const forward : {false, true})
+  {
+    auto const neighbor = road.FindNeighbor(pointId, forward);
+    if (neighbor.first == Joint::kInvalidId)
+      continue;
+
+    uint32_t const begin = forward ? pointId : neighbor.second;
+    uint32_t const end = forward ? neighbor.second : pointId;
+    LongDistance weight = 0;
+    for (uint32_t segmentIdx = begin; segmentIdx < end; ++segmentIdx)
+      weight += CalcLandmarkSegmentWeight(roadGeometry, segmentIdx);
+
+    for (size_t i = 0; i < numLandmarks; ++i)
+    {
+      distances[i] =
+          min(distances[i], AddDistance(landmarks.GetDistance(i, neighbor.first), weight));
+    }
+  }
+}
+}  // namespace
+
+namespace routing
+{
+// static
+Landmarks::Distance constexpr Landmarks::kInfiniteDistance;
+// static
+size_t constexpr Landmarks::kMaxNumLandmarks;
+
+Landmarks::Landmarks(uint32_t numJoints, vector<Distance> && distances)
+  : m_numJoints(numJoints), m_distances(move(distances))
+{
+  CHECK(m_numJoints != 0 || m_distances.empty(), ());
+  CHECK(m_numJoints == 0 || m_distances.size() % m_numJoints == 0,
+        ("Wrong landmarks distances size:", m_distances.size(), "joints:", m_numJoints));
+  CHECK_LESS_OR_EQUAL(GetNumLandmarks(), kMaxNumLandmarks, ());
+}
+
+Landmarks::Distance CalcLandmarkSegmentWeight(RoadGeometry const & road, uint32_t segmentIdx)
+{
+  double const distanceM =
+      MercatorBounds::DistanceOnEarth(road.GetPoint(segmentIdx), road.GetPoint(segmentIdx + 1));
+  double const speedMpS = KMPH2MPS(road.GetSpeed().m_weight);
+  CHECK_GREATER(speedMpS, 0.0, ());
+  return static_cast<Distance>(floor(distanceM / speedMpS * kMillisecondsInSecond));
+}
+
+Landmarks BuildLandmarks(IndexGraph & graph, size_t numLandmarks)
+{
+  CHECK_LESS_OR_EQUAL(numLandmarks, Landmarks::kMaxNumLandmarks, ());
+
+  uint32_t const numJoints = graph.GetNumJoints();
+  if (numJoints == 0 || numLandmarks == 0)
+    return {};
+
+  JointAdjacency adjacency;
+  BuildJointAdjacency(graph, adjacency);
+
+  // Farthest landmarks selection: every next landmark is the joint which is the farthest one
+  // from all the already chosen landmarks.
+  vector<LongDistance> distances;
+  CalcDistances(adjacency, FindLargestComponentJoint(adjacency), distances);
+  Joint::Id landmark = FindFarthestJoint(distances);
+
+  vector<Distance> result;
+  result.reserve(numLandmarks * numJoints);
+  vector<LongDistance> minDistances(numJoints, kInfiniteLongDistance);
+  for (size_t i = 0; i < numLandmarks && landmark != Joint::kInvalidId; ++i)
+  {
+    CalcDistances(adjacency, landmark, distances);
+    for (Joint::Id jointId = 0; jointId < numJoints; ++jointId)
+    {
+      auto const distance = distances[jointId];
+      result.push_back(static_cast<Distance>(
+          min(distance, static_cast<LongDistance>(Landmarks::kInfiniteDistance))));
+      minDistances[jointId] = min(minDistances[jointId], distance);
+    }
+
+    landmark = FindFarthestJoint(minDistances);
+    // All the joints of the component are landmarks already.
+    if (landmark != Joint::kInvalidId && minDistances[landmark] == 0)
+      landmark = Joint::kInvalidId;
+  }
+
+  LOG(LINFO, ("Landmarks built:", result.size() / numJoints, "landmarks,", numJoints, "joints"));
+  return Landmarks(numJoints, move(result));
+}
+
+double CalcLandmarkHeuristic(IndexGraph & graph, Segment const & from, Segment const & to)
+{
+  if (graph.GetLandmarks().IsEmpty())
+    return 0.0;
+
+  PointDistances fromDistances;
+  CalcPointDistances(graph, RoadPoint(from.GetFeatureId(), from.GetPointId(true /* front */)),
+                     fromDistances);
+  PointDistances toDistances;
+  CalcPointDistances(graph, RoadPoint(to.GetFeatureId(), to.GetPointId(true /* front */)),
+                     toDistances);
+
+  LongDistance result = 0;
+  for (size_t i = 0; i < fromDistances.size(); ++i)
+  {
+    auto const fromDistance = fromDistances[i];
+    auto const toDistance = toDistances[i];
+    // Points of different connected components or points which are not reachable from
+    // the landmark.
+    if (fromDistance == kInfiniteLongDistance || toDistance == kInfiniteLongDistance)
+      continue;
+
+    result = max(result, fromDistance > toDistance ? fromDistance - toDistance
+                                                   : toDistance - fromDistance);
+  }
+
+  return static_cast<double>(result) / kMillisecondsInSecond;
+}
+
+void CalcLandmarkDistances(IndexGraph & graph, RoadPoint const & rp, LandmarkDistances & distances)
+{
+  PointDistances pointDistances;
+  CalcPointDistances(graph, rp, pointDistances);
+
+  distances.clear();
+  for (auto const distance : pointDistances)
+  {
+    distances.push_back(distance == kInfiniteLongDistance
+                            ? numeric_limits<double>::infinity()
+                            : static_cast<double>(distance) / kMillisecondsInSecond);
+  }
+}
+
+void InterpolateLandmarkDistances(LandmarkDistances const & back, LandmarkDistances const & front,
+                                  double ratio, LandmarkDistances & distances)
+{
+  CHECK_EQUAL(back.size(), front.size(), ());
+  distances.clear();
+  for (size_t i = 0; i < back.size(); ++i)
+  {
+    // A point of a segment is reached from a landmark via one of the segment ends. The distances
+    // are linear along the segment, so the heuristic stays consistent for parts of the segment.
+    if (back[i] == numeric_limits<double>::infinity() ||
+        front[i] == numeric_limits<double>::infinity())
+    {
+      distances.push_back(numeric_limits<double>::infinity());
+      continue;
+    }
+    distances.push_back((1.0 - ratio) * back[i] + ratio * front[i]);
+  }
+}
+
+double CalcLandmarkHeuristic(LandmarkDistances const & lhs, LandmarkDistances const & rhs)
+{
+  CHECK_EQUAL(lhs.size(), rhs.size(), ());
+  double result = 0.0;
+  for (size_t i = 0; i < lhs.size(); ++i)
+  {
+    if (lhs[i] == numeric_limits<double>::infinity() ||
+        rhs[i] == numeric_limits<double>::infinity())
+    {
+      continue;
+    }
+    result = max(result, fabs(lhs[i] - rhs[i]));
+  }
+  return result;
+}
+}  // namespace routing
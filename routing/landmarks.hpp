@@ -0,0 +1,85 @@
+#pragma once
+
+#include "routing/geometry.hpp"
+#include "routing/joint.hpp"
+#include "routing/road_point.hpp"
+#include "routing/segment.hpp"
+
+#include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace routing
+{
+class IndexGraph;
+
+/// \brief Distances from a few landmark joints to all the joints of an mwm road graph.
+/// It's used for ALT (A*, landmarks, triangle inequality) heuristic.
+/// \note Distances are calculated for an undirected graph whose edge weights are traffic-free
+/// segment weights rounded down to milliseconds. So for every landmark L the value
+/// |dist(L, a) - dist(L, b)| is a lower bound of route weight between |a| and |b| in both
+/// directions and the heuristic built on it is consistent.
+class Landmarks final
+{
+public:
+  // Weight in milliseconds.
+  using Distance = uint32_t;
+
+  static Distance constexpr kInfiniteDistance = std::numeric_limits<Distance>::max();
+  static size_t constexpr kMaxNumLandmarks = 32;
+
+  Landmarks() = default;
+  Landmarks(uint32_t numJoints, std::vector<Distance> && distances);
+
+  bool IsEmpty() const { return m_distances.empty(); }
+  size_t GetNumLandmarks() const { return m_numJoints == 0 ? 0 : m_distances.size() / m_numJoints; }
+  uint32_t GetNumJoints() const { return m_numJoints; }
+  std::vector<Distance> const & GetDistances() const { return m_distances; }
+
+  Distance GetDistance(size_t landmarkIdx, Joint::Id jointId) const
+  {
+    ASSERT_LESS(landmarkIdx, GetNumLandmarks(), ());
+    ASSERT_LESS(jointId, m_numJoints, ());
+    return m_distances[landmarkIdx * m_numJoints + jointId];
+  }
+
+private:
+  uint32_t m_numJoints = 0;
+  // Distances for landmark |i| are kept in range [i * m_numJoints, (i + 1) * m_numJoints).
+  std::vector<Distance> m_distances;
+};
+
+/// Distances in seconds from all the landmarks of an mwm to a point of its road graph.
+/// Distances from the landmarks which don't reach the point are infinite.
+using LandmarkDistances = buffer_vector<double, Landmarks::kMaxNumLandmarks>;
+
+/// \returns weight of segment |segmentIdx| of |road| which is used for landmarks distances.
+/// It's less or equal to the weight of the segment calculated by any EdgeEstimator.
+Landmarks::Distance CalcLandmarkSegmentWeight(RoadGeometry const & road, uint32_t segmentIdx);
+
+/// \brief Chooses |numLandmarks| joints of |graph| which are far from each other and calculates
+/// distances from them to all the joints of |graph|.
+Landmarks BuildLandmarks(IndexGraph & graph, size_t numLandmarks);
+
+/// \returns lower bound of route weight in seconds between front points of |from| and |to|
+/// calculated with landmarks of |graph|. |from| and |to| should belong to |graph|.
+/// If |graph| doesn't have landmarks returns zero.
+double CalcLandmarkHeuristic(IndexGraph & graph, Segment const & from, Segment const & to);
+
+/// \brief Calculates distances from the landmarks of |graph| to |rp|.
+/// If |graph| doesn't have landmarks |distances| is empty.
+void CalcLandmarkDistances(IndexGraph & graph, RoadPoint const & rp, LandmarkDistances & distances);
+
+/// \brief Calculates distances from the landmarks to the point which is |ratio| of the way from
+/// the point with |back| distances to the point with |front| distances along a segment.
+void InterpolateLandmarkDistances(LandmarkDistances const & back, LandmarkDistances const & front,
+                                  double ratio, LandmarkDistances & distances);
+
+/// \returns lower bound of route weight in seconds between the points with |lhs| and |rhs|
+/// distances from the same landmarks.
+double CalcLandmarkHeuristic(LandmarkDistances const & lhs, LandmarkDistances const & rhs);
+}  // namespace routing
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "routing/landmarks.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+struct LandmarksHeader
+{
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, m_version);
+    WriteToSink(sink, m_numLandmarks);
+    WriteToSink(sink, m_numJoints);
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    m_version = ReadPrimitiveFromSource<uint16_t>(src);
+    m_numLandmarks = ReadPrimitiveFromSource<uint16_t>(src);
+    m_numJoints = ReadPrimitiveFromSource<uint32_t>(src);
+  }
+
+  uint16_t m_version = 0;
+  uint16_t m_numLandmarks = 0;
+  uint32_t m_numJoints = 0;
+};
+
+static_assert(sizeof(LandmarksHeader) == 8, "Wrong header size of landmarks section.");
+
+class LandmarksSerializer final
+{
+public:
+  LandmarksSerializer() = delete;
+
+  template <typename Sink>
+  static void Serialize(Sink & sink, Landmarks const & landmarks)
+  {
+    LandmarksHeader header;
+    header.m_numLandmarks = base::checked_cast<uint16_t>(landmarks.GetNumLandmarks());
+    header.m_numJoints = landmarks.GetNumJoints();
+    header.Serialize(sink);
+
+    for (auto const distance : landmarks.GetDistances())
+      WriteToSink(sink, distance);
+  }
+
+  /// \note Landmarks are skipped if they were built for a graph with other number of joints than
+  /// |numJoints|, i.e. for an obsolete routing section.
+  template <typename Source>
+  static void Deserialize(Source & src, uint32_t numJoints, Landmarks & landmarks)
+  {
+    LandmarksHeader header;
+    header.Deserialize(src);
+    CHECK_EQUAL(header.m_version, 0, ());
+
+    if (header.m_numJoints != numJoints)
+    {
+      LOG(LWARNING, ("Landmarks are built for", header.m_numJoints, "joints but the graph has",
+                     numJoints, "joints. Landmarks are skipped."));
+      landmarks = Landmarks();
+      return;
+    }
+
+    std::vector<Landmarks::Distance> distances(static_cast<size_t>(header.m_numLandmarks) *
+                                               header.m_numJoints);
+    src.Read(distances.data(), distances.size() * sizeof(Landmarks::Distance));
+    for (auto & distance : distances)
+      distance = SwapIfBigEndianMacroBased(distance);
+
+    landmarks = Landmarks(header.m_numJoints, std::move(distances));
+  }
+};
+}  // namespace routing
@@ -0,0 +1,192 @@
+#include "routing/mapped_index_graph.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/mmap_reader.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/target_os.hpp"
+
+using namespace std;
+
+namespace
+{
+// Reads uint32_t values from the mapped section checking the section bounds.
+class SectionReader final
+{
+public:
+  SectionReader(uint32_t const * data, uint64_t size) : m_data(data), m_size(size) {}
+
+  uint32_t Read()
+  {
+    CheckSize(1);
+    return m_data[m_pos++];
+  }
+
+  uint32_t const * ReadArray(uint64_t size)
+  {
+    CheckSize(size);
+    uint32_t const * array = m_data + m_pos;
+    m_pos += size;
+    return array;
+  }
+
+  uint64_t GetPos() const { return m_pos; }
+
+private:
+  void CheckSize(uint64_t size) const
+  {
+    if (m_pos + size > m_size)
+    {
+      MYTHROW(routing::CorruptedDataException,
+              ("Unexpected end of mapped index graph:", m_pos, "+", size, ">", m_size));
+    }
+  }
+
+  uint32_t const * m_data;
+  // Size and position in uint32_t values.
+  uint64_t m_size;
+  uint64_t m_pos = 0;
+};
+}  // namespace
+
+namespace routing
+{
+// static
+uint32_t constexpr MappedIndexGraphSerializer::kLastVersion;
+
+// static
+void MappedIndexGraphSerializer::SerializeGraph(IndexGraph const & graph, vector<uint32_t> & data)
+{
+  vector<uint32_t> featureIds;
+  featureIds.reserve(graph.GetNumRoads());
+  graph.ForEachRoad([&featureIds](uint32_t featureId, RoadJointIds const & /* road */) {
+    featureIds.push_back(featureId);
+  });
+  sort(featureIds.begin(), featureIds.end());
+
+  vector<uint32_t> roadOffsets = {0};
+  vector<uint32_t> roadJointIds;
+  for (uint32_t const featureId : featureIds)
+  {
+    RoadJointIds const & road = graph.GetRoad(featureId);
+    for (uint32_t pointId = 0; pointId < road.GetSize(); ++pointId)
+      roadJointIds.push_back(road.GetJointId(pointId));
+    roadOffsets.push_back(base::asserted_cast<uint32_t>(roadJointIds.size()));
+  }
+
+  uint32_t const numJoints = graph.GetNumJoints();
+  vector<uint32_t> jointOffsets = {0};
+  vector<uint32_t> jointPoints;
+  for (Joint::Id jointId = 0; jointId < numJoints; ++jointId)
+  {
+    graph.ForEachPoint(jointId, [&jointPoints](RoadPoint const & rp) {
+      jointPoints.push_back(rp.GetFeatureId());
+      jointPoints.push_back(rp.GetPointId());
+    });
+    jointOffsets.push_back(base::asserted_cast<uint32_t>(jointPoints.size() / 2));
+  }
+
+  data.clear();
+  data.push_back(base::asserted_cast<uint32_t>(featureIds.size()));
+  data.push_back(numJoints);
+  data.push_back(base::asserted_cast<uint32_t>(roadJointIds.size()));
+  data.push_back(base::asserted_cast<uint32_t>(jointPoints.size() / 2));
+  for (auto const * array :
+       {&featureIds, &roadOffsets, &roadJointIds, &jointOffsets, &jointPoints})
+  {
+    data.insert(data.end(), array->cbegin(), array->cend());
+  }
+}
+
+// static
+unique_ptr<MappedIndexGraph> MappedIndexGraph::Map(string const & fileName, uint64_t offset,
+                                                   uint64_t size, VehicleType vehicleType)
+{
+#ifdef OMIM_OS_WINDOWS
+  // MmapReader doesn't support Windows.
+  return nullptr;
+#else
+  auto reader = make_unique<MmapReader>(fileName);
+  if (offset + size > reader->Size())
+  {
+    MYTHROW(CorruptedDataException,
+            ("Mapped index graph section", offset, size, "is out of file", fileName));
+  }
+
+  auto graph = Create(reader->Data() + offset, size, vehicleType);
+  if (graph)
+    graph->m_reader = move(reader);
+  return graph;
+#endif
+}
+
+// static
+unique_ptr<MappedIndexGraph> MappedIndexGraph::Create(uint8_t const * data, uint64_t size,
+                                                      VehicleType vehicleType)
+{
+  // Values are stored in little-endian and are used without conversion.
+  if (IsBigEndianMacroBased())
+    return nullptr;
+
+  if (reinterpret_cast<uintptr_t>(data) % alignof(uint32_t) != 0)
+  {
+    LOG(LWARNING, ("Mapped index graph section is not aligned."));
+    return nullptr;
+  }
+
+  SectionReader section(reinterpret_cast<uint32_t const *>(data), size / sizeof(uint32_t));
+  uint32_t const version = section.Read();
+  if (version != MappedIndexGraphSerializer::kLastVersion)
+  {
+    MYTHROW(CorruptedDataException,
+            ("Unknown mapped index graph version", version, ", current version",
+             MappedIndexGraphSerializer::kLastVersion));
+  }
+
+  uint32_t const numGraphs = section.Read();
+  for (uint32_t i = 0; i < numGraphs; ++i)
+  {
+    uint32_t const graphVehicleType = section.Read();
+    uint32_t const graphOffset = section.Read();
+    uint32_t const graphSize = section.Read();
+    if (graphVehicleType != static_cast<uint32_t>(vehicleType))
+      continue;
+
+    if (graphOffset % sizeof(uint32_t) != 0 || graphSize % sizeof(uint32_t) != 0 ||
+        static_cast<uint64_t>(graphOffset) + graphSize > size)
+    {
+      MYTHROW(CorruptedDataException,
+              ("Wrong mapped index graph", graphOffset, graphSize, ", section size", size));
+    }
+
+    SectionReader reader(reinterpret_cast<uint32_t const *>(data + graphOffset),
+                         graphSize / sizeof(uint32_t));
+    unique_ptr<MappedIndexGraph> graph(new MappedIndexGraph());
+    graph->m_numRoads = reader.Read();
+    graph->m_numJoints = reader.Read();
+    uint32_t const numRoadJointIds = reader.Read();
+    uint32_t const numJointPoints = reader.Read();
+    graph->m_featureIds = reader.ReadArray(graph->m_numRoads);
+    graph->m_roadOffsets = reader.ReadArray(static_cast<uint64_t>(graph->m_numRoads) + 1);
+    graph->m_roadJointIds = reader.ReadArray(numRoadJointIds);
+    graph->m_jointOffsets = reader.ReadArray(static_cast<uint64_t>(graph->m_numJoints) + 1);
+    graph->m_jointPoints = reader.ReadArray(2 * static_cast<uint64_t>(numJointPoints));
+
+    // Only the bounds of the arrays are checked here. Checking all the values would require
+    // reading the whole section on every loading.
+    if (reader.GetPos() * sizeof(uint32_t) != graphSize ||
+        graph->m_roadOffsets[graph->m_numRoads] != numRoadJointIds ||
+        graph->m_jointOffsets[graph->m_numJoints] != numJointPoints)
+    {
+      MYTHROW(CorruptedDataException, ("Wrong offsets of mapped index graph for", vehicleType));
+    }
+
+    return graph;
+  }
+
+  return nullptr;
+}
+
+MappedIndexGraph::~MappedIndexGraph() = default;
+}  // namespace routing
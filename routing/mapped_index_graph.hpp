@@ -0,0 +1,121 @@
+#pragma once
+
+#include "routing/index_graph.hpp"
+#include "routing/joint.hpp"
+#include "routing/road_point.hpp"
+#include "routing/routing_exceptions.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class MmapReader;
+
+namespace routing
+{
+// Section with road and joint indices of index graphs in a layout which allows to use them
+// directly in mapped memory. There's an index graph for every vehicle type the section is built
+// for. Joint ids of a graph are the same as ids of the graph deserialized from the routing section
+// for the vehicle type.
+//
+// All the values are little-endian uint32_t:
+// version
+// graphs number
+// graphs number x (vehicle type, graph offset in bytes from the section beginning, graph size)
+// graphs
+//
+// Graph:
+// roads number, joints number, road joint ids number, joint points number
+// ascending feature ids of roads [roads number]
+// offsets of the roads in road joint ids [roads number + 1]
+// road joint ids [road joint ids number], see RoadJointIds
+// offsets of joints in joint points [joints number + 1], see JointIndex
+// joint points [2 * joint points number], pairs of feature id and point id
+class MappedIndexGraphSerializer final
+{
+public:
+  MappedIndexGraphSerializer() = delete;
+
+  template <class Sink>
+  static void Serialize(std::vector<std::pair<VehicleType, IndexGraph const *>> const & graphs,
+                        Sink & sink)
+  {
+    std::vector<std::vector<uint32_t>> data(graphs.size());
+    for (size_t i = 0; i < graphs.size(); ++i)
+      SerializeGraph(*graphs[i].second, data[i]);
+
+    WriteToSink(sink, kLastVersion);
+    WriteToSink(sink, base::asserted_cast<uint32_t>(graphs.size()));
+    uint64_t offset = sizeof(uint32_t) * (2 + 3 * graphs.size());
+    for (size_t i = 0; i < graphs.size(); ++i)
+    {
+      uint64_t const size = data[i].size() * sizeof(uint32_t);
+      WriteToSink(sink, static_cast<uint32_t>(graphs[i].first));
+      WriteToSink(sink, base::asserted_cast<uint32_t>(offset));
+      WriteToSink(sink, base::asserted_cast<uint32_t>(size));
+      offset += size;
+    }
+
+    for (auto const & graphData : data)
+    {
+      for (uint32_t const value : graphData)
+        WriteToSink(sink, value);
+    }
+  }
+
+  static uint32_t constexpr kLastVersion = 0;
+
+private:
+  static void SerializeGraph(IndexGraph const & graph, std::vector<uint32_t> & data);
+};
+
+class MappedIndexGraph final
+{
+public:
+  /// \brief Maps |vehicleType| graph of section [|offset|, |offset| + |size|) of file |fileName|.
+  /// \returns nullptr if there's no graph for |vehicleType| in the section or the section can't
+  /// be used in mapped memory on the platform.
+  /// \note Throws CorruptedDataException if the section is corrupted.
+  static std::unique_ptr<MappedIndexGraph> Map(std::string const & fileName, uint64_t offset,
+                                               uint64_t size, VehicleType vehicleType);
+
+  /// \brief The same as Map() for a section which is already in memory. |data| should be valid
+  /// while the graph is used.
+  static std::unique_ptr<MappedIndexGraph> Create(uint8_t const * data, uint64_t size,
+                                                  VehicleType vehicleType);
+
+  ~MappedIndexGraph();
+
+  uint32_t GetNumRoads() const { return m_numRoads; }
+  uint32_t GetNumJoints() const { return m_numJoints; }
+
+  uint32_t const * GetFeatureIds() const { return m_featureIds; }
+  uint32_t const * GetRoadOffsets() const { return m_roadOffsets; }
+  Joint::Id const * GetRoadJointIds() const { return m_roadJointIds; }
+  uint32_t const * GetJointOffsets() const { return m_jointOffsets; }
+  uint32_t const * GetJointPoints() const { return m_jointPoints; }
+
+private:
+  MappedIndexGraph() = default;
+
+  // Keeps the mapped file if the graph is created with Map().
+  std::unique_ptr<MmapReader> m_reader;
+
+  uint32_t m_numRoads = 0;
+  uint32_t m_numJoints = 0;
+  uint32_t const * m_featureIds = nullptr;
+  uint32_t const * m_roadOffsets = nullptr;
+  Joint::Id const * m_roadJointIds = nullptr;
+  uint32_t const * m_jointOffsets = nullptr;
+  uint32_t const * m_jointPoints = nullptr;
+};
+}  // namespace routing
@@ -9,6 +9,7 @@
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
+#include "base/timer.hpp"
 
 #include <utility>
 
@@ -46,6 +47,7 @@ bool PedestrianDirectionsEngine::Generate(IndexRoadGraph const & graph,
                                           vector<Junction> & routeGeometry,
                                           vector<Segment> & segments)
 {
+  m_turnsGenerationSec = 0.0;
   turns.clear();
   streetNames.clear();
   segments.clear();
@@ -58,7 +60,9 @@ bool PedestrianDirectionsEngine::Generate(IndexRoadGraph const & graph,
   vector<Edge> routeEdges;
   graph.GetRouteEdges(routeEdges);
 
+  base::Timer timer;
   CalculateTurns(graph, routeEdges, turns, cancellable);
+  m_turnsGenerationSec = timer.ElapsedSeconds();
 
   graph.GetRouteSegments(segments);
   return true;
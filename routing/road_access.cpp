@@ -34,8 +34,9 @@ namespace routing
 // RoadAccess --------------------------------------------------------------------------------------
 RoadAccess::Type RoadAccess::GetFeatureType(uint32_t featureId) const
 {
-// todo(@m) This may or may not be too slow. Consider profiling this and using
-// a Bloom filter or anything else that is faster than std::map.
+  if (featureId >= m_featureTypesBits.size() || !m_featureTypesBits[featureId])
+    return RoadAccess::Type::Yes;
+
   auto const it = m_featureTypes.find(featureId);
   if (it != m_featureTypes.cend())
     return it->second;
@@ -45,6 +46,10 @@ RoadAccess::Type RoadAccess::GetFeatureType(uint32_t featureId) const
 
 RoadAccess::Type RoadAccess::GetPointType(RoadPoint const & point) const
 {
+  uint32_t const featureId = point.GetFeatureId();
+  if (featureId >= m_pointTypesBits.size() || !m_pointTypesBits[featureId])
+    return RoadAccess::Type::Yes;
+
   auto const it = m_pointTypes.find(point);
   if (it != m_pointTypes.cend())
     return it->second;
@@ -52,6 +57,23 @@ RoadAccess::Type RoadAccess::GetPointType(RoadPoint const & point) const
   return RoadAccess::Type::Yes;
 }
 
+void RoadAccess::BuildFeatureBits()
+{
+  auto const setBit = [](uint32_t featureId, vector<bool> & bits) {
+    if (featureId >= bits.size())
+      bits.resize(featureId + 1, false);
+    bits[featureId] = true;
+  };
+
+  m_featureTypesBits.clear();
+  for (auto const & kv : m_featureTypes)
+    setBit(kv.first, m_featureTypesBits);
+
+  m_pointTypesBits.clear();
+  for (auto const & kv : m_pointTypes)
+    setBit(kv.first.GetFeatureId(), m_pointTypesBits);
+}
+
 bool RoadAccess::operator==(RoadAccess const & rhs) const
 {
   return m_featureTypes == rhs.m_featureTypes && m_pointTypes == rhs.m_pointTypes;
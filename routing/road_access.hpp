@@ -59,6 +59,7 @@ public:
   {
     m_featureTypes = std::forward<MF>(mf);
     m_pointTypes = std::forward<MP>(mp);
+    BuildFeatureBits();
   }
 
   void Clear();
@@ -71,14 +72,23 @@ public:
   void SetFeatureTypesForTests(MF && mf)
   {
     m_featureTypes = std::forward<MF>(mf);
+    BuildFeatureBits();
   }
 
 private:
+  void BuildFeatureBits();
+
   // If segmentIdx of a key in this map is 0, it means the
   // entire feature has the corresponding access type.
   // Otherwise, the information is about the segment with number (segmentIdx-1).
   std::unordered_map<uint32_t, RoadAccess::Type> m_featureTypes;
   std::unordered_map<RoadPoint, RoadAccess::Type, RoadPoint::Hash> m_pointTypes;
+
+  // Most of features have no access information, so maps are looked up only for features
+  // whose bits are set: |m_featureTypesBits| for keys of |m_featureTypes| and
+  // |m_pointTypesBits| for features of keys of |m_pointTypes|.
+  std::vector<bool> m_featureTypesBits;
+  std::vector<bool> m_pointTypesBits;
 };
 
 std::string ToString(RoadAccess::Type type);
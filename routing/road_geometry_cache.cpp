@@ -0,0 +1,159 @@
+#include "routing/road_geometry_cache.hpp"
+
+#include "routing/geometry.hpp"
+
+#include "base/assert.hpp"
+#include "base/cache_registry.hpp"
+
+#include <sstream>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+// Memory which is used by a cached road in addition to RoadGeometry itself: list and hash map
+// nodes and the shared_ptr control block.
+size_t constexpr kItemOverheadBytes = 96;
+
+size_t GetSizeBytes(routing::RoadGeometry const & road)
+{
+  // Upper bound: the first points of a road are kept in RoadGeometry itself.
+  return sizeof(routing::RoadGeometry) + kItemOverheadBytes +
+         road.GetPointsCount() * sizeof(routing::Junction);
+}
+}  // namespace
+
+namespace routing
+{
+// static
+size_t constexpr RoadGeometryCache::kDefaultMemoryBudgetBytes;
+// static
+size_t constexpr RoadGeometryCache::kShardsNumber;
+
+size_t RoadGeometryCache::KeyHash::operator()(Key const & key) const
+{
+  size_t const mwmHash = hash<MwmInfo const *>()(key.m_mwmKey.m_mwmId.GetInfo().get());
+  size_t const settingsHash = static_cast<size_t>(key.m_mwmKey.m_vehicleType) * 2 +
+                              (key.m_mwmKey.m_loadAltitudes ? 1 : 0);
+  size_t const featureHash = hash<uint32_t>()(key.m_featureId);
+  return (mwmHash * 31 + settingsHash) * 1000003 ^ featureHash;
+}
+
+RoadGeometryCache::RoadGeometryCache(size_t memoryBudgetBytes)
+  : m_shardBudgetBytes(memoryBudgetBytes / kShardsNumber)
+{
+}
+
+// static
+RoadGeometryCache & RoadGeometryCache::Instance()
+{
+  static RoadGeometryCache instance;
+  // Roads are loaded and processed again after the cache is cleared, so it's kept on
+  // moderate memory pressure.
+  static base::CacheRegistry::Registration const registration =
+      base::CacheRegistry::Instance().Register(
+          "RoadGeometryCache", base::CacheRegistry::Priority::Expensive,
+          [] { return instance.GetStats().m_sizeBytes; },
+          [](base::CacheRegistry::Pressure) { instance.Clear(); });
+  return instance;
+}
+
+RoadGeometryCache::RoadPtr RoadGeometryCache::GetRoad(MwmKey const & mwmKey, uint32_t featureId,
+                                                      Loader const & loader)
+{
+  Key const key = {mwmKey, featureId};
+  Shard & shard = GetShard(key);
+  {
+    lock_guard<mutex> guard(shard.m_mutex);
+    auto const it = shard.m_keyToItem.find(key);
+    if (it != shard.m_keyToItem.end())
+    {
+      shard.m_items.splice(shard.m_items.begin(), shard.m_items, it->second);
+      ++m_hits;
+      return it->second->m_road;
+    }
+  }
+
+  ++m_misses;
+  auto road = make_shared<RoadGeometry>();
+  loader(*road);
+  size_t const sizeBytes = GetSizeBytes(*road);
+
+  lock_guard<mutex> guard(shard.m_mutex);
+  // The road may be loaded by another thread meanwhile.
+  auto const it = shard.m_keyToItem.find(key);
+  if (it != shard.m_keyToItem.end())
+    return it->second->m_road;
+
+  shard.m_items.push_front({key, road, sizeBytes});
+  shard.m_keyToItem.emplace(key, shard.m_items.begin());
+  shard.m_sizeBytes += sizeBytes;
+  EvictIfNeeded(shard);
+  return road;
+}
+
+void RoadGeometryCache::SetMemoryBudget(size_t memoryBudgetBytes)
+{
+  m_shardBudgetBytes = memoryBudgetBytes / kShardsNumber;
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> guard(shard.m_mutex);
+    EvictIfNeeded(shard);
+  }
+}
+
+void RoadGeometryCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> guard(shard.m_mutex);
+    shard.m_keyToItem.clear();
+    shard.m_items.clear();
+    shard.m_sizeBytes = 0;
+  }
+}
+
+RoadGeometryCache::Stats RoadGeometryCache::GetStats() const
+{
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  stats.m_evictions = m_evictions;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> guard(shard.m_mutex);
+    stats.m_roadsNumber += shard.m_items.size();
+    stats.m_sizeBytes += shard.m_sizeBytes;
+  }
+  return stats;
+}
+
+RoadGeometryCache::Shard & RoadGeometryCache::GetShard(Key const & key)
+{
+  return m_shards[KeyHash()(key) % kShardsNumber];
+}
+
+void RoadGeometryCache::EvictIfNeeded(Shard & shard)
+{
+  size_t const budget = m_shardBudgetBytes;
+  while (shard.m_sizeBytes > budget && !shard.m_items.empty())
+  {
+    Item const & item = shard.m_items.back();
+    CHECK_GREATER_OR_EQUAL(shard.m_sizeBytes, item.m_sizeBytes, ());
+    shard.m_sizeBytes -= item.m_sizeBytes;
+    shard.m_keyToItem.erase(item.m_key);
+    shard.m_items.pop_back();
+    ++m_evictions;
+  }
+}
+
+string DebugPrint(RoadGeometryCache::Stats const & stats)
+{
+  ostringstream out;
+  out << "RoadGeometryCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", hit rate: " << stats.GetHitRate() << ", evictions: " << stats.m_evictions
+      << ", roads: " << stats.m_roadsNumber << ", size bytes: " << stats.m_sizeBytes << " ]";
+  return out.str();
+}
+}  // namespace routing
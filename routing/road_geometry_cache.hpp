@@ -0,0 +1,134 @@
+#pragma once
+
+#include "routing/vehicle_mask.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace routing
+{
+class RoadGeometry;
+
+/// \brief Process-wide cache of road geometry which is shared by all the routers.
+/// \note Roads are kept by std::shared_ptr so a road returned by GetRoad() stays valid while
+/// the caller keeps the pointer even if the road is evicted from the cache.
+/// \note The cache is thread-safe. To decrease contention it's split into shards with their own
+/// mutexes. Least recently used roads of a shard are evicted when the shard exceeds its part
+/// of the memory budget.
+/// \note Roads are loaded with the vehicle model of the country. So routers which use the cache
+/// with the same |VehicleType| should use the same vehicle models.
+class RoadGeometryCache final
+{
+public:
+  using RoadPtr = std::shared_ptr<RoadGeometry const>;
+  using Loader = std::function<void(RoadGeometry & road)>;
+
+  // Roads of one mwm loaded for the same vehicle type with the same settings.
+  struct MwmKey
+  {
+    MwmKey(MwmSet::MwmId const & mwmId, VehicleType vehicleType, bool loadAltitudes)
+      : m_mwmId(mwmId), m_vehicleType(vehicleType), m_loadAltitudes(loadAltitudes)
+    {
+    }
+
+    bool operator==(MwmKey const & rhs) const
+    {
+      return m_mwmId == rhs.m_mwmId && m_vehicleType == rhs.m_vehicleType &&
+             m_loadAltitudes == rhs.m_loadAltitudes;
+    }
+
+    MwmSet::MwmId m_mwmId;
+    VehicleType m_vehicleType;
+    bool m_loadAltitudes;
+  };
+
+  struct Stats
+  {
+    double GetHitRate() const
+    {
+      auto const requests = m_hits + m_misses;
+      return requests == 0 ? 0.0 : static_cast<double>(m_hits) / requests;
+    }
+
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    size_t m_roadsNumber = 0;
+    size_t m_sizeBytes = 0;
+  };
+
+  static size_t constexpr kDefaultMemoryBudgetBytes = 128 * 1024 * 1024;
+
+  explicit RoadGeometryCache(size_t memoryBudgetBytes = kDefaultMemoryBudgetBytes);
+
+  /// \returns the cache which is shared by all the routers of the process.
+  static RoadGeometryCache & Instance();
+
+  /// \returns road |featureId| of |mwmKey|. If the road is not cached it's loaded with |loader|
+  /// in the calling thread without holding any locks.
+  RoadPtr GetRoad(MwmKey const & mwmKey, uint32_t featureId, Loader const & loader);
+
+  void SetMemoryBudget(size_t memoryBudgetBytes);
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  struct Key
+  {
+    bool operator==(Key const & rhs) const
+    {
+      return m_featureId == rhs.m_featureId && m_mwmKey == rhs.m_mwmKey;
+    }
+
+    MwmKey m_mwmKey;
+    uint32_t m_featureId;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const;
+  };
+
+  struct Item
+  {
+    Key m_key;
+    RoadPtr m_road;
+    size_t m_sizeBytes;
+  };
+
+  struct Shard
+  {
+    mutable std::mutex m_mutex;
+    // The most recently used roads are at the beginning.
+    std::list<Item> m_items;
+    std::unordered_map<Key, std::list<Item>::iterator, KeyHash> m_keyToItem;
+    size_t m_sizeBytes = 0;
+  };
+
+  static size_t constexpr kShardsNumber = 16;
+
+  Shard & GetShard(Key const & key);
+  // Evicts the least recently used roads of |shard| while it's larger than its budget.
+  // |shard| should be locked.
+  void EvictIfNeeded(Shard & shard);
+
+  std::array<Shard, kShardsNumber> m_shards;
+  std::atomic<size_t> m_shardBudgetBytes;
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<uint64_t> m_evictions{0};
+};
+
+std::string DebugPrint(RoadGeometryCache::Stats const & stats);
+}  // namespace routing
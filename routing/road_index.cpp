@@ -4,6 +4,9 @@
 
 namespace routing
 {
+// static
+uint32_t constexpr RoadIndex::kInvalidRoadIdx;
+
 void RoadIndex::Import(vector<Joint> const & joints)
 {
   for (Joint::Id jointId = 0; jointId < joints.size(); ++jointId)
@@ -18,8 +21,50 @@ void RoadIndex::Import(vector<Joint> const & joints)
   }
 }
 
+void RoadIndex::Map(uint32_t numRoads, uint32_t const * featureIds, uint32_t const * offsets,
+                    Joint::Id const * jointIds)
+{
+  CHECK(featureIds, ());
+  CHECK(offsets, ());
+  CHECK(jointIds, ());
+
+  m_roads.clear();
+  m_mappedRoads.clear();
+  m_numMappedRoads = numRoads;
+  m_mappedFeatureIds = featureIds;
+  m_mappedOffsets = offsets;
+  m_mappedJointIds = jointIds;
+}
+
+RoadJointIds const & RoadIndex::GetRoad(uint32_t featureId) const
+{
+  if (IsMapped())
+  {
+    auto const it = m_mappedRoads.find(featureId);
+    if (it != m_mappedRoads.cend())
+      return it->second;
+
+    uint32_t const roadIdx = FindMappedRoad(featureId);
+    CHECK_NOT_EQUAL(roadIdx, kInvalidRoadIdx, ("Feature id:", featureId));
+    return m_mappedRoads.emplace(featureId, GetMappedRoad(roadIdx)).first->second;
+  }
+
+  auto const & it = m_roads.find(featureId);
+  CHECK(it != m_roads.cend(), ("Feature id:", featureId));
+  return it->second;
+}
+
 pair<Joint::Id, uint32_t> RoadIndex::FindNeighbor(RoadPoint const & rp, bool forward) const
 {
+  if (IsMapped())
+  {
+    uint32_t const roadIdx = FindMappedRoad(rp.GetFeatureId());
+    if (roadIdx == kInvalidRoadIdx)
+      MYTHROW(RoutingException, ("RoadIndex doesn't contains feature", rp.GetFeatureId()));
+
+    return GetMappedRoad(roadIdx).FindNeighbor(rp.GetPointId(), forward);
+  }
+
   auto const it = m_roads.find(rp.GetFeatureId());
   if (it == m_roads.cend())
     MYTHROW(RoutingException, ("RoadIndex doesn't contains feature", rp.GetFeatureId()));
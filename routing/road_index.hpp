@@ -2,10 +2,12 @@
 
 #include "routing/joint.hpp"
 
+#include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/cstdint.hpp"
+#include "std/limits.hpp"
 #include "std/unordered_map.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -15,32 +17,44 @@ namespace routing
 class RoadJointIds final
 {
 public:
+  RoadJointIds() = default;
+
+  /// \brief Creates a road which refers to |size| joint ids of a mapped section.
+  /// |jointIds| should be valid while the road is used. Joints can't be added to such road.
+  RoadJointIds(Joint::Id const * jointIds, uint32_t size)
+    : m_mappedJointIds(jointIds), m_mappedSize(size)
+  {
+  }
+
   void Init(uint32_t maxPointId)
   {
+    ASSERT(!IsMapped(), ());
     m_jointIds.clear();
     m_jointIds.reserve(maxPointId + 1);
   }
 
   Joint::Id GetJointId(uint32_t pointId) const
   {
-    if (pointId < m_jointIds.size())
-      return m_jointIds[pointId];
+    if (pointId < GetSize())
+      return GetData()[pointId];
 
     return Joint::kInvalidId;
   }
 
   Joint::Id GetEndingJointId() const
   {
-    if (m_jointIds.empty())
+    uint32_t const size = GetSize();
+    if (size == 0)
       return Joint::kInvalidId;
 
-    ASSERT_NOT_EQUAL(m_jointIds.back(), Joint::kInvalidId, ());
-    return m_jointIds.back();
+    ASSERT_NOT_EQUAL(GetData()[size - 1], Joint::kInvalidId, ());
+    return GetData()[size - 1];
   }
 
   void AddJoint(uint32_t pointId, Joint::Id jointId)
   {
     ASSERT_NOT_EQUAL(jointId, Joint::kInvalidId, ());
+    CHECK(!IsMapped(), ("Joints can't be added to a mapped road."));
 
     if (pointId >= m_jointIds.size())
       m_jointIds.insert(m_jointIds.end(), pointId + 1 - m_jointIds.size(), Joint::kInvalidId);
@@ -53,9 +67,9 @@ public:
   {
     uint32_t count = 0;
 
-    for (Joint::Id const jointId : m_jointIds)
+    for (uint32_t pointId = 0; pointId < GetSize(); ++pointId)
     {
-      if (jointId != Joint::kInvalidId)
+      if (GetData()[pointId] != Joint::kInvalidId)
         ++count;
     }
 
@@ -65,9 +79,10 @@ public:
   template <typename F>
   void ForEachJoint(F && f) const
   {
-    for (uint32_t pointId = 0; pointId < m_jointIds.size(); ++pointId)
+    Joint::Id const * jointIds = GetData();
+    for (uint32_t pointId = 0; pointId < GetSize(); ++pointId)
     {
-      Joint::Id const jointId = m_jointIds[pointId];
+      Joint::Id const jointId = jointIds[pointId];
       if (jointId != Joint::kInvalidId)
         f(pointId, jointId);
     }
@@ -75,14 +90,15 @@ public:
 
   pair<Joint::Id, uint32_t> FindNeighbor(uint32_t pointId, bool forward) const
   {
-    uint32_t const size = static_cast<uint32_t>(m_jointIds.size());
+    Joint::Id const * jointIds = GetData();
+    uint32_t const size = GetSize();
     pair<Joint::Id, uint32_t> result = make_pair(Joint::kInvalidId, 0);
 
     if (forward)
     {
       for (uint32_t i = pointId + 1; i < size; ++i)
       {
-        Joint::Id const jointId = m_jointIds[i];
+        Joint::Id const jointId = jointIds[i];
         if (jointId != Joint::kInvalidId)
         {
           result = {jointId, i};
@@ -94,7 +110,7 @@ public:
     {
       for (uint32_t i = min(pointId, size) - 1; i < size; --i)
       {
-        Joint::Id const jointId = m_jointIds[i];
+        Joint::Id const jointId = jointIds[i];
         if (jointId != Joint::kInvalidId)
         {
           result = {jointId, i};
@@ -106,10 +122,23 @@ public:
     return result;
   }
 
+  /// \returns number of point ids the road has joint ids for: joint ids of points with larger ids
+  /// are Joint::kInvalidId.
+  uint32_t GetSize() const
+  {
+    return IsMapped() ? m_mappedSize : static_cast<uint32_t>(m_jointIds.size());
+  }
+
 private:
+  bool IsMapped() const { return m_mappedJointIds != nullptr; }
+  Joint::Id const * GetData() const { return IsMapped() ? m_mappedJointIds : m_jointIds.data(); }
+
   // Joint ids indexed by point id.
   // If some point id doesn't match any joint id, this vector contains Joint::kInvalidId.
   vector<Joint::Id> m_jointIds;
+  // Joint ids of a mapped road. The same layout as |m_jointIds|.
+  Joint::Id const * m_mappedJointIds = nullptr;
+  uint32_t m_mappedSize = 0;
 };
 
 class RoadIndex final
@@ -117,22 +146,34 @@ class RoadIndex final
 public:
   void Import(vector<Joint> const & joints);
 
+  /// \brief Makes the index refer to roads of a mapped section without copying them.
+  /// The arrays should be valid while the index is used.
+  /// \param featureIds ascending feature ids of |numRoads| roads.
+  /// \param offsets |numRoads| + 1 offsets of the roads joint ids in |jointIds|.
+  /// \param jointIds joint ids of the roads indexed by point ids. See RoadJointIds.
+  void Map(uint32_t numRoads, uint32_t const * featureIds, uint32_t const * offsets,
+           Joint::Id const * jointIds);
+
   void AddJoint(RoadPoint const & rp, Joint::Id jointId)
   {
+    CHECK(!IsMapped(), ());
     m_roads[rp.GetFeatureId()].AddJoint(rp.GetPointId(), jointId);
   }
 
-  bool IsRoad(uint32_t featureId) const { return m_roads.count(featureId) != 0; }
-
-  RoadJointIds const & GetRoad(uint32_t featureId) const
+  bool IsRoad(uint32_t featureId) const
   {
-    auto const & it = m_roads.find(featureId);
-    CHECK(it != m_roads.cend(), ("Feature id:", featureId));
-    return it->second;
+    if (IsMapped())
+      return FindMappedRoad(featureId) != kInvalidRoadIdx;
+
+    return m_roads.count(featureId) != 0;
   }
 
+  /// \note For a mapped index the reference is valid while the index is alive.
+  RoadJointIds const & GetRoad(uint32_t featureId) const;
+
   void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
   {
+    CHECK(!IsMapped(), ());
     m_roads[rp.GetFeatureId()].AddJoint(rp.GetPointId(), jointId);
   }
 
@@ -143,10 +184,22 @@ public:
   // If there is no nearest point, return {Joint::kInvalidId, 0}
   pair<Joint::Id, uint32_t> FindNeighbor(RoadPoint const & rp, bool forward) const;
 
-  uint32_t GetSize() const { return base::asserted_cast<uint32_t>(m_roads.size()); }
+  uint32_t GetSize() const
+  {
+    return IsMapped() ? m_numMappedRoads : base::asserted_cast<uint32_t>(m_roads.size());
+  }
 
   Joint::Id GetJointId(RoadPoint const & rp) const
   {
+    if (IsMapped())
+    {
+      uint32_t const roadIdx = FindMappedRoad(rp.GetFeatureId());
+      if (roadIdx == kInvalidRoadIdx)
+        return Joint::kInvalidId;
+
+      return GetMappedRoad(roadIdx).GetJointId(rp.GetPointId());
+    }
+
     auto const it = m_roads.find(rp.GetFeatureId());
     if (it == m_roads.end())
       return Joint::kInvalidId;
@@ -157,12 +210,48 @@ public:
   template <typename F>
   void ForEachRoad(F && f) const
   {
+    if (IsMapped())
+    {
+      for (uint32_t roadIdx = 0; roadIdx < m_numMappedRoads; ++roadIdx)
+        f(m_mappedFeatureIds[roadIdx], GetMappedRoad(roadIdx));
+      return;
+    }
+
     for (auto const & it : m_roads)
       f(it.first, it.second);
   }
 
 private:
+  static uint32_t constexpr kInvalidRoadIdx = numeric_limits<uint32_t>::max();
+
+  bool IsMapped() const { return m_mappedFeatureIds != nullptr; }
+
+  // \returns index of road |featureId| in the mapped arrays or kInvalidRoadIdx.
+  uint32_t FindMappedRoad(uint32_t featureId) const
+  {
+    uint32_t const * const end = m_mappedFeatureIds + m_numMappedRoads;
+    uint32_t const * const it = lower_bound(m_mappedFeatureIds, end, featureId);
+    if (it == end || *it != featureId)
+      return kInvalidRoadIdx;
+
+    return static_cast<uint32_t>(it - m_mappedFeatureIds);
+  }
+
+  RoadJointIds GetMappedRoad(uint32_t roadIdx) const
+  {
+    uint32_t const begin = m_mappedOffsets[roadIdx];
+    return RoadJointIds(m_mappedJointIds + begin, m_mappedOffsets[roadIdx + 1] - begin);
+  }
+
   // Map from feature id to RoadJointIds.
   unordered_map<uint32_t, RoadJointIds> m_roads;
+
+  uint32_t m_numMappedRoads = 0;
+  uint32_t const * m_mappedFeatureIds = nullptr;
+  uint32_t const * m_mappedOffsets = nullptr;
+  Joint::Id const * m_mappedJointIds = nullptr;
+  // Roads of the mapped section which were requested by GetRoad(). RoadJointIds refer to the
+  // section so only a pointer and a size are kept for every road.
+  mutable unordered_map<uint32_t, RoadJointIds> m_mappedRoads;
 };
 }  // namespace routing
@@ -0,0 +1,163 @@
+#include "routing/road_snapping_index.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+template <typename T>
+T ReadFromData(vector<uint8_t> const & data, size_t pos)
+{
+  T value;
+  memcpy(&value, data.data() + pos, sizeof(value));
+  return SwapIfBigEndianMacroBased(value);
+}
+}  // namespace
+
+namespace routing
+{
+// static
+double constexpr RoadSnappingIndex::kCellSize;
+// static
+uint32_t constexpr RoadSnappingIndex::kVersion;
+
+// static
+void RoadSnappingIndex::Serialize(vector<Road> const & roads, Writer & writer)
+{
+  // Entries of every cell. A road has one entry in a cell even if several segments cross it.
+  map<uint64_t, vector<pair<uint32_t, VehicleMask>>> cells;
+  auto const addCells = [&cells](Road const & road, m2::PointD const & p1, m2::PointD const & p2) {
+    uint32_t const maxX = ToCellCoord(max(p1.x, p2.x));
+    uint32_t const maxY = ToCellCoord(max(p1.y, p2.y));
+    for (uint32_t x = ToCellCoord(min(p1.x, p2.x)); x <= maxX; ++x)
+    {
+      for (uint32_t y = ToCellCoord(min(p1.y, p2.y)); y <= maxY; ++y)
+      {
+        auto & entries = cells[GetCellKey(x, y)];
+        if (!entries.empty() && entries.back().first == road.m_featureId)
+          entries.back().second |= road.m_mask;
+        else
+          entries.emplace_back(road.m_featureId, road.m_mask);
+      }
+    }
+  };
+
+  for (size_t i = 0; i < roads.size(); ++i)
+  {
+    auto const & road = roads[i];
+    CHECK(i == 0 || roads[i - 1].m_featureId < road.m_featureId, ());
+    CHECK_LESS(road.m_mask, 1 << 8, ());
+    auto const & points = road.m_points;
+    if (points.size() == 1)
+      addCells(road, points[0], points[0]);
+
+    // A segment is split into parts not longer than a cell, so the bounding rects of the parts
+    // cover only the cells near the segment.
+    for (size_t j = 1; j < points.size(); ++j)
+    {
+      auto const & p1 = points[j - 1];
+      auto const & p2 = points[j];
+      size_t const parts = max(static_cast<size_t>(ceil(p1.Length(p2) / kCellSize)), size_t(1));
+      for (size_t k = 0; k < parts; ++k)
+      {
+        addCells(road, p1 + (p2 - p1) * (static_cast<double>(k) / parts),
+                 k + 1 == parts ? p2 : p1 + (p2 - p1) * (static_cast<double>(k + 1) / parts));
+      }
+    }
+  }
+
+  vector<uint8_t> entries;
+  vector<uint32_t> offsets;
+  offsets.reserve(cells.size() + 1);
+  {
+    PushBackByteSink<vector<uint8_t>> sink(entries);
+    for (auto const & cell : cells)
+    {
+      offsets.push_back(base::checked_cast<uint32_t>(entries.size()));
+      uint32_t prevFeatureId = 0;
+      for (auto const & entry : cell.second)
+      {
+        WriteVarUint(sink, entry.first - prevFeatureId);
+        WriteToSink(sink, static_cast<uint8_t>(entry.second));
+        prevFeatureId = entry.first;
+      }
+    }
+    offsets.push_back(base::checked_cast<uint32_t>(entries.size()));
+  }
+
+  WriteToSink(writer, kVersion);
+  WriteToSink(writer, base::checked_cast<uint32_t>(cells.size()));
+  for (auto const & cell : cells)
+    WriteToSink(writer, cell.first);
+  for (auto const offset : offsets)
+    WriteToSink(writer, offset);
+  writer.Write(entries.data(), entries.size());
+}
+
+bool RoadSnappingIndex::Init(vector<uint8_t> && data)
+{
+  m_keys.clear();
+  m_offsets.clear();
+  m_data.clear();
+
+  size_t constexpr kHeaderSize = 2 * sizeof(uint32_t);
+  if (data.size() < kHeaderSize)
+    return false;
+
+  auto const version = ReadFromData<uint32_t>(data, 0 /* pos */);
+  if (version != kVersion)
+  {
+    LOG(LWARNING, ("Unknown version of road snapping index:", version));
+    return false;
+  }
+
+  size_t const numCells = ReadFromData<uint32_t>(data, sizeof(uint32_t));
+  size_t const entriesPos =
+      kHeaderSize + numCells * sizeof(uint64_t) + (numCells + 1) * sizeof(uint32_t);
+  if (data.size() < entriesPos)
+    return false;
+
+  m_keys.resize(numCells);
+  for (size_t i = 0; i < numCells; ++i)
+    m_keys[i] = ReadFromData<uint64_t>(data, kHeaderSize + i * sizeof(uint64_t));
+
+  m_offsets.resize(numCells + 1);
+  size_t const offsetsPos = kHeaderSize + numCells * sizeof(uint64_t);
+  for (size_t i = 0; i <= numCells; ++i)
+  {
+    // Offsets are stored relative to the entries and are kept relative to |m_data|.
+    auto const offset = ReadFromData<uint32_t>(data, offsetsPos + i * sizeof(uint32_t));
+    m_offsets[i] = base::checked_cast<uint32_t>(entriesPos + offset);
+    if (m_offsets[i] > data.size() || (i != 0 && m_offsets[i] < m_offsets[i - 1]))
+    {
+      m_keys.clear();
+      m_offsets.clear();
+      return false;
+    }
+  }
+
+  m_data = move(data);
+  return true;
+}
+
+// static
+uint32_t RoadSnappingIndex::ToCellCoord(double coord)
+{
+  double const cell = floor((coord - MercatorBounds::minX) / kCellSize);
+  return cell <= 0.0 ? 0 : static_cast<uint32_t>(cell);
+}
+}  // namespace routing
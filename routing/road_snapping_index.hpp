@@ -0,0 +1,97 @@
+#pragma once
+
+#include "routing/vehicle_mask.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Writer;
+
+namespace routing
+{
+/// \brief Grid of road features which is used to snap points to roads without reading of all
+/// the features around the points.
+/// \note The section is used in place, the format is:
+///   [u32: version] [u32: number of cells]
+///   [u64 * number of cells: sorted keys of non-empty cells]
+///   [u32 * (number of cells + 1): offsets of cells entries from the beginning of entries]
+///   [entries]
+/// Every road feature has an entry in all the cells its segments cross. Entries of a cell are
+/// sorted by feature ids:
+///   [vu: difference with the previous feature id of the cell] [u8: vehicle mask]
+class RoadSnappingIndex final
+{
+public:
+  struct Road
+  {
+    uint32_t m_featureId = 0;
+    VehicleMask m_mask = 0;
+    std::vector<m2::PointD> m_points;
+  };
+
+  // Side of a cell in mercator, about 200 meters on the equator.
+  static double constexpr kCellSize = 0.002;
+
+  /// \note |roads| should be sorted by feature ids.
+  static void Serialize(std::vector<Road> const & roads, Writer & writer);
+
+  /// \brief Initializes the index from the section |data|, only cells keys and offsets are
+  /// decoded. Returns false if the section has an unknown version or is damaged.
+  bool Init(std::vector<uint8_t> && data);
+
+  bool IsEmpty() const { return m_keys.empty(); }
+
+  /// \brief Calls |fn(featureId)| for features which are roads for a vehicle of |mask| and may
+  /// cross |rect|. The same feature may be passed several times.
+  template <typename Fn>
+  void ForEachFeature(m2::RectD const & rect, VehicleMask mask, Fn && fn) const
+  {
+    if (IsEmpty())
+      return;
+
+    uint32_t const maxX = ToCellCoord(rect.maxX());
+    uint32_t const maxY = ToCellCoord(rect.maxY());
+    for (uint32_t x = ToCellCoord(rect.minX()); x <= maxX; ++x)
+    {
+      auto it = std::lower_bound(m_keys.cbegin(), m_keys.cend(),
+                                 GetCellKey(x, ToCellCoord(rect.minY())));
+      for (; it != m_keys.cend() && *it <= GetCellKey(x, maxY); ++it)
+      {
+        size_t const cell = static_cast<size_t>(std::distance(m_keys.cbegin(), it));
+        uint8_t const * const end = m_data.data() + m_offsets[cell + 1];
+        ArrayByteSource src(m_data.data() + m_offsets[cell]);
+        uint32_t featureId = 0;
+        while (src.PtrUC() < end)
+        {
+          featureId += ReadVarUint<uint32_t>(src);
+          if ((ReadPrimitiveFromSource<uint8_t>(src) & mask) != 0)
+            fn(featureId);
+        }
+      }
+    }
+  }
+
+  static uint32_t ToCellCoord(double coord);
+  static uint64_t GetCellKey(uint32_t x, uint32_t y)
+  {
+    return (static_cast<uint64_t>(x) << 32) | y;
+  }
+
+private:
+  static uint32_t constexpr kVersion = 0;
+
+  std::vector<uint64_t> m_keys;
+  // Offsets of cells entries in |m_data|.
+  std::vector<uint32_t> m_offsets;
+  std::vector<uint8_t> m_data;
+};
+}  // namespace routing
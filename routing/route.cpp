@@ -368,6 +368,29 @@ double Route::GetSegLenMeters(size_t segIdx) const
          (segIdx == 0 ? 0.0 : m_routeSegments[segIdx - 1].GetDistFromBeginningMeters());
 }
 
+void Route::GetSpeedCamerasOnRoute(vector<SpeedCameraOnRoute> & cameras) const
+{
+  cameras.clear();
+  for (size_t i = 0; i < m_routeSegments.size(); ++i)
+  {
+    auto const & speedCams = m_routeSegments[i].GetSpeedCams();
+    if (speedCams.empty())
+      continue;
+
+    double const segStartMeters =
+        i == 0 ? 0.0 : m_routeSegments[i - 1].GetDistFromBeginningMeters();
+    double const segLenMeters = GetSegLenMeters(i);
+    bool const isForward = m_routeSegments[i].GetSegment().IsForward();
+    // |m_coef| is a position from the beginning of the segment in the feature direction and
+    // |speedCams| are already ordered along the movement.
+    for (auto const & speedCam : speedCams)
+    {
+      double const coef = isForward ? speedCam.m_coef : 1.0 - speedCam.m_coef;
+      cameras.emplace_back(segStartMeters + segLenMeters * coef, speedCam.m_maxSpeedKmPH);
+    }
+  }
+}
+
 double Route::GetETAToLastPassedPointSec() const
 {
   CHECK(IsValid(), ());
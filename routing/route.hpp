@@ -3,6 +3,7 @@
 #include "routing/road_graph.hpp"
 #include "routing/routing_settings.hpp"
 #include "routing/segment.hpp"
+#include "routing/speed_camera.hpp"
 #include "routing/transit_info.hpp"
 #include "routing/turns.hpp"
 
@@ -372,6 +373,10 @@ public:
   /// \returns Length of the route segment with |segIdx| in meters.
   double GetSegLenMeters(size_t segIdx) const;
 
+  /// \brief Fills |cameras| with all the speed cameras of the route sorted by distance from
+  /// the beginning of the route.
+  void GetSpeedCamerasOnRoute(std::vector<SpeedCameraOnRoute> & cameras) const;
+
 private:
   friend std::string DebugPrint(Route const & r);
 
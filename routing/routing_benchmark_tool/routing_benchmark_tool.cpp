@@ -0,0 +1,418 @@
+#include "routing/index_router.hpp"
+#include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_callbacks.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "storage/country_info_getter.hpp"
+#include "storage/country_parent_getter.hpp"
+#include "storage/routing_helpers.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "geometry/latlon.hpp"
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+#include "base/math.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include "std/target_os.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "3party/gflags/src/gflags/gflags.h"
+#include "3party/jansson/myjansson.hpp"
+
+DEFINE_string(routes, "", "File with origin/destination pairs. Every line contains latitude and "
+                          "longitude of an origin and a destination separated by comma: "
+                          "lat,lon;lat,lon.");
+DEFINE_string(vehicle_types, "Car,Bicycle,Pedestrian",
+              "Comma separated vehicle types the routes are calculated for.");
+DEFINE_string(output, "", "Json file with timings of every route and summary by vehicle types. "
+                          "The json is written to stdout if the flag is empty.");
+DEFINE_string(data_path, "", "Data path with mwms and resources.");
+DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
+
+DEFINE_uint64(generate, 0, "Generate a file |routes| with the number of random origin/destination "
+                           "pairs inside registered mwms instead of benchmarking.");
+DEFINE_uint64(seed, 0, "Seed of random generator. The same seed and mwm set give the same routes.");
+DEFINE_double(max_distance_km, 100.0, "Max distance between generated origin and destination.");
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+struct RoutePoints
+{
+  ms::LatLon m_start;
+  ms::LatLon m_finish;
+};
+
+struct RouteRecord
+{
+  RouteRecord(VehicleType vehicleType, RoutePoints const & points)
+    : m_vehicleType(vehicleType), m_points(points)
+  {
+  }
+
+  VehicleType m_vehicleType;
+  RoutePoints m_points;
+  RouterResultCode m_code = RouterResultCode::InternalError;
+  double m_distanceM = 0.0;
+  double m_etaSec = 0.0;
+  double m_totalSec = 0.0;
+  IndexRouter::Statistics m_statistics;
+  uint64_t m_peakMemoryKb = 0;
+};
+
+// Peak resident set size of the process. It's monotonic so a value of a route is the peak
+// of the benchmark till the route is calculated.
+uint64_t GetPeakMemoryKb()
+{
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(OMIM_OS_MAC)
+  // ru_maxrss is in bytes on Mac and in kilobytes on Linux.
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+}
+
+bool ParseLatLon(string const & s, ms::LatLon & latLon)
+{
+  auto const coords = strings::Tokenize(s, ",");
+  if (coords.size() != 2)
+    return false;
+
+  return strings::to_double(coords[0], latLon.lat) && strings::to_double(coords[1], latLon.lon) &&
+         MercatorBounds::ValidLat(latLon.lat) && MercatorBounds::ValidLon(latLon.lon);
+}
+
+vector<RoutePoints> LoadRoutes(string const & fileName)
+{
+  ifstream input(fileName);
+  CHECK(input.is_open(), ("Can't open", fileName));
+
+  vector<RoutePoints> routes;
+  string line;
+  for (size_t lineNumber = 1; getline(input, line); ++lineNumber)
+  {
+    strings::Trim(line);
+    if (line.empty())
+      continue;
+
+    auto const points = strings::Tokenize(line, ";");
+    RoutePoints route;
+    CHECK(points.size() == 2 && ParseLatLon(points[0], route.m_start) &&
+              ParseLatLon(points[1], route.m_finish),
+          ("Wrong route at line", lineNumber, "of", fileName, ":", line));
+    routes.push_back(route);
+  }
+  return routes;
+}
+
+vector<VehicleType> ParseVehicleTypes(string const & s)
+{
+  vector<VehicleType> vehicleTypes;
+  for (auto const & token : strings::Tokenize(s, ","))
+  {
+    VehicleType vehicleType = VehicleType::Count;
+    FromString(token, vehicleType);
+    CHECK_NOT_EQUAL(vehicleType, VehicleType::Count, ("Wrong vehicle type", token));
+    vehicleTypes.push_back(vehicleType);
+  }
+  return vehicleTypes;
+}
+
+class Benchmark final
+{
+public:
+  Benchmark()
+  {
+    CHECK(m_cig, ());
+    CHECK(m_cpg, ());
+
+    classificator::Load();
+    vector<platform::LocalCountryFile> localFiles;
+    platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max(), localFiles);
+
+    for (auto const & localFile : localFiles)
+    {
+      UNUSED_VALUE(m_dataSource.RegisterMap(localFile));
+      auto const & countryFile = localFile.GetCountryFile();
+      auto const mwmId = m_dataSource.GetMwmIdByCountryFile(countryFile);
+      CHECK(mwmId.IsAlive(), ());
+      // We have to exclude minsk-pass because we can't register mwm which is not from
+      // countries.txt.
+      if (mwmId.GetInfo()->GetType() == MwmInfo::COUNTRY && countryFile.GetName() != "minsk-pass")
+      {
+        m_numMwmIds->RegisterFile(countryFile);
+        m_countries.push_back(countryFile.GetName());
+      }
+    }
+    CHECK(!m_countries.empty(), ("There're no mwms in", GetPlatform().WritableDir()));
+  }
+
+  // Generates |number| routes with origins inside rects of random registered mwms.
+  // Destinations are not further than |maxDistanceM| from origins.
+  vector<RoutePoints> GenerateRoutes(uint64_t number, uint64_t seed, double maxDistanceM) const
+  {
+    mt19937_64 generator(seed);
+    uniform_int_distribution<size_t> countryDistribution(0, m_countries.size() - 1);
+    uniform_real_distribution<double> unitDistribution(0.0, 1.0);
+
+    vector<RoutePoints> routes;
+    routes.reserve(number);
+    while (routes.size() < number)
+    {
+      m2::RectD const rect = m_cig->GetLimitRectForLeaf(m_countries[countryDistribution(generator)]);
+      m2::PointD const start(rect.minX() + unitDistribution(generator) * rect.SizeX(),
+                             rect.minY() + unitDistribution(generator) * rect.SizeY());
+      double const distanceM = unitDistribution(generator) * maxDistanceM;
+      double const angle = unitDistribution(generator) * 2.0 * math::pi;
+      m2::PointD const finish =
+          MercatorBounds::GetSmPoint(start, cos(angle) * distanceM, sin(angle) * distanceM);
+
+      // Routes between points outside mwms make no sense.
+      if (m_cig->GetRegionCountryId(start).empty() || m_cig->GetRegionCountryId(finish).empty())
+        continue;
+
+      routes.push_back({MercatorBounds::ToLatLon(start), MercatorBounds::ToLatLon(finish)});
+    }
+    return routes;
+  }
+
+  void Run(VehicleType vehicleType, vector<RoutePoints> const & routes,
+           vector<RouteRecord> & records)
+  {
+    auto & router = GetRouter(vehicleType);
+    for (size_t i = 0; i < routes.size(); ++i)
+    {
+      RouteRecord record(vehicleType, routes[i]);
+      Route route("" /* router */, 0 /* routeId */);
+      Checkpoints const checkpoints(MercatorBounds::FromLatLon(routes[i].m_start),
+                                    MercatorBounds::FromLatLon(routes[i].m_finish));
+
+      base::Timer timer;
+      record.m_code = router.CalculateRoute(checkpoints, m2::PointD::Zero() /* startDirection */,
+                                            false /* adjustToPrevRoute */, m_delegate, route);
+      record.m_totalSec = timer.ElapsedSeconds();
+      record.m_statistics = router.GetLastStatistics();
+      record.m_peakMemoryKb = GetPeakMemoryKb();
+      if (record.m_code == RouterResultCode::NoError)
+      {
+        record.m_distanceM = route.GetTotalDistanceMeters();
+        record.m_etaSec = route.GetTotalTimeSec();
+      }
+      records.push_back(record);
+
+      if ((i + 1) % 100 == 0)
+        LOG(LINFO, (vehicleType, "routes calculated:", i + 1, "of", routes.size()));
+    }
+  }
+
+private:
+  IndexRouter & GetRouter(VehicleType vehicleType)
+  {
+    auto & router = m_routers[static_cast<size_t>(vehicleType)];
+    if (router)
+      return *router;
+
+    auto const & infoGetter = *m_cig;
+    auto const countryFileGetter = [&infoGetter](m2::PointD const & pt) {
+      return infoGetter.GetRegionCountryId(pt);
+    };
+    auto const getMwmRectByName = [&infoGetter](string const & countryId) {
+      return infoGetter.GetLimitRectForLeaf(countryId);
+    };
+
+    router = make_unique<IndexRouter>(vehicleType, false /* load altitudes */, *m_cpg,
+                                      countryFileGetter, getMwmRectByName, m_numMwmIds,
+                                      MakeNumMwmTree(*m_numMwmIds, infoGetter), m_trafficCache,
+                                      m_dataSource);
+    return *router;
+  }
+
+  DISALLOW_COPY_AND_MOVE(Benchmark);
+
+  FrozenDataSource m_dataSource;
+  shared_ptr<NumMwmIds> m_numMwmIds = make_shared<NumMwmIds>();
+  vector<string> m_countries;
+  unique_ptr<IndexRouter> m_routers[static_cast<size_t>(VehicleType::Count)];
+  unique_ptr<storage::CountryParentGetter> m_cpg = make_unique<storage::CountryParentGetter>();
+  unique_ptr<storage::CountryInfoGetter> m_cig =
+      storage::CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  traffic::TrafficCache m_trafficCache;
+  RouterDelegate m_delegate;
+};
+
+void SaveRoutes(vector<RoutePoints> const & routes, string const & fileName)
+{
+  ofstream output(fileName);
+  CHECK(output.is_open(), ("Can't open", fileName));
+  output.precision(8);
+  for (auto const & route : routes)
+  {
+    output << route.m_start.lat << "," << route.m_start.lon << ";" << route.m_finish.lat << ","
+           << route.m_finish.lon << "\n";
+  }
+}
+
+void StatisticsToJSON(IndexRouter::Statistics const & statistics, json_t & root)
+{
+  ToJSONObject(root, "nearest_edges_sec", statistics.m_nearestEdgesSec);
+  ToJSONObject(root, "astar_sec", statistics.m_astarSec);
+  ToJSONObject(root, "leaps_sec", statistics.m_leapsSec);
+  ToJSONObject(root, "directions_sec", statistics.m_directionsSec);
+  ToJSONObject(root, "turns_sec", statistics.m_turnsSec);
+  ToJSONObject(root, "settled_vertices", statistics.m_settledVertices);
+}
+
+base::JSONPtr RouteRecordToJSON(RouteRecord const & record)
+{
+  auto json = base::NewJSONObject();
+  ToJSONObject(*json, "vehicle_type", ToString(record.m_vehicleType).c_str());
+  ToJSONObject(*json, "start", vector<double>{record.m_points.m_start.lat,
+                                              record.m_points.m_start.lon});
+  ToJSONObject(*json, "finish", vector<double>{record.m_points.m_finish.lat,
+                                               record.m_points.m_finish.lon});
+  ToJSONObject(*json, "code", DebugPrint(record.m_code).c_str());
+  ToJSONObject(*json, "distance_m", record.m_distanceM);
+  ToJSONObject(*json, "eta_sec", record.m_etaSec);
+  ToJSONObject(*json, "total_sec", record.m_totalSec);
+  StatisticsToJSON(record.m_statistics, *json);
+  ToJSONObject(*json, "peak_memory_kb", record.m_peakMemoryKb);
+  return json;
+}
+
+// Sums of the phases of successfully calculated routes of a vehicle type.
+base::JSONPtr MakeSummary(VehicleType vehicleType, vector<RouteRecord> const & records)
+{
+  uint64_t routesNumber = 0;
+  uint64_t errorsNumber = 0;
+  double totalSec = 0.0;
+  IndexRouter::Statistics sum;
+  uint64_t peakMemoryKb = 0;
+  for (auto const & record : records)
+  {
+    if (record.m_vehicleType != vehicleType)
+      continue;
+
+    ++routesNumber;
+    peakMemoryKb = max(peakMemoryKb, record.m_peakMemoryKb);
+    if (record.m_code != RouterResultCode::NoError)
+    {
+      ++errorsNumber;
+      continue;
+    }
+
+    totalSec += record.m_totalSec;
+    sum.m_nearestEdgesSec += record.m_statistics.m_nearestEdgesSec;
+    sum.m_astarSec += record.m_statistics.m_astarSec;
+    sum.m_leapsSec += record.m_statistics.m_leapsSec;
+    sum.m_directionsSec += record.m_statistics.m_directionsSec;
+    sum.m_turnsSec += record.m_statistics.m_turnsSec;
+    sum.m_settledVertices += record.m_statistics.m_settledVertices;
+  }
+
+  auto json = base::NewJSONObject();
+  ToJSONObject(*json, "vehicle_type", ToString(vehicleType).c_str());
+  ToJSONObject(*json, "routes", routesNumber);
+  ToJSONObject(*json, "errors", errorsNumber);
+  ToJSONObject(*json, "total_sec", totalSec);
+  StatisticsToJSON(sum, *json);
+  ToJSONObject(*json, "peak_memory_kb", peakMemoryKb);
+  return json;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Calculates routes of a corpus for every vehicle type and saves "
+                          "timings of route calculation phases to json. "
+                          "Use -generate to make a reproducible corpus for the mwm set.");
+  google::ParseCommandLineFlags(&argc, &argv, true /* remove_flags */);
+
+  CHECK(!FLAGS_routes.empty(), ("-routes should be set."));
+
+  Platform & platform = GetPlatform();
+  if (!FLAGS_data_path.empty())
+    platform.SetWritableDirForTests(FLAGS_data_path);
+  if (!FLAGS_user_resource_path.empty())
+    platform.SetResourceDir(FLAGS_user_resource_path);
+
+  Benchmark benchmark;
+  if (FLAGS_generate != 0)
+  {
+    SaveRoutes(benchmark.GenerateRoutes(FLAGS_generate, FLAGS_seed, FLAGS_max_distance_km * 1000.0),
+               FLAGS_routes);
+    LOG(LINFO, ("Routes are saved to", FLAGS_routes));
+    return 0;
+  }
+
+  vector<RoutePoints> const routes = LoadRoutes(FLAGS_routes);
+  vector<VehicleType> const vehicleTypes = ParseVehicleTypes(FLAGS_vehicle_types);
+
+  vector<RouteRecord> records;
+  records.reserve(routes.size() * vehicleTypes.size());
+  for (auto const vehicleType : vehicleTypes)
+    benchmark.Run(vehicleType, routes, records);
+
+  auto json = base::NewJSONObject();
+  auto jsonRoutes = base::NewJSONArray();
+  for (auto const & record : records)
+  {
+    auto jsonRecord = RouteRecordToJSON(record);
+    ToJSONArray(*jsonRoutes, jsonRecord);
+  }
+  ToJSONObject(*json, "routes", jsonRoutes);
+
+  auto summary = base::NewJSONArray();
+  for (auto const vehicleType : vehicleTypes)
+  {
+    auto jsonSummary = MakeSummary(vehicleType, records);
+    ToJSONArray(*summary, jsonSummary);
+  }
+  ToJSONObject(*json, "summary", summary);
+
+  unique_ptr<char, JSONFreeDeleter> buffer(json_dumps(json.get(), JSON_INDENT(2)));
+  if (FLAGS_output.empty())
+  {
+    cout << buffer.get() << endl;
+  }
+  else
+  {
+    ofstream output(FLAGS_output);
+    CHECK(output.is_open(), ("Can't open", FLAGS_output));
+    output << buffer.get() << "\n";
+  }
+  return 0;
+}
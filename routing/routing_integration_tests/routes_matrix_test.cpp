@@ -0,0 +1,74 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_integration_tests/routing_test_tools.hpp"
+
+#include "routing/index_router.hpp"
+#include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_callbacks.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+double constexpr kMaxWeightSec = 60 * 60;
+
+UNIT_TEST(RoutesMatrix_MoscowCarRoutesAreEqualToSingleRoutes)
+{
+  auto & components = integration::GetVehicleComponents<VehicleType::Car>();
+  auto & router = dynamic_cast<IndexRouter &>(components.GetRouter());
+
+  vector<m2::PointD> const origins = {MercatorBounds::FromLatLon(55.75100, 37.61790),
+                                      MercatorBounds::FromLatLon(55.66216, 37.63259)};
+  vector<m2::PointD> const destinations = {MercatorBounds::FromLatLon(55.66237, 37.63560),
+                                           MercatorBounds::FromLatLon(55.79060, 37.53170),
+                                           MercatorBounds::FromLatLon(55.75100, 37.61790)};
+
+  RouterDelegate delegate;
+  IndexRouter::RoutesMatrix matrix;
+  TEST_EQUAL(router.CalculateRoutesMatrix(origins, destinations, kMaxWeightSec, delegate, matrix),
+             RouterResultCode::NoError, ());
+  TEST_EQUAL(matrix.size(), origins.size(), ());
+
+  for (size_t i = 0; i < origins.size(); ++i)
+  {
+    TEST_EQUAL(matrix[i].size(), destinations.size(), ());
+    for (size_t j = 0; j < destinations.size(); ++j)
+    {
+      auto const & item = matrix[i][j];
+      TEST_EQUAL(item.m_code, RouterResultCode::NoError, (i, j));
+
+      auto const routeResult =
+          integration::CalculateRoute(components, origins[i], {0.0, 0.0}, destinations[j]);
+      TEST_EQUAL(routeResult.second, RouterResultCode::NoError, (i, j));
+      integration::TestRouteLength(*routeResult.first, item.m_distanceM);
+      integration::TestRouteTime(*routeResult.first, item.m_etaSec);
+    }
+  }
+}
+
+UNIT_TEST(RoutesMatrix_MaxWeight)
+{
+  auto & router =
+      dynamic_cast<IndexRouter &>(integration::GetVehicleComponents<VehicleType::Car>().GetRouter());
+
+  vector<m2::PointD> const origins = {MercatorBounds::FromLatLon(55.75100, 37.61790)};
+  vector<m2::PointD> const destinations = {MercatorBounds::FromLatLon(55.75310, 37.62220),
+                                           MercatorBounds::FromLatLon(55.97310, 37.41460)};
+
+  RouterDelegate delegate;
+  IndexRouter::RoutesMatrix matrix;
+  TEST_EQUAL(router.CalculateRoutesMatrix(origins, destinations, 10 * 60 /* maxWeightSec */,
+                                          delegate, matrix),
+             RouterResultCode::NoError, ());
+  TEST_EQUAL(matrix[0][0].m_code, RouterResultCode::NoError, ());
+  TEST_LESS_OR_EQUAL(matrix[0][0].m_weight, 10 * 60, ());
+  // The airport is further than 10 minutes from the centre of Moscow.
+  TEST_EQUAL(matrix[0][1].m_code, RouterResultCode::RouteNotFound, ());
+}
+}  // namespace
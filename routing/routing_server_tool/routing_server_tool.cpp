@@ -0,0 +1,381 @@
+#include "routing/checkpoints.hpp"
+#include "routing/index_router.hpp"
+#include "routing/road_geometry_cache.hpp"
+#include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_callbacks.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "storage/country_info_getter.hpp"
+#include "storage/country_parent_getter.hpp"
+#include "storage/routing_helpers.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "geometry/latlon.hpp"
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+#include "base/string_utils.hpp"
+#include "base/thread.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "3party/gflags/src/gflags/gflags.h"
+#include "3party/jansson/myjansson.hpp"
+
+DEFINE_string(requests, "", "File with route requests. Requests are read from stdin when the flag "
+                            "is empty, so the tool may serve requests of another process. "
+                            "Every line is a request: a vehicle type and two or more waypoints "
+                            "separated by semicolon: Car;lat,lon;lat,lon.");
+DEFINE_string(output, "", "File for responses, one json per line in the order of completion. "
+                          "Responses are written to stdout when the flag is empty.");
+DEFINE_string(summary, "", "Json file with the throughput summary. The summary is logged anyway.");
+DEFINE_uint64(threads, 0, "Number of router workers. Zero means the number of cores.");
+DEFINE_uint64(geometry_cache_mb, 0, "Memory budget of road geometry shared by the workers. "
+                                    "Zero means the default budget.");
+DEFINE_string(data_path, "", "Data path with mwms and resources.");
+DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+struct Request
+{
+  uint64_t m_id = 0;
+  VehicleType m_vehicleType = VehicleType::Count;
+  vector<m2::PointD> m_points;
+};
+
+struct Response
+{
+  RouterResultCode m_code = RouterResultCode::InternalError;
+  double m_distanceM = 0.0;
+  double m_etaSec = 0.0;
+  double m_totalSec = 0.0;
+};
+
+// Returns false if |line| is not a valid request.
+bool ParseRequest(string const & line, Request & request)
+{
+  auto const tokens = strings::Tokenize(line, ";");
+  if (tokens.size() < 3)
+    return false;
+
+  request.m_vehicleType = VehicleType::Count;
+  FromString(tokens[0], request.m_vehicleType);
+  if (request.m_vehicleType == VehicleType::Count)
+    return false;
+
+  request.m_points.clear();
+  for (size_t i = 1; i < tokens.size(); ++i)
+  {
+    auto const coords = strings::Tokenize(tokens[i], ",");
+    ms::LatLon latLon;
+    if (coords.size() != 2 || !strings::to_double(coords[0], latLon.lat) ||
+        !strings::to_double(coords[1], latLon.lon) || !MercatorBounds::ValidLat(latLon.lat) ||
+        !MercatorBounds::ValidLon(latLon.lon))
+    {
+      return false;
+    }
+    request.m_points.push_back(MercatorBounds::FromLatLon(latLon));
+  }
+  return true;
+}
+
+// Data which is shared by all the workers. Mwms are registered once and road geometry is
+// kept in the process-wide RoadGeometryCache, so workers don't load their own copies of roads.
+// Index graphs are still built by every worker from the mapped routing sections.
+class GraphStore final
+{
+public:
+  GraphStore()
+  {
+    CHECK(m_cig, ());
+
+    classificator::Load();
+    vector<platform::LocalCountryFile> localFiles;
+    platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max(), localFiles);
+
+    for (auto const & localFile : localFiles)
+    {
+      UNUSED_VALUE(m_dataSource.RegisterMap(localFile));
+      auto const & countryFile = localFile.GetCountryFile();
+      auto const mwmId = m_dataSource.GetMwmIdByCountryFile(countryFile);
+      CHECK(mwmId.IsAlive(), ());
+      // We have to exclude minsk-pass because we can't register mwm which is not from
+      // countries.txt.
+      if (mwmId.GetInfo()->GetType() == MwmInfo::COUNTRY && countryFile.GetName() != "minsk-pass")
+        m_numMwmIds->RegisterFile(countryFile);
+    }
+  }
+
+  unique_ptr<IndexRouter> CreateRouter(VehicleType vehicleType)
+  {
+    auto const & infoGetter = *m_cig;
+    auto const countryFileGetter = [&infoGetter](m2::PointD const & pt) {
+      return infoGetter.GetRegionCountryId(pt);
+    };
+    auto const getMwmRectByName = [&infoGetter](string const & countryId) {
+      return infoGetter.GetLimitRectForLeaf(countryId);
+    };
+
+    return make_unique<IndexRouter>(vehicleType, false /* load altitudes */, m_cpg,
+                                    countryFileGetter, getMwmRectByName, m_numMwmIds,
+                                    MakeNumMwmTree(*m_numMwmIds, infoGetter), m_trafficCache,
+                                    m_dataSource);
+  }
+
+private:
+  DISALLOW_COPY_AND_MOVE(GraphStore);
+
+  FrozenDataSource m_dataSource;
+  shared_ptr<NumMwmIds> m_numMwmIds = make_shared<NumMwmIds>();
+  storage::CountryParentGetter m_cpg;
+  unique_ptr<storage::CountryInfoGetter> m_cig =
+      storage::CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  traffic::TrafficCache m_trafficCache;
+};
+
+// Per worker state: routers and their delegate. Routers are not thread-safe.
+class Worker final
+{
+public:
+  explicit Worker(GraphStore & store) : m_store(store) {}
+
+  Response Run(Request const & request)
+  {
+    auto & router = m_routers[static_cast<size_t>(request.m_vehicleType)];
+    if (!router)
+      router = m_store.CreateRouter(request.m_vehicleType);
+
+    Response response;
+    Route route("" /* router */, 0 /* routeId */);
+    base::Timer timer;
+    response.m_code = router->CalculateRoute(Checkpoints(vector<m2::PointD>(request.m_points)),
+                                             m2::PointD::Zero() /* startDirection */,
+                                             false /* adjustToPrevRoute */, m_delegate, route);
+    response.m_totalSec = timer.ElapsedSeconds();
+    if (response.m_code == RouterResultCode::NoError)
+    {
+      response.m_distanceM = route.GetTotalDistanceMeters();
+      response.m_etaSec = route.GetTotalTimeSec();
+    }
+    return response;
+  }
+
+private:
+  GraphStore & m_store;
+  unique_ptr<IndexRouter> m_routers[static_cast<size_t>(VehicleType::Count)];
+  RouterDelegate m_delegate;
+};
+
+// Requests which are read but not calculated yet. Reading of requests is not blocked by
+// calculation, so a client may send requests without waiting for responses.
+class RequestQueue final
+{
+public:
+  void Push(Request && request)
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_requests.push(move(request));
+    }
+    m_cv.notify_one();
+  }
+
+  void Close()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_closed = true;
+    }
+    m_cv.notify_all();
+  }
+
+  // Returns false when the queue is closed and empty.
+  bool Pop(Request & request)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_closed || !m_requests.empty(); });
+    if (m_requests.empty())
+      return false;
+
+    request = move(m_requests.front());
+    m_requests.pop();
+    return true;
+  }
+
+private:
+  mutex m_mutex;
+  condition_variable m_cv;
+  queue<Request> m_requests;
+  bool m_closed = false;
+};
+
+class ResponseWriter final
+{
+public:
+  explicit ResponseWriter(ostream & output) : m_output(output) {}
+
+  void Write(Request const & request, Response const & response)
+  {
+    auto json = base::NewJSONObject();
+    ToJSONObject(*json, "id", request.m_id);
+    ToJSONObject(*json, "vehicle_type", ToString(request.m_vehicleType).c_str());
+    ToJSONObject(*json, "code", DebugPrint(response.m_code).c_str());
+    ToJSONObject(*json, "distance_m", response.m_distanceM);
+    ToJSONObject(*json, "eta_sec", response.m_etaSec);
+    ToJSONObject(*json, "total_sec", response.m_totalSec);
+    unique_ptr<char, JSONFreeDeleter> buffer(json_dumps(json.get(), JSON_COMPACT));
+
+    lock_guard<mutex> lock(m_mutex);
+    m_output << buffer.get() << endl;
+    m_totalSecs.push_back(response.m_totalSec);
+    if (response.m_code != RouterResultCode::NoError)
+      ++m_errorsNumber;
+  }
+
+  base::JSONPtr MakeSummary(double wallSec, size_t threadsNumber)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    sort(m_totalSecs.begin(), m_totalSecs.end());
+    auto const percentile = [this](double p) {
+      if (m_totalSecs.empty())
+        return 0.0;
+      return m_totalSecs[min(m_totalSecs.size() - 1, static_cast<size_t>(p * m_totalSecs.size()))];
+    };
+
+    auto json = base::NewJSONObject();
+    ToJSONObject(*json, "threads", static_cast<uint64_t>(threadsNumber));
+    ToJSONObject(*json, "requests", static_cast<uint64_t>(m_totalSecs.size()));
+    ToJSONObject(*json, "errors", m_errorsNumber);
+    ToJSONObject(*json, "wall_sec", wallSec);
+    ToJSONObject(*json, "requests_per_sec", wallSec == 0.0 ? 0.0 : m_totalSecs.size() / wallSec);
+    ToJSONObject(*json, "p50_sec", percentile(0.5));
+    ToJSONObject(*json, "p95_sec", percentile(0.95));
+    ToJSONObject(*json, "max_sec", m_totalSecs.empty() ? 0.0 : m_totalSecs.back());
+
+    auto const cacheStats = RoadGeometryCache::Instance().GetStats();
+    ToJSONObject(*json, "geometry_cache_hit_rate", cacheStats.GetHitRate());
+    ToJSONObject(*json, "geometry_cache_bytes", static_cast<uint64_t>(cacheStats.m_sizeBytes));
+    return json;
+  }
+
+private:
+  mutex m_mutex;
+  ostream & m_output;
+  vector<double> m_totalSecs;
+  uint64_t m_errorsNumber = 0;
+};
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Serves route requests by several router workers which share mwms "
+                          "and road geometry. Requests are read line by line and responses are "
+                          "written as soon as they are calculated.");
+  google::ParseCommandLineFlags(&argc, &argv, true /* remove_flags */);
+
+  Platform & platform = GetPlatform();
+  if (!FLAGS_data_path.empty())
+    platform.SetWritableDirForTests(FLAGS_data_path);
+  if (!FLAGS_user_resource_path.empty())
+    platform.SetResourceDir(FLAGS_user_resource_path);
+
+  if (FLAGS_geometry_cache_mb != 0)
+    RoadGeometryCache::Instance().SetMemoryBudget(FLAGS_geometry_cache_mb * 1024 * 1024);
+
+  ifstream requestsFile;
+  if (!FLAGS_requests.empty())
+  {
+    requestsFile.open(FLAGS_requests);
+    CHECK(requestsFile.is_open(), ("Can't open", FLAGS_requests));
+  }
+  istream & input = FLAGS_requests.empty() ? cin : requestsFile;
+
+  ofstream outputFile;
+  if (!FLAGS_output.empty())
+  {
+    outputFile.open(FLAGS_output);
+    CHECK(outputFile.is_open(), ("Can't open", FLAGS_output));
+  }
+  ResponseWriter writer(FLAGS_output.empty() ? cout : outputFile);
+
+  GraphStore store;
+  size_t const threadsNumber =
+      FLAGS_threads != 0 ? FLAGS_threads : max(thread::hardware_concurrency(), 1U);
+
+  RequestQueue queue;
+  base::Timer timer;
+  vector<threads::SimpleThread> workers;
+  for (size_t i = 0; i < threadsNumber; ++i)
+  {
+    workers.emplace_back([&store, &queue, &writer] {
+      Worker worker(store);
+      Request request;
+      while (queue.Pop(request))
+        writer.Write(request, worker.Run(request));
+    });
+  }
+
+  uint64_t id = 0;
+  string line;
+  while (getline(input, line))
+  {
+    strings::Trim(line);
+    if (line.empty())
+      continue;
+
+    // Ids are numbers of non-empty lines, so responses to wrong requests are just missed.
+    Request request;
+    request.m_id = id++;
+    if (!ParseRequest(line, request))
+    {
+      LOG(LWARNING, ("Wrong request", request.m_id, ":", line));
+      continue;
+    }
+    queue.Push(move(request));
+  }
+  queue.Close();
+
+  for (auto & worker : workers)
+    worker.join();
+
+  auto const summary = writer.MakeSummary(timer.ElapsedSeconds(), threadsNumber);
+  unique_ptr<char, JSONFreeDeleter> buffer(json_dumps(summary.get(), JSON_INDENT(2)));
+  LOG(LINFO, ("Summary:", buffer.get()));
+  if (!FLAGS_summary.empty())
+  {
+    ofstream output(FLAGS_summary);
+    CHECK(output.is_open(), ("Can't open", FLAGS_summary));
+    output << buffer.get() << "\n";
+  }
+  return 0;
+}
@@ -135,6 +135,7 @@ void RoutingSession::RemoveRoute()
   m_turnNotificationsMgr.Reset();
 
   m_route = make_unique<Route>(string() /* router */, 0 /* route id */);
+  m_speedCamerasOnRoute.clear();
 }
 
 void RoutingSession::RebuildRouteOnTrafficUpdate()
@@ -488,6 +489,7 @@ void RoutingSession::AssignRoute(shared_ptr<Route> route, RouterResultCode e)
 
   route->SetRoutingSettings(m_routingSettings);
   m_route = route;
+  m_route->GetSpeedCamerasOnRoute(m_speedCamerasOnRoute);
   m_firstNotCheckedSpeedCameraIndex = 0;
   m_cachedSpeedCameras = {};
   m_warnedSpeedCameras = {};
@@ -727,35 +729,19 @@ void RoutingSession::CopyTraffic(traffic::AllMwmTrafficInfo & trafficColoring) c
 
 void RoutingSession::FindCamerasOnRouteAndCache(double passedDistanceMeters)
 {
-  auto const & segments = m_route->GetRouteSegments();
-  size_t firstNotChecked = m_firstNotCheckedSpeedCameraIndex;
-  if (firstNotChecked == segments.size())
-    return;
-
-  CHECK_LESS(firstNotChecked, segments.size(), ());
-
-  double distToPrevSegment = segments[firstNotChecked].GetDistFromBeginningMeters();
-  double distFromCurPosToLatestCheckedSegmentM = distToPrevSegment - passedDistanceMeters;
-
-  while (firstNotChecked < segments.size() &&
-         distFromCurPosToLatestCheckedSegmentM < SpeedCameraOnRoute::kLookAheadDistanceMeters)
+  // Cameras are sorted by distance so the cursor is only moved forward.
+  while (m_firstNotCheckedSpeedCameraIndex < m_speedCamerasOnRoute.size())
   {
-    auto const & lastSegment = segments[firstNotChecked];
-    auto const & speedCamsVector = lastSegment.GetSpeedCams();
-    double segmentLength = m_route->GetSegLenMeters(firstNotChecked);
-
-    for (auto const & speedCam : speedCamsVector)
+    auto const & speedCam = m_speedCamerasOnRoute[m_firstNotCheckedSpeedCameraIndex];
+    if (speedCam.m_distFromBeginMeters - passedDistanceMeters >=
+        SpeedCameraOnRoute::kLookAheadDistanceMeters)
     {
-      segmentLength *= speedCam.m_coef;
-      m_cachedSpeedCameras.emplace(distToPrevSegment + segmentLength, speedCam.m_maxSpeedKmPH);
+      break;
     }
 
-    distToPrevSegment = lastSegment.GetDistFromBeginningMeters();
-    distFromCurPosToLatestCheckedSegmentM = distToPrevSegment - passedDistanceMeters;
-    ++firstNotChecked;
+    m_cachedSpeedCameras.push(speedCam);
+    ++m_firstNotCheckedSpeedCameraIndex;
   }
-
-  m_firstNotCheckedSpeedCameraIndex = firstNotChecked;
 }
 
 void RoutingSession::ProcessSpeedCameras(GpsInfo const & info)
@@ -28,6 +28,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <vector>
 
 namespace location
 {
@@ -224,12 +225,16 @@ private:
   // Queue of speedCams, that we have found, but they are too far, to make warning about them.
   std::queue<SpeedCameraOnRoute> m_cachedSpeedCameras;
 
+  // All speedCams of |m_route| sorted by distance from the beginning of the route.
+  std::vector<SpeedCameraOnRoute> m_speedCamerasOnRoute;
+
   // Big red button about camera in user interface.
   bool m_showWarningAboutSpeedCam = false;
 
   // Flag of doing sound notification about camera on a way.
   bool m_makeNotificationAboutSpeedCam = false;
 
+  // Index of the first camera of |m_speedCamerasOnRoute| which is not cached yet.
   size_t m_firstNotCheckedSpeedCameraIndex = 0;
 
   /// Current position metrics to check for RouteNeedRebuild state.
@@ -3,7 +3,11 @@
 #include "routing/base/astar_algorithm.hpp"
 #include "routing/base/routing_result.hpp"
 
+#include "base/cancellable.hpp"
+#include "base/exception.hpp"
+
 #include "std/map.hpp"
+#include "std/set.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -78,6 +82,12 @@ void TestAStar(UndirectedGraph & graph, vector<unsigned> const & expectedRoute,
   TEST_EQUAL(TAlgorithm::Result::OK, algo.FindPathBidirectional(params, actualRoute), ());
   TEST_EQUAL(expectedRoute, actualRoute.m_path, ());
   TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
+
+  actualRoute.m_path.clear();
+  params.m_runWavesInParallel = true;
+  TEST_EQUAL(TAlgorithm::Result::OK, algo.FindPathBidirectional(params, actualRoute), ());
+  TEST_EQUAL(expectedRoute, actualRoute.m_path, ());
+  TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
 }
 
 UNIT_TEST(AStarAlgorithm_Sample)
@@ -120,6 +130,128 @@ UNIT_TEST(AStarAlgorithm_CheckLength)
   result = algo.FindPathBidirectional(params, routingResult);
   // Best route weight is 23 so we expect to find no route with restriction |weight < 23|.
   TEST_EQUAL(result, TAlgorithm::Result::NoPath, ());
+
+  routingResult = {};
+  params.m_runWavesInParallel = true;
+  result = algo.FindPathBidirectional(params, routingResult);
+  TEST_EQUAL(result, TAlgorithm::Result::NoPath, ());
+}
+
+UNIT_TEST(AStarAlgorithm_ParallelBidirectional)
+{
+  // Grid |kSize| x |kSize| with pseudo random weights.
+  unsigned constexpr kSize = 12;
+  UndirectedGraph graph;
+  for (unsigned i = 0; i < kSize; ++i)
+  {
+    for (unsigned j = 0; j < kSize; ++j)
+    {
+      unsigned const v = i * kSize + j;
+      if (j + 1 < kSize)
+        graph.AddEdge(v, v + 1, 1 + (v * 7 + 3) % 11);
+      if (i + 1 < kSize)
+        graph.AddEdge(v, v + kSize, 1 + (v * 5 + 1) % 13);
+    }
+  }
+
+  TAlgorithm algo;
+  for (unsigned start = 0; start < kSize * kSize; start += 7)
+  {
+    for (unsigned finish = 0; finish < kSize * kSize; finish += 5)
+    {
+      if (start == finish)
+        continue;
+
+      TAlgorithm::ParamsForTests params(graph, start, finish, nullptr /* prevRoute */,
+                                        {} /* checkLengthCallback */);
+      RoutingResult<unsigned /* Vertex */, double /* Weight */> expected;
+      auto result = algo.FindPath(params, expected);
+      TEST_EQUAL(result, TAlgorithm::Result::OK, ());
+
+      params.m_runWavesInParallel = true;
+      RoutingResult<unsigned /* Vertex */, double /* Weight */> actual;
+      result = algo.FindPathBidirectional(params, actual);
+      TEST_EQUAL(result, TAlgorithm::Result::OK, (start, finish));
+      TEST_ALMOST_EQUAL_ULPS(expected.m_distance, actual.m_distance, (start, finish));
+      TEST_EQUAL(actual.m_path.front(), start, ());
+      TEST_EQUAL(actual.m_path.back(), finish, ());
+    }
+  }
+}
+
+DECLARE_EXCEPTION(GraphException, RootException);
+
+// Infinite chain 0 -> 1 -> 2 -> ... which throws when the ingoing edges are requested.
+// The forward wave never stops by itself, so the search ends only when the backward wave throws.
+class ThrowingGraph
+{
+public:
+  using Vertex = unsigned;
+  using Edge = routing_test::Edge;
+  using Weight = double;
+
+  void GetOutgoingEdgesList(unsigned v, vector<Edge> & adj) const
+  {
+    adj.assign(1, Edge(v + 1, 1));
+  }
+
+  void GetIngoingEdgesList(unsigned v, vector<Edge> & /* adj */) const
+  {
+    MYTHROW(GraphException, ("Can't get ingoing edges of", v));
+  }
+
+  double HeuristicCostEstimate(unsigned /* v */, unsigned /* w */) const { return 0; }
+};
+
+UNIT_TEST(AStarAlgorithm_ParallelBidirectionalRethrows)
+{
+  ThrowingGraph graph;
+  AStarAlgorithm<ThrowingGraph> algo;
+  AStarAlgorithm<ThrowingGraph>::ParamsForTests params(graph, 1u /* startVertex */,
+                                                       0u /* finishVertex */,
+                                                       nullptr /* prevRoute */,
+                                                       {} /* checkLengthCallback */);
+  params.m_runWavesInParallel = true;
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> result;
+  TEST_THROW(algo.FindPathBidirectional(params, result), GraphException, ());
+}
+
+UNIT_TEST(AStarAlgorithm_Alternatives)
+{
+  UndirectedGraph graph;
+
+  // The shortest path 0 - 1 - 2 - 3 - 4 - 5 - 6.
+  for (unsigned i = 0; i < 6; ++i)
+    graph.AddEdge(i, i + 1, 10);
+  // Detour 3 - 10 - 4 which shares too much with the shortest path.
+  graph.AddEdge(3, 10, 6);
+  graph.AddEdge(10, 4, 6);
+  // Alternative 0 - 7 - 8 - 9 - 11 - 12 - 6.
+  graph.AddEdge(0, 7, 10);
+  graph.AddEdge(7, 8, 10);
+  graph.AddEdge(8, 9, 10);
+  graph.AddEdge(9, 11, 10);
+  graph.AddEdge(11, 12, 10);
+  graph.AddEdge(12, 6, 11);
+  // Path 0 - 13 - 6 which is too long.
+  graph.AddEdge(0, 13, 40);
+  graph.AddEdge(13, 6, 40);
+
+  TAlgorithm algo;
+  TAlgorithm::ParamsForTests params(graph, 0u /* startVertex */, 6u /* finishVertex */,
+                                    nullptr /* prevRoute */, {} /* checkLengthCallback */);
+  TAlgorithm::AlternativesParams const alternativesParams;
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> result;
+  vector<RoutingResult<unsigned /* Vertex */, double /* Weight */>> alternatives;
+  auto const code =
+      algo.FindPathBidirectionalWithAlternatives(params, alternativesParams, result, alternatives);
+
+  TEST_EQUAL(code, TAlgorithm::Result::OK, ());
+  TEST_EQUAL(result.m_path, vector<unsigned>({0, 1, 2, 3, 4, 5, 6}), ());
+  TEST_ALMOST_EQUAL_ULPS(result.m_distance, 60.0, ());
+  TEST_EQUAL(alternatives.size(), 1, ());
+  TEST_EQUAL(alternatives[0].m_path, vector<unsigned>({0, 7, 8, 9, 11, 12, 6}), ());
+  TEST_ALMOST_EQUAL_ULPS(alternatives[0].m_distance, 61.0, ());
 }
 
 UNIT_TEST(AdjustRoute)
@@ -189,4 +321,39 @@ UNIT_TEST(AdjustRouteOutOfLimit)
   TEST_EQUAL(code, TAlgorithm::Result::NoPath, ());
   TEST(result.m_path.empty(), ());
 }
+
+UNIT_TEST(AdjustRouteStopsWhenBestJoinIsFound)
+{
+  UndirectedGraph graph;
+
+  for (unsigned int i = 0; i < 5; ++i)
+    graph.AddEdge(i /* from */, i + 1 /* to */, 1 /* weight */);
+
+  graph.AddEdge(6, 2, 1);
+  // Dead end 6 - 7 - ... - 26 which is inside the wave limit.
+  graph.AddEdge(6, 7, 1);
+  for (unsigned int i = 7; i < 26; ++i)
+    graph.AddEdge(i /* from */, i + 1 /* to */, 1 /* weight */);
+
+  // Each edge contains {vertexId, weight}.
+  vector<Edge> const prevRoute = {{0, 0}, {1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}};
+
+  base::Cancellable cancellable;
+  set<unsigned> visited;
+  TAlgorithm algo;
+  TAlgorithm::Params params(
+      graph, 6 /* startVertex */, {} /* finishVertex */, &prevRoute, cancellable,
+      [&visited](unsigned /* start */, unsigned vertex) { visited.insert(vertex); },
+      [](double weight) { return weight <= 100.0; });
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> result;
+  auto const code = algo.AdjustRoute(params, result);
+
+  vector<unsigned> const expectedRoute = {6, 2, 3, 4, 5};
+  TEST_EQUAL(code, TAlgorithm::Result::OK, ());
+  TEST_EQUAL(result.m_path, expectedRoute, ());
+  TEST_EQUAL(result.m_distance, 4.0, ());
+  // Vertices which are further than the found route are not visited.
+  TEST_EQUAL(visited.count(10), 0, ());
+  TEST_EQUAL(visited.count(26), 0, ());
+}
 }  // namespace routing_test
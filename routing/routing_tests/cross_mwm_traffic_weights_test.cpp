@@ -0,0 +1,130 @@
+#include "testing/testing.hpp"
+
+#include "routing/cross_mwm_traffic_weights.hpp"
+#include "routing/geometry.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/segment.hpp"
+#include "routing/traffic_stash.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "traffic/traffic_cache.hpp"
+#include "traffic/traffic_info.hpp"
+
+#include "indexer/classificator_loader.hpp"
+
+#include "base/math.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+using namespace traffic;
+
+namespace
+{
+//      (2, 1)
+//      ↗    ↘
+//    F2      F3
+//    ↗         ↘
+// *-F0->*---F1--->*-F4->*
+// 0     1         3     4
+//
+// Note. All the features are one segment directed features. F0 is an enter and F4 is an exit.
+class CrossMwmTrafficWeightsTest
+{
+public:
+  CrossMwmTrafficWeightsTest()
+  {
+    classificator::Load();
+    m_trafficStash = make_shared<TrafficStash>(m_trafficCache, make_shared<NumMwmIds>());
+
+    unique_ptr<TestGeometryLoader> loader = make_unique<TestGeometryLoader>();
+    loader->AddRoad(0 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                    RoadGeometry::Points({{0.0, 0.0}, {1.0, 0.0}}));
+    loader->AddRoad(1 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                    RoadGeometry::Points({{1.0, 0.0}, {3.0, 0.0}}));
+    loader->AddRoad(2 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                    RoadGeometry::Points({{1.0, 0.0}, {2.0, 1.0}}));
+    loader->AddRoad(3 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                    RoadGeometry::Points({{2.0, 1.0}, {3.0, 0.0}}));
+    loader->AddRoad(4 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                    RoadGeometry::Points({{3.0, 0.0}, {4.0, 0.0}}));
+
+    vector<Joint> const joints = {
+        MakeJoint({{0 /* feature id */, 1 /* point id */}, {1, 0}, {2, 0}}), /* joint at (1, 0) */
+        MakeJoint({{2, 1}, {3, 0}}),                                         /* joint at (2, 1) */
+        MakeJoint({{1, 1}, {3, 1}, {4, 0}}),                                 /* joint at (3, 0) */
+    };
+
+    m_graph = BuildWorldGraph(move(loader), CreateEstimatorForCar(m_trafficStash), joints);
+  }
+
+  void SetTrafficColoring(TrafficInfo::Coloring const & coloring)
+  {
+    m_trafficStash->SetColoring(kTestNumMwmId, make_shared<TrafficInfo::Coloring const>(coloring));
+  }
+
+  IndexGraph & GetIndexGraph() { return m_graph->GetIndexGraphForTests(kTestNumMwmId); }
+
+  double CalcWeight(vector<uint32_t> const & featureIds)
+  {
+    double weight = 0.0;
+    for (auto const featureId : featureIds)
+    {
+      weight += m_graph
+                    ->CalcSegmentWeight(Segment(kTestNumMwmId, featureId, 0 /* segmentIdx */,
+                                                true /* forward */))
+                    .GetWeight();
+    }
+    return weight;
+  }
+
+  shared_ptr<TrafficStash> GetTrafficStash() const { return m_trafficStash; }
+
+private:
+  TrafficCache m_trafficCache;
+  shared_ptr<TrafficStash> m_trafficStash;
+  unique_ptr<SingleVehicleWorldGraph> m_graph;
+};
+
+UNIT_CLASS_TEST(CrossMwmTrafficWeightsTest, Leaps)
+{
+  CrossMwmTrafficWeights weights(GetTrafficStash());
+  Segment const enter(kTestNumMwmId, 0 /* featureId */, 0 /* segmentIdx */, true /* forward */);
+  vector<Segment> const exits = {Segment(kTestNumMwmId, 4, 0, true)};
+  vector<SegmentEdge> edges;
+
+  // There's no traffic for the mwm. Leap weights of cross mwm section should be used.
+  TEST(!weights.GetOutgoingEdgeList(enter, exits, GetIndexGraph(), edges), ());
+  TEST(edges.empty(), ());
+  TEST_EQUAL(weights.GetRowsNumber(), 0, ());
+
+  SetTrafficColoring({});
+  TEST(weights.GetOutgoingEdgeList(enter, exits, GetIndexGraph(), edges), ());
+  TEST_EQUAL(edges.size(), 1, ());
+  TEST_EQUAL(edges[0].GetTarget(), exits[0], ());
+  double const freeWeight = CalcWeight({1, 4});
+  TEST(base::AlmostEqualAbs(edges[0].GetWeight().GetWeight(), freeWeight, 1e-6), ());
+
+  // The row is calculated once while traffic is not changed.
+  edges.clear();
+  TEST(weights.GetOutgoingEdgeList(enter, exits, GetIndexGraph(), edges), ());
+  TEST_EQUAL(edges.size(), 1, ());
+  TEST_EQUAL(weights.GetRowsNumber(), 1, ());
+
+  // F1 is blocked. The leap goes through F2 and F3.
+  SetTrafficColoring(
+      {{{1 /* feature id */, 0 /* segment id */, TrafficInfo::RoadSegmentId::kForwardDirection},
+        SpeedGroup::TempBlock}});
+  edges.clear();
+  TEST(weights.GetOutgoingEdgeList(enter, exits, GetIndexGraph(), edges), ());
+  TEST_EQUAL(edges.size(), 1, ());
+  double const trafficWeight = CalcWeight({2, 3, 4});
+  TEST_GREATER(trafficWeight, freeWeight, ());
+  TEST(base::AlmostEqualAbs(edges[0].GetWeight().GetWeight(), trafficWeight, 1e-6), ());
+  TEST_EQUAL(weights.GetRowsNumber(), 1, ());
+}
+}  // namespace
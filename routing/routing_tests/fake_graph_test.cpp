@@ -5,7 +5,7 @@
 #include "geometry/point2d.hpp"
 
 #include <cstdint>
-#include <set>
+#include <vector>
 
 using namespace routing;
 using namespace std;
@@ -48,10 +48,10 @@ ConstructFakeGraph(uint32_t numerationStart, uint32_t numFake, uint32_t numReal)
     // Test segment to vertex mapping.
     TEST_EQUAL(fakeGraph.GetVertex(newSegment), newVertex, ("Wrong segment to vertex mapping."));
     // Test outgoing edge.
-    TEST_EQUAL(fakeGraph.GetEdges(newSegment, false /* isOutgoing */), set<int32_t>{prevSegment},
+    TEST_EQUAL(fakeGraph.GetEdges(newSegment, false /* isOutgoing */), vector<int32_t>{prevSegment},
                ("Wrong ingoing edges set."));
     // Test ingoing edge.
-    TEST_EQUAL(fakeGraph.GetEdges(prevSegment, true /* isOutgoing */), set<int32_t>{newSegment},
+    TEST_EQUAL(fakeGraph.GetEdges(prevSegment, true /* isOutgoing */), vector<int32_t>{newSegment},
                ("Wrong ingoing edges set."));
     // Test graph size
     TEST_EQUAL(fakeGraph.GetSize() + numerationStart, prevNumber + 2, ("Wrong fake graph size."));
@@ -62,7 +62,7 @@ ConstructFakeGraph(uint32_t numerationStart, uint32_t numFake, uint32_t numReal)
       TEST_EQUAL(fakeGraph.FindReal(newSegment, realFound), true,
                  ("Unexpected real segment found."));
       TEST_EQUAL(realSegment, realFound, ("Wrong fake to real mapping."));
-      TEST_EQUAL(fakeGraph.GetFake(realSegment), set<int32_t>{newSegment},
+      TEST_EQUAL(fakeGraph.GetFake(realSegment), vector<int32_t>{newSegment},
                  ("Unexpected fake segment found."));
     }
     else
@@ -114,11 +114,48 @@ UNIT_TEST(FakeGraphTest)
     }
     else
     {
-      TEST_EQUAL(fakeGraph0.GetEdges(segmentFrom, true /* isOutgoing */), set<int32_t>{segmentTo},
+      TEST_EQUAL(fakeGraph0.GetEdges(segmentFrom, true /* isOutgoing */), vector<int32_t>{segmentTo},
                  ("Wrong ingoing edges set."));
       TEST_EQUAL(fakeGraph0.GetEdges(segmentTo, false /* isOutgoing */),
-                 set<int32_t>{segmentFrom}, ("Wrong ingoing edges set."));
+                 vector<int32_t>{segmentFrom}, ("Wrong ingoing edges set."));
     }
   }
 }
+
+// Test adds segments in arbitrary order and checks that edges and mappings don't depend on it.
+UNIT_TEST(FakeGraphTest_UnorderedSegments)
+{
+  FakeGraph<int32_t /* SegmentType */, m2::PointD /* VertexType */> fakeGraph;
+  fakeGraph.Reserve(4);
+  fakeGraph.AddStandaloneVertex(10, m2::PointD(10, 10));
+  fakeGraph.AddVertex(10, 2, m2::PointD(2, 2), true /* isOutgoing */, true /* isPartOfReal */,
+                      -2 /* real */);
+  fakeGraph.AddVertex(10, 7, m2::PointD(7, 7), true /* isOutgoing */, true /* isPartOfReal */,
+                      -2 /* real */);
+  fakeGraph.AddVertex(2, 5, m2::PointD(5, 5), false /* isOutgoing */, false /* isPartOfReal */,
+                      0 /* real */);
+  fakeGraph.AddConnection(7, 5);
+  fakeGraph.AddConnection(7, 5);
+
+  TEST_EQUAL(fakeGraph.GetSize(), 4, ());
+  for (int32_t const segment : {2, 5, 7, 10})
+    TEST_EQUAL(fakeGraph.GetVertex(segment), m2::PointD(segment, segment), ());
+
+  TEST_EQUAL(fakeGraph.GetEdges(10, true /* isOutgoing */), vector<int32_t>({2, 7}), ());
+  TEST_EQUAL(fakeGraph.GetEdges(5, true /* isOutgoing */), vector<int32_t>({2}), ());
+  TEST_EQUAL(fakeGraph.GetEdges(5, false /* isOutgoing */), vector<int32_t>({7}), ());
+  TEST_EQUAL(fakeGraph.GetEdges(2, false /* isOutgoing */), vector<int32_t>({5, 10}), ());
+  TEST(fakeGraph.GetEdges(3, true /* isOutgoing */).empty(), ());
+
+  TEST_EQUAL(fakeGraph.GetFake(-2), vector<int32_t>({2, 7}), ());
+  int32_t real;
+  TEST(fakeGraph.FindReal(7, real), ());
+  TEST_EQUAL(real, -2, ());
+  TEST(!fakeGraph.FindReal(5, real), ());
+
+  int32_t segment;
+  TEST(fakeGraph.FindSegment(m2::PointD(5, 5), segment), ());
+  TEST_EQUAL(segment, 5, ());
+  TEST(!fakeGraph.FindSegment(m2::PointD(3, 3), segment), ());
+}
 }  // namespace routing
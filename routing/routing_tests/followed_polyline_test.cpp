@@ -4,6 +4,8 @@
 
 #include "geometry/polyline2d.hpp"
 
+#include <vector>
+
 namespace routing_test
 {
 using namespace routing;
@@ -142,4 +144,32 @@ UNIT_TEST(FollowedPolylineGetDistanceFromBeginM)
       MercatorBounds::DistanceOnEarth(kTestDirectedPolyline1.Front(), point);
   TEST_ALMOST_EQUAL_ULPS(distance, masterDistance, ());
 }
+
+UNIT_TEST(FollowedPolylineLongPolylineProjection)
+{
+  // A zigzag which is much longer than a block of segments, so the projection is looked for
+  // through several blocks.
+  std::vector<m2::PointD> points;
+  for (size_t i = 0; i <= 1000; ++i)
+    points.emplace_back(static_cast<double>(i) * 0.001, i % 2 == 0 ? 0.0 : 0.001);
+  FollowedPolyline polyline(points.cbegin(), points.cend());
+
+  polyline.UpdateProjection(MercatorBounds::RectByCenterXYAndSizeInMeters(points[1], 2));
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 0, ());
+
+  // Jump far ahead. The closest projection is to the segment which ends at the point.
+  polyline.UpdateProjection(MercatorBounds::RectByCenterXYAndSizeInMeters(points[701], 2));
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 700, ());
+  TEST(polyline.GetCurrentIter().m_pt.EqualDxDy(points[701], 1e-9), ());
+
+  polyline.UpdateProjection(
+      MercatorBounds::RectByCenterXYAndSizeInMeters({0.8005, 0.0005}, 2));
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 800, ());
+
+  // The position is far from the polyline.
+  auto const iter =
+      polyline.UpdateProjection(MercatorBounds::RectByCenterXYAndSizeInMeters({0.9, 1.0}, 2));
+  TEST(!iter.IsValid(), ());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 800, ());
+}
 }  // namespace routing_test
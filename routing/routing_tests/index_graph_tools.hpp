@@ -112,6 +112,7 @@ public:
   ~TestTransitGraphLoader() override = default;
 
   TransitGraph & GetTransitGraph(NumMwmId mwmId, IndexGraph & indexGraph) override;
+  bool HasGates(NumMwmId /* mwmId */, uint32_t /* featureId */) override { return true; }
   void Clear() override;
 
   void AddGraph(NumMwmId mwmId, unique_ptr<TransitGraph> graph);
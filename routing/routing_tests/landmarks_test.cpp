@@ -0,0 +1,260 @@
+#include "testing/testing.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/base/routing_result.hpp"
+#include "routing/fake_ending.hpp"
+#include "routing/geometry.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/landmarks.hpp"
+#include "routing/landmarks_serialization.hpp"
+#include "routing/route_weight.hpp"
+#include "routing/segment.hpp"
+#include "routing/single_vehicle_world_graph.hpp"
+#include "routing/world_graph.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/math.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+namespace
+{
+double constexpr kEpsilon = 1e-6;
+
+// Manhattan-like city with |kCitySize| streets and |kCitySize| avenues. Every street has
+// an additional point between intersections which is not a joint. Street 0 is one-way.
+uint32_t constexpr kCitySize = 4;
+
+// Adds roads and joints of a city with |citySize| streets and |citySize| avenues.
+void FillCity(uint32_t citySize, TestGeometryLoader & loader, vector<Joint> & joints)
+{
+  double constexpr kStep = 0.01;
+  for (uint32_t i = 0; i < citySize; ++i)
+  {
+    RoadGeometry::Points street;
+    RoadGeometry::Points avenue;
+    for (uint32_t j = 0; j < citySize; ++j)
+    {
+      if (j != 0)
+        street.emplace_back(kStep * (j - 0.5), kStep * i);
+      street.emplace_back(kStep * j, kStep * i);
+      avenue.emplace_back(kStep * i, kStep * j);
+    }
+    loader.AddRoad(i, i == 0 /* oneWay */, 20.0 + 10.0 * (i % 4) /* speed */, street);
+    loader.AddRoad(i + citySize, false /* oneWay */, 40.0 /* speed */, avenue);
+  }
+
+  for (uint32_t i = 0; i < citySize; ++i)
+  {
+    for (uint32_t j = 0; j < citySize; ++j)
+      joints.emplace_back(MakeJoint({{i, 2 * j}, {j + citySize, i}}));
+  }
+}
+
+unique_ptr<IndexGraph> BuildCityGraph(traffic::TrafficCache const & trafficCache)
+{
+  auto loader = make_unique<TestGeometryLoader>();
+  vector<Joint> joints;
+  FillCity(kCitySize, *loader, joints);
+
+  auto graph = make_unique<IndexGraph>(make_shared<Geometry>(move(loader)),
+                                       CreateEstimatorForCar(trafficCache));
+  graph->Import(joints);
+  return graph;
+}
+
+// Calculates route from |start| to |finish| and returns the number of the settled vertices.
+size_t CalcRoute(FakeEnding const & start, FakeEnding const & finish, WorldGraph & graph,
+                 vector<Segment> & route, double & weight)
+{
+  auto starter = MakeStarter(start, finish, graph);
+  size_t numSettled = 0;
+  base::Cancellable const cancellable;
+  AStarAlgorithm<IndexGraphStarter>::Params params(
+      *starter, starter->GetStartSegment(), starter->GetFinishSegment(), nullptr /* prevRoute */,
+      cancellable,
+      [&numSettled](Segment const & /* vertex */, Segment const & /* target */) { ++numSettled; },
+      {} /* checkLengthCallback */);
+
+  RoutingResult<Segment, RouteWeight> result;
+  TEST_EQUAL(AStarAlgorithm<IndexGraphStarter>().FindPathBidirectional(params, result),
+             AStarAlgorithm<IndexGraphStarter>::Result::OK, ());
+
+  route = result.m_path;
+  weight = 0.0;
+  for (size_t i = 0; i < route.size(); ++i)
+    weight += starter->CalcRouteSegmentWeight(route, i).GetWeight();
+  return numSettled;
+}
+
+vector<Segment> GetAllSegments(IndexGraph & graph)
+{
+  vector<Segment> segments;
+  for (uint32_t featureId = 0; featureId < 2 * kCitySize; ++featureId)
+  {
+    RoadGeometry const & road = graph.GetGeometry().GetRoad(featureId);
+    uint32_t const pointsCount = road.GetPointsCount();
+    bool const oneWay = road.IsOneWay();
+    for (uint32_t segmentIdx = 0; segmentIdx + 1 < pointsCount; ++segmentIdx)
+    {
+      segments.emplace_back(kTestNumMwmId, featureId, segmentIdx, true /* forward */);
+      if (!oneWay)
+        segments.emplace_back(kTestNumMwmId, featureId, segmentIdx, false /* forward */);
+    }
+  }
+  return segments;
+}
+
+UNIT_TEST(Landmarks_Build)
+{
+  traffic::TrafficCache const trafficCache;
+  auto graph = BuildCityGraph(trafficCache);
+
+  Landmarks const landmarks = BuildLandmarks(*graph, 3 /* numLandmarks */);
+  TEST_EQUAL(landmarks.GetNumLandmarks(), 3, ());
+  TEST_EQUAL(landmarks.GetNumJoints(), graph->GetNumJoints(), ());
+
+  // Every landmark is a joint with zero distance to itself and all the joints are reachable.
+  for (size_t i = 0; i < landmarks.GetNumLandmarks(); ++i)
+  {
+    size_t zeroDistances = 0;
+    for (Joint::Id jointId = 0; jointId < landmarks.GetNumJoints(); ++jointId)
+    {
+      auto const distance = landmarks.GetDistance(i, jointId);
+      TEST_NOT_EQUAL(distance, Landmarks::kInfiniteDistance, ());
+      if (distance == 0)
+        ++zeroDistances;
+    }
+    TEST_EQUAL(zeroDistances, 1, ());
+  }
+
+  TEST(BuildLandmarks(*graph, 0 /* numLandmarks */).IsEmpty(), ());
+}
+
+UNIT_TEST(Landmarks_HeuristicIsAdmissibleAndConsistent)
+{
+  traffic::TrafficCache const trafficCache;
+  auto graph = BuildCityGraph(trafficCache);
+  graph->SetLandmarks(BuildLandmarks(*graph, 4 /* numLandmarks */));
+
+  vector<Segment> const segments = GetAllSegments(*graph);
+  AStarAlgorithm<IndexGraph> algorithm;
+  bool nonZeroHeuristic = false;
+  for (auto const & from : segments)
+  {
+    AStarAlgorithm<IndexGraph>::Context context;
+    algorithm.PropagateWave(*graph, from, [](Segment const & /* vertex */) { return true; },
+                            context);
+
+    for (auto const & to : segments)
+    {
+      double const heuristic = CalcLandmarkHeuristic(*graph, from, to);
+      TEST_GREATER_OR_EQUAL(heuristic, 0.0, ());
+      if (heuristic > 0.0)
+        nonZeroHeuristic = true;
+
+      // Admissibility.
+      if (context.HasDistance(to))
+      {
+        TEST_LESS_OR_EQUAL(heuristic, context.GetDistance(to).GetWeight() + kEpsilon,
+                           (from, to));
+      }
+
+      // Consistency for the edges of |from| in both directions.
+      vector<SegmentEdge> edges;
+      graph->GetOutgoingEdgesList(from, edges);
+      for (auto const & edge : edges)
+      {
+        double const next = CalcLandmarkHeuristic(*graph, edge.GetTarget(), to);
+        TEST_LESS_OR_EQUAL(heuristic, edge.GetWeight().GetWeight() + next + kEpsilon,
+                           (from, edge.GetTarget(), to));
+        TEST_LESS_OR_EQUAL(next, edge.GetWeight().GetWeight() + heuristic + kEpsilon,
+                           (from, edge.GetTarget(), to));
+      }
+    }
+  }
+  TEST(nonZeroHeuristic, ());
+}
+
+UNIT_TEST(Landmarks_StarterSettlesFewerVertices)
+{
+  uint32_t constexpr kBigCitySize = 12;
+  traffic::TrafficCache const trafficCache;
+  auto loader = make_unique<TestGeometryLoader>();
+  vector<Joint> joints;
+  FillCity(kBigCitySize, *loader, joints);
+  auto graph = BuildWorldGraph(move(loader), CreateEstimatorForCar(trafficCache), joints);
+
+  IndexGraph & indexGraph = graph->GetIndexGraphForTests(kTestNumMwmId);
+  indexGraph.SetLandmarks(BuildLandmarks(indexGraph, 8 /* numLandmarks */));
+
+  // The endings are projected to the middles of the road segments.
+  auto const start = MakeFakeEnding(1 /* featureId */, 0 /* segmentIdx */,
+                                    m2::PointD(0.0025, 0.0105), *graph);
+  auto const finish = MakeFakeEnding(kBigCitySize - 2 /* featureId */, 17 /* segmentIdx */,
+                                     m2::PointD(0.0875, 0.0995), *graph);
+
+  // Landmarks are used in SingleMwm mode only.
+  graph->SetMode(WorldGraph::Mode::NoLeaps);
+  vector<Segment> route;
+  double weight = 0.0;
+  size_t const numSettled = CalcRoute(start, finish, *graph, route, weight);
+
+  graph->SetMode(WorldGraph::Mode::SingleMwm);
+  vector<Segment> landmarksRoute;
+  double landmarksWeight = 0.0;
+  size_t const landmarksNumSettled =
+      CalcRoute(start, finish, *graph, landmarksRoute, landmarksWeight);
+
+  TEST_EQUAL(route, landmarksRoute, ());
+  TEST(base::AlmostEqualAbs(weight, landmarksWeight, kEpsilon), (weight, landmarksWeight));
+  TEST_LESS(landmarksNumSettled, numSettled, ());
+}
+
+UNIT_TEST(Landmarks_Serialization)
+{
+  traffic::TrafficCache const trafficCache;
+  auto graph = BuildCityGraph(trafficCache);
+  Landmarks const landmarks = BuildLandmarks(*graph, 2 /* numLandmarks */);
+
+  vector<uint8_t> buf;
+  {
+    MemWriter<decltype(buf)> writer(buf);
+    LandmarksSerializer::Serialize(writer, landmarks);
+  }
+
+  {
+    Landmarks deserialized;
+    MemReader memReader(buf.data(), buf.size());
+    ReaderSource<MemReader> src(memReader);
+    LandmarksSerializer::Deserialize(src, graph->GetNumJoints(), deserialized);
+    TEST_EQUAL(src.Size(), 0, ());
+    TEST_EQUAL(deserialized.GetNumJoints(), landmarks.GetNumJoints(), ());
+    TEST_EQUAL(deserialized.GetDistances(), landmarks.GetDistances(), ());
+  }
+
+  {
+    // Landmarks of an obsolete graph are skipped.
+    Landmarks deserialized;
+    MemReader memReader(buf.data(), buf.size());
+    ReaderSource<MemReader> src(memReader);
+    LandmarksSerializer::Deserialize(src, graph->GetNumJoints() + 1, deserialized);
+    TEST(deserialized.IsEmpty(), ());
+  }
+}
+}  // namespace
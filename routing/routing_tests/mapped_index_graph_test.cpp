@@ -0,0 +1,195 @@
+#include "testing/testing.hpp"
+
+#include "routing/edge_estimator.hpp"
+#include "routing/geometry.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/index_graph_serialization.hpp"
+#include "routing/joint.hpp"
+#include "routing/mapped_index_graph.hpp"
+#include "routing/routing_exceptions.hpp"
+#include "routing/segment.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+namespace
+{
+vector<uint8_t> SerializeMapped(vector<pair<VehicleType, IndexGraph const *>> const & graphs)
+{
+  vector<uint8_t> buffer;
+  MemWriter<vector<uint8_t>> writer(buffer);
+  MappedIndexGraphSerializer::Serialize(graphs, writer);
+  return buffer;
+}
+
+unique_ptr<TestGeometryLoader> MakeSquareLoader()
+{
+  auto loader = make_unique<TestGeometryLoader>();
+  loader->AddRoad(0 /* featureId */, false /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}}));
+  loader->AddRoad(1 /* featureId */, false /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{2.0, 0.0}, {2.0, 2.0}}));
+  loader->AddRoad(2 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{2.0, 2.0}, {0.0, 2.0}}));
+  loader->AddRoad(3 /* featureId */, false /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 2.0}, {0.0, 0.0}}));
+  loader->AddRoad(4 /* featureId */, false /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{1.0, 0.0}, {2.0, 2.0}}));
+  return loader;
+}
+
+vector<SegmentEdge> GetEdges(IndexGraph & graph, Segment const & segment, bool isOutgoing)
+{
+  vector<SegmentEdge> edges;
+  graph.GetEdgeList(segment, isOutgoing, edges);
+  sort(edges.begin(), edges.end());
+  return edges;
+}
+
+//
+//  Road       R0 (ped)       R1 (car)       R2 (car)
+//           0----------1 * 0----------1 * 0----------1
+//  Joints               J0             J1
+//
+UNIT_TEST(MappedIndexGraph_SameJointsAsDeserialized)
+{
+  vector<uint8_t> buffer;
+  {
+    IndexGraph graph;
+    graph.Import({MakeJoint({{0, 1}, {1, 0}}), MakeJoint({{1, 1}, {2, 0}})});
+    unordered_map<uint32_t, VehicleMask> masks = {{0, kPedestrianMask}, {1, kCarMask},
+                                                  {2, kCarMask}};
+    MemWriter<vector<uint8_t>> writer(buffer);
+    IndexGraphSerializer::Serialize(graph, masks, writer);
+  }
+
+  vector<VehicleType> const vehicleTypes = {VehicleType::Pedestrian, VehicleType::Car};
+  vector<IndexGraph> deserialized(vehicleTypes.size());
+  vector<pair<VehicleType, IndexGraph const *>> graphs;
+  for (size_t i = 0; i < vehicleTypes.size(); ++i)
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> source(reader);
+    IndexGraphSerializer::Deserialize(deserialized[i], source, GetVehicleMask(vehicleTypes[i]));
+    graphs.emplace_back(vehicleTypes[i], &deserialized[i]);
+  }
+
+  vector<uint8_t> const section = SerializeMapped(graphs);
+  TEST(!MappedIndexGraph::Create(section.data(), section.size(), VehicleType::Bicycle), ());
+
+  for (size_t i = 0; i < vehicleTypes.size(); ++i)
+  {
+    IndexGraph const & expected = deserialized[i];
+    IndexGraph mapped;
+    shared_ptr<MappedIndexGraph const> mappedGraph =
+        MappedIndexGraph::Create(section.data(), section.size(), vehicleTypes[i]);
+    TEST(mappedGraph, (vehicleTypes[i]));
+    mapped.Map(mappedGraph);
+
+    TEST_EQUAL(mapped.GetNumRoads(), expected.GetNumRoads(), (vehicleTypes[i]));
+    TEST_EQUAL(mapped.GetNumJoints(), expected.GetNumJoints(), (vehicleTypes[i]));
+    TEST_EQUAL(mapped.GetNumPoints(), expected.GetNumPoints(), (vehicleTypes[i]));
+
+    for (uint32_t featureId = 0; featureId < 4; ++featureId)
+    {
+      TEST_EQUAL(mapped.IsRoad(featureId), expected.IsRoad(featureId), (featureId));
+      for (uint32_t pointId = 0; pointId < 3; ++pointId)
+      {
+        RoadPoint const rp(featureId, pointId);
+        TEST_EQUAL(mapped.GetJointId(rp), expected.GetJointId(rp), (vehicleTypes[i], rp));
+      }
+    }
+
+    for (Joint::Id jointId = 0; jointId < expected.GetNumJoints(); ++jointId)
+    {
+      vector<RoadPoint> expectedPoints;
+      expected.ForEachPoint(jointId, [&](RoadPoint const & rp) { expectedPoints.push_back(rp); });
+      vector<RoadPoint> mappedPoints;
+      mapped.ForEachPoint(jointId, [&](RoadPoint const & rp) { mappedPoints.push_back(rp); });
+      sort(expectedPoints.begin(), expectedPoints.end());
+      sort(mappedPoints.begin(), mappedPoints.end());
+      TEST_EQUAL(mappedPoints, expectedPoints, (vehicleTypes[i], jointId));
+    }
+  }
+
+  IndexGraph car;
+  car.Map(MappedIndexGraph::Create(section.data(), section.size(), VehicleType::Car));
+  RoadJointIds const & road = car.GetRoad(1 /* featureId */);
+  TEST_EQUAL(road.GetJointId(1 /* pointId */), 0, ());
+  TEST_EQUAL(road.GetJointsNumber(), 1, ());
+  TEST_EQUAL(&car.GetRoad(1 /* featureId */), &road, ());
+}
+
+//  (0, 2) *<----R2-----* (2, 2)
+//         |           /|
+//        R3        R4  R1
+//         |       /    |
+//  (0, 0) *--R0--*--R0-* (2, 0)
+UNIT_TEST(MappedIndexGraph_SameEdgesAsInMemory)
+{
+  vector<Joint> const joints = {
+      MakeJoint({{0 /* feature id */, 0 /* point id */}, {3, 1}}), /* joint at point (0, 0) */
+      MakeJoint({{0, 1}, {4, 0}}),                                 /* joint at point (1, 0) */
+      MakeJoint({{0, 2}, {1, 0}}),                                 /* joint at point (2, 0) */
+      MakeJoint({{1, 1}, {2, 0}, {4, 1}}),                         /* joint at point (2, 2) */
+      MakeJoint({{2, 1}, {3, 0}}),                                 /* joint at point (0, 2) */
+  };
+
+  shared_ptr<EdgeEstimator> estimator = CreateEstimatorForCar(nullptr /* trafficStash */);
+  IndexGraph inMemory(make_shared<Geometry>(MakeSquareLoader()), estimator);
+  inMemory.Import(joints);
+
+  vector<uint8_t> const section = SerializeMapped({{VehicleType::Car, &inMemory}});
+  IndexGraph mapped(make_shared<Geometry>(MakeSquareLoader()), estimator);
+  mapped.Map(MappedIndexGraph::Create(section.data(), section.size(), VehicleType::Car));
+
+  vector<pair<uint32_t, uint32_t>> const roads = {{0, 2}, {1, 1}, {2, 1}, {3, 1}, {4, 1}};
+  for (auto const & road : roads)
+  {
+    for (uint32_t segmentIdx = 0; segmentIdx < road.second; ++segmentIdx)
+    {
+      for (bool const forward : {true, false})
+      {
+        Segment const segment(kTestNumMwmId, road.first, segmentIdx, forward);
+        for (bool const isOutgoing : {true, false})
+        {
+          TEST_EQUAL(GetEdges(mapped, segment, isOutgoing), GetEdges(inMemory, segment, isOutgoing),
+                     (segment, isOutgoing));
+        }
+      }
+    }
+  }
+}
+
+UNIT_TEST(MappedIndexGraph_Corrupted)
+{
+  IndexGraph graph;
+  graph.Import({MakeJoint({{0, 1}, {1, 0}}), MakeJoint({{1, 1}, {2, 0}})});
+  vector<uint8_t> const section = SerializeMapped({{VehicleType::Car, &graph}});
+
+  TEST_THROW(MappedIndexGraph::Create(section.data(), section.size() - sizeof(uint32_t),
+                                      VehicleType::Car),
+             CorruptedDataException, ());
+
+  vector<uint8_t> wrongVersion = section;
+  wrongVersion[0] = 1;
+  TEST_THROW(MappedIndexGraph::Create(wrongVersion.data(), wrongVersion.size(), VehicleType::Car),
+             CorruptedDataException, ());
+}
+}  // namespace
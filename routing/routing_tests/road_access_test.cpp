@@ -72,6 +72,32 @@ UNIT_TEST(RoadAccess_Serialization)
   }
 }
 
+UNIT_TEST(RoadAccess_GetTypes)
+{
+  unordered_map<uint32_t, RoadAccess::Type> featureTypes = {
+      {3, RoadAccess::Type::No},
+      {100, RoadAccess::Type::Private},
+  };
+  unordered_map<RoadPoint, RoadAccess::Type, RoadPoint::Hash> pointTypes = {
+      {RoadPoint(3, 1), RoadAccess::Type::Destination},
+      {RoadPoint(7, 0), RoadAccess::Type::No},
+  };
+
+  RoadAccess roadAccess;
+  TEST_EQUAL(roadAccess.GetFeatureType(3), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(7, 0)), RoadAccess::Type::Yes, ());
+
+  roadAccess.SetAccessTypes(move(featureTypes), move(pointTypes));
+  TEST_EQUAL(roadAccess.GetFeatureType(3), RoadAccess::Type::No, ());
+  TEST_EQUAL(roadAccess.GetFeatureType(100), RoadAccess::Type::Private, ());
+  TEST_EQUAL(roadAccess.GetFeatureType(7), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetFeatureType(101), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(3, 1)), RoadAccess::Type::Destination, ());
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(3, 0)), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(7, 0)), RoadAccess::Type::No, ());
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(100, 0)), RoadAccess::Type::Yes, ());
+}
+
 UNIT_TEST(RoadAccess_WayBlocked)
 {
   // Add edges to the graph in the following format: (from, to, weight).
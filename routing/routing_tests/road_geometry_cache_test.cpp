@@ -0,0 +1,150 @@
+#include "testing/testing.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/road_geometry_cache.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/math.hpp"
+#include "base/thread.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+void LoadRoad(uint32_t featureId, RoadGeometry & road)
+{
+  road = RoadGeometry(false /* oneWay */, 60.0 /* weightSpeedKMpH */, 60.0 /* etaSpeedKMpH */,
+                      RoadGeometry::Points({{0.0, 0.0}, {1.0, static_cast<double>(featureId)}}));
+}
+
+class CountingGeometryLoader final : public GeometryLoader
+{
+public:
+  explicit CountingGeometryLoader(uint32_t & loadsCounter) : m_loadsCounter(loadsCounter) {}
+
+  // GeometryLoader overrides:
+  void Load(uint32_t featureId, RoadGeometry & road) override
+  {
+    ++m_loadsCounter;
+    LoadRoad(featureId, road);
+  }
+
+private:
+  uint32_t & m_loadsCounter;
+};
+
+RoadGeometryCache::MwmKey MakeMwmKey(VehicleType vehicleType = VehicleType::Car)
+{
+  static MwmSet::MwmId const mwmId(make_shared<MwmInfo>());
+  return RoadGeometryCache::MwmKey(mwmId, vehicleType, false /* loadAltitudes */);
+}
+
+UNIT_TEST(RoadGeometryCache_HitsAndMisses)
+{
+  RoadGeometryCache cache;
+  auto const mwmKey = MakeMwmKey();
+  auto const loader = [](uint32_t featureId) {
+    return [featureId](RoadGeometry & road) { LoadRoad(featureId, road); };
+  };
+
+  auto const road = cache.GetRoad(mwmKey, 1 /* featureId */, loader(1));
+  TEST(road, ());
+  TEST_EQUAL(road->GetPoint(1), m2::PointD(1.0, 1.0), ());
+  TEST_EQUAL(cache.GetRoad(mwmKey, 1 /* featureId */, loader(1)), road, ());
+  cache.GetRoad(mwmKey, 2 /* featureId */, loader(2));
+  // Roads for other vehicle types are cached separately.
+  cache.GetRoad(MakeMwmKey(VehicleType::Pedestrian), 1 /* featureId */, loader(1));
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 3, ());
+  TEST_EQUAL(stats.m_evictions, 0, ());
+  TEST_EQUAL(stats.m_roadsNumber, 3, ());
+  TEST_GREATER(stats.m_sizeBytes, 0, ());
+  TEST(base::AlmostEqualAbs(stats.GetHitRate(), 0.25, 1e-9), (stats.GetHitRate()));
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetStats().m_roadsNumber, 0, ());
+  TEST_EQUAL(cache.GetStats().m_sizeBytes, 0, ());
+}
+
+UNIT_TEST(RoadGeometryCache_Eviction)
+{
+  RoadGeometryCache cache;
+  auto const mwmKey = MakeMwmKey();
+  uint32_t constexpr kRoadsNumber = 1000;
+  auto const firstRoad =
+      cache.GetRoad(mwmKey, 0 /* featureId */, [](RoadGeometry & road) { LoadRoad(0, road); });
+  for (uint32_t featureId = 1; featureId < kRoadsNumber; ++featureId)
+  {
+    cache.GetRoad(mwmKey, featureId,
+                  [featureId](RoadGeometry & road) { LoadRoad(featureId, road); });
+  }
+
+  size_t const sizeBytes = cache.GetStats().m_sizeBytes;
+  cache.SetMemoryBudget(sizeBytes / 4);
+
+  auto const stats = cache.GetStats();
+  TEST_GREATER(stats.m_evictions, 0, ());
+  TEST_LESS_OR_EQUAL(stats.m_sizeBytes, sizeBytes / 4, ());
+  TEST_EQUAL(stats.m_roadsNumber + stats.m_evictions, kRoadsNumber, ());
+
+  // An evicted road is valid while it's referred.
+  TEST(firstRoad->IsValid(), ());
+  TEST_EQUAL(firstRoad->GetPoint(1), m2::PointD(1.0, 0.0), ());
+}
+
+UNIT_TEST(RoadGeometryCache_SharedByGeometries)
+{
+  RoadGeometryCache cache;
+  auto const mwmKey = MakeMwmKey();
+  uint32_t loadsCounter = 0;
+  Geometry first(make_unique<CountingGeometryLoader>(loadsCounter), cache, mwmKey);
+  Geometry second(make_unique<CountingGeometryLoader>(loadsCounter), cache, mwmKey);
+
+  for (uint32_t featureId = 0; featureId < 10; ++featureId)
+  {
+    TEST_EQUAL(first.GetRoad(featureId).GetPoint(1), m2::PointD(1.0, featureId), ());
+    TEST_EQUAL(second.GetRoad(featureId).GetPoint(1), m2::PointD(1.0, featureId), ());
+  }
+
+  TEST_EQUAL(loadsCounter, 10, ());
+  TEST_EQUAL(cache.GetStats().m_hits, 10, ());
+}
+
+UNIT_TEST(RoadGeometryCache_Concurrency)
+{
+  RoadGeometryCache cache(16 * 1024 /* memoryBudgetBytes */);
+  auto const mwmKey = MakeMwmKey();
+  uint32_t constexpr kThreadsNumber = 4;
+  uint32_t constexpr kRequestsNumber = 10000;
+
+  vector<threads::SimpleThread> threads;
+  for (uint32_t i = 0; i < kThreadsNumber; ++i)
+  {
+    threads.emplace_back([&cache, &mwmKey, i]() {
+      for (uint32_t j = 0; j < kRequestsNumber; ++j)
+      {
+        uint32_t const featureId = (i * 7 + j) % 300;
+        auto const road = cache.GetRoad(
+            mwmKey, featureId, [featureId](RoadGeometry & road) { LoadRoad(featureId, road); });
+        CHECK_EQUAL(road->GetPoint(1), m2::PointD(1.0, featureId), ());
+      }
+    });
+  }
+
+  for (auto & thread : threads)
+    thread.join();
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits + stats.m_misses, kThreadsNumber * kRequestsNumber, ());
+  TEST_LESS_OR_EQUAL(stats.m_sizeBytes, 16 * 1024, ());
+}
+}  // namespace
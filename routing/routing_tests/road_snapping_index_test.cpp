@@ -0,0 +1,131 @@
+#include "testing/testing.hpp"
+
+#include "routing/road_snapping_index.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/stl_helpers.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+vector<uint8_t> Serialize(vector<RoadSnappingIndex::Road> const & roads)
+{
+  vector<uint8_t> data;
+  MemWriter<vector<uint8_t>> writer(data);
+  RoadSnappingIndex::Serialize(roads, writer);
+  return data;
+}
+
+vector<uint32_t> GetFeatures(RoadSnappingIndex const & index, m2::RectD const & rect,
+                             VehicleMask mask)
+{
+  vector<uint32_t> features;
+  index.ForEachFeature(rect, mask, [&features](uint32_t featureId) {
+    features.push_back(featureId);
+  });
+  base::SortUnique(features);
+  return features;
+}
+
+UNIT_TEST(RoadSnappingIndex_Smoke)
+{
+  vector<RoadSnappingIndex::Road> roads(3);
+  roads[0].m_featureId = 1;
+  roads[0].m_mask = kCarMask | kBicycleMask;
+  roads[0].m_points = {{0.0, 0.0}, {0.1, 0.0}};
+  roads[1].m_featureId = 5;
+  roads[1].m_mask = kPedestrianMask;
+  roads[1].m_points = {{0.05, -0.05}, {0.05, 0.05}};
+  roads[2].m_featureId = 7;
+  roads[2].m_mask = kCarMask;
+  roads[2].m_points = {{1.0, 1.0}, {1.0, 1.001}, {1.001, 1.001}};
+
+  RoadSnappingIndex index;
+  TEST(index.Init(Serialize(roads)), ());
+  TEST(!index.IsEmpty(), ());
+
+  m2::RectD const crossing(0.049, -0.001, 0.051, 0.001);
+  TEST_EQUAL(GetFeatures(index, crossing, kAllVehiclesMask), vector<uint32_t>({1, 5}), ());
+  TEST_EQUAL(GetFeatures(index, crossing, kCarMask), vector<uint32_t>({1}), ());
+  TEST_EQUAL(GetFeatures(index, crossing, kPedestrianMask), vector<uint32_t>({5}), ());
+  TEST_EQUAL(GetFeatures(index, m2::RectD(0.999, 0.999, 1.0001, 1.0001), kAllVehiclesMask),
+             vector<uint32_t>({7}), ());
+  TEST(GetFeatures(index, m2::RectD(0.5, 0.5, 0.51, 0.51), kAllVehiclesMask).empty(), ());
+}
+
+UNIT_TEST(RoadSnappingIndex_Random)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(10.0, 10.1);
+  uniform_real_distribution<double> shift(-0.02, 0.02);
+  uniform_int_distribution<uint32_t> mask(1, kAllVehiclesMask);
+
+  vector<RoadSnappingIndex::Road> roads(200);
+  for (uint32_t i = 0; i < roads.size(); ++i)
+  {
+    auto & road = roads[i];
+    road.m_featureId = 3 * i;
+    road.m_mask = mask(rng);
+    road.m_points.emplace_back(coord(rng), coord(rng));
+    for (size_t j = 0; j < 3; ++j)
+      road.m_points.push_back(road.m_points.back() + m2::PointD(shift(rng), shift(rng)));
+  }
+
+  RoadSnappingIndex index;
+  TEST(index.Init(Serialize(roads)), ());
+
+  // Every road whose points sampled along segments are in a rect should be found.
+  for (size_t i = 0; i < 200; ++i)
+  {
+    m2::PointD const center(coord(rng), coord(rng));
+    m2::RectD const rect(center - m2::PointD(0.001, 0.001), center + m2::PointD(0.001, 0.001));
+    VehicleMask const vehicleMask = GetVehicleMask(static_cast<VehicleType>(i % 3));
+    auto const features = GetFeatures(index, rect, vehicleMask);
+
+    for (auto const & road : roads)
+    {
+      bool inRect = false;
+      for (size_t j = 1; j < road.m_points.size() && !inRect; ++j)
+      {
+        auto const & p1 = road.m_points[j - 1];
+        auto const & p2 = road.m_points[j];
+        for (size_t k = 0; k <= 100 && !inRect; ++k)
+          inRect = rect.IsPointInside(p1 + (p2 - p1) * (k / 100.0));
+      }
+
+      bool const found = binary_search(features.begin(), features.end(), road.m_featureId);
+      if (inRect && (road.m_mask & vehicleMask) != 0)
+        TEST(found, (road.m_featureId, rect));
+      if ((road.m_mask & vehicleMask) == 0)
+        TEST(!found, (road.m_featureId));
+    }
+  }
+}
+
+UNIT_TEST(RoadSnappingIndex_Damaged)
+{
+  vector<RoadSnappingIndex::Road> roads(1);
+  roads[0].m_mask = kCarMask;
+  roads[0].m_points = {{0.0, 0.0}, {0.1, 0.0}};
+  auto data = Serialize(roads);
+
+  RoadSnappingIndex index;
+  TEST(!index.Init(vector<uint8_t>(data.begin(), data.begin() + 10)), ());
+  TEST(index.IsEmpty(), ());
+
+  data[0] = 1;
+  TEST(!index.Init(move(data)), ());
+  TEST(index.IsEmpty(), ());
+}
+}  // namespace
@@ -310,3 +310,32 @@ UNIT_TEST(RouteNameTest)
   route.GetCurrentStreetName(name);
   TEST_EQUAL(name, "Street3", ());
 }
+
+UNIT_TEST(SpeedCamerasOnRouteTest)
+{
+  Route route("TestRouter", 0 /* route id */);
+
+  route.SetGeometry(kTestGeometry.begin(), kTestGeometry.end());
+  vector<RouteSegment> routeSegments;
+  GetTestRouteSegments(kTestGeometry, kTestTurns2, kTestNames2, kTestTimes2, routeSegments);
+  routeSegments[0].SetSpeedCameraInfo({{0.5 /* coef */, 60 /* maxSpeedKmPH */}});
+  routeSegments[2].SetSpeedCameraInfo(
+      {{0.25 /* coef */, 90 /* maxSpeedKmPH */}, {0.75 /* coef */, 40 /* maxSpeedKmPH */}});
+  route.SetRouteSegments(routeSegments);
+
+  vector<SpeedCameraOnRoute> cameras;
+  route.GetSpeedCamerasOnRoute(cameras);
+  TEST_EQUAL(cameras.size(), 3, ());
+
+  double const segStartMeters = routeSegments[1].GetDistFromBeginningMeters();
+  double const segLenMeters = route.GetSegLenMeters(2);
+  TEST(base::AlmostEqualAbs(cameras[0].m_distFromBeginMeters,
+                            0.5 * routeSegments[0].GetDistFromBeginningMeters(), 0.1), ());
+  TEST(base::AlmostEqualAbs(cameras[1].m_distFromBeginMeters,
+                            segStartMeters + 0.25 * segLenMeters, 0.1), ());
+  TEST(base::AlmostEqualAbs(cameras[2].m_distFromBeginMeters,
+                            segStartMeters + 0.75 * segLenMeters, 0.1), ());
+  TEST_EQUAL(cameras[0].m_maxSpeedKmH, 60, ());
+  TEST_EQUAL(cameras[1].m_maxSpeedKmH, 90, ());
+  TEST_EQUAL(cameras[2].m_maxSpeedKmH, 40, ());
+}
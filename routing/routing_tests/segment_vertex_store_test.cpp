@@ -0,0 +1,96 @@
+#include "testing/testing.hpp"
+
+#include "routing/base/astar_vertex_store.hpp"
+#include "routing/route_weight.hpp"
+#include "routing/segment.hpp"
+#include "routing/segment_vertex_store.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+vector<Segment> MakeSegments()
+{
+  vector<Segment> segments;
+  for (NumMwmId mwmId : {NumMwmId(0), NumMwmId(7), kFakeNumMwmId})
+  {
+    for (uint32_t featureId = 0; featureId < 50; ++featureId)
+    {
+      for (uint32_t segmentIdx = 0; segmentIdx < 10; ++segmentIdx)
+      {
+        segments.emplace_back(mwmId, featureId, segmentIdx, true /* forward */);
+        segments.emplace_back(mwmId, featureId, segmentIdx, false /* forward */);
+      }
+    }
+  }
+  return segments;
+}
+
+UNIT_TEST(SegmentVertexStore_SameAsMapVertexStore)
+{
+  vector<Segment> const segments = MakeSegments();
+  SegmentVertexStore store;
+  MapVertexStore<Segment, RouteWeight> expected;
+
+  for (size_t i = 0; i < segments.size(); i += 2)
+  {
+    RouteWeight const distance(static_cast<double>(i));
+    store.SetDistance(segments[i], distance);
+    expected.SetDistance(segments[i], distance);
+    if (i >= 3)
+    {
+      store.SetParent(segments[i], segments[i - 3]);
+      expected.SetParent(segments[i], segments[i - 3]);
+    }
+  }
+
+  // Distances of some segments are overwritten.
+  for (size_t i = 0; i < segments.size(); i += 10)
+  {
+    store.SetDistance(segments[i], RouteWeight(-1.0));
+    expected.SetDistance(segments[i], RouteWeight(-1.0));
+  }
+
+  for (auto const & segment : segments)
+  {
+    RouteWeight const * distance = store.GetDistance(segment);
+    RouteWeight const * expectedDistance = expected.GetDistance(segment);
+    TEST_EQUAL(distance == nullptr, expectedDistance == nullptr, (segment));
+    if (distance != nullptr)
+      TEST_EQUAL(*distance, *expectedDistance, (segment));
+
+    Segment parent;
+    Segment expectedParent;
+    bool const hasParent = store.GetParent(segment, parent);
+    TEST_EQUAL(hasParent, expected.GetParent(segment, expectedParent), (segment));
+    if (hasParent)
+      TEST_EQUAL(parent, expectedParent, (segment));
+  }
+}
+
+UNIT_TEST(SegmentVertexStore_Clear)
+{
+  Segment const first(0 /* mwmId */, 1 /* featureId */, 2 /* segmentIdx */, true /* forward */);
+  Segment const second(0 /* mwmId */, 1 /* featureId */, 2 /* segmentIdx */, false /* forward */);
+
+  SegmentVertexStore store;
+  store.SetParent(second, first);
+  // A parent has no distance until it's set.
+  TEST(store.GetDistance(first) == nullptr, ());
+  TEST(store.GetDistance(second) == nullptr, ());
+  store.SetDistance(second, RouteWeight(1.0));
+  TEST_EQUAL(store.GetSize(), 2, ());
+
+  store.Clear();
+  TEST_EQUAL(store.GetSize(), 0, ());
+  TEST(store.GetDistance(second) == nullptr, ());
+  Segment parent;
+  TEST(!store.GetParent(second, parent), ());
+}
+}  // namespace
@@ -0,0 +1,110 @@
+#include "testing/testing.hpp"
+
+#include "routing/speed_profiles.hpp"
+
+#include "coding/writer.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+uint32_t constexpr kBucketSec = SpeedProfiles::kBucketSec;
+
+vector<uint8_t> Serialize(vector<SpeedProfiles::Profile> const & profiles)
+{
+  vector<uint8_t> data;
+  MemWriter<vector<uint8_t>> writer(data);
+  SpeedProfiles::Serialize(profiles, writer);
+  return data;
+}
+
+UNIT_TEST(SpeedProfiles_GetFactor)
+{
+  vector<SpeedProfiles::Profile> profiles(3);
+  profiles[0].m_featureId = 1;
+  profiles[0].m_isForward = false;
+  profiles[0].m_levels[0] = 5;
+  profiles[0].m_levels[1] = 10;
+  profiles[0].m_levels[SpeedProfiles::kBucketsCount - 1] = 15;
+  profiles[1].m_featureId = 1;
+  profiles[1].m_isForward = true;
+  profiles[1].m_levels[0] = 5;
+  profiles[1].m_levels[1] = 10;
+  profiles[1].m_levels[SpeedProfiles::kBucketsCount - 1] = 15;
+  profiles[2].m_featureId = 8;
+  profiles[2].m_levels[100] = 2;
+
+  auto const data = Serialize(profiles);
+  SpeedProfiles speedProfiles;
+  TEST(speedProfiles.Init(data), ());
+  TEST(!speedProfiles.IsEmpty(), ());
+
+  // Equal profiles share a pattern.
+  size_t constexpr kHeaderSize = 3 * sizeof(uint32_t);
+  TEST_EQUAL(data.size(), kHeaderSize + 2 * SpeedProfiles::kPatternSize +
+                              profiles.size() * (sizeof(uint32_t) + sizeof(uint16_t)),
+             ());
+
+  double constexpr kEps = 1e-9;
+  // Middles of buckets.
+  TEST(base::AlmostEqualAbs(speedProfiles.GetFactor(1, true, kBucketSec / 2), 0.5, kEps), ());
+  TEST(base::AlmostEqualAbs(speedProfiles.GetFactor(1, false, 3 * kBucketSec / 2), 1.0, kEps), ());
+  // Between buckets.
+  TEST(base::AlmostEqualAbs(speedProfiles.GetFactor(1, true, kBucketSec), 0.75, kEps), ());
+  // The week is cyclic.
+  TEST(base::AlmostEqualAbs(speedProfiles.GetFactor(1, true, 0), 1.0, kEps), ());
+  TEST(base::AlmostEqualAbs(speedProfiles.GetFactor(1, true, SpeedProfiles::kWeekSec - kBucketSec / 2),
+                            1.5, kEps), ());
+  // Buckets without data have factor 1.
+  TEST(base::AlmostEqualAbs(speedProfiles.GetFactor(8, true, 100 * kBucketSec + kBucketSec / 2),
+                            0.2, kEps), ());
+  TEST(base::AlmostEqualAbs(speedProfiles.GetFactor(8, true, 100 * kBucketSec), 0.6, kEps), ());
+  TEST_EQUAL(speedProfiles.GetFactor(8, true, 0), 1.0, ());
+  // Features and directions without profiles.
+  TEST_EQUAL(speedProfiles.GetFactor(8, false, 100 * kBucketSec), 1.0, ());
+  TEST_EQUAL(speedProfiles.GetFactor(5, true, 0), 1.0, ());
+  TEST_EQUAL(speedProfiles.GetFactor(100, true, 0), 1.0, ());
+}
+
+UNIT_TEST(SpeedProfiles_Damaged)
+{
+  vector<SpeedProfiles::Profile> profiles(1);
+  profiles[0].m_levels[0] = 1;
+  auto data = Serialize(profiles);
+
+  SpeedProfiles speedProfiles;
+  TEST(!speedProfiles.Init(vector<uint8_t>(data.begin(), data.end() - 1)), ());
+  TEST(speedProfiles.IsEmpty(), ());
+
+  data[0] = 1;
+  TEST(!speedProfiles.Init(data), ());
+  TEST(speedProfiles.IsEmpty(), ());
+}
+
+UNIT_TEST(SpeedProfiles_FactorToLevel)
+{
+  TEST_EQUAL(SpeedProfiles::FactorToLevel(0.0), 1, ());
+  TEST_EQUAL(SpeedProfiles::FactorToLevel(0.52), 5, ());
+  TEST_EQUAL(SpeedProfiles::FactorToLevel(1.0), 10, ());
+  TEST_EQUAL(SpeedProfiles::FactorToLevel(3.0), SpeedProfiles::kMaxLevel, ());
+}
+
+UNIT_TEST(SpeedProfiles_GetWeekTimeSec)
+{
+  // 2018-10-01 00:00:00 UTC is Monday.
+  time_t constexpr kMonday = 1538352000;
+  TEST_EQUAL(SpeedProfiles::GetWeekTimeSec(kMonday, 0.0 /* lon */), 0, ());
+  TEST_EQUAL(SpeedProfiles::GetWeekTimeSec(kMonday + 90, 2.0 /* lon */), 90, ());
+  // Moscow is 3 hours ahead of UTC by the solar time.
+  TEST_EQUAL(SpeedProfiles::GetWeekTimeSec(kMonday, 37.6 /* lon */), 3 * 60 * 60, ());
+  // It's still Sunday in America.
+  TEST_EQUAL(SpeedProfiles::GetWeekTimeSec(kMonday, -75.0 /* lon */),
+             SpeedProfiles::kWeekSec - 5 * 60 * 60, ());
+}
+}  // namespace
@@ -0,0 +1,99 @@
+#include "testing/testing.hpp"
+
+#include "routing/transit_raptor.hpp"
+
+#include "transit/transit_types.hpp"
+
+#include <map>
+#include <vector>
+
+using namespace routing;
+using namespace routing::transit;
+using namespace std;
+
+namespace
+{
+Edge MakeEdge(StopId stop1Id, StopId stop2Id, Weight weight, LineId lineId)
+{
+  return Edge(stop1Id, stop2Id, weight, lineId, false /* transfer */, {} /* shapeIds */);
+}
+
+Edge MakeTransfer(StopId stop1Id, StopId stop2Id, Weight weight)
+{
+  return Edge(stop1Id, stop2Id, weight, kInvalidLineId, true /* transfer */, {} /* shapeIds */);
+}
+
+Line MakeLine(LineId id, Ranges const & stopIds, Weight interval)
+{
+  return Line(id, "" /* number */, "" /* title */, "subway" /* type */, "red" /* color */,
+              0 /* networkId */, stopIds, interval);
+}
+
+// Line 1: 0 -> 1 -> 2 -> 3, interval 600 s.
+// Line 2: 10 -> 11 -> 12, interval 120 s.
+// Transfer 1 -> 10 takes 60 s.
+TransitRaptor MakeRaptor()
+{
+  vector<Edge> const edges = {MakeEdge(0, 1, 100, 1), MakeEdge(1, 2, 100, 1),
+                              MakeEdge(2, 3, 100, 1), MakeEdge(10, 11, 50, 2),
+                              MakeEdge(11, 12, 50, 2), MakeTransfer(1, 10, 60)};
+  vector<Line> const lines = {MakeLine(1, {{0, 1, 2, 3}}, 600), MakeLine(2, {{10, 11, 12}}, 120)};
+  return TransitRaptor(edges, lines);
+}
+}  // namespace
+
+UNIT_TEST(TransitRaptor_SingleLine)
+{
+  TransitRaptor const raptor = MakeRaptor();
+  TEST_EQUAL(raptor.GetStopsCount(), 7, ());
+  TEST_EQUAL(raptor.GetRoutesCount(), 2, ());
+
+  TransitRaptor::Journey journey;
+  TEST(raptor.FindJourney({{0, 10.0}}, {{3, 5.0}}, 3 /* maxRounds */, journey), ());
+  // 10 s to the stop, 300 s of waiting, 300 s on board and 5 s to the finish.
+  TEST_EQUAL(journey.m_arrival, 615.0, ());
+  TEST_EQUAL(journey.m_legs.size(), 1, ());
+  TEST_EQUAL(journey.m_legs[0].m_from, 0, ());
+  TEST_EQUAL(journey.m_legs[0].m_to, 3, ());
+  TEST_EQUAL(journey.m_legs[0].m_lineId, 1, ());
+}
+
+UNIT_TEST(TransitRaptor_Transfer)
+{
+  TransitRaptor const raptor = MakeRaptor();
+
+  TransitRaptor::Journey journey;
+  TEST(raptor.FindJourney({{0, 0.0}}, {{12, 0.0}}, 3 /* maxRounds */, journey), ());
+  // 300 + 100 on line 1, 60 to walk, 60 + 100 on line 2.
+  TEST_EQUAL(journey.m_arrival, 620.0, ());
+  TEST_EQUAL(journey.m_legs.size(), 3, ());
+  TEST_EQUAL(journey.m_legs[0].m_lineId, 1, ());
+  TEST_EQUAL(journey.m_legs[1].m_lineId, kInvalidLineId, ());
+  TEST_EQUAL(journey.m_legs[1].m_from, 1, ());
+  TEST_EQUAL(journey.m_legs[1].m_to, 10, ());
+  TEST_EQUAL(journey.m_legs[2].m_lineId, 2, ());
+  TEST_EQUAL(journey.m_legs[2].m_to, 12, ());
+
+  // One boarding is not enough to get to line 2.
+  TEST(!raptor.FindJourney({{0, 0.0}}, {{12, 0.0}}, 1 /* maxRounds */, journey), ());
+}
+
+UNIT_TEST(TransitRaptor_BestTarget)
+{
+  TransitRaptor const raptor = MakeRaptor();
+
+  TransitRaptor::Journey journey;
+  // Walking from stop 2 to the finish is long, it's better to ride to stop 3.
+  map<StopId, double> const targets = {{2, 1000.0}, {3, 10.0}};
+  TEST(raptor.FindJourney({{0, 0.0}}, targets, 3 /* maxRounds */, journey), ());
+  TEST_EQUAL(journey.m_arrival, 610.0, ());
+  TEST_EQUAL(journey.m_legs.back().m_to, 3, ());
+
+  // A source which is a target as well doesn't need transit.
+  TEST(raptor.FindJourney({{3, 1.0}}, {{3, 2.0}}, 3 /* maxRounds */, journey), ());
+  TEST_EQUAL(journey.m_arrival, 3.0, ());
+  TEST(journey.m_legs.empty(), ());
+
+  // Lines are directed.
+  TEST(!raptor.FindJourney({{3, 0.0}}, {{0, 0.0}}, 3 /* maxRounds */, journey), ());
+}
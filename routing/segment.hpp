@@ -6,7 +6,9 @@
 
 #include "routing_common/num_mwm_id.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <sstream>
 #include <string>
 
@@ -128,3 +130,19 @@ inline std::string DebugPrint(SegmentEdge const & edge)
   return out.str();
 }
 }  // namespace routing
+
+namespace std
+{
+template <>
+struct hash<routing::Segment>
+{
+  size_t operator()(routing::Segment const & s) const
+  {
+    uint64_t const id = (static_cast<uint64_t>(s.GetFeatureId()) << 32) ^
+                        (static_cast<uint64_t>(s.GetMwmId()) << 16) ^
+                        (static_cast<uint64_t>(s.GetSegmentIdx()) << 1) ^
+                        static_cast<uint64_t>(s.IsForward());
+    return hash<uint64_t>()(id);
+  }
+};
+}  // namespace std
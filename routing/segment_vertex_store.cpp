@@ -0,0 +1,144 @@
+#include "routing/segment_vertex_store.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+using namespace std;
+
+namespace
+{
+size_t constexpr kInitialTableSize = 1024;
+}  // namespace
+
+namespace routing
+{
+// static
+uint32_t constexpr SegmentVertexStore::kNoOrdinal;
+// static
+uint32_t constexpr SegmentVertexStore::kForwardBit;
+// static
+uint32_t constexpr SegmentVertexStore::kHasDistanceBit;
+
+SegmentVertexStore::SegmentVertexStore() : m_table(kInitialTableSize, kNoOrdinal) {}
+
+void SegmentVertexStore::Clear()
+{
+  // Capacities of the arrays are kept for the next wave.
+  m_table.assign(kInitialTableSize, kNoOrdinal);
+  m_featureIds.clear();
+  m_segmentIdxs.clear();
+  m_mwmIdsAndFlags.clear();
+  m_distances.clear();
+  m_parents.clear();
+}
+
+RouteWeight const * SegmentVertexStore::GetDistance(Segment const & segment) const
+{
+  uint32_t const ordinal = Find(segment);
+  if (ordinal == kNoOrdinal || (m_mwmIdsAndFlags[ordinal] & kHasDistanceBit) == 0)
+    return nullptr;
+
+  return &m_distances[ordinal];
+}
+
+void SegmentVertexStore::SetDistance(Segment const & segment, RouteWeight const & distance)
+{
+  uint32_t const ordinal = Insert(segment);
+  m_distances[ordinal] = distance;
+  m_mwmIdsAndFlags[ordinal] |= kHasDistanceBit;
+}
+
+bool SegmentVertexStore::GetParent(Segment const & segment, Segment & parent) const
+{
+  uint32_t const ordinal = Find(segment);
+  if (ordinal == kNoOrdinal || m_parents[ordinal] == kNoOrdinal)
+    return false;
+
+  parent = GetSegment(m_parents[ordinal]);
+  return true;
+}
+
+void SegmentVertexStore::SetParent(Segment const & segment, Segment const & parent)
+{
+  uint32_t const parentOrdinal = Insert(parent);
+  uint32_t const ordinal = Insert(segment);
+  m_parents[ordinal] = parentOrdinal;
+}
+
+// static
+size_t SegmentVertexStore::Hash(Segment const & segment)
+{
+  uint64_t const key = (static_cast<uint64_t>(segment.GetFeatureId()) << 32) ^
+                       (static_cast<uint64_t>(segment.GetMwmId()) << 17) ^
+                       (static_cast<uint64_t>(segment.GetSegmentIdx()) << 1) ^
+                       (segment.IsForward() ? 1 : 0);
+  // Fibonacci hashing. High bits are the best mixed ones.
+  return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+uint32_t SegmentVertexStore::Find(Segment const & segment) const
+{
+  size_t const mask = m_table.size() - 1;
+  for (size_t cell = Hash(segment) & mask;; cell = (cell + 1) & mask)
+  {
+    uint32_t const ordinal = m_table[cell];
+    if (ordinal == kNoOrdinal || IsSegment(ordinal, segment))
+      return ordinal;
+  }
+}
+
+uint32_t SegmentVertexStore::Insert(Segment const & segment)
+{
+  // The load factor is kept not greater than 1/2.
+  if (2 * (m_featureIds.size() + 1) > m_table.size())
+    Rehash(2 * m_table.size());
+
+  size_t const mask = m_table.size() - 1;
+  size_t cell = Hash(segment) & mask;
+  for (; m_table[cell] != kNoOrdinal; cell = (cell + 1) & mask)
+  {
+    if (IsSegment(m_table[cell], segment))
+      return m_table[cell];
+  }
+
+  uint32_t const ordinal = base::asserted_cast<uint32_t>(m_featureIds.size());
+  CHECK_NOT_EQUAL(ordinal, kNoOrdinal, ());
+  m_table[cell] = ordinal;
+  m_featureIds.push_back(segment.GetFeatureId());
+  m_segmentIdxs.push_back(segment.GetSegmentIdx());
+  m_mwmIdsAndFlags.push_back(static_cast<uint32_t>(segment.GetMwmId()) |
+                             (segment.IsForward() ? kForwardBit : 0));
+  m_distances.emplace_back();
+  m_parents.push_back(kNoOrdinal);
+  return ordinal;
+}
+
+bool SegmentVertexStore::IsSegment(uint32_t ordinal, Segment const & segment) const
+{
+  return m_featureIds[ordinal] == segment.GetFeatureId() &&
+         m_segmentIdxs[ordinal] == segment.GetSegmentIdx() &&
+         (m_mwmIdsAndFlags[ordinal] & (kForwardBit - 1)) == segment.GetMwmId() &&
+         ((m_mwmIdsAndFlags[ordinal] & kForwardBit) != 0) == segment.IsForward();
+}
+
+Segment SegmentVertexStore::GetSegment(uint32_t ordinal) const
+{
+  uint32_t const mwmIdAndFlags = m_mwmIdsAndFlags[ordinal];
+  return Segment(static_cast<NumMwmId>(mwmIdAndFlags & (kForwardBit - 1)), m_featureIds[ordinal],
+                 m_segmentIdxs[ordinal], (mwmIdAndFlags & kForwardBit) != 0);
+}
+
+void SegmentVertexStore::Rehash(size_t tableSize)
+{
+  ASSERT_EQUAL(tableSize & (tableSize - 1), 0, ("Table size should be a power of two."));
+  m_table.assign(tableSize, kNoOrdinal);
+  size_t const mask = tableSize - 1;
+  for (uint32_t ordinal = 0; ordinal < m_featureIds.size(); ++ordinal)
+  {
+    size_t cell = Hash(GetSegment(ordinal)) & mask;
+    while (m_table[cell] != kNoOrdinal)
+      cell = (cell + 1) & mask;
+    m_table[cell] = ordinal;
+  }
+}
+}  // namespace routing
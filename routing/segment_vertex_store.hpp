@@ -0,0 +1,63 @@
+#pragma once
+
+#include "routing/route_weight.hpp"
+#include "routing/segment.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace routing
+{
+// Distances and parents of segments of an A* wave. It's used by AStarAlgorithm::Context
+// for graphs with Segment vertices instead of std::map.
+//
+// Every segment which is met gets an ordinal. The fields of the segments, their distances and
+// ordinals of their parents are kept in flat arrays indexed by the ordinal. Segments are mapped
+// to ordinals with an open addressing hash table of uint32_t. So a settled segment takes about
+// 50 bytes instead of about 140 bytes of two std::map nodes and the wave doesn't jump over
+// the heap.
+class SegmentVertexStore final
+{
+public:
+  SegmentVertexStore();
+
+  void Clear();
+
+  /// \returns nullptr if the distance of |segment| is not set.
+  RouteWeight const * GetDistance(Segment const & segment) const;
+  void SetDistance(Segment const & segment, RouteWeight const & distance);
+
+  /// \returns false if |segment| has no parent.
+  bool GetParent(Segment const & segment, Segment & parent) const;
+  void SetParent(Segment const & segment, Segment const & parent);
+
+  size_t GetSize() const { return m_featureIds.size(); }
+
+private:
+  static uint32_t constexpr kNoOrdinal = std::numeric_limits<uint32_t>::max();
+  static uint32_t constexpr kForwardBit = 1 << 16;
+  static uint32_t constexpr kHasDistanceBit = 1 << 17;
+
+  static size_t Hash(Segment const & segment);
+
+  uint32_t Find(Segment const & segment) const;
+  uint32_t Insert(Segment const & segment);
+  bool IsSegment(uint32_t ordinal, Segment const & segment) const;
+  Segment GetSegment(uint32_t ordinal) const;
+  void Rehash(size_t tableSize);
+
+  // Ordinals of segments, kNoOrdinal for empty cells. The size is a power of two.
+  std::vector<uint32_t> m_table;
+
+  // Segments by ordinals.
+  std::vector<uint32_t> m_featureIds;
+  std::vector<uint32_t> m_segmentIdxs;
+  // Mwm id in low 16 bits, kForwardBit and kHasDistanceBit.
+  std::vector<uint32_t> m_mwmIdsAndFlags;
+
+  // Distances and ordinals of parents by ordinals of segments.
+  std::vector<RouteWeight> m_distances;
+  std::vector<uint32_t> m_parents;
+};
+}  // namespace routing
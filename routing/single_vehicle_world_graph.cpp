@@ -1,15 +1,21 @@
 #include "routing/single_vehicle_world_graph.hpp"
 
+#include "routing/landmarks.hpp"
+
+#include <algorithm>
 #include <utility>
 
 namespace routing
 {
 using namespace std;
 
-SingleVehicleWorldGraph::SingleVehicleWorldGraph(unique_ptr<CrossMwmGraph> crossMwmGraph,
-                                                 unique_ptr<IndexGraphLoader> loader,
-                                                 shared_ptr<EdgeEstimator> estimator)
-  : m_crossMwmGraph(move(crossMwmGraph)), m_loader(move(loader)), m_estimator(estimator)
+SingleVehicleWorldGraph::SingleVehicleWorldGraph(
+    unique_ptr<CrossMwmGraph> crossMwmGraph, unique_ptr<IndexGraphLoader> loader,
+    shared_ptr<EdgeEstimator> estimator, shared_ptr<CrossMwmTrafficWeights> crossMwmTrafficWeights)
+  : m_crossMwmGraph(move(crossMwmGraph))
+  , m_loader(move(loader))
+  , m_estimator(estimator)
+  , m_crossMwmTrafficWeights(move(crossMwmTrafficWeights))
 {
   CHECK(m_loader, ());
   CHECK(m_estimator, ());
@@ -25,9 +31,26 @@ void SingleVehicleWorldGraph::GetEdgeList(Segment const & segment, bool isOutgoi
     // to calculate |segment| weight. See https://jira.mail.ru/browse/MAPSME-5743 for details.
     CHECK(isOutgoing, ("Ingoing edges listing is not supported for LeapsOnly mode."));
     if (m_crossMwmGraph->IsTransition(segment, isOutgoing))
+    {
       GetTwins(segment, isOutgoing, edges);
-    else
-      m_crossMwmGraph->GetOutgoingEdgeList(segment, edges);
+      return;
+    }
+
+    // Note. Leaps of mwms with traffic are calculated with the index graph of the mwm. So the graph
+    // is loaded in LeapsOnly mode for such mwms.
+    NumMwmId const mwmId = segment.GetMwmId();
+    if (m_crossMwmTrafficWeights && !m_estimator->LeapIsAllowed(mwmId))
+    {
+      edges.clear();
+      if (m_crossMwmTrafficWeights->GetOutgoingEdgeList(
+              segment, m_crossMwmGraph->GetTransitions(mwmId, false /* isEnter */),
+              m_loader->GetIndexGraph(mwmId), edges))
+      {
+        return;
+      }
+    }
+
+    m_crossMwmGraph->GetOutgoingEdgeList(segment, edges);
     return;
   }
 
@@ -75,7 +98,19 @@ void SingleVehicleWorldGraph::GetIngoingEdgesList(Segment const & segment,
 
 RouteWeight SingleVehicleWorldGraph::HeuristicCostEstimate(Segment const & from, Segment const & to)
 {
-  return HeuristicCostEstimate(GetPoint(from, true /* front */), GetPoint(to, true /* front */));
+  RouteWeight const heuristic =
+      HeuristicCostEstimate(GetPoint(from, true /* front */), GetPoint(to, true /* front */));
+
+  // Landmarks distances are calculated inside one mwm. So the landmark heuristic is consistent
+  // only if the search doesn't leave the mwm.
+  if (m_mode != Mode::SingleMwm || from.GetMwmId() != to.GetMwmId())
+    return heuristic;
+
+  IndexGraph & indexGraph = m_loader->GetIndexGraph(from.GetMwmId());
+  if (indexGraph.GetLandmarks().IsEmpty())
+    return heuristic;
+
+  return max(heuristic, RouteWeight(CalcLandmarkHeuristic(indexGraph, from, to)));
 }
 
 RouteWeight SingleVehicleWorldGraph::HeuristicCostEstimate(m2::PointD const & from,
@@ -84,6 +119,21 @@ RouteWeight SingleVehicleWorldGraph::HeuristicCostEstimate(m2::PointD const & fr
   return RouteWeight(m_estimator->CalcHeuristic(from, to));
 }
 
+bool SingleVehicleWorldGraph::GetLandmarkDistances(Segment const & segment, bool front,
+                                                   LandmarkDistances & distances)
+{
+  // See HeuristicCostEstimate(Segment const &, Segment const &).
+  if (m_mode != Mode::SingleMwm)
+    return false;
+
+  IndexGraph & indexGraph = m_loader->GetIndexGraph(segment.GetMwmId());
+  if (indexGraph.GetLandmarks().IsEmpty())
+    return false;
+
+  CalcLandmarkDistances(indexGraph, segment.GetRoadPoint(front), distances);
+  return true;
+}
+
 RouteWeight SingleVehicleWorldGraph::CalcSegmentWeight(Segment const & segment)
 {
   return RouteWeight(m_estimator->CalcSegmentWeight(
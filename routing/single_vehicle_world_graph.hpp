@@ -1,6 +1,7 @@
 #pragma once
 
 #include "routing/cross_mwm_graph.hpp"
+#include "routing/cross_mwm_traffic_weights.hpp"
 #include "routing/edge_estimator.hpp"
 #include "routing/geometry.hpp"
 #include "routing/index_graph.hpp"
@@ -25,7 +26,8 @@ class SingleVehicleWorldGraph final : public WorldGraph
 public:
   SingleVehicleWorldGraph(std::unique_ptr<CrossMwmGraph> crossMwmGraph,
                           std::unique_ptr<IndexGraphLoader> loader,
-                          std::shared_ptr<EdgeEstimator> estimator);
+                          std::shared_ptr<EdgeEstimator> estimator,
+                          std::shared_ptr<CrossMwmTrafficWeights> crossMwmTrafficWeights);
 
   // WorldGraph overrides:
   ~SingleVehicleWorldGraph() override = default;
@@ -44,6 +46,8 @@ public:
   void GetIngoingEdgesList(Segment const & segment, std::vector<SegmentEdge> & edges) override;
   RouteWeight HeuristicCostEstimate(Segment const & from, Segment const & to) override;
   RouteWeight HeuristicCostEstimate(m2::PointD const & from, m2::PointD const & to) override;
+  bool GetLandmarkDistances(Segment const & segment, bool front,
+                            LandmarkDistances & distances) override;
   RouteWeight CalcSegmentWeight(Segment const & segment) override;
   RouteWeight CalcLeapWeight(m2::PointD const & from, m2::PointD const & to) const override;
   RouteWeight CalcOffroadWeight(m2::PointD const & from, m2::PointD const & to) const override;
@@ -68,6 +72,9 @@ private:
   std::unique_ptr<CrossMwmGraph> m_crossMwmGraph;
   std::unique_ptr<IndexGraphLoader> m_loader;
   std::shared_ptr<EdgeEstimator> m_estimator;
+  // Leap weights for mwms with traffic. May be nullptr, then leap weights of cross mwm sections
+  // are used for all mwms.
+  std::shared_ptr<CrossMwmTrafficWeights> m_crossMwmTrafficWeights;
   Mode m_mode = Mode::NoLeaps;
 };
 }  // namespace routing
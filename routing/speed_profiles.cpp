@@ -0,0 +1,192 @@
+#include "routing/speed_profiles.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/gmtime.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+
+using namespace std;
+
+namespace
+{
+using Pattern = array<uint8_t, routing::SpeedProfiles::kPatternSize>;
+
+template <typename T>
+T ReadFromData(vector<uint8_t> const & data, size_t pos)
+{
+  T value;
+  memcpy(&value, data.data() + pos, sizeof(value));
+  return SwapIfBigEndianMacroBased(value);
+}
+
+uint32_t GetKey(uint32_t featureId, bool isForward)
+{
+  CHECK_LESS(featureId, numeric_limits<uint32_t>::max() >> 1, ());
+  return (featureId << 1) | (isForward ? 1 : 0);
+}
+}  // namespace
+
+namespace routing
+{
+// static
+uint32_t constexpr SpeedProfiles::kBucketSec;
+// static
+uint32_t constexpr SpeedProfiles::kWeekSec;
+// static
+uint32_t constexpr SpeedProfiles::kBucketsCount;
+// static
+size_t constexpr SpeedProfiles::kPatternSize;
+// static
+uint8_t constexpr SpeedProfiles::kNoDataLevel;
+// static
+uint8_t constexpr SpeedProfiles::kMaxLevel;
+// static
+double constexpr SpeedProfiles::kFactorStep;
+// static
+uint32_t constexpr SpeedProfiles::kVersion;
+
+// static
+uint8_t SpeedProfiles::FactorToLevel(double factor)
+{
+  double const level = round(factor / kFactorStep);
+  return static_cast<uint8_t>(max(1.0, min(level, static_cast<double>(kMaxLevel))));
+}
+
+// static
+uint32_t SpeedProfiles::GetWeekTimeSec(time_t utcTime, double lon)
+{
+  auto const offsetSec = static_cast<time_t>(round(lon / 15.0)) * 60 * 60;
+  tm const t = base::GmTime(utcTime + offsetSec);
+  // tm_wday is 0 for Sunday.
+  uint32_t const day = static_cast<uint32_t>((t.tm_wday + 6) % 7);
+  return day * 24 * 60 * 60 + static_cast<uint32_t>(t.tm_hour * 60 * 60 + t.tm_min * 60 + t.tm_sec);
+}
+
+// static
+void SpeedProfiles::Serialize(vector<Profile> const & profiles, Writer & writer)
+{
+  map<Pattern, uint16_t> patternIds;
+  vector<Pattern const *> patterns;
+  vector<uint16_t> ids;
+  ids.reserve(profiles.size());
+  for (size_t i = 0; i < profiles.size(); ++i)
+  {
+    auto const & profile = profiles[i];
+    CHECK(i == 0 || GetKey(profiles[i - 1].m_featureId, profiles[i - 1].m_isForward) <
+                        GetKey(profile.m_featureId, profile.m_isForward),
+          ());
+
+    Pattern pattern;
+    for (size_t j = 0; j < kPatternSize; ++j)
+    {
+      CHECK_LESS_OR_EQUAL(profile.m_levels[2 * j], kMaxLevel, ());
+      CHECK_LESS_OR_EQUAL(profile.m_levels[2 * j + 1], kMaxLevel, ());
+      pattern[j] = static_cast<uint8_t>(profile.m_levels[2 * j] | (profile.m_levels[2 * j + 1] << 4));
+    }
+
+    auto const res = patternIds.emplace(pattern, base::checked_cast<uint16_t>(patterns.size()));
+    if (res.second)
+      patterns.push_back(&res.first->first);
+    ids.push_back(res.first->second);
+  }
+
+  WriteToSink(writer, kVersion);
+  WriteToSink(writer, base::checked_cast<uint32_t>(patterns.size()));
+  WriteToSink(writer, base::checked_cast<uint32_t>(profiles.size()));
+  for (auto const * pattern : patterns)
+    writer.Write(pattern->data(), pattern->size());
+  for (auto const & profile : profiles)
+    WriteToSink(writer, GetKey(profile.m_featureId, profile.m_isForward));
+  for (auto const id : ids)
+    WriteToSink(writer, id);
+
+  LOG(LINFO, ("Speed profiles:", profiles.size(), "patterns:", patterns.size()));
+}
+
+bool SpeedProfiles::Init(vector<uint8_t> const & data)
+{
+  m_patterns.clear();
+  m_keys.clear();
+  m_patternIds.clear();
+  m_features.clear();
+
+  size_t constexpr kHeaderSize = 3 * sizeof(uint32_t);
+  if (data.size() < kHeaderSize)
+    return false;
+
+  auto const version = ReadFromData<uint32_t>(data, 0 /* pos */);
+  if (version != kVersion)
+  {
+    LOG(LWARNING, ("Unknown version of speed profiles:", version));
+    return false;
+  }
+
+  size_t const numPatterns = ReadFromData<uint32_t>(data, sizeof(uint32_t));
+  size_t const numProfiles = ReadFromData<uint32_t>(data, 2 * sizeof(uint32_t));
+  size_t const keysPos = kHeaderSize + numPatterns * kPatternSize;
+  size_t const idsPos = keysPos + numProfiles * sizeof(uint32_t);
+  if (data.size() != idsPos + numProfiles * sizeof(uint16_t))
+    return false;
+
+  vector<uint32_t> keys(numProfiles);
+  vector<uint16_t> patternIds(numProfiles);
+  vector<bool> features;
+  for (size_t i = 0; i < numProfiles; ++i)
+  {
+    keys[i] = ReadFromData<uint32_t>(data, keysPos + i * sizeof(uint32_t));
+    patternIds[i] = ReadFromData<uint16_t>(data, idsPos + i * sizeof(uint16_t));
+    if ((i != 0 && keys[i - 1] >= keys[i]) || patternIds[i] >= numPatterns)
+      return false;
+
+    uint32_t const featureId = keys[i] >> 1;
+    if (featureId >= features.size())
+      features.resize(featureId + 1, false);
+    features[featureId] = true;
+  }
+
+  m_patterns.assign(data.begin() + kHeaderSize, data.begin() + keysPos);
+  m_keys = move(keys);
+  m_patternIds = move(patternIds);
+  m_features = move(features);
+  return true;
+}
+
+double SpeedProfiles::GetFactor(uint32_t featureId, bool isForward, uint32_t weekTimeSec) const
+{
+  if (featureId >= m_features.size() || !m_features[featureId])
+    return 1.0;
+
+  uint32_t const key = GetKey(featureId, isForward);
+  auto const it = lower_bound(m_keys.cbegin(), m_keys.cend(), key);
+  if (it == m_keys.cend() || *it != key)
+    return 1.0;
+
+  size_t const pattern = m_patternIds[static_cast<size_t>(distance(m_keys.cbegin(), it))];
+
+  // Factors are known in the middles of buckets.
+  uint32_t const time = (weekTimeSec % kWeekSec + kWeekSec - kBucketSec / 2) % kWeekSec;
+  uint32_t const bucket = time / kBucketSec;
+  double const ratio = static_cast<double>(time % kBucketSec) / kBucketSec;
+  auto const getFactor = [&](uint32_t b) {
+    uint8_t const level = GetLevel(pattern, b % kBucketsCount);
+    return level == kNoDataLevel ? 1.0 : level * kFactorStep;
+  };
+  return getFactor(bucket) * (1.0 - ratio) + getFactor(bucket + 1) * ratio;
+}
+
+uint8_t SpeedProfiles::GetLevel(size_t pattern, uint32_t bucket) const
+{
+  uint8_t const byte = m_patterns[pattern * kPatternSize + bucket / 2];
+  return bucket % 2 == 0 ? (byte & 0xF) : (byte >> 4);
+}
+}  // namespace routing
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+class Writer;
+
+namespace routing
+{
+/// \brief Historical speeds of road features of one mwm. A profile of a feature direction keeps
+/// a speed factor for every 15 minutes of a week, the factor is the ratio of the observed speed
+/// to the speed of the vehicle model. Most of profiles are equal, so they refer to a shared
+/// dictionary of patterns.
+/// \note The section format is:
+///   [u32: version] [u32: number of patterns] [u32: number of profiles]
+///   [kPatternSize * number of patterns: patterns, two 4 bits levels per byte]
+///   [u32 * number of profiles: sorted keys, feature id << 1 | is forward]
+///   [u16 * number of profiles: pattern indices]
+class SpeedProfiles final
+{
+public:
+  static uint32_t constexpr kBucketSec = 15 * 60;
+  static uint32_t constexpr kWeekSec = 7 * 24 * 60 * 60;
+  static uint32_t constexpr kBucketsCount = kWeekSec / kBucketSec;
+  static size_t constexpr kPatternSize = kBucketsCount / 2;
+
+  // Level 0 means that there is no data for a bucket, level l > 0 is speed factor
+  // l * kFactorStep.
+  static uint8_t constexpr kNoDataLevel = 0;
+  static uint8_t constexpr kMaxLevel = 15;
+  static double constexpr kFactorStep = 0.1;
+
+  using Levels = std::array<uint8_t, kBucketsCount>;
+
+  struct Profile
+  {
+    uint32_t m_featureId = 0;
+    bool m_isForward = true;
+    Levels m_levels = {};
+  };
+
+  static uint8_t FactorToLevel(double factor);
+
+  /// \returns seconds since Monday 00:00 of the local solar time at |lon| for |utcTime|.
+  /// The solar time is used because time zones of mwms are unknown.
+  static uint32_t GetWeekTimeSec(time_t utcTime, double lon);
+
+  /// \note |profiles| should be sorted by feature ids and directions (backward first) and
+  /// should not have equal keys.
+  static void Serialize(std::vector<Profile> const & profiles, Writer & writer);
+
+  /// \brief Initializes profiles from the section |data|. Returns false if the section has
+  /// an unknown version or is damaged.
+  bool Init(std::vector<uint8_t> const & data);
+
+  bool IsEmpty() const { return m_keys.empty(); }
+
+  /// \returns the speed factor of the feature direction at |weekTimeSec| interpolated between
+  /// the nearest buckets, or 1.0 if it's unknown.
+  double GetFactor(uint32_t featureId, bool isForward, uint32_t weekTimeSec) const;
+
+private:
+  static uint32_t constexpr kVersion = 0;
+
+  uint8_t GetLevel(size_t pattern, uint32_t bucket) const;
+
+  std::vector<uint8_t> m_patterns;
+  std::vector<uint32_t> m_keys;
+  std::vector<uint16_t> m_patternIds;
+  // Features with profiles, most of features are not looked up in |m_keys|.
+  std::vector<bool> m_features;
+};
+}  // namespace routing
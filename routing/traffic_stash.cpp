@@ -43,6 +43,16 @@ bool TrafficStash::Has(NumMwmId numMwmId) const
   return m_mwmToTraffic.find(numMwmId) != m_mwmToTraffic.cend();
 }
 
+shared_ptr<const traffic::TrafficInfo::Coloring> TrafficStash::GetColoring(
+    NumMwmId numMwmId) const
+{
+  auto const it = m_mwmToTraffic.find(numMwmId);
+  if (it == m_mwmToTraffic.cend())
+    return nullptr;
+
+  return it->second;
+}
+
 void TrafficStash::CopyTraffic()
 {
   traffic::AllMwmTrafficInfo copy;
@@ -44,6 +44,9 @@ public:
   traffic::SpeedGroup GetSpeedGroup(Segment const & segment) const;
   void SetColoring(NumMwmId numMwmId, std::shared_ptr<const traffic::TrafficInfo::Coloring> coloring);
   bool Has(NumMwmId numMwmId) const;
+  /// \returns traffic coloring of |numMwmId| or nullptr if there's no traffic for the mwm.
+  /// \note A new coloring object is set every time traffic of the mwm is updated.
+  std::shared_ptr<const traffic::TrafficInfo::Coloring> GetColoring(NumMwmId numMwmId) const;
 
 private:
   void CopyTraffic();
@@ -112,7 +112,7 @@ void TransitGraph::GetTransitEdges(Segment const & segment, bool isOutgoing,
   }
 }
 
-set<Segment> const & TransitGraph::GetFake(Segment const & real) const
+vector<Segment> const & TransitGraph::GetFake(Segment const & real) const
 {
   return m_fake.GetFake(real);
 }
@@ -143,6 +143,7 @@ void TransitGraph::Fill(transit::GraphData const & transitData, GateEndings cons
   // in mwm. We use edge fake segments in cross-mwm section and they should be stable.
   auto const & edges = transitData.GetEdges();
   CHECK_EQUAL(m_fake.GetSize(), 0, ());
+  m_fake.Reserve(edges.size());
   for (size_t i = 0; i < edges.size(); ++i)
   {
     auto const & edge = edges[i];
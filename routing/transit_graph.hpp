@@ -36,7 +36,7 @@ public:
   RouteWeight GetTransferPenalty(Segment const & from, Segment const & to) const;
   void GetTransitEdges(Segment const & segment, bool isOutgoing,
                        std::vector<SegmentEdge> & edges) const;
-  std::set<Segment> const & GetFake(Segment const & real) const;
+  std::vector<Segment> const & GetFake(Segment const & real) const;
   bool FindReal(Segment const & fake, Segment & real) const;
 
   void Fill(transit::GraphData const & transitData, GateEndings const & gateEndings);
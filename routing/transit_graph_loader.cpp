@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 using namespace std;
@@ -34,15 +35,19 @@ public:
   ~TransitGraphLoaderImpl() override = default;
 
   TransitGraph & GetTransitGraph(NumMwmId mwmId, IndexGraph & indexGraph) override;
+  bool HasGates(NumMwmId mwmId, uint32_t featureId) override;
   void Clear() override;
 
 private:
   unique_ptr<TransitGraph> CreateTransitGraph(NumMwmId mwmId, IndexGraph & indexGraph) const;
+  unordered_set<uint32_t> LoadGateFeatures(NumMwmId mwmId) const;
 
   DataSource & m_dataSource;
   shared_ptr<NumMwmIds> m_numMwmIds;
   shared_ptr<EdgeEstimator> m_estimator;
   unordered_map<NumMwmId, unique_ptr<TransitGraph>> m_graphs;
+  // Ids of pedestrian features which best segments of gates lie on.
+  unordered_map<NumMwmId, unordered_set<uint32_t>> m_gateFeatures;
 };
 
 TransitGraphLoaderImpl::TransitGraphLoaderImpl(DataSource & dataSource,
@@ -52,7 +57,11 @@ TransitGraphLoaderImpl::TransitGraphLoaderImpl(DataSource & dataSource,
 {
 }
 
-void TransitGraphLoaderImpl::Clear() { m_graphs.clear(); }
+void TransitGraphLoaderImpl::Clear()
+{
+  m_graphs.clear();
+  m_gateFeatures.clear();
+}
 
 TransitGraph & TransitGraphLoaderImpl::GetTransitGraph(NumMwmId numMwmId, IndexGraph & indexGraph)
 {
@@ -65,6 +74,15 @@ TransitGraph & TransitGraphLoaderImpl::GetTransitGraph(NumMwmId numMwmId, IndexG
   return *(emplaceRes.first)->second;
 }
 
+bool TransitGraphLoaderImpl::HasGates(NumMwmId numMwmId, uint32_t featureId)
+{
+  auto it = m_gateFeatures.find(numMwmId);
+  if (it == m_gateFeatures.end())
+    it = m_gateFeatures.emplace(numMwmId, LoadGateFeatures(numMwmId)).first;
+
+  return it->second.count(featureId) != 0;
+}
+
 unique_ptr<TransitGraph> TransitGraphLoaderImpl::CreateTransitGraph(NumMwmId numMwmId,
                                                                     IndexGraph & indexGraph) const
 {
@@ -101,6 +119,39 @@ unique_ptr<TransitGraph> TransitGraphLoaderImpl::CreateTransitGraph(NumMwmId num
   return graph;
 }
 
+unordered_set<uint32_t> TransitGraphLoaderImpl::LoadGateFeatures(NumMwmId numMwmId) const
+{
+  platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
+  MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleByCountryFile(file);
+  if (!handle.IsAlive())
+    MYTHROW(RoutingException, ("Can't get mwm handle for", file));
+
+  unordered_set<uint32_t> features;
+  MwmValue const & mwmValue = *handle.GetValue<MwmValue>();
+  if (!mwmValue.m_cont.IsExist(TRANSIT_FILE_TAG))
+    return features;
+
+  try
+  {
+    FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(TRANSIT_FILE_TAG));
+    transit::GraphData transitData;
+    transitData.DeserializeGates(*reader.GetPtr());
+
+    for (auto const & gate : transitData.GetGates())
+    {
+      auto const & gateSegment = gate.GetBestPedestrianSegment();
+      if (gateSegment.IsValid())
+        features.insert(gateSegment.GetFeatureId());
+    }
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", TRANSIT_FILE_TAG, "section.", e.Msg()));
+    throw;
+  }
+  return features;
+}
+
 // static
 unique_ptr<TransitGraphLoader> TransitGraphLoader::Create(DataSource & dataSource,
                                                           shared_ptr<NumMwmIds> numMwmIds,
@@ -6,6 +6,7 @@
 
 #include "routing_common/num_mwm_id.hpp"
 
+#include <cstdint>
 #include <memory>
 
 class DataSource;
@@ -18,6 +19,10 @@ public:
   virtual ~TransitGraphLoader() = default;
 
   virtual TransitGraph & GetTransitGraph(NumMwmId mwmId, IndexGraph & indexGraph) = 0;
+  // Returns true if a transit gate may be connected to feature |featureId| of mwm |mwmId|.
+  // Only gates are read to answer, so the transit graph of an mwm may be loaded only when
+  // the search reaches one of its gates.
+  virtual bool HasGates(NumMwmId mwmId, uint32_t featureId) = 0;
   virtual void Clear() = 0;
 
   static std::unique_ptr<TransitGraphLoader> Create(DataSource & dataSource,
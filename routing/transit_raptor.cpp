@@ -0,0 +1,285 @@
+#include "routing/transit_raptor.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+
+namespace
+{
+double constexpr kInf = numeric_limits<double>::max();
+}  // namespace
+
+namespace routing
+{
+TransitRaptor::TransitRaptor(vector<transit::Edge> const & edges,
+                             vector<transit::Line> const & lines)
+{
+  map<tuple<transit::StopId, transit::StopId, transit::LineId>, double> lineEdges;
+  for (auto const & edge : edges)
+  {
+    if (edge.GetWeight() == transit::kInvalidWeight)
+      continue;
+
+    if (edge.GetTransfer())
+    {
+      uint32_t const from = GetOrAddStop(edge.GetStop1Id());
+      uint32_t const to = GetOrAddStop(edge.GetStop2Id());
+      m_transfers[from].emplace_back(to, edge.GetWeight());
+      continue;
+    }
+
+    auto const key = make_tuple(edge.GetStop1Id(), edge.GetStop2Id(), edge.GetLineId());
+    auto const it = lineEdges.find(key);
+    if (it == lineEdges.end() || edge.GetWeight() < it->second)
+      lineEdges[key] = edge.GetWeight();
+  }
+
+  for (auto const & line : lines)
+  {
+    double const boardingTime =
+        line.GetInterval() == transit::kInvalidWeight ? 0.0 : line.GetInterval() / 2.0;
+
+    // A line is split into routes where the section has no edge between its consecutive stops.
+    for (auto const & range : line.GetStopIds())
+    {
+      Route route;
+      route.m_lineId = line.GetId();
+      route.m_boardingTime = boardingTime;
+      for (size_t i = 0; i < range.size(); ++i)
+      {
+        if (i != 0)
+        {
+          auto const it = lineEdges.find(make_tuple(range[i - 1], range[i], line.GetId()));
+          if (it == lineEdges.end())
+          {
+            AddRoute(move(route));
+            route = Route();
+            route.m_lineId = line.GetId();
+            route.m_boardingTime = boardingTime;
+          }
+          else
+          {
+            route.m_travelTimes.push_back(it->second);
+          }
+        }
+        route.m_stops.push_back(GetOrAddStop(range[i]));
+      }
+      AddRoute(move(route));
+    }
+  }
+}
+
+bool TransitRaptor::FindJourney(map<transit::StopId, double> const & sources,
+                                map<transit::StopId, double> const & targets, size_t maxRounds,
+                                Journey & journey) const
+{
+  journey = Journey();
+
+  size_t const stopsCount = m_stopIds.size();
+  vector<vector<Label>> rounds(1, vector<Label>(stopsCount));
+  vector<double> best(stopsCount, kInf);
+  vector<bool> marked(stopsCount, false);
+
+  for (auto const & source : sources)
+  {
+    auto const it = m_stopIndices.find(source.first);
+    if (it == m_stopIndices.end() || source.second >= best[it->second])
+      continue;
+
+    rounds[0][it->second].m_arrival = source.second;
+    best[it->second] = source.second;
+    marked[it->second] = true;
+  }
+  RelaxTransfers(rounds[0], best, marked);
+
+  vector<pair<uint32_t, double>> targetStops;
+  for (auto const & target : targets)
+  {
+    auto const it = m_stopIndices.find(target.first);
+    if (it != m_stopIndices.end())
+      targetStops.emplace_back(it->second, target.second);
+  }
+
+  double bestTarget = kInf;
+  size_t bestRound = 0;
+  uint32_t bestStop = kNoStop;
+  auto const updateTarget = [&](size_t round) {
+    for (auto const & target : targetStops)
+    {
+      double const arrival = rounds[round][target.first].m_arrival;
+      if (arrival != kInf && arrival + target.second < bestTarget)
+      {
+        bestTarget = arrival + target.second;
+        bestRound = round;
+        bestStop = target.first;
+      }
+    }
+  };
+  updateTarget(0);
+
+  vector<uint32_t> routeStarts(m_routes.size(), kNoStop);
+  for (size_t round = 1; round <= maxRounds; ++round)
+  {
+    // Every route is scanned once per round from its first stop improved in the previous round.
+    vector<uint32_t> routesToScan;
+    for (uint32_t stop = 0; stop < stopsCount; ++stop)
+    {
+      if (!marked[stop])
+        continue;
+
+      marked[stop] = false;
+      for (auto const & routeAndPos : m_stopRoutes[stop])
+      {
+        uint32_t & start = routeStarts[routeAndPos.first];
+        if (start == kNoStop)
+          routesToScan.push_back(routeAndPos.first);
+        start = min(start, routeAndPos.second);
+      }
+    }
+
+    if (routesToScan.empty())
+      break;
+
+    rounds.push_back(rounds.back());
+    vector<Label> const & prev = rounds[round - 1];
+    vector<Label> & labels = rounds[round];
+
+    bool improved = false;
+    for (uint32_t const routeId : routesToScan)
+    {
+      Route const & route = m_routes[routeId];
+      uint32_t const start = routeStarts[routeId];
+      routeStarts[routeId] = kNoStop;
+
+      double arrival = kInf;
+      uint32_t boardingStop = kNoStop;
+      for (size_t i = start; i < route.m_stops.size(); ++i)
+      {
+        uint32_t const stop = route.m_stops[i];
+        if (boardingStop != kNoStop)
+        {
+          arrival += route.m_travelTimes[i - 1];
+          if (arrival < best[stop] && arrival < bestTarget)
+          {
+            labels[stop].m_arrival = arrival;
+            labels[stop].m_parent = boardingStop;
+            labels[stop].m_lineId = route.m_lineId;
+            best[stop] = arrival;
+            marked[stop] = true;
+            improved = true;
+          }
+        }
+
+        // Catching the line at this stop may be better than staying on board.
+        double const prevArrival = prev[stop].m_arrival;
+        if (prevArrival != kInf && prevArrival + route.m_boardingTime < arrival)
+        {
+          arrival = prevArrival + route.m_boardingTime;
+          boardingStop = stop;
+        }
+      }
+    }
+
+    if (!improved)
+      break;
+
+    RelaxTransfers(labels, best, marked);
+    updateTarget(round);
+  }
+
+  if (bestStop == kNoStop)
+    return false;
+
+  MakeJourney(rounds, bestRound, bestStop, journey);
+  journey.m_arrival = bestTarget;
+  return true;
+}
+
+uint32_t TransitRaptor::GetOrAddStop(transit::StopId stopId)
+{
+  auto const res = m_stopIndices.emplace(stopId, static_cast<uint32_t>(m_stopIds.size()));
+  if (res.second)
+  {
+    m_stopIds.push_back(stopId);
+    m_stopRoutes.emplace_back();
+    m_transfers.emplace_back();
+  }
+  return res.first->second;
+}
+
+void TransitRaptor::AddRoute(Route && route)
+{
+  if (route.m_stops.size() < 2)
+    return;
+
+  CHECK_EQUAL(route.m_stops.size(), route.m_travelTimes.size() + 1, ());
+  auto const routeId = static_cast<uint32_t>(m_routes.size());
+  for (size_t i = 0; i + 1 < route.m_stops.size(); ++i)
+    m_stopRoutes[route.m_stops[i]].emplace_back(routeId, static_cast<uint32_t>(i));
+  m_routes.push_back(move(route));
+}
+
+void TransitRaptor::RelaxTransfers(vector<Label> & labels, vector<double> & best,
+                                   vector<bool> & marked) const
+{
+  // Only stops reached by a line are relaxed, so transfers are not chained.
+  vector<uint32_t> reached;
+  for (uint32_t stop = 0; stop < marked.size(); ++stop)
+  {
+    if (marked[stop])
+      reached.push_back(stop);
+  }
+
+  for (uint32_t const from : reached)
+  {
+    for (auto const & transfer : m_transfers[from])
+    {
+      double const arrival = labels[from].m_arrival + transfer.second;
+      if (arrival >= best[transfer.first])
+        continue;
+
+      labels[transfer.first].m_arrival = arrival;
+      labels[transfer.first].m_parent = from;
+      labels[transfer.first].m_lineId = transit::kInvalidLineId;
+      best[transfer.first] = arrival;
+      marked[transfer.first] = true;
+    }
+  }
+}
+
+void TransitRaptor::MakeJourney(vector<vector<Label>> const & rounds, size_t round, uint32_t stop,
+                                Journey & journey) const
+{
+  vector<Leg> legs;
+  while (true)
+  {
+    // Labels are copied from round to round, the leg is set at the round where the label changed.
+    while (round > 0 && rounds[round - 1][stop].m_arrival == rounds[round][stop].m_arrival)
+      --round;
+
+    Label const & label = rounds[round][stop];
+    if (label.m_parent == kNoStop)
+      break;
+
+    Leg leg;
+    leg.m_from = m_stopIds[label.m_parent];
+    leg.m_to = m_stopIds[stop];
+    leg.m_lineId = label.m_lineId;
+    leg.m_arrival = label.m_arrival;
+    legs.push_back(leg);
+
+    if (label.m_lineId != transit::kInvalidLineId)
+    {
+      CHECK_GREATER(round, 0, ());
+      --round;
+    }
+    stop = label.m_parent;
+  }
+
+  reverse(legs.begin(), legs.end());
+  journey.m_legs = move(legs);
+}
+}  // namespace routing
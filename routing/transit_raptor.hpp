@@ -0,0 +1,93 @@
+#pragma once
+
+#include "transit/transit_types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+// Round-based public transport search (RAPTOR) over the transit section of an mwm.
+// Every round k finds the earliest arrivals at stops with at most k boardings, so a round scans
+// each transit line once instead of relaxing every line edge in A*.
+//
+// The transit section has no timetables, only line intervals. So a line is modelled as a
+// frequency-based one: boarding it costs half of its interval, the expected wait with uniformly
+// distributed arrivals at the stop (the same model as TransitGraph uses). All times are in
+// seconds since the start of the journey.
+class TransitRaptor
+{
+public:
+  struct Leg
+  {
+    transit::StopId m_from = transit::kInvalidStopId;
+    transit::StopId m_to = transit::kInvalidStopId;
+    // kInvalidLineId for walking between stops of a transfer.
+    transit::LineId m_lineId = transit::kInvalidLineId;
+    // Arrival at |m_to|.
+    double m_arrival = 0.0;
+  };
+
+  struct Journey
+  {
+    // Arrival at the destination, i.e. including the time from the last stop.
+    double m_arrival = std::numeric_limits<double>::max();
+    std::vector<Leg> m_legs;
+  };
+
+  // |edges| are line edges and transfer edges of the transit section. Line edges are used to get
+  // travel times between consecutive stops of |lines|, transfer edges are walks between stops.
+  TransitRaptor(std::vector<transit::Edge> const & edges, std::vector<transit::Line> const & lines);
+
+  // |sources| are stops which may be reached from the start with times to reach them, e.g.
+  // walking times along IndexGraph from the start to gates. |targets| are stops with times to get
+  // from them to the finish. Returns false if no target is reachable with at most |maxRounds|
+  // boardings.
+  bool FindJourney(std::map<transit::StopId, double> const & sources,
+                   std::map<transit::StopId, double> const & targets, size_t maxRounds,
+                   Journey & journey) const;
+
+  size_t GetStopsCount() const { return m_stopIds.size(); }
+  size_t GetRoutesCount() const { return m_routes.size(); }
+
+private:
+  static uint32_t constexpr kNoStop = std::numeric_limits<uint32_t>::max();
+
+  // A run of consecutive stops of a line.
+  struct Route
+  {
+    transit::LineId m_lineId = transit::kInvalidLineId;
+    double m_boardingTime = 0.0;
+    std::vector<uint32_t> m_stops;
+    // m_travelTimes[i] is the time between m_stops[i] and m_stops[i + 1].
+    std::vector<double> m_travelTimes;
+  };
+
+  struct Label
+  {
+    double m_arrival = std::numeric_limits<double>::max();
+    uint32_t m_parent = kNoStop;
+    transit::LineId m_lineId = transit::kInvalidLineId;
+  };
+
+  uint32_t GetOrAddStop(transit::StopId stopId);
+  void AddRoute(Route && route);
+  void RelaxTransfers(std::vector<Label> & labels, std::vector<double> & best,
+                      std::vector<bool> & marked) const;
+  void MakeJourney(std::vector<std::vector<Label>> const & rounds, size_t round, uint32_t stop,
+                   Journey & journey) const;
+
+  std::vector<transit::StopId> m_stopIds;
+  std::unordered_map<transit::StopId, uint32_t> m_stopIndices;
+  std::vector<Route> m_routes;
+  // Stop -> (route, position of the stop in the route).
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> m_stopRoutes;
+  // Stop -> (stop reachable by a transfer, walking time).
+  std::vector<std::vector<std::pair<uint32_t, double>>> m_transfers;
+};
+}  // namespace routing
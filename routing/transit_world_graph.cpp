@@ -27,10 +27,9 @@ TransitWorldGraph::TransitWorldGraph(unique_ptr<CrossMwmGraph> crossMwmGraph,
 void TransitWorldGraph::GetEdgeList(Segment const & segment, bool isOutgoing,
                                     vector<SegmentEdge> & edges)
 {
-  auto & transitGraph = GetTransitGraph(segment.GetMwmId());
-
   if (TransitGraph::IsTransitSegment(segment))
   {
+    auto & transitGraph = GetTransitGraph(segment.GetMwmId());
     transitGraph.GetTransitEdges(segment, isOutgoing, edges);
 
     Segment real;
@@ -53,6 +52,15 @@ void TransitWorldGraph::GetEdgeList(Segment const & segment, bool isOutgoing,
   for (auto const & edge : edges)
   {
     auto const & edgeSegment = edge.GetTarget();
+    // Real segments are connected to transit by gates only. The transit graph of an mwm is
+    // not loaded until the search reaches a feature with a gate.
+    if (!TransitGraph::IsTransitSegment(edgeSegment) &&
+        !m_transitLoader->HasGates(edgeSegment.GetMwmId(), edgeSegment.GetFeatureId()))
+    {
+      continue;
+    }
+
+    auto & transitGraph = GetTransitGraph(edgeSegment.GetMwmId());
     for (auto const & s : transitGraph.GetFake(edgeSegment))
     {
       bool const haveSameFront = GetJunction(edgeSegment, true /* front */) == GetJunction(s, true);
@@ -120,6 +128,12 @@ RouteWeight TransitWorldGraph::HeuristicCostEstimate(m2::PointD const & from, m2
   return RouteWeight(m_estimator->CalcHeuristic(from, to));
 }
 
+bool TransitWorldGraph::GetLandmarkDistances(Segment const & /* segment */, bool /* front */,
+                                             LandmarkDistances & /* distances */)
+{
+  return false;
+}
+
 RouteWeight TransitWorldGraph::CalcSegmentWeight(Segment const & segment)
 {
   if (TransitGraph::IsTransitSegment(segment))
@@ -2,6 +2,7 @@
 
 #include "routing/geometry.hpp"
 #include "routing/index_graph.hpp"
+#include "routing/landmarks.hpp"
 #include "routing/road_graph.hpp"
 #include "routing/route.hpp"
 #include "routing/segment.hpp"
@@ -62,6 +63,10 @@ public:
 
   virtual RouteWeight HeuristicCostEstimate(Segment const & from, Segment const & to) = 0;
   virtual RouteWeight HeuristicCostEstimate(m2::PointD const & from, m2::PointD const & to) = 0;
+  // Fills |distances| with distances from the landmarks of the mwm of |segment| to its front or
+  // back point. Returns false if the landmarks are not applicable in the current mode.
+  virtual bool GetLandmarkDistances(Segment const & segment, bool front,
+                                    LandmarkDistances & distances) = 0;
   virtual RouteWeight CalcSegmentWeight(Segment const & segment) = 0;
   virtual RouteWeight CalcLeapWeight(m2::PointD const & from, m2::PointD const & to) const = 0;
   virtual RouteWeight CalcOffroadWeight(m2::PointD const & from, m2::PointD const & to) const = 0;
@@ -53,6 +53,19 @@ public:
   double GetOffroadSpeed() const override { return 0.0; }
 };
 
+// The model with additional road types of different levels.
+class TestVehicleModelWithAdditionalTypes : public TestVehicleModel
+{
+public:
+  TestVehicleModelWithAdditionalTypes()
+  {
+    SetAdditionalRoadTypes(
+        classif(), {{{"route", "ferry", "motorcar"}, {SpeedKMpH(10.0), SpeedKMpH(10.0)}},
+                    {{"railway", "rail", "motor_vehicle"}, {SpeedKMpH(25.0), SpeedKMpH(25.0)}},
+                    {{"route", "ferry"}, {SpeedKMpH(20.0), SpeedKMpH(20.0)}}});
+  }
+};
+
 uint32_t GetType(char const * s0, char const * s1 = 0, char const * s2 = 0)
 {
   char const * const t[] = {s0, s1, s2};
@@ -183,3 +196,22 @@ UNIT_CLASS_TEST(VehicleModelTest, VehicleModel_SpeedFactor)
   CheckSpeed({residential, unpavedGood}, {{27.0, 44.0}, {30.0, 48.0}});
   CheckSpeed({residential, unpavedBad}, {{9.0, 11.0}, {10.0, 12.0}});
 }
+
+UNIT_CLASS_TEST(VehicleModelTest, VehicleModel_AdditionalRoadTypes)
+{
+  TestVehicleModelWithAdditionalTypes vehicleModel;
+  TEST(vehicleModel.IsRoadType(GetType("route", "ferry")), ());
+  TEST(vehicleModel.IsRoadType(GetType("route", "ferry", "motorcar")), ());
+  TEST(vehicleModel.IsRoadType(GetType("railway", "rail", "motor_vehicle")), ());
+  // Additional road types are matched exactly.
+  TEST(!vehicleModel.IsRoadType(GetType("railway", "rail")), ());
+  TEST(!vehicleModel.IsRoadType(GetType("route")), ());
+  // Highway types are matched by two levels.
+  TEST(vehicleModel.IsRoadType(GetType("highway", "secondary", "bridge")), ());
+  TEST(!vehicleModel.IsRoadType(GetType("highway")), ());
+  TEST(!vehicleModel.IsRoadType(GetType("psurface", "paved_good")), ());
+
+  TEST(vehicleModel.HasRoadType(vector<uint32_t>{GetType("psurface", "paved_good"),
+                                                 GetType("railway", "rail", "motor_vehicle")}),
+       ());
+}
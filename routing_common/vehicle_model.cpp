@@ -26,10 +26,43 @@ VehicleModel::InOutCitySpeedKMpH Max(VehicleModel::InOutCitySpeedKMpH const & lh
 {
   return {Pick<max>(lhs.m_inCity, rhs.m_inCity), Pick<max>(lhs.m_outCity, rhs.m_outCity)};
 }
+
+VehicleModel::InOutCitySpeedKMpH Min(VehicleModel::InOutCitySpeedKMpH const & lhs,
+                                     VehicleModel::InOutCitySpeedKMpH const & rhs)
+{
+  return {Pick<min>(lhs.m_inCity, rhs.m_inCity), Pick<min>(lhs.m_outCity, rhs.m_outCity)};
+}
+
+// Types are compiled by their first two levels.
+uint8_t constexpr kTypeInfoLevel = 2;
+
+// The key of the first two levels of |type|. The keys of first level types differ from the keys
+// of their subtypes.
+bool GetTypeKey(uint32_t type, uint32_t & key)
+{
+  uint8_t value = 0;
+  if (!ftype::GetValue(type, 0 /* level */, value))
+    return false;
+  key = static_cast<uint32_t>(value) << 8;
+  if (ftype::GetValue(type, 1 /* level */, value))
+    key |= static_cast<uint32_t>(value) + 1;
+  return true;
+}
 }  // namespace
 
 namespace routing
 {
+VehicleModelInterface::RoadInfo VehicleModelInterface::GetRoadInfo(FeatureType & f,
+                                                                   bool inCity) const
+{
+  RoadInfo info;
+  info.m_isRoad = IsRoad(f);
+  info.m_isOneWay = IsOneWay(f);
+  info.m_speed = GetSpeed(f, inCity);
+  info.m_isPassThroughAllowed = IsPassThroughAllowed(f);
+  return info;
+}
+
 VehicleModel::AdditionalRoadType::AdditionalRoadType(Classificator const & c,
                                                      AdditionalRoadTags const & tag)
   : m_type(c.GetTypeByPath(tag.m_hwtag))
@@ -75,6 +108,8 @@ VehicleModel::VehicleModel(Classificator const & c, LimitsInitList const & featu
     double const etaFactor = base::clamp(speedFactor.m_eta, 0.0, 1.0);
     m_surfaceFactors[i++] = {c.GetTypeByPath(v.m_types), {weightFactor, etaFactor}};
   }
+
+  CompileTypeInfos();
 }
 
 void VehicleModel::SetAdditionalRoadTypes(Classificator const & c,
@@ -85,6 +120,135 @@ void VehicleModel::SetAdditionalRoadTypes(Classificator const & c,
     m_addRoadTypes.emplace_back(c, tag);
     m_maxSpeed = Max(m_maxSpeed, tag.m_speed);
   }
+
+  CompileTypeInfos();
+}
+
+void VehicleModel::CompileTypeInfos()
+{
+  m_typeInfos.clear();
+  m_minTypeKey = 0;
+
+  // Keys of the types the model knows. Highway types of deeper levels are never matched as
+  // the matched types are truncated to two levels.
+  vector<uint32_t> keys;
+  auto const addKey = [&keys](uint32_t type, bool isMatchedByLevels) {
+    uint32_t key = 0;
+    if ((!isMatchedByLevels || ftype::GetLevel(type) <= kTypeInfoLevel) && GetTypeKey(type, key))
+      keys.push_back(key);
+  };
+  for (auto const & kv : m_highwayTypes)
+    addKey(kv.first, true /* isMatchedByLevels */);
+  for (auto const & type : m_addRoadTypes)
+    addKey(type.m_type, false /* isMatchedByLevels */);
+  for (auto const & factor : m_surfaceFactors)
+    addKey(factor.m_type, false /* isMatchedByLevels */);
+  if (keys.empty())
+    return;
+
+  auto const minMax = minmax_element(keys.cbegin(), keys.cend());
+  m_minTypeKey = *minMax.first;
+  m_typeInfos.assign(*minMax.second - m_minTypeKey + 1, TypeInfo());
+  auto const getInfo = [this](uint32_t type) -> TypeInfo & {
+    uint32_t key = 0;
+    CHECK(GetTypeKey(type, key), (type));
+    return m_typeInfos[key - m_minTypeKey];
+  };
+
+  for (auto const & kv : m_highwayTypes)
+  {
+    if (ftype::GetLevel(kv.first) > kTypeInfoLevel)
+      continue;
+    auto & info = getInfo(kv.first);
+    info.m_isHighway = true;
+    info.m_isPassThroughAllowed = kv.second.IsPassThroughAllowed();
+    info.m_highwaySpeed = {kv.second.GetSpeed(true /* inCity */),
+                           kv.second.GetSpeed(false /* inCity */)};
+  }
+
+  // Only the first one of equal types is used, see FindRoadType().
+  for (auto it = m_addRoadTypes.crbegin(); it != m_addRoadTypes.crend(); ++it)
+  {
+    auto & info = getInfo(it->m_type);
+    if (ftype::GetLevel(it->m_type) > kTypeInfoLevel)
+    {
+      info.m_hasDeeperTypes = true;
+      continue;
+    }
+    info.m_isAdditionalRoad = true;
+    info.m_additionalRoadSpeed = it->m_speed;
+  }
+
+  for (auto it = m_surfaceFactors.crbegin(); it != m_surfaceFactors.crend(); ++it)
+  {
+    auto & info = getInfo(it->m_type);
+    if (ftype::GetLevel(it->m_type) > kTypeInfoLevel)
+      info.m_hasDeeperTypes = true;
+    else
+      info.m_factor = it->m_factor;
+  }
+}
+
+VehicleModel::TypeInfo const * VehicleModel::FindTypeInfo(uint32_t type) const
+{
+  uint32_t key = 0;
+  if (!GetTypeKey(type, key) || key < m_minTypeKey)
+    return nullptr;
+  key -= m_minTypeKey;
+  return key < m_typeInfos.size() ? &m_typeInfos[key] : nullptr;
+}
+
+void VehicleModel::AddTypeInfo(uint32_t type, TypesInfo & info) const
+{
+  TypeInfo const * typeInfo = FindTypeInfo(type);
+  if (typeInfo == nullptr)
+    return;
+
+  if (typeInfo->m_isHighway)
+  {
+    info.m_isRoad = true;
+    info.m_isPassThroughAllowed = info.m_isPassThroughAllowed || typeInfo->m_isPassThroughAllowed;
+    info.m_minSpeed = Min(info.m_minSpeed, typeInfo->m_highwaySpeed);
+  }
+
+  if (ftype::GetLevel(type) <= kTypeInfoLevel)
+  {
+    if (typeInfo->m_isAdditionalRoad)
+    {
+      info.m_isRoad = true;
+      info.m_hasAdditionalRoadType = true;
+      info.m_minSpeed = Min(info.m_minSpeed, typeInfo->m_additionalRoadSpeed);
+    }
+    info.m_factor = Pick<min>(info.m_factor, typeInfo->m_factor);
+    return;
+  }
+
+  if (!typeInfo->m_hasDeeperTypes)
+    return;
+
+  auto const addRoadInfoIter = FindRoadType(type);
+  if (addRoadInfoIter != m_addRoadTypes.cend())
+  {
+    info.m_isRoad = true;
+    info.m_hasAdditionalRoadType = true;
+    info.m_minSpeed = Min(info.m_minSpeed, addRoadInfoIter->m_speed);
+  }
+
+  auto const itFactor = find_if(m_surfaceFactors.cbegin(), m_surfaceFactors.cend(),
+                                [type](TypeFactor const & v) { return v.m_type == type; });
+  if (itFactor != m_surfaceFactors.cend())
+    info.m_factor = Pick<min>(info.m_factor, itFactor->m_factor);
+}
+
+VehicleModel::TypesInfo VehicleModel::GetTypesInfo(feature::TypesHolder const & types) const
+{
+  TypesInfo info;
+  info.m_minSpeed = {
+      {m_maxSpeed.m_inCity.m_weight * 2.0, m_maxSpeed.m_inCity.m_eta * 2.0},
+      {m_maxSpeed.m_outCity.m_weight * 2.0, m_maxSpeed.m_outCity.m_eta * 2.0}};
+  for (uint32_t t : types)
+    AddTypeInfo(t, info);
+  return info;
 }
 
 VehicleModel::SpeedKMpH VehicleModel::GetSpeed(FeatureType & f, bool inCity) const
@@ -95,8 +259,12 @@ VehicleModel::SpeedKMpH VehicleModel::GetSpeed(FeatureType & f, bool inCity) con
   // @TODO(bykoianko) Consider using speed on feature |f| instead of using max speed below.
   if (restriction == RoadAvailability::Available)
     return inCity ? m_maxSpeed.m_inCity : m_maxSpeed.m_outCity;
-  if (restriction != RoadAvailability::NotAvailable && HasRoadType(types))
-    return GetMinTypeSpeed(types, inCity);
+  if (restriction == RoadAvailability::NotAvailable)
+    return {};
+
+  auto const info = GetTypesInfo(types);
+  if (info.m_isRoad)
+    return GetMinTypeSpeed(info, inCity);
 
   return {};
 }
@@ -107,31 +275,17 @@ double VehicleModel::GetMaxWeightSpeed() const
 }
 
 VehicleModel::SpeedKMpH VehicleModel::GetMinTypeSpeed(feature::TypesHolder const & types, bool inCity) const
+{
+  return GetMinTypeSpeed(GetTypesInfo(types), inCity);
+}
+
+VehicleModel::SpeedKMpH VehicleModel::GetMinTypeSpeed(TypesInfo const & info, bool inCity) const
 {
   double const maxSpeedWeight = inCity ? m_maxSpeed.m_inCity.m_weight : m_maxSpeed.m_outCity.m_weight;
   double const maxEtaWeight = inCity ? m_maxSpeed.m_inCity.m_eta : m_maxSpeed.m_outCity.m_eta;
-  VehicleModel::SpeedKMpH speed{maxSpeedWeight * 2.0, maxEtaWeight * 2.0};
+  VehicleModel::SpeedKMpH const & speed = inCity ? info.m_minSpeed.m_inCity : info.m_minSpeed.m_outCity;
   // Decreasing speed factor based on road surface (cover).
-  VehicleModel::SpeedFactor factor;
-  for (uint32_t t : types)
-  {
-    uint32_t const type = ftypes::BaseChecker::PrepareToMatch(t, 2);
-    auto const itHighway = m_highwayTypes.find(type);
-    if (itHighway != m_highwayTypes.cend())
-      speed = Pick<min>(speed, itHighway->second.GetSpeed(inCity));
-
-    auto const addRoadInfoIter = FindRoadType(t);
-    if (addRoadInfoIter != m_addRoadTypes.cend())
-    {
-      speed = Pick<min>(
-          speed, inCity ? addRoadInfoIter->m_speed.m_inCity : addRoadInfoIter->m_speed.m_outCity);
-    }
-
-    auto const itFactor = find_if(m_surfaceFactors.cbegin(), m_surfaceFactors.cend(),
-                                  [t](TypeFactor const & v) { return v.m_type == t; });
-    if (itFactor != m_surfaceFactors.cend())
-      factor = Pick<min>(factor, itFactor->m_factor);
-  }
+  VehicleModel::SpeedFactor const & factor = info.m_factor;
 
   CHECK_LESS_OR_EQUAL(factor.m_weight, 1.0, ());
   CHECK_LESS_OR_EQUAL(factor.m_eta, 1.0, ());
@@ -177,39 +331,44 @@ bool VehicleModel::IsRoad(FeatureType & f) const
 
   if (GetRoadAvailability(types) == RoadAvailability::NotAvailable)
     return false;
-  return HasRoadType(types);
+  return GetTypesInfo(types).m_isRoad;
 }
 
 bool VehicleModel::IsPassThroughAllowed(FeatureType & f) const
 {
-  feature::TypesHolder const types(f);
+  auto const info = GetTypesInfo(feature::TypesHolder(f));
   // Allow pass through additional road types e.g. peer, ferry.
-  for (uint32_t t : types)
-  {
-    auto const addRoadInfoIter = FindRoadType(t);
-    if (addRoadInfoIter != m_addRoadTypes.cend())
-      return true;
-  }
-  return HasPassThroughType(types);
+  return info.m_hasAdditionalRoadType || info.m_isPassThroughAllowed;
 }
 
-bool VehicleModel::HasPassThroughType(feature::TypesHolder const & types) const
+VehicleModel::RoadInfo VehicleModel::GetRoadInfo(FeatureType & f, bool inCity) const
 {
-  for (uint32_t t : types)
-  {
-    uint32_t const type = ftypes::BaseChecker::PrepareToMatch(t, 2);
-    auto it = m_highwayTypes.find(type);
-    if (it != m_highwayTypes.end() && it->second.IsPassThroughAllowed())
-      return true;
-  }
+  feature::TypesHolder const types(f);
+  auto const info = GetTypesInfo(types);
+  RoadAvailability const restriction = GetRoadAvailability(types);
 
-  return false;
+  RoadInfo roadInfo;
+  roadInfo.m_isRoad = f.GetFeatureType() == feature::GEOM_LINE &&
+                      restriction != RoadAvailability::NotAvailable && info.m_isRoad;
+  roadInfo.m_isOneWay = IsOneWay(f);
+  if (restriction == RoadAvailability::Available)
+    roadInfo.m_speed = inCity ? m_maxSpeed.m_inCity : m_maxSpeed.m_outCity;
+  else if (restriction != RoadAvailability::NotAvailable && info.m_isRoad)
+    roadInfo.m_speed = GetMinTypeSpeed(info, inCity);
+  roadInfo.m_isPassThroughAllowed = info.m_hasAdditionalRoadType || info.m_isPassThroughAllowed;
+  return roadInfo;
+}
+
+bool VehicleModel::HasPassThroughType(feature::TypesHolder const & types) const
+{
+  return GetTypesInfo(types).m_isPassThroughAllowed;
 }
 
 bool VehicleModel::IsRoadType(uint32_t type) const
 {
-  return FindRoadType(type) != m_addRoadTypes.cend() ||
-         m_highwayTypes.find(ftypes::BaseChecker::PrepareToMatch(type, 2)) != m_highwayTypes.end();
+  TypesInfo info;
+  AddTypeInfo(type, info);
+  return info.m_isRoad;
 }
 
 VehicleModelInterface::RoadAvailability VehicleModel::GetRoadAvailability(feature::TypesHolder const & /* types */) const
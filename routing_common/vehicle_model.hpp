@@ -67,6 +67,15 @@ public:
     double m_eta = 1.0;
   };
 
+  /// Properties of a feature which are used by routing graphs, see GetRoadInfo().
+  struct RoadInfo
+  {
+    bool m_isRoad = false;
+    bool m_isOneWay = false;
+    bool m_isPassThroughAllowed = false;
+    SpeedKMpH m_speed;
+  };
+
   virtual ~VehicleModelInterface() = default;
 
   /// @return Allowed weight and ETA speed in KMpH.
@@ -92,6 +101,10 @@ public:
   /// Roads with additional types e.g. "path = ferry", "vehicle_type = yes" considered as allowed
   /// to pass through.
   virtual bool IsPassThroughAllowed(FeatureType & f) const = 0;
+
+  /// @return results of IsRoad(), IsOneWay(), GetSpeed() and IsPassThroughAllowed() for |f|.
+  /// Models may override it to evaluate types of |f| only once.
+  virtual RoadInfo GetRoadInfo(FeatureType & f, bool inCity) const;
 };
 
 class VehicleModelFactoryInterface
@@ -163,6 +176,7 @@ public:
   bool IsOneWay(FeatureType & f) const override;
   bool IsRoad(FeatureType & f) const override;
   bool IsPassThroughAllowed(FeatureType & f) const override;
+  RoadInfo GetRoadInfo(FeatureType & f, bool inCity) const override;
 
 public:
   /// @returns true if |m_highwayTypes| or |m_addRoadTypes| contains |type| and false otherwise.
@@ -207,6 +221,34 @@ protected:
   InOutCitySpeedKMpH m_maxSpeed;
 
 private:
+  // Properties of the types which start with the same two levels of the classificator.
+  struct TypeInfo
+  {
+    // Highway types are matched by two levels, so the properties are the same for all the
+    // types which start with the levels.
+    bool m_isHighway = false;
+    bool m_isPassThroughAllowed = false;
+    InOutCitySpeedKMpH m_highwaySpeed = {{}, {}};
+    // Additional road types and surface types are matched exactly. The properties are the ones
+    // of the type of the two levels only.
+    bool m_isAdditionalRoad = false;
+    InOutCitySpeedKMpH m_additionalRoadSpeed = {{}, {}};
+    SpeedFactor m_factor;
+    // True if there're additional road types or surface types of deeper levels which start with
+    // the levels.
+    bool m_hasDeeperTypes = false;
+  };
+
+  // Properties of all the types of a feature.
+  struct TypesInfo
+  {
+    bool m_isRoad = false;
+    bool m_hasAdditionalRoadType = false;
+    bool m_isPassThroughAllowed = false;
+    InOutCitySpeedKMpH m_minSpeed = {{}, {}};
+    SpeedFactor m_factor;
+  };
+
   struct AdditionalRoadType final
   {
     AdditionalRoadType(Classificator const & c, AdditionalRoadTags const & tag);
@@ -242,6 +284,15 @@ private:
 
   std::vector<AdditionalRoadType>::const_iterator FindRoadType(uint32_t type) const;
 
+  /// \brief Fills |m_typeInfos| from |m_highwayTypes|, |m_addRoadTypes| and |m_surfaceFactors|.
+  void CompileTypeInfos();
+  /// \returns the compiled properties of the two levels of |type| or nullptr if the model
+  /// doesn't know any types which start with them.
+  TypeInfo const * FindTypeInfo(uint32_t type) const;
+  void AddTypeInfo(uint32_t type, TypesInfo & info) const;
+  TypesInfo GetTypesInfo(feature::TypesHolder const & types) const;
+  SpeedKMpH GetMinTypeSpeed(TypesInfo const & info, bool inCity) const;
+
   std::unordered_map<uint32_t, RoadLimits> m_highwayTypes;
   // Mapping surface types (psurface|paved_good, psurface|paved_bad, psurface|unpaved_good,
   // psurface|unpaved_bad) to surface speed factors.
@@ -250,6 +301,11 @@ private:
 
   std::vector<AdditionalRoadType> m_addRoadTypes;
   uint32_t m_onewayType;
+
+  // Compiled properties of types indexed by keys of their two levels, see GetTypeKey() in
+  // vehicle_model.cpp. The key of the first item is |m_minTypeKey|.
+  std::vector<TypeInfo> m_typeInfos;
+  uint32_t m_minTypeKey = 0;
 };
 
 class VehicleModelFactory : public VehicleModelFactoryInterface
@@ -27,16 +27,59 @@ public:
   using Trie = base::MemTrie<Token, List>;
   using Iterator = trie::MemTrieIterator<Token, List>;
 
+  // Bulk loader of the index. It's much faster than adding docs one
+  // by one: all (token, id) pairs are sorted first, so every inverted
+  // list is built at once and the trie is traversed once per token.
+  class Builder
+  {
+  public:
+    template <typename Doc>
+    void Add(Id const & id, Doc const & doc)
+    {
+      ForEachToken(doc, [&](Token const & token) { m_postings.emplace_back(token, id); });
+    }
+
+    MemSearchIndex Build()
+    {
+      base::SortUnique(m_postings);
+
+      MemSearchIndex index;
+      std::vector<Id> ids;
+      for (size_t i = 0; i < m_postings.size();)
+      {
+        auto const & token = m_postings[i].first;
+        ids.clear();
+        for (; i < m_postings.size() && m_postings[i].first == token; ++i)
+          ids.push_back(m_postings[i].second);
+        index.m_trie.AddValues(token, ids.begin(), ids.end());
+      }
+
+      m_postings.clear();
+      return index;
+    }
+
+  private:
+    std::vector<std::pair<Token, Id>> m_postings;
+  };
+
+  // Returns a deep copy of the index.
+  MemSearchIndex Clone() const
+  {
+    MemSearchIndex index;
+    index.m_trie = m_trie.Clone();
+    return index;
+  }
+
   template <typename Doc>
   void Add(Id const & id, Doc const & doc)
   {
-    ForEachToken(id, doc, [&](Token const & token) { m_trie.Add(token, id); });
+    ForEachToken(doc, [&](Token const & token) { m_trie.Add(token, id); });
   }
 
   template <typename Doc>
   void Erase(Id const & id, Doc const & doc)
   {
-    ForEachToken(id, doc, [&](Token const & token) { m_trie.Erase(token, id); });
+    ForEachToken(doc, [&](Token const & token) { m_trie.Erase(token, id); });
   }
 
   Iterator GetRootIterator() const { return Iterator(m_trie.GetRootIterator()); }
@@ -76,7 +119,7 @@ private:
   }
 
   template <typename Doc, typename Fn>
-  void ForEachToken(Id const & id, Doc const & doc, Fn && fn)
+  static void ForEachToken(Doc const & doc, Fn && fn)
   {
     doc.ForEachToken([&](int8_t lang, Token const & token) {
       if (lang >= 0)
@@ -2,19 +2,43 @@
 
 #include "search/base/text_index/header.hpp"
 #include "search/base/text_index/text_index.hpp"
+#include "search/base/text_index/utils.hpp"
 
+#include "coding/byte_stream.hpp"
+#include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 #include <vector>
 
+// The dictionary is stored as blocks of front-coded tokens:
+//   [4 * (numBlocks + 1): starting positions of blocks, the last one is the end of the
+//                         dictionary]
+//   [block] ... [block]
+//
+// Every block except the last one contains kDictionaryBlockSize tokens:
+//   [vu: size of the first token] [the first token]
+//   [vu: size of the prefix shared with the previous token]
+//   [vu: size of the rest of the token] [the rest of the token]
+//   ...
+//
+// A token is looked up by the binary search over the first tokens of blocks, which are
+// stored as is, and by decoding one block.
 namespace search_base
 {
+size_t constexpr kDictionaryBlockSize = 16;
+
+inline size_t GetDictionaryBlocksCount(size_t numTokens)
+{
+  return (numTokens + kDictionaryBlockSize - 1) / kDictionaryBlockSize;
+}
+
 // The dictionary contains all tokens that are present
 // in the text index.
 class TextIndexDictionary
@@ -41,18 +65,36 @@ public:
   void Serialize(Sink & sink, TextIndexHeader & header, uint64_t startPos) const
   {
     header.m_numTokens = base::checked_cast<uint32_t>(m_tokens.size());
+    size_t const numBlocks = GetDictionaryBlocksCount(m_tokens.size());
 
     header.m_dictPositionsOffset = RelativePos(sink, startPos);
     // An uint32_t for each 32-bit offset and an uint32_t for the dummy entry at the end.
-    WriteZeroesToSink(sink, sizeof(uint32_t) * (header.m_numTokens + 1));
+    WriteZeroesToSink(sink, sizeof(uint32_t) * (numBlocks + 1));
     header.m_dictWordsOffset = RelativePos(sink, startPos);
 
     std::vector<uint32_t> offsets;
-    offsets.reserve(header.m_numTokens + 1);
-    for (auto const & token : m_tokens)
+    offsets.reserve(numBlocks + 1);
+    for (size_t i = 0; i < m_tokens.size(); ++i)
     {
-      offsets.emplace_back(RelativePos(sink, startPos));
-      SerializeToken(sink, token);
+      auto const & token = m_tokens[i];
+      CHECK(!token.empty(), ());
+      if (i % kDictionaryBlockSize == 0)
+      {
+        offsets.emplace_back(RelativePos(sink, startPos));
+        WriteVarUint(sink, token.size());
+        sink.Write(token.data(), token.size());
+        continue;
+      }
+
+      auto const & prev = m_tokens[i - 1];
+      size_t const common =
+          std::mismatch(token.begin(), token.begin() + std::min(token.size(), prev.size()),
+                        prev.begin())
+              .first -
+          token.begin();
+      WriteVarUint(sink, common);
+      WriteVarUint(sink, token.size() - common);
+      sink.Write(token.data() + common, token.size() - common);
     }
     offsets.emplace_back(RelativePos(sink, startPos));
 
@@ -72,45 +114,138 @@ public:
   void Deserialize(Source & source, TextIndexHeader const & header)
   {
     auto const startPos = source.Pos();
+    size_t const numBlocks = GetDictionaryBlocksCount(header.m_numTokens);
 
-    std::vector<uint32_t> tokenOffsets(header.m_numTokens + 1);
-    for (uint32_t & offset : tokenOffsets)
+    std::vector<uint32_t> blockOffsets(numBlocks + 1);
+    for (uint32_t & offset : blockOffsets)
       offset = ReadPrimitiveFromSource<uint32_t>(source);
 
     uint64_t const expectedSize = header.m_dictWordsOffset - header.m_dictPositionsOffset;
     CHECK_EQUAL(source.Pos(), startPos + expectedSize, ());
+
     m_tokens.resize(header.m_numTokens);
     for (size_t i = 0; i < m_tokens.size(); ++i)
     {
-      size_t const size = base::checked_cast<size_t>(tokenOffsets[i + 1] - tokenOffsets[i]);
-      DeserializeToken(source, m_tokens[i], size);
+      auto & token = m_tokens[i];
+      size_t common = 0;
+      if (i % kDictionaryBlockSize != 0)
+      {
+        common = ReadVarUint<uint32_t>(source);
+        CHECK_LESS_OR_EQUAL(common, m_tokens[i - 1].size(), ());
+        token.assign(m_tokens[i - 1], 0, common);
+      }
+      size_t const size = ReadVarUint<uint32_t>(source);
+      CHECK_GREATER(common + size, 0, ());
+      token.resize(common + size);
+      source.Read(&token[common], size);
     }
   }
 
 private:
-  template <typename Sink>
-  static void SerializeToken(Sink & sink, Token const & token)
+  std::vector<Token> m_tokens;
+};
+
+// The dictionary of a text index in memory. Nothing is decoded on construction and
+// lookups allocate at most one token.
+class TextIndexDictionaryView
+{
+public:
+  TextIndexDictionaryView() = default;
+
+  // |index| is the beginning of the text index, it must outlive the view.
+  TextIndexDictionaryView(uint8_t const * index, TextIndexHeader const & header)
+    : m_blockOffsets(index + header.m_dictPositionsOffset)
+    , m_index(index)
+    , m_numTokens(header.m_numTokens)
+    , m_numBlocks(GetDictionaryBlocksCount(header.m_numTokens))
   {
-    CHECK(!token.empty(), ());
-    // todo(@m) Endianness.
-    sink.Write(token.data(), token.size() * sizeof(typename Token::value_type));
   }
 
-  template <typename Source>
-  static void DeserializeToken(Source & source, Token & token, size_t size)
+  size_t GetTokensCount() const { return m_numTokens; }
+
+  bool GetTokenId(Token const & token, size_t & id) const
   {
-    CHECK_GREATER(size, 0, ());
-    ASSERT_EQUAL(size % sizeof(typename Token::value_type), 0, ());
-    token.resize(size / sizeof(typename Token::value_type));
-    source.Read(&token[0], size);
+    if (m_numBlocks == 0)
+      return false;
+
+    // Finds the last block whose first token is not greater than |token|.
+    size_t lo = 0;
+    size_t hi = m_numBlocks;
+    while (hi - lo > 1)
+    {
+      size_t const mid = lo + (hi - lo) / 2;
+      ArrayByteSource source(GetBlock(mid));
+      size_t const size = ReadVarUint<uint32_t>(source);
+      if (token.compare(0, Token::npos, source.PtrC(), size) < 0)
+        hi = mid;
+      else
+        lo = mid;
+    }
+
+    // The first token is compared without copying, that is enough for most lookups as
+    // the block size is small.
+    ArrayByteSource source(GetBlock(lo));
+    size_t size = ReadVarUint<uint32_t>(source);
+    int cmp = token.compare(0, Token::npos, source.PtrC(), size);
+    if (cmp <= 0)
+    {
+      id = lo * kDictionaryBlockSize;
+      return cmp == 0;
+    }
+
+    Token current(source.PtrC(), size);
+    source.Advance(size);
+    size_t const blockEnd = std::min(m_numTokens, (lo + 1) * kDictionaryBlockSize);
+    for (size_t i = lo * kDictionaryBlockSize + 1; i < blockEnd; ++i)
+    {
+      size_t const common = ReadVarUint<uint32_t>(source);
+      size = ReadVarUint<uint32_t>(source);
+      current.resize(common);
+      current.append(source.PtrC(), size);
+      source.Advance(size);
+
+      cmp = token.compare(current);
+      if (cmp <= 0)
+      {
+        id = i;
+        return cmp == 0;
+      }
+    }
+    return false;
   }
 
-  template <typename Sink>
-  static uint32_t RelativePos(Sink & sink, uint64_t startPos)
+  // Calls |fn| for every token in the lexicographical order.
+  template <typename Fn>
+  void ForEachToken(Fn && fn) const
   {
-    return base::checked_cast<uint32_t>(sink.Pos() - startPos);
+    if (m_numBlocks == 0)
+      return;
+
+    Token token;
+    ArrayByteSource source(GetBlock(0));
+    for (size_t i = 0; i < m_numTokens; ++i)
+    {
+      size_t common = 0;
+      if (i % kDictionaryBlockSize != 0)
+        common = ReadVarUint<uint32_t>(source);
+      size_t const size = ReadVarUint<uint32_t>(source);
+      token.resize(common);
+      token.append(source.PtrC(), size);
+      source.Advance(size);
+      fn(static_cast<Token const &>(token));
+    }
   }
 
-  std::vector<Token> m_tokens;
+private:
+  uint8_t const * GetBlock(size_t i) const
+  {
+    ASSERT_LESS(i, m_numBlocks, ());
+    return m_index + ReadUint32(m_blockOffsets + i * sizeof(uint32_t));
+  }
+
+  uint8_t const * m_blockOffsets = nullptr;
+  uint8_t const * m_index = nullptr;
+  size_t m_numTokens = 0;
+  size_t m_numBlocks = 0;
 };
 }  // namespace search_base
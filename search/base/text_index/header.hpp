@@ -18,7 +18,7 @@ struct TextIndexHeader
   template <typename Sink>
   void Serialize(Sink & sink) const
   {
-    CHECK_EQUAL(m_version, TextIndexVersion::V0, ());
+    CHECK_EQUAL(m_version, TextIndexVersion::Latest, ());
 
     sink.Write(kHeaderMagic.data(), kHeaderMagic.size());
     WriteToSink(sink, static_cast<uint8_t>(m_version));
@@ -32,13 +32,14 @@ struct TextIndexHeader
   template <typename Source>
   void Deserialize(Source & source)
   {
-    CHECK_EQUAL(m_version, TextIndexVersion::V0, ());
+    CHECK_EQUAL(m_version, TextIndexVersion::Latest, ());
 
     std::string headerMagic(kHeaderMagic.size(), ' ');
     source.Read(&headerMagic[0], headerMagic.size());
     CHECK_EQUAL(headerMagic, kHeaderMagic, ());
     m_version = static_cast<TextIndexVersion>(ReadPrimitiveFromSource<uint8_t>(source));
-    CHECK_EQUAL(m_version, TextIndexVersion::V0, ());
+    // Indexes of older versions are rebuilt rather than read.
+    CHECK_EQUAL(m_version, TextIndexVersion::Latest, ());
     m_numTokens = ReadPrimitiveFromSource<uint32_t>(source);
     m_dictPositionsOffset = ReadPrimitiveFromSource<uint32_t>(source);
     m_dictWordsOffset = ReadPrimitiveFromSource<uint32_t>(source);
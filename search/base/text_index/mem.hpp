@@ -147,16 +147,19 @@ private:
     auto const & tokens = m_dictionary.GetTokens();
     CHECK_EQUAL(source.Pos(), startPos + header.m_postingsListsOffset, ());
     m_postingsByToken.clear();
+    std::vector<uint8_t> buffer;
     for (size_t i = 0; i < header.m_numTokens; ++i)
     {
+      CHECK_EQUAL(source.Pos(), startPos + postingsStarts[i], ());
+      buffer.resize(postingsStarts[i + 1] - postingsStarts[i]);
+      source.Read(buffer.data(), buffer.size());
+
       std::vector<uint32_t> postings;
-      uint32_t last = 0;
-      while (source.Pos() < startPos + postingsStarts[i + 1])
+      for (PostingsIterator it(buffer.data(), buffer.data() + buffer.size()); it.IsValid();
+           it.Next())
       {
-        last += ReadVarUint<uint32_t>(source);
-        postings.emplace_back(last);
+        postings.emplace_back(it.Get());
       }
-      CHECK_EQUAL(source.Pos(), postingsStarts[i + 1], ());
 
       m_postingsByToken.emplace(tokens[i], postings);
     }
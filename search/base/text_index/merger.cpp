@@ -3,18 +3,19 @@
 #include "search/base/text_index/dictionary.hpp"
 #include "search/base/text_index/header.hpp"
 #include "search/base/text_index/postings.hpp"
+#include "search/base/text_index/utils.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/file_writer.hpp"
-#include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
-#include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <iterator>
+#include <future>
 #include <utility>
 #include <vector>
 
@@ -24,71 +25,19 @@ namespace
 {
 using namespace search_base;
 
-class MergedPostingsListFetcher : public PostingsFetcher
-{
-public:
-  MergedPostingsListFetcher(TextIndexDictionary const & dict, TextIndexReader const & index1,
-                            TextIndexReader const & index2)
-    : m_dict(dict), m_index1(index1), m_index2(index2)
-  {
-    ReadPostings();
-  }
-
-  // PostingsFetcher overrides:
-  bool IsValid() const override
-  {
-    auto const & tokens = m_dict.GetTokens();
-    CHECK_LESS_OR_EQUAL(m_tokenId, tokens.size(), ());
-    return m_tokenId < tokens.size();
-  }
-
-  void Advance() override
-  {
-    auto const & tokens = m_dict.GetTokens();
-    CHECK_LESS_OR_EQUAL(m_tokenId, tokens.size(), ());
-    if (m_tokenId == tokens.size())
-      return;
-
-    ++m_tokenId;
-    ReadPostings();
-  }
+// Postings lists of this number of tokens per thread are kept in memory at once.
+size_t constexpr kTokensPerThreadInChunk = 4096;
 
-  void ForEachPosting(Fn const & fn) const override
-  {
-    CHECK(IsValid(), ());
-    for (uint32_t p : m_postings)
-      fn(p);
-  }
-
-private:
-  // Reads postings for the current token.
-  void ReadPostings()
-  {
-    m_postings.clear();
-    if (!IsValid())
-      return;
-
-    auto const & tokens = m_dict.GetTokens();
-    m_index1.ForEachPosting(tokens[m_tokenId], base::MakeBackInsertFunctor(m_postings));
-    m_index2.ForEachPosting(tokens[m_tokenId], base::MakeBackInsertFunctor(m_postings));
-    base::SortUnique(m_postings);
-  }
-
-  TextIndexDictionary const & m_dict;
-  TextIndexReader const & m_index1;
-  TextIndexReader const & m_index2;
-  // Index of the next token from |m_dict| to be processed.
-  size_t m_tokenId = 0;
-  vector<uint32_t> m_postings;
-};
-
-TextIndexDictionary MergeDictionaries(TextIndexDictionary const & dict1,
-                                      TextIndexDictionary const & dict2)
+TextIndexDictionary MergeDictionaries(vector<TextIndexReader const *> const & indexes)
 {
   vector<Token> commonTokens;
-  auto const & ts1 = dict1.GetTokens();
-  auto const & ts2 = dict2.GetTokens();
-  merge(ts1.begin(), ts1.end(), ts2.begin(), ts2.end(), back_inserter(commonTokens));
+  for (auto const * index : indexes)
+  {
+    auto const middle = commonTokens.size();
+    index->GetDictionary().ForEachToken(
+        [&commonTokens](Token const & token) { commonTokens.emplace_back(token); });
+    inplace_merge(commonTokens.begin(), commonTokens.begin() + middle, commonTokens.end());
+  }
   ASSERT(is_sorted(commonTokens.begin(), commonTokens.end()), ());
   commonTokens.erase(unique(commonTokens.begin(), commonTokens.end()), commonTokens.end());
 
@@ -96,16 +45,56 @@ TextIndexDictionary MergeDictionaries(TextIndexDictionary const & dict1,
   dict.SetTokens(move(commonTokens));
   return dict;
 }
+
+// Encodes the merged postings lists of tokens [begin, end) of |tokens| to |lists|,
+// the list of tokens[i] goes to lists[i - begin].
+void EncodePostingsLists(vector<TextIndexReader const *> const & indexes,
+                         vector<Token> const & tokens, size_t begin, size_t end,
+                         size_t threadsCount, vector<vector<uint8_t>> & lists)
+{
+  lists.resize(end - begin);
+
+  atomic<size_t> next(begin);
+  auto const encode = [&]() {
+    vector<Posting> postings;
+    for (size_t i = next++; i < end; i = next++)
+    {
+      postings.clear();
+      for (auto const * index : indexes)
+        index->ForEachPosting(tokens[i], base::MakeBackInsertFunctor(postings));
+      base::SortUnique(postings);
+
+      auto & list = lists[i - begin];
+      list.clear();
+      PushBackByteSink<vector<uint8_t>> sink(list);
+      WritePostingsList(sink, postings);
+    }
+  };
+
+  if (threadsCount <= 1)
+  {
+    encode();
+    return;
+  }
+
+  vector<future<void>> encoded;
+  for (size_t i = 0; i < threadsCount; ++i)
+    encoded.push_back(async(launch::async, encode));
+  for (auto & f : encoded)
+    f.get();
+}
 }  // namespace
 
 namespace search_base
 {
 // static
-void TextIndexMerger::Merge(TextIndexReader const & index1, TextIndexReader const & index2,
-                            FileWriter & sink)
+void TextIndexMerger::Merge(vector<TextIndexReader const *> const & indexes, FileWriter & sink,
+                            size_t threadsCount)
 {
-  TextIndexDictionary const dict =
-      MergeDictionaries(index1.GetDictionary(), index2.GetDictionary());
+  CHECK_GREATER(threadsCount, 0, ());
+
+  TextIndexDictionary const dict = MergeDictionaries(indexes);
+  auto const & tokens = dict.GetTokens();
 
   TextIndexHeader header;
 
@@ -115,13 +104,44 @@ void TextIndexMerger::Merge(TextIndexReader const & index1, TextIndexReader cons
 
   dict.Serialize(sink, header, startPos);
 
-  MergedPostingsListFetcher fetcher(dict, index1, index2);
-  WritePostings(sink, startPos, header, fetcher);
+  header.m_postingsStartsOffset = RelativePos(sink, startPos);
+  // An uint32_t for each 32-bit offset and an uint32_t for the dummy entry at the end.
+  WriteZeroesToSink(sink, sizeof(uint32_t) * (header.m_numTokens + 1));
+  header.m_postingsListsOffset = RelativePos(sink, startPos);
 
-  // Fill in the header.
+  vector<uint32_t> postingsStarts;
+  postingsStarts.reserve(tokens.size() + 1);
+  size_t const chunkSize = kTokensPerThreadInChunk * threadsCount;
+  vector<vector<uint8_t>> lists;
+  for (size_t begin = 0; begin < tokens.size(); begin += chunkSize)
+  {
+    size_t const end = min(tokens.size(), begin + chunkSize);
+    EncodePostingsLists(indexes, tokens, begin, end, threadsCount, lists);
+    for (auto const & list : lists)
+    {
+      postingsStarts.emplace_back(RelativePos(sink, startPos));
+      sink.Write(list.data(), list.size());
+    }
+  }
+  // One more for convenience.
+  postingsStarts.emplace_back(RelativePos(sink, startPos));
+
+  // Fill in the offsets and the header.
   uint64_t const finishPos = sink.Pos();
+  sink.Seek(startPos + header.m_postingsStartsOffset);
+  for (uint32_t const s : postingsStarts)
+    WriteToSink(sink, s);
+  CHECK_EQUAL(sink.Pos(), startPos + header.m_postingsListsOffset, ());
+
   sink.Seek(startPos);
   header.Serialize(sink);
   sink.Seek(finishPos);
 }
+
+// static
+void TextIndexMerger::Merge(TextIndexReader const & index1, TextIndexReader const & index2,
+                            FileWriter & sink)
+{
+  Merge({&index1, &index2}, sink);
+}
 }  // namespace search_base
@@ -2,25 +2,32 @@
 
 #include "search/base/text_index/reader.hpp"
 
+#include <cstddef>
+#include <vector>
+
 class FileWriter;
 
 namespace search_base
 {
-// Merges two on-disk text indexes and writes them to a new one.
+// Merges on-disk text indexes and writes them to a new one.
 class TextIndexMerger
 {
 public:
   // The merging process is as follows.
-  // 1. Dictionaries from both indexes are read into memory, merged
+  // 1. Dictionaries from all indexes are read into memory, merged
   //    and written to disk.
   // 2. One uint32_t per entry is reserved in memory to calculate the
   //    offsets of the postings lists.
-  // 3. One token at a time, all postings for the token are read from
-  //    both indexes into memory, unified and written to disk.
+  // 3. Tokens are processed by chunks. Postings lists of tokens of a chunk
+  //    are read from all indexes, unified and encoded by |threadsCount|
+  //    threads and then written to disk in the order of tokens.
   // 4. The offsets are written to disk.
   //
   // Note that the dictionary and offsets are kept in memory during the whole
   // merging process.
+  static void Merge(std::vector<TextIndexReader const *> const & indexes, FileWriter & sink,
+                    size_t threadsCount = 1);
+
   static void Merge(TextIndexReader const & index1, TextIndexReader const & index2,
                     FileWriter & sink);
 };
@@ -4,16 +4,286 @@
 #include "search/base/text_index/text_index.hpp"
 #include "search/base/text_index/utils.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <vector>
 
+// A postings list is stored as
+//   [vu: number of postings]
+// followed by delta-encoded varints if there are less than kMinBlockedPostings postings and
+// by blocks of kPostingsBlockSize postings otherwise (the last block may be shorter):
+//   [8 * numBlocks: skip entries] [block] ... [block]
+//
+// A skip entry is [4: last posting of the block] [4: end of the block], the end is counted
+// from the first block. Skip entries allow to find the block of a posting without decoding
+// postings of the other blocks.
+//
+// Postings of a block are Elias-Fano encoded relative to the block base, which is zero for
+// the first block and the last posting of the previous block plus one otherwise:
+//   [1: number of low bits l]
+//   [ceil(n * l / 8): low bits of postings]
+//   [ceil((n + (maxValue >> l)) / 8): high bits of postings in unary]
+// Bits are written starting from the least significant bit of the first byte.
 namespace search_base
 {
-struct TextIndexHeader;
+size_t constexpr kPostingsBlockSize = 128;
+size_t constexpr kMinBlockedPostings = 16;
+
+namespace impl
+{
+inline void WriteBits(std::vector<uint8_t> & bits, uint64_t pos, uint32_t value, uint8_t count)
+{
+  for (uint8_t i = 0; i < count; ++i, ++pos)
+  {
+    if ((value >> i) & 1)
+      bits[pos / 8] |= static_cast<uint8_t>(1 << (pos % 8));
+  }
+}
+
+inline uint32_t ReadBits(uint8_t const * bits, uint64_t pos, uint8_t count)
+{
+  ASSERT_LESS_OR_EQUAL(count, 32, ());
+  uint64_t value = 0;
+  uint8_t read = 0;
+  uint8_t const shift = pos % 8;
+  for (uint8_t const * p = bits + pos / 8; read < count + shift; ++p, read += 8)
+    value |= static_cast<uint64_t>(*p) << read;
+  return static_cast<uint32_t>((value >> shift) & ((uint64_t{1} << count) - 1));
+}
+
+inline uint8_t GetLowBitsCount(uint32_t maxValue, size_t count)
+{
+  uint64_t const ratio = (static_cast<uint64_t>(maxValue) + 1) / count;
+  return ratio <= 1 ? 0 : bits::FloorLog(ratio);
+}
+
+// Writes postings [begin, end) which are not less than |blockBase|.
+template <typename Sink>
+void WritePostingsBlock(Sink & sink, Posting const * begin, Posting const * end,
+                        Posting blockBase)
+{
+  size_t const n = static_cast<size_t>(end - begin);
+  ASSERT_GREATER(n, 0, ());
+  uint32_t const maxValue = *(end - 1) - blockBase;
+  uint8_t const l = GetLowBitsCount(maxValue, n);
+
+  std::vector<uint8_t> lowBits((n * l + 7) / 8);
+  std::vector<uint8_t> highBits((n + (maxValue >> l) + 7) / 8);
+  for (size_t i = 0; i < n; ++i)
+  {
+    uint32_t const value = begin[i] - blockBase;
+    WriteBits(lowBits, i * l, value, l);
+    uint64_t const pos = (value >> l) + i;
+    highBits[pos / 8] |= static_cast<uint8_t>(1 << (pos % 8));
+  }
+
+  WriteToSink(sink, l);
+  sink.Write(lowBits.data(), lowBits.size());
+  sink.Write(highBits.data(), highBits.size());
+}
+}  // namespace impl
+
+// Writes |postings|, which must be sorted and unique.
+template <typename Sink>
+void WritePostingsList(Sink & sink, std::vector<Posting> const & postings)
+{
+  ASSERT(std::adjacent_find(postings.begin(), postings.end(), std::greater_equal<Posting>()) ==
+             postings.end(),
+         ());
+
+  WriteVarUint(sink, base::checked_cast<uint32_t>(postings.size()));
+  if (postings.size() < kMinBlockedPostings)
+  {
+    Posting last = 0;
+    for (auto const p : postings)
+    {
+      WriteVarUint(sink, p - last);
+      last = p;
+    }
+    return;
+  }
+
+  std::vector<uint8_t> blocks;
+  std::vector<std::pair<Posting, uint32_t>> skips;
+  {
+    PushBackByteSink<std::vector<uint8_t>> blocksSink(blocks);
+    Posting blockBase = 0;
+    for (size_t i = 0; i < postings.size(); i += kPostingsBlockSize)
+    {
+      auto const * begin = postings.data() + i;
+      auto const * end = postings.data() + std::min(postings.size(), i + kPostingsBlockSize);
+      impl::WritePostingsBlock(blocksSink, begin, end, blockBase);
+      skips.emplace_back(*(end - 1), base::checked_cast<uint32_t>(blocks.size()));
+      blockBase = *(end - 1) + 1;
+    }
+  }
+
+  for (auto const & skip : skips)
+  {
+    WriteToSink(sink, skip.first);
+    WriteToSink(sink, skip.second);
+  }
+  sink.Write(blocks.data(), blocks.size());
+}
+
+// Iterates over a postings list which is written by WritePostingsList() to [begin, end).
+// The list is read in place and decoded by blocks, so the memory must outlive the iterator.
+class PostingsIterator
+{
+public:
+  // Creates an iterator over an empty list.
+  PostingsIterator() = default;
+
+  PostingsIterator(uint8_t const * begin, uint8_t const * end)
+  {
+    ArrayByteSource source(begin);
+    m_count = ReadVarUint<uint32_t>(source);
+    if (m_count == 0)
+      return;
+
+    if (m_count < kMinBlockedPostings)
+    {
+      Posting last = 0;
+      for (size_t i = 0; i < m_count; ++i)
+      {
+        last += ReadVarUint<uint32_t>(source);
+        m_block[i] = last;
+      }
+      CHECK_EQUAL(source.PtrUC(), end, ());
+      m_blocksCount = 1;
+      m_blockSize = m_count;
+      return;
+    }
+
+    m_blocksCount = (m_count + kPostingsBlockSize - 1) / kPostingsBlockSize;
+    m_skips = source.PtrUC();
+    m_blocks = m_skips + 2 * sizeof(uint32_t) * m_blocksCount;
+    CHECK_EQUAL(m_blocks + GetBlockEnd(m_blocksCount - 1), end, ());
+    LoadBlock(0);
+  }
+
+  // Returns the number of postings in the list.
+  size_t GetCount() const { return m_count; }
+
+  bool IsValid() const { return m_blockIndex < m_blocksCount; }
+
+  Posting Get() const
+  {
+    ASSERT(IsValid(), ());
+    return m_block[m_pos];
+  }
+
+  void Next()
+  {
+    ASSERT(IsValid(), ());
+    if (++m_pos < m_blockSize)
+      return;
+
+    ++m_blockIndex;
+    if (IsValid())
+      LoadBlock(m_blockIndex);
+  }
+
+  // Advances the iterator to the first posting which is not less than |posting|.
+  // Blocks which are skipped are not decoded.
+  void SkipTo(Posting posting)
+  {
+    if (!IsValid() || Get() >= posting)
+      return;
+
+    if (m_skips != nullptr && GetBlockLast(m_blockIndex) < posting)
+    {
+      size_t lo = m_blockIndex + 1;
+      size_t hi = m_blocksCount;
+      while (lo < hi)
+      {
+        size_t const mid = lo + (hi - lo) / 2;
+        if (GetBlockLast(mid) < posting)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      m_blockIndex = lo;
+      if (!IsValid())
+        return;
+      LoadBlock(m_blockIndex);
+    }
+
+    m_pos = static_cast<size_t>(
+        std::lower_bound(m_block.begin() + m_pos, m_block.begin() + m_blockSize, posting) -
+        m_block.begin());
+    if (m_pos == m_blockSize)
+    {
+      // Only the last posting of a list without skip entries may be less than |posting|.
+      ASSERT(m_skips == nullptr, ());
+      m_blockIndex = m_blocksCount;
+    }
+  }
+
+private:
+  Posting GetBlockLast(size_t i) const
+  {
+    return ReadUint32(m_skips + 2 * sizeof(uint32_t) * i);
+  }
+
+  uint32_t GetBlockEnd(size_t i) const
+  {
+    return ReadUint32(m_skips + 2 * sizeof(uint32_t) * i + sizeof(uint32_t));
+  }
+
+  void LoadBlock(size_t i)
+  {
+    ASSERT_LESS(i, m_blocksCount, ());
+    Posting const blockBase = i == 0 ? 0 : GetBlockLast(i - 1) + 1;
+    uint32_t const maxValue = GetBlockLast(i) - blockBase;
+    uint8_t const * block = m_blocks + (i == 0 ? 0 : GetBlockEnd(i - 1));
+
+    m_blockSize = std::min(kPostingsBlockSize, m_count - i * kPostingsBlockSize);
+    m_pos = 0;
+
+    uint8_t const l = *block;
+    ASSERT_EQUAL(l, impl::GetLowBitsCount(maxValue, m_blockSize), ());
+    uint8_t const * lowBits = block + 1;
+    uint8_t const * highBits = lowBits + (m_blockSize * l + 7) / 8;
+
+    size_t n = 0;
+    for (size_t byte = 0; n < m_blockSize; ++byte)
+    {
+      ASSERT_LESS(byte, (m_blockSize + (maxValue >> l) + 7) / 8, ());
+      uint8_t word = highBits[byte];
+      while (word != 0 && n < m_blockSize)
+      {
+        uint32_t const pos = static_cast<uint32_t>(byte * 8) + bits::CountTrailingZeros(word);
+        uint32_t const high = pos - static_cast<uint32_t>(n);
+        uint32_t const low = l == 0 ? 0 : impl::ReadBits(lowBits, n * l, l);
+        m_block[n++] = blockBase + ((high << l) | low);
+        word &= word - 1;
+      }
+    }
+  }
+
+  uint8_t const * m_skips = nullptr;
+  uint8_t const * m_blocks = nullptr;
+  size_t m_count = 0;
+  size_t m_blocksCount = 0;
+
+  // Decoded postings of the current block.
+  std::array<Posting, kPostingsBlockSize> m_block;
+  size_t m_blockIndex = 0;
+  size_t m_blockSize = 0;
+  size_t m_pos = 0;
+};
 
 // A helper class that fetches the postings lists for
 // one token at a time. It is assumed that the tokens
@@ -56,19 +326,14 @@ void WritePostings(Sink & sink, uint64_t startPos, TextIndexHeader & header,
   std::vector<uint32_t> postingsStarts;
   postingsStarts.reserve(header.m_numTokens);
   {
-    uint32_t last;
-    // todo(@m) s/uint32_t/Posting/ ?
-    auto writePostings = [&](uint32_t p) {
-      CHECK(last == 0 || last < p, (last, p));
-      uint32_t const delta = p - last;
-      WriteVarUint(sink, delta);
-      last = p;
-    };
+    std::vector<Posting> postings;
+    auto addPosting = [&](uint32_t p) { postings.emplace_back(p); };
     while (fetcher.IsValid())
     {
       postingsStarts.emplace_back(RelativePos(sink, startPos));
-      last = 0;
-      fetcher.ForEachPosting(writePostings);
+      postings.clear();
+      fetcher.ForEachPosting(addPosting);
+      WritePostingsList(sink, postings);
       fetcher.Advance();
     }
   }
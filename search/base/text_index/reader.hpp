@@ -1,15 +1,21 @@
 #pragma once
 
 #include "search/base/text_index/dictionary.hpp"
+#include "search/base/text_index/header.hpp"
+#include "search/base/text_index/postings.hpp"
 #include "search/base/text_index/text_index.hpp"
+#include "search/base/text_index/utils.hpp"
 
 #include "coding/file_reader.hpp"
 #include "coding/reader.hpp"
-#include "coding/varint.hpp"
 
 #include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/macros.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -17,62 +23,135 @@
 
 namespace search_base
 {
-// A reader class for on-demand reading of postings lists from disk.
+// A reader class for lookups in a text index which is in memory. Neither the dictionary
+// nor the postings lists are decoded on construction: tokens are looked up and postings
+// lists are decoded in place.
 class TextIndexReader
 {
 public:
-  explicit TextIndexReader(FileReader const & fileReader) : m_fileReader(fileReader)
+  // Reads the whole index from |fileReader| to memory.
+  explicit TextIndexReader(FileReader const & fileReader)
   {
-    ReaderSource<FileReader> headerSource(m_fileReader);
-    TextIndexHeader header;
-    header.Deserialize(headerSource);
-
-    uint64_t const dictStart = header.m_dictPositionsOffset;
-    uint64_t const dictEnd = header.m_postingsStartsOffset;
-    ReaderSource<FileReader> dictSource(m_fileReader.SubReader(dictStart, dictEnd - dictStart));
-    m_dictionary.Deserialize(dictSource, header);
-
-    uint64_t const postStart = header.m_postingsStartsOffset;
-    uint64_t const postEnd = header.m_postingsListsOffset;
-    ReaderSource<FileReader> postingsSource(m_fileReader.SubReader(postStart, postEnd - postStart));
-    m_postingsStarts.resize(header.m_numTokens + 1);
-    for (uint32_t & start : m_postingsStarts)
-      start = ReadPrimitiveFromSource<uint32_t>(postingsSource);
+    m_buffer.resize(base::checked_cast<size_t>(fileReader.Size()));
+    fileReader.Read(0 /* pos */, m_buffer.data(), m_buffer.size());
+    Init(m_buffer.data(), m_buffer.size());
   }
 
+  // Uses the index in [data, data + size), e.g. a memory mapped file. The memory must
+  // outlive the reader.
+  TextIndexReader(uint8_t const * data, size_t size) { Init(data, size); }
+
+  TextIndexReader(TextIndexReader && rhs) = default;
+
   // Executes |fn| on every posting associated with |token|.
-  // The order of postings is not specified.
+  // Postings are passed in the increasing order.
   template <typename Fn>
   void ForEachPosting(Token const & token, Fn && fn) const
   {
-    size_t tokenId = 0;
-    if (!m_dictionary.GetTokenId(token, tokenId))
+    for (auto it = GetPostings(token); it.IsValid(); it.Next())
+      fn(it.Get());
+  }
+
+  template <typename Fn>
+  void ForEachPosting(strings::UniString const & token, Fn && fn) const
+  {
+    auto const utf8s = strings::ToUtf8(token);
+    ForEachPosting(std::move(utf8s), std::forward<Fn>(fn));
+  }
+
+  // Executes |fn| on every posting which is associated with all |tokens|, in the increasing
+  // order. Postings lists are intersected starting from the shortest one, longer lists
+  // are advanced by skip entries.
+  template <typename Fn>
+  void ForEachCommonPosting(std::vector<Token> const & tokens, Fn && fn) const
+  {
+    if (tokens.empty())
       return;
-    CHECK_LESS(tokenId + 1, m_postingsStarts.size(), ());
 
-    ReaderSource<FileReader> source(m_fileReader.SubReader(
-        m_postingsStarts[tokenId], m_postingsStarts[tokenId + 1] - m_postingsStarts[tokenId]));
+    std::vector<PostingsIterator> its;
+    its.reserve(tokens.size());
+    for (auto const & token : tokens)
+    {
+      its.emplace_back(GetPostings(token));
+      if (!its.back().IsValid())
+        return;
+    }
+    std::sort(its.begin(), its.end(),
+              [](PostingsIterator const & lhs, PostingsIterator const & rhs) {
+                return lhs.GetCount() < rhs.GetCount();
+              });
 
-    uint32_t last = 0;
-    while (source.Size() > 0)
+    auto & shortest = its.front();
+    while (shortest.IsValid())
     {
-      last += ReadVarUint<uint32_t>(source);
-      fn(last);
+      Posting const candidate = shortest.Get();
+      Posting next = candidate;
+      for (size_t i = 1; i < its.size() && next == candidate; ++i)
+      {
+        its[i].SkipTo(candidate);
+        if (!its[i].IsValid())
+          return;
+        next = its[i].Get();
+      }
+
+      if (next == candidate)
+      {
+        fn(candidate);
+        shortest.Next();
+      }
+      else
+      {
+        shortest.SkipTo(next);
+      }
     }
   }
 
-  template <typename Fn>
-  void ForEachPosting(strings::UniString const & token, Fn && fn) const
+  // Returns an iterator over the postings list of |token|, the list is empty when
+  // there is no |token| in the index. The iterator must not outlive the reader.
+  PostingsIterator GetPostings(Token const & token) const
   {
-    auto const utf8s = strings::ToUtf8(token);
-    ForEachPosting(std::move(utf8s), std::forward<Fn>(fn));
+    size_t tokenId = 0;
+    if (!m_dictionary.GetTokenId(token, tokenId))
+      return {};
+    CHECK_LESS(tokenId, m_dictionary.GetTokensCount(), ());
+
+    uint8_t const * starts = m_data + m_header.m_postingsStartsOffset;
+    uint32_t const begin = ReadUint32(starts + tokenId * sizeof(uint32_t));
+    uint32_t const end = ReadUint32(starts + (tokenId + 1) * sizeof(uint32_t));
+    CHECK_LESS_OR_EQUAL(begin, end, ());
+    CHECK_LESS_OR_EQUAL(end, m_size, ());
+    return PostingsIterator(m_data + begin, m_data + end);
   }
 
-  TextIndexDictionary const & GetDictionary() const { return m_dictionary; }
+  TextIndexDictionaryView const & GetDictionary() const { return m_dictionary; }
 
 private:
-  FileReader m_fileReader;
-  TextIndexDictionary m_dictionary;
-  std::vector<uint32_t> m_postingsStarts;
+  void Init(uint8_t const * data, size_t size)
+  {
+    m_data = data;
+    m_size = size;
+
+    MemReader reader(m_data, m_size);
+    ReaderSource<MemReader> source(reader);
+    m_header.Deserialize(source);
+
+    CHECK_LESS_OR_EQUAL(m_header.m_dictPositionsOffset, m_header.m_dictWordsOffset, ());
+    CHECK_LESS_OR_EQUAL(m_header.m_dictWordsOffset, m_header.m_postingsStartsOffset, ());
+    CHECK_LESS_OR_EQUAL(m_header.m_postingsStartsOffset, m_header.m_postingsListsOffset, ());
+    CHECK_LESS_OR_EQUAL(m_header.m_postingsListsOffset, m_size, ());
+    CHECK_EQUAL(m_header.m_postingsListsOffset - m_header.m_postingsStartsOffset,
+                sizeof(uint32_t) * (m_header.m_numTokens + 1), ());
+
+    m_dictionary = TextIndexDictionaryView(m_data, m_header);
+  }
+
+  // The copy of the index when it is read from a file.
+  std::vector<uint8_t> m_buffer;
+  uint8_t const * m_data = nullptr;
+  size_t m_size = 0;
+  TextIndexHeader m_header;
+  TextIndexDictionaryView m_dictionary;
+
+  DISALLOW_COPY(TextIndexReader);
 };
 }  // namespace search_base
@@ -12,6 +12,7 @@ string DebugPrint(TextIndexVersion const & version)
   switch (version)
   {
   case TextIndexVersion::V0: return "V0";
+  case TextIndexVersion::V1: return "V1";
   }
   string ret =
       "Unknown TextIndexHeader version: " + strings::to_string(static_cast<uint8_t>(version));
@@ -17,14 +17,21 @@
 // of merging several indexes together, or as a result of clearing outdated
 // entries from an old index.
 //
-// For version 0, the postings lists are docid arrays, i.e. arrays of unsigned
+// For version 1, the postings lists are docid arrays, i.e. arrays of unsigned
 // 32-bit integers stored in increasing order.
 // The structure of the index is:
 //   [header: version and offsets]
-//   [array containing the starting positions of tokens]
-//   [tokens, written without separators in the lexicographical order]
+//   [array containing the starting positions of dictionary blocks]
+//   [dictionary blocks of front-coded tokens in the lexicographical order]
 //   [array containing the offsets for the postings lists]
-//   [postings lists, stored as delta-encoded varints]
+//   [postings lists, compressed by blocks with skip entries]
+//
+// See dictionary.hpp and postings.hpp for the formats of the dictionary blocks
+// and of the postings lists. Both are read in place, so the index may be
+// mapped to memory and looked up without decoding it as a whole.
+//
+// Version 0 stored tokens and postings lists uncompressed and is not
+// supported anymore.
 //
 // All offsets are measured relative to the start of the index.
 namespace search_base
@@ -35,7 +42,8 @@ using Posting = uint32_t;
 enum class TextIndexVersion : uint8_t
 {
   V0 = 0,
-  Latest = V0
+  V1 = 1,
+  Latest = V1
 };
 
 std::string DebugPrint(TextIndexVersion const & version);
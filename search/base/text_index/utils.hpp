@@ -1,8 +1,11 @@
 #pragma once
 
+#include "coding/endianness.hpp"
+
 #include "base/checked_cast.hpp"
 
 #include <cstdint>
+#include <cstring>
 
 namespace search_base
 {
@@ -11,4 +14,12 @@ uint32_t RelativePos(Sink & sink, uint64_t startPos)
 {
   return base::checked_cast<uint32_t>(sink.Pos() - startPos);
 }
+
+// Reads a little-endian uint32_t which is not necessarily aligned.
+inline uint32_t ReadUint32(uint8_t const * p)
+{
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return SwapIfBigEndianMacroBased(value);
+}
 }  // namespace search_base
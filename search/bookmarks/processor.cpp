@@ -22,20 +22,6 @@ namespace bookmarks
 {
 namespace
 {
-struct DocVecWrapper
-{
-  explicit DocVecWrapper(DocVec const & dv) : m_dv(dv) {}
-
-  template <typename Fn>
-  void ForEachToken(Fn && fn) const
-  {
-    for (size_t i = 0; i < m_dv.GetNumTokens(); ++i)
-      fn(StringUtf8Multilang::kDefaultCode, m_dv.GetToken(i));
-  }
-
-  DocVec const & m_dv;
-};
-
 struct RankingInfo
 {
   bool operator<(RankingInfo const & rhs) const
@@ -73,31 +59,14 @@ void FillRankingInfo(QueryVec & qv, IdfMap & idfs, DocVec const & dv, RankingInf
 }  // namespace
 
 Processor::Processor(Emitter & emitter, base::Cancellable const & cancellable)
-  : m_emitter(emitter), m_cancellable(cancellable)
+  : m_emitter(emitter), m_cancellable(cancellable), m_snapshot(make_shared<Snapshot>())
 {
 }
 
-void Processor::Add(Id const & id, Doc const & doc)
+void Processor::SetSnapshot(shared_ptr<Snapshot const> snapshot)
 {
-  ASSERT_EQUAL(m_docs.count(id), 0, ());
-
-  DocVec::Builder builder;
-  doc.ForEachToken(
-      [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
-
-  DocVec const docVec(builder);
-
-  m_index.Add(id, DocVecWrapper(docVec));
-  m_docs[id] = docVec;
-}
-
-void Processor::Erase(Id const & id)
-{
-  ASSERT_EQUAL(m_docs.count(id), 1, ());
-
-  auto const & docVec = m_docs[id];
-  m_index.Erase(id, DocVecWrapper(docVec));
-  m_docs.erase(id);
+  CHECK(snapshot, ());
+  m_snapshot = move(snapshot);
 }
 
 void Processor::Search(QueryParams const & params) const
@@ -124,12 +93,11 @@ void Processor::Search(QueryParams const & params) const
   {
     BailIfCancelled();
 
-    auto it = m_docs.find(id);
-    ASSERT(it != m_docs.end(), ("Can't find retrieved doc:", id));
-    auto const & doc = it->second;
+    auto const * doc = m_snapshot->GetDoc(id);
+    ASSERT(doc, ("Can't find retrieved doc:", id));
 
     RankingInfo info;
-    FillRankingInfo(qv, idfs, doc, info);
+    FillRankingInfo(qv, idfs, *doc, info);
 
     idInfos.emplace_back(id, info);
   }
@@ -144,7 +112,7 @@ void Processor::Search(QueryParams const & params) const
 uint64_t Processor::GetNumDocs(strings::UniString const & token, bool isPrefix) const
 {
   return base::asserted_cast<uint64_t>(
-      m_index.GetNumDocs(StringUtf8Multilang::kDefaultCode, token, isPrefix));
+      m_snapshot->GetIndex().GetNumDocs(StringUtf8Multilang::kDefaultCode, token, isPrefix));
 }
 
 QueryVec Processor::GetQueryVec(IdfMap & idfs, QueryParams const & params) const
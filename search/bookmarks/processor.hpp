@@ -1,7 +1,7 @@
 #pragma once
 
-#include "search/base/mem_search_index.hpp"
 #include "search/bookmarks/results.hpp"
+#include "search/bookmarks/snapshot.hpp"
 #include "search/bookmarks/types.hpp"
 #include "search/cancel_exception.hpp"
 #include "search/doc_vec.hpp"
@@ -11,9 +11,8 @@
 #include "search/utils.hpp"
 
 #include <cstdint>
-#include <unordered_map>
+#include <memory>
 #include <utility>
-#include <vector>
 
 namespace base
 {
@@ -29,13 +28,11 @@ namespace bookmarks
 class Processor : public IdfMap::Delegate
 {
 public:
-  using Index = search_base::MemSearchIndex<Id>;
-
   Processor(Emitter & emitter, base::Cancellable const & cancellable);
   ~Processor() override = default;
 
-  void Add(Id const & id, Doc const & doc);
-  void Erase(Id const & id);
+  // Sets bookmarks which are searched by the following queries.
+  void SetSnapshot(std::shared_ptr<Snapshot const> snapshot);
 
   void Search(QueryParams const & params) const;
 
@@ -55,7 +52,7 @@ private:
                   });
     request.m_langs.insert(StringUtf8Multilang::kDefaultCode);
 
-    MatchFeaturesInTrie(request, m_index.GetRootIterator(),
+    MatchFeaturesInTrie(request, m_snapshot->GetIndex().GetRootIterator(),
                         [](Id const & /* id */) { return true; } /* filter */,
                         std::forward<Fn>(fn));
   }
@@ -65,8 +62,7 @@ private:
   Emitter & m_emitter;
   base::Cancellable const & m_cancellable;
 
-  Index m_index;
-  std::unordered_map<Id, DocVec> m_docs;
+  std::shared_ptr<Snapshot const> m_snapshot;
 };
 }  // namespace bookmarks
 }  // namespace search
@@ -0,0 +1,173 @@
+#include "search/bookmarks/snapshot.hpp"
+
+#include "coding/multilang_utf8_string.hpp"
+
+#include "base/assert.hpp"
+
+#include <utility>
+
+using namespace std;
+
+namespace search
+{
+namespace bookmarks
+{
+namespace
+{
+struct DocVecWrapper
+{
+  explicit DocVecWrapper(DocVec const & dv) : m_dv(dv) {}
+
+  template <typename Fn>
+  void ForEachToken(Fn && fn) const
+  {
+    for (size_t i = 0; i < m_dv.GetNumTokens(); ++i)
+      fn(StringUtf8Multilang::kDefaultCode, m_dv.GetToken(i));
+  }
+
+  DocVec const & m_dv;
+};
+}  // namespace
+
+// Snapshot::Builder -------------------------------------------------------------------------------
+// static
+size_t constexpr Snapshot::Builder::kMaxIncrementalEdits;
+
+Snapshot::Builder::Builder(Snapshot const & snapshot)
+  : m_index(snapshot.m_index.Clone()), m_docs(snapshot.m_docs), m_incremental(true)
+{
+}
+
+void Snapshot::Builder::Add(Id const & id, Doc const & doc)
+{
+  ASSERT_EQUAL(m_docs.count(id), 0, ());
+
+  DocVec::Builder builder;
+  doc.ForEachToken(
+      [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
+  auto const & docVec = m_docs[id] = DocVec(builder);
+
+  if (StartIncrementalEdit())
+    m_index.Add(id, DocVecWrapper(docVec));
+}
+
+void Snapshot::Builder::Erase(Id const & id)
+{
+  auto const it = m_docs.find(id);
+  ASSERT(it != m_docs.end(), (id));
+  if (it == m_docs.end())
+    return;
+
+  if (StartIncrementalEdit())
+    m_index.Erase(id, DocVecWrapper(it->second));
+  m_docs.erase(it);
+}
+
+shared_ptr<Snapshot const> Snapshot::Builder::Build()
+{
+  auto snapshot = make_shared<Snapshot>();
+  if (m_incremental)
+  {
+    snapshot->m_index = move(m_index);
+  }
+  else
+  {
+    Index::Builder builder;
+    for (auto const & idDoc : m_docs)
+      builder.Add(idDoc.first, DocVecWrapper(idDoc.second));
+    snapshot->m_index = builder.Build();
+  }
+
+  snapshot->m_docs.swap(m_docs);
+  m_docs.clear();
+  m_index = Index();
+  m_incremental = false;
+  m_numEdits = 0;
+  return snapshot;
+}
+
+bool Snapshot::Builder::StartIncrementalEdit()
+{
+  if (!m_incremental)
+    return false;
+
+  if (++m_numEdits > kMaxIncrementalEdits)
+  {
+    m_incremental = false;
+    m_index = Index();
+    return false;
+  }
+
+  return true;
+}
+
+// Snapshot ----------------------------------------------------------------------------------------
+DocVec const * Snapshot::GetDoc(Id const & id) const
+{
+  auto const it = m_docs.find(id);
+  return it == m_docs.end() ? nullptr : &it->second;
+}
+
+// SnapshotHolder ----------------------------------------------------------------------------------
+SnapshotHolder::SnapshotHolder() : m_snapshot(make_shared<Snapshot>()) {}
+
+uint64_t SnapshotHolder::AddEdit(Edit && edit)
+{
+  lock_guard<mutex> lock(m_mu);
+  m_edits.push_back(move(edit));
+  return ++m_numEdits;
+}
+
+void SnapshotHolder::ApplyEdits()
+{
+  lock_guard<mutex> buildLock(m_buildMu);
+
+  vector<Edit> edits;
+  shared_ptr<Snapshot const> snapshot;
+  uint64_t numEdits = 0;
+  {
+    lock_guard<mutex> lock(m_mu);
+    edits.swap(m_edits);
+    snapshot = m_snapshot;
+    numEdits = m_numEdits;
+  }
+
+  // All edits are already applied by a previous build.
+  if (edits.empty())
+    return;
+
+  Snapshot::Builder builder(*snapshot);
+  for (auto const & edit : edits)
+    edit(builder);
+  snapshot = builder.Build();
+
+  lock_guard<mutex> lock(m_mu);
+  m_snapshot = move(snapshot);
+  m_numAppliedEdits = numEdits;
+}
+
+shared_ptr<Snapshot const> SnapshotHolder::GetSnapshot(uint64_t numEdits)
+{
+  {
+    lock_guard<mutex> lock(m_mu);
+    if (m_numAppliedEdits >= numEdits)
+      return m_snapshot;
+  }
+
+  // Either the edits are being applied by another thread right now,
+  // and then we wait for it on |m_buildMu|, or nobody has started to
+  // apply them yet.
+  ApplyEdits();
+
+  lock_guard<mutex> lock(m_mu);
+  ASSERT_GREATER_OR_EQUAL(m_numAppliedEdits, numEdits, ());
+  return m_snapshot;
+}
+
+uint64_t SnapshotHolder::GetNumEdits() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_numEdits;
+}
+}  // namespace bookmarks
+}  // namespace search
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "search/base/mem_search_index.hpp"
+#include "search/bookmarks/types.hpp"
+#include "search/doc_vec.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace search
+{
+namespace bookmarks
+{
+// Immutable set of bookmarks with a search index built on them. A
+// snapshot is shared between search threads, and changes of
+// bookmarks produce a new snapshot, so queries may run against the
+// old one while the new one is built.
+class Snapshot
+{
+public:
+  using Index = search_base::MemSearchIndex<Id>;
+
+  // Builds a snapshot. The first |kMaxIncrementalEdits| edits are
+  // applied to a copy of the index of the base snapshot. When there
+  // are more edits the copy is dropped and the index is bulk-loaded
+  // by Build(), which is faster for big batches.
+  class Builder
+  {
+  public:
+    static size_t constexpr kMaxIncrementalEdits = 256;
+
+    Builder() = default;
+
+    // Starts with all bookmarks of |snapshot|.
+    explicit Builder(Snapshot const & snapshot);
+
+    void Add(Id const & id, Doc const & doc);
+    void Erase(Id const & id);
+
+    // The builder is empty after the call.
+    std::shared_ptr<Snapshot const> Build();
+
+  private:
+    // Returns true when the edit must be applied to |m_index|.
+    bool StartIncrementalEdit();
+
+    Index m_index;
+    std::unordered_map<Id, DocVec> m_docs;
+    // True while |m_index| is kept up to date with |m_docs|.
+    bool m_incremental = false;
+    size_t m_numEdits = 0;
+  };
+
+  Index const & GetIndex() const { return m_index; }
+
+  // Returns nullptr when there is no bookmark with |id|.
+  DocVec const * GetDoc(Id const & id) const;
+
+  size_t GetNumDocs() const { return m_docs.size(); }
+
+private:
+  Index m_index;
+  std::unordered_map<Id, DocVec> m_docs;
+};
+
+// Keeps the latest snapshot of bookmarks and applies queued edits
+// to it. This class is thread-safe.
+class SnapshotHolder
+{
+public:
+  using Edit = std::function<void(Snapshot::Builder & builder)>;
+
+  SnapshotHolder();
+
+  // Queues |edit|. Returns the number of edits queued so far.
+  uint64_t AddEdit(Edit && edit);
+
+  // Builds a new snapshot with all queued edits applied. Does nothing
+  // when there are no queued edits.
+  void ApplyEdits();
+
+  // Returns the latest snapshot with at least |numEdits| first edits
+  // applied. Applies queued edits when necessary.
+  std::shared_ptr<Snapshot const> GetSnapshot(uint64_t numEdits);
+
+  uint64_t GetNumEdits() const;
+
+private:
+  // Serializes builds of snapshots.
+  std::mutex m_buildMu;
+
+  mutable std::mutex m_mu;
+  std::shared_ptr<Snapshot const> m_snapshot;
+  std::vector<Edit> m_edits;
+  uint64_t m_numEdits = 0;
+  uint64_t m_numAppliedEdits = 0;
+};
+}  // namespace bookmarks
+}  // namespace search
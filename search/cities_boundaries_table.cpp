@@ -10,25 +10,172 @@
 
 #include "coding/reader.hpp"
 
+#include "geometry/mercator.hpp"
+
 #include "base/assert.hpp"
 #include "base/cancellable.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 using namespace indexer;
 using namespace std;
 
 namespace search
 {
+// CitiesBoundariesTable::CellIndex ----------------------------------------------------------------
+// Grid from cells to the cities whose boundaries may contain points of the cells. As the
+// intersection of the boxes of a boundary is convex, a cell is inside the boundary iff all the
+// corners of the cell are inside it. For such cells the boundaries are not checked at all.
+class CitiesBoundariesTable::CellIndex
+{
+public:
+  enum class Location
+  {
+    Outside,
+    Inside,
+    Unknown
+  };
+
+  // Side of a cell in mercator, about 2 km on the equator.
+  static double constexpr kCellSize = 0.02;
+
+  CellIndex(unordered_map<uint32_t, BoundariesPtr> const & table, double eps)
+  {
+    for (auto const & kv : table)
+    {
+      for (auto const & boundary : *kv.second)
+        AddBoundary(kv.first, boundary, eps);
+    }
+
+    for (auto & kv : m_cells)
+    {
+      auto & entries = kv.second;
+      sort(entries.begin(), entries.end());
+      // A city may have several boundaries covering the same cell.
+      size_t last = 0;
+      for (size_t i = 1; i < entries.size(); ++i)
+      {
+        if (entries[i].m_fid == entries[last].m_fid)
+          entries[last].m_inside = entries[last].m_inside || entries[i].m_inside;
+        else
+          entries[++last] = entries[i];
+      }
+      entries.erase(entries.begin() + last + 1, entries.end());
+      entries.shrink_to_fit();
+    }
+  }
+
+  Location Locate(uint32_t fid, m2::PointD const & p) const
+  {
+    auto const it = m_cells.find(GetCellKey(p));
+    if (it == m_cells.end())
+      return Location::Outside;
+
+    auto const & entries = it->second;
+    auto const jt = lower_bound(entries.begin(), entries.end(), Entry(fid, false /* inside */));
+    if (jt == entries.end() || jt->m_fid != fid)
+      return Location::Outside;
+    return jt->m_inside ? Location::Inside : Location::Unknown;
+  }
+
+  // Calls |fn(fid, inside)| in the increasing order of ids for cities whose boundaries may
+  // contain |p|, |inside| is true when the boundaries contain the whole cell of |p|.
+  template <typename Fn>
+  void ForEachCandidate(m2::PointD const & p, Fn && fn) const
+  {
+    auto const it = m_cells.find(GetCellKey(p));
+    if (it == m_cells.end())
+      return;
+    for (auto const & entry : it->second)
+      fn(entry.m_fid, entry.m_inside);
+  }
+
+private:
+  struct Entry
+  {
+    Entry(uint32_t fid, bool inside) : m_fid(fid), m_inside(inside) {}
+
+    bool operator<(Entry const & rhs) const { return m_fid < rhs.m_fid; }
+
+    uint32_t m_fid;
+    bool m_inside;
+  };
+
+  static uint32_t ToCellCoord(double coord)
+  {
+    double const cell = floor((coord - MercatorBounds::minX) / kCellSize);
+    return cell <= 0.0 ? 0 : static_cast<uint32_t>(cell);
+  }
+
+  static double FromCellCoord(uint32_t coord) { return MercatorBounds::minX + coord * kCellSize; }
+
+  static uint64_t GetCellKey(uint32_t x, uint32_t y)
+  {
+    return (static_cast<uint64_t>(x) << 32) | y;
+  }
+
+  static uint64_t GetCellKey(m2::PointD const & p)
+  {
+    return GetCellKey(ToCellCoord(p.x), ToCellCoord(p.y));
+  }
+
+  void AddBoundary(uint32_t fid, CityBoundary const & boundary, double eps)
+  {
+    auto rect = boundary.m_bbox.ToRect();
+    rect.Inflate(eps, eps);
+
+    uint32_t const maxX = ToCellCoord(rect.maxX());
+    uint32_t const maxY = ToCellCoord(rect.maxY());
+    for (uint32_t x = ToCellCoord(rect.minX()); x <= maxX; ++x)
+    {
+      for (uint32_t y = ToCellCoord(rect.minY()); y <= maxY; ++y)
+      {
+        double const minCellX = FromCellCoord(x);
+        double const minCellY = FromCellCoord(y);
+        double const maxCellX = FromCellCoord(x + 1);
+        double const maxCellY = FromCellCoord(y + 1);
+        bool const inside = boundary.HasPoint(minCellX, minCellY, eps) &&
+                            boundary.HasPoint(minCellX, maxCellY, eps) &&
+                            boundary.HasPoint(maxCellX, minCellY, eps) &&
+                            boundary.HasPoint(maxCellX, maxCellY, eps);
+        m_cells[GetCellKey(x, y)].emplace_back(fid, inside);
+      }
+    }
+  }
+
+  unordered_map<uint64_t, vector<Entry>> m_cells;
+};
+
+// static
+double constexpr CitiesBoundariesTable::CellIndex::kCellSize;
+
 // CitiesBoundariesTable::Boundaries ---------------------------------------------------------------
 bool CitiesBoundariesTable::Boundaries::HasPoint(m2::PointD const & p) const
 {
-  return any_of(m_boundaries.begin(), m_boundaries.end(),
+  if (m_index)
+  {
+    switch (m_index->Locate(m_fid, p))
+    {
+    case CellIndex::Location::Outside: return false;
+    case CellIndex::Location::Inside: return true;
+    case CellIndex::Location::Unknown: break;
+    }
+  }
+
+  auto const & boundaries = GetBoundaries();
+  return any_of(boundaries.begin(), boundaries.end(),
                 [&](CityBoundary const & b) { return b.HasPoint(p, m_eps); });
 }
 
+vector<CityBoundary> const & CitiesBoundariesTable::Boundaries::GetBoundaries() const
+{
+  static vector<CityBoundary> const kEmpty;
+  return m_boundaries ? *m_boundaries : kEmpty;
+}
+
 // CitiesBoundariesTable ---------------------------------------------------------------------------
 bool CitiesBoundariesTable::Load()
 {
@@ -80,13 +227,16 @@ bool CitiesBoundariesTable::Load()
     return false;
   }
 
+  lock_guard<mutex> lock(m_indexMutex);
+  m_index.reset();
   m_mwmId = context.GetId();
   m_table.clear();
   m_eps = precision;
   size_t boundary = 0;
   localities.ForEach([&](uint64_t fid) {
     ASSERT_LESS(boundary, all.size(), ());
-    m_table[base::asserted_cast<uint32_t>(fid)] = move(all[boundary]);
+    m_table[base::asserted_cast<uint32_t>(fid)] =
+        make_shared<vector<CityBoundary>>(move(all[boundary]));
     ++boundary;
   });
   ASSERT_EQUAL(boundary, all.size(), ());
@@ -105,17 +255,48 @@ bool CitiesBoundariesTable::Get(uint32_t fid, Boundaries & bs) const
   auto const it = m_table.find(fid);
   if (it == m_table.end())
     return false;
-  bs = Boundaries(it->second, m_eps);
+  bs.m_boundaries = it->second;
+  bs.m_eps = m_eps;
+  bs.m_index = GetIndex();
+  bs.m_fid = fid;
   return true;
 }
 
+void CitiesBoundariesTable::GetCitiesContaining(m2::PointD const & p, vector<uint32_t> & fids) const
+{
+  fids.clear();
+  GetIndex()->ForEachCandidate(p, [&](uint32_t fid, bool inside) {
+    if (inside)
+    {
+      fids.push_back(fid);
+      return;
+    }
+
+    auto const it = m_table.find(fid);
+    ASSERT(it != m_table.end(), ());
+    if (any_of(it->second->begin(), it->second->end(),
+               [&](CityBoundary const & b) { return b.HasPoint(p, m_eps); }))
+    {
+      fids.push_back(fid);
+    }
+  });
+}
+
+shared_ptr<CitiesBoundariesTable::CellIndex const> CitiesBoundariesTable::GetIndex() const
+{
+  lock_guard<mutex> lock(m_indexMutex);
+  if (!m_index)
+    m_index = make_shared<CellIndex>(m_table, m_eps);
+  return m_index;
+}
+
 void GetCityBoundariesInRectForTesting(CitiesBoundariesTable const & table, m2::RectD const & rect,
                                        vector<uint32_t> & featureIds)
 {
   featureIds.clear();
   for (auto const & kv : table.m_table)
   {
-    for (auto const & cb : kv.second)
+    for (auto const & cb : *kv.second)
     {
       if (rect.IsIntersect(m2::RectD(cb.m_bbox.Min(), cb.m_bbox.Max())))
       {
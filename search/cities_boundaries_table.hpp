@@ -7,6 +7,8 @@
 #include "geometry/rect2d.hpp"
 
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -29,18 +31,21 @@ class CitiesBoundariesTable
                                                 std::vector<uint32_t> & featureIds);
 
 public:
+  class CellIndex;
+
   class Boundaries
   {
   public:
     Boundaries() = default;
 
     Boundaries(std::vector<indexer::CityBoundary> const & boundaries, double eps)
-      : m_boundaries(boundaries), m_eps(eps)
+      : m_boundaries(std::make_shared<std::vector<indexer::CityBoundary>>(boundaries)), m_eps(eps)
     {
     }
 
     Boundaries(std::vector<indexer::CityBoundary> && boundaries, double eps)
-      : m_boundaries(std::move(boundaries)), m_eps(eps)
+      : m_boundaries(std::make_shared<std::vector<indexer::CityBoundary>>(std::move(boundaries)))
+      , m_eps(eps)
     {
     }
 
@@ -51,7 +56,7 @@ public:
     m2::RectD GetLimitRect() const
     {
       m2::RectD rect;
-      for (auto const & boundary : m_boundaries)
+      for (auto const & boundary : GetBoundaries())
       {
         rect.Add(boundary.m_bbox.Min());
         rect.Add(boundary.m_bbox.Max());
@@ -59,21 +64,36 @@ public:
       return rect;
     }
 
-    std::vector<indexer::CityBoundary> const & GetBoundariesForTesting() const { return m_boundaries; }
+    std::vector<indexer::CityBoundary> const & GetBoundariesForTesting() const
+    {
+      return GetBoundaries();
+    }
+
+    double GetEpsForTesting() const { return m_eps; }
 
     friend std::string DebugPrint(Boundaries const & boundaries)
     {
       std::ostringstream os;
       os << "Boundaries [";
-      os << ::DebugPrint(boundaries.m_boundaries) << ", ";
+      os << ::DebugPrint(boundaries.GetBoundaries()) << ", ";
       os << "eps: " << boundaries.m_eps;
       os << "]";
       return os.str();
     }
 
   private:
-    std::vector<indexer::CityBoundary> m_boundaries;
+    friend class CitiesBoundariesTable;
+
+    std::vector<indexer::CityBoundary> const & GetBoundaries() const;
+
+    // Boundaries are shared with the table, so copies of |*this| are cheap.
+    std::shared_ptr<std::vector<indexer::CityBoundary> const> m_boundaries;
     double m_eps = 0.0;
+
+    // Grid of the table the boundaries are taken from, when it's set most
+    // points are resolved by their cells without checks of the boundaries.
+    std::shared_ptr<CellIndex const> m_index;
+    uint32_t m_fid = 0;
   };
 
   explicit CitiesBoundariesTable(DataSource const & dataSource) : m_dataSource(dataSource) {}
@@ -86,13 +106,24 @@ public:
   bool Get(FeatureID const & fid, Boundaries & bs) const;
   bool Get(uint32_t fid, Boundaries & bs) const;
 
+  // Fills |fids| with sorted ids of the cities whose boundaries contain |p|.
+  void GetCitiesContaining(m2::PointD const & p, std::vector<uint32_t> & fids) const;
+
   size_t GetSize() const { return m_table.size(); }
 
 private:
+  using BoundariesPtr = std::shared_ptr<std::vector<indexer::CityBoundary> const>;
+
+  // Builds the grid on the first call after Load(), the table may be shared by several threads.
+  std::shared_ptr<CellIndex const> GetIndex() const;
+
   DataSource const & m_dataSource;
   MwmSet::MwmId m_mwmId;
-  std::unordered_map<uint32_t, std::vector<indexer::CityBoundary>> m_table;
+  std::unordered_map<uint32_t, BoundariesPtr> m_table;
   double m_eps = 0.0;
+
+  mutable std::mutex m_indexMutex;
+  mutable std::shared_ptr<CellIndex const> m_index;
 };
 
 /// \brief Fills |featureIds| with feature ids of city boundaries if bounding rect of
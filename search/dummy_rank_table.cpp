@@ -3,11 +3,17 @@
 #include "base/macros.hpp"
 
 #include "std/limits.hpp"
+#include "std/vector.hpp"
 
 namespace search
 {
 uint8_t DummyRankTable::Get(uint64_t /* i */) const { return 0; }
 
+void DummyRankTable::GetRanks(vector<uint32_t> const & ids, vector<uint8_t> & ranks) const
+{
+  ranks.assign(ids.size(), 0);
+}
+
 uint64_t DummyRankTable::Size() const
 {
   NOTIMPLEMENTED();
@@ -2,6 +2,9 @@
 
 #include "indexer/rank_table.hpp"
 
+#include <cstdint>
+#include <vector>
+
 namespace search
 {
 // This dummy rank table is used instead of a normal rank table when
@@ -12,6 +15,7 @@ class DummyRankTable : public RankTable
 public:
   // RankTable overrides:
   uint8_t Get(uint64_t i) const override;
+  void GetRanks(std::vector<uint32_t> const & ids, std::vector<uint8_t> & ranks) const override;
   uint64_t Size() const override;
   Version GetVersion() const override;
   void Serialize(Writer & /* writer */, bool /* preserveHostEndianness */) override;
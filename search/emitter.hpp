@@ -3,6 +3,7 @@
 #include "search/result.hpp"
 #include "search/search_params.hpp"
 
+#include "base/assert.hpp"
 #include "base/logging.hpp"
 
 namespace search
@@ -34,6 +35,16 @@ public:
       LOG(LERROR, ("OnResults is not set."));
   }
 
+  // Emits |results| without changing the accumulated results.
+  void EmitProvisional(Results const & results)
+  {
+    ASSERT(results.IsProvisional(), ());
+    if (m_onResults)
+      m_onResults(results);
+    else
+      LOG(LERROR, ("OnResults is not set."));
+  }
+
   Results const & GetResults() const { return m_results; }
 
   void Finish(bool cancelled)
@@ -3,11 +3,13 @@
 #include "search/geometry_utils.hpp"
 #include "search/processor.hpp"
 #include "search/search_params.hpp"
+#include "search/token_features_cache.hpp"
 
 #include "storage/country_info_getter.hpp"
 
 #include "indexer/categories_holder.hpp"
 #include "indexer/classificator.hpp"
+#include "indexer/data_source.hpp"
 #include "indexer/scales.hpp"
 #include "indexer/search_string_utils.hpp"
 
@@ -21,6 +23,7 @@
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -32,6 +35,8 @@ namespace search
 {
 namespace
 {
+size_t constexpr kDefaultTokenFeaturesCacheSize = 8 * 1024 * 1024;
+
 class InitSuggestions
 {
   map<pair<strings::UniString, int8_t>, uint8_t> m_suggests;
@@ -49,11 +54,13 @@ public:
     }
   }
 
-  void GetSuggests(vector<Suggest> & suggests) const
+  SuggestsIndex GetSuggests() const
   {
-    suggests.reserve(suggests.size() + m_suggests.size());
+    vector<Suggest> suggests;
+    suggests.reserve(m_suggests.size());
     for (auto const & s : m_suggests)
       suggests.emplace_back(s.first.first, s.second, s.first.second);
+    return SuggestsIndex(move(suggests));
   }
 };
 }  // namespace
@@ -84,27 +91,46 @@ void ProcessorHandle::Detach()
 }
 
 // Engine::Params ----------------------------------------------------------------------------------
-Engine::Params::Params() : m_locale("en"), m_numThreads(1) {}
+Engine::Params::Params()
+  : m_locale("en")
+  , m_numThreads(1)
+  , m_numGeocoderThreads(1)
+  , m_tokenFeaturesCacheSize(kDefaultTokenFeaturesCacheSize)
+  , m_maxQueueSize(0)
+{
+}
 
 Engine::Params::Params(string const & locale, size_t numThreads)
-  : m_locale(locale), m_numThreads(numThreads)
+  : m_locale(locale)
+  , m_numThreads(numThreads)
+  , m_numGeocoderThreads(1)
+  , m_tokenFeaturesCacheSize(kDefaultTokenFeaturesCacheSize)
+  , m_maxQueueSize(0)
 {
 }
 
 // Engine ------------------------------------------------------------------------------------------
 Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
                storage::CountryInfoGetter const & infoGetter, Params const & params)
-  : m_shutdown(false)
+  : m_dataSource(dataSource), m_maxQueueSize(params.m_maxQueueSize), m_shutdown(false)
 {
+  if (params.m_tokenFeaturesCacheSize != 0)
+  {
+    m_tokenFeaturesCache = make_unique<TokenFeaturesCache>(params.m_tokenFeaturesCacheSize);
+    m_dataSource.AddObserver(*m_tokenFeaturesCache);
+  }
+
   InitSuggestions doInit;
   categories.ForEachName(bind<void>(ref(doInit), placeholders::_1));
-  doInit.GetSuggests(m_suggests);
+  m_suggests = doInit.GetSuggests();
 
   m_contexts.resize(params.m_numThreads);
   for (size_t i = 0; i < params.m_numThreads; ++i)
   {
     auto processor = make_unique<Processor>(dataSource, categories, m_suggests, infoGetter);
     processor->SetPreferredLocale(params.m_locale);
+    processor->SetNumGeocoderThreads(params.m_numGeocoderThreads);
+    processor->SetTokenFeaturesCache(m_tokenFeaturesCache.get());
     m_contexts[i].m_processor = move(processor);
   }
 
@@ -126,16 +152,54 @@ Engine::~Engine()
 
   for (auto & thread : m_threads)
     thread.join();
+
+  if (m_tokenFeaturesCache)
+    m_dataSource.RemoveObserver(*m_tokenFeaturesCache);
 }
 
 weak_ptr<ProcessorHandle> Engine::Search(SearchParams const & params)
 {
   shared_ptr<ProcessorHandle> handle(new ProcessorHandle());
-  PostMessage(Message::TYPE_TASK, [this, params, handle](Processor & processor)
-              {
-                DoSearch(params, handle, processor);
-              });
-  return handle;
+  auto const postTime = chrono::steady_clock::now();
+  // The query must see all bookmarks edits made before it.
+  auto const numBookmarksEdits = m_bookmarks.GetNumEdits();
+  auto task = [this, params, postTime, handle, numBookmarksEdits](Processor & processor) {
+    {
+      lock_guard<mutex> lock(m_mu);
+      --m_numQueuedSearches;
+    }
+    if (params.m_mode == Mode::Bookmarks)
+      processor.SetBookmarksSnapshot(m_bookmarks.GetSnapshot(numBookmarksEdits));
+    DoSearch(params, postTime, handle, processor);
+  };
+
+  {
+    lock_guard<mutex> lock(m_mu);
+    if (m_maxQueueSize == 0 || m_numQueuedSearches < m_maxQueueSize)
+    {
+      ++m_numQueuedSearches;
+      m_messages.emplace(Message::TYPE_TASK, move(task));
+      m_cv.notify_one();
+      return handle;
+    }
+  }
+
+  {
+    lock_guard<mutex> lock(m_metricsMu);
+    ++m_metrics.m_numRejected;
+  }
+
+  Results results;
+  results.SetEndMarker(true /* isCancelled */);
+  if (params.m_onResults)
+    params.m_onResults(results);
+  return {};
+}
+
+Engine::Metrics Engine::GetMetrics() const
+{
+  lock_guard<mutex> lock(m_metricsMu);
+  return m_metrics;
 }
 
 void Engine::SetLocale(string const & locale)
@@ -146,6 +210,8 @@ void Engine::SetLocale(string const & locale)
 
 void Engine::ClearCaches()
 {
+  if (m_tokenFeaturesCache)
+    m_tokenFeaturesCache->Clear();
   PostMessage(Message::TYPE_BROADCAST, [](Processor & processor) { processor.ClearCaches(); });
 }
 
@@ -163,20 +229,29 @@ void Engine::LoadCountriesTree()
 
 void Engine::OnBookmarksCreated(vector<pair<bookmarks::Id, bookmarks::Doc>> const & marks)
 {
-  PostMessage(Message::TYPE_BROADCAST,
-              [marks](Processor & processor) { processor.OnBookmarksCreated(marks); });
+  PostBookmarksEdit([marks](bookmarks::Snapshot::Builder & builder) {
+    for (auto const & idDoc : marks)
+      builder.Add(idDoc.first /* id */, idDoc.second /* doc */);
+  });
 }
 
 void Engine::OnBookmarksUpdated(vector<pair<bookmarks::Id, bookmarks::Doc>> const & marks)
 {
-  PostMessage(Message::TYPE_BROADCAST,
-              [marks](Processor & processor) { processor.OnBookmarksUpdated(marks); });
+  PostBookmarksEdit([marks](bookmarks::Snapshot::Builder & builder) {
+    for (auto const & idDoc : marks)
+    {
+      builder.Erase(idDoc.first /* id */);
+      builder.Add(idDoc.first /* id */, idDoc.second /* doc */);
+    }
+  });
 }
 
 void Engine::OnBookmarksDeleted(vector<bookmarks::Id> const & marks)
 {
-  PostMessage(Message::TYPE_BROADCAST,
-              [marks](Processor & processor) { processor.OnBookmarksDeleted(marks); });
+  PostBookmarksEdit([marks](bookmarks::Snapshot::Builder & builder) {
+    for (auto const & id : marks)
+      builder.Erase(id);
+  });
 }
 
 void Engine::MainLoop(Context & context)
@@ -245,13 +320,29 @@ void Engine::PostMessage(Args &&... args)
   m_cv.notify_one();
 }
 
-void Engine::DoSearch(SearchParams const & params, shared_ptr<ProcessorHandle> handle,
-                      Processor & processor)
+void Engine::PostBookmarksEdit(bookmarks::SnapshotHolder::Edit && edit)
+{
+  m_bookmarks.AddEdit(move(edit));
+  // Several edits posted in a row are usually applied by the first of these tasks.
+  PostMessage(Message::TYPE_TASK, [this](Processor & /* processor */) { m_bookmarks.ApplyEdits(); });
+}
+
+void Engine::DoSearch(SearchParams const & params, chrono::steady_clock::time_point postTime,
+                      shared_ptr<ProcessorHandle> handle, Processor & processor)
 {
   processor.Reset();
+  if (params.m_timeout > chrono::steady_clock::duration::zero())
+    processor.SetDeadline(postTime + params.m_timeout);
   handle->Attach(processor);
   SCOPE_GUARD(detach, [&handle] { handle->Detach(); });
 
   processor.Search(params);
+
+  auto const time = chrono::steady_clock::now() - postTime;
+  lock_guard<mutex> lock(m_metricsMu);
+  ++m_metrics.m_numSearches;
+  if (processor.IsDeadlineExceeded())
+    ++m_metrics.m_numTimedOut;
+  m_metrics.m_totalTime += time;
 }
 }  // namespace search
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "search/bookmarks/processor.hpp"
+#include "search/bookmarks/snapshot.hpp"
 #include "search/result.hpp"
 #include "search/search_params.hpp"
 #include "search/suggest.hpp"
@@ -13,8 +14,10 @@
 #include "base/mutex.hpp"
 #include "base/thread.hpp"
 
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -34,6 +37,7 @@ namespace search
 {
 class EngineData;
 class Processor;
+class TokenFeaturesCache;
 
 // This class is used as a reference to a search processor in the
 // SearchEngine's queue.  It's only possible to cancel a search
@@ -87,6 +91,32 @@ public:
     // to process queries. Use this field wisely as large values may
     // negatively affect performance due to false sharing.
     size_t m_numThreads;
+
+    // Number of threads every query processor geocodes mwms on. Values greater than one
+    // reduce latency of queries which are geocoded in many mwms, e.g. everywhere search
+    // on a server.
+    size_t m_numGeocoderThreads;
+
+    // Approximate limit in bytes of the memory used by the cache of features of query tokens
+    // shared between all the threads. Zero disables the cache.
+    size_t m_tokenFeaturesCacheSize;
+
+    // When positive, queries posted while this number of queries are waiting in the queue
+    // are rejected, see Search().
+    size_t m_maxQueueSize;
+  };
+
+  struct Metrics
+  {
+    // Number of processed queries including the cancelled ones.
+    uint64_t m_numSearches = 0;
+    // Number of queries rejected because the queue was full.
+    uint64_t m_numRejected = 0;
+    // Number of queries stopped by their deadlines, see SearchParams::m_timeout.
+    uint64_t m_numTimedOut = 0;
+    // Total time of the processed queries from posting to the end, including the time
+    // spent in the queue.
+    std::chrono::steady_clock::duration m_totalTime = std::chrono::steady_clock::duration::zero();
   };
 
   // Doesn't take ownership of dataSource and categories.
@@ -94,7 +124,9 @@ public:
          storage::CountryInfoGetter const & infoGetter, Params const & params);
   ~Engine();
 
-  // Posts search request to the queue and returns its handle.
+  // Posts search request to the queue and returns its handle. When the queue is full, see
+  // Params::m_maxQueueSize, the request is not posted: |params.m_onResults| is called on the
+  // calling thread with the cancelled end marker and an expired handle is returned.
   std::weak_ptr<ProcessorHandle> Search(SearchParams const & params);
 
   // Sets default locale on all query processors.
@@ -103,6 +135,11 @@ public:
   // Posts request to clear caches to the queue.
   void ClearCaches();
 
+  // Returns nullptr when the cache of features of query tokens is disabled.
+  TokenFeaturesCache const * GetTokenFeaturesCache() const { return m_tokenFeaturesCache.get(); }
+
+  Metrics GetMetrics() const;
+
   // Posts request to reload cities boundaries tables.
   void LoadCitiesBoundaries();
 
@@ -148,6 +185,10 @@ private:
     std::unique_ptr<Processor> m_processor;
   };
 
+  // Queues |edit| of bookmarks. The new snapshot of bookmarks is built by a search thread,
+  // so queries are not blocked while it's being built.
+  void PostBookmarksEdit(bookmarks::SnapshotHolder::Edit && edit);
+
   // *ALL* following methods are executed on the m_threads threads.
 
   // This method executes tasks from a common pool (|tasks|) in a FIFO
@@ -159,15 +200,29 @@ private:
   template <typename... Args>
   void PostMessage(Args &&... args);
 
-  void DoSearch(SearchParams const & params, std::shared_ptr<ProcessorHandle> handle,
-                Processor & processor);
+  void DoSearch(SearchParams const & params, std::chrono::steady_clock::time_point postTime,
+                std::shared_ptr<ProcessorHandle> handle, Processor & processor);
+
+  SuggestsIndex m_suggests;
+
+  DataSource & m_dataSource;
+  std::unique_ptr<TokenFeaturesCache> m_tokenFeaturesCache;
 
-  std::vector<Suggest> m_suggests;
+  // Bookmarks are shared by all search threads.
+  bookmarks::SnapshotHolder m_bookmarks;
+
+  size_t const m_maxQueueSize;
 
   bool m_shutdown;
   std::mutex m_mu;
   std::condition_variable m_cv;
 
+  // Number of search requests in |m_messages|, guarded by |m_mu|.
+  size_t m_numQueuedSearches = 0;
+
+  mutable std::mutex m_metricsMu;
+  Metrics m_metrics;
+
   std::queue<Message> m_messages;
   std::vector<Context> m_contexts;
   std::vector<threads::SimpleThread> m_threads;
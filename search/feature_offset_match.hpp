@@ -6,6 +6,7 @@
 #include "search/search_trie.hpp"
 #include "search/token_slice.hpp"
 
+#include "indexer/packed_trie_reader.hpp"
 #include "indexer/trie.hpp"
 
 #include "base/assert.hpp"
@@ -20,6 +21,7 @@
 #include <limits>
 #include <memory>
 #include <queue>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -28,35 +30,100 @@ namespace search
 {
 namespace impl
 {
-namespace
-{
+// Access to nodes of both formats of the search trie, so matching is written once. Nodes of
+// trie::Iterator are allocated on every move and are held by pointers, nodes of the packed
+// trie are held by value.
+template <typename Node>
+struct TrieNode;
+
 template <typename ValueList>
-bool FindLangIndex(trie::Iterator<ValueList> const & trieRoot, uint8_t lang, uint32_t & langIx)
+struct TrieNode<trie::Iterator<ValueList>>
 {
-  ASSERT_LESS(trieRoot.m_edges.size(), std::numeric_limits<uint32_t>::max(), ());
+  using Node = trie::Iterator<ValueList>;
+  using Value = typename ValueList::Value;
+  using Holder = std::shared_ptr<Node>;
 
-  uint32_t const numLangs = static_cast<uint32_t>(trieRoot.m_edges.size());
-  for (uint32_t i = 0; i < numLangs; ++i)
+  static Holder Hold(Node const & node) { return node.Clone(); }
+  static Node const & Get(Holder const & holder) { return *holder; }
+  static Holder GoToEdge(Node const & node, size_t i) { return node.GoToEdge(i); }
+  static size_t GetEdgesCount(Node const & node) { return node.m_edges.size(); }
+
+  static typename Node::Edge::EdgeLabel const & GetEdgeLabel(Node const & node, size_t i)
   {
-    auto const & edge = trieRoot.m_edges[i].m_label;
-    ASSERT_GREATER_OR_EQUAL(edge.size(), 1, ());
-    if (edge[0] == lang)
+    return node.m_edges[i].m_label;
+  }
+
+  static bool FindEdge(Node const & node, trie::TrieChar c, size_t & i)
+  {
+    for (i = 0; i < node.m_edges.size(); ++i)
     {
-      langIx = i;
-      return true;
+      auto const & label = node.m_edges[i].m_label;
+      ASSERT_GREATER_OR_EQUAL(label.size(), 1, ());
+      if (label[0] == c)
+        return true;
     }
+    return false;
+  }
+
+  template <typename ToDo>
+  static void ForEachValue(Node const & node, ToDo && toDo)
+  {
+    node.m_values.ForEach(std::forward<ToDo>(toDo));
+  }
+};
+
+template <typename ValueList, typename Serializer>
+struct TrieNode<trie::PackedTrieIterator<ValueList, Serializer>>
+{
+  using Node = trie::PackedTrieIterator<ValueList, Serializer>;
+  using Value = typename ValueList::Value;
+  using Holder = Node;
+
+  static Holder Hold(Node const & node) { return node; }
+  static Node const & Get(Holder const & holder) { return holder; }
+  static Holder GoToEdge(Node const & node, size_t i) { return node.GoToEdge(i); }
+  static size_t GetEdgesCount(Node const & node) { return node.GetEdgesCount(); }
+
+  static typename Node::Label GetEdgeLabel(Node const & node, size_t i)
+  {
+    return node.GetEdgeLabel(i);
   }
-  return false;
+
+  static bool FindEdge(Node const & node, trie::TrieChar c, size_t & i)
+  {
+    i = node.FindEdge(c);
+    return i != node.GetEdgesCount();
+  }
+
+  template <typename ToDo>
+  static void ForEachValue(Node const & node, ToDo && toDo)
+  {
+    node.ForEachValue(std::forward<ToDo>(toDo));
+  }
+};
+
+// Casts iterators of the search trie to the node types of TrieNode, e.g. MemTrieIterator to
+// trie::Iterator.
+template <typename ValueList>
+trie::Iterator<ValueList> const & AsTrieNode(trie::Iterator<ValueList> const & node)
+{
+  return node;
 }
-}  // namespace
 
-template <typename ValueList, typename DFA, typename ToDo>
-bool MatchInTrie(trie::Iterator<ValueList> const & trieRoot, strings::UniChar const * rootPrefix,
+template <typename ValueList, typename Serializer>
+trie::PackedTrieIterator<ValueList, Serializer> const & AsTrieNode(
+    trie::PackedTrieIterator<ValueList, Serializer> const & node)
+{
+  return node;
+}
+
+template <typename Node, typename DFA, typename ToDo>
+bool MatchInTrie(Node const & trieRoot, strings::UniChar const * rootPrefix,
                  size_t rootPrefixSize, DFA const & dfa, ToDo && toDo)
 {
-  using TrieDFAIt = std::shared_ptr<trie::Iterator<ValueList>>;
+  using T = TrieNode<Node>;
   using DFAIt = typename DFA::Iterator;
-  using State = std::pair<TrieDFAIt, DFAIt>;
+  using State = std::pair<typename T::Holder, DFAIt>;
 
   std::queue<State> q;
 
@@ -65,34 +132,37 @@ bool MatchInTrie(trie::Iterator<ValueList> const & trieRoot, strings::UniChar co
     DFAMove(it, rootPrefix, rootPrefix + rootPrefixSize);
     if (it.Rejects())
       return false;
-    q.emplace(trieRoot.Clone(), it);
+    q.emplace(T::Hold(trieRoot), it);
   }
 
   bool found = false;
 
   while (!q.empty())
   {
-    auto const p = q.front();
+    auto const p = std::move(q.front());
     q.pop();
 
-    auto const & trieIt = p.first;
+    auto const & trieIt = T::Get(p.first);
     auto const & dfaIt = p.second;
 
     if (dfaIt.Accepts())
     {
-      trieIt->m_values.ForEach(toDo);
+      T::ForEachValue(trieIt, toDo);
       found = true;
     }
 
-    size_t const numEdges = trieIt->m_edges.size();
+    size_t const numEdges = T::GetEdgesCount(trieIt);
     for (size_t i = 0; i < numEdges; ++i)
     {
-      auto const & edge = trieIt->m_edges[i];
+      auto const & label = T::GetEdgeLabel(trieIt, i);
 
+      // Labels are walked until the DFA rejects, as most of the edges are rejected by their
+      // first letters.
       auto curIt = dfaIt;
-      strings::DFAMove(curIt, edge.m_label.begin(), edge.m_label.end());
+      for (auto it = label.begin(); it != label.end() && !curIt.Rejects(); ++it)
+        curIt.Move(*it);
       if (!curIt.Rejects())
-        q.emplace(trieIt->GoToEdge(i), curIt);
+        q.emplace(T::GoToEdge(trieIt, i), curIt);
     }
   }
 
@@ -143,18 +213,19 @@ public:
 };
 }  // namespace impl
 
-template <typename ValueList>
+// A node of the search trie and the rest of the label of the edge to the node after the
+// language char.
+template <typename Node>
 struct TrieRootPrefix
 {
-  using Value = typename ValueList::Value;
-  using Iterator = trie::Iterator<ValueList>;
+  using Value = typename impl::TrieNode<Node>::Value;
 
-  Iterator const & m_root;
+  Node const & m_root;
   strings::UniChar const * m_prefix;
   size_t m_prefixSize;
 
-  TrieRootPrefix(Iterator const & root, typename Iterator::Edge::EdgeLabel const & edge)
-    : m_root(root)
+  template <typename EdgeLabel>
+  TrieRootPrefix(Node const & root, EdgeLabel const & edge) : m_root(root)
   {
     if (edge.size() == 1)
     {
@@ -229,8 +300,8 @@ struct SearchTrieRequest
 // Calls |toDo| for each feature accepted by at least one DFA.
 //
 // *NOTE* |toDo| may be called several times for the same feature.
-template <typename DFA, typename ValueList, typename ToDo>
-void MatchInTrie(std::vector<DFA> const & dfas, TrieRootPrefix<ValueList> const & trieRoot,
+template <typename DFA, typename Node, typename ToDo>
+void MatchInTrie(std::vector<DFA> const & dfas, TrieRootPrefix<Node> const & trieRoot,
                  ToDo && toDo)
 {
   for (auto const & dfa : dfas)
@@ -240,41 +311,46 @@ void MatchInTrie(std::vector<DFA> const & dfas, TrieRootPrefix<ValueList> const
 // Calls |toDo| for each feature in categories branch matching to |request|.
 //
 // *NOTE* |toDo| may be called several times for the same feature.
-template <typename DFA, typename ValueList, typename ToDo>
-bool MatchCategoriesInTrie(SearchTrieRequest<DFA> const & request,
-                           trie::Iterator<ValueList> const & trieRoot, ToDo && toDo)
+template <typename DFA, typename Trie, typename ToDo>
+bool MatchCategoriesInTrie(SearchTrieRequest<DFA> const & request, Trie const & trie,
+                           ToDo && toDo)
 {
-  uint32_t langIx = 0;
-  if (!impl::FindLangIndex(trieRoot, search::kCategoriesLang, langIx))
+  auto const & trieRoot = impl::AsTrieNode(trie);
+  using Node = std::decay_t<decltype(trieRoot)>;
+  using T = impl::TrieNode<Node>;
+
+  size_t langIx = 0;
+  if (!T::FindEdge(trieRoot, search::kCategoriesLang, langIx))
     return false;
 
-  auto const & edge = trieRoot.m_edges[langIx].m_label;
+  auto const & edge = T::GetEdgeLabel(trieRoot, langIx);
   ASSERT_GREATER_OR_EQUAL(edge.size(), 1, ());
 
-  auto const catRoot = trieRoot.GoToEdge(langIx);
-  MatchInTrie(request.m_categories, TrieRootPrefix<ValueList>(*catRoot, edge), toDo);
+  auto const catRoot = T::GoToEdge(trieRoot, langIx);
+  MatchInTrie(request.m_categories, TrieRootPrefix<Node>(T::Get(catRoot), edge), toDo);
 
   return true;
 }
 
 // Calls |toDo| with trie root prefix and language code on each
 // language allowed by |request|.
-template <typename DFA, typename ValueList, typename ToDo>
-void ForEachLangPrefix(SearchTrieRequest<DFA> const & request,
-                       trie::Iterator<ValueList> const & trieRoot, ToDo && toDo)
+template <typename DFA, typename Trie, typename ToDo>
+void ForEachLangPrefix(SearchTrieRequest<DFA> const & request, Trie const & trie, ToDo && toDo)
 {
-  ASSERT_LESS(trieRoot.m_edges.size(), std::numeric_limits<uint32_t>::max(), ());
+  auto const & trieRoot = impl::AsTrieNode(trie);
+  using Node = std::decay_t<decltype(trieRoot)>;
+  using T = impl::TrieNode<Node>;
 
-  uint32_t const numLangs = static_cast<uint32_t>(trieRoot.m_edges.size());
-  for (uint32_t langIx = 0; langIx < numLangs; ++langIx)
+  size_t const numLangs = T::GetEdgesCount(trieRoot);
+  for (size_t langIx = 0; langIx < numLangs; ++langIx)
   {
-    auto const & edge = trieRoot.m_edges[langIx].m_label;
+    auto const & edge = T::GetEdgeLabel(trieRoot, langIx);
     ASSERT_GREATER_OR_EQUAL(edge.size(), 1, ());
     int8_t const lang = static_cast<int8_t>(edge[0]);
     if (edge[0] < search::kCategoriesLang && request.HasLang(lang))
     {
-      auto const langRoot = trieRoot.GoToEdge(langIx);
-      TrieRootPrefix<ValueList> langPrefix(*langRoot, edge);
+      auto const langRoot = T::GoToEdge(trieRoot, langIx);
+      TrieRootPrefix<Node> langPrefix(T::Get(langRoot), edge);
       toDo(langPrefix, lang);
     }
   }
@@ -282,23 +358,23 @@ void ForEachLangPrefix(SearchTrieRequest<DFA> const & request,
 
 // Calls |toDo| for each feature whose description matches to
 // |request|.  Each feature will be passed to |toDo| only once.
-template <typename DFA, typename ValueList, typename Filter, typename ToDo>
-void MatchFeaturesInTrie(SearchTrieRequest<DFA> const & request,
-                         trie::Iterator<ValueList> const & trieRoot, Filter const & filter,
-                         ToDo && toDo)
+template <typename DFA, typename Trie, typename Filter, typename ToDo>
+void MatchFeaturesInTrie(SearchTrieRequest<DFA> const & request, Trie const & trie,
+                         Filter const & filter, ToDo && toDo)
 {
-  using Value = typename ValueList::Value;
+  auto const & trieRoot = impl::AsTrieNode(trie);
+  using Node = std::decay_t<decltype(trieRoot)>;
+  using Value = typename impl::TrieNode<Node>::Value;
 
   TrieValuesHolder<Filter, Value> categoriesHolder(filter);
   bool const categoriesMatched = MatchCategoriesInTrie(request, trieRoot, categoriesHolder);
 
   impl::OffsetIntersector<Filter, Value> intersector(filter);
 
-  ForEachLangPrefix(
-      request, trieRoot,
-      [&request, &intersector](TrieRootPrefix<ValueList> & langRoot, int8_t /* lang */) {
-        MatchInTrie(request.m_names, langRoot, intersector);
-      });
+  ForEachLangPrefix(request, trieRoot,
+                    [&request, &intersector](TrieRootPrefix<Node> & langRoot, int8_t /* lang */) {
+                      MatchInTrie(request.m_names, langRoot, intersector);
+                    });
 
   if (categoriesMatched)
     categoriesHolder.ForEachValue(intersector);
@@ -307,19 +383,24 @@ void MatchFeaturesInTrie(SearchTrieRequest<DFA> const & request,
   intersector.ForEachResult(forward<ToDo>(toDo));
 }
 
-template <typename ValueList, typename Filter, typename ToDo>
-void MatchPostcodesInTrie(TokenSlice const & slice, trie::Iterator<ValueList> const & trieRoot,
-                          Filter const & filter, ToDo && toDo)
+template <typename Trie, typename Filter, typename ToDo>
+void MatchPostcodesInTrie(TokenSlice const & slice, Trie const & trie, Filter const & filter,
+                          ToDo && toDo)
 {
   using namespace strings;
-  using Value = typename ValueList::Value;
 
-  uint32_t langIx = 0;
-  if (!impl::FindLangIndex(trieRoot, search::kPostcodesLang, langIx))
+  auto const & trieRoot = impl::AsTrieNode(trie);
+  using Node = std::decay_t<decltype(trieRoot)>;
+  using T = impl::TrieNode<Node>;
+  using Value = typename T::Value;
+
+  size_t langIx = 0;
+  if (!T::FindEdge(trieRoot, search::kPostcodesLang, langIx))
     return;
 
-  auto const & edge = trieRoot.m_edges[langIx].m_label;
-  auto const postcodesRoot = trieRoot.GoToEdge(langIx);
+  auto const & edge = T::GetEdgeLabel(trieRoot, langIx);
+  auto const postcodesRoot = T::GoToEdge(trieRoot, langIx);
+  TrieRootPrefix<Node> const postcodesPrefix(T::Get(postcodesRoot), edge);
 
   impl::OffsetIntersector<Filter, Value> intersector(filter);
   for (size_t i = 0; i < slice.Size(); ++i)
@@ -328,13 +409,13 @@ void MatchPostcodesInTrie(TokenSlice const & slice, trie::Iterator<ValueList> co
     {
       std::vector<PrefixDFAModifier<UniStringDFA>> dfas;
       slice.Get(i).ForEach([&dfas](UniString const & s) { dfas.emplace_back(UniStringDFA(s)); });
-      MatchInTrie(dfas, TrieRootPrefix<ValueList>(*postcodesRoot, edge), intersector);
+      MatchInTrie(dfas, postcodesPrefix, intersector);
     }
     else
     {
       std::vector<UniStringDFA> dfas;
       slice.Get(i).ForEach([&dfas](UniString const & s) { dfas.emplace_back(s); });
-      MatchInTrie(dfas, TrieRootPrefix<ValueList>(*postcodesRoot, edge), intersector);
+      MatchInTrie(dfas, postcodesPrefix, intersector);
     }
 
     intersector.NextStep();
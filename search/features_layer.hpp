@@ -3,6 +3,7 @@
 #include "search/model.hpp"
 #include "search/token_range.hpp"
 
+#include "base/arena.hpp"
 #include "base/string_utils.hpp"
 
 #include "std/vector.hpp"
@@ -19,7 +20,7 @@ struct FeaturesLayer
   void Clear();
 
   // Non-owning ptr to a sorted vector of features.
-  vector<uint32_t> const * m_sortedFeatures;
+  base::ArenaVector<uint32_t> const * m_sortedFeatures;
 
   strings::UniString m_subQuery;
 
@@ -9,9 +9,8 @@
 
 namespace search
 {
-/// Max distance from house to street where we do search matching
-/// even if there is no exact street written for this house.
-int constexpr kMaxApproxStreetDistanceM = 100;
+// static
+int constexpr FeaturesLayerMatcher::kMaxApproxStreetDistanceM;
 
 FeaturesLayerMatcher::FeaturesLayerMatcher(DataSource const & dataSource,
                                            base::Cancellable const & cancellable)
@@ -20,6 +19,7 @@ FeaturesLayerMatcher::FeaturesLayerMatcher(DataSource const & dataSource,
   , m_reverseGeocoder(dataSource)
   , m_nearbyStreetsCache("FeatureToNearbyStreets")
   , m_matchingStreetsCache("BuildingToStreet")
+  , m_housesCache("FeatureToHouse")
   , m_loader(scales::GetUpperScale(), ReverseGeocoder::kLookupRadiusM)
   , m_cancellable(cancellable)
 {
@@ -44,18 +44,59 @@ void FeaturesLayerMatcher::OnQueryFinished()
 {
   m_nearbyStreetsCache.ClearIfNeeded();
   m_matchingStreetsCache.ClearIfNeeded();
+  m_housesCache.ClearIfNeeded();
   m_loader.OnQueryFinished();
 }
 
-uint32_t FeaturesLayerMatcher::GetMatchingStreet(uint32_t houseId)
+// static
+uint32_t FeaturesLayerMatcher::ChooseMatchingStreet(TStreets const & streets,
+                                                    uint32_t const * streetIndex)
 {
-  FeatureType feature;
-  return GetMatchingStreetImpl(houseId, feature);
+  // Streets farther than the lookup radius are never matched, even when
+  // they are present in |streets|.
+  if (streetIndex != nullptr && *streetIndex < streets.size() &&
+      streets[*streetIndex].m_distanceMeters <= ReverseGeocoder::kLookupRadiusM)
+  {
+    return streets[*streetIndex].m_id.m_index;
+  }
+
+  // If there is no saved street for feature, assume that it's a nearest street if it's too close.
+  if (!streets.empty() && streets[0].m_distanceMeters < kMaxApproxStreetDistanceM)
+    return streets[0].m_id.m_index;
+
+  return kInvalidId;
 }
 
-uint32_t FeaturesLayerMatcher::GetMatchingStreet(uint32_t houseId, FeatureType & houseFeature)
+FeaturesLayerMatcher::House const * FeaturesLayerMatcher::GetHouse(uint32_t houseId)
 {
-  return GetMatchingStreetImpl(houseId, houseFeature);
+  auto const load = [this](uint32_t id, House & house) {
+    FeatureType feature;
+    house.m_isValid = GetByIndex(id, feature);
+    if (!house.m_isValid)
+      return;
+    house.m_center = feature::GetCenter(feature);
+    house.m_houseNumber =
+        house_numbers::ParsedHouseNumber(strings::MakeUniString(feature.GetHouseNumber()));
+  };
+
+  // Edited features may be changed at any moment, so they are not cached.
+  if (osm::Editor::Instance().GetFeatureStatus(m_context->GetId(), houseId) !=
+      FeatureStatus::Untouched)
+  {
+    load(houseId, m_editedHouse);
+    return m_editedHouse.m_isValid ? &m_editedHouse : nullptr;
+  }
+
+  auto entry = m_housesCache.Get(houseId);
+  if (entry.second)
+    load(houseId, entry.first);
+  return entry.first.m_isValid ? &entry.first : nullptr;
+}
+
+uint32_t FeaturesLayerMatcher::GetMatchingStreet(uint32_t houseId)
+{
+  FeatureType feature;
+  return GetMatchingStreetImpl(houseId, feature);
 }
 
 FeaturesLayerMatcher::TStreets const & FeaturesLayerMatcher::GetNearbyStreets(uint32_t featureId)
@@ -98,23 +139,35 @@ uint32_t FeaturesLayerMatcher::GetMatchingStreetImpl(uint32_t houseId, FeatureTy
 {
   // Check if this feature is modified - the logic will be different.
   string streetName;
-  bool const edited =
-      osm::Editor::Instance().GetEditedFeatureStreet(houseFeature.GetID(), streetName);
+  bool const edited = osm::Editor::Instance().GetEditedFeatureStreet(
+      FeatureID(m_context->GetId(), houseId), streetName);
 
   // Check the cached result value.
   auto entry = m_matchingStreetsCache.Get(houseId);
   if (!edited && !entry.second)
     return entry.first;
 
+  uint32_t & result = entry.first;
+  result = kInvalidId;
+
+  // Use the street precomputed by the generator if the mwm has it.
+  uint32_t streetId;
+  if (!edited && m_context->GetMatchedStreet(houseId, streetId))
+  {
+    if (streetId != MatchedStreetsTable::kNoStreet)
+      result = streetId;
+    return result;
+  }
+
   // Load feature if needed.
   if (!houseFeature.GetID().IsValid() && !GetByIndex(houseId, houseFeature))
     return kInvalidId;
 
   // Get nearby streets and calculate the resulting index.
   auto const & streets = GetNearbyStreets(houseId, houseFeature);
-  uint32_t & result = entry.first;
-  result = kInvalidId;
 
+  uint32_t index;
+  bool hasIndex = false;
   if (edited)
   {
     auto const ret = find_if(streets.begin(), streets.end(), [&streetName](TStreet const & st)
@@ -122,22 +175,17 @@ uint32_t FeaturesLayerMatcher::GetMatchingStreetImpl(uint32_t houseId, FeatureTy
                                return st.m_name == streetName;
                              });
     if (ret != streets.end())
-      result = ret->m_id.m_index;
+    {
+      index = static_cast<uint32_t>(distance(streets.begin(), ret));
+      hasIndex = true;
+    }
   }
   else
   {
-    uint32_t index;
-    if (m_context->GetStreetIndex(houseId, index) && index < streets.size())
-      result = streets[index].m_id.m_index;
-  }
-
-  // If there is no saved street for feature, assume that it's a nearest street if it's too close.
-  if (result == kInvalidId && !streets.empty() &&
-      streets[0].m_distanceMeters < kMaxApproxStreetDistanceM)
-  {
-    result = streets[0].m_id.m_index;
+    hasIndex = m_context->GetStreetIndex(houseId, index);
   }
 
+  result = ChooseMatchingStreet(streets, hasIndex ? &index : nullptr);
   return result;
 }
 }  // namespace search
@@ -61,6 +61,19 @@ public:
   static uint32_t const kInvalidId = numeric_limits<uint32_t>::max();
   static int constexpr kBuildingRadiusMeters = 50;
   static int constexpr kStreetRadiusMeters = 100;
+  // Max distance from house to street where we do search matching
+  // even if there is no exact street written for this house.
+  static int constexpr kMaxApproxStreetDistanceM = 100;
+
+  using TStreet = ReverseGeocoder::Street;
+  using TStreets = vector<TStreet>;
+
+  // Returns id of a street a house is matched with, or kInvalidId.
+  // |streets| are the house's nearby streets sorted by distance,
+  // |streetIndex| is an index of the house's street in |streets| or
+  // nullptr when the street is not known.  Used by the generator to
+  // precompute matched streets too, so both must agree.
+  static uint32_t ChooseMatchingStreet(TStreets const & streets, uint32_t const * streetIndex);
 
   FeaturesLayerMatcher(DataSource const & dataSource, base::Cancellable const & cancellable);
   void SetContext(MwmContext * context);
@@ -287,7 +300,7 @@ private:
     ParseQuery(child.m_subQuery, child.m_lastTokenIsPrefix, queryParse);
 
     uint32_t numFilterInvocations = 0;
-    auto houseNumberFilter = [&](uint32_t id, FeatureType & feature, bool & loaded) -> bool {
+    auto houseNumberFilter = [&](uint32_t id) -> bool {
       ++numFilterInvocations;
       if ((numFilterInvocations & 0xFF) == 0)
         BailIfCancelled(m_cancellable);
@@ -298,25 +311,19 @@ private:
       if (m_postcodes && !m_postcodes->HasBit(id))
         return false;
 
-      if (!loaded)
-        loaded = GetByIndex(id, feature);
-
-      if (!loaded)
-        return false;
-
       if (!child.m_hasDelayedFeatures)
         return false;
 
-      strings::UniString const houseNumber(strings::MakeUniString(feature.GetHouseNumber()));
-      return house_numbers::HouseNumbersMatch(houseNumber, queryParse);
+      House const * house = GetHouse(id);
+      return house != nullptr && house_numbers::HouseNumbersMatch(house->m_houseNumber, queryParse);
     };
 
     unordered_map<uint32_t, bool> cache;
-    auto cachingHouseNumberFilter = [&](uint32_t id, FeatureType & feature, bool & loaded) -> bool {
+    auto cachingHouseNumberFilter = [&](uint32_t id) -> bool {
       auto const it = cache.find(id);
       if (it != cache.cend())
         return it->second;
-      bool const result = houseNumberFilter(id, feature, loaded);
+      bool const result = houseNumberFilter(id);
       cache[id] = result;
       return result;
     };
@@ -333,25 +340,16 @@ private:
 
       for (uint32_t houseId : street.m_features)
       {
-        FeatureType feature;
-        bool loaded = false;
-        if (!cachingHouseNumberFilter(houseId, feature, loaded))
+        if (!cachingHouseNumberFilter(houseId))
           continue;
 
-        if (!loaded && !GetByIndex(houseId, feature))
+        House const * house = GetHouse(houseId);
+        if (house == nullptr)
           continue;
 
-        // Best geometry is used here as feature::GetCenter(feature)
-        // actually modifies internal state of a |feature| by caching
-        // it's geometry. So, when GetMatchingStreet(houseId, feature)
-        // is called, high precision geometry is used again to compute
-        // |feature|'s center, and this is a right behavior as
-        // house-to-street table was generated by using high-precision
-        // centers of features.
-        m2::PointD const center = feature::GetCenter(feature);
-        if (calculator.GetProjection(center, proj) &&
+        if (calculator.GetProjection(house->m_center, proj) &&
             proj.m_distMeters <= ReverseGeocoder::kLookupRadiusM &&
-            GetMatchingStreet(houseId, feature) == streetId)
+            GetMatchingStreet(houseId) == streetId)
         {
           fn(houseId, streetId);
         }
@@ -359,22 +357,34 @@ private:
     }
   }
 
+  // Center and house number of a feature which are needed to match it
+  // with streets.
+  struct House
+  {
+    // Best geometry is used for centers as the house-to-street table
+    // was generated by using high-precision centers of features.
+    m2::PointD m_center;
+    // Parses of the house number are kept with the house, so they are
+    // made once for all queries while the house is in the cache.
+    house_numbers::ParsedHouseNumber m_houseNumber;
+    bool m_isValid = false;
+  };
+
+  // Returns nullptr if the feature can't be loaded.  The returned house
+  // of an edited feature is valid until the next call only.
+  House const * GetHouse(uint32_t houseId);
+
   // Returns id of a street feature corresponding to a |houseId|, or
   // kInvalidId if there're not such street.
   uint32_t GetMatchingStreet(uint32_t houseId);
-  uint32_t GetMatchingStreet(uint32_t houseId, FeatureType & houseFeature);
   uint32_t GetMatchingStreetImpl(uint32_t houseId, FeatureType & houseFeature);
 
-  using TStreet = ReverseGeocoder::Street;
-  using TStreets = vector<TStreet>;
-
   TStreets const & GetNearbyStreets(uint32_t featureId);
   TStreets const & GetNearbyStreets(uint32_t featureId, FeatureType & feature);
   TStreets const & GetNearbyStreetsImpl(uint32_t featureId, FeatureType & feature);
 
   inline bool GetByIndex(uint32_t id, FeatureType & ft) const
   {
-    /// @todo Add Cache for feature id -> (point, name / house number).
     if (m_context->GetFeature(id, ft))
       return true;
 
@@ -399,6 +409,10 @@ private:
   // located on multiple streets.
   Cache<uint32_t, uint32_t> m_matchingStreetsCache;
 
+  // Cache of centers and house numbers of features which are not edited.
+  Cache<uint32_t, House> m_housesCache;
+  House m_editedHouse;
+
   StreetVicinityLoader m_loader;
   base::Cancellable const & m_cancellable;
 };
@@ -118,8 +118,9 @@ void FeaturesLayerPathFinder::FindReachableVerticesTopDown(
 {
   ASSERT(!layers.empty(), ());
 
-  vector<uint32_t> reachable = *(layers.back()->m_sortedFeatures);
-  vector<uint32_t> buffer;
+  // Copies share the arena of the layer, so the vectors may be swapped.
+  base::ArenaVector<uint32_t> reachable = *(layers.back()->m_sortedFeatures);
+  base::ArenaVector<uint32_t> buffer(reachable.get_allocator());
 
   ParentGraph parentGraph;
 
@@ -169,8 +170,8 @@ void FeaturesLayerPathFinder::FindReachableVerticesBottomUp(
 {
   ASSERT(!layers.empty(), ());
 
-  vector<uint32_t> reachable = *(layers.front()->m_sortedFeatures);
-  vector<uint32_t> buffer;
+  base::ArenaVector<uint32_t> reachable = *(layers.front()->m_sortedFeatures);
+  base::ArenaVector<uint32_t> buffer(reachable.get_allocator());
 
   ParentGraph parentGraph;
 
@@ -180,7 +181,7 @@ void FeaturesLayerPathFinder::FindReachableVerticesBottomUp(
   // only one level, we must make sure that it is nonempty.
   // This problem does not arise in the top-down pass because there
   // the last reached level is exactly the lowest one.
-  vector<uint32_t> lowestLevel = reachable;
+  base::ArenaVector<uint32_t> lowestLevel = reachable;
   // True iff |addEdge| works with the lowest level.
   bool first = true;
 
@@ -4,11 +4,14 @@
 #include "search/dummy_rank_table.hpp"
 #include "search/features_filter.hpp"
 #include "search/features_layer_matcher.hpp"
+#include "search/geometry_utils.hpp"
 #include "search/house_numbers_matcher.hpp"
 #include "search/locality_scorer.hpp"
 #include "search/pre_ranker.hpp"
 #include "search/processor.hpp"
+#include "search/query_stats.hpp"
 #include "search/retrieval.hpp"
+#include "search/token_features_cache.hpp"
 #include "search/token_slice.hpp"
 #include "search/tracer.hpp"
 #include "search/utils.hpp"
@@ -36,9 +39,11 @@
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/pprof.hpp"
+#include "base/profiler.hpp"
 #include "base/random.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/bind.hpp"
@@ -54,6 +59,7 @@
 #include "base/timer.hpp"
 #endif
 
+#include <exception>
 #include <memory>
 
 using namespace strings;
@@ -123,6 +129,12 @@ public:
     return m_table->Get(i);
   }
 
+  void GetRanks(vector<uint32_t> const & ids, vector<uint8_t> & ranks) const override
+  {
+    EnsureTableLoaded();
+    m_table->GetRanks(ids, ranks);
+  }
+
   uint64_t Size() const override
   {
     EnsureTableLoaded();
@@ -332,8 +344,38 @@ size_t OrderCountries(m2::PointD const & position, m2::RectD const & pivot, bool
   auto const sep = stable_partition(infos.begin(), infos.end(), intersects);
   return distance(infos.begin(), sep);
 }
+
+// Appends |token| to the |key| of a cached retrieval request.
+void AppendTokenKey(QueryParams::Token const & token, bool isPrefix, string & key)
+{
+  key += isPrefix ? 'p' : 'f';
+  token.ForEach([&key](UniString const & s) {
+    key += ToUtf8(s);
+    key += '\1';
+  });
+  key += '\2';
+}
 }  // namespace
 
+// Geocoder::Worker -------------------------------------------------------------------------------
+struct Geocoder::Worker
+{
+  Worker(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
+         CategoriesHolder const & categories, CitiesBoundariesTable const & citiesBoundaries,
+         PreRanker & preRanker, base::Cancellable const & cancellable)
+    : m_villagesCache(cancellable)
+    , m_geocoder(dataSource, infoGetter, categories, citiesBoundaries, preRanker, m_villagesCache,
+                 cancellable)
+  {
+    m_geocoder.m_collectResults = true;
+  }
+
+  // VillagesCache of the processor can't be shared between threads.
+  VillagesCache m_villagesCache;
+  Geocoder m_geocoder;
+  std::exception_ptr m_exception;
+};
+
 // Geocoder::Geocoder ------------------------------------------------------------------------------
 Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
                    CategoriesHolder const & categories,
@@ -373,8 +415,19 @@ void Geocoder::SetParams(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_tokenKeys.clear();
   for (size_t i = 0; i < m_params.GetNumTokens(); ++i)
   {
+    // The key contains everything the request for the token is built from.
+    m_tokenKeys.emplace_back("a");
+    auto & key = m_tokenKeys.back();
+    AppendTokenKey(m_params.GetToken(i), m_params.IsPrefixToken(i), key);
+    for (auto const & index : m_params.GetTypeIndices(i))
+      key += strings::to_string(index) + ',';
+    key += '\2';
+    for (auto const lang : m_params.GetLangs())
+      key += strings::to_string(lang) + ',';
+
     if (!m_params.IsPrefixToken(i))
     {
       m_tokenRequests.emplace_back();
@@ -433,6 +486,17 @@ void Geocoder::GoInViewport()
     return !m_params.m_pivot.IsIntersect(info->m_bordersRect);
   });
 
+  if (IsIncrementalSearch())
+  {
+    vector<m2::RectD> parts;
+    SubtractRect(m_params.m_pivot, m_params.m_processedPivot, parts);
+    base::EraseIf(infos, [&parts](shared_ptr<MwmInfo> const & info) {
+      return none_of(parts.begin(), parts.end(), [&info](m2::RectD const & part) {
+        return part.IsIntersect(info->m_bordersRect);
+      });
+    });
+  }
+
   GoImpl(infos, true /* inViewport */);
 }
 
@@ -443,6 +507,9 @@ void Geocoder::Finish(bool cancelled)
 
 void Geocoder::ClearCaches()
 {
+  for (auto & worker : m_workers)
+    worker->m_geocoder.ClearCaches();
+
   m_pivotRectsCache.Clear();
   m_localityRectsCache.Clear();
 
@@ -453,6 +520,30 @@ void Geocoder::ClearCaches()
   m_hotelsFilter.ClearCaches();
   m_cuisineFilter.ClearCaches();
   m_postcodes.Clear();
+
+  m_arena.Release();
+}
+
+void Geocoder::SetNumThreads(size_t numThreads)
+{
+  ASSERT(!m_collectResults, ("Workers can't have workers."));
+  m_workers.clear();
+  if (numThreads <= 1)
+    return;
+
+  for (size_t i = 0; i < numThreads; ++i)
+  {
+    m_workers.push_back(make_unique<Worker>(m_dataSource, m_infoGetter, m_categories,
+                                            m_citiesBoundaries, m_preRanker, m_cancellable));
+    m_workers.back()->m_geocoder.SetTokenFeaturesCache(m_tokenFeaturesCache);
+  }
+}
+
+void Geocoder::SetTokenFeaturesCache(TokenFeaturesCache * cache)
+{
+  m_tokenFeaturesCache = cache;
+  for (auto & worker : m_workers)
+    worker->m_geocoder.SetTokenFeaturesCache(cache);
 }
 
 void Geocoder::SetParamsForCategorialSearch(Params const & params)
@@ -461,6 +552,7 @@ void Geocoder::SetParamsForCategorialSearch(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_tokenKeys.clear();
 
   ASSERT(!m_params.LastTokenIsPrefix(), ());
 
@@ -511,71 +603,174 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
   size_t const numIntersectingMaps =
       OrderCountries(m_params.m_position, m_params.m_pivot, inViewport, infos);
 
+  // Tracer isn't thread-safe, so traced queries are geocoded on one thread.
+  if (!m_workers.empty() && !m_params.m_tracer)
+  {
+    for (auto & worker : m_workers)
+    {
+      Geocoder & geocoder = worker->m_geocoder;
+      geocoder.SetParams(m_params);
+      geocoder.m_worldId = m_worldId;
+      geocoder.m_cities = m_cities;
+      for (size_t i = 0; i < Region::TYPE_COUNT; ++i)
+        geocoder.m_regions[i] = m_regions[i];
+    }
+
+    vector<pair<size_t, unique_ptr<MwmContext>>> batch;
+    ForEachCountry(infos, [&](size_t index, unique_ptr<MwmContext> context) {
+      batch.emplace_back(index, move(context));
+      if (batch.size() == m_workers.size())
+        GeocodeCountriesInParallel(batch, inViewport, numIntersectingMaps);
+    });
+    GeocodeCountriesInParallel(batch, inViewport, numIntersectingMaps);
+    return;
+  }
+
   // MatchAroundPivot() should always be matched in mwms
   // intersecting with position and viewport.
   auto processCountry = [&](size_t index, unique_ptr<MwmContext> context) {
-    ASSERT(context, ());
-    m_context = move(context);
+    bool const intersectsPivot = index < numIntersectingMaps;
+    GeocodeCountry(move(context), inViewport, intersectsPivot,
+                   intersectsPivot || m_preRanker.NumSentResults() == 0);
 
-    SCOPE_GUARD(cleanup, [&]() {
-      LOG(LDEBUG, (m_context->GetName(), "geocoding complete."));
-      m_matcher->OnQueryFinished();
-      m_matcher = nullptr;
-      m_context.reset();
-    });
+    if (index + 1 >= numIntersectingMaps)
+      m_preRanker.UpdateResults(false /* lastUpdate */);
+  };
 
-    auto it = m_matchersCache.find(m_context->GetId());
-    if (it == m_matchersCache.end())
-    {
-      it = m_matchersCache
-               .insert(make_pair(m_context->GetId(),
-                                 std::make_unique<FeaturesLayerMatcher>(m_dataSource, m_cancellable)))
-               .first;
-    }
-    m_matcher = it->second.get();
-    m_matcher->SetContext(m_context.get());
+  // Iterates through all alive mwms and performs geocoding.
+  ForEachCountry(infos, processCountry);
+}
 
-    BaseContext ctx;
-    InitBaseContext(ctx);
+void Geocoder::GeocodeCountry(unique_ptr<MwmContext> context, bool inViewport,
+                              bool intersectsPivot, bool matchAroundPivot)
+{
+  ASSERT(context, ());
+  m_context = move(context);
+
+  base::ProfilerZone zone("GeocodeCountry", "search");
+  static auto & mwmsCounter = base::Profiler::Instance().GetCounter("search.geocoded_mwms");
+  mwmsCounter.Add();
+
+  SCOPE_GUARD(cleanup, [&]() {
+    LOG(LDEBUG, (m_context->GetName(), "geocoding complete."));
+    m_matcher->OnQueryFinished();
+    m_matcher = nullptr;
+    m_context.reset();
+  });
 
-    if (inViewport)
-    {
-      auto const viewportCBV =
-          RetrieveGeometryFeatures(*m_context, m_params.m_pivot, RECT_ID_PIVOT);
-      for (auto & features : ctx.m_features)
-        features = features.Intersect(viewportCBV);
-    }
+  auto it = m_matchersCache.find(m_context->GetId());
+  if (it == m_matchersCache.end())
+  {
+    it = m_matchersCache
+             .insert(make_pair(m_context->GetId(),
+                               std::make_unique<FeaturesLayerMatcher>(m_dataSource, m_cancellable)))
+             .first;
+  }
+  m_matcher = it->second.get();
+  m_matcher->SetContext(m_context.get());
 
-    ctx.m_villages = m_villagesCache.Get(*m_context);
+  BaseContext ctx;
+  InitBaseContext(ctx);
 
-    auto citiesFromWorld = m_cities;
-    FillVillageLocalities(ctx);
-    SCOPE_GUARD(remove_villages, [&]() { m_cities = citiesFromWorld; });
+  if (inViewport)
+  {
+    auto viewportCBV = RetrieveGeometryFeatures(*m_context, m_params.m_pivot, RECT_ID_PIVOT);
+    if (IsIncrementalSearch())
+      viewportCBV = viewportCBV.Intersect(RetrieveUnprocessedPivotFeatures(*m_context));
+    for (auto & features : ctx.m_features)
+      features = features.Intersect(viewportCBV);
+  }
 
-    bool const intersectsPivot = index < numIntersectingMaps;
-    if (m_params.IsCategorialRequest())
+  ctx.m_villages = m_villagesCache.Get(*m_context);
+
+  auto citiesFromWorld = m_cities;
+  FillVillageLocalities(ctx);
+  SCOPE_GUARD(remove_villages, [&]() { m_cities = citiesFromWorld; });
+
+  if (m_params.IsCategorialRequest())
+  {
+    MatchCategories(ctx, intersectsPivot);
+  }
+  else
+  {
+    MatchRegions(ctx, Region::TYPE_COUNTRY);
+
+    if (matchAroundPivot)
+      MatchAroundPivot(ctx);
+  }
+}
+
+void Geocoder::GeocodeCountriesInParallel(vector<pair<size_t, unique_ptr<MwmContext>>> & countries,
+                                          bool inViewport, size_t numIntersectingMaps)
+{
+  if (countries.empty())
+    return;
+
+  ASSERT_LESS_OR_EQUAL(countries.size(), m_workers.size(), ());
+
+  // In the one-thread mode MatchAroundPivot() is called for a map which doesn't intersect
+  // the pivot until some results are sent. Here the number of sent results is the number
+  // before the batch so that the decision doesn't depend on the order of the threads.
+  bool const noSentResults = m_preRanker.NumSentResults() == 0;
+  auto const geocode = [&](size_t i) {
+    Worker & worker = *m_workers[i];
+    worker.m_exception = nullptr;
+    try
     {
-      MatchCategories(ctx, intersectsPivot);
+      bool const intersectsPivot = countries[i].first < numIntersectingMaps;
+      worker.m_geocoder.GeocodeCountry(move(countries[i].second), inViewport, intersectsPivot,
+                                       intersectsPivot || noSentResults);
     }
-    else
+    catch (...)
     {
-      MatchRegions(ctx, Region::TYPE_COUNTRY);
-
-      if (intersectsPivot || m_preRanker.NumSentResults() == 0)
-        MatchAroundPivot(ctx);
+      worker.m_exception = std::current_exception();
     }
-
-    if (index + 1 >= numIntersectingMaps)
-      m_preRanker.UpdateResults(false /* lastUpdate */);
   };
 
-  // Iterates through all alive mwms and performs geocoding.
-  ForEachCountry(infos, processCountry);
+  {
+    vector<threads::SimpleThread> threads;
+    threads.reserve(countries.size() - 1);
+    for (size_t i = 1; i < countries.size(); ++i)
+      threads.emplace_back(geocode, i);
+    geocode(0);
+    for (auto & thread : threads)
+      thread.join();
+  }
+
+  size_t const lastIndex = countries.back().first;
+  size_t const numCountries = countries.size();
+  countries.clear();
+
+  SCOPE_GUARD(clearResults, [&]() {
+    for (auto & worker : m_workers)
+      worker->m_geocoder.m_collectedResults.clear();
+  });
+
+  for (size_t i = 0; i < numCountries; ++i)
+  {
+    if (m_workers[i]->m_exception)
+      std::rethrow_exception(m_workers[i]->m_exception);
+  }
+
+  for (size_t i = 0; i < numCountries; ++i)
+  {
+    for (auto const & result : m_workers[i]->m_geocoder.m_collectedResults)
+      m_preRanker.Emplace(result.first, result.second);
+  }
+
+  if (lastIndex + 1 >= numIntersectingMaps)
+    m_preRanker.UpdateResults(false /* lastUpdate */);
 }
 
 void Geocoder::InitBaseContext(BaseContext & ctx)
 {
   Retrieval retrieval(*m_context, m_cancellable);
+  auto const retrieve = [&](size_t i, auto const & request) {
+    QueryStats::ScopedTimer timer(m_params.m_stats.get(), QueryStats::Phase::Retrieval);
+    if (m_tokenFeaturesCache)
+      return retrieval.RetrieveAddressFeatures(request, *m_tokenFeaturesCache, m_tokenKeys[i]);
+    return retrieval.RetrieveAddressFeatures(request);
+  };
 
   ctx.m_tokens.assign(m_params.GetNumTokens(), BaseContext::TOKEN_TYPE_COUNT);
   ctx.m_numTokens = m_params.GetNumTokens();
@@ -591,11 +786,11 @@ void Geocoder::InitBaseContext(BaseContext & ctx)
     }
     else if (m_params.IsPrefixToken(i))
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
+      ctx.m_features[i] = retrieve(i, m_prefixTokenRequest);
     }
     else
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
+      ctx.m_features[i] = retrieve(i, m_tokenRequests[i]);
     }
   }
 
@@ -1020,7 +1215,8 @@ void Geocoder::CreateStreetsLayerAndMatchLowerLayers(BaseContext & ctx,
   auto & layer = layers.back();
   InitLayer(Model::TYPE_STREET, prediction.m_tokenRange, layer);
 
-  vector<uint32_t> sortedFeatures;
+  base::ArenaScope arenaScope(m_arena);
+  base::ArenaVector<uint32_t> sortedFeatures(m_arena);
   sortedFeatures.reserve(base::checked_cast<size_t>(prediction.m_features.PopCount()));
   prediction.m_features.ForEach([&sortedFeatures](uint64_t bit) {
     sortedFeatures.push_back(base::asserted_cast<uint32_t>(bit));
@@ -1097,7 +1293,8 @@ void Geocoder::MatchPOIsAndBuildings(BaseContext & ctx, size_t curToken)
     auto & layer = layers.back();
     InitLayer(Model::TYPE_BUILDING, m_postcodes.m_tokenRange, layer);
 
-    vector<uint32_t> features;
+    base::ArenaScope arenaScope(m_arena);
+    base::ArenaVector<uint32_t> features(m_arena);
     m_postcodes.m_features.ForEach([&features](uint64_t bit) {
       features.push_back(base::asserted_cast<uint32_t>(bit));
     });
@@ -1111,7 +1308,10 @@ void Geocoder::MatchPOIsAndBuildings(BaseContext & ctx, size_t curToken)
   // Clusters of features by search type. Each cluster is a sorted
   // list of ids.
   size_t const kNumClusters = Model::TYPE_BUILDING + 1;
-  vector<uint32_t> clusters[kNumClusters];
+  base::ArenaScope arenaScope(m_arena);
+  base::ArenaAllocator<uint32_t> const allocator(m_arena);
+  base::ArenaVector<base::ArenaVector<uint32_t>> clusters(
+      kNumClusters, base::ArenaVector<uint32_t>(allocator), allocator);
 
   // Appends |featureId| to the end of the corresponding cluster, if
   // any.
@@ -1359,7 +1559,10 @@ void Geocoder::EmitResult(BaseContext & ctx, MwmSet::MwmId const & mwmId, uint32
 
   info.m_allTokensUsed = allTokensUsed;
 
-  m_preRanker.Emplace(id, info);
+  if (m_collectResults)
+    m_collectedResults.emplace_back(id, info);
+  else
+    m_preRanker.Emplace(id, info);
 
   // ++ctx.m_numEmitted;
 }
@@ -1423,13 +1626,21 @@ void Geocoder::MatchUnclassified(BaseContext & ctx, size_t curToken)
 
 CBV Geocoder::RetrievePostcodeFeatures(MwmContext const & context, TokenSlice const & slice)
 {
+  QueryStats::ScopedTimer timer(m_params.m_stats.get(), QueryStats::Phase::Retrieval);
   Retrieval retrieval(context, m_cancellable);
-  return CBV(retrieval.RetrievePostcodeFeatures(slice));
+  if (!m_tokenFeaturesCache)
+    return CBV(retrieval.RetrievePostcodeFeatures(slice));
+
+  string key = "p";
+  for (size_t i = 0; i < slice.Size(); ++i)
+    AppendTokenKey(slice.Get(i), slice.IsPrefix(i), key);
+  return CBV(retrieval.RetrievePostcodeFeatures(slice, *m_tokenFeaturesCache, key));
 }
 
 CBV Geocoder::RetrieveGeometryFeatures(MwmContext const & context, m2::RectD const & rect,
                                        RectId id)
 {
+  QueryStats::ScopedTimer timer(m_params.m_stats.get(), QueryStats::Phase::Retrieval);
   switch (id)
   {
   case RECT_ID_PIVOT: return m_pivotRectsCache.Get(context, rect, m_params.GetScale());
@@ -1439,6 +1650,30 @@ CBV Geocoder::RetrieveGeometryFeatures(MwmContext const & context, m2::RectD con
   CHECK_SWITCH();
 }
 
+CBV Geocoder::RetrieveUnprocessedPivotFeatures(MwmContext const & context)
+{
+  QueryStats::ScopedTimer timer(m_params.m_stats.get(), QueryStats::Phase::Retrieval);
+
+  vector<m2::RectD> parts;
+  SubtractRect(m_params.m_pivot, m_params.m_processedPivot, parts);
+
+  // Parts differ for every move of the viewport, so they aren't cached.
+  Retrieval retrieval(context, m_cancellable);
+  CBV features;
+  for (auto const & part : parts)
+    features = features.Union(CBV(retrieval.RetrieveGeometryFeatures(part, m_params.GetScale())));
+  return features;
+}
+
+bool Geocoder::IsIncrementalSearch() const
+{
+  // A result of a categorial request is a feature of the pivot. Results of other requests are
+  // matched with features of other layers, e.g. with streets, which may lie in the processed
+  // part of the pivot only, so the whole pivot is geocoded for them.
+  return m_params.m_mode == Mode::Viewport && m_params.m_processedPivot.IsValid() &&
+         m_params.IsCategorialRequest();
+}
+
 bool Geocoder::GetTypeInGeocoding(BaseContext const & ctx, uint32_t featureId, Model::Type & type)
 {
   if (ctx.m_streets.HasBit(featureId))
@@ -22,6 +22,7 @@
 #include "search/streets_matcher.hpp"
 #include "search/token_range.hpp"
 
+#include "indexer/feature_decl.hpp"
 #include "indexer/mwm_set.hpp"
 
 #include "storage/country_info_getter.hpp"
@@ -31,6 +32,7 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include "base/arena.hpp"
 #include "base/cancellable.hpp"
 #include "base/dfa_helpers.hpp"
 #include "base/levenshtein_dfa.hpp"
@@ -42,6 +44,7 @@
 #include "std/string.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/unordered_map.hpp"
+#include "std/utility.hpp"
 #include "std/vector.hpp"
 
 class CategoriesHolder;
@@ -58,6 +61,8 @@ namespace search
 class FeaturesFilter;
 class FeaturesLayerMatcher;
 class PreRanker;
+class QueryStats;
+class TokenFeaturesCache;
 class TokenSlice;
 class Tracer;
 
@@ -83,12 +88,16 @@ public:
   {
     Mode m_mode = Mode::Everywhere;
     m2::RectD m_pivot;
+    // When valid, results with centers inside the rect are known from the previous viewport
+    // search, so the results of categorial requests are looked for only in the rest of |m_pivot|.
+    m2::RectD m_processedPivot;
     m2::PointD m_position;
     Locales m_categoryLocales;
     shared_ptr<hotels_filter::Rule> m_hotelsFilter;
     vector<uint32_t> m_cuisineTypes;
     vector<uint32_t> m_preferredTypes;
     shared_ptr<Tracer> m_tracer;
+    shared_ptr<QueryStats> m_stats;
   };
 
   Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
@@ -120,7 +129,19 @@ public:
 
   void ClearCaches();
 
+  // Sets the number of threads mwms are geocoded on by GoEverywhere() and GoInViewport().
+  // When |numThreads| is greater than one, mwms are geocoded in batches of |numThreads| mwms
+  // and results of a batch are passed to PreRanker in the order of mwms after the whole
+  // batch is geocoded. So the results don't depend on scheduling of the threads.
+  void SetNumThreads(size_t numThreads);
+
+  // Sets the cache of features of tokens shared between geocoders, nullptr disables caching.
+  // The cache should outlive the geocoder.
+  void SetTokenFeaturesCache(TokenFeaturesCache * cache);
+
 private:
+  struct Worker;
+
   enum RectId
   {
     RECT_ID_PIVOT,
@@ -145,6 +166,16 @@ private:
 
   void GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport);
 
+  // Performs geocoding in the mwm of |context|. MatchAroundPivot() is called
+  // only if |matchAroundPivot| is true.
+  void GeocodeCountry(unique_ptr<MwmContext> context, bool inViewport, bool intersectsPivot,
+                      bool matchAroundPivot);
+
+  // Geocodes |countries| on m_workers and passes their results to |m_preRanker|.
+  // |countries| are pairs of indices of mwms in the order of GoImpl() and their contexts.
+  void GeocodeCountriesInParallel(vector<pair<size_t, unique_ptr<MwmContext>>> & countries,
+                                  bool inViewport, size_t numIntersectingMaps);
+
   template <typename Locality>
   using LocalitiesCache = map<TokenRange, vector<Locality>>;
 
@@ -239,6 +270,13 @@ private:
   // A caching wrapper around Retrieval::RetrieveGeometryFeatures.
   CBV RetrieveGeometryFeatures(MwmContext const & context, m2::RectD const & rect, RectId id);
 
+  // Retrieves features in the part of |m_params.m_pivot| outside of |m_params.m_processedPivot|.
+  CBV RetrieveUnprocessedPivotFeatures(MwmContext const & context);
+
+  // Returns true when only the part of the pivot outside of |m_params.m_processedPivot| is
+  // geocoded.
+  bool IsIncrementalSearch() const;
+
   // This is a faster wrapper around SearchModel::GetSearchType(), as
   // it uses pre-loaded lists of streets and villages.
   WARN_UNUSED_RESULT bool GetTypeInGeocoding(BaseContext const & ctx, uint32_t featureId,
@@ -297,10 +335,26 @@ private:
   // Path finder for interpretations.
   FeaturesLayerPathFinder m_finder;
 
+  // Memory for sorted features of layers. Every geocoder of |m_workers| runs on its own
+  // thread, so the arena is per thread and its blocks are reused by all queries.
+  base::Arena m_arena;
+
   // Search query params prepared for retrieval.
   vector<SearchTrieRequest<strings::LevenshteinDFA>> m_tokenRequests;
   SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> m_prefixTokenRequest;
 
+  // Keys of the requests of tokens in |m_tokenFeaturesCache|.
+  vector<string> m_tokenKeys;
+  TokenFeaturesCache * m_tokenFeaturesCache = nullptr;
+
   PreRanker & m_preRanker;
+
+  // When true, results are collected to |m_collectedResults| instead of |m_preRanker|.
+  // It's used by geocoders of |m_workers|.
+  bool m_collectResults = false;
+  vector<pair<FeatureID, PreRankingInfo>> m_collectedResults;
+
+  // Geocoders for parallel geocoding of mwms, empty when mwms are geocoded on one thread.
+  vector<unique_ptr<Worker>> m_workers;
 };
 }  // namespace search
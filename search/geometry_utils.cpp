@@ -39,4 +39,27 @@ int GetQueryIndexScale(m2::RectD const & viewport)
   return scales::GetScaleLevel(viewport) + 7;
 }
 
+void SubtractRect(m2::RectD const & rect, m2::RectD const & sub, std::vector<m2::RectD> & parts)
+{
+  parts.clear();
+
+  m2::RectD inner = rect;
+  if (!inner.Intersect(sub))
+  {
+    parts.push_back(rect);
+    return;
+  }
+
+  // Stripes below and above |sub| are as wide as |rect|, stripes on the left and on the right
+  // are as high as |inner|.
+  if (rect.minY() < inner.minY())
+    parts.emplace_back(rect.minX(), rect.minY(), rect.maxX(), inner.minY());
+  if (inner.maxY() < rect.maxY())
+    parts.emplace_back(rect.minX(), inner.maxY(), rect.maxX(), rect.maxY());
+  if (rect.minX() < inner.minX())
+    parts.emplace_back(rect.minX(), inner.minY(), inner.minX(), inner.maxY());
+  if (inner.maxX() < rect.maxX())
+    parts.emplace_back(inner.maxX(), inner.minY(), rect.maxX(), inner.maxY());
+}
+
 } // namespace search
@@ -3,6 +3,7 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include <vector>
 
 namespace search
 {
@@ -15,5 +16,7 @@ bool IsEqualMercator(m2::RectD const & r1, m2::RectD const & r2, double epsMeter
 bool GetInflatedViewport(m2::RectD & viewport);
 // Get scale level to make geometry index query for current viewport.
 int GetQueryIndexScale(m2::RectD const & viewport);
+// Splits the part of |rect| outside of |sub| into at most four rects without common inner points.
+void SubtractRect(m2::RectD const & rect, m2::RectD const & sub, std::vector<m2::RectD> & parts);
 
 }
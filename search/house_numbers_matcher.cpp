@@ -411,6 +411,32 @@ void TransformString(UniString && token, TFn && fn)
     fn(move(token), Token::TYPE_STRING);
   }
 }
+
+// Fast pre-check, helps to early exit without complex house number
+// parsing.
+bool MayMatch(UniString const & houseNumber, vector<Token> const & queryParse)
+{
+  if (houseNumber.empty() || queryParse.empty())
+    return false;
+
+  return !(IsASCIIDigit(houseNumber[0]) && IsASCIIDigit(queryParse[0].m_value[0]) &&
+           houseNumber[0] != queryParse[0].m_value[0]);
+}
+
+bool ParsesMatch(vector<vector<Token>> const & houseNumberParses, vector<Token> const & queryParse)
+{
+  for (auto const & parse : houseNumberParses)
+  {
+    if (parse.empty())
+      continue;
+    if (parse[0] == queryParse[0] &&
+        IsSubsequence(parse.begin() + 1, parse.end(), queryParse.begin() + 1, queryParse.end()))
+    {
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace
 
 void Tokenize(UniString s, bool isPrefix, vector<Token> & ts)
@@ -512,6 +538,16 @@ void ParseHouseNumber(strings::UniString const & s, vector<vector<Token>> & pars
     SimplifyParse(parses[i]);
 }
 
+vector<vector<Token>> const & ParsedHouseNumber::GetParses() const
+{
+  if (!m_parsed)
+  {
+    ParseHouseNumber(m_houseNumber, m_parses);
+    m_parsed = true;
+  }
+  return m_parses;
+}
+
 void ParseQuery(strings::UniString const & query, bool queryIsPrefix, vector<Token> & parse)
 {
   Tokenize(query, queryIsPrefix, parse);
@@ -532,31 +568,18 @@ bool HouseNumbersMatch(strings::UniString const & houseNumber, strings::UniStrin
 
 bool HouseNumbersMatch(strings::UniString const & houseNumber, vector<Token> const & queryParse)
 {
-  if (houseNumber.empty() || queryParse.empty())
-    return false;
-
-  // Fast pre-check, helps to early exit without complex house number
-  // parsing.
-  if (IsASCIIDigit(houseNumber[0]) && IsASCIIDigit(queryParse[0].m_value[0]) &&
-      houseNumber[0] != queryParse[0].m_value[0])
-  {
+  if (!MayMatch(houseNumber, queryParse))
     return false;
-  }
 
   vector<vector<Token>> houseNumberParses;
   ParseHouseNumber(houseNumber, houseNumberParses);
+  return ParsesMatch(houseNumberParses, queryParse);
+}
 
-  for (auto & parse : houseNumberParses)
-  {
-    if (parse.empty())
-      continue;
-    if (parse[0] == queryParse[0] &&
-        IsSubsequence(parse.begin() + 1, parse.end(), queryParse.begin() + 1, queryParse.end()))
-    {
-      return true;
-    }
-  }
-  return false;
+bool HouseNumbersMatch(ParsedHouseNumber const & houseNumber, vector<Token> const & queryParse)
+{
+  return MayMatch(houseNumber.Get(), queryParse) &&
+         ParsesMatch(houseNumber.GetParses(), queryParse);
 }
 
 bool LooksLikeHouseNumber(strings::UniString const & s, bool isPrefix)
@@ -52,6 +52,25 @@ struct Token
   bool m_prefix = false;
 };
 
+// House number which is parsed once, on the first match, and then is
+// matched against many queries without reparsing.
+class ParsedHouseNumber
+{
+public:
+  ParsedHouseNumber() = default;
+  explicit ParsedHouseNumber(strings::UniString const & houseNumber) : m_houseNumber(houseNumber)
+  {
+  }
+
+  strings::UniString const & Get() const { return m_houseNumber; }
+  vector<vector<Token>> const & GetParses() const;
+
+private:
+  strings::UniString m_houseNumber;
+  mutable vector<vector<Token>> m_parses;
+  mutable bool m_parsed = false;
+};
+
 // Tokenizes |s| that may be a house number.
 void Tokenize(strings::UniString s, bool isPrefix, vector<Token> & ts);
 
@@ -69,6 +88,9 @@ bool HouseNumbersMatch(strings::UniString const & houseNumber, strings::UniStrin
 // Returns true if house number matches to a given parsed query.
 bool HouseNumbersMatch(strings::UniString const & houseNumber, vector<Token> const & queryParse);
 
+// Same as above, but the house number is parsed only if it isn't parsed yet.
+bool HouseNumbersMatch(ParsedHouseNumber const & houseNumber, vector<Token> const & queryParse);
+
 // Returns true if |s| looks like a house number.
 bool LooksLikeHouseNumber(strings::UniString const & s, bool isPrefix);
 
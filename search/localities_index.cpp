@@ -0,0 +1,176 @@
+#include "search/localities_index.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_data.hpp"
+#include "indexer/ftypes_matcher.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/math.hpp"
+
+#include <cmath>
+#include <tuple>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+uint8_t constexpr kVersion = 0;
+uint64_t constexpr kHeaderSize = 9;
+uint64_t constexpr kCellSize = 8;
+uint64_t constexpr kLocalitySize = 12;
+}  // namespace
+
+bool IsIndexedLocality(FeatureType & ft, uint64_t & population)
+{
+  if (ft.GetFeatureType() != feature::GEOM_POINT)
+    return false;
+
+  using namespace ftypes;
+  switch (IsLocalityChecker::Instance().GetType(ft))
+  {
+  case CITY:
+  case TOWN:
+  case VILLAGE:
+    break;
+  default:
+    return false;
+  }
+
+  population = GetPopulation(ft);
+  return population != 0;
+}
+
+// LocalitiesIndex ---------------------------------------------------------------------------------
+// static
+double constexpr LocalitiesIndex::kCellSizeMercator;
+
+// static
+unique_ptr<LocalitiesIndex> LocalitiesIndex::Load(Reader & reader)
+{
+  try
+  {
+    if (reader.Size() < kHeaderSize)
+      return nullptr;
+
+    NonOwningReaderSource src(reader);
+    auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+    if (version != kVersion)
+    {
+      LOG(LWARNING, ("Unsupported localities index version:", version));
+      return nullptr;
+    }
+
+    auto const numCells = ReadPrimitiveFromSource<uint32_t>(src);
+    auto const numLocalities = ReadPrimitiveFromSource<uint32_t>(src);
+    if (reader.Size() != kHeaderSize + kCellSize * numCells + kLocalitySize * numLocalities)
+      return nullptr;
+
+    unique_ptr<LocalitiesIndex> index(new LocalitiesIndex());
+    index->m_cells.resize(numCells);
+    for (auto & cell : index->m_cells)
+    {
+      cell.m_id = ReadPrimitiveFromSource<uint32_t>(src);
+      cell.m_first = ReadPrimitiveFromSource<uint32_t>(src);
+    }
+    index->m_localities.resize(numLocalities);
+    for (auto & locality : index->m_localities)
+    {
+      locality.m_featureId = ReadPrimitiveFromSource<uint32_t>(src);
+      locality.m_center.x = ReadPrimitiveFromSource<uint32_t>(src);
+      locality.m_center.y = ReadPrimitiveFromSource<uint32_t>(src);
+    }
+
+    auto const & cells = index->m_cells;
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+      bool const valid = cells[i].m_first < numLocalities &&
+                         (i == 0 || (cells[i - 1].m_id < cells[i].m_id &&
+                                     cells[i - 1].m_first < cells[i].m_first));
+      if (!valid)
+      {
+        LOG(LWARNING, ("Malformed localities index."));
+        return nullptr;
+      }
+    }
+
+    return index;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't load localities index:", e.Msg()));
+    return nullptr;
+  }
+}
+
+// static
+uint32_t LocalitiesIndex::GetNumCols()
+{
+  return static_cast<uint32_t>(
+      ceil((MercatorBounds::maxX - MercatorBounds::minX) / kCellSizeMercator));
+}
+
+// static
+void LocalitiesIndex::GetCell(m2::PointD const & p, uint32_t & col, uint32_t & row)
+{
+  auto const toIndex = [](double d, double min) {
+    auto const numCols = static_cast<double>(GetNumCols());
+    return static_cast<uint32_t>(base::clamp(floor((d - min) / kCellSizeMercator), 0.0, numCols - 1));
+  };
+  col = toIndex(p.x, MercatorBounds::minX);
+  row = toIndex(p.y, MercatorBounds::minY);
+}
+
+// LocalitiesIndexBuilder --------------------------------------------------------------------------
+void LocalitiesIndexBuilder::Put(uint32_t featureId, m2::PointD const & center)
+{
+  uint32_t col, row;
+  LocalitiesIndex::GetCell(center, col, row);
+
+  Entry entry;
+  entry.m_cellId = LocalitiesIndex::GetCellId(col, row);
+  entry.m_featureId = featureId;
+  entry.m_center = PointDToPointU(center, POINT_COORD_BITS);
+  m_entries.push_back(entry);
+}
+
+void LocalitiesIndexBuilder::Freeze(Writer & writer) const
+{
+  auto entries = m_entries;
+  sort(entries.begin(), entries.end(), [](Entry const & lhs, Entry const & rhs) {
+    return tie(lhs.m_cellId, lhs.m_featureId) < tie(rhs.m_cellId, rhs.m_featureId);
+  });
+
+  uint32_t numCells = 0;
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    if (i == 0 || entries[i - 1].m_cellId != entries[i].m_cellId)
+      ++numCells;
+  }
+
+  WriteToSink(writer, kVersion);
+  WriteToSink(writer, numCells);
+  WriteToSink(writer, static_cast<uint32_t>(entries.size()));
+
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    if (i != 0 && entries[i - 1].m_cellId == entries[i].m_cellId)
+      continue;
+    WriteToSink(writer, entries[i].m_cellId);
+    WriteToSink(writer, static_cast<uint32_t>(i));
+  }
+
+  for (auto const & entry : entries)
+  {
+    WriteToSink(writer, entry.m_featureId);
+    WriteToSink(writer, entry.m_center.x);
+    WriteToSink(writer, entry.m_center.y);
+  }
+}
+}  // namespace search
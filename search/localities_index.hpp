@@ -0,0 +1,117 @@
+#pragma once
+
+#include "coding/pointd_to_pointu.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class FeatureType;
+class Reader;
+class Writer;
+
+namespace search
+{
+// Returns true iff |ft| is a locality which may be found by LocalityFinder, i.e. a point
+// city, town or village with known population. |population| is set to its population.
+bool IsIndexedLocality(FeatureType & ft, uint64_t & population);
+
+// A wrapper class around serialized index of the localities of an mwm, i.e. the features
+// for which IsIndexedLocality() is true. It allows LocalityFinder to get localities near
+// a point without the walk over the geometry index and decoding of all features near
+// the point.
+//
+// The index is serialized in the following format:
+//
+// File offset (bytes)   Field name     Field size (bytes)
+// 0                     version        1
+// 1                     numCells       4
+// 5                     numLocalities  4
+// 9                     cells          8 * numCells
+// 9 + 8 * numCells      localities     12 * numLocalities
+//
+// All numbers are stored in little-endian format. Localities are grouped
+// by the cells of the grid of kCellSizeMercator mercator units they are in.
+// A cell is a pair (cell id, index of the first locality of the cell),
+// cells are sorted by ids. A locality is a triple (feature id, x, y),
+// where (x, y) is the center of the locality encoded by PointDToPointU.
+class LocalitiesIndex
+{
+public:
+  static double constexpr kCellSizeMercator = 0.05;
+
+  // Returns nullptr if the index can't be loaded. The index is copied to memory,
+  // so |reader| may be destroyed after the call.
+  static std::unique_ptr<LocalitiesIndex> Load(Reader & reader);
+
+  // Calls |fn| on feature ids of the localities whose centers are inside |rect|.
+  template <typename Fn>
+  void ForEachInRect(m2::RectD const & rect, Fn && fn) const
+  {
+    uint32_t minCol, minRow, maxCol, maxRow;
+    GetCell(rect.LeftBottom(), minCol, minRow);
+    GetCell(rect.RightTop(), maxCol, maxRow);
+
+    for (uint32_t row = minRow; row <= maxRow; ++row)
+    {
+      auto it = std::lower_bound(m_cells.cbegin(), m_cells.cend(), GetCellId(minCol, row),
+                                 [](Cell const & cell, uint32_t id) { return cell.m_id < id; });
+      for (; it != m_cells.cend() && it->m_id <= GetCellId(maxCol, row); ++it)
+      {
+        uint32_t const end =
+            it + 1 == m_cells.cend() ? static_cast<uint32_t>(m_localities.size()) : (it + 1)->m_first;
+        for (uint32_t i = it->m_first; i < end; ++i)
+        {
+          auto const & locality = m_localities[i];
+          if (rect.IsPointInside(PointUToPointD(locality.m_center, POINT_COORD_BITS)))
+            fn(locality.m_featureId);
+        }
+      }
+    }
+  }
+
+private:
+  friend class LocalitiesIndexBuilder;
+
+  struct Cell
+  {
+    uint32_t m_id = 0;
+    uint32_t m_first = 0;
+  };
+
+  struct Locality
+  {
+    uint32_t m_featureId = 0;
+    m2::PointU m_center;
+  };
+
+  static uint32_t GetNumCols();
+  static uint32_t GetCellId(uint32_t col, uint32_t row) { return row * GetNumCols() + col; }
+  static void GetCell(m2::PointD const & p, uint32_t & col, uint32_t & row);
+
+  std::vector<Cell> m_cells;
+  std::vector<Locality> m_localities;
+};
+
+class LocalitiesIndexBuilder
+{
+public:
+  void Put(uint32_t featureId, m2::PointD const & center);
+  void Freeze(Writer & writer) const;
+
+private:
+  struct Entry
+  {
+    uint32_t m_cellId = 0;
+    uint32_t m_featureId = 0;
+    m2::PointU m_center;
+  };
+
+  std::vector<Entry> m_entries;
+};
+}  // namespace search
@@ -3,6 +3,7 @@
 #include "search/categories_cache.hpp"
 #include "search/cbv.hpp"
 #include "search/dummy_rank_table.hpp"
+#include "search/localities_index.hpp"
 #include "search/mwm_context.hpp"
 
 #include "indexer/data_source.hpp"
@@ -80,22 +81,9 @@ public:
     if (!m_ctx.GetFeature(id, ft))
       return;
 
-    if (ft.GetFeatureType() != feature::GEOM_POINT)
-      return;
-
-    using namespace ftypes;
-    switch (IsLocalityChecker::Instance().GetType(ft))
-    {
-    case CITY:
-    case TOWN:
-    case VILLAGE:
-      break;
-    default:
-      return;
-    }
-
-    auto const population = ftypes::GetPopulation(ft);
-    if (population == 0)
+    // Features from the localities index are checked too, as they may be edited.
+    uint64_t population;
+    if (!IsIndexedLocality(ft, population))
       return;
 
     auto const names = ft.GetNames();
@@ -218,6 +206,8 @@ LocalityFinder::LocalityFinder(DataSource const & dataSource,
 {
 }
 
+LocalityFinder::~LocalityFinder() = default;
+
 void LocalityFinder::ClearCache()
 {
   m_ranks.reset();
@@ -229,6 +219,32 @@ void LocalityFinder::ClearCache()
   m_mapsLoaded = false;
 
   m_loadedIds.clear();
+  m_indices.clear();
+}
+
+template <typename Fn>
+void LocalityFinder::ForEachLocalityCandidate(MwmContext const & ctx, m2::RectD const & rect,
+                                              Fn && fn)
+{
+  auto const & id = ctx.GetId();
+  auto it = m_indices.find(id);
+  if (it == m_indices.end())
+  {
+    unique_ptr<LocalitiesIndex> index;
+    auto const & cont = ctx.m_value.m_cont;
+    if (cont.IsExist(SEARCH_LOCALITIES_FILE_TAG))
+    {
+      auto reader = cont.GetReader(SEARCH_LOCALITIES_FILE_TAG);
+      index = LocalitiesIndex::Load(*reader.GetPtr());
+    }
+    it = m_indices.emplace(id, move(index)).first;
+  }
+
+  // Mwms without the index are walked by the geometry index.
+  if (it->second)
+    it->second->ForEachInRect(rect, forward<Fn>(fn));
+  else
+    ctx.ForEachIndex(rect, forward<Fn>(fn));
 }
 
 void LocalityFinder::LoadVicinity(m2::PointD const & p, bool loadCities, bool loadVillages)
@@ -248,8 +264,9 @@ void LocalityFinder::LoadVicinity(m2::PointD const & p, bool loadCities, bool lo
         m_ranks = make_unique<DummyRankTable>();
 
       MwmContext ctx(move(handle));
-      ctx.ForEachIndex(crect, LocalitiesLoader(ctx, m_boundariesTable, CityFilter(*m_ranks),
-                                               m_cities, m_loadedIds));
+      ForEachLocalityCandidate(ctx, crect,
+                               LocalitiesLoader(ctx, m_boundariesTable, CityFilter(*m_ranks),
+                                                m_cities, m_loadedIds));
     }
 
     m_cities.SetCovered(p);
@@ -264,9 +281,10 @@ void LocalityFinder::LoadVicinity(m2::PointD const & p, bool loadCities, bool lo
         return;
 
       MwmContext ctx(move(handle));
-      ctx.ForEachIndex(vrect,
-                       LocalitiesLoader(ctx, m_boundariesTable, VillageFilter(ctx, m_villagesCache),
-                                        m_villages, m_loadedIds));
+      ForEachLocalityCandidate(
+          ctx, vrect,
+          LocalitiesLoader(ctx, m_boundariesTable, VillageFilter(ctx, m_villagesCache), m_villages,
+                           m_loadedIds));
     });
 
     m_villages.SetCovered(p);
@@ -24,6 +24,8 @@ class DataSource;
 
 namespace search
 {
+class LocalitiesIndex;
+class MwmContext;
 class VillagesCache;
 
 struct LocalityItem
@@ -102,6 +104,7 @@ public:
 
   LocalityFinder(DataSource const & dataSource, CitiesBoundariesTable const & boundaries,
                  VillagesCache & villagesCache);
+  ~LocalityFinder();
 
   template <typename Fn>
   bool GetLocality(m2::PointD const & p, Fn && fn)
@@ -125,6 +128,11 @@ private:
   void LoadVicinity(m2::PointD const & p, bool loadCities, bool loadVillages);
   void UpdateMaps();
 
+  // Calls |fn| on ids of the features of |ctx| in |rect| which may be localities. The localities
+  // index of the mwm is used when it's available.
+  template <typename Fn>
+  void ForEachLocalityCandidate(MwmContext const & ctx, m2::RectD const & rect, Fn && fn);
+
   DataSource const & m_dataSource;
   CitiesBoundariesTable const & m_boundariesTable;
   VillagesCache & m_villagesCache;
@@ -139,5 +147,8 @@ private:
   std::unique_ptr<RankTable> m_ranks;
 
   std::map<MwmSet::MwmId, std::unordered_set<uint32_t>> m_loadedIds;
+
+  // Localities indices of mwms, nullptr when an mwm has no index.
+  std::map<MwmSet::MwmId, std::unique_ptr<LocalitiesIndex>> m_indices;
 };
 }  // namespace search
@@ -0,0 +1,126 @@
+#include "search/matched_streets_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+uint8_t constexpr kVersion = 0;
+uint64_t constexpr kHeaderSize = 6;
+uint64_t constexpr kPaddingSize = sizeof(uint64_t);
+
+uint32_t constexpr kUnknown = 0;
+uint32_t constexpr kNoStreetValue = 1;
+uint32_t constexpr kFirstStreetValue = 2;
+}  // namespace
+
+// static
+uint32_t constexpr MatchedStreetsTable::kNoStreet;
+
+MatchedStreetsTable::MatchedStreetsTable(Reader & reader, uint8_t bits, uint32_t size)
+  : m_reader(reader), m_bits(bits), m_size(size)
+{
+}
+
+bool MatchedStreetsTable::Get(uint32_t houseId, uint32_t & streetId) const
+{
+  if (houseId >= m_size)
+    return false;
+
+  uint64_t const bit = static_cast<uint64_t>(houseId) * m_bits;
+  uint64_t const word =
+      ReadPrimitiveFromPos<uint64_t>(m_reader, kHeaderSize + bit / CHAR_BIT) >> (bit % CHAR_BIT);
+  auto const value = static_cast<uint32_t>(word & ((static_cast<uint64_t>(1) << m_bits) - 1));
+
+  switch (value)
+  {
+  case kUnknown: return false;
+  case kNoStreetValue: streetId = kNoStreet; return true;
+  default: streetId = value - kFirstStreetValue; return true;
+  }
+}
+
+// static
+unique_ptr<MatchedStreetsTable> MatchedStreetsTable::Load(Reader & reader)
+{
+  try
+  {
+    if (reader.Size() < kHeaderSize)
+      return nullptr;
+
+    uint8_t const version = ReadPrimitiveFromPos<uint8_t>(reader, 0);
+    uint8_t const bits = ReadPrimitiveFromPos<uint8_t>(reader, 1);
+    uint32_t const size = ReadPrimitiveFromPos<uint32_t>(reader, 2);
+    if (version != kVersion || bits == 0 || bits > 32)
+    {
+      LOG(LWARNING, ("Unsupported matched streets table, version:", version, "bits:", bits));
+      return nullptr;
+    }
+
+    uint64_t const valuesSize = (static_cast<uint64_t>(size) * bits + CHAR_BIT - 1) / CHAR_BIT;
+    if (reader.Size() < kHeaderSize + valuesSize + kPaddingSize)
+      return nullptr;
+
+    return unique_ptr<MatchedStreetsTable>(new MatchedStreetsTable(reader, bits, size));
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't load matched streets table:", e.Msg()));
+    return nullptr;
+  }
+}
+
+void MatchedStreetsTableBuilder::Put(uint32_t houseId, uint32_t streetId)
+{
+  ASSERT(streetId == MatchedStreetsTable::kNoStreet ||
+             streetId < numeric_limits<uint32_t>::max() - kFirstStreetValue,
+         (streetId));
+
+  if (houseId >= m_values.size())
+    m_values.resize(static_cast<size_t>(houseId) + 1, kUnknown);
+  m_values[houseId] =
+      streetId == MatchedStreetsTable::kNoStreet ? kNoStreetValue : streetId + kFirstStreetValue;
+}
+
+void MatchedStreetsTableBuilder::Freeze(Writer & writer) const
+{
+  uint32_t maxValue = kNoStreetValue;
+  for (auto const value : m_values)
+    maxValue = max(maxValue, value);
+  auto const bits = static_cast<uint8_t>(bits::FloorLog(maxValue) + 1);
+
+  WriteToSink(writer, kVersion);
+  WriteToSink(writer, bits);
+  WriteToSink(writer, static_cast<uint32_t>(m_values.size()));
+
+  // Values are flushed by bytes as soon as they are filled.
+  uint64_t buffer = 0;
+  uint8_t numBits = 0;
+  for (auto const value : m_values)
+  {
+    buffer |= static_cast<uint64_t>(value) << numBits;
+    numBits += bits;
+    for (; numBits >= CHAR_BIT; numBits -= CHAR_BIT)
+    {
+      WriteToSink(writer, static_cast<uint8_t>(buffer));
+      buffer >>= CHAR_BIT;
+    }
+  }
+  if (numBits != 0)
+    WriteToSink(writer, static_cast<uint8_t>(buffer));
+
+  WriteZeroesToSink(writer, kPaddingSize);
+}
+}  // namespace search
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+class Reader;
+class Writer;
+
+namespace search
+{
+// A wrapper class around serialized table of streets matched with houses
+// of an mwm, i.e. streets chosen for the houses by FeaturesLayerMatcher from
+// nearby streets and the house-to-street table. It allows to match houses
+// with streets without loading of the houses and their nearby streets.
+//
+// The table is serialized in the following format:
+//
+// File offset (bytes)  Field name  Field size (bytes)
+// 0                    version     1
+// 1                    bits        1
+// 2                    size        4
+// 6                    values      ceil(size * bits / 8) + 8
+//
+// Size is stored in little-endian format.  Values are packed by |bits|
+// bits per feature starting from the least significant bits, from the
+// first feature to the last one: 0 means that the street of the feature
+// is not known, 1 means that the feature has no matching street and any
+// other value is the id of the matching street plus 2.  Values are padded
+// with 8 zero bytes, so any value can be read by a single read of 8 bytes.
+class MatchedStreetsTable
+{
+public:
+  static uint32_t constexpr kNoStreet = std::numeric_limits<uint32_t>::max();
+
+  // Returns false if the street of |houseId| is not known. Otherwise
+  // |streetId| is the id of the matching street or kNoStreet.
+  WARN_UNUSED_RESULT bool Get(uint32_t houseId, uint32_t & streetId) const;
+
+  // Note that |reader| must be alive until the destruction of the loaded
+  // table. Returns nullptr if the table can't be loaded.
+  static std::unique_ptr<MatchedStreetsTable> Load(Reader & reader);
+
+private:
+  MatchedStreetsTable(Reader & reader, uint8_t bits, uint32_t size);
+
+  Reader & m_reader;
+  uint8_t const m_bits;
+  uint32_t const m_size;
+};
+
+class MatchedStreetsTableBuilder
+{
+public:
+  // |streetId| is the id of a street or MatchedStreetsTable::kNoStreet.
+  void Put(uint32_t houseId, uint32_t streetId);
+  void Freeze(Writer & writer) const;
+
+private:
+  // Values are encoded as described in MatchedStreetsTable.
+  std::vector<uint32_t> m_values;
+};
+}  // namespace search
@@ -4,8 +4,16 @@
 #include "indexer/fake_feature_ids.hpp"
 #include "indexer/feature_source.hpp"
 
+#include "defines.hpp"
+
 namespace search
 {
+namespace
+{
+// Max size of top levels of each geometry index which are kept in memory by MwmContext.
+uint32_t constexpr kIndexTopLevelsSize = 4 * 1024;
+}  // namespace
+
 void CoverRect(m2::RectD const & rect, int scale, covering::Intervals & result)
 {
   covering::CoveringGetter covering(rect, covering::ViewportWithLowLevels);
@@ -19,7 +27,10 @@ MwmContext::MwmContext(MwmSet::MwmHandle handle)
   , m_vector(m_value.m_cont, m_value.GetHeader(), m_value.m_table.get())
   , m_index(m_value.m_cont.GetReader(INDEX_FILE_TAG), m_value.m_factory)
   , m_centers(m_value)
+  , m_matchedStreetsReader(unique_ptr<ModelReader>())
 {
+  // A context serves many queries to the index, so its top levels are read once.
+  m_index.LoadTopLevels(kIndexTopLevelsSize);
 }
 
 bool MwmContext::GetFeature(uint32_t index, FeatureType & ft) const
@@ -60,4 +71,25 @@ bool MwmContext::GetStreetIndex(uint32_t houseId, uint32_t & streetId)
   }
   return m_houseToStreetTable->Get(houseId, streetId);
 }
+
+bool MwmContext::GetMatchedStreet(uint32_t houseId, uint32_t & streetId)
+{
+  EnsureMatchedStreetsLoaded();
+  return m_matchedStreets && m_matchedStreets->Get(houseId, streetId);
+}
+
+void MwmContext::EnsureMatchedStreetsLoaded()
+{
+  if (m_matchedStreetsLoaded)
+    return;
+  m_matchedStreetsLoaded = true;
+
+  // The section is optional, old mwms don't have it.
+  if (!m_value.m_cont.IsExist(SEARCH_MATCHED_STREETS_FILE_TAG))
+    return;
+
+  m_matchedStreetsReader = m_value.m_cont.GetReader(SEARCH_MATCHED_STREETS_FILE_TAG);
+  if (m_matchedStreetsReader.GetPtr())
+    m_matchedStreets = MatchedStreetsTable::Load(*m_matchedStreetsReader.GetPtr());
+}
 }  // namespace search
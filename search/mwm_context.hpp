@@ -2,6 +2,7 @@
 
 #include "search/house_to_street_table.hpp"
 #include "search/lazy_centers_table.hpp"
+#include "search/matched_streets_table.hpp"
 
 #include "editor/osm_editor.hpp"
 
@@ -85,6 +86,10 @@ public:
 
   WARN_UNUSED_RESULT bool GetStreetIndex(uint32_t houseId, uint32_t & streetId);
 
+  // Returns false if there is no precomputed street for |houseId|. Otherwise |streetId| is the
+  // id of the street matched with the house or MatchedStreetsTable::kNoStreet.
+  WARN_UNUSED_RESULT bool GetMatchedStreet(uint32_t houseId, uint32_t & streetId);
+
   WARN_UNUSED_RESULT inline bool GetCenter(uint32_t index, m2::PointD & center)
   {
     return m_centers.Get(index, center);
@@ -94,6 +99,8 @@ public:
   MwmValue & m_value;
 
 private:
+  void EnsureMatchedStreetsLoaded();
+
   FeatureStatus GetEditedStatus(uint32_t index) const
   {
     return osm::Editor::Instance().GetFeatureStatus(GetId(), index);
@@ -113,13 +120,10 @@ private:
   void ForEachIndexImpl(covering::Intervals const & intervals, uint32_t scale, TFn && fn) const
   {
     CheckUniqueIndexes checkUnique(m_value.GetHeader().GetFormat() >= version::Format::v5);
-    for (auto const & i : intervals)
-      m_index.ForEachInIntervalAndScale(i.first, i.second, scale,
-          [&](uint32_t index)
-          {
-            if (checkUnique(index))
-              fn(index);
-          });
+    m_index.ForEachInIntervalsAndScale(intervals, scale, [&](uint32_t index) {
+      if (checkUnique(index))
+        fn(index);
+    });
   }
 
   FeaturesVector m_vector;
@@ -127,6 +131,10 @@ private:
   unique_ptr<HouseToStreetTable> m_houseToStreetTable;
   LazyCentersTable m_centers;
 
+  bool m_matchedStreetsLoaded = false;
+  FilesContainerR::TReader m_matchedStreetsReader;
+  unique_ptr<MatchedStreetsTable> m_matchedStreets;
+
   DISALLOW_COPY_AND_MOVE(MwmContext);
 };
 }  // namespace search
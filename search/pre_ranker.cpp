@@ -3,6 +3,7 @@
 #include "search/dummy_rank_table.hpp"
 #include "search/lazy_centers_table.hpp"
 #include "search/pre_ranking_info.hpp"
+#include "search/query_stats.hpp"
 
 #include "indexer/data_source.hpp"
 #include "indexer/mwm_set.hpp"
@@ -12,6 +13,7 @@
 #include "geometry/mercator.hpp"
 #include "geometry/nearby_points_sweeper.hpp"
 
+#include "base/profiler.hpp"
 #include "base/random.hpp"
 #include "base/stl_helpers.hpp"
 
@@ -55,6 +57,7 @@ PreRanker::PreRanker(DataSource const & dataSource, Ranker & ranker)
 void PreRanker::Init(Params const & params)
 {
   m_numSentResults = 0;
+  m_numCompleteResults = 0;
   m_results.clear();
   m_params = params;
   m_currEmit.clear();
@@ -68,58 +71,70 @@ void PreRanker::Finish(bool cancelled)
   m_ranker.Finish(cancelled);
 }
 
-void PreRanker::FillMissingFieldsInPreResults()
-{
-  MwmSet::MwmId mwmId;
-  MwmSet::MwmHandle mwmHandle;
-  unique_ptr<RankTable> ranks = make_unique<DummyRankTable>();
-  unique_ptr<RankTable> popularityRanks = make_unique<DummyRankTable>();
-  unique_ptr<LazyCentersTable> centers;
+void PreRanker::FillMissingFieldsInPreResults() { FillMissingFields(m_results); }
 
+void PreRanker::FillMissingFields(vector<PreRankerResult> & results)
+{
   m_pivotFeatures.SetPosition(m_params.m_accuratePivotCenter, m_params.m_scale);
 
-  ForEach([&](PreRankerResult & r) {
-    FeatureID const & id = r.GetId();
-    PreRankingInfo & info = r.GetInfo();
-    if (id.m_mwmId != mwmId)
+  vector<uint32_t> ids;
+  vector<uint8_t> ranks;
+  vector<uint8_t> popularity;
+
+  // Ranks are fetched by batches of consecutive results from the same mwm.
+  for (size_t begin = 0, end = 0; begin < results.size(); begin = end)
+  {
+    MwmSet::MwmId const mwmId = results[begin].GetId().m_mwmId;
+    ids.clear();
+    for (end = begin; end < results.size() && results[end].GetId().m_mwmId == mwmId; ++end)
+      ids.push_back(results[end].GetId().m_index);
+
+    unique_ptr<RankTable> rankTable;
+    unique_ptr<RankTable> popularityTable;
+    unique_ptr<LazyCentersTable> centers;
+    auto mwmHandle = m_dataSource.GetMwmHandleById(mwmId);
+    if (mwmHandle.IsAlive())
     {
-      mwmId = id.m_mwmId;
-      mwmHandle = m_dataSource.GetMwmHandleById(mwmId);
-      ranks.reset();
-      centers.reset();
-      if (mwmHandle.IsAlive())
-      {
-        ranks = RankTable::Load(mwmHandle.GetValue<MwmValue>()->m_cont, SEARCH_RANKS_FILE_TAG);
-        popularityRanks = RankTable::Load(mwmHandle.GetValue<MwmValue>()->m_cont,
-                                          POPULARITY_RANKS_FILE_TAG);
-        centers = make_unique<LazyCentersTable>(*mwmHandle.GetValue<MwmValue>());
-      }
-      if (!ranks)
-        ranks = make_unique<DummyRankTable>();
-      if (!popularityRanks)
-        popularityRanks = make_unique<DummyRankTable>();
+      auto & value = *mwmHandle.GetValue<MwmValue>();
+      rankTable = RankTable::Load(value.m_cont, SEARCH_RANKS_FILE_TAG);
+      popularityTable = RankTable::Load(value.m_cont, POPULARITY_RANKS_FILE_TAG);
+      centers = make_unique<LazyCentersTable>(value);
     }
+    if (!rankTable)
+      rankTable = make_unique<DummyRankTable>();
+    if (!popularityTable)
+      popularityTable = make_unique<DummyRankTable>();
 
-    info.m_rank = ranks->Get(id.m_index);
-    info.m_popularity = popularityRanks->Get(id.m_index);
+    rankTable->GetRanks(ids, ranks);
+    popularityTable->GetRanks(ids, popularity);
 
-    m2::PointD center;
-    if (centers && centers->Get(id.m_index, center))
+    for (size_t i = begin; i < end; ++i)
     {
-      info.m_distanceToPivot =
-          MercatorBounds::DistanceOnEarth(m_params.m_accuratePivotCenter, center);
-      info.m_center = center;
-      info.m_centerLoaded = true;
-    }
-    else
-    {
-      info.m_distanceToPivot = m_pivotFeatures.GetDistanceToFeatureMeters(id);
+      auto & r = results[i];
+      PreRankingInfo & info = r.GetInfo();
+      info.m_rank = ranks[i - begin];
+      info.m_popularity = popularity[i - begin];
+
+      m2::PointD center;
+      if (centers && centers->Get(r.GetId().m_index, center))
+      {
+        info.m_distanceToPivot =
+            MercatorBounds::DistanceOnEarth(m_params.m_accuratePivotCenter, center);
+        info.m_center = center;
+        info.m_centerLoaded = true;
+      }
+      else
+      {
+        info.m_distanceToPivot = m_pivotFeatures.GetDistanceToFeatureMeters(r.GetId());
+      }
     }
-  });
+  }
 }
 
 void PreRanker::Filter(bool viewportSearch)
 {
+  base::ProfilerZone zone("PreRank", "search");
+
   struct LessFeatureID
   {
     inline bool operator()(PreRankerResult const & lhs, PreRankerResult const & rhs) const
@@ -144,6 +159,15 @@ void PreRanker::Filter(bool viewportSearch)
   m_results.erase(unique(m_results.begin(), m_results.end(), base::EqualsBy(&PreRankerResult::GetId)),
                   m_results.end());
 
+  if (viewportSearch && m_params.m_processedViewport.IsValid())
+  {
+    auto const & processed = m_params.m_processedViewport;
+    base::EraseIf(m_results, [&processed](PreRankerResult const & result) {
+      auto const & info = result.GetInfo();
+      return info.m_centerLoaded && processed.IsPointInside(info.m_center);
+    });
+  }
+
   bool const centersLoaded =
       all_of(m_results.begin(), m_results.end(),
              [](PreRankerResult const & result) { return result.GetInfo().m_centerLoaded; });
@@ -221,6 +245,7 @@ void PreRanker::Filter(bool viewportSearch)
 
 void PreRanker::UpdateResults(bool lastUpdate)
 {
+  QueryStats::ScopedTimer timer(m_params.m_stats.get(), QueryStats::Phase::PreRanking);
   FillMissingFieldsInPreResults();
   Filter(m_params.m_viewportSearch);
   m_numSentResults += m_results.size();
@@ -232,6 +257,18 @@ void PreRanker::UpdateResults(bool lastUpdate)
     m_currEmit.swap(m_prevEmit);
 }
 
+void PreRanker::EmitProvisionalResults()
+{
+  QueryStats::ScopedTimer timer(m_params.m_stats.get(), QueryStats::Phase::PreRanking);
+
+  // The candidates are copied, so the pre-results are ranked as usual later.
+  vector<PreRankerResult> candidates;
+  copy_if(m_results.begin(), m_results.end(), back_inserter(candidates),
+          [](PreRankerResult const & r) { return r.GetInfo().m_allTokensUsed; });
+  FillMissingFields(candidates);
+  m_ranker.EmitProvisionalResults(candidates, m_params.m_numProvisionalResults);
+}
+
 void PreRanker::ClearCaches()
 {
   m_pivotFeatures.Clear();
@@ -13,6 +13,7 @@
 #include "std/cstdint.hpp"
 #include "std/random.hpp"
 #include "std/set.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -20,6 +21,8 @@ class DataSource;
 
 namespace search
 {
+class QueryStats;
+
 // Fast and simple pre-ranker for search results.
 class PreRanker
 {
@@ -41,6 +44,9 @@ public:
 
     m2::PointD m_position;
     m2::RectD m_viewport;
+    // When valid, results with centers inside the rect are reused from the previous viewport
+    // search and are filtered out.
+    m2::RectD m_processedViewport;
 
     int m_scale = 0;
 
@@ -51,6 +57,12 @@ public:
 
     bool m_viewportSearch = false;
     bool m_categorialRequest = false;
+
+    // The number of results in the provisional top, zero disables provisional results.
+    // See SearchParams::m_numProvisionalResults.
+    size_t m_numProvisionalResults = 0;
+
+    shared_ptr<QueryStats> m_stats;
   };
 
   PreRanker(DataSource const & dataSource, Ranker & ranker);
@@ -65,6 +77,14 @@ public:
     if (m_numSentResults >= Limit())
       return;
     m_results.emplace_back(forward<TArgs>(args)...);
+
+    // The provisional top is emitted once, when the required number of candidates
+    // matching all the tokens is found before the first batch is sent.
+    if (m_results.back().GetInfo().m_allTokensUsed &&
+        ++m_numCompleteResults == m_params.m_numProvisionalResults && m_numSentResults == 0)
+    {
+      EmitProvisionalResults();
+    }
   }
 
   // Computes missing fields for all pre-results.
@@ -90,7 +110,9 @@ public:
   void ClearCaches();
 
 private:
+  void FillMissingFields(vector<PreRankerResult> & results);
   void FilterForViewportSearch();
+  void EmitProvisionalResults();
 
   DataSource const & m_dataSource;
   Ranker & m_ranker;
@@ -100,6 +122,9 @@ private:
   // Amount of results sent up the pipeline.
   size_t m_numSentResults = 0;
 
+  // Amount of added results matching all the tokens.
+  size_t m_numCompleteResults = 0;
+
   // Cache of nested rects used to estimate distance from a feature to the pivot.
   NestedRectsCache m_pivotFeatures;
 
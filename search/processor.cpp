@@ -9,6 +9,7 @@
 #include "search/mode.hpp"
 #include "search/pre_ranking_info.hpp"
 #include "search/query_params.hpp"
+#include "search/query_stats.hpp"
 #include "search/ranking_info.hpp"
 #include "search/ranking_utils.hpp"
 #include "search/search_index_values.hpp"
@@ -45,11 +46,13 @@
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/profiler.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <chrono>
 
 #include "3party/Alohalytics/src/alohalytics.h"
 #include "3party/open-location-code/openlocationcode.h"
@@ -87,6 +90,23 @@ m2::RectD GetRectAroundPosition(m2::PointD const & position)
   return MercatorBounds::RectByCenterXYAndSizeInMeters(position, kMaxPositionRadiusM);
 }
 
+// Results of the previous viewport search are reused when the common part of the viewports is
+// not less than this part of the area of each viewport.
+double constexpr kMinReusedViewportPart = 0.5;
+
+double GetArea(m2::RectD const & rect) { return rect.SizeX() * rect.SizeY(); }
+
+// Returns true when the results of the search with |lhs| may be shown for the search with |rhs|.
+bool HaveSameResults(SearchParams const & lhs, SearchParams const & rhs)
+{
+  return lhs.IsEqualCommon(rhs) && lhs.m_maxNumResults == rhs.m_maxNumResults &&
+         lhs.m_minDistanceOnMapBetweenResults == rhs.m_minDistanceOnMapBetweenResults &&
+         lhs.m_suggestsEnabled == rhs.m_suggestsEnabled &&
+         lhs.m_needAddress == rhs.m_needAddress &&
+         lhs.m_needHighlighting == rhs.m_needHighlighting &&
+         lhs.m_hotelsFilter == rhs.m_hotelsFilter;
+}
+
 void SendStatistics(SearchParams const & params, m2::RectD const & viewport, Results const & res)
 {
   size_t const kMaxNumResultsToSend = 10;
@@ -143,7 +163,7 @@ double const Processor::kMinViewportRadiusM = 5.0 * 1000;
 double const Processor::kMaxViewportRadiusM = 50.0 * 1000;
 
 Processor::Processor(DataSource const & dataSource, CategoriesHolder const & categories,
-                     vector<Suggest> const & suggests,
+                     SuggestsIndex const & suggests,
                      storage::CountryInfoGetter const & infoGetter)
   : m_categories(categories)
   , m_infoGetter(infoGetter)
@@ -335,25 +355,9 @@ void Processor::LoadCitiesBoundaries()
 
 void Processor::LoadCountriesTree() { m_ranker.LoadCountriesTree(); }
 
-void Processor::OnBookmarksCreated(vector<pair<bookmarks::Id, bookmarks::Doc>> const & marks)
-{
-  for (auto const & idDoc : marks)
-    m_bookmarksProcessor.Add(idDoc.first /* id */, idDoc.second /* doc */);
-}
-
-void Processor::OnBookmarksUpdated(vector<pair<bookmarks::Id, bookmarks::Doc>> const & marks)
+void Processor::SetBookmarksSnapshot(shared_ptr<bookmarks::Snapshot const> snapshot)
 {
-  for (auto const & idDoc : marks)
-  {
-    m_bookmarksProcessor.Erase(idDoc.first /* id */);
-    m_bookmarksProcessor.Add(idDoc.first /* id */, idDoc.second /* doc */);
-  }
-}
-
-void Processor::OnBookmarksDeleted(vector<bookmarks::Id> const & marks)
-{
-  for (auto const & id : marks)
-    m_bookmarksProcessor.Erase(id);
+  m_bookmarksProcessor.SetSnapshot(move(snapshot));
 }
 
 Locales Processor::GetCategoryLocales() const
@@ -384,13 +388,30 @@ void Processor::ForEachCategoryTypeFuzzy(StringSliceBase const & slice, ToDo &&
                                      forward<ToDo>(toDo));
 }
 
+void Processor::Reset()
+{
+  base::Cancellable::Reset();
+  m_deadline = chrono::steady_clock::time_point::max();
+  m_deadlineExceeded = false;
+}
+
+bool Processor::IsCancelled() const
+{
+  return base::Cancellable::IsCancelled() || chrono::steady_clock::now() >= m_deadline;
+}
+
 void Processor::Search(SearchParams const & params)
 {
+  base::ProfilerZone zone("Search", "search");
+
   if (params.m_onStarted)
     params.m_onStarted();
 
   if (IsCancelled())
   {
+    // The deadline has passed while the query was waiting in the queue.
+    m_deadlineExceeded = !base::Cancellable::IsCancelled();
+
     Results results;
     results.SetEndMarker(true /* isCancelled */);
 
@@ -402,6 +423,8 @@ void Processor::Search(SearchParams const & params)
   }
 
   bool const viewportSearch = params.m_mode == Mode::Viewport;
+  // Traced queries are always processed from scratch, all the results are traced then.
+  bool const incremental = viewportSearch && params.m_incremental && !params.m_tracer;
 
   auto const & viewport = params.m_viewport;
   ASSERT(viewport.IsValid(), ());
@@ -413,17 +436,27 @@ void Processor::Search(SearchParams const & params)
 
   SetInputLocale(params.m_inputLocale);
 
-  SetQuery(params.m_query);
-  SetViewport(viewport);
-
   Geocoder::Params geocoderParams;
-  InitGeocoder(geocoderParams, params);
-  InitPreRanker(geocoderParams, params);
-  InitRanker(geocoderParams, params);
-  InitEmitter(params);
+  {
+    QueryStats::ScopedTimer timer(params.m_stats.get(), QueryStats::Phase::Tokenization);
+    base::ProfilerZone tokenizationZone("Tokenization", "search");
+    SetQuery(params.m_query);
+    SetViewport(viewport);
+    m_reusedViewport = incremental ? GetReusedViewport(params) : m2::RectD();
+
+    InitGeocoder(geocoderParams, params);
+    InitPreRanker(geocoderParams, params);
+    InitRanker(geocoderParams, params);
+    InitEmitter(params);
+  }
+
+  if (m_reusedViewport.IsValid())
+    EmitReusedViewportResults();
 
   try
   {
+    QueryStats::ScopedTimer timer(params.m_stats.get(), QueryStats::Phase::Geocoding);
+    base::ProfilerZone geocodingZone("Geocoding", "search");
     switch (params.m_mode)
     {
     case Mode::Everywhere:  // fallthrough
@@ -451,11 +484,96 @@ void Processor::Search(SearchParams const & params)
     LOG(LDEBUG, ("Search has been cancelled."));
   }
 
+  if (!base::Cancellable::IsCancelled() && IsCancelled())
+  {
+    // Candidates found by the deadline are ranked without further checks of the deadline.
+    LOG(LDEBUG, ("Search deadline is exceeded."));
+    m_deadlineExceeded = true;
+    m_deadline = chrono::steady_clock::time_point::max();
+  }
+
   if (!viewportSearch && !IsCancelled())
     SendStatistics(params, viewport, m_emitter.GetResults());
 
   // Emit finish marker to client.
   m_geocoder.Finish(IsCancelled());
+
+  // Results of an interrupted search are incomplete, the cached ones are still valid after it.
+  if (incremental && !IsCancelled() && !m_deadlineExceeded)
+    UpdateViewportResultsCache(params);
+}
+
+m2::RectD Processor::GetReusedViewport(SearchParams const & params) const
+{
+  auto const & cache = m_viewportResultsCache;
+  if (!cache.m_viewport.IsValid() || !HaveSameResults(cache.m_params, params))
+    return {};
+
+  auto const & viewport = GetViewport();
+  m2::RectD common = viewport;
+  if (!common.Intersect(cache.m_viewport))
+    return {};
+
+  double const commonArea = GetArea(common);
+  if (commonArea < kMinReusedViewportPart * GetArea(viewport) ||
+      commonArea < kMinReusedViewportPart * GetArea(cache.m_viewport))
+  {
+    return {};
+  }
+
+  return cache.m_viewport;
+}
+
+void Processor::EmitReusedViewportResults()
+{
+  auto const & viewport = GetViewport();
+  auto const pivot = GetPivotPoint(true /* viewportSearch */);
+
+  vector<pair<double, Result const *>> results;
+  for (auto const & result : m_viewportResultsCache.m_results)
+  {
+    auto const center = result.GetFeatureCenter();
+    if (viewport.IsPointInside(center))
+      results.emplace_back(PointDistance(center, pivot), &result);
+  }
+
+  if (results.empty())
+    return;
+
+  // Viewport results are sorted by the distance to the pivot, see Ranker::UpdateResults().
+  sort(results.begin(), results.end(), base::LessBy(&pair<double, Result const *>::first));
+  for (auto const & result : results)
+  {
+    auto copy = *result.second;
+    m_emitter.AddResultNoChecks(move(copy));
+  }
+  m_emitter.Emit();
+}
+
+void Processor::UpdateViewportResultsCache(SearchParams const & params)
+{
+  auto & cache = m_viewportResultsCache;
+  auto const & results = m_emitter.GetResults();
+
+  // When the limit is reached, results which are far from the pivot may be missed.
+  if (results.GetCount() >= params.m_maxNumResults)
+  {
+    cache.Clear();
+    return;
+  }
+
+  cache.m_params = params;
+  // The cache must not keep the callbacks and their captures alive.
+  cache.m_params.m_onStarted = nullptr;
+  cache.m_params.m_onResults = nullptr;
+  cache.m_params.m_stats.reset();
+  cache.m_viewport = GetViewport();
+  cache.m_results.clear();
+  for (auto const & result : results)
+  {
+    if (result.GetResultType() == Result::Type::Feature)
+      cache.m_results.push_back(result);
+  }
 }
 
 void Processor::SearchCoordinates()
@@ -559,12 +677,14 @@ void Processor::InitGeocoder(Geocoder::Params & geocoderParams, SearchParams con
 
   geocoderParams.m_mode = searchParams.m_mode;
   geocoderParams.m_pivot = GetPivotRect(viewportSearch);
+  geocoderParams.m_processedPivot = m_reusedViewport;
   geocoderParams.m_position = GetPosition();
   geocoderParams.m_categoryLocales = GetCategoryLocales();
   geocoderParams.m_hotelsFilter = searchParams.m_hotelsFilter;
   geocoderParams.m_cuisineTypes = m_cuisineTypes;
   geocoderParams.m_preferredTypes = m_preferredTypes;
   geocoderParams.m_tracer = searchParams.m_tracer;
+  geocoderParams.m_stats = searchParams.m_stats;
 
   m_geocoder.SetParams(geocoderParams);
 }
@@ -580,12 +700,17 @@ void Processor::InitPreRanker(Geocoder::Params const & geocoderParams,
     params.m_minDistanceOnMapBetweenResults = searchParams.m_minDistanceOnMapBetweenResults;
 
   params.m_viewport = GetViewport();
+  if (viewportSearch)
+    params.m_processedViewport = m_reusedViewport;
   params.m_accuratePivotCenter = GetPivotPoint(viewportSearch);
   params.m_position = GetPosition();
   params.m_scale = geocoderParams.GetScale();
   params.m_limit = max(kPreResultsCount, searchParams.m_maxNumResults);
   params.m_viewportSearch = viewportSearch;
   params.m_categorialRequest = geocoderParams.IsCategorialRequest();
+  if (!viewportSearch)
+    params.m_numProvisionalResults = searchParams.m_numProvisionalResults;
+  params.m_stats = geocoderParams.m_stats;
 
   m_preRanker.Init(params);
 }
@@ -631,5 +756,6 @@ void Processor::ClearCaches()
   m_preRanker.ClearCaches();
   m_ranker.ClearCaches();
   m_viewport.MakeEmpty();
+  m_viewportResultsCache.Clear();
 }
 }  // namespace search
@@ -26,8 +26,10 @@
 #include "base/cancellable.hpp"
 #include "base/string_utils.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -63,18 +65,29 @@ public:
   static double const kMaxViewportRadiusM;
 
   Processor(DataSource const & dataSource, CategoriesHolder const & categories,
-            std::vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter);
+            SuggestsIndex const & suggests, storage::CountryInfoGetter const & infoGetter);
 
   void SetViewport(m2::RectD const & viewport);
   void SetPreferredLocale(std::string const & locale);
   void SetInputLocale(std::string const & locale);
   void SetQuery(std::string const & query);
   inline void SetPosition(m2::PointD const & position) { m_position = position; }
+  void SetNumGeocoderThreads(size_t numThreads) { m_geocoder.SetNumThreads(numThreads); }
+  void SetTokenFeaturesCache(TokenFeaturesCache * cache) { m_geocoder.SetTokenFeaturesCache(cache); }
   inline std::string const & GetPivotRegion() const { return m_region; }
   inline m2::PointD const & GetPosition() const { return m_position; }
 
   inline bool IsEmptyQuery() const { return m_prefix.empty() && m_tokens.empty(); }
 
+  // Geocoding of the next query stops at |deadline|, see SearchParams::m_timeout.
+  void SetDeadline(std::chrono::steady_clock::time_point deadline) { m_deadline = deadline; }
+  // Returns true when the last query has been stopped by the deadline.
+  bool IsDeadlineExceeded() const { return m_deadlineExceeded; }
+
+  // base::Cancellable overrides:
+  void Reset() override;
+  bool IsCancelled() const override;
+
   void Search(SearchParams const & params);
 
   // Tries to generate a (lat, lon) result from |m_query|.
@@ -97,9 +110,7 @@ public:
   void LoadCitiesBoundaries();
   void LoadCountriesTree();
 
-  void OnBookmarksCreated(std::vector<std::pair<bookmarks::Id, bookmarks::Doc>> const & marks);
-  void OnBookmarksUpdated(std::vector<std::pair<bookmarks::Id, bookmarks::Doc>> const & marks);
-  void OnBookmarksDeleted(std::vector<bookmarks::Id> const & marks);
+  void SetBookmarksSnapshot(std::shared_ptr<bookmarks::Snapshot const> snapshot);
 
 protected:
   Locales GetCategoryLocales() const;
@@ -115,6 +126,13 @@ protected:
 
   m2::RectD const & GetViewport() const;
 
+  // Returns the viewport of the cached results of the previous incremental viewport search if
+  // they may be reused by the search with |params|, and an empty rect otherwise.
+  m2::RectD GetReusedViewport(SearchParams const & params) const;
+  // Emits the cached results which are inside the current viewport.
+  void EmitReusedViewportResults();
+  void UpdateViewportResultsCache(SearchParams const & params);
+
   CategoriesHolder const & m_categories;
   storage::CountryInfoGetter const & m_infoGetter;
 
@@ -129,6 +147,26 @@ protected:
   m2::RectD m_viewport;
   m2::PointD m_position;
 
+  // Feature results of the last completed incremental viewport search with the params and
+  // the viewport they were found with, see SearchParams::m_incremental.
+  struct ViewportResultsCache
+  {
+    void Clear()
+    {
+      m_params = SearchParams();
+      m_viewport.MakeEmpty();
+      m_results.clear();
+    }
+
+    SearchParams m_params;
+    m2::RectD m_viewport;
+    std::vector<Result> m_results;
+  };
+
+  ViewportResultsCache m_viewportResultsCache;
+  // Viewport of the results reused by the current query, empty if the results are not reused.
+  m2::RectD m_reusedViewport;
+
   // Suggestions language code, not the same as we use in mwm data
   int8_t m_inputLocaleCode = StringUtf8Multilang::kUnsupportedLanguageCode;
   int8_t m_currentLocaleCode = StringUtf8Multilang::kUnsupportedLanguageCode;
@@ -143,5 +181,8 @@ protected:
   Geocoder m_geocoder;
 
   bookmarks::Processor m_bookmarksProcessor;
+
+  std::chrono::steady_clock::time_point m_deadline = std::chrono::steady_clock::time_point::max();
+  bool m_deadlineExceeded = false;
 };
 }  // namespace search
@@ -20,11 +20,16 @@
 
 #include "base/assert.hpp"
 
+#include "pyhelpers/scoped_gil_release.hpp"
+
 #include <boost/python.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -172,6 +177,35 @@ struct TraceResult
   bool m_isCategory = false;
 };
 
+struct QueryResults
+{
+  string ToString() const
+  {
+    ostringstream os;
+    os << "results: " << boost::python::len(m_results) << ", response_time: " << m_responseTime;
+    return os.str();
+  }
+
+  boost::python::list m_results;
+  // Time of processing of the query by the engine in seconds.
+  double m_responseTime = 0.0;
+};
+
+// A search request which is started and waited for separately, so several requests are
+// processed by the engine at the same time.
+class BatchSearchRequest : public search::tests_support::TestSearchRequest
+{
+public:
+  BatchSearchRequest(search::tests_support::TestSearchEngine & engine,
+                     search::SearchParams const & params)
+    : TestSearchRequest(engine, params)
+  {
+  }
+
+  using TestSearchRequest::Start;
+  using TestSearchRequest::Wait;
+};
+
 unique_ptr<storage::CountryInfoGetter> CreateCountryInfoGetter()
 {
   CHECK(g_affiliations.get(), ("init() was not called."));
@@ -183,7 +217,12 @@ unique_ptr<storage::CountryInfoGetter> CreateCountryInfoGetter()
 
 struct Context
 {
-  Context() : m_engine(m_dataSource, CreateCountryInfoGetter(), search::Engine::Params{}) {}
+  explicit Context(size_t numThreads)
+    : m_engine(m_dataSource, CreateCountryInfoGetter(),
+               search::Engine::Params("en" /* locale */, numThreads))
+  {
+  }
+
   // todo(@pimenov) Choose right type for 'm_dataSource'.
   FrozenDataSource m_dataSource;
   search::tests_support::TestSearchEngine m_engine;
@@ -191,7 +230,8 @@ struct Context
 
 struct SearchEngineProxy
 {
-  SearchEngineProxy() : m_context(make_shared<Context>())
+  explicit SearchEngineProxy(size_t numThreads = 1)
+    : m_context(make_shared<Context>(max(numThreads, size_t(1))))
   {
     vector<platform::LocalCountryFile> mwms;
     platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max() /* the latest version */,
@@ -231,6 +271,63 @@ struct SearchEngineProxy
     return results;
   }
 
+  // Runs all the |params| on the threads of the engine with the GIL released and returns a list
+  // of QueryResults in the order of |params|.
+  boost::python::list SearchMany(boost::python::list const & params) const
+  {
+    vector<Params> queries;
+    auto const n = boost::python::len(params);
+    queries.reserve(static_cast<size_t>(n));
+    for (decltype(boost::python::len(params)) i = 0; i < n; ++i)
+      queries.push_back(boost::python::extract<Params>(params[i]));
+
+    vector<unique_ptr<BatchSearchRequest>> requests(queries.size());
+    {
+      scoped_gil_release const release;
+
+      // The preferred locale is common for all the processors of the engine, so queries are
+      // grouped by locales and a group is started when the previous one is finished.
+      vector<size_t> order(queries.size());
+      iota(order.begin(), order.end(), 0);
+      stable_sort(order.begin(), order.end(), [&queries](size_t lhs, size_t rhs) {
+        return queries[lhs].m_locale < queries[rhs].m_locale;
+      });
+
+      size_t begin = 0;
+      while (begin < order.size())
+      {
+        auto const & locale = queries[order[begin]].m_locale;
+        size_t end = begin;
+        while (end < order.size() && queries[order[end]].m_locale == locale)
+          ++end;
+
+        m_context->m_engine.SetLocale(locale);
+        for (size_t i = begin; i < end; ++i)
+        {
+          auto & request = requests[order[i]];
+          request = make_unique<BatchSearchRequest>(m_context->m_engine,
+                                                    MakeSearchParams(queries[order[i]]));
+          request->Start();
+        }
+        for (size_t i = begin; i < end; ++i)
+          requests[order[i]]->Wait();
+
+        begin = end;
+      }
+    }
+
+    boost::python::list results;
+    for (auto const & request : requests)
+    {
+      QueryResults qr;
+      for (auto const & result : request->Results())
+        qr.m_results.append(Result(result));
+      qr.m_responseTime = chrono::duration<double>(request->ResponseTime()).count();
+      results.append(qr);
+    }
+    return results;
+  }
+
   boost::python::list Trace(Params const &params) const
   {
     m_context->m_engine.SetLocale(params.m_locale);
@@ -300,7 +397,13 @@ BOOST_PYTHON_MODULE(pysearch)
       .def_readwrite("is_category", &TraceResult::m_isCategory)
       .def("__repr__", &TraceResult::ToString);
 
-  class_<SearchEngineProxy>("SearchEngine")
+  class_<QueryResults>("QueryResults")
+      .def_readwrite("results", &QueryResults::m_results)
+      .def_readwrite("response_time", &QueryResults::m_responseTime)
+      .def("__repr__", &QueryResults::ToString);
+
+  class_<SearchEngineProxy>("SearchEngine", init<optional<size_t>>())
       .def("query", &SearchEngineProxy::Query)
+      .def("search_many", &SearchEngineProxy::SearchMany)
       .def("trace", &SearchEngineProxy::Trace);
 }
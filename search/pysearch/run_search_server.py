@@ -15,7 +15,52 @@ MWM_PATH = os.path.realpath(os.path.join(DIR, '..', '..', 'data'))
 PORT=8080
 
 
+def result_to_json(result):
+    return {'name': result.name,
+            'address': result.address,
+            'has_center': result.has_center,
+            'center': {'x': result.center.x,
+                       'y': result.center.y
+                      }
+           }
+
+
+def params_from_json(query):
+    params = pysearch.Params()
+    params.query = query['query']
+    params.locale = query['locale']
+    params.position = pysearch.Mercator(float(query['posx']), float(query['posy']))
+    params.viewport = pysearch.Viewport(
+        pysearch.Mercator(float(query['minx']), float(query['miny'])),
+        pysearch.Mercator(float(query['maxx']), float(query['maxy'])))
+    return params
+
+
 class HTTPHandler(BaseHTTPRequestHandler):
+    # Body of a request is a JSON list of queries with the same fields as the GET
+    # parameters. Queries are processed concurrently by all the threads of the engine.
+    def do_POST(self):
+        if urlparse.urlparse(self.path).path != '/search_many':
+            self.send_response(404)
+            return
+
+        try:
+            length = int(self.headers.getheader('Content-Length', 0))
+            queries = json.loads(self.rfile.read(length))
+            params = [params_from_json(query) for query in queries]
+        except (KeyError, TypeError, ValueError):
+            self.send_response(400)
+            return
+
+        responses = [{'results': [result_to_json(result) for result in qr.results],
+                      'response_time': qr.response_time}
+                     for qr in HTTPHandler.engine.search_many(params)]
+
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        json.dump(responses, self.wfile)
+
     def do_GET(self):
         result = urlparse.urlparse(self.path)
         query = urlparse.parse_qs(result.query)
@@ -40,14 +85,7 @@ class HTTPHandler(BaseHTTPRequestHandler):
 
         results = HTTPHandler.engine.query(params)
 
-        responses = [{'name': result.name,
-                      'address': result.address,
-                      'has_center': result.has_center,
-                      'center': {'x': result.center.x,
-                                 'y': result.center.y
-                                }
-                     }
-                     for result in results]
+        responses = [result_to_json(result) for result in results]
 
         self.send_response(200)
         self.send_header("Content-Type", "application/json")
@@ -57,8 +95,7 @@ class HTTPHandler(BaseHTTPRequestHandler):
 
 def main(args):
     pysearch.init(args.r, args.m)
-    engine = pysearch.SearchEngine()
-    HTTPHandler.engine = pysearch.SearchEngine()
+    HTTPHandler.engine = pysearch.SearchEngine(args.t)
 
     print('Starting HTTP server on port', PORT)
     server = HTTPServer(('', args.p), HTTPHandler)
@@ -74,6 +111,8 @@ if __name__ == '__main__':
                         help='Path to mwm files.')
     parser.add_argument('-p', metavar='PORT', default=PORT,
                         help='Port for the server to listen')
+    parser.add_argument('-t', metavar='THREADS', type=int, default=1,
+                        help='Number of search threads')
     args = parser.parse_args()
 
     main(args)
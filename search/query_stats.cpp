@@ -0,0 +1,67 @@
+#include "search/query_stats.hpp"
+
+#include "base/assert.hpp"
+
+using namespace std;
+
+namespace search
+{
+// QueryStats::ScopedTimer -------------------------------------------------------------------------
+QueryStats::ScopedTimer::ScopedTimer(QueryStats * stats, Phase phase)
+  : m_stats(stats), m_phase(phase), m_timer(stats != nullptr /* start */)
+{
+  if (m_stats)
+    m_followingNs = m_stats->GetFollowingNs(m_phase);
+}
+
+QueryStats::ScopedTimer::~ScopedTimer()
+{
+  if (!m_stats)
+    return;
+
+  uint64_t const elapsedNs = m_timer.ElapsedNano();
+  uint64_t const followingNs = m_stats->GetFollowingNs(m_phase) - m_followingNs;
+  m_stats->Add(m_phase, elapsedNs > followingNs ? elapsedNs - followingNs : 0);
+}
+
+// QueryStats --------------------------------------------------------------------------------------
+QueryStats::QueryStats()
+{
+  for (auto & ns : m_ns)
+    ns = 0;
+}
+
+void QueryStats::Add(Phase phase, uint64_t ns)
+{
+  ASSERT_LESS(phase, Phase::Count, ());
+  m_ns[static_cast<size_t>(phase)].fetch_add(ns, memory_order_relaxed);
+}
+
+uint64_t QueryStats::GetNs(Phase phase) const
+{
+  ASSERT_LESS(phase, Phase::Count, ());
+  return m_ns[static_cast<size_t>(phase)].load(memory_order_relaxed);
+}
+
+uint64_t QueryStats::GetFollowingNs(Phase phase) const
+{
+  uint64_t ns = 0;
+  for (size_t i = static_cast<size_t>(phase) + 1; i < m_ns.size(); ++i)
+    ns += m_ns[i].load(memory_order_relaxed);
+  return ns;
+}
+
+string DebugPrint(QueryStats::Phase phase)
+{
+  switch (phase)
+  {
+  case QueryStats::Phase::Tokenization: return "Tokenization";
+  case QueryStats::Phase::Retrieval: return "Retrieval";
+  case QueryStats::Phase::Geocoding: return "Geocoding";
+  case QueryStats::Phase::PreRanking: return "PreRanking";
+  case QueryStats::Phase::Ranking: return "Ranking";
+  case QueryStats::Phase::Count: return "Count";
+  }
+  CHECK_SWITCH();
+}
+}  // namespace search
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/timer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace search
+{
+// Times spent by a query in the stages of the search pipeline. It's filled by the
+// processor, geocoders and rankers of the query and may be updated from several
+// geocoder threads at the same time.
+class QueryStats
+{
+public:
+  // The stages are listed in the order they call each other: the time of a phase
+  // doesn't include the time of the following phases spent during it, i.e. Geocoding
+  // doesn't include PreRanking and Ranking, PreRanking doesn't include Ranking.
+  // Retrieval time is included in Geocoding and is summed over all geocoder threads.
+  enum class Phase
+  {
+    Tokenization,
+    Retrieval,
+    Geocoding,
+    PreRanking,
+    Ranking,
+    Count
+  };
+
+  // Adds the time elapsed during its lifetime to |phase| of |stats|. Does nothing when
+  // |stats| is nullptr.
+  class ScopedTimer
+  {
+  public:
+    ScopedTimer(QueryStats * stats, Phase phase);
+    ~ScopedTimer();
+
+  private:
+    QueryStats * m_stats;
+    Phase const m_phase;
+    uint64_t m_followingNs = 0;
+    base::HighResTimer m_timer;
+
+    DISALLOW_COPY_AND_MOVE(ScopedTimer);
+  };
+
+  QueryStats();
+
+  void Add(Phase phase, uint64_t ns);
+
+  uint64_t GetNs(Phase phase) const;
+
+private:
+  // Returns the total time of the phases following |phase|.
+  uint64_t GetFollowingNs(Phase phase) const;
+
+  std::array<std::atomic<uint64_t>, static_cast<size_t>(Phase::Count)> m_ns;
+};
+
+std::string DebugPrint(QueryStats::Phase phase);
+}  // namespace search
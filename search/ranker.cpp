@@ -5,6 +5,7 @@
 #include "search/highlighting.hpp"
 #include "search/model.hpp"
 #include "search/pre_ranking_info.hpp"
+#include "search/query_stats.hpp"
 #include "search/ranking_utils.hpp"
 #include "search/token_slice.hpp"
 #include "search/utils.hpp"
@@ -21,6 +22,7 @@
 #include "coding/multilang_utf8_string.hpp"
 
 #include "base/logging.hpp"
+#include "base/profiler.hpp"
 #include "base/string_utils.hpp"
 
 #include <algorithm>
@@ -375,7 +377,7 @@ public:
 Ranker::Ranker(DataSource const & dataSource, CitiesBoundariesTable const & boundariesTable,
                storage::CountryInfoGetter const & infoGetter, KeywordLangMatcher & keywordsScorer,
                Emitter & emitter, CategoriesHolder const & categories,
-               vector<Suggest> const & suggests, VillagesCache & villagesCache,
+               SuggestsIndex const & suggests, VillagesCache & villagesCache,
                base::Cancellable const & cancellable)
   : m_reverseGeocoder(dataSource)
   , m_cancellable(cancellable)
@@ -477,10 +479,12 @@ void Ranker::SuggestStrings()
 
 void Ranker::UpdateResults(bool lastUpdate)
 {
+  QueryStats::ScopedTimer timer(m_geocoderParams.m_stats.get(), QueryStats::Phase::Ranking);
+  base::ProfilerZone zone("Rank", "search");
   if (!lastUpdate)
     BailIfCancelled();
 
-  MakeRankerResults(m_geocoderParams, m_tentativeResults);
+  MakeRankerResults(m_geocoderParams, m_preRankerResults, m_tentativeResults);
   RemoveDuplicatingLinear(m_tentativeResults);
   if (m_tentativeResults.empty())
     return;
@@ -542,6 +546,33 @@ void Ranker::UpdateResults(bool lastUpdate)
   }
 }
 
+void Ranker::EmitProvisionalResults(vector<PreRankerResult> const & preRankerResults,
+                                    size_t limit)
+{
+  QueryStats::ScopedTimer timer(m_geocoderParams.m_stats.get(), QueryStats::Phase::Ranking);
+  BailIfCancelled();
+
+  vector<RankerResult> rankerResults;
+  MakeRankerResults(m_geocoderParams, preRankerResults, rankerResults);
+  RemoveDuplicatingLinear(rankerResults);
+  sort(rankerResults.rbegin(), rankerResults.rend(),
+       base::LessBy(&RankerResult::GetLinearModelRank));
+
+  Results results;
+  results.SetProvisional(true);
+  for (auto const & rankerResult : rankerResults)
+  {
+    if (results.GetCount() >= min(limit, m_params.m_limit))
+      break;
+    BailIfCancelled();
+    results.AddResult(
+        MakeResult(rankerResult, m_params.m_needAddress, m_params.m_needHighlighting));
+  }
+
+  if (results.GetCount() != 0)
+    m_emitter.EmitProvisional(results);
+}
+
 void Ranker::ClearCaches() { m_localities.ClearCache(); }
 
 void Ranker::SetLocale(string const & locale)
@@ -553,10 +584,11 @@ void Ranker::SetLocale(string const & locale)
 void Ranker::LoadCountriesTree() { m_regionInfoGetter.LoadCountriesTree(); }
 
 void Ranker::MakeRankerResults(Geocoder::Params const & geocoderParams,
+                               vector<PreRankerResult> const & preRankerResults,
                                vector<RankerResult> & results)
 {
   RankerResultMaker maker(*this, m_dataSource, m_infoGetter, geocoderParams);
-  for (auto const & r : m_preRankerResults)
+  for (auto const & r : preRankerResults)
   {
     auto p = maker(r);
     if (!p)
@@ -603,20 +635,12 @@ void Ranker::GetBestMatchName(FeatureType & f, string & name) const
 void Ranker::MatchForSuggestions(strings::UniString const & token, int8_t locale,
                                  string const & prologue)
 {
-  for (auto const & suggest : m_suggests)
-  {
-    strings::UniString const & s = suggest.m_name;
-    if (suggest.m_prefixLength <= token.size()
-        && token != s                  // do not push suggestion if it already equals to token
-        && suggest.m_locale == locale  // push suggestions only for needed language
-        && strings::StartsWith(s, token))
-    {
-      string const utf8Str = strings::ToUtf8(s);
-      Result r(utf8Str, prologue + utf8Str + " ");
-      HighlightResult(m_params.m_tokens, m_params.m_prefix, r);
-      m_emitter.AddResult(move(r));
-    }
-  }
+  m_suggests.ForEachCompletion(token, locale, [&](Suggest const & suggest) {
+    string const utf8Str = strings::ToUtf8(suggest.m_name);
+    Result r(utf8Str, prologue + utf8Str + " ");
+    HighlightResult(m_params.m_tokens, m_params.m_prefix, r);
+    m_emitter.AddResult(move(r));
+  });
 }
 
 void Ranker::ProcessSuggestions(vector<RankerResult> & vec) const
@@ -81,7 +81,7 @@ public:
   Ranker(DataSource const & dataSource, CitiesBoundariesTable const & boundariesTable,
          storage::CountryInfoGetter const & infoGetter, KeywordLangMatcher & keywordsScorer,
          Emitter & emitter, CategoriesHolder const & categories,
-         std::vector<Suggest> const & suggests, VillagesCache & villagesCache,
+         SuggestsIndex const & suggests, VillagesCache & villagesCache,
          base::Cancellable const & cancellable);
   virtual ~Ranker() = default;
 
@@ -103,6 +103,11 @@ public:
 
   virtual void UpdateResults(bool lastUpdate);
 
+  // Ranks |preRankerResults| and emits the best |limit| of them as provisional results,
+  // see Results::IsProvisional(). Results accumulated by the emitter are not changed.
+  void EmitProvisionalResults(std::vector<PreRankerResult> const & preRankerResults,
+                              size_t limit);
+
   void ClearCaches();
 
   void BailIfCancelled() { ::search::BailIfCancelled(m_cancellable); }
@@ -114,7 +119,9 @@ public:
 private:
   friend class RankerResultMaker;
 
-  void MakeRankerResults(Geocoder::Params const & params, std::vector<RankerResult> & results);
+  void MakeRankerResults(Geocoder::Params const & params,
+                         std::vector<PreRankerResult> const & preRankerResults,
+                         std::vector<RankerResult> & results);
 
   void GetBestMatchName(FeatureType & f, std::string & name) const;
   void MatchForSuggestions(strings::UniString const & token, int8_t locale,
@@ -137,7 +144,7 @@ private:
   storage::CountryInfoGetter const & m_infoGetter;
   Emitter & m_emitter;
   CategoriesHolder const & m_categories;
-  std::vector<Suggest> const & m_suggests;
+  SuggestsIndex const & m_suggests;
 
   std::vector<PreRankerResult> m_preRankerResults;
   std::vector<RankerResult> m_tentativeResults;
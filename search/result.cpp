@@ -252,6 +252,7 @@ void Results::Clear()
   m_results.clear();
   m_bookmarksResults.clear();
   m_status = Status::None;
+  m_provisional = false;
   m_hotelsClassif.Clear();
 }
 
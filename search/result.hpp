@@ -184,6 +184,12 @@ public:
     m_status = cancelled ? Status::EndedCancelled : Status::EndedNormal;
   }
 
+  // Provisional results are the preliminary top of the results, emitted before the results
+  // near the pivot are ranked. They aren't followed by the end marker and must be replaced
+  // by the results of the next call of OnResults.
+  bool IsProvisional() const { return m_provisional; }
+  void SetProvisional(bool provisional) { m_provisional = provisional; }
+
   bool AddResult(Result && result);
 
   // Fast version of AddResult() that doesn't do any checks for
@@ -247,6 +253,7 @@ private:
   std::vector<Result> m_results;
   bookmarks::Results m_bookmarksResults;
   Status m_status;
+  bool m_provisional;
   HotelsClassifier m_hotelsClassif;
 };
 
@@ -6,6 +6,7 @@
 #include "search/mwm_context.hpp"
 #include "search/search_index_values.hpp"
 #include "search/search_trie.hpp"
+#include "search/token_features_cache.hpp"
 #include "search/token_slice.hpp"
 
 #include "indexer/classificator.hpp"
@@ -21,6 +22,7 @@
 #include "platform/mwm_version.hpp"
 
 #include "coding/compressed_bit_vector.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader_wrapper.hpp"
 
 #include "base/checked_cast.hpp"
@@ -73,6 +75,8 @@ public:
     m_created = editor.GetFeaturesByStatus(id, FeatureStatus::Created);
   }
 
+  bool HasEdits() const { return !m_deleted.empty() || !m_modified.empty() || !m_created.empty(); }
+
   bool ModifiedOrDeleted(uint32_t featureIndex) const
   {
     return binary_search(m_deleted.begin(), m_deleted.end(), featureIndex) ||
@@ -196,10 +200,10 @@ bool MatchFeatureByPostcode(FeatureType & ft, TokenSlice const & slice)
   return true;
 }
 
-template <typename Value, typename DFA>
+template <typename Value, typename Root, typename DFA>
 unique_ptr<coding::CompressedBitVector> RetrieveAddressFeaturesImpl(
-    Retrieval::TrieRoot<Value> const & root, MwmContext const & context,
-    base::Cancellable const & cancellable, SearchTrieRequest<DFA> const & request)
+    Root const & root, MwmContext const & context, base::Cancellable const & cancellable,
+    SearchTrieRequest<DFA> const & request)
 {
   EditedFeaturesHolder holder(context.GetId());
   vector<uint64_t> features;
@@ -220,10 +224,10 @@ unique_ptr<coding::CompressedBitVector> RetrieveAddressFeaturesImpl(
   return SortFeaturesAndBuildCBV(move(features));
 }
 
-template <typename Value>
+template <typename Value, typename Root>
 unique_ptr<coding::CompressedBitVector> RetrievePostcodeFeaturesImpl(
-    Retrieval::TrieRoot<Value> const & root, MwmContext const & context,
-    base::Cancellable const & cancellable, TokenSlice const & slice)
+    Root const & root, MwmContext const & context, base::Cancellable const & cancellable,
+    TokenSlice const & slice)
 {
   EditedFeaturesHolder holder(context.GetId());
   vector<uint64_t> features;
@@ -244,6 +248,57 @@ unique_ptr<coding::CompressedBitVector> RetrievePostcodeFeaturesImpl(
   return SortFeaturesAndBuildCBV(move(features));
 }
 
+// Retrieves features matching |request| from the search index without edits of the editor.
+template <typename Value, typename Root, typename DFA>
+unique_ptr<coding::CompressedBitVector> RetrieveIndexAddressFeaturesImpl(
+    Root const & root, MwmContext const & /* context */, base::Cancellable const & cancellable,
+    SearchTrieRequest<DFA> const & request)
+{
+  vector<uint64_t> features;
+  FeaturesCollector collector(cancellable, features);
+  MatchFeaturesInTrie(request, root, [](Value const & /* value */) { return true; } /* filter */,
+                      collector);
+  return SortFeaturesAndBuildCBV(move(features));
+}
+
+// Retrieves postcodes matching |slice| from the search index without edits of the editor.
+template <typename Value, typename Root>
+unique_ptr<coding::CompressedBitVector> RetrieveIndexPostcodeFeaturesImpl(
+    Root const & root, MwmContext const & /* context */, base::Cancellable const & cancellable,
+    TokenSlice const & slice)
+{
+  vector<uint64_t> features;
+  FeaturesCollector collector(cancellable, features);
+  MatchPostcodesInTrie(slice, root, [](Value const & /* value */) { return true; } /* filter */,
+                       collector);
+  return SortFeaturesAndBuildCBV(move(features));
+}
+
+// Applies edits of the editor to |indexFeatures| retrieved from the search index.
+// |matches| checks whether an edited feature matches the request.
+template <typename Matches>
+unique_ptr<coding::CompressedBitVector> ApplyEdits(MwmContext const & context,
+                                                   coding::CompressedBitVector const & indexFeatures,
+                                                   Matches && matches)
+{
+  EditedFeaturesHolder holder(context.GetId());
+  if (!holder.HasEdits())
+    return indexFeatures.Clone();
+
+  vector<uint64_t> features;
+  coding::CompressedBitVectorEnumerator::ForEach(indexFeatures, [&](uint64_t index) {
+    if (!holder.ModifiedOrDeleted(base::asserted_cast<uint32_t>(index)))
+      features.push_back(index);
+  });
+
+  holder.ForEachModifiedOrCreated([&](FeatureType & ft, uint64_t index) {
+    if (matches(ft))
+      features.push_back(index);
+  });
+
+  return SortFeaturesAndBuildCBV(move(features));
+}
+
 unique_ptr<coding::CompressedBitVector> RetrieveGeometryFeaturesImpl(
     MwmContext const & context, base::Cancellable const & cancellable, m2::RectD const & rect,
     int scale)
@@ -287,6 +342,26 @@ struct RetrievePostcodeFeaturesAdaptor
   }
 };
 
+template <typename T>
+struct RetrieveIndexAddressFeaturesAdaptor
+{
+  template <typename... Args>
+  unique_ptr<coding::CompressedBitVector> operator()(Args &&... args)
+  {
+    return RetrieveIndexAddressFeaturesImpl<T>(forward<Args>(args)...);
+  }
+};
+
+template <typename T>
+struct RetrieveIndexPostcodeFeaturesAdaptor
+{
+  template <typename... Args>
+  unique_ptr<coding::CompressedBitVector> operator()(Args &&... args)
+  {
+    return RetrieveIndexPostcodeFeaturesImpl<T>(forward<Args>(args)...);
+  }
+};
+
 template <typename Value>
 unique_ptr<Retrieval::TrieRoot<Value>> ReadTrie(MwmValue & value, ModelReaderPtr & reader)
 {
@@ -302,6 +377,9 @@ Retrieval::Retrieval(MwmContext const & context, base::Cancellable const & cance
   , m_cancellable(cancellable)
   , m_reader(context.m_value.m_cont.GetReader(SEARCH_INDEX_FILE_TAG))
 {
+  // Tries are read by lookups from the root, so readahead of the section doesn't help.
+  m_reader.Advise(ModelReader::Advice::Random);
+
   auto & value = context.m_value;
 
   version::MwmTraits mwmTraits(value.GetMwmVersion());
@@ -313,11 +391,38 @@ Retrieval::Retrieval(MwmContext const & context, base::Cancellable const & cance
     m_root0 = ReadTrie<FeatureWithRankAndCenter>(value, m_reader);
     break;
   case version::MwmTraits::SearchIndexFormat::CompressedBitVector:
-    m_root1 = ReadTrie<FeatureIndexValue>(value, m_reader);
+    if (SearchIndexHeader::Read(m_reader) == SearchIndexVersion::V1)
+      m_packedRoot = ReadPackedTrie();
+    else
+      m_root1 = ReadTrie<FeatureIndexValue>(value, m_reader);
     break;
   }
 }
 
+unique_ptr<Retrieval::PackedTrieRoot> Retrieval::ReadPackedTrie()
+{
+  uint64_t const size = m_reader.Size();
+  CHECK_GREATER_OR_EQUAL(size, SearchIndexHeader::kSize, ());
+
+  // The packed trie is traversed in place, so it's taken from the mapping of the mwm when
+  // there is one and is copied to memory otherwise.
+  uint8_t const * data = nullptr;
+  if (auto const * mmapReader = dynamic_cast<MmapReader const *>(m_reader.GetPtr()))
+  {
+    data = mmapReader->Data();
+  }
+  else
+  {
+    m_packedTrieData.resize(base::checked_cast<size_t>(size));
+    m_reader.Read(0 /* pos */, m_packedTrieData.data(), m_packedTrieData.size());
+    data = m_packedTrieData.data();
+  }
+
+  return make_unique<PackedTrieRoot>(trie::ReadPackedTrie<ValueList<FeatureIndexValue>>(
+      data + SearchIndexHeader::kSize, static_cast<size_t>(size - SearchIndexHeader::kSize),
+      SingleValueSerializer<FeatureIndexValue>()));
+}
+
 unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveAddressFeatures(
     SearchTrieRequest<UniStringDFA> const & request) const
 {
@@ -348,6 +453,31 @@ unique_ptr<coding::CompressedBitVector> Retrieval::RetrievePostcodeFeatures(
   return Retrieve<RetrievePostcodeFeaturesAdaptor>(slice);
 }
 
+unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveAddressFeatures(
+    SearchTrieRequest<LevenshteinDFA> const & request, TokenFeaturesCache & cache,
+    string const & key) const
+{
+  return RetrieveCached<RetrieveIndexAddressFeaturesAdaptor>(
+      cache, key, [&request](FeatureType & ft) { return MatchFeatureByNameAndType(ft, request); },
+      request);
+}
+
+unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveAddressFeatures(
+    SearchTrieRequest<PrefixDFAModifier<LevenshteinDFA>> const & request,
+    TokenFeaturesCache & cache, string const & key) const
+{
+  return RetrieveCached<RetrieveIndexAddressFeaturesAdaptor>(
+      cache, key, [&request](FeatureType & ft) { return MatchFeatureByNameAndType(ft, request); },
+      request);
+}
+
+unique_ptr<coding::CompressedBitVector> Retrieval::RetrievePostcodeFeatures(
+    TokenSlice const & slice, TokenFeaturesCache & cache, string const & key) const
+{
+  return RetrieveCached<RetrieveIndexPostcodeFeaturesAdaptor>(
+      cache, key, [&slice](FeatureType & ft) { return MatchFeatureByPostcode(ft, slice); }, slice);
+}
+
 unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveGeometryFeatures(m2::RectD const & rect,
                                                                             int scale) const
 {
@@ -368,10 +498,29 @@ unique_ptr<coding::CompressedBitVector> Retrieval::Retrieve(Args &&... args) con
   case version::MwmTraits::SearchIndexFormat::CompressedBitVector:
   {
     R<FeatureIndexValue> r;
+    if (m_packedRoot)
+      return r(*m_packedRoot, m_context, m_cancellable, forward<Args>(args)...);
     ASSERT(m_root1, ());
     return r(*m_root1, m_context, m_cancellable, forward<Args>(args)...);
   }
   }
   CHECK_SWITCH();
 }
+
+template <template <typename> class R, typename Matches, typename... Args>
+unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveCached(TokenFeaturesCache & cache,
+                                                                  string const & key,
+                                                                  Matches && matches,
+                                                                  Args &&... args) const
+{
+  auto const & id = m_context.GetId();
+  TokenFeaturesCache::Features indexFeatures = cache.Get(id, key);
+  if (!indexFeatures)
+  {
+    indexFeatures = Retrieve<R>(forward<Args>(args)...);
+    cache.Put(id, key, indexFeatures);
+  }
+
+  return ApplyEdits(m_context, *indexFeatures, forward<Matches>(matches));
+}
 }  // namespace search
@@ -13,7 +13,9 @@
 #include "base/dfa_helpers.hpp"
 #include "base/levenshtein_dfa.hpp"
 
+#include "std/string.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 class MwmValue;
 
@@ -25,6 +27,7 @@ class CompressedBitVector;
 namespace search
 {
 class MwmContext;
+class TokenFeaturesCache;
 class TokenSlice;
 
 class Retrieval
@@ -32,6 +35,8 @@ class Retrieval
 public:
   template<typename Value>
   using TrieRoot = trie::Iterator<ValueList<Value>>;
+  using PackedTrieRoot = trie::PackedTrieIterator<ValueList<FeatureIndexValue>,
+                                                  SingleValueSerializer<FeatureIndexValue>>;
 
   Retrieval(MwmContext const & context, base::Cancellable const & cancellable);
 
@@ -49,18 +54,40 @@ public:
   unique_ptr<coding::CompressedBitVector> RetrieveAddressFeatures(
       SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> const & request) const;
 
+  // The same as the corresponding functions above but features from the search index
+  // are taken from |cache| by |key| when possible. |key| should uniquely identify |request|
+  // in the mwm. Edits of the editor are applied on every call.
+  unique_ptr<coding::CompressedBitVector> RetrieveAddressFeatures(
+      SearchTrieRequest<strings::LevenshteinDFA> const & request, TokenFeaturesCache & cache,
+      string const & key) const;
+
+  unique_ptr<coding::CompressedBitVector> RetrieveAddressFeatures(
+      SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> const & request,
+      TokenFeaturesCache & cache, string const & key) const;
+
   // Retrieves from the search index corresponding to |value| all
   // postcodes matching to |slice|.
   unique_ptr<coding::CompressedBitVector> RetrievePostcodeFeatures(TokenSlice const & slice) const;
 
+  unique_ptr<coding::CompressedBitVector> RetrievePostcodeFeatures(TokenSlice const & slice,
+                                                                   TokenFeaturesCache & cache,
+                                                                   string const & key) const;
+
   // Retrieves from the geometry index corresponding to |value| all features belonging to |rect|.
   unique_ptr<coding::CompressedBitVector> RetrieveGeometryFeatures(m2::RectD const & rect,
                                                                    int scale) const;
 
 private:
+  unique_ptr<PackedTrieRoot> ReadPackedTrie();
+
   template <template <typename> class R, typename... Args>
   unique_ptr<coding::CompressedBitVector> Retrieve(Args &&... args) const;
 
+  template <template <typename> class R, typename Matches, typename... Args>
+  unique_ptr<coding::CompressedBitVector> RetrieveCached(TokenFeaturesCache & cache,
+                                                         string const & key, Matches && matches,
+                                                         Args &&... args) const;
+
   MwmContext const & m_context;
   base::Cancellable const & m_cancellable;
   ModelReaderPtr m_reader;
@@ -69,5 +96,9 @@ private:
 
   unique_ptr<TrieRoot<FeatureWithRankAndCenter>> m_root0;
   unique_ptr<TrieRoot<FeatureIndexValue>> m_root1;
+
+  // The search index section, when the packed trie is not read from the mapping of the mwm.
+  vector<uint8_t> m_packedTrieData;
+  unique_ptr<PackedTrieRoot> m_packedRoot;
 };
 }  // namespace search
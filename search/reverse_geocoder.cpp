@@ -11,9 +11,14 @@
 #include "indexer/search_string_utils.hpp"
 
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
+#include "std/cmath.hpp"
 #include "std/function.hpp"
 #include "std/limits.hpp"
+#include "std/numeric.hpp"
+
+#include <exception>
 
 namespace search
 {
@@ -23,6 +28,12 @@ size_t constexpr kSimilarityThresholdPercent = 10;
 int constexpr kQueryScale = scales::GetUpperScale();
 /// Max number of tries (nearest houses with housenumber) to check when getting point address.
 size_t constexpr kMaxNumTriesToApproxAddress = 10;
+/// Size of cells of the grid points of a batch are grouped by, about 1 km at the equator.
+double constexpr kBatchCellSizeMercator = 0.01;
+/// Max number of points in a group. Every building of a group is checked against all its points.
+size_t constexpr kMaxBatchGroupSize = 64;
+/// Max number of buildings which nearby streets are cached by a batch thread.
+size_t constexpr kMaxNumCachedStreets = 10000;
 
 using AppendStreet = function<void(FeatureType & ft)>;
 using FillStreets =
@@ -186,8 +197,127 @@ void ReverseGeocoder::GetNearbyAddress(m2::PointD const & center, Address & addr
   {
     // It's quite enough to analize nearest kMaxNumTriesToApproxAddress houses for the exact nearby address.
     // When we can't guarantee suitable address for the point with distant houses.
-    if (GetNearbyAddress(table, b, addr) || (++triesCount == kMaxNumTriesToApproxAddress))
+    if (GetNearbyAddress(table, b, nullptr /* streetsCache */, addr) ||
+        (++triesCount == kMaxNumTriesToApproxAddress))
+    {
       break;
+    }
+  }
+}
+
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & centers, size_t numThreads,
+                                         vector<Address> & addrs) const
+{
+  addrs.assign(centers.size(), Address());
+  if (centers.empty())
+    return;
+
+  auto const getCell = [&centers](size_t i) {
+    return make_pair(static_cast<int64_t>(floor(centers[i].x / kBatchCellSizeMercator)),
+                     static_cast<int64_t>(floor(centers[i].y / kBatchCellSizeMercator)));
+  };
+
+  vector<size_t> order(centers.size());
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(),
+              [&getCell](size_t lhs, size_t rhs) { return getCell(lhs) < getCell(rhs); });
+
+  // Ranges of |order| with points of the same cell.
+  vector<pair<size_t, size_t>> groups;
+  for (size_t begin = 0; begin < order.size();)
+  {
+    auto const cell = getCell(order[begin]);
+    size_t end = begin + 1;
+    while (end < order.size() && end - begin < kMaxBatchGroupSize && getCell(order[end]) == cell)
+      ++end;
+    groups.emplace_back(begin, end);
+    begin = end;
+  }
+
+  numThreads = max(static_cast<size_t>(1), min(numThreads, groups.size()));
+  vector<std::exception_ptr> exceptions(numThreads);
+
+  // Every thread geocodes a contiguous range of groups, so nearby groups share the caches.
+  auto const geocode = [&](size_t thread) {
+    try
+    {
+      BatchCache cache(m_dataSource);
+      size_t const begin = groups.size() * thread / numThreads;
+      size_t const end = groups.size() * (thread + 1) / numThreads;
+      for (size_t i = begin; i < end; ++i)
+      {
+        GetNearbyAddresses(centers, order.data() + groups[i].first,
+                           groups[i].second - groups[i].first, cache, addrs);
+      }
+    }
+    catch (...)
+    {
+      exceptions[thread] = std::current_exception();
+    }
+  };
+
+  {
+    vector<threads::SimpleThread> threads;
+    threads.reserve(numThreads - 1);
+    for (size_t i = 1; i < numThreads; ++i)
+      threads.emplace_back(geocode, i);
+    geocode(0);
+    for (auto & thread : threads)
+      thread.join();
+  }
+
+  for (auto const & e : exceptions)
+  {
+    if (e)
+      std::rethrow_exception(e);
+  }
+}
+
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & centers,
+                                         size_t const * indices, size_t numIndices,
+                                         BatchCache & cache, vector<Address> & addrs) const
+{
+  vector<m2::RectD> rects(numIndices);
+  m2::RectD rect;
+  for (size_t i = 0; i < numIndices; ++i)
+  {
+    rects[i] = GetLookupRect(centers[indices[i]], kLookupRadiusM);
+    rect.Add(rects[i]);
+  }
+
+  // Buildings of all points are collected in one pass over the union of lookup rects.
+  vector<vector<Building>> buildings(numIndices);
+  auto const addBuilding = [&](FeatureType & ft)
+  {
+    if (ft.GetHouseNumber().empty())
+      return;
+
+    m2::RectD const limitRect = ft.GetLimitRect(kQueryScale);
+    for (size_t i = 0; i < numIndices; ++i)
+    {
+      if (!rects[i].IsIntersect(limitRect))
+        continue;
+      double const distance = feature::GetMinDistanceMeters(ft, centers[indices[i]]);
+      buildings[i].push_back(FromFeature(ft, distance));
+    }
+  };
+  m_dataSource.ForEachInRect(addBuilding, rect, kQueryScale);
+
+  for (size_t i = 0; i < numIndices; ++i)
+  {
+    auto & bs = buildings[i];
+    sort(bs.begin(), bs.end(), base::LessBy(&Building::m_distanceMeters));
+
+    size_t triesCount = 0;
+    for (auto const & b : bs)
+    {
+      auto & table = cache.GetTable(b.m_id.m_mwmId);
+      if (GetNearbyAddress(table, b, &cache.m_streets, addrs[indices[i]]) ||
+          (++triesCount == kMaxNumTriesToApproxAddress))
+      {
+        break;
+      }
+    }
   }
 }
 
@@ -196,11 +326,12 @@ bool ReverseGeocoder::GetExactAddress(FeatureType & ft, Address & addr) const
   if (ft.GetHouseNumber().empty())
     return false;
   HouseTable table(m_dataSource);
-  return GetNearbyAddress(table, FromFeature(ft, 0.0 /* distMeters */), addr);
+  return GetNearbyAddress(table, FromFeature(ft, 0.0 /* distMeters */), nullptr /* streetsCache */,
+                          addr);
 }
 
 bool ReverseGeocoder::GetNearbyAddress(HouseTable & table, Building const & bld,
-                                       Address & addr) const
+                                       StreetsCache * streetsCache, Address & addr) const
 {
   string street;
   if (osm::Editor::Instance().GetEditedFeatureStreet(bld.m_id, street))
@@ -214,12 +345,29 @@ bool ReverseGeocoder::GetNearbyAddress(HouseTable & table, Building const & bld,
   if (!table.Get(bld.m_id, ind))
     return false;
 
-  vector<Street> streets;
-  GetNearbyStreets(bld.m_id.m_mwmId, bld.m_center, streets);
-  if (ind < streets.size())
+  vector<Street> localStreets;
+  vector<Street> const * streets = &localStreets;
+  if (streetsCache != nullptr)
+  {
+    auto it = streetsCache->find(bld.m_id);
+    if (it == streetsCache->end())
+    {
+      if (streetsCache->size() >= kMaxNumCachedStreets)
+        streetsCache->clear();
+      it = streetsCache->emplace(bld.m_id, vector<Street>()).first;
+      GetNearbyStreets(bld.m_id.m_mwmId, bld.m_center, it->second);
+    }
+    streets = &it->second;
+  }
+  else
+  {
+    GetNearbyStreets(bld.m_id.m_mwmId, bld.m_center, localStreets);
+  }
+
+  if (ind < streets->size())
   {
     addr.m_building = bld;
-    addr.m_street = streets[ind];
+    addr.m_street = (*streets)[ind];
     return true;
   }
   else
@@ -249,6 +397,14 @@ ReverseGeocoder::Building ReverseGeocoder::FromFeature(FeatureType & ft, double
   return { ft.GetID(), distMeters, ft.GetHouseNumber(), feature::GetCenter(ft) };
 }
 
+ReverseGeocoder::HouseTable & ReverseGeocoder::BatchCache::GetTable(MwmSet::MwmId const & id)
+{
+  auto it = m_tables.find(id);
+  if (it == m_tables.end())
+    it = m_tables.emplace(id, m_dataSource).first;
+  return it->second;
+}
+
 bool ReverseGeocoder::HouseTable::Get(FeatureID const & fid, uint32_t & streetIndex)
 {
   if (!m_table || m_handle.GetId() != fid.m_mwmId)
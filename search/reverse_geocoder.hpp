@@ -6,6 +6,7 @@
 
 #include "base/string_utils.hpp"
 
+#include "std/map.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -94,6 +95,14 @@ public:
 
   /// @return The nearest exact address where building has house number and valid street match.
   void GetNearbyAddress(m2::PointD const & center, Address & addr) const;
+  /// Batch version of GetNearbyAddress for large sets of points, e.g. GPS tracks.
+  /// Points are grouped by cells of a grid and buildings, streets and house to street tables
+  /// are loaded once per group, groups are geocoded on |numThreads| threads.
+  /// @note Candidate buildings of a point are the ones intersecting its lookup rect, so results
+  /// may differ from GetNearbyAddress for buildings on the border of the lookup area.
+  /// @param addrs (out) addresses for every point of |centers|, invalid when not found.
+  void GetNearbyAddresses(vector<m2::PointD> const & centers, size_t numThreads,
+                          vector<Address> & addrs) const;
   /// @param addr (out) the exact address of a feature.
   /// @returns false if  can't extruct address or ft have no house number.
   bool GetExactAddress(FeatureType & ft, Address & addr) const;
@@ -111,7 +120,28 @@ private:
     bool Get(FeatureID const & fid, uint32_t & streetIndex);
   };
 
-  bool GetNearbyAddress(HouseTable & table, Building const & bld, Address & addr) const;
+  using StreetsCache = map<FeatureID, vector<Street>>;
+
+  /// Tables and streets shared between nearby points of a batch. Used by one thread only.
+  class BatchCache
+  {
+    DataSource const & m_dataSource;
+    map<MwmSet::MwmId, HouseTable> m_tables;
+  public:
+    explicit BatchCache(DataSource const & dataSource) : m_dataSource(dataSource) {}
+    HouseTable & GetTable(MwmSet::MwmId const & id);
+
+    /// Nearby streets of buildings.
+    StreetsCache m_streets;
+  };
+
+  /// @param streetsCache Nearby streets of buildings, may be nullptr.
+  bool GetNearbyAddress(HouseTable & table, Building const & bld, StreetsCache * streetsCache,
+                        Address & addr) const;
+
+  /// Geocodes points |centers[indices[i]]| for i in [0, numIndices).
+  void GetNearbyAddresses(vector<m2::PointD> const & centers, size_t const * indices,
+                          size_t numIndices, BatchCache & cache, vector<Address> & addrs) const;
 
   /// @return Sorted by distance houses vector with valid house number.
   void GetNearbyBuildings(m2::PointD const & center, vector<Building> & buildings) const;
@@ -3,6 +3,7 @@
 #include "coding/compressed_bit_vector.hpp"
 #include "coding/geometry_coding.hpp"
 #include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
 #include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
@@ -10,9 +11,65 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <string>
 #include <vector>
 
+// Version of the search index section.
+enum class SearchIndexVersion : uint8_t
+{
+  // The section is the trie of trie_builder.hpp read by trie::Iterator0, there is no header.
+  V0 = 0,
+  // The section starts with SearchIndexHeader and the trie of packed_trie_builder.hpp follows.
+  V1 = 1,
+  Latest = V1,
+};
+
+// [4: signature] [1: version] [3: padding, the trie starts at an offset aligned by 8 bytes]
+//
+// A V0 section starts with the header byte of the root node. The root has no values, so two
+// high bits of the byte are zero and the signature can't be found in a V0 section.
+struct SearchIndexHeader
+{
+  static size_t constexpr kSize = 8;
+
+  template <typename Sink>
+  static void Write(Sink & sink, SearchIndexVersion version)
+  {
+    ASSERT(version != SearchIndexVersion::V0, ("V0 sections have no header."));
+    uint8_t const header[kSize] = {0xFF, 's', 'd', 'x', static_cast<uint8_t>(version), 0, 0, 0};
+    sink.Write(header, kSize);
+  }
+
+  template <typename Reader>
+  static SearchIndexVersion Read(Reader const & reader)
+  {
+    uint8_t const signature[] = {0xFF, 's', 'd', 'x'};
+    uint8_t header[kSize];
+    if (reader.Size() < kSize)
+      return SearchIndexVersion::V0;
+    reader.Read(0 /* pos */, header, kSize);
+    if (memcmp(header, signature, sizeof(signature)) != 0)
+      return SearchIndexVersion::V0;
+
+    auto const version = header[sizeof(signature)];
+    if (version == 0 || version > static_cast<uint8_t>(SearchIndexVersion::Latest))
+      MYTHROW(::Reader::ReadException, ("Unknown search index version:", version));
+    return static_cast<SearchIndexVersion>(version);
+  }
+};
+
+inline std::string DebugPrint(SearchIndexVersion version)
+{
+  switch (version)
+  {
+  case SearchIndexVersion::V0: return "V0";
+  case SearchIndexVersion::V1: return "V1";
+  }
+  CHECK_SWITCH();
+}
+
 /// Following classes are supposed to be used with StringsFile. They
 /// allow to write/read them, compare or serialize to an in-memory
 /// buffer. The reason to use these classes instead of
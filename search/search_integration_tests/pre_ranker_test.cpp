@@ -54,7 +54,7 @@ class TestRanker : public Ranker
 public:
   TestRanker(DataSource & dataSource, storage::CountryInfoGetter & infoGetter,
              CitiesBoundariesTable const & boundariesTable, KeywordLangMatcher & keywordsScorer,
-             Emitter & emitter, vector<Suggest> const & suggests, VillagesCache & villagesCache,
+             Emitter & emitter, SuggestsIndex const & suggests, VillagesCache & villagesCache,
              base::Cancellable const & cancellable, vector<PreRankerResult> & results)
     : Ranker(dataSource, boundariesTable, infoGetter, keywordsScorer, emitter,
              GetDefaultCategories(), suggests, villagesCache, cancellable)
@@ -87,7 +87,7 @@ private:
 class PreRankerTest : public SearchTest
 {
 public:
-  vector<Suggest> m_suggests;
+  SuggestsIndex m_suggests;
   base::Cancellable m_cancellable;
 };
 
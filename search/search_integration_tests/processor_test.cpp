@@ -15,6 +15,8 @@
 
 #include "editor/editable_data_source.hpp"
 
+#include "storage/country_info_getter.hpp"
+
 #include "indexer/feature.hpp"
 #include "indexer/ftypes_matcher.hpp"
 
@@ -29,6 +31,7 @@
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
 
+#include "std/chrono.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 
@@ -1221,6 +1224,24 @@ UNIT_CLASS_TEST(ProcessorTest, CityBoundaryLoad)
 
   TEST(!boundaries.HasPoint(m2::PointD(0.6, 0.6)), ());
   TEST(!boundaries.HasPoint(m2::PointD(-1, 0.5)), ());
+
+  vector<uint32_t> fids;
+  table.GetCitiesContaining(m2::PointD(0.25, 0.25), fids);
+  TEST_EQUAL(fids, vector<uint32_t>({0}), ());
+  table.GetCitiesContaining(m2::PointD(0.6, 0.6), fids);
+  TEST(fids.empty(), ());
+
+  // Points resolved by the grid cells should agree with the checks of the boundaries.
+  CitiesBoundariesTable::Boundaries const plain(boundaries.GetBoundariesForTesting(),
+                                                boundaries.GetEpsForTesting());
+  for (double x = -0.1; x <= 0.6; x += 0.005)
+  {
+    for (double y = -0.1; y <= 0.6; y += 0.005)
+    {
+      m2::PointD const p(x, y);
+      TEST_EQUAL(boundaries.HasPoint(p), plain.HasPoint(p), (p));
+    }
+  }
 }
 
 UNIT_CLASS_TEST(ProcessorTest, CityBoundarySmoke)
@@ -1604,5 +1625,132 @@ UNIT_CLASS_TEST(ProcessorTest, OperatorTest)
     TEST(ResultsMatch("atm alfa ", "en", rules), ());
   }
 }
+
+UNIT_CLASS_TEST(ProcessorTest, ParallelGeocoding)
+{
+  TestCafe wonderlandCafe(m2::PointD(0.0, 0.0), "Mad Hatter's cafe", "en");
+  TestCafe neverlandCafe(m2::PointD(10.0, 10.0), "Pirate cafe", "en");
+  TestCafe ozCafe(m2::PointD(20.0, 20.0), "Emerald cafe", "en");
+
+  auto wonderlandId =
+      BuildCountry("Wonderland", [&](TestMwmBuilder & builder) { builder.Add(wonderlandCafe); });
+  auto neverlandId =
+      BuildCountry("Neverland", [&](TestMwmBuilder & builder) { builder.Add(neverlandCafe); });
+  auto ozId = BuildCountry("Oz", [&](TestMwmBuilder & builder) { builder.Add(ozCafe); });
+
+  SetViewport(m2::RectD(-1, -1, 1, 1));
+
+  Engine::Params params;
+  // Three mwms are geocoded in two batches.
+  params.m_numGeocoderThreads = 2;
+  TestSearchEngine engine(m_dataSource, make_unique<storage::CountryInfoGetterForTesting>(),
+                          params);
+
+  {
+    TRules rules{ExactMatch(wonderlandId, wonderlandCafe), ExactMatch(neverlandId, neverlandCafe),
+                 ExactMatch(ozId, ozCafe)};
+    TEST(ResultsMatch("cafe ", rules), ());
+
+    TestSearchRequest request(engine, "cafe ", "en", Mode::Everywhere, m_viewport);
+    request.Run();
+    TEST(MatchResults(m_dataSource, rules, request.Results()), ());
+  }
+
+  {
+    TRules rules{ExactMatch(neverlandId, neverlandCafe)};
+    TEST(ResultsMatch("pirate ", rules), ());
+
+    TestSearchRequest request(engine, "pirate ", "en", Mode::Everywhere, m_viewport);
+    request.Run();
+    TEST(MatchResults(m_dataSource, rules, request.Results()), ());
+  }
+}
+
+UNIT_CLASS_TEST(ProcessorTest, ProvisionalResults)
+{
+  class ProvisionalSearchRequest : public TestSearchRequest
+  {
+  public:
+    ProvisionalSearchRequest(TestSearchEngine & engine, SearchParams const & params)
+      : TestSearchRequest(engine, params)
+    {
+      SetCustomOnResults([this](search::Results const & results) {
+        if (!results.IsProvisional())
+        {
+          OnResults(results);
+          return;
+        }
+
+        lock_guard<mutex> lock(m_mu);
+        m_provisional.emplace_back(results.begin(), results.end());
+      });
+    }
+
+    vector<vector<search::Result>> const & Provisional() const { return m_provisional; }
+
+  private:
+    vector<vector<search::Result>> m_provisional;
+  };
+
+  TestCafe cafe1(m2::PointD(0.0, 0.0), "Hungry bear", "en");
+  TestCafe cafe2(m2::PointD(0.1, 0.0), "Hungry bear", "en");
+  TestCafe cafe3(m2::PointD(0.0, 0.1), "Hungry bear", "en");
+
+  auto const id = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(cafe1);
+    builder.Add(cafe2);
+    builder.Add(cafe3);
+  });
+
+  SearchParams params;
+  params.m_query = "hungry bear ";
+  params.m_inputLocale = "en";
+  params.m_viewport = m2::RectD(m2::PointD(-1, -1), m2::PointD(1, 1));
+  params.m_mode = Mode::Everywhere;
+  params.m_suggestsEnabled = false;
+  params.m_numProvisionalResults = 2;
+
+  ProvisionalSearchRequest request(m_engine, params);
+  request.Run();
+
+  TEST_EQUAL(request.Provisional().size(), 1, ());
+  TEST_EQUAL(request.Provisional().front().size(), 2, ());
+
+  TRules rules = {ExactMatch(id, cafe1), ExactMatch(id, cafe2), ExactMatch(id, cafe3)};
+  TEST(ResultsMatch(request.Results(), rules), ());
+}
+
+UNIT_CLASS_TEST(ProcessorTest, Timeout)
+{
+  TestCafe cafe(m2::PointD(0.0, 0.0), "Hungry bear", "en");
+  auto const id = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) { builder.Add(cafe); });
+
+  SearchParams params;
+  params.m_query = "hungry bear ";
+  params.m_inputLocale = "en";
+  params.m_viewport = m2::RectD(m2::PointD(-1, -1), m2::PointD(1, 1));
+  params.m_mode = Mode::Everywhere;
+  params.m_suggestsEnabled = false;
+
+  auto const metricsBefore = m_engine.GetMetrics();
+  {
+    TestSearchRequest request(m_engine, params);
+    request.Run();
+    TRules rules = {ExactMatch(id, cafe)};
+    TEST(ResultsMatch(request.Results(), rules), ());
+  }
+  {
+    // The deadline passes before the query is started.
+    params.m_timeout = std::chrono::nanoseconds(1);
+    TestSearchRequest request(m_engine, params);
+    request.Run();
+    TEST(request.Results().empty(), ());
+  }
+
+  auto const metrics = m_engine.GetMetrics();
+  TEST_EQUAL(metrics.m_numSearches - metricsBefore.m_numSearches, 2, ());
+  TEST_EQUAL(metrics.m_numTimedOut - metricsBefore.m_numTimedOut, 1, ());
+  TEST_EQUAL(metrics.m_numRejected, metricsBefore.m_numRejected, ());
+}
 }  // namespace
 }  // namespace search
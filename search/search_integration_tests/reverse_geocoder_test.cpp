@@ -0,0 +1,74 @@
+#include "testing/testing.hpp"
+
+#include "search/reverse_geocoder.hpp"
+#include "search/search_tests_support/helpers.hpp"
+
+#include "generator/generator_tests_support/test_feature.hpp"
+#include "generator/generator_tests_support/test_mwm_builder.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace generator::tests_support;
+using namespace search::tests_support;
+using namespace std;
+
+namespace search
+{
+namespace
+{
+class ReverseGeocoderTest : public SearchTest
+{
+};
+
+UNIT_CLASS_TEST(ReverseGeocoderTest, Batch)
+{
+  TestStreet lenina(vector<m2::PointD>{m2::PointD(0.0, 0.0), m2::PointD(0.0, 0.01)}, "Lenina",
+                    "en");
+  TestStreet pushkina(vector<m2::PointD>{m2::PointD(0.02, 0.0), m2::PointD(0.02, 0.01)},
+                      "Pushkina", "en");
+  TestBuilding lenina1(m2::PointD(0.0005, 0.001), "", "1", lenina, "en");
+  TestBuilding lenina3(m2::PointD(0.0005, 0.005), "", "3", lenina, "en");
+  TestBuilding pushkina10(m2::PointD(0.0195, 0.002), "", "10", pushkina, "en");
+
+  BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(lenina);
+    builder.Add(pushkina);
+    builder.Add(lenina1);
+    builder.Add(lenina3);
+    builder.Add(pushkina10);
+  });
+
+  // Points of the same cell, of different cells and a point with no buildings around.
+  vector<m2::PointD> const centers = {
+      m2::PointD(0.0004, 0.001), m2::PointD(0.0006, 0.0049), m2::PointD(0.0194, 0.002),
+      m2::PointD(0.0005, 0.0011), m2::PointD(0.01, 0.5), m2::PointD(0.0196, 0.0021)};
+
+  ReverseGeocoder const coder(m_dataSource);
+  for (size_t numThreads : {1, 2, 10})
+  {
+    vector<ReverseGeocoder::Address> addrs;
+    coder.GetNearbyAddresses(centers, numThreads, addrs);
+    TEST_EQUAL(addrs.size(), centers.size(), ());
+
+    for (size_t i = 0; i < centers.size(); ++i)
+    {
+      ReverseGeocoder::Address expected;
+      coder.GetNearbyAddress(centers[i], expected);
+      TEST_EQUAL(addrs[i].m_building.m_id, expected.m_building.m_id, (i, numThreads));
+      TEST_EQUAL(addrs[i].GetHouseNumber(), expected.GetHouseNumber(), (i, numThreads));
+      TEST_EQUAL(addrs[i].GetStreetName(), expected.GetStreetName(), (i, numThreads));
+    }
+
+    TEST_EQUAL(addrs[0].GetHouseNumber(), "1", ());
+    TEST_EQUAL(addrs[0].GetStreetName(), "Lenina", ());
+    TEST_EQUAL(addrs[1].GetHouseNumber(), "3", ());
+    TEST_EQUAL(addrs[2].GetHouseNumber(), "10", ());
+    TEST_EQUAL(addrs[2].GetStreetName(), "Pushkina", ());
+    TEST(!addrs[4].m_building.IsValid(), ());
+  }
+}
+}  // namespace
+}  // namespace search
@@ -6,6 +6,7 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -15,6 +16,7 @@
 
 namespace search
 {
+class QueryStats;
 class Results;
 class Tracer;
 
@@ -57,9 +59,28 @@ struct SearchParams
   // Needed to highlight matching parts of search result names.
   bool m_needHighlighting = false;
 
+  // When positive, the provisional top of up to this number of results is emitted as soon as
+  // this number of candidates matching all the tokens is found, see
+  // Results::IsProvisional(). Ignored by the viewport search.
+  size_t m_numProvisionalResults = 0;
+
+  // When positive, the query is processed until this time since it's posted to the engine.
+  // Results found by the deadline are ranked and emitted as usual, the query does not
+  // geocode the rest of mwms.
+  std::chrono::steady_clock::duration m_timeout = std::chrono::steady_clock::duration::zero();
+
+  // When true, the viewport search reuses the results of the previous completed incremental
+  // viewport search with the same params if the viewports substantially overlap. Results in
+  // the common part of the viewports are emitted at once and only the rest of the viewport is
+  // searched. Ignored by other modes.
+  bool m_incremental = false;
+
   std::shared_ptr<hotels_filter::Rule> m_hotelsFilter;
 
   std::shared_ptr<Tracer> m_tracer;
+
+  // When set, times of the stages of the search pipeline are added to it.
+  std::shared_ptr<QueryStats> m_stats;
 };
 
 std::string DebugPrint(SearchParams const & params);
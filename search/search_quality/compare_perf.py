@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+
+from scipy.stats import wilcoxon
+import argparse
+import pandas as pd
+import sys
+
+
+METRICS = ['CpuMs', 'WallMs', 'Allocations', 'ReadBytes']
+ALL_TYPES = 'all'
+
+
+def load_stats(path):
+    """
+    Loads performance stats generated by features_collector_tool
+    --perf_csv. Returns a data frame indexed by sample ids, runs of a
+    query are merged into their medians to suppress noise of single
+    runs.
+    """
+
+    data = pd.read_csv(path)
+    aggregations = {m: 'median' for m in METRICS}
+    aggregations['Type'] = 'first'
+    return data.groupby('SampleId').agg(aggregations)
+
+
+def compare_metric(baseline, candidate):
+    """
+    Returns the relative change of the total of a metric and the p-value
+    of the Wilcoxon signed-rank test on the pairs of values of the same
+    queries.
+    """
+
+    total = baseline.sum()
+    change = (candidate.sum() - total) / total if total != 0 else 0.0
+    if len(baseline) < 2 or (baseline == candidate).all():
+        return change, 1.0
+    return change, wilcoxon(baseline, candidate).pvalue
+
+
+def main(args):
+    baseline = load_stats(args.baseline)
+    candidate = load_stats(args.candidate)
+
+    ids = baseline.index.intersection(candidate.index)
+    if len(ids) != len(baseline) or len(ids) != len(candidate):
+        print('Warning: only {} queries are in both files'.format(len(ids)), file=sys.stderr)
+    baseline = baseline.loc[ids]
+    candidate = candidate.loc[ids]
+
+    # Queries are broken down by the types in the baseline, the type of
+    # a query may change if the candidate changes ranking.
+    groups = [(ALL_TYPES, ids)]
+    for query_type, group in baseline.groupby('Type'):
+        groups.append((query_type, group.index))
+
+    regressions = []
+    print('{:<10} {:>6} '.format('Type', 'Num') +
+          ' '.join('{:>22}'.format(m) for m in args.metrics))
+    for query_type, group_ids in groups:
+        cells = []
+        for metric in args.metrics:
+            change, p = compare_metric(baseline.loc[group_ids, metric],
+                                       candidate.loc[group_ids, metric])
+            mark = ' '
+            if p < args.alpha:
+                mark = '*'
+                if change > args.threshold:
+                    mark = '!'
+                    regressions.append((query_type, metric, change, p))
+            cells.append('{:>+8.2%} (p={:.3f}) {}'.format(change, p, mark))
+        print('{:<10} {:>6} '.format(query_type, len(group_ids)) +
+              ' '.join('{:>22}'.format(c) for c in cells))
+
+    print()
+    print('* - significant change, ! - significant regression over {:.1%}'.format(args.threshold))
+    for query_type, metric, change, p in regressions:
+        print('Regression: {} of {} queries: {:+.2%}, p={:.4f}'.format(metric, query_type,
+                                                                         change, p))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description='Compares performance of search queries of baseline and candidate builds. '
+                    'Exits with non-zero code when a metric has a significant regression.')
+    parser.add_argument('baseline', help='features_collector_tool --perf_csv of the baseline')
+    parser.add_argument('candidate', help='features_collector_tool --perf_csv of the candidate')
+    parser.add_argument('--alpha', help='significance level', type=float, default=0.01)
+    parser.add_argument('--threshold', help='max allowed relative growth of a metric',
+                        type=float, default=0.05)
+    parser.add_argument('--metrics', help='compared metrics', nargs='+', choices=METRICS,
+                        default=METRICS)
+    args = parser.parse_args()
+    sys.exit(main(args))
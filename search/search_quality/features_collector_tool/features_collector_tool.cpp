@@ -24,7 +24,11 @@
 
 #include "base/macros.hpp"
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/cstdlib.hpp"
 #include "std/fstream.hpp"
 #include "std/iostream.hpp"
 #include "std/limits.hpp"
@@ -32,6 +36,10 @@
 #include "std/unique_ptr.hpp"
 #include "std/vector.hpp"
 
+#include <new>
+
+#include <sys/resource.h>
+
 #include "defines.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
@@ -44,6 +52,28 @@ DEFINE_string(data_path, "", "Path to data directory (resources dir)");
 DEFINE_string(mwm_path, "", "Path to mwm files (writable dir)");
 DEFINE_string(stats_path, "", "Path to store stats about queries results (default: stderr)");
 DEFINE_string(json_in, "", "Path to the json file with samples (default: stdin)");
+DEFINE_string(perf_csv, "",
+              "Path to store CPU time, allocations and bytes read by every query, "
+              "see compare_perf.py (default: not stored)");
+DEFINE_int32(perf_runs, 1, "Number of times every query is run, for the performance stats");
+
+namespace
+{
+// Number of the allocations made by operator new during the lifetime of the tool.
+atomic<uint64_t> g_numAllocations(0);
+}  // namespace
+
+void * operator new(size_t size)
+{
+  g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void * p = malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept { free(p); }
+
+void operator delete(void * p, size_t /* size */) noexcept { free(p); }
 
 struct Stats
 {
@@ -51,6 +81,69 @@ struct Stats
   vector<size_t> m_notFound;
 };
 
+struct ResourceUsage
+{
+  double m_cpuMs = 0.0;
+  uint64_t m_readBytes = 0;
+};
+
+// The search engine has a single thread and the main thread waits for the queries, so the
+// usage of the process is the usage of the queries.
+ResourceUsage GetResourceUsage()
+{
+  ResourceUsage result;
+
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    auto const toMs = [](timeval const & t) { return t.tv_sec * 1e3 + t.tv_usec / 1e3; };
+    result.m_cpuMs = toMs(usage.ru_utime) + toMs(usage.ru_stime);
+  }
+
+#if defined(OMIM_OS_LINUX)
+  ifstream io("/proc/self/io");
+  string key;
+  uint64_t value;
+  while (io >> key >> value)
+  {
+    if (key == "rchar:")
+      result.m_readBytes = value;
+  }
+#endif
+  return result;
+}
+
+// Returns the type of the query for the breakdown of the performance stats, the type is
+// guessed by the top result.
+string GetQueryType(vector<Result> const & results)
+{
+  for (auto const & result : results)
+  {
+    if (result.GetResultType() != Result::Type::Feature)
+      continue;
+
+    auto const & info = result.GetRankingInfo();
+    if (info.m_pureCats)
+      return "category";
+    if (info.m_errorsMade.IsValid() && info.m_errorsMade.m_errorsMade != 0)
+      return "fuzzy";
+
+    switch (info.m_type)
+    {
+    case Model::TYPE_POI: return "poi_name";
+    case Model::TYPE_BUILDING:
+    case Model::TYPE_STREET: return "address";
+    case Model::TYPE_VILLAGE:
+    case Model::TYPE_CITY:
+    case Model::TYPE_STATE:
+    case Model::TYPE_COUNTRY: return "locality";
+    case Model::TYPE_UNCLASSIFIED:
+    case Model::TYPE_COUNT: return "other";
+    }
+  }
+  return "empty";
+}
+
 void GetContents(istream & is, string & contents)
 {
   string line;
@@ -169,20 +262,51 @@ int main(int argc, char * argv[])
   FeatureLoader loader(dataSource);
   Matcher matcher(loader);
 
+  ofstream perf;
+  if (!FLAGS_perf_csv.empty())
+  {
+    perf.open(FLAGS_perf_csv);
+    if (!perf.is_open())
+    {
+      cerr << "Can't open output file for performance stats." << endl;
+      return -1;
+    }
+    perf << "SampleId,Run,Type,CpuMs,WallMs,Allocations,ReadBytes" << endl;
+  }
+
   cout << "SampleId,";
   RankingInfo::PrintCSVHeader(cout);
   cout << ",Relevance" << endl;
 
+  int const numRuns = max(FLAGS_perf_runs, 1);
   for (size_t i = 0; i < samples.size(); ++i)
   {
     auto const & sample = samples[i];
 
     search::SearchParams params;
     sample.FillSearchParams(params);
-    TestSearchRequest request(engine, params);
-    request.Run();
 
-    auto const & results = request.Results();
+    vector<Result> results;
+    for (int run = 0; run < numRuns; ++run)
+    {
+      TestSearchRequest request(engine, params);
+
+      auto const usageBefore = GetResourceUsage();
+      uint64_t const numAllocationsBefore = g_numAllocations.load();
+      base::Timer timer;
+      request.Run();
+      double const wallMs = timer.ElapsedSeconds() * 1e3;
+      uint64_t const numAllocations = g_numAllocations.load() - numAllocationsBefore;
+      auto const usage = GetResourceUsage();
+
+      results = request.Results();
+      if (perf.is_open())
+      {
+        perf << i << "," << run << "," << GetQueryType(results) << ","
+             << usage.m_cpuMs - usageBefore.m_cpuMs << "," << wallMs << "," << numAllocations
+             << "," << usage.m_readBytes - usageBefore.m_readBytes << endl;
+      }
+    }
 
     vector<size_t> goldenMatching;
     vector<size_t> actualMatching;
@@ -8,11 +8,13 @@
 #include "geometry/mercator.hpp"
 #include "geometry/point2d.hpp"
 
+#include "search/query_stats.hpp"
 #include "search/ranking_info.hpp"
 #include "search/result.hpp"
 #include "search/search_quality/helpers.hpp"
 #include "search/search_tests_support/test_search_engine.hpp"
 #include "search/search_tests_support/test_search_request.hpp"
+#include "search/token_features_cache.hpp"
 
 #include "platform/country_file.hpp"
 #include "platform/local_country_file.hpp"
@@ -33,8 +35,11 @@
 #include "base/timer.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/chrono.hpp"
 #include "std/cmath.hpp"
 #include "std/cstdio.hpp"
+#include "std/cstdlib.hpp"
 #include "std/fstream.hpp"
 #include "std/iomanip.hpp"
 #include "std/iostream.hpp"
@@ -43,8 +48,11 @@
 #include "std/numeric.hpp"
 #include "std/sstream.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
 #include "std/vector.hpp"
 
+#include <new>
+
 #include "defines.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
@@ -64,6 +72,32 @@ DEFINE_int32(top, 1, "Number of top results to show for every query");
 DEFINE_string(viewport, "", "Viewport to use when searching (default, moscow, london, zurich)");
 DEFINE_string(check_completeness, "", "Path to the file with completeness data");
 DEFINE_string(ranking_csv_file, "", "File ranking info will be exported to");
+DEFINE_double(benchmark_qps, 0.0,
+              "When positive, the queries are sent to the engine concurrently at this rate "
+              "(queries per second) and the latency percentiles are reported instead of results");
+DEFINE_int32(benchmark_num_queries, 0,
+             "Number of queries sent in the benchmark mode, the queries are repeated cyclically. "
+             "Zero means every query is sent once");
+DEFINE_int32(benchmark_timeout_ms, 0,
+             "When positive, the benchmark queries are stopped after this time since sending");
+
+namespace
+{
+// Number of the allocations made by operator new during the lifetime of the tool.
+atomic<uint64_t> g_numAllocations(0);
+}  // namespace
+
+void * operator new(size_t size)
+{
+  g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void * p = malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept { free(p); }
+
+void operator delete(void * p, size_t /* size */) noexcept { free(p); }
 
 map<string, m2::RectD> const kViewports = {
     {"default", m2::RectD(m2::PointD(0.0, 0.0), m2::PointD(1.0, 1.0))},
@@ -84,6 +118,48 @@ struct CompletenessQuery
   double m_lon = 0;
 };
 
+// A request of the benchmark mode. It's sent without waiting for the previous requests and
+// collects the times of the stages of the search pipeline.
+class BenchmarkRequest : public TestSearchRequest
+{
+public:
+  BenchmarkRequest(TestSearchEngine & engine, string const & query, string const & locale,
+                   m2::RectD const & viewport)
+    : TestSearchRequest(engine, query, locale, Mode::Everywhere, viewport)
+    , m_stats(make_shared<QueryStats>())
+  {
+    m_params.m_stats = m_stats;
+    if (FLAGS_benchmark_timeout_ms > 0)
+      m_params.m_timeout = std::chrono::milliseconds(FLAGS_benchmark_timeout_ms);
+  }
+
+  void Send()
+  {
+    {
+      lock_guard<mutex> lock(m_mu);
+      m_sendTime = m_timer.TimeElapsed();
+    }
+    Start();
+  }
+
+  using TestSearchRequest::Wait;
+
+  // Time from sending of the request to its end including the time spent in the queue
+  // of the engine. Call it only after call to Wait().
+  steady_clock::duration Latency() const
+  {
+    lock_guard<mutex> lock(m_mu);
+    CHECK(m_done, ("This function may be called only when request is processed."));
+    return m_endTime - m_sendTime;
+  }
+
+  QueryStats const & GetStats() const { return *m_stats; }
+
+private:
+  shared_ptr<QueryStats> m_stats;
+  steady_clock::duration m_sendTime;
+};
+
 DECLARE_EXCEPTION(MalformedQueryException, RootException);
 
 void DidDownload(TCountryId const & /* countryId */,
@@ -186,6 +262,24 @@ void CalcStatistics(vector<double> const & a, double & avg, double & maximum, do
   stdDev = sqrt(var);
 }
 
+// Returns the nearest-rank |percentile| of |a|. |a| is sorted in place.
+double CalcPercentile(vector<double> & a, double percentile)
+{
+  if (a.empty())
+    return 0.0;
+
+  sort(a.begin(), a.end());
+  auto const rank = static_cast<size_t>(ceil(percentile / 100.0 * static_cast<double>(a.size())));
+  return a[min(max(rank, static_cast<size_t>(1)), a.size()) - 1];
+}
+
+void PrintPercentiles(string const & name, vector<double> & timesMs)
+{
+  cout << setw(14) << std::left << name << std::right << " p50 " << setw(9) << CalcPercentile(timesMs, 50)
+       << "ms  p95 " << setw(9) << CalcPercentile(timesMs, 95) << "ms  p99 " << setw(9)
+       << CalcPercentile(timesMs, 99) << "ms" << endl;
+}
+
 // Unlike strings::Tokenize, this function allows for empty tokens.
 void Split(string const & s, char delim, vector<string> & parts)
 {
@@ -345,6 +439,104 @@ void CheckCompleteness(string const & path, m2::RectD const & viewport, DataSour
        << expectedResultsTop1Percentage << "%)." << endl;
 }
 
+// Sends |queries| to the |engine| at the rate of FLAGS_benchmark_qps queries per second without
+// waiting for the responses and reports the percentiles of latencies of the queries and of the
+// stages of the search pipeline, the number of allocations and the hit rate of the cache of
+// features of query tokens.
+void RunBenchmark(vector<string> const & queries, m2::RectD const & viewport,
+                  TestSearchEngine & engine)
+{
+  CHECK(!queries.empty(), ());
+  CHECK_GREATER(FLAGS_benchmark_qps, 0.0, ());
+
+  size_t const numQueries =
+      FLAGS_benchmark_num_queries > 0 ? static_cast<size_t>(FLAGS_benchmark_num_queries)
+                                      : queries.size();
+
+  vector<unique_ptr<BenchmarkRequest>> requests;
+  for (size_t i = 0; i < numQueries; ++i)
+  {
+    requests.emplace_back(make_unique<BenchmarkRequest>(
+        engine, MakePrefixFree(queries[i % queries.size()]), FLAGS_locale, viewport));
+  }
+
+  TokenFeaturesCache::Stats cacheStatsBefore;
+  if (auto const * cache = engine.GetTokenFeaturesCache())
+    cacheStatsBefore = cache->GetStats();
+  uint64_t const numAllocationsBefore = g_numAllocations.load();
+  auto const metricsBefore = engine.GetMetrics();
+
+  base::Timer timer;
+  auto const period = duration_cast<steady_clock::duration>(
+      duration<double>(1.0 / FLAGS_benchmark_qps));
+  auto const start = steady_clock::now();
+  for (size_t i = 0; i < requests.size(); ++i)
+  {
+    this_thread::sleep_until(start + period * i);
+    requests[i]->Send();
+  }
+  for (auto & request : requests)
+    request->Wait();
+  double const elapsedSeconds = timer.ElapsedSeconds();
+
+  uint64_t const numAllocations = g_numAllocations.load() - numAllocationsBefore;
+  auto const numTimedOut = engine.GetMetrics().m_numTimedOut - metricsBefore.m_numTimedOut;
+  TokenFeaturesCache::Stats cacheStats;
+  if (auto const * cache = engine.GetTokenFeaturesCache())
+    cacheStats = cache->GetStats();
+
+  auto const toMs = [](steady_clock::duration d) {
+    return static_cast<double>(duration_cast<std::chrono::microseconds>(d).count()) / 1000.0;
+  };
+
+  vector<double> latencies;
+  vector<double> processingTimes;
+  size_t const numPhases = static_cast<size_t>(QueryStats::Phase::Count);
+  vector<vector<double>> phaseTimes(numPhases);
+  for (auto const & request : requests)
+  {
+    latencies.push_back(toMs(request->Latency()));
+    processingTimes.push_back(toMs(request->ResponseTime()));
+    for (size_t i = 0; i < numPhases; ++i)
+    {
+      auto const ns = request->GetStats().GetNs(static_cast<QueryStats::Phase>(i));
+      phaseTimes[i].push_back(static_cast<double>(ns) / 1e6);
+    }
+  }
+
+  auto const numHits = cacheStats.m_numHits - cacheStatsBefore.m_numHits;
+  auto const numMisses = cacheStats.m_numMisses - cacheStatsBefore.m_numMisses;
+
+  cout << fixed << setprecision(3);
+  cout << "Queries sent: " << numQueries << ", target rate: " << FLAGS_benchmark_qps
+       << " qps, achieved rate: " << static_cast<double>(numQueries) / elapsedSeconds << " qps"
+       << endl;
+  cout << "Engine threads: " << FLAGS_num_threads << endl;
+  if (FLAGS_benchmark_timeout_ms > 0)
+  {
+    cout << "Queries stopped by the timeout of " << FLAGS_benchmark_timeout_ms
+         << " ms: " << numTimedOut << endl;
+  }
+  cout << endl;
+  PrintPercentiles("Latency", latencies);
+  PrintPercentiles("Processing", processingTimes);
+  for (size_t i = 0; i < numPhases; ++i)
+    PrintPercentiles(DebugPrint(static_cast<QueryStats::Phase>(i)), phaseTimes[i]);
+  cout << endl;
+  cout << "Allocations per query: "
+       << static_cast<double>(numAllocations) / static_cast<double>(numQueries) << endl;
+  if (numHits + numMisses != 0)
+  {
+    cout << "Token features cache hit rate: "
+         << 100.0 * static_cast<double>(numHits) / static_cast<double>(numHits + numMisses)
+         << "% (" << numHits << " hits, " << numMisses << " misses)" << endl;
+  }
+  else
+  {
+    cout << "Token features cache isn't used." << endl;
+  }
+}
+
 int main(int argc, char * argv[])
 {
   ChangeMaxNumberOfOpenFiles(kMaxOpenFiles);
@@ -435,6 +627,12 @@ int main(int argc, char * argv[])
     queriesPath = base::JoinFoldersToPath(platform.WritableDir(), kDefaultQueriesPathSuffix);
   ReadStringsFromFile(queriesPath, queries);
 
+  if (FLAGS_benchmark_qps > 0)
+  {
+    RunBenchmark(queries, viewport, engine);
+    return 0;
+  }
+
   vector<unique_ptr<TestSearchRequest>> requests;
   for (size_t i = 0; i < queries.size(); ++i)
   {
@@ -2,6 +2,7 @@
 
 #include "search/bookmarks/data.hpp"
 #include "search/bookmarks/processor.hpp"
+#include "search/bookmarks/snapshot.hpp"
 #include "search/emitter.hpp"
 
 #include "indexer/search_delimiters.hpp"
@@ -9,7 +10,10 @@
 
 #include "base/cancellable.hpp"
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace search::bookmarks;
@@ -25,12 +29,26 @@ class BookmarksProcessorTest
 public:
   BookmarksProcessorTest() : m_processor(m_emitter, m_cancellable) {}
 
-  void Add(Id const & id, Doc const & doc) { m_processor.Add(id, doc); }
+  void Add(Id const & id, Doc const & doc)
+  {
+    m_bookmarks.AddEdit([id, doc](Snapshot::Builder & builder) { builder.Add(id, doc); });
+  }
+
+  void Erase(Id const & id)
+  {
+    m_bookmarks.AddEdit([id](Snapshot::Builder & builder) { builder.Erase(id); });
+  }
 
-  void Erase(Id const & id) { m_processor.Erase(id); }
+  shared_ptr<Snapshot const> GetSnapshot()
+  {
+    return m_bookmarks.GetSnapshot(m_bookmarks.GetNumEdits());
+  }
+
+  Ids Search(string const & query) { return Search(query, GetSnapshot()); }
 
-  Ids Search(string const & query)
+  Ids Search(string const & query, shared_ptr<Snapshot const> snapshot)
   {
+    m_processor.SetSnapshot(move(snapshot));
     m_emitter.Init([](::search::Results const & /* results */) {} /* onResults */);
 
     vector<strings::UniString> tokens;
@@ -58,6 +76,7 @@ public:
 protected:
   Emitter m_emitter;
   base::Cancellable m_cancellable;
+  SnapshotHolder m_bookmarks;
   Processor m_processor;
 };
 
@@ -77,4 +96,54 @@ UNIT_CLASS_TEST(BookmarksProcessorTest, Smoke)
   TEST_EQUAL(Search("double r cafe"), Ids({10}), ());
   TEST_EQUAL(Search("dine"), Ids({10}), ());
 }
+
+UNIT_CLASS_TEST(BookmarksProcessorTest, Snapshots)
+{
+  Add(10, {"Double R Diner" /* name */, "Cherry pie" /* description */});
+  Add(20, {"Great Northern Hotel" /* name */, "Great place" /* description */});
+
+  auto const before = GetSnapshot();
+  TEST_EQUAL(before->GetNumDocs(), 2, ());
+
+  Erase(10);
+  Add(30, {"Packard Sawmill" /* name */, "Cherry trees around" /* description */});
+
+  TEST_EQUAL(Search("cherry"), Ids({30}), ());
+  TEST_EQUAL(Search("great"), Ids({20}), ());
+
+  // Old snapshots are not changed by edits.
+  TEST_EQUAL(Search("cherry", before), Ids({10}), ());
+  TEST_EQUAL(before->GetNumDocs(), 2, ());
+}
+
+UNIT_CLASS_TEST(BookmarksProcessorTest, IncrementalAndBulkEdits)
+{
+  Add(10, {"Double R Diner" /* name */, "Cherry pie" /* description */});
+  TEST_EQUAL(Search("cherry"), Ids({10}), ());
+
+  // There are few edits, so they're applied to the index of the previous snapshot.
+  Erase(10);
+  Add(10, {"Double R Diner" /* name */, "Coffee" /* description */});
+  Add(20, {"Great Northern Hotel" /* name */, "Great place" /* description */});
+  Erase(20);
+  TEST(Search("cherry").empty(), ());
+  TEST(Search("great").empty(), ());
+  TEST_EQUAL(Search("coffee"), Ids({10}), ());
+
+  // There are too many edits, so the index is bulk-loaded.
+  Ids sawmills;
+  for (Id id = 100; id <= 100 + Snapshot::Builder::kMaxIncrementalEdits; ++id)
+  {
+    Add(id, {"Packard Sawmill" /* name */, "Cherry trees around" /* description */});
+    sawmills.push_back(id);
+  }
+  Erase(10);
+
+  auto const snapshot = GetSnapshot();
+  TEST_EQUAL(snapshot->GetNumDocs(), sawmills.size(), ());
+  TEST(Search("coffee").empty(), ());
+  auto ids = Search("cherry");
+  sort(ids.begin(), ids.end());
+  TEST_EQUAL(ids, sawmills, ());
+}
 }  // namespace
@@ -0,0 +1,53 @@
+#include "testing/testing.hpp"
+
+#include "search/geometry_utils.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+double GetArea(vector<m2::RectD> const & rects)
+{
+  double area = 0.0;
+  for (auto const & rect : rects)
+    area += rect.SizeX() * rect.SizeY();
+  return area;
+}
+
+UNIT_TEST(SubtractRect_Disjoint)
+{
+  m2::RectD const rect(0, 0, 1, 1);
+  vector<m2::RectD> parts;
+  SubtractRect(rect, m2::RectD(2, 2, 3, 3), parts);
+  TEST_EQUAL(parts, vector<m2::RectD>({rect}), ());
+}
+
+UNIT_TEST(SubtractRect_Inside)
+{
+  vector<m2::RectD> parts;
+  SubtractRect(m2::RectD(1, 1, 2, 2), m2::RectD(0, 0, 3, 3), parts);
+  TEST(parts.empty(), (parts));
+
+  SubtractRect(m2::RectD(0, 0, 3, 3), m2::RectD(1, 1, 2, 2), parts);
+  TEST_EQUAL(parts.size(), 4, (parts));
+  TEST_ALMOST_EQUAL_ULPS(GetArea(parts), 8.0, (parts));
+}
+
+UNIT_TEST(SubtractRect_Shift)
+{
+  vector<m2::RectD> parts;
+  SubtractRect(m2::RectD(1, 0, 3, 2), m2::RectD(0, 0, 2, 2), parts);
+  TEST_EQUAL(parts, vector<m2::RectD>({m2::RectD(2, 0, 3, 2)}), ());
+
+  SubtractRect(m2::RectD(1, 1, 3, 3), m2::RectD(0, 0, 2, 2), parts);
+  TEST_EQUAL(parts.size(), 2, (parts));
+  TEST_ALMOST_EQUAL_ULPS(GetArea(parts), 3.0, (parts));
+  for (auto const & part : parts)
+    TEST(m2::RectD(1, 1, 3, 3).IsRectInside(part), (part));
+}
+}  // namespace
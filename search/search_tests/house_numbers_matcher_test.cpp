@@ -142,6 +142,26 @@ UNIT_TEST(HouseNumbersMatcher_Smoke)
   TEST(HouseNumbersMatch("14 д 1", "дом 14 д1"), ());
 }
 
+UNIT_TEST(HouseNumbersMatcher_ParsedHouseNumber)
+{
+  ParsedHouseNumber const houseNumber(MakeUniString("10 корпус 2 строение 2"));
+  auto const match = [&houseNumber](string const & query) {
+    vector<Token> queryParse;
+    ParseQuery(MakeUniString(query), false /* queryIsPrefix */, queryParse);
+    return search::house_numbers::HouseNumbersMatch(houseNumber, queryParse);
+  };
+
+  // The same parses are used for all the queries.
+  TEST(match("10"), ());
+  TEST(match("10 к2 с2"), ());
+  TEST(match("10к2с2"), ());
+  TEST(!match("7"), ());
+  TEST(!match("10 с 3"), ());
+  TEST(!match(""), ());
+
+  TEST(!search::house_numbers::HouseNumbersMatch(ParsedHouseNumber(), vector<Token>{}), ());
+}
+
 UNIT_TEST(LooksLikeHouseNumber_Smoke)
 {
   TEST(LooksLikeHouseNumber("1", false /* isPrefix */), ());
@@ -0,0 +1,82 @@
+#include "testing/testing.hpp"
+
+#include "search/localities_index.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/stl_helpers.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+using Buffer = vector<uint8_t>;
+
+vector<uint32_t> GetFeatureIds(LocalitiesIndex const & index, m2::RectD const & rect)
+{
+  vector<uint32_t> ids;
+  index.ForEachInRect(rect, [&ids](uint32_t id) { ids.push_back(id); });
+  base::SortUnique(ids);
+  return ids;
+}
+
+UNIT_TEST(LocalitiesIndex_Smoke)
+{
+  double const cell = LocalitiesIndex::kCellSizeMercator;
+
+  Buffer buffer;
+  {
+    LocalitiesIndexBuilder builder;
+    builder.Put(5 /* featureId */, m2::PointD(10.01, 20.01));
+    builder.Put(3 /* featureId */, m2::PointD(10.01 + cell, 20.01));
+    builder.Put(7 /* featureId */, m2::PointD(10.02, 20.02));
+    builder.Put(1 /* featureId */, m2::PointD(-179.99, -179.99));
+    builder.Put(9 /* featureId */, m2::PointD(179.99, 179.99));
+
+    MemWriter<Buffer> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto const index = LocalitiesIndex::Load(reader);
+  TEST(index, ());
+
+  TEST_EQUAL(GetFeatureIds(*index, m2::RectD(10.0, 20.0, 10.015, 20.015)), vector<uint32_t>({5}),
+             ());
+  TEST_EQUAL(GetFeatureIds(*index, m2::RectD(10.0, 20.0, 10.03, 20.03)),
+             vector<uint32_t>({5, 7}), ());
+  TEST_EQUAL(GetFeatureIds(*index, m2::RectD(10.0, 20.0, 10.1, 20.1)),
+             vector<uint32_t>({3, 5, 7}), ());
+  TEST_EQUAL(GetFeatureIds(*index, m2::RectD(10.03, 20.03, 10.05, 20.05)), vector<uint32_t>(),
+             ());
+  TEST_EQUAL(GetFeatureIds(*index, m2::RectD(-180.0, -180.0, 180.0, 180.0)),
+             vector<uint32_t>({1, 3, 5, 7, 9}), ());
+}
+
+UNIT_TEST(LocalitiesIndex_Empty)
+{
+  Buffer buffer;
+  {
+    LocalitiesIndexBuilder builder;
+    MemWriter<Buffer> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto const index = LocalitiesIndex::Load(reader);
+  TEST(index, ());
+  TEST(GetFeatureIds(*index, m2::RectD(-180.0, -180.0, 180.0, 180.0)).empty(), ());
+
+  // Truncated indices are not loaded.
+  MemReader truncated(buffer.data(), buffer.size() - 1);
+  TEST(!LocalitiesIndex::Load(truncated), ());
+}
+}  // namespace
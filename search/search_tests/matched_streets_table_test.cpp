@@ -0,0 +1,84 @@
+#include "testing/testing.hpp"
+
+#include "search/matched_streets_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+using Buffer = vector<uint8_t>;
+
+UNIT_TEST(MatchedStreetsTable_Smoke)
+{
+  Buffer buffer;
+  {
+    MatchedStreetsTableBuilder builder;
+    builder.Put(0 /* houseId */, 10 /* streetId */);
+    builder.Put(2 /* houseId */, MatchedStreetsTable::kNoStreet);
+    builder.Put(3 /* houseId */, 0 /* streetId */);
+    builder.Put(100 /* houseId */, 123456789 /* streetId */);
+
+    MemWriter<Buffer> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto const table = MatchedStreetsTable::Load(reader);
+  TEST(table, ());
+
+  uint32_t streetId;
+  TEST(table->Get(0, streetId), ());
+  TEST_EQUAL(streetId, 10, ());
+  TEST(!table->Get(1, streetId), ());
+  TEST(table->Get(2, streetId), ());
+  TEST_EQUAL(streetId, MatchedStreetsTable::kNoStreet, ());
+  TEST(table->Get(3, streetId), ());
+  TEST_EQUAL(streetId, 0, ());
+  for (uint32_t houseId = 4; houseId < 100; ++houseId)
+    TEST(!table->Get(houseId, streetId), (houseId));
+  TEST(table->Get(100, streetId), ());
+  TEST_EQUAL(streetId, 123456789, ());
+  TEST(!table->Get(101, streetId), ());
+}
+
+UNIT_TEST(MatchedStreetsTable_AllWidths)
+{
+  for (uint32_t bits = 2; bits < 32; ++bits)
+  {
+    uint32_t const maxStreetId = (static_cast<uint32_t>(1) << bits) - 1;
+
+    Buffer buffer;
+    {
+      MatchedStreetsTableBuilder builder;
+      for (uint32_t houseId = 0; houseId < 50; ++houseId)
+        builder.Put(houseId, maxStreetId - houseId % 3);
+      MemWriter<Buffer> writer(buffer);
+      builder.Freeze(writer);
+    }
+
+    MemReader reader(buffer.data(), buffer.size());
+    auto const table = MatchedStreetsTable::Load(reader);
+    TEST(table, (bits));
+    for (uint32_t houseId = 0; houseId < 50; ++houseId)
+    {
+      uint32_t streetId;
+      TEST(table->Get(houseId, streetId), (bits, houseId));
+      TEST_EQUAL(streetId, maxStreetId - houseId % 3, (bits, houseId));
+    }
+  }
+}
+
+UNIT_TEST(MatchedStreetsTable_Broken)
+{
+  Buffer const buffer = {1, 5, 0, 0, 0, 0};
+  MemReader reader(buffer.data(), buffer.size());
+  TEST(!MatchedStreetsTable::Load(reader), ());
+}
+}  // namespace
@@ -110,4 +110,30 @@ UNIT_CLASS_TEST(MemSearchIndexTest, Smoke)
   Erase(kHamlet, hamlet);
   TEST_EQUAL(StrictQuery("question", "en"), vector<Id>{}, ());
 }
+
+UNIT_CLASS_TEST(MemSearchIndexTest, Builder)
+{
+  Id const kHamlet{31337};
+  Id const kMacbeth{600613};
+  Id const kOthello{1604};
+  Doc const hamlet{"To be or not to be: that is the question...", "en"};
+  Doc const macbeth{"When shall we three meet again? In thunder, lightning, or in rain? ...", "en"};
+  Doc const othello{"Rude am I in my speech", "en"};
+
+  Index::Builder builder;
+  builder.Add(kMacbeth, macbeth);
+  builder.Add(kOthello, othello);
+  builder.Add(kHamlet, hamlet);
+  m_index = builder.Build();
+
+  TEST_EQUAL(StrictQuery("Thunder", "en"), vector<Id>({kMacbeth}), ());
+  TEST_EQUAL(StrictQuery("in", "en"), vector<Id>({kOthello, kMacbeth}), ());
+  TEST_EQUAL(StrictQuery("or", "en"), vector<Id>({kHamlet, kMacbeth}), ());
+  TEST_EQUAL(StrictQuery("to be or not to be", "en"), vector<Id>({kHamlet}), ());
+  TEST_EQUAL(m_index.GetAllIds(), vector<Id>({kOthello, kHamlet, kMacbeth}), ());
+
+  // The built index may be changed as usual.
+  Erase(kMacbeth, macbeth);
+  TEST_EQUAL(StrictQuery("in", "en"), vector<Id>({kOthello}), ());
+}
 }  // namespace
@@ -0,0 +1,187 @@
+#include "testing/benchmark.hpp"
+#include "testing/testing.hpp"
+
+#include "search/feature_offset_match.hpp"
+#include "search/search_index_values.hpp"
+#include "search/search_trie.hpp"
+
+#include "indexer/packed_trie_builder.hpp"
+#include "indexer/packed_trie_reader.hpp"
+#include "indexer/trie_builder.hpp"
+#include "indexer/trie_reader.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/reader.hpp"
+
+#include "base/levenshtein_dfa.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace search;
+using namespace std;
+using namespace strings;
+
+namespace
+{
+using Key = UniString;
+using Value = FeatureIndexValue;
+using Serializer = SingleValueSerializer<Value>;
+using KeyValuePairs = vector<pair<Key, Value>>;
+
+int8_t const kLangs[] = {0, 1, 7};
+
+// Search index of |featuresCount| features, every feature has a random word of latin or
+// cyrillic letters in every language of kLangs and a category.
+KeyValuePairs MakeIndex(uint32_t featuresCount)
+{
+  mt19937 rng(0);
+  uniform_int_distribution<uint32_t> length(2, 10);
+  uniform_int_distribution<uint32_t> letter(0, 25);
+  uniform_int_distribution<uint32_t> category(0, 50);
+
+  KeyValuePairs pairs;
+  for (uint32_t id = 0; id < featuresCount; ++id)
+  {
+    for (auto const lang : kLangs)
+    {
+      Key key(1, static_cast<UniChar>(lang));
+      UniChar const base = lang == 7 ? 0x430 : 'a';
+      for (uint32_t i = length(rng); i > 0; --i)
+        key.push_back(base + letter(rng));
+      pairs.emplace_back(key, Value(id));
+    }
+
+    Key key(1, search::kCategoriesLang);
+    key.push_back('c');
+    key.push_back(static_cast<UniChar>('0' + category(rng)));
+    pairs.emplace_back(key, Value(id));
+  }
+  sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+class Tries
+{
+public:
+  explicit Tries(KeyValuePairs const & pairs)
+  {
+    {
+      PushBackByteSink<vector<uint8_t>> sink(m_data);
+      trie::Build<PushBackByteSink<vector<uint8_t>>, Key, ValueList<Value>, Serializer>(
+          sink, m_serializer, pairs);
+      reverse(m_data.begin(), m_data.end());
+    }
+    {
+      PushBackByteSink<vector<uint8_t>> sink(m_packedData);
+      trie::BuildPacked<PushBackByteSink<vector<uint8_t>>, Key, ValueList<Value>, Serializer>(
+          sink, m_serializer, pairs);
+    }
+  }
+
+  unique_ptr<trie::Iterator<ValueList<Value>>> GetRoot() const
+  {
+    return trie::ReadTrie<MemReader, ValueList<Value>>(MemReader(m_data.data(), m_data.size()),
+                                                       m_serializer);
+  }
+
+  trie::PackedTrieIterator<ValueList<Value>, Serializer> GetPackedRoot() const
+  {
+    return trie::ReadPackedTrie<ValueList<Value>>(m_packedData.data(), m_packedData.size(),
+                                                  m_serializer);
+  }
+
+  size_t GetSize() const { return m_data.size(); }
+  size_t GetPackedSize() const { return m_packedData.size(); }
+
+private:
+  Serializer m_serializer;
+  vector<uint8_t> m_data;
+  vector<uint8_t> m_packedData;
+};
+
+template <typename DFA, typename Trie>
+vector<uint64_t> Match(SearchTrieRequest<DFA> const & request, Trie const & trie)
+{
+  vector<uint64_t> ids;
+  MatchFeaturesInTrie(request, trie, [](Value const & /* value */) { return true; } /* filter */,
+                      [&ids](Value const & value) { ids.push_back(value.m_featureId); });
+  sort(ids.begin(), ids.end());
+  return ids;
+}
+
+vector<UniString> MakeQueries(KeyValuePairs const & pairs, size_t count)
+{
+  vector<UniString> queries;
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto const & key = pairs[(i * 7919) % pairs.size()].first;
+    if (key[0] < search::kCategoriesLang)
+      queries.emplace_back(key.begin() + 1, key.end());
+  }
+  return queries;
+}
+}  // namespace
+
+UNIT_TEST(PackedTrie_MatchFeaturesInTrie)
+{
+  auto const pairs = MakeIndex(1000 /* featuresCount */);
+  Tries const tries(pairs);
+  auto const root = tries.GetRoot();
+  auto const packedRoot = tries.GetPackedRoot();
+
+  for (auto const & query : MakeQueries(pairs, 200 /* count */))
+  {
+    SearchTrieRequest<LevenshteinDFA> request;
+    request.m_names.emplace_back(query, 1 /* maxErrors */);
+    request.m_categories.emplace_back(MakeUniString("c7"));
+    request.SetLangs(kLangs);
+
+    auto const expected = Match(request, *root);
+    TEST(!expected.empty(), (query));
+    TEST_EQUAL(Match(request, packedRoot), expected, (query));
+
+    SearchTrieRequest<PrefixDFAModifier<LevenshteinDFA>> prefixRequest;
+    prefixRequest.m_names.emplace_back(LevenshteinDFA(query, 0 /* maxErrors */));
+    prefixRequest.SetLangs(kLangs);
+    TEST_EQUAL(Match(prefixRequest, packedRoot), Match(prefixRequest, *root), (query));
+  }
+}
+
+BENCHMARK_TEST(PackedTrie_MatchFeaturesInTrie)
+{
+  auto const pairs = MakeIndex(100000 /* featuresCount */);
+  Tries const tries(pairs);
+  auto const root = tries.GetRoot();
+  auto const packedRoot = tries.GetPackedRoot();
+
+  vector<SearchTrieRequest<LevenshteinDFA>> requests;
+  for (auto const & query : MakeQueries(pairs, 1000 /* count */))
+  {
+    requests.emplace_back();
+    requests.back().m_names.emplace_back(query, 1 /* maxErrors */);
+    requests.back().SetLangs(kLangs);
+  }
+
+  auto const run = [&requests](auto const & trie) {
+    base::Timer timer;
+    size_t matched = 0;
+    for (auto const & request : requests)
+      matched += Match(request, trie).size();
+    return make_pair(timer.ElapsedSeconds(), matched);
+  };
+
+  auto const iterator0 = run(*root);
+  auto const packed = run(packedRoot);
+  TEST_EQUAL(iterator0.second, packed.second, ());
+
+  cout << "Iterator0: " << iterator0.first << "s, " << tries.GetSize()
+       << " bytes; packed trie: " << packed.first << "s, " << tries.GetPackedSize()
+       << " bytes ...";
+}
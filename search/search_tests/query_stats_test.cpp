@@ -0,0 +1,47 @@
+#include "testing/testing.hpp"
+
+#include "search/query_stats.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+using Phase = QueryStats::Phase;
+
+UNIT_TEST(QueryStats_FollowingPhasesAreExcluded)
+{
+  QueryStats stats;
+  {
+    QueryStats::ScopedTimer geocoding(&stats, Phase::Geocoding);
+    {
+      QueryStats::ScopedTimer preRanking(&stats, Phase::PreRanking);
+      {
+        QueryStats::ScopedTimer ranking(&stats, Phase::Ranking);
+        this_thread::sleep_for(chrono::milliseconds(50));
+      }
+    }
+  }
+
+  TEST_GREATER_OR_EQUAL(stats.GetNs(Phase::Ranking), 50 * 1000 * 1000, ());
+  // The nested phases take almost all the time.
+  TEST_LESS(stats.GetNs(Phase::PreRanking), 25 * 1000 * 1000, ());
+  TEST_LESS(stats.GetNs(Phase::Geocoding), 25 * 1000 * 1000, ());
+  TEST_EQUAL(stats.GetNs(Phase::Tokenization), 0, ());
+  TEST_EQUAL(stats.GetNs(Phase::Retrieval), 0, ());
+}
+
+UNIT_TEST(QueryStats_Add)
+{
+  QueryStats stats;
+  stats.Add(Phase::Retrieval, 10);
+  stats.Add(Phase::Retrieval, 5);
+  TEST_EQUAL(stats.GetNs(Phase::Retrieval), 15, ());
+
+  // Timers without stats do nothing.
+  QueryStats::ScopedTimer timer(nullptr /* stats */, Phase::Retrieval);
+}
+}  // namespace
@@ -0,0 +1,53 @@
+#include "testing/testing.hpp"
+
+#include "search/suggest.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+vector<string> GetCompletions(SuggestsIndex const & index, string const & prefix, int8_t locale)
+{
+  vector<string> completions;
+  index.ForEachCompletion(strings::MakeUniString(prefix), locale, [&](Suggest const & suggest) {
+    completions.push_back(strings::ToUtf8(suggest.m_name));
+  });
+  return completions;
+}
+
+UNIT_TEST(SuggestsIndex_ForEachCompletion)
+{
+  int8_t const kEn = 1;
+  int8_t const kRu = 2;
+
+  vector<Suggest> suggests;
+  suggests.emplace_back(strings::MakeUniString("cafe"), 1, kEn);
+  suggests.emplace_back(strings::MakeUniString("cinema"), 1, kEn);
+  suggests.emplace_back(strings::MakeUniString("car wash"), 3, kEn);
+  suggests.emplace_back(strings::MakeUniString("caravan site"), 1, kEn);
+  suggests.emplace_back(strings::MakeUniString("атм"), 1, kRu);
+  suggests.emplace_back(strings::MakeUniString("cafe"), 1, kRu);
+  suggests.emplace_back(strings::MakeUniString("bar"), 1, kEn);
+
+  SuggestsIndex const index(move(suggests));
+  TEST_EQUAL(index.GetSize(), 7, ());
+
+  TEST_EQUAL(GetCompletions(index, "c", kEn), vector<string>({"cafe", "caravan site", "cinema"}),
+             ());
+  TEST_EQUAL(GetCompletions(index, "car", kEn), vector<string>({"car wash", "caravan site"}), ());
+  TEST_EQUAL(GetCompletions(index, "ca", kRu), vector<string>({"cafe"}), ());
+  TEST_EQUAL(GetCompletions(index, "а", kRu), vector<string>({"атм"}), ());
+
+  // Suggests which are equal to the prefix are not passed.
+  TEST_EQUAL(GetCompletions(index, "cafe", kEn), vector<string>(), ());
+  TEST_EQUAL(GetCompletions(index, "d", kEn), vector<string>(), ());
+  TEST_EQUAL(GetCompletions(index, "c", 3 /* locale */), vector<string>(), ());
+}
+}  // namespace
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <iterator>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -75,6 +76,27 @@ void TestForEach(Index const & index, Token const & token, vector<uint32_t> cons
   index.ForEachPosting(token, base::MakeBackInsertFunctor(actual));
   TEST_EQUAL(actual, expected, (token));
 };
+
+// Returns |count| increasing postings, gaps between postings are random up to |maxGap|.
+vector<uint32_t> MakePostings(size_t count, uint32_t maxGap, mt19937 & rng)
+{
+  uniform_int_distribution<uint32_t> gap(1, maxGap);
+  vector<uint32_t> postings;
+  uint32_t p = gap(rng) - 1;
+  for (size_t i = 0; i < count; ++i)
+  {
+    postings.push_back(p);
+    p += gap(rng);
+  }
+  return postings;
+}
+
+void Serialize(MemTextIndex & memIndex, vector<uint8_t> & buf)
+{
+  buf.clear();
+  MemWriter<vector<uint8_t>> writer(buf);
+  memIndex.Serialize(writer);
+}
 }  // namespace
 
 namespace search
@@ -200,4 +222,200 @@ UNIT_TEST(TextIndex_Merging)
     TestForEach(textIndexReader3, "e", {2});
   }
 }
+
+UNIT_TEST(TextIndex_LongPostingsLists)
+{
+  mt19937 rng(0);
+  // Lists are shorter and longer than a block, the gaps make blocks with
+  // and without low bits.
+  vector<pair<Token, vector<uint32_t>>> const lists = {
+      {"empty", {}},
+      {"one", {0}},
+      {"short", MakePostings(kMinBlockedPostings - 1, 1000 /* maxGap */, rng)},
+      {"blocked", MakePostings(kMinBlockedPostings, 1000 /* maxGap */, rng)},
+      {"dense", MakePostings(10 * kPostingsBlockSize, 1 /* maxGap */, rng)},
+      {"sparse", MakePostings(3 * kPostingsBlockSize + 1, 100000 /* maxGap */, rng)},
+      {"mixed", MakePostings(5 * kPostingsBlockSize + 17, 3 /* maxGap */, rng)},
+  };
+
+  MemTextIndex memIndex;
+  for (auto const & list : lists)
+  {
+    for (auto const p : list.second)
+      memIndex.AddPosting(list.first, p);
+  }
+
+  vector<uint8_t> indexData;
+  MemTextIndex deserializedMemIndex;
+  Serdes(memIndex, deserializedMemIndex, indexData);
+  TextIndexReader const reader(indexData.data() + kSkip, indexData.size() - kSkip);
+
+  for (auto const & list : lists)
+  {
+    TestForEach(deserializedMemIndex, list.first, list.second);
+    TestForEach(reader, list.first, list.second);
+    TEST_EQUAL(reader.GetPostings(list.first).GetCount(), list.second.size(), (list.first));
+
+    auto const & postings = list.second;
+    for (size_t step : {1, 7, 100, 300})
+    {
+      auto it = reader.GetPostings(list.first);
+      for (size_t i = 0; i < postings.size(); i += step)
+      {
+        // Postings in between are skipped both when they are in the current block
+        // and when they are in the next ones.
+        it.SkipTo(postings[i]);
+        TEST(it.IsValid(), (list.first, i));
+        TEST_EQUAL(it.Get(), postings[i], (list.first, i));
+        if (postings[i] > 0 && (i == 0 || postings[i - 1] + 1 < postings[i]))
+        {
+          auto it2 = reader.GetPostings(list.first);
+          it2.SkipTo(postings[i] - 1);
+          TEST(it2.IsValid(), (list.first, i));
+          TEST_EQUAL(it2.Get(), postings[i], (list.first, i));
+        }
+      }
+      if (!postings.empty())
+      {
+        it.SkipTo(postings.back() + 1);
+        TEST(!it.IsValid(), (list.first));
+      }
+    }
+  }
+}
+
+UNIT_TEST(TextIndex_Dictionary)
+{
+  // Tokens share prefixes within and across the blocks of the dictionary.
+  vector<Token> tokens;
+  for (char c = 'a'; c <= 'z'; ++c)
+  {
+    tokens.push_back(string(1, c));
+    for (size_t i = 0; i < 7; ++i)
+      tokens.push_back(string(1, c) + "ba" + string(i, 'c'));
+  }
+  sort(tokens.begin(), tokens.end());
+
+  MemTextIndex memIndex;
+  for (size_t i = 0; i < tokens.size(); ++i)
+    memIndex.AddPosting(tokens[i], static_cast<uint32_t>(i));
+
+  vector<uint8_t> indexData;
+  MemTextIndex deserializedMemIndex;
+  Serdes(memIndex, deserializedMemIndex, indexData);
+  TextIndexReader const reader(indexData.data() + kSkip, indexData.size() - kSkip);
+
+  vector<Token> actual;
+  reader.GetDictionary().ForEachToken([&actual](Token const & token) { actual.push_back(token); });
+  TEST_EQUAL(actual, tokens, ());
+  TEST_EQUAL(reader.GetDictionary().GetTokensCount(), tokens.size(), ());
+
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    size_t id = 0;
+    TEST(reader.GetDictionary().GetTokenId(tokens[i], id), (tokens[i]));
+    TEST_EQUAL(id, i, (tokens[i]));
+    TestForEach(reader, tokens[i], {static_cast<uint32_t>(i)});
+    TestForEach(deserializedMemIndex, tokens[i], {static_cast<uint32_t>(i)});
+
+    // Absent tokens before, in between and after the tokens of the dictionary.
+    for (auto const & absent : {tokens[i] + "b", tokens[i] + "d", tokens[i] + "ca"})
+    {
+      if (!binary_search(tokens.begin(), tokens.end(), absent))
+        TEST(!reader.GetDictionary().GetTokenId(absent, id), (absent));
+    }
+  }
+  size_t id = 0;
+  TEST(!reader.GetDictionary().GetTokenId("0", id), ());
+  TEST(!reader.GetDictionary().GetTokenId("zz", id), ());
+}
+
+UNIT_TEST(TextIndex_CommonPostings)
+{
+  mt19937 rng(0);
+  vector<uint32_t> const postings1 = MakePostings(20 * kPostingsBlockSize, 2 /* maxGap */, rng);
+  vector<uint32_t> const postings2 = MakePostings(3 * kPostingsBlockSize, 20 /* maxGap */, rng);
+  vector<uint32_t> const postings3 = MakePostings(10, 500 /* maxGap */, rng);
+
+  MemTextIndex memIndex;
+  for (auto const p : postings1)
+    memIndex.AddPosting("a", p);
+  for (auto const p : postings2)
+    memIndex.AddPosting("b", p);
+  for (auto const p : postings3)
+    memIndex.AddPosting("c", p);
+
+  vector<uint8_t> indexData;
+  Serialize(memIndex, indexData);
+  TextIndexReader const reader(indexData.data(), indexData.size());
+
+  auto const intersect = [](vector<uint32_t> const & lhs, vector<uint32_t> const & rhs) {
+    vector<uint32_t> result;
+    set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), back_inserter(result));
+    return result;
+  };
+  auto const common = [&reader](vector<Token> const & tokens) {
+    vector<uint32_t> result;
+    reader.ForEachCommonPosting(tokens, base::MakeBackInsertFunctor(result));
+    return result;
+  };
+
+  TEST_EQUAL(common({"a"}), postings1, ());
+  TEST_EQUAL(common({"a", "b"}), intersect(postings1, postings2), ());
+  TEST_EQUAL(common({"c", "b", "a"}), intersect(intersect(postings1, postings2), postings3), ());
+  TEST_EQUAL(common({"a", "x"}), vector<uint32_t>(), ());
+  TEST_EQUAL(common({}), vector<uint32_t>(), ());
+}
+
+UNIT_TEST(TextIndex_MergingMany)
+{
+  mt19937 rng(0);
+  uniform_int_distribution<uint32_t> tokenDist(0, 999);
+  uniform_int_distribution<uint32_t> postingDist(0, 99999);
+
+  size_t const kIndexesCount = 3;
+  MemTextIndex expected;
+  vector<vector<uint8_t>> indexesData(kIndexesCount);
+  vector<TextIndexReader> readers;
+  for (size_t i = 0; i < kIndexesCount; ++i)
+  {
+    MemTextIndex memIndex;
+    for (size_t j = 0; j < 20000; ++j)
+    {
+      auto const token = "t" + strings::to_string(tokenDist(rng));
+      auto const posting = postingDist(rng);
+      memIndex.AddPosting(token, posting);
+      expected.AddPosting(token, posting);
+    }
+    Serialize(memIndex, indexesData[i]);
+    readers.emplace_back(indexesData[i].data(), indexesData[i].size());
+  }
+
+  vector<TextIndexReader const *> indexes;
+  for (auto const & reader : readers)
+    indexes.push_back(&reader);
+
+  vector<uint8_t> expectedData;
+  Serialize(expected, expectedData);
+  TextIndexReader const expectedReader(expectedData.data(), expectedData.size());
+
+  for (size_t threadsCount : {1, 4})
+  {
+    ScopedFile file("text_index_tmp", ScopedFile::Mode::Create);
+    {
+      FileWriter fileWriter(file.GetFullPath());
+      TextIndexMerger::Merge(indexes, fileWriter, threadsCount);
+    }
+
+    FileReader fileReader(file.GetFullPath());
+    TextIndexReader merged(fileReader);
+    expectedReader.GetDictionary().ForEachToken([&](Token const & token) {
+      vector<uint32_t> postings;
+      expectedReader.ForEachPosting(token, base::MakeBackInsertFunctor(postings));
+      TestForEach(merged, token, postings);
+    });
+    TEST_EQUAL(merged.GetDictionary().GetTokensCount(),
+               expectedReader.GetDictionary().GetTokensCount(), ());
+  }
+}
 }  // namespace search
@@ -0,0 +1,97 @@
+#include "testing/testing.hpp"
+
+#include "search/token_features_cache.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+TokenFeaturesCache::Features MakeFeatures(vector<uint64_t> const & positions)
+{
+  return coding::CompressedBitVectorBuilder::FromBitPositions(positions);
+}
+
+bool HasFeatures(TokenFeaturesCache::Features const & features, vector<uint64_t> const & positions)
+{
+  if (!features || features->PopCount() != positions.size())
+    return false;
+
+  for (auto const position : positions)
+  {
+    if (!features->GetBit(position))
+      return false;
+  }
+  return true;
+}
+
+UNIT_TEST(TokenFeaturesCache_LeastRecentlyUsedIsEvicted)
+{
+  MwmSet::MwmId const id(make_shared<MwmInfo>());
+
+  // Every entry takes about 200 bytes.
+  TokenFeaturesCache cache(500 /* maxSize */);
+  cache.Put(id, "a", MakeFeatures({1, 2}));
+  cache.Put(id, "b", MakeFeatures({3, 4}));
+  TEST(cache.Get(id, "a"), ());
+
+  cache.Put(id, "c", MakeFeatures({5, 6}));
+  TEST(!cache.Get(id, "b"), ());
+
+  TEST(HasFeatures(cache.Get(id, "a"), {1, 2}), ());
+  TEST(cache.Get(id, "c"), ());
+  TEST_LESS_OR_EQUAL(cache.GetSize(), 500, ());
+
+  // Too big entries are not cached.
+  vector<uint64_t> positions(100);
+  for (size_t i = 0; i < positions.size(); ++i)
+    positions[i] = 100 * i;
+  cache.Put(id, "d", MakeFeatures(positions));
+  TEST(!cache.Get(id, "d"), ());
+  TEST(cache.Get(id, "a"), ());
+}
+
+UNIT_TEST(TokenFeaturesCache_Deregistration)
+{
+  MwmSet::MwmId const first(make_shared<MwmInfo>());
+  MwmSet::MwmId const second(make_shared<MwmInfo>());
+
+  TokenFeaturesCache cache(10000 /* maxSize */);
+  cache.Put(first, "a", MakeFeatures({1}));
+  cache.Put(second, "a", MakeFeatures({2}));
+  TEST(HasFeatures(cache.Get(first, "a"), {1}), ());
+  TEST(HasFeatures(cache.Get(second, "a"), {2}), ());
+
+  // Both infos have the default local file.
+  cache.OnMapDeregistered(platform::LocalCountryFile());
+  TEST(!cache.Get(first, "a"), ());
+  TEST(!cache.Get(second, "a"), ());
+  TEST_EQUAL(cache.GetSize(), 0, ());
+}
+
+UNIT_TEST(TokenFeaturesCache_Stats)
+{
+  MwmSet::MwmId const id(make_shared<MwmInfo>());
+
+  TokenFeaturesCache cache(10000 /* maxSize */);
+  TEST(!cache.Get(id, "a"), ());
+  cache.Put(id, "a", MakeFeatures({1}));
+  TEST(cache.Get(id, "a"), ());
+  TEST(cache.Get(id, "a"), ());
+  TEST(!cache.Get(id, "b"), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_numHits, 2, ());
+  TEST_EQUAL(stats.m_numMisses, 2, ());
+}
+}  // namespace
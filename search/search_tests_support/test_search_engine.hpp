@@ -28,6 +28,13 @@ public:
 
   std::weak_ptr<search::ProcessorHandle> Search(search::SearchParams const & params);
 
+  TokenFeaturesCache const * GetTokenFeaturesCache() const
+  {
+    return m_engine.GetTokenFeaturesCache();
+  }
+
+  Engine::Metrics GetMetrics() const { return m_engine.GetMetrics(); }
+
   storage::CountryInfoGetter & GetCountryInfoGetter() { return *m_infoGetter; }
 
 private:
@@ -7,12 +7,40 @@
 
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
 #include <vector>
 
 using namespace std;
 
 namespace search
 {
+namespace
+{
+bool Less(Suggest const & lhs, int8_t locale, strings::UniString const & name)
+{
+  if (lhs.m_locale != locale)
+    return lhs.m_locale < locale;
+  return lhs.m_name < name;
+}
+}  // namespace
+
+// SuggestsIndex -----------------------------------------------------------------------------------
+SuggestsIndex::SuggestsIndex(vector<Suggest> && suggests) : m_suggests(move(suggests))
+{
+  sort(m_suggests.begin(), m_suggests.end(), [](Suggest const & lhs, Suggest const & rhs) {
+    return Less(lhs, rhs.m_locale, rhs.m_name);
+  });
+}
+
+vector<Suggest>::const_iterator SuggestsIndex::LowerBound(strings::UniString const & name,
+                                                          int8_t locale) const
+{
+  return lower_bound(m_suggests.begin(), m_suggests.end(), name,
+                     [locale](Suggest const & lhs, strings::UniString const & rhs) {
+                       return Less(lhs, locale, rhs);
+                     });
+}
+
 void GetSuggestion(RankerResult const & res, string const & query, QueryTokens const & paramTokens,
                    strings::UniString const & prefix, string & suggest)
 {
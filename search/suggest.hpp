@@ -7,6 +7,8 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace search
 {
@@ -22,6 +24,37 @@ struct Suggest
   int8_t m_locale;
 };
 
+// Suggests sorted by locales and names, so completions of a prefix in a locale are
+// a contiguous range which is found by a binary search.
+class SuggestsIndex
+{
+public:
+  SuggestsIndex() = default;
+  explicit SuggestsIndex(std::vector<Suggest> && suggests);
+
+  // Calls |fn| for suggests in |locale| which start with |prefix| and differ from it,
+  // when |prefix| is long enough to suggest them. Suggests are passed in order of names.
+  template <typename Fn>
+  void ForEachCompletion(strings::UniString const & prefix, int8_t locale, Fn && fn) const
+  {
+    for (auto it = LowerBound(prefix, locale);
+         it != m_suggests.end() && it->m_locale == locale && strings::StartsWith(it->m_name, prefix);
+         ++it)
+    {
+      if (it->m_prefixLength <= prefix.size() && it->m_name != prefix)
+        fn(*it);
+    }
+  }
+
+  size_t GetSize() const { return m_suggests.size(); }
+
+private:
+  std::vector<Suggest>::const_iterator LowerBound(strings::UniString const & name,
+                                                  int8_t locale) const;
+
+  std::vector<Suggest> m_suggests;
+};
+
 void GetSuggestion(RankerResult const & res, string const & query, QueryTokens const & paramTokens,
                    strings::UniString const & prefix, std::string & suggest);
 }  // namespace search
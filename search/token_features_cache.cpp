@@ -0,0 +1,98 @@
+#include "search/token_features_cache.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "base/assert.hpp"
+
+using namespace std;
+
+namespace
+{
+// Approximate size of the list node, the map node and the shared bit vector header.
+size_t constexpr kEntryOverhead = 160;
+}  // namespace
+
+namespace search
+{
+TokenFeaturesCache::TokenFeaturesCache(size_t maxSize) : m_cache(maxSize) {}
+
+TokenFeaturesCache::Features TokenFeaturesCache::Get(MwmSet::MwmId const & mwmId,
+                                                     string const & key)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const * features = m_cache.Find(make_pair(mwmId, key));
+  if (!features)
+  {
+    ++m_stats.m_numMisses;
+    return nullptr;
+  }
+
+  ++m_stats.m_numHits;
+  return *features;
+}
+
+void TokenFeaturesCache::Put(MwmSet::MwmId const & mwmId, string const & key, Features features)
+{
+  CHECK(features, ());
+
+  Key fullKey(mwmId, key);
+  size_t const size = GetSize(fullKey, *features);
+
+  lock_guard<mutex> lock(m_mutex);
+  m_cache.Put(fullKey, move(features), size);
+}
+
+void TokenFeaturesCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_cache.Clear();
+}
+
+size_t TokenFeaturesCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_cache.GetMemorySize();
+}
+
+TokenFeaturesCache::Stats TokenFeaturesCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_stats;
+}
+
+void TokenFeaturesCache::OnMapUpdated(platform::LocalCountryFile const & /* newFile */,
+                                      platform::LocalCountryFile const & oldFile)
+{
+  RemoveCountry(oldFile);
+}
+
+void TokenFeaturesCache::OnMapDeregistered(platform::LocalCountryFile const & localFile)
+{
+  RemoveCountry(localFile);
+}
+
+// static
+size_t TokenFeaturesCache::GetSize(Key const & key, coding::CompressedBitVector const & features)
+{
+  size_t size = kEntryOverhead + 2 * key.second.size();
+  switch (features.GetStorageStrategy())
+  {
+  case coding::CompressedBitVector::StorageStrategy::Dense:
+    size += static_cast<coding::DenseCBV const &>(features).NumBitGroups() * sizeof(uint64_t);
+    break;
+  case coding::CompressedBitVector::StorageStrategy::Sparse:
+    size += features.PopCount() * sizeof(uint64_t);
+    break;
+  }
+  return size;
+}
+
+void TokenFeaturesCache::RemoveCountry(platform::LocalCountryFile const & localFile)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_cache.EraseIf([&localFile](Key const & key) {
+    auto const & info = key.first.GetInfo();
+    return !info || info->GetLocalFile().GetCountryName() == localFile.GetCountryName();
+  });
+}
+}  // namespace search
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "base/memory_lru_cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace platform
+{
+class LocalCountryFile;
+}
+
+namespace search
+{
+// LRU cache of features matched in search indices of mwms by query tokens. It's shared
+// between queries and search threads and is thread-safe.
+//
+// Features are kept as they are in the search index, i.e. without edits of the editor
+// which are applied by Retrieval on every retrieval. So the cache is invalidated only when
+// a map is updated or deregistered.
+class TokenFeaturesCache : public MwmSet::Observer
+{
+public:
+  using Features = std::shared_ptr<coding::CompressedBitVector const>;
+
+  struct Stats
+  {
+    uint64_t m_numHits = 0;
+    uint64_t m_numMisses = 0;
+  };
+
+  // |maxSize| is an approximate limit of the memory used by the cache in bytes.
+  explicit TokenFeaturesCache(size_t maxSize);
+
+  // Returns nullptr when there are no features cached for |key| in |mwmId|.
+  // |key| should uniquely identify the retrieval request.
+  Features Get(MwmSet::MwmId const & mwmId, std::string const & key);
+
+  void Put(MwmSet::MwmId const & mwmId, std::string const & key, Features features);
+
+  void Clear();
+
+  size_t GetSize() const;
+
+  // Returns the numbers of hits and misses of Get() since the construction of the cache.
+  Stats GetStats() const;
+
+  // MwmSet::Observer overrides:
+  void OnMapUpdated(platform::LocalCountryFile const & newFile,
+                    platform::LocalCountryFile const & oldFile) override;
+  void OnMapDeregistered(platform::LocalCountryFile const & localFile) override;
+
+private:
+  using Key = std::pair<MwmSet::MwmId, std::string>;
+
+  static size_t GetSize(Key const & key, coding::CompressedBitVector const & features);
+
+  void RemoveCountry(platform::LocalCountryFile const & localFile);
+
+  mutable std::mutex m_mutex;
+  base::MemoryLruCache<Key, Features> m_cache;
+  Stats m_stats;
+};
+}  // namespace search
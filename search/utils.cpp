@@ -1,5 +1,6 @@
 #include "search/utils.hpp"
 
+#include "search/cancel_exception.hpp"
 #include "search/categories_cache.hpp"
 #include "search/features_filter.hpp"
 #include "search/geometry_cache.hpp"
@@ -10,6 +11,10 @@
 #include "base/cancellable.hpp"
 
 #include <cctype>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 using namespace std;
@@ -26,6 +31,48 @@ vector<strings::UniString> const kAllowedMisprints = {
     strings::MakeUniString("еиэ"),
     strings::MakeUniString("шщ"),
 };
+
+// A DFA depends only on its token, so DFAs of frequent tokens are built once and shared
+// between queries and threads. The oldest DFAs are evicted first.
+class LevenshteinDFACache
+{
+public:
+  static size_t constexpr kMaxSize = 1024;
+
+  strings::LevenshteinDFA Get(strings::UniString const & s)
+  {
+    auto key = strings::ToUtf8(s);
+    {
+      lock_guard<mutex> lock(m_mutex);
+      auto const it = m_dfas.find(key);
+      if (it != m_dfas.end())
+        return it->second;
+    }
+
+    // DFAs are built without the lock as it takes much more time than copying.
+    strings::LevenshteinDFA dfa(s, 1 /* prefixSize */, kAllowedMisprints,
+                                search::GetMaxErrorsForToken(s));
+
+    lock_guard<mutex> lock(m_mutex);
+    if (m_dfas.count(key) != 0)
+      return dfa;
+
+    if (m_dfas.size() >= kMaxSize)
+    {
+      m_dfas.erase(m_order.front());
+      m_order.pop_front();
+    }
+    m_order.push_back(key);
+    m_dfas.emplace(move(key), dfa);
+    return dfa;
+  }
+
+private:
+  mutex m_mutex;
+  unordered_map<string, strings::LevenshteinDFA> m_dfas;
+  // Keys of |m_dfas| in the order they were added.
+  deque<string> m_order;
+};
 }  // namespace
 
 namespace search
@@ -47,7 +94,8 @@ strings::LevenshteinDFA BuildLevenshteinDFA(strings::UniString const & s)
   // In search we use LevenshteinDFAs for fuzzy matching. But due to
   // performance reasons, we limit prefix misprints to fixed set of substitutions defined in
   // kAllowedMisprints and skipped letters.
-  return strings::LevenshteinDFA(s, 1 /* prefixSize */, kAllowedMisprints, GetMaxErrorsForToken(s));
+  static LevenshteinDFACache cache;
+  return cache.Get(s);
 }
 
 vector<uint32_t> GetCategoryTypes(string const & name, string const & locale,
@@ -94,11 +142,18 @@ MwmSet::MwmHandle FindWorld(DataSource const & dataSource)
 
 void ForEachOfTypesInRect(DataSource const & dataSource, vector<uint32_t> const & types,
                           m2::RectD const & pivot, FeatureIndexCallback const & fn)
+{
+  base::Cancellable const cancellable;
+  ForEachOfTypesInRect(dataSource, types, pivot, cancellable, fn);
+}
+
+void ForEachOfTypesInRect(DataSource const & dataSource, vector<uint32_t> const & types,
+                          m2::RectD const & pivot, base::Cancellable const & cancellable,
+                          FeatureIndexCallback const & fn)
 {
   vector<shared_ptr<MwmInfo>> infos;
   dataSource.GetMwmsInfo(infos);
 
-  base::Cancellable const cancellable;
   CategoriesCache cache(types, cancellable);
   auto pivotRectsCache = PivotRectsCache(1 /* maxNumEntries */, cancellable,
                                          max(pivot.SizeX(), pivot.SizeY()) /* maxRadiusMeters */);
@@ -108,6 +163,8 @@ void ForEachOfTypesInRect(DataSource const & dataSource, vector<uint32_t> const
     if (!pivot.IsIntersect(info->m_bordersRect))
       continue;
 
+    BailIfCancelled(cancellable);
+
     auto handle = dataSource.GetMwmHandleById(MwmSet::MwmId(info));
     auto & value = *handle.GetValue<MwmValue>();
     if (!value.HasSearchIndex())
@@ -13,6 +13,7 @@
 
 #include "geometry/rect2d.hpp"
 
+#include "base/cancellable.hpp"
 #include "base/levenshtein_dfa.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
@@ -98,20 +99,16 @@ bool FillCategories(QuerySliceOnRawStrings<T> const & slice, Locales const & loc
         if (!locales.Contains(static_cast<uint64_t>(categorySynonym.m_locale)))
           return;
 
-        std::vector<QueryParams::String> categoryTokens;
-        SplitUniString(search::NormalizeAndSimplifyString(categorySynonym.m_name),
-                       base::MakeBackInsertFunctor(categoryTokens), search::Delimiters());
+        auto const name = search::NormalizeAndSimplifyString(categorySynonym.m_name);
+        size_t i = 0;
+        bool matches = true;
+        SplitUniStringToViews(name, [&](strings::UniStringView const & token) {
+          matches = matches && i < slice.Size() && token == slice.Get(i);
+          ++i;
+        }, search::Delimiters());
 
-        if (slice.Size() != categoryTokens.size())
-          return;
-
-        for (size_t i = 0; i < slice.Size(); ++i)
-        {
-          if (slice.Get(i) != categoryTokens[i])
-            return;
-        }
-
-        types.push_back(type);
+        if (matches && i == slice.Size())
+          types.push_back(type);
       });
 
   return !types.empty();
@@ -130,4 +127,8 @@ using FeatureIndexCallback = std::function<void(FeatureID const &)>;
 // Applies |fn| to each feature index of type from |types| in |rect|.
 void ForEachOfTypesInRect(DataSource const & dataSource, std::vector<uint32_t> const & types,
                           m2::RectD const & rect, FeatureIndexCallback const & fn);
+// The same as above but throws CancelException when |cancellable| is cancelled.
+void ForEachOfTypesInRect(DataSource const & dataSource, std::vector<uint32_t> const & types,
+                          m2::RectD const & rect, base::Cancellable const & cancellable,
+                          FeatureIndexCallback const & fn);
 }  // namespace search
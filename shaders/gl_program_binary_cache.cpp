@@ -0,0 +1,79 @@
+#include "shaders/gl_program_binary_cache.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+namespace gpu
+{
+namespace
+{
+uint32_t constexpr kVersion = 0;
+}  // namespace
+
+GLProgramBinaryCache::GLProgramBinaryCache(std::string const & dir, std::string const & driverId)
+  : m_dir(dir), m_driverId(driverId)
+{
+}
+
+bool GLProgramBinaryCache::Load(std::string const & programName, uint64_t sourceHash,
+                                uint32_t & format, std::vector<uint8_t> & binary) const
+{
+  try
+  {
+    FileReader reader(GetFilePath(programName));
+    ReaderSource<FileReader> src(reader);
+    if (ReadPrimitiveFromSource<uint32_t>(src) != kVersion)
+      return false;
+
+    std::string driverId;
+    rw::Read(src, driverId);
+    if (driverId != m_driverId || ReadPrimitiveFromSource<uint64_t>(src) != sourceHash)
+      return false;
+
+    format = ReadPrimitiveFromSource<uint32_t>(src);
+    auto const size = ReadVarUint<uint32_t>(src);
+    if (size == 0 || size > src.Size())
+      return false;
+
+    binary.resize(size);
+    src.Read(binary.data(), binary.size());
+    return true;
+  }
+  catch (RootException const &)
+  {
+    // There is no binary yet or the file is damaged.
+    return false;
+  }
+}
+
+void GLProgramBinaryCache::Save(std::string const & programName, uint64_t sourceHash,
+                                uint32_t format, std::vector<uint8_t> const & binary) const
+{
+  try
+  {
+    FileWriter writer(GetFilePath(programName));
+    WriteToSink(writer, kVersion);
+    rw::Write(writer, m_driverId);
+    WriteToSink(writer, sourceHash);
+    WriteToSink(writer, format);
+    rw::WriteVectorOfPOD(writer, binary);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't save binary of program", programName, e.Msg()));
+  }
+}
+
+std::string GLProgramBinaryCache::GetFilePath(std::string const & programName) const
+{
+  return base::JoinPath(m_dir, programName + ".bin");
+}
+}  // namespace gpu
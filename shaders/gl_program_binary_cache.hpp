@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gpu
+{
+// Keeps binaries of linked GL programs in files of |dir|, so programs are not compiled and
+// linked from sources on every start. A binary is valid only for the driver it is retrieved
+// from and for the sources it is compiled from, so both are checked on loading.
+class GLProgramBinaryCache
+{
+public:
+  // |driverId| identifies the GL driver, e.g. its vendor, renderer and version.
+  GLProgramBinaryCache(std::string const & dir, std::string const & driverId);
+
+  // Returns false if there is no binary of |programName| compiled from sources with
+  // |sourceHash| by the driver.
+  bool Load(std::string const & programName, uint64_t sourceHash, uint32_t & format,
+            std::vector<uint8_t> & binary) const;
+  void Save(std::string const & programName, uint64_t sourceHash, uint32_t format,
+            std::vector<uint8_t> const & binary) const;
+
+private:
+  std::string GetFilePath(std::string const & programName) const;
+
+  std::string const m_dir;
+  std::string const m_driverId;
+};
+}  // namespace gpu
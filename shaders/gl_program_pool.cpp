@@ -5,6 +5,12 @@
 #include "drape/gl_gpu_program.hpp"
 #include "drape/gl_functions.hpp"
 
+#include "base/logging.hpp"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
 namespace gpu
 {
 GLProgramPool::GLProgramPool(dp::ApiVersion apiVersion)
@@ -31,13 +37,42 @@ GLProgramPool::~GLProgramPool()
 drape_ptr<dp::GpuProgram> GLProgramPool::Get(Program program)
 {
   auto const programInfo = GetProgramInfo(m_apiVersion, program);
+  auto const name = DebugPrint(program);
+
+  uint64_t sourceHash = 0;
+  if (m_binaryCache)
+  {
+    sourceHash = std::hash<std::string>()(m_baseDefines + m_defines +
+                                          programInfo.m_vertexShaderSource +
+                                          programInfo.m_fragmentShaderSource);
+    uint32_t format = 0;
+    std::vector<uint8_t> binary;
+    if (m_binaryCache->Load(name, sourceHash, format, binary))
+    {
+      auto const programID = GLFunctions::glCreateProgram();
+      if (GLFunctions::glProgramBinary(programID, format, binary))
+        return make_unique_dp<dp::GLGpuProgram>(name, programID);
+
+      // The binary is rejected by the driver, so the program is compiled from sources.
+      LOG(LINFO, ("Binary of program", name, "is rejected"));
+      GLFunctions::glDeleteProgram(programID);
+    }
+  }
+
   auto vertexShader = GetShader(programInfo.m_vertexShaderName, programInfo.m_vertexShaderSource,
                                 dp::Shader::Type::VertexShader);
   auto fragmentShader = GetShader(programInfo.m_fragmentShaderName, programInfo.m_fragmentShaderSource,
                                   dp::Shader::Type::FragmentShader);
 
-  auto const name = DebugPrint(program);
-  return make_unique_dp<dp::GLGpuProgram>(name, vertexShader, fragmentShader);
+  auto result = make_unique_dp<dp::GLGpuProgram>(name, vertexShader, fragmentShader);
+  if (m_binaryCache)
+  {
+    glConst format = 0;
+    std::vector<uint8_t> binary;
+    if (GLFunctions::glGetProgramBinary(result->GetID(), format, binary))
+      m_binaryCache->Save(name, sourceHash, format, binary);
+  }
+  return result;
 }
 
 void GLProgramPool::SetDefines(std::string const & defines)
@@ -45,6 +80,11 @@ void GLProgramPool::SetDefines(std::string const & defines)
   m_defines = defines;
 }
 
+void GLProgramPool::SetBinaryCache(drape_ptr<GLProgramBinaryCache> && cache)
+{
+  m_binaryCache = std::move(cache);
+}
+
 ref_ptr<dp::Shader> GLProgramPool::GetShader(std::string const & name, std::string const & source,
                                              dp::Shader::Type type)
 {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "shaders/gl_program_binary_cache.hpp"
 #include "shaders/program_pool.hpp"
 
 #include "drape/drape_global.hpp"
@@ -21,6 +22,8 @@ public:
   drape_ptr<dp::GpuProgram> Get(Program program) override;
 
   void SetDefines(std::string const & defines);
+  // Linked programs are saved to |cache| and loaded from it instead of compilation.
+  void SetBinaryCache(drape_ptr<GLProgramBinaryCache> && cache);
 
 private:
   ref_ptr<dp::Shader> GetShader(std::string const & name, std::string const & source,
@@ -32,5 +35,6 @@ private:
   using Shaders = std::map<std::string, drape_ptr<dp::Shader>>;
   Shaders m_shaders;
   std::string m_defines;
+  drape_ptr<GLProgramBinaryCache> m_binaryCache;
 };
 }  // namespace gpu
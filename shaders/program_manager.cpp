@@ -4,6 +4,10 @@
 #include "drape/gl_functions.hpp"
 #include "drape/support_manager.hpp"
 
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+
 #include "base/logging.hpp"
 
 #include "std/target_os.hpp"
@@ -13,6 +17,11 @@
 
 namespace gpu
 {
+namespace
+{
+char const * const kProgramBinaryCacheDir = "gl_programs";
+}  // namespace
+
 void ProgramManager::Init(ref_ptr<dp::GraphicsContext> context)
 {
   auto const apiVersion = context->GetApiVersion();
@@ -56,6 +65,19 @@ void ProgramManager::InitForOpenGL(ref_ptr<dp::GraphicsContext> context)
   m_pool = make_unique_dp<GLProgramPool>(apiVersion);
   ref_ptr<GLProgramPool> pool = make_ref(m_pool);
   pool->SetDefines(globalDefines);
+
+  // Program binaries are a part of OpenGL ES 3.0.
+  if (apiVersion == dp::ApiVersion::OpenGLES3)
+  {
+    auto const cacheDir = base::JoinPath(GetPlatform().TmpDir(), kProgramBinaryCacheDir);
+    if (Platform::MkDirChecked(cacheDir))
+    {
+      auto const driverId = GLFunctions::glGetString(gl_const::GLVendor) + "|" +
+                            GLFunctions::glGetString(gl_const::GLRenderer) + "|" +
+                            GLFunctions::glGetString(gl_const::GLVersion);
+      pool->SetBinaryCache(make_unique_dp<GLProgramBinaryCache>(cacheDir, driverId));
+    }
+  }
   
   m_paramsSetter = make_unique_dp<GLProgramParamsSetter>();
 }
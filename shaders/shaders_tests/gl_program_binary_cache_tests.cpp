@@ -0,0 +1,45 @@
+#include "testing/testing.hpp"
+
+#include "shaders/gl_program_binary_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+UNIT_TEST(GLProgramBinaryCache_SaveLoad)
+{
+  std::string const dir = GetPlatform().TmpDir();
+  std::string const programName = "GLProgramBinaryCacheTestProgram";
+  std::string const filePath = base::JoinPath(dir, programName + ".bin");
+  uint64_t const sourceHash = 12345;
+  std::vector<uint8_t> const binary = {7, 0, 255, 1, 2, 3};
+
+  gpu::GLProgramBinaryCache const cache(dir, "Vendor|Renderer|Version");
+  uint32_t format = 0;
+  std::vector<uint8_t> loaded;
+  TEST(!cache.Load(programName, sourceHash, format, loaded), ());
+
+  cache.Save(programName, sourceHash, 42 /* format */, binary);
+  TEST(cache.Load(programName, sourceHash, format, loaded), ());
+  TEST_EQUAL(format, 42, ());
+  TEST_EQUAL(loaded, binary, ());
+
+  // Binaries of other sources and other drivers are not loaded.
+  TEST(!cache.Load(programName, sourceHash + 1, format, loaded), ());
+  gpu::GLProgramBinaryCache const otherDriverCache(dir, "Vendor|Renderer|OtherVersion");
+  TEST(!otherDriverCache.Load(programName, sourceHash, format, loaded), ());
+
+  // A damaged file is not loaded.
+  FileWriter::DeleteFileX(filePath);
+  {
+    FileWriter writer(filePath);
+    writer.Write(binary.data(), 3);
+  }
+  TEST(!cache.Load(programName, sourceHash, format, loaded), ());
+  FileWriter::DeleteFileX(filePath);
+}
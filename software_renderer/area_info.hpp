@@ -1,6 +1,7 @@
 #pragma once
 
 #include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
 
 #include "std/vector.hpp"
 #include "std/algorithm.hpp"
@@ -35,6 +36,14 @@ public:
 
   void SetCenter(m2::PointD const & p) { m_center = p; }
   m2::PointD GetCenter() const { return m_center; }
+
+  m2::RectD GetLimitRect() const
+  {
+    m2::RectD rect;
+    for (size_t i = 0; i < m_path.size(); ++i)
+      rect.Add(m_path[i]);
+    return rect;
+  }
 };
 
 }
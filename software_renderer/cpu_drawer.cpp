@@ -13,8 +13,10 @@
 
 #include "base/macros.hpp"
 #include "base/logging.hpp"
+#include "base/thread.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/bind.hpp"
 
 namespace
@@ -85,11 +87,13 @@ FeatureID const & InsertImpl(FeatureID const & id, map<FeatureID, TInfo> & map,
   return id;
 }
 
+// Geometry is read by several threads while areas and paths are rendered, so |m| is not modified.
 template<typename TInfo>
-TInfo const & GetInfo(FeatureID const & id, map<FeatureID, TInfo> & m)
+TInfo const & GetInfo(FeatureID const & id, map<FeatureID, TInfo> const & m)
 {
-  ASSERT(m.find(id) != m.end(), ());
-  return m[id];
+  auto const it = m.find(id);
+  ASSERT(it != m.end(), ());
+  return it->second;
 }
 
 }
@@ -175,6 +179,7 @@ private:
 CPUDrawer::CPUDrawer(Params const & params)
   : m_generationCounter(0)
   , m_visualScale(params.m_visualScale)
+  , m_threadsCount(max(params.m_threadsCount, size_t(1)))
 {
   auto glyphParams = GlyphCache::Params("unicode_blocks.txt",
                                         "fonts_whitelist.txt",
@@ -507,7 +512,13 @@ void CPUDrawer::Render()
     }
   };
 
-  for_each(m_areaPathShapes.begin(), m_areaPathShapes.end(), renderFn);
+  if (m_threadsCount > 1)
+    RenderAreasAndPaths();
+  else
+    for_each(m_areaPathShapes.begin(), m_areaPathShapes.end(), renderFn);
+
+  // Overlays are rendered on the calling thread because texts share the text engine and the glyph
+  // cache, there are much less pixels of them than of areas and paths.
   CPUOverlayTree tree;
   for_each(m_overlayList.begin(), m_overlayList.end(), [&tree](OverlayWrapper const & oe)
   {
@@ -526,6 +537,78 @@ void CPUDrawer::Render()
   });
 }
 
+void CPUDrawer::RenderAreasAndPaths()
+{
+  // Rows of the frame are split into bands which are taken by the threads one by one, so dense
+  // parts of the frame don't keep one thread busy while the others are idle. A band has its own
+  // clip box and draws the shapes crossing it in the order of |m_areaPathShapes|, so the result
+  // differs from drawing on a single thread only by rounding of edges clipped by the band.
+  uint32_t constexpr kBandHeight = 64;
+
+  struct ShapeToDraw
+  {
+    ComplexShape const * m_shape = nullptr;
+    m2::RectD m_rect;
+    PenInfo m_pen;
+    BrushInfo m_brush;
+  };
+
+  vector<ShapeToDraw> shapes;
+  shapes.reserve(m_areaPathShapes.size());
+  for (auto const & shape : m_areaPathShapes)
+  {
+    ShapeToDraw s;
+    s.m_shape = &shape;
+    if (shape.m_type == TYPE_PATH)
+    {
+      ASSERT(shape.m_drawRule.m_rule->GetLine() != nullptr, ());
+      ConvertStyle(shape.m_drawRule.m_rule->GetLine(), m_visualScale, s.m_pen);
+      s.m_rect = GetInfo(shape.m_geomID, m_pathGeometry).GetLimitRect();
+      // Miter joins may stick out by the doubled width of a line with the default miter limit.
+      s.m_rect.Inflate(2.0 * s.m_pen.m_w + 1.0, 2.0 * s.m_pen.m_w + 1.0);
+    }
+    else
+    {
+      ASSERT_EQUAL(shape.m_type, TYPE_AREA, ());
+      ASSERT(shape.m_drawRule.m_rule->GetArea() != nullptr, ());
+      ConvertStyle(shape.m_drawRule.m_rule->GetArea(), s.m_brush);
+      s.m_rect = GetInfo(shape.m_geomID, m_areasGeometry).GetLimitRect();
+      s.m_rect.Inflate(1.0, 1.0);
+    }
+    shapes.push_back(move(s));
+  }
+
+  uint32_t const frameHeight = static_cast<uint32_t>(m_renderer->FrameRect().SizeY());
+  uint32_t const bandsCount = (frameHeight + kBandHeight - 1) / kBandHeight;
+  atomic<uint32_t> nextBand(0);
+  auto const renderBands = [&]()
+  {
+    for (uint32_t band = nextBand++; band < bandsCount; band = nextBand++)
+    {
+      SoftwareRenderer::FrameBand frameBand(*m_renderer, band * kBandHeight,
+                                            min(frameHeight, (band + 1) * kBandHeight));
+      for (auto const & s : shapes)
+      {
+        if (!s.m_rect.IsIntersect(frameBand.GetRect()))
+          continue;
+
+        if (s.m_shape->m_type == TYPE_PATH)
+          frameBand.DrawPath(GetInfo(s.m_shape->m_geomID, m_pathGeometry), s.m_pen);
+        else
+          frameBand.DrawArea(GetInfo(s.m_shape->m_geomID, m_areasGeometry), s.m_brush);
+      }
+    }
+  };
+
+  vector<threads::SimpleThread> threads;
+  size_t const threadsCount = min(m_threadsCount, static_cast<size_t>(bandsCount));
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(renderBands);
+  renderBands();
+  for (auto & thread : threads)
+    thread.join();
+}
+
 void CPUDrawer::DrawSymbol(PointShape const * shape)
 {
   ASSERT(shape->m_type == TYPE_SYMBOL, ());
@@ -31,6 +31,8 @@ public:
 
     string m_resourcesPrefix;
     double m_visualScale;
+    // Number of threads which rasterize areas and paths of a frame.
+    size_t m_threadsCount = 1;
   };
 
   CPUDrawer(Params const & params);
@@ -80,6 +82,7 @@ protected:
 
 private:
   void Render();
+  void RenderAreasAndPaths();
 
 private:
   unique_ptr<SoftwareRenderer> m_renderer;
@@ -212,6 +215,7 @@ private:
   dp::FontDecl m_roadNumberFont;
 
   double m_visualScale;
+  size_t m_threadsCount;
 
   FeatureID m_currentFeatureID;
 };
@@ -264,14 +264,16 @@ inline agg::line_join_e translateLineJoin(dp::LineJoin line_join)
   return agg::bevel_join;
 }
 
-void SoftwareRenderer::DrawPath(PathInfo const & geometry, PenInfo const & info)
+// Draws a path clipped by |clipRect|, which should be inside the clip box of |baseRenderer|.
+void DrawPathImpl(PathInfo const & geometry, PenInfo const & info, m2::RectD const & clipRect,
+                  SoftwareRenderer::TBaseRenderer & baseRenderer)
 {
   if (!info.m_icon.m_name.empty())
     return;
 
   //@TODO (yershov) implement it
   agg::rasterizer_scanline_aa<> rasterizer;
-  rasterizer.clip_box(0, 0, m_frameWidth, m_frameHeight);
+  rasterizer.clip_box(clipRect.minX(), clipRect.minY(), clipRect.maxX(), clipRect.maxY());
   typedef agg::poly_container_adaptor<vector<m2::PointD>> path_t;
   path_t path_adaptor(geometry.m_path, false);
   typedef agg::conv_stroke<path_t> stroke_t;
@@ -303,19 +305,15 @@ void SoftwareRenderer::DrawPath(PathInfo const & geometry, PenInfo const & info)
   agg::scanline32_p8 scanline;
   agg::rgba8 color(info.m_color.GetRed(), info.m_color.GetGreen(),
                    info.m_color.GetBlue(), info.m_color.GetAlpha());
-  agg::render_scanlines_aa_solid(rasterizer, scanline, m_baseRenderer, color);
-}
-
-void SoftwareRenderer::DrawPath(PathWrapper & path, math::Matrix<double, 3, 3> const & m)
-{
-  agg::trans_affine aggM(m(0, 0), m(0, 1), m(1, 0), m(1, 1), m(2, 0), m(2, 1));
-  path.Render(m_solidRenderer, aggM, FrameRect());
+  agg::render_scanlines_aa_solid(rasterizer, scanline, baseRenderer, color);
 }
 
-void SoftwareRenderer::DrawArea(AreaInfo const & geometry, BrushInfo const & info)
+// Draws an area clipped by |clipRect|, which should be inside the clip box of |baseRenderer|.
+void DrawAreaImpl(AreaInfo const & geometry, BrushInfo const & info, m2::RectD const & clipRect,
+                  SoftwareRenderer::TBaseRenderer & baseRenderer)
 {
   agg::rasterizer_scanline_aa<> rasterizer;
-  rasterizer.clip_box(0, 0, m_frameWidth, m_frameHeight);
+  rasterizer.clip_box(clipRect.minX(), clipRect.minY(), clipRect.maxX(), clipRect.maxY());
 
   agg::path_storage path;
   for (size_t i = 2; i < geometry.m_path.size(); i += 3)
@@ -333,15 +331,31 @@ void SoftwareRenderer::DrawArea(AreaInfo const & geometry, BrushInfo const & inf
   bool antialias = false;
   if (antialias)
   {
-    agg::render_scanlines_aa_solid(rasterizer, scanline, m_baseRenderer, color);
+    agg::render_scanlines_aa_solid(rasterizer, scanline, baseRenderer, color);
   }
   else
   {
     rasterizer.filling_rule(agg::fill_even_odd);
-    agg::render_scanlines_bin_solid(rasterizer, scanline, m_baseRenderer, color);
+    agg::render_scanlines_bin_solid(rasterizer, scanline, baseRenderer, color);
   }
 }
 
+void SoftwareRenderer::DrawPath(PathInfo const & geometry, PenInfo const & info)
+{
+  DrawPathImpl(geometry, info, FrameRect(), m_baseRenderer);
+}
+
+void SoftwareRenderer::DrawPath(PathWrapper & path, math::Matrix<double, 3, 3> const & m)
+{
+  agg::trans_affine aggM(m(0, 0), m(0, 1), m(1, 0), m(1, 1), m(2, 0), m(2, 1));
+  path.Render(m_solidRenderer, aggM, FrameRect());
+}
+
+void SoftwareRenderer::DrawArea(AreaInfo const & geometry, BrushInfo const & info)
+{
+  DrawAreaImpl(geometry, info, FrameRect(), m_baseRenderer);
+}
+
 void SoftwareRenderer::DrawText(m2::PointD const & pt, dp::Anchor anchor, dp::FontDecl const & primFont, strings::UniString const & primText)
 {
   //@TODO (yershov) implement it
@@ -589,6 +603,27 @@ m2::RectD SoftwareRenderer::FrameRect() const
   return m2::RectD(0.0, 0.0, m_frameWidth, m_frameHeight);
 }
 
+SoftwareRenderer::FrameBand::FrameBand(SoftwareRenderer & renderer, uint32_t minY, uint32_t maxY)
+  : m_pixelFormat(renderer.m_renderBuffer, BLENDER_TYPE)
+  , m_baseRenderer(m_pixelFormat)
+  , m_rect(0.0, minY, renderer.m_frameWidth, maxY)
+{
+  ASSERT_LESS(minY, maxY, ());
+  ASSERT_LESS_OR_EQUAL(maxY, renderer.m_frameHeight, ());
+  m_baseRenderer.clip_box(0, static_cast<int>(minY), static_cast<int>(renderer.m_frameWidth) - 1,
+                          static_cast<int>(maxY) - 1);
+}
+
+void SoftwareRenderer::FrameBand::DrawPath(PathInfo const & geometry, PenInfo const & info)
+{
+  DrawPathImpl(geometry, info, m_rect, m_baseRenderer);
+}
+
+void SoftwareRenderer::FrameBand::DrawArea(AreaInfo const & geometry, BrushInfo const & info)
+{
+  DrawAreaImpl(geometry, info, m_rect, m_baseRenderer);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <class VertexSource> class conv_count
@@ -14,6 +14,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include "base/macros.hpp"
 #include "base/string_utils.hpp"
 
 #include "3party/agg/agg_rendering_buffer.h"
@@ -113,6 +114,27 @@ public:
   using TPrimitivesRenderer = agg::renderer_primitives<TBaseRenderer>;
   using TSolidRenderer = agg::renderer_scanline_aa_solid<TBaseRenderer>;
 
+  /// \brief Rows [minY, maxY) of the current frame. Paths and areas of different bands may be
+  /// drawn on different threads, texts and symbols may not because they use the text engine and
+  /// the glyph cache. A band must not outlive the frame.
+  class FrameBand
+  {
+  public:
+    FrameBand(SoftwareRenderer & renderer, uint32_t minY, uint32_t maxY);
+
+    void DrawPath(PathInfo const & geometry, PenInfo const & info);
+    void DrawArea(AreaInfo const & geometry, BrushInfo const & info);
+
+    m2::RectD const & GetRect() const { return m_rect; }
+
+  private:
+    TPixelFormat m_pixelFormat;
+    TBaseRenderer m_baseRenderer;
+    m2::RectD m_rect;
+
+    DISALLOW_COPY_AND_MOVE(FrameBand);
+  };
+
 private:
   unique_ptr<GlyphCache> m_glyphCache;
   map<string, m2::RectU> m_symbolsIndex;
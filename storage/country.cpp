@@ -4,12 +4,17 @@
 #include "platform/platform.hpp"
 
 #include "coding/reader.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
 
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 
 #include "3party/jansson/myjansson.hpp"
 
+#include <deque>
 #include <utility>
 
 using namespace std;
@@ -111,6 +116,191 @@ public:
     return map<TCountryId, TCountriesSet>();
   }
 };
+
+// Compiled form of single mwm countries.txt, which is loaded without parsing of json:
+//   [kCompiledTag] [1: compiled version] [8: countries version]
+//   [vu: strings count] [strings]
+//   [vu: nodes count] [nodes in the preorder]
+//   [vu: affiliations count] [affiliations]
+//   [vu: old mwms count] [old mwms]
+// A node is [vu: id] [vu: depth] [vu: mwm size] [vu: subtree mwms] [vu: subtree size].
+// An affiliation is [vu: affiliation] [vu: countries count] [vu: country id]...
+// An old mwm is [vu: old id] [vu: new ids count] [vu: new id]...
+// All the strings are written as indices in the strings table.
+char const kCompiledTag[] = "MWM_COUNTRIES";
+size_t constexpr kCompiledTagSize = sizeof(kCompiledTag) - 1;
+uint8_t constexpr kCompiledVersion = 0;
+
+bool IsCompiled(string const & buffer)
+{
+  return buffer.compare(0, kCompiledTagSize, kCompiledTag) == 0;
+}
+
+class StoreCompiledSingleMwms : public StoreSingleMwmInterface
+{
+  struct Node
+  {
+    Node(Country const & country, size_t depth) : m_country(country), m_depth(depth) {}
+
+    Country m_country;
+    size_t m_depth;
+  };
+
+  // Pointers to countries are kept by callers until subtree attributes are set.
+  deque<Node> m_nodes;
+  TMappingAffiliations m_affiliations;
+  TMappingOldMwm m_idsMapping;
+
+public:
+  // StoreSingleMwmInterface overrides:
+  Country * InsertToCountryTree(TCountryId const & id, TMwmSize mapSize, size_t depth,
+                                TCountryId const & parent) override
+  {
+    Country country(id, parent);
+    if (mapSize)
+    {
+      CountryFile countryFile(id);
+      countryFile.SetRemoteSizes(mapSize, 0 /* routingSize */);
+      country.SetFile(countryFile);
+    }
+    m_nodes.emplace_back(country, depth);
+    return &m_nodes.back().m_country;
+  }
+
+  void InsertOldMwmMapping(TCountryId const & newId, TCountryId const & oldId) override
+  {
+    m_idsMapping[oldId].insert(newId);
+  }
+
+  void InsertAffiliation(TCountryId const & countryId, string const & affilation) override
+  {
+    m_affiliations[affilation].push_back(countryId);
+  }
+
+  TMappingOldMwm GetMapping() const override { return m_idsMapping; }
+
+  void Serialize(int64_t version, Writer & writer)
+  {
+    vector<string> strings;
+    map<string, uint32_t> indices;
+    auto const getIndex = [&](string const & s) {
+      auto const result = indices.emplace(s, static_cast<uint32_t>(strings.size()));
+      if (result.second)
+        strings.push_back(s);
+      return result.first->second;
+    };
+
+    vector<uint8_t> body;
+    {
+      MemWriter<vector<uint8_t>> sink(body);
+      WriteVarUint(sink, static_cast<uint64_t>(m_nodes.size()));
+      for (auto const & node : m_nodes)
+      {
+        auto const & country = node.m_country;
+        WriteVarUint(sink, getIndex(country.Name()));
+        WriteVarUint(sink, static_cast<uint64_t>(node.m_depth));
+        WriteVarUint(sink, country.GetFile().GetRemoteSize(MapOptions::Map));
+        WriteVarUint(sink, country.GetSubtreeMwmCounter());
+        WriteVarUint(sink, country.GetSubtreeMwmSizeBytes());
+      }
+
+      WriteVarUint(sink, static_cast<uint64_t>(m_affiliations.size()));
+      for (auto & entry : m_affiliations)
+      {
+        base::SortUnique(entry.second);
+        WriteVarUint(sink, getIndex(entry.first));
+        WriteVarUint(sink, static_cast<uint64_t>(entry.second.size()));
+        for (auto const & countryId : entry.second)
+          WriteVarUint(sink, getIndex(countryId));
+      }
+
+      WriteVarUint(sink, static_cast<uint64_t>(m_idsMapping.size()));
+      for (auto const & entry : m_idsMapping)
+      {
+        WriteVarUint(sink, getIndex(entry.first));
+        WriteVarUint(sink, static_cast<uint64_t>(entry.second.size()));
+        for (auto const & newId : entry.second)
+          WriteVarUint(sink, getIndex(newId));
+      }
+    }
+
+    writer.Write(kCompiledTag, kCompiledTagSize);
+    WriteToSink(writer, kCompiledVersion);
+    WriteToSink(writer, version);
+    WriteVarUint(writer, static_cast<uint64_t>(strings.size()));
+    for (auto const & str : strings)
+      rw::Write(writer, str);
+    writer.Write(body.data(), body.size());
+  }
+};
+
+// Passes the compiled countries from |buffer| to |store|, returns version of the countries or -1.
+int64_t LoadCompiledSingleMwmsImpl(string const & buffer, StoreSingleMwmInterface & store)
+{
+  try
+  {
+    MemReaderWithExceptions reader(buffer.data(), buffer.size());
+    ReaderSource<MemReaderWithExceptions> src(reader);
+    src.Skip(kCompiledTagSize);
+    auto const compiledVersion = ReadPrimitiveFromSource<uint8_t>(src);
+    if (compiledVersion != kCompiledVersion)
+    {
+      LOG(LWARNING, ("Unknown version of compiled countries:", compiledVersion));
+      return -1;
+    }
+    auto const version = ReadPrimitiveFromSource<int64_t>(src);
+
+    vector<string> strings(ReadVarUint<uint64_t>(src));
+    for (auto & str : strings)
+      rw::Read(src, str);
+    auto const readString = [&]() -> string const & {
+      auto const index = ReadVarUint<uint32_t>(src);
+      if (index >= strings.size())
+        MYTHROW(Reader::Exception, ("Wrong string index:", index));
+      return strings[index];
+    };
+
+    // Ids of the nodes on the path from the root to the current node.
+    vector<TCountryId const *> path;
+    for (auto count = ReadVarUint<uint64_t>(src); count > 0; --count)
+    {
+      auto const & id = readString();
+      auto const depth = ReadVarUint<uint64_t>(src);
+      auto const mapSize = ReadVarUint<TMwmSize>(src);
+      auto const mwmCounter = ReadVarUint<TMwmCounter>(src);
+      auto const mwmSize = ReadVarUint<TMwmSize>(src);
+      if (depth > path.size())
+        MYTHROW(Reader::Exception, ("Wrong depth of", id, depth));
+
+      path.resize(depth);
+      Country * node = store.InsertToCountryTree(
+          id, mapSize, depth, path.empty() ? kInvalidCountryId : *path.back());
+      if (node != nullptr)
+        node->SetSubtreeAttrs(mwmCounter, mwmSize);
+      path.push_back(&id);
+    }
+
+    for (auto count = ReadVarUint<uint64_t>(src); count > 0; --count)
+    {
+      auto const & affiliation = readString();
+      for (auto n = ReadVarUint<uint64_t>(src); n > 0; --n)
+        store.InsertAffiliation(readString(), affiliation);
+    }
+
+    for (auto count = ReadVarUint<uint64_t>(src); count > 0; --count)
+    {
+      auto const & oldId = readString();
+      for (auto n = ReadVarUint<uint64_t>(src); n > 0; --n)
+        store.InsertOldMwmMapping(readString(), oldId);
+    }
+    return version;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read compiled countries:", e.Msg()));
+    return -1;
+  }
+}
 }  // namespace
 
 TMwmSubtreeAttrs LoadGroupSingleMwmsImpl(size_t depth, json_t * node, TCountryId const & parent,
@@ -304,6 +494,15 @@ int64_t LoadCountriesFromBuffer(string const & jsonBuffer, TCountryTree & countr
   countries.Clear();
   affiliations.clear();
 
+  if (IsCompiled(jsonBuffer))
+  {
+    StoreCountriesSingleMwms store(countries, affiliations);
+    auto const version = LoadCompiledSingleMwmsImpl(jsonBuffer, store);
+    if (version >= 0 && mapping)
+      *mapping = store.GetMapping();
+    return version;
+  }
+
   int64_t version = -1;
   try
   {
@@ -345,6 +544,14 @@ void LoadCountryFile2CountryInfo(string const & jsonBuffer, map<string, CountryI
 {
   ASSERT(id2info.empty(), ());
 
+  if (IsCompiled(jsonBuffer))
+  {
+    isSingleMwm = true;
+    StoreFile2InfoSingleMwms store(id2info);
+    LoadCompiledSingleMwmsImpl(jsonBuffer, store);
+    return;
+  }
+
   int64_t version = -1;
   try
   {
@@ -367,4 +574,30 @@ void LoadCountryFile2CountryInfo(string const & jsonBuffer, map<string, CountryI
     LOG(LERROR, (e.Msg()));
   }
 }
+
+bool CompileCountries(string const & jsonBuffer, Writer & writer)
+{
+  try
+  {
+    int64_t version = -1;
+    base::Json root(jsonBuffer.c_str());
+    FromJSONObject(root.get(), "v", version);
+    if (!version::IsSingleMwm(version))
+    {
+      LOG(LWARNING, ("Only single mwm countries may be compiled, version:", version));
+      return false;
+    }
+
+    StoreCompiledSingleMwms store;
+    if (!LoadCountriesSingleMwmsImpl(jsonBuffer, store))
+      return false;
+    store.Serialize(version, writer);
+    return true;
+  }
+  catch (base::Json::Exception const & e)
+  {
+    LOG(LERROR, (e.Msg()));
+    return false;
+  }
+}
 }  // namespace storage
@@ -19,6 +19,8 @@
 #include <unordered_map>
 #include <vector>
 
+class Writer;
+
 namespace update
 {
 class SizeUpdater;
@@ -82,6 +84,7 @@ public:
 using TCountryTree = CountryTree<TCountryId, Country>;
 using TCountryTreeNode = TCountryTree::Node;
 
+/// |buffer| may be either countries.txt or its compiled form, see CompileCountries().
 /// @return version of country file or -1 if error was encountered
 int64_t LoadCountriesFromBuffer(std::string const & buffer, TCountryTree & countries,
                                 TMappingAffiliations & affiliations,
@@ -92,4 +95,10 @@ int64_t LoadCountriesFromFile(std::string const & path, TCountryTree & countries
 
 void LoadCountryFile2CountryInfo(std::string const & jsonBuffer,
                                  std::map<std::string, CountryInfo> & id2info, bool & isSingleMwm);
+
+/// Writes the compiled form of single mwm countries.txt |jsonBuffer|, which is loaded in place
+/// of countries.txt without parsing of json: the ids are written once in a strings table and
+/// the nodes are written in the preorder with their subtree attributes.
+/// @return false if |jsonBuffer| can't be parsed or is not a single mwm countries file.
+bool CompileCountries(std::string const & jsonBuffer, Writer & writer);
 }  // namespace storage
@@ -16,8 +16,11 @@
 
 #include "3party/Alohalytics/src/alohalytics.h"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <utility>
 
 namespace storage
 {
@@ -25,6 +28,11 @@ namespace
 {
 size_t const kInvalidId = std::numeric_limits<size_t>::max();
 
+// Number of cells of the point lookup grid along each axis. 512 cells give about
+// 80 km wide cells at the equator: small enough for most of them to lie inside a single
+// country, and few enough to keep the built part of the grid small.
+uint32_t constexpr kGridSize = 512;
+
 struct DoFreeCacheMemory
 {
   void operator()(std::vector<m2::RegionD> & v) const { std::vector<m2::RegionD>().swap(v); }
@@ -57,6 +65,15 @@ TCountryId CountryInfoGetterBase::GetRegionCountryId(m2::PointD const & pt) cons
   return id != kInvalidId ? m_countries[id].m_countryId : kInvalidCountryId;
 }
 
+void CountryInfoGetterBase::GetRegionCountryIds(std::vector<m2::PointD> const & points,
+                                                TCountriesVec & countryIds) const
+{
+  countryIds.clear();
+  countryIds.reserve(points.size());
+  for (auto const & pt : points)
+    countryIds.push_back(GetRegionCountryId(pt));
+}
+
 bool CountryInfoGetterBase::IsBelongToRegions(m2::PointD const & pt,
                                               TRegionIdSet const & regions) const
 {
@@ -257,12 +274,121 @@ CountryInfoReader::CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countr
   LoadCountryFile2CountryInfo(buffer, m_id2info, m_isSingleMwm);
 }
 
+CountryInfoGetterBase::TRegionId CountryInfoReader::FindFirstCountry(m2::PointD const & pt) const
+{
+  m2::RectD const fullRect = MercatorBounds::FullRect();
+  if (!fullRect.IsPointInside(pt))
+    return CountryInfoGetter::FindFirstCountry(pt);
+
+  auto const toCell = [](double v, double min, double size) {
+    return std::min(static_cast<uint32_t>((v - min) / size * kGridSize), kGridSize - 1);
+  };
+  auto const cell = GetCell(toCell(pt.x, fullRect.minX(), fullRect.SizeX()),
+                            toCell(pt.y, fullRect.minY(), fullRect.SizeY()));
+
+  for (auto const & country : *cell)
+  {
+    if (country.m_coverage == Coverage::Full)
+      return country.m_id;
+    if (m_countries[country.m_id].m_rect.IsPointInside(pt) &&
+        IsBelongToRegionImpl(country.m_id, pt))
+    {
+      return country.m_id;
+    }
+  }
+  return kInvalidId;
+}
+
 void CountryInfoReader::ClearCachesImpl() const
 {
-  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    m_cache.ForEachValue(DoFreeCacheMemory());
+    m_cache.Reset();
+  }
+
+  std::lock_guard<std::mutex> lock(m_cellsMutex);
+  m_cells.clear();
+}
+
+std::shared_ptr<CountryInfoReader::Cell const> CountryInfoReader::GetCell(uint32_t x,
+                                                                          uint32_t y) const
+{
+  uint32_t const key = y * kGridSize + x;
+  {
+    std::lock_guard<std::mutex> lock(m_cellsMutex);
+    auto const it = m_cells.find(key);
+    if (it != m_cells.end())
+      return it->second;
+  }
+
+  // The cell is built without the lock because it may require loading of polygons.
+  // When several threads build the same cell the first inserted one wins, they are equal.
+  m2::RectD const fullRect = MercatorBounds::FullRect();
+  double const sizeX = fullRect.SizeX() / kGridSize;
+  double const sizeY = fullRect.SizeY() / kGridSize;
+  m2::RectD const cellRect(fullRect.minX() + x * sizeX, fullRect.minY() + y * sizeY,
+                           fullRect.minX() + (x + 1) * sizeX, fullRect.minY() + (y + 1) * sizeY);
+  auto cell = std::make_shared<Cell const>(BuildCell(cellRect));
+
+  std::lock_guard<std::mutex> lock(m_cellsMutex);
+  return m_cells.emplace(key, move(cell)).first->second;
+}
+
+CountryInfoReader::Cell CountryInfoReader::BuildCell(m2::RectD const & cellRect) const
+{
+  Cell cell;
+  for (TRegionId id = 0; id < m_countries.size(); ++id)
+  {
+    if (!m_countries[id].m_rect.IsIntersect(cellRect))
+      continue;
+
+    Coverage const coverage = GetCoverage(id, cellRect);
+    if (coverage == Coverage::None)
+      continue;
+
+    cell.push_back({id, coverage});
+    // Countries after a fully covering one are never returned for points of the cell.
+    if (coverage == Coverage::Full)
+      break;
+  }
+  return cell;
+}
+
+CountryInfoReader::Coverage CountryInfoReader::GetCoverage(TRegionId id,
+                                                           m2::RectD const & cellRect) const
+{
+  std::vector<pair<m2::PointD, m2::PointD>> const edges = {
+      {cellRect.LeftTop(), cellRect.RightTop()},
+      {cellRect.RightTop(), cellRect.RightBottom()},
+      {cellRect.RightBottom(), cellRect.LeftBottom()},
+      {cellRect.LeftBottom(), cellRect.LeftTop()}};
+
+  auto coverage = [&](std::vector<m2::RegionD> const & regions) {
+    bool meets = false;
+    for (auto const & region : regions)
+    {
+      if (!region.GetRect().IsIntersect(cellRect))
+        continue;
+      meets = true;
+
+      m2::PointD result;
+      for (auto const & edge : edges)
+      {
+        if (region.FindIntersection(edge.first, edge.second, result))
+          return Coverage::Partial;
+      }
+
+      // Borders of the cell and of the region do not cross, so the cell is either inside
+      // the region or outside of it entirely, and one corner is enough to tell.
+      if (region.Contains(cellRect.LeftBottom()))
+        return Coverage::Full;
+    }
+    return meets ? Coverage::Partial : Coverage::None;
+  };
 
-  m_cache.ForEachValue(DoFreeCacheMemory());
-  m_cache.Reset();
+  return WithRegion(id, coverage);
 }
 
 template <typename TFn>
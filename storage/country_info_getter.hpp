@@ -12,6 +12,7 @@
 #include "base/cache.hpp"
 
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <type_traits>
@@ -36,6 +37,11 @@ public:
   // string.
   TCountryId GetRegionCountryId(m2::PointD const & pt) const;
 
+  // Batch version of GetRegionCountryId(): |countryIds| is filled with one country id
+  // (or kInvalidCountryId) per point of |points|, in the same order.
+  void GetRegionCountryIds(std::vector<m2::PointD> const & points,
+                           TCountriesVec & countryIds) const;
+
   // Returns true when |pt| belongs to at least one of the specified
   // |regions|.
   bool IsBelongToRegions(m2::PointD const & pt, TRegionIdSet const & regions) const;
@@ -47,7 +53,7 @@ public:
 
 protected:
   // Returns identifier of the first country containing |pt|.
-  TRegionId FindFirstCountry(m2::PointD const & pt) const;
+  virtual TRegionId FindFirstCountry(m2::PointD const & pt) const;
 
   // Returns true when |pt| belongs to a country identified by |id|.
   virtual bool IsBelongToRegionImpl(size_t id, m2::PointD const & pt) const = 0;
@@ -145,8 +151,31 @@ public:
   static unique_ptr<CountryInfoGetter> CreateCountryInfoReaderObsolete(Platform const & platform);
 
 protected:
+  // How much of a grid cell is covered by a country.
+  enum class Coverage
+  {
+    None,
+    Partial,
+    Full
+  };
+
+  struct CellCountry
+  {
+    TRegionId m_id;
+    Coverage m_coverage;
+  };
+
+  // Countries whose polygons meet a grid cell, in the order of m_countries.
+  using Cell = std::vector<CellCountry>;
+
   CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countryR);
 
+  // CountryInfoGetterBase overrides:
+  // Looks up |pt| in a lazily built uniform grid over the mercator plane. When the cell of
+  // |pt| lies entirely inside the first candidate country no polygon is touched at all,
+  // otherwise only countries meeting the cell are tested.
+  TRegionId FindFirstCountry(m2::PointD const & pt) const override;
+
   // CountryInfoGetter overrides:
   void ClearCachesImpl() const override;
   bool IsBelongToRegionImpl(size_t id, m2::PointD const & pt) const override;
@@ -156,9 +185,18 @@ protected:
   template <typename TFn>
   std::result_of_t<TFn(vector<m2::RegionD>)> WithRegion(size_t id, TFn && fn) const;
 
+  std::shared_ptr<Cell const> GetCell(uint32_t x, uint32_t y) const;
+  Cell BuildCell(m2::RectD const & cellRect) const;
+  Coverage GetCoverage(TRegionId id, m2::RectD const & cellRect) const;
+
   FilesContainerR m_reader;
   mutable base::Cache<uint32_t, std::vector<m2::RegionD>> m_cache;
   mutable std::mutex m_cacheMutex;
+
+  // Built cells of the grid keyed by y * kGridSize + x. Cells are immutable once built, so
+  // they are shared with readers and the lock is held only to find or to insert a cell.
+  mutable std::unordered_map<uint32_t, std::shared_ptr<Cell const>> m_cells;
+  mutable std::mutex m_cellsMutex;
 };
 
 // This class allows users to get info about very simply rectangular
@@ -73,7 +73,8 @@ void Manager::ApplyDiff(ApplyDiffParams && p, std::function<void(bool const resu
       string const oldMwmPath = p.m_oldMwmFile->GetPath(MapOptions::Map);
       string const newMwmPath = diffFile->GetPath(MapOptions::Map);
       string const diffApplyingInProgressPath = newMwmPath + DIFF_APPLYING_FILE_EXTENSION;
-      result = generator::mwm_diff::ApplyDiff(oldMwmPath, diffApplyingInProgressPath, diffPath) &&
+      result = generator::mwm_diff::ApplyDiff(oldMwmPath, diffApplyingInProgressPath, diffPath,
+                                              p.m_progress) &&
               base::RenameFileX(diffApplyingInProgressPath, newMwmPath);
     }
 
@@ -23,6 +23,8 @@ public:
     string m_diffReadyPath;
     TLocalFilePtr m_diffFile;
     TLocalFilePtr m_oldMwmFile;
+    // Called on the worker thread with the number of applied bytes of the diff and its size.
+    std::function<void(uint64_t applied, uint64_t total)> m_progress;
   };
 
   class Observer
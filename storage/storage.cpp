@@ -103,6 +103,7 @@ MapFilesDownloader::TProgress Storage::GetOverallProgress(TCountriesVec const &
 Storage::Storage(string const & pathToCountriesFile /* = COUNTRIES_FILE */,
                  string const & dataDir /* = string() */)
   : m_downloader(make_unique<HttpMapFilesDownloader>())
+  , m_downloaderFactory([]() { return make_unique<HttpMapFilesDownloader>(); })
   , m_currentSlotId(0)
   , m_dataDir(dataDir)
   , m_downloadMapOnTheMap(nullptr)
@@ -224,6 +225,10 @@ void Storage::Clear()
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
   m_downloader->Reset();
+  for (auto & downloader : m_extraDownloaders)
+    downloader->Reset();
+  m_downloading.clear();
+  m_deferredDownloads.clear();
   m_queue.clear();
   m_justDownloaded.clear();
   m_failedCountries.clear();
@@ -370,10 +375,11 @@ TLocalAndRemoteSize Storage::CountrySizeInBytes(TCountryId const & countryId, Ma
   }
 
   TLocalAndRemoteSize sizes(0, GetRemoteSize(countryFile, opt, GetCurrentDataVersion()));
-  if (!m_downloader->IsIdle() && IsCountryFirstInQueue(countryId))
+  MapFilesDownloader * downloader = GetDownloader(countryId);
+  if (downloader != nullptr && !downloader->IsIdle())
   {
     sizes.first =
-        m_downloader->GetDownloadingProgress().first +
+        downloader->GetDownloadingProgress().first +
         GetRemoteSize(countryFile, queuedCountry->GetDownloadedFilesOptions(), GetCurrentDataVersion());
   }
   return sizes;
@@ -430,7 +436,7 @@ Status Storage::CountryStatus(TCountryId const & countryId) const
   // Check if we already downloading this country or have it in the queue
   if (IsCountryInQueue(countryId))
   {
-    if (IsCountryFirstInQueue(countryId))
+    if (IsCountryDownloading(countryId))
       return IsDiffApplyingInProgressToCountry(countryId) ? Status::EApplying : Status::EDownloading;
     else
       return Status::EInQueue;
@@ -531,7 +537,10 @@ void Storage::DownloadCountry(TCountryId const & countryId, MapOptions opt)
   }
   else
   {
-    NotifyStatusChangedForHierarchy(countryId);
+    if (m_downloading.size() < m_maxParallelDownloads)
+      DownloadNextCountryFromQueue();
+    if (!IsCountryDownloading(countryId))
+      NotifyStatusChangedForHierarchy(countryId);
   }
   SaveDownloadQueue();
 }
@@ -618,23 +627,111 @@ void Storage::DownloadNextCountryFromQueue()
     return;
   }
 
-  QueuedCountry & queuedCountry = m_queue.front();
-  TCountryId const countryId = queuedCountry.GetCountryId();
+  while (m_downloading.size() < m_maxParallelDownloads)
+  {
+    auto const it = FindNextCountryToDownload();
+    if (it == m_queue.end())
+      return;
+
+    QueuedCountry & queuedCountry = *it;
+    TCountryId const countryId = queuedCountry.GetCountryId();
+
+    // It's not even possible to prepare directory for files before
+    // downloading.  Mark this country as failed and switch to next
+    // country.
+    if (stopDownload ||
+        !PreparePlaceForCountryFiles(GetCurrentDataVersion(), m_dataDir, GetCountryFile(countryId)))
+    {
+      OnMapDownloadFinished(countryId, HttpRequest::Status::Failed, queuedCountry.GetInitOptions());
+      return;
+    }
+
+    m_downloading[countryId] = GetFreeDownloader();
+    DownloadNextFile(queuedCountry);
+
+    // New status for the country, "Downloading"
+    NotifyStatusChangedForHierarchy(countryId);
+  }
+}
 
-  // It's not even possible to prepare directory for files before
-  // downloading.  Mark this country as failed and switch to next
-  // country.
-  if (stopDownload ||
-      !PreparePlaceForCountryFiles(GetCurrentDataVersion(), m_dataDir, GetCountryFile(countryId)))
+Storage::TQueue::iterator Storage::FindNextCountryToDownload()
+{
+  auto next = m_queue.end();
+  for (auto it = m_queue.begin(); it != m_queue.end(); ++it)
   {
-    OnMapDownloadFinished(countryId, HttpRequest::Status::Failed, queuedCountry.GetInitOptions());
-    return;
+    if (IsCountryDownloading(it->GetCountryId()))
+      continue;
+
+    // One country at a time is downloaded in the order of the queue.
+    if (m_maxParallelDownloads == 1)
+      return it;
+
+    // Small countries are started first, so that they don't wait for big ones and
+    // free their downloaders quickly.
+    if (next == m_queue.end() ||
+        GetCountryFile(it->GetCountryId()).GetRemoteSize(MapOptions::Map) <
+            GetCountryFile(next->GetCountryId()).GetRemoteSize(MapOptions::Map))
+    {
+      next = it;
+    }
   }
+  return next;
+}
 
-  DownloadNextFile(queuedCountry);
+MapFilesDownloader * Storage::GetFreeDownloader()
+{
+  auto const isFree = [this](MapFilesDownloader const * downloader) {
+    return find_if(m_downloading.cbegin(), m_downloading.cend(), [downloader](auto const & d) {
+             return d.second == downloader;
+           }) == m_downloading.cend();
+  };
 
-  // New status for the country, "Downloading"
-  NotifyStatusChangedForHierarchy(countryId);
+  if (isFree(m_downloader.get()))
+    return m_downloader.get();
+
+  for (auto const & downloader : m_extraDownloaders)
+  {
+    if (isFree(downloader.get()))
+      return downloader.get();
+  }
+
+  CHECK(m_downloaderFactory, ("Downloader factory is needed for parallel downloading."));
+  m_extraDownloaders.push_back(m_downloaderFactory());
+  return m_extraDownloaders.back().get();
+}
+
+MapFilesDownloader * Storage::GetDownloader(TCountryId const & countryId) const
+{
+  auto const it = m_downloading.find(countryId);
+  return it == m_downloading.cend() ? nullptr : it->second;
+}
+
+Storage::TDownloadingProgress Storage::GetDownloadingProgress() const
+{
+  TDownloadingProgress progress;
+  for (auto const & d : m_downloading)
+  {
+    MapFilesDownloader::TProgress p(0, 0);
+    if (!d.second->IsIdle())
+    {
+      p = d.second->GetDownloadingProgress();
+      if (p.second == -1)
+        p = MapFilesDownloader::TProgress(0, 0);
+    }
+    progress[d.first] = p;
+  }
+  return progress;
+}
+
+void Storage::SetMaxParallelDownloads(size_t count)
+{
+  CHECK_THREAD_CHECKER(m_threadChecker, ());
+  CHECK_GREATER(count, 0, ());
+  CHECK(count == 1 || m_downloaderFactory, ("Downloader factory is needed for parallel downloading."));
+
+  m_maxParallelDownloads = count;
+  if (!m_queue.empty())
+    DownloadNextCountryFromQueue();
 }
 
 void Storage::DownloadNextFile(QueuedCountry const & country)
@@ -663,19 +760,19 @@ void Storage::DownloadNextFile(QueuedCountry const & country)
   // switch to next file.
   if (isDownloadedDiff || p.GetFileSizeByFullPath(readyFilePath, size))
   {
-    OnMapFileDownloadFinished(HttpRequest::Status::Completed,
+    OnMapFileDownloadFinished(countryId, HttpRequest::Status::Completed,
                               MapFilesDownloader::TProgress(size, size));
     return;
   }
 
   if (m_sessionServerList || !m_downloadingUrlsForTesting.empty())
   {
-    DoDownload();
+    DoDownload(countryId);
   }
   else
   {
     LoadServerListForSession();
-    SetDeferDownloading();
+    SetDeferDownloading(countryId);
   }
 }
 
@@ -698,6 +795,11 @@ TCountryId Storage::GetCurrentDownloadingCountryId() const
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
+  for (auto const & country : m_queue)
+  {
+    if (IsCountryDownloading(country.GetCountryId()))
+      return country.GetCountryId();
+  }
   return IsDownloadInProgress() ? m_queue.front().GetCountryId() : storage::TCountryId();
 }
 
@@ -745,17 +847,17 @@ void Storage::Unsubscribe(int slotId)
   }
 }
 
-void Storage::OnMapFileDownloadFinished(HttpRequest::Status status,
+void Storage::OnMapFileDownloadFinished(TCountryId const & countryId, HttpRequest::Status status,
                                         MapFilesDownloader::TProgress const & progress)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
-  if (m_queue.empty())
+  // The country can be deleted from queue while its file was being downloaded.
+  if (!IsCountryDownloading(countryId))
     return;
 
   bool const success = status == HttpRequest::Status::Completed;
-  QueuedCountry & queuedCountry = m_queue.front();
-  TCountryId const countryId = queuedCountry.GetCountryId();
+  QueuedCountry & queuedCountry = *FindCountryInQueue(countryId);
 
   if (success && queuedCountry.SwitchToNextFile())
   {
@@ -799,6 +901,10 @@ void Storage::ReportProgressForHierarchy(TCountryId const & countryId,
   TCountriesSet setQueue;
   GetQueuedCountries(m_queue, setQueue);
 
+  // Other countries may be downloaded at the same time with |countryId|.
+  TDownloadingProgress downloadingMwms = GetDownloadingProgress();
+  downloadingMwms[countryId] = leafProgress;
+
   auto calcProgress = [&](TCountryId const & parentId, TCountryTreeNode const & parentNode) {
     TCountriesVec descendants;
     parentNode.ForEachDescendant([&descendants](TCountryTreeNode const & container) {
@@ -806,30 +912,31 @@ void Storage::ReportProgressForHierarchy(TCountryId const & countryId,
     });
 
     MapFilesDownloader::TProgress localAndRemoteBytes =
-        CalculateProgress(countryId, descendants, leafProgress, setQueue);
+        CalculateProgress(downloadingMwms, descendants, setQueue);
     ReportProgress(parentId, localAndRemoteBytes);
   };
 
   ForEachAncestorExceptForTheRoot(countryId, calcProgress);
 }
 
-void Storage::DoDownload()
+void Storage::DoDownload(TCountryId const & countryId)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
   CHECK(m_sessionServerList || !m_downloadingUrlsForTesting.empty(), ());
 
-  // Queue can be empty because countries were deleted from queue.
-  if (m_queue.empty())
+  // The country can be deleted from queue while it was waiting for downloading.
+  MapFilesDownloader * downloader = GetDownloader(countryId);
+  if (downloader == nullptr)
     return;
 
-  QueuedCountry & queuedCountry = m_queue.front();
+  QueuedCountry & queuedCountry = *FindCountryInQueue(countryId);
   if (queuedCountry.GetInitOptions() == MapOptions::Diff)
   {
     using diffs::Status;
     auto const status = m_diffManager.GetStatus();
     switch (status)
     {
-    case Status::Undefined: SetDeferDownloading(); return;
+    case Status::Undefined: SetDeferDownloading(countryId); return;
     case Status::NotAvailable:
       queuedCountry.ResetToDefaultOptions();
       break;
@@ -849,41 +956,44 @@ void Storage::DoDownload()
 
   string const filePath =
       GetFileDownloadPath(queuedCountry.GetCountryId(), queuedCountry.GetCurrentFileOptions());
-  m_downloader->DownloadMapFile(fileUrls, filePath, GetDownloadSize(queuedCountry),
-                                bind(&Storage::OnMapFileDownloadFinished, this, _1, _2),
-                                bind(&Storage::OnMapFileDownloadProgress, this, _1));
+  downloader->DownloadMapFile(fileUrls, filePath, GetDownloadSize(queuedCountry),
+                              bind(&Storage::OnMapFileDownloadFinished, this, countryId, _1, _2),
+                              bind(&Storage::OnMapFileDownloadProgress, this, countryId, _1));
 }
 
-void Storage::SetDeferDownloading()
+void Storage::SetDeferDownloading(TCountryId const & countryId)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
-  m_needToStartDeferredDownloading = true;
+  m_deferredDownloads.insert(countryId);
 }
 
 void Storage::DoDeferredDownloadIfNeeded()
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
-  if (!m_needToStartDeferredDownloading || !m_sessionServerList)
+  if (m_deferredDownloads.empty() || !m_sessionServerList)
     return;
 
-  m_needToStartDeferredDownloading = false;
-  DoDownload();
+  TCountriesSet deferred;
+  deferred.swap(m_deferredDownloads);
+  for (auto const & countryId : deferred)
+    DoDownload(countryId);
 }
 
-void Storage::OnMapFileDownloadProgress(MapFilesDownloader::TProgress const & progress)
+void Storage::OnMapFileDownloadProgress(TCountryId const & countryId,
+                                        MapFilesDownloader::TProgress const & progress)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
-  // Queue can be empty because countries were deleted from queue.
-  if (m_queue.empty())
+  // The country can be deleted from queue while its file was being downloaded.
+  if (!IsCountryDownloading(countryId))
     return;
 
   if (m_observers.empty())
     return;
 
-  ReportProgressForHierarchy(m_queue.front().GetCountryId(), progress);
+  ReportProgressForHierarchy(countryId, progress);
 }
 
 void Storage::RegisterDownloadedFiles(TCountryId const & countryId, MapOptions options)
@@ -904,12 +1014,15 @@ void Storage::RegisterDownloadedFiles(TCountryId const & countryId, MapOptions o
     DeleteCountryIndexes(*localFile);
     m_didDownload(countryId, localFile);
 
-    CHECK(!m_queue.empty(), ());
-    PushToJustDownloaded(m_queue.begin());
-    PopFromQueue(m_queue.begin());
+    auto const it = find(m_queue.begin(), m_queue.end(), countryId);
+    CHECK(it != m_queue.end(), (countryId));
+    MapFilesDownloader * downloader = GetDownloader(countryId);
+    PushToJustDownloaded(it);
+    PopFromQueue(it);
     SaveDownloadQueue();
 
-    m_downloader->Reset();
+    if (downloader != nullptr)
+      downloader->Reset();
     NotifyStatusChangedForHierarchy(countryId);
     DownloadNextCountryFromQueue();
   };
@@ -919,7 +1032,7 @@ void Storage::RegisterDownloadedFiles(TCountryId const & countryId, MapOptions o
     /// At this point a diff applying process is going to start
     /// and we can't stop the process.
     /// TODO: Make the applying process cancellable.
-    m_queue.begin()->SetFrozen();
+    FindCountryInQueue(countryId)->SetFrozen();
     NotifyStatusChangedForHierarchy(countryId);
     ApplyDiff(countryId, fn);
     return;
@@ -1065,7 +1178,7 @@ Status Storage::CountryStatusWithoutFailed(TCountryId const & countryId) const
   // First, check if we already downloading this country or have in in the queue.
   if (!IsCountryInQueue(countryId))
     return CountryStatusFull(countryId, Status::EUnknown);
-  return IsCountryFirstInQueue(countryId) ? Status::EDownloading : Status::EInQueue;
+  return IsCountryDownloading(countryId) ? Status::EDownloading : Status::EInQueue;
 }
 
 Status Storage::CountryStatusFull(TCountryId const & countryId, Status const status) const
@@ -1116,31 +1229,41 @@ bool Storage::IsCountryInQueue(TCountryId const & countryId) const
   return FindCountryInQueue(countryId) != nullptr;
 }
 
-bool Storage::IsCountryFirstInQueue(TCountryId const & countryId) const
+bool Storage::IsCountryDownloading(TCountryId const & countryId) const
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
-  return !m_queue.empty() && m_queue.front().GetCountryId() == countryId;
+  return m_downloading.count(countryId) != 0;
 }
 
 bool Storage::IsDiffApplyingInProgressToCountry(TCountryId const & countryId) const
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
-  if (!IsCountryFirstInQueue(countryId))
+  if (!IsCountryDownloading(countryId))
     return false;
 
-  return m_queue.front().IsFrozen();
+  return FindCountryInQueue(countryId)->IsFrozen();
 }
 
 void Storage::SetLocale(string const & locale) { m_countryNameGetter.SetLocale(locale); }
 string Storage::GetLocale() const { return m_countryNameGetter.GetLocale(); }
 void Storage::SetDownloaderForTesting(unique_ptr<MapFilesDownloader> && downloader)
 {
+  for (auto & d : m_downloading)
+  {
+    if (d.second == m_downloader.get())
+      d.second = downloader.get();
+  }
   m_downloader = move(downloader);
   LoadServerListForTesting();
 }
 
+void Storage::SetDownloaderFactoryForTesting(TDownloaderFactory const & factory)
+{
+  m_downloaderFactory = factory;
+}
+
 void Storage::SetCurrentDataVersionForTesting(int64_t currentVersion)
 {
   m_currentVersion = currentVersion;
@@ -1246,11 +1369,11 @@ bool Storage::DeleteCountryFilesFromDownloader(TCountryId const & countryId)
     return false;
 
   MapOptions const opt = queuedCountry->GetInitOptions();
-  if (IsCountryFirstInQueue(countryId))
+  if (MapFilesDownloader * downloader = GetDownloader(countryId))
   {
     // Abrupt downloading of the current file if it should be removed.
     if (HasOptions(opt, queuedCountry->GetCurrentFileOptions()))
-      m_downloader->Reset();
+      downloader->Reset();
 
     // Remove all files downloader had been created for a country.
     DeleteDownloaderFilesForCountry(GetCurrentDataVersion(), m_dataDir, GetCountryFile(countryId));
@@ -1267,13 +1390,14 @@ bool Storage::DeleteCountryFilesFromDownloader(TCountryId const & countryId)
     SaveDownloadQueue();
   }
 
-  if (!m_queue.empty() && m_downloader->IsIdle())
+  if (!m_queue.empty())
   {
     // Kick possibly interrupted downloader.
-    if (IsCountryFirstInQueue(countryId))
-      DownloadNextFile(m_queue.front());
-    else
+    MapFilesDownloader * downloader = GetDownloader(countryId);
+    if (downloader == nullptr)
       DownloadNextCountryFromQueue();
+    else if (downloader->IsIdle())
+      DownloadNextFile(*queuedCountry);
   }
   return true;
 }
@@ -1693,21 +1817,11 @@ void Storage::GetNodeAttrs(TCountryId const & countryId, NodeAttrs & nodeAttrs)
     TCountriesVec subtree;
     node->ForEachInSubtree(
         [&subtree](TCountryTreeNode const & d) { subtree.push_back(d.Value().Name()); });
-    TCountryId const & downloadingMwm =
-        IsDownloadInProgress() ? GetCurrentDownloadingCountryId() : kInvalidCountryId;
-    MapFilesDownloader::TProgress downloadingMwmProgress(0, 0);
-    if (!m_downloader->IsIdle())
-    {
-      downloadingMwmProgress = m_downloader->GetDownloadingProgress();
-      // If we don't know estimated file size then we ignore its progress.
-      if (downloadingMwmProgress.second == -1)
-        downloadingMwmProgress = {0, 0};
-    }
 
     TCountriesSet setQueue;
     GetQueuedCountries(m_queue, setQueue);
     nodeAttrs.m_downloadingProgress =
-        CalculateProgress(downloadingMwm, subtree, downloadingMwmProgress, setQueue);
+        CalculateProgress(GetDownloadingProgress(), subtree, setQueue);
   }
 
   // Local mwm information and information about downloading mwms.
@@ -1794,19 +1908,19 @@ void Storage::DoClickOnDownloadMap(TCountryId const & countryId)
 }
 
 MapFilesDownloader::TProgress Storage::CalculateProgress(
-    TCountryId const & downloadingMwm, TCountriesVec const & mwms,
-    MapFilesDownloader::TProgress const & downloadingMwmProgress,
+    TDownloadingProgress const & downloadingMwms, TCountriesVec const & mwms,
     TCountriesSet const & mwmsInQueue) const
 {
-  // Function calculates progress correctly ONLY if |downloadingMwm| is leaf.
+  // Function calculates progress correctly ONLY if |downloadingMwms| are leaves.
 
   MapFilesDownloader::TProgress localAndRemoteBytes = make_pair(0, 0);
 
   for (auto const & d : mwms)
   {
-    if (downloadingMwm == d && downloadingMwm != kInvalidCountryId)
+    auto const it = downloadingMwms.find(d);
+    if (it != downloadingMwms.cend())
     {
-      localAndRemoteBytes.first += downloadingMwmProgress.first;
+      localAndRemoteBytes.first += it->second.first;
       localAndRemoteBytes.second += GetRemoteSize(GetCountryFile(d), MapOptions::Map,
                                                   GetCurrentDataVersion());
     }
@@ -1905,6 +2019,8 @@ void Storage::PushToJustDownloaded(TQueue::iterator justDownloadedItem)
 void Storage::PopFromQueue(TQueue::iterator it)
 {
   CHECK(!m_queue.empty(), ());
+  m_downloading.erase(it->GetCountryId());
+  m_deferredDownloads.erase(it->GetCountryId());
   m_queue.erase(it);
   if (m_queue.empty())
     m_justDownloaded.clear();
@@ -148,10 +148,21 @@ public:
   using TChangeCountryFunction = function<void(TCountryId const &)>;
   using TProgressFunction = function<void(TCountryId const &, MapFilesDownloader::TProgress const &)>;
   using TQueue = list<QueuedCountry>;
+  using TDownloaderFactory = function<unique_ptr<MapFilesDownloader>()>;
 
 private:
-  /// We support only one simultaneous request at the moment
+  using TDownloadingProgress = map<TCountryId, MapFilesDownloader::TProgress>;
+
+  /// The first downloader. It's also used for getting the list of servers.
   unique_ptr<MapFilesDownloader> m_downloader;
+  /// Downloaders which are created by |m_downloaderFactory| when several countries
+  /// are downloaded at the same time.
+  vector<unique_ptr<MapFilesDownloader>> m_extraDownloaders;
+  TDownloaderFactory m_downloaderFactory;
+  /// Maximum number of countries which are downloaded at the same time.
+  size_t m_maxParallelDownloads = 1;
+  /// Countries from |m_queue| which are being downloaded now and their downloaders.
+  map<TCountryId, MapFilesDownloader *> m_downloading;
 
   /// Stores timestamp for update checks
   int64_t m_currentVersion;
@@ -185,10 +196,6 @@ private:
   // folder.
   map<platform::CountryFile, TLocalFilePtr> m_localFilesForFakeCountries;
 
-  /// used to correctly calculate total country download progress with more than 1 file
-  /// <current, total>
-  MapFilesDownloader::TProgress m_countryProgress;
-
   DownloadingPolicy m_defaultDownloadingPolicy;
   DownloadingPolicy * m_downloadingPolicy = &m_defaultDownloadingPolicy;
 
@@ -251,12 +258,22 @@ private:
   diffs::Manager m_diffManager;
   vector<platform::LocalCountryFile> m_notAppliedDiffs;
 
-  bool m_needToStartDeferredDownloading = false;
+  // Countries which wait for the list of servers or for the diffs status before downloading.
+  TCountriesSet m_deferredDownloads;
   boost::optional<vector<string>> m_sessionServerList;
 
   StartDownloadingCallback m_startDownloadingCallback;
 
   void DownloadNextCountryFromQueue();
+  // Returns the next country from |m_queue| which is not being downloaded yet or |m_queue.end()|.
+  // Smaller countries go first when several countries are downloaded at the same time.
+  TQueue::iterator FindNextCountryToDownload();
+  // Returns a downloader which is not used by any country from |m_downloading|.
+  MapFilesDownloader * GetFreeDownloader();
+  // Returns the downloader of |countryId| or nullptr if the country is not being downloaded.
+  MapFilesDownloader * GetDownloader(TCountryId const & countryId) const;
+  // Returns progress of all countries which are being downloaded now.
+  TDownloadingProgress GetDownloadingProgress() const;
 
   void LoadCountriesFile(string const & pathToCountriesFile, string const & dataDir,
                          TMappingOldMwm * mapping = nullptr);
@@ -265,18 +282,20 @@ private:
   void ReportProgressForHierarchy(TCountryId const & countryId,
                                   MapFilesDownloader::TProgress const & leafProgress);
 
-  void DoDownload();
-  void SetDeferDownloading();
+  void DoDownload(TCountryId const & countryId);
+  void SetDeferDownloading(TCountryId const & countryId);
   void DoDeferredDownloadIfNeeded();
 
   /// Called on the main thread by MapFilesDownloader when
   /// downloading of a map file succeeds/fails.
-  void OnMapFileDownloadFinished(downloader::HttpRequest::Status status,
+  void OnMapFileDownloadFinished(TCountryId const & countryId,
+                                 downloader::HttpRequest::Status status,
                                  MapFilesDownloader::TProgress const & progress);
 
   /// Periodically called on the main thread by MapFilesDownloader
   /// during the downloading process.
-  void OnMapFileDownloadProgress(MapFilesDownloader::TProgress const & progress);
+  void OnMapFileDownloadProgress(TCountryId const & countryId,
+                                 MapFilesDownloader::TProgress const & progress);
 
   void RegisterDownloadedFiles(TCountryId const & countryId, MapOptions files);
 
@@ -310,6 +329,11 @@ public:
 
   inline void SetDownloadingPolicy(DownloadingPolicy * policy) { m_downloadingPolicy = policy; }
 
+  /// Sets how many countries may be downloaded at the same time. One country is downloaded
+  /// at a time by default. More than one needs a downloader factory.
+  void SetMaxParallelDownloads(size_t count);
+  size_t GetMaxParallelDownloads() const { return m_maxParallelDownloads; }
+
   /// @name Interface with clients (Android/iOS).
   /// \brief It represents the interface which can be used by clients (Android/iOS).
   /// The term node means an mwm or a group of mwm like a big country.
@@ -557,6 +581,7 @@ public:
 
   // for testing:
   void SetDownloaderForTesting(unique_ptr<MapFilesDownloader> && downloader);
+  void SetDownloaderFactoryForTesting(TDownloaderFactory const & factory);
   void SetCurrentDataVersionForTesting(int64_t currentVersion);
   void SetDownloadingUrlsForTesting(vector<string> const & downloadingUrls);
   void SetLocaleForTesting(string const & jsonBuffer, string const & locale);
@@ -590,8 +615,8 @@ private:
   // Returns true when country is in the downloader's queue.
   bool IsCountryInQueue(TCountryId const & countryId) const;
 
-  // Returns true when country is first in the downloader's queue.
-  bool IsCountryFirstInQueue(TCountryId const & countryId) const;
+  // Returns true when country is being downloaded now.
+  bool IsCountryDownloading(TCountryId const & countryId) const;
 
   // Returns true if we started the diff applying procedure for an mwm with countryId.
   bool IsDiffApplyingInProgressToCountry(TCountryId const & countryId) const;
@@ -650,15 +675,12 @@ private:
 
   /// Calculates progress of downloading for expandable nodes in country tree.
   /// |descendants| All descendants of the parent node.
-  /// |downloadingMwm| Downloading leaf node country id if any. If not, downloadingMwm == kInvalidCountryId.
-  /// |downloadingMwm| Must be only leaf.
-  /// If downloadingMwm != kInvalidCountryId |downloadingMwmProgress| is a progress of downloading
-  /// the leaf node in bytes. |downloadingMwmProgress.first| == number of downloaded bytes.
-  /// |downloadingMwmProgress.second| == number of bytes in downloading files.
+  /// |downloadingMwms| Progress of downloading leaf nodes which are being downloaded now.
+  /// |downloadingMwms[id].first| == number of downloaded bytes of |id|.
+  /// |downloadingMwms[id].second| == number of bytes in downloading files of |id|.
   /// |mwmsInQueue| hash table made from |m_queue|.
-  MapFilesDownloader::TProgress CalculateProgress(TCountryId const & downloadingMwm,
+  MapFilesDownloader::TProgress CalculateProgress(TDownloadingProgress const & downloadingMwms,
                                                   TCountriesVec const & descendants,
-                                                  MapFilesDownloader::TProgress const & downloadingMwmProgress,
                                                   TCountriesSet const & mwmsInQueue) const;
 
   void PushToJustDownloaded(TQueue::iterator justDownloadedItem);
@@ -48,6 +48,42 @@ UNIT_TEST(CountryInfoGetter_GetByPoint_Smoke)
   TEST_EQUAL(info.m_name, "Japan, Kinki", ());
 }
 
+UNIT_TEST(CountryInfoGetter_GetRegionCountryIds_Grid)
+{
+  auto const getter = CreateCountryInfoGetterMigrate();
+
+  // Points around Minsk, a border crossing near Brest and the sea near Tallinn.
+  vector<m2::PointD> points;
+  for (double lat = 51.0; lat <= 60.0; lat += 0.25)
+  {
+    for (double lon = 23.0; lon <= 31.0; lon += 0.25)
+      points.push_back(MercatorBounds::FromLatLon(lat, lon));
+  }
+
+  TCountriesVec ids;
+  getter->GetRegionCountryIds(points, ids);
+  TEST_EQUAL(ids.size(), points.size(), ());
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    TEST_EQUAL(ids[i], getter->GetRegionCountryId(points[i]), ());
+    if (ids[i] == kInvalidCountryId)
+      continue;
+
+    // The grid must not report a country which does not contain the point. A precise lookup
+    // by a degenerate rect tests the polygons directly.
+    auto const countries = getter->GetRegionsCountryIdByRect(m2::RectD(points[i], points[i]),
+                                                             false /* rough */);
+    TEST(find(countries.begin(), countries.end(), ids[i]) != countries.end(), (ids[i], points[i]));
+  }
+
+  // Grid cells are rebuilt after the caches are cleared.
+  getter->ClearCaches();
+  TCountriesVec idsAfterClear;
+  getter->GetRegionCountryIds(points, idsAfterClear);
+  TEST_EQUAL(ids, idsAfterClear, ());
+}
+
 UNIT_TEST(CountryInfoGetter_GetRegionsCountryIdByRect_Smoke)
 {
   auto const getter = CreateCountryInfoGetter();
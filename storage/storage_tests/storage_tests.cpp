@@ -34,6 +34,7 @@
 
 #include "coding/file_name_utils.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/writer.hpp"
 #include "coding/internal/file_data.hpp"
 
 #include "defines.hpp"
@@ -913,6 +914,41 @@ UNIT_CLASS_TEST(StorageTest, CancelDownloadingWhenAlmostDone)
   TEST(!file, (*file));
 }
 
+UNIT_CLASS_TEST(StorageTest, ParallelDownloading)
+{
+  storage.SetDownloaderFactoryForTesting(
+      [this]() { return make_unique<FakeMapFilesDownloader>(runner); });
+  storage.SetMaxParallelDownloads(2);
+
+  TCountryId const uruguayCountryId = storage.FindCountryIdByFile("Uruguay");
+  TEST(IsCountryIdValid(uruguayCountryId), ());
+  storage.DeleteCountry(uruguayCountryId, MapOptions::Map);
+  SCOPE_GUARD(cleanupUruguayFiles,
+              bind(&Storage::DeleteCountry, &storage, uruguayCountryId, MapOptions::Map));
+
+  TCountryId const venezuelaCountryId = storage.FindCountryIdByFile("Venezuela");
+  TEST(IsCountryIdValid(venezuelaCountryId), ());
+  storage.DeleteCountry(venezuelaCountryId, MapOptions::Map);
+  SCOPE_GUARD(cleanupVenezuelaFiles,
+              bind(&Storage::DeleteCountry, &storage, venezuelaCountryId, MapOptions::Map));
+
+  {
+    // Venezuela doesn't wait in the queue for Uruguay.
+    unique_ptr<CountryDownloaderChecker> uruguayChecker =
+        AbsentCountryDownloaderChecker(storage, uruguayCountryId, MapOptions::Map);
+    unique_ptr<CountryDownloaderChecker> venezuelaChecker =
+        AbsentCountryDownloaderChecker(storage, venezuelaCountryId, MapOptions::Map);
+    uruguayChecker->StartDownload();
+    venezuelaChecker->StartDownload();
+    TEST_EQUAL(storage.CountryStatusEx(uruguayCountryId), Status::EDownloading, ());
+    TEST_EQUAL(storage.CountryStatusEx(venezuelaCountryId), Status::EDownloading, ());
+    runner.Run();
+  }
+
+  TEST_EQUAL(storage.CountryStatusEx(uruguayCountryId), Status::EOnDisk, ());
+  TEST_EQUAL(storage.CountryStatusEx(venezuelaCountryId), Status::EOnDisk, ());
+}
+
 UNIT_CLASS_TEST(StorageTest, DeleteCountry)
 {
   tests_support::ScopedFile map("Wonderland.mwm", ScopedFile::Mode::Create);
@@ -1073,6 +1109,59 @@ UNIT_TEST(StorageTest_GetAffiliations)
     TEST_EQUAL(storage.GetAffiliations().at(s), indisputableId, ());
 }
 
+UNIT_TEST(StorageTest_CompiledCountries)
+{
+  string compiled;
+  {
+    MemWriter<string> writer(compiled);
+    TEST(CompileCountries(kSingleMwmCountriesTxt, writer), ());
+  }
+
+  TCountryTree jsonCountries;
+  TCountryTree compiledCountries;
+  TMappingAffiliations jsonAffiliations;
+  TMappingAffiliations compiledAffiliations;
+  TMappingOldMwm jsonMapping;
+  TMappingOldMwm compiledMapping;
+  TEST_EQUAL(LoadCountriesFromBuffer(kSingleMwmCountriesTxt, jsonCountries, jsonAffiliations,
+                                     &jsonMapping),
+             version::FOR_TESTING_SINGLE_MWM1, ());
+  TEST_EQUAL(LoadCountriesFromBuffer(compiled, compiledCountries, compiledAffiliations,
+                                     &compiledMapping),
+             version::FOR_TESTING_SINGLE_MWM1, ());
+  TEST_EQUAL(jsonAffiliations, compiledAffiliations, ());
+  TEST_EQUAL(jsonMapping, compiledMapping, ());
+
+  auto const getNodes = [](TCountryTree const & countries) {
+    vector<string> nodes;
+    countries.GetRoot().ForEachInSubtree([&nodes](TCountryTreeNode const & node) {
+      auto const & country = node.Value();
+      auto const size = country.GetFile().GetRemoteSize(MapOptions::Map);
+      nodes.push_back(country.Name() + ", parent: " + country.GetParent() +
+                      ", children: " + strings::to_string(node.ChildrenCount()) +
+                      ", size: " + strings::to_string(size) +
+                      ", subtree: " + strings::to_string(country.GetSubtreeMwmCounter()) + " " +
+                      strings::to_string(country.GetSubtreeMwmSizeBytes()));
+    });
+    return nodes;
+  };
+  TEST_EQUAL(getNodes(jsonCountries), getNodes(compiledCountries), ());
+
+  map<string, CountryInfo> jsonInfos;
+  map<string, CountryInfo> compiledInfos;
+  bool isSingleMwm = false;
+  LoadCountryFile2CountryInfo(kSingleMwmCountriesTxt, jsonInfos, isSingleMwm);
+  LoadCountryFile2CountryInfo(compiled, compiledInfos, isSingleMwm);
+  TEST(isSingleMwm, ());
+  TEST_EQUAL(jsonInfos.size(), compiledInfos.size(), ());
+  for (auto const & info : jsonInfos)
+    TEST_EQUAL(compiledInfos.at(info.first).m_name, info.second.m_name, ());
+
+  // Damaged compiled countries are not loaded.
+  compiled.resize(compiled.size() / 2);
+  TEST_EQUAL(LoadCountriesFromBuffer(compiled, compiledCountries, compiledAffiliations), -1, ());
+}
+
 UNIT_TEST(StorageTest_HasCountryId)
 {
   TCountriesVec middleEarthCountryIdVec =
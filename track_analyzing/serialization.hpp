@@ -14,19 +14,44 @@
 #include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 #include "coding/writer.hpp"
+#include "coding/zlib.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/checked_cast.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace track_analyzing
 {
+// The header of files in the columnar format.
+char const kMatchedTracksColumnsHeader[4] = {'M', 'T', 'C', '1'};
+
+// Matched tracks are stored in a columnar format. The tracks of each mwm are kept in a block,
+// so mwms which are not needed are skipped without reading. A block starts with an index of
+// users: names, numbers of points of tracks and offsets of users in the columns. Timestamps,
+// coordinates, segments and traffic of points are stored in separate zlib compressed columns,
+// values are delta coded within a track.
+//
+// Files in the previous row format (without the header) are still read.
 class MwmToMatchedTracksSerializer final
 {
 public:
+  // Returns true for mwm or user names which should be skipped.
+  using NameFilter = std::function<bool(std::string const &)>;
+
   MwmToMatchedTracksSerializer(std::shared_ptr<routing::NumMwmIds> numMwmIds)
     : m_numMwmIds(move(numMwmIds))
   {
@@ -35,6 +60,7 @@ public:
   template <class Sink>
   void Serialize(MwmToMatchedTracks const & mwmToMatchedTracks, Sink & sink)
   {
+    sink.Write(kMatchedTracksColumnsHeader, sizeof(kMatchedTracksColumnsHeader));
     WriteSize(sink, mwmToMatchedTracks.size());
 
     for (auto const & mwmIt : mwmToMatchedTracks)
@@ -43,46 +69,271 @@ public:
 
       UserToMatchedTracks const & userToMatchedTracks = mwmIt.second;
       CHECK(!userToMatchedTracks.empty(), ());
-      WriteSize(sink, userToMatchedTracks.size());
 
-      for (auto const & userIt : userToMatchedTracks)
+      std::vector<uint8_t> block;
+      MemWriter<decltype(block)> blockWriter(block);
+      SerializeBlock(userToMatchedTracks, blockWriter);
+
+      WriteSize(sink, block.size());
+      sink.Write(block.data(), block.size());
+    }
+  }
+
+  // Blocks of mwms are decoded on several threads.
+  template <class Reader>
+  void Deserialize(MwmToMatchedTracks & mwmToMatchedTracks, Reader const & reader,
+                   NameFilter const & mwmFilter = {}, NameFilter const & userFilter = {})
+  {
+    mwmToMatchedTracks.clear();
+
+    ReaderSource<Reader> src(reader);
+    char header[sizeof(kMatchedTracksColumnsHeader)] = {};
+    if (src.Size() >= sizeof(header))
+      src.Read(header, sizeof(header));
+
+    if (memcmp(header, kMatchedTracksColumnsHeader, sizeof(header)) != 0)
+    {
+      ReaderSource<Reader> rowsSrc(reader);
+      DeserializeRows(mwmToMatchedTracks, rowsSrc);
+      return;
+    }
+
+    std::vector<std::pair<routing::NumMwmId, std::vector<uint8_t>>> blocks;
+    auto const numMwms = ReadSize(src);
+    for (size_t iMwm = 0; iMwm < numMwms; ++iMwm)
+    {
+      std::string mwmName;
+      rw::Read(src, mwmName);
+      auto const blockSize = ReadSize(src);
+      if (mwmFilter && mwmFilter(mwmName))
+      {
+        src.Skip(blockSize);
+        continue;
+      }
+
+      blocks.emplace_back(m_numMwmIds->GetId(platform::CountryFile(mwmName)),
+                          std::vector<uint8_t>(blockSize));
+      src.Read(blocks.back().second.data(), blockSize);
+    }
+
+    std::vector<UserToMatchedTracks> results(blocks.size());
+    std::atomic<size_t> nextBlock(0);
+    auto const worker = [&]() {
+      for (size_t i = nextBlock++; i < blocks.size(); i = nextBlock++)
       {
-        rw::Write(sink, userIt.first);
+        MemReader memReader(blocks[i].second.data(), blocks[i].second.size());
+        ReaderSource<MemReader> blockSrc(memReader);
+        DeserializeBlock(blocks[i].first, blockSrc, userFilter, results[i]);
+      }
+    };
+
+    auto const threadsCount = std::min(
+        blocks.size(), std::max(static_cast<size_t>(std::thread::hardware_concurrency()),
+                                static_cast<size_t>(1)));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadsCount; ++i)
+      threads.emplace_back(worker);
+    worker();
+    for (auto & thread : threads)
+      thread.join();
+
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+      if (!results[i].empty())
+        mwmToMatchedTracks[blocks[i].first] = move(results[i]);
+    }
+  }
 
-        std::vector<MatchedTrack> const & tracks = userIt.second;
-        CHECK(!tracks.empty(), ());
-        WriteSize(sink, tracks.size());
+private:
+  enum Column
+  {
+    Timestamps,
+    Coordinates,
+    Segments,
+    Traffic,
+    ColumnsCount
+  };
+
+  using Columns = std::array<std::vector<uint8_t>, ColumnsCount>;
 
-        for (MatchedTrack const & track : tracks)
+  // Coordinates are stored as integers in these units of degrees.
+  static double constexpr kCoordinatesFactor = 1e6;
+
+  template <class Sink>
+  static void SerializeBlock(UserToMatchedTracks const & userToMatchedTracks, Sink & sink)
+  {
+    Columns columns;
+    std::array<MemWriter<std::vector<uint8_t>>, ColumnsCount> writers = {
+        {MemWriter<std::vector<uint8_t>>(columns[Timestamps]),
+         MemWriter<std::vector<uint8_t>>(columns[Coordinates]),
+         MemWriter<std::vector<uint8_t>>(columns[Segments]),
+         MemWriter<std::vector<uint8_t>>(columns[Traffic])}};
+
+    WriteSize(sink, userToMatchedTracks.size());
+    for (auto const & userIt : userToMatchedTracks)
+    {
+      rw::Write(sink, userIt.first);
+      for (auto const & column : columns)
+        WriteSize(sink, column.size());
+
+      std::vector<MatchedTrack> const & tracks = userIt.second;
+      CHECK(!tracks.empty(), ());
+      WriteSize(sink, tracks.size());
+
+      for (MatchedTrack const & track : tracks)
+      {
+        CHECK(!track.empty(), ());
+        WriteSize(sink, track.size());
+
+        DataPoint prevPoint;
+        int64_t prevLat = 0;
+        int64_t prevLon = 0;
+        uint32_t prevFeatureId = 0;
+        for (MatchedTrackPoint const & point : track)
         {
-          CHECK(!track.empty(), ());
-          WriteSize(sink, track.size());
+          DataPoint const & dataPoint = point.GetDataPoint();
+          WriteDelta(writers[Timestamps], static_cast<int64_t>(dataPoint.m_timestamp),
+                     static_cast<int64_t>(prevPoint.m_timestamp));
+
+          auto const lat = CoordinateToInt(dataPoint.m_latLon.lat);
+          auto const lon = CoordinateToInt(dataPoint.m_latLon.lon);
+          WriteDelta(writers[Coordinates], lat, prevLat);
+          WriteDelta(writers[Coordinates], lon, prevLon);
+
+          routing::Segment const & segment = point.GetSegment();
+          WriteDelta(writers[Segments], segment.GetFeatureId(), prevFeatureId);
+          WriteVarUint(writers[Segments], (static_cast<uint64_t>(segment.GetSegmentIdx()) << 1) |
+                                              (segment.IsForward() ? kForward : kBackward));
+
+          WriteToSink(writers[Traffic], dataPoint.m_traffic);
+
+          prevPoint = dataPoint;
+          prevLat = lat;
+          prevLon = lon;
+          prevFeatureId = segment.GetFeatureId();
+        }
+      }
+    }
+
+    for (auto const & column : columns)
+    {
+      std::vector<uint8_t> compressed;
+      if (!column.empty())
+      {
+        coding::ZLib::Deflate const deflate(coding::ZLib::Deflate::Format::ZLib,
+                                            coding::ZLib::Deflate::Level::BestCompression);
+        CHECK(deflate(column.data(), column.size(), back_inserter(compressed)), ());
+      }
+      WriteSize(sink, compressed.size());
+      sink.Write(compressed.data(), compressed.size());
+    }
+  }
 
-          for (MatchedTrackPoint const & point : track)
-            Serialize(point.GetSegment(), sink);
+  struct UserIndex
+  {
+    std::string m_user;
+    std::array<size_t, ColumnsCount> m_offsets;
+    std::vector<size_t> m_trackSizes;
+  };
 
-          std::vector<DataPoint> dataPoints;
-          dataPoints.reserve(track.size());
-          for (MatchedTrackPoint const & point : track)
-            dataPoints.push_back(point.GetDataPoint());
+  template <class Source>
+  static void DeserializeBlock(routing::NumMwmId mwmId, Source & src,
+                               NameFilter const & userFilter,
+                               UserToMatchedTracks & userToMatchedTracks)
+  {
+    std::vector<UserIndex> users(ReadSize(src));
+    CHECK(!users.empty(), ());
+    for (auto & user : users)
+    {
+      rw::Read(src, user.m_user);
+      for (auto & offset : user.m_offsets)
+        offset = ReadSize(src);
+      user.m_trackSizes.resize(ReadSize(src));
+      CHECK(!user.m_trackSizes.empty(), ());
+      for (auto & size : user.m_trackSizes)
+        size = ReadSize(src);
+    }
 
-          std::vector<uint8_t> buffer;
-          MemWriter<decltype(buffer)> memWriter(buffer);
-          coding::TrafficGPSEncoder::SerializeDataPoints(coding::TrafficGPSEncoder::kLatestVersion,
-                                                         memWriter, dataPoints);
+    Columns columns;
+    for (auto & column : columns)
+    {
+      std::vector<uint8_t> compressed(ReadSize(src));
+      src.Read(compressed.data(), compressed.size());
+      if (compressed.empty())
+        continue;
+
+      coding::ZLib::Inflate const inflate(coding::ZLib::Inflate::Format::ZLib);
+      CHECK(inflate(compressed.data(), compressed.size(), back_inserter(column)), ());
+    }
+
+    for (auto const & user : users)
+    {
+      if (userFilter && userFilter(user.m_user))
+        continue;
+
+      std::array<std::unique_ptr<MemReader>, ColumnsCount> readers;
+      std::array<std::unique_ptr<ReaderSource<MemReader>>, ColumnsCount> sources;
+      for (size_t i = 0; i < ColumnsCount; ++i)
+      {
+        CHECK_LESS_OR_EQUAL(user.m_offsets[i], columns[i].size(), ());
+        readers[i] = std::make_unique<MemReader>(columns[i].data() + user.m_offsets[i],
+                                                 columns[i].size() - user.m_offsets[i]);
+        sources[i] = std::make_unique<ReaderSource<MemReader>>(*readers[i]);
+      }
 
-          WriteSize(sink, buffer.size());
-          sink.Write(buffer.data(), buffer.size());
+      std::vector<MatchedTrack> & tracks = userToMatchedTracks[user.m_user];
+      tracks.resize(user.m_trackSizes.size());
+      for (size_t iTrack = 0; iTrack < tracks.size(); ++iTrack)
+      {
+        MatchedTrack & track = tracks[iTrack];
+        track.reserve(user.m_trackSizes[iTrack]);
+
+        int64_t timestamp = 0;
+        int64_t lat = 0;
+        int64_t lon = 0;
+        int64_t featureId = 0;
+        for (size_t iPoint = 0; iPoint < user.m_trackSizes[iTrack]; ++iPoint)
+        {
+          timestamp += ReadDelta(*sources[Timestamps]);
+          lat += ReadDelta(*sources[Coordinates]);
+          lon += ReadDelta(*sources[Coordinates]);
+          featureId += ReadDelta(*sources[Segments]);
+          auto const segment = ReadVarUint<uint64_t>(*sources[Segments]);
+          auto const traffic = ReadPrimitiveFromSource<uint8_t>(*sources[Traffic]);
+
+          DataPoint const dataPoint(static_cast<uint64_t>(timestamp),
+                                    ms::LatLon(lat / kCoordinatesFactor, lon / kCoordinatesFactor),
+                                    traffic);
+          track.emplace_back(dataPoint,
+                             routing::Segment(mwmId, static_cast<uint32_t>(featureId),
+                                              base::checked_cast<uint32_t>(segment >> 1),
+                                              (segment & 1) == kForward));
         }
       }
     }
   }
 
+  static int64_t CoordinateToInt(double coordinate)
+  {
+    return static_cast<int64_t>(std::llround(coordinate * kCoordinatesFactor));
+  }
+
+  template <class Sink>
+  static void WriteDelta(Sink & sink, int64_t value, int64_t prevValue)
+  {
+    WriteVarUint(sink, bits::ZigZagEncode(value - prevValue));
+  }
+
   template <class Source>
-  void Deserialize(MwmToMatchedTracks & mwmToMatchedTracks, Source & src)
+  static int64_t ReadDelta(Source & src)
   {
-    mwmToMatchedTracks.clear();
+    return bits::ZigZagDecode(ReadVarUint<uint64_t>(src));
+  }
 
+  // The previous format: all points of a track follow each other.
+  template <class Source>
+  void DeserializeRows(MwmToMatchedTracks & mwmToMatchedTracks, Source & src)
+  {
     auto const numMmws = ReadSize(src);
     for (size_t iMwm = 0; iMwm < numMmws; ++iMwm)
     {
@@ -123,8 +374,8 @@ public:
           ReaderSource<MemReader> memSrc(memReader);
 
           std::vector<DataPoint> dataPoints;
-          coding::TrafficGPSEncoder::DeserializeDataPoints(
-              coding::TrafficGPSEncoder::kLatestVersion, memSrc, dataPoints);
+          // Tracks of the previous format were written with version 1 of the points encoding.
+          coding::TrafficGPSEncoder::DeserializeDataPoints(1 /* version */, memSrc, dataPoints);
           CHECK_EQUAL(numSegments, dataPoints.size(), ("mwm:", mwmName, "user:", user));
 
           MatchedTrack & track = tracks[iTrack];
@@ -137,7 +388,6 @@ public:
     }
   }
 
-private:
   static uint8_t constexpr kForward = 0;
   static uint8_t constexpr kBackward = 1;
 
@@ -153,15 +403,6 @@ private:
     return base::checked_cast<size_t>(ReadVarUint<uint64_t>(src));
   }
 
-  template <class Sink>
-  static void Serialize(routing::Segment const & segment, Sink & sink)
-  {
-    WriteToSink(sink, segment.GetFeatureId());
-    WriteToSink(sink, segment.GetSegmentIdx());
-    auto const direction = segment.IsForward() ? kForward : kBackward;
-    WriteToSink(sink, direction);
-  }
-
   template <class Source>
   static void Deserialize(routing::NumMwmId numMwmId, routing::Segment & segment, Source & src)
   {
@@ -6,6 +6,8 @@
 
 #include "routing_common/num_mwm_id.hpp"
 
+#include "indexer/data_source.hpp"
+
 #include "storage/storage.hpp"
 
 #include "coding/file_name_utils.hpp"
@@ -20,9 +22,12 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using namespace routing;
 using namespace std;
@@ -33,69 +38,127 @@ namespace
 {
 using Iter = typename vector<string>::iterator;
 
-void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
-                 NumMwmIds const & numMwmIds, MwmToMatchedTracks & mwmToMatchedTracks)
+struct MatchingStats
 {
-  base::Timer timer;
-
-  uint64_t tracksCount = 0;
-  uint64_t pointsCount = 0;
-  uint64_t nonMatchedPointsCount = 0;
+  void Add(TrackMatcher const & matcher)
+  {
+    m_tracksCount += matcher.GetTracksCount();
+    m_pointsCount += matcher.GetPointsCount();
+    m_nonMatchedPointsCount += matcher.GetNonMatchedPointsCount();
+  }
 
-  auto processMwm = [&](string const & mwmName, UserToTrack const & userToTrack) {
-    auto const countryFile = platform::CountryFile(mwmName);
-    auto const mwmId = numMwmIds.GetId(countryFile);
-    TrackMatcher matcher(storage, mwmId, countryFile);
+  void Add(MatchingStats const & stats)
+  {
+    m_tracksCount += stats.m_tracksCount;
+    m_pointsCount += stats.m_pointsCount;
+    m_nonMatchedPointsCount += stats.m_nonMatchedPointsCount;
+  }
 
-    auto & userToMatchedTracks = mwmToMatchedTracks[mwmId];
+  uint64_t m_tracksCount = 0;
+  uint64_t m_pointsCount = 0;
+  uint64_t m_nonMatchedPointsCount = 0;
+};
 
-    for (auto const & it : userToTrack)
+// Matches tracks of users of one mwm on |threadsCount| threads. Threads share the data source
+// and take users one by one, each thread has its own matcher.
+MatchingStats MatchUsers(string const & mwmName, UserToTrack const & userToTrack,
+                         NumMwmId mwmId, storage::Storage const & storage, MatchingMode mode,
+                         size_t threadsCount, UserToMatchedTracks & userToMatchedTracks)
+{
+  auto const countryFile = platform::CountryFile(mwmName);
+  FrozenDataSource dataSource;
+  TrackMatcher::RegisterMwm(storage, countryFile, dataSource);
+
+  vector<UserToTrack::const_iterator> users;
+  users.reserve(userToTrack.size());
+  for (auto it = userToTrack.cbegin(); it != userToTrack.cend(); ++it)
+    users.push_back(it);
+
+  threadsCount = max(min(threadsCount, users.size()), static_cast<size_t>(1));
+  vector<vector<MatchedTrack>> results(users.size());
+  vector<MatchingStats> stats(threadsCount);
+  atomic<size_t> nextUser(0);
+
+  auto const worker = [&](size_t threadNum) {
+    TrackMatcher matcher(dataSource, mwmId, countryFile, mode);
+    for (size_t i = nextUser++; i < users.size(); i = nextUser++)
     {
-      string const & user = it.first;
-      auto & matchedTracks = userToMatchedTracks[user];
+      string const & user = users[i]->first;
       try
       {
-        matcher.MatchTrack(it.second, matchedTracks);
+        matcher.MatchTrack(users[i]->second, results[i]);
       }
       catch (RootException const & e)
       {
         LOG(LERROR, ("Can't match track for mwm:", mwmName, ", user:", user));
         LOG(LERROR, ("  ", e.what()));
       }
-
-      if (matchedTracks.empty())
-        userToMatchedTracks.erase(user);
     }
+    stats[threadNum].Add(matcher);
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(worker, i);
+  worker(0 /* threadNum */);
+  for (auto & t : threads)
+    t.join();
+
+  for (size_t i = 0; i < users.size(); ++i)
+  {
+    if (!results[i].empty())
+      userToMatchedTracks[users[i]->first] = move(results[i]);
+  }
+
+  MatchingStats result;
+  for (auto const & s : stats)
+    result.Add(s);
+  return result;
+}
+
+void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
+                 NumMwmIds const & numMwmIds, MatchingMode mode, size_t threadsCount,
+                 MwmToMatchedTracks & mwmToMatchedTracks)
+{
+  base::Timer timer;
+
+  MatchingStats total;
+
+  auto processMwm = [&](string const & mwmName, UserToTrack const & userToTrack) {
+    auto const mwmId = numMwmIds.GetId(platform::CountryFile(mwmName));
+
+    auto & userToMatchedTracks = mwmToMatchedTracks[mwmId];
+    auto const stats = MatchUsers(mwmName, userToTrack, mwmId, storage, mode, threadsCount,
+                                  userToMatchedTracks);
 
     if (userToMatchedTracks.empty())
       mwmToMatchedTracks.erase(mwmId);
 
-    tracksCount += matcher.GetTracksCount();
-    pointsCount += matcher.GetPointsCount();
-    nonMatchedPointsCount += matcher.GetNonMatchedPointsCount();
+    total.Add(stats);
 
     LOG(LINFO, (numMwmIds.GetFile(mwmId).GetName(), ", users:", userToTrack.size(), ", tracks:",
-                matcher.GetTracksCount(), ", points:", matcher.GetPointsCount(),
-                ", non matched points:", matcher.GetNonMatchedPointsCount()));
+                stats.m_tracksCount, ", points:", stats.m_pointsCount,
+                ", non matched points:", stats.m_nonMatchedPointsCount));
   };
 
   ForTracksSortedByMwmName(mwmToTracks, numMwmIds, processMwm);
 
-  LOG(LINFO,
-      ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, tracks:", tracksCount,
-       ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount));
+  LOG(LINFO, ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, tracks:",
+              total.m_tracksCount, ", points:", total.m_pointsCount,
+              ", non matched points:", total.m_nonMatchedPointsCount));
 }
 }  // namespace
 
 namespace track_analyzing
 {
-void CmdMatch(string const & logFile, string const & trackFile, shared_ptr<NumMwmIds> numMwmIds, Storage & storage)
+void CmdMatch(string const & logFile, string const & trackFile, shared_ptr<NumMwmIds> numMwmIds,
+              Storage & storage, MatchingMode mode, size_t threadsCount)
 {
   MwmToTracks mwmToTracks;
   ParseTracks(logFile, numMwmIds, storage, mwmToTracks);
 
   MwmToMatchedTracks mwmToMatchedTracks;
-  MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks);
+  MatchTracks(mwmToTracks, storage, *numMwmIds, mode, threadsCount, mwmToMatchedTracks);
 
   FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
   MwmToMatchedTracksSerializer serializer(numMwmIds);
@@ -103,15 +166,18 @@ void CmdMatch(string const & logFile, string const & trackFile, shared_ptr<NumMw
   LOG(LINFO, ("Matched tracks were saved to", trackFile));
 }
 
-void CmdMatch(string const & logFile, string const & trackFile)
+void CmdMatch(string const & logFile, string const & trackFile, MatchingMode mode)
 {
   LOG(LINFO, ("Matching", logFile));
   shared_ptr<NumMwmIds> numMwmIds;
   Storage storage;
-  CmdMatch(logFile, trackFile, numMwmIds, storage);
+  auto const threadsCount = max(static_cast<size_t>(thread::hardware_concurrency()),
+                                static_cast<size_t>(1));
+  CmdMatch(logFile, trackFile, numMwmIds, storage, mode, threadsCount);
 }
 
-void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, shared_ptr<NumMwmIds> numMwmIds)
+void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, shared_ptr<NumMwmIds> numMwmIds,
+                   MatchingMode mode)
 {
   Storage storage;
   for (auto it = begin; it != end; ++it)
@@ -145,12 +211,13 @@ void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, shared_ptr<Num
       continue;
     }
 
-    CmdMatch(file, file + trackExt, numMwmIds, storage);
+    // Files are matched on several threads already.
+    CmdMatch(file, file + trackExt, numMwmIds, storage, mode, 1 /* threadsCount */);
     FileWriter::DeleteFileX(file);
   }
 }
 
-void CmdMatchDir(string const & logDir, string const & trackExt)
+void CmdMatchDir(string const & logDir, string const & trackExt, MatchingMode mode)
 {
   Platform::EFileType fileType = Platform::FILE_TYPE_UNKNOWN;
   Platform::EError const result = Platform::GetFileType(logDir, fileType);
@@ -193,11 +260,11 @@ void CmdMatchDir(string const & logDir, string const & trackExt)
   for (size_t i = 0; i < threadsCount - 1; ++i)
   {
     auto end = begin + blockSize;
-    threads[i] = thread(UnzipAndMatch, begin, end, trackExt, numMwmIds);
+    threads[i] = thread(UnzipAndMatch, begin, end, trackExt, numMwmIds, mode);
     begin = end;
   }
 
-  UnzipAndMatch(begin, filesList.end(), trackExt, numMwmIds);
+  UnzipAndMatch(begin, filesList.end(), trackExt, numMwmIds, mode);
   for (auto & t : threads)
     t.join();
 }
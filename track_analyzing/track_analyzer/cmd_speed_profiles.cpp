@@ -0,0 +1,157 @@
+#include "track_analyzing/track.hpp"
+#include "track_analyzing/utils.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/speed_profiles.hpp"
+
+#include "routing_common/car_model.hpp"
+#include "routing_common/vehicle_model.hpp"
+
+#include "storage/routing_helpers.hpp"
+#include "storage/storage.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/logging.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "defines.hpp"
+
+using namespace routing;
+using namespace std;
+using namespace track_analyzing;
+
+namespace
+{
+// Buckets with less observed time are considered as buckets without data.
+uint64_t constexpr kMinBucketTimeSec = 60;
+// Longer intervals between points are likely stops or gaps of the track.
+uint64_t constexpr kMaxPointsIntervalSec = 30;
+
+struct BucketInfo
+{
+  double m_distance = 0.0;
+  uint64_t m_time = 0;
+};
+
+// Feature id and direction to observed speeds by buckets.
+using MwmSpeeds = map<pair<uint32_t, bool>, map<uint32_t, BucketInfo>>;
+
+void AddTrack(MatchedTrack const & track, MwmSpeeds & speeds)
+{
+  for (size_t i = 1; i < track.size(); ++i)
+  {
+    auto const & prev = track[i - 1];
+    auto const & cur = track[i];
+    Segment const & segment = prev.GetSegment();
+    if (segment.GetFeatureId() != cur.GetSegment().GetFeatureId() ||
+        segment.IsForward() != cur.GetSegment().IsForward())
+    {
+      continue;
+    }
+
+    auto const & prevPoint = prev.GetDataPoint();
+    auto const & curPoint = cur.GetDataPoint();
+    if (curPoint.m_timestamp <= prevPoint.m_timestamp ||
+        curPoint.m_timestamp - prevPoint.m_timestamp > kMaxPointsIntervalSec)
+    {
+      continue;
+    }
+
+    uint32_t const bucket =
+        SpeedProfiles::GetWeekTimeSec(static_cast<time_t>(prevPoint.m_timestamp),
+                                      prevPoint.m_latLon.lon) /
+        SpeedProfiles::kBucketSec;
+    auto & info = speeds[make_pair(segment.GetFeatureId(), segment.IsForward())][bucket];
+    info.m_distance += ms::DistanceOnEarth(prevPoint.m_latLon, curPoint.m_latLon);
+    info.m_time += curPoint.m_timestamp - prevPoint.m_timestamp;
+  }
+}
+
+void WriteProfiles(string const & mwmFile, shared_ptr<VehicleModelInterface> vehicleModel,
+                   MwmSpeeds const & speeds)
+{
+  Geometry geometry(GeometryLoader::CreateFromFile(mwmFile, vehicleModel));
+
+  vector<SpeedProfiles::Profile> profiles;
+  for (auto const & kv : speeds)
+  {
+    SpeedProfiles::Profile profile;
+    profile.m_featureId = kv.first.first;
+    profile.m_isForward = kv.first.second;
+
+    double const modelSpeedKMpH = geometry.GetRoad(profile.m_featureId).GetSpeed().m_eta;
+    if (modelSpeedKMpH <= 0.0)
+      continue;
+
+    bool hasData = false;
+    for (auto const & bucket : kv.second)
+    {
+      if (bucket.second.m_time < kMinBucketTimeSec)
+        continue;
+
+      double const speedKMpH = CalcSpeedKMpH(bucket.second.m_distance, bucket.second.m_time);
+      profile.m_levels[bucket.first] = SpeedProfiles::FactorToLevel(speedKMpH / modelSpeedKMpH);
+      hasData = true;
+    }
+
+    if (hasData)
+      profiles.push_back(profile);
+  }
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  FileWriter writer = cont.GetWriter(SPEED_PROFILES_FILE_TAG);
+  SpeedProfiles::Serialize(profiles, writer);
+}
+}  // namespace
+
+namespace track_analyzing
+{
+void CmdSpeedProfiles(string const & filepath, string const & trackExtension,
+                      StringFilter mwmFilter, StringFilter userFilter)
+{
+  storage::Storage storage;
+  storage.RegisterAllLocalMaps(false /* enableDiffs */);
+  auto numMwmIds = CreateNumMwmIds(storage);
+
+  // Tracks of an mwm may be in several files, so the sections are written after all the files.
+  map<string, MwmSpeeds> mwmToSpeeds;
+  auto processMwm = [&](string const & mwmName, UserToMatchedTracks const & userToMatchedTracks) {
+    if (mwmFilter(mwmName))
+      return;
+
+    auto & speeds = mwmToSpeeds[mwmName];
+    for (auto const & kv : userToMatchedTracks)
+    {
+      if (userFilter(kv.first))
+        continue;
+
+      for (auto const & track : kv.second)
+        AddTrack(track, speeds);
+    }
+  };
+
+  auto processTrack = [&](string const & filename, MwmToMatchedTracks const & mwmToMatchedTracks) {
+    LOG(LINFO, ("Processing", filename));
+    ForTracksSortedByMwmName(mwmToMatchedTracks, *numMwmIds, processMwm);
+  };
+
+  ForEachTrackFile(filepath, trackExtension, numMwmIds, mwmFilter, userFilter, processTrack);
+
+  for (auto const & kv : mwmToSpeeds)
+  {
+    LOG(LINFO, ("Writing", SPEED_PROFILES_FILE_TAG, "section of", kv.first));
+    WriteProfiles(GetCurrentVersionMwmFile(storage, kv.first),
+                  CarModelFactory({}).GetVehicleModelForCountry(kv.first), kv.second);
+  }
+}
+}  // namespace track_analyzing
@@ -379,6 +379,6 @@ void CmdTagsTable(string const & filepath, string const & trackExtension, String
     ForTracksSortedByMwmName(mwmToMatchedTracks, *numMwmIds, processMwm);
   };
 
-  ForEachTrackFile(filepath, trackExtension, numMwmIds, processTrack);
+  ForEachTrackFile(filepath, trackExtension, numMwmIds, mwmFilter, userFilter, processTrack);
 }
 }  // namespace track_analyzing
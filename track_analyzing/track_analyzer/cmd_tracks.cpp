@@ -207,7 +207,7 @@ void CmdTracks(string const & filepath, string const & trackExtension, StringFil
     ForTracksSortedByMwmName(mwmToMatchedTracks, *numMwmIds, processMwm);
   };
 
-  ForEachTrackFile(filepath, trackExtension, numMwmIds, processFile);
+  ForEachTrackFile(filepath, trackExtension, numMwmIds, mwmFilter, userFilter, processFile);
 
   if (!noMwmLogs)
   {
@@ -1,5 +1,6 @@
 #include "track_analyzing/exceptions.hpp"
 #include "track_analyzing/track.hpp"
+#include "track_analyzing/track_matcher.hpp"
 #include "track_analyzing/utils.hpp"
 
 #include "indexer/classificator.hpp"
@@ -38,6 +39,8 @@ DEFINE_string_ext(cmd, "",
                   "track - prints info about single track\n"
                   "cpptrack - prints track coords to insert them to cpp code\n"
                   "table - prints csv table based on matched tracks\n"
+                  "speed_profiles - writes historical speed profiles of matched tracks to "
+                  "mwms of the current version\n"
                   "gpx - convert raw logs into gpx files\n");
 DEFINE_string_ext(in, "", "input log file name");
 DEFINE_string(out, "", "output track file name");
@@ -56,6 +59,8 @@ DEFINE_double(min_length, 1000.0, "minimum track length in meters");
 DEFINE_double(min_speed, 15.0, "minimum track average speed in km/hour");
 DEFINE_double(max_speed, 110.0, "maximum track average speed in km/hour");
 DEFINE_bool(ignore_traffic, true, "ignore tracks with traffic data");
+DEFINE_bool(viterbi, false,
+            "match and match_dir: match tracks with the hidden Markov model (Viterbi) matcher");
 
 size_t Checked_track()
 {
@@ -65,6 +70,11 @@ size_t Checked_track()
   return static_cast<size_t>(FLAGS_track);
 }
 
+MatchingMode GetMatchingMode()
+{
+  return FLAGS_viterbi ? MatchingMode::Viterbi : MatchingMode::Greedy;
+}
+
 StringFilter MakeFilter(string const & filter)
 {
   return [&](string const & value) {
@@ -81,14 +91,17 @@ namespace track_analyzing
 void CmdCppTrack(string const & trackFile, string const & mwmName, string const & user,
                  size_t trackIdx);
 // Match raw gps logs to tracks.
-void CmdMatch(string const & logFile, string const & trackFile);
+void CmdMatch(string const & logFile, string const & trackFile, MatchingMode mode);
 // The same as match but applies for the directory with raw logs.
-void CmdMatchDir(string const & logDir, string const & trackExt);
+void CmdMatchDir(string const & logDir, string const & trackExt, MatchingMode mode);
 // Parse |logFile| and save tracks (mwm name, aloha id, lats, lons, timestamps in seconds in csv).
 void CmdUnmatchedTracks(string const & logFile, string const & trackFileCsv);
 // Print aggregated tracks to csv table.
 void CmdTagsTable(string const & filepath, string const & trackExtension,
                   StringFilter mwmIsFiltered, StringFilter userFilter);
+// Build speed profiles sections of mwms based on matched tracks.
+void CmdSpeedProfiles(string const & filepath, string const & trackExtension,
+                      StringFilter mwmFilter, StringFilter userFilter);
 // Print track information.
 void CmdTrack(string const & trackFile, string const & mwmName, string const & user,
               size_t trackIdx);
@@ -112,12 +125,12 @@ int main(int argc, char ** argv)
     if (cmd == "match")
     {
       string const & logFile = Checked_in();
-      CmdMatch(logFile, FLAGS_out.empty() ? logFile + ".track" : FLAGS_out);
+      CmdMatch(logFile, FLAGS_out.empty() ? logFile + ".track" : FLAGS_out, GetMatchingMode());
     }
     if (cmd == "match_dir")
     {
       string const & logDir = Checked_in();
-      CmdMatchDir(logDir, FLAGS_track_extension);
+      CmdMatchDir(logDir, FLAGS_track_extension, GetMatchingMode());
     }
     else if (cmd == "unmatched_tracks")
     {
@@ -144,6 +157,11 @@ int main(int argc, char ** argv)
       CmdTagsTable(Checked_in(), FLAGS_track_extension, MakeFilter(FLAGS_mwm),
                    MakeFilter(FLAGS_user));
     }
+    else if (cmd == "speed_profiles")
+    {
+      CmdSpeedProfiles(Checked_in(), FLAGS_track_extension, MakeFilter(FLAGS_mwm),
+                       MakeFilter(FLAGS_user));
+    }
     else if (cmd == "gpx")
     {
       CmdGPX(Checked_in(), Checked_output_dir(), FLAGS_user);
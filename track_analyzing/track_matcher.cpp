@@ -13,6 +13,15 @@
 
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <queue>
+#include <utility>
+
 using namespace routing;
 using namespace std;
 using namespace track_analyzing;
@@ -22,6 +31,16 @@ namespace
 // Matching range in meters.
 double constexpr kMatchingRange = 20.0;
 
+// Viterbi mode parameters. The emission cost of a candidate is (distance / kGpsSigma)^2 / 2, the
+// transition cost is |road distance - great circle distance| / kTransitionBeta, both in meters.
+double constexpr kGpsSigma = 5.0;
+double constexpr kTransitionBeta = 10.0;
+// Road distance between consecutive points is searched up to
+// max(kMinTransitionDistance, kTransitionFactor * great circle distance) + 2 * kMatchingRange.
+double constexpr kMinTransitionDistance = 100.0;
+double constexpr kTransitionFactor = 3.0;
+double constexpr kInf = numeric_limits<double>::max();
+
 // Mercator distance from segment to point in meters.
 double DistanceToSegment(m2::PointD const & segmentBegin, m2::PointD const & segmentEnd,
                          m2::PointD const & point)
@@ -37,6 +56,28 @@ double DistanceToSegment(Segment const & segment, m2::PointD const & point, Inde
                            indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(true)), point);
 }
 
+m2::PointD ProjectToSegment(Segment const & segment, m2::PointD const & point,
+                            IndexGraph & indexGraph)
+{
+  m2::ParametrizedSegment<m2::PointD> const s(
+      indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(false)),
+      indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(true)));
+  return s.ClosestPointTo(point);
+}
+
+double GetSegmentLength(Segment const & segment, IndexGraph & indexGraph)
+{
+  return MercatorBounds::DistanceOnEarth(
+      indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(false)),
+      indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(true)));
+}
+
+double GetEmissionCost(double distance)
+{
+  double const x = distance / kGpsSigma;
+  return 0.5 * x * x;
+}
+
 bool EdgesContain(vector<SegmentEdge> const & edges, Segment const & segment)
 {
   for (auto const & edge : edges)
@@ -53,17 +94,42 @@ namespace track_analyzing
 {
 // TrackMatcher ------------------------------------------------------------------------------------
 TrackMatcher::TrackMatcher(storage::Storage const & storage, NumMwmId mwmId,
-                           platform::CountryFile const & countryFile)
+                           platform::CountryFile const & countryFile, MatchingMode mode)
   : m_mwmId(mwmId)
+  , m_mode(mode)
+  , m_ownDataSource(make_unique<FrozenDataSource>())
+  , m_dataSource(*m_ownDataSource)
   , m_vehicleModel(CarModelFactory({}).GetVehicleModelForCountry(countryFile.GetName()))
+{
+  RegisterMwm(storage, countryFile, m_dataSource);
+  Init(countryFile);
+}
+
+TrackMatcher::TrackMatcher(DataSource & dataSource, NumMwmId mwmId,
+                           platform::CountryFile const & countryFile, MatchingMode mode)
+  : m_mwmId(mwmId)
+  , m_mode(mode)
+  , m_dataSource(dataSource)
+  , m_vehicleModel(CarModelFactory({}).GetVehicleModelForCountry(countryFile.GetName()))
+{
+  Init(countryFile);
+}
+
+// static
+void TrackMatcher::RegisterMwm(storage::Storage const & storage,
+                               platform::CountryFile const & countryFile, DataSource & dataSource)
 {
   auto localCountryFile = storage.GetLatestLocalFile(countryFile);
   CHECK(localCountryFile, ("Can't find latest country file for", countryFile.GetName()));
-  auto registerResult = m_dataSource.Register(*localCountryFile);
+  auto registerResult = dataSource.Register(*localCountryFile);
   CHECK_EQUAL(registerResult.second, MwmSet::RegResult::Success,
               ("Can't register mwm", countryFile.GetName()));
+}
 
+void TrackMatcher::Init(platform::CountryFile const & countryFile)
+{
   MwmSet::MwmHandle const handle = m_dataSource.GetMwmHandleByCountryFile(countryFile);
+  CHECK(handle.IsAlive(), ("Mwm is not registered", countryFile.GetName()));
   m_graph = make_unique<IndexGraph>(
       make_shared<Geometry>(GeometryLoader::Create(m_dataSource, handle, m_vehicleModel,
                                                    LoadCityRoads(m_dataSource, handle),
@@ -82,6 +148,15 @@ void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTra
   for (auto const & routePoint : track)
     steps.emplace_back(routePoint);
 
+  switch (m_mode)
+  {
+  case MatchingMode::Greedy: MatchTrackGreedy(steps, matchedTracks); break;
+  case MatchingMode::Viterbi: MatchTrackViterbi(steps, matchedTracks); break;
+  }
+}
+
+void TrackMatcher::MatchTrackGreedy(vector<Step> & steps, vector<MatchedTrack> & matchedTracks)
+{
   for (size_t trackBegin = 0; trackBegin < steps.size();)
   {
     for (; trackBegin < steps.size(); ++trackBegin)
@@ -126,6 +201,191 @@ void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTra
   }
 }
 
+void TrackMatcher::MatchTrackViterbi(vector<Step> & steps, vector<MatchedTrack> & matchedTracks)
+{
+  size_t constexpr kNoParent = numeric_limits<size_t>::max();
+
+  // Costs of the best paths to candidates of the steps of the current track and indices of
+  // previous candidates on these paths.
+  vector<vector<double>> costs;
+  vector<vector<size_t>> parents;
+
+  for (size_t trackBegin = 0; trackBegin < steps.size();)
+  {
+    for (; trackBegin < steps.size(); ++trackBegin)
+    {
+      steps[trackBegin].FillCandidatesWithNearbySegments(m_dataSource, *m_graph, *m_vehicleModel,
+                                                         m_mwmId);
+      if (steps[trackBegin].HasCandidates())
+        break;
+
+      ++m_nonMatchedPointsCount;
+    }
+
+    if (trackBegin >= steps.size())
+      break;
+
+    costs.clear();
+    parents.clear();
+    costs.emplace_back();
+    for (auto const & candidate : steps[trackBegin].GetCandidates())
+      costs.back().push_back(GetEmissionCost(candidate.GetDistance()));
+    parents.emplace_back(costs.back().size(), kNoParent);
+
+    size_t trackEnd = trackBegin;
+    for (; trackEnd < steps.size() - 1; ++trackEnd)
+    {
+      Step const & prevStep = steps[trackEnd];
+      Step & nextStep = steps[trackEnd + 1];
+      nextStep.FillCandidatesWithNearbySegments(m_dataSource, *m_graph, *m_vehicleModel, m_mwmId);
+
+      auto const & prevCandidates = prevStep.GetCandidates();
+      auto const & nextCandidates = nextStep.GetCandidates();
+      vector<double> nextCosts(nextCandidates.size(), kInf);
+      vector<size_t> nextParents(nextCandidates.size(), kNoParent);
+
+      double const greatCircleDistance =
+          MercatorBounds::DistanceOnEarth(prevStep.GetPoint(), nextStep.GetPoint());
+      double const maxDistance =
+          max(kMinTransitionDistance, kTransitionFactor * greatCircleDistance) +
+          2 * kMatchingRange;
+
+      bool reachable = false;
+      for (size_t i = 0; i < prevCandidates.size(); ++i)
+      {
+        if (costs.back()[i] == kInf)
+          continue;
+
+        auto const distances =
+            GetRoadDistances(prevStep, prevCandidates[i].GetSegment(), nextStep, maxDistance);
+        for (size_t j = 0; j < nextCandidates.size(); ++j)
+        {
+          if (distances[j] == kInf)
+            continue;
+
+          double const cost = costs.back()[i] +
+                              fabs(distances[j] - greatCircleDistance) / kTransitionBeta +
+                              GetEmissionCost(nextCandidates[j].GetDistance());
+          if (cost < nextCosts[j])
+          {
+            nextCosts[j] = cost;
+            nextParents[j] = i;
+            reachable = true;
+          }
+        }
+      }
+
+      // The track is broken when no candidate of the next point is reachable.
+      if (!reachable)
+        break;
+
+      costs.push_back(move(nextCosts));
+      parents.push_back(move(nextParents));
+    }
+
+    auto const & lastCosts = costs.back();
+    size_t candidate = static_cast<size_t>(
+        distance(lastCosts.begin(), min_element(lastCosts.begin(), lastCosts.end())));
+    for (size_t i = trackEnd + 1; i > trackBegin; --i)
+    {
+      Step & step = steps[i - 1];
+      CHECK_LESS(candidate, step.GetCandidates().size(), ());
+      step.SetSegment(step.GetCandidates()[candidate].GetSegment());
+      candidate = parents[i - 1 - trackBegin][candidate];
+    }
+
+    ++m_tracksCount;
+
+    matchedTracks.push_back({});
+    MatchedTrack & matchedTrack = matchedTracks.back();
+    for (size_t i = trackBegin; i <= trackEnd; ++i)
+    {
+      Step const & step = steps[i];
+      matchedTrack.emplace_back(step.GetDataPoint(), step.GetSegment());
+    }
+
+    trackBegin = trackEnd + 1;
+  }
+}
+
+vector<double> TrackMatcher::GetRoadDistances(Step const & from, Segment const & source,
+                                              Step const & to, double maxDistance)
+{
+  auto const & targets = to.GetCandidates();
+  vector<double> result(targets.size(), kInf);
+
+  map<Segment, size_t> targetIndices;
+  for (size_t i = 0; i < targets.size(); ++i)
+    targetIndices.emplace(targets[i].GetSegment(), i);
+
+  m2::PointD const sourceProjection = ProjectToSegment(source, from.GetPoint(), *m_graph);
+  auto const getDistanceToTarget = [&](Segment const & segment) {
+    return MercatorBounds::DistanceOnEarth(
+        m_graph->GetGeometry().GetPoint(segment.GetRoadPoint(false)),
+        ProjectToSegment(segment, to.GetPoint(), *m_graph));
+  };
+
+  auto const sameSegment = targetIndices.find(source);
+  if (sameSegment != targetIndices.end())
+  {
+    result[sameSegment->second] = MercatorBounds::DistanceOnEarth(
+        sourceProjection, ProjectToSegment(source, to.GetPoint(), *m_graph));
+  }
+
+  // Dijkstra over segments, the distance of a segment is the distance to its end.
+  using State = pair<double, Segment>;
+  priority_queue<State, vector<State>, greater<State>> queue;
+  map<Segment, double> distances;
+
+  double const startDistance = MercatorBounds::DistanceOnEarth(
+      sourceProjection, m_graph->GetGeometry().GetPoint(source.GetRoadPoint(true)));
+  distances[source] = startDistance;
+  queue.emplace(startDistance, source);
+
+  vector<SegmentEdge> edges;
+  while (!queue.empty())
+  {
+    State const state = queue.top();
+    queue.pop();
+
+    if (state.first > maxDistance)
+      break;
+    if (state.first > distances[state.second])
+      continue;
+
+    edges.clear();
+    m_graph->GetEdgeList(state.second, true /* isOutgoing */, edges);
+    for (SegmentEdge const & edge : edges)
+    {
+      Segment const & target = edge.GetTarget();
+      if (state.second.IsInverse(target))
+        continue;
+
+      auto const targetIt = targetIndices.find(target);
+      if (targetIt != targetIndices.end())
+      {
+        double & distance = result[targetIt->second];
+        distance = min(distance, state.first + getDistanceToTarget(target));
+      }
+
+      double const distance = state.first + GetSegmentLength(target, *m_graph);
+      auto const it = distances.find(target);
+      if (it == distances.end() || distance < it->second)
+      {
+        distances[target] = distance;
+        queue.emplace(distance, target);
+      }
+    }
+  }
+
+  for (double & distance : result)
+  {
+    if (distance > maxDistance)
+      distance = kInf;
+  }
+  return result;
+}
+
 // TrackMatcher::Step ------------------------------------------------------------------------------
 TrackMatcher::Step::Step(DataPoint const & dataPoint)
   : m_dataPoint(dataPoint), m_point(MercatorBounds::FromLatLon(dataPoint.m_latLon))
@@ -136,6 +396,7 @@ void TrackMatcher::Step::FillCandidatesWithNearbySegments(
     DataSource const & dataSource, IndexGraph const & graph,
     VehicleModelInterface const & vehicleModel, NumMwmId mwmId)
 {
+  m_candidates.clear();
   dataSource.ForEachInRect(
       [&](FeatureType & ft) {
         if (!ft.GetID().IsValid())
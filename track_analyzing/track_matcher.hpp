@@ -19,11 +19,32 @@
 
 namespace track_analyzing
 {
+enum class MatchingMode
+{
+  // Candidates of a point are the neighbours of candidates of the previous point, the nearest
+  // connected candidates are chosen going backwards.
+  Greedy,
+  // Hidden Markov model: the most probable sequence of candidates is found with the Viterbi
+  // algorithm. Transitions are weighted by the difference between the road distance and the
+  // great circle distance of consecutive points.
+  Viterbi
+};
+
 class TrackMatcher final
 {
 public:
+  // Registers the mwm in an own data source.
   TrackMatcher(storage::Storage const & storage, routing::NumMwmId mwmId,
-               platform::CountryFile const & countryFile);
+               platform::CountryFile const & countryFile,
+               MatchingMode mode = MatchingMode::Greedy);
+  // Uses |dataSource| with the mwm registered. The data source may be shared by matchers
+  // of different threads, each matcher keeps its own road graph.
+  TrackMatcher(DataSource & dataSource, routing::NumMwmId mwmId,
+               platform::CountryFile const & countryFile,
+               MatchingMode mode = MatchingMode::Greedy);
+
+  static void RegisterMwm(storage::Storage const & storage,
+                          platform::CountryFile const & countryFile, DataSource & dataSource);
 
   void MatchTrack(std::vector<DataPoint> const & track, std::vector<MatchedTrack> & matchedTracks);
 
@@ -65,6 +86,11 @@ private:
     void ChooseSegment(Step const & nextStep, routing::IndexGraph & indexGraph);
     void ChooseNearestSegment();
 
+    // Viterbi mode.
+    m2::PointD const & GetPoint() const { return m_point; }
+    std::vector<Candidate> const & GetCandidates() const { return m_candidates; }
+    void SetSegment(routing::Segment const & segment) { m_segment = segment; }
+
   private:
     void AddCandidate(routing::Segment const & segment, double distance,
                       routing::IndexGraph const & graph);
@@ -75,8 +101,19 @@ private:
     std::vector<Candidate> m_candidates;
   };
 
+  void Init(platform::CountryFile const & countryFile);
+  void MatchTrackGreedy(std::vector<Step> & steps, std::vector<MatchedTrack> & matchedTracks);
+  void MatchTrackViterbi(std::vector<Step> & steps, std::vector<MatchedTrack> & matchedTracks);
+  // Returns road distances from the projection of |from| point to |source| to projections of
+  // |to| point to its candidates. Candidates which are farther than |maxDistance| get
+  // std::numeric_limits<double>::max().
+  std::vector<double> GetRoadDistances(Step const & from, routing::Segment const & source,
+                                       Step const & to, double maxDistance);
+
   routing::NumMwmId const m_mwmId;
-  FrozenDataSource m_dataSource;
+  MatchingMode const m_mode;
+  std::unique_ptr<FrozenDataSource> m_ownDataSource;
+  DataSource & m_dataSource;
   std::shared_ptr<routing::VehicleModelInterface> m_vehicleModel;
   std::unique_ptr<routing::IndexGraph> m_graph;
   uint64_t m_tracksCount = 0;
@@ -53,11 +53,17 @@ double CalcSpeedKMpH(double meters, uint64_t secondsElapsed)
 
 void ReadTracks(shared_ptr<NumMwmIds> numMwmIds, string const & filename,
                 MwmToMatchedTracks & mwmToMatchedTracks)
+{
+  ReadTracks(numMwmIds, filename, {} /* mwmFilter */, {} /* userFilter */, mwmToMatchedTracks);
+}
+
+void ReadTracks(shared_ptr<NumMwmIds> numMwmIds, string const & filename,
+                StringFilter const & mwmFilter, StringFilter const & userFilter,
+                MwmToMatchedTracks & mwmToMatchedTracks)
 {
   FileReader reader(filename);
-  ReaderSource<FileReader> src(reader);
   MwmToMatchedTracksSerializer serializer(numMwmIds);
-  serializer.Deserialize(mwmToMatchedTracks, src);
+  serializer.Deserialize(mwmToMatchedTracks, reader, mwmFilter, userFilter);
 }
 
 MatchedTrack const & GetMatchedTrack(MwmToMatchedTracks const & mwmToMatchedTracks,
@@ -99,7 +105,8 @@ std::string GetCurrentVersionMwmFile(storage::Storage const & storage, std::stri
 
 void ForEachTrackFile(
     std::string const & filepath, std::string const & extension,
-    shared_ptr<routing::NumMwmIds> numMwmIds,
+    shared_ptr<routing::NumMwmIds> numMwmIds, StringFilter const & mwmFilter,
+    StringFilter const & userFilter,
     std::function<void(std::string const & filename, MwmToMatchedTracks const &)> && toDo)
 {
   Platform::EFileType fileType = Platform::FILE_TYPE_UNKNOWN;
@@ -114,7 +121,7 @@ void ForEachTrackFile(
   if (fileType == Platform::FILE_TYPE_REGULAR)
   {
     MwmToMatchedTracks mwmToMatchedTracks;
-    ReadTracks(numMwmIds, filepath, mwmToMatchedTracks);
+    ReadTracks(numMwmIds, filepath, mwmFilter, userFilter, mwmToMatchedTracks);
     toDo(filepath, mwmToMatchedTracks);
     return;
   }
@@ -130,7 +137,7 @@ void ForEachTrackFile(
         continue;
 
       MwmToMatchedTracks mwmToMatchedTracks;
-      ReadTracks(numMwmIds, file, mwmToMatchedTracks);
+      ReadTracks(numMwmIds, file, mwmFilter, userFilter, mwmToMatchedTracks);
       toDo(file, mwmToMatchedTracks);
     }
 
@@ -28,6 +28,10 @@ double CalcTrackLength(MatchedTrack const & track, routing::Geometry & geometry)
 double CalcSpeedKMpH(double meters, uint64_t secondsElapsed);
 void ReadTracks(std::shared_ptr<routing::NumMwmIds> numMwmIds, std::string const & filename,
                 MwmToMatchedTracks & mwmToMatchedTracks);
+// Tracks of mwms and users which are filtered out are skipped without decoding.
+void ReadTracks(std::shared_ptr<routing::NumMwmIds> numMwmIds, std::string const & filename,
+                StringFilter const & mwmFilter, StringFilter const & userFilter,
+                MwmToMatchedTracks & mwmToMatchedTracks);
 MatchedTrack const & GetMatchedTrack(MwmToMatchedTracks const & mwmToMatchedTracks,
                                      routing::NumMwmIds const & numMwmIds,
                                      std::string const & mwmName, std::string const & user,
@@ -53,8 +57,10 @@ void ForTracksSortedByMwmName(MwmToTracks const & mwmToTracks, routing::NumMwmId
   }
 }
 
+// Tracks of mwms and users which are filtered out are not passed to |toDo|.
 void ForEachTrackFile(
     std::string const & filepath, std::string const & extension,
-    std::shared_ptr<routing::NumMwmIds> numMwmIds,
+    std::shared_ptr<routing::NumMwmIds> numMwmIds, StringFilter const & mwmFilter,
+    StringFilter const & userFilter,
     std::function<void(std::string const & filename, MwmToMatchedTracks const &)> && toDo);
 }  // namespace track_analyzing
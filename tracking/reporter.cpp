@@ -29,14 +29,19 @@ const char Reporter::kEnableTrackingKey[] = "StatisticsEnabled";
 
 // static
 milliseconds const Reporter::kPushDelayMs = milliseconds(20000);
+// static
+uint32_t const Reporter::kWwanPushDelayFactor = 3;
 
-// Set m_points size to be enough to keep all points even if one reconnect attempt failed.
+// Set m_points size to be enough to keep all points collected over the longest push delay
+// even if one reconnect attempt failed.
 Reporter::Reporter(unique_ptr<platform::Socket> socket, string const & host, uint16_t port,
                    milliseconds pushDelay)
   : m_allowSendingPoints(true)
   , m_realtimeSender(move(socket), host, port, false)
   , m_pushDelay(pushDelay)
-  , m_points(ceil(duration_cast<seconds>(pushDelay).count() + kReconnectDelaySeconds) / kMinDelaySeconds)
+  , m_points(ceil(duration_cast<seconds>(pushDelay * kWwanPushDelayFactor).count() +
+                  kReconnectDelaySeconds) /
+             kMinDelaySeconds)
   , m_thread([this] { Run(); })
 {
 }
@@ -80,6 +85,12 @@ void Reporter::AddLocation(location::GpsInfo const & info, traffic::SpeedGroup t
                 static_cast<std::underlying_type<traffic::SpeedGroup>::type>(traffic)));
 }
 
+void Reporter::SetConnectionTypeFunc(function<Platform::EConnectionType()> fn)
+{
+  lock_guard<mutex> lg(m_mutex);
+  m_connectionTypeFn = fn;
+}
+
 void Reporter::Run()
 {
   LOG(LINFO, ("Tracking Reporter started"));
@@ -93,22 +104,26 @@ void Reporter::Run()
     // Fetch input.
     m_points.insert(m_points.end(), m_input.begin(), m_input.end());
     m_input.clear();
+    auto const connectionTypeFn = m_connectionTypeFn;
 
     lock.unlock();
+    // Without a network points are kept till the next push.
+    auto const connectionType = connectionTypeFn();
     if (m_points.empty() && m_idleFn)
     {
       m_idleFn();
     }
-    else
+    else if (connectionType != Platform::EConnectionType::CONNECTION_NONE)
     {
       if (SendPoints())
         m_points.clear();
     }
     lock.lock();
 
+    auto const pushDelay = GetPushDelay(connectionType);
     auto const passedMs = duration_cast<milliseconds>(steady_clock::now() - startTime);
-    if (passedMs < m_pushDelay)
-      m_cv.wait_for(lock, m_pushDelay - passedMs, [this]{return m_isFinished;});
+    if (passedMs < pushDelay)
+      m_cv.wait_for(lock, pushDelay - passedMs, [this]{return m_isFinished;});
   }
 
   LOG(LINFO, ("Tracking Reporter finished"));
@@ -148,4 +163,11 @@ bool Reporter::SendPoints()
   m_wasConnected = m_realtimeSender.Send(m_points);
   return m_wasConnected;
 }
+
+milliseconds Reporter::GetPushDelay(Platform::EConnectionType connectionType) const
+{
+  if (connectionType == Platform::EConnectionType::CONNECTION_WWAN)
+    return m_pushDelay * kWwanPushDelayFactor;
+  return m_pushDelay;
+}
 }  // namespace tracking
@@ -4,6 +4,8 @@
 
 #include "traffic/speed_groups.hpp"
 
+#include "platform/platform.hpp"
+
 #include "base/thread.hpp"
 
 #include "std/atomic.hpp"
@@ -33,6 +35,9 @@ class Reporter final
 {
 public:
   static milliseconds const kPushDelayMs;
+  // Points are sent |kWwanPushDelayFactor| times less often over a cellular network
+  // to wake the radio up less.
+  static uint32_t const kWwanPushDelayFactor;
   static const char kEnableTrackingKey[];
 
   Reporter(unique_ptr<platform::Socket> socket, string const & host, uint16_t port,
@@ -45,9 +50,13 @@ public:
 
   inline void SetIdleFunc(function<void()> fn) { m_idleFn = fn; }
 
+  // By default the connection type is Platform::ConnectionStatus().
+  void SetConnectionTypeFunc(function<Platform::EConnectionType()> fn);
+
 private:
   void Run();
   bool SendPoints();
+  milliseconds GetPushDelay(Platform::EConnectionType connectionType) const;
 
   atomic<bool> m_allowSendingPoints;
   Connection m_realtimeSender;
@@ -58,6 +67,7 @@ private:
   // Function to be called every |kPushDelayMs| in
   // case no points were sent.
   function<void()> m_idleFn;
+  function<Platform::EConnectionType()> m_connectionTypeFn = &Platform::ConnectionStatus;
   // Input buffer for incoming points. Worker thread steals it contents.
   vector<DataPoint> m_input;
   // Last collected points, sends periodically to server.
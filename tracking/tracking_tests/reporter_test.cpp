@@ -48,6 +48,7 @@ void TransferLocation(Reporter & reporter, TestSocket & testSocket, double times
     }
     case Packet::DataV0:
     case Packet::DataV1:
+    case Packet::DataV2:
     {
       readSize = 0;
       break;
@@ -93,6 +94,7 @@ UNIT_TEST(Reporter_TransferLocations)
   TestSocket & testSocket = *socket.get();
 
   Reporter reporter(move(socket), "localhost", 0, milliseconds(10) /* pushDelay */);
+  reporter.SetConnectionTypeFunc([] { return Platform::EConnectionType::CONNECTION_WIFI; });
   TransferLocation(reporter, testSocket, 1.0, 2.0, 3.0);
   TransferLocation(reporter, testSocket, 4.0, 5.0, 6.0);
   TransferLocation(reporter, testSocket, 7.0, 8.0, 9.0);
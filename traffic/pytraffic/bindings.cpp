@@ -8,13 +8,21 @@
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 #include "base/math.hpp"
+#include "base/thread.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/cstdint.hpp"
+#include "std/exception.hpp"
 #include "std/map.hpp"
+#include "std/mutex.hpp"
 #include "std/sstream.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
 #include "std/vector.hpp"
 
+#include "pyhelpers/python_buffer.hpp"
+#include "pyhelpers/scoped_gil_release.hpp"
 #include "pyhelpers/vector_list_conversion.hpp"
 #include "pyhelpers/vector_uint8.hpp"
 
@@ -101,8 +109,7 @@ boost::python::list GenerateTrafficKeys(string const & mwmPath)
   return std_vector_to_python_list(result);
 }
 
-vector<uint8_t> GenerateTrafficValues(vector<traffic::TrafficInfo::RoadSegmentId> const & keys,
-                                      boost::python::dict const & segmentMappingDict)
+SegmentMapping ToSegmentMapping(boost::python::dict const & segmentMappingDict)
 {
   SegmentMapping segmentMapping;
   boost::python::list mappingKeys = segmentMappingDict.keys();
@@ -113,7 +120,13 @@ vector<uint8_t> GenerateTrafficValues(vector<traffic::TrafficInfo::RoadSegmentId
       segmentMapping[extract<traffic::TrafficInfo::RoadSegmentId>(mappingKeys[i])] =
           extract<SegmentSpeeds>(segmentMappingDict[mappingKeys[i]]);
   }
+  return segmentMapping;
+}
 
+// Doesn't use Python objects, so it may be called with the GIL released.
+vector<uint8_t> EncodeTrafficValues(vector<traffic::TrafficInfo::RoadSegmentId> const & keys,
+                                    SegmentMapping const & segmentMapping)
+{
   traffic::TrafficInfo::Coloring const knownColors = TransformToSpeedGroups(segmentMapping);
   traffic::TrafficInfo::Coloring coloring;
   traffic::TrafficInfo::CombineColorings(keys, knownColors, coloring);
@@ -134,6 +147,12 @@ vector<uint8_t> GenerateTrafficValues(vector<traffic::TrafficInfo::RoadSegmentId
   return buf;
 }
 
+vector<uint8_t> GenerateTrafficValues(vector<traffic::TrafficInfo::RoadSegmentId> const & keys,
+                                      boost::python::dict const & segmentMappingDict)
+{
+  return EncodeTrafficValues(keys, ToSegmentMapping(segmentMappingDict));
+}
+
 vector<uint8_t> GenerateTrafficValuesFromList(boost::python::list const & keys,
                                               boost::python::dict const & segmentMappingDict)
 {
@@ -152,6 +171,114 @@ vector<uint8_t> GenerateTrafficValuesFromBinary(vector<uint8_t> const & keysBlob
   return GenerateTrafficValues(keys, segmentMappingDict);
 }
 
+void RaisePythonError(PyObject * type, string const & message)
+{
+  PyErr_SetString(type, message.c_str());
+  throw_error_already_set();
+}
+
+// Calls |fn(i)| for every i in [0, count) on |threadsCount| threads, on all the cores when
+// |threadsCount| is zero. The GIL is released meanwhile, so |fn| must not use Python objects.
+// Raises RuntimeError if |fn| throws.
+template <typename Fn>
+void ParallelFor(size_t count, size_t threadsCount, Fn && fn)
+{
+  if (threadsCount == 0)
+    threadsCount = max(thread::hardware_concurrency(), 1u);
+  threadsCount = min(threadsCount, count);
+
+  atomic<size_t> next(0);
+  mutex mu;
+  string error;
+  {
+    scoped_gil_release const release;
+    auto const process = [&]() {
+      for (size_t i = next++; i < count; i = next++)
+      {
+        try
+        {
+          fn(i);
+        }
+        catch (std::exception const & e)
+        {
+          lock_guard<mutex> lock(mu);
+          if (error.empty())
+            error = e.what();
+        }
+      }
+    };
+
+    vector<threads::SimpleThread> threads;
+    for (size_t i = 1; i < threadsCount; ++i)
+      threads.emplace_back(process);
+    process();
+    for (auto & t : threads)
+      t.join();
+  }
+
+  if (!error.empty())
+    RaisePythonError(PyExc_RuntimeError, error);
+}
+
+// Serializes the colorings of several mwms in parallel. |keysBlobs| are serialized keys of the
+// mwms, they are read in place from any objects which support the buffer protocol.
+boost::python::list GenerateTrafficValuesMany(boost::python::list const & keysBlobs,
+                                              boost::python::list const & segmentMappingDicts,
+                                              size_t threadsCount)
+{
+  auto const count = static_cast<size_t>(len(keysBlobs));
+  if (static_cast<size_t>(len(segmentMappingDicts)) != count)
+    RaisePythonError(PyExc_ValueError, "Numbers of keys and segment mappings differ.");
+
+  vector<python_buffer> blobs;
+  vector<SegmentMapping> segmentMappings;
+  blobs.reserve(count);
+  segmentMappings.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    blobs.emplace_back(keysBlobs[i]);
+    segmentMappings.push_back(ToSegmentMapping(extract<boost::python::dict>(segmentMappingDicts[i])));
+  }
+
+  vector<vector<uint8_t>> values(count);
+  ParallelFor(count, threadsCount, [&](size_t i) {
+    vector<traffic::TrafficInfo::RoadSegmentId> keys;
+    traffic::TrafficInfo::DeserializeTrafficKeys(blobs[i].data(), blobs[i].size(), keys);
+    values[i] = EncodeTrafficValues(keys, segmentMappings[i]);
+  });
+
+  boost::python::list result;
+  for (auto const & v : values)
+    result.append(v);
+  return result;
+}
+
+// Deserializes the values of several mwms in parallel. Values of an mwm are returned as bytes
+// with a SpeedGroup per byte, in the order of the keys of the mwm.
+boost::python::list DecodeTrafficValuesMany(boost::python::list const & valuesBlobs,
+                                            size_t threadsCount)
+{
+  auto const count = static_cast<size_t>(len(valuesBlobs));
+  vector<python_buffer> blobs;
+  blobs.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    blobs.emplace_back(valuesBlobs[i]);
+
+  vector<vector<uint8_t>> values(count);
+  ParallelFor(count, threadsCount, [&](size_t i) {
+    vector<traffic::SpeedGroup> speedGroups;
+    traffic::TrafficInfo::DeserializeTrafficValues(blobs[i].data(), blobs[i].size(), speedGroups);
+    values[i].reserve(speedGroups.size());
+    for (auto const sg : speedGroups)
+      values[i].push_back(static_cast<uint8_t>(sg));
+  });
+
+  boost::python::list result;
+  for (auto const & v : values)
+    result.append(v);
+  return result;
+}
+
 void LoadClassificator(string const & classifPath)
 {
   GetPlatform().SetResourceDir(classifPath);
@@ -199,4 +326,8 @@ BOOST_PYTHON_MODULE(pytraffic)
   def("generate_traffic_keys", GenerateTrafficKeys);
   def("generate_traffic_values_from_list", GenerateTrafficValuesFromList);
   def("generate_traffic_values_from_binary", GenerateTrafficValuesFromBinary);
+  def("generate_traffic_values_many", GenerateTrafficValuesMany,
+      (arg("keys_blobs"), arg("segment_mappings"), arg("threads_count") = 0));
+  def("decode_traffic_values_many", DecodeTrafficValuesMany,
+      (arg("values_blobs"), arg("threads_count") = 0));
 }
@@ -2,9 +2,11 @@ from __future__ import print_function
 from pytraffic import (RoadSegmentId,
                        SegmentSpeeds,
                        load_classificator,
+                       decode_traffic_values_many,
                        generate_traffic_keys,
                        generate_traffic_values_from_binary,
-                       generate_traffic_values_from_list)
+                       generate_traffic_values_from_list,
+                       generate_traffic_values_many)
 import argparse
 
 parser = argparse.ArgumentParser(description='Example usage of pytraffic.')
@@ -45,3 +47,8 @@ buf1 = generate_traffic_values_from_list(keys, mapping)
 
 with open(options.path_to_keys, "rb") as bin_data:
   buf2 = generate_traffic_values_from_binary(bin_data.read(), {})
+
+with open(options.path_to_keys, "rb") as bin_data:
+  keys_blob = bin_data.read()
+  bufs = generate_traffic_values_many([keys_blob, keys_blob], [mapping, {}], threads_count=2)
+  print([len(values) for values in decode_traffic_values_many(bufs)])
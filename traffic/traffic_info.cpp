@@ -78,6 +78,22 @@ string MakeRemoteURL(string const & name, uint64_t version)
 }
 
 char const kETag[] = "etag";
+
+// Tells the server that the client can apply a delta to the values received with the ETag.
+char const kAcceptDeltaHeader[] = "X-Traffic-Accept-Delta";
+
+// Number of bits of a speed group in the traffic values.
+uint8_t const kSpeedGroupBits = 3;
+
+template <typename Source>
+uint8_t ReadValuesVersion(Source & src)
+{
+  auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+  CHECK(version == TrafficInfo::kLatestValuesVersion ||
+        version == TrafficInfo::kLatestValuesDeltaVersion,
+        ("Unsupported version of traffic values."));
+  return version;
+}
 }  // namespace
 
 // TrafficInfo::RoadSegmentId -----------------------------------------------------------------
@@ -88,11 +104,33 @@ TrafficInfo::RoadSegmentId::RoadSegmentId(uint32_t fid, uint16_t idx, uint8_t di
 {
 }
 
+// TrafficInfo::PackedValues ------------------------------------------------------------------
+TrafficInfo::PackedValues::PackedValues(vector<SpeedGroup> const & values)
+  : m_data((values.size() + 1) / 2), m_size(values.size())
+{
+  for (size_t i = 0; i < values.size(); ++i)
+    m_data[i / 2] |= static_cast<uint8_t>(values[i]) << (4 * (i % 2));
+}
+
+SpeedGroup TrafficInfo::PackedValues::Get(size_t i) const
+{
+  ASSERT_LESS(i, m_size, ());
+  return static_cast<SpeedGroup>((m_data[i / 2] >> (4 * (i % 2))) & 0xF);
+}
+
+void TrafficInfo::PackedValues::Unpack(vector<SpeedGroup> & values) const
+{
+  values.resize(m_size);
+  for (size_t i = 0; i < m_size; ++i)
+    values[i] = Get(i);
+}
+
 // TrafficInfo --------------------------------------------------------------------------------
 
 // static
 uint8_t const TrafficInfo::kLatestKeysVersion = 0;
 uint8_t const TrafficInfo::kLatestValuesVersion = 0;
+uint8_t const TrafficInfo::kLatestValuesDeltaVersion = 1;
 
 TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion)
   : m_mwmId(mwmId)
@@ -155,10 +193,10 @@ void TrafficInfo::SetTrafficKeysForTesting(vector<RoadSegmentId> const & keys)
   m_availability = Availability::IsAvailable;
 }
 
-bool TrafficInfo::ReceiveTrafficData(string & etag)
+bool TrafficInfo::ReceiveTrafficData(string & etag, PackedValues const & lastValues)
 {
   vector<SpeedGroup> values;
-  switch (ReceiveTrafficValues(etag, values))
+  switch (ReceiveTrafficValues(etag, lastValues, values))
   {
   case ServerDataStatus::New:
     return UpdateTrafficData(values);
@@ -298,7 +336,14 @@ void TrafficInfo::SerializeTrafficKeys(vector<RoadSegmentId> const & keys, vecto
 void TrafficInfo::DeserializeTrafficKeys(vector<uint8_t> const & data,
                                          vector<TrafficInfo::RoadSegmentId> & result)
 {
-  MemReaderWithExceptions memReader(data.data(), data.size());
+  DeserializeTrafficKeys(data.data(), data.size(), result);
+}
+
+// static
+void TrafficInfo::DeserializeTrafficKeys(uint8_t const * data, size_t size,
+                                         vector<TrafficInfo::RoadSegmentId> & result)
+{
+  MemReaderWithExceptions memReader(data, size);
   ReaderSource<decltype(memReader)> src(memReader);
   auto const version = ReadPrimitiveFromSource<uint8_t>(src);
   CHECK_EQUAL(version, kLatestKeysVersion, ("Unsupported version of traffic values."));
@@ -358,7 +403,7 @@ void TrafficInfo::SerializeTrafficValues(vector<SpeedGroup> const & values,
     {
       uint8_t const u = static_cast<uint8_t>(v);
       CHECK_LESS(u, numSpeedGroups, ());
-      bitWriter.Write(u, 3);
+      bitWriter.Write(u, kSpeedGroupBits);
     }
   }
 
@@ -368,30 +413,101 @@ void TrafficInfo::SerializeTrafficValues(vector<SpeedGroup> const & values,
   deflate(buf.data(), buf.size(), back_inserter(result));
 }
 
+// static
+void TrafficInfo::SerializeTrafficValuesDelta(vector<SpeedGroup> const & oldValues,
+                                              vector<SpeedGroup> const & newValues,
+                                              vector<uint8_t> & result)
+{
+  CHECK_EQUAL(oldValues.size(), newValues.size(), ());
+
+  vector<uint32_t> changedIndices;
+  for (size_t i = 0; i < newValues.size(); ++i)
+  {
+    if (oldValues[i] != newValues[i])
+      changedIndices.push_back(static_cast<uint32_t>(i));
+  }
+
+  vector<uint8_t> buf;
+  MemWriter<vector<uint8_t>> memWriter(buf);
+  WriteToSink(memWriter, kLatestValuesDeltaVersion);
+  WriteVarUint(memWriter, newValues.size());
+  WriteVarUint(memWriter, changedIndices.size());
+  {
+    BitWriter<decltype(memWriter)> bitWriter(memWriter);
+
+    uint32_t prevIndex = 0;
+    for (auto const index : changedIndices)
+    {
+      bool ok = coding::GammaCoder::Encode(bitWriter, static_cast<uint64_t>(index - prevIndex) + 1);
+      ASSERT(ok, ());
+      UNUSED_VALUE(ok);
+      prevIndex = index;
+    }
+
+    for (auto const index : changedIndices)
+      bitWriter.Write(static_cast<uint8_t>(newValues[index]), kSpeedGroupBits);
+  }
+
+  using Deflate = coding::ZLib::Deflate;
+  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+
+  deflate(buf.data(), buf.size(), back_inserter(result));
+}
+
 // static
 void TrafficInfo::DeserializeTrafficValues(vector<uint8_t> const & data,
                                            vector<SpeedGroup> & result)
+{
+  DeserializeTrafficValues(data.data(), data.size(), result);
+}
+
+// static
+void TrafficInfo::DeserializeTrafficValues(uint8_t const * data, size_t size,
+                                           vector<SpeedGroup> & result)
 {
   using Inflate = coding::ZLib::Inflate;
 
   vector<uint8_t> decompressedData;
 
   Inflate inflate(Inflate::Format::ZLib);
-  inflate(data.data(), data.size(), back_inserter(decompressedData));
+  inflate(data, size, back_inserter(decompressedData));
 
   MemReaderWithExceptions memReader(decompressedData.data(), decompressedData.size());
   ReaderSource<decltype(memReader)> src(memReader);
 
-  auto const version = ReadPrimitiveFromSource<uint8_t>(src);
-  CHECK_EQUAL(version, kLatestValuesVersion, ("Unsupported version of traffic keys."));
-
+  auto const version = ReadValuesVersion(src);
   auto const n = ReadVarUint<uint32_t>(src);
+
+  if (version == kLatestValuesDeltaVersion)
+  {
+    if (result.size() != n)
+      MYTHROW(Reader::SizeException, ("Traffic values delta for", n, "values, base:", result.size()));
+
+    auto const changedCount = ReadVarUint<uint32_t>(src);
+    vector<uint32_t> changedIndices(changedCount);
+    BitReader<decltype(src)> bitReader(src);
+    uint32_t prevIndex = 0;
+    for (auto & index : changedIndices)
+    {
+      prevIndex += static_cast<uint32_t>(coding::GammaCoder::Decode(bitReader) - 1);
+      if (prevIndex >= n)
+        MYTHROW(Reader::SizeException, ("Traffic value index", prevIndex, "is out of", n));
+      index = prevIndex;
+    }
+
+    for (auto const index : changedIndices)
+      result[index] = static_cast<SpeedGroup>(bitReader.Read(kSpeedGroupBits));
+
+    ASSERT_EQUAL(src.Size(), 0, ());
+    return;
+  }
+
   result.resize(n);
   BitReader<decltype(src)> bitReader(src);
   for (size_t i = 0; i < static_cast<size_t>(n); ++i)
   {
     // SpeedGroup's values fit into 3 bits.
-    result[i] = static_cast<SpeedGroup>(bitReader.Read(3));
+    result[i] = static_cast<SpeedGroup>(bitReader.Read(kSpeedGroupBits));
   }
 
   ASSERT_EQUAL(src.Size(), 0, ());
@@ -436,7 +552,9 @@ bool TrafficInfo::ReceiveTrafficKeys()
   return true;
 }
 
-TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, vector<SpeedGroup> & values)
+TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag,
+                                                                PackedValues const & lastValues,
+                                                                vector<SpeedGroup> & values)
 {
   if (!m_mwmId.IsAlive())
     return ServerDataStatus::Error;
@@ -456,6 +574,15 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
   request.SetRawHeader("User-Agent", GetPlatform().GetAppUserAgent());
   request.SetRawHeader("If-None-Match", etag);
 
+  // A delta can be applied only to the values of the same keys.
+  bool const canApplyDelta = !etag.empty() && !lastValues.IsEmpty() &&
+                             lastValues.Size() == m_keys.size();
+  if (canApplyDelta)
+  {
+    request.SetRawHeader(kAcceptDeltaHeader, "1");
+    lastValues.Unpack(values);
+  }
+
   if (!request.RunHttpRequest() || request.ErrorCode() != 200)
     return ProcessFailure(request, version);
   try
@@ -466,6 +593,8 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
   }
   catch (Reader::Exception const & e)
   {
+    // Request the full values next time.
+    etag.clear();
     m_availability = Availability::NoData;
     LOG(LWARNING, ("Could not read traffic values received from server. MWM:",
                    info->GetCountryName(), "Version:", info->GetVersion()));
@@ -490,6 +619,7 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
 bool TrafficInfo::UpdateTrafficData(vector<SpeedGroup> const & values)
 {
   m_coloring.clear();
+  m_values = PackedValues();
 
   if (m_keys.size() != values.size())
   {
@@ -507,8 +637,9 @@ bool TrafficInfo::UpdateTrafficData(vector<SpeedGroup> const & values)
   for (size_t i = 0; i < m_keys.size(); ++i)
   {
     if (values[i] != SpeedGroup::Unknown)
-      m_coloring.emplace(m_keys[i], values[i]);
+      m_coloring.emplace_hint(m_coloring.end(), m_keys[i], values[i]);
   }
+  m_values = PackedValues(values);
 
   return true;
 }
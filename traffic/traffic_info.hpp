@@ -24,6 +24,7 @@ class TrafficInfo
 public:
   static uint8_t const kLatestKeysVersion;
   static uint8_t const kLatestValuesVersion;
+  static uint8_t const kLatestValuesDeltaVersion;
 
   enum class Availability
   {
@@ -76,6 +77,23 @@ public:
   // todo(@m) unordered_map?
   using Coloring = map<RoadSegmentId, SpeedGroup>;
 
+  // Speed groups of all the keys of an mwm, each one is packed in 4 bits.
+  class PackedValues
+  {
+  public:
+    PackedValues() : m_size(0) {}
+    explicit PackedValues(vector<SpeedGroup> const & values);
+
+    bool IsEmpty() const { return m_size == 0; }
+    size_t Size() const { return m_size; }
+    SpeedGroup Get(size_t i) const;
+    void Unpack(vector<SpeedGroup> & values) const;
+
+  private:
+    vector<uint8_t> m_data;
+    size_t m_size;
+  };
+
   TrafficInfo() = default;
 
   TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion);
@@ -88,8 +106,10 @@ public:
   // The ETag or entity tag is part of HTTP, the protocol for the World Wide Web.
   // It is one of several mechanisms that HTTP provides for web cache validation,
   // which allows a client to make conditional requests.
+  // If |lastValues| are the values received with |etag|, the server is allowed to send
+  // only the changed values.
   // *NOTE* This method must not be called on the UI thread.
-  bool ReceiveTrafficData(string & etag);
+  bool ReceiveTrafficData(string & etag, PackedValues const & lastValues = {});
 
   // Returns the latest known speed group by a feature segment's id
   // or SpeedGroup::Unknown if there is no information about the segment.
@@ -97,6 +117,8 @@ public:
 
   MwmSet::MwmId const & GetMwmId() const { return m_mwmId; }
   Coloring const & GetColoring() const { return m_coloring; }
+  // Values of all the keys from the latest data or empty values if there is no data.
+  PackedValues const & GetValues() const { return m_values; }
   Availability GetAvailability() const { return m_availability; }
 
   // Extracts RoadSegmentIds from mwm and stores them in a sorted order.
@@ -115,10 +137,22 @@ public:
   static void SerializeTrafficKeys(vector<RoadSegmentId> const & keys, vector<uint8_t> & result);
 
   static void DeserializeTrafficKeys(vector<uint8_t> const & data, vector<RoadSegmentId> & result);
+  static void DeserializeTrafficKeys(uint8_t const * data, size_t size,
+                                     vector<RoadSegmentId> & result);
 
   static void SerializeTrafficValues(vector<SpeedGroup> const & values, vector<uint8_t> & result);
 
+  // Serializes the values which differ in |oldValues| and |newValues|.
+  static void SerializeTrafficValuesDelta(vector<SpeedGroup> const & oldValues,
+                                          vector<SpeedGroup> const & newValues,
+                                          vector<uint8_t> & result);
+
+  // Deserializes the values serialized by SerializeTrafficValues() to |result| or applies
+  // the delta serialized by SerializeTrafficValuesDelta() to |result|.
+  // Throws Reader::Exception if the delta does not match the size of |result|.
   static void DeserializeTrafficValues(vector<uint8_t> const & data, vector<SpeedGroup> & result);
+  static void DeserializeTrafficValues(uint8_t const * data, size_t size,
+                                       vector<SpeedGroup> & result);
 
 private:
   enum class ServerDataStatus
@@ -138,7 +172,8 @@ private:
   // Tries to read the values of the Coloring map from server into |values|.
   // Returns result of communicating with server as ServerDataStatus.
   // Otherwise, returns false and does not change m_coloring.
-  ServerDataStatus ReceiveTrafficValues(string & etag, vector<SpeedGroup> & values);
+  ServerDataStatus ReceiveTrafficValues(string & etag, PackedValues const & lastValues,
+                                        vector<SpeedGroup> & values);
 
   // Updates the coloring and changes the availability status if needed.
   bool UpdateTrafficData(vector<SpeedGroup> const & values);
@@ -148,6 +183,9 @@ private:
   // The mapping from feature segments to speed groups (see speed_groups.hpp).
   Coloring m_coloring;
 
+  // All the values which were used to build m_coloring.
+  PackedValues m_values;
+
   // The keys of the coloring map. The values are downloaded periodically
   // and combined with the keys to form m_coloring.
   // *NOTE* The values must be received in the exact same order that the
@@ -111,6 +111,55 @@ UNIT_TEST(TrafficInfo_Serialization)
   }
 }
 
+UNIT_TEST(TrafficInfo_SerializationDelta)
+{
+  vector<SpeedGroup> const oldValues = {
+      SpeedGroup::G0, SpeedGroup::G1, SpeedGroup::G2, SpeedGroup::G3,
+      SpeedGroup::G4, SpeedGroup::G5, SpeedGroup::TempBlock, SpeedGroup::Unknown,
+  };
+  vector<SpeedGroup> newValues = oldValues;
+  newValues[0] = SpeedGroup::G5;
+  newValues[6] = SpeedGroup::Unknown;
+  newValues[7] = SpeedGroup::G1;
+
+  {
+    vector<uint8_t> buf;
+    TrafficInfo::SerializeTrafficValuesDelta(oldValues, newValues, buf);
+
+    vector<SpeedGroup> values = oldValues;
+    TrafficInfo::DeserializeTrafficValues(buf, values);
+    TEST_EQUAL(values, newValues, ());
+
+    // A delta can't be applied to values of another size.
+    vector<SpeedGroup> shortValues(oldValues.begin(), oldValues.begin() + 3);
+    TEST_THROW(TrafficInfo::DeserializeTrafficValues(buf, shortValues), Reader::Exception, ());
+  }
+
+  {
+    // Full values replace the previous ones.
+    vector<uint8_t> buf;
+    TrafficInfo::SerializeTrafficValues(newValues, buf);
+
+    vector<SpeedGroup> values = oldValues;
+    values.pop_back();
+    TrafficInfo::DeserializeTrafficValues(buf, values);
+    TEST_EQUAL(values, newValues, ());
+  }
+
+  {
+    TrafficInfo::PackedValues const packed(newValues);
+    TEST(!packed.IsEmpty(), ());
+    TEST_EQUAL(packed.Size(), newValues.size(), ());
+    for (size_t i = 0; i < newValues.size(); ++i)
+      TEST_EQUAL(packed.Get(i), newValues[i], ());
+
+    vector<SpeedGroup> unpacked;
+    packed.Unpack(unpacked);
+    TEST_EQUAL(unpacked, newValues, ());
+    TEST(TrafficInfo::PackedValues().IsEmpty(), ());
+  }
+}
+
 UNIT_TEST(TrafficInfo_UpdateTrafficData)
 {
   vector<TrafficInfo::RoadSegmentId> const keys = {
@@ -0,0 +1,125 @@
+#include "transit/transit_display_section.hpp"
+
+#include "coding/pointd_to_pointu.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+using namespace std;
+
+namespace
+{
+uint64_t constexpr kHeaderSize = 2 * sizeof(uint16_t) + sizeof(uint32_t);
+uint64_t constexpr kRecordSize = 4 * sizeof(uint32_t);
+}  // namespace
+
+namespace routing
+{
+namespace transit
+{
+uint16_t constexpr DisplaySection::kVersion;
+
+// static
+void DisplaySection::Serialize(vector<DisplayFeature> features, Writer & writer)
+{
+  sort(features.begin(), features.end(), [](DisplayFeature const & lhs, DisplayFeature const & rhs) {
+    return lhs.m_featureId < rhs.m_featureId;
+  });
+  CHECK(adjacent_find(features.begin(), features.end(),
+                      [](DisplayFeature const & lhs, DisplayFeature const & rhs) {
+                        return lhs.m_featureId == rhs.m_featureId;
+                      }) == features.end(),
+        ("Features of the transit display section must be unique."));
+  CHECK_LESS_OR_EQUAL(features.size(), numeric_limits<uint32_t>::max(), ());
+
+  WriteToSink(writer, kVersion);
+  WriteToSink(writer, static_cast<uint16_t>(0) /* reserved */);
+  WriteToSink(writer, static_cast<uint32_t>(features.size()));
+
+  string names;
+  MemWriter<string> namesWriter(names);
+  for (auto const & feature : features)
+  {
+    auto const point = PointDToPointU(feature.m_point, POINT_COORD_BITS);
+    WriteToSink(writer, feature.m_featureId);
+    WriteToSink(writer, point.x);
+    WriteToSink(writer, point.y);
+    CHECK_LESS_OR_EQUAL(names.size(), numeric_limits<uint32_t>::max(), ());
+    WriteToSink(writer, static_cast<uint32_t>(names.size()));
+    // Empty names are not written, the next record has the same offset.
+    if (!feature.m_names.IsEmpty())
+      feature.m_names.Write(namesWriter);
+  }
+  writer.Write(names.data(), names.size());
+}
+
+DisplaySection::DisplaySection(Reader & reader)
+{
+  m_data.resize(static_cast<size_t>(reader.Size()));
+  reader.Read(0 /* pos */, m_data.data(), m_data.size());
+
+  MemReader memReader(m_data.data(), m_data.size());
+  CHECK_GREATER_OR_EQUAL(m_data.size(), kHeaderSize, ());
+  auto const version = ReadPrimitiveFromPos<uint16_t>(memReader, 0 /* pos */);
+  CHECK_EQUAL(version, kVersion, ());
+  m_count = ReadPrimitiveFromPos<uint32_t>(memReader, 2 * sizeof(uint16_t));
+  CHECK_LESS_OR_EQUAL(kHeaderSize + m_count * kRecordSize, m_data.size(), ());
+}
+
+bool DisplaySection::Find(uint32_t featureId, DisplayFeature & feature) const
+{
+  size_t begin = 0;
+  size_t end = m_count;
+  while (begin < end)
+  {
+    size_t const middle = begin + (end - begin) / 2;
+    if (GetFeatureId(middle) < featureId)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+  if (begin == m_count || GetFeatureId(begin) != featureId)
+    return false;
+
+  MemReader memReader(m_data.data(), m_data.size());
+  uint64_t const pos = kHeaderSize + begin * kRecordSize;
+  m2::PointU const point(ReadPrimitiveFromPos<uint32_t>(memReader, pos + sizeof(uint32_t)),
+                         ReadPrimitiveFromPos<uint32_t>(memReader, pos + 2 * sizeof(uint32_t)));
+
+  uint64_t const namesBegin = kHeaderSize + m_count * kRecordSize;
+  uint64_t const namesPos = namesBegin + GetNamesOffset(begin);
+  uint64_t const namesEnd =
+      begin + 1 == m_count ? m_data.size() : namesBegin + GetNamesOffset(begin + 1);
+  CHECK_LESS_OR_EQUAL(namesPos, namesEnd, ());
+  CHECK_LESS_OR_EQUAL(namesEnd, m_data.size(), ());
+
+  feature.m_featureId = featureId;
+  feature.m_point = PointUToPointD(point, POINT_COORD_BITS);
+  feature.m_names.Clear();
+  if (namesPos != namesEnd)
+  {
+    ReaderSource<MemReader> src(memReader);
+    src.Skip(namesPos);
+    feature.m_names.Read(src);
+  }
+  return true;
+}
+
+uint32_t DisplaySection::GetFeatureId(size_t i) const
+{
+  MemReader memReader(m_data.data(), m_data.size());
+  return ReadPrimitiveFromPos<uint32_t>(memReader, kHeaderSize + i * kRecordSize);
+}
+
+uint32_t DisplaySection::GetNamesOffset(size_t i) const
+{
+  MemReader memReader(m_data.data(), m_data.size());
+  return ReadPrimitiveFromPos<uint32_t>(memReader,
+                                        kHeaderSize + i * kRecordSize + 3 * sizeof(uint32_t));
+}
+}  // namespace transit
+}  // namespace routing
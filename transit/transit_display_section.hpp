@@ -0,0 +1,60 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+
+#include "coding/multilang_utf8_string.hpp"
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace routing
+{
+namespace transit
+{
+// Data of a feature of a transit stop which is needed to show the transit scheme.
+struct DisplayFeature
+{
+  DisplayFeature() = default;
+  DisplayFeature(uint32_t featureId, m2::PointD const & point, StringUtf8Multilang const & names)
+    : m_featureId(featureId), m_point(point), m_names(names)
+  {
+  }
+
+  uint32_t m_featureId = 0;
+  m2::PointD m_point;
+  StringUtf8Multilang m_names;
+};
+
+// Section with precomputed DisplayFeatures of the transit section, so the transit scheme is
+// shown without reading the features of stops. The section is flat:
+// header (version and count of records), records sorted by feature ids, names of the records.
+// A record is a feature id, coordinates of the point (POINT_COORD_BITS each) and the offset
+// of the names of the feature, 4 bytes each. Empty names are not written.
+// Records are searched in place.
+class DisplaySection
+{
+public:
+  static uint16_t constexpr kVersion = 0;
+
+  static void Serialize(std::vector<DisplayFeature> features, Writer & writer);
+
+  // The section is read at once.
+  explicit DisplaySection(Reader & reader);
+
+  size_t GetCount() const { return m_count; }
+
+  // Returns false if there is no feature |featureId| in the section.
+  bool Find(uint32_t featureId, DisplayFeature & feature) const;
+
+private:
+  uint32_t GetFeatureId(size_t i) const;
+  uint32_t GetNamesOffset(size_t i) const;
+
+  std::vector<uint8_t> m_data;
+  size_t m_count = 0;
+};
+}  // namespace transit
+}  // namespace routing
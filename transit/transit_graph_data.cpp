@@ -308,6 +308,14 @@ void GraphData::DeserializeForCrossMwm(Reader & reader)
   });
 }
 
+void GraphData::DeserializeGates(Reader & reader)
+{
+  DeserializeWith(reader, [this](NonOwningReaderSource & src) {
+    src.Skip(m_header.m_gatesOffset - src.Pos());
+    ReadGates(src);
+  });
+}
+
 void GraphData::AppendTo(GraphData const & rhs)
 {
   ::Append(rhs.m_stops, m_stops);
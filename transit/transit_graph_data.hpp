@@ -132,6 +132,9 @@ public:
   void DeserializeForRouting(Reader & reader);
   void DeserializeForRendering(Reader & reader);
   void DeserializeForCrossMwm(Reader & reader);
+  /// \brief Reads only gates. It's much cheaper than DeserializeForRouting() and is enough
+  /// to find out which pedestrian features are connected to transit.
+  void DeserializeGates(Reader & reader);
   void AppendTo(GraphData const & rhs);
   void Clear();
   void CheckValidSortedUnique() const;
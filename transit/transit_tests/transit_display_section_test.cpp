@@ -0,0 +1,82 @@
+#include "testing/testing.hpp"
+
+#include "transit/transit_display_section.hpp"
+
+#include "coding/multilang_utf8_string.hpp"
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace routing;
+using namespace routing::transit;
+using namespace std;
+
+namespace
+{
+StringUtf8Multilang MakeNames(string const & defaultName, string const & enName)
+{
+  StringUtf8Multilang names;
+  names.AddString(StringUtf8Multilang::kDefaultCode, defaultName);
+  if (!enName.empty())
+    names.AddString(StringUtf8Multilang::GetLangIndex("en"), enName);
+  return names;
+}
+
+bool AlmostEqual(m2::PointD const & lhs, m2::PointD const & rhs)
+{
+  double constexpr kEps = 1e-5;
+  return base::AlmostEqualAbs(lhs.x, rhs.x, kEps) && base::AlmostEqualAbs(lhs.y, rhs.y, kEps);
+}
+}  // namespace
+
+UNIT_TEST(Transit_DisplaySection_Smoke)
+{
+  vector<DisplayFeature> const features = {
+      {30, m2::PointD(10.5, -20.25), MakeNames("Площадь Революции", "Ploshchad Revolyutsii")},
+      {7, m2::PointD(-100.0, 50.0), MakeNames("Арбатская", "")},
+      {12, m2::PointD(0.0, 0.0), StringUtf8Multilang()}};
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    DisplaySection::Serialize(features, writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  DisplaySection section(reader);
+  TEST_EQUAL(section.GetCount(), features.size(), ());
+
+  for (auto const & expected : features)
+  {
+    DisplayFeature feature;
+    TEST(section.Find(expected.m_featureId, feature), (expected.m_featureId));
+    TEST_EQUAL(feature.m_featureId, expected.m_featureId, ());
+    TEST(AlmostEqual(feature.m_point, expected.m_point), (feature.m_point, expected.m_point));
+    TEST_EQUAL(feature.m_names, expected.m_names, ());
+  }
+
+  DisplayFeature feature;
+  TEST(!section.Find(0, feature), ());
+  TEST(!section.Find(8, feature), ());
+  TEST(!section.Find(31, feature), ());
+}
+
+UNIT_TEST(Transit_DisplaySection_Empty)
+{
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    DisplaySection::Serialize({}, writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  DisplaySection section(reader);
+  TEST_EQUAL(section.GetCount(), 0, ());
+  DisplayFeature feature;
+  TEST(!section.Find(0, feature), ());
+}
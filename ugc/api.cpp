@@ -87,6 +87,9 @@ void Api::SendingCompletedImpl()
 
 void Api::SaveUGCOnDiskImpl()
 {
+  // It's done on the UGC thread, so the UGC file is compacted without blocking any callers.
+  // The index is saved right after the compaction because the offsets are changed.
+  m_storage.Defragmentation();
   m_storage.SaveIndex();
 }
 }  // namespace ugc
@@ -6,7 +6,6 @@
 #include "ugc/types.hpp"
 
 #include "coding/bwt_coder.hpp"
-#include "coding/dd_vector.hpp"
 #include "coding/read_write_utils.hpp"
 #include "coding/reader.hpp"
 #include "coding/text_storage.hpp"
@@ -33,6 +32,15 @@ enum class Version : uint64_t
   Latest = V0
 };
 
+// Parts of UGC which are decoded.
+enum class Fields
+{
+  All,
+  // Everything except texts of reviews, which are left empty. Texts are the most expensive
+  // part, as they are extracted from compressed blocks.
+  WithoutTexts
+};
+
 class UGCSeriaizer
 {
 public:
@@ -157,15 +165,32 @@ private:
 };
 
 // Deserializer for UGC. May be used for random-access, but it is more
-// efficient to keep it alive between accesses. The instances of
-// |reader| for Deserialize() may differ between calls, but all
-// instances must be set to the beginning of the UGC section
+// efficient to keep it alive between accesses, as it caches the index of
+// the section. The instances of |reader| for Deserialize() may differ
+// between calls, but all instances must be set to the beginning of the
+// UGC section
 class UGCDeserializer
 {
 public:
   template <typename R>
-  bool Deserialize(R & reader, FeatureIndex index, UGC & ugc)
+  bool Deserialize(R & reader, FeatureIndex index, UGC & ugc, Fields fields = Fields::All)
   {
+    std::vector<UGC> ugcs;
+    auto const found = Deserialize(reader, std::vector<FeatureIndex>{index}, fields, ugcs);
+    ugc = std::move(ugcs.front());
+    return found != 0;
+  }
+
+  // Deserializes UGCs of sorted |indexes| to |ugcs|, UGCs of features which have no UGC are
+  // empty. The indexes are merged with the index of the section, and the blobs are read
+  // in the order of the section. Returns the number of found UGCs.
+  template <typename R>
+  size_t Deserialize(R & reader, std::vector<FeatureIndex> const & indexes, Fields fields,
+                     std::vector<UGC> & ugcs)
+  {
+    ASSERT(std::is_sorted(indexes.begin(), indexes.end()), ());
+    ugcs.assign(indexes.size(), UGC());
+
     NonOwningReaderSource source(reader);
     auto const v = ReadPrimitiveFromSource<Version>(source);
 
@@ -173,44 +198,42 @@ public:
 
     switch (v)
     {
-    case Version::V0: return DeserializeV0(*subReader, index, ugc);
+    case Version::V0: return DeserializeV0(*subReader, indexes, fields, ugcs);
     default: ASSERT(false, ("Cannot deserialize ugc for version", v));
     }
 
-    return false;
+    return 0;
   }
 
   template <typename R>
-  bool DeserializeV0(R & reader, FeatureIndex index, UGC & ugc)
+  size_t DeserializeV0(R & reader, std::vector<FeatureIndex> const & indexes, Fields fields,
+                       std::vector<UGC> & ugcs)
   {
     InitializeIfNeeded(reader);
 
-    UGCOffset offset = 0;
-    {
-      ReaderPtr<Reader> idsSubReader(CreateFeatureIndexesSubReader(reader));
-      DDVector<FeatureIndex, ReaderPtr<Reader>> ids(idsSubReader);
-      auto const it = std::lower_bound(ids.begin(), ids.end(), index);
-      if (it == ids.end() || *it != index)
-        return false;
-
-      auto const d = static_cast<uint32_t>(distance(ids.begin(), it));
-
-      ReaderPtr<Reader> ofsSubReader(CreateUGCOffsetsSubReader(reader));
-      DDVector<UGCOffset, ReaderPtr<Reader>> ofs(ofsSubReader);
-      offset = ofs[d];
-    }
+    auto ugcSubReader = CreateUGCSubReader(reader);
+    auto textsSubReader = CreateTextsSubReader(reader);
 
+    size_t found = 0;
+    auto it = m_ids.cbegin();
+    for (size_t i = 0; i < indexes.size(); ++i)
     {
-      auto ugcSubReader = CreateUGCSubReader(reader);
+      it = std::lower_bound(it, m_ids.cend(), indexes[i]);
+      if (it == m_ids.cend())
+        break;
+      if (*it != indexes[i])
+        continue;
+
       NonOwningReaderSource source(*ugcSubReader);
-      source.Skip(offset);
+      source.Skip(m_offsets[static_cast<size_t>(std::distance(m_ids.cbegin(), it))]);
 
-      auto textsSubReader = CreateTextsSubReader(reader);
-      DeserializerVisitorV0<NonOwningReaderSource> des(source, m_keys, *textsSubReader, m_texts);
-      des(ugc);
+      DeserializerVisitorV0<NonOwningReaderSource> des(source, m_keys, *textsSubReader, m_texts,
+                                                       fields == Fields::All);
+      des(ugcs[i]);
+      ++found;
     }
 
-    return true;
+    return found;
   }
 
   std::vector<TranslationKey> const & GetTranslationKeys() const { return m_keys; }
@@ -239,6 +262,22 @@ private:
     }
 
     m_initialized = true;
+
+    {
+      auto const n = static_cast<size_t>(GetNumUGCs());
+      m_ids.resize(n);
+      m_offsets.resize(n);
+
+      auto idsSubReader = CreateFeatureIndexesSubReader(reader);
+      NonOwningReaderSource idsSource(*idsSubReader);
+      for (auto & id : m_ids)
+        id = ReadPrimitiveFromSource<FeatureIndex>(idsSource);
+
+      auto ofsSubReader = CreateUGCOffsetsSubReader(reader);
+      NonOwningReaderSource ofsSource(*ofsSubReader);
+      for (auto & offset : m_offsets)
+        offset = ReadPrimitiveFromSource<UGCOffset>(ofsSource);
+    }
   }
 
   template <typename Source>
@@ -317,6 +356,10 @@ private:
   std::vector<TranslationKey> m_keys;
   coding::BlockedTextStorageReader m_texts;
 
+  // Index of the section: sorted feature indexes and offsets of their UGC blobs.
+  std::vector<FeatureIndex> m_ids;
+  std::vector<UGCOffset> m_offsets;
+
   bool m_initialized = false;
 };
 
@@ -120,9 +120,15 @@ class DeserializerVisitorV0
 public:
   // |source| must be set to the beginning of the UGC blob.
   // |textsReader| must be set to the blocked text storage section.
+  // Texts are left empty if |extractTexts| is false, so the text storage is not decoded.
   DeserializerVisitorV0(Source & source, std::vector<TranslationKey> const & keys,
-                        Reader & textsReader, coding::BlockedTextStorageReader & texts)
-    : m_source(source), m_keys(keys), m_textsReader(textsReader), m_texts(texts)
+                        Reader & textsReader, coding::BlockedTextStorageReader & texts,
+                        bool extractTexts = true)
+    : m_source(source)
+    , m_keys(keys)
+    , m_textsReader(textsReader)
+    , m_texts(texts)
+    , m_extractTexts(extractTexts)
   {
     m_currText = DesVarUint<uint64_t>();
   }
@@ -162,7 +168,8 @@ public:
   void operator()(Text & text, char const * /* name */ = nullptr)
   {
     (*this)(text.m_lang, "lang");
-    text.m_text = m_texts.ExtractString(m_textsReader, m_currText);
+    if (m_extractTexts)
+      text.m_text = m_texts.ExtractString(m_textsReader, m_currText);
     ++m_currText;
   }
 
@@ -210,6 +217,7 @@ private:
 
   Reader & m_textsReader;
   coding::BlockedTextStorageReader & m_texts;
+  bool const m_extractTexts;
 
   uint64_t m_currText = 0;
 };
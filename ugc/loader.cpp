@@ -3,46 +3,84 @@
 #include "indexer/data_source.hpp"
 #include "indexer/feature.hpp"
 
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
 #include "defines.hpp"
 
 namespace ugc
 {
 Loader::Loader(DataSource const & dataSource) : m_dataSource(dataSource) {}
 
-UGC Loader::GetUGC(FeatureID const & featureId)
+UGC Loader::GetUGC(FeatureID const & featureId, binary::Fields fields)
+{
+  std::vector<UGC> ugcs;
+  ReadUGCs(featureId.m_mwmId, {featureId.m_index}, fields, ugcs);
+  return ugcs.empty() ? UGC() : std::move(ugcs.front());
+}
+
+std::vector<UGC> Loader::GetUGC(std::vector<FeatureID> const & featureIds, binary::Fields fields)
 {
-  auto const handle = m_dataSource.GetMwmHandleById(featureId.m_mwmId);
+  // Positions of features sorted by mwms and indexes.
+  std::vector<size_t> order(featureIds.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&featureIds](size_t lhs, size_t rhs) { return featureIds[lhs] < featureIds[rhs]; });
+
+  std::vector<UGC> result(featureIds.size());
+  std::vector<binary::FeatureIndex> indexes;
+  std::vector<UGC> ugcs;
+  for (size_t begin = 0; begin < order.size();)
+  {
+    auto const & mwmId = featureIds[order[begin]].m_mwmId;
+    size_t end = begin;
+    indexes.clear();
+    for (; end < order.size() && featureIds[order[end]].m_mwmId == mwmId; ++end)
+      indexes.push_back(featureIds[order[end]].m_index);
+
+    ReadUGCs(mwmId, indexes, fields, ugcs);
+    for (size_t i = 0; i < ugcs.size(); ++i)
+      result[order[begin + i]] = std::move(ugcs[i]);
+
+    begin = end;
+  }
+
+  return result;
+}
+
+Loader::EntryPtr Loader::GetEntry(MwmSet::MwmId const & id)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto & entry = m_deserializers[id];
+  if (!entry)
+    entry = std::make_shared<Entry>();
+  return entry;
+}
+
+void Loader::ReadUGCs(MwmSet::MwmId const & id,
+                      std::vector<binary::FeatureIndex> const & indexes, binary::Fields fields,
+                      std::vector<UGC> & ugcs)
+{
+  ugcs.clear();
+
+  auto const handle = m_dataSource.GetMwmHandleById(id);
 
   if (!handle.IsAlive())
-    return {};
+    return;
 
   auto const & value = *handle.GetValue<MwmValue>();
 
   if (!value.m_cont.IsExist(UGC_FILE_TAG))
-    return {};
-
-  UGC ugc;
-  EntryPtr entry;
-  {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_deserializers.find(featureId.m_mwmId);
-
-    if (it == m_deserializers.end())
-    {
-      auto const result = m_deserializers.emplace(featureId.m_mwmId, make_shared<Entry>());
-      it = result.first;
-    }
-    entry = it->second;
-  }
+    return;
 
+  auto const entry = GetEntry(id);
   ASSERT(entry, ());
 
   {
     std::lock_guard<std::mutex> lock(entry->m_mutex);
     auto readerPtr = value.m_cont.GetReader(UGC_FILE_TAG);
-    entry->m_deserializer.Deserialize(*readerPtr.GetPtr(), featureId.m_index, ugc);
+    entry->m_deserializer.Deserialize(*readerPtr.GetPtr(), indexes, fields, ugcs);
   }
-
-  return ugc;
 }
 }  // namespace ugc
@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 class DataSource;
 struct FeatureID;
@@ -19,7 +20,12 @@ class Loader
 {
 public:
   Loader(DataSource const & dataSource);
-  UGC GetUGC(FeatureID const & featureId);
+  UGC GetUGC(FeatureID const & featureId, binary::Fields fields = binary::Fields::All);
+
+  // Returns UGCs of |featureIds| in their order, UGCs of features without UGC are empty.
+  // Features are grouped by mwms, and the UGC section of each mwm is read once.
+  std::vector<UGC> GetUGC(std::vector<FeatureID> const & featureIds,
+                          binary::Fields fields = binary::Fields::All);
 
 private:
   struct Entry
@@ -30,6 +36,11 @@ private:
 
   using EntryPtr = std::shared_ptr<Entry>;
 
+  EntryPtr GetEntry(MwmSet::MwmId const & id);
+  // Deserializes UGCs of sorted |indexes| of the mwm |id| to |ugcs|.
+  void ReadUGCs(MwmSet::MwmId const & id, std::vector<binary::FeatureIndex> const & indexes,
+                binary::Fields fields, std::vector<UGC> & ugcs);
+
   DataSource const & m_dataSource;
   std::map<MwmSet::MwmId, EntryPtr> m_deserializers;
   std::mutex m_mutex;
@@ -6,6 +6,7 @@
 #include "editor/editable_data_source.hpp"
 
 #include "indexer/classificator.hpp"
+#include "indexer/fake_feature_ids.hpp"
 #include "indexer/feature_algo.hpp"
 #include "indexer/feature_decl.hpp"
 #include "indexer/ftraits.hpp"
@@ -155,6 +156,25 @@ UGCUpdate Storage::GetUGCUpdate(FeatureID const & id) const
   if (m_indexes.empty())
     return {};
 
+  if (!m_lookupIsValid)
+    BuildLookup();
+
+  // Ids of features created by the editor are not stable between sessions.
+  if (!feature::FakeFeatureIds::IsEditorCreatedFeature(id.m_index))
+  {
+    auto const it = m_featureToIndex.find({id.GetMwmName(), id.GetMwmVersion(), id.m_index});
+    if (it != m_featureToIndex.end())
+      return ReadUGCAtIndex(it->second);
+
+    // All the indexes are made for the same data version as |id| has, so there is no UGC
+    // for the feature and it's not necessary to read it.
+    if (m_dataVersions.empty() ||
+        (m_dataVersions.size() == 1 && *m_dataVersions.begin() == id.GetMwmVersion()))
+    {
+      return {};
+    }
+  }
+
   auto const feature = GetFeature(id);
   auto const mercator = feature::GetCenter(*feature);
   feature::TypesHolder th(*feature);
@@ -162,16 +182,17 @@ UGCUpdate Storage::GetUGCUpdate(FeatureID const & id) const
   auto const & c = classif();
   auto const type = c.GetIndexForType(th.GetBestType());
 
-  auto const index = find_if(
-      m_indexes.begin(), m_indexes.end(), [type, &mercator](UpdateIndex const & index) -> bool {
-        return type == index.m_type && mercator == index.m_mercator && !index.m_deleted;
-      });
-
-  if (index == m_indexes.end())
+  auto const pointIt = m_pointToIndex.find(PointKey(type, mercator.x, mercator.y));
+  if (pointIt == m_pointToIndex.end())
     return {};
 
-  auto const offset = index->m_offset;
-  auto const size = static_cast<size_t>(UGCSizeAtIndex(distance(m_indexes.begin(), index)));
+  return ReadUGCAtIndex(pointIt->second);
+}
+
+UGCUpdate Storage::ReadUGCAtIndex(size_t const indexPosition) const
+{
+  auto const offset = m_indexes[indexPosition].m_offset;
+  auto const size = static_cast<size_t>(UGCSizeAtIndex(indexPosition));
   vector<uint8_t> buf;
   buf.resize(size);
   auto const ugcFilePath = GetUGCFilePath();
@@ -196,11 +217,14 @@ UGCUpdate Storage::GetUGCUpdate(FeatureID const & id) const
 Storage::SettingResult Storage::SetUGCUpdate(FeatureID const & id, UGCUpdate const & ugc)
 {
   auto const feature = GetFeature(id);
+  m_lookupIsValid = false;
   return SetGenericUGCUpdate(ugc, *feature, m_indexes, m_numberOfDeleted, Version::V1);
 }
 
 void Storage::Load()
 {
+  m_lookupIsValid = false;
+
   string data;
   auto const indexFilePath = GetIndexFilePath();
   try
@@ -320,6 +344,8 @@ void Storage::Defragmentation()
 
 void Storage::DefragmentationImpl(bool force)
 {
+  m_lookupIsValid = false;
+
   auto const indexesSize = m_indexes.size();
   if (!force && m_numberOfDeleted < indexesSize / 2)
     return;
@@ -481,6 +507,34 @@ uint64_t Storage::UGCSizeAtIndex(size_t const indexPosition) const
   return nextOffset - indexOffset;
 }
 
+void Storage::BuildLookup() const
+{
+  m_featureToIndex.clear();
+  m_pointToIndex.clear();
+  m_dataVersions.clear();
+
+  for (size_t i = 0; i < m_indexes.size(); ++i)
+  {
+    auto const & index = m_indexes[i];
+    if (index.m_deleted)
+      continue;
+
+    // The latest index wins if there are several live ones, it's the latest update.
+    m_featureToIndex[{index.m_mwmName, index.m_dataVersion, index.m_featureId}] = i;
+    m_pointToIndex.emplace(PointKey(index.m_type, index.m_mercator.x, index.m_mercator.y), i);
+    m_dataVersions.insert(index.m_dataVersion);
+  }
+
+  m_lookupIsValid = true;
+}
+
+size_t Storage::FeatureKeyHash::operator()(FeatureKey const & key) const
+{
+  size_t const h = hash<string>()(key.m_mwmName);
+  return h ^ (hash<int64_t>()(key.m_dataVersion) * 31) ^
+         (hash<uint32_t>()(key.m_featureId) * 1000003);
+}
+
 unique_ptr<FeatureType> Storage::GetFeature(FeatureID const & id) const
 {
   CHECK(id.IsValid(), ());
@@ -498,11 +552,14 @@ Storage::SettingResult Storage::SetUGCUpdateForTesting(FeatureID const & id,
                                                        v0::UGCUpdate const & ugc)
 {
   auto const feature = GetFeature(id);
+  m_lookupIsValid = false;
   return SetGenericUGCUpdate(ugc, *feature, m_indexes, m_numberOfDeleted, Version::V0);
 }
 
 void Storage::LoadForTesting(std::string const & testIndexFilePath)
 {
+  m_lookupIsValid = false;
+
   string data;
   try
   {
@@ -4,8 +4,14 @@
 
 #include "base/thread_checker.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 
 class DataSource;
 class FeatureType;
@@ -36,20 +42,57 @@ public:
   size_t GetNumberOfUnsynchronized() const;
 
   /// Testing
-  UpdateIndexes & GetIndexesForTesting() { return m_indexes; }
+  UpdateIndexes & GetIndexesForTesting()
+  {
+    m_lookupIsValid = false;
+    return m_indexes;
+  }
   size_t GetNumberOfDeletedForTesting() const { return m_numberOfDeleted; }
   SettingResult SetUGCUpdateForTesting(FeatureID const & id, v0::UGCUpdate const & ugc);
   void LoadForTesting(std::string const & testIndexFilePath);
 
 private:
+  struct FeatureKey
+  {
+    bool operator==(FeatureKey const & rhs) const
+    {
+      return m_featureId == rhs.m_featureId && m_dataVersion == rhs.m_dataVersion &&
+             m_mwmName == rhs.m_mwmName;
+    }
+
+    std::string m_mwmName;
+    int64_t m_dataVersion = 0;
+    uint32_t m_featureId = 0;
+  };
+
+  struct FeatureKeyHash
+  {
+    size_t operator()(FeatureKey const & key) const;
+  };
+
+  // Type index from classificator.txt and mercator center of a feature.
+  using PointKey = std::tuple<uint32_t, double, double>;
+
   void DefragmentationImpl(bool force);
   uint64_t UGCSizeAtIndex(size_t const indexPosition) const;
+  UGCUpdate ReadUGCAtIndex(size_t const indexPosition) const;
   std::unique_ptr<FeatureType> GetFeature(FeatureID const & id) const;
   void Migrate(std::string const & indexFilePath);
+  void BuildLookup() const;
 
   DataSource const & m_dataSource;
   UpdateIndexes m_indexes;
   size_t m_numberOfDeleted = 0;
+
+  // Lookup tables from features to positions of their live indexes in |m_indexes|. They are
+  // rebuilt on the first GetUGCUpdate() call after |m_indexes| is changed. Features are found by
+  // ids first, which doesn't need to read the feature. Type and center are used for features
+  // of other data versions only, ids of features are not stable between versions.
+  mutable bool m_lookupIsValid = false;
+  mutable std::unordered_map<FeatureKey, size_t, FeatureKeyHash> m_featureToIndex;
+  mutable std::map<PointKey, size_t> m_pointToIndex;
+  // Data versions of live indexes.
+  mutable std::set<int64_t> m_dataVersions;
 };
 
 inline std::string DebugPrint(Storage::SettingResult const & result)
@@ -102,5 +102,27 @@ UNIT_TEST(BinarySerDes_Smoke)
     TEST(des.Deserialize(reader, 12345 /* index */, ugc), ());
     TEST_EQUAL(ugc, expectedUGC2, ());
   }
+
+  {
+    MemReader reader(buffer.data(), buffer.size());
+
+    vector<UGC> ugcs;
+    TEST_EQUAL(des.Deserialize(reader, {0, 12345, 20000, 31337, 40000}, Fields::All, ugcs), 2,
+               ());
+    TEST_EQUAL(ugcs.size(), 5, ());
+    TEST(ugcs[0].IsEmpty(), ());
+    TEST_EQUAL(ugcs[1], expectedUGC2, ());
+    TEST(ugcs[2].IsEmpty(), ());
+    TEST_EQUAL(ugcs[3], expectedUGC1, ());
+    TEST(ugcs[4].IsEmpty(), ());
+
+    // Reviews are decoded without texts.
+    TEST_EQUAL(des.Deserialize(reader, {31337}, Fields::WithoutTexts, ugcs), 1, ());
+    auto expected = expectedUGC1;
+    for (auto & review : expected.m_reviews)
+      review.m_text.m_text.clear();
+    TEST_EQUAL(ugcs[0], expected, ());
+    TEST(!ugcs[0].IsEmpty(), ());
+  }
 }
 }  // namespace
@@ -272,6 +272,30 @@ UNIT_CLASS_TEST(StorageTest, DifferentTypes)
   TEST_EQUAL(cafeUGC, storage.GetUGCUpdate(cafeId), ());
 }
 
+UNIT_CLASS_TEST(StorageTest, OtherDataVersion)
+{
+  auto & builder = MwmBuilder::Builder();
+  m2::PointD const cafePoint(1.0, 1.0);
+  m2::PointD const railwayPoint(2.0, 2.0);
+  builder.Build({TestCafe(cafePoint), TestRailway(railwayPoint)});
+  auto const cafeId = builder.FeatureIdForCafeAtPoint(cafePoint);
+  auto const railwayId = builder.FeatureIdForRailwayAtPoint(railwayPoint);
+  auto const cafeUGC = MakeTestUGCUpdate(Time(chrono::hours(24 * 10)));
+  Storage storage(builder.GetDataSource());
+  storage.Load();
+  TEST_EQUAL(storage.SetUGCUpdate(cafeId, cafeUGC), Storage::SettingResult::Success, ());
+  TEST_EQUAL(cafeUGC, storage.GetUGCUpdate(cafeId), ());
+  TEST(storage.GetUGCUpdate(railwayId).IsEmpty(), ());
+
+  // The UGC was made for another data version where the cafe had another id, it's found by
+  // the type and the center of the cafe.
+  auto & index = storage.GetIndexesForTesting().front();
+  index.m_dataVersion -= 1;
+  index.m_featureId = railwayId.m_index;
+  TEST_EQUAL(cafeUGC, storage.GetUGCUpdate(cafeId), ());
+  TEST(storage.GetUGCUpdate(railwayId).IsEmpty(), ());
+}
+
 UNIT_CLASS_TEST(StorageTest, LoadIndex)
 {
   auto & builder = MwmBuilder::Builder();